@@ -0,0 +1,298 @@
+/*---------------------------------------------------------------------*/
+/* Benchmark for 3D electromagnetic MPI field solvers at a fixed grid, */
+/* which compares the spectral solver (ffts with global transposes,  */
+/* cppmaxwel32, cppemfield32) with the finite difference time domain */
+/* solver on a yee mesh (cppyeebh32l, cppyeee32l, with divergence   */
+/* cleaning by cppyeediv32l, cppyeeclean32l), which needs only guard */
+/* cell exchanges with nearest neighbors.  Both time the work done   */
+/* between the charge and current deposits and the particle push.   */
+#include <stdlib.h>
+#include <stdio.h>
+#include <complex.h>
+#include <math.h>
+#include <sys/time.h>
+#include "pbpush3.h"
+#include "pplib3.h"
+
+void dtimer(double *time, struct timeval *itime, int icntrl);
+
+int main(int argc, char *argv[]) {
+/* indx/indy/indz = exponent which determines grid points in x/y/z: */
+/* direction: nx = 2**indx, ny = 2**indy, nz = 2**indz */
+   int indx =   6, indy =   6, indz =   6;
+/* nrep = number of field steps timed for each solver */
+   int nrep = 20;
+/* ndim = number of velocity coordinates = 3 */
+   int ndim = 3;
+/* dt = time interval between successive calculations */
+   float dt = 0.035;
+/* ax/ay/az = smoothed particle size in x/y/z direction */
+/* ci = reciprocal of velocity of light */
+   float ax = .912871, ay = .912871, az = .912871, ci = 0.1;
+/* dmr = coefficient of marder's divergence cleaning */
+   float dmr = 0.08;
+/* idps = number of partition boundaries = 4 */
+/* idds = dimensionality of domain decomposition = 2 */
+   int idps = 4, idds =    2;
+   float we = 0.0, wf = 0.0, wm = 0.0;
+/* declare scalars for standard code */
+   int j, k, l, n, nx, ny, nz, nxh, nzh, nxe, nye, nze, nxeh, nnxe;
+   int nxyzh, nxhyz, isign, ierr;
+   float affp, dth, ttp;
+/* declare scalars for MPI code */
+   int ntpose = 1, ltpose = 0;
+   int nvpy, nvpz, nvp, idproc, kstrt, kyp, kzp;
+   int kxyp, kyzp, kzyp, nypmx, nzpmx, nypmn, nzpmn;
+
+/* declare arrays for standard code: */
+/* qe/cue = charge/current density with guard cells */
+/* fxyze/bxyze = electric/magnetic field with guard cells */
+   float *qe = NULL, *cue = NULL, *fxyze = NULL, *bxyze = NULL;
+/* eyee/byee/cyee = electric/magnetic field and curl on yee mesh */
+   float *eyee = NULL, *byee = NULL, *cyee = NULL;
+   float complex *qt = NULL, *qs = NULL, *cut = NULL;
+   float complex *fxyzt = NULL, *fxyzs = NULL, *bxyzt = NULL;
+   float complex *exyz = NULL, *bxyz = NULL;
+   float complex *ffc = NULL, *sct = NULL;
+   int *mixup = NULL;
+/* declare arrays for MPI code: */
+   float complex *bs = NULL, *br = NULL;
+   float *edges = NULL;
+   int *nyzp = NULL, *noff = NULL;
+   float *scr = NULL, *scs = NULL;
+
+/* declare and initialize timing data */
+/* tp[0:1] = spectral/fdtd time, tp[2] = spectral transpose time */
+   double tp[3], tw[3], dtime;
+   struct timeval itime;
+
+   nx = 1L<<indx; ny = 1L<<indy; nz = 1L<<indz;
+   nxh = nx/2; nzh = 1 > nz/2 ? 1 : nz/2;
+   nxe = nx + 2; nye = ny + 2; nze = nz + 2;
+   nxeh = nxe/2;  nnxe = ndim*nxe;
+   nxyzh = (nx > ny ? nx : ny); nxyzh = (nxyzh > nz ? nxyzh : nz)/2;
+   nxhyz = nxh > ny ? nxh : ny; nxhyz = nxhyz > nz ? nxhyz : nz;
+   affp = 1.0;
+   dth = 0.5*dt;
+
+/* initialize for distributed memory parallel processing */
+   cppinit2(&idproc,&nvp,argc,argv);
+   kstrt = idproc + 1;
+   cfcomp32(nvp,nx,ny,nz,&nvpy,&nvpz,&ierr);
+   if (ierr != 0) {
+      if (kstrt==1) {
+         printf("cfcomp32 error: nvp,nvpy,nvpz=%d,%d,%d\n",nvp,nvpy,nvpz);
+      }
+      goto L3000;
+   }
+   edges = (float *) malloc(idps*sizeof(float));
+   nyzp = (int *) malloc(idds*sizeof(int));
+   noff = (int *) malloc(idds*sizeof(int));
+   cpdicomp32l(edges,nyzp,noff,&nypmx,&nzpmx,&nypmn,&nzpmn,ny,nz,kstrt,
+               nvpy,nvpz,idps,idds);
+   if ((nypmn < 1) || (nzpmn < 1)) {
+      if (kstrt==1) {
+         printf("combination not supported nvpy,nvpz= %d,%d\n",nvpy,
+                nvpz);
+      }
+      goto L3000;
+   }
+   kyp = (ny - 1)/nvpy + 1;
+   kzp = (nz - 1)/nvpz + 1;
+   kxyp = (nxh - 1)/nvpy + 1;
+   kyzp = (ny - 1)/nvpz + 1; kzyp = kyzp > kyp ? kyzp : kyp;
+
+/* allocate data */
+   qe = (float *) malloc(nxe*nypmx*nzpmx*sizeof(float));
+   fxyze = (float *) malloc(ndim*nxe*nypmx*nzpmx*sizeof(float));
+   cue = (float *) malloc(ndim*nxe*nypmx*nzpmx*sizeof(float));
+   bxyze = (float *) malloc(ndim*nxe*nypmx*nzpmx*sizeof(float));
+   eyee = (float *) malloc(ndim*nxe*nypmx*nzpmx*sizeof(float));
+   byee = (float *) malloc(ndim*nxe*nypmx*nzpmx*sizeof(float));
+   cyee = (float *) malloc(ndim*nxe*nypmx*nzpmx*sizeof(float));
+   qt = (float complex *) malloc(nze*kxyp*kyzp*sizeof(float complex));
+   qs = (float complex *) malloc(nye*kxyp*nzpmx*sizeof(float complex));
+   cut = (float complex *) malloc(ndim*nze*kxyp*kyzp
+                                  *sizeof(float complex));
+   fxyzt = (float complex *) malloc(ndim*nze*kxyp*kyzp
+                                    *sizeof(float complex));
+   fxyzs = (float complex *) malloc(ndim*nye*kxyp*nzpmx
+                                    *sizeof(float complex));
+   bxyzt = (float complex *) malloc(ndim*nze*kxyp*kyzp
+                                    *sizeof(float complex));
+   exyz = (float complex *) malloc(ndim*nze*kxyp*kyzp
+                                   *sizeof(float complex));
+   bxyz = (float complex *) malloc(ndim*nze*kxyp*kyzp
+                                   *sizeof(float complex));
+   ffc = (float complex *) malloc(nzh*kxyp*kyzp*sizeof(float complex));
+   mixup = (int *) malloc(nxhyz*sizeof(int));
+   sct = (float complex *) malloc(nxyzh*sizeof(float complex));
+   bs = (float complex *) malloc(ndim*kxyp*kzyp*kzp
+                                 *sizeof(float complex));
+   br = (float complex *) malloc(ndim*kxyp*kzyp*kzp
+                                 *sizeof(float complex));
+   scr = (float *) malloc(nnxe*nypmx*sizeof(float));
+   scs = (float *) malloc(nnxe*2*nzpmx*sizeof(float));
+
+   cwpfft32rinit(mixup,sct,indx,indy,indz,nxhyz,nxyzh);
+   isign = 0;
+   cppois332(qt,fxyzt,isign,ffc,ax,ay,az,affp,&we,nx,ny,nz,kstrt,nvpy,
+             nvpz,nze,kxyp,kyzp,nzh);
+   for (j = 0; j < ndim*nze*kxyp*kyzp; j++) {
+      exyz[j] = 0.0 + 0.0*_Complex_I;
+      bxyz[j] = 0.0 + 0.0*_Complex_I;
+   }
+   for (j = 0; j < ndim*nxe*nypmx*nzpmx; j++) {
+      eyee[j] = 0.0;
+      byee[j] = 0.0;
+   }
+
+   if (kstrt==1) {
+      printf("nx,ny,nz = %d,%d,%d, nvpy,nvpz = %d,%d\n",nx,ny,nz,nvpy,
+             nvpz);
+   }
+   for (j = 0; j < 3; j++) {
+      tp[j] = 0.0;
+   }
+   for (n = 0; n < nrep; n++) {
+/* spectral solver, sources are restored every step since ffts */
+/* modify them                                                 */
+      for (l = 0; l < nzpmx; l++) {
+         for (k = 0; k < nypmx; k++) {
+            for (j = 0; j < nxe; j++) {
+               qe[j+nxe*(k+nypmx*l)] = 0.0;
+               cue[ndim*(j+nxe*(k+nypmx*l))] = 0.0;
+               cue[1+ndim*(j+nxe*(k+nypmx*l))] = 0.0;
+               cue[2+ndim*(j+nxe*(k+nypmx*l))]
+               = sinf(0.2*(float) (k+noff[0]))*cosf(0.1*(float) j);
+            }
+         }
+      }
+      dtimer(&dtime,&itime,-1);
+      cppacguard32xl(cue,nyzp,nx,ndim,nxe,nypmx,nzpmx,idds);
+      cppnacguard32l(cue,scs,scr,nyzp,ndim,kstrt,nvpy,nvpz,nx,nxe,nypmx,
+                     nzpmx,idds);
+      cppaguard32xl(qe,nyzp,nx,nxe,nypmx,nzpmx,idds);
+      cppnaguard32l(qe,scs,scr,nyzp,kstrt,nvpy,nvpz,nx,nxe,nypmx,nzpmx,
+                    idds);
+      isign = -1;
+      cwppfft32r((float complex *)qe,qs,qt,bs,br,isign,ntpose,ltpose,
+                 mixup,sct,&ttp,indx,indy,indz,kstrt,nvpy,nvpz,nxeh,
+                 nye,nze,kxyp,kyp,kyzp,kzp,kxyp,nypmx,kyzp,nzpmx,kzyp,
+                 nxhyz,nxyzh);
+      tp[2] += ttp;
+      cwppfft32r3((float complex *)cue,fxyzs,cut,bs,br,isign,ntpose,
+                  ltpose,mixup,sct,&ttp,indx,indy,indz,kstrt,nvpy,nvpz,
+                  nxeh,nye,nze,kxyp,kyp,kyzp,kzp,kxyp,nypmx,kyzp,nzpmx,
+                  kzyp,nxhyz,nxyzh);
+      tp[2] += ttp;
+      cppcuperp32(cut,nx,ny,nz,kstrt,nvpy,nvpz,nze,kxyp,kyzp);
+      cppmaxwel32(exyz,bxyz,cut,ffc,affp,ci,dt,&wf,&wm,nx,ny,nz,kstrt,
+                  nvpy,nvpz,nze,kxyp,kyzp,nzh);
+      cppois332(qt,fxyzt,isign,ffc,ax,ay,az,affp,&we,nx,ny,nz,kstrt,nvpy,
+                nvpz,nze,kxyp,kyzp,nzh);
+      isign = 1;
+      cppemfield32(fxyzt,exyz,ffc,isign,nx,ny,nz,kstrt,nvpy,nvpz,nze,
+                   kxyp,kyzp,nzh);
+      isign = -1;
+      cppemfield32(bxyzt,bxyz,ffc,isign,nx,ny,nz,kstrt,nvpy,nvpz,nze,
+                   kxyp,kyzp,nzh);
+      isign = 1;
+      cwppfft32r3((float complex *)fxyze,fxyzs,fxyzt,bs,br,isign,ntpose,
+                  ltpose,mixup,sct,&ttp,indx,indy,indz,kstrt,nvpy,nvpz,
+                  nxeh,nye,nze,kxyp,kyp,kyzp,kzp,kxyp,nypmx,kyzp,nzpmx,
+                  kzyp,nxhyz,nxyzh);
+      tp[2] += ttp;
+      cwppfft32r3((float complex *)bxyze,fxyzs,bxyzt,bs,br,isign,ntpose,
+                  ltpose,mixup,sct,&ttp,indx,indy,indz,kstrt,nvpy,nvpz,
+                  nxeh,nye,nze,kxyp,kyp,kyzp,kzp,kxyp,nypmx,kyzp,nzpmx,
+                  kzyp,nxhyz,nxyzh);
+      tp[2] += ttp;
+      cppncguard32l(fxyze,scs,nyzp,kstrt,nvpy,nvpz,nnxe,nypmx,nzpmx,
+                    idds);
+      cppcguard32xl(fxyze,nyzp,nx,ndim,nxe,nypmx,nzpmx,idds);
+      cppncguard32l(bxyze,scs,nyzp,kstrt,nvpy,nvpz,nnxe,nypmx,nzpmx,
+                    idds);
+      cppcguard32xl(bxyze,nyzp,nx,ndim,nxe,nypmx,nzpmx,idds);
+      dtimer(&dtime,&itime,1);
+      tp[0] += dtime;
+/* finite difference time domain solver */
+      for (l = 0; l < nzpmx; l++) {
+         for (k = 0; k < nypmx; k++) {
+            for (j = 0; j < nxe; j++) {
+               qe[j+nxe*(k+nypmx*l)] = 0.0;
+               cue[ndim*(j+nxe*(k+nypmx*l))] = 0.0;
+               cue[1+ndim*(j+nxe*(k+nypmx*l))] = 0.0;
+               cue[2+ndim*(j+nxe*(k+nypmx*l))]
+               = sinf(0.2*(float) (k+noff[0]))*cosf(0.1*(float) j);
+            }
+         }
+      }
+      dtimer(&dtime,&itime,-1);
+      cppacguard32xl(cue,nyzp,nx,ndim,nxe,nypmx,nzpmx,idds);
+      cppnacguard32l(cue,scs,scr,nyzp,ndim,kstrt,nvpy,nvpz,nx,nxe,nypmx,
+                     nzpmx,idds);
+      cppncguard32l(cue,scs,nyzp,kstrt,nvpy,nvpz,nnxe,nypmx,nzpmx,idds);
+      cppcguard32xl(cue,nyzp,nx,ndim,nxe,nypmx,nzpmx,idds);
+      cppyeebh32l(eyee,byee,affp,ci,dth,&wm,nyzp,nx,nxe,nypmx,nzpmx,
+                  idds);
+      for (j = 0; j < ndim*nxe*nypmx*nzpmx; j++) {
+         cyee[j] = 0.0;
+      }
+      cppyeecurl32l(byee,cyee,nyzp,nx,nxe,nypmx,nzpmx,idds);
+      cppacguard32xl(cyee,nyzp,nx,ndim,nxe,nypmx,nzpmx,idds);
+      cppnacguard32l(cyee,scs,scr,nyzp,ndim,kstrt,nvpy,nvpz,nx,nxe,
+                     nypmx,nzpmx,idds);
+      cppyeee32l(eyee,cyee,cue,affp,ci,dt,&wf,nyzp,nx,nxe,nypmx,nzpmx,
+                 idds);
+      cppncguard32l(eyee,scs,nyzp,kstrt,nvpy,nvpz,nnxe,nypmx,nzpmx,idds);
+      cppcguard32xl(eyee,nyzp,nx,ndim,nxe,nypmx,nzpmx,idds);
+      cppyeediv32l(eyee,qe,affp,nyzp,nx,nxe,nypmx,nzpmx,idds);
+      cppaguard32xl(qe,nyzp,nx,nxe,nypmx,nzpmx,idds);
+      cppnaguard32l(qe,scs,scr,nyzp,kstrt,nvpy,nvpz,nx,nxe,nypmx,nzpmx,
+                    idds);
+      cppncguard32l(qe,scs,nyzp,kstrt,nvpy,nvpz,nxe,nypmx,nzpmx,idds);
+      cppcguard32xl(qe,nyzp,nx,1,nxe,nypmx,nzpmx,idds);
+      cppyeeclean32l(eyee,qe,dmr,affp,&wf,nyzp,nx,nxe,nypmx,nzpmx,idds);
+      cppncguard32l(eyee,scs,nyzp,kstrt,nvpy,nvpz,nnxe,nypmx,nzpmx,idds);
+      cppcguard32xl(eyee,nyzp,nx,ndim,nxe,nypmx,nzpmx,idds);
+      cppyeebh32l(eyee,byee,affp,ci,dth,&wm,nyzp,nx,nxe,nypmx,nzpmx,
+                  idds);
+      for (j = 0; j < ndim*nxe*nypmx*nzpmx; j++) {
+         fxyze[j] = 0.0;
+         bxyze[j] = 0.0;
+      }
+      isign = 1;
+      cppyeefield32l(fxyze,eyee,isign,nyzp,nx,nxe,nypmx,nzpmx,idds);
+      isign = -1;
+      cppyeefield32l(bxyze,byee,isign,nyzp,nx,nxe,nypmx,nzpmx,idds);
+      cppacguard32xl(fxyze,nyzp,nx,ndim,nxe,nypmx,nzpmx,idds);
+      cppnacguard32l(fxyze,scs,scr,nyzp,ndim,kstrt,nvpy,nvpz,nx,nxe,
+                     nypmx,nzpmx,idds);
+      cppacguard32xl(bxyze,nyzp,nx,ndim,nxe,nypmx,nzpmx,idds);
+      cppnacguard32l(bxyze,scs,scr,nyzp,ndim,kstrt,nvpy,nvpz,nx,nxe,
+                     nypmx,nzpmx,idds);
+      cppncguard32l(fxyze,scs,nyzp,kstrt,nvpy,nvpz,nnxe,nypmx,nzpmx,
+                    idds);
+      cppcguard32xl(fxyze,nyzp,nx,ndim,nxe,nypmx,nzpmx,idds);
+      cppncguard32l(bxyze,scs,nyzp,kstrt,nvpy,nvpz,nnxe,nypmx,nzpmx,
+                    idds);
+      cppcguard32xl(bxyze,nyzp,nx,ndim,nxe,nypmx,nzpmx,idds);
+      dtimer(&dtime,&itime,1);
+      tp[1] += dtime;
+   }
+/* find maximum times over processors */
+   cppdmax(tp,tw,3);
+   if (kstrt==1) {
+      for (j = 0; j < 3; j++) {
+         tp[j] = 1.0e+03*tp[j]/(double) nrep;
+      }
+      printf("msec per field step:\n");
+      printf("spectral = %10.4f (transpose = %10.4f)\n",tp[0],tp[2]);
+      printf("fdtd     = %10.4f\n",tp[1]);
+   }
+
+L3000:
+   cppexit();
+   return 0;
+}
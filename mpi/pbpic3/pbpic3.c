@@ -34,6 +34,11 @@ int main(int argc, char *argv[]) {
 /* sortime = number of time steps between standard electron sorting */
 /* relativity = (no,yes) = (0,1) = relativity is used */
    int idimp = 6, ipbc = 1, sortime = 20, relativity = 1;
+/* fdtd = field solver: (spectral,finite difference time domain) = (0,1) */
+   int fdtd = 0;
+/* dmr = coefficient of marder's divergence cleaning for fdtd = 1, */
+/* 0 < dmr <= 1/6 */
+   float dmr = 0.08;
 /* idps = number of partition boundaries = 4 */
 /* idds = dimensionality of domain decomposition = 2 */
    int idps = 4, idds =    2;
@@ -49,9 +54,12 @@ int main(int argc, char *argv[]) {
 
 /* declare scalars for MPI code */
    int ntpose = 1;
+/* ltpose = number of blocks in x for pipelined y-z transpose */
+/* (0 = transpose whole array, then fft in z)                 */
+   int ltpose = 0;
    int nvpy, nvpz, nvp, idproc, kstrt, npmax, kyp, kzp;
    int kxyp, kyzp, kzyp, nypmx, nzpmx, nypmn, nzpmn, npp, nps;
-   int nyzpm1, nbmax, ntmax;
+   int nyzpm1, nbmax, ntmax, nbs;
 
 /* declare arrays for standard code: */
 /* part, part2 = particle arrays */
@@ -60,6 +68,9 @@ int main(int argc, char *argv[]) {
 /* cue = electron current density with guard cells */
 /* fxyze/bxyze = smoothed electric/magnetic field with guard cells */
    float *qe = NULL, *cue = NULL, *fxyze = NULL, *bxyze = NULL;
+/* eyee/byee = electric/magnetic field on yee mesh with guard cells */
+/* cyee = curl of magnetic field on yee mesh with guard cells */
+   float *eyee = NULL, *byee = NULL, *cyee = NULL;
 /* qt, qs = scalar charge density field arrays in fourier space */
    float complex *qt = NULL, *qs = NULL;
 /* cut = vector current density field arrays in fourier space */
@@ -209,10 +220,19 @@ int main(int argc, char *argv[]) {
    sct = (float complex *) malloc(nxyzh*sizeof(float complex));
    ihole = (int *) malloc((ntmax+1)*2*sizeof(int));
    npic = (int *) malloc(nyzpm1*sizeof(int));
+   if (fdtd==1) {
+      eyee = (float *) malloc(ndim*nxe*nypmx*nzpmx*sizeof(float));
+      byee = (float *) malloc(ndim*nxe*nypmx*nzpmx*sizeof(float));
+      cyee = (float *) malloc(ndim*nxe*nypmx*nzpmx*sizeof(float));
+   }
 
 /* allocate data for MPI code */
-   bs = (float complex *) malloc(ndim*kxyp*kzyp*kzp*sizeof(float complex));
-   br = (float complex *) malloc(ndim*kxyp*kzyp*kzp*sizeof(float complex));
+/* pipelined transpose keeps a separate buffer for each block */
+   nbs = ltpose > 0 ? nvpz : 1;
+   bs = (float complex *) malloc(ndim*kxyp*kzyp*kzp*nbs
+                                 *sizeof(float complex));
+   br = (float complex *) malloc(ndim*kxyp*kzyp*kzp*nbs
+                                 *sizeof(float complex));
    sbufl = (float *) malloc(idimp*nbmax*sizeof(float));
    sbufr = (float *) malloc(idimp*nbmax*sizeof(float));
    rbufl = (float *) malloc(idimp*nbmax*sizeof(float));
@@ -244,6 +264,12 @@ int main(int argc, char *argv[]) {
       exyz[j] = 0.0 + 0.0*_Complex_I;
       bxyz[j] = 0.0 + 0.0*_Complex_I;
    }
+   if (fdtd==1) {
+      for (j = 0; j < ndim*nxe*nypmx*nzpmx; j++) {
+         eyee[j] = 0.0;
+         byee[j] = 0.0;
+      }
+   }
 
    if (dt > 0.37*ci) {
       printf("Warning: Courant condition may be exceeded!\n");
@@ -293,6 +319,135 @@ L500: if (nloop <= ntime)
          goto L3000;
       }
 
+/* finite difference time domain solver replaces the ffts and spectral */
+/* field solver, using only nearest neighbor data after the first step */
+      if (fdtd==1) {
+/* deposit charge with standard procedure: updates qe */
+         dtimer(&dtime,&itime,-1);
+         for (j = 0; j < nxe*nypmx*nzpmx; j++) {
+            qe[j] = 0.0;
+         }
+         cppgpost32l(part,qe,npp,noff,qme,idimp,npmax,nxe,nypmx,nzpmx,
+                     idds);
+         dtimer(&dtime,&itime,1);
+         time = (float) dtime;
+         tdpost += time;
+
+/* add and copy guard cells with standard procedure: updates cue */
+         dtimer(&dtime,&itime,-1);
+         cppacguard32xl(cue,nyzp,nx,ndim,nxe,nypmx,nzpmx,idds);
+         cppnacguard32l(cue,scs,scr,nyzp,ndim,kstrt,nvpy,nvpz,nx,nxe,
+                        nypmx,nzpmx,idds);
+         cppncguard32l(cue,scs,nyzp,kstrt,nvpy,nvpz,nnxe,nypmx,nzpmx,
+                       idds);
+         cppcguard32xl(cue,nyzp,nx,ndim,nxe,nypmx,nzpmx,idds);
+         dtimer(&dtime,&itime,1);
+         time = (float) dtime;
+         tguard += time;
+
+/* initialize electric field on yee mesh from the charge density */
+/* updates eyee, wf, wm, modifies qe                              */
+         if (ntime==0) {
+            dtimer(&dtime,&itime,-1);
+            cppaguard32xl(qe,nyzp,nx,nxe,nypmx,nzpmx,idds);
+            cppnaguard32l(qe,scs,scr,nyzp,kstrt,nvpy,nvpz,nx,nxe,nypmx,
+                          nzpmx,idds);
+            dtimer(&dtime,&itime,1);
+            time = (float) dtime;
+            tguard += time;
+/* transform charge to fourier space and find potential */
+            dtimer(&dtime,&itime,-1);
+            isign = -1;
+            cwppfft32r((float complex *)qe,qs,qt,bs,br,isign,ntpose,
+                       ltpose,mixup,sct,&ttp,indx,indy,indz,kstrt,nvpy,
+                       nvpz,nxeh,nye,nze,kxyp,kyp,kyzp,kzp,kxyp,nypmx,
+                       kyzp,nzpmx,kzyp,nxhyz,nxyzh);
+            cppyeepot32(qt,affp,nx,ny,nz,kstrt,nvpy,nvpz,nze,kxyp,kyzp);
+            isign = 1;
+            cwppfft32r((float complex *)qe,qs,qt,bs,br,isign,ntpose,
+                       ltpose,mixup,sct,&ttp,indx,indy,indz,kstrt,nvpy,
+                       nvpz,nxeh,nye,nze,kxyp,kyp,kyzp,kzp,kxyp,nypmx,
+                       kyzp,nzpmx,kzyp,nxhyz,nxyzh);
+            dtimer(&dtime,&itime,1);
+            time = (float) dtime;
+            tfft[0] += time;
+            tfft[1] += ttp;
+/* electric field is minus the gradient of the potential */
+            dtimer(&dtime,&itime,-1);
+            cppncguard32l(qe,scs,nyzp,kstrt,nvpy,nvpz,nxe,nypmx,nzpmx,
+                          idds);
+            cppcguard32xl(qe,nyzp,nx,1,nxe,nypmx,nzpmx,idds);
+            cppyeeclean32l(eyee,qe,-1.0,affp,&wf,nyzp,nx,nxe,nypmx,
+                           nzpmx,idds);
+            cppncguard32l(eyee,scs,nyzp,kstrt,nvpy,nvpz,nnxe,nypmx,
+                          nzpmx,idds);
+            cppcguard32xl(eyee,nyzp,nx,ndim,nxe,nypmx,nzpmx,idds);
+            wm = 0.0;
+            dth = 0.5*dt;
+         }
+         else {
+/* calculate electromagnetic fields on yee mesh with standard */
+/* procedure: updates eyee, byee, wf, wm                      */
+            dtimer(&dtime,&itime,-1);
+/* update magnetic field half time step */
+            cppyeebh32l(eyee,byee,affp,ci,dth,&wm,nyzp,nx,nxe,nypmx,
+                        nzpmx,idds);
+/* calculate curl of magnetic field and add guard cells */
+            for (j = 0; j < ndim*nxe*nypmx*nzpmx; j++) {
+               cyee[j] = 0.0;
+            }
+            cppyeecurl32l(byee,cyee,nyzp,nx,nxe,nypmx,nzpmx,idds);
+            cppacguard32xl(cyee,nyzp,nx,ndim,nxe,nypmx,nzpmx,idds);
+            cppnacguard32l(cyee,scs,scr,nyzp,ndim,kstrt,nvpy,nvpz,nx,
+                           nxe,nypmx,nzpmx,idds);
+/* update electric field whole time step and copy guard cells */
+            cppyeee32l(eyee,cyee,cue,affp,ci,dt,&wf,nyzp,nx,nxe,nypmx,
+                       nzpmx,idds);
+            cppncguard32l(eyee,scs,nyzp,kstrt,nvpy,nvpz,nnxe,nypmx,
+                          nzpmx,idds);
+            cppcguard32xl(eyee,nyzp,nx,ndim,nxe,nypmx,nzpmx,idds);
+/* remove error in gauss's law with marder's divergence cleaning: */
+/* updates eyee, wf, modifies qe                                  */
+            cppyeediv32l(eyee,qe,affp,nyzp,nx,nxe,nypmx,nzpmx,idds);
+            cppaguard32xl(qe,nyzp,nx,nxe,nypmx,nzpmx,idds);
+            cppnaguard32l(qe,scs,scr,nyzp,kstrt,nvpy,nvpz,nx,nxe,nypmx,
+                          nzpmx,idds);
+            cppncguard32l(qe,scs,nyzp,kstrt,nvpy,nvpz,nxe,nypmx,nzpmx,
+                          idds);
+            cppcguard32xl(qe,nyzp,nx,1,nxe,nypmx,nzpmx,idds);
+            cppyeeclean32l(eyee,qe,dmr,affp,&wf,nyzp,nx,nxe,nypmx,nzpmx,
+                           idds);
+            cppncguard32l(eyee,scs,nyzp,kstrt,nvpy,nvpz,nnxe,nypmx,
+                          nzpmx,idds);
+            cppcguard32xl(eyee,nyzp,nx,ndim,nxe,nypmx,nzpmx,idds);
+/* update magnetic field half time step */
+            cppyeebh32l(eyee,byee,affp,ci,dth,&wm,nyzp,nx,nxe,nypmx,
+                        nzpmx,idds);
+         }
+         we = 0.0;
+
+/* average fields to grid points with standard procedure: */
+/* updates fxyze, bxyze                                   */
+         for (j = 0; j < ndim*nxe*nypmx*nzpmx; j++) {
+            fxyze[j] = 0.0;
+            bxyze[j] = 0.0;
+         }
+         isign = 1;
+         cppyeefield32l(fxyze,eyee,isign,nyzp,nx,nxe,nypmx,nzpmx,idds);
+         isign = -1;
+         cppyeefield32l(bxyze,byee,isign,nyzp,nx,nxe,nypmx,nzpmx,idds);
+         cppacguard32xl(fxyze,nyzp,nx,ndim,nxe,nypmx,nzpmx,idds);
+         cppnacguard32l(fxyze,scs,scr,nyzp,ndim,kstrt,nvpy,nvpz,nx,nxe,
+                        nypmx,nzpmx,idds);
+         cppacguard32xl(bxyze,nyzp,nx,ndim,nxe,nypmx,nzpmx,idds);
+         cppnacguard32l(bxyze,scs,scr,nyzp,ndim,kstrt,nvpy,nvpz,nx,nxe,
+                        nypmx,nzpmx,idds);
+         dtimer(&dtime,&itime,1);
+         time = (float) dtime;
+         tfield += time;
+         goto L1000;
+      }
+
 /* deposit charge with standard procedure: updates qe */
       dtimer(&dtime,&itime,-1);
       for (j = 0; j < nxe*nypmx*nzpmx; j++) {
@@ -319,9 +474,10 @@ L500: if (nloop <= ntime)
 /* modifies qe */
       dtimer(&dtime,&itime,-1);
       isign = -1;
-      cwppfft32r((float complex *)qe,qs,qt,bs,br,isign,ntpose,mixup,sct,
-                 &ttp,indx,indy,indz,kstrt,nvpy,nvpz,nxeh,nye,nze,kxyp,
-                 kyp,kyzp,kzp,kxyp,nypmx,kyzp,nzpmx,kzyp,nxhyz,nxyzh);
+      cwppfft32r((float complex *)qe,qs,qt,bs,br,isign,ntpose,ltpose,
+                 mixup,sct,&ttp,indx,indy,indz,kstrt,nvpy,nvpz,nxeh,
+                 nye,nze,kxyp,kyp,kyzp,kzp,kxyp,nypmx,kyzp,nzpmx,kzyp,
+                 nxhyz,nxyzh);
       dtimer(&dtime,&itime,1);
       time = (float) dtime;
       tfft[0] += time;
@@ -332,9 +488,9 @@ L500: if (nloop <= ntime)
       dtimer(&dtime,&itime,-1);
       isign = -1;
       cwppfft32r3((float complex *)cue,fxyzs,cut,bs,br,isign,ntpose,
-                  mixup,sct,&ttp,indx,indy,indz,kstrt,nvpy,nvpz,nxeh,nye,
-                  nze,kxyp,kyp,kyzp,kzp,kxyp,nypmx,kyzp,nzpmx,kzyp,nxhyz,
-                  nxyzh);
+                  ltpose,mixup,sct,&ttp,indx,indy,indz,kstrt,nvpy,nvpz,
+                  nxeh,nye,nze,kxyp,kyp,kyzp,kzp,kxyp,nypmx,kyzp,nzpmx,
+                  kzyp,nxhyz,nxyzh);
       dtimer(&dtime,&itime,1);
       time = (float) dtime;
       tfft[0] += time;
@@ -393,9 +549,9 @@ L500: if (nloop <= ntime)
       dtimer(&dtime,&itime,-1);
       isign = 1;
       cwppfft32r3((float complex *)fxyze,fxyzs,fxyzt,bs,br,isign,ntpose,
-                  mixup,sct,&ttp,indx,indy,indz,kstrt,nvpy,nvpz,nxeh,nye,
-                  nze,kxyp,kyp,kyzp,kzp,kxyp,nypmx,kyzp,nzpmx,kzyp,nxhyz,
-                  nxyzh);
+                  ltpose,mixup,sct,&ttp,indx,indy,indz,kstrt,nvpy,nvpz,
+                  nxeh,nye,nze,kxyp,kyp,kyzp,kzp,kxyp,nypmx,kyzp,nzpmx,
+                  kzyp,nxhyz,nxyzh);
       dtimer(&dtime,&itime,1);
       time = (float) dtime;
       tfft[0] += time;
@@ -406,16 +562,16 @@ L500: if (nloop <= ntime)
       dtimer(&dtime,&itime,-1);
       isign = 1;
       cwppfft32r3((float complex *)bxyze,fxyzs,bxyzt,bs,br,isign,ntpose,
-                  mixup,sct,&ttp,indx,indy,indz,kstrt,nvpy,nvpz,nxeh,nye,
-                  nze,kxyp,kyp,kyzp,kzp,kxyp,nypmx,kyzp,nzpmx,kzyp,nxhyz,
-                  nxyzh);
+                  ltpose,mixup,sct,&ttp,indx,indy,indz,kstrt,nvpy,nvpz,
+                  nxeh,nye,nze,kxyp,kyp,kyzp,kzp,kxyp,nypmx,kyzp,nzpmx,
+                  kzyp,nxhyz,nxyzh);
       dtimer(&dtime,&itime,1);
       time = (float) dtime;
       tfft[0] += time;
       tfft[1] += ttp;
 
 /* copy guard cells with standard procedure: updates fxyze, bxyze */
-      dtimer(&dtime,&itime,-1);
+L1000: dtimer(&dtime,&itime,-1);
       cppncguard32l(fxyze,scs,nyzp,kstrt,nvpy,nvpz,nnxe,nypmx,nzpmx,
                     idds);
       cppcguard32xl(fxyze,nyzp,nx,ndim,nxe,nypmx,nzpmx,idds);
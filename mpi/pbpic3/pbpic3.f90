@@ -29,6 +29,11 @@
 ! sortime = number of time steps between standard electron sorting
 ! relativity = (no,yes) = (0,1) = relativity is used
       integer :: idimp = 6, ipbc = 1, sortime = 20, relativity = 1
+! fdtd = field solver: (spectral,finite difference time domain) = (0,1)
+      integer :: fdtd = 0
+! dmr = coefficient of marder's divergence cleaning for fdtd = 1,
+! 0 < dmr <= 1/6
+      real :: dmr = 0.08
 ! idps = number of partition boundaries = 4
 ! idds = dimensionality of domain decomposition = 2
       integer :: idps = 4, idds =    2
@@ -43,9 +48,12 @@
 !
 ! declare scalars for MPI code
       integer :: ntpose = 1
+! ltpose = number of blocks in x for pipelined y-z transpose
+! (0 = transpose whole array, then fft in z)
+      integer :: ltpose = 0
       integer :: nvpy, nvpz, nvp, idproc, kstrt, npmax, kyp, kzp
       integer :: kxyp, kyzp, kzyp, nypmx, nzpmx, nypmn, nzpmn, npp, nps
-      integer :: nyzpm1, nbmax, ntmax
+      integer :: nyzpm1, nbmax, ntmax, nbs
 !
 ! declare arrays for standard code:
 ! part, part2 = particle arrays
@@ -55,6 +63,9 @@
 ! cue = electron current density with guard cells
 ! fxyze/bxyze = smoothed electric/magnetic field with guard cells
       real, dimension(:,:,:,:), pointer :: cue, fxyze, bxyze
+! eyee/byee = electric/magnetic field on yee mesh with guard cells
+! cyee = curl of magnetic field on yee mesh with guard cells
+      real, dimension(:,:,:,:), pointer :: eyee, byee, cyee
 ! qt, qs = scalar charge density field arrays in fourier space
       complex, dimension(:,:,:), pointer :: qt, qs
 ! cut = vector current density field arrays in fourier space
@@ -184,9 +195,16 @@
       allocate(exyz(ndim,nze,kxyp,kyzp),bxyz(ndim,nze,kxyp,kyzp))
       allocate(ffc(nzh,kxyp,kyzp),mixup(nxhyz),sct(nxyzh))
       allocate(ihole(ntmax+1,2),npic(nyzpm1))
+      if (fdtd==1) then
+         allocate(eyee(ndim,nxe,nypmx,nzpmx),byee(ndim,nxe,nypmx,nzpmx))
+         allocate(cyee(ndim,nxe,nypmx,nzpmx))
+      endif
 !
 ! allocate data for MPI code
-      allocate(bs(ndim,kxyp*kzyp,kzp),br(ndim,kxyp*kzyp,kzp))
+! pipelined transpose keeps a separate buffer for each block
+      nbs = 1
+      if (ltpose > 0) nbs = nvpz
+      allocate(bs(ndim,kxyp*kzyp,kzp*nbs),br(ndim,kxyp*kzyp,kzp*nbs))
       allocate(sbufl(idimp,nbmax),sbufr(idimp,nbmax))
       allocate(rbufl(idimp,nbmax),rbufr(idimp,nbmax))
       allocate(scr(nnxe,nypmx),scs(nnxe,2*nzpmx))
@@ -214,6 +232,10 @@
 ! initialize transverse electromagnetic fields
       exyz = cmplx(0.0,0.0)
       bxyz = cmplx(0.0,0.0)
+      if (fdtd==1) then
+         eyee = 0.0
+         byee = 0.0
+      endif
 !
       if (dt > 0.37*ci) then
          write (*,*) 'Warning: Courant condition may be exceeded!'
@@ -265,6 +287,129 @@
          go to 3000
       endif
 !
+! finite difference time domain solver replaces the ffts and spectral
+! field solver, using only nearest neighbor data after the first step
+      if (fdtd==1) then
+! deposit charge with standard procedure: updates qe
+         call dtimer(dtime,itime,-1)
+         qe = 0.0
+         call PPGPOST32L(part,qe,npp,noff,qme,idimp,npmax,nxe,nypmx,    &
+     &nzpmx,idds)
+         call dtimer(dtime,itime,1)
+         time = real(dtime)
+         tdpost = tdpost + time
+!
+! add and copy guard cells with standard procedure: updates cue
+         call dtimer(dtime,itime,-1)
+         call PPACGUARD32XL(cue,nyzp,nx,ndim,nxe,nypmx,nzpmx,idds)
+         call PPNACGUARD32L(cue,scs,scr,nyzp,ndim,kstrt,nvpy,nvpz,nx,nxe&
+     &,nypmx,nzpmx,idds)
+         call PPNCGUARD32L(cue,scs,nyzp,kstrt,nvpy,nvpz,nnxe,nypmx,nzpmx&
+     &,idds)
+         call PPCGUARD32XL(cue,nyzp,nx,ndim,nxe,nypmx,nzpmx,idds)
+         call dtimer(dtime,itime,1)
+         time = real(dtime)
+         tguard = tguard + time
+!
+! initialize electric field on yee mesh from the charge density
+! updates eyee, wf, wm, modifies qe
+         if (ntime==0) then
+            call dtimer(dtime,itime,-1)
+            call PPAGUARD32XL(qe,nyzp,nx,nxe,nypmx,nzpmx,idds)
+            call PPNAGUARD32L(qe,scs,scr,nyzp,kstrt,nvpy,nvpz,nx,nxe,   &
+     &nypmx,nzpmx,idds)
+            call dtimer(dtime,itime,1)
+            time = real(dtime)
+            tguard = tguard + time
+! transform charge to fourier space and find potential
+            call dtimer(dtime,itime,-1)
+            isign = -1
+            call WPPFFT32R(qe,qs,qt,bs,br,isign,ntpose,ltpose,mixup,sct,&
+     &ttp,indx,indy,indz,kstrt,nvpy,nvpz,nxeh,nye,nze,kxyp,kyp,kyzp,kzp,&
+     &kxyp,nypmx,kyzp,nzpmx,kzyp,nxhyz,nxyzh)
+            call PPYEEPOT32(qt,affp,nx,ny,nz,kstrt,nvpy,nvpz,nze,kxyp,  &
+     &kyzp)
+            isign = 1
+            call WPPFFT32R(qe,qs,qt,bs,br,isign,ntpose,ltpose,mixup,sct,&
+     &ttp,indx,indy,indz,kstrt,nvpy,nvpz,nxeh,nye,nze,kxyp,kyp,kyzp,kzp,&
+     &kxyp,nypmx,kyzp,nzpmx,kzyp,nxhyz,nxyzh)
+            call dtimer(dtime,itime,1)
+            time = real(dtime)
+            tfft(1) = tfft(1) + time
+            tfft(2) = tfft(2) + ttp
+! electric field is minus the gradient of the potential
+            call dtimer(dtime,itime,-1)
+            call PPNCGUARD32L(qe,scs,nyzp,kstrt,nvpy,nvpz,nxe,nypmx,    &
+     &nzpmx,idds)
+            call PPCGUARD32XL(qe,nyzp,nx,1,nxe,nypmx,nzpmx,idds)
+            call PPYEECLEAN32L(eyee,qe,-1.0,affp,wf,nyzp,nx,nxe,nypmx,  &
+     &nzpmx,idds)
+            call PPNCGUARD32L(eyee,scs,nyzp,kstrt,nvpy,nvpz,nnxe,nypmx, &
+     &nzpmx,idds)
+            call PPCGUARD32XL(eyee,nyzp,nx,ndim,nxe,nypmx,nzpmx,idds)
+            wm = 0.0
+            dth = 0.5*dt
+         else
+! calculate electromagnetic fields on yee mesh with standard procedure:
+! updates eyee, byee, wf, wm
+            call dtimer(dtime,itime,-1)
+! update magnetic field half time step
+            call PPYEEBH32L(eyee,byee,affp,ci,dth,wm,nyzp,nx,nxe,nypmx, &
+     &nzpmx,idds)
+! calculate curl of magnetic field and add guard cells
+            cyee = 0.0
+            call PPYEECURL32L(byee,cyee,nyzp,nx,nxe,nypmx,nzpmx,idds)
+            call PPACGUARD32XL(cyee,nyzp,nx,ndim,nxe,nypmx,nzpmx,idds)
+            call PPNACGUARD32L(cyee,scs,scr,nyzp,ndim,kstrt,nvpy,nvpz,nx&
+     &,nxe,nypmx,nzpmx,idds)
+! update electric field whole time step and copy guard cells
+            call PPYEEE32L(eyee,cyee,cue,affp,ci,dt,wf,nyzp,nx,nxe,nypmx&
+     &,nzpmx,idds)
+            call PPNCGUARD32L(eyee,scs,nyzp,kstrt,nvpy,nvpz,nnxe,nypmx, &
+     &nzpmx,idds)
+            call PPCGUARD32XL(eyee,nyzp,nx,ndim,nxe,nypmx,nzpmx,idds)
+! remove error in gauss's law with marder's divergence cleaning:
+! updates eyee, wf, modifies qe
+            call PPYEEDIV32L(eyee,qe,affp,nyzp,nx,nxe,nypmx,nzpmx,idds)
+            call PPAGUARD32XL(qe,nyzp,nx,nxe,nypmx,nzpmx,idds)
+            call PPNAGUARD32L(qe,scs,scr,nyzp,kstrt,nvpy,nvpz,nx,nxe,   &
+     &nypmx,nzpmx,idds)
+            call PPNCGUARD32L(qe,scs,nyzp,kstrt,nvpy,nvpz,nxe,nypmx,    &
+     &nzpmx,idds)
+            call PPCGUARD32XL(qe,nyzp,nx,1,nxe,nypmx,nzpmx,idds)
+            call PPYEECLEAN32L(eyee,qe,dmr,affp,wf,nyzp,nx,nxe,nypmx,   &
+     &nzpmx,idds)
+            call PPNCGUARD32L(eyee,scs,nyzp,kstrt,nvpy,nvpz,nnxe,nypmx, &
+     &nzpmx,idds)
+            call PPCGUARD32XL(eyee,nyzp,nx,ndim,nxe,nypmx,nzpmx,idds)
+! update magnetic field half time step
+            call PPYEEBH32L(eyee,byee,affp,ci,dth,wm,nyzp,nx,nxe,nypmx, &
+     &nzpmx,idds)
+         endif
+         we = 0.0
+!
+! average fields to grid points with standard procedure:
+! updates fxyze, bxyze
+         fxyze = 0.0
+         bxyze = 0.0
+         isign = 1
+         call PPYEEFIELD32L(fxyze,eyee,isign,nyzp,nx,nxe,nypmx,nzpmx,   &
+     &idds)
+         isign = -1
+         call PPYEEFIELD32L(bxyze,byee,isign,nyzp,nx,nxe,nypmx,nzpmx,   &
+     &idds)
+         call PPACGUARD32XL(fxyze,nyzp,nx,ndim,nxe,nypmx,nzpmx,idds)
+         call PPNACGUARD32L(fxyze,scs,scr,nyzp,ndim,kstrt,nvpy,nvpz,nx, &
+     &nxe,nypmx,nzpmx,idds)
+         call PPACGUARD32XL(bxyze,nyzp,nx,ndim,nxe,nypmx,nzpmx,idds)
+         call PPNACGUARD32L(bxyze,scs,scr,nyzp,ndim,kstrt,nvpy,nvpz,nx, &
+     &nxe,nypmx,nzpmx,idds)
+         call dtimer(dtime,itime,1)
+         time = real(dtime)
+         tfield = tfield + time
+         go to 1000
+      endif
+!
 ! deposit charge with standard procedure: updates qe
       call dtimer(dtime,itime,-1)
       qe = 0.0
@@ -292,9 +437,9 @@
 ! modifies qe
       call dtimer(dtime,itime,-1)
       isign = -1
-      call WPPFFT32R(qe,qs,qt,bs,br,isign,ntpose,mixup,sct,ttp,indx,indy&
-     &,indz,kstrt,nvpy,nvpz,nxeh,nye,nze,kxyp,kyp,kyzp,kzp,kxyp,nypmx,  &
-     &kyzp,nzpmx,kzyp,nxhyz,nxyzh)
+      call WPPFFT32R(qe,qs,qt,bs,br,isign,ntpose,ltpose,mixup,sct,ttp,  &
+     &indx,indy,indz,kstrt,nvpy,nvpz,nxeh,nye,nze,kxyp,kyp,kyzp,kzp,kxyp&
+     &,nypmx,kyzp,nzpmx,kzyp,nxhyz,nxyzh)
       call dtimer(dtime,itime,1)
       time = real(dtime)
       tfft(1) = tfft(1) + time
@@ -304,9 +449,9 @@
 ! modifies cue
       call dtimer(dtime,itime,-1)
       isign = -1
-      call WPPFFT32R3(cue,fxyzs,cut,bs,br,isign,ntpose,mixup,sct,ttp,   &
-     &indx,indy,indz,kstrt,nvpy,nvpz,nxeh,nye,nze,kxyp,kyp,kyzp,kzp,kxyp&
-     &,nypmx,kyzp,nzpmx,kzyp,nxhyz,nxyzh)
+      call WPPFFT32R3(cue,fxyzs,cut,bs,br,isign,ntpose,ltpose,mixup,sct,&
+     &ttp,indx,indy,indz,kstrt,nvpy,nvpz,nxeh,nye,nze,kxyp,kyp,kyzp,kzp,&
+     &kxyp,nypmx,kyzp,nzpmx,kzyp,nxhyz,nxyzh)
       call dtimer(dtime,itime,1)
       time = real(dtime)
       tfft(1) = tfft(1) + time
@@ -363,9 +508,9 @@
 ! updates fxyze, modifies fxyzt
       call dtimer(dtime,itime,-1)
       isign = 1
-      call WPPFFT32R3(fxyze,fxyzs,fxyzt,bs,br,isign,ntpose,mixup,sct,ttp&
-     &,indx,indy,indz,kstrt,nvpy,nvpz,nxeh,nye,nze,kxyp,kyp,kyzp,kzp,   &
-     &kxyp,nypmx,kyzp,nzpmx,kzyp,nxhyz,nxyzh)
+      call WPPFFT32R3(fxyze,fxyzs,fxyzt,bs,br,isign,ntpose,ltpose,mixup,&
+     &sct,ttp,indx,indy,indz,kstrt,nvpy,nvpz,nxeh,nye,nze,kxyp,kyp,kyzp,&
+     &kzp,kxyp,nypmx,kyzp,nzpmx,kzyp,nxhyz,nxyzh)
       call dtimer(dtime,itime,1)
       time = real(dtime)
       tfft(1) = tfft(1) + time
@@ -375,16 +520,16 @@
 ! updates bxyze, modifies bxyzt
       call dtimer(dtime,itime,-1)
       isign = 1
-      call WPPFFT32R3(bxyze,fxyzs,bxyzt,bs,br,isign,ntpose,mixup,sct,ttp&
-     &,indx,indy,indz,kstrt,nvpy,nvpz,nxeh,nye,nze,kxyp,kyp,kyzp,kzp,   &
-     &kxyp,nypmx,kyzp,nzpmx,kzyp,nxhyz,nxyzh)
+      call WPPFFT32R3(bxyze,fxyzs,bxyzt,bs,br,isign,ntpose,ltpose,mixup,&
+     &sct,ttp,indx,indy,indz,kstrt,nvpy,nvpz,nxeh,nye,nze,kxyp,kyp,kyzp,&
+     &kzp,kxyp,nypmx,kyzp,nzpmx,kzyp,nxhyz,nxyzh)
       call dtimer(dtime,itime,1)
       time = real(dtime)
       tfft(1) = tfft(1) + time
       tfft(2) = tfft(2) + ttp
 !
 ! copy guard cells with standard procedure: updates fxyze, bxyze
-      call dtimer(dtime,itime,-1)
+ 1000 call dtimer(dtime,itime,-1)
       call PPNCGUARD32L(fxyze,scs,nyzp,kstrt,nvpy,nvpz,nnxe,nypmx,nzpmx,&
      &idds)
       call PPCGUARD32XL(fxyze,nyzp,nx,ndim,nxe,nypmx,nzpmx,idds)
@@ -2869,6 +2869,491 @@ c mode numbers kz = 0, nz/2
       endif
       return
       end
+c-----------------------------------------------------------------------
+      subroutine PPYEEBH32L(exyz,bxyz,affp,ci,dtb,wm,nyzp,nx,nxe,nypmx, 
+     1nzpmx,idds)
+c this subroutine advances the magnetic field on a staggered (yee) mesh
+c in real space by a time step dtb, using the equations:
+c bx(j,k,l) = bx(j,k,l) - dtb*(ez(j,k+1,l) - ez(j,k,l)
+c                            - ey(j,k,l+1) + ey(j,k,l))
+c by(j,k,l) = by(j,k,l) - dtb*(ex(j,k,l+1) - ex(j,k,l)
+c                            - ez(j+1,k,l) + ez(j,k,l))
+c bz(j,k,l) = bz(j,k,l) - dtb*(ey(j+1,k,l) - ey(j,k,l)
+c                            - ex(j,k+1,l) + ex(j,k,l))
+c where ex/ey/ez are located at (j+1/2,k,l)/(j,k+1/2,l)/(j,k,l+1/2)
+c and bx/by/bz are located at (j,k+1/2,l+1/2)/(j+1/2,k,l+1/2)/
+c (j+1/2,k+1/2,l), in units of the grid spacing.
+c only nearest neighbor data is used, so the guard cells of exyz in
+c x, y and z must be current, e.g., by calling PPNCGUARD32L and
+c PPCGUARD32XL after the electric field is updated.
+c magnetic field energy is also calculated, using
+c wm = sum((c2/affp)*0.5*|bxyz(j,k,l)|**2)
+c input: all, output: wm, bxyz
+c approximate flop count is: 27*nx*nyp*nzp
+c exyz(i,j,k,l) = i-th component of electric field
+c bxyz(i,j,k,l) = i-th component of magnetic field
+c affp = normalization constant = nx*ny*nz/np,
+c where np=number of particles
+c ci = reciprocal of velocity of light
+c dtb = time interval for magnetic field update
+c nyzp(1:2) = number of primary (complete) gridpoints in y/z
+c nx = system length in x direction
+c nxe = second dimension of field arrays, must be >= nx+1
+c nypmx = maximum size of particle partition in y, including guard cells
+c nzpmx = maximum size of particle partition in z, including guard cells
+c idds = dimensionality of domain decomposition = 2
+      implicit none
+      integer nx, nxe, nypmx, nzpmx, idds
+      integer nyzp
+      real affp, ci, dtb, wm
+      real exyz, bxyz
+      dimension exyz(3,nxe,nypmx,nzpmx), bxyz(3,nxe,nypmx,nzpmx)
+      dimension nyzp(idds)
+c local data
+      integer j, k, l, nyp, nzp
+      real anorm, at1, at2, at3
+      double precision wp
+      if (ci.le.0.0) return
+      nyp = nyzp(1)
+      nzp = nyzp(2)
+      anorm = 0.5/(ci*ci*affp)
+      wp = 0.0d0
+      do 30 l = 1, nzp
+      do 20 k = 1, nyp
+      do 10 j = 1, nx
+      at1 = bxyz(1,j,k,l) - dtb*(exyz(3,j,k+1,l) - exyz(3,j,k,l)        
+     1                         - exyz(2,j,k,l+1) + exyz(2,j,k,l))
+      at2 = bxyz(2,j,k,l) - dtb*(exyz(1,j,k,l+1) - exyz(1,j,k,l)        
+     1                         - exyz(3,j+1,k,l) + exyz(3,j,k,l))
+      at3 = bxyz(3,j,k,l) - dtb*(exyz(2,j+1,k,l) - exyz(2,j,k,l)        
+     1                         - exyz(1,j,k+1,l) + exyz(1,j,k,l))
+      bxyz(1,j,k,l) = at1
+      bxyz(2,j,k,l) = at2
+      bxyz(3,j,k,l) = at3
+      wp = wp + (at1*at1 + at2*at2 + at3*at3)
+   10 continue
+   20 continue
+   30 continue
+      wm = anorm*wp
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPYEECURL32L(bxyz,cxyz,nyzp,nx,nxe,nypmx,nzpmx,idds)
+c this subroutine calculates the curl of the magnetic field on a
+c staggered (yee) mesh in real space, using backward differences:
+c cx(j,k,l) = bz(j,k,l) - bz(j,k-1,l) - by(j,k,l) + by(j,k,l-1)
+c cy(j,k,l) = bx(j,k,l) - bx(j,k,l-1) - bz(j,k,l) + bz(j-1,k,l)
+c cz(j,k,l) = by(j,k,l) - by(j-1,k,l) - bx(j,k,l) + bx(j,k-1,l)
+c so that cx/cy/cz are located at the same points as ex/ey/ez.
+c rather than reading guard cells from the lower neighbors, each value
+c of bxyz is scattered to the points which use it, including the guard
+c cells at nx+1, nyzp(1)+1 and nyzp(2)+1.  cxyz must be zeroed before,
+c and the guard cells added afterwards with PPACGUARD32XL and
+c PPNACGUARD32L.
+c input: all, output: cxyz
+c approximate flop count is: 15*nx*nyp*nzp
+c bxyz(i,j,k,l) = i-th component of magnetic field
+c cxyz(i,j,k,l) = i-th component of curl of magnetic field
+c nyzp(1:2) = number of primary (complete) gridpoints in y/z
+c nx = system length in x direction
+c nxe = second dimension of field arrays, must be >= nx+1
+c nypmx = maximum size of particle partition in y, including guard cells
+c nzpmx = maximum size of particle partition in z, including guard cells
+c idds = dimensionality of domain decomposition = 2
+      implicit none
+      integer nx, nxe, nypmx, nzpmx, idds
+      integer nyzp
+      real bxyz, cxyz
+      dimension bxyz(3,nxe,nypmx,nzpmx), cxyz(3,nxe,nypmx,nzpmx)
+      dimension nyzp(idds)
+c local data
+      integer j, k, l, nyp, nzp
+      real at1, at2, at3
+      nyp = nyzp(1)
+      nzp = nyzp(2)
+      do 30 l = 1, nzp
+      do 20 k = 1, nyp
+      do 10 j = 1, nx
+      at1 = bxyz(1,j,k,l)
+      at2 = bxyz(2,j,k,l)
+      at3 = bxyz(3,j,k,l)
+      cxyz(1,j,k,l) = cxyz(1,j,k,l) + (at3 - at2)
+      cxyz(2,j,k,l) = cxyz(2,j,k,l) + (at1 - at3)
+      cxyz(3,j,k,l) = cxyz(3,j,k,l) + (at2 - at1)
+      cxyz(2,j+1,k,l) = cxyz(2,j+1,k,l) + at3
+      cxyz(3,j+1,k,l) = cxyz(3,j+1,k,l) - at2
+      cxyz(1,j,k+1,l) = cxyz(1,j,k+1,l) - at3
+      cxyz(3,j,k+1,l) = cxyz(3,j,k+1,l) + at1
+      cxyz(1,j,k,l+1) = cxyz(1,j,k,l+1) + at2
+      cxyz(2,j,k,l+1) = cxyz(2,j,k,l+1) - at1
+   10 continue
+   20 continue
+   30 continue
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPYEEE32L(exyz,cxyz,cu,affp,ci,dt,wf,nyzp,nx,nxe,nypmx,
+     1nzpmx,idds)
+c this subroutine advances the electric field on a staggered (yee) mesh
+c in real space by a time step dt, using the equations:
+c ex(j,k,l) = ex(j,k,l) + c2*dt*cx(j,k,l)
+c                       - affp*dt*0.5*(cux(j,k,l) + cux(j+1,k,l))
+c ey(j,k,l) = ey(j,k,l) + c2*dt*cy(j,k,l)
+c                       - affp*dt*0.5*(cuy(j,k,l) + cuy(j,k+1,l))
+c ez(j,k,l) = ez(j,k,l) + c2*dt*cz(j,k,l)
+c                       - affp*dt*0.5*(cuz(j,k,l) + cuz(j,k,l+1))
+c where cxyz is the curl of the magnetic field from PPYEECURL32L, with
+c guard cells added, and the current density, deposited at the grid
+c points, is interpolated to the locations of the electric field.
+c the guard cells of cu must be current, e.g., by calling PPNCGUARD32L
+c and PPCGUARD32XL after the guard cells are added.
+c electric field energy is also calculated, using
+c wf = sum((1/affp)*0.5*|exyz(j,k,l)|**2)
+c input: all, output: wf, exyz
+c approximate flop count is: 24*nx*nyp*nzp
+c where c2 = 1./(ci*ci)
+c exyz(i,j,k,l) = i-th component of electric field
+c cxyz(i,j,k,l) = i-th component of curl of magnetic field
+c cu(i,j,k,l) = i-th component of current density
+c affp = normalization constant = nx*ny*nz/np,
+c where np=number of particles
+c ci = reciprocal of velocity of light
+c dt = time interval between successive calculations
+c nyzp(1:2) = number of primary (complete) gridpoints in y/z
+c nx = system length in x direction
+c nxe = second dimension of field arrays, must be >= nx+1
+c nypmx = maximum size of particle partition in y, including guard cells
+c nzpmx = maximum size of particle partition in z, including guard cells
+c idds = dimensionality of domain decomposition = 2
+      implicit none
+      integer nx, nxe, nypmx, nzpmx, idds
+      integer nyzp
+      real affp, ci, dt, wf
+      real exyz, cxyz, cu
+      dimension exyz(3,nxe,nypmx,nzpmx), cxyz(3,nxe,nypmx,nzpmx)
+      dimension cu(3,nxe,nypmx,nzpmx)
+      dimension nyzp(idds)
+c local data
+      integer j, k, l, nyp, nzp
+      real cdt, adt, anorm, at1, at2, at3
+      double precision ws
+      if (ci.le.0.0) return
+      nyp = nyzp(1)
+      nzp = nyzp(2)
+      cdt = dt/(ci*ci)
+      adt = 0.5*affp*dt
+      anorm = 0.5/affp
+      ws = 0.0d0
+      do 30 l = 1, nzp
+      do 20 k = 1, nyp
+      do 10 j = 1, nx
+      at1 = exyz(1,j,k,l) + cdt*cxyz(1,j,k,l)                           
+     1    - adt*(cu(1,j,k,l) + cu(1,j+1,k,l))
+      at2 = exyz(2,j,k,l) + cdt*cxyz(2,j,k,l)                           
+     1    - adt*(cu(2,j,k,l) + cu(2,j,k+1,l))
+      at3 = exyz(3,j,k,l) + cdt*cxyz(3,j,k,l)                           
+     1    - adt*(cu(3,j,k,l) + cu(3,j,k,l+1))
+      exyz(1,j,k,l) = at1
+      exyz(2,j,k,l) = at2
+      exyz(3,j,k,l) = at3
+      ws = ws + (at1*at1 + at2*at2 + at3*at3)
+   10 continue
+   20 continue
+   30 continue
+      wf = anorm*ws
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPYEEFIELD32L(fxyz,exyz,isign,nyzp,nx,nxe,nypmx,nzpmx, 
+     1idds)
+c this subroutine averages a vector field on a staggered (yee) mesh to
+c the grid points used by the particle push.
+c if isign > 0, exyz is an electric field, located at the edges
+c (j+1/2,k,l)/(j,k+1/2,l)/(j,k,l+1/2), and two values are averaged
+c if isign < 0, exyz is a magnetic field, located at the faces
+c (j,k+1/2,l+1/2)/(j+1/2,k,l+1/2)/(j+1/2,k+1/2,l), and four values are
+c averaged
+c each value of exyz is scattered to the grid points which use it,
+c including the guard cells at nx+1, nyzp(1)+1 and nyzp(2)+1.  fxyz
+c must be zeroed before, and the guard cells added afterwards with
+c PPACGUARD32XL and PPNACGUARD32L.
+c input: all, output: fxyz
+c fxyz(i,j,k,l) = i-th component of field at grid points
+c exyz(i,j,k,l) = i-th component of field on yee mesh
+c nyzp(1:2) = number of primary (complete) gridpoints in y/z
+c nx = system length in x direction
+c nxe = second dimension of field arrays, must be >= nx+1
+c nypmx = maximum size of particle partition in y, including guard cells
+c nzpmx = maximum size of particle partition in z, including guard cells
+c idds = dimensionality of domain decomposition = 2
+      implicit none
+      integer isign, nx, nxe, nypmx, nzpmx, idds
+      integer nyzp
+      real fxyz, exyz
+      dimension fxyz(3,nxe,nypmx,nzpmx), exyz(3,nxe,nypmx,nzpmx)
+      dimension nyzp(idds)
+c local data
+      integer j, k, l, nyp, nzp
+      real at1, at2, at3
+      nyp = nyzp(1)
+      nzp = nyzp(2)
+c average electric field from edges
+      if (isign.gt.0) then
+         do 30 l = 1, nzp
+         do 20 k = 1, nyp
+         do 10 j = 1, nx
+         at1 = 0.5*exyz(1,j,k,l)
+         at2 = 0.5*exyz(2,j,k,l)
+         at3 = 0.5*exyz(3,j,k,l)
+         fxyz(1,j,k,l) = fxyz(1,j,k,l) + at1
+         fxyz(2,j,k,l) = fxyz(2,j,k,l) + at2
+         fxyz(3,j,k,l) = fxyz(3,j,k,l) + at3
+         fxyz(1,j+1,k,l) = fxyz(1,j+1,k,l) + at1
+         fxyz(2,j,k+1,l) = fxyz(2,j,k+1,l) + at2
+         fxyz(3,j,k,l+1) = fxyz(3,j,k,l+1) + at3
+   10    continue
+   20    continue
+   30    continue
+c average magnetic field from faces
+      else if (isign.lt.0) then
+         do 60 l = 1, nzp
+         do 50 k = 1, nyp
+         do 40 j = 1, nx
+         at1 = 0.25*exyz(1,j,k,l)
+         at2 = 0.25*exyz(2,j,k,l)
+         at3 = 0.25*exyz(3,j,k,l)
+         fxyz(1,j,k,l) = fxyz(1,j,k,l) + at1
+         fxyz(2,j,k,l) = fxyz(2,j,k,l) + at2
+         fxyz(3,j,k,l) = fxyz(3,j,k,l) + at3
+         fxyz(1,j,k+1,l) = fxyz(1,j,k+1,l) + at1
+         fxyz(1,j,k,l+1) = fxyz(1,j,k,l+1) + at1
+         fxyz(1,j,k+1,l+1) = fxyz(1,j,k+1,l+1) + at1
+         fxyz(2,j+1,k,l) = fxyz(2,j+1,k,l) + at2
+         fxyz(2,j,k,l+1) = fxyz(2,j,k,l+1) + at2
+         fxyz(2,j+1,k,l+1) = fxyz(2,j+1,k,l+1) + at2
+         fxyz(3,j+1,k,l) = fxyz(3,j+1,k,l) + at3
+         fxyz(3,j,k+1,l) = fxyz(3,j,k+1,l) + at3
+         fxyz(3,j+1,k+1,l) = fxyz(3,j+1,k+1,l) + at3
+   40    continue
+   50    continue
+   60    continue
+      endif
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPYEEPOT32(q,affp,nx,ny,nz,kstrt,nvpy,nvpz,nzv,kxyp,   
+     1kyzp)
+c this subroutine solves 3d poisson's equation in fourier space for
+c the potential with periodic boundary conditions for distributed data,
+c with 2D spatial decomposition, using the finite difference laplacian
+c of the staggered (yee) mesh, so that the electric field calculated
+c from the potential with PPYEECLEAN32L satisfies gauss's law on the
+c yee mesh exactly.  q is replaced by the potential.
+c input: all, output: q
+c approximate flop count is: 10*nxc*nyc*nzc
+c where nxc = (nx/2-1)/nvpy, nyc = (ny-1)/nvpz, nzc = nz
+c the equation used is:
+c pot(kx,ky,kz) = affp*q(kx,ky,kz)/(dkx**2+dky**2+dkz**2),
+c where dkx = 2*sin(kx/2), dky = 2*sin(ky/2), dkz = 2*sin(kz/2), and
+c kx = 2pi*j/nx, ky = 2pi*k/ny, kz = 2pi*l/nz, and
+c j,k,l = fourier mode numbers, except for pot(kx=0,ky=0,kz=0) = 0.
+c the modes kx = pi, ky = pi and kz = pi are kept, since the finite
+c difference laplacian is well defined there.
+c q(l,j,k) = complex charge density for fourier mode jj-1,kk-1,l-1
+c on output, complex potential for fourier mode jj-1,kk-1,l-1,
+c where jj = j + kxyp*js and kk = k + kyzp*ks, and MPI rank
+c idproc = js + nvpy*ks
+c affp = normalization constant = nx*ny*nz/np,
+c where np=number of particles
+c nx/ny/nz = system length in x/y/z direction
+c kstrt = starting data block number
+c nvpy/nvpz = number of real or virtual processors in y/z
+c nzv = first dimension of field arrays, must be >= nz
+c kxyp/kyzp = number of complex grids in each field partition in
+c x/y direction
+      implicit none
+      integer nx, ny, nz, kstrt, nvpy, nvpz, nzv, kxyp, kyzp
+      real affp
+      complex q
+      dimension q(nzv,kxyp,kyzp)
+c local data
+      integer j, k, l, nxh, nyh, nzh, js, ks, joff, koff
+      integer kxyps, kyzps, k1, lt
+      real dnx, dny, dnz, at1, at2, at3, at4
+      nxh = nx/2
+      nyh = max(1,ny/2)
+      nzh = max(1,nz/2)
+      dnx = 3.14159265358979/real(nx)
+      dny = 3.14159265358979/real(ny)
+      dnz = 3.14159265358979/real(nz)
+c find processor id and offsets in y/z
+c js/ks = processor co-ordinates in x/y => idproc = js + nvpy*ks
+      ks = (kstrt - 1)/nvpy
+      js = kstrt - nvpy*ks - 1
+      joff = kxyp*js
+      kxyps = min(kxyp,max(0,nxh-joff))
+      joff = joff - 1
+      koff = kyzp*ks
+      kyzps = min(kyzp,max(0,ny-koff))
+      koff = koff - 1
+      if (kstrt.gt.(nvpy*nvpz)) return
+c calculate potential
+      do 30 k = 1, kyzps
+      k1 = k + koff
+      at1 = (2.0*sin(dny*real(k1)))**2
+      do 20 j = 1, kxyps
+      at2 = (2.0*sin(dnx*real(j + joff)))**2 + at1
+c mode kx = nx/2 is stored with kx = 0, for ky > ny/2, and for
+c ky = 0, ny/2 and kz > nz/2
+      lt = nz + 1
+      if ((j+joff).eq.0) then
+         if (k1.gt.nyh) then
+            lt = 1
+         else if ((k1.eq.0).or.(k1.eq.nyh)) then
+            lt = nzh + 2
+         endif
+      endif
+      do 10 l = 1, nz
+      at3 = (2.0*sin(dnz*real(l - 1)))**2 + at2
+c for ky = 0, ny/2, mode kx = nx/2 for kz = 0, nz/2 is stored in the
+c imaginary part of kx = 0
+      if ((lt.eq.(nzh+2)).and.((l.eq.1).or.(l.eq.(nzh+1)))) then
+         at4 = affp/(at3 + 4.0)
+         if (at3.gt.0.0) at3 = affp/at3
+         q(l,j,k) = cmplx(at3*real(q(l,j,k)),at4*aimag(q(l,j,k)))
+      else
+         if (l.ge.lt) at3 = at3 + 4.0
+         if (at3.gt.0.0) at3 = affp/at3
+         q(l,j,k) = at3*q(l,j,k)
+      endif
+   10 continue
+   20 continue
+   30 continue
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPYEEDIV32L(exyz,q,affp,nyzp,nx,nxe,nypmx,nzpmx,idds)
+c this subroutine calculates the error in gauss's law on a staggered
+c (yee) mesh in real space, using backward differences:
+c q(j,k,l) = ex(j,k,l) - ex(j-1,k,l) + ey(j,k,l) - ey(j,k-1,l)
+c          + ez(j,k,l) - ez(j,k,l-1) - affp*q(j,k,l)
+c where ex/ey/ez are located at (j+1/2,k,l)/(j,k+1/2,l)/(j,k,l+1/2)
+c and q is located at the grid points.
+c q on input is the charge density deposited by PPGPOST32L, before the
+c guard cells are added.  rather than reading guard cells from the lower
+c neighbors, each value of exyz is scattered to the points which use
+c it, including the guard cells at nx+1, nyzp(1)+1 and nyzp(2)+1.  the
+c guard cells are added afterwards with PPAGUARD32XL and PPNAGUARD32L.
+c input: all, output: q
+c approximate flop count is: 7*nx*nyp*nzp
+c exyz(i,j,k,l) = i-th component of electric field
+c q(j,k,l) = charge density on input, error in gauss's law on output
+c affp = normalization constant = nx*ny*nz/np,
+c where np=number of particles
+c nyzp(1:2) = number of primary (complete) gridpoints in y/z
+c nx = system length in x direction
+c nxe = second dimension of field arrays, must be >= nx+1
+c nypmx = maximum size of particle partition in y, including guard cells
+c nzpmx = maximum size of particle partition in z, including guard cells
+c idds = dimensionality of domain decomposition = 2
+      implicit none
+      integer nx, nxe, nypmx, nzpmx, idds
+      integer nyzp
+      real affp
+      real exyz, q
+      dimension exyz(3,nxe,nypmx,nzpmx), q(nxe,nypmx,nzpmx)
+      dimension nyzp(idds)
+c local data
+      integer j, k, l, nyp, nzp
+      real at1, at2, at3
+      nyp = nyzp(1)
+      nzp = nyzp(2)
+c charge density, including guard cells
+      do 30 l = 1, nzp+1
+      do 20 k = 1, nyp+1
+      do 10 j = 1, nx+1
+      q(j,k,l) = -affp*q(j,k,l)
+   10 continue
+   20 continue
+   30 continue
+c divergence of electric field
+      do 60 l = 1, nzp
+      do 50 k = 1, nyp
+      do 40 j = 1, nx
+      at1 = exyz(1,j,k,l)
+      at2 = exyz(2,j,k,l)
+      at3 = exyz(3,j,k,l)
+      q(j,k,l) = q(j,k,l) + (at1 + at2 + at3)
+      q(j+1,k,l) = q(j+1,k,l) - at1
+      q(j,k+1,l) = q(j,k+1,l) - at2
+      q(j,k,l+1) = q(j,k,l+1) - at3
+   40 continue
+   50 continue
+   60 continue
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPYEECLEAN32L(exyz,f,dmr,affp,wf,nyzp,nx,nxe,nypmx,    
+     1nzpmx,idds)
+c this subroutine corrects the electric field on a staggered (yee) mesh
+c in real space with the gradient of a scalar, using forward
+c differences:
+c ex(j,k,l) = ex(j,k,l) + dmr*(f(j+1,k,l) - f(j,k,l))
+c ey(j,k,l) = ey(j,k,l) + dmr*(f(j,k+1,l) - f(j,k,l))
+c ez(j,k,l) = ez(j,k,l) + dmr*(f(j,k,l+1) - f(j,k,l))
+c if f is the error in gauss's law from PPYEEDIV32L, this is marder's
+c divergence cleaning, which damps the error by diffusion.  it is
+c stable for 0 < dmr <= 1/6.  if exyz is zero, dmr = -1 and f is the
+c potential from PPYEEPOT32, this calculates the electrostatic field.
+c the guard cells of f in x, y and z must be current, e.g., by calling
+c PPNCGUARD32L and PPCGUARD32XL.
+c electric field energy is also calculated, using
+c wf = sum((1/affp)*0.5*|exyz(j,k,l)|**2)
+c input: all, output: wf, exyz
+c approximate flop count is: 15*nx*nyp*nzp
+c exyz(i,j,k,l) = i-th component of electric field
+c f(j,k,l) = scalar field at grid points
+c dmr = coefficient of gradient
+c affp = normalization constant = nx*ny*nz/np,
+c where np=number of particles
+c nyzp(1:2) = number of primary (complete) gridpoints in y/z
+c nx = system length in x direction
+c nxe = second dimension of field arrays, must be >= nx+1
+c nypmx = maximum size of particle partition in y, including guard cells
+c nzpmx = maximum size of particle partition in z, including guard cells
+c idds = dimensionality of domain decomposition = 2
+      implicit none
+      integer nx, nxe, nypmx, nzpmx, idds
+      integer nyzp
+      real dmr, affp, wf
+      real exyz, f
+      dimension exyz(3,nxe,nypmx,nzpmx), f(nxe,nypmx,nzpmx)
+      dimension nyzp(idds)
+c local data
+      integer j, k, l, nyp, nzp
+      real anorm, at1, at2, at3, at4
+      double precision ws
+      nyp = nyzp(1)
+      nzp = nyzp(2)
+      anorm = 0.5/affp
+      ws = 0.0d0
+      do 30 l = 1, nzp
+      do 20 k = 1, nyp
+      do 10 j = 1, nx
+      at4 = f(j,k,l)
+      at1 = exyz(1,j,k,l) + dmr*(f(j+1,k,l) - at4)
+      at2 = exyz(2,j,k,l) + dmr*(f(j,k+1,l) - at4)
+      at3 = exyz(3,j,k,l) + dmr*(f(j,k,l+1) - at4)
+      exyz(1,j,k,l) = at1
+      exyz(2,j,k,l) = at2
+      exyz(3,j,k,l) = at3
+      ws = ws + (at1*at1 + at2*at2 + at3*at3)
+   10 continue
+   20 continue
+   30 continue
+      wf = anorm*ws
+      return
+      end
 c-----------------------------------------------------------------------
       subroutine WPFFT32RINIT(mixup,sct,indx,indy,indz,nxhyzd,nxyzhd)
 c this subroutine calculates tables needed by a three dimensional
@@ -2920,24 +3405,26 @@ c sine/cosine table for the angles 2*n*pi/nxyz
       return
       end
 c-----------------------------------------------------------------------
-      subroutine WPPFFT32R(f,g,h,bs,br,isign,ntpose,mixup,sct,ttp,indx, 
-     1indy,indz,kstrt,nvpy,nvpz,nxvh,nyv,nzv,kxyp,kyp,kyzp,kzp,kxypd,   
-     2kypd,kyzpd,kzpd,kzyp,nxhyzd,nxyzhd)
+      subroutine WPPFFT32R(f,g,h,bs,br,isign,ntpose,ltpose,mixup,sct,  
+     1ttp,indx,indy,indz,kstrt,nvpy,nvpz,nxvh,nyv,nzv,kxyp,kyp,kyzp,kzp,
+     2kxypd,kypd,kyzpd,kzpd,kzyp,nxhyzd,nxyzhd)
 c wrapper function for 3d real to complex fft, with packed data
 c parallelized with MPI
       implicit none
-      integer isign, ntpose, indx, indy, indz, kstrt, nvpy, nvpz
+      integer isign, ntpose, ltpose, indx, indy, indz, kstrt, nvpy, nvpz
       integer nxvh, nyv, nzv, kxyp, kyp, kyzp, kzp
       integer kxypd, kypd, kyzpd, kzpd, kzyp, nxhyzd, nxyzhd
-      integer mixup
+      integer mixup, mreq
       real ttp
       complex f, g, h, bs, br, sct
       dimension f(nxvh,kypd,kzpd), g(nyv,kxypd,kzpd), h(nzv,kxypd,kyzpd)
       dimension bs(kxyp*kzyp,kzp), br(kxyp*kzyp,kzp)
       dimension mixup(nxhyzd), sct(nxyzhd)
+      dimension mreq(2*nvpz,max(1,ltpose))
 c local data
       integer nxh, ny, nz, kypi, kxypi, js, ks, kxypp, kypp, kzpp, nvp
-      real tp, tf
+      integer n, kxb, nxb, jxi, jxp
+      real tp, tf, tw
       double precision dtime
       data kypi, kxypi /1,1/
 c calculate range of indices
@@ -2951,6 +3438,10 @@ c js/ks = processor co-ordinates in y/z => idproc = js + nvpy*ks
       kypp = min(kyp,max(0,ny-kyp*js))
       kzpp = min(kzp,max(0,nz-kzp*ks))
       nvp = nvpy*nvpz
+c kxb/nxb = size/number of blocks in x for pipelined transpose
+      kxb = (kxypp - 1)/max(1,ltpose) + 1
+      nxb = 0
+      if (kxypp.gt.0) nxb = (kxypp - 1)/kxb + 1
 c inverse fourier transform
       if (isign.lt.0) then
 c perform x fft
@@ -2965,13 +3456,38 @@ c perform y fft
          call PPFFT32RXY(g,isign,mixup,sct,indx,indy,indz,kstrt,nvpy,   
      1nvpz,kxypi,kxypp,nyv,kzpp,kxypd,kzpd,nxhyzd,nxyzhd)
 c transpose g array to h
-         call PWTIMERA(-1,tp,dtime)
-         call PPTPOS3B(g,h,bs,br,nxh,ny,nz,kxyp,kyzp,kzp,kstrt,nvpy,nvpz
-     1,nyv,nzv,kxypd,kyzpd,kzpd)
-         call PWTIMERA(1,tp,dtime)
+         if (ltpose.eq.0) then
+            call PWTIMERA(-1,tp,dtime)
+            call PPTPOS3B(g,h,bs,br,nxh,ny,nz,kxyp,kyzp,kzp,kstrt,nvpy, 
+     1nvpz,nyv,nzv,kxypd,kyzpd,kzpd)
+            call PWTIMERA(1,tp,dtime)
 c perform z fft
-         call PPFFT32RXZ(h,isign,mixup,sct,indx,indy,indz,kstrt,nvpy,   
+            call PPFFT32RXZ(h,isign,mixup,sct,indx,indy,indz,kstrt,nvpy,
      1nvpz,kxypi,kxypp,nzv,kyzp,kxypd,kyzpd,nxhyzd,nxyzhd)
+c transpose g array to h in blocks of x, so that the z fft of each
+c block overlaps with the communication of the blocks which follow
+         else
+            call PWTIMERA(-1,tp,dtime)
+            do 10 n = 1, nxb
+            jxi = kxb*(n - 1) + 1
+            jxp = min(kxb,kxypp-jxi+1)
+            call PPNTPOS3BS(g,h,bs,br,mreq(1,n),nxh,ny,nz,kxyp,kyzp,
+     1kzp,kstrt,nvpy,nvpz,1,nyv,nzv,kxypd,kyzpd,kzpd,jxi,jxp)
+   10       continue
+            call PWTIMERA(1,tp,dtime)
+            do 20 n = 1, nxb
+            jxi = kxb*(n - 1) + 1
+            jxp = min(kxb,kxypp-jxi+1)
+            call PWTIMERA(-1,tw,dtime)
+            call PPNTPOS3BW(h,br,mreq(1,n),nxh,ny,nz,kxyp,kyzp,kzp,
+     1kstrt,nvpy,nvpz,1,nzv,kxypd,kyzpd,jxi,jxp)
+            call PWTIMERA(1,tw,dtime)
+            tp = tp + tw
+c perform z fft on block
+            call PPFFT32RXZ(h,isign,mixup,sct,indx,indy,indz,kstrt,
+     1nvpy,nvpz,jxi,jxp,nzv,kyzp,kxypd,kyzpd,nxhyzd,nxyzhd)
+   20       continue
+         endif
 c transpose h array to f
          if (ntpose.eq.0) then
             call PWTIMERA(-1,tf,dtime)
@@ -2993,13 +3509,41 @@ c transpose f array to h
             call PWTIMERA(1,tf,dtime)
          endif
 c perform z fft
-         call PPFFT32RXZ(h,isign,mixup,sct,indx,indy,indz,kstrt,nvpy,   
+         if (ltpose.eq.0) then
+            call PPFFT32RXZ(h,isign,mixup,sct,indx,indy,indz,kstrt,nvpy,
      1nvpz,kxypi,kxypp,nzv,kyzp,kxypd,kyzpd,nxhyzd,nxyzhd)
 c transpose h array to g
-         call PWTIMERA(-1,tp,dtime)
-         call PPTPOS3B(h,g,br,bs,nxh,nz,ny,kxyp,kzp,kyzp,kstrt,nvpy,nvpz
-     1,nzv,nyv,kxypd,kzpd,kyzpd)
-         call PWTIMERA(1,tp,dtime)
+            call PWTIMERA(-1,tp,dtime)
+            call PPTPOS3B(h,g,br,bs,nxh,nz,ny,kxyp,kzp,kyzp,kstrt,nvpy, 
+     1nvpz,nzv,nyv,kxypd,kzpd,kyzpd)
+            call PWTIMERA(1,tp,dtime)
+c perform z fft in blocks of x, so that the transpose of each block
+c to g overlaps with the z fft of the blocks which follow
+         else
+            tp = 0.0
+            do 30 n = 1, nxb
+            jxi = kxb*(n - 1) + 1
+            jxp = min(kxb,kxypp-jxi+1)
+c perform z fft on block
+            call PPFFT32RXZ(h,isign,mixup,sct,indx,indy,indz,kstrt,
+     1nvpy,nvpz,jxi,jxp,nzv,kyzp,kxypd,kyzpd,nxhyzd,nxyzhd)
+c transpose block of h array to g
+            call PWTIMERA(-1,tw,dtime)
+            call PPNTPOS3BS(h,g,br,bs,mreq(1,n),nxh,nz,ny,kxyp,kzp,
+     1kyzp,kstrt,nvpy,nvpz,1,nzv,nyv,kxypd,kzpd,kyzpd,jxi,jxp)
+            call PWTIMERA(1,tw,dtime)
+            tp = tp + tw
+   30       continue
+            call PWTIMERA(-1,tw,dtime)
+            do 40 n = 1, nxb
+            jxi = kxb*(n - 1) + 1
+            jxp = min(kxb,kxypp-jxi+1)
+            call PPNTPOS3BW(g,bs,mreq(1,n),nxh,nz,ny,kxyp,kzp,kyzp,
+     1kstrt,nvpy,nvpz,1,nyv,kxypd,kzpd,jxi,jxp)
+   40       continue
+            call PWTIMERA(1,tw,dtime)
+            tp = tp + tw
+         endif
 c perform y fft
          call PPFFT32RXY(g,isign,mixup,sct,indx,indy,indz,kstrt,nvpy,   
      1nvpz,kxypi,kxypp,nyv,kzpp,kxypd,kzpd,nxhyzd,nxyzhd)
@@ -3017,25 +3561,27 @@ c perform x fft
       return
       end
 c-----------------------------------------------------------------------
-      subroutine WPPFFT32R3(f,g,h,bs,br,isign,ntpose,mixup,sct,ttp,indx,
-     1indy,indz,kstrt,nvpy,nvpz,nxvh,nyv,nzv,kxyp,kyp,kyzp,kzp,kxypd,   
-     2kypd,kyzpd,kzpd,kzyp,nxhyzd,nxyzhd)
+      subroutine WPPFFT32R3(f,g,h,bs,br,isign,ntpose,ltpose,mixup,sct, 
+     1ttp,indx,indy,indz,kstrt,nvpy,nvpz,nxvh,nyv,nzv,kxyp,kyp,kyzp,kzp,
+     2kxypd,kypd,kyzpd,kzpd,kzyp,nxhyzd,nxyzhd)
 c wrapper function for 3 3d real to complex ffts, with packed data
 c parallelized with MPI
       implicit none
-      integer isign, ntpose, indx, indy, indz, kstrt, nvpy, nvpz
+      integer isign, ntpose, ltpose, indx, indy, indz, kstrt, nvpy, nvpz
       integer nxvh, nyv, nzv, kxyp, kyp, kyzp, kzp
       integer kxypd, kypd, kyzpd, kzpd, kzyp, nxhyzd, nxyzhd
-      integer mixup
+      integer mixup, mreq
       real ttp
       complex f, g, h, bs, br, sct
       dimension f(3,nxvh,kypd,kzpd), g(3,nyv,kxypd,kzpd)
       dimension h(3,nzv,kxypd,kyzpd)
       dimension bs(3,kxyp*kzyp,kzp), br(3,kxyp*kzyp,kzp)
       dimension mixup(nxhyzd), sct(nxyzhd)
+      dimension mreq(2*nvpz,max(1,ltpose))
 c local data
       integer nxh, ny, nz, kypi, kxypi, js, ks, kxypp, kypp, kzpp, nvp
-      real tp, tf
+      integer n, kxb, nxb, jxi, jxp
+      real tp, tf, tw
       double precision dtime
       data kypi, kxypi /1,1/
 c calculate range of indices
@@ -3049,6 +3595,10 @@ c js/ks = processor co-ordinates in y/z => idproc = js + nvpy*ks
       kypp = min(kyp,max(0,ny-kyp*js))
       kzpp = min(kzp,max(0,nz-kzp*ks))
       nvp = nvpy*nvpz
+c kxb/nxb = size/number of blocks in x for pipelined transpose
+      kxb = (kxypp - 1)/max(1,ltpose) + 1
+      nxb = 0
+      if (kxypp.gt.0) nxb = (kxypp - 1)/kxb + 1
 c inverse fourier transform
       if (isign.lt.0) then
 c perform x fft
@@ -3063,13 +3613,38 @@ c perform y fft
          call PPFFT32R3XY(g,isign,mixup,sct,indx,indy,indz,kstrt,nvpy,  
      1nvpz,kxypi,kxypp,nyv,kzpp,kxypd,kzpd,nxhyzd,nxyzhd)
 c transpose g array to h
-         call PWTIMERA(-1,tp,dtime)
-         call PPNTPOS3B(g,h,bs,br,nxh,ny,nz,kxyp,kyzp,kzp,kstrt,nvpy,   
+         if (ltpose.eq.0) then
+            call PWTIMERA(-1,tp,dtime)
+            call PPNTPOS3B(g,h,bs,br,nxh,ny,nz,kxyp,kyzp,kzp,kstrt,nvpy,
      1nvpz,3,nyv,nzv,kxypd,kyzpd,kzpd)
-         call PWTIMERA(1,tp,dtime)
+            call PWTIMERA(1,tp,dtime)
 c perform z fft
-         call PPFFT32R3XZ(h,isign,mixup,sct,indx,indy,indz,kstrt,nvpy,  
-     1nvpz,kxypi,kxypp,nzv,kyzp,kxypd,kyzpd,nxhyzd,nxyzhd)
+            call PPFFT32R3XZ(h,isign,mixup,sct,indx,indy,indz,kstrt,    
+     1nvpy,nvpz,kxypi,kxypp,nzv,kyzp,kxypd,kyzpd,nxhyzd,nxyzhd)
+c transpose g array to h in blocks of x, so that the z fft of each
+c block overlaps with the communication of the blocks which follow
+         else
+            call PWTIMERA(-1,tp,dtime)
+            do 10 n = 1, nxb
+            jxi = kxb*(n - 1) + 1
+            jxp = min(kxb,kxypp-jxi+1)
+            call PPNTPOS3BS(g,h,bs,br,mreq(1,n),nxh,ny,nz,kxyp,kyzp,
+     1kzp,kstrt,nvpy,nvpz,3,nyv,nzv,kxypd,kyzpd,kzpd,jxi,jxp)
+   10       continue
+            call PWTIMERA(1,tp,dtime)
+            do 20 n = 1, nxb
+            jxi = kxb*(n - 1) + 1
+            jxp = min(kxb,kxypp-jxi+1)
+            call PWTIMERA(-1,tw,dtime)
+            call PPNTPOS3BW(h,br,mreq(1,n),nxh,ny,nz,kxyp,kyzp,kzp,
+     1kstrt,nvpy,nvpz,3,nzv,kxypd,kyzpd,jxi,jxp)
+            call PWTIMERA(1,tw,dtime)
+            tp = tp + tw
+c perform z fft on block
+            call PPFFT32R3XZ(h,isign,mixup,sct,indx,indy,indz,kstrt,
+     1nvpy,nvpz,jxi,jxp,nzv,kyzp,kxypd,kyzpd,nxhyzd,nxyzhd)
+   20       continue
+         endif
 c transpose h array to f
          if (ntpose.eq.0) then
             call PWTIMERA(-1,tf,dtime)
@@ -3091,13 +3666,41 @@ c transpose f array to h
             call PWTIMERA(1,tf,dtime)
          endif
 c perform z fft
-         call PPFFT32R3XZ(h,isign,mixup,sct,indx,indy,indz,kstrt,nvpy,  
-     1nvpz,kxypi,kxypp,nzv,kyzp,kxypd,kyzpd,nxhyzd,nxyzhd)
+         if (ltpose.eq.0) then
+            call PPFFT32R3XZ(h,isign,mixup,sct,indx,indy,indz,kstrt,    
+     1nvpy,nvpz,kxypi,kxypp,nzv,kyzp,kxypd,kyzpd,nxhyzd,nxyzhd)
 c transpose h array to g
-         call PWTIMERA(-1,tp,dtime)
-         call PPNTPOS3B(h,g,br,bs,nxh,nz,ny,kxyp,kzp,kyzp,kstrt,nvpy,   
+            call PWTIMERA(-1,tp,dtime)
+            call PPNTPOS3B(h,g,br,bs,nxh,nz,ny,kxyp,kzp,kyzp,kstrt,nvpy,
      1nvpz,3,nzv,nyv,kxypd,kzpd,kyzpd)
-         call PWTIMERA(1,tp,dtime)
+            call PWTIMERA(1,tp,dtime)
+c perform z fft in blocks of x, so that the transpose of each block
+c to g overlaps with the z fft of the blocks which follow
+         else
+            tp = 0.0
+            do 30 n = 1, nxb
+            jxi = kxb*(n - 1) + 1
+            jxp = min(kxb,kxypp-jxi+1)
+c perform z fft on block
+            call PPFFT32R3XZ(h,isign,mixup,sct,indx,indy,indz,kstrt,
+     1nvpy,nvpz,jxi,jxp,nzv,kyzp,kxypd,kyzpd,nxhyzd,nxyzhd)
+c transpose block of h array to g
+            call PWTIMERA(-1,tw,dtime)
+            call PPNTPOS3BS(h,g,br,bs,mreq(1,n),nxh,nz,ny,kxyp,kzp,
+     1kyzp,kstrt,nvpy,nvpz,3,nzv,nyv,kxypd,kzpd,kyzpd,jxi,jxp)
+            call PWTIMERA(1,tw,dtime)
+            tp = tp + tw
+   30       continue
+            call PWTIMERA(-1,tw,dtime)
+            do 40 n = 1, nxb
+            jxi = kxb*(n - 1) + 1
+            jxp = min(kxb,kxypp-jxi+1)
+            call PPNTPOS3BW(g,bs,mreq(1,n),nxh,nz,ny,kxyp,kzp,kyzp,
+     1kstrt,nvpy,nvpz,3,nyv,kxypd,kzpd,jxi,jxp)
+   40       continue
+            call PWTIMERA(1,tw,dtime)
+            tp = tp + tw
+         endif
 c perform y fft
          call PPFFT32R3XY(g,isign,mixup,sct,indx,indy,indz,kstrt,nvpy,  
      1nvpz,kxypi,kxypp,nyv,kzpp,kxypd,kzpd,nxhyzd,nxyzhd)
@@ -83,6 +83,31 @@ void cppemfield32(float complex fxyz[], float complex exyz[],
                   int nz, int kstrt, int nvpy, int nvpz, int nzv,
                   int kxyp, int kyzp, int nzhd);
 
+void cppyeebh32l(float exyz[], float bxyz[], float affp, float ci,
+                 float dtb, float *wm, int nyzp[], int nx, int nxe,
+                 int nypmx, int nzpmx, int idds);
+
+void cppyeecurl32l(float bxyz[], float cxyz[], int nyzp[], int nx,
+                   int nxe, int nypmx, int nzpmx, int idds);
+
+void cppyeee32l(float exyz[], float cxyz[], float cu[], float affp,
+                float ci, float dt, float *wf, int nyzp[], int nx,
+                int nxe, int nypmx, int nzpmx, int idds);
+
+void cppyeefield32l(float fxyz[], float exyz[], int isign, int nyzp[],
+                    int nx, int nxe, int nypmx, int nzpmx, int idds);
+
+void cppyeepot32(float complex q[], float affp, int nx, int ny, int nz,
+                 int kstrt, int nvpy, int nvpz, int nzv, int kxyp,
+                 int kyzp);
+
+void cppyeediv32l(float exyz[], float q[], float affp, int nyzp[],
+                  int nx, int nxe, int nypmx, int nzpmx, int idds);
+
+void cppyeeclean32l(float exyz[], float f[], float dmr, float affp,
+                    float *wf, int nyzp[], int nx, int nxe, int nypmx,
+                    int nzpmx, int idds);
+
 void cwpfft32rinit(int mixup[], float complex sct[], int indx, int indy,
                    int indz, int nxhyzd, int nxyzhd);
 
@@ -122,18 +147,18 @@ void cppfft32r3xz(float complex h[], int isign, int mixup[],
 
 void cwppfft32r(float complex f[], float complex g[], float complex h[],
                 float complex bs[], float complex br[], int isign,
-                int ntpose, int mixup[], float complex sct[],
-                float *ttp, int indx, int indy, int indz, int kstrt,
-                int nvpy, int nvpz, int nxvh, int nyv, int nzv,
-                int kxyp, int kyp, int kyzp, int kzp, int kxypd,
-                int kypd, int kyzpd, int kzpd, int kzyp, int nxhyzd,
-                int nxyzhd);
+                int ntpose, int ltpose, int mixup[],
+                float complex sct[], float *ttp, int indx, int indy,
+                int indz, int kstrt, int nvpy, int nvpz, int nxvh,
+                int nyv, int nzv, int kxyp, int kyp, int kyzp, int kzp,
+                int kxypd, int kypd, int kyzpd, int kzpd, int kzyp,
+                int nxhyzd, int nxyzhd);
 
 void cwppfft32r3(float complex f[], float complex g[],
                  float complex h[], float complex bs[],
-                 float complex br[], int isign, int ntpose, int mixup[],
-                 float complex sct[], float *ttp, int indx, int indy,
-                 int indz, int kstrt, int nvpy, int nvpz, int nxvh,
-                 int nyv, int nzv, int kxyp, int kyp, int kyzp, int kzp,
-                 int kxypd, int kypd, int kyzpd, int kzpd, int kzyp,
-                 int nxhyzd, int nxyzhd);
+                 float complex br[], int isign, int ntpose, int ltpose,
+                 int mixup[], float complex sct[], float *ttp, int indx,
+                 int indy, int indz, int kstrt, int nvpy, int nvpz,
+                 int nxvh, int nyv, int nzv, int kxyp, int kyp,
+                 int kyzp, int kzp, int kxypd, int kypd, int kyzpd,
+                 int kzpd, int kzyp, int nxhyzd, int nxyzhd);
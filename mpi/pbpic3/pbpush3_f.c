@@ -89,6 +89,32 @@ void ppemfield32_(float complex *fxyz, float complex *exyz,
                   int *nz, int *kstrt, int *nvpy, int *nvpz, int *nzv,
                   int *kxyp, int *kyzp, int *nzhd);
 
+void ppyeebh32l_(float *exyz, float *bxyz, float *affp, float *ci,
+                 float *dtb, float *wm, int *nyzp, int *nx, int *nxe,
+                 int *nypmx, int *nzpmx, int *idds);
+
+void ppyeecurl32l_(float *bxyz, float *cxyz, int *nyzp, int *nx,
+                   int *nxe, int *nypmx, int *nzpmx, int *idds);
+
+void ppyeee32l_(float *exyz, float *cxyz, float *cu, float *affp,
+                float *ci, float *dt, float *wf, int *nyzp, int *nx,
+                int *nxe, int *nypmx, int *nzpmx, int *idds);
+
+void ppyeefield32l_(float *fxyz, float *exyz, int *isign, int *nyzp,
+                    int *nx, int *nxe, int *nypmx, int *nzpmx,
+                    int *idds);
+
+void ppyeepot32_(float complex *q, float *affp, int *nx, int *ny,
+                 int *nz, int *kstrt, int *nvpy, int *nvpz, int *nzv,
+                 int *kxyp, int *kyzp);
+
+void ppyeediv32l_(float *exyz, float *q, float *affp, int *nyzp,
+                  int *nx, int *nxe, int *nypmx, int *nzpmx, int *idds);
+
+void ppyeeclean32l_(float *exyz, float *f, float *dmr, float *affp,
+                    float *wf, int *nyzp, int *nx, int *nxe, int *nypmx,
+                    int *nzpmx, int *idds);
+
 void wpfft32rinit_(int *mixup, float complex *sct, int *indx, int *indy,
                    int *indz, int *nxhyzd, int *nxyzhd);
 
@@ -130,21 +156,21 @@ void ppfft32r3xz_(float complex *h, int *isign, int *mixup,
 
 void wppfft32r_(float complex *f, float complex *g, float complex *h,
                 float complex *bs, float complex *br, int *isign,
-                int *ntpose, int *mixup, float complex *sct,
-                float *ttp, int *indx, int *indy, int *indz, int *kstrt,
-                int *nvpy, int *nvpz, int *nxvh, int *nyv, int *nzv,
-                int *kxyp, int *kyp, int *kyzp, int *kzp, int *kxypd,
-                int *kypd, int *kyzpd, int *kzpd, int *kzyp,
-                int *nxhyzd, int *nxyzhd);
+                int *ntpose, int *ltpose, int *mixup,
+                float complex *sct, float *ttp, int *indx, int *indy,
+                int *indz, int *kstrt, int *nvpy, int *nvpz, int *nxvh,
+                int *nyv, int *nzv, int *kxyp, int *kyp, int *kyzp,
+                int *kzp, int *kxypd, int *kypd, int *kyzpd, int *kzpd,
+                int *kzyp, int *nxhyzd, int *nxyzhd);
 
 void wppfft32r3_(float complex *f, float complex *g, float complex *h,
                  float complex *bs, float complex *br, int *isign,
-                 int *ntpose, int *mixup, float complex *sct,
-                 float *ttp, int *indx, int *indy, int *indz,
-                 int *kstrt, int *nvpy, int *nvpz, int *nxvh, int *nyv,
-                 int *nzv, int *kxyp, int *kyp, int *kyzp, int *kzp,
-                 int *kxypd, int *kypd, int *kyzpd, int *kzpd,
-                 int *kzyp, int *nxhyzd, int *nxyzhd);
+                 int *ntpose, int *ltpose, int *mixup,
+                 float complex *sct, float *ttp, int *indx, int *indy,
+                 int *indz, int *kstrt, int *nvpy, int *nvpz,
+                 int *nxvh, int *nyv, int *nzv, int *kxyp, int *kyp,
+                 int *kyzp, int *kzp, int *kxypd, int *kypd, int *kyzpd,
+                 int *kzpd, int *kzyp, int *nxhyzd, int *nxyzhd);
 
 /* Interfaces to C */
 
@@ -317,6 +343,62 @@ void cppemfield32(float complex fxyz[], float complex exyz[],
    return;
 }
 
+/*--------------------------------------------------------------------*/
+void cppyeebh32l(float exyz[], float bxyz[], float affp, float ci,
+                 float dtb, float *wm, int nyzp[], int nx, int nxe,
+                 int nypmx, int nzpmx, int idds) {
+   ppyeebh32l_(exyz,bxyz,&affp,&ci,&dtb,wm,nyzp,&nx,&nxe,&nypmx,&nzpmx,
+               &idds);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppyeecurl32l(float bxyz[], float cxyz[], int nyzp[], int nx,
+                   int nxe, int nypmx, int nzpmx, int idds) {
+   ppyeecurl32l_(bxyz,cxyz,nyzp,&nx,&nxe,&nypmx,&nzpmx,&idds);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppyeee32l(float exyz[], float cxyz[], float cu[], float affp,
+                float ci, float dt, float *wf, int nyzp[], int nx,
+                int nxe, int nypmx, int nzpmx, int idds) {
+   ppyeee32l_(exyz,cxyz,cu,&affp,&ci,&dt,wf,nyzp,&nx,&nxe,&nypmx,&nzpmx,
+              &idds);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppyeefield32l(float fxyz[], float exyz[], int isign, int nyzp[],
+                    int nx, int nxe, int nypmx, int nzpmx, int idds) {
+   ppyeefield32l_(fxyz,exyz,&isign,nyzp,&nx,&nxe,&nypmx,&nzpmx,&idds);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppyeepot32(float complex q[], float affp, int nx, int ny, int nz,
+                 int kstrt, int nvpy, int nvpz, int nzv, int kxyp,
+                 int kyzp) {
+   ppyeepot32_(q,&affp,&nx,&ny,&nz,&kstrt,&nvpy,&nvpz,&nzv,&kxyp,&kyzp);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppyeediv32l(float exyz[], float q[], float affp, int nyzp[],
+                  int nx, int nxe, int nypmx, int nzpmx, int idds) {
+   ppyeediv32l_(exyz,q,&affp,nyzp,&nx,&nxe,&nypmx,&nzpmx,&idds);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppyeeclean32l(float exyz[], float f[], float dmr, float affp,
+                    float *wf, int nyzp[], int nx, int nxe, int nypmx,
+                    int nzpmx, int idds) {
+   ppyeeclean32l_(exyz,f,&dmr,&affp,wf,nyzp,&nx,&nxe,&nypmx,&nzpmx,
+                  &idds);
+   return;
+}
+
 /*--------------------------------------------------------------------*/
 void cwpfft32rinit(int mixup[], float complex sct[], int indx, int indy,
                    int indz, int nxhyzd, int nxyzhd) {
@@ -391,30 +473,31 @@ void cppfft32r3xz(float complex h[], int isign, int mixup[],
 /*--------------------------------------------------------------------*/
 void cwppfft32r(float complex f[], float complex g[], float complex h[],
                 float complex bs[], float complex br[], int isign,
-                int ntpose, int mixup[], float complex sct[],
-                float *ttp, int indx, int indy, int indz, int kstrt,
-                int nvpy, int nvpz, int nxvh, int nyv, int nzv,
-                int kxyp, int kyp, int kyzp, int kzp, int kxypd,
-                int kypd, int kyzpd, int kzpd, int kzyp, int nxhyzd,
-                int nxyzhd) {
-   wppfft32r_(f,g,h,bs,br,&isign,&ntpose,mixup,sct,ttp,&indx,&indy,
-              &indz,&kstrt,&nvpy,&nvpz,&nxvh,&nyv,&nzv,&kxyp,&kyp,&kyzp,
-              &kzp,&kxypd,&kypd,&kyzpd,&kzpd,&kzyp,&nxhyzd,&nxyzhd);
+                int ntpose, int ltpose, int mixup[],
+                float complex sct[], float *ttp, int indx, int indy,
+                int indz, int kstrt, int nvpy, int nvpz, int nxvh,
+                int nyv, int nzv, int kxyp, int kyp, int kyzp, int kzp,
+                int kxypd, int kypd, int kyzpd, int kzpd, int kzyp,
+                int nxhyzd, int nxyzhd) {
+   wppfft32r_(f,g,h,bs,br,&isign,&ntpose,&ltpose,mixup,sct,ttp,&indx,
+              &indy,&indz,&kstrt,&nvpy,&nvpz,&nxvh,&nyv,&nzv,&kxyp,&kyp,
+              &kyzp,&kzp,&kxypd,&kypd,&kyzpd,&kzpd,&kzyp,&nxhyzd,
+              &nxyzhd);
    return;
 }
 
 /*--------------------------------------------------------------------*/
 void cwppfft32r3(float complex f[], float complex g[],
                  float complex h[], float complex bs[],
-                 float complex br[], int isign, int ntpose, int mixup[],
-                 float complex sct[], float *ttp, int indx, int indy,
-                 int indz, int kstrt, int nvpy, int nvpz, int nxvh,
-                 int nyv, int nzv, int kxyp, int kyp, int kyzp, int kzp,
-                 int kxypd, int kypd, int kyzpd, int kzpd, int kzyp,
-                 int nxhyzd, int nxyzhd) {
-   wppfft32r3_(f,g,h,bs,br,&isign,&ntpose,mixup,sct,ttp,&indx,&indy,
-               &indz,&kstrt,&nvpy,&nvpz,&nxvh,&nyv,&nzv,&kxyp,&kyp,
-               &kyzp,&kzp,&kxypd,&kypd,&kyzpd,&kzpd,&kzyp,&nxhyzd,
+                 float complex br[], int isign, int ntpose, int ltpose,
+                 int mixup[], float complex sct[], float *ttp, int indx,
+                 int indy, int indz, int kstrt, int nvpy, int nvpz,
+                 int nxvh, int nyv, int nzv, int kxyp, int kyp,
+                 int kyzp, int kzp, int kxypd, int kypd, int kyzpd,
+                 int kzpd, int kzyp, int nxhyzd, int nxyzhd) {
+   wppfft32r3_(f,g,h,bs,br,&isign,&ntpose,&ltpose,mixup,sct,ttp,&indx,
+               &indy,&indz,&kstrt,&nvpy,&nvpz,&nxvh,&nyv,&nzv,&kxyp,
+               &kyp,&kyzp,&kzp,&kxypd,&kypd,&kyzpd,&kzpd,&kzyp,&nxhyzd,
                &nxyzhd);
    return;
 }
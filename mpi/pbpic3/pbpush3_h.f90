@@ -214,6 +214,89 @@
          complex, dimension(nzhd,kxyp,kyzp), intent(in) :: ffc
          end subroutine
       end interface
+!
+      interface
+         subroutine PPYEEBH32L(exyz,bxyz,affp,ci,dtb,wm,nyzp,nx,nxe,    &
+     &nypmx,nzpmx,idds)
+         implicit none
+         integer, intent(in) :: nx, nxe, nypmx, nzpmx, idds
+         real, intent(in) :: affp, ci, dtb
+         real, intent(inout) :: wm
+         real, dimension(3,nxe,nypmx,nzpmx), intent(in) :: exyz
+         real, dimension(3,nxe,nypmx,nzpmx), intent(inout) :: bxyz
+         integer, dimension(idds), intent(in) :: nyzp
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPYEECURL32L(bxyz,cxyz,nyzp,nx,nxe,nypmx,nzpmx,idds)
+         implicit none
+         integer, intent(in) :: nx, nxe, nypmx, nzpmx, idds
+         real, dimension(3,nxe,nypmx,nzpmx), intent(in) :: bxyz
+         real, dimension(3,nxe,nypmx,nzpmx), intent(inout) :: cxyz
+         integer, dimension(idds), intent(in) :: nyzp
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPYEEE32L(exyz,cxyz,cu,affp,ci,dt,wf,nyzp,nx,nxe,   &
+     &nypmx,nzpmx,idds)
+         implicit none
+         integer, intent(in) :: nx, nxe, nypmx, nzpmx, idds
+         real, intent(in) :: affp, ci, dt
+         real, intent(inout) :: wf
+         real, dimension(3,nxe,nypmx,nzpmx), intent(inout) :: exyz
+         real, dimension(3,nxe,nypmx,nzpmx), intent(in) :: cxyz, cu
+         integer, dimension(idds), intent(in) :: nyzp
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPYEEFIELD32L(fxyz,exyz,isign,nyzp,nx,nxe,nypmx,    &
+     &nzpmx,idds)
+         implicit none
+         integer, intent(in) :: isign, nx, nxe, nypmx, nzpmx, idds
+         real, dimension(3,nxe,nypmx,nzpmx), intent(inout) :: fxyz
+         real, dimension(3,nxe,nypmx,nzpmx), intent(in) :: exyz
+         integer, dimension(idds), intent(in) :: nyzp
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPYEEPOT32(q,affp,nx,ny,nz,kstrt,nvpy,nvpz,nzv,kxyp,&
+     &kyzp)
+         implicit none
+         integer, intent(in) :: nx, ny, nz, kstrt, nvpy, nvpz, nzv
+         integer, intent(in) :: kxyp, kyzp
+         real, intent(in) :: affp
+         complex, dimension(nzv,kxyp,kyzp), intent(inout) :: q
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPYEEDIV32L(exyz,q,affp,nyzp,nx,nxe,nypmx,nzpmx,    &
+     &idds)
+         implicit none
+         integer, intent(in) :: nx, nxe, nypmx, nzpmx, idds
+         real, intent(in) :: affp
+         real, dimension(3,nxe,nypmx,nzpmx), intent(in) :: exyz
+         real, dimension(nxe,nypmx,nzpmx), intent(inout) :: q
+         integer, dimension(idds), intent(in) :: nyzp
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPYEECLEAN32L(exyz,f,dmr,affp,wf,nyzp,nx,nxe,nypmx, &
+     &nzpmx,idds)
+         implicit none
+         integer, intent(in) :: nx, nxe, nypmx, nzpmx, idds
+         real, intent(in) :: dmr, affp
+         real, intent(inout) :: wf
+         real, dimension(3,nxe,nypmx,nzpmx), intent(inout) :: exyz
+         real, dimension(nxe,nypmx,nzpmx), intent(in) :: f
+         integer, dimension(idds), intent(in) :: nyzp
+         end subroutine
+      end interface
 !
       interface
          subroutine WPFFT32RINIT(mixup,sct,indx,indy,indz,nxhyzd,nxyzhd)
@@ -225,11 +308,12 @@
       end interface
 !
       interface
-         subroutine WPPFFT32R(f,g,h,bs,br,isign,ntpose,mixup,sct,ttp,   &
-     &indx,indy,indz,kstrt,nvpy,nvpz,nxvh,nyv,nzv,kxyp,kyp,kyzp,kzp,    &
-     &kxypd,kypd,kyzpd,kzpd,kzyp,nxhyzd,nxyzhd)
+         subroutine WPPFFT32R(f,g,h,bs,br,isign,ntpose,ltpose,mixup,    &
+     &sct,ttp,indx,indy,indz,kstrt,nvpy,nvpz,nxvh,nyv,nzv,kxyp,kyp,kyzp,&
+     &kzp,kxypd,kypd,kyzpd,kzpd,kzyp,nxhyzd,nxyzhd)
          implicit none
-         integer, intent(in) :: isign, ntpose, indx, indy, indz, kstrt
+         integer, intent(in) :: isign, ntpose, ltpose, indx, indy
+         integer, intent(in) :: indz, kstrt
          integer, intent(in) :: nvpy, nvpz, nxvh, nyv, nzv, kxyp, kyp
          integer, intent(in) :: kyzp, kzp, kxypd, kypd, kyzpd, kzpd
          integer, intent(in) :: kzyp, nxhyzd, nxyzhd
@@ -244,11 +328,12 @@
       end interface
 !
       interface
-         subroutine WPPFFT32R3(f,g,h,bs,br,isign,ntpose,mixup,sct,ttp,  &
-     &indx,indy,indz,kstrt,nvpy,nvpz,nxvh,nyv,nzv,kxyp,kyp,kyzp,kzp,    &
-     &kxypd,kypd,kyzpd,kzpd,kzyp,nxhyzd,nxyzhd)
+         subroutine WPPFFT32R3(f,g,h,bs,br,isign,ntpose,ltpose,mixup,   &
+     &sct,ttp,indx,indy,indz,kstrt,nvpy,nvpz,nxvh,nyv,nzv,kxyp,kyp,kyzp,&
+     &kzp,kxypd,kypd,kyzpd,kzpd,kzyp,nxhyzd,nxyzhd)
          implicit none
-         integer, intent(in) :: isign, ntpose, indx, indy, indz, kstrt
+         integer, intent(in) :: isign, ntpose, ltpose, indx, indy
+         integer, intent(in) :: indz, kstrt
          integer, intent(in) :: nvpy, nvpz, nxvh, nyv, nzv, kxyp, kyp
          integer, intent(in) :: kyzp, kzp, kxypd, kypd, kyzpd, kzpd
          integer, intent(in) :: kzyp, nxhyzd, nxyzhd
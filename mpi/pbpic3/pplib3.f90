@@ -29,6 +29,11 @@
 ! PPNTPOS3B performs a transpose of an n component complex vector array,
 !           distributed in x and z, to an n component complex vector
 !           array, distributed in x and y.
+! PPNTPOS3BS starts a transpose of a block of x indices of an n
+!            component complex vector array, distributed in x and z,
+!            to an n component complex vector array, distributed in x
+!            and y, using non-blocking messages.
+! PPNTPOS3BW completes a transpose started by PPNTPOS3BS.
 ! PPMOVE32 moves particles into appropriate spatial regions with
 !          periodic boundary conditions and 2D spatial decomposition.
 !          Assumes ihole list has been found.
@@ -60,6 +65,7 @@
       public :: PPSUM, PPDSUM, PPIMAX, PPDMAX
       public :: PPNCGUARD32L, PPNAGUARD32L, PPNACGUARD32L
       public :: PPTPOS3A, PPTPOS3B, PPNTPOS3A, PPNTPOS3B, PPMOVE32
+      public :: PPNTPOS3BS, PPNTPOS3BW
 !
       contains
 !
@@ -1040,6 +1046,180 @@
       enddo
       end subroutine
 !
+!-----------------------------------------------------------------------
+      subroutine PPNTPOS3BS(g,h,s,t,mreq,nx,ny,nz,kxyp,kyzp,kzp,kstrt,  &
+     &nvpy,nvpz,ndim,nyv,nzv,kxypd,kyzpd,kzpd,jxi,jxp)
+! this subroutine starts a transpose of a block of x indices of a matrix
+! g, distributed in x and z to a matrix h, distributed in x and y, that
+! is, h(1:ndim,l+kzp*(n-1),j,k) = g(1:ndim,k+kyzp*(m-1),j,l), where
+! jxi <= j < jxi+jxp, 1 <= k <= kyzp, 1 <= l <= kzp, and
+! 1 <= m <= ny/kyzp, 1 <= n <= nz/kzp
+! and where indices n and m can be distributed across processors.
+! this subroutine posts all receives, sends all messages asynchronously
+! and copies the local block.  PPNTPOS3BW must be called with the same
+! block to complete the transpose.  several blocks can be in progress at
+! once, so that work on one block, such as an fft in z, can overlap with
+! the communication of the others.
+! g = complex input array
+! h = complex output array
+! s, t = complex scratch arrays, of size ndim*kyzp*kxyp*kzp*nvpz
+! the block starting at jxi uses the part starting at
+! ndim*kyzp*kzp*nvpz*(jxi-1)
+! mreq = receive/send requests for this block
+! nx/ny/nz = number of points in x/y/z
+! kxyp/kyzp/kzp = number of data values per block in x/y/z
+! kstrt = starting data block number
+! nvpy/nvpz = number of real or virtual processors in y/z
+! ndim = leading dimension of arrays g and h
+! nyv/nzv = first dimension of g/h
+! kxypd = second dimension of g and h
+! kzpd/kyzpd = third dimension of g/h
+! jxi = initial x index in block
+! jxp = number of x indices in block
+      implicit none
+      integer, intent(in) :: nx, ny, nz, kxyp, kyzp, kzp, kstrt, nvpy
+      integer, intent(in) :: nvpz, ndim, nyv, nzv, kxypd, kyzpd, kzpd
+      integer, intent(in) :: jxi, jxp
+      complex, dimension(ndim,nyv,kxypd,kzpd), intent(in) :: g
+      complex, dimension(ndim,nzv,kxypd,kyzpd), intent(inout) :: h
+      complex, dimension(ndim,kyzp*kxyp*kzp*nvpz), intent(inout) :: s, t
+      integer, dimension(2*nvpz), intent(inout) :: mreq
+! lgrp = current communicator
+! mcplx = default datatype for complex
+! local data
+      integer :: i, n, j, k, l, js, ks, kyzps, kzps, id, joff, koff
+      integer :: loff, moff, ld, jd, kyzxp, ierr
+! js/ks = processor co-ordinates in x/z => idproc = js + nvpy*ks
+      ks = (kstrt - 1)/nvpy
+      js = kstrt - nvpy*ks - 1
+      kyzps = min(kyzp,max(0,ny-kyzp*ks))
+      kzps = min(kzp,max(0,nz-kzp*ks))
+      joff = jxi - 1
+! special case for one processor
+      if (nvpz==1) then
+         do l = 1, kzp
+            do j = 1, jxp
+               do k = 1, kyzp
+                  do i = 1, ndim
+                     h(i,l,j+joff,k) = g(i,k,j+joff,l)
+                  enddo
+               enddo
+            enddo
+         enddo
+         mreq = MPI_REQUEST_NULL
+         return
+      endif
+! kyzxp = size of each message in this block, moff = start of block
+      kyzxp = kyzp*kzp*jxp
+      moff = kyzp*kzp*nvpz*joff
+! post all receives, data from processor id is stored in message id+1
+      do n = 1, nvpz
+         id = n - 1
+         if (id /= ks) then
+            jd = js + nvpy*id
+            call MPI_IRECV(t(1,moff+kyzxp*id+1),ndim*kyzxp,mcplx,jd,jxi,&
+     &lgrp,mreq(n),ierr)
+         else
+            mreq(n) = MPI_REQUEST_NULL
+         endif
+      enddo
+      mreq(nvpz+ks+1) = MPI_REQUEST_NULL
+! extract and send data, data to processor id is stored in message id+1
+      do n = 1, nvpz
+         id = n - ks - 1
+         if (id < 0) id = id + nvpz
+         if (id==ks) cycle
+         koff = kyzp*id
+         ld = min(kyzp,max(0,ny-koff))
+         loff = moff + kyzxp*id
+         do l = 1, kzps
+            do j = 1, jxp
+               do k = 1, ld
+                  do i = 1, ndim
+                     s(i,k+ld*(j+jxp*(l-1)-1)+loff) = g(i,k+koff,j+joff,&
+     &l)
+                  enddo
+               enddo
+            enddo
+         enddo
+         jd = js + nvpy*id
+         ld = ndim*ld*jxp*kzps
+         call MPI_ISEND(s(1,loff+1),ld,mcplx,jd,jxi,lgrp,mreq(nvpz+id+1)&
+     &,ierr)
+      enddo
+! copy local block while messages are in flight
+      koff = kyzp*ks
+      loff = kzp*ks
+      do l = 1, kzps
+         do j = 1, jxp
+            do k = 1, kyzps
+               do i = 1, ndim
+                  h(i,l+loff,j+joff,k) = g(i,k+koff,j+joff,l)
+               enddo
+            enddo
+         enddo
+      enddo
+      end subroutine
+!
+!-----------------------------------------------------------------------
+      subroutine PPNTPOS3BW(h,t,mreq,nx,ny,nz,kxyp,kyzp,kzp,kstrt,nvpy, &
+     &nvpz,ndim,nzv,kxypd,kyzpd,jxi,jxp)
+! this subroutine completes a transpose of a block of x indices started
+! by PPNTPOS3BS, inserting data into h in the order it arrives.
+! h = complex output array
+! t = complex scratch array given to PPNTPOS3BS
+! mreq = receive/send requests for this block from PPNTPOS3BS
+! nx/ny/nz = number of points in x/y/z
+! kxyp/kyzp/kzp = number of data values per block in x/y/z
+! kstrt = starting data block number
+! nvpy/nvpz = number of real or virtual processors in y/z
+! ndim = leading dimension of array h
+! nzv = first dimension of h
+! kxypd = second dimension of h
+! kyzpd = third dimension of h
+! jxi = initial x index in block
+! jxp = number of x indices in block
+      implicit none
+      integer, intent(in) :: nx, ny, nz, kxyp, kyzp, kzp, kstrt, nvpy
+      integer, intent(in) :: nvpz, ndim, nzv, kxypd, kyzpd, jxi, jxp
+      complex, dimension(ndim,nzv,kxypd,kyzpd), intent(inout) :: h
+      complex, dimension(ndim,kyzp*kxyp*kzp*nvpz), intent(inout) :: t
+      integer, dimension(2*nvpz), intent(inout) :: mreq
+! local data
+      integer :: i, n, j, k, l, ks, kyzps, id, joff, koff, loff, moff
+      integer :: ld, kyzxp, ierr
+      integer, dimension(lstat) :: istatus
+! special case for one processor
+      if (nvpz==1) return
+! ks = processor co-ordinate in z
+      ks = (kstrt - 1)/nvpy
+      kyzps = min(kyzp,max(0,ny-kyzp*ks))
+      joff = jxi - 1
+      kyzxp = kyzp*kzp*jxp
+      moff = kyzp*kzp*nvpz*joff
+! insert data as it arrives
+      do n = 2, nvpz
+         call MPI_WAITANY(nvpz,mreq,id,istatus,ierr)
+         if (id==MPI_UNDEFINED) exit
+         id = id - 1
+         loff = kzp*id
+         ld = min(kzp,max(0,nz-loff))
+         koff = moff + kyzxp*id
+         do l = 1, ld
+            do j = 1, jxp
+               do k = 1, kyzps
+                  do i = 1, ndim
+                     h(i,l+loff,j+joff,k) = t(i,k+kyzps*(j+jxp*(l-1)-1)+&
+     &koff)
+                  enddo
+               enddo
+            enddo
+         enddo
+      enddo
+! wait for sends to complete
+      call MPI_WAITALL(nvpz,mreq(nvpz+1:2*nvpz),MPI_STATUSES_IGNORE,ierr)
+      end subroutine
+!
 !-----------------------------------------------------------------------
       subroutine PPMOVE32(part,edges,npp,sbufr,sbufl,rbufr,rbufl,ihole, &
      &ny,nz,kstrt,nvpy,nvpz,idimp,npmax,idps,nbmax,ntmax,info)
@@ -1724,6 +1904,36 @@
      &nzv,kxypd,kyzpd,kzpd)
       end subroutine
 !
+!-----------------------------------------------------------------------
+      subroutine PPNTPOS3BS(g,h,s,t,mreq,nx,ny,nz,kxyp,kyzp,kzp,kstrt,  &
+     &nvpy,nvpz,ndim,nyv,nzv,kxypd,kyzpd,kzpd,jxi,jxp)
+      use pplib3, only: SUB => PPNTPOS3BS
+      implicit none
+      integer, intent(in) :: nx, ny, nz, kxyp, kyzp, kzp, kstrt, nvpy
+      integer, intent(in) :: nvpz, ndim, nyv, nzv, kxypd, kyzpd, kzpd
+      integer, intent(in) :: jxi, jxp
+      complex, dimension(ndim,nyv,kxypd,kzpd), intent(in) :: g
+      complex, dimension(ndim,nzv,kxypd,kyzpd), intent(inout) :: h
+      complex, dimension(ndim,kyzp*kxyp*kzp*nvpz), intent(inout) :: s, t
+      integer, dimension(2*nvpz), intent(inout) :: mreq
+      call SUB(g,h,s,t,mreq,nx,ny,nz,kxyp,kyzp,kzp,kstrt,nvpy,nvpz,ndim,&
+     &nyv,nzv,kxypd,kyzpd,kzpd,jxi,jxp)
+      end subroutine
+!
+!-----------------------------------------------------------------------
+      subroutine PPNTPOS3BW(h,t,mreq,nx,ny,nz,kxyp,kyzp,kzp,kstrt,nvpy, &
+     &nvpz,ndim,nzv,kxypd,kyzpd,jxi,jxp)
+      use pplib3, only: SUB => PPNTPOS3BW
+      implicit none
+      integer, intent(in) :: nx, ny, nz, kxyp, kyzp, kzp, kstrt, nvpy
+      integer, intent(in) :: nvpz, ndim, nzv, kxypd, kyzpd, jxi, jxp
+      complex, dimension(ndim,nzv,kxypd,kyzpd), intent(inout) :: h
+      complex, dimension(ndim,kyzp*kxyp*kzp*nvpz), intent(inout) :: t
+      integer, dimension(2*nvpz), intent(inout) :: mreq
+      call SUB(h,t,mreq,nx,ny,nz,kxyp,kyzp,kzp,kstrt,nvpy,nvpz,ndim,nzv,&
+     &kxypd,kyzpd,jxi,jxp)
+      end subroutine
+!
 !-----------------------------------------------------------------------
       subroutine PPMOVE32(part,edges,npp,sbufr,sbufl,rbufr,rbufl,ihole, &
      &ny,nz,kstrt,nvpy,nvpz,idimp,npmax,idps,nbmax,ntmax,info)
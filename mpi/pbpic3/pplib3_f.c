@@ -53,6 +53,17 @@ void ppntpos3b_(float complex *g, float complex *h, float complex *s,
                 int *ndim, int *nyv, int *nzv, int *kxypd, int *kyzpd,
                 int *kzpd);
 
+void ppntpos3bs_(float complex *g, float complex *h, float complex *s,
+                 float complex *t, int *mreq, int *nx, int *ny, int *nz,
+                 int *kxyp, int *kyzp, int *kzp, int *kstrt, int *nvpy,
+                 int *nvpz, int *ndim, int *nyv, int *nzv, int *kxypd,
+                 int *kyzpd, int *kzpd, int *jxi, int *jxp);
+
+void ppntpos3bw_(float complex *h, float complex *t, int *mreq, int *nx,
+                 int *ny, int *nz, int *kxyp, int *kyzp, int *kzp,
+                 int *kstrt, int *nvpy, int *nvpz, int *ndim, int *nzv,
+                 int *kxypd, int *kyzpd, int *jxi, int *jxp);
+
 void ppmove32_(float *part, float *edges, int *npp, float *sbufr,
                float *sbufl, float *rbufr, float *rbufl, int *ihole, 
                int *ny, int *nz, int *kstrt, int *nvpy, int *nvpz,
@@ -181,6 +192,27 @@ void cppntpos3b(float complex g[], float complex h[], float complex s[],
    return;
 }
 
+/*--------------------------------------------------------------------*/
+void cppntpos3bs(float complex g[], float complex h[], float complex s[],
+                 float complex t[], int mreq[], int nx, int ny, int nz,
+                 int kxyp, int kyzp, int kzp, int kstrt, int nvpy,
+                 int nvpz, int ndim, int nyv, int nzv, int kxypd,
+                 int kyzpd, int kzpd, int jxi, int jxp) {
+   ppntpos3bs_(g,h,s,t,mreq,&nx,&ny,&nz,&kxyp,&kyzp,&kzp,&kstrt,&nvpy,
+               &nvpz,&ndim,&nyv,&nzv,&kxypd,&kyzpd,&kzpd,&jxi,&jxp);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppntpos3bw(float complex h[], float complex t[], int mreq[],
+                 int nx, int ny, int nz, int kxyp, int kyzp, int kzp,
+                 int kstrt, int nvpy, int nvpz, int ndim, int nzv,
+                 int kxypd, int kyzpd, int jxi, int jxp) {
+   ppntpos3bw_(h,t,mreq,&nx,&ny,&nz,&kxyp,&kyzp,&kzp,&kstrt,&nvpy,&nvpz,
+               &ndim,&nzv,&kxypd,&kyzpd,&jxi,&jxp);
+   return;
+}
+
 /*--------------------------------------------------------------------*/
 void cppmove32(float part[], float edges[], int *npp, float sbufr[],
                float sbufl[], float rbufr[], float rbufl[], int ihole[], 
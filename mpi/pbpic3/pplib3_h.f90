@@ -148,6 +148,34 @@
          complex, dimension(ndim,kyzp*kxyp*kzp), intent(inout) :: s, t
          end subroutine
       end interface
+!
+      interface
+         subroutine PPNTPOS3BS(g,h,s,t,mreq,nx,ny,nz,kxyp,kyzp,kzp,     &
+     &kstrt,nvpy,nvpz,ndim,nyv,nzv,kxypd,kyzpd,kzpd,jxi,jxp)
+         implicit none
+         integer, intent(in) :: nx, ny, nz, kxyp, kyzp, kzp, kstrt, nvpy
+         integer, intent(in) :: nvpz, ndim, nyv, nzv, kxypd, kyzpd, kzpd
+         integer, intent(in) :: jxi, jxp
+         complex, dimension(ndim,nyv,kxypd,kzpd), intent(in) :: g
+         complex, dimension(ndim,nzv,kxypd,kyzpd), intent(inout) :: h
+         complex, dimension(ndim,kyzp*kxyp*kzp*nvpz), intent(inout) ::  &
+     &s, t
+         integer, dimension(2*nvpz), intent(inout) :: mreq
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPNTPOS3BW(h,t,mreq,nx,ny,nz,kxyp,kyzp,kzp,kstrt,   &
+     &nvpy,nvpz,ndim,nzv,kxypd,kyzpd,jxi,jxp)
+         implicit none
+         integer, intent(in) :: nx, ny, nz, kxyp, kyzp, kzp, kstrt, nvpy
+         integer, intent(in) :: nvpz, ndim, nzv, kxypd, kyzpd, jxi, jxp
+         complex, dimension(ndim,nzv,kxypd,kyzpd), intent(inout) :: h
+         complex, dimension(ndim,kyzp*kxyp*kzp*nvpz), intent(inout) ::  &
+     &t
+         integer, dimension(2*nvpz), intent(inout) :: mreq
+         end subroutine
+      end interface
 !
       interface
          subroutine PPMOVE32(part,edges,npp,sbufr,sbufl,rbufr,rbufl,    &
@@ -0,0 +1,123 @@
+/*---------------------------------------------------------------------*/
+/* Benchmark for MPI guard cell exchanges in y, which compares the     */
+/* procedures which set up new messages every call (cppnaguard2l,     */
+/* cppncguard2l) with the procedures which reuse persistent requests  */
+/* (cppnaguard2lp, cppncguard2lp), for several grid sizes.  Small     */
+/* grids per processor are latency bound, as in strong scaling.      */
+#include <stdlib.h>
+#include <stdio.h>
+#include <complex.h>
+#include <math.h>
+#include <sys/time.h>
+#include "pplib2.h"
+
+void dtimer(double *time, struct timeval *itime, int icntrl);
+
+int main(int argc, char *argv[]) {
+/* indmin/indmax = smallest/largest exponents tested, nx = 2**ind */
+   int indmin = 3, indmax = 12;
+/* nrep = number of times each add/copy pair is repeated */
+   int nrep = 1000;
+/* nyp = number of grid rows in each partition */
+   int nyp = 2;
+/* ndim = number of components in vector copy */
+   int ndim = 2;
+/* declare scalars for standard code */
+   int j, k, l, n, nx, nxe, nnxe, nypmx;
+   float dmax, ddif;
+/* declare scalars for MPI code */
+   int nvp, idproc, kstrt, igdq, igdf;
+/* qa/qb = scalar data for blocking/persistent guard cell additions */
+/* fa/fb = vector data for blocking/persistent guard cell copies */
+   float *qa = NULL, *qb = NULL, *fa = NULL, *fb = NULL;
+/* scs/scr = guard cell buffers sent to/received from nearby processors */
+   float *scs = NULL, *scr = NULL;
+/* declare and initialize timing data */
+   double tp[2], tw[2], dtime;
+   struct timeval itime;
+
+/* initialize for distributed memory parallel processing */
+   cppinit2(&idproc,&nvp,argc,argv);
+   kstrt = idproc + 1;
+
+   if (kstrt==1) {
+      printf("nvp = %d, nyp = %d\n",nvp,nyp);
+      printf("nx       blocking   persistent   max difference\n");
+      printf("       (usec per add/copy pair)\n");
+   }
+   nypmx = nyp + 1;
+/* loop over grid sizes */
+   for (l = indmin; l <= indmax; l++) {
+      nx = 1L<<l;
+      nxe = nx + 2; nnxe = ndim*nxe;
+      qa = (float *) malloc(nxe*nypmx*sizeof(float));
+      qb = (float *) malloc(nxe*nypmx*sizeof(float));
+      fa = (float *) malloc(nnxe*nypmx*sizeof(float));
+      fb = (float *) malloc(nnxe*nypmx*sizeof(float));
+      scs = (float *) malloc(nnxe*sizeof(float));
+      scr = (float *) malloc(nnxe*sizeof(float));
+      cppnguard2init(scs,scr,&igdq,kstrt,nvp,nxe,nypmx);
+      cppnguard2init(scs,scr,&igdf,kstrt,nvp,nnxe,nypmx);
+/* initialize data from global indices */
+      for (k = 0; k < nypmx; k++) {
+         for (j = 0; j < nxe; j++) {
+            n = j + nxe*(k + nyp*idproc);
+            qa[j+nxe*k] = sinf(0.37*(float) n);
+            qb[j+nxe*k] = qa[j+nxe*k];
+         }
+         for (j = 0; j < nnxe; j++) {
+            n = j + nnxe*(k + nyp*idproc);
+            fa[j+nnxe*k] = cosf(0.11*(float) n);
+            fb[j+nnxe*k] = fa[j+nnxe*k];
+         }
+      }
+      for (j = 0; j < 2; j++) {
+         tp[j] = 0.0;
+      }
+      for (n = 0; n < nrep; n++) {
+/* exchanges which set up new messages every call */
+         dtimer(&dtime,&itime,-1);
+         cppnaguard2l(qa,scr,nyp,nx,kstrt,nvp,nxe,nypmx);
+         cppncguard2l(fa,nyp,kstrt,nvp,nnxe,nypmx);
+         dtimer(&dtime,&itime,1);
+         tp[0] += dtime;
+/* exchanges with persistent requests */
+         dtimer(&dtime,&itime,-1);
+         cppnaguard2lp(qb,scs,scr,igdq,nyp,nx,nvp,nxe);
+         cppncguard2lp(fb,scs,scr,igdf,nyp,nvp,nnxe);
+         dtimer(&dtime,&itime,1);
+         tp[1] += dtime;
+      }
+/* compare results */
+      dmax = 0.0;
+      for (j = 0; j < nxe*nypmx; j++) {
+         ddif = fabsf(qa[j] - qb[j]);
+         dmax = ddif > dmax ? ddif : dmax;
+      }
+      for (j = 0; j < nnxe*nypmx; j++) {
+         ddif = fabsf(fa[j] - fb[j]);
+         dmax = ddif > dmax ? ddif : dmax;
+      }
+/* find maximum times and differences over processors */
+      cppdmax(tp,tw,2);
+      ddif = dmax;
+      cppsum(&ddif,&dmax,1);
+      if (kstrt==1) {
+         for (j = 0; j < 2; j++) {
+            tp[j] = 1.0e+06*tp[j]/(double) nrep;
+         }
+         printf("%-6d %10.4f   %10.4f     %e\n",nx,tp[0],tp[1],ddif);
+      }
+      cppnguard2free(&igdf);
+      cppnguard2free(&igdq);
+      free(scr);
+      free(scs);
+      free(fb);
+      free(fa);
+      free(qb);
+      free(qa);
+   }
+
+   cppexit();
+   return 0;
+}
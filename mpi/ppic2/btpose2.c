@@ -0,0 +1,176 @@
+/*---------------------------------------------------------------------*/
+/* Benchmark for MPI transposes used by the 2D parallel FFTs, which    */
+/* compares the transposes which exchange one message at a time       */
+/* (cpptpose, cppntpose) with the non-blocking all-to-all transposes  */
+/* (cpptposenb, cppntposenb), for several grid sizes.  Run with       */
+/* different numbers of processors to measure scaling                 */
+#include <stdlib.h>
+#include <stdio.h>
+#include <complex.h>
+#include <math.h>
+#include <sys/time.h>
+#include "pplib2.h"
+
+void dtimer(double *time, struct timeval *itime, int icntrl);
+
+int main(int argc, char *argv[]) {
+/* indmin/indmax = smallest/largest exponents tested, nx = ny = 2**ind */
+   int indmin = 6, indmax = 11;
+/* nrep = number of times each forward/backward pair is repeated */
+   int nrep = 20;
+/* ndim = number of components in vector transpose */
+   int ndim = 2;
+/* declare scalars for standard code */
+   int i, j, k, l, n, ny, nxh, nxvh, nyv;
+   float dmax, ddif;
+/* declare scalars for MPI code */
+   int nvp, idproc, kstrt, kxp, kyp, kxps, kyps, koff;
+/* f = input data, distributed in y */
+/* ga/gb = data transposed by blocking/non-blocking transposes */
+/* fb = data transposed back by non-blocking transposes */
+   float complex *f = NULL, *ga = NULL, *gb = NULL, *fb = NULL;
+/* s, t = scratch arrays for transposes */
+   float complex *s = NULL, *t = NULL;
+/* declare and initialize timing data */
+   double tp[4], tw[4], dtime;
+   struct timeval itime;
+
+/* initialize for distributed memory parallel processing */
+   cppinit2(&idproc,&nvp,argc,argv);
+   kstrt = idproc + 1;
+
+   if (kstrt==1) {
+      printf("nvp = %d\n",nvp);
+      printf("grid         scalar     scalar nb     vector     vector nb");
+      printf("   max difference\n");
+      printf("                    (msec per forward/backward pair)\n");
+   }
+/* loop over grid sizes */
+   for (l = indmin; l <= indmax; l++) {
+      nxh = 1L<<(l - 1); ny = 1L<<l;
+/* kxp = number of complex grids in each field partition in x */
+/* kyp = number of complex grids in each field partition in y */
+      kxp = (nxh - 1)/nvp + 1;
+      kyp = (ny - 1)/nvp + 1;
+      if ((kxp*(nvp-1) >= nxh) || (kyp*(nvp-1) >= ny)) {
+         if (kstrt==1)
+            printf("%5dx%-5d too many processors, skipped\n",2*nxh,ny);
+         continue;
+      }
+      nxvh = nxh; nyv = ny;
+      kxps = nxh - kxp*idproc;
+      kxps = 0 > kxps ? 0 : kxps;
+      kxps = kxp < kxps ? kxp : kxps;
+      kyps = ny - kyp*idproc;
+      kyps = 0 > kyps ? 0 : kyps;
+      kyps = kyp < kyps ? kyp : kyps;
+      f = (float complex *) malloc(ndim*nxvh*kyp*sizeof(float complex));
+      fb = (float complex *) malloc(ndim*nxvh*kyp*sizeof(float complex));
+      ga = (float complex *) malloc(ndim*nyv*kxp*sizeof(float complex));
+      gb = (float complex *) malloc(ndim*nyv*kxp*sizeof(float complex));
+/* non-blocking transposes need a separate buffer for each processor */
+      n = ndim*kxp*kyp*nvp;
+      s = (float complex *) malloc(n*sizeof(float complex));
+      t = (float complex *) malloc(n*sizeof(float complex));
+/* initialize data from global indices */
+      koff = kyp*idproc;
+      for (k = 0; k < kyp; k++) {
+         for (j = 0; j < nxvh; j++) {
+            for (i = 0; i < ndim; i++) {
+               n = i + ndim*(j + nxvh*(k + koff));
+               f[i+ndim*(j+nxvh*k)] = sinf(0.37*(float) n)
+                                    + cosf(0.11*(float) n)*_Complex_I;
+               fb[i+ndim*(j+nxvh*k)] = 0.0;
+            }
+         }
+      }
+      for (j = 0; j < 4; j++) {
+         tp[j] = 0.0;
+      }
+/* scalar transposes */
+      for (n = 0; n < nrep; n++) {
+         dtimer(&dtime,&itime,-1);
+         cpptpose(f,ga,s,t,nxh,ny,kxp,kyp,kstrt,nvp,nxvh,nyv,kxp,kyp);
+         cpptpose(ga,fb,t,s,ny,nxh,kyp,kxp,kstrt,nvp,nyv,nxvh,kyp,kxp);
+         dtimer(&dtime,&itime,1);
+         tp[0] += dtime;
+         dtimer(&dtime,&itime,-1);
+         cpptposenb(f,gb,s,t,nxh,ny,kxp,kyp,kstrt,nvp,nxvh,nyv,kxp,
+                    kyp);
+         cpptposenb(gb,fb,t,s,ny,nxh,kyp,kxp,kstrt,nvp,nyv,nxvh,kyp,
+                    kxp);
+         dtimer(&dtime,&itime,1);
+         tp[1] += dtime;
+      }
+/* compare results */
+      dmax = 0.0;
+      for (j = 0; j < kxps; j++) {
+         for (k = 0; k < ny; k++) {
+            ddif = cabsf(ga[k+nyv*j] - gb[k+nyv*j]);
+            dmax = ddif > dmax ? ddif : dmax;
+         }
+      }
+      for (k = 0; k < kyps; k++) {
+         for (j = 0; j < nxh; j++) {
+            ddif = cabsf(f[j+nxvh*k] - fb[j+nxvh*k]);
+            dmax = ddif > dmax ? ddif : dmax;
+         }
+      }
+/* vector transposes */
+      for (n = 0; n < nrep; n++) {
+         dtimer(&dtime,&itime,-1);
+         cppntpose(f,ga,s,t,nxh,ny,kxp,kyp,kstrt,nvp,ndim,nxvh,nyv,kxp,
+                   kyp);
+         cppntpose(ga,fb,t,s,ny,nxh,kyp,kxp,kstrt,nvp,ndim,nyv,nxvh,kyp,
+                   kxp);
+         dtimer(&dtime,&itime,1);
+         tp[2] += dtime;
+         dtimer(&dtime,&itime,-1);
+         cppntposenb(f,gb,s,t,nxh,ny,kxp,kyp,kstrt,nvp,ndim,nxvh,nyv,
+                     kxp,kyp);
+         cppntposenb(gb,fb,t,s,ny,nxh,kyp,kxp,kstrt,nvp,ndim,nyv,nxvh,
+                     kyp,kxp);
+         dtimer(&dtime,&itime,1);
+         tp[3] += dtime;
+      }
+/* compare results */
+      for (j = 0; j < kxps; j++) {
+         for (k = 0; k < ny; k++) {
+            for (i = 0; i < ndim; i++) {
+               ddif = cabsf(ga[i+ndim*(k+nyv*j)]
+                          - gb[i+ndim*(k+nyv*j)]);
+               dmax = ddif > dmax ? ddif : dmax;
+            }
+         }
+      }
+      for (k = 0; k < kyps; k++) {
+         for (j = 0; j < nxh; j++) {
+            for (i = 0; i < ndim; i++) {
+               ddif = cabsf(f[i+ndim*(j+nxvh*k)]
+                          - fb[i+ndim*(j+nxvh*k)]);
+               dmax = ddif > dmax ? ddif : dmax;
+            }
+         }
+      }
+/* find maximum times and differences over processors */
+      cppdmax(tp,tw,4);
+      ddif = dmax;
+      cppsum(&ddif,&dmax,1);
+      if (kstrt==1) {
+         for (j = 0; j < 4; j++) {
+            tp[j] = 1.0e+03*tp[j]/(double) nrep;
+         }
+         printf("%5dx%-5d %10.4f  %10.4f    %10.4f  %10.4f   %e\n",
+                2*nxh,ny,tp[0],tp[1],tp[2],tp[3],ddif);
+      }
+      free(t);
+      free(s);
+      free(gb);
+      free(ga);
+      free(fb);
+      free(f);
+   }
+
+   cppexit();
+   return 0;
+}
@@ -0,0 +1,461 @@
+/* C Library for Skeleton 2D Electrostatic MPI PIC Code diagnostics   */
+/* sink.  the processors holding fourier modes are divided into       */
+/* nwrite groups of consecutive processors.  each group sends its kxp */
+/* slices of pott to the first processor of the group, the writer,    */
+/* which assembles them into a ring of preallocated record buffers.   */
+/* a background thread on each writer appends the records to its own  */
+/* binary time series file.  messages are received into the ring with */
+/* nonblocking receives which are completed on the next call, so the  */
+/* time loop neither waits for the disk nor for the other processors  */
+/* of its group, unless the ring is full.  the background thread does */
+/* not make MPI calls.                                                 */
+/* file format: a header diaghead, followed by one record per call to */
+/* cppdiagwrite2, containing ntime, a pad word, and nkx columns of    */
+/* modesyd complex modes, kx = kx0,...,kx0+nkx-1, ky fastest.  the    */
+/* kx = nx/2 mode, if stored, is the last column of the last file.    */
+/* with one writer the file is named fname, otherwise the files are   */
+/* named fname.1, fname.2, ..., in order of kx.                        */
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <complex.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "mpi.h"
+#include "pdiag2.h"
+
+/* ndiagmax = maximum number of sinks open at one time */
+#define NDIAGMAX                 8
+
+/* header of time series file                                */
+/* magic = file identifier                                   */
+/* nx/ny = system length, modesx/modesy = modes kept in x/y  */
+/* modesyd = number of complex modes in y per column         */
+/* kx0/nkx = first mode number and number of modes in x kept */
+/* in this file, nfile = number of files in the time series  */
+struct diaghead {
+   char magic[8];
+   int nx, ny, modesx, modesy, modesyd, kx0, nkx, nfile;
+};
+
+/* sink state                                                         */
+/* comm = private communicator, idproc = rank in comm                 */
+/* nwriter = rank of writer of group, nfile = number of writers       */
+/* lwriter = (0,1) = (no,yes) this processor is a writer              */
+/* jmax = number of kx columns of pott held by this processor         */
+/* lnyq = (0,1) = (no,yes) this processor sends the kx = nx/2 mode    */
+/* to the last writer, sbuf/sreq = send buffers and requests          */
+/* isend = next send buffer to use                                    */
+/* writer only:                                                       */
+/* fd = file descriptor, nrec = size of one record in bytes           */
+/* ring = nbuf record buffers, ifill = next buffer to fill            */
+/* iwrite = next buffer to write, nfull = number of filled buffers    */
+/* ldone = (0,1) = (no,yes) no more records will be added             */
+/* wrc = error code of the background writer                          */
+/* lpend = (0,1) = (no,yes) buffer ifill has receives outstanding     */
+/* npend/rreq = number of outstanding receives and their requests     */
+/* ngrp/kxp/kx0/nkx = group size, block size, first kx and number of  */
+/* kx columns in file, knyq = column of kx = nx/2 mode, or -1         */
+struct diagsink {
+   int lopen, idproc, lwriter, nwriter, nfile, jmax, lnyq, isend;
+   int modesyd, kxp, kx0, nkx, knyq, ngrp, npend, lpend;
+   int fd, nbuf, ifill, iwrite, nfull, ldone, wrc;
+   long nrec;
+   MPI_Comm comm;
+   float complex *sbuf;
+   MPI_Request sreq[4];
+   MPI_Request *rreq;
+   char *ring;
+   pthread_mutex_t lock;
+   pthread_cond_t cfull, cfree;
+   pthread_t writer;
+};
+
+static struct diagsink sinks[NDIAGMAX];
+
+static char diagmagic[8] = "FMODES2";
+
+/*--------------------------------------------------------------------*/
+static void *cppdiagwr2(void *arg) {
+/* this function is run by the background thread of a writer.  it
+   appends filled record buffers to the file in order until the sink
+   is closed and the ring is empty.
+   a write error sets wrc = 2, and later records are discarded
+local data                                                            */
+   struct diagsink *ds = (struct diagsink *) arg;
+   int ierr = 0;
+   long nn;
+   ssize_t nw;
+   char *buf;
+   pthread_mutex_lock(&ds->lock);
+   for (;;) {
+      while ((ds->nfull==0) && (!ds->ldone)) {
+         pthread_cond_wait(&ds->cfull,&ds->lock);
+      }
+      if (ds->nfull==0)
+         break;
+      buf = &ds->ring[ds->nrec*ds->iwrite];
+      pthread_mutex_unlock(&ds->lock);
+      nn = 0;
+      while ((ierr==0) && (nn < ds->nrec)) {
+         nw = write(ds->fd,&buf[nn],ds->nrec-nn);
+         if (nw <= 0)
+            ierr = 2;
+         else
+            nn += nw;
+      }
+      pthread_mutex_lock(&ds->lock);
+      ds->wrc = ierr;
+      ds->iwrite = (ds->iwrite + 1)%ds->nbuf;
+      ds->nfull -= 1;
+      pthread_cond_signal(&ds->cfree);
+   }
+   pthread_mutex_unlock(&ds->lock);
+   return NULL;
+}
+
+/*--------------------------------------------------------------------*/
+static void cppdiagpass2(struct diagsink *ds) {
+/* this subroutine completes the receives into buffer ifill of a writer
+   and passes the buffer to the background thread
+local data                                                            */
+   if (!ds->lpend)
+      return;
+   MPI_Waitall(ds->npend,ds->rreq,MPI_STATUSES_IGNORE);
+   pthread_mutex_lock(&ds->lock);
+   ds->ifill = (ds->ifill + 1)%ds->nbuf;
+   ds->nfull += 1;
+   pthread_cond_signal(&ds->cfull);
+   pthread_mutex_unlock(&ds->lock);
+   ds->lpend = 0;
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppdiagopen2(char *fname, int nx, int ny, int modesx, int modesy,
+                  int kstrt, int kxp, int modesyd, int nwrite, int nbuf,
+                  int *nd, int *irc) {
+/* this subroutine creates the time series files for the fourier modes
+   extracted by cpprdmodes2, and starts the background thread on each
+   writer.  must be called by all processors
+   input: all except nd, irc, output: nd, irc
+   fname = name of time series file
+   nx/ny = system length in x/y direction
+   modesx/modesy = number of modes stored in x/y direction
+   kstrt = starting data block number
+   kxp = number of data values per block
+   modesyd = first dimension of pott, >= min(2*modesy-1,ny)
+   nwrite = requested number of writers, at most one per processor
+   holding modes is used
+   nbuf = number of record buffers on each writer, at least 2 are used
+   nd = sink number, to be passed to cppdiagwrite2 and cppdiagclose2
+   irc = error code on all processors: 0 = ok, 1 = cannot create file
+   or allocate buffers, 3 = too many sinks open
+local data                                                            */
+   int n, nvp, idproc, nxh, mx, nact, ngrp, nfile, ig, r0, r1, ierr;
+   long nn;
+   ssize_t nw;
+   char fn[264];
+   struct diaghead dh;
+   struct diagsink *ds;
+   *nd = -1;
+   *irc = 0;
+   for (n = 0; n < NDIAGMAX; n++) {
+      if (!sinks[n].lopen)
+         break;
+   }
+   if (n==NDIAGMAX) {
+      *irc = 3;
+      return;
+   }
+   ds = &sinks[n];
+   memset(ds,0,sizeof(struct diagsink));
+   MPI_Comm_dup(MPI_COMM_WORLD,&ds->comm);
+   MPI_Comm_size(ds->comm,&nvp);
+   idproc = kstrt - 1;
+/* mx = number of modes 0 <= kx < nx/2 stored */
+/* nact = number of processors holding them   */
+   nxh = nx/2;
+   mx = modesx < nxh ? modesx : nxh;
+   nact = (mx - 1)/kxp + 1;
+   nact = nact < nvp ? nact : nvp;
+/* divide active processors into groups */
+   nfile = nwrite > 1 ? nwrite : 1;
+   nfile = nfile < nact ? nfile : nact;
+   ngrp = (nact - 1)/nfile + 1;
+   nfile = (nact - 1)/ngrp + 1;
+   ds->idproc = idproc;
+   ds->ngrp = ngrp;
+   ds->nfile = nfile;
+   ds->kxp = kxp;
+   ds->modesyd = modesyd;
+   ds->knyq = -1;
+   ds->jmax = mx - kxp*idproc;
+   ds->jmax = ds->jmax < kxp ? ds->jmax : kxp;
+   ds->jmax = ds->jmax > 0 ? ds->jmax : 0;
+   ig = idproc/ngrp;
+   ds->nwriter = ngrp*ig;
+   ds->lwriter = (idproc < nact) && (idproc==ds->nwriter);
+   if ((idproc==0) && (modesx > nxh) && (nfile > 1))
+      ds->lnyq = 1;
+   ds->sbuf = (float complex *) malloc(2*(kxp+1)*modesyd
+                                       *sizeof(float complex));
+   ds->sreq[0] = MPI_REQUEST_NULL; ds->sreq[1] = MPI_REQUEST_NULL;
+   ds->sreq[2] = MPI_REQUEST_NULL; ds->sreq[3] = MPI_REQUEST_NULL;
+   ierr = ds->sbuf==NULL ? 1 : 0;
+/* writer creates file and ring buffers */
+   if (ds->lwriter) {
+      r0 = ds->nwriter;
+      r1 = r0 + ngrp < nact ? r0 + ngrp : nact;
+      ds->kx0 = kxp*r0;
+      ds->nkx = (mx < kxp*r1 ? mx : kxp*r1) - ds->kx0;
+      if ((modesx > nxh) && (ig==(nfile-1))) {
+         ds->knyq = ds->nkx;
+         ds->nkx += 1;
+      }
+      ds->nbuf = nbuf > 2 ? nbuf : 2;
+      ds->nrec = 2*sizeof(int) + sizeof(float complex)*ds->nkx*modesyd;
+      ds->ring = (char *) malloc(ds->nrec*ds->nbuf);
+      ds->rreq = (MPI_Request *) malloc(ngrp*sizeof(MPI_Request));
+      if (nfile==1)
+         sprintf(fn,"%s",fname);
+      else
+         sprintf(fn,"%s.%d",fname,ig+1);
+      ds->fd = open(fn,O_WRONLY|O_CREAT|O_TRUNC,0644);
+      if ((ds->ring==NULL) || (ds->rreq==NULL) || (ds->fd < 0)) {
+         ierr = 1;
+      }
+/* write header */
+      else {
+         memset(&dh,0,sizeof(dh));
+         memcpy(dh.magic,diagmagic,8);
+         dh.nx = nx; dh.ny = ny; dh.modesx = modesx; dh.modesy = modesy;
+         dh.modesyd = modesyd; dh.kx0 = ds->kx0; dh.nkx = ds->nkx;
+         dh.nfile = nfile;
+         nw = write(ds->fd,&dh,sizeof(dh));
+         nn = nw;
+         if (nn != sizeof(dh))
+            ierr = 1;
+      }
+      if (ierr==0) {
+         pthread_mutex_init(&ds->lock,NULL);
+         pthread_cond_init(&ds->cfull,NULL);
+         pthread_cond_init(&ds->cfree,NULL);
+         if (pthread_create(&ds->writer,NULL,cppdiagwr2,ds) != 0) {
+            pthread_mutex_destroy(&ds->lock);
+            pthread_cond_destroy(&ds->cfull);
+            pthread_cond_destroy(&ds->cfree);
+            ierr = 1;
+         }
+      }
+   }
+/* check for errors on any processor */
+   MPI_Allreduce(&ierr,irc,1,MPI_INT,MPI_MAX,ds->comm);
+   if (*irc != 0) {
+      if (ds->lwriter) {
+         if ((ierr==0) && (ds->fd >= 0)) {
+            pthread_mutex_lock(&ds->lock);
+            ds->ldone = 1;
+            pthread_cond_signal(&ds->cfull);
+            pthread_mutex_unlock(&ds->lock);
+            pthread_join(ds->writer,NULL);
+            pthread_mutex_destroy(&ds->lock);
+            pthread_cond_destroy(&ds->cfull);
+            pthread_cond_destroy(&ds->cfree);
+         }
+         if (ds->fd >= 0)
+            close(ds->fd);
+         free(ds->ring);
+         free(ds->rreq);
+      }
+      free(ds->sbuf);
+      MPI_Comm_free(&ds->comm);
+      return;
+   }
+   ds->lopen = 1;
+   *nd = n;
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppdiagwrite2(int nd, float complex pott[], int ntime,
+                   int *irc) {
+/* this subroutine sends the fourier modes in pott to the writer of
+   this processor's group.  on a writer, the record started on the
+   previous call is completed and passed to the background thread,
+   then the local modes are copied into the next free buffer and
+   receives are posted for the rest of the group.
+   pott may be modified as soon as this subroutine returns.
+   must be called by all processors
+   input: all except irc, output: irc
+   nd = sink number returned by cppdiagopen2
+   pott[j][k] = mode kx = j + kxp*(kstrt-1), ky index k, as stored by
+   cpprdmodes2, with kx = nx/2 at j = kxp on processor 0
+   ntime = time step stored with record
+   irc = error code: 0 = ok, 2 = write error in earlier record on this
+   processor, 3 = sink not open
+local data                                                            */
+   int j, n, nsize, modesyd, kxp, idproc;
+   int *ihd;
+   float complex *rec, *sb;
+   struct diagsink *ds;
+   if ((nd < 0) || (nd >= NDIAGMAX) || (!sinks[nd].lopen)) {
+      *irc = 3;
+      return;
+   }
+   ds = &sinks[nd];
+   *irc = 0;
+   modesyd = ds->modesyd;
+   kxp = ds->kxp;
+   idproc = ds->idproc;
+/* send modes to writer, reusing the buffer of two calls ago */
+   if ((!ds->lwriter) || ds->lnyq) {
+      sb = &ds->sbuf[(kxp+1)*modesyd*ds->isend];
+      MPI_Waitall(2,&ds->sreq[2*ds->isend],MPI_STATUSES_IGNORE);
+      if ((!ds->lwriter) && (ds->jmax > 0)) {
+         nsize = modesyd*ds->jmax;
+         for (j = 0; j < nsize; j++) {
+            sb[j] = pott[j];
+         }
+         MPI_Isend(sb,2*nsize,MPI_FLOAT,ds->nwriter,1,ds->comm,
+                   &ds->sreq[2*ds->isend]);
+      }
+      if (ds->lnyq) {
+         for (j = 0; j < modesyd; j++) {
+            sb[j+modesyd*kxp] = pott[j+modesyd*kxp];
+         }
+         MPI_Isend(&sb[modesyd*kxp],2*modesyd,MPI_FLOAT,
+                   ds->ngrp*(ds->nfile-1),2,ds->comm,
+                   &ds->sreq[2*ds->isend+1]);
+      }
+      ds->isend = 1 - ds->isend;
+   }
+   if (!ds->lwriter)
+      return;
+/* complete previous record and pass it to background thread */
+   cppdiagpass2(ds);
+/* wait for a free buffer */
+   pthread_mutex_lock(&ds->lock);
+   while (ds->nfull==ds->nbuf) {
+      pthread_cond_wait(&ds->cfree,&ds->lock);
+   }
+   *irc = ds->wrc;
+   pthread_mutex_unlock(&ds->lock);
+/* copy local modes into record */
+   ihd = (int *) &ds->ring[ds->nrec*ds->ifill];
+   ihd[0] = ntime;
+   ihd[1] = 0;
+   rec = (float complex *) &ihd[2];
+   nsize = modesyd*ds->jmax;
+   for (j = 0; j < nsize; j++) {
+      rec[j] = pott[j];
+   }
+   if ((ds->knyq >= 0) && (idproc==0)) {
+      for (j = 0; j < modesyd; j++) {
+         rec[j+modesyd*ds->knyq] = pott[j+modesyd*kxp];
+      }
+   }
+/* post receives for rest of group */
+   ds->npend = 0;
+   for (n = 1; n < ds->ngrp; n++) {
+      j = kxp*(idproc + n) - ds->kx0;
+      nsize = ds->nkx - (ds->knyq >= 0 ? 1 : 0) - j;
+      if (nsize <= 0)
+         break;
+      nsize = nsize < kxp ? nsize : kxp;
+      MPI_Irecv(&rec[modesyd*j],2*modesyd*nsize,MPI_FLOAT,idproc+n,1,
+                ds->comm,&ds->rreq[ds->npend]);
+      ds->npend += 1;
+   }
+   if ((ds->knyq >= 0) && (idproc != 0)) {
+      MPI_Irecv(&rec[modesyd*ds->knyq],2*modesyd,MPI_FLOAT,0,2,ds->comm,
+                &ds->rreq[ds->npend]);
+      ds->npend += 1;
+   }
+   ds->lpend = 1;
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppdiagclose2(int nd, int *irc) {
+/* this subroutine completes outstanding messages of sink nd, waits for
+   all records to be written, stops the background threads, closes the
+   files and frees the buffers.  must be called by all processors
+   irc = error code on all processors: 0 = ok, 2 = write error on any
+   writer, 3 = sink not open
+local data                                                            */
+   int ierr;
+   struct diagsink *ds;
+   if ((nd < 0) || (nd >= NDIAGMAX) || (!sinks[nd].lopen)) {
+      *irc = 3;
+      return;
+   }
+   ds = &sinks[nd];
+   MPI_Waitall(4,ds->sreq,MPI_STATUSES_IGNORE);
+   ierr = 0;
+   if (ds->lwriter) {
+      cppdiagpass2(ds);
+      pthread_mutex_lock(&ds->lock);
+      ds->ldone = 1;
+      pthread_cond_signal(&ds->cfull);
+      pthread_mutex_unlock(&ds->lock);
+      pthread_join(ds->writer,NULL);
+      if (close(ds->fd) != 0)
+         ds->wrc = 2;
+      ierr = ds->wrc;
+      pthread_mutex_destroy(&ds->lock);
+      pthread_cond_destroy(&ds->cfull);
+      pthread_cond_destroy(&ds->cfree);
+      free(ds->ring);
+      free(ds->rreq);
+      ds->ring = NULL;
+      ds->rreq = NULL;
+   }
+   MPI_Allreduce(&ierr,irc,1,MPI_INT,MPI_MAX,ds->comm);
+   free(ds->sbuf);
+   ds->sbuf = NULL;
+   MPI_Comm_free(&ds->comm);
+   ds->lopen = 0;
+   return;
+}
+
+/* Interfaces to Fortran */
+
+/*--------------------------------------------------------------------*/
+void cppdiagopen2_(char *fname, int *nx, int *ny, int *modesx,
+                   int *modesy, int *kstrt, int *kxp, int *modesyd,
+                   int *nwrite, int *nbuf, int *nd, int *irc,
+                   size_t lfname) {
+/* lfname = length of fortran character variable fname, which is */
+/* blank padded and not null terminated                          */
+   char cname[256];
+   size_t lf;
+   lf = lfname;
+   while ((lf > 0) && (fname[lf-1]==' '))
+      lf -= 1;
+   if (lf >= sizeof(cname)) {
+      *nd = -1;
+      *irc = 1;
+      return;
+   }
+   memcpy(cname,fname,lf);
+   cname[lf] = '\0';
+   cppdiagopen2(cname,*nx,*ny,*modesx,*modesy,*kstrt,*kxp,*modesyd,
+                *nwrite,*nbuf,nd,irc);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppdiagwrite2_(int *nd, float complex *pott, int *ntime, int *irc) {
+   cppdiagwrite2(*nd,pott,*ntime,irc);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppdiagclose2_(int *nd, int *irc) {
+   cppdiagclose2(*nd,irc);
+   return;
+}
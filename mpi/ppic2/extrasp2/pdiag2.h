@@ -0,0 +1,9 @@
+/* header file for pdiag2.c */
+
+void cppdiagopen2(char *fname, int nx, int ny, int modesx, int modesy,
+                  int kstrt, int kxp, int modesyd, int nwrite, int nbuf,
+                  int *nd, int *irc);
+
+void cppdiagwrite2(int nd, float complex pott[], int ntime, int *irc);
+
+void cppdiagclose2(int nd, int *irc);
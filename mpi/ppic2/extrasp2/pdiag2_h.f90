@@ -0,0 +1,34 @@
+!-----------------------------------------------------------------------
+! Interface file for pdiag2.c
+      module pdiag2_h
+      implicit none
+!
+      interface
+         subroutine cppdiagopen2(fname,nx,ny,modesx,modesy,kstrt,kxp,   &
+     &modesyd,nwrite,nbuf,nd,irc)
+         implicit none
+         character(len=*), intent(in) :: fname
+         integer, intent(in) :: nx, ny, modesx, modesy, kstrt, kxp
+         integer, intent(in) :: modesyd, nwrite, nbuf
+         integer, intent(inout) :: nd, irc
+         end subroutine
+      end interface
+!
+      interface
+         subroutine cppdiagwrite2(nd,pott,ntime,irc)
+         implicit none
+         integer, intent(in) :: nd, ntime
+         integer, intent(inout) :: irc
+         complex, dimension(*), intent(in) :: pott
+         end subroutine
+      end interface
+!
+      interface
+         subroutine cppdiagclose2(nd,irc)
+         implicit none
+         integer, intent(in) :: nd
+         integer, intent(inout) :: irc
+         end subroutine
+      end interface
+!
+      end module
@@ -500,3 +500,147 @@ c mode numbers kx = 0, nx/2
       endif
       return
       end
+c-----------------------------------------------------------------------
+      subroutine PPWKMODES2(pott,pkw,wm,dt,it,nt,nx,ny,modesx,modesy,
+     1kstrt,kxp,modesxpd,modesyd,iw,iwd)
+c this subroutine accumulates a windowed discrete fourier transform in
+c time of the modes in pott, extracted by PPRDMODES2, for the
+c frequencies in wm, so that a frequency-wavenumber spectrum can be
+c obtained without storing the modes at each time step.
+c each processor transforms only its own modes, no communication is done
+c pkw(k,j,l) = pkw(k,j,l) + dt*w(it)*pott(k,j)*exp(i*wm(l)*dt*(it-1))
+c where w(it) = 0.5*(1 - cos(2*pi*(it-1)/(nt-1))) is a hann window
+c a mode varying as exp(-i*w0*t) has a peak at wm(l) = w0
+c pkw must be zeroed before the first sample
+c modes stored: kx = (kxp*(idproc)+(0,1,...kxp-1)) where idproc=kstrt-1,
+c and ky=(0,+-1,+-2,...,+-(NY/2-1),NY/2)
+c except kx = NX/2 is stored at location kxp+1 when idproc=0.
+c pott = unpacked complex modes at sample it
+c pkw = accumulated transform for each mode and frequency
+c wm = frequencies to be calculated
+c dt = time interval between samples
+c it = sample number, 1 <= it <= nt, other samples are ignored
+c nt = total number of samples in window
+c nx/ny = system length in x/y direction
+c modesx/modesy = number of modes stored in x/y direction
+c kstrt = starting data block number
+c kxp = number of data values per block
+c modesyd = first dimension of arrays pott, pkw,
+c where modesyd >= min(2*modesy-1,ny)
+c modesxpd = second dimension of arrays pott, pkw,
+c modesxpd >= min(modesx,kxp), unless modesx = nx/2+1, in which case
+c modesxpd = kxp+1
+c iw = number of frequencies
+c iwd = third dimension of array pkw, iwd >= iw
+      implicit none
+      integer it, nt, nx, ny, modesx, modesy, kstrt, kxp
+      integer modesxpd, modesyd, iw, iwd
+      real dt
+      complex pott, pkw
+      real wm
+      dimension pott(modesyd,modesxpd), pkw(modesyd,modesxpd,iwd)
+      dimension wm(iw)
+c local data
+      integer nxh, jmax, kmax, j1, j, k, l
+      complex zt
+      double precision tt, wt
+      if ((it.lt.1).or.(it.gt.nt)) return
+      nxh = nx/2
+      if (kstrt.gt.nxh) return
+      kmax = min0(2*modesy-1,ny)
+      jmax = min0(modesx,nxh) - kxp*(kstrt - 1)
+      jmax = max0(0,min0(jmax,kxp))
+c kx = nx/2 mode on processor 0
+      j1 = 0
+      if ((kstrt.eq.1).and.(modesx.gt.nxh)) j1 = kxp + 1
+c hann window
+      wt = 1.0d0
+      if (nt.gt.1) then
+         wt = 6.283185307179586d0*dble(it-1)/dble(nt-1)
+         wt = 0.5d0*(1.0d0 - dcos(wt))
+      endif
+      wt = dble(dt)*wt
+      tt = dble(dt)*dble(it-1)
+      do 40 l = 1, iw
+      zt = cmplx(real(wt*dcos(dble(wm(l))*tt)),
+     1           real(wt*dsin(dble(wm(l))*tt)))
+      do 20 j = 1, jmax
+      do 10 k = 1, kmax
+      pkw(k,j,l) = pkw(k,j,l) + zt*pott(k,j)
+   10 continue
+   20 continue
+      if (j1.gt.0) then
+         do 30 k = 1, kmax
+         pkw(k,j1,l) = pkw(k,j1,l) + zt*pott(k,j1)
+   30    continue
+      endif
+   40 continue
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPWKPOW2(pkw,wkp,dt,nt,nx,ny,modesx,modesy,kstrt,kxp,
+     1modesxpd,modesyd,iw,iwd)
+c this subroutine calculates the frequency-wavenumber power spectrum
+c of the modes on this processor from the transform accumulated by
+c PPWKMODES2 over nt samples
+c wkp(k,j,l) = |pkw(k,j,l)|**2/(dt*sum(w(it)**2))
+c where w(it) is the hann window used by PPWKMODES2
+c pkw = accumulated transform for each mode and frequency
+c wkp = power spectrum for each mode and frequency
+c dt = time interval between samples
+c nt = total number of samples in window
+c nx/ny = system length in x/y direction
+c modesx/modesy = number of modes stored in x/y direction
+c kstrt = starting data block number
+c kxp = number of data values per block
+c modesyd = first dimension of arrays pkw, wkp,
+c where modesyd >= min(2*modesy-1,ny)
+c modesxpd = second dimension of arrays pkw, wkp,
+c modesxpd >= min(modesx,kxp), unless modesx = nx/2+1, in which case
+c modesxpd = kxp+1
+c iw = number of frequencies
+c iwd = third dimension of arrays pkw, wkp, iwd >= iw
+      implicit none
+      integer nt, nx, ny, modesx, modesy, kstrt, kxp
+      integer modesxpd, modesyd, iw, iwd
+      real dt
+      complex pkw
+      real wkp
+      dimension pkw(modesyd,modesxpd,iwd), wkp(modesyd,modesxpd,iwd)
+c local data
+      integer nxh, jmax, kmax, j1, j, k, l
+      real anorm
+      double precision wt, sum1
+      nxh = nx/2
+      if (kstrt.gt.nxh) return
+      kmax = min0(2*modesy-1,ny)
+      jmax = min0(modesx,nxh) - kxp*(kstrt - 1)
+      jmax = max0(0,min0(jmax,kxp))
+      j1 = 0
+      if ((kstrt.eq.1).and.(modesx.gt.nxh)) j1 = kxp + 1
+c sum squares of hann window
+      sum1 = 1.0d0
+      if (nt.gt.1) then
+         sum1 = 0.0d0
+         do 10 j = 1, nt
+         wt = 6.283185307179586d0*dble(j-1)/dble(nt-1)
+         wt = 0.5d0*(1.0d0 - dcos(wt))
+         sum1 = sum1 + wt*wt
+   10    continue
+      endif
+      anorm = 1.0/real(dble(dt)*sum1)
+      do 50 l = 1, iw
+      do 30 j = 1, jmax
+      do 20 k = 1, kmax
+      wkp(k,j,l) = anorm*(real(pkw(k,j,l))**2 + aimag(pkw(k,j,l))**2)
+   20 continue
+   30 continue
+      if (j1.gt.0) then
+         do 40 k = 1, kmax
+         wkp(k,j1,l) = anorm*(real(pkw(k,j1,l))**2
+     1                      + aimag(pkw(k,j1,l))**2)
+   40    continue
+      endif
+   50 continue
+      return
+      end
@@ -21,3 +21,12 @@ void cpprdmodes2(float complex pot[], float complex pott[], int nx,
 void cppwrmodes2(float complex pot[], float complex pott[], int nx,
                  int ny, int modesx, int modesy, int kstrt, int nyv,
                  int kxp, int modesxpd, int modesyd);
+
+void cppwkmodes2(float complex pott[], float complex pkw[], float wm[],
+                 float dt, int it, int nt, int nx, int ny, int modesx,
+                 int modesy, int kstrt, int kxp, int modesxpd,
+                 int modesyd, int iw, int iwd);
+
+void cppwkpow2(float complex pkw[], float wkp[], float dt, int nt,
+               int nx, int ny, int modesx, int modesy, int kstrt,
+               int kxp, int modesxpd, int modesyd, int iw, int iwd);
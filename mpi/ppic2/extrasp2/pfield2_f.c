@@ -8,7 +8,7 @@ void ppotp2_(float complex *q, float complex *pot, float complex *ffc,
              float *we, int *nx, int *ny, int *kstrt, int *nyv,
              int *kxp, int *nyhd);
 
-void dppivf2_(float complex *f, float complex *df, int *nx, int *ny,
+void ppdivf2_(float complex *f, float complex *df, int *nx, int *ny,
               int *kstrt, int *ndim, int *nyv, int *kxp);
 
 void ppgradf2_(float complex *df, float complex *f, int *nx, int *ny,
@@ -26,6 +26,16 @@ void ppwrmodes2_(float complex *pot, float complex *pott, int *nx,
                  int *ny, int *modesx, int *modesy, int *kstrt,
                  int *nyv, int *kxp, int *modesxpd, int *modesyd);
 
+void ppwkmodes2_(float complex *pott, float complex *pkw, float *wm,
+                 float *dt, int *it, int *nt, int *nx, int *ny,
+                 int *modesx, int *modesy, int *kstrt, int *kxp,
+                 int *modesxpd, int *modesyd, int *iw, int *iwd);
+
+void ppwkpow2_(float complex *pkw, float *wkp, float *dt, int *nt,
+               int *nx, int *ny, int *modesx, int *modesy, int *kstrt,
+               int *kxp, int *modesxpd, int *modesyd, int *iw,
+               int *iwd);
+
 /* Interfaces to C */
 
 /*--------------------------------------------------------------------*/
@@ -39,7 +49,7 @@ void cppotp2(float complex q[], float complex pot[],
 /*--------------------------------------------------------------------*/
 void cppdivf2(float complex f[], float complex df[], int nx, int ny,
               int kstrt, int ndim, int nyv, int kxp) {
-   dppivf2_(f,df,&nx,&ny,&kstrt,&ndim,&nyv,&kxp);
+   ppdivf2_(f,df,&nx,&ny,&kstrt,&ndim,&nyv,&kxp);
    return;
 }
 
@@ -75,3 +85,22 @@ void cppwrmodes2(float complex pot[], float complex pott[], int nx,
                &modesxpd,&modesyd);
    return;
 }
+
+/*--------------------------------------------------------------------*/
+void cppwkmodes2(float complex pott[], float complex pkw[], float wm[],
+                 float dt, int it, int nt, int nx, int ny, int modesx,
+                 int modesy, int kstrt, int kxp, int modesxpd,
+                 int modesyd, int iw, int iwd) {
+   ppwkmodes2_(pott,pkw,wm,&dt,&it,&nt,&nx,&ny,&modesx,&modesy,&kstrt,
+               &kxp,&modesxpd,&modesyd,&iw,&iwd);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppwkpow2(float complex pkw[], float wkp[], float dt, int nt,
+               int nx, int ny, int modesx, int modesy, int kstrt,
+               int kxp, int modesxpd, int modesyd, int iw, int iwd) {
+   ppwkpow2_(pkw,wkp,&dt,&nt,&nx,&ny,&modesx,&modesy,&kstrt,&kxp,
+             &modesxpd,&modesyd,&iw,&iwd);
+   return;
+}
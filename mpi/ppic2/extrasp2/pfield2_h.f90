@@ -63,5 +63,30 @@
          complex, dimension(modesyd,modesxpd), intent(in) :: pott
          end subroutine
       end interface
+!
+      interface
+         subroutine PPWKMODES2(pott,pkw,wm,dt,it,nt,nx,ny,modesx,modesy,&
+     &kstrt,kxp,modesxpd,modesyd,iw,iwd)
+         implicit none
+         integer, intent(in) :: it, nt, nx, ny, modesx, modesy
+         integer, intent(in) :: kstrt, kxp, modesxpd, modesyd, iw, iwd
+         real, intent(in) :: dt
+         complex, dimension(modesyd,modesxpd), intent(in) :: pott
+         complex, dimension(modesyd,modesxpd,iwd), intent(inout) :: pkw
+         real, dimension(iw), intent(in) :: wm
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPWKPOW2(pkw,wkp,dt,nt,nx,ny,modesx,modesy,kstrt,   &
+     &kxp,modesxpd,modesyd,iw,iwd)
+         implicit none
+         integer, intent(in) :: nt, nx, ny, modesx, modesy
+         integer, intent(in) :: kstrt, kxp, modesxpd, modesyd, iw, iwd
+         real, intent(in) :: dt
+         complex, dimension(modesyd,modesxpd,iwd), intent(in) :: pkw
+         real, dimension(modesyd,modesxpd,iwd), intent(inout) :: wkp
+         end subroutine
+      end interface
 !
       end module
@@ -44,8 +44,30 @@ int main(int argc, char *argv[]) {
 
 /* declare scalars for MPI code */
    int ntpose = 1;
+/* ltpose = (0,1) = (no,yes) use non-blocking all-to-all transpose */
+   int ltpose = 0;
+/* lmove = (0,1) = (no,yes) send particles directly to their destination */
+/* processor, instead of passing them through nearest neighbors */
+   int lmove = 0;
+/* nbal = number of time steps between load balancing, 0 = never */
+   int nbal = 0;
+/* ybal = largest partition allowed by load balancing, in units of */
+/* the uniform partition size */
+   float ybal = 2.0;
+/* nchkpt = number of time steps between checkpoints, 0 = never */
+   int nchkpt = 0;
+/* lrestart = (0,1) = (no,yes) restart from checkpoint file fchkpt */
+   int lrestart = 0;
+   char fchkpt[] = "ppchkpt2.dat";
    int nvp, idproc, kstrt, npmax, kxp, kyp, nypmx, nypmn;
-   int nyp, noff, npp, nps, nbmax, ntmax;
+   int nyp, noff, npp, nps, nbmax, ntmax, nbs;
+   int kyps, nypu, nypbmx;
+   float pimb;
+/* declare scalars for checkpoint: */
+/* isc/fsc = integer/real scalars saved in checkpoint */
+   int nvpo;
+   int isc[6];
+   float fsc[2];
 
 /* declare arrays for standard code: */
 /* part, part2 = particle arrays */
@@ -69,7 +91,7 @@ int main(int argc, char *argv[]) {
 /* npic = scratch array for reordering particles */
    int *npic = NULL;
    double wtot[4], work[4];
-   int info[7];
+   int info[7], ibal[1], iwork[1];
 
 /* declare arrays for MPI code: */
 /* bs/br = complex send/receive buffers for data transpose */
@@ -77,16 +99,28 @@ int main(int argc, char *argv[]) {
 /* sbufl/sbufr = particle buffers sent to nearby processors */
 /* rbufl/rbufr = particle buffers received from nearby processors */
    float *sbufl = NULL, *sbufr = NULL, *rbufl = NULL, *rbufr = NULL;
+/* sbuf = buffer for particles sent to any processor */
+   float *sbuf = NULL;
 /* edges[0:1] = lower:upper y boundaries of particle partition */
    float *edges = NULL;
-/* scr = guard cell buffer received from nearby processors */
-   float *scr = NULL;
+/* scs/scr = guard cell buffers sent to/received from nearby processors */
+   float *scs = NULL, *scr = NULL;
+/* igdq/igdf = persistent guard cell exchange plans for qe/fxye */
+   int igdq = 0, igdf = 0;
+/* qu/fxyu = charge density/smoothed electric field in uniform */
+/* partition used by fft */
+   float *qu = NULL, *fxyu = NULL;
+/* npicy = number of particles in each grid row in y */
+   float *npicy = NULL, *scry = NULL;
 
 /* declare and initialize timing data */
    float time;
    struct timeval itime;
    float tdpost = 0.0, tguard = 0.0, ttp = 0.0, tfield = 0.0;
-   float tpush = 0.0, tsort = 0.0, tmov = 0.0;
+   float tpush = 0.0, tsort = 0.0, tmov = 0.0, tbal = 0.0;
+   float tchkpt = 0.0;
+/* pimbav/pimbmx = average/maximum particle imbalance */
+   float pimbav = 0.0, pimbmx = 0.0;
    float tfft[2] = {0.0,0.0};
    double dtime;
 
@@ -137,6 +171,16 @@ int main(int argc, char *argv[]) {
    kxp = (nxh - 1)/nvp + 1;
 /* kyp = number of complex grids in each field partition in y direction */
    kyp = (ny - 1)/nvp + 1;
+/* kyps = actual size of uniform field partition in y direction */
+   kyps = ny - kyp*idproc;
+   kyps = 0 > kyps ? 0 : kyps;
+   kyps = kyp < kyps ? kyp : kyps;
+/* nypbmx = largest partition allowed by load balancing */
+   if (nbal > 0) {
+      nypbmx = ybal*(float) kyp;
+      nypbmx = ny < nypbmx ? ny : nypbmx;
+      nypmx = nypbmx + 1;
+   }
 /* npmax = maximum number of electrons in each partition */
    npmax = (np/nvp)*1.25;
 /* nbmax = size of buffer for passing particles between processors */
@@ -158,13 +202,36 @@ int main(int argc, char *argv[]) {
    npic = (int *) malloc(nypmx*sizeof(int));
 
 /* allocate data for MPI code */
-   bs = (float complex *) malloc(ndim*kxp*kyp*sizeof(float complex));
-   br = (float complex *) malloc(ndim*kxp*kyp*sizeof(float complex));
+/* non-blocking transpose needs a separate buffer for each processor */
+   nbs = 1;
+   if (ltpose==1)
+      nbs = nvp;
+   bs = (float complex *) malloc(ndim*kxp*kyp*nbs*sizeof(float complex));
+   br = (float complex *) malloc(ndim*kxp*kyp*nbs*sizeof(float complex));
    sbufl = (float *) malloc(idimp*nbmax*sizeof(float));
    sbufr = (float *) malloc(idimp*nbmax*sizeof(float));
    rbufl = (float *) malloc(idimp*nbmax*sizeof(float));
    rbufr = (float *) malloc(idimp*nbmax*sizeof(float));
-   scr = (float *) malloc(nxe*2*sizeof(float));
+   if (lmove==1)
+      sbuf = (float *) malloc(idimp*ntmax*sizeof(float));
+   scs = (float *) malloc(nnxe*sizeof(float));
+   scr = (float *) malloc(nnxe*sizeof(float));
+/* create persistent guard cell exchanges, reused every time step */
+   cppnguard2init(scs,scr,&igdq,kstrt,nvp,nxe,nypmx);
+   cppnguard2init(scs,scr,&igdf,kstrt,nvp,nnxe,nypmx);
+/* load balancing needs separate fft arrays in uniform partition */
+   if (nbal > 0) {
+      qu = (float *) malloc(nxe*kyp*sizeof(float));
+      fxyu = (float *) malloc(ndim*nxe*kyp*sizeof(float));
+      npicy = (float *) malloc(ny*sizeof(float));
+      scry = (float *) malloc(ny*sizeof(float));
+      nypu = kyp;
+   }
+   else {
+      qu = qe;
+      fxyu = fxye;
+      nypu = nypmx;
+   }
 
 /* prepare fft tables */
    cwpfft2rinit(mixup,sct,indx,indy,nxhy,nxyh);
@@ -172,16 +239,65 @@ int main(int argc, char *argv[]) {
    isign = 0;
    cppois22(qt,fxyt,isign,ffc,ax,ay,affp,&we,nx,ny,kstrt,nye,kxp,nyh);
 /* initialize electrons */
-   nps = 1;
-   npp = 0;
-   cpdistr2(part,edges,&npp,nps,vtx,vty,vx0,vy0,npx,npy,nx,ny,idimp,
-            npmax,idps,ipbc,&ierr);
+   if (lrestart==0) {
+      nps = 1;
+      npp = 0;
+      cpdistr2(part,edges,&npp,nps,vtx,vty,vx0,vy0,npx,npy,nx,ny,idimp,
+               npmax,idps,ipbc,&ierr);
 /* check for particle initialization error */
-   if (ierr != 0) {
+      if (ierr != 0) {
+         if (kstrt==1) {
+            printf("particle initialization error: ierr=%d\n",ierr);
+         }
+         goto L3000;
+      }
+   }
+/* restart electrons from checkpoint file: updates part, npp, ntime */
+   else {
+      dtimer(&dtime,&itime,-1);
+      cpprchkpth2(fchkpt,6,isc,2,fsc,&nvpo,&ierr);
+      if (ierr==0) {
+         if ((isc[1] != nx) || (isc[2] != ny) || (isc[3] != npx)
+            || (isc[4] != npy) || (isc[5] != idimp)) {
+            ierr = 2;
+         }
+         else {
+            ntime = isc[0];
+            we = fsc[0];
+            wke = fsc[1];
+            cpprchkptp2(2,part,&npp,idimp,npmax,&ierr);
+         }
+         cpprchkptc2();
+      }
+      if (ierr != 0) {
+         if (kstrt==1) {
+            printf("checkpoint read error: ierr=%d\n",ierr);
+         }
+         goto L3000;
+      }
+/* move particles read into partition which owns them */
+      do {
+         cppholes2(part,edges,npp,ihole,idimp,npmax,idps,ntmax);
+         ibal[0] = ihole[0];
+         cppimax(ibal,iwork,1);
+         if (ibal[0] > 0) {
+            cppmove2(part,edges,&npp,sbufr,sbufl,rbufr,rbufl,ihole,ny,
+                     kstrt,nvp,idimp,npmax,idps,nbmax,ntmax,info);
+            if (info[0] != 0) {
+               ierr = info[0];
+               if (kstrt==1) {
+                  printf("restart particle manager error: ierr=%d\n",
+                         ierr);
+               }
+               goto L3000;
+            }
+         }
+      } while (ibal[0] > 0);
+      dtimer(&dtime,&itime,1);
+      tchkpt += (float) dtime;
       if (kstrt==1) {
-         printf("particle initialization error: ierr=%d\n",ierr);
+         printf("restart from ntime, nvp = %d,%d\n",ntime,nvpo);
       }
-      goto L3000;
    }
 
 /* * * * start main iteration loop * * * */
@@ -203,17 +319,28 @@ L500: if (nloop <= ntime)
 /* add guard cells with standard procedure: updates qe */
       dtimer(&dtime,&itime,-1);
       cppaguard2xl(qe,nyp,nx,nxe,nypmx);
-      cppnaguard2l(qe,scr,nyp,nx,kstrt,nvp,nxe,nypmx);
+      cppnaguard2lp(qe,scs,scr,igdq,nyp,nx,nvp,nxe);
       dtimer(&dtime,&itime,1);
       time = (float) dtime;
       tguard += time;
 
+/* move charge to uniform partition used by fft: updates qu */
+      if (nbal > 0) {
+         dtimer(&dtime,&itime,-1);
+         cppfmove2(qe,qu,noff,nyp,kyp*idproc,kyps,kstrt,nvp,nxe,nypmx,
+                   kyp);
+         dtimer(&dtime,&itime,1);
+         time = (float) dtime;
+         tbal += time;
+      }
+
 /* transform charge to fourier space with standard procedure: updates qt */
-/* modifies qe */
+/* modifies qu */
       dtimer(&dtime,&itime,-1);
       isign = -1;
-      cwppfft2r((float complex *)qe,qt,bs,br,isign,ntpose,mixup,sct,&ttp,
-                indx,indy,kstrt,nvp,nxeh,nye,kxp,kyp,nypmx,nxhy,nxyh);
+      cwppfft2r((float complex *)qu,qt,bs,br,isign,ntpose,ltpose,mixup,
+                sct,&ttp,indx,indy,kstrt,nvp,nxeh,nye,kxp,kyp,nypu,nxhy,
+                nxyh);
       dtimer(&dtime,&itime,1);
       time = (float) dtime;
       tfft[0] += time;
@@ -228,21 +355,31 @@ L500: if (nloop <= ntime)
       time = (float) dtime;
       tfield += time;
 
-/* transform force to real space with standard procedure: updates fxye */
+/* transform force to real space with standard procedure: updates fxyu */
 /* modifies fxyt */
       dtimer(&dtime,&itime,-1);
       isign = 1;
-      cwppfft2r2((float complex *)fxye,fxyt,bs,br,isign,ntpose,mixup,sct,
-                 &ttp,indx,indy,kstrt,nvp,nxeh,nye,kxp,kyp,nypmx,nxhy,
-                 nxyh);
+      cwppfft2r2((float complex *)fxyu,fxyt,bs,br,isign,ntpose,ltpose,
+                 mixup,sct,&ttp,indx,indy,kstrt,nvp,nxeh,nye,kxp,kyp,
+                 nypu,nxhy,nxyh);
       dtimer(&dtime,&itime,1);
       time = (float) dtime;
       tfft[0] += time;
       tfft[1] += ttp;
 
+/* move force to particle partition: updates fxye */
+      if (nbal > 0) {
+         dtimer(&dtime,&itime,-1);
+         cppfmove2(fxyu,fxye,kyp*idproc,kyps,noff,nyp,kstrt,nvp,nnxe,kyp,
+                   nypmx);
+         dtimer(&dtime,&itime,1);
+         time = (float) dtime;
+         tbal += time;
+      }
+
 /* copy guard cells with standard procedure: updates fxye */
       dtimer(&dtime,&itime,-1);
-      cppncguard2l(fxye,nyp,kstrt,nvp,nnxe,nypmx);
+      cppncguard2lp(fxye,scs,scr,igdf,nyp,nvp,nnxe);
       cppcguard2xl(fxye,nyp,nx,ndim,nxe,nypmx);
       dtimer(&dtime,&itime,1);
       time = (float) dtime;
@@ -265,8 +402,14 @@ L500: if (nloop <= ntime)
       }
 /* move electrons into appropriate spatial regions: updates part, npp */
       dtimer(&dtime,&itime,-1);
-      cppmove2(part,edges,&npp,sbufr,sbufl,rbufr,rbufl,ihole,ny,kstrt,nvp,
-               idimp,npmax,idps,nbmax,ntmax,info);
+      if (lmove==1) {
+         cppmove2nb(part,edges,&npp,sbuf,ihole,ny,kstrt,nvp,idimp,npmax,
+                    idps,ntmax,info);
+      }
+      else {
+         cppmove2(part,edges,&npp,sbufr,sbufl,rbufr,rbufl,ihole,ny,kstrt,
+                  nvp,idimp,npmax,idps,nbmax,ntmax,info);
+      }
       dtimer(&dtime,&itime,1);
       time = (float) dtime;
       tmov += time;
@@ -278,6 +421,10 @@ L500: if (nloop <= ntime)
          }
          goto L3000;
       }
+/* particle imbalance = maximum/average number of particles */
+      pimb = (float) info[1]*((float) nvp/np);
+      pimbav += pimb;
+      pimbmx = pimb > pimbmx ? pimb : pimbmx;
 
 /* sort particles for standard code: updates part */
       if (sortime > 0) {
@@ -294,6 +441,45 @@ L500: if (nloop <= ntime)
          }
       }
 
+/* load balance particles: updates edges, nyp, noff, part, npp */
+      if (nbal > 0) {
+         if ((ntime+1)%nbal==0) {
+            dtimer(&dtime,&itime,-1);
+/* find global particle density profile in y */
+            cppcount2y(part,npicy,npp,idimp,npmax,ny);
+            cppsum(npicy,scry,ny);
+/* find new partition boundaries */
+            cpfedges2(edges,&nyp,&noff,npicy,1,nypbmx,ny,kstrt,nvp,idps);
+/* move particles into new partitions, at most ntmax at a time */
+            do {
+               cppholes2(part,edges,npp,ihole,idimp,npmax,idps,ntmax);
+               ibal[0] = ihole[0];
+               cppimax(ibal,iwork,1);
+               if (ibal[0] > 0) {
+                  if (lmove==1) {
+                     cppmove2nb(part,edges,&npp,sbuf,ihole,ny,kstrt,nvp,
+                                idimp,npmax,idps,ntmax,info);
+                  }
+                  else {
+                     cppmove2(part,edges,&npp,sbufr,sbufl,rbufr,rbufl,
+                              ihole,ny,kstrt,nvp,idimp,npmax,idps,nbmax,
+                              ntmax,info);
+                  }
+                  if (info[0] != 0) {
+                     ierr = info[0];
+                     if (kstrt==1) {
+                        printf("load balance error: ierr=%d\n",ierr);
+                     }
+                     goto L3000;
+                  }
+               }
+            } while (ibal[0] > 0);
+            dtimer(&dtime,&itime,1);
+            time = (float) dtime;
+            tbal += time;
+         }
+      }
+
 /* energy diagnostic */
       wtot[0] = we;
       wtot[1] = wke;
@@ -309,10 +495,42 @@ L500: if (nloop <= ntime)
          }
       }
       ntime += 1;
+
+/* write checkpoint with MPI-IO: charge density, electric field and */
+/* particles of all processors are written to one file */
+      if (nchkpt > 0) {
+         if (ntime%nchkpt==0) {
+            dtimer(&dtime,&itime,-1);
+            isc[0] = ntime; isc[1] = nx; isc[2] = ny; isc[3] = npx;
+            isc[4] = npy; isc[5] = idimp;
+            fsc[0] = we; fsc[1] = wke;
+            cppwchkpth2(fchkpt,6,isc,2,fsc,&ierr);
+            if (ierr==0) {
+               cppwchkpta2(qe,nxe,nyp,noff,ny);
+               cppwchkpta2(fxye,nnxe,nyp,noff,ny);
+               cppwchkptp2(part,npp,idimp,npmax);
+               cppwchkptc2(&ierr);
+            }
+            if (ierr != 0) {
+               if (kstrt==1) {
+                  printf("checkpoint write error: ierr=%d\n",ierr);
+               }
+               goto L3000;
+            }
+            dtimer(&dtime,&itime,1);
+            tchkpt += (float) dtime;
+         }
+      }
       goto L500;
 L2000:
 
 /* * * * end main iteration loop * * * */
+
+/* find imbalance in push and deposit time between processors */
+   wtot[0] = tdpost + tpush;
+   wtot[1] = wtot[0];
+   cppdmax(wtot,work,1);
+   cppdsum(&wtot[1],work,1);
  
    if (kstrt==1) {
       printf("ntime = %i\n",ntime);
@@ -328,12 +546,19 @@ L2000:
       printf("push time = %f\n",tpush);
       printf("particle move time = %f\n",tmov);
       printf("sort time = %f\n",tsort);
+      printf("load balance time = %f\n",tbal);
+      if ((nchkpt > 0) || (lrestart==1))
+         printf("checkpoint time = %f\n",tchkpt);
+      printf("particle imbalance (max/average): mean, max = %f,%f\n",
+             pimbav/(float) nloop,pimbmx);
+      printf("push and deposit time imbalance (max/average) = %f\n",
+             wtot[0]*(double) nvp/wtot[1]);
       tfield += tguard + tfft[0];
       printf("total solver time = %f\n",tfield);
       tsort += tmov;
       time = tdpost + tpush + tsort;
       printf("total particle time = %f\n",time);
-      wt = time + tfield;
+      wt = time + tfield + tbal;
       printf("total time = %f\n",wt);
       printf("\n");
 
@@ -344,6 +569,9 @@ L2000:
       printf("Total Particle Time (nsec) = %f\n",time*wt);
    }
 
+   cppnguard2free(&igdf);
+   cppnguard2free(&igdq);
+
 L3000:
    cppexit();
    return 0;
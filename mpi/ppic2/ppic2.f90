@@ -38,8 +38,22 @@
 !
 ! declare scalars for MPI code
       integer :: ntpose = 1
+! ltpose = (0,1) = (no,yes) use non-blocking all-to-all transpose
+      integer :: ltpose = 0
+! lmove = (0,1) = (no,yes) send particles directly to their destination
+! processor, instead of passing them through nearest neighbors
+      integer :: lmove = 0
+! igdq/igdf = persistent guard cell exchange plans for qe/fxye
+      integer :: igdq = 0, igdf = 0
+! nbal = number of time steps between load balancing, 0 = never
+      integer :: nbal = 0
+! ybal = largest partition allowed by load balancing, in units of
+! the uniform partition size
+      real :: ybal = 2.0
       integer :: nvp, idproc, kstrt, npmax, kxp, kyp, nypmx, nypmn
-      integer :: nyp, noff, npp, nps, nbmax, ntmax
+      integer :: nyp, noff, npp, nps, nbmax, ntmax, nbs
+      integer :: kyps, nypu, nypbmx
+      real :: pimb
 !
 ! declare arrays for standard code:
 ! part, part2 = particle arrays
@@ -64,6 +78,7 @@
       integer, dimension(:), pointer :: npic
       double precision, dimension(4) :: wtot, work
       integer, dimension(7) :: info
+      integer, dimension(1) :: ibal, iwork
 !
 ! declare arrays for MPI code:
 ! bs/br = complex send/receive buffers for data transpose
@@ -71,16 +86,26 @@
 ! sbufl/sbufr = particle buffers sent to nearby processors
 ! rbufl/rbufr = particle buffers received from nearby processors
       real, dimension(:,:), pointer :: sbufl, sbufr, rbufl, rbufr
+! sbuf = buffer for particles sent to any processor
+      real, dimension(:,:), pointer :: sbuf
 ! edges(1:2) = lower:upper y boundaries of particle partition
       real, dimension(:), pointer  :: edges
-! scr = guard cell buffer received from nearby processors
-      real, dimension(:), pointer  :: scr
+! scs/scr = guard cell buffers sent to/received from nearby processors
+      real, dimension(:), pointer  :: scs, scr
+! qu/fxyu = charge density/smoothed electric field in uniform
+! partition used by fft
+      real, dimension(:,:), pointer :: qu
+      real, dimension(:,:,:), pointer :: fxyu
+! npicy = number of particles in each grid row in y
+      real, dimension(:), pointer :: npicy, scry
 !
 ! declare and initialize timing data
       real :: time
       integer, dimension(4) :: itime
       real :: tdpost = 0.0, tguard = 0.0, ttp = 0.0, tfield = 0.0
-      real :: tpush = 0.0, tsort = 0.0, tmov = 0.0
+      real :: tpush = 0.0, tsort = 0.0, tmov = 0.0, tbal = 0.0
+! pimbav/pimbmx = average/maximum particle imbalance
+      real :: pimbav = 0.0, pimbmx = 0.0
       real, dimension(2) :: tfft = 0.0
       double precision :: dtime
 !
@@ -129,6 +154,13 @@
       kxp = (nxh - 1)/nvp + 1
 ! kyp = number of complex grids in each field partition in y direction
       kyp = (ny - 1)/nvp + 1
+! kyps = actual size of uniform field partition in y direction
+      kyps = min(kyp,max(0,ny-kyp*idproc))
+! nypbmx = largest partition allowed by load balancing
+      if (nbal > 0) then
+         nypbmx = min(ny,int(ybal*real(kyp)))
+         nypmx = nypbmx + 1
+      endif
 ! npmax = maximum number of electrons in each partition
       npmax = (np/nvp)*1.25
 ! nbmax = size of buffer for passing particles between processors
@@ -144,10 +176,27 @@
       allocate(ihole(ntmax+1),npic(nypmx))
 !
 ! allocate data for MPI code
-      allocate(bs(ndim,kxp,kyp),br(ndim,kxp,kyp))
+! non-blocking transpose needs a separate buffer for each processor
+      nbs = 1
+      if (ltpose==1) nbs = nvp
+      allocate(bs(ndim,kxp,kyp*nbs),br(ndim,kxp,kyp*nbs))
       allocate(sbufl(idimp,nbmax),sbufr(idimp,nbmax))
       allocate(rbufl(idimp,nbmax),rbufr(idimp,nbmax))
-      allocate(scr(nxe))
+      if (lmove==1) allocate(sbuf(idimp,ntmax))
+      allocate(scs(nnxe),scr(nnxe))
+! create persistent guard cell exchanges, reused every time step
+      call PPNGUARD2INIT(scs,scr,igdq,kstrt,nvp,nxe,nypmx)
+      call PPNGUARD2INIT(scs,scr,igdf,kstrt,nvp,nnxe,nypmx)
+! load balancing needs separate fft arrays in uniform partition
+      if (nbal > 0) then
+         allocate(qu(nxe,kyp),fxyu(ndim,nxe,kyp))
+         allocate(npicy(ny),scry(ny))
+         nypu = kyp
+      else
+         qu => qe
+         fxyu => fxye
+         nypu = nypmx
+      endif
 !
 ! prepare fft tables
       call WPFFT2RINIT(mixup,sct,indx,indy,nxhy,nxyh)
@@ -185,17 +234,27 @@
 ! add guard cells with standard procedure: updates qe
       call dtimer(dtime,itime,-1)
       call PPAGUARD2XL(qe,nyp,nx,nxe,nypmx)
-      call PPNAGUARD2L(qe,scr,nyp,nx,kstrt,nvp,nxe,nypmx)
+      call PPNAGUARD2LP(qe,scs,scr,igdq,nyp,nx,nvp,nxe)
       call dtimer(dtime,itime,1)
       time = real(dtime)
       tguard = tguard + time
 !
+! move charge to uniform partition used by fft: updates qu
+      if (nbal > 0) then
+         call dtimer(dtime,itime,-1)
+         call PPFMOVE2(qe,qu,noff,nyp,kyp*idproc,kyps,kstrt,nvp,nxe,   &
+     &nypmx,kyp)
+         call dtimer(dtime,itime,1)
+         time = real(dtime)
+         tbal = tbal + time
+      endif
+!
 ! transform charge to fourier space with standard procedure: updates qt
-! modifies qe
+! modifies qu
       call dtimer(dtime,itime,-1)
       isign = -1
-      call WPPFFT2R(qe,qt,bs,br,isign,ntpose,mixup,sct,ttp,indx,indy,   &
-     &kstrt,nvp,nxeh,nye,kxp,kyp,nypmx,nxhy,nxyh)
+      call WPPFFT2R(qu,qt,bs,br,isign,ntpose,ltpose,mixup,sct,ttp,indx, &
+     &indy,kstrt,nvp,nxeh,nye,kxp,kyp,nypu,nxhy,nxyh)
       call dtimer(dtime,itime,1)
       time = real(dtime)
       tfft(1) = tfft(1) + time
@@ -211,20 +270,30 @@
       time = real(dtime)
       tfield = tfield + time
 !
-! transform force to real space with standard procedure: updates fxye
+! transform force to real space with standard procedure: updates fxyu
 ! modifies fxyt
       call dtimer(dtime,itime,-1)
       isign = 1
-      call WPPFFT2R2(fxye,fxyt,bs,br,isign,ntpose,mixup,sct,ttp,indx,   &
-     &indy,kstrt,nvp,nxeh,nye,kxp,kyp,nypmx,nxhy,nxyh)
+      call WPPFFT2R2(fxyu,fxyt,bs,br,isign,ntpose,ltpose,mixup,sct,ttp, &
+     &indx,indy,kstrt,nvp,nxeh,nye,kxp,kyp,nypu,nxhy,nxyh)
       call dtimer(dtime,itime,1)
       time = real(dtime)
       tfft(1) = tfft(1) + time
       tfft(2) = tfft(2) + ttp
 !
+! move force to particle partition: updates fxye
+      if (nbal > 0) then
+         call dtimer(dtime,itime,-1)
+         call PPFMOVE2(fxyu,fxye,kyp*idproc,kyps,noff,nyp,kstrt,nvp,   &
+     &nnxe,kyp,nypmx)
+         call dtimer(dtime,itime,1)
+         time = real(dtime)
+         tbal = tbal + time
+      endif
+!
 ! copy guard cells with standard procedure: updates fxye
       call dtimer(dtime,itime,-1)
-      call PPNCGUARD2L(fxye,nyp,kstrt,nvp,nnxe,nypmx)
+      call PPNCGUARD2LP(fxye,scs,scr,igdf,nyp,nvp,nnxe)
       call PPCGUARD2XL(fxye,nyp,nx,ndim,nxe,nypmx)
       call dtimer(dtime,itime,1)
       time = real(dtime)
@@ -250,8 +319,13 @@
 !
 ! move electrons into appropriate spatial regions: updates part, npp
       call dtimer(dtime,itime,-1)
-      call PPMOVE2(part,edges,npp,sbufr,sbufl,rbufr,rbufl,ihole,ny,kstrt&
-     &,nvp,idimp,npmax,idps,nbmax,ntmax,info)
+      if (lmove==1) then
+         call PPMOVE2NB(part,edges,npp,sbuf,ihole,ny,kstrt,nvp,idimp,   &
+     &npmax,idps,ntmax,info)
+      else
+         call PPMOVE2(part,edges,npp,sbufr,sbufl,rbufr,rbufl,ihole,ny,  &
+     &kstrt,nvp,idimp,npmax,idps,nbmax,ntmax,info)
+      endif
       call dtimer(dtime,itime,1)
       time = real(dtime)
       tmov = tmov + time
@@ -263,6 +337,10 @@
          endif
          go to 3000
       endif
+! particle imbalance = maximum/average number of particles
+      pimb = real(info(2))*(real(nvp)/np)
+      pimbav = pimbav + pimb
+      pimbmx = max(pimbmx,pimb)
 !
 ! sort particles for standard code: updates part
       if (sortime > 0) then
@@ -280,6 +358,46 @@
          endif
       endif
 !
+! load balance particles: updates edges, nyp, noff, part, npp
+      if (nbal > 0) then
+         if (mod(ntime+1,nbal)==0) then
+            call dtimer(dtime,itime,-1)
+! find global particle density profile in y
+            call PPCOUNT2Y(part,npicy,npp,idimp,npmax,ny)
+            call PPSUM(npicy,scry,ny)
+! find new partition boundaries
+            call PFEDGES2(edges,nyp,noff,npicy,1,nypbmx,ny,kstrt,nvp,  &
+     &idps)
+! move particles into new partitions, at most ntmax at a time
+            ibal(1) = 1
+            do while (ibal(1) > 0)
+               call PPHOLES2(part,edges,npp,ihole,idimp,npmax,idps,    &
+     &ntmax)
+               ibal(1) = ihole(1)
+               call PPIMAX(ibal,iwork,1)
+               if (ibal(1) > 0) then
+                  if (lmove==1) then
+                     call PPMOVE2NB(part,edges,npp,sbuf,ihole,ny,kstrt, &
+     &nvp,idimp,npmax,idps,ntmax,info)
+                  else
+                     call PPMOVE2(part,edges,npp,sbufr,sbufl,rbufr,rbufl&
+     &,ihole,ny,kstrt,nvp,idimp,npmax,idps,nbmax,ntmax,info)
+                  endif
+                  if (info(1) /= 0) then
+                     ierr = info(1)
+                     if (kstrt==1) then
+                        write (*,*) 'load balance error: ierr=', ierr
+                     endif
+                     go to 3000
+                  endif
+               endif
+            enddo
+            call dtimer(dtime,itime,1)
+            time = real(dtime)
+            tbal = tbal + time
+         endif
+      endif
+!
 ! energy diagnostic
       wtot(1) = we
       wtot(2) = wke
@@ -299,6 +417,12 @@
  2000 continue
 !
 ! * * * end main iteration loop * * *
+!
+! find imbalance in push and deposit time between processors
+      wtot(1) = tdpost + tpush
+      wtot(2) = wtot(1)
+      call PPDMAX(wtot,work,1)
+      call PPDSUM(wtot(2:2),work,1)
 !
       if (kstrt==1) then
          write (*,*) 'ntime = ', ntime
@@ -314,12 +438,17 @@
          write (*,*) 'push time = ', tpush
          write (*,*) 'particle move time = ', tmov
          write (*,*) 'sort time = ', tsort
+         write (*,*) 'load balance time = ', tbal
+         write (*,*) 'particle imbalance (max/average): mean, max = ',  &
+     &pimbav/real(nloop), pimbmx
+         write (*,*) 'push and deposit time imbalance (max/average) = ',&
+     &wtot(1)*dble(nvp)/wtot(2)
          tfield = tfield + tguard + tfft(1)
          write (*,*) 'total solver time = ', tfield
          tsort = tsort + tmov
          time = tdpost + tpush + tsort
          write (*,*) 'total particle time = ', time
-         wt = time + tfield
+         wt = time + tfield + tbal
          write (*,*) 'total time = ', wt
          write (*,*)
 !
@@ -329,6 +458,9 @@
          write (*,*) 'Sort Time (nsec) = ', tsort*wt
          write (*,*) 'Total Particle Time (nsec) = ', time*wt
       endif
+!
+      call PPNGUARD2FREE(igdf)
+      call PPNGUARD2FREE(igdq)
 !
  3000 continue
       call PPEXIT()
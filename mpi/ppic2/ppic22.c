@@ -0,0 +1,443 @@
+/*---------------------------------------------------------------------*/
+/* Skeleton 2D Electrostatic MPI PIC code */
+/* with 2D spatial decomposition in x and y */
+#include <stdlib.h>
+#include <stdio.h>
+#include <complex.h>
+#include <sys/time.h>
+#include "ppush2.h"
+#include "pplib2.h"
+
+void dtimer(double *time, struct timeval *itime, int icntrl);
+
+int main(int argc, char *argv[]) {
+/* indx/indy = exponent which determines grid points in x/y direction: */
+/* nx = 2**indx, ny = 2**indy */
+   int indx =   9, indy =   9;
+/* npx/npy = number of electrons distributed in x/y direction */
+   int npx =  3072, npy =   3072;
+/* ndim = number of velocity coordinates = 2 */
+   int ndim = 2;
+/* tend = time at end of simulation, in units of plasma frequency */
+/* dt = time interval between successive calculations */
+/* qme = charge on electron, in units of e */
+   float tend = 10.0, dt = 0.1, qme = -1.0;
+/* vtx/vty = thermal velocity of electrons in x/y direction */
+/* vx0/vy0 = drift velocity of electrons in x/y direction */
+   float vtx = 1.0, vty = 1.0, vx0 = 0.0, vy0 = 0.0;
+/* ax/ay = smoothed particle size in x/y direction */
+   float ax = .912871, ay = .912871;
+/* idimp = number of particle coordinates = 4 */
+/* ipbc = particle boundary condition: 1 = periodic */
+/* sortime = number of time steps between standard electron sorting */
+   int idimp = 4, ipbc = 1, sortime = 50;
+/* idps = number of partition boundaries = 4 */
+/* idds = dimensionality of domain decomposition = 2 */
+   int idps = 4, idds = 2;
+/* wke/we/wt = particle kinetic/electric field/total energy */
+   float wke = 0.0, we = 0.0, wt = 0.0;
+/* declare scalars for standard code */
+   int j;
+   int nx, ny, nxh, nyh, nxe, nye, nxeh, nxyh, nxhy;
+   int ntime, nloop, isign, ierr;
+   float qbme, affp;
+   double np;
+
+/* declare scalars for MPI code */
+   int ntpose = 1;
+/* ltpose = (0,1) = (no,yes) use non-blocking all-to-all transpose */
+   int ltpose = 0;
+   int nvp, idproc, kstrt, npmax, kxp, kyp, nxpmx, nypmx, nxpmn, nypmn;
+   int nvpx, nvpy, nvpf, npp, nps, nbmax, ntmax, nbs, nsc, kyps;
+   float pimb;
+
+/* declare arrays for standard code: */
+/* part, part2 = particle arrays */
+   float *part = NULL, *part2 = NULL, *tpart = NULL;
+/* qe = electron charge density with guard cells */
+   float *qe = NULL;
+/* fxye = smoothed electric field with guard cells */
+   float *fxye = NULL;
+/* qt = scalar charge density field array in fourier space */
+   float complex *qt = NULL;
+/* fxyt = vector electric field array in fourier space */
+   float complex *fxyt = NULL;
+/* ffc = form factor array for poisson solver */
+   float complex *ffc = NULL;
+/* mixup = bit reverse table for FFT */
+   int *mixup = NULL;
+/* sct = sine/cosine table for FFT */
+   float complex *sct = NULL;
+/* ihole = location of hole left in particle arrays */
+   int *ihole = NULL;
+/* npic = scratch array for reordering particles */
+   int *npic = NULL;
+   double wtot[4], work[4];
+   int info[7];
+
+/* declare arrays for MPI code: */
+/* bs/br = complex send/receive buffers for data transpose */
+   float complex *bs = NULL, *br = NULL;
+/* sbufl/sbufr = particle buffers sent to nearby processors */
+/* rbufl/rbufr = particle buffers received from nearby processors */
+   float *sbufl = NULL, *sbufr = NULL, *rbufl = NULL, *rbufr = NULL;
+/* edges[0:1] = left:right x boundaries of particle partition */
+/* edges[2:3] = lower:upper y boundaries of particle partition */
+   float *edges = NULL;
+/* nxyp[0:1] = number of primary gridpoints in x/y in particle partition */
+/* noff[0:1] = leftmost/lowermost global gridpoint in particle partition */
+   int nxyp[2], noff[2];
+/* nxypu/noffu = same as nxyp/noff for uniform partition used by fft */
+   int nxypu[2], noffu[2];
+/* scs/scr = guard cell and field move buffers */
+   float *scs = NULL, *scr = NULL;
+/* qu/fxyu = charge density/smoothed electric field in uniform */
+/* partition used by fft */
+   float *qu = NULL, *fxyu = NULL;
+
+/* declare and initialize timing data */
+   float time;
+   struct timeval itime;
+   float tdpost = 0.0, tguard = 0.0, ttp = 0.0, tfield = 0.0;
+   float tpush = 0.0, tsort = 0.0, tmov = 0.0, tfmov = 0.0;
+/* pimbav/pimbmx = average/maximum particle imbalance */
+   float pimbav = 0.0, pimbmx = 0.0;
+   float tfft[2] = {0.0,0.0};
+   double dtime;
+
+/* initialize scalars for standard code */
+/* np = total number of particles in simulation */
+   np =  (double) npx*(double) npy;
+/* nx/ny = number of grid points in x/y direction */
+   nx = 1L<<indx; ny = 1L<<indy;
+   nxh = nx/2; nyh = 1 > ny/2 ? 1 : ny/2;
+   nxe = nx + 2; nye = ny + 2; nxeh = nxe/2;
+   nxyh = (nx > ny ? nx : ny)/2; nxhy = nxh > ny ? nxh : ny;
+/* nloop = number of time steps in simulation */
+/* ntime = current time step */
+   nloop = tend/dt + .0001; ntime = 0;
+   qbme = qme;
+   affp = (double) nx*(double) ny/np;
+
+/* nvp = number of MPI ranks */
+/* initialize for distributed memory parallel processing */
+   cppinit2(&idproc,&nvp,argc,argv);
+   kstrt = idproc + 1;
+/* obtain 2D partition (nvpx,nvpy) from nvp: */
+/* nvpx/nvpy = number of processors in x/y */
+   cfcomp22(&nvp,nx,ny,&nvpx,&nvpy,&ierr);
+   if (ierr != 0) {
+      if (kstrt==1) {
+         printf("cfcomp22 error: nvp,nvpx,nvpy=%d,%d,%d\n",nvp,nvpx,
+                nvpy);
+      }
+      goto L3000;
+   }
+/* check if too many processors */
+   if ((nvpx > nx) || (nvpy > ny)) {
+      if (kstrt==1) {
+         printf("Too many processors requested: nvpx,nvpy=%d,%d\n",nvpx,
+                nvpy);
+      }
+      goto L3000;
+   }
+/* initialize data for MPI code */
+   edges = (float *) malloc(idps*sizeof(float));
+/* calculate partition variables: edges, nxyp, noff, nxpmx, nypmx      */
+/* edges[0:1] = left:right boundary in x of particle partition         */
+/* edges[2:3] = lower:upper boundary in y of particle partition        */
+/* nxyp[0:1] = number of primary (complete) gridpoints in x/y          */
+/* noff[0:1] = leftmost/lowermost global gridpoint in x/y              */
+/* nxpmx/nypmx = maximum size of particle partition in x/y, including  */
+/* guard cells                                                         */
+/* nxpmn/nypmn = minimum value of nxyp[0]/nxyp[1]                      */
+   cpdicomp22l(edges,nxyp,noff,&nxpmx,&nypmx,&nxpmn,&nypmn,nx,ny,kstrt,
+               nvpx,nvpy,idps,idds);
+   if ((nxpmn < 1) || (nypmn < 1)) {
+      if (kstrt==1) {
+         printf("combination not supported nvpx,nx,nvpy,ny=%d,%d,%d,%d\n",
+                nvpx,nx,nvpy,ny);
+      }
+      goto L3000;
+   }
+
+/* initialize additional scalars for MPI code */
+/* nvpf = number of processors used by the fft, which divides whole */
+/* lines in y and x between processors */
+   nvpf = nvp;
+   nvpf = ny < nvpf ? ny : nvpf;
+   nvpf = nxh < nvpf ? nxh : nvpf;
+   do {
+/* kxp = number of complex grids in each field partition in x direction */
+      kxp = (nxh - 1)/nvpf + 1;
+/* kyp = number of complex grids in each field partition in y direction */
+      kyp = (ny - 1)/nvpf + 1;
+      if ((kxp*(nvpf-1) < nxh) && (kyp*(nvpf-1) < ny))
+         break;
+      nvpf -= 1;
+   } while (nvpf > 1);
+/* kyps = actual size of uniform field partition in y direction */
+   kyps = 0;
+   if (kstrt <= nvpf) {
+      kyps = ny - kyp*idproc;
+      kyps = kyp < kyps ? kyp : kyps;
+   }
+   noffu[0] = 0;
+   noffu[1] = kyp*idproc;
+   nxypu[0] = 0;
+   if (kyps > 0)
+      nxypu[0] = nx;
+   nxypu[1] = kyps;
+/* npmax = maximum number of electrons in each partition */
+   npmax = (np/nvp)*1.25;
+/* nbmax = size of buffer for passing particles between processors */
+   nbmax = 0.1*npmax;
+/* ntmax = size of ihole buffer for particles leaving processor */
+   ntmax = 2*nbmax;
+
+/* allocate data for standard code */
+   part = (float *) malloc(idimp*npmax*sizeof(float));
+   part2 = (float *) malloc(idimp*npmax*sizeof(float));
+   qe = (float *) malloc(nxpmx*nypmx*sizeof(float));
+   fxye = (float *) malloc(ndim*nxpmx*nypmx*sizeof(float));
+   qt = (float complex *) malloc(nye*kxp*sizeof(float complex));
+   fxyt = (float complex *) malloc(ndim*nye*kxp*sizeof(float complex));
+   ffc = (float complex *) malloc(nyh*kxp*sizeof(float complex));
+   mixup = (int *) malloc(nxhy*sizeof(int));
+   sct = (float complex *) malloc(nxyh*sizeof(float complex));
+   ihole = (int *) malloc((ntmax+1)*sizeof(int));
+   npic = (int *) malloc(nypmx*sizeof(int));
+
+/* allocate data for MPI code */
+/* non-blocking transpose needs a separate buffer for each processor */
+   nbs = 1;
+   if (ltpose==1)
+      nbs = nvpf;
+   bs = (float complex *) malloc(ndim*kxp*kyp*nbs*sizeof(float complex));
+   br = (float complex *) malloc(ndim*kxp*kyp*nbs*sizeof(float complex));
+   sbufl = (float *) malloc(idimp*nbmax*sizeof(float));
+   sbufr = (float *) malloc(idimp*nbmax*sizeof(float));
+   rbufl = (float *) malloc(idimp*nbmax*sizeof(float));
+   rbufr = (float *) malloc(idimp*nbmax*sizeof(float));
+   nsc = nxpmx*nypmx > nxe*kyp ? nxpmx*nypmx : nxe*kyp;
+   nsc = ndim*nsc;
+   scs = (float *) malloc(nsc*sizeof(float));
+   scr = (float *) malloc(nsc*sizeof(float));
+   qu = (float *) malloc(nxe*kyp*sizeof(float));
+   fxyu = (float *) malloc(ndim*nxe*kyp*sizeof(float));
+
+/* prepare fft tables */
+   cwpfft2rinit(mixup,sct,indx,indy,nxhy,nxyh);
+/* calculate form factors */
+   if (kstrt <= nvpf) {
+      isign = 0;
+      cppois22(qt,fxyt,isign,ffc,ax,ay,affp,&we,nx,ny,kstrt,nye,kxp,
+               nyh);
+   }
+/* initialize electrons */
+   nps = 1;
+   npp = 0;
+   cpdistr22(part,edges,&npp,nps,vtx,vty,vx0,vy0,npx,npy,nx,ny,idimp,
+             npmax,idps,ipbc,&ierr);
+/* check for particle initialization error */
+   if (ierr != 0) {
+      if (kstrt==1) {
+         printf("particle initialization error: ierr=%d\n",ierr);
+      }
+      goto L3000;
+   }
+
+/* * * * start main iteration loop * * * */
+
+L500: if (nloop <= ntime)
+         goto L2000;
+/*    if (kstrt==1) printf("ntime = %i\n",ntime); */
+
+/* deposit charge with standard procedure: updates qe */
+      dtimer(&dtime,&itime,-1);
+      for (j = 0; j < nxpmx*nypmx; j++) {
+         qe[j] = 0.0;
+      }
+      cppgpost22l(part,qe,npp,noff,qme,idimp,npmax,nxpmx,nypmx,idds);
+      dtimer(&dtime,&itime,1);
+      time = (float) dtime;
+      tdpost += time;
+
+/* add guard cells with standard procedure: updates qe */
+      dtimer(&dtime,&itime,-1);
+      cppnaguard22l(qe,scs,scr,nxyp,kstrt,nvpx,nvpy,nxpmx,nypmx,idds);
+      dtimer(&dtime,&itime,1);
+      time = (float) dtime;
+      tguard += time;
+
+/* move charge to uniform partition used by fft: updates qu */
+      dtimer(&dtime,&itime,-1);
+      cppfmove22(qe,qu,scs,scr,noff,nxyp,noffu,nxypu,1,kstrt,nvp,nxpmx,
+                 nypmx,nxe,kyp,idds);
+      dtimer(&dtime,&itime,1);
+      time = (float) dtime;
+      tfmov += time;
+
+/* only the first nvpf processors take part in the field solve */
+      we = 0.0;
+      if (kstrt <= nvpf) {
+/* transform charge to fourier space with standard procedure: updates qt */
+/* modifies qu */
+         dtimer(&dtime,&itime,-1);
+         isign = -1;
+         cwppfft2r((float complex *)qu,qt,bs,br,isign,ntpose,ltpose,
+                   mixup,sct,&ttp,indx,indy,kstrt,nvpf,nxeh,nye,kxp,kyp,
+                   kyp,nxhy,nxyh);
+         dtimer(&dtime,&itime,1);
+         time = (float) dtime;
+         tfft[0] += time;
+         tfft[1] += ttp;
+
+/* calculate force/charge in fourier space with standard procedure: */
+/* updates fxyt, we */
+         dtimer(&dtime,&itime,-1);
+         isign = -1;
+         cppois22(qt,fxyt,isign,ffc,ax,ay,affp,&we,nx,ny,kstrt,nye,kxp,
+                  nyh);
+         dtimer(&dtime,&itime,1);
+         time = (float) dtime;
+         tfield += time;
+
+/* transform force to real space with standard procedure: updates fxyu */
+/* modifies fxyt */
+         dtimer(&dtime,&itime,-1);
+         isign = 1;
+         cwppfft2r2((float complex *)fxyu,fxyt,bs,br,isign,ntpose,ltpose,
+                    mixup,sct,&ttp,indx,indy,kstrt,nvpf,nxeh,nye,kxp,kyp,
+                    kyp,nxhy,nxyh);
+         dtimer(&dtime,&itime,1);
+         time = (float) dtime;
+         tfft[0] += time;
+         tfft[1] += ttp;
+      }
+
+/* move force to particle partition: updates fxye */
+      dtimer(&dtime,&itime,-1);
+      cppfmove22(fxyu,fxye,scs,scr,noffu,nxypu,noff,nxyp,ndim,kstrt,nvp,
+                 nxe,kyp,nxpmx,nypmx,idds);
+      dtimer(&dtime,&itime,1);
+      time = (float) dtime;
+      tfmov += time;
+
+/* copy guard cells with standard procedure: updates fxye */
+      dtimer(&dtime,&itime,-1);
+      cppncguard22l(fxye,scs,nxyp,ndim,kstrt,nvpx,nvpy,nxpmx,nypmx,idds);
+      dtimer(&dtime,&itime,1);
+      time = (float) dtime;
+      tguard += time;
+
+/* push particles: updates part, wke */
+      dtimer(&dtime,&itime,-1);
+      wke = 0.0;
+      cppgpush22l(part,fxye,npp,noff,qbme,dt,&wke,nx,ny,idimp,npmax,
+                  nxpmx,nypmx,idds,ipbc);
+      dtimer(&dtime,&itime,1);
+      time = (float) dtime;
+      tpush += time;
+/* move electrons into appropriate spatial regions: updates part, npp */
+      dtimer(&dtime,&itime,-1);
+      cppmoveg22(part,edges,&npp,sbufr,sbufl,rbufr,rbufl,ihole,nx,ny,
+                 kstrt,nvpx,nvpy,idimp,npmax,idps,nbmax,ntmax,info);
+      dtimer(&dtime,&itime,1);
+      time = (float) dtime;
+      tmov += time;
+/* check for particle manager error */
+      if (info[0] != 0) {
+         ierr = info[0];
+         if (kstrt==1) {
+            printf("particle manager error: ierr=%d\n",ierr);
+         }
+         goto L3000;
+      }
+/* particle imbalance = maximum/average number of particles */
+      pimb = (float) info[1]*((float) nvp/np);
+      pimbav += pimb;
+      pimbmx = pimb > pimbmx ? pimb : pimbmx;
+
+/* sort particles for standard code: updates part */
+      if (sortime > 0) {
+         if (ntime%sortime==0) {
+            dtimer(&dtime,&itime,-1);
+            cppdsortp2yl(part,part2,npic,npp,noff[1],nxyp[1],idimp,npmax,
+                         nypmx);
+/* exchange pointers */
+            tpart = part;
+            part = part2;
+            part2 = tpart;
+            dtimer(&dtime,&itime,1);
+            time = (float) dtime;
+            tsort += time;
+         }
+      }
+
+/* energy diagnostic */
+      wtot[0] = we;
+      wtot[1] = wke;
+      wtot[2] = 0.0;
+      wtot[3] = we + wke;
+      cppdsum(wtot,work,4);
+      we = wtot[0];
+      wke = wtot[1];
+      if (ntime==0) {
+         if (kstrt==1) {
+            printf("Initial Field, Kinetic and Total Energies:\n");
+            printf("%e %e %e\n",we,wke,wke+we);
+         }
+      }
+      ntime += 1;
+      goto L500;
+L2000:
+
+/* * * * end main iteration loop * * * */
+
+/* find imbalance in push and deposit time between processors */
+   wtot[0] = tdpost + tpush;
+   wtot[1] = wtot[0];
+   cppdmax(wtot,work,1);
+   cppdsum(&wtot[1],work,1);
+
+   if (kstrt==1) {
+      printf("ntime = %i\n",ntime);
+      printf("MPI nodes nvp = %i, nvpx, nvpy = %i,%i, fft nodes = %i\n",
+             nvp,nvpx,nvpy,nvpf);
+      printf("Final Field, Kinetic and Total Energies:\n");
+      printf("%e %e %e\n",we,wke,wke+we);
+
+      printf("\n");
+      printf("deposit time = %f\n",tdpost);
+      printf("guard time = %f\n",tguard);
+      printf("solver time = %f\n",tfield);
+      printf("fft and transpose time = %f,%f\n",tfft[0],tfft[1]);
+      printf("field move time = %f\n",tfmov);
+      printf("push time = %f\n",tpush);
+      printf("particle move time = %f\n",tmov);
+      printf("sort time = %f\n",tsort);
+      printf("particle imbalance (max/average): mean, max = %f,%f\n",
+             pimbav/(float) nloop,pimbmx);
+      printf("push and deposit time imbalance (max/average) = %f\n",
+             wtot[0]*(double) nvp/wtot[1]);
+      tfield += tguard + tfft[0] + tfmov;
+      printf("total solver time = %f\n",tfield);
+      tsort += tmov;
+      time = tdpost + tpush + tsort;
+      printf("total particle time = %f\n",time);
+      wt = time + tfield;
+      printf("total time = %f\n",wt);
+      printf("\n");
+
+      wt = 1.0e+09/(((float) nloop)*((float) np));
+      printf("Push Time (nsec) = %f\n",tpush*wt);
+      printf("Deposit Time (nsec) = %f\n",tdpost*wt);
+      printf("Sort Time (nsec) = %f\n",tsort*wt);
+      printf("Total Particle Time (nsec) = %f\n",time*wt);
+   }
+
+L3000:
+   cppexit();
+   return 0;
+}
@@ -0,0 +1,416 @@
+!-----------------------------------------------------------------------
+! Skeleton 2D Electrostatic MPI PIC code
+! with 2D spatial decomposition in x and y
+      program ppic22
+      use ppush2_h
+      use pplib2       ! use with pplib2.f90
+!     use pplib2_h     ! use with pplib2.f
+      implicit none
+! indx/indy = exponent which determines grid points in x/y direction:
+! nx = 2**indx, ny = 2**indy.
+      integer, parameter :: indx =   9, indy =   9
+! npx/npy = number of electrons distributed in x/y direction.
+      integer, parameter :: npx =  3072, npy =   3072
+! ndim = number of velocity coordinates = 2
+      integer, parameter :: ndim = 2
+! tend = time at end of simulation, in units of plasma frequency.
+! dt = time interval between successive calculations.
+! qme = charge on electron, in units of e.
+      real, parameter :: tend = 10.0, dt = 0.1, qme = -1.0
+! vtx/vty = thermal velocity of electrons in x/y direction
+! vx0/vy0 = drift velocity of electrons in x/y direction.
+      real, parameter :: vtx = 1.0, vty = 1.0, vx0 = 0.0, vy0 = 0.0
+! ax/ay = smoothed particle size in x/y direction
+      real :: ax = .912871, ay = .912871
+! idimp = number of particle coordinates = 4
+! ipbc = particle boundary condition: 1 = periodic
+! sortime = number of time steps between standard electron sorting
+      integer :: idimp = 4, ipbc = 1, sortime = 50
+! idps = number of partition boundaries = 4
+! idds = dimensionality of domain decomposition = 2
+      integer :: idps = 4, idds = 2
+! wke/we/wt = particle kinetic/electric field/total energy
+      real :: wke = 0.0, we = 0.0, wt = 0.0
+! declare scalars for standard code
+      integer :: nx, ny, nxh, nyh, nxe, nye, nxeh, nxyh, nxhy
+      integer :: ntime, nloop, isign, ierr
+      real :: qbme, affp
+      double precision :: np
+!
+! declare scalars for MPI code
+      integer :: ntpose = 1
+! ltpose = (0,1) = (no,yes) use non-blocking all-to-all transpose
+      integer :: ltpose = 0
+      integer :: nvp, idproc, kstrt, npmax, kxp, kyp, nxpmx, nypmx
+      integer :: nxpmn, nypmn, nvpx, nvpy, nvpf, npp, nps, nbmax, ntmax
+      integer :: nbs, nsc, kyps
+      real :: pimb
+!
+! declare arrays for standard code:
+! part, part2 = particle arrays
+      real, dimension(:,:), pointer :: part, part2, tpart
+! qe = electron charge density with guard cells
+      real, dimension(:,:), pointer :: qe
+! fxye = smoothed electric field with guard cells
+      real, dimension(:,:,:), pointer :: fxye
+! qt = scalar charge density field array in fourier space
+      complex, dimension(:,:), pointer :: qt
+! fxyt = vector electric field array in fourier space
+      complex, dimension(:,:,:), pointer :: fxyt
+! ffc = form factor array for poisson solver
+      complex, dimension(:,:), pointer :: ffc
+! mixup = bit reverse table for FFT
+      integer, dimension(:), pointer :: mixup
+! sct = sine/cosine table for FFT
+      complex, dimension(:), pointer :: sct
+! ihole = location of hole left in particle arrays
+      integer, dimension(:), pointer :: ihole
+! npic = scratch array for reordering particles
+      integer, dimension(:), pointer :: npic
+      double precision, dimension(4) :: wtot, work
+      integer, dimension(7) :: info
+!
+! declare arrays for MPI code:
+! bs/br = complex send/receive buffers for data transpose
+      complex, dimension(:,:,:), pointer :: bs, br
+! sbufl/sbufr = particle buffers sent to nearby processors
+! rbufl/rbufr = particle buffers received from nearby processors
+      real, dimension(:,:), pointer :: sbufl, sbufr, rbufl, rbufr
+! edges(1:2) = left:right x boundaries of particle partition
+! edges(3:4) = lower:upper y boundaries of particle partition
+      real, dimension(:), pointer  :: edges
+! nxyp(1:2) = number of primary gridpoints in x/y in particle partition
+! noff(1:2) = leftmost/lowermost global gridpoint in particle partition
+      integer, dimension(:), pointer :: nxyp, noff
+! nxypu/noffu = same as nxyp/noff for uniform partition used by fft
+      integer, dimension(:), pointer :: nxypu, noffu
+! scs/scr = guard cell and field move buffers
+      real, dimension(:), pointer  :: scs, scr
+! qu/fxyu = charge density/smoothed electric field in uniform
+! partition used by fft
+      real, dimension(:,:), pointer :: qu
+      real, dimension(:,:,:), pointer :: fxyu
+!
+! declare and initialize timing data
+      real :: time
+      integer, dimension(4) :: itime
+      real :: tdpost = 0.0, tguard = 0.0, ttp = 0.0, tfield = 0.0
+      real :: tpush = 0.0, tsort = 0.0, tmov = 0.0, tfmov = 0.0
+! pimbav/pimbmx = average/maximum particle imbalance
+      real :: pimbav = 0.0, pimbmx = 0.0
+      real, dimension(2) :: tfft = 0.0
+      double precision :: dtime
+!
+! initialize scalars for standard code
+! np = total number of particles in simulation
+      np =  dble(npx)*dble(npy)
+! nx/ny = number of grid points in x/y direction
+      nx = 2**indx; ny = 2**indy; nxh = nx/2; nyh = max(1,ny/2)
+      nxe = nx + 2; nye = ny + 2; nxeh = nxe/2
+      nxyh = max(nx,ny)/2; nxhy = max(nxh,ny)
+! nloop = number of time steps in simulation
+! ntime = current time step
+      nloop = tend/dt + .0001; ntime = 0
+      qbme = qme
+      affp = dble(nx)*dble(ny)/np
+!
+! nvp = number of MPI ranks
+! initialize for distributed memory parallel processing
+      call PPINIT2(idproc,nvp)
+      kstrt = idproc + 1
+! obtain 2D partition (nvpx,nvpy) from nvp:
+! nvpx/nvpy = number of processors in x/y
+      call FCOMP22(nvp,nx,ny,nvpx,nvpy,ierr)
+      if (ierr /= 0) then
+         if (kstrt==1) then
+            write (*,*) 'FCOMP22 error: nvp,nvpx,nvpy=', nvp, nvpx, nvpy
+         endif
+         go to 3000
+      endif
+! check if too many processors
+      if ((nvpx > nx).or.(nvpy > ny)) then
+         if (kstrt==1) then
+            write (*,*) 'Too many processors requested: nvpx,nvpy=',    &
+     &nvpx, nvpy
+         endif
+         go to 3000
+      endif
+!
+! initialize data for MPI code
+      allocate(edges(idps),nxyp(idds),noff(idds))
+      allocate(nxypu(idds),noffu(idds))
+! calculate partition variables: edges, nxyp, noff, nxpmx, nypmx
+! edges(1:2) = left:right boundary in x of particle partition
+! edges(3:4) = lower:upper boundary in y of particle partition
+! nxyp(1:2) = number of primary (complete) gridpoints in x/y
+! noff(1:2) = leftmost/lowermost global gridpoint in x/y
+! nxpmx/nypmx = maximum size of particle partition in x/y, including
+! guard cells
+! nxpmn/nypmn = minimum value of nxyp(1)/nxyp(2)
+      call PDICOMP22L(edges,nxyp,noff,nxpmx,nypmx,nxpmn,nypmn,nx,ny,    &
+     &kstrt,nvpx,nvpy,idps,idds)
+      if ((nxpmn < 1).or.(nypmn < 1)) then
+         if (kstrt==1) then
+            write (*,*) 'combination not supported nvpx,nx,nvpy,ny =',  &
+     &nvpx, nx, nvpy, ny
+         endif
+         go to 3000
+      endif
+! initialize additional scalars for MPI code
+! nvpf = number of processors used by the fft, which divides whole
+! lines in y and x between processors
+      nvpf = min(nvp,ny,nxh)
+      do
+! kxp = number of complex grids in each field partition in x direction
+         kxp = (nxh - 1)/nvpf + 1
+! kyp = number of complex grids in each field partition in y direction
+         kyp = (ny - 1)/nvpf + 1
+         if ((kxp*(nvpf-1) < nxh).and.(kyp*(nvpf-1) < ny)) exit
+         nvpf = nvpf - 1
+         if (nvpf <= 1) exit
+      enddo
+! kyps = actual size of uniform field partition in y direction
+      kyps = 0
+      if (kstrt <= nvpf) kyps = min(kyp,ny-kyp*idproc)
+      noffu(1) = 0
+      noffu(2) = kyp*idproc
+      nxypu(1) = 0
+      if (kyps > 0) nxypu(1) = nx
+      nxypu(2) = kyps
+! npmax = maximum number of electrons in each partition
+      npmax = (np/nvp)*1.25
+! nbmax = size of buffer for passing particles between processors
+      nbmax = 0.1*npmax
+! ntmax = size of ihole buffer for particles leaving processor
+      ntmax = 2*nbmax
+!
+! allocate data for standard code
+      allocate(part(idimp,npmax),part2(idimp,npmax))
+      allocate(qe(nxpmx,nypmx),fxye(ndim,nxpmx,nypmx))
+      allocate(qt(nye,kxp),fxyt(ndim,nye,kxp))
+      allocate(ffc(nyh,kxp),mixup(nxhy),sct(nxyh))
+      allocate(ihole(ntmax+1),npic(nypmx))
+!
+! allocate data for MPI code
+! non-blocking transpose needs a separate buffer for each processor
+      nbs = 1
+      if (ltpose==1) nbs = nvpf
+      allocate(bs(ndim,kxp,kyp*nbs),br(ndim,kxp,kyp*nbs))
+      allocate(sbufl(idimp,nbmax),sbufr(idimp,nbmax))
+      allocate(rbufl(idimp,nbmax),rbufr(idimp,nbmax))
+      nsc = ndim*max(nxpmx*nypmx,nxe*kyp)
+      allocate(scs(nsc),scr(nsc))
+      allocate(qu(nxe,kyp),fxyu(ndim,nxe,kyp))
+!
+! prepare fft tables
+      call WPFFT2RINIT(mixup,sct,indx,indy,nxhy,nxyh)
+! calculate form factors
+      if (kstrt <= nvpf) then
+         isign = 0
+         call PPOIS22(qt,fxyt,isign,ffc,ax,ay,affp,we,nx,ny,kstrt,nye,  &
+     &kxp,nyh)
+      endif
+! initialize electrons
+      nps = 1
+      npp = 0
+      call PDISTR22(part,edges,npp,nps,vtx,vty,vx0,vy0,npx,npy,nx,ny,   &
+     &idimp,npmax,idps,ipbc,ierr)
+! check for particle initialization error
+      if (ierr /= 0) then
+         if (kstrt==1) then
+            write (*,*) 'particle initialization error: ierr=', ierr
+         endif
+         go to 3000
+      endif
+!
+! * * * start main iteration loop * * *
+!
+  500 if (nloop <= ntime) go to 2000
+!     if (kstrt==1) write (*,*) 'ntime = ', ntime
+!
+! deposit charge with standard procedure: updates qe
+      call dtimer(dtime,itime,-1)
+      qe = 0.0
+      call PPGPOST22L(part,qe,npp,noff,qme,idimp,npmax,nxpmx,nypmx,idds)
+      call dtimer(dtime,itime,1)
+      time = real(dtime)
+      tdpost = tdpost + time
+!
+! add guard cells with standard procedure: updates qe
+      call dtimer(dtime,itime,-1)
+      call PPNAGUARD22L(qe,scs,scr,nxyp,kstrt,nvpx,nvpy,nxpmx,nypmx,idds&
+     &)
+      call dtimer(dtime,itime,1)
+      time = real(dtime)
+      tguard = tguard + time
+!
+! move charge to uniform partition used by fft: updates qu
+      call dtimer(dtime,itime,-1)
+      call PPFMOVE22(qe,qu,scs,scr,noff,nxyp,noffu,nxypu,1,kstrt,nvp,   &
+     &nxpmx,nypmx,nxe,kyp,idds)
+      call dtimer(dtime,itime,1)
+      time = real(dtime)
+      tfmov = tfmov + time
+!
+! only the first nvpf processors take part in the field solve
+      we = 0.0
+      if (kstrt <= nvpf) then
+! transform charge to fourier space with standard procedure: updates qt
+! modifies qu
+         call dtimer(dtime,itime,-1)
+         isign = -1
+         call WPPFFT2R(qu,qt,bs,br,isign,ntpose,ltpose,mixup,sct,ttp,   &
+     &indx,indy,kstrt,nvpf,nxeh,nye,kxp,kyp,kyp,nxhy,nxyh)
+         call dtimer(dtime,itime,1)
+         time = real(dtime)
+         tfft(1) = tfft(1) + time
+         tfft(2) = tfft(2) + ttp
+!
+! calculate force/charge in fourier space with standard procedure:
+! updates fxyt, we
+         call dtimer(dtime,itime,-1)
+         isign = -1
+         call PPOIS22(qt,fxyt,isign,ffc,ax,ay,affp,we,nx,ny,kstrt,nye,  &
+     &kxp,nyh)
+         call dtimer(dtime,itime,1)
+         time = real(dtime)
+         tfield = tfield + time
+!
+! transform force to real space with standard procedure: updates fxyu
+! modifies fxyt
+         call dtimer(dtime,itime,-1)
+         isign = 1
+         call WPPFFT2R2(fxyu,fxyt,bs,br,isign,ntpose,ltpose,mixup,sct,  &
+     &ttp,indx,indy,kstrt,nvpf,nxeh,nye,kxp,kyp,kyp,nxhy,nxyh)
+         call dtimer(dtime,itime,1)
+         time = real(dtime)
+         tfft(1) = tfft(1) + time
+         tfft(2) = tfft(2) + ttp
+      endif
+!
+! move force to particle partition: updates fxye
+      call dtimer(dtime,itime,-1)
+      call PPFMOVE22(fxyu,fxye,scs,scr,noffu,nxypu,noff,nxyp,ndim,kstrt, &
+     &nvp,nxe,kyp,nxpmx,nypmx,idds)
+      call dtimer(dtime,itime,1)
+      time = real(dtime)
+      tfmov = tfmov + time
+!
+! copy guard cells with standard procedure: updates fxye
+      call dtimer(dtime,itime,-1)
+      call PPNCGUARD22L(fxye,scs,nxyp,ndim,kstrt,nvpx,nvpy,nxpmx,nypmx, &
+     &idds)
+      call dtimer(dtime,itime,1)
+      time = real(dtime)
+      tguard = tguard + time
+!
+! push particles: updates part, wke
+      call dtimer(dtime,itime,-1)
+      wke = 0.0
+      call PPGPUSH22L(part,fxye,npp,noff,qbme,dt,wke,nx,ny,idimp,npmax, &
+     &nxpmx,nypmx,idds,ipbc)
+      call dtimer(dtime,itime,1)
+      time = real(dtime)
+      tpush = tpush + time
+!
+! move electrons into appropriate spatial regions: updates part, npp
+      call dtimer(dtime,itime,-1)
+      call PPMOVEG22(part,edges,npp,sbufr,sbufl,rbufr,rbufl,ihole,nx,ny,&
+     &kstrt,nvpx,nvpy,idimp,npmax,idps,nbmax,ntmax,info)
+      call dtimer(dtime,itime,1)
+      time = real(dtime)
+      tmov = tmov + time
+! check for particle manager error
+      if (info(1) /= 0) then
+         ierr = info(1)
+         if (kstrt==1) then
+            write (*,*) 'particle manager error: ierr=', ierr
+         endif
+         go to 3000
+      endif
+! particle imbalance = maximum/average number of particles
+      pimb = real(info(2))*(real(nvp)/np)
+      pimbav = pimbav + pimb
+      pimbmx = max(pimbmx,pimb)
+!
+! sort particles for standard code: updates part
+      if (sortime > 0) then
+         if (mod(ntime,sortime)==0) then
+            call dtimer(dtime,itime,-1)
+            call PPDSORTP2YL(part,part2,npic,npp,noff(2),nxyp(2),idimp, &
+     &npmax,nypmx)
+! exchange pointers
+            tpart => part
+            part => part2
+            part2 => tpart
+            call dtimer(dtime,itime,1)
+            time = real(dtime)
+            tsort = tsort + time
+         endif
+      endif
+!
+! energy diagnostic
+      wtot(1) = we
+      wtot(2) = wke
+      wtot(3) = 0.0
+      wtot(4) = we + wke
+      call PPDSUM(wtot,work,4)
+      we = wtot(1)
+      wke = wtot(2)
+      if (ntime==0) then
+         if (kstrt==1) then
+            write (*,*) 'Initial Field, Kinetic and Total Energies:'
+            write (*,'(3e14.7)') we, wke, wke + we
+         endif
+      endif
+      ntime = ntime + 1
+      go to 500
+ 2000 continue
+!
+! * * * end main iteration loop * * *
+!
+! find imbalance in push and deposit time between processors
+      wtot(1) = tdpost + tpush
+      wtot(2) = wtot(1)
+      call PPDMAX(wtot,work,1)
+      call PPDSUM(wtot(2:2),work,1)
+!
+      if (kstrt==1) then
+         write (*,*) 'ntime = ', ntime
+         write (*,*) 'MPI nodes nvp = ', nvp, ', nvpx, nvpy = ', nvpx,  &
+     &nvpy, ', fft nodes = ', nvpf
+         write (*,*) 'Final Field, Kinetic and Total Energies:'
+         write (*,'(3e14.7)') we, wke, wke + we
+!
+         write (*,*)
+         write (*,*) 'deposit time = ', tdpost
+         write (*,*) 'guard time = ', tguard
+         write (*,*) 'solver time = ', tfield
+         write (*,*) 'fft and transpose time = ', tfft(1), tfft(2)
+         write (*,*) 'field move time = ', tfmov
+         write (*,*) 'push time = ', tpush
+         write (*,*) 'particle move time = ', tmov
+         write (*,*) 'sort time = ', tsort
+         write (*,*) 'particle imbalance (max/average): mean, max = ',  &
+     &pimbav/real(nloop), pimbmx
+         write (*,*) 'push and deposit time imbalance (max/average) = ',&
+     &wtot(1)*dble(nvp)/wtot(2)
+         tfield = tfield + tguard + tfft(1) + tfmov
+         write (*,*) 'total solver time = ', tfield
+         tsort = tsort + tmov
+         time = tdpost + tpush + tsort
+         write (*,*) 'total particle time = ', time
+         wt = time + tfield
+         write (*,*) 'total time = ', wt
+         write (*,*)
+!
+         wt = 1.0e+09/(real(nloop)*real(np))
+         write (*,*) 'Push Time (nsec) = ', tpush*wt
+         write (*,*) 'Deposit Time (nsec) = ', tdpost*wt
+         write (*,*) 'Sort Time (nsec) = ', tsort*wt
+         write (*,*) 'Total Particle Time (nsec) = ', time*wt
+      endif
+!
+ 3000 continue
+      call PPEXIT()
+      end program
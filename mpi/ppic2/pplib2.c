@@ -19,19 +19,69 @@
    cppnacguard2lL adds guard cells in y for vector array, linear
                   interpolation, and distributed data with non-uniform
                   partition.
+   cppnguard2init creates persistent requests for guard cell exchanges
+                  in y of one row of data, to be reused every time step.
+   cppncguard2lp copies data to guard cells in y for scalar data, using
+                 persistent requests created by cppnguard2init.
+   cppnaguard2lp adds guard cells in y for scalar array, using
+                 persistent requests created by cppnguard2init.
+   cppnacguard2lp adds guard cells in y for vector array, using
+                  persistent requests created by cppnguard2init.
+   cppnguard2free frees persistent requests created by cppnguard2init.
    cpptpose performs a transpose of a complex scalar array, distributed
             in y, to a complex scalar array, distributed in x.
    cppntpose performs a transpose of an n component complex vector array,
             distributed in y, to an n component complex vector array,
             distributed in x.
+   cpptposenb performs a transpose of a complex scalar array, distributed
+              in y, to a complex scalar array, distributed in x, using
+              non-blocking messages to all processors at once.
+   cppntposenb performs a transpose of an n component complex vector
+               array, distributed in y, to an n component complex vector
+               array, distributed in x, using non-blocking messages to all
+               processors at once.
+   cppfmove2 moves field data in y between two different partitions,
+             such as a non-uniform particle partition and the uniform
+             partition used by the fft.
    cppmove2 moves particles into appropriate spatial regions with periodic
             boundary conditions.  Assumes ihole list has been found.
+   cppmove2nb moves particles into appropriate spatial regions with
+              periodic boundary conditions, sending particles directly
+              to their destination processor with non-blocking messages.
+              Assumes ihole list has been found.
+   cppncguard22l copies data to guard cells in x and y for vector data,
+                 linear interpolation, and distributed data with 2D
+                 spatial decomposition.
+   cppnaguard22l adds guard cells in x and y for scalar array, linear
+                 interpolation, and distributed data with 2D spatial
+                 decomposition.
+   cppfmove22 moves field data between two partitions divided in x and y,
+              such as a 2D particle partition and the uniform partition
+              in y used by the fft.
+   cppmoveg22 moves particles into appropriate spatial regions with
+              periodic boundary conditions and 2D spatial decomposition.
+              ihole list is calculated from particle co-ordinates.
+   cppwchkpth2 opens a shared checkpoint file for writing with MPI-IO
+               and saves the scalars.
+   cppwchkpta2 writes the rows of a distributed array to a checkpoint
+               file with a collective write.
+   cppwchkptp2 writes particles and an index of particles per processor
+               to a checkpoint file with a collective write.
+   cppwchkptc2 completes a checkpoint file.
+   cpprchkpth2 opens a shared checkpoint file for reading with MPI-IO
+               and reads the scalars.
+   cpprchkpta2 reads the rows of a distributed array from a checkpoint
+               file, in any partition.
+   cpprchkptp2 reads particles from a checkpoint file, written by the
+               same or a different number of processors.
+   cpprchkptc2 closes a checkpoint file opened for reading.
    written by viktor k. decyk, ucla
    copyright 1995, regents of the university of california
    update: february 26, 2018                                         */
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <complex.h>
 #include "mpi.h"
 #include "pplib2.h"
@@ -54,6 +104,50 @@ static MPI_Op msum, mmax;
 
 static FILE *unit2 = NULL;
 
+/* persistent requests for guard cell exchanges
+   maxgds = maximum number of guard cell exchange plans
+   ngds = number of plans created so far
+   mgds[igds][0:1] = receive/send requests for copying guard cells
+   mgds[igds][2:3] = receive/send requests for adding guard cells */
+#define MAXGDS          8
+static int ngds = 0;
+static MPI_Request mgds[MAXGDS][4];
+
+/* shared checkpoint file written and read with MPI-IO
+   nchkmax = maximum number of scalars or arrays in a checkpoint
+   nchkal = alignment of arrays in checkpoint file, in bytes */
+#define NCHKMAX         32
+#define NCHKAL          4096
+
+/* header of checkpoint file, written by processor 0
+   magic = file identifier
+   nvp = number of processors which wrote the file
+   nis/nfs/narr = number of integer/real scalars and arrays
+   nrow[n] = length of each row of array n, in reals,
+   or size of phase space for particles
+   nrows[n] = total number of rows of array n, 0 for particles
+   noffa[n] = file offset of array n, in bytes
+   ntot[n] = total number of particles in particle array n */
+struct ppchkhead {
+   char magic[8];
+   int nvp, nis, nfs, narr;
+   int isc[NCHKMAX];
+   float fsc[NCHKMAX];
+   int nrow[NCHKMAX], nrows[NCHKMAX];
+   long long noffa[NCHKMAX], ntot[NCHKMAX];
+};
+
+static char ppchkmagic[8] = "PPCHK2";
+/* mchk = checkpoint file being written or read */
+/* nchkf = offset of next array in file being written */
+/* chkerr = error code of checkpoint being written */
+/* fchk = name of checkpoint file being written */
+static MPI_File mchk = MPI_FILE_NULL;
+static MPI_Offset nchkf = 0;
+static int chkerr = 0;
+static struct ppchkhead chkhd;
+static char fchk[256];
+
 float vresult(float prec) {
    float vresult;
    vresult = prec;
@@ -413,6 +507,379 @@ local data */
    return;
 }
 
+/*--------------------------------------------------------------------*/
+void cppnguard2init(float scs[], float scr[], int *igds, int kstrt,
+                    int nvp, int nxv, int nypmx) {
+/* this subroutine creates persistent requests for guard cell exchanges
+   in y with non-uniform partitions, for data with nxv reals per row.
+   the same plan is used by cppncguard2lp, cppnaguard2lp and
+   cppnacguard2lp, which avoids setting up new messages every call.
+   scs/scr = buffers for sending/receiving one row of data, which must
+   not be moved or freed while the plan is in use.
+   igds = plan number returned, 0 if no plan could be created
+   kstrt = starting data block number
+   nvp = number of real or virtual processors
+   nxv = number of reals in one row of data, e.g., ndim*nxv for a
+   vector array
+   nypmx = maximum size of field partition, including guard cells.
+local data */
+   int n, ks, moff, kl, kr, ierr;
+   *igds = 0;
+   if (ngds >= MAXGDS) {
+      if (kstrt==1)
+         printf("cppnguard2init: too many plans, maxgds=%d\n",MAXGDS);
+      return;
+   }
+   n = ngds;
+   ngds += 1;
+   *igds = ngds;
+/* special case for one processor */
+   if (nvp==1) {
+      for (ks = 0; ks < 4; ks++) {
+         mgds[n][ks] = MPI_REQUEST_NULL;
+      }
+      return;
+   }
+   ks = kstrt - 1;
+   kr = ks + 1;
+   if (kr >= nvp)
+      kr = kr - nvp;
+   kl = ks - 1;
+   if (kl < 0)
+      kl = kl + nvp;
+/* copy guard cells: receive from right, send to left */
+   moff = nypmx*nvp + 2;
+   ierr = MPI_Recv_init(scr,nxv,mreal,kr,moff,lgrp,&mgds[n][0]);
+   ierr = MPI_Send_init(scs,nxv,mreal,kl,moff,lgrp,&mgds[n][1]);
+/* add guard cells: receive from left, send to right */
+   moff = nypmx*nvp + 1;
+   ierr = MPI_Recv_init(scr,nxv,mreal,kl,moff,lgrp,&mgds[n][2]);
+   ierr = MPI_Send_init(scs,nxv,mreal,kr,moff,lgrp,&mgds[n][3]);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppncguard2lp(float f[], float scs[], float scr[], int igds,
+                   int nyp, int nvp, int nxv) {
+/* this subroutine copies data to guard cells in non-uniform partitions
+   using persistent requests created by cppnguard2init
+   f[k][j] = real data for grid j,k in particle partition.
+   the grid is non-uniform and includes one extra guard cell.
+   output: f, scs, scr
+   scs/scr = send/receive buffers given to cppnguard2init
+   igds = plan number returned by cppnguard2init
+   nyp = number of primary gridpoints in field partition
+   it is assumed the nyp > 0.
+   nvp = number of real or virtual processors
+   nxv = first dimension of f, must be same as in cppnguard2init
+   linear interpolation, for distributed data
+local data */
+   int j, ierr;
+/* special case for one processor */
+   if (nvp==1) {
+      for (j = 0; j < nxv; j++) {
+        f[j+nxv*nyp] = f[j];
+      }
+      return;
+   }
+/* this segment is used for mpi computers */
+   for (j = 0; j < nxv; j++) {
+      scs[j] = f[j];
+   }
+   ierr = MPI_Startall(2,&mgds[igds-1][0]);
+   ierr = MPI_Waitall(2,&mgds[igds-1][0],MPI_STATUSES_IGNORE);
+   for (j = 0; j < nxv; j++) {
+      f[j+nxv*nyp] = scr[j];
+   }
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppnaguard2lp(float f[], float scs[], float scr[], int igds,
+                   int nyp, int nx, int nvp, int nxv) {
+/* this subroutine adds data from guard cells in non-uniform partitions
+   using persistent requests created by cppnguard2init
+   f[k][j] = real data for grid j,k in particle partition.
+   the grid is non-uniform and includes one extra guard cell.
+   output: f, scs, scr
+   scs/scr = send/receive buffers given to cppnguard2init
+   igds = plan number returned by cppnguard2init
+   nyp = number of primary gridpoints in particle partition
+   it is assumed the nyp > 0.
+   nx = system length in x direction
+   nvp = number of real or virtual processors
+   nxv = first dimension of f, must be same as in cppnguard2init
+   linear interpolation, for distributed data
+local data */
+   int j, nx1, ierr;
+   nx1 = nx + 1;
+/* special case for one processor */
+   if (nvp==1) {
+      for (j = 0; j < nx1; j++) {
+         f[j] += f[j+nxv*nyp];
+         f[j+nxv*nyp] = 0.0;
+      }
+      return;
+   }
+/* this segment is used for mpi computers */
+   for (j = 0; j < nxv; j++) {
+      scs[j] = f[j+nxv*nyp];
+   }
+   ierr = MPI_Startall(2,&mgds[igds-1][2]);
+   ierr = MPI_Waitall(2,&mgds[igds-1][2],MPI_STATUSES_IGNORE);
+/* add up the guard cells */
+   for (j = 0; j < nx1; j++) {
+      f[j] += scr[j];
+      f[j+nxv*nyp] = 0.0;
+   }
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppnacguard2lp(float f[], float scs[], float scr[], int igds,
+                    int nyp, int nx, int ndim, int nvp, int nxv) {
+/* this subroutine adds data from guard cells in non-uniform partitions
+   using persistent requests created by cppnguard2init
+   f[k][j][ndim] = real data for grid j,k in particle partition.
+   the grid is non-uniform and includes one extra guard cell.
+   output: f, scs, scr
+   scs/scr = send/receive buffers given to cppnguard2init
+   igds = plan number returned by cppnguard2init, created with ndim*nxv
+   reals per row
+   nyp = number of primary gridpoints in particle partition
+   it is assumed the nyp > 0.
+   nx = system length in x direction
+   ndim = leading dimension of array f
+   nvp = number of real or virtual processors
+   nxv = first dimension of f, must be >= nx
+   linear interpolation, for distributed data
+local data */
+   int j, n, nx1, nnxv, ierr;
+   nx1 = nx + 1;
+   nnxv = ndim*nxv;
+/* special case for one processor */
+   if (nvp==1) {
+      for (j = 0; j < nx1; j++) {
+         for (n = 0; n < ndim; n++) {
+            f[n+ndim*j] += f[n+ndim*(j+nxv*nyp)];
+            f[n+ndim*(j+nxv*nyp)] = 0.0;
+         }
+      }
+      return;
+   }
+/* this segment is used for mpi computers */
+   for (j = 0; j < nnxv; j++) {
+      scs[j] = f[j+nnxv*nyp];
+   }
+   ierr = MPI_Startall(2,&mgds[igds-1][2]);
+   ierr = MPI_Waitall(2,&mgds[igds-1][2],MPI_STATUSES_IGNORE);
+/* add up the guard cells */
+   for (j = 0; j < nx1; j++) {
+      for (n = 0; n < ndim; n++) {
+         f[n+ndim*j] += scr[n+ndim*j];
+         f[n+ndim*(j+nxv*nyp)] = 0.0;
+      }
+   }
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppnguard2free(int *igds) {
+/* this subroutine frees persistent requests created by cppnguard2init
+   igds = plan number, set to 0 on output
+local data */
+   int n, ierr;
+   if ((*igds < 1) || (*igds > ngds))
+      return;
+   for (n = 0; n < 4; n++) {
+      if (mgds[*igds-1][n] != MPI_REQUEST_NULL)
+         ierr = MPI_Request_free(&mgds[*igds-1][n]);
+   }
+/* release plan number if it was the last one created */
+   if (*igds==ngds)
+      ngds -= 1;
+   *igds = 0;
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppncguard22l(float f[], float scs[], int nxyp[], int ndim,
+                   int kstrt, int nvpx, int nvpy, int nxv, int nypmx,
+                   int idds) {
+/* this subroutine copies data to guard cells in non-uniform partitions
+   f[k][j][ndim] = real data for grid j,k in particle partition.
+   the grid is non-uniform and includes one extra guard cell in x and y.
+   output: f, scs
+   scs[2][k][ndim] = scratch array for particle partition
+   nxyp[0:1] = number of primary gridpoints in x/y in particle partition
+   it is assumed the nxyp > 0.
+   ndim = leading dimension of array f
+   kstrt = starting data block number
+   nvpx/nvpy = number of real or virtual processors in x/y
+   nxv = second dimension of f, must be >= nxpmx
+   nypmx = maximum size of particle partition in y, including guard cells
+   idds = dimensionality of domain decomposition
+   linear interpolation, for distributed data,
+   with 2D spatial decomposition
+local data */
+   int j, k, n, js, ks, moff, kl, kr, nxp, nyp, nnxv, ierr;
+   MPI_Request msid;
+   MPI_Status istatus;
+   nxp = nxyp[0];
+   nyp = nxyp[1];
+/* js/ks = processor co-ordinates in x/y => idproc = js + nvpx*ks */
+   ks = (kstrt - 1)/nvpx;
+   js = kstrt - nvpx*ks - 1;
+   moff = nypmx*nvpy;
+   nnxv = ndim*nxv;
+/* special case for one processor in x */
+   if (nvpx==1) {
+      for (k = 0; k < nyp; k++) {
+         for (n = 0; n < ndim; n++) {
+            f[n+ndim*nxp+nnxv*k] = f[n+nnxv*k];
+         }
+      }
+      goto L40;
+   }
+/* buffer data in x */
+   for (k = 0; k < nyp; k++) {
+      for (n = 0; n < ndim; n++) {
+         scs[n+ndim*k] = f[n+nnxv*k];
+      }
+   }
+/* copy to guard cells in x */
+   kr = js + 1;
+   if (kr >= nvpx)
+      kr -= nvpx;
+   kl = js - 1;
+   if (kl < 0)
+      kl += nvpx;
+   kr = kr + nvpx*ks;
+   kl = kl + nvpx*ks;
+/* this segment is used for mpi computers */
+   ierr = MPI_Irecv(&scs[ndim*nypmx],ndim*nypmx,mreal,kr,moff+3,lgrp,
+                    &msid);
+   ierr = MPI_Send(scs,ndim*nyp,mreal,kl,moff+3,lgrp);
+   ierr = MPI_Wait(&msid,&istatus);
+/* copy guard cells */
+   for (k = 0; k < nyp; k++) {
+      for (n = 0; n < ndim; n++) {
+         f[n+ndim*nxp+nnxv*k] = scs[n+ndim*(k+nypmx)];
+      }
+   }
+/* special case for one processor in y */
+L40: if (nvpy==1) {
+      for (j = 0; j < nnxv; j++) {
+         f[j+nnxv*nyp] = f[j];
+      }
+      return;
+   }
+/* copy to guard cells in y */
+   kr = ks + 1;
+   if (kr >= nvpy)
+      kr -= nvpy;
+   kl = ks - 1;
+   if (kl < 0)
+      kl += nvpy;
+   kr = js + nvpx*kr;
+   kl = js + nvpx*kl;
+/* this segment is used for mpi computers */
+   ierr = MPI_Irecv(&f[nnxv*nyp],nnxv,mreal,kr,moff+4,lgrp,&msid);
+   ierr = MPI_Send(f,nnxv,mreal,kl,moff+4,lgrp);
+   ierr = MPI_Wait(&msid,&istatus);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppnaguard22l(float f[], float scs[], float scr[], int nxyp[],
+                   int kstrt, int nvpx, int nvpy, int nxv, int nypmx,
+                   int idds) {
+/* this subroutine adds data from guard cells in non-uniform partitions
+   f[k][j] = real data for grid j,k in particle partition.
+   the grid is non-uniform and includes one extra guard cell in x and y.
+   output: f, scs, scr
+   scs[2][k] = scratch array for particle partition in x
+   scr[j] = scratch array for particle partition in y
+   nxyp[0:1] = number of primary gridpoints in x/y in particle partition
+   it is assumed the nxyp > 0.
+   kstrt = starting data block number
+   nvpx/nvpy = number of real or virtual processors in x/y
+   nxv = first dimension of f, must be >= nxpmx
+   nypmx = maximum size of particle partition in y, including guard cells
+   idds = dimensionality of domain decomposition
+   linear interpolation, for distributed data
+   with 2D spatial decomposition
+local data */
+   int j, k, js, ks, moff, kl, kr, nxp, nyp, nxp1, nyp1, ierr;
+   MPI_Request msid;
+   MPI_Status istatus;
+   nxp = nxyp[0];
+   nyp = nxyp[1];
+   nxp1 = nxp + 1;
+   nyp1 = nyp + 1;
+/* js/ks = processor co-ordinates in x/y => idproc = js + nvpx*ks */
+   ks = (kstrt - 1)/nvpx;
+   js = kstrt - nvpx*ks - 1;
+   moff = nypmx*nvpy;
+/* special case for one processor in x */
+   if (nvpx==1) {
+      for (k = 0; k < nyp1; k++) {
+         f[nxv*k] += f[nxp+nxv*k];
+         f[nxp+nxv*k] = 0.0;
+      }
+      goto L40;
+   }
+/* buffer data in x */
+   for (k = 0; k < nyp1; k++) {
+      scs[k] = f[nxp+nxv*k];
+   }
+/* add guard cells in x */
+   kr = js + 1;
+   if (kr >= nvpx)
+      kr -= nvpx;
+   kl = js - 1;
+   if (kl < 0)
+      kl += nvpx;
+   kr = kr + nvpx*ks;
+   kl = kl + nvpx*ks;
+/* this segment is used for mpi computers */
+   ierr = MPI_Irecv(&scs[nypmx],nypmx,mreal,kl,moff+1,lgrp,&msid);
+   ierr = MPI_Send(scs,nyp1,mreal,kr,moff+1,lgrp);
+   ierr = MPI_Wait(&msid,&istatus);
+/* add up the guard cells */
+   for (k = 0; k < nyp1; k++) {
+      f[nxv*k] += scs[k+nypmx];
+      f[nxp+nxv*k] = 0.0;
+   }
+/* special case for one processor in y */
+L40: if (nvpy==1) {
+      for (j = 0; j < nxp1; j++) {
+         f[j] += f[j+nxv*nyp];
+         f[j+nxv*nyp] = 0.0;
+      }
+      return;
+   }
+/* add guard cells in y */
+   kr = ks + 1;
+   if (kr >= nvpy)
+      kr -= nvpy;
+   kl = ks - 1;
+   if (kl < 0)
+      kl += nvpy;
+   kr = js + nvpx*kr;
+   kl = js + nvpx*kl;
+/* this segment is used for mpi computers */
+   ierr = MPI_Irecv(scr,nxv,mreal,kl,moff+2,lgrp,&msid);
+   ierr = MPI_Send(&f[nxv*nyp],nxv,mreal,kr,moff+2,lgrp);
+   ierr = MPI_Wait(&msid,&istatus);
+/* add up the guard cells */
+   for (j = 0; j < nxp1; j++) {
+      f[j] += scr[j];
+      f[j+nxv*nyp] = 0.0;
+   }
+   return;
+}
+
 /*--------------------------------------------------------------------*/
 void cpptpose(float complex f[], float complex g[], float complex s[],
               float complex t[], int nx, int ny, int kxp, int kyp,
@@ -606,55 +1073,433 @@ local data */
 }
 
 /*--------------------------------------------------------------------*/
-void cppmove2(float part[], float edges[], int *npp, float sbufr[],
-              float sbufl[], float rbufr[], float rbufl[], int ihole[],
-              int ny, int kstrt, int nvp, int idimp, int npmax, int idps,
-              int nbmax, int ntmax, int info[]) {
-/* this subroutine moves particles into appropriate spatial regions
-   periodic boundary conditions
-   output: part, npp, sbufr, sbufl, rbufr, rbufl, info
-   part[n][0] = position x of particle n in partition
-   part[n][1] = position y of particle n in partition
-   part[n][2] = velocity vx of particle n in partition
-   part[n][3] = velocity vy of particle n in partition
-   edges[0:1] = lower:lower boundary of particle partition
-   npp = number of particles in partition
-   sbufl = buffer for particles being sent to lower processor
-   sbufr = buffer for particles being sent to upper processor
-   rbufl = buffer for particles being received from lower processor
-   rbufr = buffer for particles being received from upper processor
-   ihole = location of holes left in particle arrays
-   ny = system length in y direction
+static void cppntunpack(float complex g[], float complex t[], int id,
+                        int ny, int kxp, int kxps, int kyp, int ndim,
+                        int nyv) {
+/* this subroutine inserts block id of transposed data in t, received
+   from processor id, into g.  used by cppntposenb
+local data */
+   int i, j, k, koff, ld, nnyv;
+   float complex *tn;
+   nnyv = ndim*nyv;
+   tn = &t[ndim*kxp*kyp*id];
+   koff = kyp*id;
+   ld = ny - koff;
+   ld = 0 > ld ? 0 : ld;
+   ld = kyp < ld ? kyp : ld;
+   for (k = 0; k < ld; k++) {
+      for (j = 0; j < kxps; j++) {
+         for (i = 0; i < ndim; i++) {
+            g[i+ndim*(k+koff)+nnyv*j] = tn[i+ndim*(j+kxps*k)];
+         }
+      }
+   }
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cpptposenb(float complex f[], float complex g[], float complex s[],
+                float complex t[], int nx, int ny, int kxp, int kyp,
+                int kstrt, int nvp, int nxv, int nyv, int kxpd,
+                int kypd) {
+/* this subroutine performs a transpose of a matrix f, distributed in y,
+   to a matrix g, distributed in x, that is,
+   g[l][j][k+kyp*m] = f[m][k][j+kxp*l], where
+   0 <= j < kxp, 0 <= k < kyp, 0 <= l < nx/kxp, 0 <= m < ny/kyp
+   and where indices l and m can be distributed across processors.
+   this subroutine posts all receives first, then sends all messages
+   asynchronously, unpacking data in the order it arrives, so that
+   packing and unpacking overlap with communication.
+   it requires nvp times the scratch memory of cpptpose
+   f = complex input array
+   g = complex output array
+   s, t = complex scratch arrays, of size kxp*kyp*nvp
+   nx/ny = number of points in x/y
+   kxp/kyp = number of data values per block in x/y
    kstrt = starting data block number
    nvp = number of real or virtual processors
-   idimp = size of phase space = 4
-   npmax = maximum number of particles in each partition.
-   idps = number of partition boundaries
-   nbmax =  size of buffers for passing particles between processors
-   ntmax =  size of hole array for particles leaving processors
-   info = status information
-   info[0] = ierr = (0,N) = (no,yes) error condition exists
-   info[1] = maximum number of particles per processor
-   info[2] = minimum number of particles per processor
-   info[3] = maximum number of buffer overflows
-   info[4] = maximum number of particle passes required
+   nxv/nyv = first dimension of f/g
+   kypd/kxpd = second dimension of f/g
 local data */
-/* iy = partitioned co-ordinate */
-   int iy = 1;
-   int ierr, ks, ih, iter, nps, itg, kl, kr, j, j1, j2, i;
-   int joff, jin, nbsize, nter, mter, itermax, mpp;
-   float any, yt;
-   MPI_Request msid[4];
-   MPI_Status istatus;
-   int jsl[2], jsr[2], jss[2], ibflg[4], iwork[4];
-   any = (float) ny;
-   ks = kstrt - 1;
-   nbsize = idimp*nbmax;
-   iter = 2;
-   nter = 0;
-   info[0] = 0;
-   info[4] = 0;
-   ih = ihole[0];
+   cppntposenb(f,g,s,t,nx,ny,kxp,kyp,kstrt,nvp,1,nxv,nyv,kxpd,kypd);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppntposenb(float complex f[], float complex g[], float complex s[],
+                 float complex t[], int nx, int ny, int kxp, int kyp,
+                 int kstrt, int nvp, int ndim, int nxv, int nyv,
+                 int kxpd, int kypd) {
+/* this subroutine performs a transpose of a matrix f, distributed in y,
+   to a matrix g, distributed in x, that is,
+   g[l][j][k+kyp*m][1:ndim] = f[m][k][j+kxp*l][1:ndim], where
+   0 <= j < kxp, 0 <= k < kyp, 0 <= l < nx/kxp, 0 <= m < ny/kyp
+   and where indices l and m can be distributed across processors.
+   this subroutine posts all receives first, then sends all messages
+   asynchronously, unpacking data in the order it arrives, so that
+   packing and unpacking overlap with communication.
+   the local block is copied directly.
+   it requires nvp times the scratch memory of cppntpose
+   f = complex input array
+   g = complex output array
+   s, t = complex scratch arrays, of size ndim*kxp*kyp*nvp
+   nx/ny = number of points in x/y
+   kxp/kyp = number of data values per block in x/y
+   kstrt = starting data block number
+   nvp = number of real or virtual processors
+   ndim = leading dimension of arrays f and g
+   nxv/nyv = first dimension of f/g
+   kypd/kxpd = second dimension of f/g
+local data */
+   int i, n, j, k, ks, kxps, kyps, kxyp, id, joff, koff, ld, flag, ierr;
+   int nnxv, nnyv;
+   MPI_Request msid[nvp], mrid[nvp];
+   MPI_Status istatus;
+   ks = kstrt - 1;
+   kxps = nx - kxp*ks;
+   kxps = 0 > kxps ? 0 : kxps;
+   kxps = kxp < kxps ? kxp : kxps;
+   kyps = ny - kyp*ks;
+   kyps = 0 > kyps ? 0 : kyps;
+   kyps = kyp < kyps ? kyp : kyps;
+   kxyp = ndim*kxp*kyp;
+   nnxv = ndim*nxv;
+   nnyv = ndim*nyv;
+/* special case for one processor */
+   if (nvp==1) {
+      for (k = 0; k < kyp; k++) {
+         for (j = 0; j < kxp; j++) {
+            for (i = 0; i < ndim; i++) {
+               g[i+ndim*k+nnyv*j] = f[i+ndim*j+nnxv*k];
+            }
+         }
+      }
+      return;
+   }
+/* post all receives, data from processor id is stored in block id */
+   for (n = 0; n < nvp; n++) {
+      id = n - ks;
+      if (id < 0)
+         id += nvp;
+      if (id != ks)
+         ierr = MPI_Irecv(&t[kxyp*id],kxyp,mcplx,id,n,lgrp,&mrid[id]);
+   }
+   mrid[ks] = MPI_REQUEST_NULL;
+   msid[ks] = MPI_REQUEST_NULL;
+/* extract and send data, data to processor id is stored in block id */
+   for (n = 0; n < nvp; n++) {
+      id = n - ks;
+      if (id < 0)
+         id += nvp;
+      if (id==ks)
+         continue;
+      joff = kxp*id;
+      ld = nx - joff;
+      ld = 0 > ld ? 0 : ld;
+      ld = kxp < ld ? kxp : ld;
+      for (k = 0; k < kyps; k++) {
+         for (j = 0; j < ld; j++) {
+            for (i = 0; i < ndim; i++) {
+               s[i+ndim*(j+ld*k)+kxyp*id] = f[i+ndim*(j+joff)+nnxv*k];
+            }
+         }
+      }
+      ld *= ndim*kyps;
+      ierr = MPI_Isend(&s[kxyp*id],ld,mcplx,id,n,lgrp,&msid[id]);
+/* insert any data which has already arrived */
+      flag = 1;
+      while (flag) {
+         ierr = MPI_Testany(nvp,mrid,&id,&flag,&istatus);
+         if (id==MPI_UNDEFINED)
+            flag = 0;
+         if (flag)
+            cppntunpack(g,t,id,ny,kxp,kxps,kyp,ndim,nyv);
+      }
+   }
+/* copy local block while messages are in flight */
+   joff = kxp*ks;
+   koff = kyp*ks;
+   for (k = 0; k < kyps; k++) {
+      for (j = 0; j < kxps; j++) {
+         for (i = 0; i < ndim; i++) {
+            g[i+ndim*(k+koff)+nnyv*j] = f[i+ndim*(j+joff)+nnxv*k];
+         }
+      }
+   }
+/* insert remaining data as it arrives */
+   for (n = 1; n < nvp; n++) {
+      ierr = MPI_Waitany(nvp,mrid,&id,&istatus);
+      if (id==MPI_UNDEFINED)
+         break;
+      cppntunpack(g,t,id,ny,kxp,kxps,kyp,ndim,nyv);
+   }
+/* wait for sends to complete */
+   ierr = MPI_Waitall(nvp,msid,MPI_STATUSES_IGNORE);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppfmove2(float f[], float g[], int noff, int nyp, int noffd,
+               int nypd, int kstrt, int nvp, int nxv, int nypmx,
+               int nypmxd) {
+/* this subroutine moves field data from one partition to another,
+   for example from a non-uniform particle partition to the uniform
+   partition used by the fft, or back.
+   each processor sends the rows it owns to every processor whose new
+   partition overlaps them, posting all messages at once.
+   rows are contiguous, so no packing is needed.  guard cells are not
+   moved.
+   f[k][j] = real data for grid j,k in input partition
+   g[k][j] = real data for grid j,k in output partition
+   output: g
+   noff/nyp = lowermost global gridpoint/number of primary gridpoints
+   in input partition
+   noffd/nypd = lowermost global gridpoint/number of primary gridpoints
+   in output partition
+   kstrt = starting data block number
+   nvp = number of real or virtual processors
+   nxv = first dimension of f and g
+   nypmx/nypmxd = second dimension of f/g
+local data */
+   int j, n, ks, kl, kr, moff, ierr;
+   int mpart[4], mparts[4*nvp];
+   MPI_Request msid[nvp], mrid[nvp];
+/* special case for one processor */
+   if (nvp==1) {
+      for (j = 0; j < nxv*nypd; j++) {
+         g[j] = f[j];
+      }
+      return;
+   }
+   ks = kstrt - 1;
+   moff = nypmx*nvp + 3;
+/* find input and output partitions of all processors */
+   mpart[0] = noff;
+   mpart[1] = nyp;
+   mpart[2] = noffd;
+   mpart[3] = nypd;
+   ierr = MPI_Allgather(mpart,4,mint,mparts,4,mint,lgrp);
+/* post receives for rows of output partition held by other processors */
+   for (n = 0; n < nvp; n++) {
+      mrid[n] = MPI_REQUEST_NULL;
+      kl = mparts[4*n];
+      kl = noffd > kl ? noffd : kl;
+      kr = mparts[4*n] + mparts[4*n+1];
+      kr = noffd + nypd < kr ? noffd + nypd : kr;
+      if ((kr > kl) && (n != ks)) {
+         ierr = MPI_Irecv(&g[nxv*(kl-noffd)],nxv*(kr-kl),mreal,n,moff,
+                          lgrp,&mrid[n]);
+      }
+   }
+/* send rows of input partition needed by other processors */
+   for (n = 0; n < nvp; n++) {
+      msid[n] = MPI_REQUEST_NULL;
+      kl = mparts[4*n+2];
+      kl = noff > kl ? noff : kl;
+      kr = mparts[4*n+2] + mparts[4*n+3];
+      kr = noff + nyp < kr ? noff + nyp : kr;
+      if (kr > kl) {
+         if (n != ks) {
+            ierr = MPI_Isend(&f[nxv*(kl-noff)],nxv*(kr-kl),mreal,n,moff,
+                             lgrp,&msid[n]);
+         }
+/* copy local rows directly */
+         else {
+            for (j = 0; j < nxv*(kr-kl); j++) {
+               g[j+nxv*(kl-noffd)] = f[j+nxv*(kl-noff)];
+            }
+         }
+      }
+   }
+/* wait for messages to complete */
+   ierr = MPI_Waitall(nvp,mrid,MPI_STATUSES_IGNORE);
+   ierr = MPI_Waitall(nvp,msid,MPI_STATUSES_IGNORE);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppfmove22(float f[], float g[], float scs[], float scr[],
+                int noff[], int nxyp[], int noffd[], int nxypd[],
+                int ndim, int kstrt, int nvp, int nxv, int nypmx,
+                int nxvd, int nypmxd, int idds) {
+/* this subroutine moves field data from one partition to another,
+   where both partitions may be divided in x and y, for example from
+   the 2D particle partition to the uniform partition in y used by the
+   fft, or back.
+   each processor packs the rectangle it shares with every other
+   processor's new partition and sends it, posting all messages at once.
+   guard cells are not moved.
+   f[k][j][ndim] = real data for grid j,k in input partition
+   g[k][j][ndim] = real data for grid j,k in output partition
+   output: g, scs, scr
+   scs/scr = scratch arrays for data sent/received, of size at least
+   ndim*nxyp[0]*nxyp[1] and ndim*nxypd[0]*nxypd[1], respectively
+   noff[0:1]/nxyp[0:1] = leftmost and lowermost global gridpoint/number
+   of primary gridpoints in x and y in input partition
+   noffd[0:1]/nxypd[0:1] = leftmost and lowermost global gridpoint/
+   number of primary gridpoints in x and y in output partition
+   processors which do not hold any data in a partition should set
+   nxyp or nxypd to zero
+   ndim = leading dimension of arrays f and g
+   kstrt = starting data block number
+   nvp = number of real or virtual processors
+   nxv/nypmx = second/third dimension of f
+   nxvd/nypmxd = second/third dimension of g
+   idds = dimensionality of domain decomposition = 2
+local data */
+   int i, j, k, n, ks, moff, ierr;
+   int jl, jr, kl, kr, joff, ioff;
+   int mpart[8], mparts[8*nvp];
+   MPI_Request msid[nvp], mrid[nvp];
+   ks = kstrt - 1;
+   moff = nypmx*nvp + 3;
+/* find input and output partitions of all processors */
+   mpart[0] = noff[0];
+   mpart[1] = noff[1];
+   mpart[2] = nxyp[0];
+   mpart[3] = nxyp[1];
+   mpart[4] = noffd[0];
+   mpart[5] = noffd[1];
+   mpart[6] = nxypd[0];
+   mpart[7] = nxypd[1];
+   ierr = MPI_Allgather(mpart,8,mint,mparts,8,mint,lgrp);
+/* post receives for data in output partition held by other processors */
+   ioff = 0;
+   for (n = 0; n < nvp; n++) {
+      mrid[n] = MPI_REQUEST_NULL;
+      jl = mparts[8*n];
+      jl = noffd[0] > jl ? noffd[0] : jl;
+      jr = mparts[8*n] + mparts[8*n+2];
+      jr = noffd[0] + nxypd[0] < jr ? noffd[0] + nxypd[0] : jr;
+      kl = mparts[8*n+1];
+      kl = noffd[1] > kl ? noffd[1] : kl;
+      kr = mparts[8*n+1] + mparts[8*n+3];
+      kr = noffd[1] + nxypd[1] < kr ? noffd[1] + nxypd[1] : kr;
+      if ((jr > jl) && (kr > kl) && (n != ks)) {
+         ierr = MPI_Irecv(&scr[ioff],ndim*(jr-jl)*(kr-kl),mreal,n,moff,
+                          lgrp,&mrid[n]);
+         ioff += ndim*(jr - jl)*(kr - kl);
+      }
+   }
+/* pack and send data in input partition needed by other processors */
+   joff = 0;
+   for (n = 0; n < nvp; n++) {
+      msid[n] = MPI_REQUEST_NULL;
+      jl = mparts[8*n+4];
+      jl = noff[0] > jl ? noff[0] : jl;
+      jr = mparts[8*n+4] + mparts[8*n+6];
+      jr = noff[0] + nxyp[0] < jr ? noff[0] + nxyp[0] : jr;
+      kl = mparts[8*n+5];
+      kl = noff[1] > kl ? noff[1] : kl;
+      kr = mparts[8*n+5] + mparts[8*n+7];
+      kr = noff[1] + nxyp[1] < kr ? noff[1] + nxyp[1] : kr;
+      if ((jr > jl) && (kr > kl)) {
+         if (n != ks) {
+            ioff = joff;
+            for (k = kl; k < kr; k++) {
+               for (j = jl; j < jr; j++) {
+                  for (i = 0; i < ndim; i++) {
+                     scs[ioff+i] = f[i+ndim*(j-noff[0]+nxv*(k-noff[1]))];
+                  }
+                  ioff += ndim;
+               }
+            }
+            ierr = MPI_Isend(&scs[joff],ioff-joff,mreal,n,moff,lgrp,
+                             &msid[n]);
+            joff = ioff;
+         }
+/* copy local data directly */
+         else {
+            for (k = kl; k < kr; k++) {
+               for (j = jl; j < jr; j++) {
+                  for (i = 0; i < ndim; i++) {
+                     g[i+ndim*(j-noffd[0]+nxvd*(k-noffd[1]))]
+                     = f[i+ndim*(j-noff[0]+nxv*(k-noff[1]))];
+                  }
+               }
+            }
+         }
+      }
+   }
+/* wait for data to arrive */
+   ierr = MPI_Waitall(nvp,mrid,MPI_STATUSES_IGNORE);
+/* unpack received data */
+   ioff = 0;
+   for (n = 0; n < nvp; n++) {
+      jl = mparts[8*n];
+      jl = noffd[0] > jl ? noffd[0] : jl;
+      jr = mparts[8*n] + mparts[8*n+2];
+      jr = noffd[0] + nxypd[0] < jr ? noffd[0] + nxypd[0] : jr;
+      kl = mparts[8*n+1];
+      kl = noffd[1] > kl ? noffd[1] : kl;
+      kr = mparts[8*n+1] + mparts[8*n+3];
+      kr = noffd[1] + nxypd[1] < kr ? noffd[1] + nxypd[1] : kr;
+      if ((jr > jl) && (kr > kl) && (n != ks)) {
+         for (k = kl; k < kr; k++) {
+            for (j = jl; j < jr; j++) {
+               for (i = 0; i < ndim; i++) {
+                  g[i+ndim*(j-noffd[0]+nxvd*(k-noffd[1]))] = scr[ioff+i];
+               }
+               ioff += ndim;
+            }
+         }
+      }
+   }
+/* make sure sent data can be reused */
+   ierr = MPI_Waitall(nvp,msid,MPI_STATUSES_IGNORE);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppmove2(float part[], float edges[], int *npp, float sbufr[],
+              float sbufl[], float rbufr[], float rbufl[], int ihole[],
+              int ny, int kstrt, int nvp, int idimp, int npmax, int idps,
+              int nbmax, int ntmax, int info[]) {
+/* this subroutine moves particles into appropriate spatial regions
+   periodic boundary conditions
+   output: part, npp, sbufr, sbufl, rbufr, rbufl, info
+   part[n][0] = position x of particle n in partition
+   part[n][1] = position y of particle n in partition
+   part[n][2] = velocity vx of particle n in partition
+   part[n][3] = velocity vy of particle n in partition
+   edges[0:1] = lower:lower boundary of particle partition
+   npp = number of particles in partition
+   sbufl = buffer for particles being sent to lower processor
+   sbufr = buffer for particles being sent to upper processor
+   rbufl = buffer for particles being received from lower processor
+   rbufr = buffer for particles being received from upper processor
+   ihole = location of holes left in particle arrays
+   ny = system length in y direction
+   kstrt = starting data block number
+   nvp = number of real or virtual processors
+   idimp = size of phase space = 4
+   npmax = maximum number of particles in each partition.
+   idps = number of partition boundaries
+   nbmax =  size of buffers for passing particles between processors
+   ntmax =  size of hole array for particles leaving processors
+   info = status information
+   info[0] = ierr = (0,N) = (no,yes) error condition exists
+   info[1] = maximum number of particles per processor
+   info[2] = minimum number of particles per processor
+   info[3] = maximum number of buffer overflows
+   info[4] = maximum number of particle passes required
+local data */
+/* iy = partitioned co-ordinate */
+   int iy = 1;
+   int ierr, ks, ih, iter, nps, itg, kl, kr, j, j1, j2, i;
+   int joff, jin, nbsize, nter, mter, itermax, mpp;
+   float any, yt;
+   MPI_Request msid[4];
+   MPI_Status istatus;
+   int jsl[2], jsr[2], jss[2], ibflg[4], iwork[4];
+   any = (float) ny;
+   ks = kstrt - 1;
+   nbsize = idimp*nbmax;
+   iter = 2;
+   nter = 0;
+   info[0] = 0;
+   info[4] = 0;
+   ih = ihole[0];
    joff = 1;
    jin = 1;
    itermax = 2000;
@@ -980,21 +1825,960 @@ L180: nps = mpp + jsl[1] + jsr[1] - jss[0];
    return;
 }
 
-/* Interfaces to Fortran */
-
 /*--------------------------------------------------------------------*/
-void cppinit2_(int *idproc, int *nvp, int *argc, char *argv[]) {
-   cppinit2(idproc,nvp,*argc,argv);
-   return;
-}
-
-void cppexit_() {
-   cppexit();
-   return;
-}
-
-void cppabort_() {
-   cppabort();
+void cppmove2nb(float part[], float edges[], int *npp, float sbuf[],
+                int ihole[], int ny, int kstrt, int nvp, int idimp,
+                int npmax, int idps, int ntmax, int info[]) {
+/* this subroutine moves particles into appropriate spatial regions
+   periodic boundary conditions
+   particles leaving the partition are sorted by destination processor
+   in one pass, then delivered directly to that processor with one
+   message, however many partitions they cross.  the number of particles
+   each processor will receive is exchanged first, then the particles
+   themselves, posting all messages at once.  if the particle array
+   would overflow, the error is returned before any particles are
+   moved, so part and npp are unchanged.
+   output: part, npp, sbuf, info
+   part[n][0] = position x of particle n in partition
+   part[n][1] = position y of particle n in partition
+   part[n][2] = velocity vx of particle n in partition
+   part[n][3] = velocity vy of particle n in partition
+   edges[0:1] = lower:upper boundary of particle partition
+   npp = number of particles in partition
+   sbuf = buffer for particles being sent, of size at least idimp*ntmax
+   ihole = location of holes left in particle arrays
+   ny = system length in y direction
+   kstrt = starting data block number
+   nvp = number of real or virtual processors
+   idimp = size of phase space = 4
+   npmax = maximum number of particles in each partition.
+   idps = number of partition boundaries
+   ntmax =  size of hole array for particles leaving processors
+   info = status information
+   info[0] = ierr = (0,N) = (no,yes) error condition exists
+   info[1] = maximum number of particles per processor
+   info[2] = minimum number of particles per processor
+   info[3] = maximum number of buffer overflows = 0
+   info[4] = maximum number of particle passes required = 1
+local data */
+/* iy = partitioned co-ordinate */
+   int iy = 1;
+   int ierr, ks, ih, nps, nin, j, j1, j2, i, n, nl, nr, mpp, moff;
+   float any, yt;
+   float eds[nvp];
+   int scnt[nvp], sdsp[nvp], rcnt[nvp], rdsp[nvp], ibflg[2], iwork[2];
+   MPI_Request msid[nvp], mrid[nvp];
+   any = (float) ny;
+   ks = kstrt - 1;
+   moff = 2;
+   info[0] = 0;
+   info[3] = 0;
+   info[4] = 1;
+   ih = ihole[0];
+   mpp = *npp;
+/* find lower boundaries of all partitions */
+   ierr = MPI_Allgather(edges,1,mreal,eds,1,mreal,lgrp);
+/* count particles going to each processor */
+   for (n = 0; n < nvp; n++) {
+      scnt[n] = 0;
+   }
+   for (j = 0; j < ih; j++) {
+      j1 = ihole[j+1] - 1;
+      yt = part[iy+idimp*j1];
+      if (yt < 0.0)
+         yt += any;
+      if (yt >= any)
+         yt -= any;
+/* find last partition whose lower boundary is not above particle */
+      nl = 0;
+      nr = nvp - 1;
+      while (nl < nr) {
+         n = (nl + nr + 1)/2;
+         if (yt >= eds[n])
+            nl = n;
+         else
+            nr = n - 1;
+      }
+      scnt[nl] += 1;
+   }
+   nps = 0;
+   for (n = 0; n < nvp; n++) {
+      sdsp[n] = nps;
+      nps += scnt[n];
+   }
+/* exchange number of particles going to each processor */
+   ierr = MPI_Alltoall(scnt,1,mint,rcnt,1,mint,lgrp);
+   nin = 0;
+   for (n = 0; n < nvp; n++) {
+      rdsp[n] = mpp - ih + nin;
+      nin += rcnt[n];
+   }
+/* check if move would overflow particle array */
+   nps = mpp - ih + nin;
+   ibflg[0] = nps;
+   nps = npmax < nps ? npmax : nps;
+   ibflg[1] = -nps;
+   cppimax(ibflg,iwork,2);
+   info[1] = ibflg[0];
+   info[2] = -ibflg[1];
+   ierr = ibflg[0] - npmax;
+   if (ierr > 0) {
+      fprintf(unit2,"particle overflow error, ierr = %d\n",ierr);
+      info[0] = ierr;
+      return;
+   }
+/* copy outgoing particles into buffer, sorted by destination */
+   for (j = 0; j < ih; j++) {
+      j1 = ihole[j+1] - 1;
+      yt = part[iy+idimp*j1];
+      if (yt < 0.0)
+         yt += any;
+      if (yt >= any)
+         yt -= any;
+      nl = 0;
+      nr = nvp - 1;
+      while (nl < nr) {
+         n = (nl + nr + 1)/2;
+         if (yt >= eds[n])
+            nl = n;
+         else
+            nr = n - 1;
+      }
+      j2 = sdsp[nl];
+      for (i = 0; i < idimp; i++) {
+         sbuf[i+idimp*j2] = part[i+idimp*j1];
+      }
+      sbuf[iy+idimp*j2] = yt;
+      sdsp[nl] += 1;
+   }
+   for (n = 0; n < nvp; n++) {
+      sdsp[n] -= scnt[n];
+   }
+/* fill up holes in particle array with particles from bottom */
+   for (j = 0; j < ih; j++) {
+      j1 = mpp - j - 1;
+      j2 = ihole[ih-j] - 1;
+      if (j1 > j2) {
+/* move particle only if it is below current hole */
+         for (i = 0; i < idimp; i++) {
+            part[i+idimp*j2] = part[i+idimp*j1];
+         }
+      }
+   }
+   mpp -= ih;
+/* post receives directly into the bottom of the particle array */
+   for (n = 0; n < nvp; n++) {
+      mrid[n] = MPI_REQUEST_NULL;
+      if ((rcnt[n] > 0) && (n != ks)) {
+         ierr = MPI_Irecv(&part[idimp*rdsp[n]],idimp*rcnt[n],mreal,n,
+                          moff,lgrp,&mrid[n]);
+      }
+   }
+/* send particles, copy particles staying here directly */
+   for (n = 0; n < nvp; n++) {
+      msid[n] = MPI_REQUEST_NULL;
+      if (scnt[n] > 0) {
+         if (n != ks) {
+            ierr = MPI_Isend(&sbuf[idimp*sdsp[n]],idimp*scnt[n],mreal,n,
+                             moff,lgrp,&msid[n]);
+         }
+         else {
+            for (j = 0; j < idimp*scnt[n]; j++) {
+               part[j+idimp*rdsp[n]] = sbuf[j+idimp*sdsp[n]];
+            }
+         }
+      }
+   }
+/* wait for messages to complete */
+   ierr = MPI_Waitall(nvp,mrid,MPI_STATUSES_IGNORE);
+   ierr = MPI_Waitall(nvp,msid,MPI_STATUSES_IGNORE);
+   *npp = mpp + nin;
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppmoveg22(float part[], float edges[], int *npp, float sbufr[],
+                float sbufl[], float rbufr[], float rbufl[],
+                int ihole[], int nx, int ny, int kstrt, int nvpx,
+                int nvpy, int idimp, int npmax, int idps, int nbmax,
+                int ntmax, int info[]) {
+/* this subroutine moves particles into appropriate spatial regions
+   ihole array is calculated from particles co-ordinates
+   with periodic boundary conditions and 2D spatial decomposition
+   output: part, ihole, npp, sbufr, sbufl, rbufr, rbufl, info
+   part[n][0] = position x of particle n in partition
+   part[n][1] = position y of particle n in partition
+   part[n][2] = velocity vx of particle n in partition
+   part[n][3] = velocity vy of particle n in partition
+   edges[0:1] = left:right boundary in x of particle partition
+   edges[2:3] = lower:upper boundary in y of particle partition
+   npp = number of particles in partition
+   sbufl = buffer for particles being sent to left or lower processor
+   sbufr = buffer for particles being sent to right or upper processor
+   rbufl = buffer for particles being received from left or lower
+   processor
+   rbufr = buffer for particles being received from right or upper
+   processor
+   ihole = location of holes left in particle arrays
+   nx/ny = system length in x/y direction
+   kstrt = starting data block number
+   nvpx/nvpy = number of real or virtual processors in x/y
+   idimp = size of phase space = 4
+   npmax = maximum number of particles in each partition.
+   idps = number of particle partition boundaries = 4
+   nbmax =  size of buffers for passing particles between processors
+   ntmax =  size of hole array for particles leaving processors
+   info = status information
+   info[0] = ierr = (0,N) = (no,yes) error condition exists
+   info[1] = maximum number of particles per processor
+   info[2] = minimum number of particles per processor
+   info[3:4] = maximum number of buffer overflows in x/y
+   info[5:6] = maximum number of particle passes required in x/y
+local data */
+   int ierr, js, ks, ic, nvp, ih, iter, nps, itg, kl, kr, j, j1, j2;
+   int i, n, joff, jin, nbsize, nter, mter, itermax, mpp;
+   float an, xt;
+   MPI_Request msid[4];
+   MPI_Status istatus;
+   int kb[2], jsl[2], jsr[2], jss[2], ibflg[4], iwork[4];
+/* js/ks = processor co-ordinates in x/y => idproc = js + nvpx*ks */
+   ks = (kstrt - 1)/nvpx;
+   js = kstrt - nvpx*ks - 1;
+   nbsize = idimp*nbmax;
+   info[0] = 0;
+   info[5] = 0;
+   info[6] = 0;
+   itermax = 2000;
+   mpp = *npp;
+/* buffer outgoing particles, first in x then in y direction */
+   for (n = 0; n < 2; n++) {
+      if (n==0) {
+         ic = 0;
+         nvp = nvpx;
+         an = (float) nx;
+      }
+      else {
+         ic = 1;
+         nvp = nvpy;
+         an = (float) ny;
+      }
+      iter = 2;
+      nter = 0;
+      joff = 1;
+/* ih = number of particles extracted from holes   */
+/* joff = next hole location for extraction        */
+/* jss[0] = number of holes available to be filled */
+/* jin = next hole location to be filled           */
+/* start loop */
+L10: mter = 0;
+      nps = 0;
+      jin = 1;
+      kb[0] = js;
+      kb[1] = ks;
+/* buffer outgoing particles */
+      jsl[0] = 0;
+      jsr[0] = 0;
+/* load particle buffers */
+      for (j = 0; j < mpp; j++) {
+         xt = part[ic+idimp*j];
+/* particles going left or down */
+         if (xt < edges[2*n]) {
+            if (kb[n]==0)
+               xt += an;
+            if (jsl[0] < nbmax) {
+               for (i = 0; i < idimp; i++) {
+                  sbufl[i+idimp*jsl[0]] = part[i+idimp*j];
+               }
+               sbufl[ic+idimp*jsl[0]] = xt;
+               jsl[0] += 1;
+               ihole[jsl[0]+jsr[0]] = j + 1;
+            }
+            else {
+               nps = 1;
+               goto L50;
+            }
+         }
+/* particles going right or up */
+         else if (xt >= edges[2*n+1]) {
+            if (kb[n]==(nvp-1))
+               xt -= an;
+            if (jsr[0] < nbmax) {
+               for (i = 0; i < idimp; i++) {
+                  sbufr[i+idimp*jsr[0]] = part[i+idimp*j];
+               }
+               sbufr[ic+idimp*jsr[0]] = xt;
+               jsr[0] += 1;
+               ihole[jsl[0]+jsr[0]] = j + 1;
+            }
+            else {
+               nps = 1;
+               goto L50;
+            }
+         }
+      }
+L50:  jss[0] = jsl[0] + jsr[0];
+      joff += jss[0];
+      ihole[0] = jss[0];
+      ih = 0;
+/* check for full buffer condition */
+      ibflg[2] = nps;
+/* copy particle buffers */
+L60:  iter += 2;
+      mter += 1;
+/* special case for one processor */
+      if (nvp==1) {
+         jsl[1] = jsr[0];
+         for (j = 0; j < jsl[1]; j++) {
+            for (i = 0; i < idimp; i++) {
+               rbufl[i+idimp*j] = sbufr[i+idimp*j];
+            }
+         }
+         jsr[1] = jsl[0];
+         for (j = 0; j < jsr[1]; j++) {
+            for (i = 0; i < idimp; i++) {
+               rbufr[i+idimp*j] = sbufl[i+idimp*j];
+            }
+         }
+      }
+/* this segment is used for mpi computers */
+      else {
+/* get particles from left and right or below and above */
+         kb[0] = js;
+         kb[1] = ks;
+         kl = kb[n];
+         kb[n] = kl + 1;
+         if (kb[n] >= nvp)
+            kb[n] -= nvp;
+         kr = kb[0] + nvpx*kb[1];
+         kb[n] = kl - 1;
+         if (kb[n] < 0)
+            kb[n] += nvp;
+         kl = kb[0] + nvpx*kb[1];
+/* post receive */
+         itg = iter - 1;
+         ierr = MPI_Irecv(rbufl,nbsize,mreal,kl,itg,lgrp,&msid[0]);
+         ierr = MPI_Irecv(rbufr,nbsize,mreal,kr,iter,lgrp,&msid[1]);
+/* send particles */
+         jsr[0] = idimp*jsr[0];
+         ierr = MPI_Isend(sbufr,jsr[0],mreal,kr,itg,lgrp,&msid[2]);
+         jsl[0] = idimp*jsl[0];
+         ierr = MPI_Isend(sbufl,jsl[0],mreal,kl,iter,lgrp,&msid[3]);
+/* wait for particles to arrive */
+         ierr = MPI_Wait(&msid[0],&istatus);
+         ierr = MPI_Get_count(&istatus,mreal,&nps);
+         jsl[1] = nps/idimp;
+         ierr = MPI_Wait(&msid[1],&istatus);
+         ierr = MPI_Get_count(&istatus,mreal,&nps);
+         jsr[1] = nps/idimp;
+      }
+/* check if particles must be passed further */
+/* check if any particles coming from right or above belong here */
+      jsl[0] = 0;
+      jsr[0] = 0;
+      jss[1] = 0;
+      for (j = 0; j < jsr[1]; j++) {
+         if (rbufr[ic+idimp*j] < edges[2*n])
+            jsl[0] += 1;
+         if (rbufr[ic+idimp*j] >= edges[2*n+1])
+            jsr[0] += 1;
+      }
+/* check if any particles coming from left or below belong here */
+      for (j = 0; j < jsl[1]; j++) {
+         if (rbufl[ic+idimp*j] >= edges[2*n+1])
+            jsr[0] += 1;
+         if (rbufl[ic+idimp*j] < edges[2*n])
+            jss[1] += 1;
+      }
+      nps = jsl[0] + jsr[0] + jss[1];
+      ibflg[1] = nps;
+/* make sure sbufr and sbufl have been sent */
+      if (nvp != 1) {
+         ierr = MPI_Wait(&msid[2],&istatus);
+         ierr = MPI_Wait(&msid[3],&istatus);
+      }
+      if (nps==0)
+         goto L180;
+/* remove particles which do not belong here */
+      kb[0] = js;
+      kb[1] = ks;
+/* first check particles coming from right or above */
+      jsl[0] = 0;
+      jsr[0] = 0;
+      jss[1] = 0;
+      for (j = 0; j < jsr[1]; j++) {
+         xt = rbufr[ic+idimp*j];
+/* particles going left or down */
+         if (xt < edges[2*n]) {
+            if (kb[n]==0)
+               xt += an;
+            rbufr[ic+idimp*j] = xt;
+            for (i = 0; i < idimp; i++) {
+               sbufl[i+idimp*jsl[0]] = rbufr[i+idimp*j];
+            }
+            jsl[0] += 1;
+         }
+/* particles going right or up, should not happen */
+         else if (xt >= edges[2*n+1]) {
+            if (kb[n]==(nvp-1))
+               xt -= an;
+            rbufr[ic+idimp*j] = xt;
+            for (i = 0; i < idimp; i++) {
+               sbufr[i+idimp*jsr[0]] = rbufr[i+idimp*j];
+            }
+            jsr[0] += 1;
+         }
+/* particles staying here */
+         else {
+            for (i = 0; i < idimp; i++) {
+               rbufr[i+idimp*jss[1]] = rbufr[i+idimp*j];
+            }
+            jss[1] += 1;
+         }
+      }
+      jsr[1] = jss[1];
+/* next check particles coming from left or below */
+      jss[1] = 0;
+      for (j = 0; j < jsl[1]; j++) {
+         xt = rbufl[ic+idimp*j];
+/* particles going right or up */
+         if (xt >= edges[2*n+1]) {
+            if (jsr[0] < nbmax) {
+               if (kb[n]==(nvp-1))
+                  xt -= an;
+               rbufl[ic+idimp*j] = xt;
+               for (i = 0; i < idimp; i++) {
+                  sbufr[i+idimp*jsr[0]] = rbufl[i+idimp*j];
+               }
+               jsr[0] += 1;
+            }
+            else {
+               jss[1] = 2*npmax;
+               goto L170;
+            }
+         }
+/* particles going left or down, should not happen */
+         else if (xt < edges[2*n]) {
+            if (jsl[0] < nbmax) {
+               if (kb[n]==0)
+                  xt += an;
+               rbufl[ic+idimp*j] = xt;
+               for (i = 0; i < idimp; i++) {
+                  sbufl[i+idimp*jsl[0]] = rbufl[i+idimp*j];
+               }
+               jsl[0] += 1;
+            }
+            else {
+               jss[1] = 2*npmax;
+               goto L170;
+            }
+         }
+/* particles staying here */
+         else {
+            for (i = 0; i < idimp; i++) {
+               rbufl[i+idimp*jss[1]] = rbufl[i+idimp*j];
+            }
+            jss[1] += 1;
+         }
+      }
+L170: jsl[1] = jss[1];
+/* check if move would overflow particle array */
+L180: nps = mpp + jsl[1] + jsr[1] - jss[0];
+      ibflg[0] = nps;
+      nps = npmax < nps ? npmax : nps;
+      ibflg[3] = -nps;
+      cppimax(ibflg,iwork,4);
+      info[1] = ibflg[0];
+      info[2] = -ibflg[3];
+      ierr = ibflg[0] - npmax;
+      if (ierr > 0) {
+         fprintf(unit2,"particle overflow error, ierr = %d\n",ierr);
+         info[0] = ierr;
+         *npp = mpp;
+         return;
+      }
+/* distribute incoming particles from buffers */
+/* distribute particles coming from left or below into holes */
+      jss[1] = jss[0] < jsl[1] ? jss[0] : jsl[1];
+      for (j = 0; j < jss[1]; j++) {
+         j1 = ihole[j+jin] - 1;
+         for (i = 0; i < idimp; i++) {
+            part[i+idimp*j1] = rbufl[i+idimp*j];
+         }
+      }
+      jin += jss[1];
+      if (jss[0] > jsl[1]) {
+         jss[1] = jss[0] - jsl[1];
+         jss[1] = jss[1] < jsr[1] ? jss[1] : jsr[1];
+      }
+      else
+         jss[1] = jsl[1] - jss[0];
+      for (j = 0; j < jss[1]; j++) {
+/* no more particles coming from left or below */
+/* distribute particles coming from right or above into holes */
+         if (jss[0] > jsl[1]) {
+            j1 = ihole[j+jin] - 1;
+            for (i = 0; i < idimp; i++) {
+               part[i+idimp*j1] = rbufr[i+idimp*j];
+            }
+         }
+/* no more holes */
+/* distribute remaining particles from left or below into bottom */
+         else {
+            for (i = 0; i < idimp; i++) {
+               part[i+idimp*(j+mpp)] = rbufl[i+idimp*(j+jss[0])];
+            }
+         }
+      }
+      if (jss[0] > jsl[1])
+         jin += jss[1];
+      nps = jsl[1] + jsr[1];
+      if (jss[0] <= jsl[1]) {
+         mpp += jsl[1] - jss[0];
+         jss[0] = jsl[1];
+      }
+/* no more holes */
+/* distribute remaining particles from right or above into bottom */
+      jsr[1] = nps - jss[0];
+      jsr[1] = 0 > jsr[1] ? 0 : jsr[1];
+      jss[0] -= jsl[1];
+      for (j = 0; j < jsr[1]; j++) {
+         for (i = 0; i < idimp; i++) {
+            part[i+idimp*(j+mpp)] = rbufr[i+idimp*(j+jss[0])];
+         }
+      }
+      mpp += jsr[1];
+/* holes left over */
+/* fill up remaining holes in particle array with particles from bottom */
+      if (ih==0) {
+         jsr[1] = ihole[0] - jin + 1;
+         jsr[1] = 0 > jsr[1] ? 0 : jsr[1];
+         for (j = 0; j < jsr[1]; j++) {
+            j1 = mpp - j - 1;
+            j2 = ihole[jsr[1]-j+jin-1] - 1;
+            if (j1 > j2) {
+/* move particle only if it is below current hole */
+               for (i = 0; i < idimp; i++) {
+                  part[i+idimp*j2] = part[i+idimp*j1];
+               }
+            }
+         }
+         jin += jsr[1];
+         mpp -= jsr[1];
+      }
+      jss[0] = 0;
+/* check if any particles have to be passed further */
+      if (ibflg[2] > 0)
+         ibflg[2] = 1;
+      info[5+n] = info[5+n] > mter ? info[5+n] : mter;
+      if (ibflg[1] > 0) {
+         if (iter < itermax)
+            goto L60;
+         ierr = -((iter-2)/2);
+         if (kstrt==1)
+            fprintf(unit2,"Iteration overflow, iter = %d\n",ierr);
+         info[0] = ierr;
+         *npp = mpp;
+         return;
+      }
+/* check if buffer overflowed and more particles remain to be checked */
+      if (ibflg[2] > 0) {
+         nter += 1;
+         info[3+n] = nter;
+         goto L10;
+      }
+      if (nter > 0) {
+         if (kstrt==1) {
+            fprintf(unit2,"Info: %d buffer overflows, nbmax=%d\n",nter,
+                    nbmax);
+         }
+      }
+   }
+   *npp = mpp;
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppwchkpth2(char *fname, int nis, int isc[], int nfs, float fsc[],
+                 int *irc) {
+/* this subroutine opens a shared checkpoint file for writing by all
+   processors with MPI-IO, and saves the scalars, which should be the
+   same on all processors.  distributed arrays are then written by
+   cppwchkpta2 and particles by cppwchkptp2, and the file is completed
+   by cppwchkptc2.  the file is written as fname.tmp and renamed when
+   complete, so that an interrupted checkpoint does not destroy the
+   previous one
+   input: all, output: irc
+   fname = name of checkpoint file
+   nis/nfs = number of integer/real scalars, <= 32
+   isc/fsc = integer/real scalars
+   irc = error code: 0 = ok, 1 = cannot create file, 4 = too many
+   scalars
+local data */
+   int n, ierr;
+   char ftmp[264];
+   MPI_Info minfo;
+   *irc = 0;
+   if ((nis > NCHKMAX) || (nfs > NCHKMAX) || (strlen(fname) > 255)) {
+      *irc = 4;
+      return;
+   }
+   memset(&chkhd,0,sizeof(struct ppchkhead));
+   memcpy(chkhd.magic,ppchkmagic,8);
+   chkhd.nvp = nproc;
+   chkhd.nis = nis;
+   chkhd.nfs = nfs;
+   for (n = 0; n < nis; n++) {
+      chkhd.isc[n] = isc[n];
+   }
+   for (n = 0; n < nfs; n++) {
+      chkhd.fsc[n] = fsc[n];
+   }
+   strcpy(fchk,fname);
+   sprintf(ftmp,"%s.tmp",fname);
+/* collective buffering lets a few aggregators access the file */
+   MPI_Info_create(&minfo);
+   MPI_Info_set(minfo,"romio_cb_write","enable");
+   ierr = MPI_File_open(lgrp,ftmp,MPI_MODE_WRONLY|MPI_MODE_CREATE,
+                        minfo,&mchk);
+   MPI_Info_free(&minfo);
+   if (ierr != MPI_SUCCESS) {
+      mchk = MPI_FILE_NULL;
+      *irc = 1;
+      return;
+   }
+/* discard any previous contents */
+   ierr = MPI_File_set_size(mchk,0);
+/* first block is reserved for header */
+   nchkf = NCHKAL;
+   chkerr = 0;
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppwchkpta2(float f[], int nrow, int nrp, int noffr, int nrows) {
+/* this subroutine writes a distributed array to the checkpoint file
+   opened by cppwchkpth2, with a collective write.  the array is
+   stored as nrows global rows, each processor writes its nrp rows,
+   which start at global row noffr.  the rows may be the nyp rows
+   of a particle partition, or the kxp rows of an array transposed
+   in fourier space, with complex data counted as two reals
+   input: all
+   f = distributed array, first nrp rows are written
+   nrow = length of each row, in reals
+   nrp = number of rows in this processor
+   noffr = global row number of first row in this processor
+   nrows = total number of rows, sum of nrp over processors
+local data */
+   int n, nsz, ierr;
+   MPI_Offset noff;
+   MPI_Status istatus;
+   if (mchk==MPI_FILE_NULL)
+      return;
+   n = chkhd.narr;
+   if (n >= NCHKMAX) {
+      chkerr = 4;
+      return;
+   }
+   ierr = MPI_Type_size(mreal,&nsz);
+   chkhd.nrow[n] = nrow;
+   chkhd.nrows[n] = nrows;
+   chkhd.noffa[n] = nchkf;
+   noff = nchkf + (MPI_Offset) nsz*nrow*(MPI_Offset) noffr;
+   ierr = MPI_File_write_at_all(mchk,noff,f,nrow*nrp,mreal,&istatus);
+   if (ierr != MPI_SUCCESS)
+      chkerr = 2;
+/* next array starts on a block boundary */
+   noff = (MPI_Offset) nsz*nrow*(MPI_Offset) nrows;
+   nchkf += NCHKAL*((noff + NCHKAL - 1)/NCHKAL);
+   chkhd.narr = n + 1;
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppwchkptp2(float part[], int npp, int idimp, int npmax) {
+/* this subroutine writes particles to the checkpoint file opened by
+   cppwchkpth2, with a collective write.  an index with the number of
+   particles in each processor is written first, followed by the
+   particles of each processor in processor order
+   input: all
+   part[n][i] = coordinate i of particle n in partition
+   npp = number of particles in partition
+   idimp = size of phase space = 4
+   npmax = maximum number of particles in each partition
+local data */
+   int j, n, ks, nsz, ierr;
+   long long nsum, ntot;
+   MPI_Offset noff;
+   MPI_Status istatus;
+   int *kpp = NULL;
+   if (mchk==MPI_FILE_NULL)
+      return;
+   n = chkhd.narr;
+   if (n >= NCHKMAX) {
+      chkerr = 4;
+      return;
+   }
+   ierr = MPI_Comm_rank(lgrp,&ks);
+   ierr = MPI_Type_size(mreal,&nsz);
+/* find particle index */
+   kpp = (int *) malloc(nproc*sizeof(int));
+   ierr = MPI_Allgather(&npp,1,mint,kpp,1,mint,lgrp);
+   nsum = 0;
+   ntot = 0;
+   for (j = 0; j < nproc; j++) {
+      if (j < ks)
+         nsum += kpp[j];
+      ntot += kpp[j];
+   }
+   chkhd.nrow[n] = idimp;
+   chkhd.nrows[n] = 0;
+   chkhd.noffa[n] = nchkf;
+   chkhd.ntot[n] = ntot;
+/* processor 0 writes the index */
+   if (ks==0) {
+      ierr = MPI_File_write_at(mchk,nchkf,kpp,nproc,mint,&istatus);
+      if (ierr != MPI_SUCCESS)
+         chkerr = 2;
+   }
+   free(kpp);
+   noff = sizeof(int)*(MPI_Offset) nproc;
+   nchkf += NCHKAL*((noff + NCHKAL - 1)/NCHKAL);
+/* write particles */
+   noff = nchkf + (MPI_Offset) nsz*idimp*(MPI_Offset) nsum;
+   ierr = MPI_File_write_at_all(mchk,noff,part,idimp*npp,mreal,
+                                &istatus);
+   if (ierr != MPI_SUCCESS)
+      chkerr = 2;
+   noff = (MPI_Offset) nsz*idimp*(MPI_Offset) ntot;
+   nchkf += NCHKAL*((noff + NCHKAL - 1)/NCHKAL);
+   chkhd.narr = n + 1;
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppwchkptc2(int *irc) {
+/* this subroutine completes the checkpoint file written by cppwchkpth2,
+   cppwchkpta2 and cppwchkptp2.  processor 0 writes the header, and
+   renames the file after it is closed
+   output: irc
+   irc = error code: 0 = ok, 1 = file not open, 2 = write error,
+   3 = rename error, 4 = too many arrays
+local data */
+   int ks, ierr;
+   char ftmp[264];
+   MPI_Status istatus;
+   if (mchk==MPI_FILE_NULL) {
+      *irc = 1;
+      return;
+   }
+   ierr = MPI_Comm_rank(lgrp,&ks);
+   if (ks==0) {
+      ierr = MPI_File_write_at(mchk,0,&chkhd,sizeof(struct ppchkhead),
+                               MPI_BYTE,&istatus);
+      if (ierr != MPI_SUCCESS)
+         chkerr = 2;
+   }
+   ierr = MPI_File_sync(mchk);
+   if (ierr != MPI_SUCCESS)
+      chkerr = 2;
+   ierr = MPI_File_close(&mchk);
+   mchk = MPI_FILE_NULL;
+   ierr = MPI_Allreduce(&chkerr,irc,1,mint,mmax,lgrp);
+/* rename completed file */
+   if (ks==0) {
+      if (*irc==0) {
+         sprintf(ftmp,"%s.tmp",fchk);
+         if (rename(ftmp,fchk) != 0)
+            *irc = 3;
+      }
+   }
+   ierr = MPI_Bcast(irc,1,mint,0,lgrp);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cpprchkpth2(char *fname, int nis, int isc[], int nfs, float fsc[],
+                 int *nvpo, int *irc) {
+/* this subroutine opens a checkpoint file written by cppwchkpth2 for
+   reading by all processors with MPI-IO, and reads the scalars.
+   the arrays are then read by cpprchkpta2 and cpprchkptp2, and the
+   file is closed by cpprchkptc2
+   input: fname, nis, nfs, output: isc, fsc, nvpo, irc
+   fname = name of checkpoint file
+   nis/nfs = number of integer/real scalars expected
+   isc/fsc = integer/real scalars
+   nvpo = number of processors which wrote the file
+   irc = error code: 0 = ok, 1 = cannot open file, 2 = not a valid
+   checkpoint file, or wrong number of scalars
+local data */
+   int n, ks, ierr;
+   MPI_Info minfo;
+   MPI_Status istatus;
+   *irc = 0;
+   MPI_Info_create(&minfo);
+   MPI_Info_set(minfo,"romio_cb_read","enable");
+   ierr = MPI_File_open(lgrp,fname,MPI_MODE_RDONLY,minfo,&mchk);
+   MPI_Info_free(&minfo);
+   if (ierr != MPI_SUCCESS) {
+      mchk = MPI_FILE_NULL;
+      *irc = 1;
+      return;
+   }
+/* processor 0 reads the header and broadcasts it */
+   ierr = MPI_Comm_rank(lgrp,&ks);
+   memset(&chkhd,0,sizeof(struct ppchkhead));
+   if (ks==0) {
+      ierr = MPI_File_read_at(mchk,0,&chkhd,sizeof(struct ppchkhead),
+                              MPI_BYTE,&istatus);
+   }
+   ierr = MPI_Bcast(&chkhd,sizeof(struct ppchkhead),MPI_BYTE,0,lgrp);
+   if ((memcmp(chkhd.magic,ppchkmagic,8) != 0) || (chkhd.nis != nis)
+      || (chkhd.nfs != nfs) || (chkhd.narr > NCHKMAX)
+      || (chkhd.nvp < 1)) {
+      cpprchkptc2();
+      *irc = 2;
+      return;
+   }
+   for (n = 0; n < nis; n++) {
+      isc[n] = chkhd.isc[n];
+   }
+   for (n = 0; n < nfs; n++) {
+      fsc[n] = chkhd.fsc[n];
+   }
+   *nvpo = chkhd.nvp;
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cpprchkpta2(int n, float f[], int nrow, int nrp, int noffr,
+                 int nrows, int *irc) {
+/* this subroutine reads a distributed array from the checkpoint file
+   opened by cpprchkpth2, with a collective read.  each processor reads
+   nrp rows starting at global row noffr, so the partition need not be
+   the same as the one which wrote the file
+   input: n, nrow, nrp, noffr, nrows, output: f, irc
+   n = array number in checkpoint file, starting with 0
+   f = distributed array, first nrp rows are read
+   nrow = length of each row, in reals
+   nrp = number of rows in this processor
+   noffr = global row number of first row in this processor
+   nrows = total number of rows
+   irc = error code: 0 = ok, 2 = read error, 3 = array not found or
+   wrong size
+local data */
+   int nsz, ierr, jerr;
+   MPI_Offset noff;
+   MPI_Status istatus;
+   if ((mchk==MPI_FILE_NULL) || (n >= chkhd.narr)
+      || (chkhd.nrows[n] != nrows) || (chkhd.nrow[n] != nrow)) {
+      *irc = 3;
+      return;
+   }
+   ierr = MPI_Type_size(mreal,&nsz);
+   noff = chkhd.noffa[n] + (MPI_Offset) nsz*nrow*(MPI_Offset) noffr;
+   ierr = MPI_File_read_at_all(mchk,noff,f,nrow*nrp,mreal,&istatus);
+   jerr = 0;
+   if (ierr != MPI_SUCCESS)
+      jerr = 2;
+   ierr = MPI_Allreduce(&jerr,irc,1,mint,mmax,lgrp);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cpprchkptp2(int n, float part[], int *npp, int idimp, int npmax,
+                 int *irc) {
+/* this subroutine reads particles from the checkpoint file opened by
+   cpprchkpth2, with a collective read.  if the file was written by the
+   same number of processors, each processor reads the particles it
+   wrote, using the index.  otherwise the particles are divided evenly
+   among processors, and must afterwards be moved to the correct
+   partition, for example with cppmove2
+   input: n, idimp, npmax, output: part, npp, irc
+   n = array number in checkpoint file, starting with 0
+   part[n][i] = coordinate i of particle n in partition
+   npp = number of particles read in partition
+   idimp = size of phase space = 4
+   npmax = maximum number of particles in each partition
+   irc = error code: 0 = ok, 2 = read error, 3 = array not found,
+   wrong size, or too many particles
+local data */
+   int j, ks, nvpo, mpp, nsz, ierr, jerr;
+   long long nsum;
+   MPI_Offset noff;
+   MPI_Status istatus;
+   int *kpp = NULL;
+   if ((mchk==MPI_FILE_NULL) || (n >= chkhd.narr)
+      || (chkhd.nrows[n] != 0) || (chkhd.nrow[n] != idimp)) {
+      *irc = 3;
+      return;
+   }
+   ierr = MPI_Comm_rank(lgrp,&ks);
+   ierr = MPI_Type_size(mreal,&nsz);
+   nvpo = chkhd.nvp;
+/* read particle index */
+   kpp = (int *) malloc(nvpo*sizeof(int));
+   ierr = MPI_File_read_at_all(mchk,chkhd.noffa[n],kpp,nvpo,mint,
+                               &istatus);
+   jerr = 0;
+   if (ierr != MPI_SUCCESS)
+      jerr = 2;
+/* same processors: read own particles */
+   if (nvpo==nproc) {
+      nsum = 0;
+      for (j = 0; j < ks; j++) {
+         nsum += kpp[j];
+      }
+      mpp = kpp[ks];
+   }
+/* different processors: divide particles evenly */
+   else {
+      nsum = (chkhd.ntot[n]*ks)/nproc;
+      mpp = (chkhd.ntot[n]*(ks + 1))/nproc - nsum;
+   }
+   free(kpp);
+   if ((mpp < 0) || (mpp > npmax))
+      jerr = 3;
+   ierr = MPI_Allreduce(&jerr,irc,1,mint,mmax,lgrp);
+   if (*irc != 0)
+      return;
+/* read particles */
+   noff = sizeof(int)*(MPI_Offset) nvpo;
+   noff = chkhd.noffa[n] + NCHKAL*((noff + NCHKAL - 1)/NCHKAL)
+        + (MPI_Offset) nsz*idimp*(MPI_Offset) nsum;
+   ierr = MPI_File_read_at_all(mchk,noff,part,idimp*mpp,mreal,
+                               &istatus);
+   if (ierr != MPI_SUCCESS)
+      jerr = 2;
+   ierr = MPI_Allreduce(&jerr,irc,1,mint,mmax,lgrp);
+   *npp = mpp;
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cpprchkptc2() {
+/* this subroutine closes the checkpoint file opened by cpprchkpth2 */
+   int ierr;
+   if (mchk != MPI_FILE_NULL)
+      ierr = MPI_File_close(&mchk);
+   mchk = MPI_FILE_NULL;
+   return;
+}
+
+/* Interfaces to Fortran */
+
+/*--------------------------------------------------------------------*/
+void cppinit2_(int *idproc, int *nvp, int *argc, char *argv[]) {
+   cppinit2(idproc,nvp,*argc,argv);
+   return;
+}
+
+void cppexit_() {
+   cppexit();
+   return;
+}
+
+void cppabort_() {
+   cppabort();
    return;
 }
 
@@ -1049,6 +2833,40 @@ void cppnacguard2l_(float *f, float *scr, int *nyp, int *nx, int *ndim,
    return;
 }
 
+/*--------------------------------------------------------------------*/
+void cppnguard2init_(float *scs, float *scr, int *igds, int *kstrt,
+                     int *nvp, int *nxv, int *nypmx) {
+   cppnguard2init(scs,scr,igds,*kstrt,*nvp,*nxv,*nypmx);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppncguard2lp_(float *f, float *scs, float *scr, int *igds,
+                    int *nyp, int *nvp, int *nxv) {
+   cppncguard2lp(f,scs,scr,*igds,*nyp,*nvp,*nxv);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppnaguard2lp_(float *f, float *scs, float *scr, int *igds,
+                    int *nyp, int *nx, int *nvp, int *nxv) {
+   cppnaguard2lp(f,scs,scr,*igds,*nyp,*nx,*nvp,*nxv);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppnacguard2lp_(float *f, float *scs, float *scr, int *igds,
+                     int *nyp, int *nx, int *ndim, int *nvp, int *nxv) {
+   cppnacguard2lp(f,scs,scr,*igds,*nyp,*nx,*ndim,*nvp,*nxv);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppnguard2free_(int *igds) {
+   cppnguard2free(igds);
+   return;
+}
+
 /*--------------------------------------------------------------------*/
 void cpptpose_(float complex *f, float complex *g, float complex *s,
                float complex *t, int *nx, int *ny, int *kxp, int *kyp,
@@ -1068,6 +2886,35 @@ void cppntpose_(float complex *f, float complex *g, float complex *s,
    return;
 }
 
+/*--------------------------------------------------------------------*/
+void cpptposenb_(float complex *f, float complex *g, float complex *s,
+                 float complex *t, int *nx, int *ny, int *kxp, int *kyp,
+                 int *kstrt, int *nvp, int *nxv, int *nyv, int *kxpd,
+                 int *kypd) {
+   cpptposenb(f,g,s,t,*nx,*ny,*kxp,*kyp,*kstrt,*nvp,*nxv,*nyv,*kxpd,
+              *kypd);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppntposenb_(float complex *f, float complex *g, float complex *s,
+                  float complex *t, int *nx, int *ny, int *kxp, int *kyp,
+                  int *kstrt, int *nvp, int *ndim, int *nxv, int *nyv,
+                  int *kxpd, int *kypd) {
+   cppntposenb(f,g,s,t,*nx,*ny,*kxp,*kyp,*kstrt,*nvp,*ndim,*nxv,*nyv,
+               *kxpd,*kypd);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppfmove2_(float *f, float *g, int *noff, int *nyp, int *noffd,
+                int *nypd, int *kstrt, int *nvp, int *nxv, int *nypmx,
+                int *nypmxd) {
+   cppfmove2(f,g,*noff,*nyp,*noffd,*nypd,*kstrt,*nvp,*nxv,*nypmx,
+             *nypmxd);
+   return;
+}
+
 /*--------------------------------------------------------------------*/
 void cppmove2_(float *part, float *edges, int *npp, float *sbufr,
                float *sbufl, float *rbufr, float *rbufl, int *ihole,
@@ -1077,3 +2924,49 @@ void cppmove2_(float *part, float *edges, int *npp, float *sbufr,
             *idimp,*npmax,*idps,*nbmax,*ntmax,info);
    return;
 }
+
+/*--------------------------------------------------------------------*/
+void cppmove2nb_(float *part, float *edges, int *npp, float *sbuf,
+                 int *ihole, int *ny, int *kstrt, int *nvp, int *idimp,
+                 int *npmax, int *idps, int *ntmax, int *info) {
+   cppmove2nb(part,edges,npp,sbuf,ihole,*ny,*kstrt,*nvp,*idimp,*npmax,
+              *idps,*ntmax,info);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppncguard22l_(float *f, float *scs, int *nxyp, int *ndim,
+                    int *kstrt, int *nvpx, int *nvpy, int *nxv,
+                    int *nypmx, int *idds) {
+   cppncguard22l(f,scs,nxyp,*ndim,*kstrt,*nvpx,*nvpy,*nxv,*nypmx,*idds);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppnaguard22l_(float *f, float *scs, float *scr, int *nxyp,
+                    int *kstrt, int *nvpx, int *nvpy, int *nxv,
+                    int *nypmx, int *idds) {
+   cppnaguard22l(f,scs,scr,nxyp,*kstrt,*nvpx,*nvpy,*nxv,*nypmx,*idds);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppfmove22_(float *f, float *g, float *scs, float *scr, int *noff,
+                 int *nxyp, int *noffd, int *nxypd, int *ndim,
+                 int *kstrt, int *nvp, int *nxv, int *nypmx, int *nxvd,
+                 int *nypmxd, int *idds) {
+   cppfmove22(f,g,scs,scr,noff,nxyp,noffd,nxypd,*ndim,*kstrt,*nvp,*nxv,
+              *nypmx,*nxvd,*nypmxd,*idds);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppmoveg22_(float *part, float *edges, int *npp, float *sbufr,
+                 float *sbufl, float *rbufr, float *rbufl, int *ihole,
+                 int *nx, int *ny, int *kstrt, int *nvpx, int *nvpy,
+                 int *idimp, int *npmax, int *idps, int *nbmax,
+                 int *ntmax, int *info) {
+   cppmoveg22(part,edges,npp,sbufr,sbufl,rbufr,rbufl,ihole,*nx,*ny,
+              *kstrt,*nvpx,*nvpy,*idimp,*npmax,*idps,*nbmax,*ntmax,info);
+   return;
+}
@@ -19,13 +19,62 @@ c             partition.
 c PPNACGUARD2L adds guard cells in y for vector array, linear
 c              interpolation, and distributed data with non-uniform
 c              partition.
+c PPNGUARD2INIT creates persistent requests for guard cell exchanges
+c               in y of one row of data, to be reused every time step.
+c PPNCGUARD2LP copies data to guard cells in y for scalar data, using
+c              persistent requests created by PPNGUARD2INIT.
+c PPNAGUARD2LP adds guard cells in y for scalar array, using persistent
+c              requests created by PPNGUARD2INIT.
+c PPNACGUARD2LP adds guard cells in y for vector array, using
+c               persistent requests created by PPNGUARD2INIT.
+c PPNGUARD2FREE frees persistent requests created by PPNGUARD2INIT.
 c PPTPOSE performs a transpose of a complex scalar array, distributed
 c         in y, to a complex scalar array, distributed in x.
 c PPNTPOSE performs a transpose of an n component complex vector array,
 c          distributed in y, to an n component complex vector array,
 c          distributed in x.
+c PPTPOSENB performs a transpose of a complex scalar array, distributed
+c           in y, to a complex scalar array, distributed in x, using
+c           non-blocking messages to all processors at once.
+c PPNTPOSENB performs a transpose of an n component complex vector
+c            array, distributed in y, to an n component complex vector
+c            array, distributed in x, using non-blocking messages to all
+c            processors at once.
+c PPFMOVE2 moves field data in y between two different partitions,
+c          such as a non-uniform particle partition and the uniform
+c          partition used by the fft.
 c PPMOVE2 moves particles into appropriate spatial regions with periodic
 c         boundary conditions.  Assumes ihole list has been found.
+c PPMOVE2NB moves particles into appropriate spatial regions with
+c           periodic boundary conditions, sending particles directly to
+c           their destination processor with non-blocking messages.
+c           Assumes ihole list has been found.
+c PPNCGUARD22L copies data to guard cells in x and y for vector data,
+c              linear interpolation, and distributed data with 2D
+c              spatial decomposition.
+c PPNAGUARD22L adds guard cells in x and y for scalar array, linear
+c              interpolation, and distributed data with 2D spatial
+c              decomposition.
+c PPFMOVE22 moves field data between two partitions divided in x and y,
+c           such as a 2D particle partition and the uniform partition
+c           in y used by the fft.
+c PPMOVEG22 moves particles into appropriate spatial regions with
+c           periodic boundary conditions and 2D spatial decomposition.
+c           ihole list is calculated from particle co-ordinates.
+c PPWCHKPTH2 opens a shared checkpoint file for writing with MPI-IO
+c            and saves the scalars.
+c PPWCHKPTA2 writes the rows of a distributed array to a checkpoint
+c            file with a collective write.
+c PPWCHKPTP2 writes particles and an index of particles per processor
+c            to a checkpoint file with a collective write.
+c PPWCHKPTC2 completes a checkpoint file.
+c PPRCHKPTH2 opens a shared checkpoint file for reading with MPI-IO
+c            and reads the scalars.
+c PPRCHKPTA2 reads the rows of a distributed array from a checkpoint
+c            file, in any partition.
+c PPRCHKPTP2 reads particles from a checkpoint file, written by the
+c            same or a different number of processors.
+c PPRCHKPTC2 closes a checkpoint file opened for reading.
 c written by viktor k. decyk, ucla
 c copyright 1995, regents of the university of california
 c update: april 19, 2015
@@ -70,12 +119,18 @@ c lworld = MPI_COMM_WORLD communicator
 c msum = MPI_SUM
 c mmax = MPI_MAX
       common /PPARMSX/ msum, mmax
+c common block for persistent guard cell requests
+      integer maxgds, ngds, mgds
+      parameter(maxgds=8)
+c ngds = number of guard cell exchange plans created so far
+c mgds = persistent requests for each plan
+      common /PPGDS/ ngds, mgds(4,maxgds)
 c local data
       integer ierror, ndprec, idprec
       integer ibig, iprec, iresult
       logical flag
       real small, prec, vresult
-      save /PPARMS/, /PPARMSX/
+      save /PPARMS/, /PPARMSX/, /PPGDS/
       data small /1.0e-12/
       data ibig /2147483647/
       prec = 1.0 + small
@@ -133,6 +188,8 @@ c     endif
 c operators
       msum = MPI_SUM
       mmax = MPI_MAX
+c no guard cell exchange plans yet
+      ngds = 0
       nvp = nproc
       return
       end
@@ -501,6 +558,440 @@ c add up the guard cells
    40 continue
       return
       end
+c-----------------------------------------------------------------------
+      subroutine PPNGUARD2INIT(scs,scr,igds,kstrt,nvp,nxv,nypmx)
+c this subroutine creates persistent requests for guard cell exchanges
+c in y with non-uniform partitions, for data with nxv reals per row.
+c the same plan is used by PPNCGUARD2LP, PPNAGUARD2LP and PPNACGUARD2LP,
+c which avoids setting up new messages every call.
+c scs/scr = buffers for sending/receiving one row of data, which must
+c not be moved or deallocated while the plan is in use.
+c igds = plan number returned, 0 if no plan could be created
+c kstrt = starting data block number
+c nvp = number of real or virtual processors
+c nxv = number of reals in one row of data, e.g., ndim*nxv for a
+c vector array
+c nypmx = maximum size of field partition, including guard cells.
+      implicit none
+      integer igds, kstrt, nvp, nxv, nypmx
+      real scs, scr
+      dimension scs(nxv), scr(nxv)
+c get definition of MPI constants
+      include 'mpif.h'
+c common block for parallel processing
+      integer nproc, lgrp, mreal, mint, mcplx, mdouble, lworld
+c lgrp = current communicator
+c mreal = default datatype for reals
+      common /PPARMS/ nproc, lgrp, mreal, mint, mcplx, mdouble, lworld
+c common block for persistent guard cell requests
+      integer maxgds, ngds, mgds
+      parameter(maxgds=8)
+c ngds = number of guard cell exchange plans created so far
+c mgds = persistent requests for each plan
+      common /PPGDS/ ngds, mgds(4,maxgds)
+c local data
+      integer n, ks, moff, kl, kr, ierr
+      igds = 0
+      if (ngds.ge.maxgds) then
+         if (kstrt.eq.1) then
+            write (*,*) 'PPNGUARD2INIT: too many plans, maxgds=', maxgds
+         endif
+         return
+      endif
+      ngds = ngds + 1
+      n = ngds
+      igds = n
+c special case for one processor
+      if (nvp.eq.1) then
+         do 10 ks = 1, 4
+         mgds(ks,n) = MPI_REQUEST_NULL
+   10    continue
+         return
+      endif
+      ks = kstrt - 1
+      kr = ks + 1
+      if (kr.ge.nvp) kr = kr - nvp
+      kl = ks - 1
+      if (kl.lt.0) kl = kl + nvp
+c copy guard cells: receive from right, send to left
+      moff = nypmx*nvp + 2
+      call MPI_RECV_INIT(scr,nxv,mreal,kr,moff,lgrp,mgds(1,n),ierr)
+      call MPI_SEND_INIT(scs,nxv,mreal,kl,moff,lgrp,mgds(2,n),ierr)
+c add guard cells: receive from left, send to right
+      moff = nypmx*nvp + 1
+      call MPI_RECV_INIT(scr,nxv,mreal,kl,moff,lgrp,mgds(3,n),ierr)
+      call MPI_SEND_INIT(scs,nxv,mreal,kr,moff,lgrp,mgds(4,n),ierr)
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPNCGUARD2LP(f,scs,scr,igds,nyp,nvp,nxv)
+c this subroutine copies data to guard cells in non-uniform partitions
+c using persistent requests created by PPNGUARD2INIT
+c f(j,k) = real data for grid j,k in particle partition.
+c the grid is non-uniform and includes one extra guard cell.
+c output: f, scs, scr
+c scs/scr = send/receive buffers given to PPNGUARD2INIT
+c igds = plan number returned by PPNGUARD2INIT
+c nyp = number of primary gridpoints in field partition
+c it is assumed the nyp > 0.
+c nvp = number of real or virtual processors
+c nxv = first dimension of f, must be same as in PPNGUARD2INIT
+c linear interpolation, for distributed data
+      implicit none
+      integer igds, nyp, nvp, nxv
+      real f, scs, scr
+      dimension f(nxv,*), scs(nxv), scr(nxv)
+c get definition of MPI constants
+      include 'mpif.h'
+c common block for persistent guard cell requests
+      integer maxgds, ngds, mgds
+      parameter(maxgds=8)
+      common /PPGDS/ ngds, mgds(4,maxgds)
+c local data
+      integer j, ierr
+c special case for one processor
+      if (nvp.eq.1) then
+         do 10 j = 1, nxv
+         f(j,nyp+1) = f(j,1)
+   10    continue
+         return
+      endif
+c this segment is used for mpi computers
+      do 20 j = 1, nxv
+      scs(j) = f(j,1)
+   20 continue
+      call MPI_STARTALL(2,mgds(1,igds),ierr)
+      call MPI_WAITALL(2,mgds(1,igds),MPI_STATUSES_IGNORE,ierr)
+      do 30 j = 1, nxv
+      f(j,nyp+1) = scr(j)
+   30 continue
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPNAGUARD2LP(f,scs,scr,igds,nyp,nx,nvp,nxv)
+c this subroutine adds data from guard cells in non-uniform partitions
+c using persistent requests created by PPNGUARD2INIT
+c f(j,k) = real data for grid j,k in particle partition.
+c the grid is non-uniform and includes one extra guard cell.
+c output: f, scs, scr
+c scs/scr = send/receive buffers given to PPNGUARD2INIT
+c igds = plan number returned by PPNGUARD2INIT
+c nyp = number of primary gridpoints in particle partition
+c it is assumed the nyp > 0.
+c nx = system length in x direction
+c nvp = number of real or virtual processors
+c nxv = first dimension of f, must be same as in PPNGUARD2INIT
+c linear interpolation, for distributed data
+      implicit none
+      integer igds, nyp, nx, nvp, nxv
+      real f, scs, scr
+      dimension f(nxv,*), scs(nxv), scr(nxv)
+c get definition of MPI constants
+      include 'mpif.h'
+c common block for persistent guard cell requests
+      integer maxgds, ngds, mgds
+      parameter(maxgds=8)
+      common /PPGDS/ ngds, mgds(4,maxgds)
+c local data
+      integer j, nx1, ierr
+      nx1 = nx + 1
+c special case for one processor
+      if (nvp.eq.1) then
+         do 10 j = 1, nx1
+         f(j,1) = f(j,1) + f(j,nyp+1)
+         f(j,nyp+1) = 0.0
+   10    continue
+         return
+      endif
+c this segment is used for mpi computers
+      do 20 j = 1, nxv
+      scs(j) = f(j,nyp+1)
+   20 continue
+      call MPI_STARTALL(2,mgds(3,igds),ierr)
+      call MPI_WAITALL(2,mgds(3,igds),MPI_STATUSES_IGNORE,ierr)
+c add up the guard cells
+      do 30 j = 1, nx1
+      f(j,1) = f(j,1) + scr(j)
+      f(j,nyp+1) = 0.0
+   30 continue
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPNACGUARD2LP(f,scs,scr,igds,nyp,nx,ndim,nvp,nxv)
+c this subroutine adds data from guard cells in non-uniform partitions
+c using persistent requests created by PPNGUARD2INIT
+c f(ndim,j,k) = real data for grid j,k in particle partition.
+c the grid is non-uniform and includes one extra guard cell.
+c output: f, scs, scr
+c scs/scr = send/receive buffers given to PPNGUARD2INIT
+c igds = plan number returned by PPNGUARD2INIT, created with ndim*nxv
+c reals per row
+c nyp = number of primary gridpoints in particle partition
+c it is assumed the nyp > 0.
+c nx = system length in x direction
+c ndim = leading dimension of array f
+c nvp = number of real or virtual processors
+c nxv = first dimension of f, must be >= nx
+c linear interpolation, for distributed data
+      implicit none
+      integer igds, nyp, nx, ndim, nvp, nxv
+      real f, scs, scr
+      dimension f(ndim,nxv,*), scs(ndim,nxv), scr(ndim,nxv)
+c get definition of MPI constants
+      include 'mpif.h'
+c common block for persistent guard cell requests
+      integer maxgds, ngds, mgds
+      parameter(maxgds=8)
+      common /PPGDS/ ngds, mgds(4,maxgds)
+c local data
+      integer j, n, nx1, ierr
+      nx1 = nx + 1
+c special case for one processor
+      if (nvp.eq.1) then
+         do 20 j = 1, nx1
+         do 10 n = 1, ndim
+         f(n,j,1) = f(n,j,1) + f(n,j,nyp+1)
+         f(n,j,nyp+1) = 0.0
+   10    continue
+   20    continue
+         return
+      endif
+c this segment is used for mpi computers
+      do 40 j = 1, nxv
+      do 30 n = 1, ndim
+      scs(n,j) = f(n,j,nyp+1)
+   30 continue
+   40 continue
+      call MPI_STARTALL(2,mgds(3,igds),ierr)
+      call MPI_WAITALL(2,mgds(3,igds),MPI_STATUSES_IGNORE,ierr)
+c add up the guard cells
+      do 60 j = 1, nx1
+      do 50 n = 1, ndim
+      f(n,j,1) = f(n,j,1) + scr(n,j)
+      f(n,j,nyp+1) = 0.0
+   50 continue
+   60 continue
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPNGUARD2FREE(igds)
+c this subroutine frees persistent requests created by PPNGUARD2INIT
+c igds = plan number, set to 0 on output
+      implicit none
+      integer igds
+c get definition of MPI constants
+      include 'mpif.h'
+c common block for persistent guard cell requests
+      integer maxgds, ngds, mgds
+      parameter(maxgds=8)
+      common /PPGDS/ ngds, mgds(4,maxgds)
+c local data
+      integer n, ierr
+      if ((igds.lt.1).or.(igds.gt.ngds)) return
+      do 10 n = 1, 4
+      if (mgds(n,igds).ne.MPI_REQUEST_NULL) then
+         call MPI_REQUEST_FREE(mgds(n,igds),ierr)
+      endif
+   10 continue
+c release plan number if it was the last one created
+      if (igds.eq.ngds) ngds = ngds - 1
+      igds = 0
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPNCGUARD22L(f,scs,nxyp,ndim,kstrt,nvpx,nvpy,nxv,nypmx,
+     1idds)
+c this subroutine copies data to guard cells in non-uniform partitions
+c f(n,j,k) = real data for grid j,k in particle partition.
+c the grid is non-uniform and includes one extra guard cell in x and y.
+c output: f, scs
+c scs(n,k,2) = scratch array for particle partition
+c nxyp(1:2) = number of primary gridpoints in x/y in particle partition
+c it is assumed the nxyp > 0.
+c ndim = leading dimension of array f
+c kstrt = starting data block number
+c nvpx/nvpy = number of real or virtual processors in x/y
+c nxv = second dimension of f, must be >= nxpmx
+c nypmx = maximum size of particle partition in y, including guard cells
+c idds = dimensionality of domain decomposition
+c linear interpolation, for distributed data,
+c with 2D spatial decomposition
+      implicit none
+      integer ndim, kstrt, nvpx, nvpy, nxv, nypmx, idds
+      integer nxyp
+      real f, scs
+      dimension nxyp(idds)
+      dimension f(ndim,nxv,nypmx), scs(ndim,nypmx,2)
+c common block for parallel processing
+      integer nproc, lgrp, lstat, mreal, mint, mcplx, mdouble, lworld
+c lstat = length of status array
+      parameter(lstat=10)
+c lgrp = current communicator
+c mreal = default datatype for reals
+      common /PPARMS/ nproc, lgrp, mreal, mint, mcplx, mdouble, lworld
+c local data
+      integer ierr, msid, istatus
+      integer j, k, n, js, ks, moff, kr, kl
+      integer nxp1, nyp1, nnxv
+      dimension istatus(lstat)
+      nxp1 = nxyp(1) + 1
+      nyp1 = nxyp(2) + 1
+c js/ks = processor co-ordinates in x/y => idproc = js + nvpx*ks
+      ks = (kstrt - 1)/nvpx
+      js = kstrt - nvpx*ks - 1
+      moff = nypmx*nvpy
+      nnxv = ndim*nxv
+c special case for one processor in x
+      if (nvpx.eq.1) then
+         do 20 k = 1, nxyp(2)
+         do 10 n = 1, ndim
+         f(n,nxp1,k) = f(n,1,k)
+   10    continue
+   20    continue
+         go to 70
+      endif
+c buffer data in x
+      do 40 k = 1, nxyp(2)
+      do 30 n = 1, ndim
+      scs(n,k,1) = f(n,1,k)
+   30 continue
+   40 continue
+c copy to guard cells in x
+      kr = js + 1
+      if (kr.ge.nvpx) kr = kr - nvpx
+      kl = js - 1
+      if (kl.lt.0) kl = kl + nvpx
+      kr = kr + nvpx*ks
+      kl = kl + nvpx*ks
+c this segment is used for mpi computers
+      call MPI_IRECV(scs(1,1,2),ndim*nypmx,mreal,kr,moff+3,lgrp,msid,
+     1ierr)
+      call MPI_SEND(scs,ndim*nxyp(2),mreal,kl,moff+3,lgrp,ierr)
+      call MPI_WAIT(msid,istatus,ierr)
+c copy guard cells
+      do 60 k = 1, nxyp(2)
+      do 50 n = 1, ndim
+      f(n,nxp1,k) = scs(n,k,2)
+   50 continue
+   60 continue
+c special case for one processor in y
+   70 if (nvpy.eq.1) then
+         do 90 j = 1, nxv
+         do 80 n = 1, ndim
+         f(n,j,nyp1) = f(n,j,1)
+   80    continue
+   90    continue
+         return
+      endif
+c copy to guard cells in y
+      kr = ks + 1
+      if (kr.ge.nvpy) kr = kr - nvpy
+      kl = ks - 1
+      if (kl.lt.0) kl = kl + nvpy
+      kr = js + nvpx*kr
+      kl = js + nvpx*kl
+c this segment is used for mpi computers
+      call MPI_IRECV(f(1,1,nyp1),nnxv,mreal,kr,moff+4,lgrp,msid,ierr)
+      call MPI_SEND(f,nnxv,mreal,kl,moff+4,lgrp,ierr)
+      call MPI_WAIT(msid,istatus,ierr)
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPNAGUARD22L(f,scs,scr,nxyp,kstrt,nvpx,nvpy,nxv,nypmx, 
+     1idds)
+c this subroutine adds data from guard cells in non-uniform partitions
+c f(j,k) = real data for grid j,k in particle partition.
+c the grid is non-uniform and includes one extra guard cell in x and y.
+c output: f, scs, scr
+c scs(k,2) = scratch array for particle partition in x
+c scr(j) = scratch array for particle partition in y
+c nxyp(1:2) = number of primary gridpoints in x/y in particle partition
+c it is assumed the nxyp > 0.
+c kstrt = starting data block number
+c nvpx/nvpy = number of real or virtual processors in x/y
+c nxv = first dimension of f, must be >= nxpmx
+c nypmx = maximum size of particle partition in y, including guard cells
+c idds = dimensionality of domain decomposition
+c linear interpolation, for distributed data
+c with 2D spatial decomposition
+      implicit none
+      integer kstrt, nvpx, nvpy, nxv, nypmx, idds
+      integer nxyp
+      real f, scs, scr
+      dimension nxyp(idds)
+      dimension f(nxv,nypmx), scs(nypmx,2), scr(nxv)
+c common block for parallel processing
+      integer nproc, lgrp, lstat, mreal, mint, mcplx, mdouble, lworld
+c lstat = length of status array
+      parameter(lstat=10)
+c lgrp = current communicator
+c mreal = default datatype for reals
+      common /PPARMS/ nproc, lgrp, mreal, mint, mcplx, mdouble, lworld
+c local data
+      integer ierr, msid, istatus
+      integer j, k, js, ks, moff, kr, kl
+      integer nxp1, nyp1
+      dimension istatus(lstat)
+      nxp1 = nxyp(1) + 1
+      nyp1 = nxyp(2) + 1
+c js/ks = processor co-ordinates in x/y => idproc = js + nvpx*ks
+      ks = (kstrt - 1)/nvpx
+      js = kstrt - nvpx*ks - 1
+      moff = nypmx*nvpy
+c special case for one processor in x
+      if (nvpx.eq.1) then
+         do 10 k = 1, nyp1
+         f(1,k) = f(1,k) + f(nxp1,k)
+         f(nxp1,k) = 0.0
+   10    continue
+         go to 40
+      endif
+c buffer data in x
+      do 20 k = 1, nyp1
+      scs(k,1) = f(nxp1,k)
+   20 continue
+c add guard cells in x
+      kr = js + 1
+      if (kr.ge.nvpx) kr = kr - nvpx
+      kl = js - 1
+      if (kl.lt.0) kl = kl + nvpx
+      kr = kr + nvpx*ks
+      kl = kl + nvpx*ks
+c this segment is used for mpi computers
+      call MPI_IRECV(scs(1,2),nypmx,mreal,kl,moff+1,lgrp,msid,ierr)
+      call MPI_SEND(scs,nyp1,mreal,kr,moff+1,lgrp,ierr)
+      call MPI_WAIT(msid,istatus,ierr)
+c add up the guard cells
+      do 30 k = 1, nyp1
+      f(1,k) = f(1,k) + scs(k,2)
+      f(nxp1,k) = 0.0
+   30 continue
+c special case for one processor in y
+   40 if (nvpy.eq.1) then
+         do 50 j = 1, nxp1
+         f(j,1) = f(j,1) + f(j,nyp1)
+         f(j,nyp1) = 0.0
+   50    continue
+         return
+      endif
+c add guard cells in y
+      kr = ks + 1
+      if (kr.ge.nvpy) kr = kr - nvpy
+      kl = ks - 1
+      if (kl.lt.0) kl = kl + nvpy
+      kr = js + nvpx*kr
+      kl = js + nvpx*kl
+c this segment is used for mpi computers
+      call MPI_IRECV(scr,nxv,mreal,kl,moff+2,lgrp,msid,ierr)
+      call MPI_SEND(f(1,nyp1),nxv,mreal,kr,moff+2,lgrp,ierr)
+      call MPI_WAIT(msid,istatus,ierr)
+c add up the guard cells
+      do 60 j = 1, nxp1
+      f(j,1) = f(j,1) + scr(j)
+      f(j,nyp1) = 0.0
+   60 continue
+      return
+      end
 c-----------------------------------------------------------------------
       subroutine PPTPOSE(f,g,s,t,nx,ny,kxp,kyp,kstrt,nvp,nxv,nyv,kxpd,  
      1kypd)
@@ -691,53 +1182,434 @@ c insert data received
       return
       end
 c-----------------------------------------------------------------------
-      subroutine PPMOVE2(part,edges,npp,sbufr,sbufl,rbufr,rbufl,ihole,ny
-     1,kstrt,nvp,idimp,npmax,idps,nbmax,ntmax,info)
-c this subroutine moves particles into appropriate spatial regions
-c periodic boundary conditions
-c output: part, npp, sbufr, sbufl, rbufr, rbufl, info
-c part(1,n) = position x of particle n in partition
-c part(2,n) = position y of particle n in partition
-c part(3,n) = velocity vx of particle n in partition
-c part(4,n) = velocity vy of particle n in partition
-c edges(1:2) = lower:lower boundary of particle partition
-c npp = number of particles in partition
-c sbufl = buffer for particles being sent to lower processor
-c sbufr = buffer for particles being sent to upper processor
-c rbufl = buffer for particles being received from lower processor
-c rbufr = buffer for particles being received from upper processor
-c ihole = location of holes left in particle arrays
-c ny = system length in y direction
+      subroutine PPTPOSENB(f,g,s,t,nx,ny,kxp,kyp,kstrt,nvp,nxv,nyv,kxpd,
+     1kypd)
+c this subroutine performs a transpose of a matrix f, distributed in y,
+c to a matrix g, distributed in x, that is,
+c g(k+kyp*(m-1),j,l) = f(j+kxp*(l-1),k,m), where
+c 1 <= j <= kxp, 1 <= k <= kyp, 1 <= l <= nx/kxp, 1 <= m <= ny/kyp
+c and where indices l and m can be distributed across processors.
+c this subroutine posts all receives first, then sends all messages
+c asynchronously, unpacking data in the order it arrives, so that
+c packing and unpacking overlap with communication.
+c it requires nvp times the scratch memory of PPTPOSE
+c f = complex input array
+c g = complex output array
+c s, t = complex scratch arrays, of size kxp*kyp*nvp
+c nx/ny = number of points in x/y
+c kxp/kyp = number of data values per block in x/y
 c kstrt = starting data block number
 c nvp = number of real or virtual processors
-c idimp = size of phase space = 4
-c npmax = maximum number of particles in each partition.
-c idps = number of partition boundaries
-c nbmax =  size of buffers for passing particles between processors
-c ntmax =  size of hole array for particles leaving processors
-c info = status information
-c info(1) = ierr = (0,N) = (no,yes) error condition exists
-c info(2) = maximum number of particles per processor
-c info(3) = minimum number of particles per processor
-c info(4) = maximum number of buffer overflows
-c info(5) = maximum number of particle passes required
+c nxv/nyv = first dimension of f/g
+c kypd/kxpd = second dimension of f/g
       implicit none
-      integer ny, kstrt, nvp, idimp, npmax, idps, nbmax, ntmax
-      real part, edges, sbufr, sbufl, rbufr, rbufl
-      integer npp, ihole, info
-      dimension part(idimp,npmax)
-      dimension edges(idps)
-      dimension sbufl(idimp,nbmax), sbufr(idimp,nbmax)
-      dimension rbufl(idimp,nbmax), rbufr(idimp,nbmax)
-      dimension ihole(ntmax+1)
-      dimension info(5)
-c common block for parallel processing
-      integer nproc, lgrp, lstat, mreal, mint, mcplx, mdouble, lworld
-c lstat = length of status array
-      parameter(lstat=10)
-c lgrp = current communicator
-c mint = default datatype for integers
-c mreal = default datatype for reals
+      integer nx, ny, kxp, kyp, kstrt, nvp, nxv, nyv, kxpd, kypd
+      complex f, g, s, t
+      dimension f(nxv,kypd), g(nyv,kxpd)
+      dimension s(kxp*kyp,nvp), t(kxp*kyp,nvp)
+      call PPNTPOSENB(f,g,s,t,nx,ny,kxp,kyp,kstrt,nvp,1,nxv,nyv,kxpd,   
+     1kypd)
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPNTPOSENB(f,g,s,t,nx,ny,kxp,kyp,kstrt,nvp,ndim,nxv,nyv
+     1,kxpd,kypd)
+c this subroutine performs a transpose of a matrix f, distributed in y,
+c to a matrix g, distributed in x, that is,
+c g(1:ndim,k+kyp*(m-1),j,l) = f(1:ndim,j+kxp*(l-1),k,m), where
+c 1 <= j <= kxp, 1 <= k <= kyp, 1 <= l <= nx/kxp, 1 <= m <= ny/kyp
+c and where indices l and m can be distributed across processors.
+c this subroutine posts all receives first, then sends all messages
+c asynchronously, unpacking data in the order it arrives, so that
+c packing and unpacking overlap with communication.
+c the local block is copied directly.
+c it requires nvp times the scratch memory of PPNTPOSE
+c f = complex input array
+c g = complex output array
+c s, t = complex scratch arrays, of size ndim*kxp*kyp*nvp
+c nx/ny = number of points in x/y
+c kxp/kyp = number of data values per block in x/y
+c kstrt = starting data block number
+c nvp = number of real or virtual processors
+c ndim = leading dimension of arrays f and g
+c nxv/nyv = first dimension of f/g
+c kypd/kxpd = second dimension of f/g
+      implicit none
+      integer nx, ny, kxp, kyp, kstrt, nvp, ndim, nxv, nyv, kxpd, kypd
+      complex f, g, s, t
+      dimension f(ndim,nxv,kypd), g(ndim,nyv,kxpd)
+      dimension s(ndim,kxp*kyp,nvp), t(ndim,kxp*kyp,nvp)
+      include 'mpif.h'
+c common block for parallel processing
+      integer nproc, lgrp, mreal, mint, mcplx, mdouble, lworld
+c lgrp = current communicator
+c mcplx = default datatype for complex
+      common /PPARMS/ nproc, lgrp, mreal, mint, mcplx, mdouble, lworld
+c local data
+      integer i, n, j, k, ks, kxps, kyps, kxyp, id, joff, koff, ld
+      integer ierr, msid, mrid, istatus
+      logical flag
+      dimension msid(nvp), mrid(nvp), istatus(MPI_STATUS_SIZE)
+      ks = kstrt - 1
+      kxps = min(kxp,max(0,nx-kxp*ks))
+      kyps = min(kyp,max(0,ny-kyp*ks))
+      kxyp = ndim*kxp*kyp
+c special case for one processor
+      if (nvp.eq.1) then
+         do 30 k = 1, kyp
+         do 20 j = 1, kxp
+         do 10 i = 1, ndim
+         g(i,k,j) = f(i,j,k)
+   10    continue
+   20    continue
+   30    continue
+         return
+      endif
+c post all receives, data from processor id is stored in block id+1
+      do 40 n = 1, nvp
+      id = n - ks - 1
+      if (id.lt.0) id = id + nvp
+      if (id.ne.ks) then
+         call MPI_IRECV(t(1,1,id+1),kxyp,mcplx,id,n,lgrp,mrid(id+1),ierr
+     1)
+      endif
+   40 continue
+      mrid(ks+1) = MPI_REQUEST_NULL
+      msid(ks+1) = MPI_REQUEST_NULL
+c extract and send data, data to processor id is stored in block id+1
+      do 90 n = 1, nvp
+      id = n - ks - 1
+      if (id.lt.0) id = id + nvp
+      if (id.eq.ks) go to 90
+      joff = kxp*id
+      ld = min(kxp,max(0,nx-joff))
+      do 70 k = 1, kyps
+      do 60 j = 1, ld
+      do 50 i = 1, ndim
+      s(i,j+ld*(k-1),id+1) = f(i,j+joff,k)
+   50 continue
+   60 continue
+   70 continue
+      ld = ndim*ld*kyps
+      call MPI_ISEND(s(1,1,id+1),ld,mcplx,id,n,lgrp,msid(id+1),ierr)
+c insert any data which has already arrived
+      flag = .true.
+   80 if (flag) then
+         call MPI_TESTANY(nvp,mrid,id,flag,istatus,ierr)
+         if (id.eq.MPI_UNDEFINED) flag = .false.
+         if (flag) then
+            call PPNTUNPACK(g,t(1,1,id),id-1,ny,kxp,kxps,kyp,ndim,nyv,
+     1kxpd)
+         endif
+         go to 80
+      endif
+   90 continue
+c copy local block while messages are in flight
+      joff = kxp*ks
+      koff = kyp*ks
+      do 120 k = 1, kyps
+      do 110 j = 1, kxps
+      do 100 i = 1, ndim
+      g(i,k+koff,j) = f(i,j+joff,k)
+  100 continue
+  110 continue
+  120 continue
+c insert remaining data as it arrives
+      do 130 n = 2, nvp
+      call MPI_WAITANY(nvp,mrid,id,istatus,ierr)
+      if (id.eq.MPI_UNDEFINED) go to 140
+      call PPNTUNPACK(g,t(1,1,id),id-1,ny,kxp,kxps,kyp,ndim,nyv,kxpd)
+  130 continue
+c wait for sends to complete
+  140 call MPI_WAITALL(nvp,msid,MPI_STATUSES_IGNORE,ierr)
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPNTUNPACK(g,t,id,ny,kxp,kxps,kyp,ndim,nyv,kxpd)
+c this subroutine inserts a block of transposed data t, received from
+c processor id, into g.  used by PPNTPOSENB
+      implicit none
+      integer id, ny, kxp, kxps, kyp, ndim, nyv, kxpd
+      complex g, t
+      dimension g(ndim,nyv,kxpd), t(ndim,kxp*kyp)
+c local data
+      integer i, j, k, koff, ld
+      koff = kyp*id
+      ld = min(kyp,max(0,ny-koff))
+      do 30 k = 1, ld
+      do 20 j = 1, kxps
+      do 10 i = 1, ndim
+      g(i,k+koff,j) = t(i,j+kxps*(k-1))
+   10 continue
+   20 continue
+   30 continue
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPFMOVE2(f,g,noff,nyp,noffd,nypd,kstrt,nvp,nxv,nypmx,
+     1nypmxd)
+c this subroutine moves field data from one partition to another,
+c for example from a non-uniform particle partition to the uniform
+c partition used by the fft, or back.
+c each processor sends the rows it owns to every processor whose new
+c partition overlaps them, posting all messages at once.
+c rows are contiguous, so no packing is needed.  guard cells are not
+c moved.
+c f(j,k) = real data for grid j,k in input partition
+c g(j,k) = real data for grid j,k in output partition
+c output: g
+c noff/nyp = lowermost global gridpoint/number of primary gridpoints
+c in input partition
+c noffd/nypd = lowermost global gridpoint/number of primary gridpoints
+c in output partition
+c kstrt = starting data block number
+c nvp = number of real or virtual processors
+c nxv = first dimension of f and g
+c nypmx/nypmxd = second dimension of f/g
+      implicit none
+      integer noff, nyp, noffd, nypd, kstrt, nvp, nxv, nypmx, nypmxd
+      real f, g
+      dimension f(nxv,nypmx), g(nxv,nypmxd)
+      include 'mpif.h'
+c common block for parallel processing
+      integer nproc, lgrp, mreal, mint, mcplx, mdouble, lworld
+c lgrp = current communicator
+c mreal = default datatype for reals
+c mint = default datatype for integers
+      common /PPARMS/ nproc, lgrp, mreal, mint, mcplx, mdouble, lworld
+c local data
+      integer j, k, n, ks, kl, kr, moff, ierr
+      integer mpart, mparts, msid, mrid
+      dimension mpart(4), mparts(4,nvp), msid(nvp), mrid(nvp)
+c special case for one processor
+      if (nvp.eq.1) then
+         do 20 k = 1, nypd
+         do 10 j = 1, nxv
+         g(j,k) = f(j,k)
+   10    continue
+   20    continue
+         return
+      endif
+      ks = kstrt - 1
+      moff = nypmx*nvp + 3
+c find input and output partitions of all processors
+      mpart(1) = noff
+      mpart(2) = nyp
+      mpart(3) = noffd
+      mpart(4) = nypd
+      call MPI_ALLGATHER(mpart,4,mint,mparts,4,mint,lgrp,ierr)
+c post receives for rows of output partition held by other processors
+      do 30 n = 1, nvp
+      mrid(n) = MPI_REQUEST_NULL
+      kl = max(noffd,mparts(1,n))
+      kr = min(noffd+nypd,mparts(1,n)+mparts(2,n))
+      if ((kr.gt.kl).and.(n.ne.(ks+1))) then
+         call MPI_IRECV(g(1,kl-noffd+1),nxv*(kr-kl),mreal,n-1,moff,lgrp,
+     1mrid(n),ierr)
+      endif
+   30 continue
+c send rows of input partition needed by other processors
+      do 60 n = 1, nvp
+      msid(n) = MPI_REQUEST_NULL
+      kl = max(noff,mparts(3,n))
+      kr = min(noff+nyp,mparts(3,n)+mparts(4,n))
+      if (kr.gt.kl) then
+         if (n.ne.(ks+1)) then
+            call MPI_ISEND(f(1,kl-noff+1),nxv*(kr-kl),mreal,n-1,moff,
+     1lgrp,msid(n),ierr)
+c copy local rows directly
+         else
+            do 50 k = kl+1, kr
+            do 40 j = 1, nxv
+            g(j,k-noffd) = f(j,k-noff)
+   40       continue
+   50       continue
+         endif
+      endif
+   60 continue
+c wait for messages to complete
+      call MPI_WAITALL(nvp,mrid,MPI_STATUSES_IGNORE,ierr)
+      call MPI_WAITALL(nvp,msid,MPI_STATUSES_IGNORE,ierr)
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPFMOVE22(f,g,scs,scr,noff,nxyp,noffd,nxypd,ndim,kstrt,
+     1nvp,nxv,nypmx,nxvd,nypmxd,idds)
+c this subroutine moves field data from one partition to another,
+c where both partitions may be divided in x and y, for example from
+c the 2D particle partition to the uniform partition in y used by the
+c fft, or back.
+c each processor packs the rectangle it shares with every other
+c processor's new partition and sends it, posting all messages at once.
+c guard cells are not moved.
+c f(n,j,k) = real data for grid j,k in input partition
+c g(n,j,k) = real data for grid j,k in output partition
+c output: g, scs, scr
+c scs/scr = scratch arrays for data sent/received, of size at least
+c ndim*nxyp(1)*nxyp(2) and ndim*nxypd(1)*nxypd(2), respectively
+c noff(1:2)/nxyp(1:2) = leftmost and lowermost global gridpoint/number
+c of primary gridpoints in x and y in input partition
+c noffd(1:2)/nxypd(1:2) = leftmost and lowermost global gridpoint/
+c number of primary gridpoints in x and y in output partition
+c processors which do not hold any data in a partition should set
+c nxyp or nxypd to zero
+c ndim = leading dimension of arrays f and g
+c kstrt = starting data block number
+c nvp = number of real or virtual processors
+c nxv/nypmx = second/third dimension of f
+c nxvd/nypmxd = second/third dimension of g
+c idds = dimensionality of domain decomposition = 2
+      implicit none
+      integer ndim, kstrt, nvp, nxv, nypmx, nxvd, nypmxd, idds
+      integer noff, nxyp, noffd, nxypd
+      real f, g, scs, scr
+      dimension f(ndim,nxv,nypmx), g(ndim,nxvd,nypmxd)
+      dimension scs(*), scr(*)
+      dimension noff(idds), nxyp(idds), noffd(idds), nxypd(idds)
+      include 'mpif.h'
+c common block for parallel processing
+      integer nproc, lgrp, mreal, mint, mcplx, mdouble, lworld
+c lgrp = current communicator
+c mreal = default datatype for reals
+c mint = default datatype for integers
+      common /PPARMS/ nproc, lgrp, mreal, mint, mcplx, mdouble, lworld
+c local data
+      integer i, j, k, n, ks, moff, ierr
+      integer jl, jr, kl, kr, joff, ioff
+      integer mpart, mparts, msid, mrid
+      dimension mpart(8), mparts(8,nvp), msid(nvp), mrid(nvp)
+      ks = kstrt - 1
+      moff = nypmx*nvp + 3
+c find input and output partitions of all processors
+      mpart(1) = noff(1)
+      mpart(2) = noff(2)
+      mpart(3) = nxyp(1)
+      mpart(4) = nxyp(2)
+      mpart(5) = noffd(1)
+      mpart(6) = noffd(2)
+      mpart(7) = nxypd(1)
+      mpart(8) = nxypd(2)
+      call MPI_ALLGATHER(mpart,8,mint,mparts,8,mint,lgrp,ierr)
+c post receives for data in output partition held by other processors
+      ioff = 0
+      do 10 n = 1, nvp
+      mrid(n) = MPI_REQUEST_NULL
+      jl = max(noffd(1),mparts(1,n))
+      jr = min(noffd(1)+nxypd(1),mparts(1,n)+mparts(3,n))
+      kl = max(noffd(2),mparts(2,n))
+      kr = min(noffd(2)+nxypd(2),mparts(2,n)+mparts(4,n))
+      if ((jr.gt.jl).and.(kr.gt.kl).and.(n.ne.(ks+1))) then
+         call MPI_IRECV(scr(ioff+1),ndim*(jr-jl)*(kr-kl),mreal,n-1,moff,
+     1lgrp,mrid(n),ierr)
+         ioff = ioff + ndim*(jr - jl)*(kr - kl)
+      endif
+   10 continue
+c pack and send data in input partition needed by other processors
+      joff = 0
+      do 80 n = 1, nvp
+      msid(n) = MPI_REQUEST_NULL
+      jl = max(noff(1),mparts(5,n))
+      jr = min(noff(1)+nxyp(1),mparts(5,n)+mparts(7,n))
+      kl = max(noff(2),mparts(6,n))
+      kr = min(noff(2)+nxyp(2),mparts(6,n)+mparts(8,n))
+      if ((jr.gt.jl).and.(kr.gt.kl)) then
+         if (n.ne.(ks+1)) then
+            ioff = joff
+            do 40 k = kl+1, kr
+            do 30 j = jl+1, jr
+            do 20 i = 1, ndim
+            scs(ioff+i) = f(i,j-noff(1),k-noff(2))
+   20       continue
+            ioff = ioff + ndim
+   30       continue
+   40       continue
+            call MPI_ISEND(scs(joff+1),ioff-joff,mreal,n-1,moff,lgrp,
+     1msid(n),ierr)
+            joff = ioff
+c copy local data directly
+         else
+            do 70 k = kl+1, kr
+            do 60 j = jl+1, jr
+            do 50 i = 1, ndim
+            g(i,j-noffd(1),k-noffd(2)) = f(i,j-noff(1),k-noff(2))
+   50       continue
+   60       continue
+   70       continue
+         endif
+      endif
+   80 continue
+c wait for data to arrive
+      call MPI_WAITALL(nvp,mrid,MPI_STATUSES_IGNORE,ierr)
+c unpack received data
+      ioff = 0
+      do 120 n = 1, nvp
+      jl = max(noffd(1),mparts(1,n))
+      jr = min(noffd(1)+nxypd(1),mparts(1,n)+mparts(3,n))
+      kl = max(noffd(2),mparts(2,n))
+      kr = min(noffd(2)+nxypd(2),mparts(2,n)+mparts(4,n))
+      if ((jr.gt.jl).and.(kr.gt.kl).and.(n.ne.(ks+1))) then
+         do 110 k = kl+1, kr
+         do 100 j = jl+1, jr
+         do 90 i = 1, ndim
+         g(i,j-noffd(1),k-noffd(2)) = scr(ioff+i)
+   90    continue
+         ioff = ioff + ndim
+  100    continue
+  110    continue
+      endif
+  120 continue
+c make sure sent data can be reused
+      call MPI_WAITALL(nvp,msid,MPI_STATUSES_IGNORE,ierr)
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPMOVE2(part,edges,npp,sbufr,sbufl,rbufr,rbufl,ihole,ny
+     1,kstrt,nvp,idimp,npmax,idps,nbmax,ntmax,info)
+c this subroutine moves particles into appropriate spatial regions
+c periodic boundary conditions
+c output: part, npp, sbufr, sbufl, rbufr, rbufl, info
+c part(1,n) = position x of particle n in partition
+c part(2,n) = position y of particle n in partition
+c part(3,n) = velocity vx of particle n in partition
+c part(4,n) = velocity vy of particle n in partition
+c edges(1:2) = lower:lower boundary of particle partition
+c npp = number of particles in partition
+c sbufl = buffer for particles being sent to lower processor
+c sbufr = buffer for particles being sent to upper processor
+c rbufl = buffer for particles being received from lower processor
+c rbufr = buffer for particles being received from upper processor
+c ihole = location of holes left in particle arrays
+c ny = system length in y direction
+c kstrt = starting data block number
+c nvp = number of real or virtual processors
+c idimp = size of phase space = 4
+c npmax = maximum number of particles in each partition.
+c idps = number of partition boundaries
+c nbmax =  size of buffers for passing particles between processors
+c ntmax =  size of hole array for particles leaving processors
+c info = status information
+c info(1) = ierr = (0,N) = (no,yes) error condition exists
+c info(2) = maximum number of particles per processor
+c info(3) = minimum number of particles per processor
+c info(4) = maximum number of buffer overflows
+c info(5) = maximum number of particle passes required
+      implicit none
+      integer ny, kstrt, nvp, idimp, npmax, idps, nbmax, ntmax
+      real part, edges, sbufr, sbufl, rbufr, rbufl
+      integer npp, ihole, info
+      dimension part(idimp,npmax)
+      dimension edges(idps)
+      dimension sbufl(idimp,nbmax), sbufr(idimp,nbmax)
+      dimension rbufl(idimp,nbmax), rbufr(idimp,nbmax)
+      dimension ihole(ntmax+1)
+      dimension info(5)
+c common block for parallel processing
+      integer nproc, lgrp, lstat, mreal, mint, mcplx, mdouble, lworld
+c lstat = length of status array
+      parameter(lstat=10)
+c lgrp = current communicator
+c mint = default datatype for integers
+c mreal = default datatype for reals
       common /PPARMS/ nproc, lgrp, mreal, mint, mcplx, mdouble, lworld
 c local data
 c iy = partitioned co-ordinate
@@ -755,12 +1627,568 @@ c iy = partitioned co-ordinate
       nbsize = idimp*nbmax
       iter = 2
       nter = 0
-      info(1) = 0
-      info(5) = 0
-      ih = ihole(1)
+      info(1) = 0
+      info(5) = 0
+      ih = ihole(1)
+      joff = 1
+      jin = 1
+      itermax = 2000
+c ih = number of particles extracted from holes
+c joff = next hole location for extraction
+c jss(1) = number of holes available to be filled
+c jin = next hole location to be filled
+c start loop
+   10 mter = 0
+      nps = 0
+c buffer outgoing particles
+      jsl(1) = 0
+      jsr(1) = 0
+c load particle buffers
+      do 40 j = 1, ih
+      j1 = ihole(j+joff)
+      yt = part(iy,j1)
+c particles going down
+      if (yt.lt.edges(1)) then
+         if (ks.eq.0) yt = yt + any
+         if (jsl(1).lt.nbmax) then
+            jsl(1) = jsl(1) + 1
+            do 20 i = 1, idimp
+            sbufl(i,jsl(1)) = part(i,j1)
+   20       continue
+            sbufl(iy,jsl(1)) = yt
+         else
+            nps = 1
+            go to 50
+         endif
+c particles going up
+      else
+         if (ks.eq.(nvp-1)) yt = yt - any
+         if (jsr(1).lt.nbmax) then
+            jsr(1) = jsr(1) + 1
+            do 30 i = 1, idimp
+            sbufr(i,jsr(1)) = part(i,j1)
+   30       continue
+            sbufr(iy,jsr(1)) = yt
+         else
+            nps = 1
+            go to 50
+         endif
+      endif
+   40 continue
+   50 jss(1) = jsl(1) + jsr(1)
+      joff = joff + jss(1)
+      ih = ih - jss(1)
+c check for full buffer condition
+      ibflg(3) = nps
+c copy particle buffers
+   60 iter = iter + 2
+      mter = mter + 1
+c special case for one processor
+      if (nvp.eq.1) then
+         jsl(2) = jsr(1)
+         do 64 j = 1, jsl(2)
+         do 62 i = 1, idimp
+         rbufl(i,j) = sbufr(i,j)
+   62    continue
+   64    continue
+         jsr(2) = jsl(1)
+         do 68 j = 1, jsr(2)
+         do 66 i = 1, idimp
+         rbufr(i,j) = sbufl(i,j)
+   66    continue
+   68    continue
+c this segment is used for mpi computers
+      else
+c get particles from below and above
+         kr = ks + 1
+         if (kr.ge.nvp) kr = kr - nvp
+         kl = ks - 1
+         if (kl.lt.0) kl = kl + nvp
+c post receive
+         itg = iter - 1
+         call MPI_IRECV(rbufl,nbsize,mreal,kl,itg,lgrp,msid(1),ierr)
+         call MPI_IRECV(rbufr,nbsize,mreal,kr,iter,lgrp,msid(2),ierr)
+c send particles
+         jsr(1) = idimp*jsr(1)
+         call MPI_ISEND(sbufr,jsr(1),mreal,kr,itg,lgrp,msid(3),ierr)
+         jsl(1) = idimp*jsl(1)
+         call MPI_ISEND(sbufl,jsl(1),mreal,kl,iter,lgrp,msid(4),ierr)
+c wait for particles to arrive
+         call MPI_WAIT(msid(1),istatus,ierr)
+         call MPI_GET_COUNT(istatus,mreal,nps,ierr)
+         jsl(2) = nps/idimp
+         call MPI_WAIT(msid(2),istatus,ierr)
+         call MPI_GET_COUNT(istatus,mreal,nps,ierr)
+         jsr(2) = nps/idimp
+      endif
+c check if particles must be passed further
+c check if any particles coming from above belong here
+      jsl(1) = 0
+      jsr(1) = 0
+      jss(2) = 0
+      do 70 j = 1, jsr(2)
+      if (rbufr(iy,j).lt.edges(1)) jsl(1) = jsl(1) + 1
+      if (rbufr(iy,j).ge.edges(2)) jsr(1) = jsr(1) + 1
+   70 continue
+c     if (jsr(1).ne.0) write (2,*) ks+1, 'Info: particles returning up'
+c check if any particles coming from below belong here
+      do 80 j = 1, jsl(2)
+      if (rbufl(iy,j).ge.edges(2)) jsr(1) = jsr(1) + 1
+      if (rbufl(iy,j).lt.edges(1)) jss(2) = jss(2) + 1
+   80 continue
+c     if (jss(2).ne.0) write (2,*) ks+1,'Info: particles returning down'
+      nps = jsl(1) + jsr(1) + jss(2)
+      ibflg(2) = nps
+c make sure sbufr and sbufl have been sent
+      if (nvp.ne.1) then
+         call MPI_WAIT(msid(3),istatus,ierr)
+         call MPI_WAIT(msid(4),istatus,ierr)
+      endif
+      if (nps.eq.0) go to 180
+c remove particles which do not belong here
+c first check particles coming from above
+      jsl(1) = 0
+      jsr(1) = 0
+      jss(2) = 0
+      do 120 j = 1, jsr(2)
+      yt = rbufr(iy,j)
+c particles going down
+      if (yt.lt.edges(1)) then
+         jsl(1) = jsl(1) + 1
+         if (ks.eq.0) yt = yt + any
+         rbufr(iy,j) = yt
+         do 90 i = 1, idimp
+         sbufl(i,jsl(1)) = rbufr(i,j)
+   90    continue
+c particles going up, should not happen
+      else if (yt.ge.edges(2)) then
+         jsr(1) = jsr(1) + 1
+         if (ks.eq.(nvp-1)) yt = yt - any
+         rbufr(iy,j) = yt
+         do 100 i = 1, idimp
+         sbufr(i,jsr(1)) = rbufr(i,j)
+  100    continue
+c particles staying here
+      else
+         jss(2) = jss(2) + 1
+         do 110 i = 1, idimp
+         rbufr(i,jss(2)) = rbufr(i,j)
+  110    continue
+      endif
+  120 continue
+      jsr(2) = jss(2)
+c next check particles coming from below
+      jss(2) = 0
+      do 160 j = 1, jsl(2)
+      yt = rbufl(iy,j)
+c particles going up
+      if (yt.ge.edges(2)) then
+         if (jsr(1).lt.nbmax) then
+            jsr(1) = jsr(1) + 1
+            if (ks.eq.(nvp-1)) yt = yt - any
+            rbufl(iy,j) = yt
+            do 130 i = 1, idimp
+            sbufr(i,jsr(1)) = rbufl(i,j)
+  130       continue
+         else
+            jss(2) = 2*npmax
+            go to 170
+         endif
+c particles going down, should not happen
+      else if (yt.lt.edges(1)) then
+         if (jsl(1).lt.nbmax) then
+            jsl(1) = jsl(1) + 1
+            if (ks.eq.0) yt = yt + any
+            rbufl(iy,j) = yt
+            do 140 i = 1, idimp
+            sbufl(i,jsl(1)) = rbufl(i,j)
+  140       continue
+         else
+            jss(2) = 2*npmax
+            go to 170
+         endif
+c particles staying here
+      else
+         jss(2) = jss(2) + 1
+         do 150 i = 1, idimp
+         rbufl(i,jss(2)) = rbufl(i,j)
+  150    continue
+      endif
+  160 continue
+  170 jsl(2) = jss(2)
+c check if move would overflow particle array
+  180 nps = npp + jsl(2) + jsr(2) - jss(1)
+      ibflg(1) = nps
+      ibflg(4) = -min0(npmax,nps)
+      call PPIMAX(ibflg,iwork,4)
+      info(2) = ibflg(1)
+      info(3) = -ibflg(4)
+      ierr = ibflg(1) - npmax
+      if (ierr.gt.0) then
+         write (2,*) 'particle overflow error, ierr = ', ierr
+         info(1) = ierr
+         return
+      endif
+c distribute incoming particles from buffers
+c distribute particles coming from below into holes
+      jss(2) = min0(jss(1),jsl(2))
+      do 200 j = 1, jss(2)
+      j1 = ihole(j+jin)
+      do 190 i = 1, idimp
+      part(i,j1) = rbufl(i,j)
+  190 continue
+  200 continue
+      jin = jin + jss(2)
+      if (jss(1).gt.jsl(2)) then
+         jss(2) = min0(jss(1)-jsl(2),jsr(2))
+      else
+         jss(2) = jsl(2) - jss(1)
+      endif
+      do 230 j = 1, jss(2)
+c no more particles coming from below
+c distribute particles coming from above into holes
+      if (jss(1).gt.jsl(2)) then
+         j1 = ihole(j+jin)
+         do 210 i = 1, idimp
+         part(i,j1) = rbufr(i,j)
+  210    continue
+c no more holes
+c distribute remaining particles from below into bottom
+      else
+         do 220 i = 1, idimp
+         part(i,j+npp) = rbufl(i,j+jss(1))
+  220    continue
+      endif
+  230 continue
+      if (jss(1).gt.jsl(2)) jin = jin + jss(2)
+      nps = jsl(2) + jsr(2)
+      if (jss(1).le.jsl(2)) then
+         npp = npp + (jsl(2) - jss(1))
+         jss(1) = jsl(2)
+      endif
+c no more holes
+c distribute remaining particles from above into bottom
+      jsr(2) = max0(0,nps-jss(1))
+      jss(1) = jss(1) - jsl(2)
+      do 250 j = 1, jsr(2)
+      do 240 i = 1, idimp
+      part(i,j+npp) = rbufr(i,j+jss(1))
+  240 continue
+  250 continue
+      npp = npp + jsr(2)
+c holes left over
+c fill up remaining holes in particle array with particles from bottom
+      if (ih.eq.0) then
+         jsr(2) = max0(0,ihole(1)-jin+1)
+         do 270 j = 1, jsr(2)
+         j1 = npp - j + 1
+         j2 = ihole(jsr(2)-j+jin+1)
+         if (j1.gt.j2) then
+c move particle only if it is below current hole
+            do 260 i = 1, idimp
+            part(i,j2) = part(i,j1)
+  260       continue
+         endif
+  270    continue
+         jin = jin + jsr(2)
+         npp = npp - jsr(2)
+      endif
+      jss(1) = 0
+c check if any particles have to be passed further
+      if (ibflg(3).gt.0) ibflg(3) = 1
+      info(5) = max0(info(5),mter)
+      if (ibflg(2).gt.0) then
+c        write (2,*) 'Info: particles being passed further = ', ibflg(2)
+         if (iter.lt.itermax) go to 60
+         ierr = -((iter-2)/2)
+         write (2,*) 'Iteration overflow, iter = ', ierr
+         info(1) = ierr
+         return
+      endif
+c check if buffer overflowed and more particles remain to be checked
+      if (ibflg(3).gt.0) then
+         nter = nter + 1
+         info(4) = nter
+         go to 10
+      endif
+      if (nter.gt.0) then
+         write (2,*) 'Info: ', nter, ' buffer overflows, nbmax=', nbmax
+      endif
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPMOVE2NB(part,edges,npp,sbuf,ihole,ny,kstrt,nvp,idimp,
+     1npmax,idps,ntmax,info)
+c this subroutine moves particles into appropriate spatial regions
+c periodic boundary conditions
+c particles leaving the partition are sorted by destination processor
+c in one pass, then delivered directly to that processor with one
+c message, however many partitions they cross.  the number of particles
+c each processor will receive is exchanged first, then the particles
+c themselves, posting all messages at once.  if the particle array
+c would overflow, the error is returned before any particles are
+c moved, so part and npp are unchanged.
+c output: part, npp, sbuf, info
+c part(1,n) = position x of particle n in partition
+c part(2,n) = position y of particle n in partition
+c part(3,n) = velocity vx of particle n in partition
+c part(4,n) = velocity vy of particle n in partition
+c edges(1:2) = lower:upper boundary of particle partition
+c npp = number of particles in partition
+c sbuf = buffer for particles being sent
+c ihole = location of holes left in particle arrays
+c ny = system length in y direction
+c kstrt = starting data block number
+c nvp = number of real or virtual processors
+c idimp = size of phase space = 4
+c npmax = maximum number of particles in each partition.
+c idps = number of partition boundaries
+c ntmax =  size of hole array for particles leaving processors
+c info = status information
+c info(1) = ierr = (0,N) = (no,yes) error condition exists
+c info(2) = maximum number of particles per processor
+c info(3) = minimum number of particles per processor
+c info(4) = maximum number of buffer overflows = 0
+c info(5) = maximum number of particle passes required = 1
+      implicit none
+      integer ny, kstrt, nvp, idimp, npmax, idps, ntmax
+      real part, edges, sbuf
+      integer npp, ihole, info
+      dimension part(idimp,npmax)
+      dimension edges(idps)
+      dimension sbuf(idimp,ntmax)
+      dimension ihole(ntmax+1)
+      dimension info(5)
+      include 'mpif.h'
+c common block for parallel processing
+      integer nproc, lgrp, mreal, mint, mcplx, mdouble, lworld
+c lgrp = current communicator
+c mint = default datatype for integers
+c mreal = default datatype for reals
+      common /PPARMS/ nproc, lgrp, mreal, mint, mcplx, mdouble, lworld
+c local data
+c iy = partitioned co-ordinate
+      integer iy
+      parameter(iy=2)
+      integer ierr, ks, ih, nps, nin, j, j1, j2, i, n, nl, nr, moff
+      integer scnt, sdsp, rcnt, rdsp, ibflg, iwork, msid, mrid
+      real any, yt, eds
+      dimension eds(nvp)
+      dimension scnt(nvp), sdsp(nvp), rcnt(nvp), rdsp(nvp)
+      dimension ibflg(2), iwork(2), msid(nvp), mrid(nvp)
+      any = real(ny)
+      ks = kstrt - 1
+      moff = 2
+      info(1) = 0
+      info(4) = 0
+      info(5) = 1
+      ih = ihole(1)
+c find lower boundaries of all partitions
+      call MPI_ALLGATHER(edges,1,mreal,eds,1,mreal,lgrp,ierr)
+c count particles going to each processor
+      do 10 n = 1, nvp
+      scnt(n) = 0
+   10 continue
+      do 30 j = 1, ih
+      j1 = ihole(j+1)
+      yt = part(iy,j1)
+      if (yt.lt.0.0) yt = yt + any
+      if (yt.ge.any) yt = yt - any
+c find last partition whose lower boundary is not above particle
+      nl = 1
+      nr = nvp
+   20 if (nl.lt.nr) then
+         n = (nl + nr + 1)/2
+         if (yt.ge.eds(n)) then
+            nl = n
+         else
+            nr = n - 1
+         endif
+         go to 20
+      endif
+      scnt(nl) = scnt(nl) + 1
+   30 continue
+      nps = 0
+      do 40 n = 1, nvp
+      sdsp(n) = nps
+      nps = nps + scnt(n)
+   40 continue
+c exchange number of particles going to each processor
+      call MPI_ALLTOALL(scnt,1,mint,rcnt,1,mint,lgrp,ierr)
+      nin = 0
+      do 110 n = 1, nvp
+      rdsp(n) = npp - ih + nin
+      nin = nin + rcnt(n)
+  110 continue
+c check if move would overflow particle array
+      nps = npp - ih + nin
+      ibflg(1) = nps
+      ibflg(2) = -min0(npmax,nps)
+      call PPIMAX(ibflg,iwork,2)
+      info(2) = ibflg(1)
+      info(3) = -ibflg(2)
+      ierr = ibflg(1) - npmax
+      if (ierr.gt.0) then
+         write (2,*) 'particle overflow error, ierr = ', ierr
+         info(1) = ierr
+         return
+      endif
+c copy outgoing particles into buffer, sorted by destination
+      do 70 j = 1, ih
+      j1 = ihole(j+1)
+      yt = part(iy,j1)
+      if (yt.lt.0.0) yt = yt + any
+      if (yt.ge.any) yt = yt - any
+      nl = 1
+      nr = nvp
+   50 if (nl.lt.nr) then
+         n = (nl + nr + 1)/2
+         if (yt.ge.eds(n)) then
+            nl = n
+         else
+            nr = n - 1
+         endif
+         go to 50
+      endif
+      sdsp(nl) = sdsp(nl) + 1
+      j2 = sdsp(nl)
+      do 60 i = 1, idimp
+      sbuf(i,j2) = part(i,j1)
+   60 continue
+      sbuf(iy,j2) = yt
+   70 continue
+      do 80 n = 1, nvp
+      sdsp(n) = sdsp(n) - scnt(n)
+   80 continue
+c fill up holes in particle array with particles from bottom
+      do 100 j = 1, ih
+      j1 = npp - j + 1
+      j2 = ihole(ih-j+2)
+      if (j1.gt.j2) then
+c move particle only if it is below current hole
+         do 90 i = 1, idimp
+         part(i,j2) = part(i,j1)
+   90    continue
+      endif
+  100 continue
+      npp = npp - ih
+c post receives directly into the bottom of the particle array
+      do 120 n = 1, nvp
+      mrid(n) = MPI_REQUEST_NULL
+      if ((rcnt(n).gt.0).and.(n.ne.(ks+1))) then
+         call MPI_IRECV(part(1,rdsp(n)+1),idimp*rcnt(n),mreal,n-1,moff,
+     1lgrp,mrid(n),ierr)
+      endif
+  120 continue
+c send particles, copy particles staying here directly
+      do 150 n = 1, nvp
+      msid(n) = MPI_REQUEST_NULL
+      if (scnt(n).gt.0) then
+         if (n.ne.(ks+1)) then
+            call MPI_ISEND(sbuf(1,sdsp(n)+1),idimp*scnt(n),mreal,n-1,
+     1moff,lgrp,msid(n),ierr)
+         else
+            do 140 j = 1, scnt(n)
+            do 130 i = 1, idimp
+            part(i,j+rdsp(n)) = sbuf(i,j+sdsp(n))
+  130       continue
+  140       continue
+         endif
+      endif
+  150 continue
+c wait for messages to complete
+      call MPI_WAITALL(nvp,mrid,MPI_STATUSES_IGNORE,ierr)
+      call MPI_WAITALL(nvp,msid,MPI_STATUSES_IGNORE,ierr)
+      npp = npp + nin
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPMOVEG22(part,edges,npp,sbufr,sbufl,rbufr,rbufl,ihole,
+     1nx,ny,kstrt,nvpx,nvpy,idimp,npmax,idps,nbmax,ntmax,info)
+c this subroutine moves particles into appropriate spatial regions
+c ihole array is calculated from particles co-ordinates
+c with periodic boundary conditions and 2D spatial decomposition
+c output: part, ihole, npp, sbufr, sbufl, rbufr, rbufl, info
+c part(1,n) = position x of particle n in partition
+c part(2,n) = position y of particle n in partition
+c part(3,n) = velocity vx of particle n in partition
+c part(4,n) = velocity vy of particle n in partition
+c edges(1:2) = left/right boundary in x of particle partition
+c edges(3:4) = lower/upper boundary in y of particle partition
+c npp = number of particles in partition
+c sbufl = buffer for particles being sent to left or lower processor
+c sbufr = buffer for particles being sent to right or upper processor
+c rbufl = buffer for particles being received from left or lower
+c processor
+c rbufr = buffer for particles being received from right or upper
+c processor
+c ihole = location of holes left in particle arrays
+c nx/ny = system length in x/y direction
+c kstrt = starting data block number
+c nvpx/nvpy = number of real or virtual processors in x/y
+c idimp = size of phase space = 4
+c npmax = maximum number of particles in each partition.
+c idps = number of particle partition boundaries = 4
+c nbmax =  size of buffers for passing particles between processors
+c ntmax =  size of hole array for particles leaving processors
+c info = status information
+c info(1) = ierr = (0,N) = (no,yes) error condition exists
+c info(2) = maximum number of particles per processor
+c info(3) = minimum number of particles per processor
+c info(4:5) = maximum number of buffer overflows in x/y
+c info(6:7) = maximum number of particle passes required in x/y
+      implicit none
+      integer npp, nx, ny, kstrt, nvpx, nvpy, idimp, npmax, idps, nbmax
+      integer ntmax
+      real part, edges, sbufr, sbufl, rbufr, rbufl
+      integer ihole, info
+      dimension part(idimp,npmax)
+      dimension edges(idps)
+      dimension sbufl(idimp,nbmax), sbufr(idimp,nbmax)
+      dimension rbufl(idimp,nbmax), rbufr(idimp,nbmax)
+      dimension ihole(ntmax+1)
+      dimension info(7)
+c common block for parallel processing
+      integer nproc, lgrp, lstat, mreal, mint, mcplx, mdouble, lworld
+c lstat = length of status array
+      parameter(lstat=10)
+c lgrp = current communicator
+c mint = default datatype for integers
+c mreal = default datatype for reals
+      common /PPARMS/ nproc, lgrp, mreal, mint, mcplx, mdouble, lworld
+c local data
+c ix/iy = partitioned co-ordinates
+      integer ix, iy
+      parameter(ix=1,iy=2)
+      integer i, j, n, js, ks, ic, nvp, iter, nps, itg, kl, kr, j1, j2
+      integer ih, joff, jin, nbsize, nter, mter, itermax, ierr
+      integer msid, istatus
+      integer kb, jsl, jsr, jss, ibflg, iwork
+      real an, xt
+      dimension msid(4), istatus(lstat)
+      dimension kb(2), jsl(2), jsr(2), jss(2), ibflg(4), iwork(4)
+c js/ks = processor co-ordinates in x/y => idproc = js + nvpx*ks
+      ks = (kstrt - 1)/nvpx
+      js = kstrt - nvpx*ks - 1
+      nbsize = idimp*nbmax
+      info(1) = 0
+      info(6) = 0
+      info(7) = 0
+      itermax = 2000
+c buffer outgoing particles, first in x then in y direction
+      do 280 n = 1, 2
+      if (n.eq.1) then
+         ic = ix
+         nvp = nvpx
+         an = real(nx)
+      else if (n.eq.2) then
+         ic = iy
+         nvp = nvpy
+         an = real(ny)
+      endif
+      iter = 2
+      nter = 0
       joff = 1
-      jin = 1
-      itermax = 2000
 c ih = number of particles extracted from holes
 c joff = next hole location for extraction
 c jss(1) = number of holes available to be filled
@@ -768,35 +2196,39 @@ c jin = next hole location to be filled
 c start loop
    10 mter = 0
       nps = 0
+      jin = 1
+      kb(1) = js
+      kb(2) = ks
 c buffer outgoing particles
       jsl(1) = 0
       jsr(1) = 0
 c load particle buffers
-      do 40 j = 1, ih
-      j1 = ihole(j+joff)
-      yt = part(iy,j1)
-c particles going down
-      if (yt.lt.edges(1)) then
-         if (ks.eq.0) yt = yt + any
+      do 40 j = 1, npp
+      xt = part(ic,j)
+c particles going left or down
+      if (xt.lt.edges(2*n-1)) then
+         if (kb(n).eq.0) xt = xt + an
          if (jsl(1).lt.nbmax) then
             jsl(1) = jsl(1) + 1
             do 20 i = 1, idimp
-            sbufl(i,jsl(1)) = part(i,j1)
+            sbufl(i,jsl(1)) = part(i,j)
    20       continue
-            sbufl(iy,jsl(1)) = yt
+            sbufl(ic,jsl(1)) = xt
+            ihole(jsl(1)+jsr(1)+1) = j
          else
             nps = 1
             go to 50
          endif
-c particles going up
-      else
-         if (ks.eq.(nvp-1)) yt = yt - any
+c particles going right or up
+      else if (xt.ge.edges(2*n)) then
+         if (kb(n).eq.(nvp-1)) xt = xt - an
          if (jsr(1).lt.nbmax) then
             jsr(1) = jsr(1) + 1
             do 30 i = 1, idimp
-            sbufr(i,jsr(1)) = part(i,j1)
+            sbufr(i,jsr(1)) = part(i,j)
    30       continue
-            sbufr(iy,jsr(1)) = yt
+            sbufr(ic,jsr(1)) = xt
+            ihole(jsl(1)+jsr(1)+1) = j
          else
             nps = 1
             go to 50
@@ -805,7 +2237,8 @@ c particles going up
    40 continue
    50 jss(1) = jsl(1) + jsr(1)
       joff = joff + jss(1)
-      ih = ih - jss(1)
+      ihole(1) = jss(1)
+      ih = 0
 c check for full buffer condition
       ibflg(3) = nps
 c copy particle buffers
@@ -827,11 +2260,16 @@ c special case for one processor
    68    continue
 c this segment is used for mpi computers
       else
-c get particles from below and above
-         kr = ks + 1
-         if (kr.ge.nvp) kr = kr - nvp
-         kl = ks - 1
-         if (kl.lt.0) kl = kl + nvp
+c get particles from left and right or below and above
+         kb(1) = js
+         kb(2) = ks
+         kl = kb(n)
+         kb(n) = kl + 1
+         if (kb(n).ge.nvp) kb(n) = kb(n) - nvp
+         kr = kb(1) + nvpx*kb(2)
+         kb(n) = kl - 1
+         if (kb(n).lt.0) kb(n) = kb(n) + nvp
+         kl = kb(1) + nvpx*kb(2)
 c post receive
          itg = iter - 1
          call MPI_IRECV(rbufl,nbsize,mreal,kl,itg,lgrp,msid(1),ierr)
@@ -850,21 +2288,19 @@ c wait for particles to arrive
          jsr(2) = nps/idimp
       endif
 c check if particles must be passed further
-c check if any particles coming from above belong here
+c check if any particles coming from right or above belong here
       jsl(1) = 0
       jsr(1) = 0
       jss(2) = 0
       do 70 j = 1, jsr(2)
-      if (rbufr(iy,j).lt.edges(1)) jsl(1) = jsl(1) + 1
-      if (rbufr(iy,j).ge.edges(2)) jsr(1) = jsr(1) + 1
+      if (rbufr(ic,j).lt.edges(2*n-1)) jsl(1) = jsl(1) + 1
+      if (rbufr(ic,j).ge.edges(2*n)) jsr(1) = jsr(1) + 1
    70 continue
-c     if (jsr(1).ne.0) write (2,*) ks+1, 'Info: particles returning up'
-c check if any particles coming from below belong here
+c check if any particles coming from left or below belong here
       do 80 j = 1, jsl(2)
-      if (rbufl(iy,j).ge.edges(2)) jsr(1) = jsr(1) + 1
-      if (rbufl(iy,j).lt.edges(1)) jss(2) = jss(2) + 1
+      if (rbufl(ic,j).ge.edges(2*n)) jsr(1) = jsr(1) + 1
+      if (rbufl(ic,j).lt.edges(2*n-1)) jss(2) = jss(2) + 1
    80 continue
-c     if (jss(2).ne.0) write (2,*) ks+1,'Info: particles returning down'
       nps = jsl(1) + jsr(1) + jss(2)
       ibflg(2) = nps
 c make sure sbufr and sbufl have been sent
@@ -874,25 +2310,27 @@ c make sure sbufr and sbufl have been sent
       endif
       if (nps.eq.0) go to 180
 c remove particles which do not belong here
-c first check particles coming from above
+      kb(1) = js
+      kb(2) = ks
+c first check particles coming from right or above
       jsl(1) = 0
       jsr(1) = 0
       jss(2) = 0
       do 120 j = 1, jsr(2)
-      yt = rbufr(iy,j)
-c particles going down
-      if (yt.lt.edges(1)) then
+      xt = rbufr(ic,j)
+c particles going left or down
+      if (xt.lt.edges(2*n-1)) then
          jsl(1) = jsl(1) + 1
-         if (ks.eq.0) yt = yt + any
-         rbufr(iy,j) = yt
+         if (kb(n).eq.0) xt = xt + an
+         rbufr(ic,j) = xt
          do 90 i = 1, idimp
          sbufl(i,jsl(1)) = rbufr(i,j)
    90    continue
-c particles going up, should not happen
-      else if (yt.ge.edges(2)) then
+c particles going right or up, should not happen
+      else if (xt.ge.edges(2*n)) then
          jsr(1) = jsr(1) + 1
-         if (ks.eq.(nvp-1)) yt = yt - any
-         rbufr(iy,j) = yt
+         if (kb(n).eq.(nvp-1)) xt = xt - an
+         rbufr(ic,j) = xt
          do 100 i = 1, idimp
          sbufr(i,jsr(1)) = rbufr(i,j)
   100    continue
@@ -905,16 +2343,16 @@ c particles staying here
       endif
   120 continue
       jsr(2) = jss(2)
-c next check particles coming from below
+c next check particles coming from left or below
       jss(2) = 0
       do 160 j = 1, jsl(2)
-      yt = rbufl(iy,j)
-c particles going up
-      if (yt.ge.edges(2)) then
+      xt = rbufl(ic,j)
+c particles going right or up
+      if (xt.ge.edges(2*n)) then
          if (jsr(1).lt.nbmax) then
             jsr(1) = jsr(1) + 1
-            if (ks.eq.(nvp-1)) yt = yt - any
-            rbufl(iy,j) = yt
+            if (kb(n).eq.(nvp-1)) xt = xt - an
+            rbufl(ic,j) = xt
             do 130 i = 1, idimp
             sbufr(i,jsr(1)) = rbufl(i,j)
   130       continue
@@ -922,12 +2360,12 @@ c particles going up
             jss(2) = 2*npmax
             go to 170
          endif
-c particles going down, should not happen
-      else if (yt.lt.edges(1)) then
+c particles going left or down, should not happen
+      else if (xt.lt.edges(2*n-1)) then
          if (jsl(1).lt.nbmax) then
             jsl(1) = jsl(1) + 1
-            if (ks.eq.0) yt = yt + any
-            rbufl(iy,j) = yt
+            if (kb(n).eq.0) xt = xt + an
+            rbufl(ic,j) = xt
             do 140 i = 1, idimp
             sbufl(i,jsl(1)) = rbufl(i,j)
   140       continue
@@ -958,7 +2396,7 @@ c check if move would overflow particle array
          return
       endif
 c distribute incoming particles from buffers
-c distribute particles coming from below into holes
+c distribute particles coming from left or below into holes
       jss(2) = min0(jss(1),jsl(2))
       do 200 j = 1, jss(2)
       j1 = ihole(j+jin)
@@ -973,15 +2411,15 @@ c distribute particles coming from below into holes
          jss(2) = jsl(2) - jss(1)
       endif
       do 230 j = 1, jss(2)
-c no more particles coming from below
-c distribute particles coming from above into holes
+c no more particles coming from left or below
+c distribute particles coming from right or above into holes
       if (jss(1).gt.jsl(2)) then
          j1 = ihole(j+jin)
          do 210 i = 1, idimp
          part(i,j1) = rbufr(i,j)
   210    continue
 c no more holes
-c distribute remaining particles from below into bottom
+c distribute remaining particles from left or below into bottom
       else
          do 220 i = 1, idimp
          part(i,j+npp) = rbufl(i,j+jss(1))
@@ -995,7 +2433,7 @@ c distribute remaining particles from below into bottom
          jss(1) = jsl(2)
       endif
 c no more holes
-c distribute remaining particles from above into bottom
+c distribute remaining particles from right or above into bottom
       jsr(2) = max0(0,nps-jss(1))
       jss(1) = jss(1) - jsl(2)
       do 250 j = 1, jsr(2)
@@ -1024,24 +2462,619 @@ c move particle only if it is below current hole
       jss(1) = 0
 c check if any particles have to be passed further
       if (ibflg(3).gt.0) ibflg(3) = 1
-      info(5) = max0(info(5),mter)
+      info(5+n) = max0(info(5+n),mter)
       if (ibflg(2).gt.0) then
-c        write (2,*) 'Info: particles being passed further = ', ibflg(2)
          if (iter.lt.itermax) go to 60
          ierr = -((iter-2)/2)
-         write (2,*) 'Iteration overflow, iter = ', ierr
+         if (kstrt.eq.1) write (2,*) 'Iteration overflow, iter = ', ierr
          info(1) = ierr
          return
       endif
 c check if buffer overflowed and more particles remain to be checked
       if (ibflg(3).gt.0) then
          nter = nter + 1
-         info(4) = nter
+         info(3+n) = nter
          go to 10
       endif
       if (nter.gt.0) then
-         write (2,*) 'Info: ', nter, ' buffer overflows, nbmax=', nbmax
+         if (kstrt.eq.1) then
+            write (2,*) 'Info: ',nter,' buffer overflows, nbmax=', nbmax
+         endif
+      endif
+  280 continue
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPWCHKPTH2(fname,nis,isc,nfs,fsc,irc)
+c this subroutine opens a shared checkpoint file for writing by all
+c processors with MPI-IO, and saves the scalars, which should be the
+c same on all processors.  distributed arrays are then written by
+c PPWCHKPTA2 and particles by PPWCHKPTP2, and the file is completed by
+c PPWCHKPTC2
+c input: all, output: irc
+c fname = name of checkpoint file
+c nis/nfs = number of integer/real scalars, <= 32
+c isc/fsc = integer/real scalars
+c irc = error code: 0 = ok, 1 = cannot create file, 4 = too many
+c scalars
+      implicit none
+      integer nis, nfs, irc
+      integer isc
+      real fsc
+      character*(*) fname
+      dimension isc(nis), fsc(nfs)
+c get definition of MPI constants
+      include 'mpif.h'
+c common block for parallel processing
+      integer nproc, lgrp, lstat, mreal, mint, mcplx, mdouble, lworld
+      integer msum, mmax
+c lstat = length of status array
+      parameter(lstat=10)
+c lgrp = current communicator
+c mreal = default datatype for reals
+c mint = default datatype for integers
+      common /PPARMS/ nproc, lgrp, mreal, mint, mcplx, mdouble, lworld
+c msum = MPI_SUM
+c mmax = MPI_MAX
+      common /PPARMSX/ msum, mmax
+c common block for checkpoint file, the header has the same layout
+c as the one written by the C library
+c nchkmax = maximum number of scalars or arrays in a checkpoint
+c nchkal = alignment of arrays in checkpoint file, in bytes
+c lchkh = size of integer header
+      integer nchkmax, nchkal, lchkh
+      parameter(nchkmax=32,nchkal=4096,lchkh=4+3*nchkmax)
+c nchkf = offset of next array in file being written
+c nchkh(1:32) = file offset of each array, in bytes
+c nchkh(33:64) = total number of particles in each particle array
+c mchk = checkpoint file handle
+c chkerr = error code of checkpoint being written
+c ichkh(1:4) = nvp, nis, nfs, narr
+c ichkh(5:36) = integer scalars
+c ichkh(37:68) = length of each row of each array, in reals,
+c or size of phase space for particles
+c ichkh(69:100) = total number of rows of each array, 0 for particles
+c fchkh = real scalars
+      integer(kind=MPI_OFFSET_KIND) nchkf, nchkh
+      integer mchk, chkerr, ichkh
+      real fchkh
+      dimension nchkh(2*nchkmax), ichkh(lchkh), fchkh(nchkmax)
+      common /PPCHKP/ nchkf, nchkh, mchk, chkerr, ichkh, fchkh
+      save /PPCHKP/
+c local data
+      integer j, minfo, ierr
+      integer(kind=MPI_OFFSET_KIND) nzero
+      irc = 0
+      if ((nis.gt.nchkmax).or.(nfs.gt.nchkmax)) then
+         irc = 4
+         return
+      endif
+      do 10 j = 1, lchkh
+      ichkh(j) = 0
+   10 continue
+      do 20 j = 1, nchkmax
+      fchkh(j) = 0.0
+   20 continue
+      do 30 j = 1, 2*nchkmax
+      nchkh(j) = 0
+   30 continue
+      ichkh(1) = nproc
+      ichkh(2) = nis
+      ichkh(3) = nfs
+      do 40 j = 1, nis
+      ichkh(j+4) = isc(j)
+   40 continue
+      do 50 j = 1, nfs
+      fchkh(j) = fsc(j)
+   50 continue
+c collective buffering lets a few aggregators access the file
+      call MPI_INFO_CREATE(minfo,ierr)
+      call MPI_INFO_SET(minfo,'romio_cb_write','enable',ierr)
+      call MPI_FILE_OPEN(lgrp,fname,MPI_MODE_WRONLY+MPI_MODE_CREATE,
+     1minfo,mchk,ierr)
+      call MPI_INFO_FREE(minfo,ierr)
+      if (ierr.ne.MPI_SUCCESS) then
+         mchk = MPI_FILE_NULL
+         irc = 1
+         return
+      endif
+c discard any previous contents
+      nzero = 0
+      call MPI_FILE_SET_SIZE(mchk,nzero,ierr)
+c first block is reserved for header
+      nchkf = nchkal
+      chkerr = 0
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPWCHKPTA2(f,nrow,nrp,noffr,nrows)
+c this subroutine writes a distributed array to the checkpoint file
+c opened by PPWCHKPTH2, with a collective write.  the array is stored
+c as nrows global rows, each processor writes its nrp rows, which
+c start at global row noffr.  the rows may be the nyp rows of a
+c particle partition, or the kxp rows of an array transposed in
+c fourier space, with complex data counted as two reals
+c input: all
+c f = distributed array, first nrp rows are written
+c nrow = length of each row, in reals
+c nrp = number of rows in this processor
+c noffr = global row number of first row in this processor
+c nrows = total number of rows, sum of nrp over processors
+      implicit none
+      integer nrow, nrp, noffr, nrows
+      real f
+      dimension f(nrow,nrp)
+c get definition of MPI constants
+      include 'mpif.h'
+c common block for parallel processing
+      integer nproc, lgrp, lstat, mreal, mint, mcplx, mdouble, lworld
+      integer msum, mmax
+c lstat = length of status array
+      parameter(lstat=10)
+c lgrp = current communicator
+c mreal = default datatype for reals
+c mint = default datatype for integers
+      common /PPARMS/ nproc, lgrp, mreal, mint, mcplx, mdouble, lworld
+c msum = MPI_SUM
+c mmax = MPI_MAX
+      common /PPARMSX/ msum, mmax
+c common block for checkpoint file
+      integer nchkmax, nchkal, lchkh
+      parameter(nchkmax=32,nchkal=4096,lchkh=4+3*nchkmax)
+      integer(kind=MPI_OFFSET_KIND) nchkf, nchkh
+      integer mchk, chkerr, ichkh
+      real fchkh
+      dimension nchkh(2*nchkmax), ichkh(lchkh), fchkh(nchkmax)
+      common /PPCHKP/ nchkf, nchkh, mchk, chkerr, ichkh, fchkh
+c local data
+      integer n, nsz, ierr
+      integer istatus
+      integer(kind=MPI_OFFSET_KIND) noff, nbytes
+      dimension istatus(lstat)
+      if (mchk.eq.MPI_FILE_NULL) return
+      n = ichkh(4) + 1
+      if (n.gt.nchkmax) then
+         chkerr = 4
+         return
+      endif
+      call MPI_TYPE_SIZE(mreal,nsz,ierr)
+      ichkh(n+36) = nrow
+      ichkh(n+68) = nrows
+      nchkh(n) = nchkf
+      nbytes = nsz*nrow
+      noff = nchkf + nbytes*noffr
+      call MPI_FILE_WRITE_AT_ALL(mchk,noff,f,nrow*nrp,mreal,istatus,
+     1ierr)
+      if (ierr.ne.MPI_SUCCESS) chkerr = 2
+c next array starts on a block boundary
+      nbytes = nbytes*nrows
+      nchkf = nchkf + nchkal*((nbytes + nchkal - 1)/nchkal)
+      ichkh(4) = n
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPWCHKPTP2(part,npp,idimp,npmax)
+c this subroutine writes particles to the checkpoint file opened by
+c PPWCHKPTH2, with a collective write.  an index with the number of
+c particles in each processor is written first, followed by the
+c particles of each processor in processor order
+c input: all
+c part(i,n) = coordinate i of particle n in partition
+c npp = number of particles in partition
+c idimp = size of phase space = 4
+c npmax = maximum number of particles in each partition
+      implicit none
+      integer npp, idimp, npmax
+      real part
+      dimension part(idimp,npmax)
+c get definition of MPI constants
+      include 'mpif.h'
+c common block for parallel processing
+      integer nproc, lgrp, lstat, mreal, mint, mcplx, mdouble, lworld
+      integer msum, mmax
+c lstat = length of status array
+      parameter(lstat=10)
+c lgrp = current communicator
+c mreal = default datatype for reals
+c mint = default datatype for integers
+      common /PPARMS/ nproc, lgrp, mreal, mint, mcplx, mdouble, lworld
+c msum = MPI_SUM
+c mmax = MPI_MAX
+      common /PPARMSX/ msum, mmax
+c common block for checkpoint file
+      integer nchkmax, nchkal, lchkh
+      parameter(nchkmax=32,nchkal=4096,lchkh=4+3*nchkmax)
+      integer(kind=MPI_OFFSET_KIND) nchkf, nchkh
+      integer mchk, chkerr, ichkh
+      real fchkh
+      dimension nchkh(2*nchkmax), ichkh(lchkh), fchkh(nchkmax)
+      common /PPCHKP/ nchkf, nchkh, mchk, chkerr, ichkh, fchkh
+c local data
+      integer n, ks, nsz, nisz, ierr
+      integer istatus
+      integer(kind=MPI_OFFSET_KIND) mpp, nsum, ntot, noff, nbytes
+      dimension istatus(lstat)
+      if (mchk.eq.MPI_FILE_NULL) return
+      n = ichkh(4) + 1
+      if (n.gt.nchkmax) then
+         chkerr = 4
+         return
+      endif
+      call MPI_COMM_RANK(lgrp,ks,ierr)
+      call MPI_TYPE_SIZE(mreal,nsz,ierr)
+      call MPI_TYPE_SIZE(mint,nisz,ierr)
+c find location of particles in file
+      mpp = npp
+      call MPI_EXSCAN(mpp,nsum,1,MPI_INTEGER8,msum,lgrp,ierr)
+      if (ks.eq.0) nsum = 0
+      call MPI_ALLREDUCE(mpp,ntot,1,MPI_INTEGER8,msum,lgrp,ierr)
+      ichkh(n+36) = idimp
+      ichkh(n+68) = 0
+      nchkh(n) = nchkf
+      nchkh(n+nchkmax) = ntot
+c each processor writes its entry in the index
+      noff = nchkf + nisz*ks
+      call MPI_FILE_WRITE_AT_ALL(mchk,noff,npp,1,mint,istatus,ierr)
+      if (ierr.ne.MPI_SUCCESS) chkerr = 2
+      nbytes = nisz
+      nbytes = nbytes*nproc
+      nchkf = nchkf + nchkal*((nbytes + nchkal - 1)/nchkal)
+c write particles
+      nbytes = nsz*idimp
+      noff = nchkf + nbytes*nsum
+      call MPI_FILE_WRITE_AT_ALL(mchk,noff,part,idimp*npp,mreal,istatus
+     1,ierr)
+      if (ierr.ne.MPI_SUCCESS) chkerr = 2
+      nbytes = nbytes*ntot
+      nchkf = nchkf + nchkal*((nbytes + nchkal - 1)/nchkal)
+      ichkh(4) = n
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPWCHKPTC2(irc)
+c this subroutine completes the checkpoint file written by PPWCHKPTH2,
+c PPWCHKPTA2 and PPWCHKPTP2.  processor 0 writes the header.  the
+c file is written in place: the C wrappers in pplib2_f.c open
+c fname.tmp and rename it after this call
+c output: irc
+c irc = error code: 0 = ok, 1 = file not open, 2 = write error,
+c 4 = too many arrays
+      implicit none
+      integer irc
+c get definition of MPI constants
+      include 'mpif.h'
+c common block for parallel processing
+      integer nproc, lgrp, lstat, mreal, mint, mcplx, mdouble, lworld
+      integer msum, mmax
+c lstat = length of status array
+      parameter(lstat=10)
+c lgrp = current communicator
+c mreal = default datatype for reals
+c mint = default datatype for integers
+      common /PPARMS/ nproc, lgrp, mreal, mint, mcplx, mdouble, lworld
+c msum = MPI_SUM
+c mmax = MPI_MAX
+      common /PPARMSX/ msum, mmax
+c common block for checkpoint file
+      integer nchkmax, nchkal, lchkh
+      parameter(nchkmax=32,nchkal=4096,lchkh=4+3*nchkmax)
+      integer(kind=MPI_OFFSET_KIND) nchkf, nchkh
+      integer mchk, chkerr, ichkh
+      real fchkh
+      dimension nchkh(2*nchkmax), ichkh(lchkh), fchkh(nchkmax)
+      common /PPCHKP/ nchkf, nchkh, mchk, chkerr, ichkh, fchkh
+c local data
+      integer ks, ierr
+      integer istatus
+      integer(kind=MPI_OFFSET_KIND) noff
+      character*8 cmagic
+      dimension istatus(lstat)
+      if (mchk.eq.MPI_FILE_NULL) then
+         irc = 1
+         return
+      endif
+      call MPI_COMM_RANK(lgrp,ks,ierr)
+c header is written in the layout of the C structure
+      if (ks.eq.0) then
+         cmagic = 'PPCHK2'//char(0)//char(0)
+         noff = 0
+         call MPI_FILE_WRITE_AT(mchk,noff,cmagic,8,MPI_CHARACTER,
+     1istatus,ierr)
+         if (ierr.ne.MPI_SUCCESS) chkerr = 2
+         noff = 8
+         call MPI_FILE_WRITE_AT(mchk,noff,ichkh,nchkmax+4,mint,istatus,
+     1ierr)
+         if (ierr.ne.MPI_SUCCESS) chkerr = 2
+         noff = 152
+         call MPI_FILE_WRITE_AT(mchk,noff,fchkh,nchkmax,mreal,istatus,
+     1ierr)
+         if (ierr.ne.MPI_SUCCESS) chkerr = 2
+         noff = 280
+         call MPI_FILE_WRITE_AT(mchk,noff,ichkh(nchkmax+5),2*nchkmax,
+     1mint,istatus,ierr)
+         if (ierr.ne.MPI_SUCCESS) chkerr = 2
+         noff = 536
+         call MPI_FILE_WRITE_AT(mchk,noff,nchkh,2*nchkmax,MPI_INTEGER8,
+     1istatus,ierr)
+         if (ierr.ne.MPI_SUCCESS) chkerr = 2
+      endif
+      call MPI_FILE_SYNC(mchk,ierr)
+      if (ierr.ne.MPI_SUCCESS) chkerr = 2
+      call MPI_FILE_CLOSE(mchk,ierr)
+      mchk = MPI_FILE_NULL
+      call MPI_ALLREDUCE(chkerr,irc,1,mint,mmax,lgrp,ierr)
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPRCHKPTH2(fname,nis,isc,nfs,fsc,nvpo,irc)
+c this subroutine opens a checkpoint file written by PPWCHKPTH2 for
+c reading by all processors with MPI-IO, and reads the scalars.
+c the arrays are then read by PPRCHKPTA2 and PPRCHKPTP2, and the file
+c is closed by PPRCHKPTC2
+c input: fname, nis, nfs, output: isc, fsc, nvpo, irc
+c fname = name of checkpoint file
+c nis/nfs = number of integer/real scalars expected
+c isc/fsc = integer/real scalars
+c nvpo = number of processors which wrote the file
+c irc = error code: 0 = ok, 1 = cannot open file, 2 = not a valid
+c checkpoint file, or wrong number of scalars
+      implicit none
+      integer nis, nfs, nvpo, irc
+      integer isc
+      real fsc
+      character*(*) fname
+      dimension isc(nis), fsc(nfs)
+c get definition of MPI constants
+      include 'mpif.h'
+c common block for parallel processing
+      integer nproc, lgrp, lstat, mreal, mint, mcplx, mdouble, lworld
+      integer msum, mmax
+c lstat = length of status array
+      parameter(lstat=10)
+c lgrp = current communicator
+c mreal = default datatype for reals
+c mint = default datatype for integers
+      common /PPARMS/ nproc, lgrp, mreal, mint, mcplx, mdouble, lworld
+c msum = MPI_SUM
+c mmax = MPI_MAX
+      common /PPARMSX/ msum, mmax
+c common block for checkpoint file
+      integer nchkmax, nchkal, lchkh
+      parameter(nchkmax=32,nchkal=4096,lchkh=4+3*nchkmax)
+      integer(kind=MPI_OFFSET_KIND) nchkf, nchkh
+      integer mchk, chkerr, ichkh
+      real fchkh
+      dimension nchkh(2*nchkmax), ichkh(lchkh), fchkh(nchkmax)
+      common /PPCHKP/ nchkf, nchkh, mchk, chkerr, ichkh, fchkh
+c local data
+      integer j, ks, minfo, ierr
+      integer istatus
+      integer(kind=MPI_OFFSET_KIND) noff
+      character*8 cmagic, cmg
+      dimension istatus(lstat)
+      irc = 0
+      call MPI_INFO_CREATE(minfo,ierr)
+      call MPI_INFO_SET(minfo,'romio_cb_read','enable',ierr)
+      call MPI_FILE_OPEN(lgrp,fname,MPI_MODE_RDONLY,minfo,mchk,ierr)
+      call MPI_INFO_FREE(minfo,ierr)
+      if (ierr.ne.MPI_SUCCESS) then
+         mchk = MPI_FILE_NULL
+         irc = 1
+         return
+      endif
+c processor 0 reads the header and broadcasts it
+      call MPI_COMM_RANK(lgrp,ks,ierr)
+      cmagic = ' '
+      do 10 j = 1, lchkh
+      ichkh(j) = 0
+   10 continue
+      if (ks.eq.0) then
+         noff = 0
+         call MPI_FILE_READ_AT(mchk,noff,cmagic,8,MPI_CHARACTER,istatus,
+     1ierr)
+         noff = 8
+         call MPI_FILE_READ_AT(mchk,noff,ichkh,nchkmax+4,mint,istatus,
+     1ierr)
+         noff = 152
+         call MPI_FILE_READ_AT(mchk,noff,fchkh,nchkmax,mreal,istatus,
+     1ierr)
+         noff = 280
+         call MPI_FILE_READ_AT(mchk,noff,ichkh(nchkmax+5),2*nchkmax,
+     1mint,istatus,ierr)
+         noff = 536
+         call MPI_FILE_READ_AT(mchk,noff,nchkh,2*nchkmax,MPI_INTEGER8,
+     1istatus,ierr)
       endif
+      call MPI_BCAST(cmagic,8,MPI_CHARACTER,0,lgrp,ierr)
+      call MPI_BCAST(ichkh,lchkh,mint,0,lgrp,ierr)
+      call MPI_BCAST(fchkh,nchkmax,mreal,0,lgrp,ierr)
+      call MPI_BCAST(nchkh,2*nchkmax,MPI_INTEGER8,0,lgrp,ierr)
+      cmg = 'PPCHK2'//char(0)//char(0)
+      if ((cmagic.ne.cmg).or.(ichkh(1).lt.1).or.(ichkh(2).ne.nis).or.
+     1(ichkh(3).ne.nfs).or.(ichkh(4).gt.nchkmax)) then
+         call PPRCHKPTC2
+         irc = 2
+         return
+      endif
+      do 20 j = 1, nis
+      isc(j) = ichkh(j+4)
+   20 continue
+      do 30 j = 1, nfs
+      fsc(j) = fchkh(j)
+   30 continue
+      nvpo = ichkh(1)
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPRCHKPTA2(n,f,nrow,nrp,noffr,nrows,irc)
+c this subroutine reads a distributed array from the checkpoint file
+c opened by PPRCHKPTH2, with a collective read.  each processor reads
+c nrp rows starting at global row noffr, so the partition need not be
+c the same as the one which wrote the file
+c input: n, nrow, nrp, noffr, nrows, output: f, irc
+c n = array number in checkpoint file, starting with 1
+c f = distributed array, first nrp rows are read
+c nrow = length of each row, in reals
+c nrp = number of rows in this processor
+c noffr = global row number of first row in this processor
+c nrows = total number of rows
+c irc = error code: 0 = ok, 2 = read error, 3 = array not found or
+c wrong size
+      implicit none
+      integer n, nrow, nrp, noffr, nrows, irc
+      real f
+      dimension f(nrow,nrp)
+c get definition of MPI constants
+      include 'mpif.h'
+c common block for parallel processing
+      integer nproc, lgrp, lstat, mreal, mint, mcplx, mdouble, lworld
+      integer msum, mmax
+c lstat = length of status array
+      parameter(lstat=10)
+c lgrp = current communicator
+c mreal = default datatype for reals
+c mint = default datatype for integers
+      common /PPARMS/ nproc, lgrp, mreal, mint, mcplx, mdouble, lworld
+c msum = MPI_SUM
+c mmax = MPI_MAX
+      common /PPARMSX/ msum, mmax
+c common block for checkpoint file
+      integer nchkmax, nchkal, lchkh
+      parameter(nchkmax=32,nchkal=4096,lchkh=4+3*nchkmax)
+      integer(kind=MPI_OFFSET_KIND) nchkf, nchkh
+      integer mchk, chkerr, ichkh
+      real fchkh
+      dimension nchkh(2*nchkmax), ichkh(lchkh), fchkh(nchkmax)
+      common /PPCHKP/ nchkf, nchkh, mchk, chkerr, ichkh, fchkh
+c local data
+      integer nsz, ierr, jerr
+      integer istatus
+      integer(kind=MPI_OFFSET_KIND) noff, nbytes
+      dimension istatus(lstat)
+      if ((mchk.eq.MPI_FILE_NULL).or.(n.lt.1).or.(n.gt.ichkh(4))) then
+         irc = 3
+         return
+      endif
+      if ((ichkh(n+36).ne.nrow).or.(ichkh(n+68).ne.nrows)) then
+         irc = 3
+         return
+      endif
+      call MPI_TYPE_SIZE(mreal,nsz,ierr)
+      nbytes = nsz*nrow
+      noff = nchkh(n) + nbytes*noffr
+      call MPI_FILE_READ_AT_ALL(mchk,noff,f,nrow*nrp,mreal,istatus,ierr)
+      jerr = 0
+      if (ierr.ne.MPI_SUCCESS) jerr = 2
+      call MPI_ALLREDUCE(jerr,irc,1,mint,mmax,lgrp,ierr)
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPRCHKPTP2(n,part,npp,idimp,npmax,irc)
+c this subroutine reads particles from the checkpoint file opened by
+c PPRCHKPTH2, with a collective read.  if the file was written by the
+c same number of processors, each processor reads the particles it
+c wrote, using the index.  otherwise the particles are divided evenly
+c among processors, and must afterwards be moved to the correct
+c partition, for example with PPMOVE2
+c input: n, idimp, npmax, output: part, npp, irc
+c n = array number in checkpoint file, starting with 1
+c part(i,n) = coordinate i of particle n in partition
+c npp = number of particles read in partition
+c idimp = size of phase space = 4
+c npmax = maximum number of particles in each partition
+c irc = error code: 0 = ok, 2 = read error, 3 = array not found,
+c wrong size, or too many particles
+      implicit none
+      integer n, npp, idimp, npmax, irc
+      real part
+      dimension part(idimp,npmax)
+c get definition of MPI constants
+      include 'mpif.h'
+c common block for parallel processing
+      integer nproc, lgrp, lstat, mreal, mint, mcplx, mdouble, lworld
+      integer msum, mmax
+c lstat = length of status array
+      parameter(lstat=10)
+c lgrp = current communicator
+c mreal = default datatype for reals
+c mint = default datatype for integers
+      common /PPARMS/ nproc, lgrp, mreal, mint, mcplx, mdouble, lworld
+c msum = MPI_SUM
+c mmax = MPI_MAX
+      common /PPARMSX/ msum, mmax
+c common block for checkpoint file
+      integer nchkmax, nchkal, lchkh
+      parameter(nchkmax=32,nchkal=4096,lchkh=4+3*nchkmax)
+      integer(kind=MPI_OFFSET_KIND) nchkf, nchkh
+      integer mchk, chkerr, ichkh
+      real fchkh
+      dimension nchkh(2*nchkmax), ichkh(lchkh), fchkh(nchkmax)
+      common /PPCHKP/ nchkf, nchkh, mchk, chkerr, ichkh, fchkh
+c local data
+      integer ks, nvpo, mpp, nsz, nisz, ierr, jerr
+      integer istatus
+      integer(kind=MPI_OFFSET_KIND) nsum, noffp, nbytes, ntot, kpp
+      dimension istatus(lstat)
+      if ((mchk.eq.MPI_FILE_NULL).or.(n.lt.1).or.(n.gt.ichkh(4))) then
+         irc = 3
+         return
+      endif
+      if ((ichkh(n+36).ne.idimp).or.(ichkh(n+68).ne.0)) then
+         irc = 3
+         return
+      endif
+      call MPI_COMM_RANK(lgrp,ks,ierr)
+      call MPI_TYPE_SIZE(mreal,nsz,ierr)
+      call MPI_TYPE_SIZE(mint,nisz,ierr)
+      nvpo = ichkh(1)
+      ntot = nchkh(n+nchkmax)
+      jerr = 0
+c same processors: read own entry in index
+      if (nvpo.eq.nproc) then
+         noffp = nchkh(n) + nisz*ks
+         call MPI_FILE_READ_AT_ALL(mchk,noffp,mpp,1,mint,istatus,ierr)
+         if (ierr.ne.MPI_SUCCESS) jerr = 2
+         kpp = mpp
+         call MPI_EXSCAN(kpp,nsum,1,MPI_INTEGER8,msum,lgrp,ierr)
+         if (ks.eq.0) nsum = 0
+c different processors: divide particles evenly
+      else
+         nsum = (ntot*ks)/nproc
+         mpp = int((ntot*(ks + 1))/nproc - nsum)
+      endif
+      if ((mpp.lt.0).or.(mpp.gt.npmax)) jerr = 3
+      call MPI_ALLREDUCE(jerr,irc,1,mint,mmax,lgrp,ierr)
+      if (irc.ne.0) return
+c read particles
+      nbytes = nisz
+      nbytes = nbytes*nvpo
+      noffp = nchkh(n) + nchkal*((nbytes + nchkal - 1)/nchkal)
+      nbytes = nsz*idimp
+      noffp = noffp + nbytes*nsum
+      call MPI_FILE_READ_AT_ALL(mchk,noffp,part,idimp*mpp,mreal,istatus
+     1,ierr)
+      if (ierr.ne.MPI_SUCCESS) jerr = 2
+      call MPI_ALLREDUCE(jerr,irc,1,mint,mmax,lgrp,ierr)
+      npp = mpp
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPRCHKPTC2
+c this subroutine closes the checkpoint file opened by PPRCHKPTH2
+      implicit none
+c get definition of MPI constants
+      include 'mpif.h'
+c common block for checkpoint file
+      integer nchkmax, nchkal, lchkh
+      parameter(nchkmax=32,nchkal=4096,lchkh=4+3*nchkmax)
+      integer(kind=MPI_OFFSET_KIND) nchkf, nchkh
+      integer mchk, chkerr, ichkh
+      real fchkh
+      dimension nchkh(2*nchkmax), ichkh(lchkh), fchkh(nchkmax)
+      common /PPCHKP/ nchkf, nchkh, mchk, chkerr, ichkh, fchkh
+c local data
+      integer ierr
+      if (mchk.ne.MPI_FILE_NULL) call MPI_FILE_CLOSE(mchk,ierr)
+      mchk = MPI_FILE_NULL
       return
       end
-
@@ -19,13 +19,48 @@
 ! PPNACGUARD2L adds guard cells in y for vector array, linear
 !              interpolation, and distributed data with non-uniform
 !              partition.
+! PPNGUARD2INIT creates persistent requests for guard cell exchanges
+!               in y of one row of data, to be reused every time step.
+! PPNCGUARD2LP copies data to guard cells in y for scalar data, using
+!              persistent requests created by PPNGUARD2INIT.
+! PPNAGUARD2LP adds guard cells in y for scalar array, using persistent
+!              requests created by PPNGUARD2INIT.
+! PPNACGUARD2LP adds guard cells in y for vector array, using
+!               persistent requests created by PPNGUARD2INIT.
+! PPNGUARD2FREE frees persistent requests created by PPNGUARD2INIT.
 ! PPTPOSE performs a transpose of a complex scalar array, distributed
 !         in y, to a complex scalar array, distributed in x.
 ! PPNTPOSE performs a transpose of an n component complex vector array,
 !          distributed in y, to an n component complex vector array,
 !          distributed in x.
+! PPTPOSENB performs a transpose of a complex scalar array, distributed
+!           in y, to a complex scalar array, distributed in x, using
+!           non-blocking messages to all processors at once.
+! PPNTPOSENB performs a transpose of an n component complex vector
+!            array, distributed in y, to an n component complex vector
+!            array, distributed in x, using non-blocking messages to all
+!            processors at once.
+! PPFMOVE2 moves field data in y between two different partitions,
+!          such as a non-uniform particle partition and the uniform
+!          partition used by the fft.
 ! PPMOVE2 moves particles into appropriate spatial regions with periodic
 !         boundary conditions.  Assumes ihole list has been found.
+! PPMOVE2NB moves particles into appropriate spatial regions with
+!           periodic boundary conditions, sending particles directly to
+!           their destination processor with non-blocking messages.
+!           Assumes ihole list has been found.
+! PPNCGUARD22L copies data to guard cells in x and y for vector data,
+!              linear interpolation, and distributed data with 2D
+!              spatial decomposition.
+! PPNAGUARD22L adds guard cells in x and y for scalar array, linear
+!              interpolation, and distributed data with 2D spatial
+!              decomposition.
+! PPFMOVE22 moves field data between two partitions divided in x and y,
+!           such as a 2D particle partition and the uniform partition
+!           in y used by the fft.
+! PPMOVEG22 moves particles into appropriate spatial regions with
+!           periodic boundary conditions and 2D spatial decomposition.
+!           ihole list is calculated from particle co-ordinates.
 ! written by viktor k. decyk, ucla
 ! copyright 1995, regents of the university of california
 ! update: april 23, 2015
@@ -47,13 +82,23 @@
 ! msum = MPI_SUM
 ! mmax = MPI_MAX
       integer :: msum, mmax
+! maxgds = maximum number of guard cell exchange plans
+      integer, parameter :: maxgds = 8
+! ngds = number of guard cell exchange plans created so far
+      integer :: ngds = 0
+! mgds = persistent requests for each plan
+      integer, dimension(4,maxgds) :: mgds
       save
 !
       private
       public :: PPINIT2, PPEXIT, PPABORT, PWTIMERA
       public :: PPSUM, PPDSUM, PPIMAX, PPDMAX
       public :: PPNCGUARD2L, PPNAGUARD2L, PPNACGUARD2L
-      public :: PPTPOSE, PPNTPOSE, PPMOVE2
+      public :: PPNGUARD2INIT, PPNCGUARD2LP, PPNAGUARD2LP, PPNACGUARD2LP
+      public :: PPNGUARD2FREE
+      public :: PPTPOSE, PPNTPOSE, PPTPOSENB, PPNTPOSENB
+      public :: PPFMOVE2, PPMOVE2, PPMOVE2NB
+      public :: PPNCGUARD22L, PPNAGUARD22L, PPFMOVE22, PPMOVEG22
 !
       contains
 !
@@ -444,6 +489,399 @@
       enddo
       end subroutine
 !
+!-----------------------------------------------------------------------
+      subroutine PPNGUARD2INIT(scs,scr,igds,kstrt,nvp,nxv,nypmx)
+! this subroutine creates persistent requests for guard cell exchanges
+! in y with non-uniform partitions, for data with nxv reals per row.
+! the same plan is used by PPNCGUARD2LP, PPNAGUARD2LP and PPNACGUARD2LP,
+! which avoids setting up new messages every call.
+! scs/scr = buffers for sending/receiving one row of data, which must
+! not be moved or deallocated while the plan is in use.
+! igds = plan number returned, 0 if no plan could be created
+! kstrt = starting data block number
+! nvp = number of real or virtual processors
+! nxv = number of reals in one row of data, e.g., ndim*nxv for a
+! vector array
+! nypmx = maximum size of field partition, including guard cells.
+      implicit none
+      integer, intent(in) :: kstrt, nvp, nxv, nypmx
+      integer, intent(inout) :: igds
+      real, dimension(nxv), intent(inout) :: scs, scr
+! lgrp = current communicator
+! mreal = default datatype for reals
+! ngds = number of guard cell exchange plans created so far
+! mgds = persistent requests for each plan
+! local data
+      integer :: n, ks, moff, kl, kr, ierr
+      igds = 0
+      if (ngds >= maxgds) then
+         if (kstrt==1) then
+            write (*,*) 'PPNGUARD2INIT: too many plans, maxgds=', maxgds
+         endif
+         return
+      endif
+      ngds = ngds + 1
+      n = ngds
+      igds = n
+! special case for one processor
+      if (nvp==1) then
+         mgds(:,n) = MPI_REQUEST_NULL
+         return
+      endif
+      ks = kstrt - 1
+      kr = ks + 1
+      if (kr >= nvp) kr = kr - nvp
+      kl = ks - 1
+      if (kl < 0) kl = kl + nvp
+! copy guard cells: receive from right, send to left
+      moff = nypmx*nvp + 2
+      call MPI_RECV_INIT(scr,nxv,mreal,kr,moff,lgrp,mgds(1,n),ierr)
+      call MPI_SEND_INIT(scs,nxv,mreal,kl,moff,lgrp,mgds(2,n),ierr)
+! add guard cells: receive from left, send to right
+      moff = nypmx*nvp + 1
+      call MPI_RECV_INIT(scr,nxv,mreal,kl,moff,lgrp,mgds(3,n),ierr)
+      call MPI_SEND_INIT(scs,nxv,mreal,kr,moff,lgrp,mgds(4,n),ierr)
+      end subroutine
+!
+!-----------------------------------------------------------------------
+      subroutine PPNCGUARD2LP(f,scs,scr,igds,nyp,nvp,nxv)
+! this subroutine copies data to guard cells in non-uniform partitions
+! using persistent requests created by PPNGUARD2INIT
+! f(j,k) = real data for grid j,k in particle partition.
+! the grid is non-uniform and includes one extra guard cell.
+! output: f, scs, scr
+! scs/scr = send/receive buffers given to PPNGUARD2INIT
+! igds = plan number returned by PPNGUARD2INIT
+! nyp = number of primary gridpoints in field partition
+! it is assumed the nyp > 0.
+! nvp = number of real or virtual processors
+! nxv = first dimension of f, must be same as in PPNGUARD2INIT
+! linear interpolation, for distributed data
+      implicit none
+      integer, intent(in) :: igds, nyp, nvp, nxv
+      real, dimension(nxv,*), intent(inout) :: f
+      real, dimension(nxv), intent(inout) :: scs, scr
+! mgds = persistent requests for each plan
+! local data
+      integer :: j, ierr
+! special case for one processor
+      if (nvp==1) then
+         do j = 1, nxv
+            f(j,nyp+1) = f(j,1)
+         enddo
+         return
+      endif
+! this segment is used for mpi computers
+      do j = 1, nxv
+         scs(j) = f(j,1)
+      enddo
+      call MPI_STARTALL(2,mgds(1:2,igds),ierr)
+      call MPI_WAITALL(2,mgds(1:2,igds),MPI_STATUSES_IGNORE,ierr)
+      do j = 1, nxv
+         f(j,nyp+1) = scr(j)
+      enddo
+      end subroutine
+!
+!-----------------------------------------------------------------------
+      subroutine PPNAGUARD2LP(f,scs,scr,igds,nyp,nx,nvp,nxv)
+! this subroutine adds data from guard cells in non-uniform partitions
+! using persistent requests created by PPNGUARD2INIT
+! f(j,k) = real data for grid j,k in particle partition.
+! the grid is non-uniform and includes one extra guard cell.
+! output: f, scs, scr
+! scs/scr = send/receive buffers given to PPNGUARD2INIT
+! igds = plan number returned by PPNGUARD2INIT
+! nyp = number of primary gridpoints in particle partition
+! it is assumed the nyp > 0.
+! nx = system length in x direction
+! nvp = number of real or virtual processors
+! nxv = first dimension of f, must be same as in PPNGUARD2INIT
+! linear interpolation, for distributed data
+      implicit none
+      integer, intent(in) :: igds, nyp, nx, nvp, nxv
+      real, dimension(nxv,*), intent(inout) :: f
+      real, dimension(nxv), intent(inout) :: scs, scr
+! mgds = persistent requests for each plan
+! local data
+      integer :: j, nx1, ierr
+      nx1 = nx + 1
+! special case for one processor
+      if (nvp==1) then
+         do j = 1, nx1
+            f(j,1) = f(j,1) + f(j,nyp+1)
+            f(j,nyp+1) = 0.0
+         enddo
+         return
+      endif
+! this segment is used for mpi computers
+      do j = 1, nxv
+         scs(j) = f(j,nyp+1)
+      enddo
+      call MPI_STARTALL(2,mgds(3:4,igds),ierr)
+      call MPI_WAITALL(2,mgds(3:4,igds),MPI_STATUSES_IGNORE,ierr)
+! add up the guard cells
+      do j = 1, nx1
+         f(j,1) = f(j,1) + scr(j)
+         f(j,nyp+1) = 0.0
+      enddo
+      end subroutine
+!
+!-----------------------------------------------------------------------
+      subroutine PPNACGUARD2LP(f,scs,scr,igds,nyp,nx,ndim,nvp,nxv)
+! this subroutine adds data from guard cells in non-uniform partitions
+! using persistent requests created by PPNGUARD2INIT
+! f(ndim,j,k) = real data for grid j,k in particle partition.
+! the grid is non-uniform and includes one extra guard cell.
+! output: f, scs, scr
+! scs/scr = send/receive buffers given to PPNGUARD2INIT
+! igds = plan number returned by PPNGUARD2INIT, created with ndim*nxv
+! reals per row
+! nyp = number of primary gridpoints in particle partition
+! it is assumed the nyp > 0.
+! nx = system length in x direction
+! ndim = leading dimension of array f
+! nvp = number of real or virtual processors
+! nxv = first dimension of f, must be >= nx
+! linear interpolation, for distributed data
+      implicit none
+      integer, intent(in) :: igds, nyp, nx, ndim, nvp, nxv
+      real, dimension(ndim,nxv,*), intent(inout) :: f
+      real, dimension(ndim,nxv), intent(inout) :: scs, scr
+! mgds = persistent requests for each plan
+! local data
+      integer :: j, n, nx1, ierr
+      nx1 = nx + 1
+! special case for one processor
+      if (nvp==1) then
+         do j = 1, nx1
+            do n = 1, ndim
+               f(n,j,1) = f(n,j,1) + f(n,j,nyp+1)
+               f(n,j,nyp+1) = 0.0
+            enddo
+         enddo
+         return
+      endif
+! this segment is used for mpi computers
+      do j = 1, nxv
+         do n = 1, ndim
+            scs(n,j) = f(n,j,nyp+1)
+         enddo
+      enddo
+      call MPI_STARTALL(2,mgds(3:4,igds),ierr)
+      call MPI_WAITALL(2,mgds(3:4,igds),MPI_STATUSES_IGNORE,ierr)
+! add up the guard cells
+      do j = 1, nx1
+         do n = 1, ndim
+            f(n,j,1) = f(n,j,1) + scr(n,j)
+            f(n,j,nyp+1) = 0.0
+         enddo
+      enddo
+      end subroutine
+!
+!-----------------------------------------------------------------------
+      subroutine PPNGUARD2FREE(igds)
+! this subroutine frees persistent requests created by PPNGUARD2INIT
+! igds = plan number, set to 0 on output
+      implicit none
+      integer, intent(inout) :: igds
+! ngds = number of guard cell exchange plans created so far
+! mgds = persistent requests for each plan
+! local data
+      integer :: n, ierr
+      if ((igds < 1).or.(igds > ngds)) return
+      do n = 1, 4
+         if (mgds(n,igds) /= MPI_REQUEST_NULL) then
+            call MPI_REQUEST_FREE(mgds(n,igds),ierr)
+         endif
+      enddo
+! release plan number if it was the last one created
+      if (igds==ngds) ngds = ngds - 1
+      igds = 0
+      end subroutine
+!
+!-----------------------------------------------------------------------
+      subroutine PPNCGUARD22L(f,scs,nxyp,ndim,kstrt,nvpx,nvpy,nxv,nypmx,&
+     &idds)
+! this subroutine copies data to guard cells in non-uniform partitions
+! f(n,j,k) = real data for grid j,k in particle partition.
+! the grid is non-uniform and includes one extra guard cell in x and y.
+! output: f, scs
+! scs(n,k,2) = scratch array for particle partition
+! nxyp(1:2) = number of primary gridpoints in x/y in particle partition
+! it is assumed the nxyp > 0.
+! ndim = leading dimension of array f
+! kstrt = starting data block number
+! nvpx/nvpy = number of real or virtual processors in x/y
+! nxv = second dimension of f, must be >= nxpmx
+! nypmx = maximum size of particle partition in y, including guard cells
+! idds = dimensionality of domain decomposition
+! linear interpolation, for distributed data,
+! with 2D spatial decomposition
+      implicit none
+      integer, intent(in) :: ndim, kstrt, nvpx, nvpy, nxv, nypmx, idds
+      integer, dimension(idds), intent(in) :: nxyp
+      real, dimension(ndim,nxv,nypmx), intent(inout) :: f
+      real, dimension(ndim,nypmx,2), intent(inout) :: scs
+! lgrp = current communicator
+! mreal = default datatype for reals
+! local data
+      integer :: j, k, n, js, ks, moff, kr, kl
+      integer :: nxp1, nyp1, nnxv
+      integer :: msid, ierr
+      integer, dimension(lstat) :: istatus
+      nxp1 = nxyp(1) + 1
+      nyp1 = nxyp(2) + 1
+! js/ks = processor co-ordinates in x/y => idproc = js + nvpx*ks
+      ks = (kstrt - 1)/nvpx
+      js = kstrt - nvpx*ks - 1
+      moff = nypmx*nvpy
+      nnxv = ndim*nxv
+! special case for one processor in x
+      if (nvpx==1) then
+         do k = 1, nxyp(2)
+            do n = 1, ndim
+               f(n,nxp1,k) = f(n,1,k)
+            enddo
+         enddo
+      else
+! buffer data in x
+         do k = 1, nxyp(2)
+            do n = 1, ndim
+               scs(n,k,1) = f(n,1,k)
+            enddo
+         enddo
+! copy to guard cells in x
+         kr = js + 1
+         if (kr >= nvpx) kr = kr - nvpx
+         kl = js - 1
+         if (kl < 0) kl = kl + nvpx
+         kr = kr + nvpx*ks
+         kl = kl + nvpx*ks
+! this segment is used for mpi computers
+         call MPI_IRECV(scs(1,1,2),ndim*nypmx,mreal,kr,moff+3,lgrp,msid,&
+     &ierr)
+         call MPI_SEND(scs,ndim*nxyp(2),mreal,kl,moff+3,lgrp,ierr)
+         call MPI_WAIT(msid,istatus,ierr)
+! copy guard cells
+         do k = 1, nxyp(2)
+            do n = 1, ndim
+               f(n,nxp1,k) = scs(n,k,2)
+            enddo
+         enddo
+      endif
+! special case for one processor in y
+      if (nvpy==1) then
+         do j = 1, nxv
+            do n = 1, ndim
+               f(n,j,nyp1) = f(n,j,1)
+            enddo
+         enddo
+         return
+      endif
+! copy to guard cells in y
+      kr = ks + 1
+      if (kr >= nvpy) kr = kr - nvpy
+      kl = ks - 1
+      if (kl < 0) kl = kl + nvpy
+      kr = js + nvpx*kr
+      kl = js + nvpx*kl
+! this segment is used for mpi computers
+      call MPI_IRECV(f(1,1,nyp1),nnxv,mreal,kr,moff+4,lgrp,msid,ierr)
+      call MPI_SEND(f,nnxv,mreal,kl,moff+4,lgrp,ierr)
+      call MPI_WAIT(msid,istatus,ierr)
+      end subroutine
+!
+!-----------------------------------------------------------------------
+      subroutine PPNAGUARD22L(f,scs,scr,nxyp,kstrt,nvpx,nvpy,nxv,nypmx, &
+     &idds)
+! this subroutine adds data from guard cells in non-uniform partitions
+! f(j,k) = real data for grid j,k in particle partition.
+! the grid is non-uniform and includes one extra guard cell in x and y.
+! output: f, scs, scr
+! scs(k,2) = scratch array for particle partition in x
+! scr(j) = scratch array for particle partition in y
+! nxyp(1:2) = number of primary gridpoints in x/y in particle partition
+! it is assumed the nxyp > 0.
+! kstrt = starting data block number
+! nvpx/nvpy = number of real or virtual processors in x/y
+! nxv = first dimension of f, must be >= nxpmx
+! nypmx = maximum size of particle partition in y, including guard cells
+! idds = dimensionality of domain decomposition
+! linear interpolation, for distributed data
+! with 2D spatial decomposition
+      implicit none
+      integer, intent(in) :: kstrt, nvpx, nvpy, nxv, nypmx, idds
+      integer, dimension(idds), intent(in) :: nxyp
+      real, dimension(nxv,nypmx), intent(inout) :: f
+      real, dimension(nypmx,2), intent(inout) :: scs
+      real, dimension(nxv), intent(inout) :: scr
+! lgrp = current communicator
+! mreal = default datatype for reals
+! local data
+      integer :: j, k, js, ks, moff, kr, kl
+      integer :: nxp1, nyp1
+      integer :: msid, ierr
+      integer, dimension(lstat) :: istatus
+      nxp1 = nxyp(1) + 1
+      nyp1 = nxyp(2) + 1
+! js/ks = processor co-ordinates in x/y => idproc = js + nvpx*ks
+      ks = (kstrt - 1)/nvpx
+      js = kstrt - nvpx*ks - 1
+      moff = nypmx*nvpy
+! special case for one processor in x
+      if (nvpx==1) then
+         do k = 1, nyp1
+            f(1,k) = f(1,k) + f(nxp1,k)
+            f(nxp1,k) = 0.0
+         enddo
+      else
+! buffer data in x
+         do k = 1, nyp1
+            scs(k,1) = f(nxp1,k)
+         enddo
+! add guard cells in x
+         kr = js + 1
+         if (kr >= nvpx) kr = kr - nvpx
+         kl = js - 1
+         if (kl < 0) kl = kl + nvpx
+         kr = kr + nvpx*ks
+         kl = kl + nvpx*ks
+! this segment is used for mpi computers
+         call MPI_IRECV(scs(1,2),nypmx,mreal,kl,moff+1,lgrp,msid,ierr)
+         call MPI_SEND(scs,nyp1,mreal,kr,moff+1,lgrp,ierr)
+         call MPI_WAIT(msid,istatus,ierr)
+! add up the guard cells
+         do k = 1, nyp1
+            f(1,k) = f(1,k) + scs(k,2)
+            f(nxp1,k) = 0.0
+         enddo
+      endif
+! special case for one processor in y
+      if (nvpy==1) then
+         do j = 1, nxp1
+            f(j,1) = f(j,1) + f(j,nyp1)
+            f(j,nyp1) = 0.0
+         enddo
+         return
+      endif
+! add guard cells in y
+      kr = ks + 1
+      if (kr >= nvpy) kr = kr - nvpy
+      kl = ks - 1
+      if (kl < 0) kl = kl + nvpy
+      kr = js + nvpx*kr
+      kl = js + nvpx*kl
+! this segment is used for mpi computers
+      call MPI_IRECV(scr,nxv,mreal,kl,moff+2,lgrp,msid,ierr)
+      call MPI_SEND(f(1,nyp1),nxv,mreal,kr,moff+2,lgrp,ierr)
+      call MPI_WAIT(msid,istatus,ierr)
+! add up the guard cells
+      do j = 1, nxp1
+         f(j,1) = f(j,1) + scr(j)
+         f(j,nyp1) = 0.0
+      enddo
+      end subroutine
+!
 !-----------------------------------------------------------------------
       subroutine PPTPOSE(f,g,s,t,nx,ny,kxp,kyp,kstrt,nvp,nxv,nyv,kxpd,  &
      &kypd)
@@ -626,64 +1064,439 @@
       end subroutine
 !
 !-----------------------------------------------------------------------
-      subroutine PPMOVE2(part,edges,npp,sbufr,sbufl,rbufr,rbufl,ihole,ny&
-     &,kstrt,nvp,idimp,npmax,idps,nbmax,ntmax,info)
-! this subroutine moves particles into appropriate spatial regions
-! periodic boundary conditions
-! output: part, npp, sbufr, sbufl, rbufr, rbufl, info
-! part(1,n) = position x of particle n in partition
-! part(2,n) = position y of particle n in partition
-! part(3,n) = velocity vx of particle n in partition
-! part(4,n) = velocity vy of particle n in partition
-! edges(1:2) = lower:lower boundary of particle partition
-! npp = number of particles in partition
-! sbufl = buffer for particles being sent to lower processor
-! sbufr = buffer for particles being sent to upper processor
-! rbufl = buffer for particles being received from lower processor
-! rbufr = buffer for particles being received from upper processor
-! ihole = location of holes left in particle arrays
-! ny = system length in y direction
+      subroutine PPTPOSENB(f,g,s,t,nx,ny,kxp,kyp,kstrt,nvp,nxv,nyv,kxpd,&
+     &kypd)
+! this subroutine performs a transpose of a matrix f, distributed in y,
+! to a matrix g, distributed in x, that is,
+! g(k+kyp*(m-1),j,l) = f(j+kxp*(l-1),k,m), where
+! 1 <= j <= kxp, 1 <= k <= kyp, 1 <= l <= nx/kxp, 1 <= m <= ny/kyp
+! and where indices l and m can be distributed across processors.
+! this subroutine posts all receives first, then sends all messages
+! asynchronously, unpacking data in the order it arrives, so that
+! packing and unpacking overlap with communication.
+! it requires nvp times the scratch memory of PPTPOSE
+! f = complex input array
+! g = complex output array
+! s, t = complex scratch arrays, of size kxp*kyp*nvp
+! nx/ny = number of points in x/y
+! kxp/kyp = number of data values per block in x/y
 ! kstrt = starting data block number
 ! nvp = number of real or virtual processors
-! idimp = size of phase space = 4
-! npmax = maximum number of particles in each partition.
-! idps = number of partition boundaries
-! nbmax =  size of buffers for passing particles between processors
-! ntmax =  size of hole array for particles leaving processors
-! info = status information
-! info(1) = ierr = (0,N) = (no,yes) error condition exists
-! info(2) = maximum number of particles per processor
-! info(3) = minimum number of particles per processor
-! info(4) = maximum number of buffer overflows
-! info(5) = maximum number of particle passes required
+! nxv/nyv = first dimension of f/g
+! kypd/kxpd = second dimension of f/g
       implicit none
-      integer, intent(in) :: ny, kstrt, nvp, idimp, npmax, idps
-      integer, intent(in) :: nbmax, ntmax
-      integer, intent(inout) :: npp
-      real, dimension(idimp,npmax), intent(inout) :: part
-      real, dimension(idps), intent(in) :: edges
-      real, dimension(idimp,nbmax), intent(inout) :: sbufl, sbufr, rbufl, rbufr
-      integer, dimension(ntmax+1), intent(inout) :: ihole
-      integer, dimension(5), intent(inout) :: info
-! lgrp = current communicator
-! mint = default datatype for integers
-! mreal = default datatype for reals
-! local data
-! iy = partitioned co-ordinate
-      integer, parameter :: iy = 2
-      integer :: ierr, ks, ih, iter, nps, itg, kl, kr, j, j1, j2, i
-      integer :: joff, jin, nbsize, nter, mter, itermax
-      real :: any, yt
-      integer, dimension(4) :: msid
-      integer, dimension(lstat) :: istatus
-      integer, dimension(2) :: jsl, jsr, jss
-      integer, dimension(4) :: ibflg, iwork
-      any = real(ny)
-      ks = kstrt - 1
-      nbsize = idimp*nbmax
-      iter = 2
-      nter = 0
-      info(1) = 0
+      integer, intent(in) :: nx, ny, kxp, kyp, kstrt, nvp, nxv, nyv
+      integer, intent(in) :: kxpd, kypd
+      complex, dimension(nxv,kypd), intent(in) :: f
+      complex, dimension(nyv,kxpd), intent(inout) :: g
+      complex, dimension(kxp*kyp,nvp), intent(inout) :: s, t
+      call PPNTPOSENB(f,g,s,t,nx,ny,kxp,kyp,kstrt,nvp,1,nxv,nyv,kxpd,   &
+     &kypd)
+      end subroutine
+!
+!-----------------------------------------------------------------------
+      subroutine PPNTPOSENB(f,g,s,t,nx,ny,kxp,kyp,kstrt,nvp,ndim,nxv,nyv&
+     &,kxpd,kypd)
+! this subroutine performs a transpose of a matrix f, distributed in y,
+! to a matrix g, distributed in x, that is,
+! g(1:ndim,k+kyp*(m-1),j,l) = f(1:ndim,j+kxp*(l-1),k,m), where
+! 1 <= j <= kxp, 1 <= k <= kyp, 1 <= l <= nx/kxp, 1 <= m <= ny/kyp
+! and where indices l and m can be distributed across processors.
+! this subroutine posts all receives first, then sends all messages
+! asynchronously, unpacking data in the order it arrives, so that
+! packing and unpacking overlap with communication.
+! the local block is copied directly.
+! it requires nvp times the scratch memory of PPNTPOSE
+! f = complex input array
+! g = complex output array
+! s, t = complex scratch arrays, of size ndim*kxp*kyp*nvp
+! nx/ny = number of points in x/y
+! kxp/kyp = number of data values per block in x/y
+! kstrt = starting data block number
+! nvp = number of real or virtual processors
+! ndim = leading dimension of arrays f and g
+! nxv/nyv = first dimension of f/g
+! kypd/kxpd = second dimension of f/g
+      implicit none
+      integer, intent(in) :: nx, ny, kxp, kyp, kstrt, nvp, ndim
+      integer, intent(in) :: nxv, nyv, kxpd, kypd
+      complex, dimension(ndim,nxv,kypd), intent(in) :: f
+      complex, dimension(ndim,nyv,kxpd), intent(inout) :: g
+      complex, dimension(ndim,kxp*kyp,nvp), intent(inout) :: s, t
+! lgrp = current communicator
+! mcplx = default datatype for complex
+! local data
+      integer :: i, n, j, k, ks, kxps, kyps, kxyp, id, joff, koff, ld
+      integer :: ierr
+      logical :: flag
+      integer, dimension(nvp) :: msid, mrid
+      integer, dimension(lstat) :: istatus
+      ks = kstrt - 1
+      kxps = min(kxp,max(0,nx-kxp*ks))
+      kyps = min(kyp,max(0,ny-kyp*ks))
+      kxyp = ndim*kxp*kyp
+! special case for one processor
+      if (nvp==1) then
+         do k = 1, kyp
+            do j = 1, kxp
+               do i = 1, ndim
+                  g(i,k,j) = f(i,j,k)
+               enddo
+            enddo
+         enddo
+         return
+      endif
+! post all receives, data from processor id is stored in block id+1
+      do n = 1, nvp
+         id = n - ks - 1
+         if (id.lt.0) id = id + nvp
+         if (id /= ks) then
+            call MPI_IRECV(t(1,1,id+1),kxyp,mcplx,id,n,lgrp,mrid(id+1),  &
+     &ierr)
+         endif
+      enddo
+      mrid(ks+1) = MPI_REQUEST_NULL
+      msid(ks+1) = MPI_REQUEST_NULL
+! extract and send data, data to processor id is stored in block id+1
+      do n = 1, nvp
+         id = n - ks - 1
+         if (id.lt.0) id = id + nvp
+         if (id==ks) cycle
+         joff = kxp*id
+         ld = min(kxp,max(0,nx-joff))
+         do k = 1, kyps
+            do j = 1, ld
+               do i = 1, ndim
+                  s(i,j+ld*(k-1),id+1) = f(i,j+joff,k)
+               enddo
+            enddo
+         enddo
+         ld = ndim*ld*kyps
+         call MPI_ISEND(s(1,1,id+1),ld,mcplx,id,n,lgrp,msid(id+1),ierr)
+! insert any data which has already arrived
+         flag = .true.
+         do while (flag)
+            call MPI_TESTANY(nvp,mrid,id,flag,istatus,ierr)
+            if (id==MPI_UNDEFINED) flag = .false.
+            if (flag) then
+               call PPNTUNPACK(g,t(1,1,id),id-1,ny,kxp,kxps,kyp,ndim,nyv&
+     &,kxpd)
+            endif
+         enddo
+      enddo
+! copy local block while messages are in flight
+      joff = kxp*ks
+      koff = kyp*ks
+      do k = 1, kyps
+         do j = 1, kxps
+            do i = 1, ndim
+               g(i,k+koff,j) = f(i,j+joff,k)
+            enddo
+         enddo
+      enddo
+! insert remaining data as it arrives
+      do n = 2, nvp
+         call MPI_WAITANY(nvp,mrid,id,istatus,ierr)
+         if (id==MPI_UNDEFINED) exit
+         call PPNTUNPACK(g,t(1,1,id),id-1,ny,kxp,kxps,kyp,ndim,nyv,kxpd)
+      enddo
+! wait for sends to complete
+      call MPI_WAITALL(nvp,msid,MPI_STATUSES_IGNORE,ierr)
+      end subroutine
+!
+!-----------------------------------------------------------------------
+      subroutine PPNTUNPACK(g,t,id,ny,kxp,kxps,kyp,ndim,nyv,kxpd)
+! this subroutine inserts a block of transposed data t, received from
+! processor id, into g.  used by PPNTPOSENB
+      implicit none
+      integer, intent(in) :: id, ny, kxp, kxps, kyp, ndim, nyv, kxpd
+      complex, dimension(ndim,nyv,kxpd), intent(inout) :: g
+      complex, dimension(ndim,kxp*kyp), intent(in) :: t
+! local data
+      integer :: i, j, k, koff, ld
+      koff = kyp*id
+      ld = min(kyp,max(0,ny-koff))
+      do k = 1, ld
+         do j = 1, kxps
+            do i = 1, ndim
+               g(i,k+koff,j) = t(i,j+kxps*(k-1))
+            enddo
+         enddo
+      enddo
+      end subroutine
+!
+!-----------------------------------------------------------------------
+      subroutine PPFMOVE2(f,g,noff,nyp,noffd,nypd,kstrt,nvp,nxv,nypmx,  &
+     &nypmxd)
+! this subroutine moves field data from one partition to another,
+! for example from a non-uniform particle partition to the uniform
+! partition used by the fft, or back.
+! each processor sends the rows it owns to every processor whose new
+! partition overlaps them, posting all messages at once.
+! rows are contiguous, so no packing is needed.  guard cells are not
+! moved.
+! f(j,k) = real data for grid j,k in input partition
+! g(j,k) = real data for grid j,k in output partition
+! output: g
+! noff/nyp = lowermost global gridpoint/number of primary gridpoints
+! in input partition
+! noffd/nypd = lowermost global gridpoint/number of primary gridpoints
+! in output partition
+! kstrt = starting data block number
+! nvp = number of real or virtual processors
+! nxv = first dimension of f and g
+! nypmx/nypmxd = second dimension of f/g
+      implicit none
+      integer, intent(in) :: noff, nyp, noffd, nypd, kstrt, nvp, nxv
+      integer, intent(in) :: nypmx, nypmxd
+      real, dimension(nxv,nypmx), intent(in) :: f
+      real, dimension(nxv,nypmxd), intent(inout) :: g
+! lgrp = current communicator
+! mreal = default datatype for reals
+! mint = default datatype for integers
+! local data
+      integer :: j, k, n, ks, kl, kr, moff, ierr
+      integer, dimension(4) :: mpart
+      integer, dimension(4,nvp) :: mparts
+      integer, dimension(nvp) :: msid, mrid
+! special case for one processor
+      if (nvp==1) then
+         do k = 1, nypd
+            do j = 1, nxv
+               g(j,k) = f(j,k)
+            enddo
+         enddo
+         return
+      endif
+      ks = kstrt - 1
+      moff = nypmx*nvp + 3
+! find input and output partitions of all processors
+      mpart(1) = noff
+      mpart(2) = nyp
+      mpart(3) = noffd
+      mpart(4) = nypd
+      call MPI_ALLGATHER(mpart,4,mint,mparts,4,mint,lgrp,ierr)
+! post receives for rows of output partition held by other processors
+      do n = 1, nvp
+         mrid(n) = MPI_REQUEST_NULL
+         kl = max(noffd,mparts(1,n))
+         kr = min(noffd+nypd,mparts(1,n)+mparts(2,n))
+         if ((kr > kl).and.(n /= (ks+1))) then
+            call MPI_IRECV(g(1,kl-noffd+1),nxv*(kr-kl),mreal,n-1,moff,  &
+     &lgrp,mrid(n),ierr)
+         endif
+      enddo
+! send rows of input partition needed by other processors
+      do n = 1, nvp
+         msid(n) = MPI_REQUEST_NULL
+         kl = max(noff,mparts(3,n))
+         kr = min(noff+nyp,mparts(3,n)+mparts(4,n))
+         if (kr > kl) then
+            if (n /= (ks+1)) then
+               call MPI_ISEND(f(1,kl-noff+1),nxv*(kr-kl),mreal,n-1,moff,&
+     &lgrp,msid(n),ierr)
+! copy local rows directly
+            else
+               do k = kl+1, kr
+                  do j = 1, nxv
+                     g(j,k-noffd) = f(j,k-noff)
+                  enddo
+               enddo
+            endif
+         endif
+      enddo
+! wait for messages to complete
+      call MPI_WAITALL(nvp,mrid,MPI_STATUSES_IGNORE,ierr)
+      call MPI_WAITALL(nvp,msid,MPI_STATUSES_IGNORE,ierr)
+      end subroutine
+!
+!-----------------------------------------------------------------------
+      subroutine PPFMOVE22(f,g,scs,scr,noff,nxyp,noffd,nxypd,ndim,kstrt,&
+     &nvp,nxv,nypmx,nxvd,nypmxd,idds)
+! this subroutine moves field data from one partition to another,
+! where both partitions may be divided in x and y, for example from
+! the 2D particle partition to the uniform partition in y used by the
+! fft, or back.
+! each processor packs the rectangle it shares with every other
+! processor's new partition and sends it, posting all messages at once.
+! guard cells are not moved.
+! f(n,j,k) = real data for grid j,k in input partition
+! g(n,j,k) = real data for grid j,k in output partition
+! output: g, scs, scr
+! scs/scr = scratch arrays for data sent/received, of size at least
+! ndim*nxyp(1)*nxyp(2) and ndim*nxypd(1)*nxypd(2), respectively
+! noff(1:2)/nxyp(1:2) = leftmost and lowermost global gridpoint/number
+! of primary gridpoints in x and y in input partition
+! noffd(1:2)/nxypd(1:2) = leftmost and lowermost global gridpoint/
+! number of primary gridpoints in x and y in output partition
+! processors which do not hold any data in a partition should set
+! nxyp or nxypd to zero
+! ndim = leading dimension of arrays f and g
+! kstrt = starting data block number
+! nvp = number of real or virtual processors
+! nxv/nypmx = second/third dimension of f
+! nxvd/nypmxd = second/third dimension of g
+! idds = dimensionality of domain decomposition = 2
+      implicit none
+      integer, intent(in) :: ndim, kstrt, nvp, nxv, nypmx, nxvd, nypmxd
+      integer, intent(in) :: idds
+      integer, dimension(idds), intent(in) :: noff, nxyp, noffd, nxypd
+      real, dimension(ndim,nxv,nypmx), intent(in) :: f
+      real, dimension(ndim,nxvd,nypmxd), intent(inout) :: g
+      real, dimension(*), intent(inout) :: scs, scr
+! lgrp = current communicator
+! mreal = default datatype for reals
+! mint = default datatype for integers
+! local data
+      integer :: i, j, k, n, ks, moff, ierr
+      integer :: jl, jr, kl, kr, joff, ioff
+      integer, dimension(8) :: mpart
+      integer, dimension(8,nvp) :: mparts
+      integer, dimension(nvp) :: msid, mrid
+      ks = kstrt - 1
+      moff = nypmx*nvp + 3
+! find input and output partitions of all processors
+      mpart(1) = noff(1)
+      mpart(2) = noff(2)
+      mpart(3) = nxyp(1)
+      mpart(4) = nxyp(2)
+      mpart(5) = noffd(1)
+      mpart(6) = noffd(2)
+      mpart(7) = nxypd(1)
+      mpart(8) = nxypd(2)
+      call MPI_ALLGATHER(mpart,8,mint,mparts,8,mint,lgrp,ierr)
+! post receives for data in output partition held by other processors
+      ioff = 0
+      do n = 1, nvp
+         mrid(n) = MPI_REQUEST_NULL
+         jl = max(noffd(1),mparts(1,n))
+         jr = min(noffd(1)+nxypd(1),mparts(1,n)+mparts(3,n))
+         kl = max(noffd(2),mparts(2,n))
+         kr = min(noffd(2)+nxypd(2),mparts(2,n)+mparts(4,n))
+         if ((jr > jl).and.(kr > kl).and.(n /= (ks+1))) then
+            call MPI_IRECV(scr(ioff+1),ndim*(jr-jl)*(kr-kl),mreal,n-1,  &
+     &moff,lgrp,mrid(n),ierr)
+            ioff = ioff + ndim*(jr - jl)*(kr - kl)
+         endif
+      enddo
+! pack and send data in input partition needed by other processors
+      joff = 0
+      do n = 1, nvp
+         msid(n) = MPI_REQUEST_NULL
+         jl = max(noff(1),mparts(5,n))
+         jr = min(noff(1)+nxyp(1),mparts(5,n)+mparts(7,n))
+         kl = max(noff(2),mparts(6,n))
+         kr = min(noff(2)+nxyp(2),mparts(6,n)+mparts(8,n))
+         if ((jr > jl).and.(kr > kl)) then
+            if (n /= (ks+1)) then
+               ioff = joff
+               do k = kl+1, kr
+                  do j = jl+1, jr
+                     do i = 1, ndim
+                        scs(ioff+i) = f(i,j-noff(1),k-noff(2))
+                     enddo
+                     ioff = ioff + ndim
+                  enddo
+               enddo
+               call MPI_ISEND(scs(joff+1),ioff-joff,mreal,n-1,moff,lgrp,&
+     &msid(n),ierr)
+               joff = ioff
+! copy local data directly
+            else
+               do k = kl+1, kr
+                  do j = jl+1, jr
+                     do i = 1, ndim
+                        g(i,j-noffd(1),k-noffd(2)) =                    &
+     &f(i,j-noff(1),k-noff(2))
+                     enddo
+                  enddo
+               enddo
+            endif
+         endif
+      enddo
+! wait for data to arrive
+      call MPI_WAITALL(nvp,mrid,MPI_STATUSES_IGNORE,ierr)
+! unpack received data
+      ioff = 0
+      do n = 1, nvp
+         jl = max(noffd(1),mparts(1,n))
+         jr = min(noffd(1)+nxypd(1),mparts(1,n)+mparts(3,n))
+         kl = max(noffd(2),mparts(2,n))
+         kr = min(noffd(2)+nxypd(2),mparts(2,n)+mparts(4,n))
+         if ((jr > jl).and.(kr > kl).and.(n /= (ks+1))) then
+            do k = kl+1, kr
+               do j = jl+1, jr
+                  do i = 1, ndim
+                     g(i,j-noffd(1),k-noffd(2)) = scr(ioff+i)
+                  enddo
+                  ioff = ioff + ndim
+               enddo
+            enddo
+         endif
+      enddo
+! make sure sent data can be reused
+      call MPI_WAITALL(nvp,msid,MPI_STATUSES_IGNORE,ierr)
+      end subroutine
+!
+!-----------------------------------------------------------------------
+      subroutine PPMOVE2(part,edges,npp,sbufr,sbufl,rbufr,rbufl,ihole,ny&
+     &,kstrt,nvp,idimp,npmax,idps,nbmax,ntmax,info)
+! this subroutine moves particles into appropriate spatial regions
+! periodic boundary conditions
+! output: part, npp, sbufr, sbufl, rbufr, rbufl, info
+! part(1,n) = position x of particle n in partition
+! part(2,n) = position y of particle n in partition
+! part(3,n) = velocity vx of particle n in partition
+! part(4,n) = velocity vy of particle n in partition
+! edges(1:2) = lower:lower boundary of particle partition
+! npp = number of particles in partition
+! sbufl = buffer for particles being sent to lower processor
+! sbufr = buffer for particles being sent to upper processor
+! rbufl = buffer for particles being received from lower processor
+! rbufr = buffer for particles being received from upper processor
+! ihole = location of holes left in particle arrays
+! ny = system length in y direction
+! kstrt = starting data block number
+! nvp = number of real or virtual processors
+! idimp = size of phase space = 4
+! npmax = maximum number of particles in each partition.
+! idps = number of partition boundaries
+! nbmax =  size of buffers for passing particles between processors
+! ntmax =  size of hole array for particles leaving processors
+! info = status information
+! info(1) = ierr = (0,N) = (no,yes) error condition exists
+! info(2) = maximum number of particles per processor
+! info(3) = minimum number of particles per processor
+! info(4) = maximum number of buffer overflows
+! info(5) = maximum number of particle passes required
+      implicit none
+      integer, intent(in) :: ny, kstrt, nvp, idimp, npmax, idps
+      integer, intent(in) :: nbmax, ntmax
+      integer, intent(inout) :: npp
+      real, dimension(idimp,npmax), intent(inout) :: part
+      real, dimension(idps), intent(in) :: edges
+      real, dimension(idimp,nbmax), intent(inout) :: sbufl, sbufr, rbufl, rbufr
+      integer, dimension(ntmax+1), intent(inout) :: ihole
+      integer, dimension(5), intent(inout) :: info
+! lgrp = current communicator
+! mint = default datatype for integers
+! mreal = default datatype for reals
+! local data
+! iy = partitioned co-ordinate
+      integer, parameter :: iy = 2
+      integer :: ierr, ks, ih, iter, nps, itg, kl, kr, j, j1, j2, i
+      integer :: joff, jin, nbsize, nter, mter, itermax
+      real :: any, yt
+      integer, dimension(4) :: msid
+      integer, dimension(lstat) :: istatus
+      integer, dimension(2) :: jsl, jsr, jss
+      integer, dimension(4) :: ibflg, iwork
+      any = real(ny)
+      ks = kstrt - 1
+      nbsize = idimp*nbmax
+      iter = 2
+      nter = 0
+      info(1) = 0
       info(5) = 0
       ih = ihole(1)
       joff = 1
@@ -971,6 +1784,558 @@
          write (2,*) 'Info: ', nter, ' buffer overflows, nbmax=', nbmax
       endif
       end subroutine
+!
+!-----------------------------------------------------------------------
+      subroutine PPMOVE2NB(part,edges,npp,sbuf,ihole,ny,kstrt,nvp,idimp,&
+     &npmax,idps,ntmax,info)
+! this subroutine moves particles into appropriate spatial regions
+! periodic boundary conditions
+! particles leaving the partition are sorted by destination processor
+! in one pass, then delivered directly to that processor with one
+! message, however many partitions they cross.  the number of particles
+! each processor will receive is exchanged first, then the particles
+! themselves, posting all messages at once.  if the particle array
+! would overflow, the error is returned before any particles are
+! moved, so part and npp are unchanged.
+! output: part, npp, sbuf, info
+! part(1,n) = position x of particle n in partition
+! part(2,n) = position y of particle n in partition
+! part(3,n) = velocity vx of particle n in partition
+! part(4,n) = velocity vy of particle n in partition
+! edges(1:2) = lower:upper boundary of particle partition
+! npp = number of particles in partition
+! sbuf = buffer for particles being sent
+! ihole = location of holes left in particle arrays
+! ny = system length in y direction
+! kstrt = starting data block number
+! nvp = number of real or virtual processors
+! idimp = size of phase space = 4
+! npmax = maximum number of particles in each partition.
+! idps = number of partition boundaries
+! ntmax =  size of hole array for particles leaving processors
+! info = status information
+! info(1) = ierr = (0,N) = (no,yes) error condition exists
+! info(2) = maximum number of particles per processor
+! info(3) = minimum number of particles per processor
+! info(4) = maximum number of buffer overflows = 0
+! info(5) = maximum number of particle passes required = 1
+      implicit none
+      integer, intent(in) :: ny, kstrt, nvp, idimp, npmax, idps, ntmax
+      integer, intent(inout) :: npp
+      real, dimension(idimp,npmax), intent(inout) :: part
+      real, dimension(idps), intent(in) :: edges
+      real, dimension(idimp,ntmax), intent(inout) :: sbuf
+      integer, dimension(ntmax+1), intent(inout) :: ihole
+      integer, dimension(5), intent(inout) :: info
+! lgrp = current communicator
+! mint = default datatype for integers
+! mreal = default datatype for reals
+! local data
+! iy = partitioned co-ordinate
+      integer, parameter :: iy = 2
+      integer :: ierr, ks, ih, nps, nin, j, j1, j2, i, n, nl, nr, moff
+      real :: any, yt
+      real, dimension(nvp) :: eds
+      integer, dimension(nvp) :: scnt, sdsp, rcnt, rdsp, msid, mrid
+      integer, dimension(2) :: ibflg, iwork
+      any = real(ny)
+      ks = kstrt - 1
+      moff = 2
+      info(1) = 0
+      info(4) = 0
+      info(5) = 1
+      ih = ihole(1)
+! find lower boundaries of all partitions
+      call MPI_ALLGATHER(edges,1,mreal,eds,1,mreal,lgrp,ierr)
+! count particles going to each processor
+      scnt = 0
+      do j = 1, ih
+         j1 = ihole(j+1)
+         yt = part(iy,j1)
+         if (yt < 0.0) yt = yt + any
+         if (yt >= any) yt = yt - any
+! find last partition whose lower boundary is not above particle
+         nl = 1
+         nr = nvp
+         do while (nl < nr)
+            n = (nl + nr + 1)/2
+            if (yt >= eds(n)) then
+               nl = n
+            else
+               nr = n - 1
+            endif
+         enddo
+         scnt(nl) = scnt(nl) + 1
+      enddo
+      nps = 0
+      do n = 1, nvp
+         sdsp(n) = nps
+         nps = nps + scnt(n)
+      enddo
+! exchange number of particles going to each processor
+      call MPI_ALLTOALL(scnt,1,mint,rcnt,1,mint,lgrp,ierr)
+      nin = 0
+      do n = 1, nvp
+         rdsp(n) = npp - ih + nin
+         nin = nin + rcnt(n)
+      enddo
+! check if move would overflow particle array
+      nps = npp - ih + nin
+      ibflg(1) = nps
+      ibflg(2) = -min0(npmax,nps)
+      call PPIMAX(ibflg,iwork,2)
+      info(2) = ibflg(1)
+      info(3) = -ibflg(2)
+      ierr = ibflg(1) - npmax
+      if (ierr > 0) then
+         write (2,*) 'particle overflow error, ierr = ', ierr
+         info(1) = ierr
+         return
+      endif
+! copy outgoing particles into buffer, sorted by destination
+      do j = 1, ih
+         j1 = ihole(j+1)
+         yt = part(iy,j1)
+         if (yt < 0.0) yt = yt + any
+         if (yt >= any) yt = yt - any
+         nl = 1
+         nr = nvp
+         do while (nl < nr)
+            n = (nl + nr + 1)/2
+            if (yt >= eds(n)) then
+               nl = n
+            else
+               nr = n - 1
+            endif
+         enddo
+         sdsp(nl) = sdsp(nl) + 1
+         j2 = sdsp(nl)
+         do i = 1, idimp
+            sbuf(i,j2) = part(i,j1)
+         enddo
+         sbuf(iy,j2) = yt
+      enddo
+      do n = 1, nvp
+         sdsp(n) = sdsp(n) - scnt(n)
+      enddo
+! fill up holes in particle array with particles from bottom
+      do j = 1, ih
+         j1 = npp - j + 1
+         j2 = ihole(ih-j+2)
+         if (j1 > j2) then
+! move particle only if it is below current hole
+            do i = 1, idimp
+               part(i,j2) = part(i,j1)
+            enddo
+         endif
+      enddo
+      npp = npp - ih
+! post receives directly into the bottom of the particle array
+      do n = 1, nvp
+         mrid(n) = MPI_REQUEST_NULL
+         if ((rcnt(n) > 0).and.(n /= (ks+1))) then
+            call MPI_IRECV(part(1,rdsp(n)+1),idimp*rcnt(n),mreal,n-1,   &
+     &moff,lgrp,mrid(n),ierr)
+         endif
+      enddo
+! send particles, copy particles staying here directly
+      do n = 1, nvp
+         msid(n) = MPI_REQUEST_NULL
+         if (scnt(n) > 0) then
+            if (n /= (ks+1)) then
+               call MPI_ISEND(sbuf(1,sdsp(n)+1),idimp*scnt(n),mreal,n-1,&
+     &moff,lgrp,msid(n),ierr)
+            else
+               do j = 1, scnt(n)
+                  do i = 1, idimp
+                     part(i,j+rdsp(n)) = sbuf(i,j+sdsp(n))
+                  enddo
+               enddo
+            endif
+         endif
+      enddo
+! wait for messages to complete
+      call MPI_WAITALL(nvp,mrid,MPI_STATUSES_IGNORE,ierr)
+      call MPI_WAITALL(nvp,msid,MPI_STATUSES_IGNORE,ierr)
+      npp = npp + nin
+      end subroutine
+!
+!-----------------------------------------------------------------------
+      subroutine PPMOVEG22(part,edges,npp,sbufr,sbufl,rbufr,rbufl,ihole,&
+     &nx,ny,kstrt,nvpx,nvpy,idimp,npmax,idps,nbmax,ntmax,info)
+! this subroutine moves particles into appropriate spatial regions
+! ihole array is calculated from particles co-ordinates
+! with periodic boundary conditions and 2D spatial decomposition
+! output: part, ihole, npp, sbufr, sbufl, rbufr, rbufl, info
+! part(1,n) = position x of particle n in partition
+! part(2,n) = position y of particle n in partition
+! part(3,n) = velocity vx of particle n in partition
+! part(4,n) = velocity vy of particle n in partition
+! edges(1:2) = left/right boundary in x of particle partition
+! edges(3:4) = lower/upper boundary in y of particle partition
+! npp = number of particles in partition
+! sbufl = buffer for particles being sent to left or lower processor
+! sbufr = buffer for particles being sent to right or upper processor
+! rbufl = buffer for particles being received from left or lower
+! processor
+! rbufr = buffer for particles being received from right or upper
+! processor
+! ihole = location of holes left in particle arrays
+! nx/ny = system length in x/y direction
+! kstrt = starting data block number
+! nvpx/nvpy = number of real or virtual processors in x/y
+! idimp = size of phase space = 4
+! npmax = maximum number of particles in each partition.
+! idps = number of particle partition boundaries = 4
+! nbmax =  size of buffers for passing particles between processors
+! ntmax =  size of hole array for particles leaving processors
+! info = status information
+! info(1) = ierr = (0,N) = (no,yes) error condition exists
+! info(2) = maximum number of particles per processor
+! info(3) = minimum number of particles per processor
+! info(4:5) = maximum number of buffer overflows in x/y
+! info(6:7) = maximum number of particle passes required in x/y
+      implicit none
+      integer, intent(in) :: nx, ny, kstrt, nvpx, nvpy, idimp, npmax
+      integer, intent(in) :: idps, nbmax, ntmax
+      integer, intent(inout) :: npp
+      real, dimension(idimp,npmax), intent(inout) :: part
+      real, dimension(idps), intent(in) :: edges
+      real, dimension(idimp,nbmax), intent(inout) :: sbufl, sbufr
+      real, dimension(idimp,nbmax), intent(inout) :: rbufl, rbufr
+      integer, dimension(ntmax+1), intent(inout) :: ihole
+      integer, dimension(7), intent(inout) :: info
+! lgrp = current communicator
+! mint = default datatype for integers
+! mreal = default datatype for reals
+! local data
+! ix/iy = partitioned co-ordinates
+      integer, parameter :: ix = 1, iy = 2
+      integer :: i, j, n, js, ks, ic, nvp, iter, nps, itg, kl, kr, j1, j2
+      integer :: ih, joff, jin, nbsize, nter, mter, itermax, ierr
+      real :: an, xt
+      integer, dimension(4) :: msid
+      integer, dimension(lstat) :: istatus
+      integer, dimension(2) :: kb, jsl, jsr, jss
+      integer, dimension(4) :: ibflg, iwork
+! js/ks = processor co-ordinates in x/y => idproc = js + nvpx*ks
+      ks = (kstrt - 1)/nvpx
+      js = kstrt - nvpx*ks - 1
+      nbsize = idimp*nbmax
+      info(1) = 0
+      info(6) = 0
+      info(7) = 0
+      itermax = 2000
+! buffer outgoing particles, first in x then in y direction
+      do n = 1, 2
+         if (n==1) then
+            ic = ix
+            nvp = nvpx
+            an = real(nx)
+         else if (n==2) then
+            ic = iy
+            nvp = nvpy
+            an = real(ny)
+         endif
+         iter = 2
+         nter = 0
+         joff = 1
+! ih = number of particles extracted from holes
+! joff = next hole location for extraction
+! jss(1) = number of holes available to be filled
+! jin = next hole location to be filled
+! start loop
+   10    mter = 0
+         nps = 0
+         jin = 1
+         kb(1) = js
+         kb(2) = ks
+! buffer outgoing particles
+         jsl(1) = 0
+         jsr(1) = 0
+! load particle buffers
+         do j = 1, npp
+            xt = part(ic,j)
+! particles going left or down
+            if (xt < edges(2*n-1)) then
+               if (kb(n)==0) xt = xt + an
+               if (jsl(1) < nbmax) then
+                  jsl(1) = jsl(1) + 1
+                  do i = 1, idimp
+                     sbufl(i,jsl(1)) = part(i,j)
+                  enddo
+                  sbufl(ic,jsl(1)) = xt
+                  ihole(jsl(1)+jsr(1)+1) = j
+               else
+                  nps = 1
+                  exit
+               endif
+! particles going right or up
+            else if (xt >= edges(2*n)) then
+               if (kb(n)==(nvp-1)) xt = xt - an
+               if (jsr(1) < nbmax) then
+                  jsr(1) = jsr(1) + 1
+                  do i = 1, idimp
+                     sbufr(i,jsr(1)) = part(i,j)
+                  enddo
+                  sbufr(ic,jsr(1)) = xt
+                  ihole(jsl(1)+jsr(1)+1) = j
+               else
+                  nps = 1
+                  exit
+               endif
+            endif
+         enddo
+         jss(1) = jsl(1) + jsr(1)
+         joff = joff + jss(1)
+         ihole(1) = jss(1)
+         ih = 0
+! check for full buffer condition
+         ibflg(3) = nps
+! copy particle buffers
+   60    iter = iter + 2
+         mter = mter + 1
+! special case for one processor
+         if (nvp==1) then
+            jsl(2) = jsr(1)
+            do j = 1, jsl(2)
+               do i = 1, idimp
+                  rbufl(i,j) = sbufr(i,j)
+               enddo
+            enddo
+            jsr(2) = jsl(1)
+            do j = 1, jsr(2)
+               do i = 1, idimp
+                  rbufr(i,j) = sbufl(i,j)
+               enddo
+            enddo
+! this segment is used for mpi computers
+         else
+! get particles from left and right or below and above
+            kb(1) = js
+            kb(2) = ks
+            kl = kb(n)
+            kb(n) = kl + 1
+            if (kb(n) >= nvp) kb(n) = kb(n) - nvp
+            kr = kb(1) + nvpx*kb(2)
+            kb(n) = kl - 1
+            if (kb(n) < 0) kb(n) = kb(n) + nvp
+            kl = kb(1) + nvpx*kb(2)
+! post receive
+            itg = iter - 1
+            call MPI_IRECV(rbufl,nbsize,mreal,kl,itg,lgrp,msid(1),ierr)
+            call MPI_IRECV(rbufr,nbsize,mreal,kr,iter,lgrp,msid(2),ierr)
+! send particles
+            jsr(1) = idimp*jsr(1)
+            call MPI_ISEND(sbufr,jsr(1),mreal,kr,itg,lgrp,msid(3),ierr)
+            jsl(1) = idimp*jsl(1)
+            call MPI_ISEND(sbufl,jsl(1),mreal,kl,iter,lgrp,msid(4),ierr)
+! wait for particles to arrive
+            call MPI_WAIT(msid(1),istatus,ierr)
+            call MPI_GET_COUNT(istatus,mreal,nps,ierr)
+            jsl(2) = nps/idimp
+            call MPI_WAIT(msid(2),istatus,ierr)
+            call MPI_GET_COUNT(istatus,mreal,nps,ierr)
+            jsr(2) = nps/idimp
+         endif
+! check if particles must be passed further
+! check if any particles coming from right or above belong here
+         jsl(1) = 0
+         jsr(1) = 0
+         jss(2) = 0
+         do j = 1, jsr(2)
+            if (rbufr(ic,j) < edges(2*n-1)) jsl(1) = jsl(1) + 1
+            if (rbufr(ic,j) >= edges(2*n)) jsr(1) = jsr(1) + 1
+         enddo
+! check if any particles coming from left or below belong here
+         do j = 1, jsl(2)
+            if (rbufl(ic,j) >= edges(2*n)) jsr(1) = jsr(1) + 1
+            if (rbufl(ic,j) < edges(2*n-1)) jss(2) = jss(2) + 1
+         enddo
+         nps = jsl(1) + jsr(1) + jss(2)
+         ibflg(2) = nps
+! make sure sbufr and sbufl have been sent
+         if (nvp /= 1) then
+            call MPI_WAIT(msid(3),istatus,ierr)
+            call MPI_WAIT(msid(4),istatus,ierr)
+         endif
+         if (nps==0) go to 180
+! remove particles which do not belong here
+         kb(1) = js
+         kb(2) = ks
+! first check particles coming from right or above
+         jsl(1) = 0
+         jsr(1) = 0
+         jss(2) = 0
+         do j = 1, jsr(2)
+            xt = rbufr(ic,j)
+! particles going left or down
+            if (xt < edges(2*n-1)) then
+               jsl(1) = jsl(1) + 1
+               if (kb(n)==0) xt = xt + an
+               rbufr(ic,j) = xt
+               do i = 1, idimp
+                  sbufl(i,jsl(1)) = rbufr(i,j)
+               enddo
+! particles going right or up, should not happen
+            else if (xt >= edges(2*n)) then
+               jsr(1) = jsr(1) + 1
+               if (kb(n)==(nvp-1)) xt = xt - an
+               rbufr(ic,j) = xt
+               do i = 1, idimp
+                  sbufr(i,jsr(1)) = rbufr(i,j)
+               enddo
+! particles staying here
+            else
+               jss(2) = jss(2) + 1
+               do i = 1, idimp
+                  rbufr(i,jss(2)) = rbufr(i,j)
+               enddo
+            endif
+         enddo
+         jsr(2) = jss(2)
+! next check particles coming from left or below
+         jss(2) = 0
+         do j = 1, jsl(2)
+            xt = rbufl(ic,j)
+! particles going right or up
+            if (xt >= edges(2*n)) then
+               if (jsr(1) < nbmax) then
+                  jsr(1) = jsr(1) + 1
+                  if (kb(n)==(nvp-1)) xt = xt - an
+                  rbufl(ic,j) = xt
+                  do i = 1, idimp
+                     sbufr(i,jsr(1)) = rbufl(i,j)
+                  enddo
+               else
+                  jss(2) = 2*npmax
+                  exit
+               endif
+! particles going left or down, should not happen
+            else if (xt < edges(2*n-1)) then
+               if (jsl(1) < nbmax) then
+                  jsl(1) = jsl(1) + 1
+                  if (kb(n)==0) xt = xt + an
+                  rbufl(ic,j) = xt
+                  do i = 1, idimp
+                     sbufl(i,jsl(1)) = rbufl(i,j)
+                  enddo
+               else
+                  jss(2) = 2*npmax
+                  exit
+               endif
+! particles staying here
+            else
+               jss(2) = jss(2) + 1
+               do i = 1, idimp
+                  rbufl(i,jss(2)) = rbufl(i,j)
+               enddo
+            endif
+         enddo
+         jsl(2) = jss(2)
+! check if move would overflow particle array
+  180    nps = npp + jsl(2) + jsr(2) - jss(1)
+         ibflg(1) = nps
+         ibflg(4) = -min0(npmax,nps)
+         call PPIMAX(ibflg,iwork,4)
+         info(2) = ibflg(1)
+         info(3) = -ibflg(4)
+         ierr = ibflg(1) - npmax
+         if (ierr > 0) then
+            write (2,*) 'particle overflow error, ierr = ', ierr
+            info(1) = ierr
+            return
+         endif
+! distribute incoming particles from buffers
+! distribute particles coming from left or below into holes
+         jss(2) = min0(jss(1),jsl(2))
+         do j = 1, jss(2)
+            j1 = ihole(j+jin)
+            do i = 1, idimp
+               part(i,j1) = rbufl(i,j)
+            enddo
+         enddo
+         jin = jin + jss(2)
+         if (jss(1) > jsl(2)) then
+            jss(2) = min0(jss(1)-jsl(2),jsr(2))
+         else
+            jss(2) = jsl(2) - jss(1)
+         endif
+         do j = 1, jss(2)
+! no more particles coming from left or below
+! distribute particles coming from right or above into holes
+            if (jss(1) > jsl(2)) then
+               j1 = ihole(j+jin)
+               do i = 1, idimp
+                  part(i,j1) = rbufr(i,j)
+               enddo
+! no more holes
+! distribute remaining particles from left or below into bottom
+            else
+               do i = 1, idimp
+                  part(i,j+npp) = rbufl(i,j+jss(1))
+               enddo
+            endif
+         enddo
+         if (jss(1) > jsl(2)) jin = jin + jss(2)
+         nps = jsl(2) + jsr(2)
+         if (jss(1) <= jsl(2)) then
+            npp = npp + (jsl(2) - jss(1))
+            jss(1) = jsl(2)
+         endif
+! no more holes
+! distribute remaining particles from right or above into bottom
+         jsr(2) = max0(0,nps-jss(1))
+         jss(1) = jss(1) - jsl(2)
+         do j = 1, jsr(2)
+            do i = 1, idimp
+               part(i,j+npp) = rbufr(i,j+jss(1))
+            enddo
+         enddo
+         npp = npp + jsr(2)
+! holes left over
+! fill up remaining holes in particle array with particles from bottom
+         if (ih==0) then
+            jsr(2) = max0(0,ihole(1)-jin+1)
+            do j = 1, jsr(2)
+               j1 = npp - j + 1
+               j2 = ihole(jsr(2)-j+jin+1)
+               if (j1 > j2) then
+! move particle only if it is below current hole
+                  do i = 1, idimp
+                     part(i,j2) = part(i,j1)
+                  enddo
+               endif
+            enddo
+            jin = jin + jsr(2)
+            npp = npp - jsr(2)
+         endif
+         jss(1) = 0
+! check if any particles have to be passed further
+         if (ibflg(3) > 0) ibflg(3) = 1
+         info(5+n) = max0(info(5+n),mter)
+         if (ibflg(2) > 0) then
+            if (iter < itermax) go to 60
+            ierr = -((iter-2)/2)
+            if (kstrt==1) write (2,*) 'Iteration overflow, iter = ',    &
+     &ierr
+            info(1) = ierr
+            return
+         endif
+! check if buffer overflowed and more particles remain to be checked
+         if (ibflg(3) > 0) then
+            nter = nter + 1
+            info(3+n) = nter
+            go to 10
+         endif
+         if (nter > 0) then
+            if (kstrt==1) then
+               write (2,*) 'Info: ',nter,' buffer overflows, nbmax=',   &
+     &nbmax
+            endif
+         endif
+      enddo
+      end subroutine
 !
       end module
 !
@@ -1073,6 +2438,79 @@
       call SUB(f,scr,nyp,nx,ndim,kstrt,nvp,nxv,nypmx)
       end subroutine
 !
+!-----------------------------------------------------------------------
+      subroutine PPNGUARD2INIT(scs,scr,igds,kstrt,nvp,nxv,nypmx)
+      use pplib2, only: SUB => PPNGUARD2INIT
+      implicit none
+      integer, intent(in) :: kstrt, nvp, nxv, nypmx
+      integer, intent(inout) :: igds
+      real, dimension(nxv), intent(inout) :: scs, scr
+      call SUB(scs,scr,igds,kstrt,nvp,nxv,nypmx)
+      end subroutine
+!
+!-----------------------------------------------------------------------
+      subroutine PPNCGUARD2LP(f,scs,scr,igds,nyp,nvp,nxv)
+      use pplib2, only: SUB => PPNCGUARD2LP
+      implicit none
+      integer, intent(in) :: igds, nyp, nvp, nxv
+      real, dimension(nxv,*), intent(inout) :: f
+      real, dimension(nxv), intent(inout) :: scs, scr
+      call SUB(f,scs,scr,igds,nyp,nvp,nxv)
+      end subroutine
+!
+!-----------------------------------------------------------------------
+      subroutine PPNAGUARD2LP(f,scs,scr,igds,nyp,nx,nvp,nxv)
+      use pplib2, only: SUB => PPNAGUARD2LP
+      implicit none
+      integer, intent(in) :: igds, nyp, nx, nvp, nxv
+      real, dimension(nxv,*), intent(inout) :: f
+      real, dimension(nxv), intent(inout) :: scs, scr
+      call SUB(f,scs,scr,igds,nyp,nx,nvp,nxv)
+      end subroutine
+!
+!-----------------------------------------------------------------------
+      subroutine PPNACGUARD2LP(f,scs,scr,igds,nyp,nx,ndim,nvp,nxv)
+      use pplib2, only: SUB => PPNACGUARD2LP
+      implicit none
+      integer, intent(in) :: igds, nyp, nx, ndim, nvp, nxv
+      real, dimension(ndim,nxv,*), intent(inout) :: f
+      real, dimension(ndim,nxv), intent(inout) :: scs, scr
+      call SUB(f,scs,scr,igds,nyp,nx,ndim,nvp,nxv)
+      end subroutine
+!
+!-----------------------------------------------------------------------
+      subroutine PPNGUARD2FREE(igds)
+      use pplib2, only: SUB => PPNGUARD2FREE
+      implicit none
+      integer, intent(inout) :: igds
+      call SUB(igds)
+      end subroutine
+!
+!-----------------------------------------------------------------------
+      subroutine PPNCGUARD22L(f,scs,nxyp,ndim,kstrt,nvpx,nvpy,nxv,nypmx,&
+     &idds)
+      use pplib2, only: SUB => PPNCGUARD22L
+      implicit none
+      integer, intent(in) :: ndim, kstrt, nvpx, nvpy, nxv, nypmx, idds
+      integer, dimension(idds), intent(in) :: nxyp
+      real, dimension(ndim,nxv,nypmx), intent(inout) :: f
+      real, dimension(ndim,nypmx,2), intent(inout) :: scs
+      call SUB(f,scs,nxyp,ndim,kstrt,nvpx,nvpy,nxv,nypmx,idds)
+      end subroutine
+!
+!-----------------------------------------------------------------------
+      subroutine PPNAGUARD22L(f,scs,scr,nxyp,kstrt,nvpx,nvpy,nxv,nypmx, &
+     &idds)
+      use pplib2, only: SUB => PPNAGUARD22L
+      implicit none
+      integer, intent(in) :: kstrt, nvpx, nvpy, nxv, nypmx, idds
+      integer, dimension(idds), intent(in) :: nxyp
+      real, dimension(nxv,nypmx), intent(inout) :: f
+      real, dimension(nypmx,2), intent(inout) :: scs
+      real, dimension(nxv), intent(inout) :: scr
+      call SUB(f,scs,scr,nxyp,kstrt,nvpx,nvpy,nxv,nypmx,idds)
+      end subroutine
+!
 !-----------------------------------------------------------------------
       subroutine PPTPOSE(f,g,s,t,nx,ny,kxp,kyp,kstrt,nvp,nxv,nyv,kxpd,  &
      &kypd)
@@ -1099,6 +2537,59 @@
       call SUB(f,g,s,t,nx,ny,kxp,kyp,kstrt,nvp,ndim,nxv,nyv,kxpd,kypd)
       end subroutine
 !
+!-----------------------------------------------------------------------
+      subroutine PPTPOSENB(f,g,s,t,nx,ny,kxp,kyp,kstrt,nvp,nxv,nyv,kxpd,&
+     &kypd)
+      use pplib2, only: SUB => PPTPOSENB
+      implicit none
+      integer, intent(in) :: nx, ny, kxp, kyp, kstrt, nvp, nxv, nyv
+      integer, intent(in) :: kxpd, kypd
+      complex, dimension(nxv,kypd), intent(in) :: f
+      complex, dimension(nyv,kxpd), intent(inout) :: g
+      complex, dimension(kxp*kyp,nvp), intent(inout) :: s, t
+      call SUB(f,g,s,t,nx,ny,kxp,kyp,kstrt,nvp,nxv,nyv,kxpd,kypd)
+      end subroutine
+!
+!-----------------------------------------------------------------------
+      subroutine PPNTPOSENB(f,g,s,t,nx,ny,kxp,kyp,kstrt,nvp,ndim,nxv,nyv&
+     &,kxpd,kypd)
+      use pplib2, only: SUB => PPNTPOSENB
+      implicit none
+      integer, intent(in) :: nx, ny, kxp, kyp, kstrt, nvp, ndim
+      integer, intent(in) :: nxv, nyv, kxpd, kypd
+      complex, dimension(ndim,nxv,kypd), intent(in) :: f
+      complex, dimension(ndim,nyv,kxpd), intent(inout) :: g
+      complex, dimension(ndim,kxp*kyp,nvp), intent(inout) :: s, t
+      call SUB(f,g,s,t,nx,ny,kxp,kyp,kstrt,nvp,ndim,nxv,nyv,kxpd,kypd)
+      end subroutine
+!
+!-----------------------------------------------------------------------
+      subroutine PPFMOVE2(f,g,noff,nyp,noffd,nypd,kstrt,nvp,nxv,nypmx,  &
+     &nypmxd)
+      use pplib2, only: SUB => PPFMOVE2
+      implicit none
+      integer, intent(in) :: noff, nyp, noffd, nypd, kstrt, nvp, nxv
+      integer, intent(in) :: nypmx, nypmxd
+      real, dimension(nxv,nypmx), intent(in) :: f
+      real, dimension(nxv,nypmxd), intent(inout) :: g
+      call SUB(f,g,noff,nyp,noffd,nypd,kstrt,nvp,nxv,nypmx,nypmxd)
+      end subroutine
+!
+!-----------------------------------------------------------------------
+      subroutine PPFMOVE22(f,g,scs,scr,noff,nxyp,noffd,nxypd,ndim,kstrt,&
+     &nvp,nxv,nypmx,nxvd,nypmxd,idds)
+      use pplib2, only: SUB => PPFMOVE22
+      implicit none
+      integer, intent(in) :: ndim, kstrt, nvp, nxv, nypmx, nxvd, nypmxd
+      integer, intent(in) :: idds
+      integer, dimension(idds), intent(in) :: noff, nxyp, noffd, nxypd
+      real, dimension(ndim,nxv,nypmx), intent(in) :: f
+      real, dimension(ndim,nxvd,nypmxd), intent(inout) :: g
+      real, dimension(*), intent(inout) :: scs, scr
+      call SUB(f,g,scs,scr,noff,nxyp,noffd,nxypd,ndim,kstrt,nvp,nxv,nypmx&
+     &,nxvd,nypmxd,idds)
+      end subroutine
+!
 !-----------------------------------------------------------------------
       subroutine PPMOVE2(part,edges,npp,sbufr,sbufl,rbufr,rbufl,ihole,ny&
      &,kstrt,nvp,idimp,npmax,idps,nbmax,ntmax,info)
@@ -1116,4 +2607,37 @@
       call SUB(part,edges,npp,sbufr,sbufl,rbufr,rbufl,ihole,ny,kstrt,nvp&
      &,idimp,npmax,idps,nbmax,ntmax,info)
       end subroutine
-
+!
+!-----------------------------------------------------------------------
+      subroutine PPMOVE2NB(part,edges,npp,sbuf,ihole,ny,kstrt,nvp,idimp,&
+     &npmax,idps,ntmax,info)
+      use pplib2, only: SUB => PPMOVE2NB
+      implicit none
+      integer, intent(in) :: ny, kstrt, nvp, idimp, npmax, idps, ntmax
+      integer, intent(inout) :: npp
+      real, dimension(idimp,npmax), intent(inout) :: part
+      real, dimension(idps), intent(in) :: edges
+      real, dimension(idimp,ntmax), intent(inout) :: sbuf
+      integer, dimension(ntmax+1), intent(inout) :: ihole
+      integer, dimension(5), intent(inout) :: info
+      call SUB(part,edges,npp,sbuf,ihole,ny,kstrt,nvp,idimp,npmax,idps, &
+     &ntmax,info)
+      end subroutine
+!
+!-----------------------------------------------------------------------
+      subroutine PPMOVEG22(part,edges,npp,sbufr,sbufl,rbufr,rbufl,ihole,&
+     &nx,ny,kstrt,nvpx,nvpy,idimp,npmax,idps,nbmax,ntmax,info)
+      use pplib2, only: SUB => PPMOVEG22
+      implicit none
+      integer, intent(in) :: nx, ny, kstrt, nvpx, nvpy, idimp, npmax
+      integer, intent(in) :: idps, nbmax, ntmax
+      integer, intent(inout) :: npp
+      real, dimension(idimp,npmax), intent(inout) :: part
+      real, dimension(idps), intent(in) :: edges
+      real, dimension(idimp,nbmax), intent(inout) :: sbufl, sbufr
+      real, dimension(idimp,nbmax), intent(inout) :: rbufl, rbufr
+      integer, dimension(ntmax+1), intent(inout) :: ihole
+      integer, dimension(7), intent(inout) :: info
+      call SUB(part,edges,npp,sbufr,sbufl,rbufr,rbufl,ihole,nx,ny,kstrt, &
+     &nvpx,nvpy,idimp,npmax,idps,nbmax,ntmax,info)
+      end subroutine
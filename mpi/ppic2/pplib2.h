@@ -25,6 +25,28 @@ void cppnaguard2l(float f[], float scr[], int nyp, int nx, int kstrt,
 void cppnacguard2l(float f[], float scr[], int nyp, int nx, int ndim,
                    int kstrt, int nvp, int nxv, int nypmx);
 
+void cppnguard2init(float scs[], float scr[], int *igds, int kstrt,
+                    int nvp, int nxv, int nypmx);
+
+void cppncguard2lp(float f[], float scs[], float scr[], int igds,
+                   int nyp, int nvp, int nxv);
+
+void cppnaguard2lp(float f[], float scs[], float scr[], int igds,
+                   int nyp, int nx, int nvp, int nxv);
+
+void cppnacguard2lp(float f[], float scs[], float scr[], int igds,
+                    int nyp, int nx, int ndim, int nvp, int nxv);
+
+void cppnguard2free(int *igds);
+
+void cppncguard22l(float f[], float scs[], int nxyp[], int ndim,
+                   int kstrt, int nvpx, int nvpy, int nxv, int nypmx,
+                   int idds);
+
+void cppnaguard22l(float f[], float scs[], float scr[], int nxyp[],
+                   int kstrt, int nvpx, int nvpy, int nxv, int nypmx,
+                   int idds);
+
 void cpptpose(float complex f[], float complex g[], float complex s[],
               float complex t[], int nx, int ny, int kxp, int kyp,
               int kstrt, int nvp, int nxv, int nyv, int kxpd, int kypd);
@@ -34,7 +56,56 @@ void cppntpose(float complex f[], float complex g[], float complex s[],
                int kstrt, int nvp, int ndim, int nxv, int nyv, int kxpd,
                int kypd);
 
+void cpptposenb(float complex f[], float complex g[], float complex s[],
+                float complex t[], int nx, int ny, int kxp, int kyp,
+                int kstrt, int nvp, int nxv, int nyv, int kxpd,
+                int kypd);
+
+void cppntposenb(float complex f[], float complex g[], float complex s[],
+                 float complex t[], int nx, int ny, int kxp, int kyp,
+                 int kstrt, int nvp, int ndim, int nxv, int nyv,
+                 int kxpd, int kypd);
+
+void cppfmove2(float f[], float g[], int noff, int nyp, int noffd,
+               int nypd, int kstrt, int nvp, int nxv, int nypmx,
+               int nypmxd);
+
+void cppfmove22(float f[], float g[], float scs[], float scr[],
+                int noff[], int nxyp[], int noffd[], int nxypd[],
+                int ndim, int kstrt, int nvp, int nxv, int nypmx,
+                int nxvd, int nypmxd, int idds);
+
 void cppmove2(float part[], float edges[], int *npp, float sbufr[],
               float sbufl[], float rbufr[], float rbufl[], int ihole[],
               int ny, int kstrt, int nvp, int idimp, int npmax, int idps,
               int nbmax, int ntmax, int info[]);
+
+void cppmove2nb(float part[], float edges[], int *npp, float sbuf[],
+                int ihole[], int ny, int kstrt, int nvp, int idimp,
+                int npmax, int idps, int ntmax, int info[]);
+
+void cppmoveg22(float part[], float edges[], int *npp, float sbufr[],
+                float sbufl[], float rbufr[], float rbufl[],
+                int ihole[], int nx, int ny, int kstrt, int nvpx,
+                int nvpy, int idimp, int npmax, int idps, int nbmax,
+                int ntmax, int info[]);
+
+void cppwchkpth2(char *fname, int nis, int isc[], int nfs, float fsc[],
+                 int *irc);
+
+void cppwchkpta2(float f[], int nrow, int nrp, int noffr, int nrows);
+
+void cppwchkptp2(float part[], int npp, int idimp, int npmax);
+
+void cppwchkptc2(int *irc);
+
+void cpprchkpth2(char *fname, int nis, int isc[], int nfs, float fsc[],
+                 int *nvpo, int *irc);
+
+void cpprchkpta2(int n, float f[], int nrow, int nrp, int noffr,
+                 int nrows, int *irc);
+
+void cpprchkptp2(int n, float part[], int *npp, int idimp, int npmax,
+                 int *irc);
+
+void cpprchkptc2();
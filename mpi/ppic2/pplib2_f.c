@@ -1,6 +1,9 @@
 /* Basic parallel PIC library for MPI communications */
 /* Wrappers for calling the Fortran routines from a C main program */
 
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
 #include <complex.h>
 
 void ppinit2_(int *idproc, int *nvp, int *argc, char *argv[]);
@@ -28,6 +31,28 @@ void ppnaguard2l_(float *f, float *scr, int *nyp, int *nx, int *kstrt,
 void ppnacguard2l_(float *f, float *scr, int *nyp, int *nx, int *ndim,
                    int *kstrt, int *nvp, int *nxv, int *nypmx);
 
+void ppnguard2init_(float *scs, float *scr, int *igds, int *kstrt,
+                    int *nvp, int *nxv, int *nypmx);
+
+void ppncguard2lp_(float *f, float *scs, float *scr, int *igds,
+                   int *nyp, int *nvp, int *nxv);
+
+void ppnaguard2lp_(float *f, float *scs, float *scr, int *igds,
+                   int *nyp, int *nx, int *nvp, int *nxv);
+
+void ppnacguard2lp_(float *f, float *scs, float *scr, int *igds,
+                    int *nyp, int *nx, int *ndim, int *nvp, int *nxv);
+
+void ppnguard2free_(int *igds);
+
+void ppncguard22l_(float *f, float *scs, int *nxyp, int *ndim,
+                   int *kstrt, int *nvpx, int *nvpy, int *nxv,
+                   int *nypmx, int *idds);
+
+void ppnaguard22l_(float *f, float *scs, float *scr, int *nxyp,
+                   int *kstrt, int *nvpx, int *nvpy, int *nxv,
+                   int *nypmx, int *idds);
+
 void pptpose_(float complex *f, float complex *g, float complex *s,
               float complex *t, int *nx, int *ny, int *kxp, int *kyp,
               int *kstrt, int *nvp, int *nxv, int *nyv, int *kxpd,
@@ -38,16 +63,71 @@ void ppntpose_(float complex *f, float complex *g, float complex *s,
                int *kstrt, int *nvp, int *ndim, int *nxv, int *nyv,
                int *kxpd, int *kypd);
 
+void pptposenb_(float complex *f, float complex *g, float complex *s,
+                float complex *t, int *nx, int *ny, int *kxp, int *kyp,
+                int *kstrt, int *nvp, int *nxv, int *nyv, int *kxpd,
+                int *kypd);
+
+void ppntposenb_(float complex *f, float complex *g, float complex *s,
+                 float complex *t, int *nx, int *ny, int *kxp, int *kyp,
+                 int *kstrt, int *nvp, int *ndim, int *nxv, int *nyv,
+                 int *kxpd, int *kypd);
+
+void ppfmove2_(float *f, float *g, int *noff, int *nyp, int *noffd,
+               int *nypd, int *kstrt, int *nvp, int *nxv, int *nypmx,
+               int *nypmxd);
+
+void ppfmove22_(float *f, float *g, float *scs, float *scr, int *noff,
+                int *nxyp, int *noffd, int *nxypd, int *ndim, int *kstrt,
+                int *nvp, int *nxv, int *nypmx, int *nxvd, int *nypmxd,
+                int *idds);
+
 void ppmove2_(float *part, float *edges, int *npp, float *sbufr,
               float *sbufl, float *rbufr, float *rbufl, int *ihole,
               int *ny, int *kstrt, int *nvp, int *idimp, int *npmax,
               int *idps, int *nbmax, int *ntmax, int *info);
 
+void ppmove2nb_(float *part, float *edges, int *npp, float *sbuf,
+                int *ihole, int *ny, int *kstrt, int *nvp, int *idimp,
+                int *npmax, int *idps, int *ntmax, int *info);
+
+void ppmoveg22_(float *part, float *edges, int *npp, float *sbufr,
+                float *sbufl, float *rbufr, float *rbufl, int *ihole,
+                int *nx, int *ny, int *kstrt, int *nvpx, int *nvpy,
+                int *idimp, int *npmax, int *idps, int *nbmax,
+                int *ntmax, int *info);
+
+void ppwchkpth2_(char *fname, int *nis, int *isc, int *nfs, float *fsc,
+                 int *irc, size_t lfname);
+
+void ppwchkpta2_(float *f, int *nrow, int *nrp, int *noffr, int *nrows);
+
+void ppwchkptp2_(float *part, int *npp, int *idimp, int *npmax);
+
+void ppwchkptc2_(int *irc);
+
+void pprchkpth2_(char *fname, int *nis, int *isc, int *nfs, float *fsc,
+                 int *nvpo, int *irc, size_t lfname);
+
+void pprchkpta2_(int *n, float *f, int *nrow, int *nrp, int *noffr,
+                 int *nrows, int *irc);
+
+void pprchkptp2_(int *n, float *part, int *npp, int *idimp, int *npmax,
+                 int *irc);
+
+void pprchkptc2_();
+
 /* Interfaces to C */
 
+/* fchk = name of checkpoint file being written */
+/* kchkid = processor id, processor 0 renames the checkpoint file */
+static char fchk[256];
+static int kchkid = 0;
+
 /*--------------------------------------------------------------------*/
 void cppinit2(int *idproc, int *nvp, int argc, char *argv[]) {
    ppinit2_(idproc,nvp,&argc,argv);
+   kchkid = *idproc;
    return;
 }
 
@@ -113,6 +193,56 @@ void cppnacguard2l(float f[], float scr[], int nyp, int nx, int ndim,
    return;
 }
 
+/*--------------------------------------------------------------------*/
+void cppnguard2init(float scs[], float scr[], int *igds, int kstrt,
+                    int nvp, int nxv, int nypmx) {
+   ppnguard2init_(scs,scr,igds,&kstrt,&nvp,&nxv,&nypmx);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppncguard2lp(float f[], float scs[], float scr[], int igds,
+                   int nyp, int nvp, int nxv) {
+   ppncguard2lp_(f,scs,scr,&igds,&nyp,&nvp,&nxv);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppnaguard2lp(float f[], float scs[], float scr[], int igds,
+                   int nyp, int nx, int nvp, int nxv) {
+   ppnaguard2lp_(f,scs,scr,&igds,&nyp,&nx,&nvp,&nxv);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppnacguard2lp(float f[], float scs[], float scr[], int igds,
+                    int nyp, int nx, int ndim, int nvp, int nxv) {
+   ppnacguard2lp_(f,scs,scr,&igds,&nyp,&nx,&ndim,&nvp,&nxv);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppnguard2free(int *igds) {
+   ppnguard2free_(igds);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppncguard22l(float f[], float scs[], int nxyp[], int ndim,
+                   int kstrt, int nvpx, int nvpy, int nxv, int nypmx,
+                   int idds) {
+   ppncguard22l_(f,scs,nxyp,&ndim,&kstrt,&nvpx,&nvpy,&nxv,&nypmx,&idds);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppnaguard22l(float f[], float scs[], float scr[], int nxyp[],
+                   int kstrt, int nvpx, int nvpy, int nxv, int nypmx,
+                   int idds) {
+   ppnaguard22l_(f,scs,scr,nxyp,&kstrt,&nvpx,&nvpy,&nxv,&nypmx,&idds);
+   return;
+}
+
 /*--------------------------------------------------------------------*/
 void cpptpose(float complex f[], float complex g[], float complex s[],
               float complex t[], int nx, int ny, int kxp, int kyp,
@@ -132,6 +262,45 @@ void cppntpose(float complex f[], float complex g[], float complex s[],
    return;
 }
 
+/*--------------------------------------------------------------------*/
+void cpptposenb(float complex f[], float complex g[], float complex s[],
+                float complex t[], int nx, int ny, int kxp, int kyp,
+                int kstrt, int nvp, int nxv, int nyv, int kxpd,
+                int kypd) {
+   pptposenb_(f,g,s,t,&nx,&ny,&kxp,&kyp,&kstrt,&nvp,&nxv,&nyv,&kxpd,
+              &kypd);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppntposenb(float complex f[], float complex g[], float complex s[],
+                 float complex t[], int nx, int ny, int kxp, int kyp,
+                 int kstrt, int nvp, int ndim, int nxv, int nyv,
+                 int kxpd, int kypd) {
+   ppntposenb_(f,g,s,t,&nx,&ny,&kxp,&kyp,&kstrt,&nvp,&ndim,&nxv,&nyv,
+               &kxpd,&kypd);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppfmove2(float f[], float g[], int noff, int nyp, int noffd,
+               int nypd, int kstrt, int nvp, int nxv, int nypmx,
+               int nypmxd) {
+   ppfmove2_(f,g,&noff,&nyp,&noffd,&nypd,&kstrt,&nvp,&nxv,&nypmx,
+             &nypmxd);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppfmove22(float f[], float g[], float scs[], float scr[],
+                int noff[], int nxyp[], int noffd[], int nxypd[],
+                int ndim, int kstrt, int nvp, int nxv, int nypmx,
+                int nxvd, int nypmxd, int idds) {
+   ppfmove22_(f,g,scs,scr,noff,nxyp,noffd,nxypd,&ndim,&kstrt,&nvp,&nxv,
+              &nypmx,&nxvd,&nypmxd,&idds);
+   return;
+}
+
 /*--------------------------------------------------------------------*/
 void cppmove2(float part[], float edges[], int *npp, float sbufr[],
               float sbufl[], float rbufr[], float rbufl[], int ihole[],
@@ -141,3 +310,98 @@ void cppmove2(float part[], float edges[], int *npp, float sbufr[],
             &nvp,&idimp,&npmax,&idps,&nbmax,&ntmax,info);
    return;
 }
+
+/*--------------------------------------------------------------------*/
+void cppmove2nb(float part[], float edges[], int *npp, float sbuf[],
+                int ihole[], int ny, int kstrt, int nvp, int idimp,
+                int npmax, int idps, int ntmax, int info[]) {
+   ppmove2nb_(part,edges,npp,sbuf,ihole,&ny,&kstrt,&nvp,&idimp,&npmax,
+              &idps,&ntmax,info);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppmoveg22(float part[], float edges[], int *npp, float sbufr[],
+                float sbufl[], float rbufr[], float rbufl[],
+                int ihole[], int nx, int ny, int kstrt, int nvpx,
+                int nvpy, int idimp, int npmax, int idps, int nbmax,
+                int ntmax, int info[]) {
+   ppmoveg22_(part,edges,npp,sbufr,sbufl,rbufr,rbufl,ihole,&nx,&ny,
+              &kstrt,&nvpx,&nvpy,&idimp,&npmax,&idps,&nbmax,&ntmax,info);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppwchkpth2(char *fname, int nis, int isc[], int nfs, float fsc[],
+                 int *irc) {
+/* the file is written as fname.tmp and renamed by cppwchkptc2 */
+   char ftmp[264];
+   if (strlen(fname) > 255) {
+      *irc = 4;
+      return;
+   }
+   strcpy(fchk,fname);
+   sprintf(ftmp,"%s.tmp",fname);
+   ppwchkpth2_(ftmp,&nis,isc,&nfs,fsc,irc,strlen(ftmp));
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppwchkpta2(float f[], int nrow, int nrp, int noffr, int nrows) {
+   ppwchkpta2_(f,&nrow,&nrp,&noffr,&nrows);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppwchkptp2(float part[], int npp, int idimp, int npmax) {
+   ppwchkptp2_(part,&npp,&idimp,&npmax);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppwchkptc2(int *irc) {
+/* irc = 3 if the completed file cannot be renamed */
+   int one = 1;
+   int jrc[1];
+   char ftmp[264];
+   ppwchkptc2_(irc);
+   if ((*irc==0) && (kchkid==0)) {
+      sprintf(ftmp,"%s.tmp",fchk);
+      if (rename(ftmp,fchk) != 0)
+         *irc = 3;
+   }
+   ppimax_(irc,jrc,&one);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cpprchkpth2(char *fname, int nis, int isc[], int nfs, float fsc[],
+                 int *nvpo, int *irc) {
+   pprchkpth2_(fname,&nis,isc,&nfs,fsc,nvpo,irc,strlen(fname));
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cpprchkpta2(int n, float f[], int nrow, int nrp, int noffr,
+                 int nrows, int *irc) {
+/* arrays in the checkpoint file are numbered from 0 in C, 1 in Fortran */
+   int n1;
+   n1 = n + 1;
+   pprchkpta2_(&n1,f,&nrow,&nrp,&noffr,&nrows,irc);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cpprchkptp2(int n, float part[], int *npp, int idimp, int npmax,
+                 int *irc) {
+   int n1;
+   n1 = n + 1;
+   pprchkptp2_(&n1,part,npp,&idimp,&npmax,irc);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cpprchkptc2() {
+   pprchkptc2_();
+   return;
+}
@@ -88,6 +88,73 @@
          real, dimension(ndim,nxv), intent(inout) :: scr
          end subroutine
       end interface
+!
+      interface
+         subroutine PPNGUARD2INIT(scs,scr,igds,kstrt,nvp,nxv,nypmx)
+         implicit none
+         integer, intent(in) :: kstrt, nvp, nxv, nypmx
+         integer, intent(inout) :: igds
+         real, dimension(nxv), intent(inout) :: scs, scr
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPNCGUARD2LP(f,scs,scr,igds,nyp,nvp,nxv)
+         implicit none
+         integer, intent(in) :: igds, nyp, nvp, nxv
+         real, dimension(nxv,*), intent(inout) :: f
+         real, dimension(nxv), intent(inout) :: scs, scr
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPNAGUARD2LP(f,scs,scr,igds,nyp,nx,nvp,nxv)
+         implicit none
+         integer, intent(in) :: igds, nyp, nx, nvp, nxv
+         real, dimension(nxv,*), intent(inout) :: f
+         real, dimension(nxv), intent(inout) :: scs, scr
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPNACGUARD2LP(f,scs,scr,igds,nyp,nx,ndim,nvp,nxv)
+         implicit none
+         integer, intent(in) :: igds, nyp, nx, ndim, nvp, nxv
+         real, dimension(ndim,nxv,*), intent(inout) :: f
+         real, dimension(ndim,nxv), intent(inout) :: scs, scr
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPNGUARD2FREE(igds)
+         implicit none
+         integer, intent(inout) :: igds
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPNCGUARD22L(f,scs,nxyp,ndim,kstrt,nvpx,nvpy,nxv,   &
+     &nypmx,idds)
+         implicit none
+         integer, intent(in) :: ndim, kstrt, nvpx, nvpy, nxv, nypmx
+         integer, intent(in) :: idds
+         real, dimension(ndim,nxv,nypmx), intent(inout) :: f
+         real, dimension(ndim,nypmx,2), intent(inout) :: scs
+         integer, dimension(idds), intent(in) :: nxyp
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPNAGUARD22L(f,scs,scr,nxyp,kstrt,nvpx,nvpy,nxv,    &
+     &nypmx,idds)
+         implicit none
+         integer, intent(in) :: kstrt, nvpx, nvpy, nxv, nypmx, idds
+         real, dimension(nxv,nypmx), intent(inout) :: f
+         real, dimension(nypmx,2), intent(inout) :: scs
+         real, dimension(nxv), intent(inout) :: scr
+         integer, dimension(idds), intent(in) :: nxyp
+         end subroutine
+      end interface
 !
       interface
          subroutine PPTPOSE(f,g,s,t,nx,ny,kxp,kyp,kstrt,nvp,nxv,nyv,kxpd&
@@ -112,6 +179,55 @@
          complex, dimension(ndim,kxp*kyp), intent(inout) :: s, t
          end subroutine
       end interface
+!
+      interface
+         subroutine PPTPOSENB(f,g,s,t,nx,ny,kxp,kyp,kstrt,nvp,nxv,nyv,  &
+     &kxpd,kypd)
+         implicit none
+         integer, intent(in) :: nx, ny, kxp, kyp, kstrt, nvp, nxv, nyv
+         integer, intent(in) :: kxpd, kypd
+         real, dimension(2*nxv,kypd), intent(in) :: f
+         complex, dimension(nyv,kxpd), intent(inout) :: g
+         complex, dimension(kxp*kyp,nvp), intent(inout) :: s, t
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPNTPOSENB(f,g,s,t,nx,ny,kxp,kyp,kstrt,nvp,ndim,nxv,&
+     &nyv,kxpd,kypd)
+         implicit none
+         integer, intent(in) :: nx, ny, kxp, kyp, kstrt, nvp, ndim
+         integer, intent(in) :: nxv, nyv, kxpd, kypd
+         real, dimension(ndim,2*nxv,kypd), intent(in) :: f
+         complex, dimension(ndim,nyv,kxpd), intent(inout) :: g
+         complex, dimension(ndim,kxp*kyp,nvp), intent(inout) :: s, t
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPFMOVE2(f,g,noff,nyp,noffd,nypd,kstrt,nvp,nxv,nypmx&
+     &,nypmxd)
+         implicit none
+         integer, intent(in) :: noff, nyp, noffd, nypd, kstrt, nvp, nxv
+         integer, intent(in) :: nypmx, nypmxd
+         real, dimension(nxv,nypmx), intent(in) :: f
+         real, dimension(nxv,nypmxd), intent(inout) :: g
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPFMOVE22(f,g,scs,scr,noff,nxyp,noffd,nxypd,ndim,   &
+     &kstrt,nvp,nxv,nypmx,nxvd,nypmxd,idds)
+         implicit none
+         integer, intent(in) :: ndim, kstrt, nvp, nxv, nypmx, nxvd
+         integer, intent(in) :: nypmxd, idds
+         real, dimension(ndim,nxv,nypmx), intent(in) :: f
+         real, dimension(ndim,nxvd,nypmxd), intent(inout) :: g
+         real, dimension(*), intent(inout) :: scs, scr
+         integer, dimension(idds), intent(in) :: noff, nxyp
+         integer, dimension(idds), intent(in) :: noffd, nxypd
+         end subroutine
+      end interface
 !
       interface
          subroutine PPMOVE2(part,edges,npp,sbufr,sbufl,rbufr,rbufl,ihole&
@@ -128,6 +244,106 @@
          integer, dimension(5), intent(inout) :: info
          end subroutine
       end interface
+!
+      interface
+         subroutine PPMOVE2NB(part,edges,npp,sbuf,ihole,ny,kstrt,nvp,   &
+     &idimp,npmax,idps,ntmax,info)
+         implicit none
+         integer, intent(in) :: ny, kstrt, nvp, idimp, npmax, idps
+         integer, intent(in) :: ntmax
+         integer, intent(inout) :: npp
+         real, dimension(idimp,npmax), intent(inout) :: part
+         real, dimension(idps), intent(in) :: edges
+         real, dimension(idimp,ntmax), intent(inout) :: sbuf
+         integer, dimension(ntmax+1), intent(inout) :: ihole
+         integer, dimension(5), intent(inout) :: info
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPMOVEG22(part,edges,npp,sbufr,sbufl,rbufr,rbufl,   &
+     &ihole,nx,ny,kstrt,nvpx,nvpy,idimp,npmax,idps,nbmax,ntmax,info)
+         implicit none
+         integer, intent(in) :: nx, ny, kstrt, nvpx, nvpy, idimp, npmax
+         integer, intent(in) :: idps, nbmax, ntmax
+         integer, intent(inout) :: npp
+         real, dimension(idimp,npmax), intent(inout) :: part
+         real, dimension(idps), intent(in) :: edges
+         real, dimension(idimp,nbmax), intent(inout) :: sbufr, sbufl
+         real, dimension(idimp,nbmax), intent(inout) :: rbufr, rbufl
+         integer, dimension(ntmax+1) , intent(inout):: ihole
+         integer, dimension(7), intent(inout) :: info
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPWCHKPTH2(fname,nis,isc,nfs,fsc,irc)
+         implicit none
+         integer, intent(in) :: nis, nfs
+         integer, intent(inout) :: irc
+         character(len=*), intent(in) :: fname
+         integer, dimension(nis), intent(in) :: isc
+         real, dimension(nfs), intent(in) :: fsc
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPWCHKPTA2(f,nrow,nrp,noffr,nrows)
+         implicit none
+         integer, intent(in) :: nrow, nrp, noffr, nrows
+         real, dimension(nrow,nrp), intent(in) :: f
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPWCHKPTP2(part,npp,idimp,npmax)
+         implicit none
+         integer, intent(in) :: npp, idimp, npmax
+         real, dimension(idimp,npmax), intent(in) :: part
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPWCHKPTC2(irc)
+         implicit none
+         integer, intent(inout) :: irc
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPRCHKPTH2(fname,nis,isc,nfs,fsc,nvpo,irc)
+         implicit none
+         integer, intent(in) :: nis, nfs
+         integer, intent(inout) :: nvpo, irc
+         character(len=*), intent(in) :: fname
+         integer, dimension(nis), intent(inout) :: isc
+         real, dimension(nfs), intent(inout) :: fsc
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPRCHKPTA2(n,f,nrow,nrp,noffr,nrows,irc)
+         implicit none
+         integer, intent(in) :: n, nrow, nrp, noffr, nrows
+         integer, intent(inout) :: irc
+         real, dimension(nrow,nrp), intent(inout) :: f
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPRCHKPTP2(n,part,npp,idimp,npmax,irc)
+         implicit none
+         integer, intent(in) :: n, idimp, npmax
+         integer, intent(inout) :: npp, irc
+         real, dimension(idimp,npmax), intent(inout) :: part
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPRCHKPTC2()
+         implicit none
+         end subroutine
+      end interface
 !
       end module
 
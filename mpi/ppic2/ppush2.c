@@ -120,6 +120,74 @@ local data                                                            */
    return;
 }
 
+/*--------------------------------------------------------------------*/
+void cpfedges2(float edges[], int *nyp, int *noff, float npicy[],
+               int nypmin, int nypmax, int ny, int kstrt, int nvp,
+               int idps) {
+/* this subroutine determines spatial boundaries for non-uniform
+   particle decomposition, so that each partition contains nearly the
+   same number of particles, calculates number of grid points in each
+   spatial region, and the offset of these grid points from the global
+   address.  all processors calculate the same boundaries.
+   integer boundaries are set.
+   input: npicy, nypmin, nypmax, ny, kstrt, nvp, idps
+   output: edges, nyp, noff
+   edges[0] = lower boundary of particle partition
+   edges[1] = upper boundary of particle partition
+   nyp = number of primary (complete) gridpoints in particle partition
+   noff = lowermost global gridpoint in particle partition
+   npicy[k] = number of particles in global grid row k, summed over
+   all processors
+   nypmin/nypmax = minimum/maximum value of nyp allowed
+   it is assumed that nvp*nypmin <= ny <= nvp*nypmax
+   ny = system length in y direction
+   kstrt = starting data block number (processor id + 1)
+   nvp = number of real or virtual processors
+   idps = number of partition boundaries
+local data                                                            */
+   int k, n, kl, kr, kt;
+   double sum1, sum2, anpav;
+/* find average number of particles per partition */
+   sum1 = 0.0;
+   for (k = 0; k < ny; k++) {
+      sum1 += npicy[k];
+   }
+   anpav = sum1/(double) nvp;
+/* find upper boundary of each partition in turn, up to this one */
+   kl = 0;
+   kr = 0;
+   k = 0;
+   sum1 = 0.0;
+   for (n = 1; n <= kstrt; n++) {
+      if (n==nvp) {
+         kr = ny;
+      }
+      else {
+/* find grid row closest to cumulative particle target */
+         sum2 = anpav*(double) n;
+         while ((k < ny) && ((sum1 + 0.5*npicy[k]) < sum2)) {
+            sum1 += npicy[k];
+            k += 1;
+         }
+         kr = k;
+/* enforce partition size limits for this and remaining partitions */
+         kt = ny - nypmax*(nvp - n);
+         kt = kt > kl + nypmin ? kt : kl + nypmin;
+         kr = kr > kt ? kr : kt;
+         kt = ny - nypmin*(nvp - n);
+         kt = kt < kl + nypmax ? kt : kl + nypmax;
+         kr = kr < kt ? kr : kt;
+      }
+      if (n < kstrt)
+         kl = kr;
+   }
+   edges[0] = (float) kl;
+   edges[1] = (float) kr;
+   *noff = kl;
+   *nyp = kr - kl;
+   return;
+}
+
 /*--------------------------------------------------------------------*/
 void cpdistr2(float part[], float edges[], int *npp, int nps, float vtx,
               float vty, float vdx, float vdy, int npx, int npy, int nx,
@@ -467,6 +535,466 @@ local data                                                            */
    return;
 }
 
+/*--------------------------------------------------------------------*/
+void cppcount2y(float part[], float npicy[], int npp, int idimp,
+                int npmax, int ny) {
+/* this subroutine counts the number of particles in each grid row in y
+   the result must be summed over processors to obtain the global
+   density profile used for load balancing
+   input: all except npicy, output: npicy
+   part[n][1] = position y of particle n in partition
+   npicy[k] = number of particles in global grid row k
+   npp = number of particles in partition
+   idimp = size of phase space
+   npmax = maximum number of particles in each partition
+   ny = system length in y direction
+local data                                                            */
+   int j, k, m;
+/* clear counter array */
+   for (k = 0; k < ny; k++) {
+      npicy[k] = 0.0;
+   }
+/* find how many particles in each grid row */
+   for (j = 0; j < npp; j++) {
+      m = part[1+idimp*j];
+      npicy[m] += 1.0;
+   }
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppholes2(float part[], float edges[], int npp, int ihole[],
+               int idimp, int npmax, int idps, int ntmax) {
+/* this subroutine determines list of particles which are outside the
+   partition boundaries, as needed by cppmove2 after the boundaries
+   have been changed.  at most ntmax particles are listed, so that
+   the procedure must be repeated until no particles are found
+   input: all except ihole, output: ihole
+   part[n][1] = position y of particle n in partition
+   edges[0:1] = lower:upper boundary of particle partition
+   npp = number of particles in partition
+   ihole = location of hole left in particle arrays
+   ihole[0] = ih, number of holes left
+   idimp = size of phase space
+   npmax = maximum number of particles in each partition
+   idps = number of partition boundaries
+   ntmax = size of hole array for particles leaving processors
+local data                                                            */
+   int j, ih;
+   float dy;
+   ih = 0;
+   for (j = 0; j < npp; j++) {
+      dy = part[1+idimp*j];
+/* find particles out of bounds */
+      if ((dy < edges[0]) || (dy >= edges[1])) {
+         if (ih < ntmax) {
+            ihole[ih+1] = j + 1;
+            ih += 1;
+         }
+      }
+   }
+   ihole[0] = ih;
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cfcomp22(int *nvp, int nx, int ny, int *nvpx, int *nvpy,
+              int *ierr) {
+/* determines optimal partition for nvp processors with 2D spatial
+   decomposition in x and y
+   input: nvp, number of processors, nx, ny = number of grids
+   output: nvp, nvpx, nvpy, processors in x, y direction,
+   ierr = error code
+   nvp = number of real or virtual processors obtained
+   nx/ny = system length in x/y direction
+   nvpx/nvpy = number of real or virtual processors in x/y
+   ierr = (0,1) = (no,yes) error condition exists
+local data                                                            */
+   int lvp;
+   double dt1;
+   *ierr = 0;
+/* prefer equal number of grids in x and y partitions */
+   dt1 = sqrt((double) *nvp*(double) nx/(double) ny);
+/* return total number of processors in x and y */
+   *nvpx = (float) dt1;
+   if (*nvpx < 1)
+      *nvpx = 1;
+   *nvpy = *nvp/(*nvpx);
+   lvp = (*nvpx)*(*nvpy);
+   if (lvp > *nvp) {
+      printf("invalid partition:nvpx,nvpy,nvp=%d,%d,%d\n",*nvpx,*nvpy,
+             *nvp);
+      *ierr = 1;
+      return;
+   }
+   while (lvp != *nvp) {
+      *nvpx -= 1;
+      *nvpy = *nvp/(*nvpx);
+      lvp = (*nvpx)*(*nvpy);
+   }
+   *nvp = lvp;
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cpdicomp22l(float edges[], int nxyp[], int noff[], int *nxpmx,
+                 int *nypmx, int *nxpmn, int *nypmn, int nx, int ny,
+                 int kstrt, int nvpx, int nvpy, int idps, int idds) {
+/* this subroutine determines spatial boundaries for uniform particle
+   decomposition in x and y, calculates number of grid points in each
+   spatial region, and the offset of these grid points from the global
+   address
+   nvpx must be < nx and nvpy must be < ny.
+   some combinations of nx and nvpx and ny and nvpy result in a zero
+   value of nxyp.  this is not supported.
+   input: nx, ny, kstrt, nvpx, nvpy, idps, idds
+   output: edges, nxyp, noff, nxpmx, nypmx, nxpmn, nypmn
+   for 2D spatial decomposition
+   edges[0:1] = left:right boundary in x of particle partition
+   edges[2:3] = lower:upper boundary in y of particle partition
+   nxyp[0:1] = number of primary (complete) gridpoints in x/y
+   noff[0] = leftmost global gridpoint in x in particle partition
+   noff[1] = lowermost global gridpoint in y in particle partition
+   nxpmx = maximum size of particle partition in x, including guard cells
+   nypmx = maximum size of particle partition in y, including guard cells
+   nxpmn = minimum value of nxyp[0]
+   nypmn = minimum value of nxyp[1]
+   nx/ny = system length in x/y direction
+   kstrt = starting data block number (processor id + 1)
+   nvpx/nvpy = number of real or virtual processors in x/y
+   idps = number of particle partition boundaries = 4
+   idds = dimensionality of domain decomposition = 2
+local data                                                            */
+   int jb, kb, kxp, kyp;
+   float at1, at2, anx, any;
+   int mxypm[4], iwork4[4];
+   anx = (float) nx;
+   any = (float) ny;
+/* determine decomposition */
+/* find processor id in x/y */
+   kb = (kstrt - 1)/nvpx;
+   jb = kstrt - nvpx*kb - 1;
+/* boundaries in x */
+   kxp = (nx - 1)/nvpx + 1;
+   at1 = (float) kxp;
+   edges[0] = at1*(float) jb;
+   if (edges[0] > anx)
+      edges[0] = anx;
+   noff[0] = edges[0];
+   edges[1] = at1*(float) (jb + 1);
+   if (edges[1] > anx)
+      edges[1] = anx;
+   jb = edges[1];
+   nxyp[0] = jb - noff[0];
+/* boundaries in y */
+   kyp = (ny - 1)/nvpy + 1;
+   at2 = (float) kyp;
+   edges[2] = at2*(float) kb;
+   if (edges[2] > any)
+      edges[2] = any;
+   noff[1] = edges[2];
+   edges[3] = at2*(float) (kb + 1);
+   if (edges[3] > any)
+      edges[3] = any;
+   kb = edges[3];
+   nxyp[1] = kb - noff[1];
+/* find maximum/minimum partition size in x and y */
+   mxypm[0] = nxyp[0];
+   mxypm[1] = -nxyp[0];
+   mxypm[2] = nxyp[1];
+   mxypm[3] = -nxyp[1];
+   cppimax(mxypm,iwork4,4);
+   *nxpmx = mxypm[0] + 1;
+   *nxpmn = -mxypm[1];
+   *nypmx = mxypm[2] + 1;
+   *nypmn = -mxypm[3];
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cpdistr22(float part[], float edges[], int *npp, int nps,
+               float vtx, float vty, float vdx, float vdy, int npx,
+               int npy, int nx, int ny, int idimp, int npmax, int idps,
+               int ipbc, int *ierr) {
+/* for 2d code, this subroutine calculates initial particle co-ordinates
+   and velocities with uniform density and maxwellian velocity with drift
+   for distributed data with 2D spatial decomposition
+   input: all except part, npp, ierr, output: part, npp, ierr
+   part[n][0] = position x of particle n in partition
+   part[n][1] = position y of particle n in partition
+   part[n][2] = velocity vx of particle n in partition
+   part[n][3] = velocity vy of particle n in partition
+   edges[0:1] = left:right boundary in x of particle partition
+   edges[2:3] = lower:upper boundary in y of particle partition
+   npp = number of particles in partition
+   nps = starting address of particles in partition
+   vtx/vty = thermal velocity of electrons in x/y direction
+   vdx/vdy = drift velocity of beam electrons in x/y direction
+   npx/npy = initial number of particles distributed in x/y direction
+   nx/ny = system length in x/y direction
+   idimp = size of phase space = 4
+   npmax = maximum number of particles in each partition
+   idps = number of particle partition boundaries = 4
+   ipbc = particle boundary condition = (0,1,2,3) =
+   (none,2d periodic,2d reflecting,mixed reflecting/periodic)
+   ierr = (0,1) = (no,yes) error condition exists
+   ranorm = gaussian random number with zero mean and unit variance
+   with 2D spatial decomposition
+local data                                                            */
+   int j, k, npt, k1, npxyp;
+   float edgelx, edgely, at1, at2, xt, yt, vxt, vyt;
+   double dnpx, dnpxy, dt1;
+   int ierr1[1], iwork1[1];
+   double sum3[3], work3[3];
+   *ierr = 0;
+/* particle distribution constant */
+   dnpx = (double) npx;
+/* set boundary values */
+   edgelx = 0.0;
+   edgely = 0.0;
+   at1 = (float) nx/(float) npx;
+   at2 = (float) ny/(float) npy;
+   if (ipbc==2) {
+      edgelx = 1.0;
+      edgely = 1.0;
+      at1 = (float) (nx-2)/(float) npx;
+      at2 = (float) (ny-2)/(float) npy;
+   }
+   else if (ipbc==3) {
+      edgelx = 1.0;
+      at1 = (float) (nx-2)/(float) npx;
+   }
+   npt = *npp;
+/* uniform density profile */
+   for (k = 0; k < npy; k++) {
+      yt = edgely + at2*(((float) k) + 0.5);
+      for (j = 0; j < npx; j++) {
+         xt = edgelx + at1*(((float) j) + 0.5);
+/* maxwellian velocity distribution */
+         vxt = vtx*ranorm();
+         vyt = vty*ranorm();
+         if ((xt >= edges[0]) && (xt < edges[1]) && (yt >= edges[2])
+            && (yt < edges[3])) {
+            if (npt < npmax) {
+               k1 = idimp*npt;
+               part[k1] = xt;
+               part[1+k1] = yt;
+               part[2+k1] = vxt;
+               part[3+k1] = vyt;
+               npt += 1;
+            }
+            else
+               *ierr += 1;
+         }
+      }
+   }
+   npxyp = 0;
+/* add correct drift */
+   sum3[0] = 0.0;
+   sum3[1] = 0.0;
+   for (j = nps-1; j < npt; j++) {
+      npxyp += 1;
+      sum3[0] += part[2+idimp*j];
+      sum3[1] += part[3+idimp*j];
+   }
+   sum3[2] = npxyp;
+   cppdsum(sum3,work3,3);
+   dnpxy = sum3[2];
+   ierr1[0] = *ierr;
+   cppimax(ierr1,iwork1,1);
+   *ierr = ierr1[0];
+   dt1 = 1.0/dnpxy;
+   sum3[0] = dt1*sum3[0] - vdx;
+   sum3[1] = dt1*sum3[1] - vdy;
+   for (j = nps-1; j < npt; j++) {
+      part[2+idimp*j] -= sum3[0];
+      part[3+idimp*j] -= sum3[1];
+   }
+/* process errors */
+   dnpxy -= dnpx*(double) npy;
+   if (dnpxy != 0.0)
+      *ierr = dnpxy;
+   *npp = npt;
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppgpush22l(float part[], float fxy[], int npp, int noff[],
+                 float qbm, float dt, float *ek, int nx, int ny,
+                 int idimp, int npmax, int nxv, int nypmx, int idds,
+                 int ipbc) {
+/* for 2d code, this subroutine updates particle co-ordinates and
+   velocities using leap-frog scheme in time and first-order linear
+   interpolation in space, with various boundary conditions
+   scalar version using guard cells, for distributed data
+   with 2D spatial decomposition.  periodic boundaries are applied by
+   cppmoveg22, which also finds the particles leaving this processor
+   42 flops/particle, 12 loads, 4 stores
+   input: all, output: part, ek
+   equations used are:
+   vx(t+dt/2) = vx(t-dt/2) + (q/m)*fx(x(t),y(t))*dt,
+   vy(t+dt/2) = vy(t-dt/2) + (q/m)*fy(x(t),y(t))*dt,
+   where q/m is charge/mass, and
+   x(t+dt) = x(t) + vx(t+dt/2)*dt, y(t+dt) = y(t) + vy(t+dt/2)*dt
+   fx(x(t),y(t)) and fy(x(t),y(t)) are approximated by interpolation from
+   the nearest grid points:
+   fx(x,y) = (1-dy)*((1-dx)*fx(n,m)+dx*fx(n+1,m)) + dy*((1-dx)*fx(n,m+1)
+      + dx*fx(n+1,m+1))
+   fy(x,y) = (1-dy)*((1-dx)*fy(n,m)+dx*fy(n+1,m)) + dy*((1-dx)*fy(n,m+1)
+      + dx*fy(n+1,m+1))
+   where n,m = leftmost grid points and dx = x-n, dy = y-m
+   part[n][0] = position x of particle n in partition
+   part[n][1] = position y of particle n in partition
+   part[n][2] = velocity vx of particle n in partition
+   part[n][3] = velocity vy of particle n in partition
+   fxy[k][j][0] = x component of force/charge at grid (jj,kk)
+   fxy[k][j][1] = y component of force/charge at grid (jj,kk)
+   in other words, fxy are the convolutions of the electric field
+   over the particle shape, where jj = j + noff[0], kk = k + noff[1]
+   npp = number of particles in partition
+   noff[0:1] = leftmost/lowermost global gridpoint in particle partition
+   qbm = particle charge/mass
+   dt = time interval between successive calculations
+   kinetic energy/mass at time t is also calculated, using
+   ek = .125*sum((vx(t+dt/2)+vx(t-dt/2))**2+(vy(t+dt/2)+vy(t-dt/2))**2)
+   nx/ny = system length in x/y direction
+   idimp = size of phase space = 4
+   npmax = maximum number of particles in each partition
+   nxv = first dimension of field array, must be >= nxpmx
+   nypmx = maximum size of particle partition in y, including guard cells
+   idds = dimensionality of domain decomposition = 2
+   ipbc = particle boundary condition = (0,1,2,3) =
+   (none,2d periodic,2d reflecting,mixed reflecting/periodic)
+local data                                                            */
+   int mnoff, lnoff, j, nn, mm, np, mp, nxv2;
+   float qtm, edgelx, edgely, edgerx, edgery, dxp, dyp, amx, amy;
+   float dx, dy, vx, vy;
+   double sum1;
+   nxv2 = 2*nxv;
+   qtm = qbm*dt;
+   sum1 = 0.0;
+/* set boundary values */
+   edgelx = 0.0;
+   edgely = 1.0;
+   edgerx = (float) nx;
+   edgery = (float) (ny-1);
+   if ((ipbc==2) || (ipbc==3)) {
+      edgelx = 1.0;
+      edgerx = (float) (nx-1);
+   }
+   lnoff = noff[0];
+   mnoff = noff[1];
+   for (j = 0; j < npp; j++) {
+/* find interpolation weights */
+      nn = part[idimp*j];
+      mm = part[1+idimp*j];
+      dxp = part[idimp*j] - (float) nn;
+      dyp = part[1+idimp*j] - (float) mm;
+      nn = 2*(nn - lnoff);
+      mm = nxv2*(mm - mnoff);
+      amx = 1.0 - dxp;
+      mp = mm + nxv2;
+      amy = 1.0 - dyp;
+      np = nn + 2;
+/* find acceleration */
+      dx = dyp*(dxp*fxy[np+mp] + amx*fxy[nn+mp])
+         + amy*(dxp*fxy[np+mm] + amx*fxy[nn+mm]);
+      dy = dyp*(dxp*fxy[1+np+mp] + amx*fxy[1+nn+mp])
+         + amy*(dxp*fxy[1+np+mm] + amx*fxy[1+nn+mm]);
+/* new velocity */
+      vx = part[2+idimp*j];
+      vy = part[3+idimp*j];
+      dx = vx + qtm*dx;
+      dy = vy + qtm*dy;
+/* average kinetic energy */
+      vx += dx;
+      vy += dy;
+      sum1 += vx*vx + vy*vy;
+      part[2+idimp*j] = dx;
+      part[3+idimp*j] = dy;
+/* new position */
+      dx = part[idimp*j] + dx*dt;
+      dy = part[1+idimp*j] + dy*dt;
+/* reflecting boundary conditions */
+      if (ipbc==2) {
+         if ((dx < edgelx) || (dx >= edgerx)) {
+            dx = part[idimp*j];
+            part[2+idimp*j] = -part[2+idimp*j];
+         }
+         if ((dy < edgely) || (dy >= edgery)) {
+            dy = part[1+idimp*j];
+            part[3+idimp*j] = -part[3+idimp*j];
+         }
+      }
+/* mixed reflecting/periodic boundary conditions */
+      else if (ipbc==3) {
+         if ((dx < edgelx) || (dx >= edgerx)) {
+            dx = part[idimp*j];
+            part[2+idimp*j] = -part[2+idimp*j];
+         }
+      }
+/* set new position */
+      part[idimp*j] = dx;
+      part[1+idimp*j] = dy;
+   }
+/* normalize kinetic energy */
+   *ek += 0.125*sum1;
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppgpost22l(float part[], float q[], int npp, int noff[], float qm,
+                 int idimp, int npmax, int nxv, int nypmx, int idds) {
+/* for 2d code, this subroutine calculates particle charge density
+   using first-order linear interpolation, periodic boundaries
+   scalar version using guard cells, for distributed data
+   with 2D spatial decomposition
+   17 flops/particle, 6 loads, 4 stores
+   input: all, output: q
+   charge density is approximated by values at the nearest grid points
+   q(n,m)=qm*(1.-dx)*(1.-dy)
+   q(n+1,m)=qm*dx*(1.-dy)
+   q(n,m+1)=qm*(1.-dx)*dy
+   q(n+1,m+1)=qm*dx*dy
+   where n,m = leftmost grid points and dx = x-n, dy = y-m
+   part[n][0] = position x of particle n in partition
+   part[n][1] = position y of particle n in partition
+   q[k][j] = charge density at grid point (jj,kk),
+   where jj = j + noff[0], kk = k + noff[1]
+   npp = number of particles in partition
+   noff[0:1] = leftmost/lowermost global gridpoint in particle partition
+   qm = charge on particle, in units of e
+   idimp = size of phase space = 4
+   npmax = maximum number of particles in each partition
+   nxv = first dimension of charge array, must be >= nxpmx
+   nypmx = maximum size of particle partition in y, including guard cells
+   idds = dimensionality of domain decomposition = 2
+local data                                                            */
+   int mnoff, lnoff, j, nn, np, mm, mp;
+   float dxp, dyp, amx, amy;
+   lnoff = noff[0];
+   mnoff = noff[1];
+   for (j = 0; j < npp; j++) {
+/* find interpolation weights */
+      nn = part[idimp*j];
+      mm = part[1+idimp*j];
+      dxp = qm*(part[idimp*j] - (float) nn);
+      dyp = part[1+idimp*j] - (float) mm;
+      nn = nn - lnoff;
+      mm = nxv*(mm - mnoff);
+      amx = qm - dxp;
+      mp = mm + nxv;
+      amy = 1.0 - dyp;
+      np = nn + 1;
+/* deposit charge */
+      q[np+mp] += dxp*dyp;
+      q[nn+mp] += amx*dyp;
+      q[np+mm] += dxp*amy;
+      q[nn+mm] += amx*amy;
+   }
+   return;
+}
+
 /*--------------------------------------------------------------------*/
 void cppcguard2xl(float fxy[], int nyp, int nx, int ndim, int nxe,
                   int nypmx) {
@@ -1427,12 +1955,13 @@ L90: if (ks==0) {
 
 /*--------------------------------------------------------------------*/
 void cwppfft2r(float complex f[], float complex g[], float complex bs[],
-               float complex br[], int isign, int ntpose, int mixup[],
-               float complex sct[], float *ttp, int indx, int indy,
-               int kstrt, int nvp, int nxvh, int nyv, int kxp, int kyp,
-               int kypd, int nxhyd, int nxyhd) {
+               float complex br[], int isign, int ntpose, int ltpose,
+               int mixup[], float complex sct[], float *ttp, int indx,
+               int indy, int kstrt, int nvp, int nxvh, int nyv, int kxp,
+               int kyp, int kypd, int nxhyd, int nxyhd) {
 /* wrapper function for 2d real to complex fft, with packed data */
 /* parallelized with MPI */
+/* ltpose = (0,1) = (no,yes) use non-blocking transpose */
 /* local data */
    int nxh, ny, ks, kxpp, kypp;
    static int kxpi = 1, kypi = 1;
@@ -1455,7 +1984,11 @@ void cwppfft2r(float complex f[], float complex g[], float complex bs[],
                  nxhyd,nxyhd);
 /* transpose f array to g */
       cpwtimera(-1,ttp,&dtime);
-      cpptpose(f,g,bs,br,nxh,ny,kxp,kyp,kstrt,nvp,nxvh,nyv,kxp,kypd);
+      if (ltpose==1)
+         cpptposenb(f,g,bs,br,nxh,ny,kxp,kyp,kstrt,nvp,nxvh,nyv,kxp,
+                    kypd);
+      else
+         cpptpose(f,g,bs,br,nxh,ny,kxp,kyp,kstrt,nvp,nxvh,nyv,kxp,kypd);
       cpwtimera(1,ttp,&dtime);
 /* perform y fft */
       cppfft2rxy(g,isign,mixup,sct,indx,indy,kstrt,kxpi,kxpp,nyv,kxp,
@@ -1463,7 +1996,12 @@ void cwppfft2r(float complex f[], float complex g[], float complex bs[],
 /* transpose g array to f */
       if (ntpose==0) {
          cpwtimera(-1,&tf,&dtime);
-         cpptpose(g,f,br,bs,ny,nxh,kyp,kxp,kstrt,nvp,nyv,nxvh,kypd,kxp);
+         if (ltpose==1)
+            cpptposenb(g,f,br,bs,ny,nxh,kyp,kxp,kstrt,nvp,nyv,nxvh,kypd,
+                       kxp);
+         else
+            cpptpose(g,f,br,bs,ny,nxh,kyp,kxp,kstrt,nvp,nyv,nxvh,kypd,
+                     kxp);
          cpwtimera(1,&tf,&dtime);
       }
    }
@@ -1472,7 +2010,12 @@ void cwppfft2r(float complex f[], float complex g[], float complex bs[],
 /* transpose f array to g */
       if (ntpose==0) {
          cpwtimera(-1,&tf,&dtime);
-         cpptpose(f,g,bs,br,nxh,ny,kxp,kyp,kstrt,nvp,nxvh,nyv,kxp,kypd);
+         if (ltpose==1)
+            cpptposenb(f,g,bs,br,nxh,ny,kxp,kyp,kstrt,nvp,nxvh,nyv,kxp,
+                       kypd);
+         else
+            cpptpose(f,g,bs,br,nxh,ny,kxp,kyp,kstrt,nvp,nxvh,nyv,kxp,
+                     kypd);
          cpwtimera(1,&tf,&dtime);
       }
 /* perform y fft */
@@ -1480,7 +2023,11 @@ void cwppfft2r(float complex f[], float complex g[], float complex bs[],
                  nxhyd,nxyhd);
 /* transpose g array to f */
       cpwtimera(-1,ttp,&dtime);
-      cpptpose(g,f,br,bs,ny,nxh,kyp,kxp,kstrt,nvp,nyv,nxvh,kypd,kxp);
+      if (ltpose==1)
+         cpptposenb(g,f,br,bs,ny,nxh,kyp,kxp,kstrt,nvp,nyv,nxvh,kypd,
+                    kxp);
+      else
+         cpptpose(g,f,br,bs,ny,nxh,kyp,kxp,kstrt,nvp,nyv,nxvh,kypd,kxp);
       cpwtimera(1,ttp,&dtime);
 /* perform x fft */
       cppfft2rxx(f,isign,mixup,sct,indx,indy,kstrt,kypi,kypp,nxvh,kypd,
@@ -1493,12 +2040,13 @@ void cwppfft2r(float complex f[], float complex g[], float complex bs[],
 
 /*--------------------------------------------------------------------*/
 void cwppfft2r2(float complex f[], float complex g[], float complex bs[],
-                float complex br[], int isign, int ntpose, int mixup[],
-                float complex sct[], float *ttp, int indx, int indy,
-                int kstrt, int nvp, int nxvh, int nyv, int kxp, int kyp,
-                int kypd, int nxhyd, int nxyhd) {
+                float complex br[], int isign, int ntpose, int ltpose,
+                int mixup[], float complex sct[], float *ttp, int indx,
+                int indy, int kstrt, int nvp, int nxvh, int nyv, int kxp,
+                int kyp, int kypd, int nxhyd, int nxyhd) {
 /* wrapper function for 2 2d real to complex ffts, with packed data */
 /* parallelized with MPI */
+/* ltpose = (0,1) = (no,yes) use non-blocking transpose */
 /* local data */
    int nxh, ny, ks, kxpp, kypp;
    static int kxpi = 1, kypi = 1;
@@ -1521,7 +2069,12 @@ void cwppfft2r2(float complex f[], float complex g[], float complex bs[],
                   nxhyd,nxyhd);
 /* transpose f array to g */
       cpwtimera(-1,ttp,&dtime);
-      cppntpose(f,g,bs,br,nxh,ny,kxp,kyp,kstrt,nvp,2,nxvh,nyv,kxp,kypd);
+      if (ltpose==1)
+         cppntposenb(f,g,bs,br,nxh,ny,kxp,kyp,kstrt,nvp,2,nxvh,nyv,kxp,
+                     kypd);
+      else
+         cppntpose(f,g,bs,br,nxh,ny,kxp,kyp,kstrt,nvp,2,nxvh,nyv,kxp,
+                   kypd);
       cpwtimera(1,ttp,&dtime);
 /* perform y fft */
       cppfft2r2xy(g,isign,mixup,sct,indx,indy,kstrt,kxpi,kxpp,nyv,kxp,
@@ -1529,8 +2082,12 @@ void cwppfft2r2(float complex f[], float complex g[], float complex bs[],
 /* transpose g array to f */
       if (ntpose==0) {
          cpwtimera(-1,&tf,&dtime);
-         cppntpose(g,f,br,bs,ny,nxh,kyp,kxp,kstrt,nvp,2,nyv,nxvh,kypd,
-                   kxp);
+         if (ltpose==1)
+            cppntposenb(g,f,br,bs,ny,nxh,kyp,kxp,kstrt,nvp,2,nyv,nxvh,
+                        kypd,kxp);
+         else
+            cppntpose(g,f,br,bs,ny,nxh,kyp,kxp,kstrt,nvp,2,nyv,nxvh,
+                      kypd,kxp);
          cpwtimera(1,&tf,&dtime);
       }
    }
@@ -1539,8 +2096,12 @@ void cwppfft2r2(float complex f[], float complex g[], float complex bs[],
 /* transpose f array to g */
       if (ntpose==0) {
          cpwtimera(-1,&tf,&dtime);
-         cppntpose(f,g,bs,br,nxh,ny,kxp,kyp,kstrt,nvp,2,nxvh,nyv,kxp,
-                   kypd);
+         if (ltpose==1)
+            cppntposenb(f,g,bs,br,nxh,ny,kxp,kyp,kstrt,nvp,2,nxvh,nyv,
+                        kxp,kypd);
+         else
+            cppntpose(f,g,bs,br,nxh,ny,kxp,kyp,kstrt,nvp,2,nxvh,nyv,kxp,
+                      kypd);
          cpwtimera(1,&tf,&dtime);
       }
 /* perform y fft */
@@ -1548,7 +2109,12 @@ void cwppfft2r2(float complex f[], float complex g[], float complex bs[],
                   nxhyd,nxyhd);
 /* transpose g array to f */
       cpwtimera(-1,ttp,&dtime);
-      cppntpose(g,f,br,bs,ny,nxh,kyp,kxp,kstrt,nvp,2,nyv,nxvh,kypd,kxp);
+      if (ltpose==1)
+         cppntposenb(g,f,br,bs,ny,nxh,kyp,kxp,kstrt,nvp,2,nyv,nxvh,kypd,
+                     kxp);
+      else
+         cppntpose(g,f,br,bs,ny,nxh,kyp,kxp,kstrt,nvp,2,nyv,nxvh,kypd,
+                   kxp);
       cpwtimera(1,ttp,&dtime);
 /* perform x fft */
       cppfft2r2xx(f,isign,mixup,sct,indx,indy,kstrt,kypi,kypp,nxvh,kypd,
@@ -1568,6 +2134,14 @@ void cpdicomp2l_(float *edges, int *nyp, int *noff, int *nypmx,
    return;
 }
 
+/*--------------------------------------------------------------------*/
+void cpfedges2_(float *edges, int *nyp, int *noff, float *npicy,
+                int *nypmin, int *nypmax, int *ny, int *kstrt, int *nvp,
+                int *idps) {
+   cpfedges2(edges,nyp,noff,npicy,*nypmin,*nypmax,*ny,*kstrt,*nvp,*idps);
+   return;
+}
+
 /*--------------------------------------------------------------------*/
 void cpdistr2_(float *part, float *edges, int *npp, int *nps, float *vtx,
                float *vty, float *vdx, float *vdy, int *npx, int *npy,
@@ -1603,6 +2177,65 @@ void cppdsortp2yl_(float *parta, float *partb, int *npic, int *npp,
    return;
 }
 
+/*--------------------------------------------------------------------*/
+void cppcount2y_(float *part, float *npicy, int *npp, int *idimp,
+                 int *npmax, int *ny) {
+   cppcount2y(part,npicy,*npp,*idimp,*npmax,*ny);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppholes2_(float *part, float *edges, int *npp, int *ihole,
+                int *idimp, int *npmax, int *idps, int *ntmax) {
+   cppholes2(part,edges,*npp,ihole,*idimp,*npmax,*idps,*ntmax);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cfcomp22_(int *nvp, int *nx, int *ny, int *nvpx, int *nvpy,
+               int *ierr) {
+   cfcomp22(nvp,*nx,*ny,nvpx,nvpy,ierr);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cpdicomp22l_(float *edges, int *nxyp, int *noff, int *nxpmx,
+                  int *nypmx, int *nxpmn, int *nypmn, int *nx, int *ny,
+                  int *kstrt, int *nvpx, int *nvpy, int *idps,
+                  int *idds) {
+   cpdicomp22l(edges,nxyp,noff,nxpmx,nypmx,nxpmn,nypmn,*nx,*ny,*kstrt,
+               *nvpx,*nvpy,*idps,*idds);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cpdistr22_(float *part, float *edges, int *npp, int *nps,
+                float *vtx, float *vty, float *vdx, float *vdy, int *npx,
+                int *npy, int *nx, int *ny, int *idimp, int *npmax,
+                int *idps, int *ipbc, int *ierr) {
+   cpdistr22(part,edges,npp,*nps,*vtx,*vty,*vdx,*vdy,*npx,*npy,*nx,*ny,
+             *idimp,*npmax,*idps,*ipbc,ierr);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppgpush22l_(float *part, float *fxy, int *npp, int *noff,
+                  float *qbm, float *dt, float *ek, int *nx, int *ny,
+                  int *idimp, int *npmax, int *nxv, int *nypmx,
+                  int *idds, int *ipbc) {
+   cppgpush22l(part,fxy,*npp,noff,*qbm,*dt,ek,*nx,*ny,*idimp,*npmax,
+               *nxv,*nypmx,*idds,*ipbc);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppgpost22l_(float *part, float *q, int *npp, int *noff, float *qm,
+                  int *idimp, int *npmax, int *nxv, int *nypmx,
+                  int *idds) {
+   cppgpost22l(part,q,*npp,noff,*qm,*idimp,*npmax,*nxv,*nypmx,*idds);
+   return;
+}
+
 /*--------------------------------------------------------------------*/
 void cppcguard2xl_(float *fxy, int *nyp, int *nx, int *ndim, int *nxe,
                    int *nypmx) {
@@ -1675,22 +2308,23 @@ void cppfft2r2xy_(float complex *g, int *isign, int *mixup,
 
 /*--------------------------------------------------------------------*/
 void cwppfft2r_(float complex *f, float complex *g, float complex *bs,
-                float complex *br, int *isign, int *ntpose, int *mixup,
-                float complex *sct, float *ttp, int *indx, int *indy,
-                int *kstrt, int *nvp, int *nxvh, int *nyv, int *kxp,
-                int *kyp, int *kypd, int *nxhyd, int *nxyhd) {
-   cwppfft2r(f,g,bs,br,*isign,*ntpose,mixup,sct,ttp,*indx,*indy,*kstrt,
-             *nvp,*nxvh,*nyv,*kxp,*kyp,*kypd,*nxhyd,*nxyhd);
+                float complex *br, int *isign, int *ntpose, int *ltpose,
+                int *mixup, float complex *sct, float *ttp, int *indx,
+                int *indy, int *kstrt, int *nvp, int *nxvh, int *nyv,
+                int *kxp, int *kyp, int *kypd, int *nxhyd, int *nxyhd) {
+   cwppfft2r(f,g,bs,br,*isign,*ntpose,*ltpose,mixup,sct,ttp,*indx,*indy,
+             *kstrt,*nvp,*nxvh,*nyv,*kxp,*kyp,*kypd,*nxhyd,*nxyhd);
    return;
 }
 
 /*--------------------------------------------------------------------*/
 void cwppfft2r2_(float complex *f, float complex *g, float complex *bs,
-                 float complex *br, int *isign, int *ntpose, int *mixup,
-                 float complex *sct, float *ttp, int *indx, int *indy,
-                 int *kstrt, int *nvp, int *nxvh, int *nyv, int *kxp,
-                 int *kyp, int *kypd, int *nxhyd, int *nxyhd) {
-   cwppfft2r2(f,g,bs,br,*isign,*ntpose,mixup,sct,ttp,*indx,*indy,*kstrt,
-              *nvp,*nxvh,*nyv,*kxp,*kyp,*kypd,*nxhyd,*nxyhd);
+                 float complex *br, int *isign, int *ntpose, int *ltpose,
+                 int *mixup, float complex *sct, float *ttp, int *indx,
+                 int *indy, int *kstrt, int *nvp, int *nxvh, int *nyv,
+                 int *kxp, int *kyp, int *kypd, int *nxhyd, int *nxyhd) {
+   cwppfft2r2(f,g,bs,br,*isign,*ntpose,*ltpose,mixup,sct,ttp,*indx,
+              *indy,*kstrt,*nvp,*nxvh,*nyv,*kxp,*kyp,*kypd,*nxhyd,
+              *nxyhd);
    return;
 }
@@ -48,6 +48,75 @@ c find maximum/minimum partition size
       nypmn = -mypm(2)
       return
       end
+c-----------------------------------------------------------------------
+      subroutine PFEDGES2(edges,nyp,noff,npicy,nypmin,nypmax,ny,kstrt,  
+     1nvp,idps)
+c this subroutine determines spatial boundaries for non-uniform
+c particle decomposition, so that each partition contains nearly the
+c same number of particles, calculates number of grid points in each
+c spatial region, and the offset of these grid points from the global
+c address.  all processors calculate the same boundaries.
+c integer boundaries are set.
+c input: npicy, nypmin, nypmax, ny, kstrt, nvp, idps
+c output: edges, nyp, noff
+c edges(1) = lower boundary of particle partition
+c edges(2) = upper boundary of particle partition
+c nyp = number of primary (complete) gridpoints in particle partition
+c noff = lowermost global gridpoint in particle partition
+c npicy(k) = number of particles in global grid row k, summed over
+c all processors
+c nypmin/nypmax = minimum/maximum value of nyp allowed
+c it is assumed that nvp*nypmin <= ny <= nvp*nypmax
+c ny = system length in y direction
+c kstrt = starting data block number (processor id + 1)
+c nvp = number of real or virtual processors
+c idps = number of partition boundaries
+      implicit none
+      integer nyp, noff, nypmin, nypmax, ny, kstrt, nvp, idps
+      real edges, npicy
+      dimension edges(idps), npicy(ny)
+c local data
+      integer k, n, kl, kr, kt
+      double precision sum1, sum2, anpav
+c find average number of particles per partition
+      sum1 = 0.0d0
+      do 10 k = 1, ny
+      sum1 = sum1 + dble(npicy(k))
+   10 continue
+      anpav = sum1/dble(nvp)
+c find upper boundary of each partition in turn, up to this one
+      kl = 0
+      kr = 0
+      k = 0
+      sum1 = 0.0d0
+      do 30 n = 1, kstrt
+      if (n.eq.nvp) then
+         kr = ny
+      else
+c find grid row closest to cumulative particle target
+         sum2 = anpav*dble(n)
+   20    if (k.lt.ny) then
+            if ((sum1 + 0.5d0*dble(npicy(k+1))).lt.sum2) then
+               sum1 = sum1 + dble(npicy(k+1))
+               k = k + 1
+               go to 20
+            endif
+         endif
+         kr = k
+c enforce partition size limits for this and remaining partitions
+         kt = max(ny-nypmax*(nvp-n),kl+nypmin)
+         kr = max(kr,kt)
+         kt = min(ny-nypmin*(nvp-n),kl+nypmax)
+         kr = min(kr,kt)
+      endif
+      if (n.lt.kstrt) kl = kr
+   30 continue
+      edges(1) = real(kl)
+      edges(2) = real(kr)
+      noff = kl
+      nyp = kr - kl
+      return
+      end
 c-----------------------------------------------------------------------
       subroutine PDISTR2(part,edges,npp,nps,vtx,vty,vdx,vdy,npx,npy,nx, 
      1ny,idimp,npmax,idps,ipbc,ierr)
@@ -403,6 +472,477 @@ c find addresses of particles at each grid and reorder particles
    50 continue
       return
       end
+c-----------------------------------------------------------------------
+      subroutine PPCOUNT2Y(part,npicy,npp,idimp,npmax,ny)
+c this subroutine counts the number of particles in each grid row in y
+c the result must be summed over processors to obtain the global
+c density profile used for load balancing
+c input: all except npicy, output: npicy
+c part(2,n) = position y of particle n in partition
+c npicy(k) = number of particles in global grid row k
+c npp = number of particles in partition
+c idimp = size of phase space
+c npmax = maximum number of particles in each partition
+c ny = system length in y direction
+      implicit none
+      integer npp, idimp, npmax, ny
+      real part, npicy
+      dimension part(idimp,npmax), npicy(ny)
+c local data
+      integer j, k, m
+c clear counter array
+      do 10 k = 1, ny
+      npicy(k) = 0.0
+   10 continue
+c find how many particles in each grid row
+      do 20 j = 1, npp
+      m = part(2,j)
+      m = m + 1
+      npicy(m) = npicy(m) + 1.0
+   20 continue
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPHOLES2(part,edges,npp,ihole,idimp,npmax,idps,ntmax)
+c this subroutine determines list of particles which are outside the
+c partition boundaries, as needed by PPMOVE2 after the boundaries
+c have been changed.  at most ntmax particles are listed, so that
+c the procedure must be repeated until no particles are found
+c input: all except ihole, output: ihole
+c part(2,n) = position y of particle n in partition
+c edges(1:2) = lower:upper boundary of particle partition
+c npp = number of particles in partition
+c ihole = location of hole left in particle arrays
+c ihole(1) = ih, number of holes left
+c idimp = size of phase space
+c npmax = maximum number of particles in each partition
+c idps = number of partition boundaries
+c ntmax = size of hole array for particles leaving processors
+      implicit none
+      integer npp, idimp, npmax, idps, ntmax
+      real part, edges
+      integer ihole
+      dimension part(idimp,npmax), edges(idps), ihole(ntmax+1)
+c local data
+      integer j, ih
+      real dy
+      ih = 0
+      do 10 j = 1, npp
+      dy = part(2,j)
+c find particles out of bounds
+      if ((dy.lt.edges(1)).or.(dy.ge.edges(2))) then
+         if (ih.lt.ntmax) then
+            ihole(ih+2) = j
+            ih = ih + 1
+         endif
+      endif
+   10 continue
+      ihole(1) = ih
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine FCOMP22(nvp,nx,ny,nvpx,nvpy,ierr)
+c determines optimal partition for nvp processors with 2D spatial
+c decomposition in x and y
+c input: nvp, number of processors, nx, ny = number of grids
+c output: nvpx, nvpy, processors in x, y direction, ierr = error code
+c nvp = number of real or virtual processors obtained
+c nx/ny = system length in x/y direction
+c nvpx/nvpy = number of real or virtual processors in x/y
+c ierr = (0,1) = (no,yes) error condition exists
+      implicit none
+      integer nvp, nx, ny, nvpx, nvpy, ierr
+c local data
+      integer lvp
+      double precision dt1
+      ierr = 0
+c prefer equal number of grids in x and y partitions
+      dt1 = sqrt(dble(nvp)*dble(nx)/dble(ny))
+c return total number of processors in x and y
+      nvpx = real(dt1)
+      if (nvpx.lt.1) nvpx = 1
+      nvpy = nvp/nvpx
+      lvp = nvpx*nvpy
+      if (lvp.gt.nvp) then
+         write (*,*) 'invalid partition:nvpx,nvpy,nvp=', nvpx, nvpy, nvp
+         ierr = 1
+         return
+      endif
+   10 if (lvp.ne.nvp) then
+         nvpx = nvpx - 1
+         nvpy = nvp/nvpx
+         lvp = nvpx*nvpy
+         go to 10
+      endif
+      nvp = lvp
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PDICOMP22L(edges,nxyp,noff,nxpmx,nypmx,nxpmn,nypmn,nx, 
+     1ny,kstrt,nvpx,nvpy,idps,idds)
+c this subroutine determines spatial boundaries for uniform particle
+c decomposition in x and y, calculates number of grid points in each
+c spatial region, and the offset of these grid points from the global
+c address
+c nvpx must be < nx and nvpy must be < ny.
+c some combinations of nx and nvpx and ny and nvpy result in a zero
+c value of nxyp.  this is not supported.
+c input: nx, ny, kstrt, nvpx, nvpy, idps, idds
+c output: edges, nxyp, noff, nxpmx, nypmx, nxpmn, nypmn
+c for 2D spatial decomposition
+c edges(1:2) = left/right boundary in x of particle partition
+c edges(3:4) = lower/upper boundary in y of particle partition
+c nxyp(1:2) = number of primary (complete) gridpoints in x/y
+c noff(1) = leftmost global gridpoint in x in particle partition
+c noff(2) = lowermost global gridpoint in y in particle partition
+c nxpmx = maximum size of particle partition in x, including guard cells
+c nypmx = maximum size of particle partition in y, including guard cells
+c nxpmn = minimum value of nxyp(1)
+c nypmn = minimum value of nxyp(2)
+c nx/ny = system length in x/y direction
+c kstrt = starting data block number (processor id + 1)
+c nvpx/nvpy = number of real or virtual processors in x/y
+c idps = number of particle partition boundaries = 4
+c idds = dimensionality of domain decomposition = 2
+      implicit none
+      integer nxpmx, nypmx, nxpmn, nypmn, nx, ny, kstrt, nvpx, nvpy
+      integer idps, idds
+      integer nxyp, noff
+      real edges
+      dimension nxyp(idds), noff(idds)
+      dimension edges(idps)
+c local data
+      integer jb, kb, kxp, kyp
+      real at1, at2, anx, any
+      integer mxypm, iwork4
+      dimension mxypm(4), iwork4(4)
+      anx = real(nx)
+      any = real(ny)
+c determine decomposition
+c find processor id in x/y
+      kb = (kstrt - 1)/nvpx
+      jb = kstrt - nvpx*kb - 1
+c boundaries in x
+      kxp = (nx - 1)/nvpx + 1
+      at1 = real(kxp)
+      edges(1) = at1*real(jb)
+      if (edges(1).gt.anx) edges(1) = anx
+      noff(1) = edges(1)
+      edges(2) = at1*real(jb + 1)
+      if (edges(2).gt.anx) edges(2) = anx
+      jb = edges(2)
+      nxyp(1) = jb - noff(1)
+c boundaries in y
+      kyp = (ny - 1)/nvpy + 1
+      at2 = real(kyp)
+      edges(3) = at2*real(kb)
+      if (edges(3).gt.any) edges(3) = any
+      noff(2) = edges(3)
+      edges(4) = at2*real(kb + 1)
+      if (edges(4).gt.any) edges(4) = any
+      kb = edges(4)
+      nxyp(2) = kb - noff(2)
+c find maximum/minimum partition size in x and y
+      mxypm(1) = nxyp(1)
+      mxypm(2) = -nxyp(1)
+      mxypm(3) = nxyp(2)
+      mxypm(4) = -nxyp(2)
+      call PPIMAX(mxypm,iwork4,4)
+      nxpmx = mxypm(1) + 1
+      nxpmn = -mxypm(2)
+      nypmx = mxypm(3) + 1
+      nypmn = -mxypm(4)
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PDISTR22(part,edges,npp,nps,vtx,vty,vdx,vdy,npx,npy,nx,
+     1ny,idimp,npmax,idps,ipbc,ierr)
+c for 2d code, this subroutine calculates initial particle co-ordinates
+c and velocities with uniform density and maxwellian velocity with drift
+c for distributed data with 2D spatial decomposition
+c input: all except part, npp, ierr, output: part, npp, ierr
+c part(1,n) = position x of particle n in partition
+c part(2,n) = position y of particle n in partition
+c part(3,n) = velocity vx of particle n in partition
+c part(4,n) = velocity vy of particle n in partition
+c edges(1:2) = left/right boundary in x of particle partition
+c edges(3:4) = lower/upper boundary in y of particle partition
+c npp = number of particles in partition
+c nps = starting address of particles in partition
+c vtx/vty = thermal velocity of electrons in x/y direction
+c vdx/vdy = drift velocity of beam electrons in x/y direction
+c npx/npy = initial number of particles distributed in x/y direction
+c nx/ny = system length in x/y direction
+c idimp = size of phase space = 4
+c npmax = maximum number of particles in each partition
+c idps = number of particle partition boundaries = 4
+c ipbc = particle boundary condition = (0,1,2,3) =
+c (none,2d periodic,2d reflecting,mixed reflecting/periodic)
+c ierr = (0,1) = (no,yes) error condition exists
+c ranorm = gaussian random number with zero mean and unit variance
+c with 2D spatial decomposition
+      implicit none
+      integer npp, nps, npx, npy, nx, ny, idimp, npmax, idps, ipbc, ierr
+      real vtx, vty, vdx, vdy
+      real part, edges
+      dimension part(idimp,npmax), edges(idps)
+c local data
+      integer j, k, npt, npxyp
+      real edgelx, edgely, at1, at2, xt, yt, vxt, vyt
+      double precision dnpx, dnpxy, dt1
+      integer ierr1, iwork1
+      double precision sum3, work3
+      dimension ierr1(1), iwork1(1), sum3(3), work3(3)
+      double precision ranorm
+      ierr = 0
+c particle distribution constant
+      dnpx = dble(npx)
+c set boundary values
+      edgelx = 0.0
+      edgely = 0.0
+      at1 = real(nx)/real(npx)
+      at2 = real(ny)/real(npy)
+      if (ipbc.eq.2) then
+         edgelx = 1.0
+         edgely = 1.0
+         at1 = real(nx-2)/real(npx)
+         at2 = real(ny-2)/real(npy)
+      else if (ipbc.eq.3) then
+         edgelx = 1.0
+         at1 = real(nx-2)/real(npx)
+      endif
+c uniform density profile
+      do 20 k = 1, npy
+      yt = edgely + at2*(real(k) - 0.5)
+      do 10 j = 1, npx
+      xt = edgelx + at1*(real(j) - 0.5)
+c maxwellian velocity distribution
+      vxt = vtx*ranorm()
+      vyt = vty*ranorm()
+      if ((xt.ge.edges(1)).and.(xt.lt.edges(2)).and.(yt.ge.edges(3))   
+     1.and.(yt.lt.edges(4))) then
+         npt = npp + 1
+         if (npt.le.npmax) then
+            part(1,npt) = xt
+            part(2,npt) = yt
+            part(3,npt) = vxt
+            part(4,npt) = vyt
+            npp = npt
+         else
+            ierr = ierr + 1
+         endif
+      endif
+   10 continue
+   20 continue
+      npxyp = 0
+c add correct drift
+      sum3(1) = 0.0d0
+      sum3(2) = 0.0d0
+      do 30 j = nps, npp
+      npxyp = npxyp + 1
+      sum3(1) = sum3(1) + part(3,j)
+      sum3(2) = sum3(2) + part(4,j)
+   30 continue
+      sum3(3) = npxyp
+      call PPDSUM(sum3,work3,3)
+      dnpxy = sum3(3)
+      ierr1(1) = ierr
+      call PPIMAX(ierr1,iwork1,1)
+      ierr = ierr1(1)
+      dt1 = 1.0d0/dnpxy
+      sum3(1) = dt1*sum3(1) - vdx
+      sum3(2) = dt1*sum3(2) - vdy
+      do 40 j = nps, npp
+      part(3,j) = part(3,j) - sum3(1)
+      part(4,j) = part(4,j) - sum3(2)
+   40 continue
+c process errors
+      dnpxy = dnpxy - dnpx*dble(npy)
+      if (dnpxy.ne.0.0d0) ierr = dnpxy
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPGPUSH22L(part,fxy,npp,noff,qbm,dt,ek,nx,ny,idimp,    
+     1npmax,nxv,nypmx,idds,ipbc)
+c for 2d code, this subroutine updates particle co-ordinates and
+c velocities using leap-frog scheme in time and first-order linear
+c interpolation in space, with various boundary conditions
+c scalar version using guard cells, for distributed data
+c with 2D spatial decomposition.  periodic boundaries are applied by
+c PPMOVEG22, which also finds the particles leaving this processor
+c 42 flops/particle, 12 loads, 4 stores
+c input: all, output: part, ek
+c equations used are:
+c vx(t+dt/2) = vx(t-dt/2) + (q/m)*fx(x(t),y(t))*dt,
+c vy(t+dt/2) = vy(t-dt/2) + (q/m)*fy(x(t),y(t))*dt,
+c where q/m is charge/mass, and
+c x(t+dt) = x(t) + vx(t+dt/2)*dt, y(t+dt) = y(t) + vy(t+dt/2)*dt
+c fx(x(t),y(t)) and fy(x(t),y(t)) are approximated by interpolation from
+c the nearest grid points:
+c fx(x,y) = (1-dy)*((1-dx)*fx(n,m)+dx*fx(n+1,m)) + dy*((1-dx)*fx(n,m+1)
+c    + dx*fx(n+1,m+1))
+c fy(x,y) = (1-dy)*((1-dx)*fy(n,m)+dx*fy(n+1,m)) + dy*((1-dx)*fy(n,m+1)
+c    + dx*fy(n+1,m+1))
+c where n,m = leftmost grid points and dx = x-n, dy = y-m
+c part(1,n) = position x of particle n in partition
+c part(2,n) = position y of particle n in partition
+c part(3,n) = velocity vx of particle n in partition
+c part(4,n) = velocity vy of particle n in partition
+c fxy(1,j,k) = x component of force/charge at grid (jj,kk)
+c fxy(2,j,k) = y component of force/charge at grid (jj,kk)
+c in other words, fxy are the convolutions of the electric field
+c over the particle shape, where jj = j + noff(1) - 1 and
+c kk = k + noff(2) - 1
+c npp = number of particles in partition
+c noff(1:2) = leftmost/lowermost global gridpoint in particle partition
+c qbm = particle charge/mass
+c dt = time interval between successive calculations
+c kinetic energy/mass at time t is also calculated, using
+c ek = .125*sum((vx(t+dt/2)+vx(t-dt/2))**2+(vy(t+dt/2)+vy(t-dt/2))**2)
+c nx/ny = system length in x/y direction
+c idimp = size of phase space = 4
+c npmax = maximum number of particles in each partition
+c nxv = second dimension of field array, must be >= nxpmx
+c nypmx = maximum size of particle partition in y, including guard cells
+c idds = dimensionality of domain decomposition = 2
+c ipbc = particle boundary condition = (0,1,2,3) =
+c (none,2d periodic,2d reflecting,mixed reflecting/periodic)
+      implicit none
+      integer npp, nx, ny, idimp, npmax, nxv, nypmx, idds, ipbc
+      real qbm, dt, ek
+      real part, fxy
+      integer noff
+      dimension part(idimp,npmax), fxy(2,nxv,nypmx)
+      dimension noff(idds)
+c local data
+      integer lnoff, mnoff, j, nn, mm, np, mp
+      real qtm, edgelx, edgely, edgerx, edgery, dxp, dyp, amx, amy
+      real dx, dy
+      double precision sum1
+      qtm = qbm*dt
+      sum1 = 0.0d0
+c set boundary values
+      edgelx = 0.0
+      edgely = 1.0
+      edgerx = real(nx)
+      edgery = real(ny-1)
+      if ((ipbc.eq.2).or.(ipbc.eq.3)) then
+         edgelx = 1.0
+         edgerx = real(nx-1)
+      endif
+      lnoff = noff(1) - 1
+      mnoff = noff(2) - 1
+      do 10 j = 1, npp
+c find interpolation weights
+      nn = part(1,j)
+      mm = part(2,j)
+      dxp = part(1,j) - real(nn)
+      dyp = part(2,j) - real(mm)
+      nn = nn - lnoff
+      mm = mm - mnoff
+      amx = 1.0 - dxp
+      mp = mm + 1
+      amy = 1.0 - dyp
+      np = nn + 1
+c find acceleration
+      dx = dyp*(dxp*fxy(1,np,mp) + amx*fxy(1,nn,mp))                    
+     1   + amy*(dxp*fxy(1,np,mm) + amx*fxy(1,nn,mm))
+      dy = dyp*(dxp*fxy(2,np,mp) + amx*fxy(2,nn,mp))                    
+     1   + amy*(dxp*fxy(2,np,mm) + amx*fxy(2,nn,mm))
+c new velocity
+      dx = part(3,j) + qtm*dx
+      dy = part(4,j) + qtm*dy
+c average kinetic energy
+      sum1 = sum1 + (dx + part(3,j))**2 + (dy + part(4,j))**2
+      part(3,j) = dx
+      part(4,j) = dy
+c new position
+      dx = part(1,j) + dx*dt
+      dy = part(2,j) + dy*dt
+c reflecting boundary conditions
+      if (ipbc.eq.2) then
+         if ((dx.lt.edgelx).or.(dx.ge.edgerx)) then
+            dx = part(1,j)
+            part(3,j) = -part(3,j)
+         endif
+         if ((dy.lt.edgely).or.(dy.ge.edgery)) then
+            dy = part(2,j)
+            part(4,j) = -part(4,j)
+         endif
+c mixed reflecting/periodic boundary conditions
+      else if (ipbc.eq.3) then
+         if ((dx.lt.edgelx).or.(dx.ge.edgerx)) then
+            dx = part(1,j)
+            part(3,j) = -part(3,j)
+         endif
+      endif
+c set new position
+      part(1,j) = dx
+      part(2,j) = dy
+   10 continue
+c normalize kinetic energy
+      ek = ek + 0.125*sum1
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPGPOST22L(part,q,npp,noff,qm,idimp,npmax,nxv,nypmx,   
+     1idds)
+c for 2d code, this subroutine calculates particle charge density
+c using first-order linear interpolation, periodic boundaries
+c scalar version using guard cells, for distributed data
+c with 2D spatial decomposition
+c 17 flops/particle, 6 loads, 4 stores
+c input: all, output: q
+c charge density is approximated by values at the nearest grid points
+c q(n,m)=qm*(1.-dx)*(1.-dy)
+c q(n+1,m)=qm*dx*(1.-dy)
+c q(n,m+1)=qm*(1.-dx)*dy
+c q(n+1,m+1)=qm*dx*dy
+c where n,m = leftmost grid points and dx = x-n, dy = y-m
+c part(1,n) = position x of particle n in partition
+c part(2,n) = position y of particle n in partition
+c q(j,k) = charge density at grid point (jj,kk),
+c where jj = j + noff(1) - 1 and kk = k + noff(2) - 1
+c npp = number of particles in partition
+c noff(1:2) = leftmost/lowermost global gridpoint in particle partition
+c qm = charge on particle, in units of e
+c idimp = size of phase space = 4
+c npmax = maximum number of particles in each partition
+c nxv = first dimension of charge array, must be >= nxpmx
+c nypmx = maximum size of particle partition in y, including guard cells
+c idds = dimensionality of domain decomposition = 2
+      implicit none
+      integer npp, idimp, npmax, nxv, nypmx, idds
+      real qm
+      real part, q
+      integer noff
+      dimension part(idimp,npmax), q(nxv,nypmx)
+      dimension noff(idds)
+c local data
+      integer lnoff, mnoff, j, nn, np, mm, mp
+      real dxp, dyp, amx, amy
+      lnoff = noff(1) - 1
+      mnoff = noff(2) - 1
+      do 10 j = 1, npp
+c find interpolation weights
+      nn = part(1,j)
+      mm = part(2,j)
+      dxp = qm*(part(1,j) - real(nn))
+      dyp = part(2,j) - real(mm)
+      nn = nn - lnoff
+      mm = mm - mnoff
+      amx = qm - dxp
+      mp = mm + 1
+      amy = 1.0 - dyp
+      np = nn + 1
+c deposit charge
+      q(np,mp) = q(np,mp) + dxp*dyp
+      q(nn,mp) = q(nn,mp) + amx*dyp
+      q(np,mm) = q(np,mm) + dxp*amy
+      q(nn,mm) = q(nn,mm) + amx*amy
+   10 continue
+      return
+      end
 c-----------------------------------------------------------------------
       subroutine PPCGUARD2XL(fxy,nyp,nx,ndim,nxe,nypmx)
 c replicate extended periodic vector field in x direction
@@ -632,17 +1172,18 @@ c sine/cosine table for the angles 2*n*pi/nxy
       return
       end
 c-----------------------------------------------------------------------
-      subroutine WPPFFT2R(f,g,bs,br,isign,ntpose,mixup,sct,ttp,indx,indy
-     1,kstrt,nvp,nxvh,nyv,kxp,kyp,kypd,nxhyd,nxyhd)
+      subroutine WPPFFT2R(f,g,bs,br,isign,ntpose,ltpose,mixup,sct,ttp,in
+     1dx,indy,kstrt,nvp,nxvh,nyv,kxp,kyp,kypd,nxhyd,nxyhd)
 c wrapper function for 2d real to complex fft, with packed data
 c parallelized with MPI
+c ltpose = (0,1) = (no,yes) use non-blocking transpose
       implicit none
-      integer isign, ntpose, indx, indy, kstrt, nvp, nxvh, nyv, kxp, kyp
-      integer kypd, nxhyd, nxyhd, mixup
+      integer isign, ntpose, ltpose, indx, indy, kstrt, nvp, nxvh, nyv
+      integer kxp, kyp, kypd, nxhyd, nxyhd, mixup
       real ttp
       complex f, g, bs, br, sct
       dimension f(nxvh,kypd), g(nyv,kxp)
-      dimension bs(kxp,kyp), br(kxp,kyp)
+      dimension bs(kxp*kyp,*), br(kxp*kyp,*)
       dimension mixup(nxhyd), sct(nxyhd)
 c local data
       integer nxh, ny, kxpi, kypi, ks, kxpp, kypp
@@ -662,8 +1203,13 @@ c perform x fft
      1,kypd,nxhyd,nxyhd)
 c transpose f array to g
          call PWTIMERA(-1,ttp,dtime)
-         call PPTPOSE(f,g,bs,br,nxh,ny,kxp,kyp,kstrt,nvp,nxvh,nyv,kxp,  
-     1kypd)
+         if (ltpose.eq.1) then
+            call PPTPOSENB(f,g,bs,br,nxh,ny,kxp,kyp,kstrt,nvp,nxvh,nyv,k
+     1xp,kypd)
+         else
+            call PPTPOSE(f,g,bs,br,nxh,ny,kxp,kyp,kstrt,nvp,nxvh,nyv,kxp
+     1,kypd)
+         endif
          call PWTIMERA(1,ttp,dtime)
 c perform y fft
          call PPFFT2RXY(g,isign,mixup,sct,indx,indy,kstrt,kxpi,kxpp,nyv,
@@ -671,8 +1217,13 @@ c perform y fft
 c transpose g array to f
          if (ntpose.eq.0) then
             call PWTIMERA(-1,tf,dtime)
-            call PPTPOSE(g,f,br,bs,ny,nxh,kyp,kxp,kstrt,nvp,nyv,nxvh,   
+            if (ltpose.eq.1) then
+               call PPTPOSENB(g,f,br,bs,ny,nxh,kyp,kxp,kstrt,nvp,nyv,nxv
+     1h,kypd,kxp)
+            else
+               call PPTPOSE(g,f,br,bs,ny,nxh,kyp,kxp,kstrt,nvp,nyv,nxvh,
      1kypd,kxp)
+            endif
             call PWTIMERA(1,tf,dtime)
          endif
 c forward fourier transform
@@ -680,8 +1231,13 @@ c forward fourier transform
 c transpose f array to g
          if (ntpose.eq.0) then
             call PWTIMERA(-1,tf,dtime)
-            call PPTPOSE(f,g,bs,br,nxh,ny,kxp,kyp,kstrt,nvp,nxvh,nyv,kxp
-     1,kypd)
+            if (ltpose.eq.1) then
+               call PPTPOSENB(f,g,bs,br,nxh,ny,kxp,kyp,kstrt,nvp,nxvh,ny
+     1v,kxp,kypd)
+            else
+               call PPTPOSE(f,g,bs,br,nxh,ny,kxp,kyp,kstrt,nvp,nxvh,nyv,
+     1kxp,kypd)
+            endif
             call PWTIMERA(1,tf,dtime)
          endif
 c perform y fft
@@ -689,8 +1245,13 @@ c perform y fft
      1kxp,nxhyd,nxyhd)
 c transpose g array to f
          call PWTIMERA(-1,ttp,dtime)
-         call PPTPOSE(g,f,br,bs,ny,nxh,kyp,kxp,kstrt,nvp,nyv,nxvh,kypd, 
-     1kxp)
+         if (ltpose.eq.1) then
+            call PPTPOSENB(g,f,br,bs,ny,nxh,kyp,kxp,kstrt,nvp,nyv,nxvh,k
+     1ypd,kxp)
+         else
+            call PPTPOSE(g,f,br,bs,ny,nxh,kyp,kxp,kstrt,nvp,nyv,nxvh,kyp
+     1d,kxp)
+         endif
          call PWTIMERA(1,ttp,dtime)
 c perform x fft
          call PPFFT2RXX(f,isign,mixup,sct,indx,indy,kstrt,kypi,kypp,nxvh
@@ -700,17 +1261,18 @@ c perform x fft
       return
       end
 c-----------------------------------------------------------------------
-      subroutine WPPFFT2R2(f,g,bs,br,isign,ntpose,mixup,sct,ttp,indx,ind
-     1y,kstrt,nvp,nxvh,nyv,kxp,kyp,kypd,nxhyd,nxyhd)
+      subroutine WPPFFT2R2(f,g,bs,br,isign,ntpose,ltpose,mixup,sct,ttp,i
+     1ndx,indy,kstrt,nvp,nxvh,nyv,kxp,kyp,kypd,nxhyd,nxyhd)
 c wrapper function for 2 2d real to complex ffts, with packed data
 c parallelized with MPI
+c ltpose = (0,1) = (no,yes) use non-blocking transpose
       implicit none
-      integer isign, ntpose, indx, indy, kstrt, nvp, nxvh, nyv, kxp, kyp
-      integer kypd, nxhyd, nxyhd, mixup
+      integer isign, ntpose, ltpose, indx, indy, kstrt, nvp, nxvh, nyv
+      integer kxp, kyp, kypd, nxhyd, nxyhd, mixup
       real ttp
       complex f, g, bs, br, sct
       dimension f(2,nxvh,kypd), g(2,nyv,kxp)
-      dimension bs(2,kxp,kyp), br(2,kxp,kyp)
+      dimension bs(2,kxp*kyp,*), br(2,kxp*kyp,*)
       dimension mixup(nxhyd), sct(nxyhd)
 c local data
       integer nxh, ny, kxpi, kypi, ks, kxpp, kypp
@@ -730,8 +1292,13 @@ c perform x fft
      1nxvh,kypd,nxhyd,nxyhd)
 c transpose f array to g
          call PWTIMERA(-1,ttp,dtime)
-         call PPNTPOSE(f,g,bs,br,nxh,ny,kxp,kyp,kstrt,nvp,2,nxvh,nyv,kxp
-     1,kypd)
+         if (ltpose.eq.1) then
+            call PPNTPOSENB(f,g,bs,br,nxh,ny,kxp,kyp,kstrt,nvp,2,nxvh,ny
+     1v,kxp,kypd)
+         else
+            call PPNTPOSE(f,g,bs,br,nxh,ny,kxp,kyp,kstrt,nvp,2,nxvh,nyv,
+     1kxp,kypd)
+         endif
          call PWTIMERA(1,ttp,dtime)
 c perform y fft
          call PPFFT2R2XY(g,isign,mixup,sct,indx,indy,kstrt,kxpi,kxpp,nyv
@@ -739,8 +1306,13 @@ c perform y fft
 c transpose g array to f
          if (ntpose.eq.0) then
             call PWTIMERA(-1,tf,dtime)
-            call PPNTPOSE(g,f,br,bs,ny,nxh,kyp,kxp,kstrt,nvp,2,nyv,nxvh,
-     1kypd,kxp)
+            if (ltpose.eq.1) then
+               call PPNTPOSENB(g,f,br,bs,ny,nxh,kyp,kxp,kstrt,nvp,2,nyv,
+     1nxvh,kypd,kxp)
+            else
+               call PPNTPOSE(g,f,br,bs,ny,nxh,kyp,kxp,kstrt,nvp,2,nyv,nx
+     1vh,kypd,kxp)
+            endif
             call PWTIMERA(1,tf,dtime)
          endif
 c forward fourier transform
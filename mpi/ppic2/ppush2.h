@@ -5,6 +5,10 @@ double ranorm();
 void cpdicomp2l(float edges[], int *nyp, int *noff, int *nypmx,
                 int *nypmn, int ny, int kstrt, int nvp, int idps);
 
+void cpfedges2(float edges[], int *nyp, int *noff, float npicy[],
+               int nypmin, int nypmax, int ny, int kstrt, int nvp,
+               int idps);
+
 void cpdistr2(float part[], float edges[], int *npp, int nps, float vtx,
               float vty, float vdx, float vdy, int npx, int npy, int nx,
               int ny, int idimp, int npmax, int idps, int ipbc, int *ierr);
@@ -20,6 +24,32 @@ void cppgpost2l(float part[], float q[], int npp, int noff, float qm,
 void cppdsortp2yl(float parta[], float partb[], int npic[], int npp,
                   int noff, int nyp, int idimp, int npmax, int nypm1);
 
+void cppcount2y(float part[], float npicy[], int npp, int idimp,
+                int npmax, int ny);
+
+void cppholes2(float part[], float edges[], int npp, int ihole[],
+               int idimp, int npmax, int idps, int ntmax);
+
+void cfcomp22(int *nvp, int nx, int ny, int *nvpx, int *nvpy,
+              int *ierr);
+
+void cpdicomp22l(float edges[], int nxyp[], int noff[], int *nxpmx,
+                 int *nypmx, int *nxpmn, int *nypmn, int nx, int ny,
+                 int kstrt, int nvpx, int nvpy, int idps, int idds);
+
+void cpdistr22(float part[], float edges[], int *npp, int nps,
+               float vtx, float vty, float vdx, float vdy, int npx,
+               int npy, int nx, int ny, int idimp, int npmax, int idps,
+               int ipbc, int *ierr);
+
+void cppgpush22l(float part[], float fxy[], int npp, int noff[],
+                 float qbm, float dt, float *ek, int nx, int ny,
+                 int idimp, int npmax, int nxv, int nypmx, int idds,
+                 int ipbc);
+
+void cppgpost22l(float part[], float q[], int npp, int noff[], float qm,
+                 int idimp, int npmax, int nxv, int nypmx, int idds);
+
 void cppcguard2xl(float fxy[], int nyp, int nx, int ndim, int nxe,
                   int nypmx);
 
@@ -54,13 +84,13 @@ void cppfft2r2xy(float complex g[], int isign, int mixup[],
                  int nxyhd);
 
 void cwppfft2r(float complex f[], float complex g[], float complex bs[],
-               float complex br[], int isign, int ntpose, int mixup[],
-               float complex sct[], float *ttp, int indx, int indy,
-               int kstrt, int nvp, int nxvh, int nyv, int kxp, int kyp,
-               int kypd, int nxhyd, int nxyhd);
+               float complex br[], int isign, int ntpose, int ltpose,
+               int mixup[], float complex sct[], float *ttp, int indx,
+               int indy, int kstrt, int nvp, int nxvh, int nyv, int kxp,
+               int kyp, int kypd, int nxhyd, int nxyhd);
 
 void cwppfft2r2(float complex f[], float complex g[], float complex bs[],
-                float complex br[], int isign, int ntpose, int mixup[],
-                float complex sct[], float *ttp, int indx, int indy,
-                int kstrt, int nvp, int nxvh, int nyv, int kxp, int kyp,
-                int kypd, int nxhyd, int nxyhd);
+                float complex br[], int isign, int ntpose, int ltpose,
+                int mixup[], float complex sct[], float *ttp, int indx,
+                int indy, int kstrt, int nvp, int nxvh, int nyv, int kxp,
+                int kyp, int kypd, int nxhyd, int nxyhd);
@@ -8,6 +8,10 @@ double ranorm_();
 void pdicomp2l_(float *edges, int *nyp, int *noff, int *nypmx,
                 int *nypmn, int *ny, int *kstrt, int *nvp, int *idps);
 
+void pfedges2_(float *edges, int *nyp, int *noff, float *npicy,
+               int *nypmin, int *nypmax, int *ny, int *kstrt, int *nvp,
+               int *idps);
+
 void pdistr2_(float *part, float *edges, int *npp, int *nps, float *vtx,
               float *vty, float *vdx, float *vdy, int *npx, int *npy,
               int *nx, int *ny, int *idimp, int *npmax, int *idps,
@@ -25,6 +29,32 @@ void ppdsortp2yl_(float *parta, float *partb, int *npic, int *npp,
                   int *noff, int *nyp, int *idimp, int *npmax,
                   int *nypm1);
 
+void ppcount2y_(float *part, float *npicy, int *npp, int *idimp,
+                int *npmax, int *ny);
+
+void ppholes2_(float *part, float *edges, int *npp, int *ihole,
+               int *idimp, int *npmax, int *idps, int *ntmax);
+
+void fcomp22_(int *nvp, int *nx, int *ny, int *nvpx, int *nvpy,
+              int *ierr);
+
+void pdicomp22l_(float *edges, int *nxyp, int *noff, int *nxpmx,
+                 int *nypmx, int *nxpmn, int *nypmn, int *nx, int *ny,
+                 int *kstrt, int *nvpx, int *nvpy, int *idps, int *idds);
+
+void pdistr22_(float *part, float *edges, int *npp, int *nps, float *vtx,
+               float *vty, float *vdx, float *vdy, int *npx, int *npy,
+               int *nx, int *ny, int *idimp, int *npmax, int *idps,
+               int *ipbc, int *ierr);
+
+void ppgpush22l_(float *part, float *fxy, int *npp, int *noff,
+                 float *qbm, float *dt, float *ek, int *nx, int *ny,
+                 int *idimp, int *npmax, int *nxv, int *nypmx, int *idds,
+                 int *ipbc);
+
+void ppgpost22l_(float *part, float *q, int *npp, int *noff, float *qm,
+                 int *idimp, int *npmax, int *nxv, int *nypmx, int *idds);
+
 void ppcguard2xl_(float *fxy, int *nyp, int *nx, int *ndim, int *nxe,
                   int *nypmx);
 
@@ -59,16 +89,16 @@ void ppfft2r2xy_(float complex *g, int *isign, int *mixup,
                  int *nxyhd);
 
 void wppfft2r_(float complex *f, float complex *g, float complex *bs,
-               float complex *br, int *isign, int *ntpose, int *mixup,
-               float complex *sct, float *ttp, int *indx, int *indy,
-               int *kstrt, int *nvp, int *nxvh, int *nyv, int *kxp,
-               int *kyp, int *kypd, int *nxhyd, int *nxyhd);
+               float complex *br, int *isign, int *ntpose, int *ltpose,
+               int *mixup, float complex *sct, float *ttp, int *indx,
+               int *indy, int *kstrt, int *nvp, int *nxvh, int *nyv,
+               int *kxp, int *kyp, int *kypd, int *nxhyd, int *nxyhd);
 
 void wppfft2r2_(float complex *f, float complex *g, float complex *bs,
-                float complex *br, int *isign, int *ntpose, int *mixup,
-                float complex *sct, float *ttp, int *indx, int *indy,
-                int *kstrt, int *nvp, int *nxvh, int *nyv, int *kxp,
-                int *kyp, int *kypd, int *nxhyd, int *nxyhd);
+                float complex *br, int *isign, int *ntpose, int *ltpose,
+                int *mixup, float complex *sct, float *ttp, int *indx,
+                int *indy, int *kstrt, int *nvp, int *nxvh, int *nyv,
+                int *kxp, int *kyp, int *kypd, int *nxhyd, int *nxyhd);
 
 /* Interfaces to C */
 
@@ -83,6 +113,14 @@ void cpdicomp2l(float edges[], int *nyp, int *noff, int *nypmx,
    return;
 }
 
+/*--------------------------------------------------------------------*/
+void cpfedges2(float edges[], int *nyp, int *noff, float npicy[],
+               int nypmin, int nypmax, int ny, int kstrt, int nvp,
+               int idps) {
+   pfedges2_(edges,nyp,noff,npicy,&nypmin,&nypmax,&ny,&kstrt,&nvp,&idps);
+   return;
+}
+
 /*--------------------------------------------------------------------*/
 void cpdistr2(float part[], float edges[], int *npp, int nps, float vtx,
               float vty, float vdx, float vdy, int npx, int npy, int nx,
@@ -116,6 +154,63 @@ void cppdsortp2yl(float parta[], float partb[], int npic[], int npp,
    return;
 }
 
+/*--------------------------------------------------------------------*/
+void cppcount2y(float part[], float npicy[], int npp, int idimp,
+                int npmax, int ny) {
+   ppcount2y_(part,npicy,&npp,&idimp,&npmax,&ny);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppholes2(float part[], float edges[], int npp, int ihole[],
+               int idimp, int npmax, int idps, int ntmax) {
+   ppholes2_(part,edges,&npp,ihole,&idimp,&npmax,&idps,&ntmax);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cfcomp22(int *nvp, int nx, int ny, int *nvpx, int *nvpy,
+              int *ierr) {
+   fcomp22_(nvp,&nx,&ny,nvpx,nvpy,ierr);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cpdicomp22l(float edges[], int nxyp[], int noff[], int *nxpmx,
+                 int *nypmx, int *nxpmn, int *nypmn, int nx, int ny,
+                 int kstrt, int nvpx, int nvpy, int idps, int idds) {
+   pdicomp22l_(edges,nxyp,noff,nxpmx,nypmx,nxpmn,nypmn,&nx,&ny,&kstrt,
+               &nvpx,&nvpy,&idps,&idds);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cpdistr22(float part[], float edges[], int *npp, int nps,
+               float vtx, float vty, float vdx, float vdy, int npx,
+               int npy, int nx, int ny, int idimp, int npmax, int idps,
+               int ipbc, int *ierr) {
+   pdistr22_(part,edges,npp,&nps,&vtx,&vty,&vdx,&vdy,&npx,&npy,&nx,&ny,
+             &idimp,&npmax,&idps,&ipbc,ierr);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppgpush22l(float part[], float fxy[], int npp, int noff[],
+                 float qbm, float dt, float *ek, int nx, int ny,
+                 int idimp, int npmax, int nxv, int nypmx, int idds,
+                 int ipbc) {
+   ppgpush22l_(part,fxy,&npp,noff,&qbm,&dt,ek,&nx,&ny,&idimp,&npmax,&nxv,
+               &nypmx,&idds,&ipbc);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppgpost22l(float part[], float q[], int npp, int noff[], float qm,
+                 int idimp, int npmax, int nxv, int nypmx, int idds) {
+   ppgpost22l_(part,q,&npp,noff,&qm,&idimp,&npmax,&nxv,&nypmx,&idds);
+   return;
+}
+
 /*--------------------------------------------------------------------*/
 void cppcguard2xl(float fxy[], int nyp, int nx, int ndim, int nxe,
                   int nypmx) {
@@ -188,22 +283,23 @@ void cppfft2r2xy(float complex g[], int isign, int mixup[],
 
 /*--------------------------------------------------------------------*/
 void cwppfft2r(float complex f[], float complex g[], float complex bs[],
-               float complex br[], int isign, int ntpose, int mixup[],
-               float complex sct[], float *ttp, int indx, int indy,
-               int kstrt, int nvp, int nxvh, int nyv, int kxp, int kyp,
-               int kypd, int nxhyd, int nxyhd) {
-   wppfft2r_(f,g,bs,br,&isign,&ntpose,mixup,sct,ttp,&indx,&indy,&kstrt,
-             &nvp,&nxvh,&nyv,&kxp,&kyp,&kypd,&nxhyd,&nxyhd);
+               float complex br[], int isign, int ntpose, int ltpose,
+               int mixup[], float complex sct[], float *ttp, int indx,
+               int indy, int kstrt, int nvp, int nxvh, int nyv, int kxp,
+               int kyp, int kypd, int nxhyd, int nxyhd) {
+   wppfft2r_(f,g,bs,br,&isign,&ntpose,&ltpose,mixup,sct,ttp,&indx,&indy,
+             &kstrt,&nvp,&nxvh,&nyv,&kxp,&kyp,&kypd,&nxhyd,&nxyhd);
    return;
 }
 
 /*--------------------------------------------------------------------*/
 void cwppfft2r2(float complex f[], float complex g[], float complex bs[],
-                float complex br[], int isign, int ntpose, int mixup[],
-                float complex sct[], float *ttp, int indx, int indy,
-                int kstrt, int nvp, int nxvh, int nyv, int kxp, int kyp,
-                int kypd, int nxhyd, int nxyhd) {
-   wppfft2r2_(f,g,bs,br,&isign,&ntpose,mixup,sct,ttp,&indx,&indy,&kstrt,
-              &nvp,&nxvh,&nyv,&kxp,&kyp,&kypd,&nxhyd,&nxyhd);
+                float complex br[], int isign, int ntpose, int ltpose,
+                int mixup[], float complex sct[], float *ttp, int indx,
+                int indy, int kstrt, int nvp, int nxvh, int nyv, int kxp,
+                int kyp, int kypd, int nxhyd, int nxyhd) {
+   wppfft2r2_(f,g,bs,br,&isign,&ntpose,&ltpose,mixup,sct,ttp,&indx,
+              &indy,&kstrt,&nvp,&nxvh,&nyv,&kxp,&kyp,&kypd,&nxhyd,
+              &nxyhd);
    return;
 }
@@ -12,6 +12,17 @@
          real, dimension(idps), intent(inout) :: edges
          end subroutine
       end interface
+!
+      interface
+         subroutine PFEDGES2(edges,nyp,noff,npicy,nypmin,nypmax,ny,kstrt&
+     &,nvp,idps)
+         implicit none
+         integer, intent(in) :: nypmin, nypmax, ny, kstrt, nvp, idps
+         integer, intent(inout) :: nyp, noff
+         real, dimension(idps), intent(inout) :: edges
+         real, dimension(ny), intent(in) :: npicy
+         end subroutine
+      end interface
 !
       interface
          subroutine PDISTR2(part,edges,npp,nps,vtx,vty,vdx,vdy,npx,npy, &
@@ -61,6 +72,85 @@
          integer, dimension(nypm1), intent(inout) :: npic
          end subroutine
       end interface
+!
+      interface
+         subroutine PPCOUNT2Y(part,npicy,npp,idimp,npmax,ny)
+         implicit none
+         integer, intent(in) :: npp, idimp, npmax, ny
+         real, dimension(idimp,npmax), intent(in) :: part
+         real, dimension(ny), intent(inout) :: npicy
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPHOLES2(part,edges,npp,ihole,idimp,npmax,idps,ntmax&
+     &)
+         implicit none
+         integer, intent(in) :: npp, idimp, npmax, idps, ntmax
+         real, dimension(idimp,npmax), intent(in) :: part
+         real, dimension(idps), intent(in) :: edges
+         integer, dimension(ntmax+1), intent(inout) :: ihole
+         end subroutine
+      end interface
+!
+      interface
+         subroutine FCOMP22(nvp,nx,ny,nvpx,nvpy,ierr)
+         implicit none
+         integer, intent(in) :: nx, ny
+         integer, intent(inout) :: nvp
+         integer, intent(inout) :: nvpx, nvpy, ierr
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PDICOMP22L(edges,nxyp,noff,nxpmx,nypmx,nxpmn,nypmn, &
+     &nx,ny,kstrt,nvpx,nvpy,idps,idds)
+         implicit none
+         integer, intent(in) :: nx, ny, kstrt, nvpx, nvpy, idps, idds
+         integer, intent(inout) :: nxpmx, nypmx, nxpmn, nypmn
+         real, dimension(idps), intent(inout) :: edges
+         integer, dimension(idds), intent(inout) :: nxyp, noff
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PDISTR22(part,edges,npp,nps,vtx,vty,vdx,vdy,npx,npy,&
+     &nx,ny,idimp,npmax,idps,ipbc,ierr)
+         implicit none
+         integer, intent(in) :: nps, npx, npy, nx, ny, idimp, npmax
+         integer, intent(in) :: idps, ipbc
+         integer, intent(inout) :: npp, ierr
+         real, intent(in) :: vtx, vty, vdx, vdy
+         real, dimension(idimp,npmax), intent(inout) :: part
+         real, dimension(idps), intent(in) :: edges
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPGPUSH22L(part,fxy,npp,noff,qbm,dt,ek,nx,ny,idimp, &
+     &npmax,nxv,nypmx,idds,ipbc)
+         implicit none
+         integer, intent(in) :: npp, nx, ny, idimp, npmax, nxv, nypmx
+         integer, intent(in) :: idds, ipbc
+         real, intent(in) :: qbm, dt
+         real, intent(inout) :: ek
+         real, dimension(idimp,npmax), intent(inout) :: part
+         real, dimension(2,nxv,nypmx), intent(in) :: fxy
+         integer, dimension(idds), intent(in) :: noff
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPGPOST22L(part,q,npp,noff,qm,idimp,npmax,nxv,nypmx,&
+     &idds)
+         implicit none
+         integer, intent(in) :: npp, idimp, npmax, nxv, nypmx, idds
+         real, intent(in) :: qm
+         real, dimension(idimp,npmax), intent(in) :: part
+         real, dimension(nxv,nypmx), intent(inout) :: q
+         integer, dimension(idds), intent(in) :: noff
+         end subroutine
+      end interface
 !
       interface
          subroutine PPCGUARD2XL(fxy,nyp,nx,ndim,nxe,nypmx)
@@ -101,30 +191,32 @@
       end interface
 !
       interface
-         subroutine WPPFFT2R(f,g,bs,br,isign,ntpose,mixup,sct,ttp,indx, &
-     &indy,kstrt,nvp,nxvh,nyv,kxp,kyp,kypd,nxhyd,nxyhd)
+         subroutine WPPFFT2R(f,g,bs,br,isign,ntpose,ltpose,mixup,sct,ttp&
+     &,indx,indy,kstrt,nvp,nxvh,nyv,kxp,kyp,kypd,nxhyd,nxyhd)
          implicit none
-         integer, intent(in) :: isign, ntpose, indx, indy, kstrt, nvp
+         integer, intent(in) :: isign, ntpose, ltpose, indx, indy
+         integer, intent(in) :: kstrt, nvp
          integer, intent(in) :: nxvh, nyv, kxp, kyp, kypd, nxhyd, nxyhd
          real, intent(inout) :: ttp
          real, dimension(2*nxvh,kypd), intent(inout) :: f
          complex, dimension(nyv,kxp), intent(inout) :: g
-         complex, dimension(kxp,kyp), intent(inout) :: bs, br
+         complex, dimension(kxp*kyp,*), intent(inout) :: bs, br
          integer, dimension(nxhyd), intent(in) :: mixup
          complex, dimension(nxyhd), intent(in) :: sct
          end subroutine
       end interface
 !
       interface
-         subroutine WPPFFT2R2(f,g,bs,br,isign,ntpose,mixup,sct,ttp,indx,&
-     &indy,kstrt,nvp,nxvh,nyv,kxp,kyp,kypd,nxhyd,nxyhd)
+         subroutine WPPFFT2R2(f,g,bs,br,isign,ntpose,ltpose,mixup,sct,  &
+     &ttp,indx,indy,kstrt,nvp,nxvh,nyv,kxp,kyp,kypd,nxhyd,nxyhd)
          implicit none
-         integer, intent(in) :: isign, ntpose, indx, indy, kstrt, nvp
+         integer, intent(in) :: isign, ntpose, ltpose, indx, indy
+         integer, intent(in) :: kstrt, nvp
          integer, intent(in) :: nxvh, nyv, kxp, kyp, kypd, nxhyd, nxyhd
          real, intent(inout) :: ttp
          real, dimension(2,2*nxvh,kypd), intent(inout) :: f
          complex, dimension(2,nyv,kxp), intent(inout) :: g
-         complex, dimension(2,kxp,kyp), intent(inout) :: bs, br
+         complex, dimension(2,kxp*kyp,*), intent(inout) :: bs, br
          integer, dimension(nxhyd), intent(in) :: mixup
          complex, dimension(nxyhd), intent(in) :: sct
          end subroutine
@@ -46,9 +46,20 @@ int main(int argc, char *argv[]) {
 
 /* declare scalars for MPI code */
    int ntpose = 1;
+/* ltpose = number of blocks in x for pipelined y-z transpose */
+/* (0 = transpose whole array, then fft in z)                 */
+   int ltpose = 0;
+/* nchkpt = number of time steps between checkpoints, 0 = never */
+   int nchkpt = 0;
+/* lrestart = (0,1) = (no,yes) restart from checkpoint file fchkpt */
+   int lrestart = 0;
+   char fchkpt[] = "ppchkpt3.dat";
+/* ftchkpt = file written during a checkpoint, renamed to fchkpt when */
+/* complete, so that an interrupted checkpoint keeps the previous one */
+   char ftchkpt[] = "ppchkpt3.dat.tmp";
    int nvpy, nvpz, nvp, idproc, kstrt, npmax, kyp, kzp;
    int kxyp, kyzp, kzyp, nypmx, nzpmx, nypmn, nzpmn, npp, nps;
-   int nyzpm1, nbmax, ntmax;
+   int nyzpm1, nbmax, ntmax, nbs, nvpo;
 
 /* declare arrays for standard code: */
 /* part, part2 = particle arrays */
@@ -73,6 +84,9 @@ int main(int argc, char *argv[]) {
    int *npic = NULL;
    double wtot[4], work[4];
    int info[7];
+/* isc/fsc = integer/real scalars saved in checkpoint file */
+   int isc[8], jerr[1];
+   float fsc[2];
 
 /* declare arrays for MPI code: */
 /* bs/br = complex send/receive buffers for data transpose */
@@ -88,12 +102,15 @@ int main(int argc, char *argv[]) {
    int *nyzp = NULL, *noff = NULL;
 /* scr/scs = guard cell buffers received/sent from nearby processors */
    float *scr = NULL, *scs = NULL;
+/* igdq/igdf = persistent guard cell exchange plans for qe/fxyze */
+   int igdq = 0, igdf = 0;
 
 /* declare and initialize timing data */
    float time;
    struct timeval itime;
    float tdpost = 0.0, tguard = 0.0, ttp = 0.0, tfield = 0.0;
    float tpush = 0.0, tsort = 0.0, tmov = 0.0;
+   float tchkpt = 0.0;
    float tfft[2] = {0.0,0.0};
    double dtime;
 
@@ -193,14 +210,21 @@ int main(int argc, char *argv[]) {
    npic = (int *) malloc(nyzpm1*sizeof(int));
 
 /* allocate data for MPI code */
-   bs = (float complex *) malloc(ndim*kxyp*kzyp*kzp*sizeof(float complex));
-   br = (float complex *) malloc(ndim*kxyp*kzyp*kzp*sizeof(float complex));
+/* pipelined transpose keeps a separate buffer for each block */
+   nbs = ltpose > 0 ? nvpz : 1;
+   bs = (float complex *) malloc(ndim*kxyp*kzyp*kzp*nbs
+                                 *sizeof(float complex));
+   br = (float complex *) malloc(ndim*kxyp*kzyp*kzp*nbs
+                                 *sizeof(float complex));
    sbufl = (float *) malloc(idimp*nbmax*sizeof(float));
    sbufr = (float *) malloc(idimp*nbmax*sizeof(float));
    rbufl = (float *) malloc(idimp*nbmax*sizeof(float));
    rbufr = (float *) malloc(idimp*nbmax*sizeof(float));
-   scr = (float *) malloc(nxe*nypmx*sizeof(float));
+   scr = (float *) malloc(nnxe*2*nypmx*sizeof(float));
    scs = (float *) malloc(nnxe*2*nzpmx*sizeof(float));
+/* create persistent guard cell exchanges, reused every time step */
+   cppnguard32init(scs,scr,&igdq,kstrt,nvpy,nvpz,nxe,nypmx,nzpmx);
+   cppnguard32init(scs,scr,&igdf,kstrt,nvpy,nvpz,nnxe,nypmx,nzpmx);
 
 /* prepare fft tables */
    cwpfft32rinit(mixup,sct,indx,indy,indz,nxhyz,nxyzh);
@@ -209,16 +233,48 @@ int main(int argc, char *argv[]) {
    cppois332(qt,fxyzt,isign,ffc,ax,ay,az,affp,&we,nx,ny,nz,kstrt,nvpy,
              nvpz,nze,kxyp,kyzp,nzh);
 /* initialize electrons */
-   nps = 1;
-   npp = 0;
-   cpdistr32(part,edges,&npp,nps,vtx,vty,vtz,vx0,vy0,vz0,npx,npy,npz,nx,
-             ny,nz,idimp,npmax,idps,ipbc,&ierr);
+   if (lrestart==0) {
+      nps = 1;
+      npp = 0;
+      cpdistr32(part,edges,&npp,nps,vtx,vty,vtz,vx0,vy0,vz0,npx,npy,npz,
+                nx,ny,nz,idimp,npmax,idps,ipbc,&ierr);
 /* check for particle initialization error */
-   if (ierr != 0) {
+      if (ierr != 0) {
+         if (kstrt==1) {
+            printf("particle initialization error: ierr=%d\n",ierr);
+         }
+         goto L3000;
+      }
+   }
+/* restart electrons from checkpoint file: updates part, npp, ntime */
+   else {
+      dtimer(&dtime,&itime,-1);
+      cpprchkpth3(fchkpt,8,isc,2,fsc,&nvpo,&ierr);
+      if (ierr==0) {
+         if ((isc[1] != nx) || (isc[2] != ny) || (isc[3] != nz)
+            || (isc[4] != npx) || (isc[5] != npy) || (isc[6] != npz)
+            || (isc[7] != idimp)) {
+            ierr = 2;
+         }
+         else {
+            ntime = isc[0];
+            we = fsc[0];
+            wke = fsc[1];
+            cpprchkptp3(3,part,edges,&npp,idimp,npmax,idps,&ierr);
+         }
+         cpprchkptc3();
+      }
+      if (ierr != 0) {
+         if (kstrt==1) {
+            printf("checkpoint read error: ierr=%d\n",ierr);
+         }
+         goto L3000;
+      }
+      dtimer(&dtime,&itime,1);
+      tchkpt += (float) dtime;
       if (kstrt==1) {
-         printf("particle initialization error: ierr=%d\n",ierr);
+         printf("restart from ntime, nvp = %d,%d\n",ntime,nvpo);
       }
-      goto L3000;
    }
 
 /* * * * start main iteration loop * * * */
@@ -240,8 +296,8 @@ L500: if (nloop <= ntime)
 /* add guard cells with standard procedure: updates qe */
       dtimer(&dtime,&itime,-1);
       cppaguard32xl(qe,nyzp,nx,nxe,nypmx,nzpmx,idds);
-      cppnaguard32l(qe,scs,scr,nyzp,kstrt,nvpy,nvpz,nx,nxe,nypmx,nzpmx,
-                    idds);
+      cppnaguard32lp(qe,scs,scr,igdq,nyzp,nvpy,nvpz,nx,nxe,nypmx,nzpmx,
+                     idds);
       dtimer(&dtime,&itime,1);
       time = (float) dtime;
       tguard += time;
@@ -250,9 +306,10 @@ L500: if (nloop <= ntime)
 /* modifies qe */
       dtimer(&dtime,&itime,-1);
       isign = -1;
-      cwppfft32r((float complex *)qe,qs,qt,bs,br,isign,ntpose,mixup,sct,
-                 &ttp,indx,indy,indz,kstrt,nvpy,nvpz,nxeh,nye,nze,kxyp,
-                 kyp,kyzp,kzp,kxyp,nypmx,kyzp,nzpmx,kzyp,nxhyz,nxyzh);
+      cwppfft32r((float complex *)qe,qs,qt,bs,br,isign,ntpose,ltpose,
+                 mixup,sct,&ttp,indx,indy,indz,kstrt,nvpy,nvpz,nxeh,
+                 nye,nze,kxyp,kyp,kyzp,kzp,kxyp,nypmx,kyzp,nzpmx,kzyp,
+                 nxhyz,nxyzh);
       dtimer(&dtime,&itime,1);
       time = (float) dtime;
       tfft[0] += time;
@@ -273,9 +330,9 @@ L500: if (nloop <= ntime)
       dtimer(&dtime,&itime,-1);
       isign = 1;
       cwppfft32r3((float complex *)fxyze,fxyzs,fxyzt,bs,br,isign,ntpose,
-                  mixup,sct,&ttp,indx,indy,indz,kstrt,nvpy,nvpz,nxeh,nye,
-                  nze,kxyp,kyp,kyzp,kzp,kxyp,nypmx,kyzp,nzpmx,kzyp,nxhyz,
-                  nxyzh);
+                  ltpose,mixup,sct,&ttp,indx,indy,indz,kstrt,nvpy,nvpz,
+                  nxeh,nye,nze,kxyp,kyp,kyzp,kzp,kxyp,nypmx,kyzp,nzpmx,
+                  kzyp,nxhyz,nxyzh);
       dtimer(&dtime,&itime,1);
       time = (float) dtime;
       tfft[0] += time;
@@ -283,8 +340,8 @@ L500: if (nloop <= ntime)
 
 /* copy guard cells with standard procedure: updates fxyze */
       dtimer(&dtime,&itime,-1);
-      cppncguard32l(fxyze,scs,nyzp,kstrt,nvpy,nvpz,nnxe,nypmx,nzpmx,
-                    idds);
+      cppncguard32lp(fxyze,scs,scr,igdf,nyzp,nvpy,nvpz,nnxe,nypmx,nzpmx,
+                     idds);
       cppcguard32xl(fxyze,nyzp,nx,ndim,nxe,nypmx,nzpmx,idds);
       dtimer(&dtime,&itime,1);
       time = (float) dtime;
@@ -353,6 +410,38 @@ L500: if (nloop <= ntime)
          }
       }
       ntime += 1;
+
+/* write checkpoint with MPI-IO: charge density, electric field and */
+/* particles of all processors are written to one shared file       */
+      if (nchkpt > 0) {
+         if (ntime%nchkpt==0) {
+            dtimer(&dtime,&itime,-1);
+            isc[0] = ntime; isc[1] = nx; isc[2] = ny; isc[3] = nz;
+            isc[4] = npx; isc[5] = npy; isc[6] = npz; isc[7] = idimp;
+            fsc[0] = we; fsc[1] = wke;
+            cppwchkpth3(ftchkpt,8,isc,2,fsc,&ierr);
+            if (ierr==0) {
+               cppwchkpta3(qe,nyzp,noff,nxe,ny,nz,nypmx,nzpmx,idds);
+               cppwchkpta3(fxyze,nyzp,noff,nnxe,ny,nz,nypmx,nzpmx,idds);
+               cppwchkptp3(part,edges,npp,idimp,npmax,idps);
+               cppwchkptc3(&ierr);
+/* rename completed file: ierr = 3 if rename fails */
+               if ((ierr==0) && (kstrt==1)) {
+                  if (rename(ftchkpt,fchkpt) != 0)
+                     ierr = 3;
+               }
+               cppimax(&ierr,jerr,1);
+            }
+            if (ierr != 0) {
+               if (kstrt==1) {
+                  printf("checkpoint write error: ierr=%d\n",ierr);
+               }
+               goto L3000;
+            }
+            dtimer(&dtime,&itime,1);
+            tchkpt += (float) dtime;
+         }
+      }
       goto L500;
 L2000:
 
@@ -372,6 +461,8 @@ L2000:
       printf("push time = %f\n",tpush);
       printf("particle move time = %f\n",tmov);
       printf("sort time = %f\n",tsort);
+      if ((nchkpt > 0) || (lrestart==1))
+         printf("checkpoint time = %f\n",tchkpt);
       tfield += tguard + tfft[0];
       printf("total solver time = %f\n",tfield);
       tsort += tmov;
@@ -388,6 +479,9 @@ L2000:
       printf("Total Particle Time (nsec) = %f\n",time*wt);
    }
 
+   cppnguard32free(&igdf);
+   cppnguard32free(&igdq);
+
 L3000:
    cppexit();
    return 0;
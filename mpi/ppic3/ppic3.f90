@@ -40,9 +40,14 @@
 !
 ! declare scalars for MPI code
       integer :: ntpose = 1
+! ltpose = number of blocks in x for pipelined y-z transpose
+! (0 = transpose whole array, then fft in z)
+      integer :: ltpose = 0
+! igdq/igdf = persistent guard cell exchange plans for qe/fxyze
+      integer :: igdq = 0, igdf = 0
       integer :: nvpy, nvpz, nvp, idproc, kstrt, npmax, kyp, kzp
       integer :: kxyp, kyzp, kzyp, nypmx, nzpmx, nypmn, nzpmn, npp, nps
-      integer :: nyzpm1, nbmax, ntmax
+      integer :: nyzpm1, nbmax, ntmax, nbs
 !
 ! declare arrays for standard code:
 ! part, part2 = particle arrays
@@ -173,10 +178,16 @@
       allocate(ihole(ntmax+1,2),npic(nyzpm1))
 !
 ! allocate data for MPI code
-      allocate(bs(ndim,kxyp*kzyp,kzp),br(ndim,kxyp*kzyp,kzp))
+! pipelined transpose keeps a separate buffer for each block
+      nbs = 1
+      if (ltpose > 0) nbs = nvpz
+      allocate(bs(ndim,kxyp*kzyp,kzp*nbs),br(ndim,kxyp*kzyp,kzp*nbs))
       allocate(sbufl(idimp,nbmax),sbufr(idimp,nbmax))
       allocate(rbufl(idimp,nbmax),rbufr(idimp,nbmax))
-      allocate(scr(nxe,nypmx),scs(nnxe,2*nzpmx))
+      allocate(scr(nnxe,2*nypmx),scs(nnxe,2*nzpmx))
+! create persistent guard cell exchanges, reused every time step
+      call PPNGUARD32INIT(scs,scr,igdq,kstrt,nvpy,nvpz,nxe,nypmx,nzpmx)
+      call PPNGUARD32INIT(scs,scr,igdf,kstrt,nvpy,nvpz,nnxe,nypmx,nzpmx)
 !
 ! prepare fft tables
       call WPFFT32RINIT(mixup,sct,indx,indy,indz,nxhyz,nxyzh)
@@ -217,7 +228,7 @@
 ! add guard cells with standard procedure: updates qe
       call dtimer(dtime,itime,-1)
       call PPAGUARD32XL(qe,nyzp,nx,nxe,nypmx,nzpmx,idds)
-      call PPNAGUARD32L(qe,scs,scr,nyzp,kstrt,nvpy,nvpz,nx,nxe,nypmx,   &
+      call PPNAGUARD32LP(qe,scs,scr,igdq,nyzp,nvpy,nvpz,nx,nxe,nypmx,   &
      &nzpmx,idds)
       call dtimer(dtime,itime,1)
       time = real(dtime)
@@ -227,9 +238,9 @@
 ! modifies qe
       call dtimer(dtime,itime,-1)
       isign = -1
-      call WPPFFT32R(qe,qs,qt,bs,br,isign,ntpose,mixup,sct,ttp,indx,indy&
-     &,indz,kstrt,nvpy,nvpz,nxeh,nye,nze,kxyp,kyp,kyzp,kzp,kxyp,nypmx,  &
-     &kyzp,nzpmx,kzyp,nxhyz,nxyzh)
+      call WPPFFT32R(qe,qs,qt,bs,br,isign,ntpose,ltpose,mixup,sct,ttp,  &
+     &indx,indy,indz,kstrt,nvpy,nvpz,nxeh,nye,nze,kxyp,kyp,kyzp,kzp,kxyp&
+     &,nypmx,kyzp,nzpmx,kzyp,nxhyz,nxyzh)
       call dtimer(dtime,itime,1)
       time = real(dtime)
       tfft(1) = tfft(1) + time
@@ -249,9 +260,9 @@
 ! modifies fxyzt
       call dtimer(dtime,itime,-1)
       isign = 1
-      call WPPFFT32R3(fxyze,fxyzs,fxyzt,bs,br,isign,ntpose,mixup,sct,ttp&
-     &,indx,indy,indz,kstrt,nvpy,nvpz,nxeh,nye,nze,kxyp,kyp,kyzp,kzp,   &
-     &kxyp,nypmx,kyzp,nzpmx,kzyp,nxhyz,nxyzh)
+      call WPPFFT32R3(fxyze,fxyzs,fxyzt,bs,br,isign,ntpose,ltpose,mixup,&
+     &sct,ttp,indx,indy,indz,kstrt,nvpy,nvpz,nxeh,nye,nze,kxyp,kyp,kyzp,&
+     &kzp,kxyp,nypmx,kyzp,nzpmx,kzyp,nxhyz,nxyzh)
       call dtimer(dtime,itime,1)
       time = real(dtime)
       tfft(1) = tfft(1) + time
@@ -259,8 +270,8 @@
 !
 ! copy guard cells with standard procedure: updates fxyze
       call dtimer(dtime,itime,-1)
-      call PPNCGUARD32L(fxyze,scs,nyzp,kstrt,nvpy,nvpz,nnxe,nypmx,nzpmx,&
-     &idds)
+      call PPNCGUARD32LP(fxyze,scs,scr,igdf,nyzp,nvpy,nvpz,nnxe,nypmx,  &
+     &nzpmx,idds)
       call PPCGUARD32XL(fxyze,nyzp,nx,ndim,nxe,nypmx,nzpmx,idds)
       call dtimer(dtime,itime,1)
       time = real(dtime)
@@ -365,6 +376,9 @@
          write (*,*) 'Sort Time (nsec) = ', tsort*wt
          write (*,*) 'Total Particle Time (nsec) = ', time*wt
       endif
+!
+      call PPNGUARD32FREE(igdf)
+      call PPNGUARD32FREE(igdq)
 !
  3000 continue
       call PPEXIT()
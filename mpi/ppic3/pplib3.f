@@ -19,6 +19,15 @@ c              partition.
 c PPNACGUARD32L adds guard cells in y and z for vector array, linear
 c               interpolation, and distributed data with 2D non-uniform
 c               partition.
+c PPNGUARD32INIT creates persistent requests for guard cell exchanges
+c                in y and z, to be reused every time step.
+c PPNCGUARD32LP copies data to guard cells in y and z for scalar data,
+c               using persistent requests created by PPNGUARD32INIT.
+c PPNAGUARD32LP adds guard cells in y and z for scalar array, using
+c               persistent requests created by PPNGUARD32INIT.
+c PPNACGUARD32LP adds guard cells in y and z for vector array, using
+c                persistent requests created by PPNGUARD32INIT.
+c PPNGUARD32FREE frees persistent requests created by PPNGUARD32INIT.
 c PPTPOS3A performs a transpose of a complex scalar array, distributed
 c          in y and z, to a complex scalar array, distributed in x and z
 c PPTPOS3B performs a transpose of a complex scalar array, distributed
@@ -29,12 +38,33 @@ c           array, distributed in x and z.
 c PPNTPOS3B performs a transpose of an n component complex vector array,
 c           distributed in x and z, to an n component complex vector
 c           array, distributed in x and y.
+c PPNTPOS3BS starts a transpose of a block of x indices of an n
+c            component complex vector array, distributed in x and z,
+c            to an n component complex vector array, distributed in x
+c            and y, using non-blocking messages.
+c PPNTPOS3BW completes a transpose started by PPNTPOS3BS.
 c PPMOVE32 moves particles into appropriate spatial regions with
 c          periodic boundary conditions and 2D spatial decomposition.
 c          Assumes ihole list has been found.
 c PPMOVEG32 moves particles into appropriate spatial regions with
 c           periodic boundary conditions and 2D spatial decomposition.
 c           ihole list is calculated from particles co-ordinates
+c PPWCHKPTH3 opens a shared checkpoint file for writing with MPI-IO
+c            and saves the scalars.
+c PPWCHKPTA3 writes the partition of a distributed 3d array to a
+c            checkpoint file with a collective write.
+c PPWCHKPTP3 writes particles and an index of particles and partition
+c            boundaries per processor to a checkpoint file with a
+c            collective write.
+c PPWCHKPTC3 completes a checkpoint file.
+c PPRCHKPTH3 opens a shared checkpoint file for reading with MPI-IO
+c            and reads the scalars.
+c PPRCHKPTA3 reads the partition of a distributed 3d array from a
+c            checkpoint file, in any partition.
+c PPRCHKPTP3 reads the particles inside the partition from a
+c            checkpoint file, written by the same or a different number
+c            of processors.
+c PPRCHKPTC3 closes a checkpoint file opened for reading.
 c written by viktor k. decyk, ucla
 c copyright 1995, regents of the university of california
 c update: august 29, 2015
@@ -79,12 +109,18 @@ c lworld = MPI_COMM_WORLD communicator
 c msum = MPI_SUM
 c mmax = MPI_MAX
       common /PPARMSX/ msum, mmax
+c common block for persistent guard cell requests
+      integer maxgds, ngds, mgds
+      parameter(maxgds=8)
+c ngds = number of guard cell exchange plans created so far
+c mgds = persistent requests for each plan
+      common /PPGDS/ ngds, mgds(8,maxgds)
 c local data
       integer ierror, ndprec, idprec
       integer ibig, iprec, iresult
       logical flag
       real small, prec, vresult
-      save /PPARMS/, /PPARMSX/
+      save /PPARMS/, /PPARMSX/, /PPGDS/
       data small /1.0e-12/
       data ibig /2147483647/
       prec = 1.0 + small
@@ -142,6 +178,8 @@ c     endif
 c operators
       msum = MPI_SUM
       mmax = MPI_MAX
+c no guard cell exchange plans yet
+      ngds = 0
       nvp = nproc
       return
       end
@@ -836,6 +874,411 @@ c add up the guard cells
   290 continue
       return
       end
+c-----------------------------------------------------------------------
+      subroutine PPNGUARD32INIT(scs,scr,igds,kstrt,nvpy,nvpz,nxv,nypmx,
+     1nzpmx)
+c this subroutine creates persistent requests for guard cell exchanges
+c in y and z with non-uniform partitions, for data with nxv reals per
+c row in x.
+c the same plan is used by PPNCGUARD32LP, PPNAGUARD32LP and
+c PPNACGUARD32LP, which avoids setting up new messages every call.
+c a full plane of nxv*nzpmx reals is sent in y and nxv*nypmx reals in z,
+c so that the message sizes do not depend on the partition.
+c scs = buffers for sending/receiving data in y
+c scr = buffers for sending/receiving data in z
+c scs and scr must not be moved or deallocated while the plan is in use.
+c igds = plan number returned, 0 if no plan could be created
+c kstrt = starting data block number
+c nvpy/nvpz = number of real or virtual processors in y/z
+c nxv = number of reals in one row of data, e.g., ndim*nxv for a
+c vector array
+c nypmx = maximum size of particle partition in y, including guard cells
+c nzpmx = maximum size of particle partition in z, including guard cells
+      implicit none
+      integer igds, kstrt, nvpy, nvpz, nxv, nypmx, nzpmx
+      real scs, scr
+      dimension scs(nxv,nzpmx,2), scr(nxv,nypmx,2)
+c get definition of MPI constants
+      include 'mpif.h'
+c common block for parallel processing
+      integer nproc, lgrp, mreal, mint, mcplx, mdouble, lworld
+c lgrp = current communicator
+c mreal = default datatype for reals
+      common /PPARMS/ nproc, lgrp, mreal, mint, mcplx, mdouble, lworld
+c common block for persistent guard cell requests
+      integer maxgds, ngds, mgds
+      parameter(maxgds=8)
+c ngds = number of guard cell exchange plans created so far
+c mgds = persistent requests for each plan
+      common /PPGDS/ ngds, mgds(8,maxgds)
+c local data
+      integer i, n, js, ks, noff, kr, kl, nxvz, nxvy, ierr
+      igds = 0
+      if (ngds.ge.maxgds) then
+         if (kstrt.eq.1) then
+            write (*,*) 'PPNGUARD32INIT: too many plans, maxgds=',
+     1maxgds
+         endif
+         return
+      endif
+      ngds = ngds + 1
+      n = ngds
+      igds = n
+      do 10 i = 1, 8
+      mgds(i,n) = MPI_REQUEST_NULL
+   10 continue
+c js/ks = processor co-ordinates in y/z => idproc = js + nvpy*ks
+      ks = (kstrt - 1)/nvpy
+      js = kstrt - nvpy*ks - 1
+      noff = nypmx*nzpmx
+      nxvz = nxv*nzpmx
+      nxvy = nxv*nypmx
+c exchanges in y, special case for one processor in y
+      if (nvpy.gt.1) then
+         kr = js + 1
+         if (kr.ge.nvpy) kr = kr - nvpy
+         kl = js - 1
+         if (kl.lt.0) kl = kl + nvpy
+         kr = kr + nvpy*ks
+         kl = kl + nvpy*ks
+c copy guard cells: receive from right, send to left
+         call MPI_RECV_INIT(scs(1,1,2),nxvz,mreal,kr,noff+3,lgrp,
+     1mgds(1,n),ierr)
+         call MPI_SEND_INIT(scs,nxvz,mreal,kl,noff+3,lgrp,mgds(2,n),
+     1ierr)
+c add guard cells: receive from left, send to right
+         call MPI_RECV_INIT(scs(1,1,2),nxvz,mreal,kl,noff+1,lgrp,
+     1mgds(5,n),ierr)
+         call MPI_SEND_INIT(scs,nxvz,mreal,kr,noff+1,lgrp,mgds(6,n),
+     1ierr)
+      endif
+c exchanges in z, special case for one processor in z
+      if (nvpz.gt.1) then
+         kr = ks + 1
+         if (kr.ge.nvpz) kr = kr - nvpz
+         kl = ks - 1
+         if (kl.lt.0) kl = kl + nvpz
+         kr = js + nvpy*kr
+         kl = js + nvpy*kl
+c copy guard cells: receive from right, send to left
+         call MPI_RECV_INIT(scr(1,1,2),nxvy,mreal,kr,noff+4,lgrp,
+     1mgds(3,n),ierr)
+         call MPI_SEND_INIT(scr,nxvy,mreal,kl,noff+4,lgrp,mgds(4,n),
+     1ierr)
+c add guard cells: receive from left, send to right
+         call MPI_RECV_INIT(scr(1,1,2),nxvy,mreal,kl,noff+2,lgrp,
+     1mgds(7,n),ierr)
+         call MPI_SEND_INIT(scr,nxvy,mreal,kr,noff+2,lgrp,mgds(8,n),
+     1ierr)
+      endif
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPNCGUARD32LP(f,scs,scr,igds,nyzp,nvpy,nvpz,nxv,nypmx,
+     1nzpmx,idds)
+c this subroutine copies data to guard cells in non-uniform partitions
+c using persistent requests created by PPNGUARD32INIT
+c f(j,k,l) = real data for grid j,k,l in particle partition.
+c the grid is non-uniform and includes one extra guard cell.
+c output: f, scs, scr
+c scs/scr = buffers in y/z given to PPNGUARD32INIT
+c igds = plan number returned by PPNGUARD32INIT
+c nyzp(1:2) = number of primary gridpoints in y/z in particle partition
+c nvpy/nvpz = number of real or virtual processors in y/z
+c nxv = first dimension of f, must be same as in PPNGUARD32INIT
+c nypmx = maximum size of particle partition in y, including guard cells
+c nzpmx = maximum size of particle partition in z, including guard cells
+c idds = dimensionality of domain decomposition
+c linear interpolation, for distributed data,
+c with 2D spatial decomposition
+      implicit none
+      integer igds, nvpy, nvpz, nxv, nypmx, nzpmx, idds
+      integer nyzp
+      real f, scs, scr
+      dimension nyzp(idds)
+      dimension f(nxv,nypmx,nzpmx)
+      dimension scs(nxv,nzpmx,2), scr(nxv,nypmx,2)
+c get definition of MPI constants
+      include 'mpif.h'
+c common block for persistent guard cell requests
+      integer maxgds, ngds, mgds
+      parameter(maxgds=8)
+      common /PPGDS/ ngds, mgds(8,maxgds)
+c local data
+      integer j, k, nyp1, nzp1, ierr
+      nyp1 = nyzp(1) + 1
+      nzp1 = nyzp(2) + 1
+c special case for one processor in y
+      if (nvpy.eq.1) then
+         do 20 k = 1, nyzp(2)
+         do 10 j = 1, nxv
+         f(j,nyp1,k) = f(j,1,k)
+   10    continue
+   20    continue
+         go to 70
+      endif
+c buffer data in y
+      do 40 k = 1, nyzp(2)
+      do 30 j = 1, nxv
+      scs(j,k,1) = f(j,1,k)
+   30 continue
+   40 continue
+c copy to guard cells in y
+      call MPI_STARTALL(2,mgds(1,igds),ierr)
+      call MPI_WAITALL(2,mgds(1,igds),MPI_STATUSES_IGNORE,ierr)
+c copy guard cells
+      do 60 k = 1, nyzp(2)
+      do 50 j = 1, nxv
+      f(j,nyp1,k) = scs(j,k,2)
+   50 continue
+   60 continue
+c special case for one processor in z
+   70 if (nvpz.eq.1) then
+         do 90 k = 1, nyp1
+         do 80 j = 1, nxv
+         f(j,k,nzp1) = f(j,k,1)
+   80    continue
+   90    continue
+         return
+      endif
+c buffer data in z
+      do 110 k = 1, nyp1
+      do 100 j = 1, nxv
+      scr(j,k,1) = f(j,k,1)
+  100 continue
+  110 continue
+c copy to guard cells in z
+      call MPI_STARTALL(2,mgds(3,igds),ierr)
+      call MPI_WAITALL(2,mgds(3,igds),MPI_STATUSES_IGNORE,ierr)
+c copy guard cells
+      do 130 k = 1, nyp1
+      do 120 j = 1, nxv
+      f(j,k,nzp1) = scr(j,k,2)
+  120 continue
+  130 continue
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPNAGUARD32LP(f,scs,scr,igds,nyzp,nvpy,nvpz,nx,nxv,
+     1nypmx,nzpmx,idds)
+c this subroutine adds data from guard cells in non-uniform partitions
+c using persistent requests created by PPNGUARD32INIT
+c f(j,k,l) = real data for grid j,k,l in particle partition.
+c the grid is non-uniform and includes one extra guard cell.
+c output: f, scs, scr
+c scs/scr = buffers in y/z given to PPNGUARD32INIT
+c igds = plan number returned by PPNGUARD32INIT
+c nyzp(1:2) = number of primary gridpoints in y/z in particle partition
+c nvpy/nvpz = number of real or virtual processors in y/z
+c nx = system length in x direction
+c nxv = first dimension of f, must be same as in PPNGUARD32INIT
+c nypmx = maximum size of particle partition in y, including guard cells
+c nzpmx = maximum size of particle partition in z, including guard cells
+c idds = dimensionality of domain decomposition
+c linear interpolation, for distributed data
+c with 2D spatial decomposition
+      implicit none
+      integer igds, nvpy, nvpz, nx, nxv, nypmx, nzpmx, idds
+      integer nyzp
+      real f, scs, scr
+      dimension nyzp(idds)
+      dimension f(nxv,nypmx,nzpmx)
+      dimension scs(nxv,nzpmx,2), scr(nxv,nypmx,2)
+c get definition of MPI constants
+      include 'mpif.h'
+c common block for persistent guard cell requests
+      integer maxgds, ngds, mgds
+      parameter(maxgds=8)
+      common /PPGDS/ ngds, mgds(8,maxgds)
+c local data
+      integer j, k, nx1, nyp1, nzp1, ierr
+      nx1 = nx + 1
+      nyp1 = nyzp(1) + 1
+      nzp1 = nyzp(2) + 1
+c special case for one processor in y
+      if (nvpy.eq.1) then
+         do 20 k = 1, nzp1
+         do 10 j = 1, nx1
+         f(j,1,k) = f(j,1,k) + f(j,nyp1,k)
+         f(j,nyp1,k) = 0.0
+   10    continue
+   20    continue
+         go to 70
+      endif
+c buffer data in y
+      do 40 k = 1, nzp1
+      do 30 j = 1, nxv
+      scs(j,k,1) = f(j,nyp1,k)
+   30 continue
+   40 continue
+c add guard cells in y
+      call MPI_STARTALL(2,mgds(5,igds),ierr)
+      call MPI_WAITALL(2,mgds(5,igds),MPI_STATUSES_IGNORE,ierr)
+c add up the guard cells
+      do 60 k = 1, nzp1
+      do 50 j = 1, nx1
+      f(j,1,k) = f(j,1,k) + scs(j,k,2)
+      f(j,nyp1,k) = 0.0
+   50 continue
+   60 continue
+c special case for one processor in z
+   70 if (nvpz.eq.1) then
+         do 90 k = 1, nyp1
+         do 80 j = 1, nx1
+         f(j,k,1) = f(j,k,1) + f(j,k,nzp1)
+         f(j,k,nzp1) = 0.0
+   80    continue
+   90    continue
+         return
+      endif
+c buffer data in z
+      do 110 k = 1, nyp1
+      do 100 j = 1, nxv
+      scr(j,k,1) = f(j,k,nzp1)
+  100 continue
+  110 continue
+c add guard cells in z
+      call MPI_STARTALL(2,mgds(7,igds),ierr)
+      call MPI_WAITALL(2,mgds(7,igds),MPI_STATUSES_IGNORE,ierr)
+c add up the guard cells
+      do 130 k = 1, nyp1
+      do 120 j = 1, nx1
+      f(j,k,1) = f(j,k,1) + scr(j,k,2)
+      f(j,k,nzp1) = 0.0
+  120 continue
+  130 continue
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPNACGUARD32LP(f,scs,scr,igds,nyzp,ndim,nvpy,nvpz,nx,
+     1nxv,nypmx,nzpmx,idds)
+c this subroutine adds data from guard cells in non-uniform partitions
+c using persistent requests created by PPNGUARD32INIT
+c f(ndim,j,k,l) = real data for grid j,k,l in particle partition.
+c the grid is non-uniform and includes one extra guard cell.
+c output: f, scs, scr
+c scs/scr = buffers in y/z given to PPNGUARD32INIT
+c igds = plan number returned by PPNGUARD32INIT, created with ndim*nxv
+c reals per row
+c nyzp(1:2) = number of primary gridpoints in y/z in particle partition
+c ndim = leading dimension of array f
+c nvpy/nvpz = number of real or virtual processors in y/z
+c nx = system length in x direction
+c nxv = second dimension of f, must be >= nx+1
+c nypmx = maximum size of particle partition in y, including guard cells
+c nzpmx = maximum size of particle partition in z, including guard cells
+c idds = dimensionality of domain decomposition
+c linear interpolation, for distributed data
+c with 2D spatial decomposition
+      implicit none
+      integer igds, ndim, nvpy, nvpz, nx, nxv, nypmx, nzpmx, idds
+      integer nyzp
+      real f, scs, scr
+      dimension nyzp(idds)
+      dimension f(ndim,nxv,nypmx,nzpmx)
+      dimension scs(ndim,nxv,nzpmx,2), scr(ndim,nxv,nypmx,2)
+c get definition of MPI constants
+      include 'mpif.h'
+c common block for persistent guard cell requests
+      integer maxgds, ngds, mgds
+      parameter(maxgds=8)
+      common /PPGDS/ ngds, mgds(8,maxgds)
+c local data
+      integer i, j, k, nx1, nyp1, nzp1, ierr
+      nx1 = nx + 1
+      nyp1 = nyzp(1) + 1
+      nzp1 = nyzp(2) + 1
+c special case for one processor in y
+      if (nvpy.eq.1) then
+         do 30 k = 1, nzp1
+         do 20 j = 1, nx1
+         do 10 i = 1, ndim
+         f(i,j,1,k) = f(i,j,1,k) + f(i,j,nyp1,k)
+         f(i,j,nyp1,k) = 0.0
+   10    continue
+   20    continue
+   30    continue
+         go to 100
+      endif
+c buffer data in y
+      do 60 k = 1, nzp1
+      do 50 j = 1, nxv
+      do 40 i = 1, ndim
+      scs(i,j,k,1) = f(i,j,nyp1,k)
+   40 continue
+   50 continue
+   60 continue
+c add guard cells in y
+      call MPI_STARTALL(2,mgds(5,igds),ierr)
+      call MPI_WAITALL(2,mgds(5,igds),MPI_STATUSES_IGNORE,ierr)
+c add up the guard cells
+      do 90 k = 1, nzp1
+      do 80 j = 1, nx1
+      do 70 i = 1, ndim
+      f(i,j,1,k) = f(i,j,1,k) + scs(i,j,k,2)
+      f(i,j,nyp1,k) = 0.0
+   70 continue
+   80 continue
+   90 continue
+c special case for one processor in z
+  100 if (nvpz.eq.1) then
+         do 130 k = 1, nyp1
+         do 120 j = 1, nx1
+         do 110 i = 1, ndim
+         f(i,j,k,1) = f(i,j,k,1) + f(i,j,k,nzp1)
+         f(i,j,k,nzp1) = 0.0
+  110    continue
+  120    continue
+  130    continue
+         return
+      endif
+c buffer data in z
+      do 160 k = 1, nyp1
+      do 150 j = 1, nxv
+      do 140 i = 1, ndim
+      scr(i,j,k,1) = f(i,j,k,nzp1)
+  140 continue
+  150 continue
+  160 continue
+c add guard cells in z
+      call MPI_STARTALL(2,mgds(7,igds),ierr)
+      call MPI_WAITALL(2,mgds(7,igds),MPI_STATUSES_IGNORE,ierr)
+c add up the guard cells
+      do 190 k = 1, nyp1
+      do 180 j = 1, nx1
+      do 170 i = 1, ndim
+      f(i,j,k,1) = f(i,j,k,1) + scr(i,j,k,2)
+      f(i,j,k,nzp1) = 0.0
+  170 continue
+  180 continue
+  190 continue
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPNGUARD32FREE(igds)
+c this subroutine frees persistent requests created by PPNGUARD32INIT
+c igds = plan number, set to 0 on output
+      implicit none
+      integer igds
+c get definition of MPI constants
+      include 'mpif.h'
+c common block for persistent guard cell requests
+      integer maxgds, ngds, mgds
+      parameter(maxgds=8)
+      common /PPGDS/ ngds, mgds(8,maxgds)
+c local data
+      integer n, ierr
+      if ((igds.lt.1).or.(igds.gt.ngds)) return
+      do 10 n = 1, 8
+      if (mgds(n,igds).ne.MPI_REQUEST_NULL) then
+         call MPI_REQUEST_FREE(mgds(n,igds),ierr)
+      endif
+   10 continue
+c release plan number if it was the last one created
+      if (igds.eq.ngds) ngds = ngds - 1
+      igds = 0
+      return
+      end
 c-----------------------------------------------------------------------
       subroutine PPTPOS3A(f,g,s,t,nx,ny,nz,kxyp,kyp,kzp,kstrt,nvpy,nxv, 
      1nyv,kxypd,kypd,kzpd)
@@ -1286,6 +1729,186 @@ c insert data received
   130 continue
       return
       end
+c-----------------------------------------------------------------------
+      subroutine PPNTPOS3BS(g,h,s,t,mreq,nx,ny,nz,kxyp,kyzp,kzp,kstrt,  
+     1nvpy,nvpz,ndim,nyv,nzv,kxypd,kyzpd,kzpd,jxi,jxp)
+c this subroutine starts a transpose of a block of x indices of a matrix
+c g, distributed in x and z to a matrix h, distributed in x and y, that
+c is, h(1:ndim,l+kzp*(n-1),j,k) = g(1:ndim,k+kyzp*(m-1),j,l), where
+c jxi <= j < jxi+jxp, 1 <= k <= kyzp, 1 <= l <= kzp, and
+c 1 <= m <= ny/kyzp, 1 <= n <= nz/kzp
+c and where indices n and m can be distributed across processors.
+c this subroutine posts all receives, sends all messages asynchronously
+c and copies the local block.  PPNTPOS3BW must be called with the same
+c block to complete the transpose.  several blocks can be in progress at
+c once, so that work on one block, such as an fft in z, can overlap with
+c the communication of the others.
+c g = complex input array
+c h = complex output array
+c s, t = complex scratch arrays, of size ndim*kyzp*kxyp*kzp*nvpz
+c the block starting at jxi uses the part starting at
+c ndim*kyzp*kzp*nvpz*(jxi-1)
+c mreq = receive/send requests for this block
+c nx/ny/nz = number of points in x/y/z
+c kxyp/kyzp/kzp = number of data values per block in x/y/z
+c kstrt = starting data block number
+c nvpy/nvpz = number of real or virtual processors in y/z
+c ndim = leading dimension of arrays g and h
+c nyv/nzv = first dimension of g/h
+c kxypd = second dimension of g and h
+c kzpd/kyzpd = third dimension of g/h
+c jxi = initial x index in block
+c jxp = number of x indices in block
+      implicit none
+      integer nx, ny, nz, kxyp, kyzp, kzp, kstrt, nvpy, nvpz, ndim
+      integer nyv, nzv, kxypd, kyzpd, kzpd, jxi, jxp
+      integer mreq
+      complex g, h, s, t
+      dimension g(ndim,nyv,kxypd,kzpd), h(ndim,nzv,kxypd,kyzpd)
+      dimension s(ndim,kyzp*kxyp*kzp*nvpz), t(ndim,kyzp*kxyp*kzp*nvpz)
+      dimension mreq(2*nvpz)
+      include 'mpif.h'
+c common block for parallel processing
+      integer nproc, lgrp, mreal, mint, mcplx, mdouble, lworld
+c lgrp = current communicator
+c mcplx = default datatype for complex
+      common /PPARMS/ nproc, lgrp, mreal, mint, mcplx, mdouble, lworld
+c local data
+      integer i, n, j, k, l, js, ks, kyzps, kzps, id, joff, koff, loff
+      integer moff, ld, jd, kyzxp, ierr
+c js/ks = processor co-ordinates in x/z => idproc = js + nvpy*ks
+      ks = (kstrt - 1)/nvpy
+      js = kstrt - nvpy*ks - 1
+      kyzps = min(kyzp,max(0,ny-kyzp*ks))
+      kzps = min(kzp,max(0,nz-kzp*ks))
+      joff = jxi - 1
+c special case for one processor
+      if (nvpz.eq.1) then
+         do 40 l = 1, kzp
+         do 30 j = 1, jxp
+         do 20 k = 1, kyzp
+         do 10 i = 1, ndim
+         h(i,l,j+joff,k) = g(i,k,j+joff,l)
+   10    continue
+   20    continue
+   30    continue
+   40    continue
+         mreq(1) = MPI_REQUEST_NULL
+         mreq(2) = MPI_REQUEST_NULL
+         return
+      endif
+c kyzxp = size of each message in this block, moff = start of block
+      kyzxp = kyzp*kzp*jxp
+      moff = kyzp*kzp*nvpz*joff
+c post all receives, data from processor id is stored in message id+1
+      do 50 n = 1, nvpz
+      id = n - 1
+      if (id.ne.ks) then
+         jd = js + nvpy*id
+         call MPI_IRECV(t(1,moff+kyzxp*id+1),ndim*kyzxp,mcplx,jd,jxi,
+     1lgrp,mreq(n),ierr)
+      else
+         mreq(n) = MPI_REQUEST_NULL
+      endif
+   50 continue
+      mreq(nvpz+ks+1) = MPI_REQUEST_NULL
+c extract and send data, data to processor id is stored in message id+1
+      do 100 n = 1, nvpz
+      id = n - ks - 1
+      if (id.lt.0) id = id + nvpz
+      if (id.eq.ks) go to 100
+      koff = kyzp*id
+      ld = min(kyzp,max(0,ny-koff))
+      loff = moff + kyzxp*id
+      do 90 l = 1, kzps
+      do 80 j = 1, jxp
+      do 70 k = 1, ld
+      do 60 i = 1, ndim
+      s(i,k+ld*(j+jxp*(l-1)-1)+loff) = g(i,k+koff,j+joff,l)
+   60 continue
+   70 continue
+   80 continue
+   90 continue
+      jd = js + nvpy*id
+      ld = ndim*ld*jxp*kzps
+      call MPI_ISEND(s(1,loff+1),ld,mcplx,jd,jxi,lgrp,mreq(nvpz+id+1),
+     1ierr)
+  100 continue
+c copy local block while messages are in flight
+      koff = kyzp*ks
+      loff = kzp*ks
+      do 140 l = 1, kzps
+      do 130 j = 1, jxp
+      do 120 k = 1, kyzps
+      do 110 i = 1, ndim
+      h(i,l+loff,j+joff,k) = g(i,k+koff,j+joff,l)
+  110 continue
+  120 continue
+  130 continue
+  140 continue
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPNTPOS3BW(h,t,mreq,nx,ny,nz,kxyp,kyzp,kzp,kstrt,nvpy, 
+     1nvpz,ndim,nzv,kxypd,kyzpd,jxi,jxp)
+c this subroutine completes a transpose of a block of x indices started
+c by PPNTPOS3BS, inserting data into h in the order it arrives.
+c h = complex output array
+c t = complex scratch array given to PPNTPOS3BS
+c mreq = receive/send requests for this block from PPNTPOS3BS
+c nx/ny/nz = number of points in x/y/z
+c kxyp/kyzp/kzp = number of data values per block in x/y/z
+c kstrt = starting data block number
+c nvpy/nvpz = number of real or virtual processors in y/z
+c ndim = leading dimension of array h
+c nzv = first dimension of h
+c kxypd = second dimension of h
+c kyzpd = third dimension of h
+c jxi = initial x index in block
+c jxp = number of x indices in block
+      implicit none
+      integer nx, ny, nz, kxyp, kyzp, kzp, kstrt, nvpy, nvpz, ndim
+      integer nzv, kxypd, kyzpd, jxi, jxp
+      integer mreq
+      complex h, t
+      dimension h(ndim,nzv,kxypd,kyzpd)
+      dimension t(ndim,kyzp*kxyp*kzp*nvpz)
+      dimension mreq(2*nvpz)
+      include 'mpif.h'
+c local data
+      integer i, n, j, k, l, ks, kyzps, id, joff, koff, loff, moff, ld
+      integer kyzxp, ierr, istatus
+      dimension istatus(MPI_STATUS_SIZE)
+c special case for one processor
+      if (nvpz.eq.1) return
+c ks = processor co-ordinate in z
+      ks = (kstrt - 1)/nvpy
+      kyzps = min(kyzp,max(0,ny-kyzp*ks))
+      joff = jxi - 1
+      kyzxp = kyzp*kzp*jxp
+      moff = kyzp*kzp*nvpz*joff
+c insert data as it arrives
+      do 50 n = 2, nvpz
+      call MPI_WAITANY(nvpz,mreq,id,istatus,ierr)
+      if (id.eq.MPI_UNDEFINED) go to 60
+      id = id - 1
+      loff = kzp*id
+      ld = min(kzp,max(0,nz-loff))
+      koff = moff + kyzxp*id
+      do 40 l = 1, ld
+      do 30 j = 1, jxp
+      do 20 k = 1, kyzps
+      do 10 i = 1, ndim
+      h(i,l+loff,j+joff,k) = t(i,k+kyzps*(j+jxp*(l-1)-1)+koff)
+   10 continue
+   20 continue
+   30 continue
+   40 continue
+   50 continue
+c wait for sends to complete
+   60 call MPI_WAITALL(nvpz,mreq(nvpz+1),MPI_STATUSES_IGNORE,ierr)
+      return
+      end
 c-----------------------------------------------------------------------
       subroutine PPMOVE32(part,edges,npp,sbufr,sbufl,rbufr,rbufl,ihole, 
      1ny,nz,kstrt,nvpy,nvpz,idimp,npmax,idps,nbmax,ntmax,info)
@@ -2193,3 +2816,708 @@ c check if buffer overflowed and more particles remain to be checked
   280 continue
       return
       end
+c-----------------------------------------------------------------------
+      subroutine PPWCHKPTH3(fname,nis,isc,nfs,fsc,irc)
+c this subroutine opens a shared checkpoint file for writing by all
+c processors with MPI-IO, and saves the scalars, which should be the
+c same on all processors.  distributed arrays are then written by
+c PPWCHKPTA3 and particles by PPWCHKPTP3, and the file is completed by
+c PPWCHKPTC3
+c input: all, output: irc
+c fname = name of checkpoint file
+c nis/nfs = number of integer/real scalars, <= 32
+c isc/fsc = integer/real scalars
+c irc = error code: 0 = ok, 1 = cannot create file, 4 = too many
+c scalars
+      implicit none
+      integer nis, nfs, irc
+      integer isc
+      real fsc
+      character*(*) fname
+      dimension isc(nis), fsc(nfs)
+c get definition of MPI constants
+      include 'mpif.h'
+c common block for parallel processing
+      integer nproc, lgrp, lstat, mreal, mint, mcplx, mdouble, lworld
+c lstat = length of status array
+      parameter(lstat=10)
+c lgrp = current communicator
+      common /PPARMS/ nproc, lgrp, mreal, mint, mcplx, mdouble, lworld
+c common block for checkpoint file
+c nchkmax = maximum number of scalars or arrays in a checkpoint
+c nchkal = alignment of arrays in checkpoint file, in bytes
+c nchkmg = magic number identifying file, 'PPC3' in ascii
+c lchkh = size of integer header
+      integer nchkmax, nchkal, nchkmg, lchkh
+      parameter(nchkmax=32,nchkal=4096,nchkmg=860049488)
+      parameter(lchkh=5+4*nchkmax)
+c nchkf = offset of next array in file being written
+c nchkh(1:32) = file offset of each array, in bytes
+c nchkh(33:64) = total number of particles in each particle array
+c mchk = checkpoint file handle
+c chkerr = error code of checkpoint being written
+c ichkh(1:5) = magic number, nvp, nis, nfs, narr
+c ichkh(6:37) = integer scalars
+c ichkh(38:133) = nxv, ny, nz of each array, idimp, 0, 0 for particles
+c fchkh = real scalars
+      integer(kind=MPI_OFFSET_KIND) nchkf, nchkh
+      integer mchk, chkerr, ichkh
+      real fchkh
+      dimension nchkh(2*nchkmax), ichkh(lchkh), fchkh(nchkmax)
+      common /PPCHKP/ nchkf, nchkh, mchk, chkerr, ichkh, fchkh
+      save /PPCHKP/
+c local data
+      integer j, minfo, ierr
+      integer(kind=MPI_OFFSET_KIND) nzero
+      irc = 0
+      if ((nis.gt.nchkmax).or.(nfs.gt.nchkmax)) then
+         irc = 4
+         return
+      endif
+      do 10 j = 1, lchkh
+      ichkh(j) = 0
+   10 continue
+      do 20 j = 1, 2*nchkmax
+      nchkh(j) = 0
+   20 continue
+      ichkh(1) = nchkmg
+      ichkh(2) = nproc
+      ichkh(3) = nis
+      ichkh(4) = nfs
+      do 30 j = 1, nis
+      ichkh(j+5) = isc(j)
+   30 continue
+      do 40 j = 1, nfs
+      fchkh(j) = fsc(j)
+   40 continue
+c collective buffering lets a few aggregators access the file
+      call MPI_INFO_CREATE(minfo,ierr)
+      call MPI_INFO_SET(minfo,'romio_cb_write','enable',ierr)
+      call MPI_FILE_OPEN(lgrp,fname,MPI_MODE_WRONLY+MPI_MODE_CREATE,
+     1minfo,mchk,ierr)
+      call MPI_INFO_FREE(minfo,ierr)
+      if (ierr.ne.MPI_SUCCESS) then
+         mchk = MPI_FILE_NULL
+         irc = 1
+         return
+      endif
+c discard any previous contents
+      nzero = 0
+      call MPI_FILE_SET_SIZE(mchk,nzero,ierr)
+c first block is reserved for header
+      nchkf = nchkal
+      chkerr = 0
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPWCHKPTA3(f,nyzp,noff,nxv,ny,nz,nypmx,nzpmx,idds)
+c this subroutine writes a distributed array to the checkpoint file
+c opened by PPWCHKPTH3, with a collective write.  the array is stored
+c as a global array f(nxv,ny,nz), each processor writes the nyzp(1) by
+c nyzp(2) block of its partition which starts at noff(1),noff(2),
+c without guard cells
+c input: all
+c f = distributed array, such as charge density or electric field
+c nyzp(1:2) = number of primary (complete) gridpoints in y/z
+c noff(1:2) = lowermost global gridpoint in y/z
+c nxv = first dimension of field array, must be >= nx
+c ny/nz = system length in y/z direction
+c nypmx = maximum size of particle partition in y, including guard cells
+c nzpmx = maximum size of particle partition in z, including guard cells
+c idds = dimensionality of domain decomposition
+      implicit none
+      integer nxv, ny, nz, nypmx, nzpmx, idds
+      real f
+      integer nyzp, noff
+      dimension f(nxv,nypmx,nzpmx)
+      dimension nyzp(idds), noff(idds)
+c get definition of MPI constants
+      include 'mpif.h'
+c common block for parallel processing
+      integer nproc, lgrp, lstat, mreal, mint, mcplx, mdouble, lworld
+c lstat = length of status array
+      parameter(lstat=10)
+c lgrp = current communicator
+c mreal = default datatype for reals
+      common /PPARMS/ nproc, lgrp, mreal, mint, mcplx, mdouble, lworld
+c common block for checkpoint file
+      integer nchkmax, nchkal, lchkh
+      parameter(nchkmax=32,nchkal=4096,lchkh=5+4*nchkmax)
+      integer(kind=MPI_OFFSET_KIND) nchkf, nchkh
+      integer mchk, chkerr, ichkh
+      real fchkh
+      dimension nchkh(2*nchkmax), ichkh(lchkh), fchkh(nchkmax)
+      common /PPCHKP/ nchkf, nchkh, mchk, chkerr, ichkh, fchkh
+c local data
+      integer n, nsz, mtype, ftype, ierr
+      integer lsizes, lsubs, lstarts, istatus
+      integer(kind=MPI_OFFSET_KIND) nzero, nbytes
+      dimension lsizes(3), lsubs(3), lstarts(3), istatus(lstat)
+      if (mchk.eq.MPI_FILE_NULL) return
+      n = ichkh(5) + 1
+      if (n.gt.nchkmax) then
+         chkerr = 4
+         return
+      endif
+      call MPI_TYPE_SIZE(mreal,nsz,ierr)
+      ichkh(3*n+3+nchkmax) = nxv
+      ichkh(3*n+4+nchkmax) = ny
+      ichkh(3*n+5+nchkmax) = nz
+      nchkh(n) = nchkf
+c block of partition in memory, without guard cells
+      lsizes(1) = nxv
+      lsizes(2) = nypmx
+      lsizes(3) = nzpmx
+      lsubs(1) = nxv
+      lsubs(2) = nyzp(1)
+      lsubs(3) = nyzp(2)
+      lstarts(1) = 0
+      lstarts(2) = 0
+      lstarts(3) = 0
+      call MPI_TYPE_CREATE_SUBARRAY(3,lsizes,lsubs,lstarts,
+     1MPI_ORDER_FORTRAN,mreal,mtype,ierr)
+      call MPI_TYPE_COMMIT(mtype,ierr)
+c block of partition in global array in file
+      lsizes(2) = ny
+      lsizes(3) = nz
+      lstarts(2) = noff(1)
+      lstarts(3) = noff(2)
+      call MPI_TYPE_CREATE_SUBARRAY(3,lsizes,lsubs,lstarts,
+     1MPI_ORDER_FORTRAN,mreal,ftype,ierr)
+      call MPI_TYPE_COMMIT(ftype,ierr)
+      call MPI_FILE_SET_VIEW(mchk,nchkf,mreal,ftype,'native',
+     1MPI_INFO_NULL,ierr)
+      call MPI_FILE_WRITE_ALL(mchk,f,1,mtype,istatus,ierr)
+      if (ierr.ne.MPI_SUCCESS) chkerr = 2
+c restore view of file as bytes
+      nzero = 0
+      call MPI_FILE_SET_VIEW(mchk,nzero,MPI_BYTE,MPI_BYTE,'native',
+     1MPI_INFO_NULL,ierr)
+      call MPI_TYPE_FREE(ftype,ierr)
+      call MPI_TYPE_FREE(mtype,ierr)
+c next array starts on a block boundary
+      nbytes = nsz
+      nbytes = nbytes*nxv*ny*nz
+      nchkf = nchkf + nchkal*((nbytes + nchkal - 1)/nchkal)
+      ichkh(5) = n
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPWCHKPTP3(part,edges,npp,idimp,npmax,idps)
+c this subroutine writes particles to the checkpoint file opened by
+c PPWCHKPTH3, with a collective write.  an index with the number of
+c particles and the partition boundaries of each processor is written
+c first, followed by the particles of each processor in processor order
+c input: all
+c part(i,n) = coordinate i of particle n in partition
+c edges(1:2) = lower:upper boundary in y of particle partition
+c edges(3:4) = back:front boundary in z of particle partition
+c npp = number of particles in partition
+c idimp = size of phase space = 6
+c npmax = maximum number of particles in each partition
+c idps = number of partition boundaries = 4
+      implicit none
+      integer npp, idimp, npmax, idps
+      real part, edges
+      dimension part(idimp,npmax), edges(idps)
+c get definition of MPI constants
+      include 'mpif.h'
+c common block for parallel processing
+      integer nproc, lgrp, lstat, mreal, mint, mcplx, mdouble, lworld
+      integer msum, mmax
+c lstat = length of status array
+      parameter(lstat=10)
+c lgrp = current communicator
+c mreal = default datatype for reals
+c mint = default datatype for integers
+      common /PPARMS/ nproc, lgrp, mreal, mint, mcplx, mdouble, lworld
+c msum = MPI_SUM
+      common /PPARMSX/ msum, mmax
+c common block for checkpoint file
+      integer nchkmax, nchkal, lchkh
+      parameter(nchkmax=32,nchkal=4096,lchkh=5+4*nchkmax)
+      integer(kind=MPI_OFFSET_KIND) nchkf, nchkh
+      integer mchk, chkerr, ichkh
+      real fchkh
+      dimension nchkh(2*nchkmax), ichkh(lchkh), fchkh(nchkmax)
+      common /PPCHKP/ nchkf, nchkh, mchk, chkerr, ichkh, fchkh
+c local data
+      integer n, ks, nsz, nisz, ierr
+      integer istatus
+      integer(kind=MPI_OFFSET_KIND) mpp, nsum, ntot, noff, nbytes
+      dimension istatus(lstat)
+      if (mchk.eq.MPI_FILE_NULL) return
+      n = ichkh(5) + 1
+      if (n.gt.nchkmax) then
+         chkerr = 4
+         return
+      endif
+      call MPI_COMM_RANK(lgrp,ks,ierr)
+      call MPI_TYPE_SIZE(mreal,nsz,ierr)
+      call MPI_TYPE_SIZE(mint,nisz,ierr)
+c find location of particles in file
+      mpp = npp
+      call MPI_EXSCAN(mpp,nsum,1,MPI_INTEGER8,msum,lgrp,ierr)
+      if (ks.eq.0) nsum = 0
+      call MPI_ALLREDUCE(mpp,ntot,1,MPI_INTEGER8,msum,lgrp,ierr)
+      ichkh(3*n+3+nchkmax) = idimp
+      ichkh(3*n+5+nchkmax) = idps
+      nchkh(n) = nchkf
+      nchkh(n+nchkmax) = ntot
+c each processor writes its entries in the index, the particle count
+c followed later by the partition boundaries
+      noff = nchkf + nisz*ks
+      call MPI_FILE_WRITE_AT_ALL(mchk,noff,npp,1,mint,istatus,ierr)
+      if (ierr.ne.MPI_SUCCESS) chkerr = 2
+      noff = nchkf + nisz*nproc + nsz*idps*ks
+      call MPI_FILE_WRITE_AT_ALL(mchk,noff,edges,idps,mreal,istatus,
+     1ierr)
+      if (ierr.ne.MPI_SUCCESS) chkerr = 2
+      nbytes = nisz + nsz*idps
+      nbytes = nbytes*nproc
+      nchkf = nchkf + nchkal*((nbytes + nchkal - 1)/nchkal)
+c write particles
+      noff = nchkf + nsz*idimp*nsum
+      call MPI_FILE_WRITE_AT_ALL(mchk,noff,part,idimp*npp,mreal,istatus
+     1,ierr)
+      if (ierr.ne.MPI_SUCCESS) chkerr = 2
+      nbytes = nsz*idimp
+      nbytes = nbytes*ntot
+      nchkf = nchkf + nchkal*((nbytes + nchkal - 1)/nchkal)
+      ichkh(5) = n
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPWCHKPTC3(irc)
+c this subroutine completes the checkpoint file written by PPWCHKPTH3,
+c PPWCHKPTA3 and PPWCHKPTP3.  processor 0 writes the header.  the
+c file is written in place: the caller should write a temporary file
+c and rename it after this call, as ppic3.c does
+c output: irc
+c irc = error code: 0 = ok, 1 = file not open, 2 = write error,
+c 4 = too many arrays
+      implicit none
+      integer irc
+c get definition of MPI constants
+      include 'mpif.h'
+c common block for parallel processing
+      integer nproc, lgrp, lstat, mreal, mint, mcplx, mdouble, lworld
+      integer msum, mmax
+c lstat = length of status array
+      parameter(lstat=10)
+c lgrp = current communicator
+c mreal = default datatype for reals
+c mint = default datatype for integers
+      common /PPARMS/ nproc, lgrp, mreal, mint, mcplx, mdouble, lworld
+c mmax = MPI_MAX
+      common /PPARMSX/ msum, mmax
+c common block for checkpoint file
+      integer nchkmax, nchkal, lchkh
+      parameter(nchkmax=32,nchkal=4096,lchkh=5+4*nchkmax)
+      integer(kind=MPI_OFFSET_KIND) nchkf, nchkh
+      integer mchk, chkerr, ichkh
+      real fchkh
+      dimension nchkh(2*nchkmax), ichkh(lchkh), fchkh(nchkmax)
+      common /PPCHKP/ nchkf, nchkh, mchk, chkerr, ichkh, fchkh
+c local data
+      integer ks, ierr
+      integer istatus
+      integer(kind=MPI_OFFSET_KIND) noff
+      dimension istatus(lstat)
+      if (mchk.eq.MPI_FILE_NULL) then
+         irc = 1
+         return
+      endif
+      call MPI_COMM_RANK(lgrp,ks,ierr)
+c header is written as integers, reals and offsets
+      if (ks.eq.0) then
+         noff = 0
+         call MPI_FILE_WRITE_AT(mchk,noff,ichkh,lchkh,mint,istatus,ierr)
+         if (ierr.ne.MPI_SUCCESS) chkerr = 2
+         noff = 2048
+         call MPI_FILE_WRITE_AT(mchk,noff,fchkh,nchkmax,mreal,istatus,
+     1ierr)
+         if (ierr.ne.MPI_SUCCESS) chkerr = 2
+         noff = 3072
+         call MPI_FILE_WRITE_AT(mchk,noff,nchkh,2*nchkmax,MPI_INTEGER8,
+     1istatus,ierr)
+         if (ierr.ne.MPI_SUCCESS) chkerr = 2
+      endif
+      call MPI_FILE_SYNC(mchk,ierr)
+      if (ierr.ne.MPI_SUCCESS) chkerr = 2
+      call MPI_FILE_CLOSE(mchk,ierr)
+      mchk = MPI_FILE_NULL
+      call MPI_ALLREDUCE(chkerr,irc,1,mint,mmax,lgrp,ierr)
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPRCHKPTH3(fname,nis,isc,nfs,fsc,nvpo,irc)
+c this subroutine opens a checkpoint file written by PPWCHKPTH3 for
+c reading by all processors with MPI-IO, and reads the scalars.
+c the arrays are then read by PPRCHKPTA3 and PPRCHKPTP3, and the file
+c is closed by PPRCHKPTC3
+c input: fname, nis, nfs, output: isc, fsc, nvpo, irc
+c fname = name of checkpoint file
+c nis/nfs = number of integer/real scalars expected
+c isc/fsc = integer/real scalars
+c nvpo = number of processors which wrote the file
+c irc = error code: 0 = ok, 1 = cannot open file, 2 = not a valid
+c checkpoint file, or wrong number of scalars
+      implicit none
+      integer nis, nfs, nvpo, irc
+      integer isc
+      real fsc
+      character*(*) fname
+      dimension isc(nis), fsc(nfs)
+c get definition of MPI constants
+      include 'mpif.h'
+c common block for parallel processing
+      integer nproc, lgrp, lstat, mreal, mint, mcplx, mdouble, lworld
+c lstat = length of status array
+      parameter(lstat=10)
+c lgrp = current communicator
+c mreal = default datatype for reals
+c mint = default datatype for integers
+      common /PPARMS/ nproc, lgrp, mreal, mint, mcplx, mdouble, lworld
+c common block for checkpoint file
+      integer nchkmax, nchkal, nchkmg, lchkh
+      parameter(nchkmax=32,nchkal=4096,nchkmg=860049488)
+      parameter(lchkh=5+4*nchkmax)
+      integer(kind=MPI_OFFSET_KIND) nchkf, nchkh
+      integer mchk, chkerr, ichkh
+      real fchkh
+      dimension nchkh(2*nchkmax), ichkh(lchkh), fchkh(nchkmax)
+      common /PPCHKP/ nchkf, nchkh, mchk, chkerr, ichkh, fchkh
+c local data
+      integer j, ks, minfo, ierr
+      integer istatus
+      integer(kind=MPI_OFFSET_KIND) noff
+      dimension istatus(lstat)
+      irc = 0
+      call MPI_INFO_CREATE(minfo,ierr)
+      call MPI_INFO_SET(minfo,'romio_cb_read','enable',ierr)
+      call MPI_FILE_OPEN(lgrp,fname,MPI_MODE_RDONLY,minfo,mchk,ierr)
+      call MPI_INFO_FREE(minfo,ierr)
+      if (ierr.ne.MPI_SUCCESS) then
+         mchk = MPI_FILE_NULL
+         irc = 1
+         return
+      endif
+c processor 0 reads the header and broadcasts it
+      call MPI_COMM_RANK(lgrp,ks,ierr)
+      do 10 j = 1, lchkh
+      ichkh(j) = 0
+   10 continue
+      if (ks.eq.0) then
+         noff = 0
+         call MPI_FILE_READ_AT(mchk,noff,ichkh,lchkh,mint,istatus,ierr)
+         noff = 2048
+         call MPI_FILE_READ_AT(mchk,noff,fchkh,nchkmax,mreal,istatus,
+     1ierr)
+         noff = 3072
+         call MPI_FILE_READ_AT(mchk,noff,nchkh,2*nchkmax,MPI_INTEGER8,
+     1istatus,ierr)
+      endif
+      call MPI_BCAST(ichkh,lchkh,mint,0,lgrp,ierr)
+      call MPI_BCAST(fchkh,nchkmax,mreal,0,lgrp,ierr)
+      call MPI_BCAST(nchkh,2*nchkmax,MPI_INTEGER8,0,lgrp,ierr)
+      if ((ichkh(1).ne.nchkmg).or.(ichkh(2).lt.1).or.(ichkh(3).ne.nis)
+     1.or.(ichkh(4).ne.nfs).or.(ichkh(5).gt.nchkmax)) then
+         call PPRCHKPTC3
+         irc = 2
+         return
+      endif
+      do 20 j = 1, nis
+      isc(j) = ichkh(j+5)
+   20 continue
+      do 30 j = 1, nfs
+      fsc(j) = fchkh(j)
+   30 continue
+      nvpo = ichkh(2)
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPRCHKPTA3(n,f,nyzp,noff,nxv,ny,nz,nypmx,nzpmx,idds,irc
+     1)
+c this subroutine reads a distributed array from the checkpoint file
+c opened by PPRCHKPTH3, with a collective read.  each processor reads
+c the block of its partition from the global array f(nxv,ny,nz), so
+c the partition need not be the same as the one which wrote the file
+c input: all except f, irc, output: f, irc
+c n = array number in checkpoint file, starting with 1
+c f = distributed array, guard cells are not read
+c nyzp(1:2) = number of primary (complete) gridpoints in y/z
+c noff(1:2) = lowermost global gridpoint in y/z
+c nxv = first dimension of field array, must be >= nx
+c ny/nz = system length in y/z direction
+c nypmx = maximum size of particle partition in y, including guard cells
+c nzpmx = maximum size of particle partition in z, including guard cells
+c idds = dimensionality of domain decomposition
+c irc = error code: 0 = ok, 2 = read error, 3 = array not found or
+c wrong size
+      implicit none
+      integer n, nxv, ny, nz, nypmx, nzpmx, idds, irc
+      real f
+      integer nyzp, noff
+      dimension f(nxv,nypmx,nzpmx)
+      dimension nyzp(idds), noff(idds)
+c get definition of MPI constants
+      include 'mpif.h'
+c common block for parallel processing
+      integer nproc, lgrp, lstat, mreal, mint, mcplx, mdouble, lworld
+      integer msum, mmax
+c lstat = length of status array
+      parameter(lstat=10)
+c lgrp = current communicator
+c mreal = default datatype for reals
+c mint = default datatype for integers
+      common /PPARMS/ nproc, lgrp, mreal, mint, mcplx, mdouble, lworld
+c mmax = MPI_MAX
+      common /PPARMSX/ msum, mmax
+c common block for checkpoint file
+      integer nchkmax, nchkal, lchkh
+      parameter(nchkmax=32,nchkal=4096,lchkh=5+4*nchkmax)
+      integer(kind=MPI_OFFSET_KIND) nchkf, nchkh
+      integer mchk, chkerr, ichkh
+      real fchkh
+      dimension nchkh(2*nchkmax), ichkh(lchkh), fchkh(nchkmax)
+      common /PPCHKP/ nchkf, nchkh, mchk, chkerr, ichkh, fchkh
+c local data
+      integer mtype, ftype, ierr, jerr
+      integer lsizes, lsubs, lstarts, istatus
+      integer(kind=MPI_OFFSET_KIND) nzero
+      dimension lsizes(3), lsubs(3), lstarts(3), istatus(lstat)
+      if ((mchk.eq.MPI_FILE_NULL).or.(n.lt.1).or.(n.gt.ichkh(5))) then
+         irc = 3
+         return
+      endif
+      if ((ichkh(3*n+3+nchkmax).ne.nxv).or.(ichkh(3*n+4+nchkmax).ne.ny)
+     1.or.(ichkh(3*n+5+nchkmax).ne.nz)) then
+         irc = 3
+         return
+      endif
+c block of partition in memory, without guard cells
+      lsizes(1) = nxv
+      lsizes(2) = nypmx
+      lsizes(3) = nzpmx
+      lsubs(1) = nxv
+      lsubs(2) = nyzp(1)
+      lsubs(3) = nyzp(2)
+      lstarts(1) = 0
+      lstarts(2) = 0
+      lstarts(3) = 0
+      call MPI_TYPE_CREATE_SUBARRAY(3,lsizes,lsubs,lstarts,
+     1MPI_ORDER_FORTRAN,mreal,mtype,ierr)
+      call MPI_TYPE_COMMIT(mtype,ierr)
+c block of partition in global array in file
+      lsizes(2) = ny
+      lsizes(3) = nz
+      lstarts(2) = noff(1)
+      lstarts(3) = noff(2)
+      call MPI_TYPE_CREATE_SUBARRAY(3,lsizes,lsubs,lstarts,
+     1MPI_ORDER_FORTRAN,mreal,ftype,ierr)
+      call MPI_TYPE_COMMIT(ftype,ierr)
+      call MPI_FILE_SET_VIEW(mchk,nchkh(n),mreal,ftype,'native',
+     1MPI_INFO_NULL,ierr)
+      call MPI_FILE_READ_ALL(mchk,f,1,mtype,istatus,ierr)
+      jerr = 0
+      if (ierr.ne.MPI_SUCCESS) jerr = 2
+c restore view of file as bytes
+      nzero = 0
+      call MPI_FILE_SET_VIEW(mchk,nzero,MPI_BYTE,MPI_BYTE,'native',
+     1MPI_INFO_NULL,ierr)
+      call MPI_TYPE_FREE(ftype,ierr)
+      call MPI_TYPE_FREE(mtype,ierr)
+      call MPI_ALLREDUCE(jerr,irc,1,mint,mmax,lgrp,ierr)
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPRCHKPTP3(n,part,edges,npp,idimp,npmax,idps,irc)
+c this subroutine reads particles from the checkpoint file opened by
+c PPRCHKPTH3, with collective reads.  from the index, each processor
+c finds the processors which wrote the file whose partitions overlap
+c its own partition in y and z, reads their particles and keeps those
+c inside its own partition.  if the partitions are the same, each
+c processor reads only the particles it wrote.  otherwise the file may
+c have been written by a different number of processors, and the
+c particles are read in blocks of at most nchkbf particles, into the
+c unused part of the particle array, so no particles need to be moved
+c between processors afterwards
+c input: n, edges, idimp, npmax, idps, output: part, npp, irc
+c n = array number in checkpoint file, starting with 1
+c part(i,n) = coordinate i of particle n in partition
+c edges(1:2) = lower:upper boundary in y of particle partition
+c edges(3:4) = back:front boundary in z of particle partition
+c npp = number of particles read in partition
+c idimp = size of phase space = 6
+c npmax = maximum number of particles in each partition
+c idps = number of partition boundaries = 4
+c irc = error code: 0 = ok, 2 = read error, 3 = array not found,
+c wrong size, too many particles, or particles outside all partitions
+      implicit none
+      integer n, npp, idimp, npmax, idps, irc
+      real part, edges
+      dimension part(idimp,npmax), edges(idps)
+c get definition of MPI constants
+      include 'mpif.h'
+c common block for parallel processing
+      integer nproc, lgrp, lstat, mreal, mint, mcplx, mdouble, lworld
+      integer msum, mmax
+c lstat = length of status array
+      parameter(lstat=10)
+c lgrp = current communicator
+c mreal = default datatype for reals
+c mint = default datatype for integers
+      common /PPARMS/ nproc, lgrp, mreal, mint, mcplx, mdouble, lworld
+c msum = MPI_SUM
+c mmax = MPI_MAX
+      common /PPARMSX/ msum, mmax
+c common block for checkpoint file
+      integer nchkmax, nchkal, lchkh
+      parameter(nchkmax=32,nchkal=4096,lchkh=5+4*nchkmax)
+      integer(kind=MPI_OFFSET_KIND) nchkf, nchkh
+      integer mchk, chkerr, ichkh
+      real fchkh
+      dimension nchkh(2*nchkmax), ichkh(lchkh), fchkh(nchkmax)
+      common /PPCHKP/ nchkf, nchkh, mchk, chkerr, ichkh, fchkh
+c nchkbf = maximum number of particles read in one block
+c nvpmx = maximum number of processors which wrote the file
+      integer nchkbf, nvpmx
+      parameter(nchkbf=65536,nvpmx=16384)
+c local data
+      integer i, j, jw, ks, nvpo, mpp, mps, nps, npt, nsz, nisz, ierr
+      integer jerr
+      integer kpp, istatus
+      integer(kind=MPI_OFFSET_KIND) noffp, nbytes, nsum, mtot, ntot
+      integer(kind=MPI_OFFSET_KIND) mrem
+      logical lsame, lover
+      real edgs, yt, zt
+      dimension kpp(nvpmx), edgs(4,nvpmx), istatus(lstat)
+      if ((mchk.eq.MPI_FILE_NULL).or.(n.lt.1).or.(n.gt.ichkh(5))) then
+         irc = 3
+         return
+      endif
+      nvpo = ichkh(2)
+      if ((ichkh(3*n+3+nchkmax).ne.idimp).or.(ichkh(3*n+4+nchkmax).ne.0)
+     1.or.(ichkh(3*n+5+nchkmax).ne.idps).or.(idps.ne.4).or.
+     2(nvpo.gt.nvpmx)) then
+         irc = 3
+         return
+      endif
+      call MPI_COMM_RANK(lgrp,ks,ierr)
+      call MPI_TYPE_SIZE(mreal,nsz,ierr)
+      call MPI_TYPE_SIZE(mint,nisz,ierr)
+c read particle index
+      jerr = 0
+      call MPI_FILE_READ_AT_ALL(mchk,nchkh(n),kpp,nvpo,mint,istatus,ierr
+     1)
+      if (ierr.ne.MPI_SUCCESS) jerr = 2
+      noffp = nchkh(n) + nisz*nvpo
+      call MPI_FILE_READ_AT_ALL(mchk,noffp,edgs,idps*nvpo,mreal,istatus
+     1,ierr)
+      if (ierr.ne.MPI_SUCCESS) jerr = 2
+      nbytes = nisz + nsz*idps
+      nbytes = nbytes*nvpo
+      noffp = nchkh(n) + nchkal*((nbytes + nchkal - 1)/nchkal)
+c same partition: read own particles directly
+      lsame = .false.
+      if (nvpo.eq.nproc) then
+         lsame = ((edgs(1,ks+1).eq.edges(1)).and.(edgs(2,ks+1).eq.
+     1edges(2)).and.(edgs(3,ks+1).eq.edges(3)).and.(edgs(4,ks+1).eq.
+     2edges(4)))
+      endif
+      mpp = 0
+      nsum = 0
+      if (lsame) then
+         do 10 j = 1, ks
+         nsum = nsum + kpp(j)
+   10    continue
+         mpp = kpp(ks+1)
+         if (mpp.gt.npmax) jerr = 3
+      endif
+      call MPI_ALLREDUCE(jerr,irc,1,mint,mmax,lgrp,ierr)
+      if (irc.ne.0) return
+      nbytes = nsz*idimp
+      nbytes = noffp + nbytes*nsum
+      call MPI_FILE_READ_AT_ALL(mchk,nbytes,part,idimp*mpp,mreal,
+     1istatus,ierr)
+      if (ierr.ne.MPI_SUCCESS) jerr = 2
+c different partition: read particles of overlapping partitions in
+c blocks, until no processor has particles left to read
+c jw = processor being read, mrem = particles of jw not yet read
+c nsum = particles in file before next block
+      jw = 0
+      mrem = 0
+      nsum = 0
+      if (.not.lsame) jw = 1
+   20 if ((jw.ge.1).and.(jw.le.nvpo).and.(mrem.eq.0)) then
+         lover = ((edgs(1,jw).lt.edges(2)).and.(edgs(2,jw).gt.edges(1))
+     1.and.(edgs(3,jw).lt.edges(4)).and.(edgs(4,jw).gt.edges(3)))
+         if (lover) then
+            mrem = kpp(jw)
+         else
+            nsum = nsum + kpp(jw)
+         endif
+         jw = jw + 1
+         go to 20
+      endif
+      nps = min(mrem,int(min(nchkbf,npmax-mpp),kind=MPI_OFFSET_KIND))
+      mps = mpp
+c particles are read into the unused part of the particle array
+      if ((nps.le.0).and.(mrem.gt.0)) then
+         jerr = 3
+         nps = 0
+         mrem = 0
+         jw = nvpo + 1
+      endif
+      call MPI_ALLREDUCE(nps,npt,1,mint,mmax,lgrp,ierr)
+      if (npt.gt.0) then
+         nbytes = nsz*idimp
+         nbytes = noffp + nbytes*nsum
+         call MPI_FILE_READ_AT_ALL(mchk,nbytes,part(1,min(mps+1,npmax)),
+     1idimp*nps,mreal,istatus,ierr)
+         if (ierr.ne.MPI_SUCCESS) jerr = 2
+         nsum = nsum + nps
+         mrem = mrem - nps
+c keep particles inside partition
+         do 40 j = 1, nps
+         yt = part(2,mps+j)
+         zt = part(3,mps+j)
+         if ((yt.ge.edges(1)).and.(yt.lt.edges(2)).and.(zt.ge.edges(3))
+     1.and.(zt.lt.edges(4))) then
+            mpp = mpp + 1
+            do 30 i = 1, idimp
+            part(i,mpp) = part(i,mps+j)
+   30       continue
+         endif
+   40    continue
+         go to 20
+      endif
+c check that every particle was read by one processor
+      mtot = mpp
+      call MPI_ALLREDUCE(mtot,ntot,1,MPI_INTEGER8,msum,lgrp,ierr)
+      if (ntot.ne.nchkh(n+nchkmax)) jerr = 3
+      call MPI_ALLREDUCE(jerr,irc,1,mint,mmax,lgrp,ierr)
+      npp = mpp
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPRCHKPTC3
+c this subroutine closes the checkpoint file opened by PPRCHKPTH3
+      implicit none
+c get definition of MPI constants
+      include 'mpif.h'
+c common block for checkpoint file
+      integer nchkmax, nchkal, lchkh
+      parameter(nchkmax=32,nchkal=4096,lchkh=5+4*nchkmax)
+      integer(kind=MPI_OFFSET_KIND) nchkf, nchkh
+      integer mchk, chkerr, ichkh
+      real fchkh
+      dimension nchkh(2*nchkmax), ichkh(lchkh), fchkh(nchkmax)
+      common /PPCHKP/ nchkf, nchkh, mchk, chkerr, ichkh, fchkh
+c local data
+      integer ierr
+      if (mchk.ne.MPI_FILE_NULL) call MPI_FILE_CLOSE(mchk,ierr)
+      mchk = MPI_FILE_NULL
+      return
+      end
@@ -19,6 +19,15 @@
 ! PPNACGUARD32L adds guard cells in y and z for vector array, linear
 !               interpolation, and distributed data with 2D non-uniform
 !               partition.
+! PPNGUARD32INIT creates persistent requests for guard cell exchanges
+!                in y and z, to be reused every time step.
+! PPNCGUARD32LP copies data to guard cells in y and z for scalar data,
+!               using persistent requests created by PPNGUARD32INIT.
+! PPNAGUARD32LP adds guard cells in y and z for scalar array, using
+!               persistent requests created by PPNGUARD32INIT.
+! PPNACGUARD32LP adds guard cells in y and z for vector array, using
+!                persistent requests created by PPNGUARD32INIT.
+! PPNGUARD32FREE frees persistent requests created by PPNGUARD32INIT.
 ! PPTPOS3A performs a transpose of a complex scalar array, distributed
 !          in y and z, to a complex scalar array, distributed in x and z
 ! PPTPOS3B performs a transpose of a complex scalar array, distributed
@@ -29,6 +38,11 @@
 ! PPNTPOS3B performs a transpose of an n component complex vector array,
 !           distributed in x and z, to an n component complex vector
 !           array, distributed in x and y.
+! PPNTPOS3BS starts a transpose of a block of x indices of an n
+!            component complex vector array, distributed in x and z,
+!            to an n component complex vector array, distributed in x
+!            and y, using non-blocking messages.
+! PPNTPOS3BW completes a transpose started by PPNTPOS3BS.
 ! PPMOVE32 moves particles into appropriate spatial regions with
 !          periodic boundary conditions and 2D spatial decomposition.
 !          Assumes ihole list has been found.
@@ -53,13 +67,22 @@
 ! msum = MPI_SUM
 ! mmax = MPI_MAX
       integer :: msum, mmax
+! maxgds = maximum number of guard cell exchange plans
+      integer, parameter :: maxgds = 8
+! ngds = number of guard cell exchange plans created so far
+      integer :: ngds = 0
+! mgds = persistent requests for each plan
+      integer, dimension(8,maxgds) :: mgds
       save
 !
       private
       public :: PPINIT2, PPEXIT, PPABORT, PWTIMERA
       public :: PPSUM, PPDSUM, PPIMAX, PPDMAX
       public :: PPNCGUARD32L, PPNAGUARD32L, PPNACGUARD32L
+      public :: PPNGUARD32INIT, PPNCGUARD32LP, PPNAGUARD32LP
+      public :: PPNACGUARD32LP, PPNGUARD32FREE
       public :: PPTPOS3A, PPTPOS3B, PPNTPOS3A, PPNTPOS3B, PPMOVE32
+      public :: PPNTPOS3BS, PPNTPOS3BW
 !
       contains
 !
@@ -610,6 +633,380 @@
       enddo
       end subroutine
 !
+!-----------------------------------------------------------------------
+      subroutine PPNGUARD32INIT(scs,scr,igds,kstrt,nvpy,nvpz,nxv,nypmx, &
+     &nzpmx)
+! this subroutine creates persistent requests for guard cell exchanges
+! in y and z with non-uniform partitions, for data with nxv reals per
+! row in x.
+! the same plan is used by PPNCGUARD32LP, PPNAGUARD32LP and
+! PPNACGUARD32LP, which avoids setting up new messages every call.
+! a full plane of nxv*nzpmx reals is sent in y and nxv*nypmx reals in z,
+! so that the message sizes do not depend on the partition.
+! scs = buffers for sending/receiving data in y
+! scr = buffers for sending/receiving data in z
+! scs and scr must not be moved or deallocated while the plan is in use.
+! igds = plan number returned, 0 if no plan could be created
+! kstrt = starting data block number
+! nvpy/nvpz = number of real or virtual processors in y/z
+! nxv = number of reals in one row of data, e.g., ndim*nxv for a
+! vector array
+! nypmx = maximum size of particle partition in y, including guard cells
+! nzpmx = maximum size of particle partition in z, including guard cells
+      implicit none
+      integer, intent(in) :: kstrt, nvpy, nvpz, nxv, nypmx, nzpmx
+      integer, intent(inout) :: igds
+      real, dimension(nxv,nzpmx,2), intent(inout) :: scs
+      real, dimension(nxv,nypmx,2), intent(inout) :: scr
+! lgrp = current communicator
+! mreal = default datatype for reals
+! ngds = number of guard cell exchange plans created so far
+! mgds = persistent requests for each plan
+! local data
+      integer :: n, js, ks, noff, kr, kl, nxvz, nxvy, ierr
+      igds = 0
+      if (ngds >= maxgds) then
+         if (kstrt==1) then
+            write (*,*) 'PPNGUARD32INIT: too many plans, maxgds=',maxgds
+         endif
+         return
+      endif
+      ngds = ngds + 1
+      n = ngds
+      igds = n
+      mgds(:,n) = MPI_REQUEST_NULL
+! js/ks = processor co-ordinates in y/z => idproc = js + nvpy*ks
+      ks = (kstrt - 1)/nvpy
+      js = kstrt - nvpy*ks - 1
+      noff = nypmx*nzpmx
+      nxvz = nxv*nzpmx
+      nxvy = nxv*nypmx
+! exchanges in y, special case for one processor in y
+      if (nvpy > 1) then
+         kr = js + 1
+         if (kr >= nvpy) kr = kr - nvpy
+         kl = js - 1
+         if (kl < 0) kl = kl + nvpy
+         kr = kr + nvpy*ks
+         kl = kl + nvpy*ks
+! copy guard cells: receive from right, send to left
+         call MPI_RECV_INIT(scs(1,1,2),nxvz,mreal,kr,noff+3,lgrp,       &
+     &mgds(1,n),ierr)
+         call MPI_SEND_INIT(scs,nxvz,mreal,kl,noff+3,lgrp,mgds(2,n),ierr&
+     &)
+! add guard cells: receive from left, send to right
+         call MPI_RECV_INIT(scs(1,1,2),nxvz,mreal,kl,noff+1,lgrp,       &
+     &mgds(5,n),ierr)
+         call MPI_SEND_INIT(scs,nxvz,mreal,kr,noff+1,lgrp,mgds(6,n),ierr&
+     &)
+      endif
+! exchanges in z, special case for one processor in z
+      if (nvpz > 1) then
+         kr = ks + 1
+         if (kr >= nvpz) kr = kr - nvpz
+         kl = ks - 1
+         if (kl < 0) kl = kl + nvpz
+         kr = js + nvpy*kr
+         kl = js + nvpy*kl
+! copy guard cells: receive from right, send to left
+         call MPI_RECV_INIT(scr(1,1,2),nxvy,mreal,kr,noff+4,lgrp,       &
+     &mgds(3,n),ierr)
+         call MPI_SEND_INIT(scr,nxvy,mreal,kl,noff+4,lgrp,mgds(4,n),ierr&
+     &)
+! add guard cells: receive from left, send to right
+         call MPI_RECV_INIT(scr(1,1,2),nxvy,mreal,kl,noff+2,lgrp,       &
+     &mgds(7,n),ierr)
+         call MPI_SEND_INIT(scr,nxvy,mreal,kr,noff+2,lgrp,mgds(8,n),ierr&
+     &)
+      endif
+      end subroutine
+!
+!-----------------------------------------------------------------------
+      subroutine PPNCGUARD32LP(f,scs,scr,igds,nyzp,nvpy,nvpz,nxv,nypmx, &
+     &nzpmx,idds)
+! this subroutine copies data to guard cells in non-uniform partitions
+! using persistent requests created by PPNGUARD32INIT
+! f(j,k,l) = real data for grid j,k,l in particle partition.
+! the grid is non-uniform and includes one extra guard cell.
+! output: f, scs, scr
+! scs/scr = buffers in y/z given to PPNGUARD32INIT
+! igds = plan number returned by PPNGUARD32INIT
+! nyzp(1:2) = number of primary gridpoints in y/z in particle partition
+! nvpy/nvpz = number of real or virtual processors in y/z
+! nxv = first dimension of f, must be same as in PPNGUARD32INIT
+! nypmx = maximum size of particle partition in y, including guard cells
+! nzpmx = maximum size of particle partition in z, including guard cells
+! idds = dimensionality of domain decomposition
+! linear interpolation, for distributed data,
+! with 2D spatial decomposition
+      implicit none
+      integer, intent(in) :: igds, nvpy, nvpz, nxv, nypmx, nzpmx, idds
+      real, dimension(nxv,nypmx,nzpmx), intent(inout) :: f
+      real, dimension(nxv,nzpmx,2), intent(inout) :: scs
+      real, dimension(nxv,nypmx,2), intent(inout) :: scr
+      integer, dimension(idds), intent(in) :: nyzp
+! mgds = persistent requests for each plan
+! local data
+      integer :: j, k, nyp1, nzp1, ierr
+      nyp1 = nyzp(1) + 1
+      nzp1 = nyzp(2) + 1
+! special case for one processor in y
+      if (nvpy==1) then
+         do k = 1, nyzp(2)
+            do j = 1, nxv
+               f(j,nyp1,k) = f(j,1,k)
+            enddo
+         enddo
+      else
+! buffer data in y
+         do k = 1, nyzp(2)
+            do j = 1, nxv
+               scs(j,k,1) = f(j,1,k)
+            enddo
+         enddo
+! copy to guard cells in y
+         call MPI_STARTALL(2,mgds(1:2,igds),ierr)
+         call MPI_WAITALL(2,mgds(1:2,igds),MPI_STATUSES_IGNORE,ierr)
+! copy guard cells
+         do k = 1, nyzp(2)
+            do j = 1, nxv
+               f(j,nyp1,k) = scs(j,k,2)
+            enddo
+         enddo
+      endif
+! special case for one processor in z
+      if (nvpz==1) then
+         do k = 1, nyp1
+            do j = 1, nxv
+               f(j,k,nzp1) = f(j,k,1)
+            enddo
+         enddo
+         return
+      endif
+! buffer data in z
+      do k = 1, nyp1
+         do j = 1, nxv
+            scr(j,k,1) = f(j,k,1)
+         enddo
+      enddo
+! copy to guard cells in z
+      call MPI_STARTALL(2,mgds(3:4,igds),ierr)
+      call MPI_WAITALL(2,mgds(3:4,igds),MPI_STATUSES_IGNORE,ierr)
+! copy guard cells
+      do k = 1, nyp1
+         do j = 1, nxv
+            f(j,k,nzp1) = scr(j,k,2)
+         enddo
+      enddo
+      end subroutine
+!
+!-----------------------------------------------------------------------
+      subroutine PPNAGUARD32LP(f,scs,scr,igds,nyzp,nvpy,nvpz,nx,nxv,    &
+     &nypmx,nzpmx,idds)
+! this subroutine adds data from guard cells in non-uniform partitions
+! using persistent requests created by PPNGUARD32INIT
+! f(j,k,l) = real data for grid j,k,l in particle partition.
+! the grid is non-uniform and includes one extra guard cell.
+! output: f, scs, scr
+! scs/scr = buffers in y/z given to PPNGUARD32INIT
+! igds = plan number returned by PPNGUARD32INIT
+! nyzp(1:2) = number of primary gridpoints in y/z in particle partition
+! nvpy/nvpz = number of real or virtual processors in y/z
+! nx = system length in x direction
+! nxv = first dimension of f, must be same as in PPNGUARD32INIT
+! nypmx = maximum size of particle partition in y, including guard cells
+! nzpmx = maximum size of particle partition in z, including guard cells
+! idds = dimensionality of domain decomposition
+! linear interpolation, for distributed data
+! with 2D spatial decomposition
+      implicit none
+      integer, intent(in) :: igds, nvpy, nvpz, nx, nxv, nypmx, nzpmx
+      integer, intent(in) :: idds
+      real, dimension(nxv,nypmx,nzpmx), intent(inout) :: f
+      real, dimension(nxv,nzpmx,2), intent(inout) :: scs
+      real, dimension(nxv,nypmx,2), intent(inout) :: scr
+      integer, dimension(idds), intent(in) :: nyzp
+! mgds = persistent requests for each plan
+! local data
+      integer :: j, k, nx1, nyp1, nzp1, ierr
+      nx1 = nx + 1
+      nyp1 = nyzp(1) + 1
+      nzp1 = nyzp(2) + 1
+! special case for one processor in y
+      if (nvpy==1) then
+         do k = 1, nzp1
+            do j = 1, nx1
+               f(j,1,k) = f(j,1,k) + f(j,nyp1,k)
+               f(j,nyp1,k) = 0.0
+            enddo
+         enddo
+      else
+! buffer data in y
+         do k = 1, nzp1
+            do j = 1, nxv
+               scs(j,k,1) = f(j,nyp1,k)
+            enddo
+         enddo
+! add guard cells in y
+         call MPI_STARTALL(2,mgds(5:6,igds),ierr)
+         call MPI_WAITALL(2,mgds(5:6,igds),MPI_STATUSES_IGNORE,ierr)
+! add up the guard cells
+         do k = 1, nzp1
+            do j = 1, nx1
+               f(j,1,k) = f(j,1,k) + scs(j,k,2)
+               f(j,nyp1,k) = 0.0
+            enddo
+         enddo
+      endif
+! special case for one processor in z
+      if (nvpz==1) then
+         do k = 1, nyp1
+            do j = 1, nx1
+               f(j,k,1) = f(j,k,1) + f(j,k,nzp1)
+               f(j,k,nzp1) = 0.0
+            enddo
+         enddo
+         return
+      endif
+! buffer data in z
+      do k = 1, nyp1
+         do j = 1, nxv
+            scr(j,k,1) = f(j,k,nzp1)
+         enddo
+      enddo
+! add guard cells in z
+      call MPI_STARTALL(2,mgds(7:8,igds),ierr)
+      call MPI_WAITALL(2,mgds(7:8,igds),MPI_STATUSES_IGNORE,ierr)
+! add up the guard cells
+      do k = 1, nyp1
+         do j = 1, nx1
+            f(j,k,1) = f(j,k,1) + scr(j,k,2)
+            f(j,k,nzp1) = 0.0
+         enddo
+      enddo
+      end subroutine
+!
+!-----------------------------------------------------------------------
+      subroutine PPNACGUARD32LP(f,scs,scr,igds,nyzp,ndim,nvpy,nvpz,nx,  &
+     &nxv,nypmx,nzpmx,idds)
+! this subroutine adds data from guard cells in non-uniform partitions
+! using persistent requests created by PPNGUARD32INIT
+! f(ndim,j,k,l) = real data for grid j,k,l in particle partition.
+! the grid is non-uniform and includes one extra guard cell.
+! output: f, scs, scr
+! scs/scr = buffers in y/z given to PPNGUARD32INIT
+! igds = plan number returned by PPNGUARD32INIT, created with ndim*nxv
+! reals per row
+! nyzp(1:2) = number of primary gridpoints in y/z in particle partition
+! ndim = leading dimension of array f
+! nvpy/nvpz = number of real or virtual processors in y/z
+! nx = system length in x direction
+! nxv = second dimension of f, must be >= nx+1
+! nypmx = maximum size of particle partition in y, including guard cells
+! nzpmx = maximum size of particle partition in z, including guard cells
+! idds = dimensionality of domain decomposition
+! linear interpolation, for distributed data
+! with 2D spatial decomposition
+      implicit none
+      integer, intent(in) :: igds, ndim, nvpy, nvpz, nx, nxv
+      integer, intent(in) :: nypmx, nzpmx, idds
+      real, dimension(ndim,nxv,nypmx,nzpmx), intent(inout) :: f
+      real, dimension(ndim,nxv,nzpmx,2), intent(inout) :: scs
+      real, dimension(ndim,nxv,nypmx,2), intent(inout) :: scr
+      integer, dimension(idds), intent(in) :: nyzp
+! mgds = persistent requests for each plan
+! local data
+      integer :: i, j, k, nx1, nyp1, nzp1, ierr
+      nx1 = nx + 1
+      nyp1 = nyzp(1) + 1
+      nzp1 = nyzp(2) + 1
+! special case for one processor in y
+      if (nvpy==1) then
+         do k = 1, nzp1
+            do j = 1, nx1
+               do i = 1, ndim
+                  f(i,j,1,k) = f(i,j,1,k) + f(i,j,nyp1,k)
+                  f(i,j,nyp1,k) = 0.0
+               enddo
+            enddo
+         enddo
+      else
+! buffer data in y
+         do k = 1, nzp1
+            do j = 1, nxv
+               do i = 1, ndim
+                  scs(i,j,k,1) = f(i,j,nyp1,k)
+               enddo
+            enddo
+         enddo
+! add guard cells in y
+         call MPI_STARTALL(2,mgds(5:6,igds),ierr)
+         call MPI_WAITALL(2,mgds(5:6,igds),MPI_STATUSES_IGNORE,ierr)
+! add up the guard cells
+         do k = 1, nzp1
+            do j = 1, nx1
+               do i = 1, ndim
+                  f(i,j,1,k) = f(i,j,1,k) + scs(i,j,k,2)
+                  f(i,j,nyp1,k) = 0.0
+               enddo
+            enddo
+         enddo
+      endif
+! special case for one processor in z
+      if (nvpz==1) then
+         do k = 1, nyp1
+            do j = 1, nx1
+               do i = 1, ndim
+                  f(i,j,k,1) = f(i,j,k,1) + f(i,j,k,nzp1)
+                  f(i,j,k,nzp1) = 0.0
+               enddo
+            enddo
+         enddo
+         return
+      endif
+! buffer data in z
+      do k = 1, nyp1
+         do j = 1, nxv
+            do i = 1, ndim
+               scr(i,j,k,1) = f(i,j,k,nzp1)
+            enddo
+         enddo
+      enddo
+! add guard cells in z
+      call MPI_STARTALL(2,mgds(7:8,igds),ierr)
+      call MPI_WAITALL(2,mgds(7:8,igds),MPI_STATUSES_IGNORE,ierr)
+! add up the guard cells
+      do k = 1, nyp1
+         do j = 1, nx1
+            do i = 1, ndim
+               f(i,j,k,1) = f(i,j,k,1) + scr(i,j,k,2)
+               f(i,j,k,nzp1) = 0.0
+            enddo
+         enddo
+      enddo
+      end subroutine
+!
+!-----------------------------------------------------------------------
+      subroutine PPNGUARD32FREE(igds)
+! this subroutine frees persistent requests created by PPNGUARD32INIT
+! igds = plan number, set to 0 on output
+      implicit none
+      integer, intent(inout) :: igds
+! ngds = number of guard cell exchange plans created so far
+! mgds = persistent requests for each plan
+! local data
+      integer :: n, ierr
+      if ((igds < 1).or.(igds > ngds)) return
+      do n = 1, 8
+         if (mgds(n,igds) /= MPI_REQUEST_NULL) then
+            call MPI_REQUEST_FREE(mgds(n,igds),ierr)
+         endif
+      enddo
+! release plan number if it was the last one created
+      if (igds==ngds) ngds = ngds - 1
+      igds = 0
+      end subroutine
+!
 !-----------------------------------------------------------------------
       subroutine PPTPOS3A(f,g,s,t,nx,ny,nz,kxyp,kyp,kzp,kstrt,nvpy,nxv, &
      &nyv,kxypd,kypd,kzpd)
@@ -1040,6 +1437,180 @@
       enddo
       end subroutine
 !
+!-----------------------------------------------------------------------
+      subroutine PPNTPOS3BS(g,h,s,t,mreq,nx,ny,nz,kxyp,kyzp,kzp,kstrt,  &
+     &nvpy,nvpz,ndim,nyv,nzv,kxypd,kyzpd,kzpd,jxi,jxp)
+! this subroutine starts a transpose of a block of x indices of a matrix
+! g, distributed in x and z to a matrix h, distributed in x and y, that
+! is, h(1:ndim,l+kzp*(n-1),j,k) = g(1:ndim,k+kyzp*(m-1),j,l), where
+! jxi <= j < jxi+jxp, 1 <= k <= kyzp, 1 <= l <= kzp, and
+! 1 <= m <= ny/kyzp, 1 <= n <= nz/kzp
+! and where indices n and m can be distributed across processors.
+! this subroutine posts all receives, sends all messages asynchronously
+! and copies the local block.  PPNTPOS3BW must be called with the same
+! block to complete the transpose.  several blocks can be in progress at
+! once, so that work on one block, such as an fft in z, can overlap with
+! the communication of the others.
+! g = complex input array
+! h = complex output array
+! s, t = complex scratch arrays, of size ndim*kyzp*kxyp*kzp*nvpz
+! the block starting at jxi uses the part starting at
+! ndim*kyzp*kzp*nvpz*(jxi-1)
+! mreq = receive/send requests for this block
+! nx/ny/nz = number of points in x/y/z
+! kxyp/kyzp/kzp = number of data values per block in x/y/z
+! kstrt = starting data block number
+! nvpy/nvpz = number of real or virtual processors in y/z
+! ndim = leading dimension of arrays g and h
+! nyv/nzv = first dimension of g/h
+! kxypd = second dimension of g and h
+! kzpd/kyzpd = third dimension of g/h
+! jxi = initial x index in block
+! jxp = number of x indices in block
+      implicit none
+      integer, intent(in) :: nx, ny, nz, kxyp, kyzp, kzp, kstrt, nvpy
+      integer, intent(in) :: nvpz, ndim, nyv, nzv, kxypd, kyzpd, kzpd
+      integer, intent(in) :: jxi, jxp
+      complex, dimension(ndim,nyv,kxypd,kzpd), intent(in) :: g
+      complex, dimension(ndim,nzv,kxypd,kyzpd), intent(inout) :: h
+      complex, dimension(ndim,kyzp*kxyp*kzp*nvpz), intent(inout) :: s, t
+      integer, dimension(2*nvpz), intent(inout) :: mreq
+! lgrp = current communicator
+! mcplx = default datatype for complex
+! local data
+      integer :: i, n, j, k, l, js, ks, kyzps, kzps, id, joff, koff
+      integer :: loff, moff, ld, jd, kyzxp, ierr
+! js/ks = processor co-ordinates in x/z => idproc = js + nvpy*ks
+      ks = (kstrt - 1)/nvpy
+      js = kstrt - nvpy*ks - 1
+      kyzps = min(kyzp,max(0,ny-kyzp*ks))
+      kzps = min(kzp,max(0,nz-kzp*ks))
+      joff = jxi - 1
+! special case for one processor
+      if (nvpz==1) then
+         do l = 1, kzp
+            do j = 1, jxp
+               do k = 1, kyzp
+                  do i = 1, ndim
+                     h(i,l,j+joff,k) = g(i,k,j+joff,l)
+                  enddo
+               enddo
+            enddo
+         enddo
+         mreq = MPI_REQUEST_NULL
+         return
+      endif
+! kyzxp = size of each message in this block, moff = start of block
+      kyzxp = kyzp*kzp*jxp
+      moff = kyzp*kzp*nvpz*joff
+! post all receives, data from processor id is stored in message id+1
+      do n = 1, nvpz
+         id = n - 1
+         if (id /= ks) then
+            jd = js + nvpy*id
+            call MPI_IRECV(t(1,moff+kyzxp*id+1),ndim*kyzxp,mcplx,jd,jxi,&
+     &lgrp,mreq(n),ierr)
+         else
+            mreq(n) = MPI_REQUEST_NULL
+         endif
+      enddo
+      mreq(nvpz+ks+1) = MPI_REQUEST_NULL
+! extract and send data, data to processor id is stored in message id+1
+      do n = 1, nvpz
+         id = n - ks - 1
+         if (id < 0) id = id + nvpz
+         if (id==ks) cycle
+         koff = kyzp*id
+         ld = min(kyzp,max(0,ny-koff))
+         loff = moff + kyzxp*id
+         do l = 1, kzps
+            do j = 1, jxp
+               do k = 1, ld
+                  do i = 1, ndim
+                     s(i,k+ld*(j+jxp*(l-1)-1)+loff) = g(i,k+koff,j+joff,&
+     &l)
+                  enddo
+               enddo
+            enddo
+         enddo
+         jd = js + nvpy*id
+         ld = ndim*ld*jxp*kzps
+         call MPI_ISEND(s(1,loff+1),ld,mcplx,jd,jxi,lgrp,mreq(nvpz+id+1)&
+     &,ierr)
+      enddo
+! copy local block while messages are in flight
+      koff = kyzp*ks
+      loff = kzp*ks
+      do l = 1, kzps
+         do j = 1, jxp
+            do k = 1, kyzps
+               do i = 1, ndim
+                  h(i,l+loff,j+joff,k) = g(i,k+koff,j+joff,l)
+               enddo
+            enddo
+         enddo
+      enddo
+      end subroutine
+!
+!-----------------------------------------------------------------------
+      subroutine PPNTPOS3BW(h,t,mreq,nx,ny,nz,kxyp,kyzp,kzp,kstrt,nvpy, &
+     &nvpz,ndim,nzv,kxypd,kyzpd,jxi,jxp)
+! this subroutine completes a transpose of a block of x indices started
+! by PPNTPOS3BS, inserting data into h in the order it arrives.
+! h = complex output array
+! t = complex scratch array given to PPNTPOS3BS
+! mreq = receive/send requests for this block from PPNTPOS3BS
+! nx/ny/nz = number of points in x/y/z
+! kxyp/kyzp/kzp = number of data values per block in x/y/z
+! kstrt = starting data block number
+! nvpy/nvpz = number of real or virtual processors in y/z
+! ndim = leading dimension of array h
+! nzv = first dimension of h
+! kxypd = second dimension of h
+! kyzpd = third dimension of h
+! jxi = initial x index in block
+! jxp = number of x indices in block
+      implicit none
+      integer, intent(in) :: nx, ny, nz, kxyp, kyzp, kzp, kstrt, nvpy
+      integer, intent(in) :: nvpz, ndim, nzv, kxypd, kyzpd, jxi, jxp
+      complex, dimension(ndim,nzv,kxypd,kyzpd), intent(inout) :: h
+      complex, dimension(ndim,kyzp*kxyp*kzp*nvpz), intent(inout) :: t
+      integer, dimension(2*nvpz), intent(inout) :: mreq
+! local data
+      integer :: i, n, j, k, l, ks, kyzps, id, joff, koff, loff, moff
+      integer :: ld, kyzxp, ierr
+      integer, dimension(lstat) :: istatus
+! special case for one processor
+      if (nvpz==1) return
+! ks = processor co-ordinate in z
+      ks = (kstrt - 1)/nvpy
+      kyzps = min(kyzp,max(0,ny-kyzp*ks))
+      joff = jxi - 1
+      kyzxp = kyzp*kzp*jxp
+      moff = kyzp*kzp*nvpz*joff
+! insert data as it arrives
+      do n = 2, nvpz
+         call MPI_WAITANY(nvpz,mreq,id,istatus,ierr)
+         if (id==MPI_UNDEFINED) exit
+         id = id - 1
+         loff = kzp*id
+         ld = min(kzp,max(0,nz-loff))
+         koff = moff + kyzxp*id
+         do l = 1, ld
+            do j = 1, jxp
+               do k = 1, kyzps
+                  do i = 1, ndim
+                     h(i,l+loff,j+joff,k) = t(i,k+kyzps*(j+jxp*(l-1)-1)+&
+     &koff)
+                  enddo
+               enddo
+            enddo
+         enddo
+      enddo
+! wait for sends to complete
+      call MPI_WAITALL(nvpz,mreq(nvpz+1:2*nvpz),MPI_STATUSES_IGNORE,ierr)
+      end subroutine
+!
 !-----------------------------------------------------------------------
       subroutine PPMOVE32(part,edges,npp,sbufr,sbufl,rbufr,rbufl,ihole, &
      &ny,nz,kstrt,nvpy,nvpz,idimp,npmax,idps,nbmax,ntmax,info)
@@ -1668,6 +2239,68 @@
      &idds)
       end subroutine
 !
+!-----------------------------------------------------------------------
+      subroutine PPNGUARD32INIT(scs,scr,igds,kstrt,nvpy,nvpz,nxv,nypmx, &
+     &nzpmx)
+      use pplib3, only: SUB => PPNGUARD32INIT
+      implicit none
+      integer, intent(in) :: kstrt, nvpy, nvpz, nxv, nypmx, nzpmx
+      integer, intent(inout) :: igds
+      real, dimension(nxv,nzpmx,2), intent(inout) :: scs
+      real, dimension(nxv,nypmx,2), intent(inout) :: scr
+      call SUB(scs,scr,igds,kstrt,nvpy,nvpz,nxv,nypmx,nzpmx)
+      end subroutine
+!
+!-----------------------------------------------------------------------
+      subroutine PPNCGUARD32LP(f,scs,scr,igds,nyzp,nvpy,nvpz,nxv,nypmx, &
+     &nzpmx,idds)
+      use pplib3, only: SUB => PPNCGUARD32LP
+      implicit none
+      integer, intent(in) :: igds, nvpy, nvpz, nxv, nypmx, nzpmx, idds
+      real, dimension(nxv,nypmx,nzpmx), intent(inout) :: f
+      real, dimension(nxv,nzpmx,2), intent(inout) :: scs
+      real, dimension(nxv,nypmx,2), intent(inout) :: scr
+      integer, dimension(idds), intent(in) :: nyzp
+      call SUB(f,scs,scr,igds,nyzp,nvpy,nvpz,nxv,nypmx,nzpmx,idds)
+      end subroutine
+!
+!-----------------------------------------------------------------------
+      subroutine PPNAGUARD32LP(f,scs,scr,igds,nyzp,nvpy,nvpz,nx,nxv,    &
+     &nypmx,nzpmx,idds)
+      use pplib3, only: SUB => PPNAGUARD32LP
+      implicit none
+      integer, intent(in) :: igds, nvpy, nvpz, nx, nxv, nypmx, nzpmx
+      integer, intent(in) :: idds
+      real, dimension(nxv,nypmx,nzpmx), intent(inout) :: f
+      real, dimension(nxv,nzpmx,2), intent(inout) :: scs
+      real, dimension(nxv,nypmx,2), intent(inout) :: scr
+      integer, dimension(idds), intent(in) :: nyzp
+      call SUB(f,scs,scr,igds,nyzp,nvpy,nvpz,nx,nxv,nypmx,nzpmx,idds)
+      end subroutine
+!
+!-----------------------------------------------------------------------
+      subroutine PPNACGUARD32LP(f,scs,scr,igds,nyzp,ndim,nvpy,nvpz,nx,  &
+     &nxv,nypmx,nzpmx,idds)
+      use pplib3, only: SUB => PPNACGUARD32LP
+      implicit none
+      integer, intent(in) :: igds, ndim, nvpy, nvpz, nx, nxv
+      integer, intent(in) :: nypmx, nzpmx, idds
+      real, dimension(ndim,nxv,nypmx,nzpmx), intent(inout) :: f
+      real, dimension(ndim,nxv,nzpmx,2), intent(inout) :: scs
+      real, dimension(ndim,nxv,nypmx,2), intent(inout) :: scr
+      integer, dimension(idds), intent(in) :: nyzp
+      call SUB(f,scs,scr,igds,nyzp,ndim,nvpy,nvpz,nx,nxv,nypmx,nzpmx,   &
+     &idds)
+      end subroutine
+!
+!-----------------------------------------------------------------------
+      subroutine PPNGUARD32FREE(igds)
+      use pplib3, only: SUB => PPNGUARD32FREE
+      implicit none
+      integer, intent(inout) :: igds
+      call SUB(igds)
+      end subroutine
+!
 !-----------------------------------------------------------------------
       subroutine PPTPOS3A(f,g,s,t,nx,ny,nz,kxyp,kyp,kzp,kstrt,nvpy,nxv, &
      &nyv,kxypd,kypd,kzpd)
@@ -1724,6 +2357,36 @@
      &nzv,kxypd,kyzpd,kzpd)
       end subroutine
 !
+!-----------------------------------------------------------------------
+      subroutine PPNTPOS3BS(g,h,s,t,mreq,nx,ny,nz,kxyp,kyzp,kzp,kstrt,  &
+     &nvpy,nvpz,ndim,nyv,nzv,kxypd,kyzpd,kzpd,jxi,jxp)
+      use pplib3, only: SUB => PPNTPOS3BS
+      implicit none
+      integer, intent(in) :: nx, ny, nz, kxyp, kyzp, kzp, kstrt, nvpy
+      integer, intent(in) :: nvpz, ndim, nyv, nzv, kxypd, kyzpd, kzpd
+      integer, intent(in) :: jxi, jxp
+      complex, dimension(ndim,nyv,kxypd,kzpd), intent(in) :: g
+      complex, dimension(ndim,nzv,kxypd,kyzpd), intent(inout) :: h
+      complex, dimension(ndim,kyzp*kxyp*kzp*nvpz), intent(inout) :: s, t
+      integer, dimension(2*nvpz), intent(inout) :: mreq
+      call SUB(g,h,s,t,mreq,nx,ny,nz,kxyp,kyzp,kzp,kstrt,nvpy,nvpz,ndim,&
+     &nyv,nzv,kxypd,kyzpd,kzpd,jxi,jxp)
+      end subroutine
+!
+!-----------------------------------------------------------------------
+      subroutine PPNTPOS3BW(h,t,mreq,nx,ny,nz,kxyp,kyzp,kzp,kstrt,nvpy, &
+     &nvpz,ndim,nzv,kxypd,kyzpd,jxi,jxp)
+      use pplib3, only: SUB => PPNTPOS3BW
+      implicit none
+      integer, intent(in) :: nx, ny, nz, kxyp, kyzp, kzp, kstrt, nvpy
+      integer, intent(in) :: nvpz, ndim, nzv, kxypd, kyzpd, jxi, jxp
+      complex, dimension(ndim,nzv,kxypd,kyzpd), intent(inout) :: h
+      complex, dimension(ndim,kyzp*kxyp*kzp*nvpz), intent(inout) :: t
+      integer, dimension(2*nvpz), intent(inout) :: mreq
+      call SUB(h,t,mreq,nx,ny,nz,kxyp,kyzp,kzp,kstrt,nvpy,nvpz,ndim,nzv,&
+     &kxypd,kyzpd,jxi,jxp)
+      end subroutine
+!
 !-----------------------------------------------------------------------
       subroutine PPMOVE32(part,edges,npp,sbufr,sbufl,rbufr,rbufl,ihole, &
      &ny,nz,kstrt,nvpy,nvpz,idimp,npmax,idps,nbmax,ntmax,info)
@@ -28,6 +28,24 @@ void cppnacguard32l(float f[], float scs[], float scr[], int nyzp[],
                     int ndim, int kstrt, int nvpy, int nvpz, int nx,
                     int nxv, int nypmx, int nzpmx, int idds);
 
+void cppnguard32init(float scs[], float scr[], int *igds, int kstrt,
+                     int nvpy, int nvpz, int nxv, int nypmx,
+                     int nzpmx);
+
+void cppncguard32lp(float f[], float scs[], float scr[], int igds,
+                    int nyzp[], int nvpy, int nvpz, int nxv, int nypmx,
+                    int nzpmx, int idds);
+
+void cppnaguard32lp(float f[], float scs[], float scr[], int igds,
+                    int nyzp[], int nvpy, int nvpz, int nx, int nxv,
+                    int nypmx, int nzpmx, int idds);
+
+void cppnacguard32lp(float f[], float scs[], float scr[], int igds,
+                     int nyzp[], int ndim, int nvpy, int nvpz, int nx,
+                     int nxv, int nypmx, int nzpmx, int idds);
+
+void cppnguard32free(int *igds);
+
 void cpptpos3a(float complex f[], float complex g[], float complex s[], 
                float complex t[], int nx, int ny, int nz, int kxyp,
                int kyp, int kzp, int kstrt, int nvpy, int nxv, int nyv,
@@ -49,6 +67,17 @@ void cppntpos3b(float complex g[], float complex h[], float complex s[],
                 int ndim, int nyv, int nzv, int kxypd, int kyzpd,
                 int kzpd);
 
+void cppntpos3bs(float complex g[], float complex h[], float complex s[],
+                 float complex t[], int mreq[], int nx, int ny, int nz,
+                 int kxyp, int kyzp, int kzp, int kstrt, int nvpy,
+                 int nvpz, int ndim, int nyv, int nzv, int kxypd,
+                 int kyzpd, int kzpd, int jxi, int jxp);
+
+void cppntpos3bw(float complex h[], float complex t[], int mreq[],
+                 int nx, int ny, int nz, int kxyp, int kyzp, int kzp,
+                 int kstrt, int nvpy, int nvpz, int ndim, int nzv,
+                 int kxypd, int kyzpd, int jxi, int jxp);
+
 void cppmove32(float part[], float edges[], int *npp, float sbufr[],
                float sbufl[], float rbufr[], float rbufl[], int ihole[], 
                int ny, int nz, int kstrt, int nvpy, int nvpz, int idimp,
@@ -58,3 +87,26 @@ void cppmoveg32(float part[], float edges[], int *npp, float sbufr[],
                float sbufl[], float rbufr[], float rbufl[], int ihole[], 
                int ny, int nz, int kstrt, int nvpy, int nvpz, int idimp,
                int npmax, int idps, int nbmax, int ntmax, int info[]);
+
+void cppwchkpth3(char *fname, int nis, int isc[], int nfs, float fsc[],
+                 int *irc);
+
+void cppwchkpta3(float f[], int nyzp[], int noff[], int nxv, int ny,
+                 int nz, int nypmx, int nzpmx, int idds);
+
+void cppwchkptp3(float part[], float edges[], int npp, int idimp,
+                 int npmax, int idps);
+
+void cppwchkptc3(int *irc);
+
+void cpprchkpth3(char *fname, int nis, int isc[], int nfs, float fsc[],
+                 int *nvpo, int *irc);
+
+void cpprchkpta3(int n, float f[], int nyzp[], int noff[], int nxv,
+                 int ny, int nz, int nypmx, int nzpmx, int idds,
+                 int *irc);
+
+void cpprchkptp3(int n, float part[], float edges[], int *npp,
+                 int idimp, int npmax, int idps, int *irc);
+
+void cpprchkptc3();
@@ -1,6 +1,8 @@
 /* Basic parallel PIC library for MPI communications */
 /* Wrappers for calling the Fortran routines from a C main program */
 
+#include <stddef.h>
+#include <string.h>
 #include <complex.h>
 
 void ppinit2_(int *idproc, int *nvp);
@@ -32,6 +34,25 @@ void ppnacguard32l_(float *f, float *scs, float *scr, int *nyzp,
                     int *nx, int *nxv, int *nypmx, int *nzpmx,
                     int *idds);
 
+void ppnguard32init_(float *scs, float *scr, int *igds, int *kstrt,
+                     int *nvpy, int *nvpz, int *nxv, int *nypmx,
+                     int *nzpmx);
+
+void ppncguard32lp_(float *f, float *scs, float *scr, int *igds,
+                    int *nyzp, int *nvpy, int *nvpz, int *nxv,
+                    int *nypmx, int *nzpmx, int *idds);
+
+void ppnaguard32lp_(float *f, float *scs, float *scr, int *igds,
+                    int *nyzp, int *nvpy, int *nvpz, int *nx, int *nxv,
+                    int *nypmx, int *nzpmx, int *idds);
+
+void ppnacguard32lp_(float *f, float *scs, float *scr, int *igds,
+                     int *nyzp, int *ndim, int *nvpy, int *nvpz,
+                     int *nx, int *nxv, int *nypmx, int *nzpmx,
+                     int *idds);
+
+void ppnguard32free_(int *igds);
+
 void pptpos3a_(float complex *f, float complex *g, float complex *s, 
                float complex *t, int *nx, int *ny, int *nz, int *kxyp,
                int *kyp, int *kzp, int *kstrt, int *nvpy, int *nxv,
@@ -53,6 +74,17 @@ void ppntpos3b_(float complex *g, float complex *h, float complex *s,
                 int *ndim, int *nyv, int *nzv, int *kxypd, int *kyzpd,
                 int *kzpd);
 
+void ppntpos3bs_(float complex *g, float complex *h, float complex *s,
+                 float complex *t, int *mreq, int *nx, int *ny, int *nz,
+                 int *kxyp, int *kyzp, int *kzp, int *kstrt, int *nvpy,
+                 int *nvpz, int *ndim, int *nyv, int *nzv, int *kxypd,
+                 int *kyzpd, int *kzpd, int *jxi, int *jxp);
+
+void ppntpos3bw_(float complex *h, float complex *t, int *mreq, int *nx,
+                 int *ny, int *nz, int *kxyp, int *kyzp, int *kzp,
+                 int *kstrt, int *nvpy, int *nvpz, int *ndim, int *nzv,
+                 int *kxypd, int *kyzpd, int *jxi, int *jxp);
+
 void ppmove32_(float *part, float *edges, int *npp, float *sbufr,
                float *sbufl, float *rbufr, float *rbufl, int *ihole, 
                int *ny, int *nz, int *kstrt, int *nvpy, int *nvpz,
@@ -65,6 +97,30 @@ void ppmoveg32_(float *part, float *edges, int *npp, float *sbufr,
                 int *idimp, int *npmax, int *idps, int *nbmax,
                 int *ntmax, int *info);
 
+/* character arguments are followed by a hidden length argument */
+void ppwchkpth3_(char *fname, int *nis, int *isc, int *nfs, float *fsc,
+                 int *irc, size_t lfname);
+
+void ppwchkpta3_(float *f, int *nyzp, int *noff, int *nxv, int *ny,
+                 int *nz, int *nypmx, int *nzpmx, int *idds);
+
+void ppwchkptp3_(float *part, float *edges, int *npp, int *idimp,
+                 int *npmax, int *idps);
+
+void ppwchkptc3_(int *irc);
+
+void pprchkpth3_(char *fname, int *nis, int *isc, int *nfs, float *fsc,
+                 int *nvpo, int *irc, size_t lfname);
+
+void pprchkpta3_(int *n, float *f, int *nyzp, int *noff, int *nxv,
+                 int *ny, int *nz, int *nypmx, int *nzpmx, int *idds,
+                 int *irc);
+
+void pprchkptp3_(int *n, float *part, float *edges, int *npp, int *idimp,
+                 int *npmax, int *idps, int *irc);
+
+void pprchkptc3_();
+
 /* Interfaces to C */
 
 /*--------------------------------------------------------------------*/
@@ -140,6 +196,47 @@ void cppnacguard32l(float f[], float scs[], float scr[], int nyzp[],
    return;
 }
 
+/*--------------------------------------------------------------------*/
+void cppnguard32init(float scs[], float scr[], int *igds, int kstrt,
+                     int nvpy, int nvpz, int nxv, int nypmx,
+                     int nzpmx) {
+   ppnguard32init_(scs,scr,igds,&kstrt,&nvpy,&nvpz,&nxv,&nypmx,&nzpmx);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppncguard32lp(float f[], float scs[], float scr[], int igds,
+                    int nyzp[], int nvpy, int nvpz, int nxv, int nypmx,
+                    int nzpmx, int idds) {
+   ppncguard32lp_(f,scs,scr,&igds,nyzp,&nvpy,&nvpz,&nxv,&nypmx,&nzpmx,
+                  &idds);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppnaguard32lp(float f[], float scs[], float scr[], int igds,
+                    int nyzp[], int nvpy, int nvpz, int nx, int nxv,
+                    int nypmx, int nzpmx, int idds) {
+   ppnaguard32lp_(f,scs,scr,&igds,nyzp,&nvpy,&nvpz,&nx,&nxv,&nypmx,
+                  &nzpmx,&idds);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppnacguard32lp(float f[], float scs[], float scr[], int igds,
+                     int nyzp[], int ndim, int nvpy, int nvpz, int nx,
+                     int nxv, int nypmx, int nzpmx, int idds) {
+   ppnacguard32lp_(f,scs,scr,&igds,nyzp,&ndim,&nvpy,&nvpz,&nx,&nxv,
+                   &nypmx,&nzpmx,&idds);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppnguard32free(int *igds) {
+   ppnguard32free_(igds);
+   return;
+}
+
 /*--------------------------------------------------------------------*/
 void cpptpos3a(float complex f[], float complex g[], float complex s[], 
                float complex t[], int nx, int ny, int nz, int kxyp,
@@ -181,6 +278,27 @@ void cppntpos3b(float complex g[], float complex h[], float complex s[],
    return;
 }
 
+/*--------------------------------------------------------------------*/
+void cppntpos3bs(float complex g[], float complex h[], float complex s[],
+                 float complex t[], int mreq[], int nx, int ny, int nz,
+                 int kxyp, int kyzp, int kzp, int kstrt, int nvpy,
+                 int nvpz, int ndim, int nyv, int nzv, int kxypd,
+                 int kyzpd, int kzpd, int jxi, int jxp) {
+   ppntpos3bs_(g,h,s,t,mreq,&nx,&ny,&nz,&kxyp,&kyzp,&kzp,&kstrt,&nvpy,
+               &nvpz,&ndim,&nyv,&nzv,&kxypd,&kyzpd,&kzpd,&jxi,&jxp);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppntpos3bw(float complex h[], float complex t[], int mreq[],
+                 int nx, int ny, int nz, int kxyp, int kyzp, int kzp,
+                 int kstrt, int nvpy, int nvpz, int ndim, int nzv,
+                 int kxypd, int kyzpd, int jxi, int jxp) {
+   ppntpos3bw_(h,t,mreq,&nx,&ny,&nz,&kxyp,&kyzp,&kzp,&kstrt,&nvpy,&nvpz,
+               &ndim,&nzv,&kxypd,&kyzpd,&jxi,&jxp);
+   return;
+}
+
 /*--------------------------------------------------------------------*/
 void cppmove32(float part[], float edges[], int *npp, float sbufr[],
                float sbufl[], float rbufr[], float rbufl[], int ihole[], 
@@ -201,3 +319,58 @@ void cppmoveg32(float part[], float edges[], int *npp, float sbufr[],
               info);
    return;
 }
+
+/*--------------------------------------------------------------------*/
+void cppwchkpth3(char *fname, int nis, int isc[], int nfs, float fsc[],
+                 int *irc) {
+   ppwchkpth3_(fname,&nis,isc,&nfs,fsc,irc,strlen(fname));
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppwchkpta3(float f[], int nyzp[], int noff[], int nxv, int ny,
+                 int nz, int nypmx, int nzpmx, int idds) {
+   ppwchkpta3_(f,nyzp,noff,&nxv,&ny,&nz,&nypmx,&nzpmx,&idds);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppwchkptp3(float part[], float edges[], int npp, int idimp,
+                 int npmax, int idps) {
+   ppwchkptp3_(part,edges,&npp,&idimp,&npmax,&idps);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppwchkptc3(int *irc) {
+   ppwchkptc3_(irc);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cpprchkpth3(char *fname, int nis, int isc[], int nfs, float fsc[],
+                 int *nvpo, int *irc) {
+   pprchkpth3_(fname,&nis,isc,&nfs,fsc,nvpo,irc,strlen(fname));
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cpprchkpta3(int n, float f[], int nyzp[], int noff[], int nxv,
+                 int ny, int nz, int nypmx, int nzpmx, int idds,
+                 int *irc) {
+   pprchkpta3_(&n,f,nyzp,noff,&nxv,&ny,&nz,&nypmx,&nzpmx,&idds,irc);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cpprchkptp3(int n, float part[], float edges[], int *npp,
+                 int idimp, int npmax, int idps, int *irc) {
+   pprchkptp3_(&n,part,edges,npp,&idimp,&npmax,&idps,irc);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cpprchkptc3() {
+   pprchkptc3_();
+   return;
+}
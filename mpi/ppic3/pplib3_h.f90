@@ -100,6 +100,62 @@
          integer, dimension(idds), intent(in) :: nyzp
          end subroutine
       end interface
+!
+      interface
+         subroutine PPNGUARD32INIT(scs,scr,igds,kstrt,nvpy,nvpz,nxv,    &
+     &nypmx,nzpmx)
+         implicit none
+         integer, intent(in) :: kstrt, nvpy, nvpz, nxv, nypmx, nzpmx
+         integer, intent(inout) :: igds
+         real, dimension(nxv,nzpmx,2), intent(inout) :: scs
+         real, dimension(nxv,nypmx,2), intent(inout) :: scr
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPNCGUARD32LP(f,scs,scr,igds,nyzp,nvpy,nvpz,nxv,    &
+     &nypmx,nzpmx,idds)
+         implicit none
+         integer, intent(in) :: igds, nvpy, nvpz, nxv, nypmx, nzpmx, idds
+         real, dimension(nxv,nypmx,nzpmx), intent(inout) :: f
+         real, dimension(nxv,nzpmx,2), intent(inout) :: scs
+         real, dimension(nxv,nypmx,2), intent(inout) :: scr
+         integer, dimension(idds), intent(in) :: nyzp
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPNAGUARD32LP(f,scs,scr,igds,nyzp,nvpy,nvpz,nx,     &
+     &nxv,nypmx,nzpmx,idds)
+         implicit none
+         integer, intent(in) :: igds, nvpy, nvpz, nx, nxv, nypmx, nzpmx
+         integer, intent(in) :: idds
+         real, dimension(nxv,nypmx,nzpmx), intent(inout) :: f
+         real, dimension(nxv,nzpmx,2), intent(inout) :: scs
+         real, dimension(nxv,nypmx,2), intent(inout) :: scr
+         integer, dimension(idds), intent(in) :: nyzp
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPNACGUARD32LP(f,scs,scr,igds,nyzp,ndim,nvpy,nvpz,  &
+     &nx,nxv,nypmx,nzpmx,idds)
+         implicit none
+         integer, intent(in) :: igds, ndim, nvpy, nvpz, nx, nxv
+         integer, intent(in) :: nypmx, nzpmx, idds
+         real, dimension(ndim,nxv,nypmx,nzpmx), intent(inout) :: f
+         real, dimension(ndim,nxv,nzpmx,2), intent(inout) :: scs
+         real, dimension(ndim,nxv,nypmx,2), intent(inout) :: scr
+         integer, dimension(idds), intent(in) :: nyzp
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPNGUARD32FREE(igds)
+         implicit none
+         integer, intent(inout) :: igds
+         end subroutine
+      end interface
 !
       interface
          subroutine PPTPOS3A(f,g,s,t,nx,ny,nz,kxyp,kyp,kzp,kstrt,nvpy,  &
@@ -148,6 +204,34 @@
          complex, dimension(ndim,kyzp*kxyp*kzp), intent(inout) :: s, t
          end subroutine
       end interface
+!
+      interface
+         subroutine PPNTPOS3BS(g,h,s,t,mreq,nx,ny,nz,kxyp,kyzp,kzp,     &
+     &kstrt,nvpy,nvpz,ndim,nyv,nzv,kxypd,kyzpd,kzpd,jxi,jxp)
+         implicit none
+         integer, intent(in) :: nx, ny, nz, kxyp, kyzp, kzp, kstrt, nvpy
+         integer, intent(in) :: nvpz, ndim, nyv, nzv, kxypd, kyzpd, kzpd
+         integer, intent(in) :: jxi, jxp
+         complex, dimension(ndim,nyv,kxypd,kzpd), intent(in) :: g
+         complex, dimension(ndim,nzv,kxypd,kyzpd), intent(inout) :: h
+         complex, dimension(ndim,kyzp*kxyp*kzp*nvpz), intent(inout) ::  &
+     &s, t
+         integer, dimension(2*nvpz), intent(inout) :: mreq
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPNTPOS3BW(h,t,mreq,nx,ny,nz,kxyp,kyzp,kzp,kstrt,   &
+     &nvpy,nvpz,ndim,nzv,kxypd,kyzpd,jxi,jxp)
+         implicit none
+         integer, intent(in) :: nx, ny, nz, kxyp, kyzp, kzp, kstrt, nvpy
+         integer, intent(in) :: nvpz, ndim, nzv, kxypd, kyzpd, jxi, jxp
+         complex, dimension(ndim,nzv,kxypd,kyzpd), intent(inout) :: h
+         complex, dimension(ndim,kyzp*kxyp*kzp*nvpz), intent(inout) ::  &
+     &t
+         integer, dimension(2*nvpz), intent(inout) :: mreq
+         end subroutine
+      end interface
 !
       interface
          subroutine PPMOVE32(part,edges,npp,sbufr,sbufl,rbufr,rbufl,    &
@@ -180,6 +264,81 @@
          integer, dimension(7), intent(inout) :: info
          end subroutine
       end interface
+!
+      interface
+         subroutine PPWCHKPTH3(fname,nis,isc,nfs,fsc,irc)
+         implicit none
+         integer, intent(in) :: nis, nfs
+         integer, intent(inout) :: irc
+         character(len=*), intent(in) :: fname
+         integer, dimension(nis), intent(in) :: isc
+         real, dimension(nfs), intent(in) :: fsc
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPWCHKPTA3(f,nyzp,noff,nxv,ny,nz,nypmx,nzpmx,idds)
+         implicit none
+         integer, intent(in) :: nxv, ny, nz, nypmx, nzpmx, idds
+         real, dimension(nxv,nypmx,nzpmx), intent(in) :: f
+         integer, dimension(idds), intent(in) :: nyzp, noff
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPWCHKPTP3(part,edges,npp,idimp,npmax,idps)
+         implicit none
+         integer, intent(in) :: npp, idimp, npmax, idps
+         real, dimension(idimp,npmax), intent(in) :: part
+         real, dimension(idps), intent(in) :: edges
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPWCHKPTC3(irc)
+         implicit none
+         integer, intent(inout) :: irc
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPRCHKPTH3(fname,nis,isc,nfs,fsc,nvpo,irc)
+         implicit none
+         integer, intent(in) :: nis, nfs
+         integer, intent(inout) :: nvpo, irc
+         character(len=*), intent(in) :: fname
+         integer, dimension(nis), intent(inout) :: isc
+         real, dimension(nfs), intent(inout) :: fsc
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPRCHKPTA3(n,f,nyzp,noff,nxv,ny,nz,nypmx,nzpmx, &
+     &idds,irc)
+         implicit none
+         integer, intent(in) :: n, nxv, ny, nz, nypmx, nzpmx, idds
+         integer, intent(inout) :: irc
+         real, dimension(nxv,nypmx,nzpmx), intent(inout) :: f
+         integer, dimension(idds), intent(in) :: nyzp, noff
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPRCHKPTP3(n,part,edges,npp,idimp,npmax,idps,irc&
+     &)
+         implicit none
+         integer, intent(in) :: n, idimp, npmax, idps
+         integer, intent(inout) :: npp, irc
+         real, dimension(idimp,npmax), intent(inout) :: part
+         real, dimension(idps), intent(in) :: edges
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPRCHKPTC3()
+         implicit none
+         end subroutine
+      end interface
 !
       end module
 
@@ -996,24 +996,26 @@ c sine/cosine table for the angles 2*n*pi/nxyz
       return
       end
 c-----------------------------------------------------------------------
-      subroutine WPPFFT32R(f,g,h,bs,br,isign,ntpose,mixup,sct,ttp,indx, 
-     1indy,indz,kstrt,nvpy,nvpz,nxvh,nyv,nzv,kxyp,kyp,kyzp,kzp,kxypd,   
-     2kypd,kyzpd,kzpd,kzyp,nxhyzd,nxyzhd)
+      subroutine WPPFFT32R(f,g,h,bs,br,isign,ntpose,ltpose,mixup,sct,  
+     1ttp,indx,indy,indz,kstrt,nvpy,nvpz,nxvh,nyv,nzv,kxyp,kyp,kyzp,kzp,
+     2kxypd,kypd,kyzpd,kzpd,kzyp,nxhyzd,nxyzhd)
 c wrapper function for 3d real to complex fft, with packed data
 c parallelized with MPI
       implicit none
-      integer isign, ntpose, indx, indy, indz, kstrt, nvpy, nvpz
+      integer isign, ntpose, ltpose, indx, indy, indz, kstrt, nvpy, nvpz
       integer nxvh, nyv, nzv, kxyp, kyp, kyzp, kzp
       integer kxypd, kypd, kyzpd, kzpd, kzyp, nxhyzd, nxyzhd
-      integer mixup
+      integer mixup, mreq
       real ttp
       complex f, g, h, bs, br, sct
       dimension f(nxvh,kypd,kzpd), g(nyv,kxypd,kzpd), h(nzv,kxypd,kyzpd)
       dimension bs(kxyp*kzyp,kzp), br(kxyp*kzyp,kzp)
       dimension mixup(nxhyzd), sct(nxyzhd)
+      dimension mreq(2*nvpz,max(1,ltpose))
 c local data
       integer nxh, ny, nz, kypi, kxypi, js, ks, kxypp, kypp, kzpp, nvp
-      real tp, tf
+      integer n, kxb, nxb, jxi, jxp
+      real tp, tf, tw
       double precision dtime
       data kypi, kxypi /1,1/
 c calculate range of indices
@@ -1027,6 +1029,10 @@ c js/ks = processor co-ordinates in y/z => idproc = js + nvpy*ks
       kypp = min(kyp,max(0,ny-kyp*js))
       kzpp = min(kzp,max(0,nz-kzp*ks))
       nvp = nvpy*nvpz
+c kxb/nxb = size/number of blocks in x for pipelined transpose
+      kxb = (kxypp - 1)/max(1,ltpose) + 1
+      nxb = 0
+      if (kxypp.gt.0) nxb = (kxypp - 1)/kxb + 1
 c inverse fourier transform
       if (isign.lt.0) then
 c perform x fft
@@ -1041,13 +1047,38 @@ c perform y fft
          call PPFFT32RXY(g,isign,mixup,sct,indx,indy,indz,kstrt,nvpy,   
      1nvpz,kxypi,kxypp,nyv,kzpp,kxypd,kzpd,nxhyzd,nxyzhd)
 c transpose g array to h
-         call PWTIMERA(-1,tp,dtime)
-         call PPTPOS3B(g,h,bs,br,nxh,ny,nz,kxyp,kyzp,kzp,kstrt,nvpy,nvpz
-     1,nyv,nzv,kxypd,kyzpd,kzpd)
-         call PWTIMERA(1,tp,dtime)
+         if (ltpose.eq.0) then
+            call PWTIMERA(-1,tp,dtime)
+            call PPTPOS3B(g,h,bs,br,nxh,ny,nz,kxyp,kyzp,kzp,kstrt,nvpy, 
+     1nvpz,nyv,nzv,kxypd,kyzpd,kzpd)
+            call PWTIMERA(1,tp,dtime)
 c perform z fft
-         call PPFFT32RXZ(h,isign,mixup,sct,indx,indy,indz,kstrt,nvpy,   
+            call PPFFT32RXZ(h,isign,mixup,sct,indx,indy,indz,kstrt,nvpy,
      1nvpz,kxypi,kxypp,nzv,kyzp,kxypd,kyzpd,nxhyzd,nxyzhd)
+c transpose g array to h in blocks of x, so that the z fft of each
+c block overlaps with the communication of the blocks which follow
+         else
+            call PWTIMERA(-1,tp,dtime)
+            do 10 n = 1, nxb
+            jxi = kxb*(n - 1) + 1
+            jxp = min(kxb,kxypp-jxi+1)
+            call PPNTPOS3BS(g,h,bs,br,mreq(1,n),nxh,ny,nz,kxyp,kyzp,
+     1kzp,kstrt,nvpy,nvpz,1,nyv,nzv,kxypd,kyzpd,kzpd,jxi,jxp)
+   10       continue
+            call PWTIMERA(1,tp,dtime)
+            do 20 n = 1, nxb
+            jxi = kxb*(n - 1) + 1
+            jxp = min(kxb,kxypp-jxi+1)
+            call PWTIMERA(-1,tw,dtime)
+            call PPNTPOS3BW(h,br,mreq(1,n),nxh,ny,nz,kxyp,kyzp,kzp,
+     1kstrt,nvpy,nvpz,1,nzv,kxypd,kyzpd,jxi,jxp)
+            call PWTIMERA(1,tw,dtime)
+            tp = tp + tw
+c perform z fft on block
+            call PPFFT32RXZ(h,isign,mixup,sct,indx,indy,indz,kstrt,
+     1nvpy,nvpz,jxi,jxp,nzv,kyzp,kxypd,kyzpd,nxhyzd,nxyzhd)
+   20       continue
+         endif
 c transpose h array to f
          if (ntpose.eq.0) then
             call PWTIMERA(-1,tf,dtime)
@@ -1069,13 +1100,41 @@ c transpose f array to h
             call PWTIMERA(1,tf,dtime)
          endif
 c perform z fft
-         call PPFFT32RXZ(h,isign,mixup,sct,indx,indy,indz,kstrt,nvpy,   
+         if (ltpose.eq.0) then
+            call PPFFT32RXZ(h,isign,mixup,sct,indx,indy,indz,kstrt,nvpy,
      1nvpz,kxypi,kxypp,nzv,kyzp,kxypd,kyzpd,nxhyzd,nxyzhd)
 c transpose h array to g
-         call PWTIMERA(-1,tp,dtime)
-         call PPTPOS3B(h,g,br,bs,nxh,nz,ny,kxyp,kzp,kyzp,kstrt,nvpy,nvpz
-     1,nzv,nyv,kxypd,kzpd,kyzpd)
-         call PWTIMERA(1,tp,dtime)
+            call PWTIMERA(-1,tp,dtime)
+            call PPTPOS3B(h,g,br,bs,nxh,nz,ny,kxyp,kzp,kyzp,kstrt,nvpy, 
+     1nvpz,nzv,nyv,kxypd,kzpd,kyzpd)
+            call PWTIMERA(1,tp,dtime)
+c perform z fft in blocks of x, so that the transpose of each block
+c to g overlaps with the z fft of the blocks which follow
+         else
+            tp = 0.0
+            do 30 n = 1, nxb
+            jxi = kxb*(n - 1) + 1
+            jxp = min(kxb,kxypp-jxi+1)
+c perform z fft on block
+            call PPFFT32RXZ(h,isign,mixup,sct,indx,indy,indz,kstrt,
+     1nvpy,nvpz,jxi,jxp,nzv,kyzp,kxypd,kyzpd,nxhyzd,nxyzhd)
+c transpose block of h array to g
+            call PWTIMERA(-1,tw,dtime)
+            call PPNTPOS3BS(h,g,br,bs,mreq(1,n),nxh,nz,ny,kxyp,kzp,
+     1kyzp,kstrt,nvpy,nvpz,1,nzv,nyv,kxypd,kzpd,kyzpd,jxi,jxp)
+            call PWTIMERA(1,tw,dtime)
+            tp = tp + tw
+   30       continue
+            call PWTIMERA(-1,tw,dtime)
+            do 40 n = 1, nxb
+            jxi = kxb*(n - 1) + 1
+            jxp = min(kxb,kxypp-jxi+1)
+            call PPNTPOS3BW(g,bs,mreq(1,n),nxh,nz,ny,kxyp,kzp,kyzp,
+     1kstrt,nvpy,nvpz,1,nyv,kxypd,kzpd,jxi,jxp)
+   40       continue
+            call PWTIMERA(1,tw,dtime)
+            tp = tp + tw
+         endif
 c perform y fft
          call PPFFT32RXY(g,isign,mixup,sct,indx,indy,indz,kstrt,nvpy,   
      1nvpz,kxypi,kxypp,nyv,kzpp,kxypd,kzpd,nxhyzd,nxyzhd)
@@ -1093,25 +1152,27 @@ c perform x fft
       return
       end
 c-----------------------------------------------------------------------
-      subroutine WPPFFT32R3(f,g,h,bs,br,isign,ntpose,mixup,sct,ttp,indx,
-     1indy,indz,kstrt,nvpy,nvpz,nxvh,nyv,nzv,kxyp,kyp,kyzp,kzp,kxypd,   
-     2kypd,kyzpd,kzpd,kzyp,nxhyzd,nxyzhd)
+      subroutine WPPFFT32R3(f,g,h,bs,br,isign,ntpose,ltpose,mixup,sct, 
+     1ttp,indx,indy,indz,kstrt,nvpy,nvpz,nxvh,nyv,nzv,kxyp,kyp,kyzp,kzp,
+     2kxypd,kypd,kyzpd,kzpd,kzyp,nxhyzd,nxyzhd)
 c wrapper function for 3 3d real to complex ffts, with packed data
 c parallelized with MPI
       implicit none
-      integer isign, ntpose, indx, indy, indz, kstrt, nvpy, nvpz
+      integer isign, ntpose, ltpose, indx, indy, indz, kstrt, nvpy, nvpz
       integer nxvh, nyv, nzv, kxyp, kyp, kyzp, kzp
       integer kxypd, kypd, kyzpd, kzpd, kzyp, nxhyzd, nxyzhd
-      integer mixup
+      integer mixup, mreq
       real ttp
       complex f, g, h, bs, br, sct
       dimension f(3,nxvh,kypd,kzpd), g(3,nyv,kxypd,kzpd)
       dimension h(3,nzv,kxypd,kyzpd)
       dimension bs(3,kxyp*kzyp,kzp), br(3,kxyp*kzyp,kzp)
       dimension mixup(nxhyzd), sct(nxyzhd)
+      dimension mreq(2*nvpz,max(1,ltpose))
 c local data
       integer nxh, ny, nz, kypi, kxypi, js, ks, kxypp, kypp, kzpp, nvp
-      real tp, tf
+      integer n, kxb, nxb, jxi, jxp
+      real tp, tf, tw
       double precision dtime
       data kypi, kxypi /1,1/
 c calculate range of indices
@@ -1125,6 +1186,10 @@ c js/ks = processor co-ordinates in y/z => idproc = js + nvpy*ks
       kypp = min(kyp,max(0,ny-kyp*js))
       kzpp = min(kzp,max(0,nz-kzp*ks))
       nvp = nvpy*nvpz
+c kxb/nxb = size/number of blocks in x for pipelined transpose
+      kxb = (kxypp - 1)/max(1,ltpose) + 1
+      nxb = 0
+      if (kxypp.gt.0) nxb = (kxypp - 1)/kxb + 1
 c inverse fourier transform
       if (isign.lt.0) then
 c perform x fft
@@ -1139,13 +1204,38 @@ c perform y fft
          call PPFFT32R3XY(g,isign,mixup,sct,indx,indy,indz,kstrt,nvpy,  
      1nvpz,kxypi,kxypp,nyv,kzpp,kxypd,kzpd,nxhyzd,nxyzhd)
 c transpose g array to h
-         call PWTIMERA(-1,tp,dtime)
-         call PPNTPOS3B(g,h,bs,br,nxh,ny,nz,kxyp,kyzp,kzp,kstrt,nvpy,   
+         if (ltpose.eq.0) then
+            call PWTIMERA(-1,tp,dtime)
+            call PPNTPOS3B(g,h,bs,br,nxh,ny,nz,kxyp,kyzp,kzp,kstrt,nvpy,
      1nvpz,3,nyv,nzv,kxypd,kyzpd,kzpd)
-         call PWTIMERA(1,tp,dtime)
+            call PWTIMERA(1,tp,dtime)
 c perform z fft
-         call PPFFT32R3XZ(h,isign,mixup,sct,indx,indy,indz,kstrt,nvpy,  
-     1nvpz,kxypi,kxypp,nzv,kyzp,kxypd,kyzpd,nxhyzd,nxyzhd)
+            call PPFFT32R3XZ(h,isign,mixup,sct,indx,indy,indz,kstrt,    
+     1nvpy,nvpz,kxypi,kxypp,nzv,kyzp,kxypd,kyzpd,nxhyzd,nxyzhd)
+c transpose g array to h in blocks of x, so that the z fft of each
+c block overlaps with the communication of the blocks which follow
+         else
+            call PWTIMERA(-1,tp,dtime)
+            do 10 n = 1, nxb
+            jxi = kxb*(n - 1) + 1
+            jxp = min(kxb,kxypp-jxi+1)
+            call PPNTPOS3BS(g,h,bs,br,mreq(1,n),nxh,ny,nz,kxyp,kyzp,
+     1kzp,kstrt,nvpy,nvpz,3,nyv,nzv,kxypd,kyzpd,kzpd,jxi,jxp)
+   10       continue
+            call PWTIMERA(1,tp,dtime)
+            do 20 n = 1, nxb
+            jxi = kxb*(n - 1) + 1
+            jxp = min(kxb,kxypp-jxi+1)
+            call PWTIMERA(-1,tw,dtime)
+            call PPNTPOS3BW(h,br,mreq(1,n),nxh,ny,nz,kxyp,kyzp,kzp,
+     1kstrt,nvpy,nvpz,3,nzv,kxypd,kyzpd,jxi,jxp)
+            call PWTIMERA(1,tw,dtime)
+            tp = tp + tw
+c perform z fft on block
+            call PPFFT32R3XZ(h,isign,mixup,sct,indx,indy,indz,kstrt,
+     1nvpy,nvpz,jxi,jxp,nzv,kyzp,kxypd,kyzpd,nxhyzd,nxyzhd)
+   20       continue
+         endif
 c transpose h array to f
          if (ntpose.eq.0) then
             call PWTIMERA(-1,tf,dtime)
@@ -1167,13 +1257,41 @@ c transpose f array to h
             call PWTIMERA(1,tf,dtime)
          endif
 c perform z fft
-         call PPFFT32R3XZ(h,isign,mixup,sct,indx,indy,indz,kstrt,nvpy,  
-     1nvpz,kxypi,kxypp,nzv,kyzp,kxypd,kyzpd,nxhyzd,nxyzhd)
+         if (ltpose.eq.0) then
+            call PPFFT32R3XZ(h,isign,mixup,sct,indx,indy,indz,kstrt,    
+     1nvpy,nvpz,kxypi,kxypp,nzv,kyzp,kxypd,kyzpd,nxhyzd,nxyzhd)
 c transpose h array to g
-         call PWTIMERA(-1,tp,dtime)
-         call PPNTPOS3B(h,g,br,bs,nxh,nz,ny,kxyp,kzp,kyzp,kstrt,nvpy,   
+            call PWTIMERA(-1,tp,dtime)
+            call PPNTPOS3B(h,g,br,bs,nxh,nz,ny,kxyp,kzp,kyzp,kstrt,nvpy,
      1nvpz,3,nzv,nyv,kxypd,kzpd,kyzpd)
-         call PWTIMERA(1,tp,dtime)
+            call PWTIMERA(1,tp,dtime)
+c perform z fft in blocks of x, so that the transpose of each block
+c to g overlaps with the z fft of the blocks which follow
+         else
+            tp = 0.0
+            do 30 n = 1, nxb
+            jxi = kxb*(n - 1) + 1
+            jxp = min(kxb,kxypp-jxi+1)
+c perform z fft on block
+            call PPFFT32R3XZ(h,isign,mixup,sct,indx,indy,indz,kstrt,
+     1nvpy,nvpz,jxi,jxp,nzv,kyzp,kxypd,kyzpd,nxhyzd,nxyzhd)
+c transpose block of h array to g
+            call PWTIMERA(-1,tw,dtime)
+            call PPNTPOS3BS(h,g,br,bs,mreq(1,n),nxh,nz,ny,kxyp,kzp,
+     1kyzp,kstrt,nvpy,nvpz,3,nzv,nyv,kxypd,kzpd,kyzpd,jxi,jxp)
+            call PWTIMERA(1,tw,dtime)
+            tp = tp + tw
+   30       continue
+            call PWTIMERA(-1,tw,dtime)
+            do 40 n = 1, nxb
+            jxi = kxb*(n - 1) + 1
+            jxp = min(kxb,kxypp-jxi+1)
+            call PPNTPOS3BW(g,bs,mreq(1,n),nxh,nz,ny,kxyp,kzp,kyzp,
+     1kstrt,nvpy,nvpz,3,nyv,kxypd,kzpd,jxi,jxp)
+   40       continue
+            call PWTIMERA(1,tw,dtime)
+            tp = tp + tw
+         endif
 c perform y fft
          call PPFFT32R3XY(g,isign,mixup,sct,indx,indy,indz,kstrt,nvpy,  
      1nvpz,kxypi,kxypp,nyv,kzpp,kxypd,kzpd,nxhyzd,nxyzhd)
@@ -82,18 +82,18 @@ void cppfft32r3xz(float complex h[], int isign, int mixup[],
 
 void cwppfft32r(float complex f[], float complex g[], float complex h[],
                 float complex bs[], float complex br[], int isign,
-                int ntpose, int mixup[], float complex sct[],
-                float *ttp, int indx, int indy, int indz, int kstrt,
-                int nvpy, int nvpz, int nxvh, int nyv, int nzv,
-                int kxyp, int kyp, int kyzp, int kzp, int kxypd,
-                int kypd, int kyzpd, int kzpd, int kzyp, int nxhyzd,
-                int nxyzhd);
+                int ntpose, int ltpose, int mixup[],
+                float complex sct[], float *ttp, int indx, int indy,
+                int indz, int kstrt, int nvpy, int nvpz, int nxvh,
+                int nyv, int nzv, int kxyp, int kyp, int kyzp, int kzp,
+                int kxypd, int kypd, int kyzpd, int kzpd, int kzyp,
+                int nxhyzd, int nxyzhd);
 
 void cwppfft32r3(float complex f[], float complex g[],
                  float complex h[], float complex bs[],
-                 float complex br[], int isign, int ntpose, int mixup[],
-                 float complex sct[], float *ttp, int indx, int indy,
-                 int indz, int kstrt, int nvpy, int nvpz, int nxvh,
-                 int nyv, int nzv, int kxyp, int kyp, int kyzp, int kzp,
-                 int kxypd, int kypd, int kyzpd, int kzpd, int kzyp,
-                 int nxhyzd, int nxyzhd);
+                 float complex br[], int isign, int ntpose, int ltpose,
+                 int mixup[], float complex sct[], float *ttp, int indx,
+                 int indy, int indz, int kstrt, int nvpy, int nvpz,
+                 int nxvh, int nyv, int nzv, int kxyp, int kyp,
+                 int kyzp, int kzp, int kxypd, int kypd, int kyzpd,
+                 int kzpd, int kzyp, int nxhyzd, int nxyzhd);
@@ -86,21 +86,21 @@ void ppfft32r3xz_(float complex *h, int *isign, int *mixup,
 
 void wppfft32r_(float complex *f, float complex *g, float complex *h,
                 float complex *bs, float complex *br, int *isign,
-                int *ntpose, int *mixup, float complex *sct,
-                float *ttp, int *indx, int *indy, int *indz, int *kstrt,
-                int *nvpy, int *nvpz, int *nxvh, int *nyv, int *nzv,
-                int *kxyp, int *kyp, int *kyzp, int *kzp, int *kxypd,
-                int *kypd, int *kyzpd, int *kzpd, int *kzyp,
-                int *nxhyzd, int *nxyzhd);
+                int *ntpose, int *ltpose, int *mixup,
+                float complex *sct, float *ttp, int *indx, int *indy,
+                int *indz, int *kstrt, int *nvpy, int *nvpz, int *nxvh,
+                int *nyv, int *nzv, int *kxyp, int *kyp, int *kyzp,
+                int *kzp, int *kxypd, int *kypd, int *kyzpd, int *kzpd,
+                int *kzyp, int *nxhyzd, int *nxyzhd);
 
 void wppfft32r3_(float complex *f, float complex *g, float complex *h,
                  float complex *bs, float complex *br, int *isign,
-                 int *ntpose, int *mixup, float complex *sct,
-                 float *ttp, int *indx, int *indy, int *indz,
-                 int *kstrt, int *nvpy, int *nvpz, int *nxvh, int *nyv,
-                 int *nzv, int *kxyp, int *kyp, int *kyzp, int *kzp,
-                 int *kxypd, int *kypd, int *kyzpd, int *kzpd,
-                 int *kzyp, int *nxhyzd, int *nxyzhd);
+                 int *ntpose, int *ltpose, int *mixup,
+                 float complex *sct, float *ttp, int *indx, int *indy,
+                 int *indz, int *kstrt, int *nvpy, int *nvpz,
+                 int *nxvh, int *nyv, int *nzv, int *kxyp, int *kyp,
+                 int *kyzp, int *kzp, int *kxypd, int *kypd, int *kyzpd,
+                 int *kzpd, int *kzyp, int *nxhyzd, int *nxyzhd);
 
 /* Interfaces to C */
 
@@ -264,30 +264,31 @@ void cppfft32r3xz(float complex h[], int isign, int mixup[],
 /*--------------------------------------------------------------------*/
 void cwppfft32r(float complex f[], float complex g[], float complex h[],
                 float complex bs[], float complex br[], int isign,
-                int ntpose, int mixup[], float complex sct[],
-                float *ttp, int indx, int indy, int indz, int kstrt,
-                int nvpy, int nvpz, int nxvh, int nyv, int nzv,
-                int kxyp, int kyp, int kyzp, int kzp, int kxypd,
-                int kypd, int kyzpd, int kzpd, int kzyp, int nxhyzd,
-                int nxyzhd) {
-   wppfft32r_(f,g,h,bs,br,&isign,&ntpose,mixup,sct,ttp,&indx,&indy,
-              &indz,&kstrt,&nvpy,&nvpz,&nxvh,&nyv,&nzv,&kxyp,&kyp,&kyzp,
-              &kzp,&kxypd,&kypd,&kyzpd,&kzpd,&kzyp,&nxhyzd,&nxyzhd);
+                int ntpose, int ltpose, int mixup[],
+                float complex sct[], float *ttp, int indx, int indy,
+                int indz, int kstrt, int nvpy, int nvpz, int nxvh,
+                int nyv, int nzv, int kxyp, int kyp, int kyzp, int kzp,
+                int kxypd, int kypd, int kyzpd, int kzpd, int kzyp,
+                int nxhyzd, int nxyzhd) {
+   wppfft32r_(f,g,h,bs,br,&isign,&ntpose,&ltpose,mixup,sct,ttp,&indx,
+              &indy,&indz,&kstrt,&nvpy,&nvpz,&nxvh,&nyv,&nzv,&kxyp,&kyp,
+              &kyzp,&kzp,&kxypd,&kypd,&kyzpd,&kzpd,&kzyp,&nxhyzd,
+              &nxyzhd);
    return;
 }
 
 /*--------------------------------------------------------------------*/
 void cwppfft32r3(float complex f[], float complex g[],
                  float complex h[], float complex bs[],
-                 float complex br[], int isign, int ntpose, int mixup[],
-                 float complex sct[], float *ttp, int indx, int indy,
-                 int indz, int kstrt, int nvpy, int nvpz, int nxvh,
-                 int nyv, int nzv, int kxyp, int kyp, int kyzp, int kzp,
-                 int kxypd, int kypd, int kyzpd, int kzpd, int kzyp,
-                 int nxhyzd, int nxyzhd) {
-   wppfft32r3_(f,g,h,bs,br,&isign,&ntpose,mixup,sct,ttp,&indx,&indy,
-               &indz,&kstrt,&nvpy,&nvpz,&nxvh,&nyv,&nzv,&kxyp,&kyp,
-               &kyzp,&kzp,&kxypd,&kypd,&kyzpd,&kzpd,&kzyp,&nxhyzd,
+                 float complex br[], int isign, int ntpose, int ltpose,
+                 int mixup[], float complex sct[], float *ttp, int indx,
+                 int indy, int indz, int kstrt, int nvpy, int nvpz,
+                 int nxvh, int nyv, int nzv, int kxyp, int kyp,
+                 int kyzp, int kzp, int kxypd, int kypd, int kyzpd,
+                 int kzpd, int kzyp, int nxhyzd, int nxyzhd) {
+   wppfft32r3_(f,g,h,bs,br,&isign,&ntpose,&ltpose,mixup,sct,ttp,&indx,
+               &indy,&indz,&kstrt,&nvpy,&nvpz,&nxvh,&nyv,&nzv,&kxyp,
+               &kyp,&kyzp,&kzp,&kxypd,&kypd,&kyzpd,&kzpd,&kzyp,&nxhyzd,
                &nxyzhd);
    return;
 }
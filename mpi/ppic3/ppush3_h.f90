@@ -118,11 +118,12 @@
       end interface
 !
       interface
-         subroutine WPPFFT32R(f,g,h,bs,br,isign,ntpose,mixup,sct,ttp,   &
-     &indx,indy,indz,kstrt,nvpy,nvpz,nxvh,nyv,nzv,kxyp,kyp,kyzp,kzp,    &
-     &kxypd,kypd,kyzpd,kzpd,kzyp,nxhyzd,nxyzhd)
+         subroutine WPPFFT32R(f,g,h,bs,br,isign,ntpose,ltpose,mixup,    &
+     &sct,ttp,indx,indy,indz,kstrt,nvpy,nvpz,nxvh,nyv,nzv,kxyp,kyp,kyzp,&
+     &kzp,kxypd,kypd,kyzpd,kzpd,kzyp,nxhyzd,nxyzhd)
          implicit none
-         integer, intent(in) :: isign, ntpose, indx, indy, indz, kstrt
+         integer, intent(in) :: isign, ntpose, ltpose, indx, indy
+         integer, intent(in) :: indz, kstrt
          integer, intent(in) :: nvpy, nvpz, nxvh, nyv, nzv, kxyp, kyp
          integer, intent(in) :: kyzp, kzp, kxypd, kypd, kyzpd, kzpd
          integer, intent(in) :: kzyp, nxhyzd, nxyzhd
@@ -137,11 +138,12 @@
       end interface
 !
       interface
-         subroutine WPPFFT32R3(f,g,h,bs,br,isign,ntpose,mixup,sct,ttp,  &
-     &indx,indy,indz,kstrt,nvpy,nvpz,nxvh,nyv,nzv,kxyp,kyp,kyzp,kzp,    &
-     &kxypd,kypd,kyzpd,kzpd,kzyp,nxhyzd,nxyzhd)
+         subroutine WPPFFT32R3(f,g,h,bs,br,isign,ntpose,ltpose,mixup,   &
+     &sct,ttp,indx,indy,indz,kstrt,nvpy,nvpz,nxvh,nyv,nzv,kxyp,kyp,kyzp,&
+     &kzp,kxypd,kypd,kyzpd,kzpd,kzyp,nxhyzd,nxyzhd)
          implicit none
-         integer, intent(in) :: isign, ntpose, indx, indy, indz, kstrt
+         integer, intent(in) :: isign, ntpose, ltpose, indx, indy
+         integer, intent(in) :: indz, kstrt
          integer, intent(in) :: nvpy, nvpz, nxvh, nyv, nzv, kxyp, kyp
          integer, intent(in) :: kyzp, kzp, kxypd, kypd, kyzpd, kzpd
          integer, intent(in) :: kzyp, nxhyzd, nxyzhd
@@ -0,0 +1,156 @@
+/*---------------------------------------------------------------------*/
+/* Benchmark for 3D Electromagnetic OpenMP current deposit, which      */
+/* compares updating tile edges with atomic operations (cgjppost3l,    */
+/* cgrjppost3l) and with a halo buffer (cgjppost3lh, cgrjppost3lh),    */
+/* for several tile sizes                                              */
+#include <stdlib.h>
+#include <stdio.h>
+#include <complex.h>
+#include <math.h>
+#include <sys/time.h>
+#include "mbpush3.h"
+#include "omplib.h"
+
+void dtimer(double *time, struct timeval *itime, int icntrl);
+
+int main(int argc, char *argv[]) {
+/* indx/indy/indz = exponent which determines grid points in x/y/z: */
+/* direction: nx = 2**indx, ny = 2**indy, nz = 2**indz */
+   int indx =   7, indy =   7, indz =   7;
+/* npx/npy/npz = number of electrons distributed in x/y/z direction */
+   int npx =  384, npy =   384, npz =   384;
+/* qme = charge on electron, in units of e */
+/* dt = time interval between successive calculations, set to zero */
+/* so that particle positions are not changed by the deposit */
+   float qme = -1.0, dt = 0.0;
+/* vtx/vty/vtz = thermal velocity of electrons in x/y/z direction */
+   float vtx = 1.0, vty = 1.0, vtz = 1.0;
+/* vx0/vy0/vz0 = drift velocity of electrons in x/y/z direction */
+   float vx0 = 0.0, vy0 = 0.0, vz0 = 0.0;
+/* ci = reciprocal of velocity of light */
+   float ci = 0.1;
+/* idimp = number of particle coordinates = 6 */
+/* ipbc = particle boundary condition: 1 = periodic */
+/* relativity = (no,yes) = (0,1) = relativity is used */
+   int idimp = 6, ipbc = 1, relativity = 1;
+/* ntile = number of tile sizes tested, mxs = tile sizes */
+   int ntile = 3;
+   int mxs[3] = {4,8,16};
+/* nrep = number of times each deposit is repeated */
+   int nrep = 5;
+/* xtras = fraction of extra particles needed for particle management */
+   float xtras = 0.2;
+/* declare scalars for standard code */
+   int i, j, l;
+   int np, nx, ny, nz, nxe, nye, nze, mx, my, mz, mx1, my1, mz1, mxyz1;
+   int nxyze;
+   float cmax, dmax;
+/* declare scalars for OpenMP code */
+   int nppmx, nppmx0, irc;
+   int nvp;
+/* part = original particle array */
+   float *part = NULL;
+/* cua/cub = current density from atomic/halo buffer deposits */
+   float *cua = NULL, *cub = NULL;
+/* ppart = tiled particle array, cuh = current density on tile edges */
+   float *ppart = NULL, *cuh = NULL;
+/* kpic = number of particles in each tile */
+   int *kpic = NULL;
+/* declare and initialize timing data */
+   float ta, tb;
+   struct timeval itime;
+   double dtime;
+
+   irc = 0;
+/* nvp = number of shared memory nodes  (0=default) */
+   nvp = 0;
+/* initialize for shared memory parallel processing */
+   cinit_omp(nvp);
+
+/* initialize scalars for standard code */
+   np = npx*npy*npz; nx = 1L<<indx; ny = 1L<<indy; nz = 1L<<indz;
+   nxe = nx + 1; nye = ny + 1; nze = nz + 1;
+   nxyze = 3*nxe*nye*nze;
+   part = (float *) malloc(idimp*np*sizeof(float));
+   cua = (float *) malloc(nxyze*sizeof(float));
+   cub = (float *) malloc(nxyze*sizeof(float));
+/* initialize electrons */
+   cdistr3(part,vtx,vty,vtz,vx0,vy0,vz0,npx,npy,npz,idimp,np,nx,ny,nz,
+           ipbc);
+
+   printf("tile   atomic (nsec)   halo (nsec)   max rel. difference\n");
+/* loop over tile sizes */
+   for (l = 0; l < ntile; l++) {
+      mx = mxs[l]; my = mxs[l]; mz = mxs[l];
+      mx1 = (nx - 1)/mx + 1; my1 = (ny - 1)/my + 1;
+      mz1 = (nz - 1)/mz + 1; mxyz1 = mx1*my1*mz1;
+      kpic = (int *) malloc(mxyz1*sizeof(int));
+      cuh = (float *) malloc(3*(2*(mx+1)*(my+1)+2*(mz-1)*(mx+my))*mxyz1
+                             *sizeof(float));
+/* find number of particles in each of mx, my, mz tiles: */
+/* updates kpic, nppmx */
+      cdblkp3l(part,kpic,&nppmx,idimp,np,mx,my,mz,mx1,my1,mxyz1,&irc);
+      if (irc != 0) {
+         printf("cdblkp3l error, irc=%d\n",irc);
+         exit(1);
+      }
+      nppmx0 = (1.0 + xtras)*nppmx;
+      ppart = (float *) malloc(idimp*nppmx0*mxyz1*sizeof(float));
+/* copy ordered particle data for OpenMP: updates ppart and kpic */
+      cppmovin3l(part,ppart,kpic,nppmx0,idimp,np,mx,my,mz,mx1,my1,
+                 mxyz1,&irc);
+      if (irc != 0) {
+         printf("cppmovin3l overflow error, irc=%d\n",irc);
+         exit(1);
+      }
+/* deposit with atomic updates of tile edges */
+      ta = 0.0;
+      for (i = 0; i < nrep; i++) {
+         for (j = 0; j < nxyze; j++) {
+            cua[j] = 0.0;
+         }
+         dtimer(&dtime,&itime,-1);
+         if (relativity==1)
+            cgrjppost3l(ppart,cua,kpic,qme,dt,ci,nppmx0,idimp,nx,ny,nz,
+                        mx,my,mz,nxe,nye,nze,mx1,my1,mxyz1,ipbc);
+         else
+            cgjppost3l(ppart,cua,kpic,qme,dt,nppmx0,idimp,nx,ny,nz,mx,
+                       my,mz,nxe,nye,nze,mx1,my1,mxyz1,ipbc);
+         dtimer(&dtime,&itime,1);
+         ta += (float) dtime;
+      }
+/* deposit with halo buffer for tile edges */
+      tb = 0.0;
+      for (i = 0; i < nrep; i++) {
+         for (j = 0; j < nxyze; j++) {
+            cub[j] = 0.0;
+         }
+         dtimer(&dtime,&itime,-1);
+         if (relativity==1)
+            cgrjppost3lh(ppart,cub,cuh,kpic,qme,dt,ci,nppmx0,idimp,nx,
+                         ny,nz,mx,my,mz,nxe,nye,nze,mx1,my1,mxyz1,ipbc);
+         else
+            cgjppost3lh(ppart,cub,cuh,kpic,qme,dt,nppmx0,idimp,nx,ny,
+                        nz,mx,my,mz,nxe,nye,nze,mx1,my1,mxyz1,ipbc);
+         dtimer(&dtime,&itime,1);
+         tb += (float) dtime;
+      }
+/* compare results */
+      cmax = 0.0; dmax = 0.0;
+      for (j = 0; j < nxyze; j++) {
+         cmax = fabsf(cua[j]) > cmax ? fabsf(cua[j]) : cmax;
+         dmax = fabsf(cua[j]-cub[j]) > dmax ? fabsf(cua[j]-cub[j])
+                                            : dmax;
+      }
+      if (cmax > 0.0)
+         dmax = dmax/cmax;
+      ta = 1.0e+09*ta/((float) nrep*(float) np);
+      tb = 1.0e+09*tb/((float) nrep*(float) np);
+      printf("%4d   %13.6f   %11.6f   %e\n",mx,ta,tb,dmax);
+      free(ppart);
+      free(cuh);
+      free(kpic);
+   }
+
+   return 0;
+}
@@ -0,0 +1,16 @@
+/* header file for chkpt3.c */
+
+void cwchkptw3(int *irc);
+
+void cwchkpt3(char *fname, int nis, int isc[], int nfs, float fsc[],
+              int narr, void *arr[], long nbytes[], int *irc);
+
+void crchkpth3(char *fname, int nis, int isc[], int nfs, float fsc[],
+               int *irc);
+
+void crchkpta3(int n, void *arr, long nbytes, int *irc);
+
+void crchkptp3(int n, float ppart[], int kpic[], int idimp, int nppmx,
+               int mxyz1, int *irc);
+
+void crchkptc3();
@@ -7,6 +7,7 @@
 #include <sys/time.h>
 #include "mbpush3.h"
 #include "omplib.h"
+#include "chkpt3.h"
 
 void dtimer(double *time, struct timeval *itime, int icntrl);
 
@@ -40,6 +41,14 @@ int main(int argc, char *argv[]) {
    int mx = 8, my = 8, mz = 8;
 /* xtras = fraction of extra particles needed for particle management */
    float xtras = 0.2;
+/* ldep = (0,1) = update tile edges in current deposit with (atomic */
+/* operations, halo buffer) */
+   int ldep = 0;
+/* nchkpt = number of time steps between checkpoints, 0 = none */
+   int nchkpt = 0;
+/* lrestart = (0,1) = (no,yes) restart from checkpoint file fchkpt */
+   int lrestart = 0;
+   char fchkpt[] = "chkpt3.dat";
 /* declare scalars for standard code */
    int j;
    int np, nx, ny, nz, nxh, nyh, nzh, nxe, nye, nze, nxeh;
@@ -74,12 +83,22 @@ int main(int argc, char *argv[]) {
 /* ncl = number of particles departing tile in each direction */
 /* ihole = location/destination of each particle departing tile */
    int *kpic = NULL, *ncl = NULL, *ihole = NULL;
+/* cuh = current density on tile edges, used if ldep = 1 */
+   float *cuh = NULL;
+
+/* declare checkpoint data */
+/* isc/fsc = integer/real scalars in checkpoint */
+   int isc[12];
+   float fsc[5];
+/* carr = arrays in checkpoint, nbytes = their sizes in bytes */
+   void *carr[4];
+   long nbytes[4];
 
 /* declare and initialize timing data */
    float time;
    struct timeval itime;
    float tdpost = 0.0, tguard = 0.0, tfft = 0.0, tfield = 0.0;
-   float tdjpost = 0.0, tpush = 0.0, tsort = 0.0;
+   float tdjpost = 0.0, tpush = 0.0, tsort = 0.0, tchkpt = 0.0;
    double dtime;
 
    irc = 0;
@@ -127,31 +146,72 @@ int main(int argc, char *argv[]) {
    isign = 0;
    cmpois33((float complex *)qe,(float complex *)fxyze,isign,ffc,ax,ay,
             az,affp,&we,nx,ny,nz,nxeh,nye,nze,nxh,nyh,nzh);
+/* restart: read scalars from checkpoint file: updates isc, fsc */
+   if (lrestart==1) {
+      crchkpth3(fchkpt,12,isc,5,fsc,&irc);
+      if (irc != 0) {
+         printf("crchkpth3 error: irc=%d\n",irc);
+         exit(1);
+      }
+/* with relativity = 1, ppart in the file holds momenta, not velocities */
+      if ((isc[4] != np) || (isc[5] != nx) || (isc[6] != ny)
+         || (isc[7] != nz) || (isc[8] != mx) || (isc[9] != my)
+         || (isc[10] != mz) || (isc[11] != relativity)) {
+         printf("checkpoint does not match: np,nx,ny,nz,mx,my,mz,\
+relativity=%d,%d,%d,%d,%d,%d,%d,%d\n",isc[4],isc[5],isc[6],isc[7],
+                isc[8],isc[9],isc[10],isc[11]);
+         exit(1);
+      }
+      ntime = isc[0]; nppmx0 = isc[1]; npbmx = isc[2]; ntmax = isc[3];
+      we = fsc[0]; wf = fsc[1]; wm = fsc[2]; wke = fsc[3];
+      dth = fsc[4];
+   }
+   else {
 /* initialize electrons */
-   cdistr3(part,vtx,vty,vtz,vx0,vy0,vz0,npx,npy,npz,idimp,np,nx,ny,nz,
-           ipbc);
-
+      cdistr3(part,vtx,vty,vtz,vx0,vy0,vz0,npx,npy,npz,idimp,np,nx,ny,
+              nz,ipbc);
 /* find number of particles in each of mx, my, mz tiles: */
 /* updates kpic, nppmx */
-   cdblkp3l(part,kpic,&nppmx,idimp,np,mx,my,mz,mx1,my1,mxyz1,&irc);
-   if (irc != 0) { 
-      printf("cdblkp3l error, irc=%d\n",irc);
-      exit(1);
+      cdblkp3l(part,kpic,&nppmx,idimp,np,mx,my,mz,mx1,my1,mxyz1,&irc);
+      if (irc != 0) { 
+         printf("cdblkp3l error, irc=%d\n",irc);
+         exit(1);
+      }
+      nppmx0 = (1.0 + xtras)*nppmx;
+      ntmax = xtras*nppmx;
+      npbmx = xtras*nppmx;
    }
 /* allocate vector particle data */
-   nppmx0 = (1.0 + xtras)*nppmx;
-   ntmax = xtras*nppmx;
-   npbmx = xtras*nppmx;
    ppart = (float *) malloc(idimp*nppmx0*mxyz1*sizeof(float));
    ppbuff = (float *) malloc(idimp*npbmx*mxyz1*sizeof(float));
    ncl = (int *) malloc(26*mxyz1*sizeof(int));
    ihole = (int *) malloc(2*(ntmax+1)*mxyz1*sizeof(int));
+   cuh = (float *) malloc(3*(2*(mx+1)*(my+1)+2*(mz-1)*(mx+my))*mxyz1
+                          *sizeof(float));
+/* restart: copy tiled particles and fields from checkpoint file: */
+/* updates kpic, ppart, exyz, bxyz                                */
+   if (lrestart==1) {
+      crchkpta3(0,kpic,sizeof(int)*mxyz1,&irc);
+      if (irc==0)
+         crchkptp3(1,ppart,kpic,idimp,nppmx0,mxyz1,&irc);
+      if (irc==0)
+         crchkpta3(2,exyz,sizeof(float complex)*ndim*nxeh*nye*nze,&irc);
+      if (irc==0)
+         crchkpta3(3,bxyz,sizeof(float complex)*ndim*nxeh*nye*nze,&irc);
+      crchkptc3();
+      if (irc != 0) {
+         printf("crchkpt3 error: irc=%d\n",irc);
+         exit(1);
+      }
+   }
 /* copy ordered particle data for OpenMP: updates ppart and kpic */
-   cppmovin3l(part,ppart,kpic,nppmx0,idimp,np,mx,my,mz,mx1,my1,mxyz1,
-              &irc);
-   if (irc != 0) { 
-      printf("cppmovin3l overflow error, irc=%d\n",irc);
-      exit(1);
+   else {
+      cppmovin3l(part,ppart,kpic,nppmx0,idimp,np,mx,my,mz,mx1,my1,
+                 mxyz1,&irc);
+      if (irc != 0) { 
+         printf("cppmovin3l overflow error, irc=%d\n",irc);
+         exit(1);
+      }
    }
 /* sanity check */
    cppcheck3l(ppart,kpic,idimp,nppmx0,nx,ny,nz,mx,my,mz,mx1,my1,mz1,
@@ -162,9 +222,11 @@ int main(int argc, char *argv[]) {
    }
 
 /* initialize transverse electromagnetic fields */
-   for (j = 0; j < ndim*nxeh*nye*nze; j++) {
-      exyz[j] = 0.0 + 0.0*_Complex_I;
-      bxyz[j] = 0.0 + 0.0*_Complex_I;
+   if (lrestart==0) {
+      for (j = 0; j < ndim*nxeh*nye*nze; j++) {
+         exyz[j] = 0.0 + 0.0*_Complex_I;
+         bxyz[j] = 0.0 + 0.0*_Complex_I;
+      }
    }
 
    if (dt > 0.37*ci) {
@@ -182,7 +244,16 @@ L500: if (nloop <= ntime)
       for (j = 0; j < ndim*nxe*nye*nze; j++) {
          cue[j] = 0.0;
       }
-      if (relativity==1)
+/* halo buffer for tile edges: updates ppart, cue */
+      if (ldep==1) {
+         if (relativity==1)
+            cgrjppost3lh(ppart,cue,cuh,kpic,qme,dth,ci,nppmx0,idimp,nx,
+                         ny,nz,mx,my,mz,nxe,nye,nze,mx1,my1,mxyz1,ipbc);
+         else
+            cgjppost3lh(ppart,cue,cuh,kpic,qme,dth,nppmx0,idimp,nx,ny,
+                        nz,mx,my,mz,nxe,nye,nze,mx1,my1,mxyz1,ipbc);
+      }
+      else if (relativity==1)
 /* updates ppart, cue */
 /*       cgrjppost3l(ppart,cue,kpic,qme,dth,ci,nppmx0,idimp,nx,ny,nz, */
 /*                   mx,my,mz,nxe,nye,nze,mx1,my1,mxyz1,ipbc);        */
@@ -214,11 +285,13 @@ L500: if (nloop <= ntime)
 /* reorder particles by tile with OpenMP: */
       dtimer(&dtime,&itime,-1);
 /* updates ppart, ppbuff, kpic, ncl, ihole, and irc */
-/*    cpporder3l(ppart,ppbuff,kpic,ncl,ihole,idimp,nppmx0,nx,ny,nz, */
-/*               mx,my,mz,mx1,my1,mz1,npbmx,ntmax,&irc);            */
+      if (ldep==1)
+         cpporder3l(ppart,ppbuff,kpic,ncl,ihole,idimp,nppmx0,nx,ny,nz,
+                    mx,my,mz,mx1,my1,mz1,npbmx,ntmax,&irc);
 /* updates ppart, ppbuff, kpic, ncl, and irc */
-      cpporderf3l(ppart,ppbuff,kpic,ncl,ihole,idimp,nppmx0,mx1,my1,
-                  mz1,npbmx,ntmax,&irc);
+      else
+         cpporderf3l(ppart,ppbuff,kpic,ncl,ihole,idimp,nppmx0,mx1,my1,
+                     mz1,npbmx,ntmax,&irc);
       dtimer(&dtime,&itime,1);
       time = (float) dtime;
       tsort += time;
@@ -397,11 +470,43 @@ Field Energies:\n");
          printf("%e %e %e\n",we,wf,wm);
       }
       ntime += 1;
+
+/* write checkpoint in the background */
+      if ((nchkpt > 0) && (ntime%nchkpt==0)) {
+         dtimer(&dtime,&itime,-1);
+         isc[0] = ntime; isc[1] = nppmx0; isc[2] = npbmx;
+         isc[3] = ntmax; isc[4] = np; isc[5] = nx; isc[6] = ny;
+         isc[7] = nz; isc[8] = mx; isc[9] = my; isc[10] = mz;
+         isc[11] = relativity;
+         fsc[0] = we; fsc[1] = wf; fsc[2] = wm; fsc[3] = wke;
+         fsc[4] = dth;
+         carr[0] = kpic; nbytes[0] = sizeof(int)*mxyz1;
+         carr[1] = ppart; nbytes[1] = sizeof(float)*idimp*nppmx0*mxyz1;
+         carr[2] = exyz;
+         nbytes[2] = sizeof(float complex)*ndim*nxeh*nye*nze;
+         carr[3] = bxyz;
+         nbytes[3] = sizeof(float complex)*ndim*nxeh*nye*nze;
+         cwchkpt3(fchkpt,12,isc,5,fsc,4,carr,nbytes,&irc);
+         dtimer(&dtime,&itime,1);
+         time = (float) dtime;
+         tchkpt += time;
+         if (irc != 0) {
+            printf("%d,cwchkpt3 error: irc=%d\n",ntime,irc);
+            irc = 0;
+         }
+      }
       goto L500;
 L2000:
 
 /* * * * end main iteration loop * * * */
 
+/* wait for last checkpoint to be written */
+   if (nchkpt > 0) {
+      cwchkptw3(&irc);
+      if (irc != 0)
+         printf("cwchkptw3 error: irc=%d\n",irc);
+   }
+
    printf("ntime, relativity = %i,%i\n",ntime,relativity);
    wt = we + wf + wm;
    printf("Final Total Field, Kinetic and Total Energies:\n");
@@ -420,6 +525,8 @@ Energies:\n");
    printf("fft time = %f\n",tfft);
    printf("push time = %f\n",tpush);
    printf("sort time = %f\n",tsort);
+   if (nchkpt > 0)
+      printf("checkpoint time = %f\n",tchkpt);
    tfield += tguard + tfft;
    printf("total solver time = %f\n",tfield);
    time = tdpost + tpush + tsort;
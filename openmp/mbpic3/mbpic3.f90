@@ -34,6 +34,9 @@
       integer :: mx = 8, my = 8, mz = 8
 ! xtras = fraction of extra particles needed for particle management
       real :: xtras = 0.2
+! ldep = (0,1) = update tile edges in current deposit with (atomic
+! operations, halo buffer)
+      integer :: ldep = 0
 ! declare scalars for standard code
       integer :: np, nx, ny, nz, nxh, nyh, nzh, nxe, nye, nze, nxeh
       integer :: nxyzh, nxhyz, mx1, my1, mz1, mxyz1
@@ -71,6 +74,8 @@
       integer, dimension(:,:), pointer :: ncl
 ! ihole = location/destination of each particle departing tile
       integer, dimension(:,:,:), pointer :: ihole
+! cuh = current density on tile edges, used if ldep = 1
+      real, dimension(:,:,:), pointer :: cuh
 !
 ! declare and initialize timing data
       real :: time
@@ -137,6 +142,7 @@
       allocate(ppbuff(idimp,npbmx,mxyz1))
       allocate(ncl(26,mxyz1))
       allocate(ihole(2,ntmax+1,mxyz1))
+      allocate(cuh(3,2*(mx+1)*(my+1)+2*(mz-1)*(mx+my),mxyz1))
 ! copy ordered particle data for OpenMP: updates ppart and kpic
       call PPMOVIN3L(part,ppart,kpic,nppmx0,idimp,np,mx,my,mz,mx1,my1,  &
      &mxyz1,irc)
@@ -168,7 +174,16 @@
 ! deposit current with OpenMP: 
       call dtimer(dtime,itime,-1)
       cue = 0.0
-      if (relativity==1) then
+! halo buffer for tile edges: updates ppart, cue
+      if (ldep==1) then
+         if (relativity==1) then
+            call GRJPPOST3LH(ppart,cue,cuh,kpic,qme,dth,ci,nppmx0,idimp,&
+     &nx,ny,nz,mx,my,mz,nxe,nye,nze,mx1,my1,mxyz1,ipbc)
+         else
+            call GJPPOST3LH(ppart,cue,cuh,kpic,qme,dth,nppmx0,idimp,nx, &
+     &ny,nz,mx,my,mz,nxe,nye,nze,mx1,my1,mxyz1,ipbc)
+         endif
+      else if (relativity==1) then
 ! updates ppart, cue
 !        call GRJPPOST3L(ppart,cue,kpic,qme,dth,ci,nppmx0,idimp,nx,ny,nz&
 !    &,mx,my,mz,nxe,nye,nze,mx1,my1,mxyz1,ipbc)
@@ -198,11 +213,14 @@
 ! reorder particles by tile with OpenMP:
       call dtimer(dtime,itime,-1)
 ! updates ppart, ppbuff, kpic, ncl, ihole, and irc
-!     call PPORDER3L(ppart,ppbuff,kpic,ncl,ihole,idimp,nppmx0,nx,ny,nz, &
-!    &mx,my,mz,mx1,my1,mz1,npbmx,ntmax,irc)
+      if (ldep==1) then
+         call PPORDER3L(ppart,ppbuff,kpic,ncl,ihole,idimp,nppmx0,nx,ny, &
+     &nz,mx,my,mz,mx1,my1,mz1,npbmx,ntmax,irc)
 ! updates ppart, ppbuff, kpic, ncl, and irc
-      call PPORDERF3L(ppart,ppbuff,kpic,ncl,ihole,idimp,nppmx0,mx1,my1, &
-     &mz1,npbmx,ntmax,irc)
+      else
+         call PPORDERF3L(ppart,ppbuff,kpic,ncl,ihole,idimp,nppmx0,mx1,  &
+     &my1,mz1,npbmx,ntmax,irc)
+      endif
       call dtimer(dtime,itime,1)
       time = real(dtime)
       tsort = tsort + time
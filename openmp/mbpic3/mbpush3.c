@@ -3510,6 +3510,596 @@ edgelz,edgerx,edgery,edgerz,scu)
 #undef MZV
 }
 
+/*--------------------------------------------------------------------*/
+void cgjppost3lh(float ppart[], float cu[], float cuh[], int kpic[],
+                 float qm, float dt, int nppmx, int idimp, int nx,
+                 int ny, int nz, int mx, int my, int mz, int nxv,
+                 int nyv, int nzv, int mx1, int my1, int mxyz1,
+                 int ipbc) {
+/* for 3d code, this subroutine calculates particle current density
+   using first-order linear interpolation
+   in addition, particle positions are advanced a half time-step
+   OpenMP version using guard cells
+   data deposited in tiles
+   particles stored segmented array
+   same as cgjppost3l, except current on the edges of each tile is first
+   saved in a halo buffer, then added to cu in a second pass which
+   processes tiles in 8 colors, so that no atomic updates are needed.
+   tiles of the same color do not share any grid points
+   69 flops/particle, 30 loads, 27 stores
+   input: all, output: ppart, cu
+   current density is approximated by values at the nearest grid points
+   cu(i,n,m,l)=qci*(1.-dx)*(1.-dy)*(1.-dz)
+   cu(i,n+1,m,l)=qci*dx*(1.-dy)*(1.-dz)
+   cu(i,n,m+1,l)=qci*(1.-dx)*dy*(1.-dz)
+   cu(i,n+1,m+1,l)=qci*dx*dy*(1.-dz)
+   cu(i,n,m,l+1)=qci*(1.-dx)*(1.-dy)*dz
+   cu(i,n+1,m,l+1)=qci*dx*(1.-dy)*dz
+   cu(i,n,m+1,l+1)=qci*(1.-dx)*dy*dz
+   cu(i,n+1,m+1,l+1)=qci*dx*dy*dz
+   where n,m,l = leftmost grid points and dx = x-n, dy = y-m, dz = z-l
+   and qci = qm*vi, where i = x,y,z
+   ppart[m][n][0] = position x of particle n in tile m
+   ppart[m][n][1] = position y of particle n in tile m
+   ppart[m][n][2] = position z of particle n in tile m
+   ppart[m][n][3] = velocity vx of particle n in tile m
+   ppart[m][n][4] = velocity vy of particle n in tile m
+   ppart[m][n][5] = velocity vz of particle n in tile m
+   cu[l][k][j][i] = ith component of current density at grid point j,k,l
+   cuh[l][j][i] = ith component of current density at edge point j of
+   tile l
+   kpic = number of particles per tile
+   qm = charge on particle, in units of e
+   dt = time interval between successive calculations
+   nppmx = maximum number of particles in tile
+   idimp = size of phase space = 6
+   nx/ny/nz = system length in x/y/z direction
+   mx/my/mz = number of grids in sorting cell in x/y/z
+   nxv = second dimension of current array, must be >= nx+1
+   nyv = third dimension of current array, must be >= ny+1
+   nzv = fourth dimension of current array, must be >= nz+1
+   mx1 = (system length in x direction - 1)/mx + 1
+   my1 = (system length in y direction - 1)/my + 1
+   mxyz1 = mx1*my1*mz1,
+   where mz1 = (system length in z direction - 1)/mz + 1
+   ipbc = particle boundary condition = (0,1,2,3) =
+   (none,3d periodic,3d reflecting,mixed 2d reflecting/1d periodic)
+   the second dimension of cuh must be >=
+   2*(mx+1)*(my+1) + 2*(mz-1)*(mx+my)
+local data                                                            */
+#define MXV             17
+#define MYV             17
+#define MZV             17
+   int mxy1, noff, moff, loff, npoff, npp, nh, kc;
+   int i, j, k, l, nn, mm, ll, ih, ii, mxv, myv, mxyv, nxyv;
+   float edgelx, edgely, edgelz, edgerx, edgery, edgerz;
+   float dxp, dyp, dzp, amx, amy, amz, dx1, dx, dy, dz, vx, vy, vz;
+   float x, y, z;
+   float scu[3*MXV*MYV*MZV];
+/* float scu[3*(mx+1)*(my+1)*(mz+1)]; */
+/* mxv = MXV; */
+/* myv = MYV; */
+   mxv = mx+1;
+   myv = my+1;
+   mxyv = mxv*myv;
+   nxyv = nxv*nyv;
+   mxy1 = mx1*my1;
+   nh = 2*(mx+1)*(my+1) + 2*(mz-1)*(mx+my);
+/* set boundary values */
+   edgelx = 0.0f;
+   edgely = 0.0f;
+   edgelz = 0.0f;
+   edgerx = (float) nx;
+   edgery = (float) ny;
+   edgerz = (float) nz;
+   if (ipbc==2) {
+      edgelx = 1.0f;
+      edgely = 1.0f;
+      edgelz = 1.0f;
+      edgerx = (float) (nx-1);
+      edgery = (float) (ny-1);
+      edgerz = (float) (nz-1);
+   }
+   else if (ipbc==3) {
+      edgelx = 1.0f;
+      edgely = 1.0f;
+      edgerx = (float) (nx-1);
+      edgery = (float) (ny-1);
+   }
+/* error if local array is too small                */
+/* if ((mx >= MXV) || (my >= MYV) || (mz >= MZV))   */
+/*    return;                                       */
+/* loop over tiles */
+#pragma omp parallel for \
+private(i,j,k,l,noff,moff,loff,npp,npoff,nn,mm,ll,ih,ii,x,y,z,dxp,dyp, \
+dzp,amx,amy,amz,dx1,dx,dy,dz,vx,vy,vz,scu)
+   for (l = 0; l < mxyz1; l++) {
+      loff = l/mxy1;
+      k = l - mxy1*loff;
+      loff = mz*loff;
+      noff = k/mx1;
+      moff = my*noff;
+      noff = mx*(k - mx1*noff);
+      npp = kpic[l];
+      npoff = nppmx*l;
+/* zero out local accumulator */
+      for (j = 0; j < 3*mxyv*(mz+1); j++) {
+         scu[j] = 0.0f;
+      }
+/* loop over particles in tile */
+      for (j = 0; j < npp; j++) {
+/* find interpolation weights */
+         x = ppart[idimp*(j+npoff)];
+         y = ppart[1+idimp*(j+npoff)];
+         z = ppart[2+idimp*(j+npoff)];
+         nn = x;
+         mm = y;
+         ll = z;
+         dxp = qm*(x - (float) nn);
+         dyp = y - (float) mm;
+         dzp = z - (float) ll;
+         nn = 3*(nn - noff + mxv*(mm - moff) + mxyv*(ll - loff));
+         amx = qm - dxp;
+         amy = 1.0f - dyp;
+         dx1 = dxp*dyp;
+         dyp = amx*dyp;
+         amx = amx*amy;
+         amz = 1.0f - dzp;
+         amy = dxp*amy;
+/* deposit current within tile to local accumulator */
+         dx = amx*amz;
+         dy = amy*amz;
+         vx = ppart[3+idimp*(j+npoff)];
+         vy = ppart[4+idimp*(j+npoff)];
+         vz = ppart[5+idimp*(j+npoff)];
+         scu[nn] += vx*dx;
+         scu[nn+1] += vy*dx;
+         scu[nn+2] += vz*dx;
+         dx = dyp*amz;
+         scu[nn+3] += vx*dy;
+         scu[nn+1+3] += vy*dy;
+         scu[nn+2+3] += vz*dy;
+         dy = dx1*amz;
+         mm = nn + 3*mxv;
+         scu[mm] += vx*dx;
+         scu[mm+1] += vy*dx;
+         scu[mm+2] += vz*dx;
+         dx = amx*dzp;
+         scu[mm+3] += vx*dy;
+         scu[mm+1+3] += vy*dy;
+         scu[mm+2+3] += vz*dy;
+         dy = amy*dzp;
+         nn += 3*mxyv;
+         scu[nn] += vx*dx;
+         scu[nn+1] += vy*dx;
+         scu[nn+2] += vz*dx;
+         dx = dyp*dzp;
+         scu[nn+3] += vx*dy;
+         scu[nn+1+3] += vy*dy;
+         scu[nn+2+3] += vz*dy;
+         dy = dx1*dzp;
+         mm = nn + 3*mxv;
+         scu[mm] += vx*dx;
+         scu[mm+1] += vy*dx;
+         scu[mm+2] += vz*dx;
+         scu[mm+3] += vx*dy;
+         scu[mm+1+3] += vy*dy;
+         scu[mm+2+3] += vz*dy;
+/* advance position half a time-step */
+         dx = x + vx*dt;
+         dy = y + vy*dt;
+         dz = z + vz*dt;
+/* reflecting boundary conditions */
+         if (ipbc==2) {
+            if ((dx < edgelx) || (dx >= edgerx)) {
+               dx = x;
+               ppart[3+idimp*(j+npoff)] = -vx;
+            }
+            if ((dy < edgely) || (dy >= edgery)) {
+               dy = y;
+               ppart[4+idimp*(j+npoff)] = -vy;
+            }
+            if ((dz < edgelz) || (dz >= edgerz)) {
+               dz = z;
+               ppart[5+idimp*(j+npoff)] = -vz;
+            }
+         }
+/* mixed reflecting/periodic boundary conditions */
+         else if (ipbc==3) {
+            if ((dx < edgelx) || (dx >= edgerx)) {
+               dx = x;
+               ppart[3+idimp*(j+npoff)] = -vx;
+            }
+            if ((dy < edgely) || (dy >= edgery)) {
+               dy = y;
+               ppart[4+idimp*(j+npoff)] = -vy;
+            }
+         }
+/* set new position */
+         ppart[idimp*(j+npoff)] = dx;
+         ppart[1+idimp*(j+npoff)] = dy;
+         ppart[2+idimp*(j+npoff)] = dz;
+      }
+/* deposit current to interior points in global array */
+      nn = nxv - noff;
+      nn = mx < nn ? mx : nn;
+      mm = nyv - moff;
+      mm = my < mm ? my : mm;
+      ll = nzv - loff;
+      ll = mz < ll ? mz : ll;
+      for (k = 1; k < ll; k++) {
+         for (j = 1; j < mm; j++) {
+            for (i = 1; i < nn; i++) {
+               cu[3*(i+noff+nxv*(j+moff)+nxyv*(k+loff))]
+               += scu[3*(i+mxv*j+mxyv*k)];
+               cu[1+3*(i+noff+nxv*(j+moff)+nxyv*(k+loff))]
+               += scu[1+3*(i+mxv*j+mxyv*k)];
+               cu[2+3*(i+noff+nxv*(j+moff)+nxyv*(k+loff))]
+               += scu[2+3*(i+mxv*j+mxyv*k)];
+            }
+         }
+      }
+/* save current at edge points in halo buffer */
+      nn = nxv - noff;
+      nn = mx+1 < nn ? mx+1 : nn;
+      mm = nyv - moff;
+      mm = my+1 < mm ? my+1 : mm;
+      ll = nzv - loff;
+      ll = mz+1 < ll ? mz+1 : ll;
+      ih = 3*nh*l;
+      for (k = 0; k < ll; k++) {
+         for (j = 0; j < mm; j++) {
+            ii = (k==0) || (k==mz) || (j==0) || (j==my) ? 1 : mx;
+            for (i = 0; i < nn; i += ii) {
+               cuh[ih] = scu[3*(i+mxv*j+mxyv*k)];
+               cuh[1+ih] = scu[1+3*(i+mxv*j+mxyv*k)];
+               cuh[2+ih] = scu[2+3*(i+mxv*j+mxyv*k)];
+               ih += 3;
+            }
+         }
+      }
+   }
+/* second pass: add edges to global array, one color at a time */
+   for (kc = 0; kc < 8; kc++) {
+#pragma omp parallel for private(i,j,k,l,noff,moff,loff,nn,mm,ll,ih,ii)
+      for (l = 0; l < mxyz1; l++) {
+         loff = l/mxy1;
+         k = l - mxy1*loff;
+         moff = k/mx1;
+         noff = k - mx1*moff;
+         if ((noff%2 + 2*(moff%2) + 4*(loff%2)) != kc)
+            continue;
+         loff = mz*loff;
+         moff = my*moff;
+         noff = mx*noff;
+         nn = nxv - noff;
+         nn = mx+1 < nn ? mx+1 : nn;
+         mm = nyv - moff;
+         mm = my+1 < mm ? my+1 : mm;
+         ll = nzv - loff;
+         ll = mz+1 < ll ? mz+1 : ll;
+         ih = 3*nh*l;
+         for (k = 0; k < ll; k++) {
+            for (j = 0; j < mm; j++) {
+               ii = (k==0) || (k==mz) || (j==0) || (j==my) ? 1 : mx;
+               for (i = 0; i < nn; i += ii) {
+                  cu[3*(i+noff+nxv*(j+moff)+nxyv*(k+loff))] += cuh[ih];
+                  cu[1+3*(i+noff+nxv*(j+moff)+nxyv*(k+loff))]
+                  += cuh[1+ih];
+                  cu[2+3*(i+noff+nxv*(j+moff)+nxyv*(k+loff))]
+                  += cuh[2+ih];
+                  ih += 3;
+               }
+            }
+         }
+      }
+   }
+   return;
+#undef MXV
+#undef MYV
+#undef MZV
+}
+
+/*--------------------------------------------------------------------*/
+void cgrjppost3lh(float ppart[], float cu[], float cuh[], int kpic[],
+                  float qm, float dt, float ci, int nppmx, int idimp,
+                  int nx, int ny, int nz, int mx, int my, int mz,
+                  int nxv, int nyv, int nzv, int mx1, int my1,
+                  int mxyz1, int ipbc) {
+/* for 3d code, this subroutine calculates particle current density
+   using first-order linear interpolation for relativistic particles
+   in addition, particle positions are advanced a half time-step
+   OpenMP version using guard cells
+   data deposited in tiles
+   particles stored segmented array
+   same as cgrjppost3l, except current on the edges of each tile is first
+   saved in a halo buffer, then added to cu in a second pass which
+   processes tiles in 8 colors, so that no atomic updates are needed.
+   tiles of the same color do not share any grid points
+   79 flops/particle, 1 divide, 1 sqrt, 30 loads, 27 stores
+   input: all, output: ppart, cu
+   current density is approximated by values at the nearest grid points
+   cu(i,n,m,l)=qci*(1.-dx)*(1.-dy)*(1.-dz)
+   cu(i,n+1,m,l)=qci*dx*(1.-dy)*(1.-dz)
+   cu(i,n,m+1,l)=qci*(1.-dx)*dy*(1.-dz)
+   cu(i,n+1,m+1,l)=qci*dx*dy*(1.-dz)
+   cu(i,n,m,l+1)=qci*(1.-dx)*(1.-dy)*dz
+   cu(i,n+1,m,l+1)=qci*dx*(1.-dy)*dz
+   cu(i,n,m+1,l+1)=qci*(1.-dx)*dy*dz
+   cu(i,n+1,m+1,l+1)=qci*dx*dy*dz
+   where n,m,l = leftmost grid points and dx = x-n, dy = y-m, dz = z-l
+   and qci = qm*pi*gami, where i = x,y,z
+   where gami = 1./sqrt(1.+sum(pi**2)*ci*ci)
+   ppart[m][n][0] = position x of particle n in tile m
+   ppart[m][n][1] = position y of particle n in tile m
+   ppart[m][n][2] = position z of particle n in tile m
+   ppart[m][n][3] = x momentum of particle n in tile m
+   ppart[m][n][4] = y momentum of particle n in tile m
+   ppart[m][n][5] = z momentum of particle n in tile m
+   cu[l][k][j][i] = ith component of current density at grid point j,k,l
+   cuh[l][j][i] = ith component of current density at edge point j of
+   tile l
+   kpic = number of particles per tile
+   qm = charge on particle, in units of e
+   dt = time interval between successive calculations
+   ci = reciprocal of velocity of light
+   nppmx = maximum number of particles in tile
+   idimp = size of phase space = 6
+   nx/ny/nz = system length in x/y/z direction
+   mx/my/mz = number of grids in sorting cell in x/y/z
+   nxv = second dimension of current array, must be >= nx+1
+   nyv = third dimension of current array, must be >= ny+1
+   nzv = fourth dimension of current array, must be >= nz+1
+   mx1 = (system length in x direction - 1)/mx + 1
+   my1 = (system length in y direction - 1)/my + 1
+   mxyz1 = mx1*my1*mz1,
+   where mz1 = (system length in z direction - 1)/mz + 1
+   ipbc = particle boundary condition = (0,1,2,3) =
+   (none,3d periodic,3d reflecting,mixed 2d reflecting/1d periodic)
+   the second dimension of cuh must be >=
+   2*(mx+1)*(my+1) + 2*(mz-1)*(mx+my)
+local data                                                            */
+#define MXV             17
+#define MYV             17
+#define MZV             17
+   int mxy1, noff, moff, loff, npoff, npp, nh, kc;
+   int i, j, k, l, nn, mm, ll, ih, ii, mxv, myv, mxyv, nxyv;
+   float ci2, edgelx, edgely, edgelz, edgerx, edgery, edgerz;
+   float dxp, dyp, dzp, amx, amy, amz, dx1, dx, dy, dz, vx, vy, vz;
+   float x, y, z, p2, gami;
+   float scu[3*MXV*MYV*MZV];
+/* float scu[3*(mx+1)*(my+1)*(mz+1)]; */
+/* mxv = MXV; */
+/* myv = MYV; */
+   mxv = mx+1;
+   myv = my+1;
+   mxyv = mxv*myv;
+   nxyv = nxv*nyv;
+   mxy1 = mx1*my1;
+   nh = 2*(mx+1)*(my+1) + 2*(mz-1)*(mx+my);
+   ci2 = ci*ci;
+/* set boundary values */
+   edgelx = 0.0f;
+   edgely = 0.0f;
+   edgelz = 0.0f;
+   edgerx = (float) nx;
+   edgery = (float) ny;
+   edgerz = (float) nz;
+   if (ipbc==2) {
+      edgelx = 1.0f;
+      edgely = 1.0f;
+      edgelz = 1.0f;
+      edgerx = (float) (nx-1);
+      edgery = (float) (ny-1);
+      edgerz = (float) (nz-1);
+   }
+   else if (ipbc==3) {
+      edgelx = 1.0f;
+      edgely = 1.0f;
+      edgerx = (float) (nx-1);
+      edgery = (float) (ny-1);
+   }
+/* error if local array is too small                */
+/* if ((mx >= MXV) || (my >= MYV) || (mz >= MZV))   */
+/*    return;                                       */
+/* loop over tiles */
+#pragma omp parallel for \
+private(i,j,k,l,noff,moff,loff,npp,npoff,nn,mm,ll,ih,ii,x,y,z,dxp,dyp, \
+dzp,amx,amy,amz,dx1,dx,dy,dz,vx,vy,vz,p2,gami,scu)
+   for (l = 0; l < mxyz1; l++) {
+      loff = l/mxy1;
+      k = l - mxy1*loff;
+      loff = mz*loff;
+      noff = k/mx1;
+      moff = my*noff;
+      noff = mx*(k - mx1*noff);
+      npp = kpic[l];
+      npoff = nppmx*l;
+/* zero out local accumulator */
+      for (j = 0; j < 3*mxyv*(mz+1); j++) {
+         scu[j] = 0.0f;
+      }
+/* loop over particles in tile */
+      for (j = 0; j < npp; j++) {
+/* find interpolation weights */
+         x = ppart[idimp*(j+npoff)];
+         y = ppart[1+idimp*(j+npoff)];
+         z = ppart[2+idimp*(j+npoff)];
+         nn = x;
+         mm = y;
+         ll = z;
+         dxp = qm*(x - (float) nn);
+         dyp = y - (float) mm;
+         dzp = z - (float) ll;
+/* find inverse gamma */
+         vx = ppart[3+idimp*(j+npoff)];
+         vy = ppart[4+idimp*(j+npoff)];
+         vz = ppart[5+idimp*(j+npoff)];
+         p2 = vx*vx + vy*vy + vz*vz;
+         gami = 1.0f/sqrtf(1.0f + p2*ci2);
+/* calculate weights */
+         nn = 3*(nn - noff + mxv*(mm - moff) + mxyv*(ll - loff));
+         amx = qm - dxp;
+         amy = 1.0f - dyp;
+         dx1 = dxp*dyp;
+         dyp = amx*dyp;
+         amx = amx*amy;
+         amz = 1.0f - dzp;
+         amy = dxp*amy;
+/* deposit current within tile to local accumulator */
+         dx = amx*amz;
+         dy = amy*amz;
+         vx *= gami;
+         vy *= gami;
+         vz *= gami;
+         scu[nn] += vx*dx;
+         scu[nn+1] += vy*dx;
+         scu[nn+2] += vz*dx;
+         dx = dyp*amz;
+         scu[nn+3] += vx*dy;
+         scu[nn+1+3] += vy*dy;
+         scu[nn+2+3] += vz*dy;
+         dy = dx1*amz;
+         mm = nn + 3*mxv;
+         scu[mm] += vx*dx;
+         scu[mm+1] += vy*dx;
+         scu[mm+2] += vz*dx;
+         dx = amx*dzp;
+         scu[mm+3] += vx*dy;
+         scu[mm+1+3] += vy*dy;
+         scu[mm+2+3] += vz*dy;
+         dy = amy*dzp;
+         nn += 3*mxyv;
+         scu[nn] += vx*dx;
+         scu[nn+1] += vy*dx;
+         scu[nn+2] += vz*dx;
+         dx = dyp*dzp;
+         scu[nn+3] += vx*dy;
+         scu[nn+1+3] += vy*dy;
+         scu[nn+2+3] += vz*dy;
+         dy = dx1*dzp;
+         mm = nn + 3*mxv;
+         scu[mm] += vx*dx;
+         scu[mm+1] += vy*dx;
+         scu[mm+2] += vz*dx;
+         scu[mm+3] += vx*dy;
+         scu[mm+1+3] += vy*dy;
+         scu[mm+2+3] += vz*dy;
+/* advance position half a time-step */
+         dx = x + vx*dt;
+         dy = y + vy*dt;
+         dz = z + vz*dt;
+/* reflecting boundary conditions */
+         if (ipbc==2) {
+            if ((dx < edgelx) || (dx >= edgerx)) {
+               dx = x;
+               ppart[3+idimp*(j+npoff)] = -ppart[3+idimp*(j+npoff)];
+            }
+            if ((dy < edgely) || (dy >= edgery)) {
+               dy = y;
+               ppart[4+idimp*(j+npoff)] = -ppart[4+idimp*(j+npoff)];
+            }
+            if ((dz < edgelz) || (dz >= edgerz)) {
+               dz = z;
+               ppart[5+idimp*(j+npoff)] = -ppart[5+idimp*(j+npoff)];
+            }
+         }
+/* mixed reflecting/periodic boundary conditions */
+         else if (ipbc==3) {
+            if ((dx < edgelx) || (dx >= edgerx)) {
+               dx = x;
+               ppart[3+idimp*(j+npoff)] = -ppart[3+idimp*(j+npoff)];
+            }
+            if ((dy < edgely) || (dy >= edgery)) {
+               dy = y;
+               ppart[4+idimp*(j+npoff)] = -ppart[4+idimp*(j+npoff)];
+            }
+         }
+/* set new position */
+         ppart[idimp*(j+npoff)] = dx;
+         ppart[1+idimp*(j+npoff)] = dy;
+         ppart[2+idimp*(j+npoff)] = dz;
+      }
+/* deposit current to interior points in global array */
+      nn = nxv - noff;
+      nn = mx < nn ? mx : nn;
+      mm = nyv - moff;
+      mm = my < mm ? my : mm;
+      ll = nzv - loff;
+      ll = mz < ll ? mz : ll;
+      for (k = 1; k < ll; k++) {
+         for (j = 1; j < mm; j++) {
+            for (i = 1; i < nn; i++) {
+               cu[3*(i+noff+nxv*(j+moff)+nxyv*(k+loff))]
+               += scu[3*(i+mxv*j+mxyv*k)];
+               cu[1+3*(i+noff+nxv*(j+moff)+nxyv*(k+loff))]
+               += scu[1+3*(i+mxv*j+mxyv*k)];
+               cu[2+3*(i+noff+nxv*(j+moff)+nxyv*(k+loff))]
+               += scu[2+3*(i+mxv*j+mxyv*k)];
+            }
+         }
+      }
+/* save current at edge points in halo buffer */
+      nn = nxv - noff;
+      nn = mx+1 < nn ? mx+1 : nn;
+      mm = nyv - moff;
+      mm = my+1 < mm ? my+1 : mm;
+      ll = nzv - loff;
+      ll = mz+1 < ll ? mz+1 : ll;
+      ih = 3*nh*l;
+      for (k = 0; k < ll; k++) {
+         for (j = 0; j < mm; j++) {
+            ii = (k==0) || (k==mz) || (j==0) || (j==my) ? 1 : mx;
+            for (i = 0; i < nn; i += ii) {
+               cuh[ih] = scu[3*(i+mxv*j+mxyv*k)];
+               cuh[1+ih] = scu[1+3*(i+mxv*j+mxyv*k)];
+               cuh[2+ih] = scu[2+3*(i+mxv*j+mxyv*k)];
+               ih += 3;
+            }
+         }
+      }
+   }
+/* second pass: add edges to global array, one color at a time */
+   for (kc = 0; kc < 8; kc++) {
+#pragma omp parallel for private(i,j,k,l,noff,moff,loff,nn,mm,ll,ih,ii)
+      for (l = 0; l < mxyz1; l++) {
+         loff = l/mxy1;
+         k = l - mxy1*loff;
+         moff = k/mx1;
+         noff = k - mx1*moff;
+         if ((noff%2 + 2*(moff%2) + 4*(loff%2)) != kc)
+            continue;
+         loff = mz*loff;
+         moff = my*moff;
+         noff = mx*noff;
+         nn = nxv - noff;
+         nn = mx+1 < nn ? mx+1 : nn;
+         mm = nyv - moff;
+         mm = my+1 < mm ? my+1 : mm;
+         ll = nzv - loff;
+         ll = mz+1 < ll ? mz+1 : ll;
+         ih = 3*nh*l;
+         for (k = 0; k < ll; k++) {
+            for (j = 0; j < mm; j++) {
+               ii = (k==0) || (k==mz) || (j==0) || (j==my) ? 1 : mx;
+               for (i = 0; i < nn; i += ii) {
+                  cu[3*(i+noff+nxv*(j+moff)+nxyv*(k+loff))] += cuh[ih];
+                  cu[1+3*(i+noff+nxv*(j+moff)+nxyv*(k+loff))]
+                  += cuh[1+ih];
+                  cu[2+3*(i+noff+nxv*(j+moff)+nxyv*(k+loff))]
+                  += cuh[2+ih];
+                  ih += 3;
+               }
+            }
+         }
+      }
+   }
+   return;
+#undef MXV
+#undef MYV
+#undef MZV
+}
+
 /*--------------------------------------------------------------------*/
 void cpporder3l(float ppart[], float ppbuff[], int kpic[], int ncl[],
                 int ihole[], int idimp, int nppmx, int nx, int ny,
@@ -7325,6 +7915,28 @@ void cgrjppostf3l_(float *ppart, float *cu, int *kpic, int *ncl,
    return;
 }
 
+/*--------------------------------------------------------------------*/
+void cgjppost3lh_(float *ppart, float *cu, float *cuh, int *kpic,
+                  float *qm, float *dt, int *nppmx, int *idimp, int *nx,
+                  int *ny, int *nz, int *mx, int *my, int *mz, int *nxv,
+                  int *nyv, int *nzv, int *mx1, int *my1, int *mxyz1,
+                  int *ipbc) {
+   cgjppost3lh(ppart,cu,cuh,kpic,*qm,*dt,*nppmx,*idimp,*nx,*ny,*nz,*mx,
+               *my,*mz,*nxv,*nyv,*nzv,*mx1,*my1,*mxyz1,*ipbc);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cgrjppost3lh_(float *ppart, float *cu, float *cuh, int *kpic,
+                   float *qm, float *dt, float *ci, int *nppmx,
+                   int *idimp, int *nx, int *ny, int *nz, int *mx,
+                   int *my, int *mz, int *nxv, int *nyv, int *nzv,
+                   int *mx1, int *my1, int *mxyz1, int *ipbc) {
+   cgrjppost3lh(ppart,cu,cuh,kpic,*qm,*dt,*ci,*nppmx,*idimp,*nx,*ny,
+                *nz,*mx,*my,*mz,*nxv,*nyv,*nzv,*mx1,*my1,*mxyz1,*ipbc);
+   return;
+}
+
 /*--------------------------------------------------------------------*/
 void cpporder3l_(float *ppart, float *ppbuff, int *kpic, int *ncl,
                  int *ihole, int *idimp, int *nppmx, int *nx, int *ny,
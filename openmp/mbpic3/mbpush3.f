@@ -3331,6 +3331,578 @@ c set error and end of file flag
 !$OMP END PARALLEL DO
       return
       end
+c-----------------------------------------------------------------------
+      subroutine GJPPOST3LH(ppart,cu,cuh,kpic,qm,dt,nppmx,idimp,nx,ny,nz
+     1,mx,my,mz,nxv,nyv,nzv,mx1,my1,mxyz1,ipbc)
+c for 3d code, this subroutine calculates particle current density
+c using first-order linear interpolation
+c in addition, particle positions are advanced a half time-step
+c OpenMP version using guard cells
+c data deposited in tiles
+c particles stored segmented array
+c same as GJPPOST3L, except current on the edges of each tile is first
+c saved in a halo buffer, then added to cu in a second pass which
+c processes tiles in 8 colors, so that no atomic updates are needed.
+c tiles of the same color do not share any grid points
+c 69 flops/particle, 30 loads, 27 stores
+c input: all, output: ppart, cu
+c current density is approximated by values at the nearest grid points
+c cu(i,n,m,l)=qci*(1.-dx)*(1.-dy)*(1.-dz)
+c cu(i,n+1,m,l)=qci*dx*(1.-dy)*(1.-dz)
+c cu(i,n,m+1,l)=qci*(1.-dx)*dy*(1.-dz)
+c cu(i,n+1,m+1,l)=qci*dx*dy*(1.-dz)
+c cu(i,n,m,l+1)=qci*(1.-dx)*(1.-dy)*dz
+c cu(i,n+1,m,l+1)=qci*dx*(1.-dy)*dz
+c cu(i,n,m+1,l+1)=qci*(1.-dx)*dy*dz
+c cu(i,n+1,m+1,l+1)=qci*dx*dy*dz
+c where n,m,l = leftmost grid points and dx = x-n, dy = y-m, dz = z-l
+c and qci = qm*vi, where i = x,y,z
+c ppart(1,n,m) = position x of particle n in tile m
+c ppart(2,n,m) = position y of particle n in tile m
+c ppart(3,n,m) = position z of particle n in tile m
+c ppart(4,n,m) = velocity vx of particle n in tile m
+c ppart(5,n,m) = velocity vy of particle n in tile m
+c ppart(6,n,m) = velocity vz of particle n in tile m
+c cu(i,j,k,l) = ith component of current density at grid point j,k,l
+c cuh(i,j,l) = ith component of current density at edge point j of
+c tile l
+c kpic = number of particles per tile
+c qm = charge on particle, in units of e
+c dt = time interval between successive calculations
+c nppmx = maximum number of particles in tile
+c idimp = size of phase space = 6
+c nx/ny/nz = system length in x/y/z direction
+c mx/my/mz = number of grids in sorting cell in x/y/z
+c nxv = second dimension of current array, must be >= nx+1
+c nyv = third dimension of current array, must be >= ny+1
+c nzv = fourth dimension of current array, must be >= nz+1
+c mx1 = (system length in x direction - 1)/mx + 1
+c my1 = (system length in y direction - 1)/my + 1
+c mxyz1 = mx1*my1*mz1,
+c where mz1 = (system length in z direction - 1)/mz + 1
+c ipbc = particle boundary condition = (0,1,2,3) =
+c (none,3d periodic,3d reflecting,mixed 2d reflecting/1d periodic)
+c the second dimension of cuh must be >=
+c 2*(mx+1)*(my+1) + 2*(mz-1)*(mx+my)
+      implicit none
+      integer nppmx, idimp, nx, ny, nz, mx, my, mz, nxv, nyv, nzv
+      integer mx1, my1, mxyz1, ipbc
+      real qm, dt
+      real ppart, cu, cuh
+      integer kpic
+      dimension ppart(idimp,nppmx,mxyz1), cu(3,nxv,nyv,nzv)
+      dimension cuh(3,2*(mx+1)*(my+1)+2*(mz-1)*(mx+my),mxyz1)
+      dimension kpic(mxyz1)
+c local data
+      integer MXV, MYV, MZV
+      parameter(MXV=17,MYV=17,MZV=17)
+      integer mxy1, noff, moff, loff, npp, kc
+      integer i, j, k, l, nn, mm, ll, ih, ii
+      real edgelx, edgely, edgelz, edgerx, edgery, edgerz
+      real dxp, dyp, dzp, amx, amy, amz, dx1, dx, dy, dz, vx, vy, vz
+      real x, y, z
+      real scu
+      dimension scu(3,MXV,MYV,MZV)
+c     dimension scu(3,mx+1,my+1,mz+1)
+      mxy1 = mx1*my1
+c set boundary values
+      edgelx = 0.0
+      edgely = 0.0
+      edgelz = 0.0
+      edgerx = real(nx)
+      edgery = real(ny)
+      edgerz = real(nz)
+      if (ipbc.eq.2) then
+         edgelx = 1.0
+         edgely = 1.0
+         edgelz = 1.0
+         edgerx = real(nx-1)
+         edgery = real(ny-1)
+         edgerz = real(nz-1)
+      else if (ipbc.eq.3) then
+         edgelx = 1.0
+         edgely = 1.0
+         edgerx = real(nx-1)
+         edgery = real(ny-1)
+      endif
+c error if local array is too small
+c     if ((mx.ge.MXV).or.(my.ge.MYV).or.(mz.ge.MZV)) return
+c first pass: deposit to interior points and save edges
+!$OMP PARALLEL DO
+!$OMP& PRIVATE(i,j,k,l,noff,moff,loff,npp,nn,mm,ll,ih,ii,x,y,z,dxp,dyp, 
+!$OMP& dzp,amx,amy,amz,dx1,dx,dy,dz,vx,vy,vz,scu)
+      do 150 l = 1, mxyz1
+      loff = (l - 1)/mxy1
+      k = l - mxy1*loff
+      loff = mz*loff
+      noff = (k - 1)/mx1
+      moff = my*noff
+      noff = mx*(k - mx1*noff - 1)
+      npp = kpic(l)
+c zero out local accumulator
+      do 30 k = 1, mz+1
+      do 20 j = 1, my+1
+      do 10 i = 1, mx+1
+      scu(1,i,j,k) = 0.0
+      scu(2,i,j,k) = 0.0
+      scu(3,i,j,k) = 0.0
+   10 continue
+   20 continue
+   30 continue
+c loop over particles in tile
+      do 40 j = 1, npp
+c find interpolation weights
+      x = ppart(1,j,l)
+      y = ppart(2,j,l)
+      z = ppart(3,j,l)
+      nn = x
+      mm = y
+      ll = z
+      dxp = qm*(x - real(nn))
+      dyp = y - real(mm)
+      dzp = z - real(ll)
+      nn = nn - noff + 1
+      mm = mm - moff + 1
+      ll = ll - loff + 1
+      amx = qm - dxp
+      amy = 1.0 - dyp
+      dx1 = dxp*dyp
+      dyp = amx*dyp
+      amx = amx*amy
+      amz = 1.0 - dzp
+      amy = dxp*amy
+c deposit current within tile to local accumulator
+      dx = amx*amz
+      dy = amy*amz
+      vx = ppart(4,j,l)
+      vy = ppart(5,j,l)
+      vz = ppart(6,j,l)
+      scu(1,nn,mm,ll) = scu(1,nn,mm,ll) + vx*dx
+      scu(2,nn,mm,ll) = scu(2,nn,mm,ll) + vy*dx
+      scu(3,nn,mm,ll) = scu(3,nn,mm,ll) + vz*dx
+      dx = dyp*amz
+      scu(1,nn+1,mm,ll) = scu(1,nn+1,mm,ll) + vx*dy
+      scu(2,nn+1,mm,ll) = scu(2,nn+1,mm,ll) + vy*dy
+      scu(3,nn+1,mm,ll) = scu(3,nn+1,mm,ll) + vz*dy
+      dy = dx1*amz
+      scu(1,nn,mm+1,ll) = scu(1,nn,mm+1,ll) + vx*dx
+      scu(2,nn,mm+1,ll) = scu(2,nn,mm+1,ll) + vy*dx
+      scu(3,nn,mm+1,ll) = scu(3,nn,mm+1,ll) + vz*dx
+      dx = amx*dzp
+      scu(1,nn+1,mm+1,ll) = scu(1,nn+1,mm+1,ll) + vx*dy
+      scu(2,nn+1,mm+1,ll) = scu(2,nn+1,mm+1,ll) + vy*dy
+      scu(3,nn+1,mm+1,ll) = scu(3,nn+1,mm+1,ll) + vz*dy
+      dy = amy*dzp
+      scu(1,nn,mm,ll+1) = scu(1,nn,mm,ll+1) + vx*dx
+      scu(2,nn,mm,ll+1) = scu(2,nn,mm,ll+1) + vy*dx
+      scu(3,nn,mm,ll+1) = scu(3,nn,mm,ll+1) + vz*dx
+      dx = dyp*dzp
+      scu(1,nn+1,mm,ll+1) = scu(1,nn+1,mm,ll+1) + vx*dy
+      scu(2,nn+1,mm,ll+1) = scu(2,nn+1,mm,ll+1) + vy*dy
+      scu(3,nn+1,mm,ll+1) = scu(3,nn+1,mm,ll+1) + vz*dy
+      dy = dx1*dzp
+      scu(1,nn,mm+1,ll+1) = scu(1,nn,mm+1,ll+1) + vx*dx
+      scu(2,nn,mm+1,ll+1) = scu(2,nn,mm+1,ll+1) + vy*dx
+      scu(3,nn,mm+1,ll+1) = scu(3,nn,mm+1,ll+1) + vz*dx
+      scu(1,nn+1,mm+1,ll+1) = scu(1,nn+1,mm+1,ll+1) + vx*dy
+      scu(2,nn+1,mm+1,ll+1) = scu(2,nn+1,mm+1,ll+1) + vy*dy
+      scu(3,nn+1,mm+1,ll+1) = scu(3,nn+1,mm+1,ll+1) + vz*dy
+c advance position half a time-step
+      dx = x + vx*dt
+      dy = y + vy*dt
+      dz = z + vz*dt
+c reflecting boundary conditions
+      if (ipbc.eq.2) then
+         if ((dx.lt.edgelx).or.(dx.ge.edgerx)) then
+            dx = x
+            ppart(4,j,l) = -vx
+         endif
+         if ((dy.lt.edgely).or.(dy.ge.edgery)) then
+            dy = y
+            ppart(5,j,l) = -vy
+         endif
+         if ((dz.lt.edgelz).or.(dz.ge.edgerz)) then
+            dz = z
+            ppart(6,j,l) = -vz
+         endif
+c mixed reflecting/periodic boundary conditions
+      else if (ipbc.eq.3) then
+         if ((dx.lt.edgelx).or.(dx.ge.edgerx)) then
+            dx = x
+            ppart(4,j,l) = -vx
+         endif
+         if ((dy.lt.edgely).or.(dy.ge.edgery)) then
+            dy = y
+            ppart(5,j,l) = -vy
+         endif
+      endif
+c set new position
+      ppart(1,j,l) = dx
+      ppart(2,j,l) = dy
+      ppart(3,j,l) = dz
+   40 continue
+c deposit current to interior points in global array
+      nn = min(mx,nxv-noff)
+      mm = min(my,nyv-moff)
+      ll = min(mz,nzv-loff)
+      do 70 k = 2, ll
+      do 60 j = 2, mm
+      do 50 i = 2, nn
+      cu(1,i+noff,j+moff,k+loff) = cu(1,i+noff,j+moff,k+loff)           
+     1+ scu(1,i,j,k)
+      cu(2,i+noff,j+moff,k+loff) = cu(2,i+noff,j+moff,k+loff)           
+     1+ scu(2,i,j,k)
+      cu(3,i+noff,j+moff,k+loff) = cu(3,i+noff,j+moff,k+loff)           
+     1+ scu(3,i,j,k)
+   50 continue
+   60 continue
+   70 continue
+c save current at edge points in halo buffer
+      nn = min(mx+1,nxv-noff)
+      mm = min(my+1,nyv-moff)
+      ll = min(mz+1,nzv-loff)
+      ih = 0
+      do 100 k = 1, ll
+      do 90 j = 1, mm
+      ii = mx
+      if ((k.eq.1).or.(k.eq.(mz+1)).or.(j.eq.1).or.(j.eq.(my+1))) ii = 1
+      do 80 i = 1, nn, ii
+      ih = ih + 1
+      cuh(1,ih,l) = scu(1,i,j,k)
+      cuh(2,ih,l) = scu(2,i,j,k)
+      cuh(3,ih,l) = scu(3,i,j,k)
+   80 continue
+   90 continue
+  100 continue
+  150 continue
+!$OMP END PARALLEL DO
+c second pass: add edges to global array, one color at a time
+      do 200 kc = 0, 7
+!$OMP PARALLEL DO PRIVATE(i,j,k,l,noff,moff,loff,nn,mm,ll,ih,ii)
+      do 190 l = 1, mxyz1
+      loff = (l - 1)/mxy1
+      k = l - mxy1*loff
+      moff = (k - 1)/mx1
+      noff = k - mx1*moff - 1
+      if ((mod(noff,2)+2*mod(moff,2)+4*mod(loff,2)).ne.kc) go to 190
+      loff = mz*loff
+      moff = my*moff
+      noff = mx*noff
+      nn = min(mx+1,nxv-noff)
+      mm = min(my+1,nyv-moff)
+      ll = min(mz+1,nzv-loff)
+      ih = 0
+      do 180 k = 1, ll
+      do 170 j = 1, mm
+      ii = mx
+      if ((k.eq.1).or.(k.eq.(mz+1)).or.(j.eq.1).or.(j.eq.(my+1))) ii = 1
+      do 160 i = 1, nn, ii
+      ih = ih + 1
+      cu(1,i+noff,j+moff,k+loff) = cu(1,i+noff,j+moff,k+loff)           
+     1+ cuh(1,ih,l)
+      cu(2,i+noff,j+moff,k+loff) = cu(2,i+noff,j+moff,k+loff)           
+     1+ cuh(2,ih,l)
+      cu(3,i+noff,j+moff,k+loff) = cu(3,i+noff,j+moff,k+loff)           
+     1+ cuh(3,ih,l)
+  160 continue
+  170 continue
+  180 continue
+  190 continue
+!$OMP END PARALLEL DO
+  200 continue
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine GRJPPOST3LH(ppart,cu,cuh,kpic,qm,dt,ci,nppmx,idimp,nx,n
+     1y,nz,mx,my,mz,nxv,nyv,nzv,mx1,my1,mxyz1,ipbc)
+c for 3d code, this subroutine calculates particle current density
+c using first-order linear interpolation for relativistic particles
+c in addition, particle positions are advanced a half time-step
+c OpenMP version using guard cells
+c data deposited in tiles
+c particles stored segmented array
+c same as GRJPPOST3L, except current on the edges of each tile is first
+c saved in a halo buffer, then added to cu in a second pass which
+c processes tiles in 8 colors, so that no atomic updates are needed.
+c tiles of the same color do not share any grid points
+c 79 flops/particle, 1 divide, 1 sqrt, 30 loads, 27 stores
+c input: all, output: ppart, cu
+c current density is approximated by values at the nearest grid points
+c cu(i,n,m,l)=qci*(1.-dx)*(1.-dy)*(1.-dz)
+c cu(i,n+1,m,l)=qci*dx*(1.-dy)*(1.-dz)
+c cu(i,n,m+1,l)=qci*(1.-dx)*dy*(1.-dz)
+c cu(i,n+1,m+1,l)=qci*dx*dy*(1.-dz)
+c cu(i,n,m,l+1)=qci*(1.-dx)*(1.-dy)*dz
+c cu(i,n+1,m,l+1)=qci*dx*(1.-dy)*dz
+c cu(i,n,m+1,l+1)=qci*(1.-dx)*dy*dz
+c cu(i,n+1,m+1,l+1)=qci*dx*dy*dz
+c where n,m,l = leftmost grid points and dx = x-n, dy = y-m, dz = z-l
+c and qci = qm*pi*gami, where i = x,y,z
+c where gami = 1./sqrt(1.+sum(pi**2)*ci*ci)
+c ppart(1,n,m) = position x of particle n in tile m
+c ppart(2,n,m) = position y of particle n in tile m
+c ppart(3,n,m) = position z of particle n in tile m
+c ppart(4,n,m) = x momentum of particle n in tile m
+c ppart(5,n,m) = y momentum of particle n in tile m
+c ppart(6,n,m) = z momentum of particle n in tile m
+c cu(i,j,k,l) = ith component of current density at grid point j,k,l
+c cuh(i,j,l) = ith component of current density at edge point j of
+c tile l
+c kpic = number of particles per tile
+c qm = charge on particle, in units of e
+c dt = time interval between successive calculations
+c ci = reciprocal of velocity of light
+c nppmx = maximum number of particles in tile
+c idimp = size of phase space = 6
+c nx/ny/nz = system length in x/y/z direction
+c mx/my/mz = number of grids in sorting cell in x/y/z
+c nxv = second dimension of current array, must be >= nx+1
+c nyv = third dimension of current array, must be >= ny+1
+c nzv = fourth dimension of current array, must be >= nz+1
+c mx1 = (system length in x direction - 1)/mx + 1
+c my1 = (system length in y direction - 1)/my + 1
+c mxyz1 = mx1*my1*mz1,
+c where mz1 = (system length in z direction - 1)/mz + 1
+c ipbc = particle boundary condition = (0,1,2,3) =
+c (none,3d periodic,3d reflecting,mixed 2d reflecting/1d periodic)
+c the second dimension of cuh must be >=
+c 2*(mx+1)*(my+1) + 2*(mz-1)*(mx+my)
+      implicit none
+      integer nppmx, idimp, nx, ny, nz, mx, my, mz, nxv, nyv, nzv
+      integer mx1, my1, mxyz1, ipbc
+      real qm, dt, ci
+      real ppart, cu, cuh
+      integer kpic
+      dimension ppart(idimp,nppmx,mxyz1), cu(3,nxv,nyv,nzv)
+      dimension cuh(3,2*(mx+1)*(my+1)+2*(mz-1)*(mx+my),mxyz1)
+      dimension kpic(mxyz1)
+c local data
+      integer MXV, MYV, MZV
+      parameter(MXV=17,MYV=17,MZV=17)
+      integer mxy1, noff, moff, loff, npp, kc
+      integer i, j, k, l, nn, mm, ll, ih, ii
+      real ci2, edgelx, edgely, edgelz, edgerx, edgery, edgerz
+      real dxp, dyp, dzp, amx, amy, amz, dx1, dx, dy, dz, vx, vy, vz
+      real x, y, z, p2, gami
+      real scu
+      dimension scu(3,MXV,MYV,MZV)
+c     dimension scu(3,mx+1,my+1,mz+1)
+      mxy1 = mx1*my1
+      ci2 = ci*ci
+c set boundary values
+      edgelx = 0.0
+      edgely = 0.0
+      edgelz = 0.0
+      edgerx = real(nx)
+      edgery = real(ny)
+      edgerz = real(nz)
+      if (ipbc.eq.2) then
+         edgelx = 1.0
+         edgely = 1.0
+         edgelz = 1.0
+         edgerx = real(nx-1)
+         edgery = real(ny-1)
+         edgerz = real(nz-1)
+      else if (ipbc.eq.3) then
+         edgelx = 1.0
+         edgely = 1.0
+         edgerx = real(nx-1)
+         edgery = real(ny-1)
+      endif
+c error if local array is too small
+c     if ((mx.ge.MXV).or.(my.ge.MYV).or.(mz.ge.MZV)) return
+c first pass: deposit to interior points and save edges
+!$OMP PARALLEL DO
+!$OMP& PRIVATE(i,j,k,l,noff,moff,loff,npp,nn,mm,ll,ih,ii,x,y,z,dxp,dyp, 
+!$OMP& dzp,amx,amy,amz,dx1,dx,dy,dz,vx,vy,vz,p2,gami,scu)
+      do 150 l = 1, mxyz1
+      loff = (l - 1)/mxy1
+      k = l - mxy1*loff
+      loff = mz*loff
+      noff = (k - 1)/mx1
+      moff = my*noff
+      noff = mx*(k - mx1*noff - 1)
+      npp = kpic(l)
+c zero out local accumulator
+      do 30 k = 1, mz+1
+      do 20 j = 1, my+1
+      do 10 i = 1, mx+1
+      scu(1,i,j,k) = 0.0
+      scu(2,i,j,k) = 0.0
+      scu(3,i,j,k) = 0.0
+   10 continue
+   20 continue
+   30 continue
+c loop over particles in tile
+      do 40 j = 1, npp
+c find interpolation weights
+      x = ppart(1,j,l)
+      y = ppart(2,j,l)
+      z = ppart(3,j,l)
+      nn = x
+      mm = y
+      ll = z
+      dxp = qm*(x - real(nn))
+      dyp = y - real(mm)
+      dzp = z - real(ll)
+c find inverse gamma
+      vx = ppart(4,j,l)
+      vy = ppart(5,j,l)
+      vz = ppart(6,j,l)
+      p2 = vx*vx + vy*vy + vz*vz
+      gami = 1.0/sqrt(1.0 + p2*ci2)
+c calculate weights
+      nn = nn - noff + 1
+      mm = mm - moff + 1
+      ll = ll - loff + 1
+      amx = qm - dxp
+      amy = 1.0 - dyp
+      dx1 = dxp*dyp
+      dyp = amx*dyp
+      amx = amx*amy
+      amz = 1.0 - dzp
+      amy = dxp*amy
+c deposit current within tile to local accumulator
+      dx = amx*amz
+      dy = amy*amz
+      vx = vx*gami
+      vy = vy*gami
+      vz = vz*gami
+      scu(1,nn,mm,ll) = scu(1,nn,mm,ll) + vx*dx
+      scu(2,nn,mm,ll) = scu(2,nn,mm,ll) + vy*dx
+      scu(3,nn,mm,ll) = scu(3,nn,mm,ll) + vz*dx
+      dx = dyp*amz
+      scu(1,nn+1,mm,ll) = scu(1,nn+1,mm,ll) + vx*dy
+      scu(2,nn+1,mm,ll) = scu(2,nn+1,mm,ll) + vy*dy
+      scu(3,nn+1,mm,ll) = scu(3,nn+1,mm,ll) + vz*dy
+      dy = dx1*amz
+      scu(1,nn,mm+1,ll) = scu(1,nn,mm+1,ll) + vx*dx
+      scu(2,nn,mm+1,ll) = scu(2,nn,mm+1,ll) + vy*dx
+      scu(3,nn,mm+1,ll) = scu(3,nn,mm+1,ll) + vz*dx
+      dx = amx*dzp
+      scu(1,nn+1,mm+1,ll) = scu(1,nn+1,mm+1,ll) + vx*dy
+      scu(2,nn+1,mm+1,ll) = scu(2,nn+1,mm+1,ll) + vy*dy
+      scu(3,nn+1,mm+1,ll) = scu(3,nn+1,mm+1,ll) + vz*dy
+      dy = amy*dzp
+      scu(1,nn,mm,ll+1) = scu(1,nn,mm,ll+1) + vx*dx
+      scu(2,nn,mm,ll+1) = scu(2,nn,mm,ll+1) + vy*dx
+      scu(3,nn,mm,ll+1) = scu(3,nn,mm,ll+1) + vz*dx
+      dx = dyp*dzp
+      scu(1,nn+1,mm,ll+1) = scu(1,nn+1,mm,ll+1) + vx*dy
+      scu(2,nn+1,mm,ll+1) = scu(2,nn+1,mm,ll+1) + vy*dy
+      scu(3,nn+1,mm,ll+1) = scu(3,nn+1,mm,ll+1) + vz*dy
+      dy = dx1*dzp
+      scu(1,nn,mm+1,ll+1) = scu(1,nn,mm+1,ll+1) + vx*dx
+      scu(2,nn,mm+1,ll+1) = scu(2,nn,mm+1,ll+1) + vy*dx
+      scu(3,nn,mm+1,ll+1) = scu(3,nn,mm+1,ll+1) + vz*dx
+      scu(1,nn+1,mm+1,ll+1) = scu(1,nn+1,mm+1,ll+1) + vx*dy
+      scu(2,nn+1,mm+1,ll+1) = scu(2,nn+1,mm+1,ll+1) + vy*dy
+      scu(3,nn+1,mm+1,ll+1) = scu(3,nn+1,mm+1,ll+1) + vz*dy
+c advance position half a time-step
+      dx = x + vx*dt
+      dy = y + vy*dt
+      dz = z + vz*dt
+c reflecting boundary conditions
+      if (ipbc.eq.2) then
+         if ((dx.lt.edgelx).or.(dx.ge.edgerx)) then
+            dx = x
+            ppart(4,j,l) = -ppart(4,j,l)
+         endif
+         if ((dy.lt.edgely).or.(dy.ge.edgery)) then
+            dy = y
+            ppart(5,j,l) = -ppart(5,j,l)
+         endif
+         if ((dz.lt.edgelz).or.(dz.ge.edgerz)) then
+            dz = z
+            ppart(6,j,l) = -ppart(6,j,l)
+         endif
+c mixed reflecting/periodic boundary conditions
+      else if (ipbc.eq.3) then
+         if ((dx.lt.edgelx).or.(dx.ge.edgerx)) then
+            dx = x
+            ppart(4,j,l) = -ppart(4,j,l)
+         endif
+         if ((dy.lt.edgely).or.(dy.ge.edgery)) then
+            dy = y
+            ppart(5,j,l) = -ppart(5,j,l)
+         endif
+      endif
+c set new position
+      ppart(1,j,l) = dx
+      ppart(2,j,l) = dy
+      ppart(3,j,l) = dz
+   40 continue
+c deposit current to interior points in global array
+      nn = min(mx,nxv-noff)
+      mm = min(my,nyv-moff)
+      ll = min(mz,nzv-loff)
+      do 70 k = 2, ll
+      do 60 j = 2, mm
+      do 50 i = 2, nn
+      cu(1,i+noff,j+moff,k+loff) = cu(1,i+noff,j+moff,k+loff)           
+     1+ scu(1,i,j,k)
+      cu(2,i+noff,j+moff,k+loff) = cu(2,i+noff,j+moff,k+loff)           
+     1+ scu(2,i,j,k)
+      cu(3,i+noff,j+moff,k+loff) = cu(3,i+noff,j+moff,k+loff)           
+     1+ scu(3,i,j,k)
+   50 continue
+   60 continue
+   70 continue
+c save current at edge points in halo buffer
+      nn = min(mx+1,nxv-noff)
+      mm = min(my+1,nyv-moff)
+      ll = min(mz+1,nzv-loff)
+      ih = 0
+      do 100 k = 1, ll
+      do 90 j = 1, mm
+      ii = mx
+      if ((k.eq.1).or.(k.eq.(mz+1)).or.(j.eq.1).or.(j.eq.(my+1))) ii = 1
+      do 80 i = 1, nn, ii
+      ih = ih + 1
+      cuh(1,ih,l) = scu(1,i,j,k)
+      cuh(2,ih,l) = scu(2,i,j,k)
+      cuh(3,ih,l) = scu(3,i,j,k)
+   80 continue
+   90 continue
+  100 continue
+  150 continue
+!$OMP END PARALLEL DO
+c second pass: add edges to global array, one color at a time
+      do 200 kc = 0, 7
+!$OMP PARALLEL DO PRIVATE(i,j,k,l,noff,moff,loff,nn,mm,ll,ih,ii)
+      do 190 l = 1, mxyz1
+      loff = (l - 1)/mxy1
+      k = l - mxy1*loff
+      moff = (k - 1)/mx1
+      noff = k - mx1*moff - 1
+      if ((mod(noff,2)+2*mod(moff,2)+4*mod(loff,2)).ne.kc) go to 190
+      loff = mz*loff
+      moff = my*moff
+      noff = mx*noff
+      nn = min(mx+1,nxv-noff)
+      mm = min(my+1,nyv-moff)
+      ll = min(mz+1,nzv-loff)
+      ih = 0
+      do 180 k = 1, ll
+      do 170 j = 1, mm
+      ii = mx
+      if ((k.eq.1).or.(k.eq.(mz+1)).or.(j.eq.1).or.(j.eq.(my+1))) ii = 1
+      do 160 i = 1, nn, ii
+      ih = ih + 1
+      cu(1,i+noff,j+moff,k+loff) = cu(1,i+noff,j+moff,k+loff)           
+     1+ cuh(1,ih,l)
+      cu(2,i+noff,j+moff,k+loff) = cu(2,i+noff,j+moff,k+loff)           
+     1+ cuh(2,ih,l)
+      cu(3,i+noff,j+moff,k+loff) = cu(3,i+noff,j+moff,k+loff)           
+     1+ cuh(3,ih,l)
+  160 continue
+  170 continue
+  180 continue
+  190 continue
+!$OMP END PARALLEL DO
+  200 continue
+      return
+      end
 c-----------------------------------------------------------------------
       subroutine PPORDER3L(ppart,ppbuff,kpic,ncl,ihole,idimp,nppmx,nx,ny
      1,nz,mx,my,mz,mx1,my1,mz1,npbmx,ntmax,irc)
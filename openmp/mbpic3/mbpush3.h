@@ -71,6 +71,18 @@ void cgrjppostf3l(float ppart[], float cu[], int kpic[], int ncl[],
                   int mz, int nxv, int nyv, int nzv, int mx1, int my1,
                   int mxyz1, int ntmax, int *irc);
 
+void cgjppost3lh(float ppart[], float cu[], float cuh[], int kpic[],
+                 float qm, float dt, int nppmx, int idimp, int nx,
+                 int ny, int nz, int mx, int my, int mz, int nxv,
+                 int nyv, int nzv, int mx1, int my1, int mxyz1,
+                 int ipbc);
+
+void cgrjppost3lh(float ppart[], float cu[], float cuh[], int kpic[],
+                  float qm, float dt, float ci, int nppmx, int idimp,
+                  int nx, int ny, int nz, int mx, int my, int mz,
+                  int nxv, int nyv, int nzv, int mx1, int my1,
+                  int mxyz1, int ipbc);
+
 void cpporder3l(float ppart[], float ppbuff[], int kpic[], int ncl[],
                 int ihole[], int idimp, int nppmx, int nx, int ny,
                 int nz, int mx, int my, int mz, int mx1, int my1,
@@ -79,6 +79,18 @@ void grjppostf3l_(float *ppart, float *cu, int *kpic, int *ncl,
                   int *nzv, int *mx1, int *my1, int *mxyz1, int *ntmax,
                   int *irc);
 
+void gjppost3lh_(float *ppart, float *cu, float *cuh, int *kpic,
+                 float *qm, float *dt, int *nppmx, int *idimp, int *nx,
+                 int *ny, int *nz, int *mx, int *my, int *mz, int *nxv,
+                 int *nyv, int *nzv, int *mx1, int *my1, int *mxyz1,
+                 int *ipbc);
+
+void grjppost3lh_(float *ppart, float *cu, float *cuh, int *kpic,
+                  float *qm, float *dt, float *ci, int *nppmx,
+                  int *idimp, int *nx, int *ny, int *nz, int *mx,
+                  int *my, int *mz, int *nxv, int *nyv, int *nzv,
+                  int *mx1, int *my1, int *mxyz1, int *ipbc);
+
 void pporder3l_(float *ppart, float *ppbuff, int *kpic, int *ncl,
                 int *ihole, int *idimp, int *nppmx, int *nx, int *ny,
                 int *nz, int *mx, int *my, int *mz, int *mx1, int *my1,
@@ -301,6 +313,28 @@ void cgrjppostf3l(float ppart[], float cu[], int kpic[], int ncl[],
    return;
 }
 
+/*--------------------------------------------------------------------*/
+void cgjppost3lh(float ppart[], float cu[], float cuh[], int kpic[],
+                 float qm, float dt, int nppmx, int idimp, int nx,
+                 int ny, int nz, int mx, int my, int mz, int nxv,
+                 int nyv, int nzv, int mx1, int my1, int mxyz1,
+                 int ipbc) {
+   gjppost3lh_(ppart,cu,cuh,kpic,&qm,&dt,&nppmx,&idimp,&nx,&ny,&nz,&mx,
+               &my,&mz,&nxv,&nyv,&nzv,&mx1,&my1,&mxyz1,&ipbc);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cgrjppost3lh(float ppart[], float cu[], float cuh[], int kpic[],
+                  float qm, float dt, float ci, int nppmx, int idimp,
+                  int nx, int ny, int nz, int mx, int my, int mz,
+                  int nxv, int nyv, int nzv, int mx1, int my1,
+                  int mxyz1, int ipbc) {
+   grjppost3lh_(ppart,cu,cuh,kpic,&qm,&dt,&ci,&nppmx,&idimp,&nx,&ny,&nz,
+                &mx,&my,&mz,&nxv,&nyv,&nzv,&mx1,&my1,&mxyz1,&ipbc);
+   return;
+}
+
 /*--------------------------------------------------------------------*/
 void cpporder3l(float ppart[], float ppbuff[], int kpic[], int ncl[],
                 int ihole[], int idimp, int nppmx, int nx, int ny,
@@ -184,6 +184,36 @@
          integer, dimension(2,ntmax+1,mxyz1), intent(inout) :: ihole
          end subroutine
       end interface
+!
+      interface
+         subroutine GJPPOST3LH(ppart,cu,cuh,kpic,qm,dt,nppmx,idimp,nx,ny&
+     &,nz,mx,my,mz,nxv,nyv,nzv,mx1,my1,mxyz1,ipbc)
+         implicit none
+         integer, intent(in) :: nppmx, idimp, nx, ny, nz, mx, my, mz
+         integer, intent(in) :: nxv, nyv, nzv, mx1, my1, mxyz1, ipbc
+         real, intent(in) :: qm, dt
+         real, dimension(idimp,nppmx,mxyz1), intent(inout) :: ppart
+         real, dimension(3,nxv,nyv,nzv), intent(inout) :: cu
+         real, dimension(3,2*(mx+1)*(my+1)+2*(mz-1)*(mx+my),mxyz1),     &
+     &intent(inout) :: cuh
+         integer, dimension(mxyz1), intent(in) :: kpic
+         end subroutine
+      end interface
+!
+      interface
+         subroutine GRJPPOST3LH(ppart,cu,cuh,kpic,qm,dt,ci,nppmx,idimp, &
+     &nx,ny,nz,mx,my,mz,nxv,nyv,nzv,mx1,my1,mxyz1,ipbc)
+         implicit none
+         integer, intent(in) :: nppmx, idimp, nx, ny, nz, mx, my, mz
+         integer, intent(in) :: nxv, nyv, nzv, mx1, my1, mxyz1, ipbc
+         real, intent(in) :: qm, dt, ci
+         real, dimension(idimp,nppmx,mxyz1), intent(inout) :: ppart
+         real, dimension(3,nxv,nyv,nzv), intent(inout) :: cu
+         real, dimension(3,2*(mx+1)*(my+1)+2*(mz-1)*(mx+my),mxyz1),     &
+     &intent(inout) :: cuh
+         integer, dimension(mxyz1), intent(in) :: kpic
+         end subroutine
+      end interface
 !
       interface
          subroutine PPORDER3L(ppart,ppbuff,kpic,ncl,ihole,idimp,nppmx,nx&
@@ -0,0 +1,337 @@
+/* C Library for checkpoint and restart of 3D OpenMP PIC codes */
+/* a checkpoint file holds a header page with integer and real scalars */
+/* followed by arrays, each starting on a page boundary.  a checkpoint */
+/* is copied to a staging buffer in memory and written to disk by a    */
+/* background thread, so that the time loop can continue.  a restart  */
+/* maps the file into memory and copies each array from the mapping,   */
+/* tiled particles tile by tile, so that only the occupied part of     */
+/* each tile is read, by the thread which will later push it.          */
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include "chkpt3.h"
+
+/* nchkmax = maximum number of scalars or arrays in a checkpoint */
+#define NCHKMAX                 32
+/* npage = alignment of arrays in checkpoint file */
+#define NPAGE                   4096
+
+/* header of checkpoint file                                */
+/* magic = file identifier                                  */
+/* nis/nfs/narr = number of integer/real scalars and arrays */
+/* noff/nbytes = file offset/size in bytes of each array    */
+struct chkhead {
+   char magic[8];
+   int nis, nfs, narr, npad;
+   int isc[NCHKMAX];
+   float fsc[NCHKMAX];
+   long noff[NCHKMAX], nbytes[NCHKMAX];
+};
+
+static char chkmagic[8] = "PICCHK3";
+
+/* stage = staging buffer for checkpoint being written, kept for reuse */
+/* nstage = size of staging buffer, nfile = size of checkpoint file    */
+static char *stage = NULL;
+static long nstage = 0, nfile = 0;
+/* fchk = name of checkpoint file being written */
+static char fchk[256];
+/* lwrite = (0,1) = (no,yes) background writer is active */
+/* wrc = error code of last checkpoint written           */
+static int lwrite = 0, wrc = 0;
+static pthread_t writer;
+
+/* rmap = mapped checkpoint file being read, nrmap = its size */
+static char *rmap = NULL;
+static long nrmap = 0;
+static struct chkhead rhead;
+
+/*--------------------------------------------------------------------*/
+static void cchkptcpy(char *dst, char *src, long nbytes) {
+/* this subroutine copies nbytes from src to dst with OpenMP, in blocks
+   of npage bytes, so that each thread touches a contiguous part
+local data                                                            */
+   long j, nb, nn;
+   nb = (nbytes + NPAGE - 1)/NPAGE;
+#pragma omp parallel for private(j,nn)
+   for (j = 0; j < nb; j++) {
+      nn = nbytes - NPAGE*j;
+      nn = nn < NPAGE ? nn : NPAGE;
+      memcpy(&dst[NPAGE*j],&src[NPAGE*j],nn);
+   }
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+static void *cchkptwr(void *arg) {
+/* this function writes the staging buffer to a temporary file and
+   renames it to fchk when it is complete, so that an interrupted
+   write does not destroy the previous checkpoint
+   sets wrc = 1 if file cannot be created, 2 if write fails,
+   3 if rename fails
+local data                                                            */
+   int fd;
+   long nn;
+   ssize_t nw;
+   char ftmp[264];
+   sprintf(ftmp,"%s.tmp",fchk);
+   fd = open(ftmp,O_WRONLY|O_CREAT|O_TRUNC,0644);
+   if (fd < 0) {
+      wrc = 1;
+      return NULL;
+   }
+   nn = 0;
+   while (nn < nfile) {
+      nw = write(fd,&stage[nn],nfile-nn);
+      if (nw <= 0) {
+         wrc = 2;
+         break;
+      }
+      nn += nw;
+   }
+   if ((wrc==0) && (fsync(fd) != 0))
+      wrc = 2;
+   close(fd);
+   if ((wrc==0) && (rename(ftmp,fchk) != 0))
+      wrc = 3;
+   return NULL;
+}
+
+/*--------------------------------------------------------------------*/
+void cwchkptw3(int *irc) {
+/* this subroutine waits for the checkpoint being written by cwchkpt3
+   to finish
+   irc = error code of checkpoint written: 0 = ok, 1 = cannot create
+   file, 2 = write error, 3 = rename error
+local data                                                            */
+   if (lwrite) {
+      pthread_join(writer,NULL);
+      lwrite = 0;
+   }
+   *irc = wrc;
+   wrc = 0;
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cwchkpt3(char *fname, int nis, int isc[], int nfs, float fsc[],
+              int narr, void *arr[], long nbytes[], int *irc) {
+/* this subroutine writes a checkpoint file in the background.
+   it first waits for the previous checkpoint to be written, then
+   copies the scalars and arrays to a staging buffer with OpenMP, and
+   starts a thread which writes the buffer to file fname.
+   the arrays may be modified as soon as this subroutine returns
+   input: all, output: irc
+   fname = name of checkpoint file
+   nis/nfs = number of integer/real scalars, <= 32
+   isc/fsc = integer/real scalars
+   narr = number of arrays, <= 32
+   arr[n] = pointer to array n
+   nbytes[n] = size of array n in bytes
+   irc = error code: 0 = ok, 1-3 = error in previous checkpoint,
+   as returned by cwchkptw3, 4 = too many scalars or arrays,
+   5 = staging buffer allocation error
+local data                                                            */
+   int n;
+   long noff;
+   struct chkhead *head;
+/* wait for previous checkpoint */
+   cwchkptw3(irc);
+   if (*irc != 0)
+      return;
+   if ((nis > NCHKMAX) || (nfs > NCHKMAX) || (narr > NCHKMAX)
+      || (strlen(fname) > 255)) {
+      *irc = 4;
+      return;
+   }
+/* find layout of file */
+   noff = NPAGE;
+   for (n = 0; n < narr; n++) {
+      noff += NPAGE*((nbytes[n] + NPAGE - 1)/NPAGE);
+   }
+   nfile = noff;
+/* allocate staging buffer */
+   if (nfile > nstage) {
+      free(stage);
+      stage = (char *) malloc(nfile);
+      if (stage==NULL) {
+         nstage = 0;
+         *irc = 5;
+         return;
+      }
+      nstage = nfile;
+   }
+/* copy header */
+   memset(stage,0,NPAGE);
+   head = (struct chkhead *) stage;
+   memcpy(head->magic,chkmagic,8);
+   head->nis = nis;
+   head->nfs = nfs;
+   head->narr = narr;
+   for (n = 0; n < nis; n++) {
+      head->isc[n] = isc[n];
+   }
+   for (n = 0; n < nfs; n++) {
+      head->fsc[n] = fsc[n];
+   }
+/* copy arrays, padding each to a page boundary */
+   noff = NPAGE;
+   for (n = 0; n < narr; n++) {
+      head->noff[n] = noff;
+      head->nbytes[n] = nbytes[n];
+      cchkptcpy(&stage[noff],(char *) arr[n],nbytes[n]);
+      memset(&stage[noff+nbytes[n]],0,
+             NPAGE*((nbytes[n] + NPAGE - 1)/NPAGE) - nbytes[n]);
+      noff += NPAGE*((nbytes[n] + NPAGE - 1)/NPAGE);
+   }
+/* start writer thread, or write synchronously if it cannot start */
+   strcpy(fchk,fname);
+   wrc = 0;
+   if (pthread_create(&writer,NULL,cchkptwr,NULL)==0) {
+      lwrite = 1;
+   }
+   else {
+      cchkptwr(NULL);
+      *irc = wrc;
+      wrc = 0;
+   }
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void crchkpth3(char *fname, int nis, int isc[], int nfs, float fsc[],
+               int *irc) {
+/* this subroutine maps checkpoint file fname into memory and reads
+   the scalars.  the arrays are read afterwards by crchkpta3 and
+   crchkptp3, and the file is unmapped by crchkptc3
+   input: fname, nis, nfs, output: isc, fsc, irc
+   fname = name of checkpoint file
+   nis/nfs = number of integer/real scalars expected
+   isc/fsc = integer/real scalars
+   irc = error code: 0 = ok, 1 = cannot open file, 2 = not a valid
+   checkpoint file, or wrong number of scalars
+local data                                                            */
+   int n, fd;
+   struct stat fst;
+   void *map;
+   fd = open(fname,O_RDONLY);
+   if (fd < 0) {
+      *irc = 1;
+      return;
+   }
+   if ((fstat(fd,&fst) != 0) || (fst.st_size < NPAGE)) {
+      close(fd);
+      *irc = 2;
+      return;
+   }
+/* pages are read on demand by the threads which copy them */
+   nrmap = fst.st_size;
+   map = mmap(NULL,nrmap,PROT_READ,MAP_PRIVATE,fd,0);
+   close(fd);
+   if (map==MAP_FAILED) {
+      nrmap = 0;
+      *irc = 1;
+      return;
+   }
+   rmap = (char *) map;
+   memcpy(&rhead,rmap,sizeof(struct chkhead));
+   if ((memcmp(rhead.magic,chkmagic,8) != 0) || (rhead.nis != nis)
+      || (rhead.nfs != nfs) || (rhead.narr > NCHKMAX)) {
+      crchkptc3();
+      *irc = 2;
+      return;
+   }
+   for (n = 0; n < rhead.narr; n++) {
+      if ((rhead.noff[n] + rhead.nbytes[n]) > nrmap) {
+         crchkptc3();
+         *irc = 2;
+         return;
+      }
+   }
+   for (n = 0; n < nis; n++) {
+      isc[n] = rhead.isc[n];
+   }
+   for (n = 0; n < nfs; n++) {
+      fsc[n] = rhead.fsc[n];
+   }
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void crchkpta3(int n, void *arr, long nbytes, int *irc) {
+/* this subroutine copies array n from the checkpoint file mapped by
+   crchkpth3 with OpenMP
+   input: n, nbytes, output: arr, irc
+   n = array number in checkpoint file, starting with 0
+   arr = array to be read
+   nbytes = size of array in bytes
+   irc = error code: 0 = ok, 3 = array not found or wrong size
+local data                                                            */
+   if ((rmap==NULL) || (n >= rhead.narr)
+      || (rhead.nbytes[n] != nbytes)) {
+      *irc = 3;
+      return;
+   }
+   cchkptcpy((char *) arr,&rmap[rhead.noff[n]],nbytes);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void crchkptp3(int n, float ppart[], int kpic[], int idimp, int nppmx,
+               int mxyz1, int *irc) {
+/* this subroutine copies tiled particle array n from the checkpoint
+   file mapped by crchkpth3, in the same tile order as the particle
+   procedures, so that no reordering is needed.  only the kpic[l]
+   particles in tile l are copied, so that the unused part of the
+   tiles is never read
+   input: all except ppart, irc, output: ppart, irc
+   n = array number in checkpoint file, starting with 0
+   ppart[l][j][i] = tiled particle array
+   kpic = number of particles per tile, read previously
+   idimp = size of phase space = 6
+   nppmx = maximum number of particles in tile
+   mxyz1 = number of tiles
+   irc = error code: 0 = ok, 3 = array not found or wrong size,
+   tile overflow
+local data                                                            */
+   int l, npp, ierr;
+   long noff;
+   float *src;
+   if ((rmap==NULL) || (n >= rhead.narr)
+      || (rhead.nbytes[n] != sizeof(float)*idimp*nppmx*(long) mxyz1)) {
+      *irc = 3;
+      return;
+   }
+   src = (float *) &rmap[rhead.noff[n]];
+   ierr = 0;
+#pragma omp parallel for private(l,npp,noff) reduction(+:ierr)
+   for (l = 0; l < mxyz1; l++) {
+      npp = kpic[l];
+      noff = idimp*nppmx*(long) l;
+      if ((npp < 0) || (npp > nppmx))
+         ierr += 1;
+      else
+         memcpy(&ppart[noff],&src[noff],sizeof(float)*idimp*npp);
+   }
+   if (ierr > 0)
+      *irc = 3;
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void crchkptc3() {
+/* this subroutine unmaps the checkpoint file mapped by crchkpth3 */
+   if (rmap != NULL)
+      munmap(rmap,nrmap);
+   rmap = NULL;
+   nrmap = 0;
+   return;
+}
@@ -7,6 +7,7 @@
 #include <sys/time.h>
 #include "mdpush3.h"
 #include "omplib.h"
+#include "chkpt3.h"
 
 void dtimer(double *time, struct timeval *itime, int icntrl);
 
@@ -44,6 +45,11 @@ int main(int argc, char *argv[]) {
    int mx = 8, my = 8, mz = 8;
 /* xtras = fraction of extra particles needed for particle management */
    float xtras = 0.2;
+/* nchkpt = number of time steps between checkpoints, 0 = none */
+   int nchkpt = 0;
+/* lrestart = (0,1) = (no,yes) restart from checkpoint file fchkpt */
+   int lrestart = 0;
+   char fchkpt[] = "chkpt3.dat";
 /* declare scalars for standard code */
    int j, k;
    int np, nx, ny, nz, nxh, nyh, nzh, nxe, nye, nze, nxeh;
@@ -85,11 +91,20 @@ int main(int argc, char *argv[]) {
 /* ihole = location/destination of each particle departing tile */
    int *kpic = NULL, *ncl = NULL, *ihole = NULL;
 
+/* declare checkpoint data */
+/* isc/fsc = integer/real scalars in checkpoint */
+   int isc[11];
+   float fsc[6];
+/* carr = arrays in checkpoint, nbytes = their sizes in bytes */
+   void *carr[5];
+   long nbytes[5];
+
 /* declare and initialize timing data */
    float time;
    struct timeval itime;
    float tdpost = 0.0, tguard = 0.0, tfft = 0.0, tfield = 0.0;
    float tdjpost = 0.0, tdcjpost = 0.0, tpush = 0.0, tsort = 0.0;
+   float tchkpt = 0.0;
    double dtime;
 
    irc = 0;
@@ -142,31 +157,71 @@ int main(int argc, char *argv[]) {
    isign = 0;
    cmpois33((float complex *)qe,(float complex *)fxyze,isign,ffc,ax,ay,
             az,affp,&we,nx,ny,nz,nxeh,nye,nze,nxh,nyh,nzh);
+/* restart: read scalars from checkpoint file: updates isc, fsc */
+   if (lrestart==1) {
+      crchkpth3(fchkpt,11,isc,6,fsc,&irc);
+      if (irc != 0) {
+         printf("crchkpth3 error: irc=%d\n",irc);
+         exit(1);
+      }
+      if ((isc[4] != np) || (isc[5] != nx) || (isc[6] != ny)
+         || (isc[7] != nz) || (isc[8] != mx) || (isc[9] != my)
+         || (isc[10] != mz)) {
+         printf("checkpoint does not match: np,nx,ny,nz,mx,my,mz=%d,\
+%d,%d,%d,%d,%d,%d\n",isc[4],isc[5],isc[6],isc[7],isc[8],isc[9],
+                isc[10]);
+         exit(1);
+      }
+      ntime = isc[0]; nppmx0 = isc[1]; npbmx = isc[2]; ntmax = isc[3];
+      we = fsc[0]; wf = fsc[1]; wm = fsc[2]; wke = fsc[3];
+      wpm = fsc[4]; q2m0 = fsc[5];
+   }
+   else {
 /* initialize electrons */
-   cdistr3(part,vtx,vty,vtz,vx0,vy0,vz0,npx,npy,npz,idimp,np,nx,ny,nz,
-           ipbc);
-
+      cdistr3(part,vtx,vty,vtz,vx0,vy0,vz0,npx,npy,npz,idimp,np,nx,ny,
+              nz,ipbc);
 /* find number of particles in each of mx, my, mz tiles: */
 /* updates kpic, nppmx */
-   cdblkp3l(part,kpic,&nppmx,idimp,np,mx,my,mz,mx1,my1,mxyz1,&irc);
-   if (irc != 0) { 
-      printf("cdblkp3l error, irc=%d\n",irc);
-      exit(1);
+      cdblkp3l(part,kpic,&nppmx,idimp,np,mx,my,mz,mx1,my1,mxyz1,&irc);
+      if (irc != 0) { 
+         printf("cdblkp3l error, irc=%d\n",irc);
+         exit(1);
+      }
+      nppmx0 = (1.0 + xtras)*nppmx;
+      ntmax = xtras*nppmx;
+      npbmx = xtras*nppmx;
    }
 /* allocate vector particle data */
-   nppmx0 = (1.0 + xtras)*nppmx;
-   ntmax = xtras*nppmx;
-   npbmx = xtras*nppmx;
    ppart = (float *) malloc(idimp*nppmx0*mxyz1*sizeof(float));
    ppbuff = (float *) malloc(idimp*npbmx*mxyz1*sizeof(float));
    ncl = (int *) malloc(26*mxyz1*sizeof(int));
    ihole = (int *) malloc(2*(ntmax+1)*mxyz1*sizeof(int));
+/* restart: copy tiled particles and fields from checkpoint file: */
+/* updates kpic, ppart, cus, exyze, bxyze                         */
+   if (lrestart==1) {
+      crchkpta3(0,kpic,sizeof(int)*mxyz1,&irc);
+      if (irc==0)
+         crchkptp3(1,ppart,kpic,idimp,nppmx0,mxyz1,&irc);
+      if (irc==0)
+         crchkpta3(2,cus,sizeof(float)*ndim*nxe*nye*nze,&irc);
+      if (irc==0)
+         crchkpta3(3,exyze,sizeof(float)*ndim*nxe*nye*nze,&irc);
+      if (irc==0)
+         crchkpta3(4,bxyze,sizeof(float)*ndim*nxe*nye*nze,&irc);
+      crchkptc3();
+      if (irc != 0) {
+         printf("crchkpt3 error: irc=%d\n",irc);
+         exit(1);
+      }
+   }
 /* copy ordered particle data for OpenMP: updates ppart and kpic */
-   cppmovin3l(part,ppart,kpic,nppmx0,idimp,np,mx,my,mz,mx1,my1,mxyz1,
-              &irc);
-   if (irc != 0) { 
-      printf("cppmovin3l overflow error, irc=%d\n",irc);
-      exit(1);
+   else {
+      cppmovin3l(part,ppart,kpic,nppmx0,idimp,np,mx,my,mz,mx1,my1,
+                 mxyz1,&irc);
+      if (irc != 0) { 
+         printf("cppmovin3l overflow error, irc=%d\n",irc);
+         exit(1);
+      }
    }
 /* sanity check */
    cppcheck3l(ppart,kpic,idimp,nppmx0,nx,ny,nz,mx,my,mz,mx1,my1,mz1,
@@ -177,27 +232,32 @@ int main(int argc, char *argv[]) {
    }
 
 /* find maximum and minimum initial electron density */
-   for (j = 0; j < nxe*nye*nze; j++) {
-      qe[j] = 0.0;
-   }
-   cgppost3l(ppart,qe,kpic,qme,nppmx0,idimp,mx,my,mz,nxe,nye,nze,mx1,my1,
-             mxyz1);
-   caguard3l(qe,nx,ny,nz,nxe,nye,nze);
-   cfwpminmx3(qe,qbme,&wpmax,&wpmin,nx,ny,nz,nxe,nye,nze);
-   wpm = 0.5*(wpmax + wpmin)*affp;
+/* on restart, wpm and q2m0 were read from checkpoint file */
+   if (lrestart==0) {
+      for (j = 0; j < nxe*nye*nze; j++) {
+         qe[j] = 0.0;
+      }
+      cgppost3l(ppart,qe,kpic,qme,nppmx0,idimp,mx,my,mz,nxe,nye,nze,
+                mx1,my1,mxyz1);
+      caguard3l(qe,nx,ny,nz,nxe,nye,nze);
+      cfwpminmx3(qe,qbme,&wpmax,&wpmin,nx,ny,nz,nxe,nye,nze);
+      wpm = 0.5*(wpmax + wpmin)*affp;
 /* accelerate convergence: update wpm */
-   if (wpm <= 10.0)
-      wpm = 0.75*wpm;
+      if (wpm <= 10.0)
+         wpm = 0.75*wpm;
+      q2m0 = wpm/affp;
+   }
    printf("wpm=%f\n",wpm);
-   q2m0 = wpm/affp;
 /* calculate form factor: ffe */
    isign = 0;
    cmepois33((float complex *)dcu,(float complex *)cus,isign,ffe,ax,ay,
              az,affp,wpm,ci,&wf,nx,ny,nz,nxeh,nye,nze,nxh,nyh,nzh);
 
 /* initialize transverse electric field */
-   for (j = 0; j < ndim*nxe*nye*nze; j++) {
-      cus[j] = 0.0;
+   if (lrestart==0) {
+      for (j = 0; j < ndim*nxe*nye*nze; j++) {
+         cus[j] = 0.0;
+      }
    }
 
 /* * * * start main iteration loop * * * */
@@ -580,11 +640,41 @@ Field Energies:\n");
          printf("%e %e %e\n",we,wf,wm);
       }
       ntime += 1;
+
+/* write checkpoint in the background */
+      if ((nchkpt > 0) && (ntime%nchkpt==0)) {
+         dtimer(&dtime,&itime,-1);
+         isc[0] = ntime; isc[1] = nppmx0; isc[2] = npbmx;
+         isc[3] = ntmax; isc[4] = np; isc[5] = nx; isc[6] = ny;
+         isc[7] = nz; isc[8] = mx; isc[9] = my; isc[10] = mz;
+         fsc[0] = we; fsc[1] = wf; fsc[2] = wm; fsc[3] = wke;
+         fsc[4] = wpm; fsc[5] = q2m0;
+         carr[0] = kpic; nbytes[0] = sizeof(int)*mxyz1;
+         carr[1] = ppart; nbytes[1] = sizeof(float)*idimp*nppmx0*mxyz1;
+         carr[2] = cus; nbytes[2] = sizeof(float)*ndim*nxe*nye*nze;
+         carr[3] = exyze; nbytes[3] = sizeof(float)*ndim*nxe*nye*nze;
+         carr[4] = bxyze; nbytes[4] = sizeof(float)*ndim*nxe*nye*nze;
+         cwchkpt3(fchkpt,11,isc,6,fsc,5,carr,nbytes,&irc);
+         dtimer(&dtime,&itime,1);
+         time = (float) dtime;
+         tchkpt += time;
+         if (irc != 0) {
+            printf("%d,cwchkpt3 error: irc=%d\n",ntime,irc);
+            irc = 0;
+         }
+      }
       goto L500;
 L2000:
 
 /* * * * end main iteration loop * * * */
 
+/* wait for last checkpoint to be written */
+   if (nchkpt > 0) {
+      cwchkptw3(&irc);
+      if (irc != 0)
+         printf("cwchkptw3 error: irc=%d\n",irc);
+   }
+
    printf("ntime, ndc = %i,%i\n",ntime,ndc);
    wt = we + wm;
    printf("Final Total Field, Kinetic and Total Energies:\n");
@@ -604,6 +694,8 @@ Energies:\n");
    printf("fft time = %f\n",tfft);
    printf("push time = %f\n",tpush);
    printf("sort time = %f\n",tsort);
+   if (nchkpt > 0)
+      printf("checkpoint time = %f\n",tchkpt);
    tfield += tguard + tfft;
    printf("total solver time = %f\n",tfield);
    time = tdpost + tpush + tsort;
@@ -0,0 +1,131 @@
+/*---------------------------------------------------------------------*/
+/* Benchmark for y part of 2D real to complex OpenMP FFTs, which       */
+/* compares the strided transforms (cfft2rmxy, cfft2rm2y) with the     */
+/* cache-blocked transposed transforms (cfft2rmxyb, cfft2rm2yb), for   */
+/* several grid sizes, to find the crossover used in cwfft2rmx and     */
+/* cwfft2rm2                                                           */
+#include <stdlib.h>
+#include <stdio.h>
+#include <complex.h>
+#include <math.h>
+#include <sys/time.h>
+#include "mpush2.h"
+#include "omplib.h"
+
+void dtimer(double *time, struct timeval *itime, int icntrl);
+
+int main(int argc, char *argv[]) {
+/* indmin/indmax = smallest/largest exponents tested, nx = ny = 2**ind */
+   int indmin = 6, indmax = 12;
+/* nrep = number of times each inverse/forward pair is repeated */
+   int nrep = 10;
+/* declare scalars for standard code */
+   int i, j, l, indx, indy, isign;
+   int nx, ny, nxh, nxe, nye, nxeh, nxyh, nxhy, nxy;
+   float fmax, dmax, anorm;
+/* declare scalars for OpenMP code */
+   int nvp;
+/* fa/fb = data transformed with strided/blocked y transforms */
+   float complex *fa = NULL, *fb = NULL;
+/* mixup = bit reverse table for FFT */
+   int *mixup = NULL;
+/* sct = sine/cosine table for FFT */
+   float complex *sct = NULL;
+/* declare and initialize timing data */
+   float ta, tb, tc, td;
+   struct timeval itime;
+   double dtime;
+
+/* nvp = number of shared memory nodes  (0=default) */
+   nvp = 0;
+/* initialize for shared memory parallel processing */
+   cinit_omp(nvp);
+
+   printf("grid        1d strided  1d blocked   2d strided  2d blocked");
+   printf("   max rel. difference\n");
+   printf("                    (msec per inverse/forward pair)\n");
+/* loop over grid sizes */
+   for (l = indmin; l <= indmax; l++) {
+      indx = l; indy = l;
+      nx = 1L<<indx; ny = 1L<<indy; nxh = nx/2;
+      nxe = nx + 2; nye = ny + 1; nxeh = nxe/2;
+      nxy = nx > ny ? nx : ny;
+      nxyh = nxy/2;
+      nxhy = nxh > ny ? nxh : ny;
+      fa = (float complex *) malloc(2*nxeh*nye*sizeof(float complex));
+      fb = (float complex *) malloc(2*nxeh*nye*sizeof(float complex));
+      mixup = (int *) malloc(nxhy*sizeof(int));
+      sct = (float complex *) malloc(nxyh*sizeof(float complex));
+      cwfft2rinit(mixup,sct,indx,indy,nxhy,nxyh);
+      anorm = 1.0/(float) ny;
+/* initialize data */
+      for (j = 0; j < 2*nxeh*nye; j++) {
+         fa[j] = sinf(0.37*(float) j) + cosf(0.11*(float) j)*_Complex_I;
+         fb[j] = fa[j];
+      }
+/* scalar transforms */
+      ta = 0.0;
+      tb = 0.0;
+      for (i = 0; i < nrep; i++) {
+         for (isign = -1; isign <= 1; isign += 2) {
+            dtimer(&dtime,&itime,-1);
+            cfft2rmxy(fa,isign,mixup,sct,indx,indy,1,nxh,nxeh,nye,nxhy,
+                      nxyh);
+            dtimer(&dtime,&itime,1);
+            ta += (float) dtime;
+            dtimer(&dtime,&itime,-1);
+            cfft2rmxyb(fb,isign,mixup,sct,indx,indy,1,nxh,nxeh,nye,nxhy,
+                       nxyh);
+            dtimer(&dtime,&itime,1);
+            tb += (float) dtime;
+         }
+/* normalize to keep data bounded */
+         for (j = 0; j < 2*nxeh*nye; j++) {
+            fa[j] = anorm*fa[j];
+            fb[j] = anorm*fb[j];
+         }
+      }
+/* 2 component vector transforms */
+      tc = 0.0;
+      td = 0.0;
+      for (i = 0; i < nrep; i++) {
+         for (isign = -1; isign <= 1; isign += 2) {
+            dtimer(&dtime,&itime,-1);
+            cfft2rm2y(fa,isign,mixup,sct,indx,indy,1,nxh,nxeh,nye,nxhy,
+                      nxyh);
+            dtimer(&dtime,&itime,1);
+            tc += (float) dtime;
+            dtimer(&dtime,&itime,-1);
+            cfft2rm2yb(fb,isign,mixup,sct,indx,indy,1,nxh,nxeh,nye,nxhy,
+                       nxyh);
+            dtimer(&dtime,&itime,1);
+            td += (float) dtime;
+         }
+/* normalize to keep data bounded */
+         for (j = 0; j < 2*nxeh*nye; j++) {
+            fa[j] = anorm*fa[j];
+            fb[j] = anorm*fb[j];
+         }
+      }
+/* compare results */
+      fmax = 0.0; dmax = 0.0;
+      for (j = 0; j < 2*nxeh*nye; j++) {
+         fmax = cabsf(fa[j]) > fmax ? cabsf(fa[j]) : fmax;
+         dmax = cabsf(fa[j]-fb[j]) > dmax ? cabsf(fa[j]-fb[j]) : dmax;
+      }
+      if (fmax > 0.0)
+         dmax = dmax/fmax;
+      ta = 1.0e+03*ta/(float) nrep;
+      tb = 1.0e+03*tb/(float) nrep;
+      tc = 1.0e+03*tc/(float) nrep;
+      td = 1.0e+03*td/(float) nrep;
+      printf("%5dx%-5d %10.4f  %10.4f   %10.4f  %10.4f   %e\n",nx,ny,ta,
+             tb,tc,td,dmax);
+      free(sct);
+      free(mixup);
+      free(fb);
+      free(fa);
+   }
+
+   return 0;
+}
@@ -0,0 +1,134 @@
+/*---------------------------------------------------------------------*/
+/* Benchmark for 2D Electrostatic OpenMP charge deposit, which compares */
+/* updating tile edges with atomic operations (cgppost2l) and with a    */
+/* halo buffer (cgppost2lh), for several tile sizes                     */
+#include <stdlib.h>
+#include <stdio.h>
+#include <complex.h>
+#include <math.h>
+#include <sys/time.h>
+#include "mpush2.h"
+#include "omplib.h"
+
+void dtimer(double *time, struct timeval *itime, int icntrl);
+
+int main(int argc, char *argv[]) {
+/* indx/indy = exponent which determines grid points in x/y direction: */
+/* nx = 2**indx, ny = 2**indy */
+   int indx =   9, indy =   9;
+/* npx/npy = number of electrons distributed in x/y direction */
+   int npx =  3072, npy =   3072;
+/* qme = charge on electron, in units of e */
+   float qme = -1.0;
+/* vtx/vty = thermal velocity of electrons in x/y direction */
+/* vx0/vy0 = drift velocity of electrons in x/y direction */
+   float vtx = 1.0, vty = 1.0, vx0 = 0.0, vy0 = 0.0;
+/* idimp = number of particle coordinates = 4 */
+/* ipbc = particle boundary condition: 1 = periodic */
+   int idimp = 4, ipbc = 1;
+/* ntile = number of tile sizes tested, mxs = tile sizes */
+   int ntile = 4;
+   int mxs[4] = {8,16,32,64};
+/* nrep = number of times each deposit is repeated */
+   int nrep = 10;
+/* xtras = fraction of extra particles needed for particle management */
+   float xtras = 0.2;
+/* declare scalars for standard code */
+   int i, j, l;
+   int np, nx, ny, nxe, nye, mx, my, mx1, my1, mxy1;
+   float qmax, dmax;
+/* declare scalars for OpenMP code */
+   int nppmx, nppmx0, irc;
+   int nvp;
+/* part = original particle array */
+   float *part = NULL;
+/* qa/qb = charge density from atomic/halo buffer deposits */
+   float *qa = NULL, *qb = NULL;
+/* ppart = tiled particle array, qh = charge density on tile edges */
+   float *ppart = NULL, *qh = NULL;
+/* kpic = number of particles in each tile */
+   int *kpic = NULL;
+/* declare and initialize timing data */
+   float ta, tb;
+   struct timeval itime;
+   double dtime;
+
+   irc = 0;
+/* nvp = number of shared memory nodes  (0=default) */
+   nvp = 0;
+/* initialize for shared memory parallel processing */
+   cinit_omp(nvp);
+
+/* initialize scalars for standard code */
+   np = npx*npy; nx = 1L<<indx; ny = 1L<<indy;
+   nxe = nx + 2; nye = ny + 1;
+   part = (float *) malloc(idimp*np*sizeof(float));
+   qa = (float *) malloc(nxe*nye*sizeof(float));
+   qb = (float *) malloc(nxe*nye*sizeof(float));
+/* initialize electrons */
+   cdistr2(part,vtx,vty,vx0,vy0,npx,npy,idimp,np,nx,ny,ipbc);
+
+   printf("tile   atomic (nsec)   halo (nsec)   max rel. difference\n");
+/* loop over tile sizes */
+   for (l = 0; l < ntile; l++) {
+      mx = mxs[l]; my = mxs[l];
+      mx1 = (nx - 1)/mx + 1; my1 = (ny - 1)/my + 1; mxy1 = mx1*my1;
+      kpic = (int *) malloc(mxy1*sizeof(int));
+      qh = (float *) malloc(2*(mx+my)*mxy1*sizeof(float));
+/* find number of particles in each of mx, my tiles: */
+/* updates kpic, nppmx */
+      cdblkp2l(part,kpic,&nppmx,idimp,np,mx,my,mx1,mxy1,&irc);
+      if (irc != 0) {
+         printf("cdblkp2l error, irc=%d\n",irc);
+         exit(1);
+      }
+      nppmx0 = (1.0 + xtras)*nppmx;
+      ppart = (float *) malloc(idimp*nppmx0*mxy1*sizeof(float));
+/* copy ordered particle data for OpenMP: updates ppart and kpic */
+      cppmovin2l(part,ppart,kpic,nppmx0,idimp,np,mx,my,mx1,mxy1,&irc);
+      if (irc != 0) {
+         printf("cppmovin2l overflow error, irc=%d\n",irc);
+         exit(1);
+      }
+/* deposit with atomic updates of tile edges */
+      ta = 0.0;
+      for (i = 0; i < nrep; i++) {
+         for (j = 0; j < nxe*nye; j++) {
+            qa[j] = 0.0;
+         }
+         dtimer(&dtime,&itime,-1);
+         cgppost2l(ppart,qa,kpic,qme,nppmx0,idimp,mx,my,nxe,nye,mx1,
+                   mxy1);
+         dtimer(&dtime,&itime,1);
+         ta += (float) dtime;
+      }
+/* deposit with halo buffer for tile edges */
+      tb = 0.0;
+      for (i = 0; i < nrep; i++) {
+         for (j = 0; j < nxe*nye; j++) {
+            qb[j] = 0.0;
+         }
+         dtimer(&dtime,&itime,-1);
+         cgppost2lh(ppart,qb,qh,kpic,qme,nppmx0,idimp,mx,my,nxe,nye,
+                    mx1,mxy1);
+         dtimer(&dtime,&itime,1);
+         tb += (float) dtime;
+      }
+/* compare results */
+      qmax = 0.0; dmax = 0.0;
+      for (j = 0; j < nxe*nye; j++) {
+         qmax = fabsf(qa[j]) > qmax ? fabsf(qa[j]) : qmax;
+         dmax = fabsf(qa[j]-qb[j]) > dmax ? fabsf(qa[j]-qb[j]) : dmax;
+      }
+      if (qmax > 0.0)
+         dmax = dmax/qmax;
+      ta = 1.0e+09*ta/((float) nrep*(float) np);
+      tb = 1.0e+09*tb/((float) nrep*(float) np);
+      printf("%4d   %13.6f   %11.6f   %e\n",mx,ta,tb,dmax);
+      free(ppart);
+      free(qh);
+      free(kpic);
+   }
+
+   return 0;
+}
@@ -0,0 +1,16 @@
+/* header file for chkpt2.c */
+
+void cwchkptw2(int *irc);
+
+void cwchkpt2(char *fname, int nis, int isc[], int nfs, float fsc[],
+              int narr, void *arr[], long nbytes[], int *irc);
+
+void crchkpth2(char *fname, int nis, int isc[], int nfs, float fsc[],
+               int *irc);
+
+void crchkpta2(int n, void *arr, long nbytes, int *irc);
+
+void crchkptp2(int n, float ppart[], int kpic[], int idimp, int nppmx,
+               int mxy1, int kpl, int *irc);
+
+void crchkptc2();
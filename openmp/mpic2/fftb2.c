@@ -0,0 +1,292 @@
+/* C Library for 2D real to complex FFT backends */
+/* the built-in OpenMP FFT in mpush2.c is the default backend, an      */
+/* optional backend uses a locally installed FFTW3 library, enabled by */
+/* compiling this file with -DFFTW and linking with -lfftw3f_omp       */
+/* -lfftw3f.  FFTW plans are created once by cwfft2binit and reused by */
+/* every transform until cwfft2bdel is called.                         */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <complex.h>
+#include "mpush2.h"
+#include "fftb2.h"
+#ifdef FFTW
+#include <fftw3.h>
+#include <omp.h>
+#endif
+
+/* kfftb = (1,2) = current backend = (built-in,FFTW) */
+static int kfftb = 1;
+
+#ifdef FFTW
+/* planrx/planxr = plans for scalar real to complex/complex to real ffts */
+/* planrxn/planxrn = plans for 2 component vector ffts                   */
+static fftwf_plan planrx = NULL, planxr = NULL;
+static fftwf_plan planrxn = NULL, planxrn = NULL;
+/* fbuf = scratch array holding unpacked fourier coefficients */
+static float complex *fbuf = NULL;
+/* grid sizes and dimensions used when the plans were created */
+static int nxb = 0, nyb = 0, nxhdb = 0;
+
+/*--------------------------------------------------------------------*/
+static void cfftw2pack(float complex f[], float complex g[], int ndim,
+                       int nx, int ny, int nxhd) {
+/* this subroutine copies fourier coefficients from the unpacked layout
+   of the fftw real to complex transform in g to the packed layout used
+   by the spectral field solvers in f, and normalizes them
+   g[n][k][j] = mode j,k of component n, where 0 <= j <= nx/2
+   f[k][j][n] = mode j,k of component n, where 0 <= j < nx/2, except
+   for f[k][0][n] = mode nx/2,k, where ny/2+1 <= k < ny, and
+   imag(f[0][0][n]) = real part of mode nx/2,0 and
+   imag(f[ny/2][0][n]) = real part of mode nx/2,ny/2
+   ndim = number of components
+   nx/ny = system length in x/y direction
+   nxhd = second dimension of f >= nx/2
+local data                                                            */
+   int nxh, nyh, nxh1, j, k, n, koff, noff;
+   float ani;
+   nxh = nx/2;
+   nyh = ny/2;
+   nxh1 = nxh + 1;
+   ani = 1.0/((float) nx*(float) ny);
+#pragma omp parallel for private(j,k,n,koff,noff)
+   for (k = 0; k < ny; k++) {
+      koff = ndim*nxhd*k;
+      for (n = 0; n < ndim; n++) {
+         noff = nxh1*(k + ny*n);
+         for (j = 1; j < nxh; j++) {
+            f[n+ndim*j+koff] = ani*g[j+noff];
+         }
+/* modes kx = 0, nx/2 */
+         if ((k==0) || (k==nyh)) {
+            f[n+koff] = ani*(crealf(g[noff])
+                             + crealf(g[nxh+noff])*_Complex_I);
+         }
+         else if (k < nyh) {
+            f[n+koff] = ani*g[noff];
+         }
+         else {
+            f[n+koff] = ani*g[nxh+noff];
+         }
+      }
+   }
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+static void cfftw2unpack(float complex f[], float complex g[], int ndim,
+                         int nx, int ny, int nxhd) {
+/* this subroutine copies fourier coefficients from the packed layout
+   used by the spectral field solvers in f to the unpacked layout of
+   the fftw complex to real transform in g
+   layouts of f and g are as described in cfftw2pack
+   ndim = number of components
+   nx/ny = system length in x/y direction
+   nxhd = second dimension of f >= nx/2
+local data                                                            */
+   int nxh, nyh, nxh1, j, k, k1, n, koff, k1off, noff, n1off;
+   nxh = nx/2;
+   nyh = ny/2;
+   nxh1 = nxh + 1;
+#pragma omp parallel for private(j,k,k1,n,koff,k1off,noff,n1off)
+   for (k = 0; k < ny; k++) {
+      koff = ndim*nxhd*k;
+      k1 = ny - k;
+      k1off = ndim*nxhd*k1;
+      for (n = 0; n < ndim; n++) {
+         noff = nxh1*(k + ny*n);
+         for (j = 1; j < nxh; j++) {
+            g[j+noff] = f[n+ndim*j+koff];
+         }
+/* modes kx = 0, nx/2 */
+         if ((k==0) || (k==nyh)) {
+            g[noff] = crealf(f[n+koff]);
+            g[nxh+noff] = cimagf(f[n+koff]);
+         }
+         else if (k < nyh) {
+            n1off = nxh1*(k1 + ny*n);
+            g[noff] = f[n+koff];
+            g[n1off] = conjf(f[n+koff]);
+            g[nxh+noff] = conjf(f[n+k1off]);
+            g[nxh+n1off] = f[n+k1off];
+         }
+      }
+   }
+   return;
+}
+#endif
+
+/*--------------------------------------------------------------------*/
+void cwfft2binit(int kfft, int indx, int indy, int nxhd, int nyd,
+                 int *irc) {
+/* this subroutine selects the backend used by cwfft2bx and cwfft2b2,
+   and for the fftw backend, creates the fftw plans
+   kfft = (1,2) = requested backend = (built-in,FFTW)
+   indx/indy = exponent which determines length in x/y direction,
+   where nx=2**indx, ny=2**indy
+   nxhd = first dimension of f >= nx/2 + 1
+   nyd = second dimension of f >= ny
+   irc = error indicator, irc = 1 if the FFTW backend was requested but
+   is not available, in which case the built-in backend is used
+local data                                                            */
+#ifdef FFTW
+   int n[2], inembed[2], onembed[2];
+   int nx, ny, nxh1;
+   float *f;
+#endif
+   *irc = 0;
+   cwfft2bdel();
+   kfftb = 1;
+   if (kfft != 2)
+      return;
+#ifdef FFTW
+   nx = 1L<<indx;
+   ny = 1L<<indy;
+   nxh1 = nx/2 + 1;
+   nxb = nx;
+   nyb = ny;
+   nxhdb = nxhd;
+   fftwf_init_threads();
+   fftwf_plan_with_nthreads(omp_get_max_threads());
+/* scratch arrays used for planning */
+   fbuf = (float complex *) fftwf_malloc(2*nxh1*ny*sizeof(float complex));
+   f = (float *) fftwf_malloc(4*nxhd*nyd*sizeof(float));
+   n[0] = ny;
+   n[1] = nx;
+   inembed[0] = nyd;
+   inembed[1] = 2*nxhd;
+   onembed[0] = ny;
+   onembed[1] = nxh1;
+/* scalar transforms: real array f[k][j] */
+   planrx = fftwf_plan_many_dft_r2c(2,n,1,f,inembed,1,0,fbuf,onembed,1,
+                                    0,FFTW_MEASURE|FFTW_UNALIGNED);
+   planxr = fftwf_plan_many_dft_c2r(2,n,1,fbuf,onembed,1,0,f,inembed,1,
+                                    0,FFTW_MEASURE|FFTW_UNALIGNED);
+/* 2 component vector transforms: real array f[k][j][2] */
+   planrxn = fftwf_plan_many_dft_r2c(2,n,2,f,inembed,2,1,fbuf,onembed,
+                                     1,nxh1*ny,
+                                     FFTW_MEASURE|FFTW_UNALIGNED);
+   planxrn = fftwf_plan_many_dft_c2r(2,n,2,fbuf,onembed,1,nxh1*ny,f,
+                                     inembed,2,1,
+                                     FFTW_MEASURE|FFTW_UNALIGNED);
+   fftwf_free(f);
+   if ((planrx==NULL) || (planxr==NULL) || (planrxn==NULL)
+      || (planxrn==NULL)) {
+      cwfft2bdel();
+      *irc = 1;
+      return;
+   }
+   kfftb = 2;
+#else
+   *irc = 1;
+#endif
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cwfft2bdel() {
+/* this subroutine deletes the fftw plans and scratch arrays, and
+   selects the built-in backend                                       */
+#ifdef FFTW
+   if (planrx != NULL)
+      fftwf_destroy_plan(planrx);
+   if (planxr != NULL)
+      fftwf_destroy_plan(planxr);
+   if (planrxn != NULL)
+      fftwf_destroy_plan(planrxn);
+   if (planxrn != NULL)
+      fftwf_destroy_plan(planxrn);
+   planrx = NULL;
+   planxr = NULL;
+   planrxn = NULL;
+   planxrn = NULL;
+   if (fbuf != NULL)
+      fftwf_free(fbuf);
+   fbuf = NULL;
+#endif
+   kfftb = 1;
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cwfft2bx(float complex f[], int isign, int mixup[],
+              float complex sct[], int indx, int indy, int nxhd, int nyd,
+              int nxhyd, int nxyhd) {
+/* wrapper function for real to complex fft, with packed data, using */
+/* the backend selected by cwfft2binit                               */
+/* arguments are the same as for cwfft2rmx                           */
+#ifdef FFTW
+   if (kfftb==2) {
+/* inverse fourier transform */
+      if (isign < 0) {
+         fftwf_execute_dft_r2c(planrx,(float *)f,fbuf);
+         cfftw2pack(f,fbuf,1,nxb,nyb,nxhdb);
+      }
+/* forward fourier transform */
+      else if (isign > 0) {
+         cfftw2unpack(f,fbuf,1,nxb,nyb,nxhdb);
+         fftwf_execute_dft_c2r(planxr,fbuf,(float *)f);
+      }
+      return;
+   }
+#endif
+   cwfft2rmx(f,isign,mixup,sct,indx,indy,nxhd,nyd,nxhyd,nxyhd);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cwfft2b2(float complex f[], int isign, int mixup[],
+              float complex sct[], int indx, int indy, int nxhd, int nyd,
+              int nxhyd, int nxyhd) {
+/* wrapper function for 2 2d real to complex ffts, with packed data, */
+/* using the backend selected by cwfft2binit                         */
+/* arguments are the same as for cwfft2rm2                           */
+#ifdef FFTW
+   if (kfftb==2) {
+/* inverse fourier transform */
+      if (isign < 0) {
+         fftwf_execute_dft_r2c(planrxn,(float *)f,fbuf);
+         cfftw2pack(f,fbuf,2,nxb,nyb,nxhdb);
+      }
+/* forward fourier transform */
+      else if (isign > 0) {
+         cfftw2unpack(f,fbuf,2,nxb,nyb,nxhdb);
+         fftwf_execute_dft_c2r(planxrn,fbuf,(float *)f);
+      }
+      return;
+   }
+#endif
+   cwfft2rm2(f,isign,mixup,sct,indx,indy,nxhd,nyd,nxhyd,nxyhd);
+   return;
+}
+
+/* Interfaces to Fortran */
+
+/*--------------------------------------------------------------------*/
+void cwfft2binit_(int *kfft, int *indx, int *indy, int *nxhd, int *nyd,
+                  int *irc) {
+   cwfft2binit(*kfft,*indx,*indy,*nxhd,*nyd,irc);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cwfft2bdel_() {
+   cwfft2bdel();
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cwfft2bx_(float complex *f, int *isign, int *mixup,
+               float complex *sct, int *indx, int *indy, int *nxhd,
+               int *nyd, int *nxhyd, int *nxyhd) {
+   cwfft2bx(f,*isign,mixup,sct,*indx,*indy,*nxhd,*nyd,*nxhyd,*nxyhd);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cwfft2b2_(float complex *f, int *isign, int *mixup,
+               float complex *sct, int *indx, int *indy, int *nxhd,
+               int *nyd, int *nxhyd, int *nxyhd) {
+   cwfft2b2(f,*isign,mixup,sct,*indx,*indy,*nxhd,*nyd,*nxhyd,*nxyhd);
+   return;
+}
@@ -0,0 +1,14 @@
+/* header file for fftb2.c */
+
+void cwfft2binit(int kfft, int indx, int indy, int nxhd, int nyd,
+                 int *irc);
+
+void cwfft2bdel();
+
+void cwfft2bx(float complex f[], int isign, int mixup[],
+              float complex sct[], int indx, int indy, int nxhd, int nyd,
+              int nxhyd, int nxyhd);
+
+void cwfft2b2(float complex f[], int isign, int mixup[],
+              float complex sct[], int indx, int indy, int nxhd, int nyd,
+              int nxhyd, int nxyhd);
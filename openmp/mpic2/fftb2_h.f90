@@ -0,0 +1,44 @@
+!-----------------------------------------------------------------------
+! Interface file for fftb2.c
+      module fftb2_h
+      implicit none
+!
+      interface
+         subroutine cwfft2binit(kfft,indx,indy,nxhd,nyd,irc)
+         implicit none
+         integer, intent(in) :: kfft, indx, indy, nxhd, nyd
+         integer, intent(inout) :: irc
+         end subroutine
+      end interface
+!
+      interface
+         subroutine cwfft2bdel()
+         implicit none
+         end subroutine
+      end interface
+!
+      interface
+         subroutine cwfft2bx(f,isign,mixup,sct,indx,indy,nxhd,nyd,nxhyd,&
+     &nxyhd)
+         implicit none
+         integer, intent(in) :: isign, indx, indy, nxhd, nyd
+         integer, intent(in) :: nxhyd, nxyhd
+         real, dimension(2*nxhd,nyd), intent(inout) :: f
+         integer, dimension(nxhyd), intent(in) :: mixup
+         complex, dimension(nxyhd), intent(in) :: sct
+         end subroutine
+      end interface
+!
+      interface
+         subroutine cwfft2b2(f,isign,mixup,sct,indx,indy,nxhd,nyd,nxhyd,&
+     &nxyhd)
+         implicit none
+         integer, intent(in) :: isign, indx, indy, nxhd, nyd
+         integer, intent(in) :: nxhyd, nxyhd
+         real, dimension(2,2*nxhd,nyd), intent(inout) :: f
+         integer, dimension(nxhyd), intent(in) :: mixup
+         complex, dimension(nxyhd), intent(in) :: sct
+         end subroutine
+      end interface
+!
+      end module
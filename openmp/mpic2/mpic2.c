@@ -7,6 +7,8 @@
 #include <sys/time.h>
 #include "mpush2.h"
 #include "omplib.h"
+#include "fftb2.h"
+#include "chkpt2.h"
 
 void dtimer(double *time, struct timeval *itime, int icntrl);
 
@@ -36,6 +38,24 @@ int main(int argc, char *argv[]) {
    int mx = 16, my = 16;
 /* xtras = fraction of extra particles needed for particle management */
    float xtras = 0.2;
+/* lgrow = (0,1) = (stop,enlarge particle arrays) when tiles overflow */
+   int lgrow = 1;
+/* kpl = (0,1,2) = particle layout in tiles: (array of structures, */
+/* structure of arrays, structure of arrays with vectorizable blocks) */
+   int kpl = 0;
+/* ldep = (0,1) = update tile edges in deposit with (atomic operations, */
+/* halo buffer), for kpl = 0 */
+   int ldep = 0;
+/* lfuse = (0,1) = (separate,fused) push and deposit, for kpl = 0 */
+/* if lfuse = 1, the push deposits the charge for the next step */
+   int lfuse = 0;
+/* kfft = (1,2) = FFT backend = (built-in,FFTW library) */
+   int kfft = 1;
+/* nchkpt = number of time steps between checkpoints, 0 = none */
+   int nchkpt = 0;
+/* lrestart = (0,1) = (no,yes) restart from checkpoint file fchkpt */
+   int lrestart = 0;
+   char fchkpt[] = "chkpt2.dat";
 /* declare scalars for standard code */
    int j;
    int np, nx, ny, nxh, nyh, nxe, nye, nxeh, nxyh, nxhy;
@@ -45,6 +65,9 @@ int main(int argc, char *argv[]) {
 /* declare scalars for OpenMP code */
    int nppmx, nppmx0, ntmax, npbmx, irc;
    int nvp;
+/* nppmn/nbmn = particles needed in ppart/ppbuff tiles for reordering */
+/* ngrow = number of times particle arrays were enlarged */
+   int nppmn, nbmn, ngrow = 0;
 
 /* declare arrays for standard code: */
 /* part = original particle array */
@@ -61,7 +84,8 @@ int main(int argc, char *argv[]) {
    float complex *sct = NULL;
 
 /* declare arrays for OpenMP (tiled) code: */
-/* ppart = tiled particle array */
+/* ppart = tiled particle array, */
+/* ppart[k][n][i] for kpl = 0, ppart[k][i][n] for kpl > 0 */
 /* ppbuff = buffer array for reordering tiled particle array */
    float *ppart = NULL, *ppbuff = NULL;
 /* kpic = number of particles in each tile */
@@ -70,12 +94,22 @@ int main(int argc, char *argv[]) {
    int *ncl = NULL;
 /* ihole = location/destination of each particle departing tile */
    int *ihole = NULL;
+/* qh = charge density on tile edges, used if ldep = 1 */
+   float *qh = NULL;
+
+/* declare checkpoint data */
+/* isc/fsc = integer/real scalars in checkpoint */
+   int isc[11];
+   float fsc[2];
+/* carr = arrays in checkpoint, nbytes = their sizes in bytes */
+   void *carr[4];
+   long nbytes[4];
 
 /* declare and initialize timing data */
    float time;
    struct timeval itime;
    float tdpost = 0.0, tguard = 0.0, tfft = 0.0, tfield = 0.0;
-   float tpush = 0.0, tsort = 0.0;
+   float tpush = 0.0, tsort = 0.0, tchkpt = 0.0;
    double dtime;
 
    irc = 0;
@@ -109,38 +143,93 @@ int main(int argc, char *argv[]) {
    mixup = (int *) malloc(nxhy*sizeof(int));
    sct = (float complex *) malloc(nxyh*sizeof(float complex));
    kpic = (int *) malloc(mxy1*sizeof(int));
+   qh = (float *) malloc(2*(mx+my)*mxy1*sizeof(float));
 
 /* prepare fft tables */
    cwfft2rinit(mixup,sct,indx,indy,nxhy,nxyh);
+/* select FFT backend and prepare FFTW plans */
+   cwfft2binit(kfft,indx,indy,nxeh,nye,&irc);
+   if (irc != 0) {
+      printf("FFTW backend not available, using built-in FFT\n");
+      irc = 0;
+   }
 /* calculate form factors */
    isign = 0;
    cmpois22((float complex *)qe,(float complex *)fxye,isign,ffc,ax,ay,
              affp,&we,nx,ny,nxeh,nye,nxh,nyh);
+/* restart: read scalars from checkpoint file: updates isc, fsc */
+   if (lrestart==1) {
+      crchkpth2(fchkpt,11,isc,2,fsc,&irc);
+      if (irc != 0) {
+         printf("crchkpth2 error: irc=%d\n",irc);
+         exit(1);
+      }
+/* with lfuse = 1, qe in the file is the charge for the next step */
+      if ((isc[4] != kpl) || (isc[5] != np) || (isc[6] != nx)
+         || (isc[7] != ny) || (isc[8] != mx) || (isc[9] != my)
+         || (isc[10] != lfuse)) {
+         printf("checkpoint does not match: kpl,np,nx,ny,mx,my,lfuse=\
+%d,%d,%d,%d,%d,%d,%d\n",isc[4],isc[5],isc[6],isc[7],isc[8],isc[9],
+                isc[10]);
+         exit(1);
+      }
+      ntime = isc[0]; nppmx0 = isc[1]; npbmx = isc[2]; ntmax = isc[3];
+      we = fsc[0]; wke = fsc[1];
+   }
+   else {
 /* initialize electrons */
-   cdistr2(part,vtx,vty,vx0,vy0,npx,npy,idimp,np,nx,ny,ipbc);
-
-/* find number of particles in each of mx, my tiles: updates kpic, nppmx */
-   cdblkp2l(part,kpic,&nppmx,idimp,np,mx,my,mx1,mxy1,&irc);
-   if (irc != 0) { 
-      printf("cdblkp2l error, irc=%d\n",irc);
-      exit(1);
+      cdistr2(part,vtx,vty,vx0,vy0,npx,npy,idimp,np,nx,ny,ipbc);
+/* find number of particles in each of mx, my tiles: */
+/* updates kpic, nppmx */
+      cdblkp2l(part,kpic,&nppmx,idimp,np,mx,my,mx1,mxy1,&irc);
+      if (irc != 0) { 
+         printf("cdblkp2l error, irc=%d\n",irc);
+         exit(1);
+      }
+      nppmx0 = (1.0 + xtras)*nppmx;
+      ntmax = xtras*nppmx;
+      npbmx = xtras*nppmx;
    }
 /* allocate vector particle data */
-   nppmx0 = (1.0 + xtras)*nppmx;
-   ntmax = xtras*nppmx;
-   npbmx = xtras*nppmx;
    ppart = (float *) malloc(idimp*nppmx0*mxy1*sizeof(float));
    ppbuff = (float *) malloc(idimp*npbmx*mxy1*sizeof(float));
    ncl = (int *) malloc(8*mxy1*sizeof(int));
    ihole = (int *) malloc(2*(ntmax+1)*mxy1*sizeof(int));
+/* restart: copy tiled particles and fields from checkpoint file: */
+/* updates kpic, ppart, qe, fxye                                  */
+   if (lrestart==1) {
+      crchkpta2(0,kpic,sizeof(int)*mxy1,&irc);
+      if (irc==0)
+         crchkptp2(1,ppart,kpic,idimp,nppmx0,mxy1,kpl,&irc);
+      if (irc==0)
+         crchkpta2(2,qe,sizeof(float)*nxe*nye,&irc);
+      if (irc==0)
+         crchkpta2(3,fxye,sizeof(float)*ndim*nxe*nye,&irc);
+      crchkptc2();
+      if (irc != 0) {
+         printf("crchkpt2 error: irc=%d\n",irc);
+         exit(1);
+      }
+   }
 /* copy ordered particle data for OpenMP: updates ppart and kpic */
-   cppmovin2l(part,ppart,kpic,nppmx0,idimp,np,mx,my,mx1,mxy1,&irc);
-   if (irc != 0) { 
-      printf("cppmovin2l overflow error, irc=%d\n",irc);
-      exit(1);
+   else {
+      if (kpl==0)
+         cppmovin2l(part,ppart,kpic,nppmx0,idimp,np,mx,my,mx1,mxy1,
+                    &irc);
+/* transposed layout */
+      else
+         cppmovin2lt(part,ppart,kpic,nppmx0,idimp,np,mx,my,mx1,mxy1,
+                     &irc);
+      if (irc != 0) { 
+         printf("cppmovin2l overflow error, irc=%d\n",irc);
+         exit(1);
+      }
    }
 /* sanity check */
-   cppcheck2l(ppart,kpic,idimp,nppmx0,nx,ny,mx,my,mx1,my1,&irc);
+   if (kpl==0)
+      cppcheck2l(ppart,kpic,idimp,nppmx0,nx,ny,mx,my,mx1,my1,&irc);
+   else
+      cppcheck2lt(ppart,kpic,idimp,nppmx0,nx,ny,mx,my,mx1,my1,&irc);
    if (irc != 0) {
       printf("%d,cppcheck2l error: irc=%d\n",ntime,irc);
       exit(1);
@@ -153,11 +242,30 @@ L500: if (nloop <= ntime)
 /*    printf("ntime = %i\n",ntime); */
 
 /* deposit charge with OpenMP: updates qe */
+/* with fused push and deposit, qe was calculated in the previous push */
       dtimer(&dtime,&itime,-1);
-      for (j = 0; j < nxe*nye; j++) {
-         qe[j] = 0.0;
+      if ((kpl > 0) || (lfuse==0) || (ntime==0)) {
+         for (j = 0; j < nxe*nye; j++) {
+            qe[j] = 0.0;
+         }
+         if (kpl==0) {
+            if (ldep==0)
+               cgppost2l(ppart,qe,kpic,qme,nppmx0,idimp,mx,my,nxe,nye,
+                         mx1,mxy1);
+/* edges saved in halo buffer, no atomic operations */
+            else
+               cgppost2lh(ppart,qe,qh,kpic,qme,nppmx0,idimp,mx,my,nxe,
+                          nye,mx1,mxy1);
+         }
+/* transposed layout */
+         else if (kpl==1)
+            cgppost2lt(ppart,qe,kpic,qme,nppmx0,idimp,mx,my,nxe,nye,mx1,
+                       mxy1);
+/* transposed layout, vectorizable blocks */
+         else if (kpl==2)
+            cvgppost2lt(ppart,qe,kpic,qme,nppmx0,idimp,mx,my,nxe,nye,
+                        mx1,mxy1);
       }
-      cgppost2l(ppart,qe,kpic,qme,nppmx0,idimp,mx,my,nxe,nye,mx1,mxy1);
       dtimer(&dtime,&itime,1);
       time = (float) dtime;
       tdpost += time;
@@ -172,8 +280,8 @@ L500: if (nloop <= ntime)
 /* transform charge to fourier space with OpenMP: updates qe */
       dtimer(&dtime,&itime,-1);
       isign = -1;
-      cwfft2rmx((float complex *)qe,isign,mixup,sct,indx,indy,nxeh,
-                nye,nxhy,nxyh);
+      cwfft2bx((float complex *)qe,isign,mixup,sct,indx,indy,nxeh,nye,
+               nxhy,nxyh);
       dtimer(&dtime,&itime,1);
       time = (float) dtime;
       tfft += time;
@@ -190,8 +298,8 @@ L500: if (nloop <= ntime)
 /* transform force to real space with OpenMP: updates fxye */
       dtimer(&dtime,&itime,-1);
       isign = 1;
-      cwfft2rm2((float complex *)fxye,isign,mixup,sct,indx,indy,nxeh,
-                nye,nxhy,nxyh);
+      cwfft2b2((float complex *)fxye,isign,mixup,sct,indx,indy,nxeh,nye,
+               nxhy,nxyh);
 
       dtimer(&dtime,&itime,1);
       time = (float) dtime;
@@ -211,12 +319,32 @@ L500: if (nloop <= ntime)
 /*    cgppush2l(ppart,fxye,kpic,qbme,dt,&wke,idimp,nppmx0,nx,ny,mx,my, */
 /*              nxe,nye,mx1,mxy1,ipbc);                                */
 /* updates ppart, ncl, ihole, wke, irc */
-      cgppushf2l(ppart,fxye,kpic,ncl,ihole,qbme,dt,&wke,idimp,nppmx0,
-                 nx,ny,mx,my,nxe,nye,mx1,mxy1,ntmax,&irc);
+      if (kpl==0) {
+         if (lfuse==0)
+            cgppushf2l(ppart,fxye,kpic,ncl,ihole,qbme,dt,&wke,idimp,
+                       nppmx0,nx,ny,mx,my,nxe,nye,mx1,mxy1,ntmax,&irc);
+/* fused push and deposit: also updates qe for the next time step */
+         else {
+            for (j = 0; j < nxe*nye; j++) {
+               qe[j] = 0.0;
+            }
+            cgppushfq2l(ppart,fxye,qe,kpic,ncl,ihole,qbme,qme,dt,&wke,
+                        idimp,nppmx0,nx,ny,mx,my,nxe,nye,mx1,mxy1,ntmax,
+                        &irc);
+         }
+      }
+/* transposed layout */
+      else if (kpl==1)
+         cgppushf2lt(ppart,fxye,kpic,ncl,ihole,qbme,dt,&wke,idimp,
+                     nppmx0,nx,ny,mx,my,nxe,nye,mx1,mxy1,ntmax,&irc);
+/* transposed layout, vectorizable blocks */
+      else if (kpl==2)
+         cvgppushf2lt(ppart,fxye,kpic,ncl,ihole,qbme,dt,&wke,idimp,
+                      nppmx0,nx,ny,mx,my,nxe,nye,mx1,mxy1,ntmax,&irc);
       dtimer(&dtime,&itime,1);
       time = (float) dtime;
       tpush += time;
-      if (irc != 0) {
+      if ((irc != 0) && (lgrow==0)) {
          printf("cgppushf2l error: irc=%d\n",irc);
          exit(1);
       }
@@ -226,9 +354,68 @@ L500: if (nloop <= ntime)
 /* updates ppart, ppbuff, kpic, ncl, ihole, and irc */
 /*    cpporder2l(ppart,ppbuff,kpic,ncl,ihole,idimp,nppmx0,nx,ny,mx,my, */
 /*               mx1,my1,npbmx,ntmax,&irc);                            */
+/* enlarge particle arrays before reordering if tiles would overflow */
+      if (lgrow==1) {
+/* find sizes needed for reordering: updates nppmn, nbmn */
+         cppsizef2l(kpic,ncl,&nppmn,&nbmn,mx1,my1);
+         if (nppmn > nppmx0) {
+            nppmn = (1.0 + xtras)*nppmn;
+            ppart = (float *) realloc(ppart,
+                                      idimp*nppmn*mxy1*sizeof(float));
+            if (ppart==NULL) {
+               printf("ppart reallocation error: nppmx0=%d\n",nppmn);
+               exit(1);
+            }
+/* updates ppart */
+            if (kpl==0)
+               cppgrow2l(ppart,kpic,idimp,nppmx0,nppmn,mxy1);
+            else
+               cppgrow2lt(ppart,kpic,idimp,nppmx0,nppmn,mxy1);
+            nppmx0 = nppmn;
+            ngrow += 1;
+         }
+         if (nbmn > npbmx) {
+            npbmx = (1.0 + xtras)*nbmn;
+            free(ppbuff);
+            ppbuff = (float *) malloc(idimp*npbmx*mxy1*sizeof(float));
+            ngrow += 1;
+         }
+/* ihole overflow in push, list of departing particles is incomplete */
+         if (nbmn > ntmax) {
+            ntmax = (1.0 + xtras)*nbmn;
+            free(ihole);
+            ihole = (int *) malloc(2*(ntmax+1)*mxy1*sizeof(int));
+            ngrow += 1;
+         }
+         if ((ppbuff==NULL) || (ihole==NULL)) {
+            printf("reallocation error: npbmx,ntmax=%d,%d\n",npbmx,
+                   ntmax);
+            exit(1);
+         }
+      }
+/* recalculate list of departing particles after ihole overflow */
+      if (irc != 0) {
+         irc = 0;
+/* updates ncl, ihole, irc */
+         if (kpl==0)
+            cpphole2l(ppart,kpic,ncl,ihole,idimp,nppmx0,mx,my,mx1,my1,
+                      ntmax,&irc);
+         else
+            cpphole2lt(ppart,kpic,ncl,ihole,idimp,nppmx0,mx,my,mx1,my1,
+                       ntmax,&irc);
+      }
 /* updates ppart, ppbuff, kpic, ncl, and irc */
-      cpporderf2l(ppart,ppbuff,kpic,ncl,ihole,idimp,nppmx0,mx1,my1,
-                  npbmx,ntmax,&irc);
+      if (kpl==0)
+         cpporderf2l(ppart,ppbuff,kpic,ncl,ihole,idimp,nppmx0,mx1,my1,
+                     npbmx,ntmax,&irc);
+/* transposed layout */
+      else if (kpl==1)
+         cpporderf2lt(ppart,ppbuff,kpic,ncl,ihole,idimp,nppmx0,mx1,my1,
+                      npbmx,ntmax,&irc);
+/* transposed layout, vectorizable blocks */
+      else if (kpl==2)
+         cvpporderf2lt(ppart,ppbuff,kpic,ncl,ihole,idimp,nppmx0,mx1,my1,
+                       npbmx,ntmax,&irc);
       dtimer(&dtime,&itime,1);
       time = (float) dtime;
       tsort += time;
@@ -242,14 +429,47 @@ L500: if (nloop <= ntime)
          printf("%e %e %e\n",we,wke,wke+we);
       }
       ntime += 1;
+
+/* write checkpoint in the background */
+      if ((nchkpt > 0) && (ntime%nchkpt==0)) {
+         dtimer(&dtime,&itime,-1);
+         isc[0] = ntime; isc[1] = nppmx0; isc[2] = npbmx;
+         isc[3] = ntmax; isc[4] = kpl; isc[5] = np; isc[6] = nx;
+         isc[7] = ny; isc[8] = mx; isc[9] = my; isc[10] = lfuse;
+         fsc[0] = we; fsc[1] = wke;
+         carr[0] = kpic; nbytes[0] = sizeof(int)*mxy1;
+         carr[1] = ppart; nbytes[1] = sizeof(float)*idimp*nppmx0*mxy1;
+         carr[2] = qe; nbytes[2] = sizeof(float)*nxe*nye;
+         carr[3] = fxye; nbytes[3] = sizeof(float)*ndim*nxe*nye;
+         cwchkpt2(fchkpt,11,isc,2,fsc,4,carr,nbytes,&irc);
+         dtimer(&dtime,&itime,1);
+         time = (float) dtime;
+         tchkpt += time;
+         if (irc != 0) {
+            printf("%d,cwchkpt2 error: irc=%d\n",ntime,irc);
+            irc = 0;
+         }
+      }
       goto L500;
 L2000:
 
 /* * * * end main iteration loop * * * */
 
-   printf("ntime = %i\n",ntime);
+/* wait for last checkpoint to be written */
+   if (nchkpt > 0) {
+      cwchkptw2(&irc);
+      if (irc != 0)
+         printf("cwchkptw2 error: irc=%d\n",irc);
+   }
+
+   printf("ntime = %i, kpl = %i\n",ntime,kpl);
    printf("Final Field, Kinetic and Total Energies:\n");
    printf("%e %e %e\n",we,wke,wke+we);
+   if (ngrow > 0) {
+      printf("particle arrays enlarged %d times\n",ngrow);
+      printf("final nppmx0, npbmx, ntmax = %d,%d,%d\n",nppmx0,npbmx,
+             ntmax);
+   }
 
    printf("\n");
    printf("deposit time = %f\n",tdpost);
@@ -258,6 +478,8 @@ L2000:
    printf("fft time = %f\n",tfft);
    printf("push time = %f\n",tpush);
    printf("sort time = %f\n",tsort);
+   if (nchkpt > 0)
+      printf("checkpoint time = %f\n",tchkpt);
    tfield += tguard + tfft;
    printf("total solver time = %f\n",tfield);
    time = tdpost + tpush + tsort;
@@ -273,5 +495,8 @@ L2000:
    printf("Total Particle Time (nsec) = %f\n",time*wt);
    printf("\n");
 
+/* delete FFTW plans */
+   cwfft2bdel();
+
    return 0;
 }
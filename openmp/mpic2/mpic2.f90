@@ -4,6 +4,7 @@
       program mpic2
       use mpush2_h
       use omplib_h
+      use fftb2_h
       implicit none
 ! indx/indy = exponent which determines grid points in x/y direction:
 ! nx = 2**indx, ny = 2**indy.
@@ -30,6 +31,19 @@
       integer :: mx = 16, my = 16
 ! xtras = fraction of extra particles needed for particle management
       real :: xtras = 0.2
+! lgrow = (0,1) = (stop,enlarge particle arrays) when tiles overflow
+      integer :: lgrow = 1
+! kpl = (0,1,2) = particle layout in tiles: (array of structures,
+! structure of arrays, structure of arrays with vectorizable blocks)
+      integer :: kpl = 0
+! ldep = (0,1) = update tile edges in deposit with (atomic operations,
+! halo buffer), for kpl = 0
+      integer :: ldep = 0
+! lfuse = (0,1) = (separate,fused) push and deposit, for kpl = 0
+! if lfuse = 1, the push deposits the charge for the next step
+      integer :: lfuse = 0
+! kfft = (1,2) = FFT backend = (built-in,FFTW library)
+      integer :: kfft = 1
 ! declare scalars for standard code
       integer :: np, nx, ny, nxh, nyh, nxe, nye, nxeh, nxyh, nxhy
       integer :: mx1, my1, mxy1, ntime, nloop, isign
@@ -38,6 +52,9 @@
 ! declare scalars for OpenMP code
       integer :: nppmx, nppmx0, ntmax, npbmx, irc
       integer :: nvp
+! nppmn/nbmn = particles needed in ppart/ppbuff tiles for reordering
+! ngrow = number of times particle arrays were enlarged
+      integer :: nppmn, nbmn, ngrow = 0
 !
 ! declare arrays for standard code:
 ! part = original particle array
@@ -57,12 +74,16 @@
 ! ppart = tiled particle array
 ! ppbuff = buffer array for reordering tiled particle array
       real, dimension(:,:,:), pointer :: ppart, ppbuff
+! pflat = temporary flat copy of ppart used when enlarging it
+      real, dimension(:), pointer :: pflat
 ! kpic = number of particles in each tile
       integer, dimension(:), pointer :: kpic
 ! ncl = number of particles departing tile in each direction
       integer, dimension(:,:), pointer :: ncl
 ! ihole = location/destination of each particle departing tile
       integer, dimension(:,:,:), pointer :: ihole
+! qh = charge density on tile edges, used if ldep = 1
+      real, dimension(:,:), pointer :: qh
 !
 ! declare and initialize timing data
       real :: time
@@ -99,9 +120,18 @@
       allocate(qe(nxe,nye),fxye(ndim,nxe,nye))
       allocate(ffc(nxh,nyh),mixup(nxhy),sct(nxyh))
       allocate(kpic(mxy1))
+      allocate(qh(2*(mx+my),mxy1))
 !
 ! prepare fft tables
       call WFFT2RINIT(mixup,sct,indx,indy,nxhy,nxyh)
+! select FFT backend and prepare FFTW plans
+      if (kfft==2) then
+         call cwfft2binit(kfft,indx,indy,nxeh,nye,irc)
+         if (irc /= 0) then
+            write (*,*) 'FFTW backend not available, using built-in FFT'
+            kfft = 1; irc = 0
+         endif
+      endif
 ! calculate form factors
       isign = 0
       call MPOIS22(qe,fxye,isign,ffc,ax,ay,affp,we,nx,ny,nxeh,nye,nxh,  &
@@ -124,13 +154,25 @@
       allocate(ncl(8,mxy1))
       allocate(ihole(2,ntmax+1,mxy1))
 ! copy ordered particle data for OpenMP: updates ppart and kpic
-      call PPMOVIN2L(part,ppart,kpic,nppmx0,idimp,np,mx,my,mx1,mxy1,irc)
+      if (kpl==0) then
+         call PPMOVIN2L(part,ppart,kpic,nppmx0,idimp,np,mx,my,mx1,mxy1, &
+     &irc)
+! transposed layout
+      else
+         call PPMOVIN2LT(part,ppart,kpic,nppmx0,idimp,np,mx,my,mx1,mxy1,&
+     &irc)
+      endif
       if (irc /= 0) then
          write (*,*) 'PPMOVIN2L overflow error, irc=', irc
          stop
       endif
 ! sanity check
-      call PPCHECK2L(ppart,kpic,idimp,nppmx0,nx,ny,mx,my,mx1,my1,irc)
+      if (kpl==0) then
+         call PPCHECK2L(ppart,kpic,idimp,nppmx0,nx,ny,mx,my,mx1,my1,irc)
+      else
+         call PPCHECK2LT(ppart,kpic,idimp,nppmx0,nx,ny,mx,my,mx1,my1,irc&
+     &)
+      endif
       if (irc /= 0) then
          write (*,*) 'PPCHECK2L error: irc=', irc
          stop
@@ -142,10 +184,29 @@
 !     write (*,*) 'ntime = ', ntime
 !
 ! deposit charge with OpenMP: updates qe
+! with fused push and deposit, qe was calculated in the previous push
       call dtimer(dtime,itime,-1)
-      qe = 0.0
-      call GPPOST2L(ppart,qe,kpic,qme,nppmx0,idimp,mx,my,nxe,nye,mx1,   &
-     &mxy1)
+      if ((kpl > 0).or.(lfuse==0).or.(ntime==0)) then
+         qe = 0.0
+         if (kpl==0) then
+            if (ldep==0) then
+               call GPPOST2L(ppart,qe,kpic,qme,nppmx0,idimp,mx,my,nxe,  &
+     &nye,mx1,mxy1)
+! edges saved in halo buffer, no atomic operations
+            else
+               call GPPOST2LH(ppart,qe,qh,kpic,qme,nppmx0,idimp,mx,my,  &
+     &nxe,nye,mx1,mxy1)
+            endif
+! transposed layout
+         else if (kpl==1) then
+            call GPPOST2LT(ppart,qe,kpic,qme,nppmx0,idimp,mx,my,nxe,nye,&
+     &mx1,mxy1)
+! transposed layout, vectorizable blocks
+         else if (kpl==2) then
+            call VGPPOST2LT(ppart,qe,kpic,qme,nppmx0,idimp,mx,my,nxe,nye&
+     &,mx1,mxy1)
+         endif
+      endif
       call dtimer(dtime,itime,1)
       time = real(dtime)
       tdpost = tdpost + time
@@ -160,7 +221,11 @@
 ! transform charge to fourier space with OpenMP: updates qe
       call dtimer(dtime,itime,-1)
       isign = -1
-      call WFFT2RMX(qe,isign,mixup,sct,indx,indy,nxeh,nye,nxhy,nxyh)
+      if (kfft==2) then
+         call cwfft2bx(qe,isign,mixup,sct,indx,indy,nxeh,nye,nxhy,nxyh)
+      else
+         call WFFT2RMX(qe,isign,mixup,sct,indx,indy,nxeh,nye,nxhy,nxyh)
+      endif
       call dtimer(dtime,itime,1)
       time = real(dtime)
       tfft = tfft + time
@@ -177,7 +242,13 @@
 ! transform force to real space with OpenMP: updates fxye
       call dtimer(dtime,itime,-1)
       isign = 1
-      call WFFT2RM2(fxye,isign,mixup,sct,indx,indy,nxeh,nye,nxhy,nxyh)
+      if (kfft==2) then
+         call cwfft2b2(fxye,isign,mixup,sct,indx,indy,nxeh,nye,nxhy,    &
+     &nxyh)
+      else
+         call WFFT2RM2(fxye,isign,mixup,sct,indx,indy,nxeh,nye,nxhy,    &
+     &nxyh)
+      endif
       call dtimer(dtime,itime,1)
       time = real(dtime)
       tfft = tfft + time
@@ -196,12 +267,29 @@
 !     call GPPUSH2L(ppart,fxye,kpic,qbme,dt,wke,idimp,nppmx0,nx,ny,mx,my&
 !    &,nxe,nye,mx1,mxy1,ipbc)
 ! updates ppart, ncl, ihole, wke, irc
-      call GPPUSHF2L(ppart,fxye,kpic,ncl,ihole,qbme,dt,wke,idimp,nppmx0,&
-     &nx,ny,mx,my,nxe,nye,mx1,mxy1,ntmax,irc)
+      if (kpl==0) then
+         if (lfuse==0) then
+            call GPPUSHF2L(ppart,fxye,kpic,ncl,ihole,qbme,dt,wke,idimp, &
+     &nppmx0,nx,ny,mx,my,nxe,nye,mx1,mxy1,ntmax,irc)
+! fused push and deposit: also updates qe for the next time step
+         else
+            qe = 0.0
+            call GPPUSHFQ2L(ppart,fxye,qe,kpic,ncl,ihole,qbme,qme,dt,wke&
+     &,idimp,nppmx0,nx,ny,mx,my,nxe,nye,mx1,mxy1,ntmax,irc)
+         endif
+! transposed layout
+      else if (kpl==1) then
+         call GPPUSHF2LT(ppart,fxye,kpic,ncl,ihole,qbme,dt,wke,idimp,   &
+     &nppmx0,nx,ny,mx,my,nxe,nye,mx1,mxy1,ntmax,irc)
+! transposed layout, vectorizable blocks
+      else if (kpl==2) then
+         call VGPPUSHF2LT(ppart,fxye,kpic,ncl,ihole,qbme,dt,wke,idimp,  &
+     &nppmx0,nx,ny,mx,my,nxe,nye,mx1,mxy1,ntmax,irc)
+      endif
       call dtimer(dtime,itime,1)
       time = real(dtime)
       tpush = tpush + time
-      if (irc /= 0) then
+      if ((irc /= 0).and.(lgrow==0)) then
          write (*,*) 'GPPUSHF2L error: irc=', irc
          stop
       endif
@@ -211,9 +299,66 @@
 ! updates ppart, ppbuff, kpic, ncl, ihole, and irc
 !     call PPORDER2L(ppart,ppbuff,kpic,ncl,ihole,idimp,nppmx0,nx,ny,mx, &
 !    &my,mx1,my1,npbmx,ntmax,irc)
+! enlarge particle arrays before reordering if tiles would overflow
+      if (lgrow==1) then
+! find sizes needed for reordering: updates nppmn, nbmn
+         call PPSIZEF2L(kpic,ncl,nppmn,nbmn,mx1,my1)
+         if (nppmn > nppmx0) then
+            nppmn = (1.0 + xtras)*nppmn
+            allocate(pflat(idimp*nppmn*mxy1))
+            pflat(1:size(ppart)) = reshape(ppart,(/size(ppart)/))
+! updates pflat
+            if (kpl==0) then
+               call PPGROW2L(pflat,kpic,idimp,nppmx0,nppmn,mxy1)
+            else
+               call PPGROW2LT(pflat,kpic,idimp,nppmx0,nppmn,mxy1)
+            endif
+            deallocate(ppart)
+            allocate(ppart(idimp,nppmn,mxy1))
+            ppart = reshape(pflat,(/idimp,nppmn,mxy1/))
+            deallocate(pflat)
+            nppmx0 = nppmn
+            ngrow = ngrow + 1
+         endif
+         if (nbmn > npbmx) then
+            npbmx = (1.0 + xtras)*nbmn
+            deallocate(ppbuff)
+            allocate(ppbuff(idimp,npbmx,mxy1))
+            ngrow = ngrow + 1
+         endif
+! ihole overflow in push, list of departing particles is incomplete
+         if (nbmn > ntmax) then
+            ntmax = (1.0 + xtras)*nbmn
+            deallocate(ihole)
+            allocate(ihole(2,ntmax+1,mxy1))
+            ngrow = ngrow + 1
+         endif
+      endif
+! recalculate list of departing particles after ihole overflow
+      if (irc /= 0) then
+         irc = 0
+! updates ncl, ihole, irc
+         if (kpl==0) then
+            call PPHOLE2L(ppart,kpic,ncl,ihole,idimp,nppmx0,mx,my,mx1,my1&
+     &,ntmax,irc)
+         else
+            call PPHOLE2LT(ppart,kpic,ncl,ihole,idimp,nppmx0,mx,my,mx1,  &
+     &my1,ntmax,irc)
+         endif
+      endif
 ! updates ppart, ppbuff, kpic, ncl, and irc
-      call PPORDERF2L(ppart,ppbuff,kpic,ncl,ihole,idimp,nppmx0,mx1,my1, &
-     &npbmx,ntmax,irc)
+      if (kpl==0) then
+         call PPORDERF2L(ppart,ppbuff,kpic,ncl,ihole,idimp,nppmx0,mx1,  &
+     &my1,npbmx,ntmax,irc)
+! transposed layout
+      else if (kpl==1) then
+         call PPORDERF2LT(ppart,ppbuff,kpic,ncl,ihole,idimp,nppmx0,mx1, &
+     &my1,npbmx,ntmax,irc)
+! transposed layout, vectorizable blocks
+      else if (kpl==2) then
+         call VPPORDERF2LT(ppart,ppbuff,kpic,ncl,ihole,idimp,nppmx0,mx1,&
+     &my1,npbmx,ntmax,irc)
+      endif
       call dtimer(dtime,itime,1)
       time = real(dtime)
       tsort = tsort + time
@@ -232,9 +377,14 @@
 !
 ! * * * end main iteration loop * * *
 !
-      write (*,*) 'ntime = ', ntime
+      write (*,*) 'ntime, kpl = ', ntime, kpl
       write (*,*) 'Final Field, Kinetic and Total Energies:'
       write (*,'(3e14.7)') we, wke, wke + we
+      if (ngrow > 0) then
+         write (*,*) 'particle arrays enlarged ', ngrow, ' times'
+         write (*,*) 'final nppmx0, npbmx, ntmax = ', nppmx0, npbmx,    &
+     &ntmax
+      endif
 !
       write (*,*)
       write (*,*) 'deposit time = ', tdpost
@@ -257,6 +407,9 @@
       write (*,*) 'Sort Time (nsec) = ', tsort*wt
       write (*,*) 'Total Particle Time (nsec) = ', time*wt
       write (*,*)
+!
+! delete FFTW plans
+      if (kfft==2) call cwfft2bdel()
 !
       stop
       end program
@@ -5,8 +5,62 @@
 #include <stdio.h>
 #include <complex.h>
 #include <math.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 #include "mpush2.h"
 
+/* scratch arena for local arrays in tiles, one segment per thread */
+static float *sarena = NULL, *sraw = NULL;
+static int nsseg = 0, nsthrd = 0;
+
+/*--------------------------------------------------------------------*/
+static int cthreadnum() {
+/* this function returns the number of the calling OpenMP thread,
+   or 0 if OpenMP is not enabled                                     */
+#ifdef _OPENMP
+   return omp_get_thread_num();
+#else
+   return 0;
+#endif
+}
+
+/*--------------------------------------------------------------------*/
+static float *cgetscr2l(int nsize, int *nseg) {
+/* this function returns a scratch arena with one segment of at least
+   nsize floats for each OpenMP thread, used for local arrays in tiles.
+   the arena is allocated the first time it is needed and only
+   reallocated if a larger segment or more threads are required.
+   the arena and each segment start on a 64 byte boundary, so that
+   threads do not share cache lines.
+   must be called outside of a parallel region
+   nsize = number of floats needed by each thread
+   nseg = returned distance between segments, in floats
+local data                                                            */
+#define LALIGN          16
+   int nthreads;
+   nthreads = 1;
+#ifdef _OPENMP
+   nthreads = omp_get_max_threads();
+#endif
+   *nseg = LALIGN*((nsize - 1)/LALIGN + 1);
+   if ((*nseg > nsseg) || (nthreads > nsthrd)) {
+      nsseg = *nseg > nsseg ? *nseg : nsseg;
+      nsthrd = nthreads > nsthrd ? nthreads : nsthrd;
+      free(sraw);
+      sraw = (float *) malloc((nsseg*nsthrd + LALIGN)*sizeof(float));
+      if (sraw==NULL) {
+         printf("scratch arena allocation error: nsize=%d\n",nsseg);
+         exit(1);
+      }
+      sarena = sraw + (LALIGN - ((size_t) sraw/sizeof(float))%LALIGN)
+               %LALIGN;
+   }
+   *nseg = nsseg;
+   return sarena;
+#undef LALIGN
+}
+
 /*--------------------------------------------------------------------*/
 double ranorm() {
 /* this program calculates a random number y from a gaussian distribution
@@ -314,6 +368,96 @@ private(j,k,noff,moff,npp,nn,mm,ist,edgelx,edgely,edgerx,edgery,dx,dy)
    return;
 }
 
+/*--------------------------------------------------------------------*/
+static inline double ctilepush2l(float ppart[], float fxy[],
+                                 float sfxy[], float qtm, float dt,
+                                 float edgelx, float edgely,
+                                 float edgerx, float edgery, int npp,
+                                 int npoff, int noff, int moff,
+                                 int idimp, int nx, int ny, int mx,
+                                 int my, int nxv, int ipbc) {
+/* this function updates particle co-ordinates and velocities in one
+   tile for cgppush2l, and returns the kinetic energy sum for the tile.
+   sfxy = local field array for tile, with (mx+1)*(my+1) points
+   cgppush2l calls it with constant mx, my for common tile sizes, so
+   that specialized versions are generated when it is inlined
+local data                                                            */
+   int i, j, nn, mm, mxv;
+   float dxp, dyp, amx, amy;
+   float x, y, dx, dy, vx, vy;
+   double sum1;
+   mxv = mx + 1;
+/* load local fields from global array */
+   nn = (mx < nx-noff ? mx : nx-noff) + 1;
+   mm = (my < ny-moff ? my : ny-moff) + 1;
+   for (j = 0; j < mm; j++) {
+      for (i = 0; i < nn; i++) {
+         sfxy[2*(i+mxv*j)] = fxy[2*(i+noff+nxv*(j+moff))];
+         sfxy[1+2*(i+mxv*j)] = fxy[1+2*(i+noff+nxv*(j+moff))];
+      }
+   }
+   sum1 = 0.0;
+/* loop over particles in tile */
+   for (j = 0; j < npp; j++) {
+/* find interpolation weights */
+      x = ppart[idimp*(j+npoff)];
+      y = ppart[1+idimp*(j+npoff)];
+      nn = x;
+      mm = y;
+      dxp = x - (float) nn;
+      dyp = y - (float) mm;
+      nn = 2*(nn - noff) + 2*mxv*(mm - moff);
+      amx = 1.0f - dxp;
+      amy = 1.0f - dyp;
+/* find acceleration */
+      dx = amx*sfxy[nn];
+      dy = amx*sfxy[nn+1];
+      dx = amy*(dxp*sfxy[nn+2] + dx);
+      dy = amy*(dxp*sfxy[nn+3] + dy);
+      nn += 2*mxv;
+      vx = amx*sfxy[nn];
+      vy = amx*sfxy[nn+1];
+      dx += dyp*(dxp*sfxy[nn+2] + vx);
+      dy += dyp*(dxp*sfxy[nn+3] + vy);
+/* new velocity */
+      vx = ppart[2+idimp*(j+npoff)];
+      vy = ppart[3+idimp*(j+npoff)];
+      dx = vx + qtm*dx;
+      dy = vy + qtm*dy;
+/* average kinetic energy */
+      vx += dx;
+      vy += dy;
+      sum1 += vx*vx + vy*vy;
+      ppart[2+idimp*(j+npoff)] = dx;
+      ppart[3+idimp*(j+npoff)] = dy;
+/* new position */
+      dx = x + dx*dt;
+      dy = y + dy*dt;
+/* reflecting boundary conditions */
+      if (ipbc==2) {
+         if ((dx < edgelx) || (dx >= edgerx)) {
+            dx = ppart[idimp*(j+npoff)];
+            ppart[2+idimp*(j+npoff)] = -ppart[2+idimp*(j+npoff)];
+         }
+         if ((dy < edgely) || (dy >= edgery)) {
+            dy = ppart[1+idimp*(j+npoff)];
+            ppart[3+idimp*(j+npoff)] = -ppart[3+idimp*(j+npoff)];
+         }
+      }
+/* mixed reflecting/periodic boundary conditions */
+      else if (ipbc==3) {
+         if ((dx < edgelx) || (dx >= edgerx)) {
+            dx = ppart[idimp*(j+npoff)];
+            ppart[2+idimp*(j+npoff)] = -ppart[2+idimp*(j+npoff)];
+         }
+      }
+/* set new position */
+      ppart[idimp*(j+npoff)] = dx;
+      ppart[1+idimp*(j+npoff)] = dy;
+   }
+   return sum1;
+}
+
 /*--------------------------------------------------------------------*/
 void cgppush2l(float ppart[], float fxy[], int kpic[], float qbm,
                float dt, float *ek, int idimp, int nppmx, int nx,
@@ -362,17 +506,12 @@ void cgppush2l(float ppart[], float fxy[], int kpic[], float qbm,
    ipbc = particle boundary condition = (0,1,2,3) =
    (none,2d periodic,2d reflecting,mixed reflecting/periodic)
 local data                                                            */
-#define MXV             33
-#define MYV             33
-   int noff, moff, npoff, npp;
-   int i, j, k, nn, mm, mxv;
-   float qtm, edgelx, edgely, edgerx, edgery, dxp, dyp, amx, amy;
-   float x, y, dx, dy, vx, vy;
-   float sfxy[2*MXV*MYV];
-/* float sfxy[2*(mx+1)*(my+1)]; */
+   int noff, moff, npoff, npp, nseg;
+   int k, mxv;
+   float qtm, edgelx, edgely, edgerx, edgery;
+   float *scr, *sfxy;
    double sum1, sum2;
-/* mxv = MXV; */
-   mxv = mx+1;
+   mxv = mx + 1;
    qtm = qbm*dt;
    sum2 = 0.0;
 /* set boundary values */
@@ -390,95 +529,189 @@ local data                                                            */
       edgelx = 1.0f;
       edgerx = (float) (nx-1);
    }
-/* error if local array is too small */
-/* if ((mx >= MXV) || (my >= MYV))   */
-/*    return;                        */
+/* find aligned scratch space for local fields in each thread */
+   scr = cgetscr2l(2*mxv*(my+1),&nseg);
 /* loop over tiles */
 #pragma omp parallel for \
-private(i,j,k,noff,moff,npp,npoff,nn,mm,x,y,dxp,dyp,amx,amy,dx,dy, \
-vx,vy,sum1,sfxy) \
+private(k,noff,moff,npp,npoff,sum1,sfxy) \
 reduction(+:sum2)
    for (k = 0; k < mxy1; k++) {
+      sfxy = scr + nseg*cthreadnum();
       noff = k/mx1;
       moff = my*noff;
       noff = mx*(k - mx1*noff);
       npp = kpic[k];
       npoff = nppmx*k;
+/* push particles in tile, with specialized versions for common */
+/* tile sizes                                                   */
+      if ((mx==16) && (my==16))
+         sum1 = ctilepush2l(ppart,fxy,sfxy,qtm,dt,edgelx,edgely,edgerx,
+                            edgery,npp,npoff,noff,moff,idimp,nx,ny,16,
+                            16,nxv,ipbc);
+      else if ((mx==8) && (my==8))
+         sum1 = ctilepush2l(ppart,fxy,sfxy,qtm,dt,edgelx,edgely,edgerx,
+                            edgery,npp,npoff,noff,moff,idimp,nx,ny,8,8,
+                            nxv,ipbc);
+      else if ((mx==32) && (my==32))
+         sum1 = ctilepush2l(ppart,fxy,sfxy,qtm,dt,edgelx,edgely,edgerx,
+                            edgery,npp,npoff,noff,moff,idimp,nx,ny,32,
+                            32,nxv,ipbc);
+      else
+         sum1 = ctilepush2l(ppart,fxy,sfxy,qtm,dt,edgelx,edgely,edgerx,
+                            edgery,npp,npoff,noff,moff,idimp,nx,ny,mx,
+                            my,nxv,ipbc);
+      sum2 += sum1;
+   }
+/* normalize kinetic energy */
+   *ek += 0.125f*sum2;
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+static inline double ctilepushf2l(float ppart[], float fxy[],
+                                  float sfxy[], int ncl[], int ihole[],
+                                  float qtm, float dt, float anx,
+                                  float any, int k, int npp, int npoff,
+                                  int noff, int moff, int idimp, int nx,
+                                  int ny, int mx, int my, int nxv,
+                                  int ntmax, int *irc) {
+/* this function updates particle co-ordinates and velocities in one
+   tile k for cgppushf2l, finds the particles leaving the tile, and
+   returns the kinetic energy sum for the tile.
+   sfxy = local field array for tile, with (mx+1)*(my+1) points
+   cgppushf2l calls it with constant mx, my for common tile sizes, so
+   that specialized versions are generated when it is inlined
+local data                                                            */
+   int i, j, ih, nh, nn, mm, mxv;
+   float dxp, dyp, amx, amy;
+   float x, y, dx, dy, vx, vy;
+   float edgelx, edgely, edgerx, edgery;
+   double sum1;
+   mxv = mx + 1;
+   nn = nx - noff;
+   nn = mx < nn ? mx : nn;
+   mm = ny - moff;
+   mm = my < mm ? my : mm;
+   edgelx = noff;
+   edgerx = noff + nn;
+   edgely = moff;
+   edgery = moff + mm;
+   ih = 0;
+   nh = 0;
+   nn += 1;
+   mm += 1;
 /* load local fields from global array */
-      nn = (mx < nx-noff ? mx : nx-noff) + 1;
-      mm = (my < ny-moff ? my : ny-moff) + 1;
-      for (j = 0; j < mm; j++) {
-         for (i = 0; i < nn; i++) {
-            sfxy[2*(i+mxv*j)] = fxy[2*(i+noff+nxv*(j+moff))];
-            sfxy[1+2*(i+mxv*j)] = fxy[1+2*(i+noff+nxv*(j+moff))];
-         }
+   for (j = 0; j < mm; j++) {
+      for (i = 0; i < nn; i++) {
+         sfxy[2*(i+mxv*j)] = fxy[2*(i+noff+nxv*(j+moff))];
+         sfxy[1+2*(i+mxv*j)] = fxy[1+2*(i+noff+nxv*(j+moff))];
       }
-      sum1 = 0.0;
+   }
+/* clear counters */
+   for (j = 0; j < 8; j++) {
+      ncl[j+8*k] = 0;
+   }
+   sum1 = 0.0;
 /* loop over particles in tile */
-      for (j = 0; j < npp; j++) {
+   for (j = 0; j < npp; j++) {
 /* find interpolation weights */
-         x = ppart[idimp*(j+npoff)];
-         y = ppart[1+idimp*(j+npoff)];
-         nn = x;
-         mm = y;
-         dxp = x - (float) nn;
-         dyp = y - (float) mm;
-         nn = 2*(nn - noff) + 2*mxv*(mm - moff);
-         amx = 1.0f - dxp;
-         amy = 1.0f - dyp;
+      x = ppart[idimp*(j+npoff)];
+      y = ppart[1+idimp*(j+npoff)];
+      nn = x;
+      mm = y;
+      dxp = x - (float) nn;
+      dyp = y - (float) mm;
+      nn = 2*(nn - noff) + 2*mxv*(mm - moff);
+      amx = 1.0f - dxp;
+      amy = 1.0f - dyp;
 /* find acceleration */
-         dx = amx*sfxy[nn];
-         dy = amx*sfxy[nn+1];
-         dx = amy*(dxp*sfxy[nn+2] + dx);
-         dy = amy*(dxp*sfxy[nn+3] + dy);
-         nn += 2*mxv;
-         vx = amx*sfxy[nn];
-         vy = amx*sfxy[nn+1];
-         dx += dyp*(dxp*sfxy[nn+2] + vx);
-         dy += dyp*(dxp*sfxy[nn+3] + vy);
+      dx = amx*sfxy[nn];
+      dy = amx*sfxy[nn+1];
+      dx = amy*(dxp*sfxy[nn+2] + dx);
+      dy = amy*(dxp*sfxy[nn+3] + dy);
+      nn += 2*mxv;
+      vx = amx*sfxy[nn];
+      vy = amx*sfxy[nn+1];
+      dx += dyp*(dxp*sfxy[nn+2] + vx);
+      dy += dyp*(dxp*sfxy[nn+3] + vy);
 /* new velocity */
-         vx = ppart[2+idimp*(j+npoff)];
-         vy = ppart[3+idimp*(j+npoff)];
-         dx = vx + qtm*dx;
-         dy = vy + qtm*dy;
+      vx = ppart[2+idimp*(j+npoff)];
+      vy = ppart[3+idimp*(j+npoff)];
+      dx = vx + qtm*dx;
+      dy = vy + qtm*dy;
 /* average kinetic energy */
-         vx += dx;
-         vy += dy;
-         sum1 += vx*vx + vy*vy;
-         ppart[2+idimp*(j+npoff)] = dx;
-         ppart[3+idimp*(j+npoff)] = dy;
+      vx += dx;
+      vy += dy;
+      sum1 += (vx*vx + vy*vy);
+      ppart[2+idimp*(j+npoff)] = dx;
+      ppart[3+idimp*(j+npoff)] = dy;
 /* new position */
-         dx = x + dx*dt;
-         dy = y + dy*dt;
-/* reflecting boundary conditions */
-         if (ipbc==2) {
-            if ((dx < edgelx) || (dx >= edgerx)) {
-               dx = ppart[idimp*(j+npoff)];
-               ppart[2+idimp*(j+npoff)] = -ppart[2+idimp*(j+npoff)];
-            }
-            if ((dy < edgely) || (dy >= edgery)) {
-               dy = ppart[1+idimp*(j+npoff)];
-               ppart[3+idimp*(j+npoff)] = -ppart[3+idimp*(j+npoff)];
-            }
+      dx = x + dx*dt;
+      dy = y + dy*dt;
+/* find particles going out of bounds */
+      mm = 0;
+/* count how many particles are going in each direction in ncl   */
+/* save their address and destination in ihole                   */
+/* use periodic boundary conditions and check for roundoff error */
+/* mm = direction particle is going                              */
+      if (dx >= edgerx) {
+         if (dx >= anx)
+            dx -= anx;
+         mm = 2;
+      }
+      else if (dx < edgelx) {
+         if (dx < 0.0f) {
+            dx += anx;
+            if (dx < anx)
+               mm = 1;
+            else
+               dx = 0.0;
          }
-/* mixed reflecting/periodic boundary conditions */
-         else if (ipbc==3) {
-            if ((dx < edgelx) || (dx >= edgerx)) {
-               dx = ppart[idimp*(j+npoff)];
-               ppart[2+idimp*(j+npoff)] = -ppart[2+idimp*(j+npoff)];
-            }
+         else {
+            mm = 1;
          }
+      }
+      if (dy >= edgery) {
+         if (dy >= any)
+            dy -= any;
+         mm += 6;
+      }
+      else if (dy < edgely) {
+         if (dy < 0.0) {
+            dy += any;
+            if (dy < any)
+               mm += 3;
+            else
+               dy = 0.0;
+         }
+         else {
+            mm += 3;
+         }
+      }
 /* set new position */
-         ppart[idimp*(j+npoff)] = dx;
-         ppart[1+idimp*(j+npoff)] = dy;
+      ppart[idimp*(j+npoff)] = dx;
+      ppart[1+idimp*(j+npoff)] = dy;
+/* increment counters */
+      if (mm > 0) {
+         ncl[mm+8*k-1] += 1;
+         ih += 1;
+         if (ih <= ntmax) {
+            ihole[2*(ih+(ntmax+1)*k)] = j + 1;
+            ihole[1+2*(ih+(ntmax+1)*k)] = mm;
+         }
+         else {
+            nh = 1;
+         }
       }
-      sum2 += sum1;
    }
-/* normalize kinetic energy */
-   *ek += 0.125f*sum2;
-   return;
-#undef MXV
-#undef MYV
+/* set error and end of file flag */
+/* ihole overflow */
+   if (nh > 0) {
+      *irc = ih;
+      ih = -ih;
+   }
+   ihole[2*(ntmax+1)*k] = ih;
+   return sum1;
 }
 
 /*--------------------------------------------------------------------*/
@@ -535,184 +768,475 @@ void cgppushf2l(float ppart[], float fxy[], int kpic[], int ncl[],
    irc = maximum overflow, returned only if error occurs, when irc > 0
    optimized version
 local data                                                            */
-#define MXV             33
-#define MYV             33
-   int noff, moff, npoff, npp;
-   int i, j, k, ih, nh, nn, mm, mxv;
-   float qtm, dxp, dyp, amx, amy;
-   float x, y, dx, dy, vx, vy;
-   float anx, any, edgelx, edgely, edgerx, edgery;
-   float sfxy[2*MXV*MYV];
-/* float sfxy[2*(mx+1)*(my+1)]; */
+   int noff, moff, npoff, npp, nseg;
+   int k, mxv;
+   float qtm, anx, any;
+   float *scr, *sfxy;
    double sum1, sum2;
    mxv = mx + 1;
    qtm = qbm*dt;
    anx = (float) nx;
    any = (float) ny;
    sum2 = 0.0;
-/* error if local array is too small */
-/* if ((mx >= MXV) || (my >= MYV))   */
-/*    return;                        */
+/* find aligned scratch space for local fields in each thread */
+   scr = cgetscr2l(2*mxv*(my+1),&nseg);
 /* loop over tiles */
 #pragma omp parallel for \
-private(i,j,k,noff,moff,npp,npoff,nn,mm,ih,nh,x,y,dxp,dyp,amx,amy, \
-dx,dy,vx,vy,edgelx,edgely,edgerx,edgery,sum1,sfxy) \
+private(k,noff,moff,npp,npoff,sum1,sfxy) \
 reduction(+:sum2)
    for (k = 0; k < mxy1; k++) {
+      sfxy = scr + nseg*cthreadnum();
       noff = k/mx1;
       moff = my*noff;
       noff = mx*(k - mx1*noff);
       npp = kpic[k];
       npoff = nppmx*k;
-      nn = nx - noff;
-      nn = mx < nn ? mx : nn;
-      mm = ny - moff;
-      mm = my < mm ? my : mm;
-      edgelx = noff;
-      edgerx = noff + nn;
-      edgely = moff;
-      edgery = moff + mm;
-      ih = 0;
-      nh = 0;
-      nn += 1;
-      mm += 1;
+/* push particles in tile and find particles leaving it, with */
+/* specialized versions for common tile sizes                 */
+      if ((mx==16) && (my==16))
+         sum1 = ctilepushf2l(ppart,fxy,sfxy,ncl,ihole,qtm,dt,anx,any,k,
+                             npp,npoff,noff,moff,idimp,nx,ny,16,16,nxv,
+                             ntmax,irc);
+      else if ((mx==8) && (my==8))
+         sum1 = ctilepushf2l(ppart,fxy,sfxy,ncl,ihole,qtm,dt,anx,any,k,
+                             npp,npoff,noff,moff,idimp,nx,ny,8,8,nxv,
+                             ntmax,irc);
+      else if ((mx==32) && (my==32))
+         sum1 = ctilepushf2l(ppart,fxy,sfxy,ncl,ihole,qtm,dt,anx,any,k,
+                             npp,npoff,noff,moff,idimp,nx,ny,32,32,nxv,
+                             ntmax,irc);
+      else
+         sum1 = ctilepushf2l(ppart,fxy,sfxy,ncl,ihole,qtm,dt,anx,any,k,
+                             npp,npoff,noff,moff,idimp,nx,ny,mx,my,nxv,
+                             ntmax,irc);
+      sum2 += sum1;
+   }
+/* normalize kinetic energy */
+   *ek += 0.125f*sum2;
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+static inline double ctilepushfq2l(float ppart[], float fxy[],
+                                   float q[], float sfxy[], float sq[],
+                                   int ncl[], int ihole[], float qtm,
+                                   float qm, float dt, float anx,
+                                   float any, int k, int npp, int npoff,
+                                   int noff, int moff, int idimp, int nx,
+                                   int ny, int mx, int my, int nxv,
+                                   int ntmax, int *irc) {
+/* this function updates particle co-ordinates and velocities in one
+   tile k for cgppushfq2l, finds the particles leaving the tile,
+   deposits the charge at the new positions, and returns the kinetic
+   energy sum for the tile.
+   sfxy = local field array for tile, with (mx+1)*(my+1) points
+   sq = local charge array for tile plus a border of one grid point,
+   with (mx+3)*(my+3) points, starting at grid point noff-1, moff-1
+   cgppushfq2l calls it with constant mx, my for common tile sizes, so
+   that specialized versions are generated when it is inlined
+local data                                                            */
+   int i, j, ih, nh, nn, mm, np, mp, mxv, mxq;
+   float dxp, dyp, amx, amy;
+   float x, y, dx, dy, vx, vy;
+   float edgelx, edgely, edgerx, edgery, sxq, syq;
+   double sum1;
+   mxv = mx + 1;
+   mxq = mx + 3;
+   sxq = (float) (mx + 2);
+   syq = (float) (my + 2);
+   nn = nx - noff;
+   nn = mx < nn ? mx : nn;
+   mm = ny - moff;
+   mm = my < mm ? my : mm;
+   edgelx = noff;
+   edgerx = noff + nn;
+   edgely = moff;
+   edgery = moff + mm;
+   ih = 0;
+   nh = 0;
+   nn += 1;
+   mm += 1;
 /* load local fields from global array */
-      for (j = 0; j < mm; j++) {
-         for (i = 0; i < nn; i++) {
-            sfxy[2*(i+mxv*j)] = fxy[2*(i+noff+nxv*(j+moff))];
-            sfxy[1+2*(i+mxv*j)] = fxy[1+2*(i+noff+nxv*(j+moff))];
-         }
+   for (j = 0; j < mm; j++) {
+      for (i = 0; i < nn; i++) {
+         sfxy[2*(i+mxv*j)] = fxy[2*(i+noff+nxv*(j+moff))];
+         sfxy[1+2*(i+mxv*j)] = fxy[1+2*(i+noff+nxv*(j+moff))];
       }
+   }
+/* zero out local accumulator */
+   for (j = 0; j < mxq*(my+3); j++) {
+      sq[j] = 0.0f;
+   }
 /* clear counters */
-      for (j = 0; j < 8; j++) {
-         ncl[j+8*k] = 0;
-      }
-      sum1 = 0.0;
+   for (j = 0; j < 8; j++) {
+      ncl[j+8*k] = 0;
+   }
+   sum1 = 0.0;
 /* loop over particles in tile */
-      for (j = 0; j < npp; j++) {
+   for (j = 0; j < npp; j++) {
 /* find interpolation weights */
-         x = ppart[idimp*(j+npoff)];
-         y = ppart[1+idimp*(j+npoff)];
-         nn = x;
-         mm = y;
-         dxp = x - (float) nn;
-         dyp = y - (float) mm;
-         nn = 2*(nn - noff) + 2*mxv*(mm - moff);
-         amx = 1.0f - dxp;
-         amy = 1.0f - dyp;
+      x = ppart[idimp*(j+npoff)];
+      y = ppart[1+idimp*(j+npoff)];
+      nn = x;
+      mm = y;
+      dxp = x - (float) nn;
+      dyp = y - (float) mm;
+      nn = 2*(nn - noff) + 2*mxv*(mm - moff);
+      amx = 1.0f - dxp;
+      amy = 1.0f - dyp;
 /* find acceleration */
-         dx = amx*sfxy[nn];
-         dy = amx*sfxy[nn+1];
-         dx = amy*(dxp*sfxy[nn+2] + dx);
-         dy = amy*(dxp*sfxy[nn+3] + dy);
-         nn += 2*mxv;
-         vx = amx*sfxy[nn];
-         vy = amx*sfxy[nn+1];
-         dx += dyp*(dxp*sfxy[nn+2] + vx);
-         dy += dyp*(dxp*sfxy[nn+3] + vy);
+      dx = amx*sfxy[nn];
+      dy = amx*sfxy[nn+1];
+      dx = amy*(dxp*sfxy[nn+2] + dx);
+      dy = amy*(dxp*sfxy[nn+3] + dy);
+      nn += 2*mxv;
+      vx = amx*sfxy[nn];
+      vy = amx*sfxy[nn+1];
+      dx += dyp*(dxp*sfxy[nn+2] + vx);
+      dy += dyp*(dxp*sfxy[nn+3] + vy);
 /* new velocity */
-         vx = ppart[2+idimp*(j+npoff)];
-         vy = ppart[3+idimp*(j+npoff)];
-         dx = vx + qtm*dx;
-         dy = vy + qtm*dy;
+      vx = ppart[2+idimp*(j+npoff)];
+      vy = ppart[3+idimp*(j+npoff)];
+      dx = vx + qtm*dx;
+      dy = vy + qtm*dy;
 /* average kinetic energy */
-         vx += dx;
-         vy += dy;
-         sum1 += (vx*vx + vy*vy);
-         ppart[2+idimp*(j+npoff)] = dx;
-         ppart[3+idimp*(j+npoff)] = dy;
+      vx += dx;
+      vy += dy;
+      sum1 += (vx*vx + vy*vy);
+      ppart[2+idimp*(j+npoff)] = dx;
+      ppart[3+idimp*(j+npoff)] = dy;
 /* new position */
-         dx = x + dx*dt;
-         dy = y + dy*dt;
+      dx = x + dx*dt;
+      dy = y + dy*dt;
+/* deposit charge at new position, before boundary conditions, */
+/* while the particle is still in registers                    */
+      x = dx - (float) (noff - 1);
+      y = dy - (float) (moff - 1);
+      mp = 0;
+/* particle within one grid point of tile: deposit to local array */
+      if ((x >= 0.0f) && (x < sxq) && (y >= 0.0f) && (y < syq)) {
+         np = x;
+         mp = y;
+         dxp = qm*(x - (float) np);
+         dyp = y - (float) mp;
+         np += mxq*mp;
+         amx = qm - dxp;
+         amy = 1.0f - dyp;
+         sq[np] += amx*amy;
+         sq[np+1] += dxp*amy;
+         np += mxq;
+         sq[np] += amx*dyp;
+         sq[np+1] += dxp*dyp;
+         mp = -1;
+      }
 /* find particles going out of bounds */
-         mm = 0;
+      mm = 0;
 /* count how many particles are going in each direction in ncl   */
 /* save their address and destination in ihole                   */
 /* use periodic boundary conditions and check for roundoff error */
 /* mm = direction particle is going                              */
-         if (dx >= edgerx) {
-            if (dx >= anx)
-               dx -= anx;
-            mm = 2;
-         }
-         else if (dx < edgelx) {
-            if (dx < 0.0f) {
-               dx += anx;
-               if (dx < anx)
-                  mm = 1;
-               else
-                  dx = 0.0;
-            }
-            else {
+      if (dx >= edgerx) {
+         if (dx >= anx)
+            dx -= anx;
+         mm = 2;
+      }
+      else if (dx < edgelx) {
+         if (dx < 0.0f) {
+            dx += anx;
+            if (dx < anx)
                mm = 1;
-            }
+            else
+               dx = 0.0;
          }
-         if (dy >= edgery) {
-            if (dy >= any)
-               dy -= any;
-            mm += 6;
+         else {
+            mm = 1;
          }
-         else if (dy < edgely) {
-            if (dy < 0.0) {
-               dy += any;
-               if (dy < any)
-                  mm += 3;
-               else
-                  dy = 0.0;
-            }
-            else {
+      }
+      if (dy >= edgery) {
+         if (dy >= any)
+            dy -= any;
+         mm += 6;
+      }
+      else if (dy < edgely) {
+         if (dy < 0.0) {
+            dy += any;
+            if (dy < any)
                mm += 3;
-            }
+            else
+               dy = 0.0;
+         }
+         else {
+            mm += 3;
          }
+      }
 /* set new position */
-         ppart[idimp*(j+npoff)] = dx;
-         ppart[1+idimp*(j+npoff)] = dy;
+      ppart[idimp*(j+npoff)] = dx;
+      ppart[1+idimp*(j+npoff)] = dy;
+/* particle moved more than one grid point: deposit to global array */
+      if (mp >= 0) {
+         np = dx;
+         mp = dy;
+         dxp = qm*(dx - (float) np);
+         dyp = dy - (float) mp;
+         np += nxv*mp;
+         amx = qm - dxp;
+         amy = 1.0f - dyp;
+#pragma omp atomic
+         q[np] += amx*amy;
+#pragma omp atomic
+         q[np+1] += dxp*amy;
+         np += nxv;
+#pragma omp atomic
+         q[np] += amx*dyp;
+#pragma omp atomic
+         q[np+1] += dxp*dyp;
+      }
 /* increment counters */
-         if (mm > 0) {
-            ncl[mm+8*k-1] += 1;
-            ih += 1;
-            if (ih <= ntmax) {
-               ihole[2*(ih+(ntmax+1)*k)] = j + 1;
-               ihole[1+2*(ih+(ntmax+1)*k)] = mm;
-            }
-            else {
-               nh = 1;
-            }
+      if (mm > 0) {
+         ncl[mm+8*k-1] += 1;
+         ih += 1;
+         if (ih <= ntmax) {
+            ihole[2*(ih+(ntmax+1)*k)] = j + 1;
+            ihole[1+2*(ih+(ntmax+1)*k)] = mm;
+         }
+         else {
+            nh = 1;
          }
       }
-      sum2 += sum1;
+   }
 /* set error and end of file flag */
 /* ihole overflow */
-      if (nh > 0) {
-         *irc = ih;
-         ih = -ih;
+   if (nh > 0) {
+      *irc = ih;
+      ih = -ih;
+   }
+   ihole[2*(ntmax+1)*k] = ih;
+/* deposit local charge to global array, with periodic boundaries. */
+/* the border overlaps neighboring tiles, so atomic updates are used */
+   for (j = 0; j < my+3; j++) {
+      mm = j + moff - 1;
+      if (mm < 0)
+         mm += ny;
+      else if (mm > ny)
+         mm -= ny;
+      for (i = 0; i < mxq; i++) {
+         nn = i + noff - 1;
+         if (nn < 0)
+            nn += nx;
+         else if (nn > nx)
+            nn -= nx;
+#pragma omp atomic
+         q[nn+nxv*mm] += sq[i+mxq*j];
       }
-      ihole[2*(ntmax+1)*k] = ih;
    }
-/* normalize kinetic energy */
-   *ek += 0.125f*sum2;
-   return;
-#undef MXV
-#undef MYV
+   return sum1;
 }
 
 /*--------------------------------------------------------------------*/
-void cgppost2l(float ppart[], float q[], int kpic[], float qm,
-               int nppmx, int idimp, int mx, int my, int nxv, int nyv,
-               int mx1, int mxy1) {
-/* for 2d code, this subroutine calculates particle charge density
-   using first-order linear interpolation, periodic boundaries
+void cgppushfq2l(float ppart[], float fxy[], float q[], int kpic[],
+                 int ncl[], int ihole[], float qbm, float qm, float dt,
+                 float *ek, int idimp, int nppmx, int nx, int ny,
+                 int mx, int my, int nxv, int nyv, int mx1, int mxy1,
+                 int ntmax, int *irc) {
+/* for 2d code, this subroutine updates particle co-ordinates and
+   velocities using leap-frog scheme in time and first-order linear
+   interpolation in space, with periodic boundary conditions.
+   also determines list of particles which are leaving this tile, and
+   deposits the charge density at the new positions, so that the
+   particles are read only once per time step
    OpenMP version using guard cells
-   data deposited in tiles
+   data read and deposited in tiles
    particles stored segmented array
-   17 flops/particle, 6 loads, 4 stores
-   input: all, output: q
+   61 flops/particle, 12 loads, 8 stores
+   input: all except ncl, ihole, irc, output: ppart, q, ncl, ihole, ek,
+   irc
+   equations used are the same as for cgppushf2l.
    charge density is approximated by values at the nearest grid points
    q(n,m)=qm*(1.-dx)*(1.-dy)
    q(n+1,m)=qm*dx*(1.-dy)
    q(n,m+1)=qm*(1.-dx)*dy
    q(n+1,m+1)=qm*dx*dy
-   where n,m = leftmost grid points and dx = x-n, dy = y-m
+   where n,m = leftmost grid points and dx = x-n, dy = y-m, at the new
+   position x(t+dt), y(t+dt)
+   charge is accumulated in a local array covering the tile and one
+   grid point beyond it, which is then added to q with atomic updates.
+   particles which moved further are deposited directly to q.
+   q must be cleared before calling, and guard cells must be added
+   afterwards with caguard2l.
+   ppart[m][n][0] = position x of particle n in tile m
+   ppart[m][n][1] = position y of particle n in tile m
+   ppart[m][n][2] = velocity vx of particle n in tile m
+   ppart[m][n][3] = velocity vy of particle n in tile m
+   fxy[k][j][0] = x component of force/charge at grid (j,k)
+   fxy[k][j][1] = y component of force/charge at grid (j,k)
+   that is, convolution of electric field over particle shape
+   q[k][j] = charge density at grid point j,k
+   kpic[k] = number of particles in tile k
+   ncl[k][i] = number of particles going to destination i, tile k
+   ihole[k][:][0] = location of hole in array left by departing particle
+   ihole[k][:][1] = destination of particle leaving hole
+   ihole[k][0][0] = ih, number of holes left (error, if negative)
+   qbm = particle charge/mass
+   qm = charge on particle, in units of e
+   dt = time interval between successive calculations
+   kinetic energy/mass at time t is also calculated, using
+   ek = .125*sum((vx(t+dt/2)+vx(t-dt/2))**2+(vy(t+dt/2)+vy(t-dt/2))**2)
+   idimp = size of phase space = 4
+   nppmx = maximum number of particles in tile
+   nx/ny = system length in x/y direction
+   mx/my = number of grids in sorting cell in x/y
+   nxv = second dimension of field arrays, must be >= nx+1
+   nyv = third dimension of field arrays, must be >= ny+1
+   mx1 = (system length in x direction - 1)/mx + 1
+   mxy1 = mx1*my1, where my1 = (system length in y direction - 1)/my + 1
+   ntmax = size of hole array for particles leaving tiles
+   irc = maximum overflow, returned only if error occurs, when irc > 0
+local data                                                            */
+#define LALIGN          16
+   int noff, moff, npoff, npp, nseg, nsfxy;
+   int k, mxv;
+   float qtm, anx, any;
+   float *scr, *sfxy, *sq;
+   double sum1, sum2;
+   mxv = mx + 1;
+   qtm = qbm*dt;
+   anx = (float) nx;
+   any = (float) ny;
+   sum2 = 0.0;
+/* find aligned scratch space for local fields and charge in each */
+/* thread                                                         */
+   nsfxy = LALIGN*((2*mxv*(my+1) - 1)/LALIGN + 1);
+   scr = cgetscr2l(nsfxy+(mx+3)*(my+3),&nseg);
+/* loop over tiles */
+#pragma omp parallel for \
+private(k,noff,moff,npp,npoff,sum1,sfxy,sq) \
+reduction(+:sum2)
+   for (k = 0; k < mxy1; k++) {
+      sfxy = scr + nseg*cthreadnum();
+      sq = sfxy + nsfxy;
+      noff = k/mx1;
+      moff = my*noff;
+      noff = mx*(k - mx1*noff);
+      npp = kpic[k];
+      npoff = nppmx*k;
+/* push particles in tile, find particles leaving it and deposit */
+/* charge, with specialized versions for common tile sizes       */
+      if ((mx==16) && (my==16))
+         sum1 = ctilepushfq2l(ppart,fxy,q,sfxy,sq,ncl,ihole,qtm,qm,dt,
+                              anx,any,k,npp,npoff,noff,moff,idimp,nx,ny,
+                              16,16,nxv,ntmax,irc);
+      else if ((mx==8) && (my==8))
+         sum1 = ctilepushfq2l(ppart,fxy,q,sfxy,sq,ncl,ihole,qtm,qm,dt,
+                              anx,any,k,npp,npoff,noff,moff,idimp,nx,ny,
+                              8,8,nxv,ntmax,irc);
+      else if ((mx==32) && (my==32))
+         sum1 = ctilepushfq2l(ppart,fxy,q,sfxy,sq,ncl,ihole,qtm,qm,dt,
+                              anx,any,k,npp,npoff,noff,moff,idimp,nx,ny,
+                              32,32,nxv,ntmax,irc);
+      else
+         sum1 = ctilepushfq2l(ppart,fxy,q,sfxy,sq,ncl,ihole,qtm,qm,dt,
+                              anx,any,k,npp,npoff,noff,moff,idimp,nx,ny,
+                              mx,my,nxv,ntmax,irc);
+      sum2 += sum1;
+   }
+/* normalize kinetic energy */
+   *ek += 0.125f*sum2;
+   return;
+#undef LALIGN
+}
+
+/*--------------------------------------------------------------------*/
+static inline void ctilepost2l(float ppart[], float q[], float sq[],
+                               float qm, int npp, int npoff, int noff,
+                               int moff, int idimp, int mx, int my,
+                               int nxv, int nyv) {
+/* this function deposits the charge of the particles in one tile for
+   cgppost2l, first to the local accumulator sq, then to q.
+   sq = local charge array for tile, with (mx+1)*(my+1) points
+   cgppost2l calls it with constant mx, my for common tile sizes, so
+   that specialized versions are generated when it is inlined
+local data                                                            */
+   int i, j, nn, mm, mxv;
+   float x, y, dxp, dyp, amx, amy;
+   mxv = mx + 1;
+/* zero out local accumulator */
+   for (j = 0; j < mxv*(my+1); j++) {
+      sq[j] = 0.0f;
+   }
+/* loop over particles in tile */
+   for (j = 0; j < npp; j++) {
+/* find interpolation weights */
+      x = ppart[idimp*(j+npoff)];
+      y = ppart[1+idimp*(j+npoff)];
+      nn = x;
+      mm = y;
+      dxp = qm*(x - (float) nn);
+      dyp = y - (float) mm;
+      nn = nn - noff + mxv*(mm - moff);
+      amx = qm - dxp;
+      amy = 1.0f - dyp;
+/* deposit charge within tile to local accumulator */
+      x = sq[nn] + amx*amy;
+      y = sq[nn+1] + dxp*amy;
+      sq[nn] = x;
+      sq[nn+1] = y;
+      nn += mxv;
+      x = sq[nn] + amx*dyp;
+      y = sq[nn+1] + dxp*dyp;
+      sq[nn] = x;
+      sq[nn+1] = y;
+   }
+/* deposit charge to interior points in global array */
+   nn = nxv - noff;
+   mm = nyv - moff;
+   nn = mx < nn ? mx : nn;
+   mm = my < mm ? my : mm;
+   for (j = 1; j < mm; j++) {
+      for (i = 1; i < nn; i++) {
+         q[i+noff+nxv*(j+moff)] += sq[i+mxv*j];
+      }
+   }
+/* deposit charge to edge points in global array */
+   mm = nyv - moff;
+   mm = my+1 < mm ? my+1 : mm;
+   for (i = 1; i < nn; i++) {
+#pragma omp atomic
+      q[i+noff+nxv*moff] += sq[i];
+      if (mm > my) {
+#pragma omp atomic
+         q[i+noff+nxv*(mm+moff-1)] += sq[i+mxv*(mm-1)];
+      }
+   }
+   nn = nxv - noff;
+   nn = mx+1 < nn ? mx+1 : nn;
+   for (j = 0; j < mm; j++) {
+#pragma omp atomic
+      q[noff+nxv*(j+moff)] += sq[mxv*j];
+      if (nn > mx) {
+#pragma omp atomic
+         q[nn+noff-1+nxv*(j+moff)] += sq[nn-1+mxv*j];
+      }
+   }
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cgppost2l(float ppart[], float q[], int kpic[], float qm,
+               int nppmx, int idimp, int mx, int my, int nxv, int nyv,
+               int mx1, int mxy1) {
+/* for 2d code, this subroutine calculates particle charge density
+   using first-order linear interpolation, periodic boundaries
+   OpenMP version using guard cells
+   data deposited in tiles
+   particles stored segmented array
+   17 flops/particle, 6 loads, 4 stores
+   input: all, output: q
+   charge density is approximated by values at the nearest grid points
+   q(n,m)=qm*(1.-dx)*(1.-dy)
+   q(n+1,m)=qm*dx*(1.-dy)
+   q(n,m+1)=qm*(1.-dx)*dy
+   q(n+1,m+1)=qm*dx*dy
+   where n,m = leftmost grid points and dx = x-n, dy = y-m
    ppart[m][n][0] = position x of particle n in tile m
    ppart[m][n][1] = position y of particle n in tile m
    q[k][j] = charge density at grid point j,k
@@ -726,21 +1250,89 @@ void cgppost2l(float ppart[], float q[], int kpic[], float qm,
    mx1 = (system length in x direction - 1)/mx + 1
    mxy1 = mx1*my1, where my1 = (system length in y direction - 1)/my + 1
 local data                                                            */
-#define MXV             33
-#define MYV             33
-   int noff, moff, npoff, npp, mxv;
-   int i, j, k, nn, mm;
-   float x, y, dxp, dyp, amx, amy;
-   float sq[MXV*MYV];
-/* float sq[(mx+1)*(my+1)]; */
+   int noff, moff, npoff, npp, mxv, nseg;
+   int k;
+   float *scr, *sq;
    mxv = mx + 1;
-/* error if local array is too small */
-/* if ((mx >= MXV) || (my >= MYV))   */
-/*    return;                        */
+/* find aligned scratch space for local charge in each thread */
+   scr = cgetscr2l(mxv*(my+1),&nseg);
 /* loop over tiles */
 #pragma omp parallel for \
-private(i,j,k,noff,moff,npp,npoff,nn,mm,x,y,dxp,dyp,amx,amy,sq)
+private(k,noff,moff,npp,npoff,sq)
+   for (k = 0; k < mxy1; k++) {
+      sq = scr + nseg*cthreadnum();
+      noff = k/mx1;
+      moff = my*noff;
+      noff = mx*(k - mx1*noff);
+      npp = kpic[k];
+      npoff = nppmx*k;
+/* deposit charge in tile, with specialized versions for common */
+/* tile sizes                                                   */
+      if ((mx==16) && (my==16))
+         ctilepost2l(ppart,q,sq,qm,npp,npoff,noff,moff,idimp,16,16,nxv,
+                     nyv);
+      else if ((mx==8) && (my==8))
+         ctilepost2l(ppart,q,sq,qm,npp,npoff,noff,moff,idimp,8,8,nxv,
+                     nyv);
+      else if ((mx==32) && (my==32))
+         ctilepost2l(ppart,q,sq,qm,npp,npoff,noff,moff,idimp,32,32,nxv,
+                     nyv);
+      else
+         ctilepost2l(ppart,q,sq,qm,npp,npoff,noff,moff,idimp,mx,my,nxv,
+                     nyv);
+   }
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cgppost2lh(float ppart[], float q[], float qh[], int kpic[],
+                float qm, int nppmx, int idimp, int mx, int my, int nxv,
+                int nyv, int mx1, int mxy1) {
+/* for 2d code, this subroutine calculates particle charge density
+   using first-order linear interpolation, periodic boundaries
+   OpenMP version using guard cells
+   data deposited in tiles
+   particles stored segmented array
+   same as cgppost2l, except charge on the edges of each tile is first
+   saved in a halo buffer, then added to q in a second pass which
+   processes tiles in 4 colors, so that no atomic updates are needed.
+   tiles of the same color do not share any grid points
+   17 flops/particle, 6 loads, 4 stores
+   input: all, output: q
+   charge density is approximated by values at the nearest grid points
+   q(n,m)=qm*(1.-dx)*(1.-dy)
+   q(n+1,m)=qm*dx*(1.-dy)
+   q(n,m+1)=qm*(1.-dx)*dy
+   q(n+1,m+1)=qm*dx*dy
+   where n,m = leftmost grid points and dx = x-n, dy = y-m
+   ppart[m][n][0] = position x of particle n in tile m
+   ppart[m][n][1] = position y of particle n in tile m
+   q[k][j] = charge density at grid point j,k
+   qh[k][j] = charge density at edge point j of tile k
+   kpic = number of particles per tile
+   qm = charge on particle, in units of e
+   nppmx = maximum number of particles in tile
+   idimp = size of phase space = 4
+   mx/my = number of grids in sorting cell in x/y
+   nxv = first dimension of charge array, must be >= nx+1
+   nyv = second dimension of charge array, must be >= ny+1
+   mx1 = (system length in x direction - 1)/mx + 1
+   mxy1 = mx1*my1, where my1 = (system length in y direction - 1)/my + 1
+   the second dimension of qh must be >= 2*(mx+my)
+local data                                                            */
+   int noff, moff, npoff, npp, mxv, nseg, nh, kc;
+   int i, j, k, nn, mm, ih, ii;
+   float x, y, dxp, dyp, amx, amy;
+   float *scr, *sq;
+   mxv = mx + 1;
+   nh = 2*(mx + my);
+/* find aligned scratch space for local charge in each thread */
+   scr = cgetscr2l(mxv*(my+1),&nseg);
+/* first pass: deposit to interior points and save edges */
+#pragma omp parallel for \
+private(i,j,k,noff,moff,npp,npoff,nn,mm,ih,ii,x,y,dxp,dyp,amx,amy,sq)
    for (k = 0; k < mxy1; k++) {
+      sq = scr + nseg*cthreadnum();
       noff = k/mx1;
       moff = my*noff;
       noff = mx*(k - mx1*noff);
@@ -783,31 +1375,46 @@ private(i,j,k,noff,moff,npp,npoff,nn,mm,x,y,dxp,dyp,amx,amy,sq)
             q[i+noff+nxv*(j+moff)] += sq[i+mxv*j];
          }
       }
-/* deposit charge to edge points in global array */
+/* save charge at edge points in halo buffer */
+      nn = nxv - noff;
       mm = nyv - moff;
+      nn = mx+1 < nn ? mx+1 : nn;
       mm = my+1 < mm ? my+1 : mm;
-      for (i = 1; i < nn; i++) {
-#pragma omp atomic
-         q[i+noff+nxv*moff] += sq[i];
-         if (mm > my) {
-#pragma omp atomic
-            q[i+noff+nxv*(mm+moff-1)] += sq[i+mxv*(mm-1)];
+      ih = nh*k;
+      for (j = 0; j < mm; j++) {
+         ii = (j==0) || (j==my) ? 1 : mx;
+         for (i = 0; i < nn; i += ii) {
+            qh[ih] = sq[i+mxv*j];
+            ih += 1;
          }
       }
-      nn = nxv - noff;
-      nn = mx+1 < nn ? mx+1 : nn;
-      for (j = 0; j < mm; j++) {
-#pragma omp atomic
-         q[noff+nxv*(j+moff)] += sq[mxv*j];
-         if (nn > mx) {
-#pragma omp atomic
-            q[nn+noff-1+nxv*(j+moff)] += sq[nn-1+mxv*j];
+   }
+/* second pass: add edges to global array, one color at a time */
+   for (kc = 0; kc < 4; kc++) {
+#pragma omp parallel for private(i,j,k,noff,moff,nn,mm,ih,ii)
+      for (k = 0; k < mxy1; k++) {
+         noff = k/mx1;
+         moff = noff;
+         noff = k - mx1*noff;
+         if ((noff%2 + 2*(moff%2)) != kc)
+            continue;
+         moff = my*moff;
+         noff = mx*noff;
+         nn = nxv - noff;
+         mm = nyv - moff;
+         nn = mx+1 < nn ? mx+1 : nn;
+         mm = my+1 < mm ? my+1 : mm;
+         ih = nh*k;
+         for (j = 0; j < mm; j++) {
+            ii = (j==0) || (j==my) ? 1 : mx;
+            for (i = 0; i < nn; i += ii) {
+               q[i+noff+nxv*(j+moff)] += qh[ih];
+               ih += 1;
+            }
          }
       }
    }
    return;
-#undef MXV
-#undef MYV
 }
 
 /*--------------------------------------------------------------------*/
@@ -1219,30 +1826,2888 @@ private(i,j,k,ii,kk,npp,kx,ky,kl,kr,kxl,kxr,ih,nh,ncoff,ist,j1,j2,ip,ks)
                 }
             }
             else {
-               ist = 1;
+               ist = 1;
+            }
+         }
+      }
+/* set error */
+      if (ist > 0)
+         *irc = j1+1;
+/* fill up remaining holes in particle array with particles from bottom */
+      if (ih < nh) {
+         ip = nh - ih;
+         for (j = 0; j < ip; j++) {
+            j1 = npp - j - 1;
+            j2 = ihole[2*(nh-j+(ntmax+1)*k)] - 1;
+            if (j1 > j2) {
+/* move particle only if it is below current hole */
+               for (i = 0; i < idimp; i++) {
+                  ppart[i+idimp*(j2+nppmx*k)]
+                  = ppart[i+idimp*(j1+nppmx*k)];
+               }
+            }
+         }
+         npp -= ip;
+      }
+      kpic[k] = npp;
+   }
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppsizef2l(int kpic[], int ncl[], int *nppmx, int *nbmx, int mx1,
+                int my1) {
+/* this subroutine finds the maximum number of particles in each tile
+   and the maximum number of particles leaving any tile which would
+   result from reordering particles with cpporderf2l.
+   it assumes that the number of particles leaving a tile in each
+   direction has been previously stored in ncl by the cgppushf2l
+   procedure.  it can be used to enlarge the arrays ppart, ppbuff and
+   ihole before they overflow.
+   input: all except nppmx, nbmx, output: nppmx, nbmx
+   kpic[k] = number of particles in tile k
+   ncl[k][i] = number of particles going to destination i, tile k
+   nppmx = return maximum number of particles in tile after reordering
+   nbmx = return maximum number of particles leaving tile
+   mx1 = (system length in x direction - 1)/mx + 1
+   my1 = (system length in y direction - 1)/my + 1
+local data                                                            */
+   int mxy1, npp, nps, nbs, npx, nbx;
+   int j, k, ii, kx, ky, kxl, kxr, kk, kl, kr;
+   int ks[8];
+   mxy1 = mx1*my1;
+   npx = 0;
+   nbx = 0;
+/* loop over tiles */
+   for (k = 0; k < mxy1; k++) {
+      ky = k/mx1;
+/* loop over tiles in y, assume periodic boundary conditions */
+      kk = ky*mx1;
+/* find tile above */
+      kl = ky - 1;
+      if (kl < 0)
+         kl += my1;
+      kl = kl*mx1;
+/* find tile below */
+      kr = ky + 1;
+      if (kr >= my1)
+          kr -= my1;
+      kr = kr*mx1;
+/* loop over tiles in x, assume periodic boundary conditions */
+      kx = k - ky*mx1;
+      kxl = kx - 1;
+      if (kxl < 0)
+         kxl += mx1;
+      kxr = kx + 1;
+      if (kxr >= mx1)
+         kxr -= mx1;
+/* find tile number for different directions */
+      ks[0] = kxr + kk;
+      ks[1] = kxl + kk;
+      ks[2] = kx + kr;
+      ks[3] = kxr + kr;
+      ks[4] = kxl + kr;
+      ks[5] = kx + kl;
+      ks[6] = kxr + kl;
+      ks[7] = kxl + kl;
+/* count particles leaving tile */
+      nbs = 0;
+      for (j = 0; j < 8; j++) {
+         nbs += ncl[j+8*k];
+      }
+/* count particles arriving from each direction */
+      nps = 0;
+      for (ii = 0; ii < 8; ii++) {
+         nps += ncl[ii+8*ks[ii]];
+      }
+      npp = kpic[k] + nps - nbs;
+      npx = npx > npp ? npx : npp;
+      nbx = nbx > nbs ? nbx : nbs;
+   }
+   *nppmx = npx;
+   *nbmx = nbx;
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppgrow2l(float ppart[], int kpic[], int idimp, int nppmx,
+               int nppmxn, int mxy1) {
+/* this subroutine changes the maximum number of particles in each tile
+   of the segmented particle array ppart from nppmx to nppmxn, moving
+   the particles in place.  the array ppart must already have been
+   reallocated to hold idimp*nppmxn*mxy1 elements.
+   tiles are moved in reverse order, so that no data is overwritten
+   input: all, output: ppart
+   ppart[k][n][i] = i co-ordinate of particle n in tile k
+   kpic[k] = number of particles in tile k
+   idimp = size of phase space = 4
+   nppmx = old maximum number of particles in tile
+   nppmxn = new maximum number of particles in tile, must be >= nppmx
+   mxy1 = mx1*my1, where my1 = (system length in y direction - 1)/my + 1
+local data                                                            */
+   int j, k, npp;
+   if (nppmxn <= nppmx)
+      return;
+   for (k = mxy1-1; k > 0; k--) {
+      npp = kpic[k];
+      npp = npp < nppmx ? npp : nppmx;
+      for (j = idimp*npp-1; j >= 0; j--) {
+         ppart[j+idimp*nppmxn*k] = ppart[j+idimp*nppmx*k];
+      }
+   }
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cpphole2l(float ppart[], int kpic[], int ncl[], int ihole[],
+               int idimp, int nppmx, int mx, int my, int mx1, int my1,
+               int ntmax, int *irc) {
+/* this subroutine finds the list of particles leaving tiles of mx, my
+   after the co-ordinates have been updated and periodic boundary
+   conditions applied, for example by cgppushf2l.  the destination is
+   found from the tile containing the new position.
+   it is used to recalculate ncl and ihole after ihole has overflowed
+   in cgppushf2l and has been enlarged.
+   tiles are assumed to be arranged in 2D linear memory
+   input: all except ncl, ihole, irc
+   output: ncl, ihole, irc
+   ppart[k][n][0] = position x of particle n in tile k
+   ppart[k][n][1] = position y of particle n in tile k
+   kpic[k] = number of particles in tile k
+   ncl[k][i] = number of particles going to destination i, tile k
+   ihole[k][:][0] = location of hole in array left by departing particle
+   ihole[k][:][1] = direction destination of particle leaving hole
+   all for tile k
+   ihole[k][0][0] = ih, number of holes left (error, if negative)
+   idimp = size of phase space = 4
+   nppmx = maximum number of particles in tile
+   mx/my = number of grids in sorting cell in x/y
+   mx1 = (system length in x direction - 1)/mx + 1
+   my1 = (system length in y direction - 1)/my + 1
+   ntmax = size of hole array for particles leaving tiles
+   irc = maximum overflow, returned only if error occurs, when irc > 0
+local data                                                            */
+   int mxy1, npp, j, k, kx, ky, ih, nh, ist, nn, mm;
+   mxy1 = mx1*my1;
+/* loop over tiles */
+#pragma omp parallel for \
+private(j,k,kx,ky,npp,nn,mm,ih,nh,ist)
+   for (k = 0; k < mxy1; k++) {
+      ky = k/mx1;
+      kx = k - mx1*ky;
+      npp = kpic[k];
+      ih = 0;
+      nh = 0;
+/* clear counters */
+      for (j = 0; j < 8; j++) {
+         ncl[j+8*k] = 0;
+      }
+/* loop over particles in tile */
+      for (j = 0; j < npp; j++) {
+         nn = ppart[idimp*(j+nppmx*k)];
+         mm = ppart[1+idimp*(j+nppmx*k)];
+         nn = nn/mx - kx;
+         mm = mm/my - ky;
+/* ist = direction particle is going, allowing for periodic tiles */
+         ist = 0;
+         if ((nn==1) || (nn==(1-mx1)))
+            ist = 2;
+         else if (nn != 0)
+            ist = 1;
+         if ((mm==1) || (mm==(1-my1)))
+            ist += 6;
+         else if (mm != 0)
+            ist += 3;
+         if (ist > 0) {
+            ncl[ist+8*k-1] += 1;
+            ih += 1;
+            if (ih <= ntmax) {
+               ihole[2*(ih+(ntmax+1)*k)] = j + 1;
+               ihole[1+2*(ih+(ntmax+1)*k)] = ist;
+            }
+            else {
+               nh = 1;
+            }
+         }
+      }
+/* set error and end of file flag */
+      if (nh > 0) {
+         *irc = ih;
+         ih = -ih;
+      }
+      ihole[2*(ntmax+1)*k] = ih;
+   }
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppmovin2lt(float part[], float ppart[], int kpic[], int nppmx,
+                 int idimp, int nop, int mx, int my, int mx1, int mxy1,
+                 int *irc) {
+/* this subroutine sorts particles by x,y grid in tiles of mx, my
+   and copies to segmented array ppart
+   linear interpolation
+   input: all except ppart, kpic, output: ppart, kpic
+   part/ppart = input/output particle arrays
+   part[n][0] = position x of particle n in partition
+   part[n][1] = position y of particle n in partition
+   ppart[k][0][n] = position x of particle n in tile k
+   ppart[k][1][n] = position y of particle n in tile k
+   kpic = output number of particles per tile
+   nppmx = maximum number of particles in tile
+   idimp = size of phase space = 4
+   nop = number of particles
+   mx/my = number of grids in sorting cell in x and y
+   mx1 = (system length in x direction - 1)/mx + 1
+   mxy1 = mx1*my1, where my1 = (system length in y direction - 1)/my + 1
+   irc = maximum overflow, returned only if error occurs, when irc > 0
+local data                                                            */
+   int i, j, k, n, m, ip, ierr;
+   ierr = 0;
+/* clear counter array */
+   for (k = 0; k < mxy1; k++) {
+      kpic[k] = 0;
+   }
+/* find addresses of particles at each tile and reorder particles */
+   for (j = 0; j < nop; j++) {
+      n = part[idimp*j];
+      m = part[1+idimp*j];
+      n = n/mx;
+      m = m/my;
+      m = n + mx1*m;
+      ip = kpic[m];
+      if (ip < nppmx) {
+         for (i = 0; i < idimp; i++) {
+            ppart[ip+nppmx*(i+idimp*m)] = part[i+idimp*j];
+         }
+      }
+      else {
+         ierr = ierr > ip-nppmx+1 ? ierr : ip-nppmx+1;
+      }
+      kpic[m] = ip + 1;
+   }
+   if (ierr > 0)
+      *irc = ierr;
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppcheck2lt(float ppart[], int kpic[], int idimp, int nppmx, int nx,
+                 int ny, int mx, int my, int mx1, int my1, 
+                 int *irc) {
+/* this subroutine performs a sanity check to make sure particles sorted
+   by x,y grid in tiles of mx, my, are all within bounds.
+   tiles are assumed to be arranged in 2D linear memory, and transposed
+   input: all except irc
+   output: irc
+   ppart[k][0][n] = position x of particle n in tile k
+   ppart[k][1][n] = position y of particle n in tile k
+   kpic[k] = number of reordered output particles in tile k
+   idimp = size of phase space = 4
+   nppmx = maximum number of particles in tile
+   nx/ny = system length in x/y direction
+   mx/my = number of grids in sorting cell in x/y
+   mx1 = (system length in x direction - 1)/mx + 1
+   my1 = (system length in y direction - 1)/my + 1
+   irc = particle error, returned only if error occurs, when irc > 0
+local data                                                            */
+   int mxy1, noff, moff, npp, j, k, ist, nn, mm;
+   float edgelx, edgely, edgerx, edgery, dx, dy;
+   mxy1 = mx1*my1;
+/* loop over tiles */
+#pragma omp parallel for \
+private(j,k,noff,moff,npp,nn,mm,ist,edgelx,edgely,edgerx,edgery,dx,dy)
+   for (k = 0; k < mxy1; k++) {
+      noff = k/mx1;
+      moff = my*noff;
+      noff = mx*(k - mx1*noff);
+      npp = kpic[k];
+      nn = nx - noff;
+      nn = mx < nn ? mx : nn;
+      mm = ny - moff;
+      mm = my < mm ? my : mm;
+      edgelx = noff;
+      edgerx = noff + nn;
+      edgely = moff;
+      edgery = moff + mm;
+/* loop over particles in tile */
+      for (j = 0; j < npp; j++) {
+         dx = ppart[j+nppmx*(idimp*k)];
+         dy = ppart[j+nppmx*(1+idimp*k)];
+/* find particles going out of bounds */
+         ist = 0;
+         if (dx < edgelx)
+            ist = 1;
+         if (dx >= edgerx)
+            ist = 2;
+         if (dy < edgely)
+            ist += 3;
+         if (dy >= edgery)
+            ist += 6;
+         if (ist > 0)
+            *irc = k + 1;
+      }
+   }
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cgppush2lt(float ppart[], float fxy[], int kpic[], float qbm,
+                float dt, float *ek, int idimp, int nppmx, int nx,
+                int ny, int mx, int my, int nxv, int nyv, int mx1,
+                int mxy1, int ipbc) {
+/* for 2d code, this subroutine updates particle co-ordinates and
+   velocities using leap-frog scheme in time and first-order linear
+   interpolation in space, with various boundary conditions.
+   OpenMP version using guard cells
+   data read in tiles
+   particles stored segmented array
+   44 flops/particle, 12 loads, 4 stores
+   input: all, output: ppart, ek
+   equations used are:
+   vx(t+dt/2) = vx(t-dt/2) + (q/m)*fx(x(t),y(t))*dt,
+   vy(t+dt/2) = vy(t-dt/2) + (q/m)*fy(x(t),y(t))*dt,
+   where q/m is charge/mass, and
+   x(t+dt) = x(t) + vx(t+dt/2)*dt, y(t+dt) = y(t) + vy(t+dt/2)*dt
+   fx(x(t),y(t)) and fy(x(t),y(t)) are approximated by interpolation from
+   the nearest grid points:
+   fx(x,y) = (1-dy)*((1-dx)*fx(n,m)+dx*fx(n+1,m)) + dy*((1-dx)*fx(n,m+1)
+      + dx*fx(n+1,m+1))
+   fy(x,y) = (1-dy)*((1-dx)*fy(n,m)+dx*fy(n+1,m)) + dy*((1-dx)*fy(n,m+1)
+      + dx*fy(n+1,m+1))
+   where n,m = leftmost grid points and dx = x-n, dy = y-m
+   ppart[m][0][n] = position x of particle n in tile m
+   ppart[m][1][n] = position y of particle n in tile m
+   ppart[m][2][n] = velocity vx of particle n in tile m
+   ppart[m][3][n] = velocity vy of particle n in tile m
+   fxy[k][j][0] = x component of force/charge at grid (j,k)
+   fxy[k][j][1] = y component of force/charge at grid (j,k)
+   that is, convolution of electric field over particle shape
+   kpic = number of particles per tile
+   qbm = particle charge/mass
+   dt = time interval between successive calculations
+   kinetic energy/mass at time t is also calculated, using
+   ek = .125*sum((vx(t+dt/2)+vx(t-dt/2))**2+(vy(t+dt/2)+vy(t-dt/2))**2)
+   idimp = size of phase space = 4
+   nppmx = maximum number of particles in tile
+   nx/ny = system length in x/y direction
+   mx/my = number of grids in sorting cell in x/y
+   nxv = second dimension of field arrays, must be >= nx+1
+   nyv = third dimension of field arrays, must be >= ny+1
+   mx1 = (system length in x direction - 1)/mx + 1
+   mxy1 = mx1*my1, where my1 = (system length in y direction - 1)/my + 1
+   ipbc = particle boundary condition = (0,1,2,3) =
+   (none,2d periodic,2d reflecting,mixed reflecting/periodic)
+local data                                                            */
+   int noff, moff, npoff, npp, nseg;
+   int i, j, k, nn, mm, mxv;
+   float qtm, edgelx, edgely, edgerx, edgery, dxp, dyp, amx, amy;
+   float x, y, dx, dy, vx, vy;
+   float *scr, *sfxy;
+   double sum1, sum2;
+   mxv = mx + 1;
+   qtm = qbm*dt;
+   sum2 = 0.0;
+/* set boundary values */
+   edgelx = 0.0f;
+   edgely = 0.0f;
+   edgerx = (float) nx;
+   edgery = (float) ny;
+   if (ipbc==2) {
+      edgelx = 1.0f;
+      edgely = 1.0f;
+      edgerx = (float) (nx-1);
+      edgery = (float) (ny-1);
+   }
+   else if (ipbc==3) {
+      edgelx = 1.0f;
+      edgerx = (float) (nx-1);
+   }
+/* find aligned scratch space for local fields in each thread */
+   scr = cgetscr2l(2*mxv*(my+1),&nseg);
+/* loop over tiles */
+#pragma omp parallel for \
+private(i,j,k,noff,moff,npp,npoff,nn,mm,x,y,dxp,dyp,amx,amy,dx,dy,vx, \
+vy,sum1,sfxy) \
+reduction(+:sum2)
+   for (k = 0; k < mxy1; k++) {
+      sfxy = scr + nseg*cthreadnum();
+      noff = k/mx1;
+      moff = my*noff;
+      noff = mx*(k - mx1*noff);
+      npp = kpic[k];
+      npoff = idimp*nppmx*k;
+/* load local fields from global array */
+      nn = (mx < nx-noff ? mx : nx-noff) + 1;
+      mm = (my < ny-moff ? my : ny-moff) + 1;
+      for (j = 0; j < mm; j++) {
+         for (i = 0; i < nn; i++) {
+            sfxy[2*(i+mxv*j)] = fxy[2*(i+noff+nxv*(j+moff))];
+            sfxy[1+2*(i+mxv*j)] = fxy[1+2*(i+noff+nxv*(j+moff))];
+         }
+      }
+      sum1 = 0.0;
+/* loop over particles in tile */
+      for (j = 0; j < npp; j++) {
+/* find interpolation weights */
+         x = ppart[j+npoff];
+         y = ppart[j+nppmx+npoff];
+         nn = x;
+         mm = y;
+         dxp = x - (float) nn;
+         dyp = y - (float) mm;
+         nn = 2*(nn - noff + mxv*(mm - moff));
+         amx = 1.0f - dxp;
+         amy = 1.0f - dyp;
+/* find acceleration */
+         dx = amx*sfxy[nn];
+         dy = amx*sfxy[nn+1];
+         dx = amy*(dxp*sfxy[nn+2] + dx);
+         dy = amy*(dxp*sfxy[nn+3] + dy);
+         nn += 2*mxv;
+         vx = amx*sfxy[nn];
+         vy = amx*sfxy[nn+1];
+         dx += dyp*(dxp*sfxy[nn+2] + vx);
+         dy += dyp*(dxp*sfxy[nn+3] + vy);
+/* new velocity */
+         dxp = ppart[j+2*nppmx+npoff];
+         dyp = ppart[j+3*nppmx+npoff];
+         vx = dxp + qtm*dx;
+         vy = dyp + qtm*dy;
+/* average kinetic energy */
+         dxp += vx;
+         dyp += vy;
+         sum1 += dxp*dxp + dyp*dyp;
+/* new position */
+         dx = x + vx*dt;
+         dy = y + vy*dt;
+/* reflecting boundary conditions */
+         if (ipbc==2) {
+            if ((dx < edgelx) || (dx >= edgerx)) {
+               dx = x;
+               vx = -vx;
+            }
+            if ((dy < edgely) || (dy >= edgery)) {
+               dy = y;
+               vy = -vy;
+            }
+         }
+/* mixed reflecting/periodic boundary conditions */
+         else if (ipbc==3) {
+            if ((dx < edgelx) || (dx >= edgerx)) {
+               dx = x;
+               vx = -vx;
+            }
+         }
+/* set new position */
+         ppart[j+npoff] = dx;
+         ppart[j+nppmx+npoff] = dy;
+/* set new velocity */
+         ppart[j+2*nppmx+npoff] = vx;
+         ppart[j+3*nppmx+npoff] = vy;
+      }
+      sum2 += sum1;
+   }
+/* normalize kinetic energy */
+   *ek += 0.125f*sum2;
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cgppushf2lt(float ppart[], float fxy[], int kpic[], int ncl[],
+                 int ihole[], float qbm, float dt, float *ek, int idimp,
+                 int nppmx, int nx, int ny, int mx, int my, int nxv,
+                 int nyv, int mx1, int mxy1, int ntmax, int *irc) {
+/* for 2d code, this subroutine updates particle co-ordinates and
+   velocities using leap-frog scheme in time and first-order linear
+   interpolation in space, with periodic boundary conditions.
+   also determines list of particles which are leaving this tile
+   OpenMP version using guard cells
+   data read in tiles
+   particles stored segmented array
+   44 flops/particle, 12 loads, 4 stores
+   input: all except ncl, ihole, irc, output: ppart, ncl, ihole, ek, irc
+   equations used are:
+   vx(t+dt/2) = vx(t-dt/2) + (q/m)*fx(x(t),y(t))*dt,
+   vy(t+dt/2) = vy(t-dt/2) + (q/m)*fy(x(t),y(t))*dt,
+   where q/m is charge/mass, and
+   x(t+dt) = x(t) + vx(t+dt/2)*dt, y(t+dt) = y(t) + vy(t+dt/2)*dt
+   fx(x(t),y(t)) and fy(x(t),y(t)) are approximated by interpolation from
+   the nearest grid points:
+   fx(x,y) = (1-dy)*((1-dx)*fx(n,m)+dx*fx(n+1,m)) + dy*((1-dx)*fx(n,m+1)
+      + dx*fx(n+1,m+1))
+   fy(x,y) = (1-dy)*((1-dx)*fy(n,m)+dx*fy(n+1,m)) + dy*((1-dx)*fy(n,m+1)
+      + dx*fy(n+1,m+1))
+   where n,m = leftmost grid points and dx = x-n, dy = y-m
+   ppart[m][0][n] = position x of particle n in tile m
+   ppart[m][1][n] = position y of particle n in tile m
+   ppart[m][2][n] = velocity vx of particle n in tile m
+   ppart[m][3][n] = velocity vy of particle n in tile m
+   fxy[k][j][0] = x component of force/charge at grid (j,k)
+   fxy[k][j][1] = y component of force/charge at grid (j,k)
+   that is, convolution of electric field over particle shape
+   kpic[k] = number of particles in tile k
+   ncl[k][i] = number of particles going to destination i, tile k
+   ihole[k][:][0] = location of hole in array left by departing particle
+   ihole[k][:][1] = destination of particle leaving hole
+   ihole[k][0][0] = ih, number of holes left (error, if negative)
+   qbm = particle charge/mass
+   dt = time interval between successive calculations
+   kinetic energy/mass at time t is also calculated, using
+   ek = .125*sum((vx(t+dt/2)+vx(t-dt/2))**2+(vy(t+dt/2)+vy(t-dt/2))**2)
+   idimp = size of phase space = 4
+   nppmx = maximum number of particles in tile
+   nx/ny = system length in x/y direction
+   mx/my = number of grids in sorting cell in x/y
+   nxv = second dimension of field arrays, must be >= nx+1
+   nyv = third dimension of field arrays, must be >= ny+1
+   mx1 = (system length in x direction - 1)/mx + 1
+   mxy1 = mx1*my1, where my1 = (system length in y direction - 1)/my + 1
+   ntmax = size of hole array for particles leaving tiles
+   irc = maximum overflow, returned only if error occurs, when irc > 0
+   optimized version
+local data                                                            */
+   int noff, moff, npoff, npp, nseg;
+   int i, j, k, ih, nh, nn, mm, mxv;
+   float qtm, dxp, dyp, amx, amy;
+   float x, y, dx, dy, vx, vy;
+   float anx, any, edgelx, edgely, edgerx, edgery;
+   float *scr, *sfxy;
+   double sum1, sum2;
+   mxv = mx + 1;
+   qtm = qbm*dt;
+   anx = (float) nx;
+   any = (float) ny;
+   sum2 = 0.0;
+/* find aligned scratch space for local fields in each thread */
+   scr = cgetscr2l(2*mxv*(my+1),&nseg);
+/* loop over tiles */
+#pragma omp parallel for \
+private(i,j,k,noff,moff,npp,npoff,nn,mm,ih,nh,x,y,dxp,dyp,amx,amy, \
+dx,dy,vx,vy,edgelx,edgely,edgerx,edgery,sum1,sfxy) \
+reduction(+:sum2)
+   for (k = 0; k < mxy1; k++) {
+      sfxy = scr + nseg*cthreadnum();
+      noff = k/mx1;
+      moff = my*noff;
+      noff = mx*(k - mx1*noff);
+      npp = kpic[k];
+      npoff = idimp*nppmx*k;
+      nn = nx - noff;
+      nn = mx < nn ? mx : nn;
+      mm = ny - moff;
+      mm = my < mm ? my : mm;
+      edgelx = noff;
+      edgerx = noff + nn;
+      edgely = moff;
+      edgery = moff + mm;
+      ih = 0;
+      nh = 0;
+      nn += 1;
+      mm += 1;
+/* load local fields from global array */
+      for (j = 0; j < mm; j++) {
+         for (i = 0; i < nn; i++) {
+            sfxy[2*(i+mxv*j)] = fxy[2*(i+noff+nxv*(j+moff))];
+            sfxy[1+2*(i+mxv*j)] = fxy[1+2*(i+noff+nxv*(j+moff))];
+         }
+      }
+/* clear counters */
+      for (j = 0; j < 8; j++) {
+         ncl[j+8*k] = 0;
+      }
+      sum1 = 0.0;
+/* loop over particles in tile */
+      for (j = 0; j < npp; j++) {
+/* find interpolation weights */
+         x = ppart[j+npoff];
+         y = ppart[j+nppmx+npoff];
+         nn = x;
+         mm = y;
+         dxp = x - (float) nn;
+         dyp = y - (float) mm;
+         nn = 2*(nn - noff + mxv*(mm - moff));
+         amx = 1.0f - dxp;
+         amy = 1.0f - dyp;
+/* find acceleration */
+         dx = amx*sfxy[nn];
+         dy = amx*sfxy[nn+1];
+         dx = amy*(dxp*sfxy[nn+2] + dx);
+         dy = amy*(dxp*sfxy[nn+3] + dy);
+         nn += 2*mxv;
+         vx = amx*sfxy[nn];
+         vy = amx*sfxy[nn+1];
+         dx += dyp*(dxp*sfxy[nn+2] + vx);
+         dy += dyp*(dxp*sfxy[nn+3] + vy);
+/* new velocity */
+         dxp = ppart[j+2*nppmx+npoff];
+         dyp = ppart[j+3*nppmx+npoff];
+         vx = dxp + qtm*dx;
+         vy = dyp + qtm*dy;
+/* average kinetic energy */
+         dxp += vx;
+         dyp += vy;
+         sum1 += dxp*dxp + dyp*dyp;
+/* new position */
+         dx = x + vx*dt;
+         dy = y + vy*dt;
+/* find particles going out of bounds */
+         mm = 0;
+/* count how many particles are going in each direction in ncl   */
+/* save their address and destination in ihole                   */
+/* use periodic boundary conditions and check for roundoff error */
+/* mm = direction particle is going                              */
+         if (dx >= edgerx) {
+            if (dx >= anx)
+               dx -= anx;
+            mm = 2;
+         }
+         else if (dx < edgelx) {
+            if (dx < 0.0f) {
+               dx += anx;
+               if (dx < anx)
+                  mm = 1;
+               else
+                  dx = 0.0;
+            }
+            else {
+               mm = 1;
+            }
+         }
+         if (dy >= edgery) {
+            if (dy >= any)
+               dy -= any;
+            mm += 6;
+         }
+         else if (dy < edgely) {
+            if (dy < 0.0) {
+               dy += any;
+               if (dy < any)
+                  mm += 3;
+               else
+                  dy = 0.0;
+            }
+            else {
+               mm += 3;
+            }
+         }
+/* set new position */
+         ppart[j+npoff] = dx;
+         ppart[j+nppmx+npoff] = dy;
+/* set new velocity */
+         ppart[j+2*nppmx+npoff] = vx;
+         ppart[j+3*nppmx+npoff] = vy;
+/* increment counters */
+         if (mm > 0) {
+            ncl[mm+8*k-1] += 1;
+            ih += 1;
+            if (ih <= ntmax) {
+               ihole[2*(ih+(ntmax+1)*k)] = j + 1;
+               ihole[1+2*(ih+(ntmax+1)*k)] = mm;
+            }
+            else {
+               nh = 1;
+            }
+         }
+      }
+      sum2 += sum1;
+/* set error and end of file flag */
+/* ihole overflow */
+      if (nh > 0) {
+         *irc = ih;
+         ih = -ih;
+      }
+      ihole[2*(ntmax+1)*k] = ih;
+   }
+/* normalize kinetic energy */
+   *ek += 0.125f*sum2;
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cvgppush2lt(float ppart[], float fxy[], int kpic[], float qbm,
+                 float dt, float *ek, int idimp, int nppmx, int nx,
+                 int ny, int mx, int my, int nxv, int nyv, int mx1,
+                 int mxy1, int ipbc) {
+/* for 2d code, this subroutine updates particle co-ordinates and
+   velocities using leap-frog scheme in time and first-order linear
+   interpolation in space, with various boundary conditions.
+   vectorizable/OpenMP version using guard cells
+   data read in tiles
+   particles stored segmented array
+   44 flops/particle, 12 loads, 4 stores
+   input: all, output: ppart, ek
+   equations used are:
+   vx(t+dt/2) = vx(t-dt/2) + (q/m)*fx(x(t),y(t))*dt,
+   vy(t+dt/2) = vy(t-dt/2) + (q/m)*fy(x(t),y(t))*dt,
+   where q/m is charge/mass, and
+   x(t+dt) = x(t) + vx(t+dt/2)*dt, y(t+dt) = y(t) + vy(t+dt/2)*dt
+   fx(x(t),y(t)) and fy(x(t),y(t)) are approximated by interpolation from
+   the nearest grid points:
+   fx(x,y) = (1-dy)*((1-dx)*fx(n,m)+dx*fx(n+1,m)) + dy*((1-dx)*fx(n,m+1)
+      + dx*fx(n+1,m+1))
+   fy(x,y) = (1-dy)*((1-dx)*fy(n,m)+dx*fy(n+1,m)) + dy*((1-dx)*fy(n,m+1)
+      + dx*fy(n+1,m+1))
+   where n,m = leftmost grid points and dx = x-n, dy = y-m
+   ppart[m][0][n] = position x of particle n in tile m
+   ppart[m][1][n] = position y of particle n in tile m
+   ppart[m][2][n] = velocity vx of particle n in tile m
+   ppart[m][3][n] = velocity vy of particle n in tile m
+   fxy[k][j][0] = x component of force/charge at grid (j,k)
+   fxy[k][j][1] = y component of force/charge at grid (j,k)
+   that is, convolution of electric field over particle shape
+   kpic = number of particles per tile
+   qbm = particle charge/mass
+   dt = time interval between successive calculations
+   kinetic energy/mass at time t is also calculated, using
+   ek = .125*sum((vx(t+dt/2)+vx(t-dt/2))**2+(vy(t+dt/2)+vy(t-dt/2))**2)
+   idimp = size of phase space = 4
+   nppmx = maximum number of particles in tile
+   nx/ny = system length in x/y direction
+   mx/my = number of grids in sorting cell in x/y
+   nxv = second dimension of field arrays, must be >= nx+1
+   nyv = third dimension of field arrays, must be >= ny+1
+   mx1 = (system length in x direction - 1)/mx + 1
+   mxy1 = mx1*my1, where my1 = (system length in y direction - 1)/my + 1
+   ipbc = particle boundary condition = (0,1,2,3) =
+   (none,2d periodic,2d reflecting,mixed reflecting/periodic)
+local data                                                            */
+#define NPBLK             32
+#define LVECT             4
+   int noff, moff, npoff, npp, ipp, joff, nps, nseg;
+   int i, j, k, m, nn, mm, lxv;
+   float qtm, edgelx, edgely, edgerx, edgery, dxp, dyp, amx, amy;
+   float x, y, dx, dy, vx, vy;
+   float *scr, *sfxy;
+/* scratch arrays */
+   int n[NPBLK];
+   float s[NPBLK*LVECT], t[NPBLK*2];
+   double sum1, sum2;
+   lxv = mx + 1;
+   qtm = qbm*dt;
+   sum2 = 0.0;
+/* set boundary values */
+   edgelx = 0.0f;
+   edgely = 0.0f;
+   edgerx = (float) nx;
+   edgery = (float) ny;
+   if (ipbc==2) {
+      edgelx = 1.0f;
+      edgely = 1.0f;
+      edgerx = (float) (nx-1);
+      edgery = (float) (ny-1);
+   }
+   else if (ipbc==3) {
+      edgelx = 1.0f;
+      edgerx = (float) (nx-1);
+   }
+/* find aligned scratch space for local fields in each thread */
+   scr = cgetscr2l(2*lxv*(my+1),&nseg);
+/* loop over tiles */
+#pragma omp parallel for \
+private(i,j,k,m,noff,moff,npp,npoff,ipp,joff,nps,nn,mm,x,y,dxp,dyp, \
+amx,amy,dx,dy,vx,vy,sum1,sfxy,n,s,t) \
+reduction(+:sum2)
+   for (k = 0; k < mxy1; k++) {
+      sfxy = scr + nseg*cthreadnum();
+      noff = k/mx1;
+      moff = my*noff;
+      noff = mx*(k - mx1*noff);
+      npp = kpic[k];
+      npoff = idimp*nppmx*k;
+/* load local fields from global array */
+      nn = (mx < nx-noff ? mx : nx-noff) + 1;
+      mm = (my < ny-moff ? my : ny-moff) + 1;
+      for (j = 0; j < mm; j++) {
+         for (i = 0; i < nn; i++) {
+            sfxy[2*(i+lxv*j)] = fxy[2*(i+noff+nxv*(j+moff))];
+            sfxy[1+2*(i+lxv*j)] = fxy[1+2*(i+noff+nxv*(j+moff))];
+         }
+      }
+      sum1 = 0.0;
+/* loop over particles in tile */
+      ipp = npp/NPBLK;
+/* outer loop over number of full blocks */
+      for (m = 0; m < ipp; m++) {
+         joff = NPBLK*m;
+/* inner loop over particles in block */
+         for (j = 0; j < NPBLK; j++) {
+/* find interpolation weights */
+            x = ppart[j+joff+npoff];
+            y = ppart[j+joff+nppmx+npoff];
+            nn = x;
+            mm = y;
+            dxp = x - (float) nn;
+            dyp = y - (float) mm;
+            n[j] = nn - noff + lxv*(mm - moff);
+            amx = 1.0f - dxp;
+            amy = 1.0f - dyp;
+            s[j] = amx*amy;
+            s[j+NPBLK] = dxp*amy;
+            s[j+2*NPBLK] = amx*dyp;
+            s[j+3*NPBLK] = dxp*dyp;
+            t[j] = x;
+            t[j+NPBLK] = y;
+         }
+/* find acceleration */
+         for (j = 0; j < NPBLK; j++) {
+            nn = n[j];
+            mm = nn + lxv - 2;
+            dx = 0.0f;
+            dy = 0.0f;
+            for (i = 0; i < LVECT; i++) {
+               if (i > 1)
+                  nn = mm;
+               dx += sfxy[2*(i+nn)]*s[j+NPBLK*i];
+               dy += sfxy[1+2*(i+nn)]*s[j+NPBLK*i];
+            }
+            s[j] = dx;
+            s[j+NPBLK] = dy;
+         }
+/* new velocity */
+         for (j = 0; j < NPBLK; j++) {
+            x = t[j];
+            y = t[j+NPBLK];
+            dxp = ppart[j+joff+2*nppmx+npoff];
+            dyp = ppart[j+joff+3*nppmx+npoff];
+            vx = dxp + qtm*s[j];
+            vy = dyp + qtm*s[j+NPBLK];
+/* average kinetic energy */
+            dxp += vx;
+            dyp += vy;
+            sum1 += dxp*dxp + dyp*dyp;
+/* new position */
+            s[j] = x + vx*dt;
+            s[j+NPBLK] = y + vy*dt;
+            s[j+2*NPBLK] = vx;
+            s[j+3*NPBLK] = vy;
+         }
+/* check boundary conditions */
+         for (j = 0; j < NPBLK; j++) {
+            dx = s[j];
+            dy = s[j+NPBLK];
+            vx = s[j+2*NPBLK];
+            vy = s[j+3*NPBLK];
+/* reflecting boundary conditions */
+            if (ipbc==2) {
+               if ((dx < edgelx) || (dx >= edgerx)) {
+                  dx = t[j];
+                  vx = -vx;
+               }
+               if ((dy < edgely) || (dy >= edgery)) {
+                  dy = t[j+NPBLK];
+                  vy = -vy;
+               }
+            }
+/* mixed reflecting/periodic boundary conditions */
+            else if (ipbc==3) {
+               if ((dx < edgelx) || (dx >= edgerx)) {
+                  dx = t[j];
+                  vx = -vx;
+               }
+            }
+/* set new position */
+            ppart[j+joff+npoff] = dx;
+            ppart[j+joff+nppmx+npoff] = dy;
+/* set new velocity */
+            ppart[j+joff+2*nppmx+npoff] = vx;
+            ppart[j+joff+3*nppmx+npoff] = vy;
+         }
+      }
+      nps = NPBLK*ipp;
+/* loop over remaining particles */
+      for (j = nps; j < npp; j++) {
+/* find interpolation weights */
+         x = ppart[j+npoff];
+         y = ppart[j+nppmx+npoff];
+         nn = x;
+         mm = y;
+         dxp = x - (float) nn;
+         dyp = y - (float) mm;
+         nn = 2*(nn - noff + lxv*(mm - moff));
+         amx = 1.0f - dxp;
+         amy = 1.0f - dyp;
+/* find acceleration */
+         dx = amx*sfxy[nn];
+         dy = amx*sfxy[nn+1];
+         dx = amy*(dxp*sfxy[nn+2] + dx);
+         dy = amy*(dxp*sfxy[nn+3] + dy);
+         nn += 2*lxv;
+         vx = amx*sfxy[nn];
+         vy = amx*sfxy[nn+1];
+         dx += dyp*(dxp*sfxy[nn+2] + vx);
+         dy += dyp*(dxp*sfxy[nn+3] + vy);
+/* new velocity */
+         dxp = ppart[j+2*nppmx+npoff];
+         dyp = ppart[j+3*nppmx+npoff];
+         vx = dxp + qtm*dx;
+         vy = dyp + qtm*dy;
+/* average kinetic energy */
+         dxp += vx;
+         dyp += vy;
+         sum1 += dxp*dxp + dyp*dyp;
+/* new position */
+         dx = x + vx*dt;
+         dy = y + vy*dt;
+/* reflecting boundary conditions */
+         if (ipbc==2) {
+            if ((dx < edgelx) || (dx >= edgerx)) {
+               dx = x;
+               vx = -vx;
+            }
+            if ((dy < edgely) || (dy >= edgery)) {
+               dy = y;
+               vy = -vy;
+            }
+         }
+/* mixed reflecting/periodic boundary conditions */
+         else if (ipbc==3) {
+            if ((dx < edgelx) || (dx >= edgerx)) {
+               dx = x;
+               vx = -vx;
+            }
+         }
+/* set new position */
+         ppart[j+npoff] = dx;
+         ppart[j+nppmx+npoff] = dy;
+/* set new velocity */
+         ppart[j+2*nppmx+npoff] = vx;
+         ppart[j+3*nppmx+npoff] = vy;
+      }
+      sum2 += sum1;
+   }
+/* normalize kinetic energy */
+   *ek += 0.125f*sum2;
+   return;
+#undef LVECT
+#undef NPBLK
+}
+
+/*--------------------------------------------------------------------*/
+void cvgppushf2lt(float ppart[], float fxy[], int kpic[], int ncl[],
+                  int ihole[], float qbm, float dt, float *ek,
+                  int idimp, int nppmx, int nx, int ny, int mx, int my,
+                  int nxv, int nyv, int mx1, int mxy1, int ntmax,
+                  int *irc) {
+/* for 2d code, this subroutine updates particle co-ordinates and
+   velocities using leap-frog scheme in time and first-order linear
+   interpolation in space, with periodic boundary conditions.
+   also determines list of particles which are leaving this tile
+   vectorizable/OpenMP version using guard cells
+   data read in tiles
+   particles stored segmented array
+   44 flops/particle, 12 loads, 4 stores
+   input: all except ncl, ihole, irc, output: ppart, ncl, ihole, ek, irc
+   equations used are:
+   vx(t+dt/2) = vx(t-dt/2) + (q/m)*fx(x(t),y(t))*dt,
+   vy(t+dt/2) = vy(t-dt/2) + (q/m)*fy(x(t),y(t))*dt,
+   where q/m is charge/mass, and
+   x(t+dt) = x(t) + vx(t+dt/2)*dt, y(t+dt) = y(t) + vy(t+dt/2)*dt
+   fx(x(t),y(t)) and fy(x(t),y(t)) are approximated by interpolation from
+   the nearest grid points:
+   fx(x,y) = (1-dy)*((1-dx)*fx(n,m)+dx*fx(n+1,m)) + dy*((1-dx)*fx(n,m+1)
+      + dx*fx(n+1,m+1))
+   fy(x,y) = (1-dy)*((1-dx)*fy(n,m)+dx*fy(n+1,m)) + dy*((1-dx)*fy(n,m+1)
+      + dx*fy(n+1,m+1))
+   where n,m = leftmost grid points and dx = x-n, dy = y-m
+   ppart[m][0][n] = position x of particle n in tile m
+   ppart[m][1][n] = position y of particle n in tile m
+   ppart[m][2][n] = velocity vx of particle n in tile m
+   ppart[m][3][n] = velocity vy of particle n in tile m
+   fxy[k][j][0] = x component of force/charge at grid (j,k)
+   fxy[k][j][1] = y component of force/charge at grid (j,k)
+   that is, convolution of electric field over particle shape
+   kpic[k] = number of particles in tile k
+   ncl[k][i] = number of particles going to destination i, tile k
+   ihole[k][:][0] = location of hole in array left by departing particle
+   ihole[k][:][1] = destination of particle leaving hole
+   ihole[k][0][0] = ih, number of holes left (error, if negative)
+   qbm = particle charge/mass
+   dt = time interval between successive calculations
+   kinetic energy/mass at time t is also calculated, using
+   ek = .125*sum((vx(t+dt/2)+vx(t-dt/2))**2+(vy(t+dt/2)+vy(t-dt/2))**2)
+   idimp = size of phase space = 4
+   nppmx = maximum number of particles in tile
+   nx/ny = system length in x/y direction
+   mx/my = number of grids in sorting cell in x/y
+   nxv = second dimension of field arrays, must be >= nx+1
+   nyv = third dimension of field arrays, must be >= ny+1
+   mx1 = (system length in x direction - 1)/mx + 1
+   mxy1 = mx1*my1, where my1 = (system length in y direction - 1)/my + 1
+   ntmax = size of hole array for particles leaving tiles
+   irc = maximum overflow, returned only if error occurs, when irc > 0
+   optimized version
+local data                                                            */
+#define NPBLK             32
+#define LVECT             4
+   int noff, moff, npoff, npp, ipp, joff, nps, nseg;
+   int i, j, k, m, ih, nh, nn, mm, lxv;
+   float qtm, dxp, dyp, amx, amy;
+   float x, y, dx, dy, vx, vy;
+   float anx, any, edgelx, edgely, edgerx, edgery;
+   float *scr, *sfxy;
+/* scratch arrays */
+   int n[NPBLK];
+   float s[NPBLK*LVECT], t[NPBLK*2];
+   double sum1, sum2;
+   lxv = mx + 1;
+   qtm = qbm*dt;
+   anx = (float) nx;
+   any = (float) ny;
+   sum2 = 0.0;
+/* find aligned scratch space for local fields in each thread */
+   scr = cgetscr2l(2*lxv*(my+1),&nseg);
+/* loop over tiles */
+#pragma omp parallel for \
+private(i,j,k,m,noff,moff,npp,npoff,ipp,joff,nps,nn,mm,ih,nh,x,y,dxp, \
+dyp,amx,amy,dx,dy,vx,vy,edgelx,edgely,edgerx,edgery,sum1,sfxy,n,s,t) \
+reduction(+:sum2)
+   for (k = 0; k < mxy1; k++) {
+      sfxy = scr + nseg*cthreadnum();
+      noff = k/mx1;
+      moff = my*noff;
+      noff = mx*(k - mx1*noff);
+      npp = kpic[k];
+      npoff = idimp*nppmx*k;
+      nn = nx - noff;
+      nn = mx < nn ? mx : nn;
+      mm = ny - moff;
+      mm = my < mm ? my : mm;
+      edgelx = noff;
+      edgerx = noff + nn;
+      edgely = moff;
+      edgery = moff + mm;
+      ih = 0;
+      nh = 0;
+      nn += 1;
+      mm += 1;
+/* load local fields from global array */
+      for (j = 0; j < mm; j++) {
+         for (i = 0; i < nn; i++) {
+            sfxy[2*(i+lxv*j)] = fxy[2*(i+noff+nxv*(j+moff))];
+            sfxy[1+2*(i+lxv*j)] = fxy[1+2*(i+noff+nxv*(j+moff))];
+         }
+      }
+/* clear counters */
+      for (j = 0; j < 8; j++) {
+         ncl[j+8*k] = 0;
+      }
+      sum1 = 0.0;
+/* loop over particles in tile */
+      ipp = npp/NPBLK;
+/* outer loop over number of full blocks */
+      for (m = 0; m < ipp; m++) {
+         joff = NPBLK*m;
+/* inner loop over particles in block */
+         for (j = 0; j < NPBLK; j++) {
+/* find interpolation weights */
+            x = ppart[j+joff+npoff];
+            y = ppart[j+joff+nppmx+npoff];
+            nn = x;
+            mm = y;
+            dxp = x - (float) nn;
+            dyp = y - (float) mm;
+            n[j] = nn - noff + lxv*(mm - moff);
+            amx = 1.0f - dxp;
+            amy = 1.0f - dyp;
+            s[j] = amx*amy;
+            s[j+NPBLK] = dxp*amy;
+            s[j+2*NPBLK] = amx*dyp;
+            s[j+3*NPBLK] = dxp*dyp;
+            t[j] = x;
+            t[j+NPBLK] = y;
+         }
+/* find acceleration */
+         for (j = 0; j < NPBLK; j++) {
+            nn = n[j];
+            mm = nn + lxv - 2;
+            dx = 0.0f;
+            dy = 0.0f;
+            for (i = 0; i < LVECT; i++) {
+               if (i > 1)
+                  nn = mm;
+               dx += sfxy[2*(i+nn)]*s[j+NPBLK*i];
+               dy += sfxy[1+2*(i+nn)]*s[j+NPBLK*i];
+            }
+            s[j] = dx;
+            s[j+NPBLK] = dy;
+         }
+/* new velocity */
+         for (j = 0; j < NPBLK; j++) {
+            x = t[j];
+            y = t[j+NPBLK];
+            dxp = ppart[j+joff+2*nppmx+npoff];
+            dyp = ppart[j+joff+3*nppmx+npoff];
+            vx = dxp + qtm*s[j];
+            vy = dyp + qtm*s[j+NPBLK];
+/* average kinetic energy */
+            dxp += vx;
+            dyp += vy;
+            sum1 += dxp*dxp + dyp*dyp;
+/* new position */
+            s[j] = x + vx*dt;
+            s[j+NPBLK] = y + vy*dt;
+            s[j+2*NPBLK] = vx;
+            s[j+3*NPBLK] = vy;
+         }
+/* check boundary conditions */
+         for (j = 0; j < NPBLK; j++) {
+            dx = s[j];
+            dy = s[j+NPBLK];
+/* find particles going out of bounds */
+            mm = 0;
+/* count how many particles are going in each direction in ncl   */
+/* save their address and destination in ihole                   */
+/* use periodic boundary conditions and check for roundoff error */
+/* mm = direction particle is going                              */
+            if (dx >= edgerx) {
+               if (dx >= anx)
+                  dx -= anx;
+               mm = 2;
+            }
+            else if (dx < edgelx) {
+               if (dx < 0.0f) {
+                  dx += anx;
+                  if (dx < anx)
+                     mm = 1;
+                  else
+                     dx = 0.0;
+               }
+               else {
+                  mm = 1;
+               }
+            }
+            if (dy >= edgery) {
+               if (dy >= any)
+                  dy -= any;
+               mm += 6;
+            }
+            else if (dy < edgely) {
+               if (dy < 0.0) {
+                  dy += any;
+                  if (dy < any)
+                     mm += 3;
+                  else
+                     dy = 0.0;
+               }
+               else {
+                  mm += 3;
+               }
+            }
+/* set new position */
+            ppart[j+joff+npoff] = dx;
+            ppart[j+joff+nppmx+npoff] = dy;
+/* set new velocity */
+            ppart[j+joff+2*nppmx+npoff] = s[j+2*NPBLK];
+            ppart[j+joff+3*nppmx+npoff] = s[j+3*NPBLK];
+/* increment counters */
+            if (mm > 0) {
+               ncl[mm+8*k-1] += 1;
+               ih += 1;
+               if (ih <= ntmax) {
+                  ihole[2*(ih+(ntmax+1)*k)] = j + joff + 1;
+                  ihole[1+2*(ih+(ntmax+1)*k)] = mm;
+               }
+               else {
+                  nh = 1;
+               }
+            }
+         }
+      }
+      nps = NPBLK*ipp;
+/* loop over remaining particles */
+      for (j = nps; j < npp; j++) {
+/* find interpolation weights */
+         x = ppart[j+npoff];
+         y = ppart[j+nppmx+npoff];
+         nn = x;
+         mm = y;
+         dxp = x - (float) nn;
+         dyp = y - (float) mm;
+         nn = 2*(nn - noff + lxv*(mm - moff));
+         amx = 1.0f - dxp;
+         amy = 1.0f - dyp;
+/* find acceleration */
+         dx = amx*sfxy[nn];
+         dy = amx*sfxy[nn+1];
+         dx = amy*(dxp*sfxy[nn+2] + dx);
+         dy = amy*(dxp*sfxy[nn+3] + dy);
+         nn += 2*lxv;
+         vx = amx*sfxy[nn];
+         vy = amx*sfxy[nn+1];
+         dx += dyp*(dxp*sfxy[nn+2] + vx);
+         dy += dyp*(dxp*sfxy[nn+3] + vy);
+/* new velocity */
+         dxp = ppart[j+2*nppmx+npoff];
+         dyp = ppart[j+3*nppmx+npoff];
+         vx = dxp + qtm*dx;
+         vy = dyp + qtm*dy;
+/* average kinetic energy */
+         dxp += vx;
+         dyp += vy;
+         sum1 += dxp*dxp + dyp*dyp;
+/* new position */
+         dx = x + vx*dt;
+         dy = y + vy*dt;
+/* find particles going out of bounds */
+         mm = 0;
+/* count how many particles are going in each direction in ncl   */
+/* save their address and destination in ihole                   */
+/* use periodic boundary conditions and check for roundoff error */
+/* mm = direction particle is going                              */
+         if (dx >= edgerx) {
+            if (dx >= anx)
+               dx -= anx;
+            mm = 2;
+         }
+         else if (dx < edgelx) {
+            if (dx < 0.0f) {
+               dx += anx;
+               if (dx < anx)
+                  mm = 1;
+               else
+                  dx = 0.0;
+            }
+            else {
+               mm = 1;
+            }
+         }
+         if (dy >= edgery) {
+            if (dy >= any)
+               dy -= any;
+            mm += 6;
+         }
+         else if (dy < edgely) {
+            if (dy < 0.0) {
+               dy += any;
+               if (dy < any)
+                  mm += 3;
+               else
+                  dy = 0.0;
+            }
+            else {
+               mm += 3;
+            }
+         }
+/* set new position */
+         ppart[j+npoff] = dx;
+         ppart[j+nppmx+npoff] = dy;
+/* set new velocity */
+         ppart[j+2*nppmx+npoff] = vx;
+         ppart[j+3*nppmx+npoff] = vy;
+/* increment counters */
+         if (mm > 0) {
+            ncl[mm+8*k-1] += 1;
+            ih += 1;
+            if (ih <= ntmax) {
+               ihole[2*(ih+(ntmax+1)*k)] = j + 1;
+               ihole[1+2*(ih+(ntmax+1)*k)] = mm;
+            }
+            else {
+               nh = 1;
+            }
+         }
+      }
+      sum2 += sum1;
+/* set error and end of file flag */
+/* ihole overflow */
+      if (nh > 0) {
+         *irc = ih;
+         ih = -ih;
+      }
+      ihole[2*(ntmax+1)*k] = ih;
+   }
+/* normalize kinetic energy */
+   *ek += 0.125f*sum2;
+   return;
+#undef LVECT
+#undef NPBLK
+}
+
+/*--------------------------------------------------------------------*/
+void cgppost2lt(float ppart[], float q[], int kpic[], float qm,
+                int nppmx, int idimp, int mx, int my, int nxv, int nyv,
+                int mx1, int mxy1) {
+/* for 2d code, this subroutine calculates particle charge density
+   using first-order linear interpolation, periodic boundaries
+   OpenMP version using guard cells
+   data deposited in tiles
+   particles stored segmented array
+   17 flops/particle, 6 loads, 4 stores
+   input: all, output: q
+   charge density is approximated by values at the nearest grid points
+   q(n,m)=qm*(1.-dx)*(1.-dy)
+   q(n+1,m)=qm*dx*(1.-dy)
+   q(n,m+1)=qm*(1.-dx)*dy
+   q(n+1,m+1)=qm*dx*dy
+   where n,m = leftmost grid points and dx = x-n, dy = y-m
+   ppart[m][0][n] = position x of particle n in tile m
+   ppart[m][1][n] = position y of particle n in tile m
+   q[k][j] = charge density at grid point j,k
+   kpic = number of particles per tile
+   qm = charge on particle, in units of e
+   nppmx = maximum number of particles in tile
+   idimp = size of phase space = 4
+   mx/my = number of grids in sorting cell in x/y
+   nxv = first dimension of charge array, must be >= nx+1
+   nyv = second dimension of charge array, must be >= ny+1
+   mx1 = (system length in x direction - 1)/mx + 1
+   mxy1 = mx1*my1, where my1 = (system length in y direction - 1)/my + 1
+local data                                                            */
+   int noff, moff, npoff, npp, mxv, nseg;
+   int i, j, k, nn, mm;
+   float x, y, dxp, dyp, amx, amy;
+   float *scr, *sq;
+   mxv = mx + 1;
+/* find aligned scratch space for local charge in each thread */
+   scr = cgetscr2l(mxv*(my+1),&nseg);
+/* loop over tiles */
+#pragma omp parallel for \
+private(i,j,k,noff,moff,npp,npoff,nn,mm,x,y,dxp,dyp,amx,amy,sq)
+   for (k = 0; k < mxy1; k++) {
+      sq = scr + nseg*cthreadnum();
+      noff = k/mx1;
+      moff = my*noff;
+      noff = mx*(k - mx1*noff);
+      npp = kpic[k];
+      npoff = idimp*nppmx*k;
+/* zero out local accumulator */
+      for (j = 0; j < mxv*(my+1); j++) {
+         sq[j] = 0.0f;
+      }
+/* loop over particles in tile */
+      for (j = 0; j < npp; j++) {
+/* find interpolation weights */
+         x = ppart[j+npoff];
+         y = ppart[j+nppmx+npoff];
+         nn = x;
+         mm = y;
+         dxp = qm*(x - (float) nn);
+         dyp = y - (float) mm;
+         nn = nn - noff + mxv*(mm - moff);
+         amx = qm - dxp;
+         amy = 1.0f - dyp;
+/* deposit charge within tile to local accumulator */
+         x = sq[nn] + amx*amy;
+         y = sq[nn+1] + dxp*amy;
+         sq[nn] = x;
+         sq[nn+1] = y;
+         nn += mxv;
+         x = sq[nn] + amx*dyp;
+         y = sq[nn+1] + dxp*dyp;
+         sq[nn] = x;
+         sq[nn+1] = y;
+      }
+/* deposit charge to interior points in global array */
+      nn = nxv - noff;
+      mm = nyv - moff;
+      nn = mx < nn ? mx : nn;
+      mm = my < mm ? my : mm;
+      for (j = 1; j < mm; j++) {
+         for (i = 1; i < nn; i++) {
+            q[i+noff+nxv*(j+moff)] += sq[i+mxv*j];
+         }
+      }
+/* deposit charge to edge points in global array */
+      mm = nyv - moff;
+      mm = my+1 < mm ? my+1 : mm;
+      for (i = 1; i < nn; i++) {
+#pragma omp atomic
+         q[i+noff+nxv*moff] += sq[i];
+         if (mm > my) {
+#pragma omp atomic
+            q[i+noff+nxv*(mm+moff-1)] += sq[i+mxv*(mm-1)];
+         }
+      }
+      nn = nxv - noff;
+      nn = mx+1 < nn ? mx+1 : nn;
+      for (j = 0; j < mm; j++) {
+#pragma omp atomic
+         q[noff+nxv*(j+moff)] += sq[mxv*j];
+         if (nn > mx) {
+#pragma omp atomic
+            q[nn+noff-1+nxv*(j+moff)] += sq[nn-1+mxv*j];
+         }
+      }
+   }
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cvgppost2lt(float ppart[], float q[], int kpic[], float qm,
+                 int nppmx, int idimp, int mx, int my, int nxv, int nyv,
+                 int mx1, int mxy1) {
+/* for 2d code, this subroutine calculates particle charge density
+   using first-order linear interpolation, periodic boundaries
+   vectorizable/OpenMP version using guard cells
+   data deposited in tiles
+   particles stored segmented array
+   17 flops/particle, 6 loads, 4 stores
+   input: all, output: q
+   charge density is approximated by values at the nearest grid points
+   q(n,m)=qm*(1.-dx)*(1.-dy)
+   q(n+1,m)=qm*dx*(1.-dy)
+   q(n,m+1)=qm*(1.-dx)*dy
+   q(n+1,m+1)=qm*dx*dy
+   where n,m = leftmost grid points and dx = x-n, dy = y-m
+   ppart[m][0][n] = position x of particle n in tile m
+   ppart[m][1][n] = position y of particle n in tile m
+   q[k][j] = charge density at grid point j,k
+   kpic = number of particles per tile
+   qm = charge on particle, in units of e
+   nppmx = maximum number of particles in tile
+   idimp = size of phase space = 4
+   mx/my = number of grids in sorting cell in x/y
+   nxv = first dimension of charge array, must be >= nx+1
+   nyv = second dimension of charge array, must be >= ny+1
+   mx1 = (system length in x direction - 1)/mx + 1
+   mxy1 = mx1*my1, where my1 = (system length in y direction - 1)/my + 1
+local data                                                            */
+#define NPBLK             32
+#define LVECT             4
+   int noff, moff, npoff, npp, ipp, joff, nps, nseg;
+   int i, j, k, m, nn, mm, lxv;
+   float x, y, dxp, dyp, amx, amy;
+   float *scr, *sq;
+/* scratch arrays */
+   int n[NPBLK];
+   float s[NPBLK*LVECT];
+   lxv = mx + 1;
+/* find aligned scratch space for local charge in each thread */
+   scr = cgetscr2l(lxv*(my+1),&nseg);
+/* loop over tiles */
+#pragma omp parallel for \
+private(i,j,k,m,noff,moff,npp,npoff,ipp,joff,nps,nn,mm,x,y,dxp,dyp, \
+amx,amy,sq,n,s)
+   for (k = 0; k < mxy1; k++) {
+      sq = scr + nseg*cthreadnum();
+      noff = k/mx1;
+      moff = my*noff;
+      noff = mx*(k - mx1*noff);
+      npp = kpic[k];
+      npoff = idimp*nppmx*k;
+/* zero out local accumulator */
+      for (j = 0; j < lxv*(my+1); j++) {
+         sq[j] = 0.0f;
+      }
+/* loop over particles in tile */
+      ipp = npp/NPBLK;
+/* outer loop over number of full blocks */
+      for (m = 0; m < ipp; m++) {
+         joff = NPBLK*m;
+/* inner loop over particles in block */
+         for (j = 0; j < NPBLK; j++) {
+/* find interpolation weights */
+            x = ppart[j+joff+npoff];
+            y = ppart[j+joff+nppmx+npoff];
+            nn = x;
+            mm = y;
+            dxp = qm*(x - (float) nn);
+            dyp = y - (float) mm;
+            n[j] = nn - noff + lxv*(mm - moff);
+            amx = qm - dxp;
+            amy = 1.0f - dyp;
+            s[j] = amx*amy;
+            s[j+NPBLK] = dxp*amy;
+            s[j+2*NPBLK] = amx*dyp;
+            s[j+3*NPBLK] = dxp*dyp;
+        }
+/* deposit charge within tile to local accumulator */
+         for (j = 0; j < NPBLK; j++) {
+            nn = n[j];
+            mm = nn + lxv - 2;
+            for (i = 0; i < LVECT; i++) {
+               if (i > 1)
+                  nn = mm;
+               sq[i+nn] += s[j+NPBLK*i];
+            }
+         }
+      }
+      nps = NPBLK*ipp;
+/* loop over remaining particles */
+      for (j = nps; j < npp; j++) {
+/* find interpolation weights */
+         x = ppart[j+npoff];
+         y = ppart[j+nppmx+npoff];
+         nn = x;
+         mm = y;
+         dxp = qm*(x - (float) nn);
+         dyp = y - (float) mm;
+         nn = nn - noff + lxv*(mm - moff);
+         amx = qm - dxp;
+         amy = 1.0f - dyp;
+/* deposit charge within tile to local accumulator */
+         x = sq[nn] + amx*amy;
+         y = sq[nn+1] + dxp*amy;
+         sq[nn] = x;
+         sq[nn+1] = y;
+         nn += lxv;
+         x = sq[nn] + amx*dyp;
+         y = sq[nn+1] + dxp*dyp;
+         sq[nn] = x;
+         sq[nn+1] = y;
+      }
+/* deposit charge to interior points in global array */
+      nn = nxv - noff;
+      mm = nyv - moff;
+      nn = mx < nn ? mx : nn;
+      mm = my < mm ? my : mm;
+      for (j = 1; j < mm; j++) {
+         for (i = 1; i < nn; i++) {
+            q[i+noff+nxv*(j+moff)] += sq[i+lxv*j];
+         }
+      }
+/* deposit charge to edge points in global array */
+      mm = nyv - moff;
+      mm = my+1 < mm ? my+1 : mm;
+      for (i = 1; i < nn; i++) {
+#pragma omp atomic
+         q[i+noff+nxv*moff] += sq[i];
+         if (mm > my) {
+#pragma omp atomic
+            q[i+noff+nxv*(mm+moff-1)] += sq[i+lxv*(mm-1)];
+         }
+      }
+      nn = nxv - noff;
+      nn = mx+1 < nn ? mx+1 : nn;
+      for (j = 0; j < mm; j++) {
+#pragma omp atomic
+         q[noff+nxv*(j+moff)] += sq[lxv*j];
+         if (nn > mx) {
+#pragma omp atomic
+            q[nn+noff-1+nxv*(j+moff)] += sq[nn-1+lxv*j];
+         }
+      }
+   }
+   return;
+#undef LVECT
+#undef NPBLK
+}
+
+/*--------------------------------------------------------------------*/
+void cviscan2(int *isdata, int *mb, int nths) {
+/* performs vectorizable prefix reduction of integer data */
+/* using binary tree method. */
+/* local data */
+   int j, kxs, lb, ns;
+   ns = nths/2;
+   for (j = 0; j < ns; j++) {
+      mb[j] = j;
+   }
+   kxs = 1;
+   while (kxs < nths) {
+      for (j = 0; j < ns; j++) {
+         lb = kxs*mb[j];
+         if ((j+lb+kxs) < nths) {
+            isdata[j+lb+kxs] += isdata[2*lb+kxs-1];
+         }
+         mb[j] >>= 1;
+      }
+      kxs <<= 1;
+   }
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cpporder2lt(float ppart[], float ppbuff[], int kpic[], int ncl[],
+                 int ihole[], int idimp, int nppmx, int nx, int ny,
+                 int mx, int my, int mx1, int my1, int npbmx, int ntmax,
+                 int *irc) {
+/* this subroutine sorts particles by x,y grid in tiles of mx, my
+   linear interpolation, with periodic boundary conditions
+   tiles are assumed to be arranged in 2D linear memory
+   algorithm has 3 steps.  first, one finds particles leaving tile and
+   stores their number in each directon, location, and destination in ncl
+   and ihole.  second, a prefix scan of ncl is performed and departing
+   particles are buffered in ppbuff in direction order.  finally, we copy
+   the incoming particles from other tiles into ppart.
+   input: all except ppbuff, ncl, ihole, irc
+   output: ppart, ppbuff, kpic, ncl, ihole, irc
+   ppart[k][0][n] = position x of particle n in tile k
+   ppart[k][1][n] = position y of particle n in tile k 
+   ppbuff[k][i][n] = i co-ordinate of particle n in tile k
+   kpic[k] = number of particles in tile k
+   ncl[k][i] = number of particles going to destination i, tile k
+   ihole[k][:][0] = location of hole in array left by departing particle
+   ihole[k][:][1] = direction destination of particle leaving hole
+   all for tile k
+   ihole[k][0][0] = ih, number of holes left (error, if negative)
+   idimp = size of phase space = 4
+   nppmx = maximum number of particles in tile
+   nx/ny = system length in x/y direction
+   mx/my = number of grids in sorting cell in x/y
+   mx1 = (system length in x direction - 1)/mx + 1
+   my1 = (system length in y direction - 1)/my + 1
+   npbmx = size of buffer array ppbuff
+   ntmax = size of hole array for particles leaving tiles
+   irc = maximum overflow, returned only if error occurs, when irc > 0
+local data                                                            */
+   int mxy1, noff, moff, npoff, npp, nboff, ncoff;
+   int i, j, k, ii, kx, ky, ih, nh, ist, nn, mm, isum;
+   int ip, j1, j2, kxl, kxr, kk, kl, kr;
+   float anx, any, edgelx, edgely, edgerx, edgery, dx, dy;
+   int ks[8];
+   mxy1 = mx1*my1;
+   anx = (float) nx;
+   any = (float) ny;
+/* find and count particles leaving tiles and determine destination */
+/* update ppart, ihole, ncl */
+/* loop over tiles */
+#pragma omp parallel for \
+private(j,k,noff,moff,npp,npoff,nn,mm,ih,nh,ist,dx,dy,edgelx,edgely, \
+edgerx,edgery)
+   for (k = 0; k < mxy1; k++) {
+      noff = k/mx1;
+      moff = my*noff;
+      noff = mx*(k - mx1*noff);
+      npp = kpic[k];
+      npoff = idimp*nppmx*k;
+      nn = nx - noff;
+      nn = mx < nn ? mx : nn;
+      mm = ny - moff;
+      mm = my < mm ? my : mm;
+      ih = 0;
+      nh = 0;
+      edgelx = noff;
+      edgerx = noff + nn;
+      edgely = moff;
+      edgery = moff + mm;
+/* clear counters */
+      for (j = 0; j < 8; j++) {
+         ncl[j+8*k] = 0;
+      }
+/* loop over particles in tile */
+      for (j = 0; j < npp; j++) {
+         dx = ppart[j+npoff];
+         dy = ppart[j+nppmx+npoff];
+/* find particles going out of bounds */
+         ist = 0;
+/* count how many particles are going in each direction in ncl   */
+/* save their address and destination in ihole                   */
+/* use periodic boundary conditions and check for roundoff error */
+/* ist = direction particle is going                             */
+         if (dx >= edgerx) {
+            if (dx >= anx)
+               ppart[j+npoff] = dx - anx;
+            ist = 2;
+         }
+         else if (dx < edgelx) {
+            if (dx < 0.0) {
+               dx += anx;
+               if (dx < anx)
+                  ist = 1;
+               else
+                  dx = 0.0;
+               ppart[j+npoff] = dx;
+            }
+            else {
+               ist = 1;
+            }
+         }
+         if (dy >= edgery) {
+            if (dy >= any)
+               ppart[j+nppmx+npoff] = dy - any;
+            ist += 6;
+         }
+         else if (dy < edgely) {
+            if (dy < 0.0) {
+               dy += any;
+               if (dy < any)
+                  ist += 3;
+               else
+                  dy = 0.0;
+               ppart[j+nppmx+npoff] = dy;
+            }
+            else {
+               ist += 3;
+            }
+         }
+         if (ist > 0) {
+            ncl[ist+8*k-1] += 1;
+            ih += 1;
+            if (ih <= ntmax) {
+               ihole[2*(ih+(ntmax+1)*k)] = j + 1;
+               ihole[1+2*(ih+(ntmax+1)*k)] = ist;
+            }
+            else {
+               nh = 1;
+            }
+         }
+      }
+/* set error and end of file flag */
+      if (nh > 0) {
+         *irc = ih;
+         ih = -ih;
+      }
+      ihole[2*(ntmax+1)*k] = ih;
+   }
+/* ihole overflow */
+   if (*irc > 0)
+      return;
+
+/* buffer particles that are leaving tile: update ppbuff, ncl */
+/* loop over tiles */
+#pragma omp parallel for \
+private(i,j,k,npoff,nboff,isum,ist,nh,ip,j1,ii)
+   for (k = 0; k < mxy1; k++) {
+      npoff = idimp*nppmx*k;
+      nboff = idimp*npbmx*k;
+/* find address offset for ordered ppbuff array */
+      isum = 0;
+      for (j = 0; j < 8; j++) {
+         ist = ncl[j+8*k];
+         ncl[j+8*k] = isum;
+         isum += ist;
+      }
+      nh = ihole[2*(ntmax+1)*k];
+      ip = 0;
+/* loop over particles leaving tile */
+      for (j = 0; j < nh; j++) {
+/* buffer particles that are leaving tile, in direction order */
+         j1 = ihole[2*(j+1+(ntmax+1)*k)] - 1;
+         ist = ihole[1+2*(j+1+(ntmax+1)*k)];
+         ii = ncl[ist+8*k-1];
+         if (ii < npbmx) {
+            for (i = 0; i < idimp; i++) {
+               ppbuff[ii+npbmx*i+nboff]
+               = ppart[j1+nppmx*i+npoff];
+            }
+         }
+         else {
+            ip = 1;
+         }
+         ncl[ist+8*k-1] = ii + 1;
+      }
+/* set error */
+      if (ip > 0)
+         *irc = ncl[7+8*k];
+   }
+/* ppbuff overflow */
+   if (*irc > 0)
+      return;
+
+/* copy incoming particles from buffer into ppart: update ppart, kpic */
+/* loop over tiles */
+#pragma omp parallel for \
+private(i,j,k,ii,kk,npp,npoff,nboff,kx,ky,kl,kr,kxl,kxr,ih,nh,nn, \
+ncoff,ist,j1,j2,ip,ks)
+   for (k = 0; k < mxy1; k++) {
+      npp = kpic[k];
+      npoff = idimp*nppmx*k;
+      ky = k/mx1;
+/* loop over tiles in y, assume periodic boundary conditions */
+      kk = ky*mx1;
+/* find tile above */
+      kl = ky - 1;
+      if (kl < 0)
+         kl += my1;
+      kl = kl*mx1;
+/* find tile below */
+      kr = ky + 1;
+      if (kr >= my1)
+          kr -= my1;
+      kr = kr*mx1;
+/* loop over tiles in x, assume periodic boundary conditions */
+      kx = k - ky*mx1;
+      kxl = kx - 1;
+      if (kxl < 0)
+         kxl += mx1;
+      kxr = kx + 1;
+      if (kxr >= mx1)
+         kxr -= mx1;
+/* find tile number for different directions */
+      ks[0] = kxr + kk;
+      ks[1] = kxl + kk;
+      ks[2] = kx + kr;
+      ks[3] = kxr + kr;
+      ks[4] = kxl + kr;
+      ks[5] = kx + kl;
+      ks[6] = kxr + kl;
+      ks[7] = kxl + kl;
+/* loop over directions */
+      nh = ihole[2*(ntmax+1)*k];
+      ncoff = 0;
+      ih = 0;
+      ist = 0;
+      j1 = 0;
+      for (ii = 0; ii < 8; ii++) {
+         nboff = idimp*npbmx*ks[ii];
+         if (ii > 0)
+            ncoff = ncl[ii-1+8*ks[ii]];
+/* ip = number of particles coming from direction ii */
+         ip = ncl[ii+8*ks[ii]] - ncoff;
+         for (j = 0; j < ip; j++) {
+            ih += 1;
+/* insert incoming particles into holes */
+            if (ih <= nh) {
+               j1 = ihole[2*(ih+(ntmax+1)*k)] - 1;
+            }
+/* place overflow at end of array */
+            else {
+               j1 = npp;
+               npp += 1;
+            }
+            if (j1 < nppmx) {
+               for (i = 0; i < idimp; i++) {
+                  ppart[j1+nppmx*i+npoff]
+                  = ppbuff[j+ncoff+npbmx*i+nboff];
+                }
+            }
+            else {
+               ist = 1;
+            }
+         }
+      }
+/* set error */
+      if (ist > 0)
+         *irc = j1+1;
+/* fill up remaining holes in particle array with particles from bottom */
+/* holes with locations great than npp-ip do not need to be filled      */
+      if (ih < nh) {
+         ip = nh - ih;
+         ii = nh;
+         nn = ihole[2*(ii+(ntmax+1)*k)] - 1;
+         ih += 1;
+         j2 = ihole[2*(ih+(ntmax+1)*k)] - 1;
+/* move particles from end into remaining holes */
+/* holes are processed in increasing order      */
+         for (j = 0; j < ip; j++) {
+            j1 = npp - j - 1;
+            if (j1==nn) {
+               ii -= 1;
+               nn = ihole[2*(ii+(ntmax+1)*k)] - 1;
+            }
+            else {
+               for (i = 0; i < idimp; i++) {
+                  ppart[j2+nppmx*i+npoff]
+                  = ppart[j1+nppmx*i+npoff];
+               }
+               ih += 1;
+               j2 = ihole[2*(ih+(ntmax+1)*k)] - 1;
+            }
+         }
+         npp -= ip;
+      }
+      kpic[k] = npp;
+   }
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cpporderf2lt(float ppart[], float ppbuff[], int kpic[], int ncl[],
+                  int ihole[], int idimp, int nppmx, int mx1, int my1,
+                  int npbmx, int ntmax, int *irc) {
+/* this subroutine sorts particles by x,y grid in tiles of mx, my
+   linear interpolation, with periodic boundary conditions
+   tiles are assumed to be arranged in 2D linear memory
+   the algorithm has 2 steps.  first, a prefix scan of ncl is performed
+   and departing particles are buffered in ppbuff in direction order.
+   then we copy the incoming particles from other tiles into ppart.
+   it assumes that the number, location, and destination of particles 
+   leaving a tile have been previously stored in ncl and ihole by the
+   cgppushf2lt procedure.
+   input: all except ppbuff, irc
+   output: ppart, ppbuff, kpic, ncl, irc
+   ppart[k][0][n] = position x of particle n in tile k
+   ppart[k][1][n] = position y of particle n in tile k 
+   ppbuff[k][i][n] = i co-ordinate of particle n in tile k
+   kpic[k] = number of particles in tile k
+   ncl[k][i] = number of particles going to destination i, tile k
+   ihole[k][:][0] = location of hole in array left by departing particle
+   ihole[k][:][1] = direction destination of particle leaving hole
+   all for tile k
+   ihole[k][0][0] = ih, number of holes left (error, if negative)
+   idimp = size of phase space = 4
+   nppmx = maximum number of particles in tile
+   mx1 = (system length in x direction - 1)/mx + 1
+   my1 = (system length in y direction - 1)/my + 1
+   npbmx = size of buffer array ppbuff
+   ntmax = size of hole array for particles leaving tiles
+   irc = maximum overflow, returned only if error occurs, when irc > 0
+local data                                                            */
+   int mxy1, npoff, npp, nboff, ncoff;
+   int i, j, k, ii, kx, ky, ih, nh, ist, nn, isum;
+   int ip, j1, j2, kxl, kxr, kk, kl, kr;
+   int ks[8];
+   mxy1 = mx1*my1;
+/* buffer particles that are leaving tile: update ppbuff, ncl */
+/* loop over tiles */
+#pragma omp parallel for \
+private(i,j,k,npoff,nboff,isum,ist,nh,ip,j1,ii)
+   for (k = 0; k < mxy1; k++) {
+      npoff = idimp*nppmx*k;
+      nboff = idimp*npbmx*k;
+/* find address offset for ordered ppbuff array */
+      isum = 0;
+      for (j = 0; j < 8; j++) {
+         ist = ncl[j+8*k];
+         ncl[j+8*k] = isum;
+         isum += ist;
+      }
+      nh = ihole[2*(ntmax+1)*k];
+      ip = 0;
+/* loop over particles leaving tile */
+      for (j = 0; j < nh; j++) {
+/* buffer particles that are leaving tile, in direction order */
+         j1 = ihole[2*(j+1+(ntmax+1)*k)] - 1;
+         ist = ihole[1+2*(j+1+(ntmax+1)*k)];
+         ii = ncl[ist+8*k-1];
+         if (ii < npbmx) {
+            for (i = 0; i < idimp; i++) {
+               ppbuff[ii+npbmx*i+nboff]
+               = ppart[j1+nppmx*i+npoff];
+            }
+         }
+         else {
+            ip = 1;
+         }
+         ncl[ist+8*k-1] = ii + 1;
+      }
+/* set error */
+      if (ip > 0)
+         *irc = ncl[7+8*k];
+   }
+/* ppbuff overflow */
+   if (*irc > 0)
+      return;
+
+/* copy incoming particles from buffer into ppart: update ppart, kpic */
+/* loop over tiles */
+#pragma omp parallel for \
+private(i,j,k,ii,kk,npp,npoff,nboff,kx,ky,kl,kr,kxl,kxr,ih,nh,nn, \
+ncoff,ist,j1,j2,ip,ks)
+   for (k = 0; k < mxy1; k++) {
+      npp = kpic[k];
+      npoff = idimp*nppmx*k;
+      ky = k/mx1;
+/* loop over tiles in y, assume periodic boundary conditions */
+      kk = ky*mx1;
+/* find tile above */
+      kl = ky - 1;
+      if (kl < 0)
+         kl += my1;
+      kl = kl*mx1;
+/* find tile below */
+      kr = ky + 1;
+      if (kr >= my1)
+          kr -= my1;
+      kr = kr*mx1;
+/* loop over tiles in x, assume periodic boundary conditions */
+      kx = k - ky*mx1;
+      kxl = kx - 1;
+      if (kxl < 0)
+         kxl += mx1;
+      kxr = kx + 1;
+      if (kxr >= mx1)
+         kxr -= mx1;
+/* find tile number for different directions */
+      ks[0] = kxr + kk;
+      ks[1] = kxl + kk;
+      ks[2] = kx + kr;
+      ks[3] = kxr + kr;
+      ks[4] = kxl + kr;
+      ks[5] = kx + kl;
+      ks[6] = kxr + kl;
+      ks[7] = kxl + kl;
+/* loop over directions */
+      nh = ihole[2*(ntmax+1)*k];
+      ncoff = 0;
+      ih = 0;
+      ist = 0;
+      j1 = 0;
+      for (ii = 0; ii < 8; ii++) {
+         nboff = idimp*npbmx*ks[ii];
+         if (ii > 0)
+            ncoff = ncl[ii-1+8*ks[ii]];
+/* ip = number of particles coming from direction ii */
+         ip = ncl[ii+8*ks[ii]] - ncoff;
+         for (j = 0; j < ip; j++) {
+            ih += 1;
+/* insert incoming particles into holes */
+            if (ih <= nh) {
+               j1 = ihole[2*(ih+(ntmax+1)*k)] - 1;
+            }
+/* place overflow at end of array */
+            else {
+               j1 = npp;
+               npp += 1;
+            }
+            if (j1 < nppmx) {
+               for (i = 0; i < idimp; i++) {
+                  ppart[j1+nppmx*i+npoff]
+                  = ppbuff[j+ncoff+npbmx*i+nboff];
+                }
+            }
+            else {
+               ist = 1;
+            }
+         }
+      }
+/* set error */
+      if (ist > 0)
+         *irc = j1+1;
+/* fill up remaining holes in particle array with particles from bottom */
+/* holes with locations great than npp-ip do not need to be filled      */
+      if (ih < nh) {
+         ip = nh - ih;
+         ii = nh;
+         nn = ihole[2*(ii+(ntmax+1)*k)] - 1;
+         ih += 1;
+         j2 = ihole[2*(ih+(ntmax+1)*k)] - 1;
+/* move particles from end into remaining holes */
+/* holes are processed in increasing order      */
+         for (j = 0; j < ip; j++) {
+            j1 = npp - j - 1;
+            if (j1==nn) {
+               ii -= 1;
+               nn = ihole[2*(ii+(ntmax+1)*k)] - 1;
+            }
+            else {
+               for (i = 0; i < idimp; i++) {
+                  ppart[j2+nppmx*i+npoff]
+                  = ppart[j1+nppmx*i+npoff];
+               }
+               ih += 1;
+               j2 = ihole[2*(ih+(ntmax+1)*k)] - 1;
+            }
+         }
+         npp -= ip;
+      }
+      kpic[k] = npp;
+   }
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cvpporder2lt(float ppart[], float ppbuff[], int kpic[], int ncl[],
+                  int ihole[], int idimp, int nppmx, int nx, int ny,
+                  int mx, int my, int mx1, int my1, int npbmx,
+                  int ntmax, int *irc) {
+/* this subroutine sorts particles by x,y grid in tiles of mx, my
+   linear interpolation, with periodic boundary conditions
+   tiles are assumed to be arranged in 2D linear memory
+   algorithm has 3 steps.  first, one finds particles leaving tile and
+   stores their number in each directon, location, and destination in ncl
+   and ihole.  second, a prefix scan of ncl is performed and departing
+   particles are buffered in ppbuff in direction order.  finally, we copy
+   the incoming particles from other tiles into ppart.
+   input: all except ppbuff, ncl, ihole, irc
+   output: ppart, ppbuff, kpic, ncl, ihole, irc
+   ppart[k][0][n] = position x of particle n in tile k
+   ppart[k][1][n] = position y of particle n in tile k 
+   ppbuff[k][i][n] = i co-ordinate of particle n in tile k
+   kpic[k] = number of particles in tile k
+   ncl[k][i] = number of particles going to destination i, tile k
+   ihole[k][:][0] = location of hole in array left by departing particle
+   ihole[k][:][1] = direction destination of particle leaving hole
+   all for tile k
+   ihole[k][0][0] = ih, number of holes left (error, if negative)
+   idimp = size of phase space = 4
+   nppmx = maximum number of particles in tile
+   nx/ny = system length in x/y direction
+   mx/my = number of grids in sorting cell in x/y
+   mx1 = (system length in x direction - 1)/mx + 1
+   my1 = (system length in y direction - 1)/my + 1
+   npbmx = size of buffer array ppbuff
+   ntmax = size of hole array for particles leaving tiles
+   irc = maximum overflow, returned only if error occurs, when irc > 0
+local data                                                            */
+#define NPBLK             16
+   int mxy1, noff, moff, npoff, npp, ipp, joff, nps, nboff, ncoff;
+   int i, j, k, m, ii, kx, ky, ih, nh, ist, nn, mm, in;
+   int ip, j1, j2, kxl, kxr, kk, kl, kr, lb, kxs;
+   float anx, any, edgelx, edgely, edgerx, edgery, dx, dy;
+   int sncl[8], ks[8];
+/* scratch arrays */
+   int n[NPBLK*3];
+   mxy1 = mx1*my1;
+   anx = (float) nx;
+   any = (float) ny;
+/* find and count particles leaving tiles and determine destination */
+/* update ppart, ihole, ncl */
+/* loop over tiles */
+#pragma omp parallel for \
+private(j,k,noff,moff,npp,npoff,nn,mm,ih,nh,ist,dx,dy,edgelx,edgely, \
+edgerx,edgery)
+   for (k = 0; k < mxy1; k++) {
+      noff = k/mx1;
+      moff = my*noff;
+      noff = mx*(k - mx1*noff);
+      npp = kpic[k];
+      npoff = idimp*nppmx*k;
+      nn = nx - noff;
+      nn = mx < nn ? mx : nn;
+      mm = ny - moff;
+      mm = my < mm ? my : mm;
+      ih = 0;
+      nh = 0;
+      edgelx = noff;
+      edgerx = noff + nn;
+      edgely = moff;
+      edgery = moff + mm;
+/* clear counters */
+      for (j = 0; j < 8; j++) {
+         ncl[j+8*k] = 0;
+      }
+/* loop over particles in tile */
+      for (j = 0; j < npp; j++) {
+         dx = ppart[j+npoff];
+         dy = ppart[j+nppmx+npoff];
+/* find particles going out of bounds */
+         ist = 0;
+/* count how many particles are going in each direction in ncl   */
+/* save their address and destination in ihole                   */
+/* use periodic boundary conditions and check for roundoff error */
+/* ist = direction particle is going                             */
+         if (dx >= edgerx) {
+            if (dx >= anx)
+               ppart[j+npoff] = dx - anx;
+            ist = 2;
+         }
+         else if (dx < edgelx) {
+            if (dx < 0.0) {
+               dx += anx;
+               if (dx < anx)
+                  ist = 1;
+               else
+                  dx = 0.0;
+               ppart[j+npoff] = dx;
+            }
+            else {
+               ist = 1;
+            }
+         }
+         if (dy >= edgery) {
+            if (dy >= any)
+               ppart[j+nppmx+npoff] = dy - any;
+            ist += 6;
+         }
+         else if (dy < edgely) {
+            if (dy < 0.0) {
+               dy += any;
+               if (dy < any)
+                  ist += 3;
+               else
+                  dy = 0.0;
+               ppart[j+nppmx+npoff] = dy;
+            }
+            else {
+               ist += 3;
+            }
+         }
+         if (ist > 0) {
+            ncl[ist+8*k-1] += 1;
+            ih += 1;
+            if (ih <= ntmax) {
+               ihole[2*(ih+(ntmax+1)*k)] = j + 1;
+               ihole[1+2*(ih+(ntmax+1)*k)] = ist;
+            }
+            else {
+               nh = 1;
+            }
+         }
+      }
+/* set error and end of file flag */
+      if (nh > 0) {
+         *irc = ih;
+         ih = -ih;
+      }
+      ihole[2*(ntmax+1)*k] = ih;
+   }
+/* ihole overflow */
+   if (*irc > 0)
+      return;
+
+/* buffer particles that are leaving tile: update ppbuff, ncl */
+/* loop over tiles */
+#pragma omp parallel for \
+private(i,j,k,m,kxs,lb,npoff,nboff,ist,nh,ip,ipp,nps,joff,j1,ii,sncl, \
+ks,n)
+   for (k = 0; k < mxy1; k++) {
+      npoff = idimp*nppmx*k;
+      nboff = idimp*npbmx*k;
+/* find address offset for ordered ppbuff array */
+      for (j = 0; j < 8; j++) {
+         sncl[j] = ncl[j+8*k];
+         ks[j] = j;
+      }
+      kxs = 1;
+      while (kxs < 8) {
+         for (j = 0; j < 4; j++) {
+            lb = kxs*ks[j];
+            sncl[j+lb+kxs] += sncl[2*lb+kxs-1];
+            ks[j] >>= 1;
+         }     
+         kxs <<= 1;
+      }
+      for (j = 0; j < 8; j++) {
+         sncl[j] -= ncl[j+8*k];
+      }
+      nh = ihole[2*(ntmax+1)*k];
+      ip = 0;
+/* buffer particles that are leaving tile, in direction order */
+/* loop over particles leaving tile */
+      ipp = nh/NPBLK;
+/* outer loop over number of full blocks */
+      for (m = 0; m < ipp; m++) {
+         joff = NPBLK*m + 1;
+/* inner loop over particles in block */
+         for (j = 0; j < NPBLK; j++) {
+            n[j] = ihole[2*(j+joff+(ntmax+1)*k)] - 1;
+            n[j+NPBLK] = ihole[1+2*(j+joff+(ntmax+1)*k)];
+         }
+/* calculate offsets */
+         for (j = 0; j < NPBLK; j++) {
+            ist = n[j+NPBLK];
+            ii = sncl[ist-1];
+            n[j+NPBLK] = ii;
+            sncl[ist-1] = ii + 1;
+         }
+/* buffer particles that are leaving tile, in direction order */
+         for (i = 0; i < idimp; i++) {
+            for (j = 0; j < NPBLK; j++) {
+               j1 = n[j];
+               ii = n[j+NPBLK];
+               if (ii < npbmx) {
+                 ppbuff[ii+npbmx*i+nboff]
+                  = ppart[j1+nppmx*i+npoff];
+               }
+               else {
+                  ip = 1;
+               }
+            }
+         }
+      }
+      nps = NPBLK*ipp;
+/* loop over remaining particles */
+      for (j = nps; j < nh; j++) {
+/* buffer particles that are leaving tile, in direction order */
+         j1 = ihole[2*(j+1+(ntmax+1)*k)] - 1;
+         ist = ihole[1+2*(j+1+(ntmax+1)*k)];
+         ii = sncl[ist-1];
+         if (ii < npbmx) {
+            for (i = 0; i < idimp; i++) {
+               ppbuff[ii+npbmx*i+nboff]
+               = ppart[j1+nppmx*i+npoff];
+            }
+         }
+         else {
+            ip = 1;
+         }
+         sncl[ist-1] = ii + 1;
+      }
+      for (j = 0; j < 8; j++) {
+         ncl[j+8*k] = sncl[j];
+      }
+/* set error */
+      if (ip > 0)
+         *irc = ncl[7+8*k];
+   }
+/* ppbuff overflow */
+   if (*irc > 0)
+      return;
+
+/* copy incoming particles from buffer into ppart: update ppart, kpic */
+/* loop over tiles */
+#pragma omp parallel for \
+private(i,j,k,m,ii,kk,in,npp,npoff,nboff,ipp,joff,nps,kx,ky,kl,kr,kxl, \
+kxr,ih,nh,nn,mm,ncoff,ist,j1,j2,ip,ks,n)
+   for (k = 0; k < mxy1; k++) {
+      npp = kpic[k];
+      npoff = idimp*nppmx*k;
+      ky = k/mx1;
+/* loop over tiles in y, assume periodic boundary conditions */
+      kk = ky*mx1;
+/* find tile above */
+      kl = ky - 1;
+      if (kl < 0)
+         kl += my1;
+      kl = kl*mx1;
+/* find tile below */
+      kr = ky + 1;
+      if (kr >= my1)
+          kr -= my1;
+      kr = kr*mx1;
+/* loop over tiles in x, assume periodic boundary conditions */
+      kx = k - ky*mx1;
+      kxl = kx - 1;
+      if (kxl < 0)
+         kxl += mx1;
+      kxr = kx + 1;
+      if (kxr >= mx1)
+         kxr -= mx1;
+/* find tile number for different directions */
+      ks[0] = kxr + kk;
+      ks[1] = kxl + kk;
+      ks[2] = kx + kr;
+      ks[3] = kxr + kr;
+      ks[4] = kxl + kr;
+      ks[5] = kx + kl;
+      ks[6] = kxr + kl;
+      ks[7] = kxl + kl;
+/* loop over directions */
+      nh = ihole[2*(ntmax+1)*k];
+      ncoff = 0;
+      ih = 0;
+      ist = 0;
+      j1 = 0;
+      for (ii = 0; ii < 8; ii++) {
+         nboff = idimp*npbmx*ks[ii];
+         if (ii > 0)
+            ncoff = ncl[ii-1+8*ks[ii]];
+/* ip = number of particles coming from direction ii */
+         ip = ncl[ii+8*ks[ii]] - ncoff;
+/* loop over particles coming from direction ii */
+         ipp = ip/NPBLK;
+/* outer loop over number of full blocks */
+         for (m = 0; m < ipp; m++) {
+            joff = NPBLK*m;
+/* inner loop over particles in block */
+            for (j = 0; j < NPBLK; j++) {
+/* insert incoming particles into holes */
+               if ((j+ih) < nh) {
+                  j1 = ihole[2*(j+ih+1+(ntmax+1)*k)] - 1;
+               }
+/* place overflow at end of array */
+               else {
+                  j1 = npp + j + ih - nh;
+               }
+               n[j] = j1;
+            }
+            for (i = 0; i < idimp; i++) {
+               for (j = 0; j < NPBLK; j++) {
+                  j1 = n[j];
+                  if (j1 < nppmx) {
+                     ppart[j1+nppmx*i+npoff]
+                     = ppbuff[j+joff+ncoff+npbmx*i+nboff];
+                  }
+                  else {
+                    ist = 1;
+                  }
+               }
+            }
+            ih += NPBLK;
+         }
+         nps = NPBLK*ipp;
+/* loop over remaining particles */
+         for (j = nps; j < ip; j++) {
+            ih += 1;
+/* insert incoming particles into holes */
+            if (ih <= nh) {
+               j1 = ihole[2*(ih+(ntmax+1)*k)] - 1;
+            }
+/* place overflow at end of array */
+            else {
+               j1 = npp + ih - nh - 1;
+            }
+            if (j1 < nppmx) {
+               for (i = 0; i < idimp; i++) {
+                  ppart[j1+nppmx*i+npoff]
+                  = ppbuff[j+ncoff+npbmx*i+nboff];
+                }
+            }
+            else {
+               ist = 1;
+            }
+         }
+      }
+      if (ih > nh)
+         npp = npp + ih - nh;
+/* set error */
+      if (ist > 0)
+         *irc = j1+1;
+/* fill up remaining holes in particle array with particles from bottom */
+/* holes with locations great than npp-ip do not need to be filled      */
+      if (ih < nh) {
+         ip = nh - ih;
+/* move particles from end into remaining holes */
+/* holes are processed in increasing order      */
+         ii = nh;
+         ipp = ip/NPBLK;
+/* outer loop over number of full blocks */
+         for (m = 0; m < ipp; m++) {
+            joff = NPBLK*m;
+/* inner loop over particles in block */
+            for (j = 0; j < NPBLK; j++) {
+               n[j+NPBLK] = ihole[2*(ih+j+1+(ntmax+1)*k)] - 1;
+               n[j+2*NPBLK] = ihole[2*(ii-j+(ntmax+1)*k)] - 1;
+            }
+            in = 0;
+            mm = 0;
+            nn = n[in+2*NPBLK];
+            for (j = 0; j < NPBLK; j++) {
+               j1 = npp - j - joff - 1;
+               n[j] = n[mm+NPBLK];
+               if (j1==nn) {
+                  in += 1;
+                  nn = n[in+2*NPBLK];
+                  n[j] = -1;
+               }
+               else {
+                  mm += 1;
+               }
+            }
+            for (i = 0; i < idimp; i++) {
+               for (j = 0; j < NPBLK; j++) {
+                  j1 = npp - j - joff - 1;
+                  j2 = n[j];
+                  if (j2 >= 0) {
+                     ppart[j2+nppmx*i+npoff]
+                     = ppart[j1+nppmx*i+npoff];
+                  }
+               }
+            }
+            ii -= in;
+            ih += mm;
+         }
+         nps = NPBLK*ipp;
+         nn = ihole[2*(ii+(ntmax+1)*k)] - 1;
+         ih += 1;
+         j2 = ihole[2*(ih+(ntmax+1)*k)] - 1;
+/* loop over remaining particles */
+         for (j = nps; j < ip; j++) {
+            j1 = npp - j - 1;
+            if (j1==nn) {
+               ii -= 1;
+               nn = ihole[2*(ii+(ntmax+1)*k)] - 1;
+            }
+            else {
+               for (i = 0; i < idimp; i++) {
+                  ppart[j2+nppmx*i+npoff]
+                  = ppart[j1+nppmx*i+npoff];
+               }
+               ih += 1;
+               j2 = ihole[2*(ih+(ntmax+1)*k)] - 1;
+            }
+         }
+         npp -= ip;
+      }
+      kpic[k] = npp;
+   }
+   return;
+#undef NPBLK
+}
+
+/*--------------------------------------------------------------------*/
+void cvpporderf2lt(float ppart[], float ppbuff[], int kpic[], int ncl[],
+                   int ihole[], int idimp, int nppmx, int mx1, int my1,
+                   int npbmx, int ntmax, int *irc) {
+/* this subroutine sorts particles by x,y grid in tiles of mx, my
+   linear interpolation, with periodic boundary conditions
+   tiles are assumed to be arranged in 2D linear memory
+   the algorithm has 2 steps.  first, a prefix scan of ncl is performed
+   and departing particles are buffered in ppbuff in direction order.
+   then we copy the incoming particles from other tiles into ppart.
+   it assumes that the number, location, and destination of particles 
+   leaving a tile have been previously stored in ncl and ihole by the
+   cgppushf2lt procedure.
+   input: all except ppbuff, irc
+   output: ppart, ppbuff, kpic, ncl, irc
+   ppart[k][0][n] = position x of particle n in tile k
+   ppart[k][1][n] = position y of particle n in tile k 
+   ppbuff[k][i][n] = i co-ordinate of particle n in tile k
+   kpic[k] = number of particles in tile k
+   ncl[k][i] = number of particles going to destination i, tile k
+   ihole[k][:][0] = location of hole in array left by departing particle
+   ihole[k][:][1] = direction destination of particle leaving hole
+   all for tile k
+   ihole[k][0][0] = ih, number of holes left (error, if negative)
+   idimp = size of phase space = 4
+   nppmx = maximum number of particles in tile
+   mx1 = (system length in x direction - 1)/mx + 1
+   my1 = (system length in y direction - 1)/my + 1
+   npbmx = size of buffer array ppbuff
+   ntmax = size of hole array for particles leaving tiles
+   irc = maximum overflow, returned only if error occurs, when irc > 0
+local data                                                            */
+#define NPBLK             16
+   int mxy1, npoff, npp, nboff, ncoff;
+   int i, j, k, ii, kx, ky, ih, nh, ist, nn, mm, in;
+   int ip, j1, j2, kxl, kxr, kk, kl, kr;
+   int lb, kxs, m, ipp, nps, joff;
+   int sncl[8], ks[8];
+/* scratch arrays */
+   int n[NPBLK*3];
+   mxy1 = mx1*my1;
+/* buffer particles that are leaving tile: update ppbuff, ncl */
+/* loop over tiles */
+#pragma omp parallel for \
+private(i,j,k,m,kxs,lb,npoff,nboff,ist,nh,ip,ipp,nps,joff,j1,ii,sncl, \
+ks,n)
+   for (k = 0; k < mxy1; k++) {
+      npoff = idimp*nppmx*k;
+      nboff = idimp*npbmx*k;
+/* find address offset for ordered ppbuff array */
+      for (j = 0; j < 8; j++) {
+         sncl[j] = ncl[j+8*k];
+         ks[j] = j;
+      }
+      kxs = 1;
+      while (kxs < 8) {
+         for (j = 0; j < 4; j++) {
+            lb = kxs*ks[j];
+            sncl[j+lb+kxs] += sncl[2*lb+kxs-1];
+            ks[j] >>= 1;
+         }     
+         kxs <<= 1;
+      }
+      for (j = 0; j < 8; j++) {
+         sncl[j] -= ncl[j+8*k];
+      }
+      nh = ihole[2*(ntmax+1)*k];
+      ip = 0;
+/* buffer particles that are leaving tile, in direction order */
+/* loop over particles leaving tile */
+      ipp = nh/NPBLK;
+/* outer loop over number of full blocks */
+      for (m = 0; m < ipp; m++) {
+         joff = NPBLK*m + 1;
+/* inner loop over particles in block */
+         for (j = 0; j < NPBLK; j++) {
+            n[j] = ihole[2*(j+joff+(ntmax+1)*k)] - 1;
+            n[j+NPBLK] = ihole[1+2*(j+joff+(ntmax+1)*k)];
+         }
+/* calculate offsets */
+         for (j = 0; j < NPBLK; j++) {
+            ist = n[j+NPBLK];
+            ii = sncl[ist-1];
+            n[j+NPBLK] = ii;
+            sncl[ist-1] = ii + 1;
+         }
+/* buffer particles that are leaving tile, in direction order */
+         for (i = 0; i < idimp; i++) {
+            for (j = 0; j < NPBLK; j++) {
+               j1 = n[j];
+               ii = n[j+NPBLK];
+               if (ii < npbmx) {
+                 ppbuff[ii+npbmx*i+nboff]
+                  = ppart[j1+nppmx*i+npoff];
+               }
+               else {
+                  ip = 1;
+               }
+            }
+         }
+      }
+      nps = NPBLK*ipp;
+/* loop over remaining particles */
+      for (j = nps; j < nh; j++) {
+/* buffer particles that are leaving tile, in direction order */
+         j1 = ihole[2*(j+1+(ntmax+1)*k)] - 1;
+         ist = ihole[1+2*(j+1+(ntmax+1)*k)];
+         ii = sncl[ist-1];
+         if (ii < npbmx) {
+            for (i = 0; i < idimp; i++) {
+               ppbuff[ii+npbmx*i+nboff]
+               = ppart[j1+nppmx*i+npoff];
+            }
+         }
+         else {
+            ip = 1;
+         }
+         sncl[ist-1] = ii + 1;
+      }
+      for (j = 0; j < 8; j++) {
+         ncl[j+8*k] = sncl[j];
+      }
+/* set error */
+      if (ip > 0)
+         *irc = ncl[7+8*k];
+   }
+/* ppbuff overflow */
+   if (*irc > 0)
+      return;
+
+/* copy incoming particles from buffer into ppart: update ppart, kpic */
+/* loop over tiles */
+#pragma omp parallel for \
+private(i,j,k,m,ii,kk,in,npp,npoff,nboff,ipp,joff,nps,kx,ky,kl,kr,kxl, \
+kxr,ih,nh,nn,mm,ncoff,ist,j1,j2,ip,ks,n)
+   for (k = 0; k < mxy1; k++) {
+      npp = kpic[k];
+      npoff = idimp*nppmx*k;
+      ky = k/mx1;
+/* loop over tiles in y, assume periodic boundary conditions */
+      kk = ky*mx1;
+/* find tile above */
+      kl = ky - 1;
+      if (kl < 0)
+         kl += my1;
+      kl = kl*mx1;
+/* find tile below */
+      kr = ky + 1;
+      if (kr >= my1)
+          kr -= my1;
+      kr = kr*mx1;
+/* loop over tiles in x, assume periodic boundary conditions */
+      kx = k - ky*mx1;
+      kxl = kx - 1;
+      if (kxl < 0)
+         kxl += mx1;
+      kxr = kx + 1;
+      if (kxr >= mx1)
+         kxr -= mx1;
+/* find tile number for different directions */
+      ks[0] = kxr + kk;
+      ks[1] = kxl + kk;
+      ks[2] = kx + kr;
+      ks[3] = kxr + kr;
+      ks[4] = kxl + kr;
+      ks[5] = kx + kl;
+      ks[6] = kxr + kl;
+      ks[7] = kxl + kl;
+/* loop over directions */
+      nh = ihole[2*(ntmax+1)*k];
+      ncoff = 0;
+      ih = 0;
+      ist = 0;
+      j1 = 0;
+      for (ii = 0; ii < 8; ii++) {
+         nboff = idimp*npbmx*ks[ii];
+         if (ii > 0)
+            ncoff = ncl[ii-1+8*ks[ii]];
+/* ip = number of particles coming from direction ii */
+         ip = ncl[ii+8*ks[ii]] - ncoff;
+/* loop over particles coming from direction ii */
+         ipp = ip/NPBLK;
+/* outer loop over number of full blocks */
+         for (m = 0; m < ipp; m++) {
+            joff = NPBLK*m;
+/* inner loop over particles in block */
+            for (j = 0; j < NPBLK; j++) {
+/* insert incoming particles into holes */
+               if ((j+ih) < nh) {
+                  j1 = ihole[2*(j+ih+1+(ntmax+1)*k)] - 1;
+               }
+/* place overflow at end of array */
+               else {
+                  j1 = npp + j + ih - nh;
+               }
+               n[j] = j1;
+            }
+            for (i = 0; i < idimp; i++) {
+               for (j = 0; j < NPBLK; j++) {
+                  j1 = n[j];
+                  if (j1 < nppmx) {
+                     ppart[j1+nppmx*i+npoff]
+                     = ppbuff[j+joff+ncoff+npbmx*i+nboff];
+                  }
+                  else {
+                    ist = 1;
+                  }
+               }
+            }
+            ih += NPBLK;
+         }
+         nps = NPBLK*ipp;
+/* loop over remaining particles */
+         for (j = nps; j < ip; j++) {
+            ih += 1;
+/* insert incoming particles into holes */
+            if (ih <= nh) {
+               j1 = ihole[2*(ih+(ntmax+1)*k)] - 1;
+            }
+/* place overflow at end of array */
+            else {
+               j1 = npp + ih - nh - 1;
+            }
+            if (j1 < nppmx) {
+               for (i = 0; i < idimp; i++) {
+                  ppart[j1+nppmx*i+npoff]
+                  = ppbuff[j+ncoff+npbmx*i+nboff];
+                }
+            }
+            else {
+               ist = 1;
+            }
+         }
+      }
+      if (ih > nh)
+         npp = npp + ih - nh;
+/* set error */
+      if (ist > 0)
+         *irc = j1+1;
+/* fill up remaining holes in particle array with particles from bottom */
+/* holes with locations great than npp-ip do not need to be filled      */
+      if (ih < nh) {
+         ip = nh - ih;
+/* move particles from end into remaining holes */
+/* holes are processed in increasing order      */
+         ii = nh;
+         ipp = ip/NPBLK;
+/* outer loop over number of full blocks */
+         for (m = 0; m < ipp; m++) {
+            joff = NPBLK*m;
+/* inner loop over particles in block */
+            for (j = 0; j < NPBLK; j++) {
+               n[j+NPBLK] = ihole[2*(ih+j+1+(ntmax+1)*k)] - 1;
+               n[j+2*NPBLK] = ihole[2*(ii-j+(ntmax+1)*k)] - 1;
+            }
+            in = 0;
+            mm = 0;
+            nn = n[in+2*NPBLK];
+            for (j = 0; j < NPBLK; j++) {
+               j1 = npp - j - joff - 1;
+               n[j] = n[mm+NPBLK];
+               if (j1==nn) {
+                  in += 1;
+                  nn = n[in+2*NPBLK];
+                  n[j] = -1;
+               }
+               else {
+                  mm += 1;
+               }
+            }
+            for (i = 0; i < idimp; i++) {
+               for (j = 0; j < NPBLK; j++) {
+                  j1 = npp - j - joff - 1;
+                  j2 = n[j];
+                  if (j2 >= 0) {
+                     ppart[j2+nppmx*i+npoff]
+                     = ppart[j1+nppmx*i+npoff];
+                  }
+               }
+            }
+            ii -= in;
+            ih += mm;
+         }
+         nps = NPBLK*ipp;
+         nn = ihole[2*(ii+(ntmax+1)*k)] - 1;
+         ih += 1;
+         j2 = ihole[2*(ih+(ntmax+1)*k)] - 1;
+/* loop over remaining particles */
+         for (j = nps; j < ip; j++) {
+            j1 = npp - j - 1;
+            if (j1==nn) {
+               ii -= 1;
+               nn = ihole[2*(ii+(ntmax+1)*k)] - 1;
+            }
+            else {
+               for (i = 0; i < idimp; i++) {
+                  ppart[j2+nppmx*i+npoff]
+                  = ppart[j1+nppmx*i+npoff];
+               }
+               ih += 1;
+               j2 = ihole[2*(ih+(ntmax+1)*k)] - 1;
+            }
+         }
+         npp -= ip;
+      }
+      kpic[k] = npp;
+   }
+   return;
+#undef NPBLK
+}
+
+/*--------------------------------------------------------------------*/
+void cppgrow2lt(float ppart[], int kpic[], int idimp, int nppmx,
+                int nppmxn, int mxy1) {
+/* this subroutine changes the maximum number of particles in each tile
+   of the segmented particle array ppart from nppmx to nppmxn, moving
+   the particles in place.  the array ppart must already have been
+   reallocated to hold nppmxn*idimp*mxy1 elements.
+   co-ordinates are moved in reverse order, so that no data is
+   overwritten
+   input: all, output: ppart
+   ppart[k][i][n] = i co-ordinate of particle n in tile k
+   kpic[k] = number of particles in tile k
+   idimp = size of phase space = 4
+   nppmx = old maximum number of particles in tile
+   nppmxn = new maximum number of particles in tile, must be >= nppmx
+   mxy1 = mx1*my1, where my1 = (system length in y direction - 1)/my + 1
+local data                                                            */
+   int j, k, npp;
+   if (nppmxn <= nppmx)
+      return;
+/* loop over co-ordinates in all tiles, k = i + idimp*tile */
+   for (k = idimp*mxy1-1; k > 0; k--) {
+      npp = kpic[k/idimp];
+      npp = npp < nppmx ? npp : nppmx;
+      for (j = npp-1; j >= 0; j--) {
+         ppart[j+nppmxn*k] = ppart[j+nppmx*k];
+      }
+   }
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cpphole2lt(float ppart[], int kpic[], int ncl[], int ihole[],
+                int idimp, int nppmx, int mx, int my, int mx1, int my1,
+                int ntmax, int *irc) {
+/* this subroutine finds the list of particles leaving tiles of mx, my
+   after the co-ordinates have been updated and periodic boundary
+   conditions applied, for example by cgppushf2lt.  the destination is
+   found from the tile containing the new position.
+   it is used to recalculate ncl and ihole after ihole has overflowed
+   in cgppushf2lt and has been enlarged.
+   tiles are assumed to be arranged in 2D linear memory, and transposed
+   input: all except ncl, ihole, irc
+   output: ncl, ihole, irc
+   ppart[k][0][n] = position x of particle n in tile k
+   ppart[k][1][n] = position y of particle n in tile k
+   kpic[k] = number of particles in tile k
+   ncl[k][i] = number of particles going to destination i, tile k
+   ihole[k][:][0] = location of hole in array left by departing particle
+   ihole[k][:][1] = direction destination of particle leaving hole
+   all for tile k
+   ihole[k][0][0] = ih, number of holes left (error, if negative)
+   idimp = size of phase space = 4
+   nppmx = maximum number of particles in tile
+   mx/my = number of grids in sorting cell in x/y
+   mx1 = (system length in x direction - 1)/mx + 1
+   my1 = (system length in y direction - 1)/my + 1
+   ntmax = size of hole array for particles leaving tiles
+   irc = maximum overflow, returned only if error occurs, when irc > 0
+local data                                                            */
+   int mxy1, npp, j, k, kx, ky, ih, nh, ist, nn, mm;
+   mxy1 = mx1*my1;
+/* loop over tiles */
+#pragma omp parallel for \
+private(j,k,kx,ky,npp,nn,mm,ih,nh,ist)
+   for (k = 0; k < mxy1; k++) {
+      ky = k/mx1;
+      kx = k - mx1*ky;
+      npp = kpic[k];
+      ih = 0;
+      nh = 0;
+/* clear counters */
+      for (j = 0; j < 8; j++) {
+         ncl[j+8*k] = 0;
+      }
+/* loop over particles in tile */
+      for (j = 0; j < npp; j++) {
+         nn = ppart[j+nppmx*idimp*k];
+         mm = ppart[j+nppmx*(1+idimp*k)];
+         nn = nn/mx - kx;
+         mm = mm/my - ky;
+/* ist = direction particle is going, allowing for periodic tiles */
+         ist = 0;
+         if ((nn==1) || (nn==(1-mx1)))
+            ist = 2;
+         else if (nn != 0)
+            ist = 1;
+         if ((mm==1) || (mm==(1-my1)))
+            ist += 6;
+         else if (mm != 0)
+            ist += 3;
+         if (ist > 0) {
+            ncl[ist+8*k-1] += 1;
+            ih += 1;
+            if (ih <= ntmax) {
+               ihole[2*(ih+(ntmax+1)*k)] = j + 1;
+               ihole[1+2*(ih+(ntmax+1)*k)] = ist;
+            }
+            else {
+               nh = 1;
             }
          }
       }
-/* set error */
-      if (ist > 0)
-         *irc = j1+1;
-/* fill up remaining holes in particle array with particles from bottom */
-      if (ih < nh) {
-         ip = nh - ih;
-         for (j = 0; j < ip; j++) {
-            j1 = npp - j - 1;
-            j2 = ihole[2*(nh-j+(ntmax+1)*k)] - 1;
-            if (j1 > j2) {
-/* move particle only if it is below current hole */
-               for (i = 0; i < idimp; i++) {
-                  ppart[i+idimp*(j2+nppmx*k)]
-                  = ppart[i+idimp*(j1+nppmx*k)];
-               }
-            }
-         }
-         npp -= ip;
+/* set error and end of file flag */
+      if (nh > 0) {
+         *irc = ih;
+         ih = -ih;
       }
-      kpic[k] = npp;
+      ihole[2*(ntmax+1)*k] = ih;
    }
    return;
 }
@@ -2134,6 +5599,225 @@ private(i,j,k,l,ns,ns2,km,kmr,k1,k2,jj,j1,j2,koff,t1,t2,t3)
    return;
 }
 
+/*--------------------------------------------------------------------*/
+static void cfft1yb(float complex g[], int isign, float complex sct[],
+                    int indy, int nry, int nc, int nyv) {
+/* this subroutine performs the butterflies for nc one dimensional
+   complex fast fourier transforms of length ny=2**indy, stored
+   contiguously in g[i][k], where the data is already bit-reversed
+   if isign = -1, inverse fourier transforms are performed
+   if isign = 1, forward fourier transforms are performed
+   sct = sine/cosine table
+   nry = stride in sct for the longest butterfly
+   nc = number of transforms
+   nyv = first dimension of g >= ny
+local data                                                            */
+   int ny, nyh, i, j, k, l, j1, j2, k1, k2, ns, ns2, km, kmr, ioff;
+   float complex t1, t2;
+   ny = 1L<<indy;
+   nyh = ny/2;
+   for (i = 0; i < nc; i++) {
+      ioff = nyv*i;
+      ns = 1;
+      for (l = 0; l < indy; l++) {
+         ns2 = ns + ns;
+         km = nyh/ns;
+         kmr = km*nry;
+         for (k = 0; k < km; k++) {
+            k1 = ns2*k + ioff;
+            k2 = k1 + ns;
+            for (j = 0; j < ns; j++) {
+               j1 = j + k1;
+               j2 = j + k2;
+               t1 = sct[kmr*j];
+               if (isign > 0)
+                  t1 = conjf(t1);
+               t2 = t1*g[j2];
+               g[j2] = g[j1] - t2;
+               g[j1] += t2;
+            }
+         }
+         ns = ns2;
+      }
+   }
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cfft2rmxyb(float complex f[], int isign, int mixup[],
+                float complex sct[], int indx, int indy, int nxi,
+                int nxp, int nxhd, int nyd, int nxhyd, int nxyhd) {
+/* this subroutine performs the y part of a two dimensional real to
+   complex fast fourier transform and its inverse, for a subset of x,
+   using complex arithmetic, with OpenMP, for large grids.
+   blocks of NBLKY columns are copied in bit-reversed order to a
+   contiguous transposed scratch array in each thread, transformed
+   with unit stride, and then copied back.  this replaces the stride
+   nxhd memory accesses in cfft2rmxy with unit stride accesses.
+   arguments and results are the same as for cfft2rmxy
+local data                                                            */
+#define NBLKY           8
+   int indx1, indx1y, nx, ny, nyh, nxy, nxhy, nxt;
+   int nry, nryb, nxb, nyv, nseg, i, k, k1, ii, ib, nb, koff;
+   float complex t1;
+   float complex *g;
+   float *scr;
+   if (isign==0)
+      return;
+   indx1 = indx - 1;
+   indx1y = indx1 > indy ? indx1 : indy;
+   nx = 1L<<indx;
+   ny = 1L<<indy;
+   nyh = ny/2;
+   nxy = nx > ny ? nx : ny;
+   nxhy = 1L<<indx1y;
+   nxt = nxi + nxp - 1;
+   nryb = nxhy/ny;
+   nry = nxy/ny;
+   nxb = (nxp - 1)/NBLKY + 1;
+/* pad columns of scratch array by one cache line, to avoid */
+/* associativity conflicts when ny is a large power of 2    */
+   nyv = ny + 8;
+/* scramble modes kx = 0, nx/2 */
+   if ((isign > 0) && (nxi==1)) {
+      for (k = 1; k < nyh; k++) {
+         koff = nxhd*k;
+         k1 = nxhd*ny - koff;
+         t1 = cimagf(f[k1]) + crealf(f[k1])*_Complex_I;
+         f[k1] = conjf(f[koff] - t1);
+         f[koff] += t1;
+      }
+   }
+/* find aligned scratch space for column blocks in each thread */
+   scr = cgetscr2l(2*NBLKY*nyv,&nseg);
+#pragma omp parallel for private(i,k,k1,ii,ib,nb,koff,g)
+   for (ib = 0; ib < nxb; ib++) {
+      g = (float complex *) (scr + nseg*cthreadnum());
+      i = nxi - 1 + NBLKY*ib;
+      nb = nxt - i;
+      nb = NBLKY < nb ? NBLKY : nb;
+/* copy block of columns to scratch array, with bit-reversal in y */
+      for (k = 0; k < ny; k++) {
+         k1 = (mixup[k] - 1)/nryb;
+         koff = i + nxhd*k1;
+         for (ii = 0; ii < nb; ii++) {
+            g[k+nyv*ii] = f[ii+koff];
+         }
+      }
+/* then transform in y */
+      cfft1yb(g,isign,sct,indy,nry,nb,nyv);
+/* copy transformed columns back */
+      for (k = 0; k < ny; k++) {
+         koff = i + nxhd*k;
+         for (ii = 0; ii < nb; ii++) {
+            f[ii+koff] = g[k+nyv*ii];
+         }
+      }
+   }
+/* unscramble modes kx = 0, nx/2 */
+   if ((isign < 0) && (nxi==1)) {
+      for (k = 1; k < nyh; k++) {
+         koff = nxhd*k;
+         k1 = nxhd*ny - koff;
+         t1 = f[k1];
+         f[k1] = 0.5*(cimagf(f[koff] + t1)
+                  + crealf(f[koff] - t1)*_Complex_I);
+         f[koff] = 0.5*(crealf(f[koff] + t1)
+                    + cimagf(f[koff] - t1)*_Complex_I);
+      }
+   }
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cfft2rm2yb(float complex f[], int isign, int mixup[],
+                float complex sct[], int indx, int indy, int nxi,
+                int nxp, int nxhd, int nyd, int nxhyd, int nxyhd) {
+/* this subroutine performs the y part of 2 two dimensional real to
+   complex fast fourier transforms, and their inverses, for a subset of
+   x, using complex arithmetic, with OpenMP, for large grids.
+   blocks of NBLKY columns of both components are copied in
+   bit-reversed order to a contiguous transposed scratch array in each
+   thread, transformed with unit stride, and then copied back.
+   arguments and results are the same as for cfft2rm2y
+local data                                                            */
+   int indx1, indx1y, nx, ny, nyh, nxy, nxhy, nxt;
+   int nry, nryb, nxb, nyv, nseg, i, k, k1, ii, ib, jj, nb, koff;
+   float complex t1;
+   float complex *g;
+   float *scr;
+   if (isign==0)
+      return;
+   indx1 = indx - 1;
+   indx1y = indx1 > indy ? indx1 : indy;
+   nx = 1L<<indx;
+   ny = 1L<<indy;
+   nyh = ny/2;
+   nxy = nx > ny ? nx : ny;
+   nxhy = 1L<<indx1y;
+   nxt = nxi + nxp - 1;
+   nryb = nxhy/ny;
+   nry = nxy/ny;
+   nxb = (nxp - 1)/NBLKY + 1;
+/* pad columns of scratch array by one cache line, to avoid */
+/* associativity conflicts when ny is a large power of 2    */
+   nyv = ny + 8;
+/* scramble modes kx = 0, nx/2 */
+   if ((isign > 0) && (nxi==1)) {
+      for (k = 1; k < nyh; k++) {
+         koff = 2*nxhd*k;
+         k1 = 2*nxhd*ny - koff;
+         for (jj = 0; jj < 2; jj++) {
+            t1 = cimagf(f[jj+k1]) + crealf(f[jj+k1])*_Complex_I;
+            f[jj+k1] = conjf(f[jj+koff] - t1);
+            f[jj+koff] += t1;
+         }
+      }
+   }
+/* find aligned scratch space for column blocks in each thread */
+   scr = cgetscr2l(4*NBLKY*nyv,&nseg);
+#pragma omp parallel for private(i,k,k1,ii,ib,nb,koff,g)
+   for (ib = 0; ib < nxb; ib++) {
+      g = (float complex *) (scr + nseg*cthreadnum());
+      i = nxi - 1 + NBLKY*ib;
+      nb = nxt - i;
+      nb = NBLKY < nb ? NBLKY : nb;
+/* copy block of columns to scratch array, with bit-reversal in y */
+      for (k = 0; k < ny; k++) {
+         k1 = (mixup[k] - 1)/nryb;
+         koff = 2*(i + nxhd*k1);
+         for (ii = 0; ii < 2*nb; ii++) {
+            g[k+nyv*ii] = f[ii+koff];
+         }
+      }
+/* then transform in y */
+      cfft1yb(g,isign,sct,indy,nry,2*nb,nyv);
+/* copy transformed columns back */
+      for (k = 0; k < ny; k++) {
+         koff = 2*(i + nxhd*k);
+         for (ii = 0; ii < 2*nb; ii++) {
+            f[ii+koff] = g[k+nyv*ii];
+         }
+      }
+   }
+/* unscramble modes kx = 0, nx/2 */
+   if ((isign < 0) && (nxi==1)) {
+      for (k = 1; k < nyh; k++) {
+         koff = 2*nxhd*k;
+         k1 = 2*nxhd*ny - koff;
+         for (jj = 0; jj < 2; jj++) {
+            t1 = f[jj+k1];
+            f[jj+k1] = 0.5*(cimagf(f[jj+koff] + t1)
+                        + crealf(f[jj+koff] - t1)*_Complex_I);
+            f[jj+koff] = 0.5*(crealf(f[jj+koff] + t1)
+                          + cimagf(f[jj+koff] - t1)*_Complex_I);
+         }
+      }
+   }
+   return;
+#undef NBLKY
+}
+
 /*--------------------------------------------------------------------*/
 void cwfft2rmx(float complex f[], int isign, int mixup[],
                float complex sct[], int indx, int indy, int nxhd,
@@ -2143,6 +5827,9 @@ void cwfft2rmx(float complex f[], int isign, int mixup[],
 /* local data */
    int nxh, ny;
    static int nxi = 1, nyi = 1;
+/* nxybmin = smallest size nxhd*nyd for which the cache-blocked y fft */
+/* is used, from the crossover measured with the benchmark cbfft2    */
+   static int nxybmin = 524288;
 /* calculate range of indices */
    nxh = 1L<<(indx - 1);
    ny = 1L<<indy;
@@ -2152,14 +5839,22 @@ void cwfft2rmx(float complex f[], int isign, int mixup[],
       cfft2rmxx(f,isign,mixup,sct,indx,indy,nyi,ny,nxhd,nyd,nxhyd,
                 nxyhd);
 /* perform y fft */
-      cfft2rmxy(f,isign,mixup,sct,indx,indy,nxi,nxh,nxhd,nyd,nxhyd,
-                nxyhd);
+      if (nxhd*nyd < nxybmin)
+         cfft2rmxy(f,isign,mixup,sct,indx,indy,nxi,nxh,nxhd,nyd,nxhyd,
+                   nxyhd);
+      else
+         cfft2rmxyb(f,isign,mixup,sct,indx,indy,nxi,nxh,nxhd,nyd,nxhyd,
+                    nxyhd);
    }
 /* forward fourier transform */
    else if (isign > 0) {
 /* perform y fft */
-      cfft2rmxy(f,isign,mixup,sct,indx,indy,nxi,nxh,nxhd,nyd,nxhyd,
-                nxyhd);
+      if (nxhd*nyd < nxybmin)
+         cfft2rmxy(f,isign,mixup,sct,indx,indy,nxi,nxh,nxhd,nyd,nxhyd,
+                   nxyhd);
+      else
+         cfft2rmxyb(f,isign,mixup,sct,indx,indy,nxi,nxh,nxhd,nyd,nxhyd,
+                    nxyhd);
 /* perform x fft */
       cfft2rmxx(f,isign,mixup,sct,indx,indy,nyi,ny,nxhd,nyd,nxhyd,
                 nxyhd);
@@ -2176,6 +5871,9 @@ void cwfft2rm2(float complex f[], int isign, int mixup[],
 /* local data */
    int nxh, ny;
    static int nxi = 1, nyi = 1;
+/* nxybmin = smallest size nxhd*nyd for which the cache-blocked y fft */
+/* is used, from the crossover measured with the benchmark cbfft2    */
+   static int nxybmin = 2097152;
 /* calculate range of indices */
    nxh = 1L<<(indx - 1);
    ny = 1L<<indy;
@@ -2185,14 +5883,22 @@ void cwfft2rm2(float complex f[], int isign, int mixup[],
       cfft2rm2x(f,isign,mixup,sct,indx,indy,nyi,ny,nxhd,nyd,nxhyd,
                 nxyhd);
 /* perform y fft */
-      cfft2rm2y(f,isign,mixup,sct,indx,indy,nxi,nxh,nxhd,nyd,nxhyd,
-                nxyhd);
+      if (nxhd*nyd < nxybmin)
+         cfft2rm2y(f,isign,mixup,sct,indx,indy,nxi,nxh,nxhd,nyd,nxhyd,
+                   nxyhd);
+      else
+         cfft2rm2yb(f,isign,mixup,sct,indx,indy,nxi,nxh,nxhd,nyd,nxhyd,
+                    nxyhd);
    }
 /* forward fourier transform */
    else if (isign > 0) {
 /* perform y fft */
-      cfft2rm2y(f,isign,mixup,sct,indx,indy,nxi,nxh,nxhd,nyd,nxhyd,
-                nxyhd);
+      if (nxhd*nyd < nxybmin)
+         cfft2rm2y(f,isign,mixup,sct,indx,indy,nxi,nxh,nxhd,nyd,nxhyd,
+                   nxyhd);
+      else
+         cfft2rm2yb(f,isign,mixup,sct,indx,indy,nxi,nxh,nxhd,nyd,nxhyd,
+                    nxyhd);
 /* perform x fft */
       cfft2rm2x(f,isign,mixup,sct,indx,indy,nyi,ny,nxhd,nyd,nxhyd,
                 nxyhd);
@@ -2255,6 +5961,17 @@ void cgppushf2l_(float *ppart, float *fxy, int *kpic, int *ncl,
    return;
 }
 
+/*--------------------------------------------------------------------*/
+void cgppushfq2l_(float *ppart, float *fxy, float *q, int *kpic,
+                  int *ncl, int *ihole, float *qbm, float *qm, float *dt,
+                  float *ek, int *idimp, int *nppmx, int *nx, int *ny,
+                  int *mx, int *my, int *nxv, int *nyv, int *mx1,
+                  int *mxy1, int *ntmax, int *irc) {
+   cgppushfq2l(ppart,fxy,q,kpic,ncl,ihole,*qbm,*qm,*dt,ek,*idimp,*nppmx,
+               *nx,*ny,*mx,*my,*nxv,*nyv,*mx1,*mxy1,*ntmax,irc);
+   return;
+}
+
 /*--------------------------------------------------------------------*/
 void cgppost2l_(float *ppart, float *q, int *kpic, float *qm,
                 int *nppmx, int *idimp, int *mx, int *my, int *nxv,
@@ -2264,6 +5981,15 @@ void cgppost2l_(float *ppart, float *q, int *kpic, float *qm,
    return;
 }
 
+/*--------------------------------------------------------------------*/
+void cgppost2lh_(float *ppart, float *q, float *qh, int *kpic,
+                 float *qm, int *nppmx, int *idimp, int *mx, int *my,
+                 int *nxv, int *nyv, int *mx1, int *mxy1) {
+   cgppost2lh(ppart,q,qh,kpic,*qm,*nppmx,*idimp,*mx,*my,*nxv,*nyv,
+              *mx1,*mxy1);
+   return;
+}
+
 /*--------------------------------------------------------------------*/
 void cpporder2l_(float *ppart, float *ppbuff, int *kpic, int *ncl,
                  int *ihole, int *idimp, int *nppmx, int *nx, int *ny,
@@ -2283,6 +6009,166 @@ void cpporderf2l_(float *ppart, float *ppbuff, int *kpic, int *ncl,
    return;
 }
 
+/*--------------------------------------------------------------------*/
+void cppsizef2l_(int *kpic, int *ncl, int *nppmx, int *nbmx, int *mx1,
+                 int *my1) {
+   cppsizef2l(kpic,ncl,nppmx,nbmx,*mx1,*my1);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppgrow2l_(float *ppart, int *kpic, int *idimp, int *nppmx,
+                int *nppmxn, int *mxy1) {
+   cppgrow2l(ppart,kpic,*idimp,*nppmx,*nppmxn,*mxy1);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cpphole2l_(float *ppart, int *kpic, int *ncl, int *ihole,
+                int *idimp, int *nppmx, int *mx, int *my, int *mx1,
+                int *my1, int *ntmax, int *irc) {
+   cpphole2l(ppart,kpic,ncl,ihole,*idimp,*nppmx,*mx,*my,*mx1,*my1,
+             *ntmax,irc);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppmovin2lt_(float *part, float *ppart, int *kpic, int *nppmx,
+                  int *idimp, int *nop, int *mx, int *my, int *mx1,
+                  int *mxy1, int *irc) {
+   cppmovin2lt(part,ppart,kpic,*nppmx,*idimp,*nop,*mx,*my,*mx1,*mxy1,
+               irc);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppcheck2lt_(float *ppart, int *kpic, int *idimp, int *nppmx,
+                  int *nx, int *ny, int *mx, int *my, int *mx1,
+                  int *my1, int *irc) {
+   cppcheck2lt(ppart,kpic,*idimp,*nppmx,*nx,*ny,*mx,*my,*mx1,*my1,irc);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cgppush2lt_(float *ppart, float *fxy, int *kpic, float *qbm,
+                 float *dt, float *ek, int *idimp, int *nppmx, int *nx,
+                 int *ny, int *mx, int *my, int *nxv, int *nyv,
+                 int *mx1, int *mxy1, int *ipbc) {
+   cgppush2lt(ppart,fxy,kpic,*qbm,*dt,ek,*idimp,*nppmx,*nx,*ny,*mx,*my,
+              *nxv,*nyv,*mx1,*mxy1,*ipbc);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cgppushf2lt_(float *ppart, float *fxy, int *kpic, int *ncl,
+                  int *ihole, float *qbm, float *dt, float *ek,
+                  int *idimp, int *nppmx, int *nx, int *ny, int *mx,
+                  int *my, int *nxv, int *nyv, int *mx1, int *mxy1,
+                  int *ntmax, int *irc) {
+   cgppushf2lt(ppart,fxy,kpic,ncl,ihole,*qbm,*dt,ek,*idimp,*nppmx,*nx,
+               *ny,*mx,*my,*nxv,*nyv,*mx1,*mxy1,*ntmax,irc);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cvgppush2lt_(float *ppart, float *fxy, int *kpic, float *qbm,
+                  float *dt, float *ek, int *idimp, int *nppmx, int *nx,
+                  int *ny, int *mx, int *my, int *nxv, int *nyv,
+                  int *mx1, int *mxy1, int *ipbc) {
+   cvgppush2lt(ppart,fxy,kpic,*qbm,*dt,ek,*idimp,*nppmx,*nx,*ny,*mx,*my,
+               *nxv,*nyv,*mx1,*mxy1,*ipbc);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cvgppushf2lt_(float *ppart, float *fxy, int *kpic, int *ncl,
+                   int *ihole, float *qbm, float *dt, float *ek,
+                   int *idimp, int *nppmx, int *nx, int *ny, int *mx,
+                   int *my, int *nxv, int *nyv, int *mx1, int *mxy1,
+                   int *ntmax, int *irc) {
+   cvgppushf2lt(ppart,fxy,kpic,ncl,ihole,*qbm,*dt,ek,*idimp,*nppmx,*nx,
+                *ny,*mx,*my,*nxv,*nyv,*mx1,*mxy1,*ntmax,irc);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cgppost2lt_(float *ppart, float *q, int *kpic, float *qm,
+                 int *nppmx, int *idimp, int *mx, int *my, int *nxv,
+                 int *nyv, int *mx1, int *mxy1) {
+   cgppost2lt(ppart,q,kpic,*qm,*nppmx,*idimp,*mx,*my,*nxv,*nyv,*mx1,
+              *mxy1);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cvgppost2lt_(float *ppart, float *q, int *kpic, float *qm,
+                  int *nppmx, int *idimp, int *mx, int *my, int *nxv,
+                  int *nyv, int *mx1, int *mxy1) {
+   cvgppost2lt(ppart,q,kpic,*qm,*nppmx,*idimp,*mx,*my,*nxv,*nyv,*mx1,
+               *mxy1);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cviscan2_(int *isdata, int *mb, int *nths) {
+   cviscan2(isdata,mb,*nths);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cpporder2lt_(float *ppart, float *ppbuff, int *kpic, int *ncl,
+                  int *ihole, int *idimp, int *nppmx, int *nx, int *ny,
+                  int *mx, int *my, int *mx1, int *my1, int *npbmx,
+                  int *ntmax, int *irc) {
+   cpporder2lt(ppart,ppbuff,kpic,ncl,ihole,*idimp,*nppmx,*nx,*ny,*mx,
+                *my,*mx1,*my1,*npbmx,*ntmax,irc);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cpporderf2lt_(float *ppart, float *ppbuff, int *kpic, int *ncl,
+                   int *ihole, int *idimp, int *nppmx, int *mx1,
+                   int *my1, int *npbmx, int *ntmax, int *irc) {
+   cpporderf2lt(ppart,ppbuff,kpic,ncl,ihole,*idimp,*nppmx,*mx1,*my1,
+                 *npbmx,*ntmax,irc);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cvpporder2lt_(float *ppart, float *ppbuff, int *kpic, int *ncl,
+                   int *ihole, int *idimp, int *nppmx, int *nx, int *ny,
+                   int *mx, int *my, int *mx1, int *my1, int *npbmx,
+                   int *ntmax, int *irc) {
+   cvpporder2lt(ppart,ppbuff,kpic,ncl,ihole,*idimp,*nppmx,*nx,*ny,*mx,
+                *my,*mx1,*my1,*npbmx,*ntmax,irc);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cvpporderf2lt_(float *ppart, float *ppbuff, int *kpic, int *ncl,
+                    int *ihole, int *idimp, int *nppmx, int *mx1,
+                    int *my1, int *npbmx, int *ntmax, int *irc) {
+   cvpporderf2lt(ppart,ppbuff,kpic,ncl,ihole,*idimp,*nppmx,*mx1,*my1,
+                 *npbmx,*ntmax,irc);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppgrow2lt_(float *ppart, int *kpic, int *idimp, int *nppmx,
+                 int *nppmxn, int *mxy1) {
+   cppgrow2lt(ppart,kpic,*idimp,*nppmx,*nppmxn,*mxy1);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cpphole2lt_(float *ppart, int *kpic, int *ncl, int *ihole,
+                 int *idimp, int *nppmx, int *mx, int *my, int *mx1,
+                 int *my1, int *ntmax, int *irc) {
+   cpphole2lt(ppart,kpic,ncl,ihole,*idimp,*nppmx,*mx,*my,*mx1,*my1,
+              *ntmax,irc);
+   return;
+}
+
 /*--------------------------------------------------------------------*/
 void ccguard2l_(float *fxy, int *nx, int *ny, int *nxe, int *nye) {
    ccguard2l(fxy,*nx,*ny,*nxe,*nye);
@@ -2348,6 +6234,24 @@ void cfft2rm2y_(float complex *f, int *isign, int *mixup,
    return;
 }
 
+/*--------------------------------------------------------------------*/
+void cfft2rmxyb_(float complex *f, int *isign, int *mixup,
+                 float complex *sct, int *indx, int *indy, int *nxi,
+                 int *nxp, int *nxhd, int *nyd, int *nxhyd, int *nxyhd) {
+   cfft2rmxyb(f,*isign,mixup,sct,*indx,*indy,*nxi,*nxp,*nxhd,*nyd,
+              *nxhyd,*nxyhd);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cfft2rm2yb_(float complex *f, int *isign, int *mixup,
+                 float complex *sct, int *indx, int *indy, int *nxi,
+                 int *nxp, int *nxhd, int *nyd, int *nxhyd, int *nxyhd) {
+   cfft2rm2yb(f,*isign,mixup,sct,*indx,*indy,*nxi,*nxp,*nxhd,*nyd,
+              *nxhyd,*nxyhd);
+   return;
+}
+
 /*--------------------------------------------------------------------*/
 void cwfft2rmx_(float complex *f, int *isign, int *mixup,
                 float complex *sct, int *indx, int *indy, int *nxhd,
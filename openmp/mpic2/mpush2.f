@@ -299,15 +299,12 @@ c (none,2d periodic,2d reflecting,mixed reflecting/periodic)
       dimension ppart(idimp,nppmx,mxy1), fxy(2,nxv,nyv)
       dimension kpic(mxy1)
 c local data
-      integer MXV, MYV
-      parameter(MXV=33,MYV=33)
       integer noff, moff, npp
       integer i, j, k, nn, mm
       real qtm, edgelx, edgely, edgerx, edgery, dxp, dyp, amx, amy
       real x, y, dx, dy, vx, vy
       real sfxy
-      dimension sfxy(2,MXV,MYV)
-c     dimension sfxy(2,mx+1,my+1)
+      dimension sfxy(2,mx+1,my+1)
       double precision sum1, sum2
       qtm = qbm*dt
       sum2 = 0.0d0
@@ -325,8 +322,6 @@ c set boundary values
          edgelx = 1.0
          edgerx = real(nx-1)
       endif
-c error if local array is too small
-c     if ((mx.ge.MXV).or.(my.ge.MYV)) return
 c loop over tiles
 !$OMP PARALLEL DO
 !$OMP& PRIVATE(i,j,k,noff,moff,npp,nn,mm,x,y,dxp,dyp,amx,amy,dx,dy,vx,vy
@@ -470,23 +465,18 @@ c optimized version
       dimension kpic(mxy1), ncl(8,mxy1)
       dimension ihole(2,ntmax+1,mxy1)
 c local data
-      integer MXV, MYV
-      parameter(MXV=33,MYV=33)
       integer noff, moff, npp
       integer i, j, k, ih, nh, nn, mm
       real qtm, dxp, dyp, amx, amy
       real x, y, dx, dy, vx, vy
       real anx, any, edgelx, edgely, edgerx, edgery
       real sfxy
-      dimension sfxy(2,MXV,MYV)
-c     dimension sfxy(2,mx+1,my+1)
+      dimension sfxy(2,mx+1,my+1)
       double precision sum1, sum2
       qtm = qbm*dt
       anx = real(nx)
       any = real(ny)
       sum2 = 0.0d0
-c error if local array is too small
-c     if ((mx.ge.MXV).or.(my.ge.MYV)) return
 c loop over tiles
 !$OMP PARALLEL DO
 !$OMP& PRIVATE(i,j,k,noff,moff,npp,nn,mm,ih,nh,x,y,dxp,dyp,amx,amy,dx,dy
@@ -614,6 +604,285 @@ c ihole overflow
       ihole(1,1,k) = ih
    50 continue
 !$OMP END PARALLEL DO
+c normalize kinetic energy
+      ek = ek + 0.125*sum2
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine GPPUSHFQ2L(ppart,fxy,q,kpic,ncl,ihole,qbm,qm,dt,ek,    
+     1idimp,nppmx,nx,ny,mx,my,nxv,nyv,mx1,mxy1,ntmax,irc)
+c for 2d code, this subroutine updates particle co-ordinates and
+c velocities using leap-frog scheme in time and first-order linear
+c interpolation in space, with periodic boundary conditions.
+c also determines list of particles which are leaving this tile, and
+c deposits the charge density at the new positions, so that the
+c particles are read only once per time step
+c OpenMP version using guard cells
+c data read and deposited in tiles
+c particles stored segmented array
+c 61 flops/particle, 12 loads, 8 stores
+c input: all except ncl, ihole, irc, output: ppart, q, ncl, ihole, ek,
+c irc
+c equations used are the same as for GPPUSHF2L.
+c charge density is approximated by values at the nearest grid points
+c q(n,m)=qm*(1.-dx)*(1.-dy)
+c q(n+1,m)=qm*dx*(1.-dy)
+c q(n,m+1)=qm*(1.-dx)*dy
+c q(n+1,m+1)=qm*dx*dy
+c where n,m = leftmost grid points and dx = x-n, dy = y-m, at the new
+c position x(t+dt), y(t+dt)
+c charge is accumulated in a local array covering the tile and one
+c grid point beyond it, which is then added to q with atomic updates.
+c particles which moved further are deposited directly to q.
+c q must be cleared before calling, and guard cells must be added
+c afterwards with AGUARD2L.
+c ppart(1,n,m) = position x of particle n in tile m
+c ppart(2,n,m) = position y of particle n in tile m
+c ppart(3,n,m) = velocity vx of particle n in tile m
+c ppart(4,n,m) = velocity vy of particle n in tile m
+c fxy(1,j,k) = x component of force/charge at grid (j,k)
+c fxy(2,j,k) = y component of force/charge at grid (j,k)
+c that is, convolution of electric field over particle shape
+c q(j,k) = charge density at grid point j,k
+c kpic(k) = number of particles in tile k
+c ncl(i,k) = number of particles going to destination i, tile k
+c ihole(1,:,k) = location of hole in array left by departing particle
+c ihole(2,:,k) = destination of particle leaving hole
+c ihole(1,1,k) = ih, number of holes left (error, if negative)
+c qbm = particle charge/mass
+c qm = charge on particle, in units of e
+c dt = time interval between successive calculations
+c kinetic energy/mass at time t is also calculated, using
+c ek = .125*sum((vx(t+dt/2)+vx(t-dt/2))**2+(vy(t+dt/2)+vy(t-dt/2))**2)
+c idimp = size of phase space = 4
+c nppmx = maximum number of particles in tile
+c nx/ny = system length in x/y direction
+c mx/my = number of grids in sorting cell in x/y
+c nxv = second dimension of field arrays, must be >= nx+1
+c nyv = third dimension of field arrays, must be >= ny+1
+c mx1 = (system length in x direction - 1)/mx + 1
+c mxy1 = mx1*my1, where my1 = (system length in y direction - 1)/my + 1
+c ntmax = size of hole array for particles leaving tiles
+c irc = maximum overflow, returned only if error occurs, when irc > 0
+      implicit none
+      integer idimp, nppmx, nx, ny, mx, my, nxv, nyv, mx1, mxy1, ntmax
+      integer irc
+      real qbm, qm, dt, ek
+      real ppart, fxy, q
+      integer kpic, ncl, ihole
+      dimension ppart(idimp,nppmx,mxy1), fxy(2,nxv,nyv), q(nxv,nyv)
+      dimension kpic(mxy1), ncl(8,mxy1)
+      dimension ihole(2,ntmax+1,mxy1)
+c local data
+      integer noff, moff, npp
+      integer i, j, k, ih, nh, nn, mm, np, mp
+      real qtm, dxp, dyp, amx, amy
+      real x, y, dx, dy, vx, vy
+      real anx, any, edgelx, edgely, edgerx, edgery, sxq, syq
+      real sfxy, sq
+      dimension sfxy(2,mx+1,my+1)
+c sq = local charge array for tile plus a border of one grid point
+      dimension sq(mx+3,my+3)
+      double precision sum1, sum2
+      qtm = qbm*dt
+      anx = real(nx)
+      any = real(ny)
+      sxq = real(mx + 2)
+      syq = real(my + 2)
+      sum2 = 0.0d0
+c loop over tiles
+!$OMP PARALLEL DO
+!$OMP& PRIVATE(i,j,k,noff,moff,npp,nn,mm,np,mp,ih,nh,x,y,dxp,dyp,amx,amy
+!$OMP& ,dx,dy,vx,vy,edgelx,edgely,edgerx,edgery,sum1,sfxy,sq)
+!$OMP& REDUCTION(+:sum2)
+      do 90 k = 1, mxy1
+      noff = (k - 1)/mx1
+      moff = my*noff
+      noff = mx*(k - mx1*noff - 1)
+      npp = kpic(k)
+      nn = min(mx,nx-noff)
+      mm = min(my,ny-moff)
+      edgelx = noff
+      edgerx = noff + nn
+      edgely = moff
+      edgery = moff + mm
+      ih = 0
+      nh = 0
+c load local fields from global array
+      do 20 j = 1, mm+1
+      do 10 i = 1, nn+1
+      sfxy(1,i,j) = fxy(1,i+noff,j+moff)
+      sfxy(2,i,j) = fxy(2,i+noff,j+moff)
+   10 continue
+   20 continue
+c zero out local accumulator
+      do 40 j = 1, my+3
+      do 30 i = 1, mx+3
+      sq(i,j) = 0.0
+   30 continue
+   40 continue
+c clear counters
+      do 50 j = 1, 8
+      ncl(j,k) = 0
+   50 continue
+      sum1 = 0.0d0
+c loop over particles in tile
+      do 60 j = 1, npp
+c find interpolation weights
+      x = ppart(1,j,k)
+      y = ppart(2,j,k)
+      nn = x
+      mm = y
+      dxp = x - real(nn)
+      dyp = y - real(mm)
+      nn = nn - noff + 1
+      mm = mm - moff + 1
+      amx = 1.0 - dxp
+      amy = 1.0 - dyp
+c find acceleration
+      dx = amx*sfxy(1,nn,mm)
+      dy = amx*sfxy(2,nn,mm)
+      dx = amy*(dxp*sfxy(1,nn+1,mm) + dx)
+      dy = amy*(dxp*sfxy(2,nn+1,mm) + dy)
+      vx = amx*sfxy(1,nn,mm+1)
+      vy = amx*sfxy(2,nn,mm+1)
+      dx = dx + dyp*(dxp*sfxy(1,nn+1,mm+1) + vx) 
+      dy = dy + dyp*(dxp*sfxy(2,nn+1,mm+1) + vy)
+c new velocity
+      vx = ppart(3,j,k)
+      vy = ppart(4,j,k)
+      dx = vx + qtm*dx
+      dy = vy + qtm*dy
+c average kinetic energy
+      vx = vx + dx
+      vy = vy + dy
+      sum1 = sum1 + (vx*vx + vy*vy)
+      ppart(3,j,k) = dx
+      ppart(4,j,k) = dy
+c new position
+      dx = x + dx*dt
+      dy = y + dy*dt
+c deposit charge at new position, before boundary conditions,
+c while the particle is still in registers
+      x = dx - real(noff - 1)
+      y = dy - real(moff - 1)
+      mp = 0
+c particle within one grid point of tile: deposit to local array
+      if ((x.ge.0.0).and.(x.lt.sxq).and.(y.ge.0.0).and.(y.lt.syq)) then
+         np = x
+         mp = y
+         dxp = qm*(x - real(np))
+         dyp = y - real(mp)
+         np = np + 1
+         mp = mp + 1
+         amx = qm - dxp
+         amy = 1.0 - dyp
+         sq(np,mp) = sq(np,mp) + amx*amy
+         sq(np+1,mp) = sq(np+1,mp) + dxp*amy
+         sq(np,mp+1) = sq(np,mp+1) + amx*dyp
+         sq(np+1,mp+1) = sq(np+1,mp+1) + dxp*dyp
+         mp = -1
+      endif
+c find particles going out of bounds
+      mm = 0
+c count how many particles are going in each direction in ncl
+c save their address and destination in ihole
+c use periodic boundary conditions and check for roundoff error
+c mm = direction particle is going
+      if (dx.ge.edgerx) then
+         if (dx.ge.anx) dx = dx - anx
+         mm = 2
+      else if (dx.lt.edgelx) then
+         if (dx.lt.0.0) then
+            dx = dx + anx
+            if (dx.lt.anx) then
+               mm = 1
+            else
+               dx = 0.0
+            endif
+         else
+            mm = 1
+         endif
+      endif
+      if (dy.ge.edgery) then
+         if (dy.ge.any) dy = dy - any
+         mm = mm + 6
+      else if (dy.lt.edgely) then
+         if (dy.lt.0.0) then
+            dy = dy + any
+            if (dy.lt.any) then
+               mm = mm + 3
+            else
+               dy = 0.0
+            endif
+         else
+            mm = mm + 3
+         endif
+      endif
+c set new position
+      ppart(1,j,k) = dx
+      ppart(2,j,k) = dy
+c particle moved more than one grid point: deposit to global array
+      if (mp.ge.0) then
+         np = dx
+         mp = dy
+         dxp = qm*(dx - real(np))
+         dyp = dy - real(mp)
+         np = np + 1
+         mp = mp + 1
+         amx = qm - dxp
+         amy = 1.0 - dyp
+!$OMP ATOMIC
+         q(np,mp) = q(np,mp) + amx*amy
+!$OMP ATOMIC
+         q(np+1,mp) = q(np+1,mp) + dxp*amy
+!$OMP ATOMIC
+         q(np,mp+1) = q(np,mp+1) + amx*dyp
+!$OMP ATOMIC
+         q(np+1,mp+1) = q(np+1,mp+1) + dxp*dyp
+      endif
+c increment counters
+      if (mm.gt.0) then
+         ncl(mm,k) = ncl(mm,k) + 1
+         ih = ih + 1
+         if (ih.le.ntmax) then
+            ihole(1,ih+1,k) = j
+            ihole(2,ih+1,k) = mm
+         else
+            nh = 1
+         endif
+      endif
+   60 continue
+      sum2 = sum2 + sum1
+c set error and end of file flag
+c ihole overflow
+      if (nh.gt.0) then
+         irc = ih
+         ih = -ih
+      endif
+      ihole(1,1,k) = ih
+c deposit local charge to global array, with periodic boundaries.
+c the border overlaps neighboring tiles, so atomic updates are used
+      do 80 j = 1, my+3
+      mm = j + moff - 2
+      if (mm.lt.0) then
+         mm = mm + ny
+      else if (mm.gt.ny) then
+         mm = mm - ny
+      endif
+      do 70 i = 1, mx+3
+      nn = i + noff - 2
+      if (nn.lt.0) then
+         nn = nn + nx
+      else if (nn.gt.nx) then
+         nn = nn - nx
+      endif
+!$OMP ATOMIC
+      q(nn+1,mm+1) = q(nn+1,mm+1) + sq(i,j)
+   70 continue
+   80 continue
+   90 continue
+!$OMP END PARALLEL DO
 c normalize kinetic energy
       ek = ek + 0.125*sum2
       return
@@ -654,16 +923,11 @@ c mxy1 = mx1*my1, where my1 = (system length in y direction - 1)/my + 1
       dimension ppart(idimp,nppmx,mxy1), q(nxv,nyv)
       dimension kpic(mxy1)
 c local data
-      integer MXV, MYV
-      parameter(MXV=33,MYV=33)
       integer noff, moff, npp
       integer i, j, k, nn, mm
       real x, y, dxp, dyp, amx, amy
       real sq
-c     dimension sq(MXV,MYV)
       dimension sq(mx+1,my+1)
-c error if local array is too small
-c     if ((mx.ge.MXV).or.(my.ge.MYV)) return
 c loop over tiles
 !$OMP PARALLEL DO
 !$OMP& PRIVATE(i,j,k,noff,moff,npp,nn,mm,x,y,dxp,dyp,amx,amy,sq)
@@ -677,64 +941,2593 @@ c zero out local accumulator
       do 10 i = 1, mx+1
       sq(i,j) = 0.0
    10 continue
-   20 continue
-c loop over particles in tile
-      do 30 j = 1, npp
-c find interpolation weights
-      x = ppart(1,j,k)
-      y = ppart(2,j,k)
-      nn = x
-      mm = y
-      dxp = qm*(x - real(nn))
-      dyp = y - real(mm)
-      nn = nn - noff + 1
-      mm = mm - moff + 1
-      amx = qm - dxp
-      amy = 1.0 - dyp
-c deposit charge within tile to local accumulator
-      x = sq(nn,mm) + amx*amy
-      y = sq(nn+1,mm) + dxp*amy
-      sq(nn,mm) = x
-      sq(nn+1,mm) = y
-      x = sq(nn,mm+1) + amx*dyp
-      y = sq(nn+1,mm+1) + dxp*dyp
-      sq(nn,mm+1) = x
-      sq(nn+1,mm+1) = y
+   20 continue
+c loop over particles in tile
+      do 30 j = 1, npp
+c find interpolation weights
+      x = ppart(1,j,k)
+      y = ppart(2,j,k)
+      nn = x
+      mm = y
+      dxp = qm*(x - real(nn))
+      dyp = y - real(mm)
+      nn = nn - noff + 1
+      mm = mm - moff + 1
+      amx = qm - dxp
+      amy = 1.0 - dyp
+c deposit charge within tile to local accumulator
+      x = sq(nn,mm) + amx*amy
+      y = sq(nn+1,mm) + dxp*amy
+      sq(nn,mm) = x
+      sq(nn+1,mm) = y
+      x = sq(nn,mm+1) + amx*dyp
+      y = sq(nn+1,mm+1) + dxp*dyp
+      sq(nn,mm+1) = x
+      sq(nn+1,mm+1) = y
+   30 continue
+c deposit charge to interior points in global array
+      nn = min(mx,nxv-noff)
+      mm = min(my,nyv-moff)
+      do 50 j = 2, mm
+      do 40 i = 2, nn
+      q(i+noff,j+moff) = q(i+noff,j+moff) + sq(i,j)
+   40 continue
+   50 continue
+c deposit charge to edge points in global array
+      mm = min(my+1,nyv-moff)
+      do 60 i = 2, nn
+!$OMP ATOMIC
+      q(i+noff,1+moff) = q(i+noff,1+moff) + sq(i,1)
+      if (mm > my) then
+!$OMP ATOMIC
+         q(i+noff,mm+moff) = q(i+noff,mm+moff) + sq(i,mm)
+      endif
+   60 continue
+      nn = min(mx+1,nxv-noff)
+      do 70 j = 1, mm
+!$OMP ATOMIC
+      q(1+noff,j+moff) = q(1+noff,j+moff) + sq(1,j)
+      if (nn > mx) then
+!$OMP ATOMIC
+         q(nn+noff,j+moff) = q(nn+noff,j+moff) + sq(nn,j)
+      endif
+   70 continue
+   80 continue
+!$OMP END PARALLEL DO
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine GPPOST2LH(ppart,q,qh,kpic,qm,nppmx,idimp,mx,my,nxv,nyv,
+     1mx1,mxy1)
+c for 2d code, this subroutine calculates particle charge density
+c using first-order linear interpolation, periodic boundaries
+c OpenMP version using guard cells
+c data deposited in tiles
+c particles stored segmented array
+c same as GPPOST2L, except charge on the edges of each tile is first
+c saved in a halo buffer, then added to q in a second pass which
+c processes tiles in 4 colors, so that no atomic updates are needed.
+c tiles of the same color do not share any grid points
+c 17 flops/particle, 6 loads, 4 stores
+c input: all, output: q
+c charge density is approximated by values at the nearest grid points
+c q(n,m)=qm*(1.-dx)*(1.-dy)
+c q(n+1,m)=qm*dx*(1.-dy)
+c q(n,m+1)=qm*(1.-dx)*dy
+c q(n+1,m+1)=qm*dx*dy
+c where n,m = leftmost grid points and dx = x-n, dy = y-m
+c ppart(1,n,m) = position x of particle n in tile m
+c ppart(2,n,m) = position y of particle n in tile m
+c q(j,k) = charge density at grid point j,k
+c qh(j,k) = charge density at edge point j of tile k
+c kpic = number of particles per tile
+c qm = charge on particle, in units of e
+c nppmx = maximum number of particles in tile
+c idimp = size of phase space = 4
+c mx/my = number of grids in sorting cell in x/y
+c nxv = first dimension of charge array, must be >= nx+1
+c nyv = second dimension of charge array, must be >= ny+1
+c mx1 = (system length in x direction - 1)/mx + 1
+c mxy1 = mx1*my1, where my1 = (system length in y direction - 1)/my + 1
+      implicit none
+      integer nppmx, idimp, mx, my, nxv, nyv, mx1, mxy1
+      real qm
+      real ppart, q, qh
+      integer kpic
+      dimension ppart(idimp,nppmx,mxy1), q(nxv,nyv)
+      dimension qh(2*(mx+my),mxy1)
+      dimension kpic(mxy1)
+c local data
+      integer noff, moff, npp, kc
+      integer i, j, k, nn, mm, ih, ii
+      real x, y, dxp, dyp, amx, amy
+      real sq
+      dimension sq(mx+1,my+1)
+c first pass: deposit to interior points and save edges
+!$OMP PARALLEL DO
+!$OMP& PRIVATE(i,j,k,noff,moff,npp,nn,mm,ih,ii,x,y,dxp,dyp,amx,amy,sq)
+      do 80 k = 1, mxy1
+      noff = (k - 1)/mx1
+      moff = my*noff
+      noff = mx*(k - mx1*noff - 1)
+      npp = kpic(k)
+c zero out local accumulator
+      do 20 j = 1, my+1
+      do 10 i = 1, mx+1
+      sq(i,j) = 0.0
+   10 continue
+   20 continue
+c loop over particles in tile
+      do 30 j = 1, npp
+c find interpolation weights
+      x = ppart(1,j,k)
+      y = ppart(2,j,k)
+      nn = x
+      mm = y
+      dxp = qm*(x - real(nn))
+      dyp = y - real(mm)
+      nn = nn - noff + 1
+      mm = mm - moff + 1
+      amx = qm - dxp
+      amy = 1.0 - dyp
+c deposit charge within tile to local accumulator
+      x = sq(nn,mm) + amx*amy
+      y = sq(nn+1,mm) + dxp*amy
+      sq(nn,mm) = x
+      sq(nn+1,mm) = y
+      x = sq(nn,mm+1) + amx*dyp
+      y = sq(nn+1,mm+1) + dxp*dyp
+      sq(nn,mm+1) = x
+      sq(nn+1,mm+1) = y
+   30 continue
+c deposit charge to interior points in global array
+      nn = min(mx,nxv-noff)
+      mm = min(my,nyv-moff)
+      do 50 j = 2, mm
+      do 40 i = 2, nn
+      q(i+noff,j+moff) = q(i+noff,j+moff) + sq(i,j)
+   40 continue
+   50 continue
+c save charge at edge points in halo buffer
+      nn = min(mx+1,nxv-noff)
+      mm = min(my+1,nyv-moff)
+      ih = 0
+      do 70 j = 1, mm
+      ii = mx
+      if ((j.eq.1).or.(j.eq.(my+1))) ii = 1
+      do 60 i = 1, nn, ii
+      ih = ih + 1
+      qh(ih,k) = sq(i,j)
+   60 continue
+   70 continue
+   80 continue
+!$OMP END PARALLEL DO
+c second pass: add edges to global array, one color at a time
+      do 120 kc = 0, 3
+!$OMP PARALLEL DO PRIVATE(i,j,k,noff,moff,nn,mm,ih,ii)
+      do 110 k = 1, mxy1
+      noff = (k - 1)/mx1
+      moff = noff
+      noff = k - mx1*noff - 1
+      if ((mod(noff,2)+2*mod(moff,2)).ne.kc) go to 110
+      moff = my*moff
+      noff = mx*noff
+      nn = min(mx+1,nxv-noff)
+      mm = min(my+1,nyv-moff)
+      ih = 0
+      do 100 j = 1, mm
+      ii = mx
+      if ((j.eq.1).or.(j.eq.(my+1))) ii = 1
+      do 90 i = 1, nn, ii
+      ih = ih + 1
+      q(i+noff,j+moff) = q(i+noff,j+moff) + qh(ih,k)
+   90 continue
+  100 continue
+  110 continue
+!$OMP END PARALLEL DO
+  120 continue
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPORDER2L(ppart,ppbuff,kpic,ncl,ihole,idimp,nppmx,nx,ny
+     1,mx,my,mx1,my1,npbmx,ntmax,irc)
+c this subroutine sorts particles by x,y grid in tiles of mx, my
+c linear interpolation, with periodic boundary conditions
+c tiles are assumed to be arranged in 2D linear memory
+c algorithm has 3 steps.  first, one finds particles leaving tile and
+c stores their number in each directon, location, and destination in ncl
+c and ihole.  second, a prefix scan of ncl is performed and departing
+c particles are buffered in ppbuff in direction order.  finally, we copy
+c the incoming particles from other tiles into ppart.
+c input: all except ppbuff, ncl, ihole, irc
+c output: ppart, ppbuff, kpic, ncl, ihole, irc
+c ppart(1,n,k) = position x of particle n in tile k
+c ppart(2,n,k) = position y of particle n in tile k
+c ppbuff(i,n,k) = i co-ordinate of particle n in tile k
+c kpic(k) = number of particles in tile k
+c ncl(i,k) = number of particles going to destination i, tile k
+c ihole(1,:,k) = location of hole in array left by departing particle
+c ihole(2,:,k) = direction destination of particle leaving hole
+c all for tile k
+c ihole(1,1,k) = ih, number of holes left (error, if negative)
+c idimp = size of phase space = 4
+c nppmx = maximum number of particles in tile
+c nx/ny = system length in x/y direction
+c mx/my = number of grids in sorting cell in x/y
+c mx1 = (system length in x direction - 1)/mx + 1
+c my1 = (system length in y direction - 1)/my + 1
+c npbmx = size of buffer array ppbuff
+c ntmax = size of hole array for particles leaving tiles
+c irc = maximum overflow, returned only if error occurs, when irc > 0
+      implicit none
+      integer idimp, nppmx, nx, ny, mx, my, mx1, my1, npbmx, ntmax, irc
+      real ppart, ppbuff
+      integer kpic, ncl, ihole
+      dimension ppart(idimp,nppmx,mx1*my1), ppbuff(idimp,npbmx,mx1*my1)
+      dimension kpic(mx1*my1), ncl(8,mx1*my1)
+      dimension ihole(2,ntmax+1,mx1*my1)
+c local data
+      integer mxy1, noff, moff, npp, ncoff
+      integer i, j, k, ii, kx, ky, ih, nh, ist, nn, mm, isum
+      integer ip, j1, j2, kxl, kxr, kk, kl, kr
+      real anx, any, edgelx, edgely, edgerx, edgery, dx, dy
+      integer ks
+      dimension ks(8)
+      mxy1 = mx1*my1
+      anx = real(nx)
+      any = real(ny)
+c find and count particles leaving tiles and determine destination
+c update ppart, ihole, ncl
+c loop over tiles
+!$OMP PARALLEL DO
+!$OMP& PRIVATE(j,k,noff,moff,npp,nn,mm,ih,nh,ist,dx,dy,edgelx,edgely,
+!$OMP& edgerx,edgery)
+      do 30 k = 1, mxy1
+      noff = (k - 1)/mx1
+      moff = my*noff
+      noff = mx*(k - mx1*noff - 1)
+      npp = kpic(k)
+      nn = min(mx,nx-noff)
+      mm = min(my,ny-moff)
+      ih = 0
+      nh = 0
+      edgelx = noff
+      edgerx = noff + nn
+      edgely = moff
+      edgery = moff + mm
+c clear counters
+      do 10 j = 1, 8
+      ncl(j,k) = 0
+   10 continue
+c loop over particles in tile
+      do 20 j = 1, npp
+      dx = ppart(1,j,k)
+      dy = ppart(2,j,k)
+c find particles going out of bounds
+      ist = 0
+c count how many particles are going in each direction in ncl
+c save their address and destination in ihole
+c use periodic boundary conditions and check for roundoff error
+c ist = direction particle is going
+      if (dx.ge.edgerx) then
+         if (dx.ge.anx) ppart(1,j,k) = dx - anx
+         ist = 2
+      else if (dx.lt.edgelx) then
+         if (dx.lt.0.0) then
+            dx = dx + anx
+            if (dx.lt.anx) then
+               ist = 1
+            else
+               dx = 0.0
+            endif
+            ppart(1,j,k) = dx
+         else
+            ist = 1
+         endif
+      endif
+      if (dy.ge.edgery) then
+         if (dy.ge.any) ppart(2,j,k) = dy - any
+         ist = ist + 6
+      else if (dy.lt.edgely) then
+         if (dy.lt.0.0) then
+            dy = dy + any
+            if (dy.lt.any) then
+               ist = ist + 3
+            else
+               dy = 0.0
+            endif
+            ppart(2,j,k) = dy
+         else
+            ist = ist + 3
+         endif
+      endif
+      if (ist.gt.0) then
+         ncl(ist,k) = ncl(ist,k) + 1
+         ih = ih + 1
+         if (ih.le.ntmax) then
+            ihole(1,ih+1,k) = j
+            ihole(2,ih+1,k) = ist
+         else
+            nh = 1
+         endif
+      endif
+   20 continue
+c set error and end of file flag
+      if (nh.gt.0) then
+         irc = ih
+         ih = -ih
+      endif
+      ihole(1,1,k) = ih
+   30 continue
+!$OMP END PARALLEL DO
+c ihole overflow
+      if (irc.gt.0) return
+c
+c buffer particles that are leaving tile: update ppbuff, ncl
+c loop over tiles
+!$OMP PARALLEL DO
+!$OMP& PRIVATE(i,j,k,isum,ist,nh,ip,j1,ii)
+      do 70 k = 1, mxy1
+c find address offset for ordered ppbuff array
+      isum = 0
+      do 40 j = 1, 8
+      ist = ncl(j,k)
+      ncl(j,k) = isum
+      isum = isum + ist
+   40 continue
+      nh = ihole(1,1,k)
+      ip = 0
+c loop over particles leaving tile
+      do 60 j = 1, nh
+c buffer particles that are leaving tile, in direction order
+      j1 = ihole(1,j+1,k)
+      ist = ihole(2,j+1,k)
+      ii = ncl(ist,k) + 1
+      if (ii.le.npbmx) then
+         do 50 i = 1, idimp
+         ppbuff(i,ii,k) = ppart(i,j1,k)
+   50    continue
+      else
+         ip = 1
+      endif
+      ncl(ist,k) = ii
+   60 continue
+c set error
+      if (ip.gt.0) irc = ncl(8,k)
+   70 continue
+!$OMP END PARALLEL DO
+c ppbuff overflow
+      if (irc.gt.0) return
+c
+c copy incoming particles from buffer into ppart: update ppart, kpic
+c loop over tiles
+!$OMP PARALLEL DO
+!$OMP& PRIVATE(i,j,k,ii,kk,npp,kx,ky,kl,kr,kxl,kxr,ih,nh,ncoff,ist,j1,j2
+!$OMP& ,ip,ks)
+      do 130 k = 1, mxy1
+      npp = kpic(k)
+      ky = (k - 1)/mx1 + 1
+c loop over tiles in y, assume periodic boundary conditions
+      kk = (ky - 1)*mx1
+c find tile above
+      kl = ky - 1 
+      if (kl.lt.1) kl = kl + my1
+      kl = (kl - 1)*mx1
+c find tile below
+      kr = ky + 1
+      if (kr.gt.my1) kr = kr - my1
+      kr = (kr - 1)*mx1
+c loop over tiles in x, assume periodic boundary conditions
+      kx = k - (ky - 1)*mx1
+      kxl = kx - 1 
+      if (kxl.lt.1) kxl = kxl + mx1
+      kxr = kx + 1
+      if (kxr.gt.mx1) kxr = kxr - mx1
+c find tile number for different directions
+      ks(1) = kxr + kk
+      ks(2) = kxl + kk
+      ks(3) = kx + kr
+      ks(4) = kxr + kr
+      ks(5) = kxl + kr
+      ks(6) = kx + kl
+      ks(7) = kxr + kl
+      ks(8) = kxl + kl
+c loop over directions
+      nh = ihole(1,1,k)
+      ncoff = 0
+      ih = 0
+      ist = 0
+      j1 = 0
+      do 100 ii = 1, 8
+      if (ii.gt.1) ncoff = ncl(ii-1,ks(ii))
+c ip = number of particles coming from direction ii
+      ip = ncl(ii,ks(ii)) - ncoff
+      do 90 j = 1, ip
+      ih = ih + 1
+c insert incoming particles into holes
+      if (ih.le.nh) then
+         j1 = ihole(1,ih+1,k)
+c place overflow at end of array
+      else
+         j1 = npp + 1
+         npp = j1
+      endif
+      if (j1.le.nppmx) then
+         do 80 i = 1, idimp
+         ppart(i,j1,k) = ppbuff(i,j+ncoff,ks(ii))
+   80    continue
+      else
+         ist = 1
+      endif
+   90 continue
+  100 continue
+c set error
+      if (ist.gt.0) irc = j1
+c fill up remaining holes in particle array with particles from bottom
+      if (ih.lt.nh) then
+         ip = nh - ih
+         do 120 j = 1, ip
+         j1 = npp - j + 1
+         j2 = ihole(1,nh-j+2,k)
+         if (j1.gt.j2) then
+c move particle only if it is below current hole
+            do 110 i = 1, idimp
+            ppart(i,j2,k) = ppart(i,j1,k)
+  110       continue
+         endif
+  120    continue
+         npp = npp - ip
+      endif
+      kpic(k) = npp
+  130 continue
+!$OMP END PARALLEL DO
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPORDERF2L(ppart,ppbuff,kpic,ncl,ihole,idimp,nppmx,mx1,
+     1my1,npbmx,ntmax,irc)
+c this subroutine sorts particles by x,y grid in tiles of mx, my
+c linear interpolation, with periodic boundary conditions
+c tiles are assumed to be arranged in 2D linear memory.
+c the algorithm has 2 steps.  first, a prefix scan of ncl is performed
+c and departing particles are buffered in ppbuff in direction order.
+c then we copy the incoming particles from other tiles into ppart.
+c it assumes that the number, location, and destination of particles 
+c leaving a tile have been previously stored in ncl and ihole by the
+c GPPUSHF2L subroutine.
+c input: all except ppbuff, irc
+c output: ppart, ppbuff, kpic, ncl, irc
+c ppart(1,n,k) = position x of particle n in tile k
+c ppart(2,n,k) = position y of particle n in tile k
+c ppbuff(i,n,k) = i co-ordinate of particle n in tile k
+c kpic(k) = number of particles in tile k
+c ncl(i,k) = number of particles going to destination i, tile k
+c ihole(1,:,k) = location of hole in array left by departing particle
+c ihole(2,:,k) = direction destination of particle leaving hole
+c all for tile k
+c ihole(1,1,k) = ih, number of holes left (error, if negative)
+c idimp = size of phase space = 4
+c nppmx = maximum number of particles in tile
+c mx1 = (system length in x direction - 1)/mx + 1
+c my1 = (system length in y direction - 1)/my + 1
+c npbmx = size of buffer array ppbuff
+c ntmax = size of hole array for particles leaving tiles
+c irc = maximum overflow, returned only if error occurs, when irc > 0
+      implicit none
+      integer idimp, nppmx, mx1, my1, npbmx, ntmax, irc
+      real ppart, ppbuff
+      integer kpic, ncl, ihole
+      dimension ppart(idimp,nppmx,mx1*my1), ppbuff(idimp,npbmx,mx1*my1)
+      dimension kpic(mx1*my1), ncl(8,mx1*my1)
+      dimension ihole(2,ntmax+1,mx1*my1)
+c local data
+      integer mxy1, npp, ncoff
+      integer i, j, k, ii, kx, ky, ih, nh, ist, isum
+      integer ip, j1, j2, kxl, kxr, kk, kl, kr
+      integer ks
+      dimension ks(8)
+      mxy1 = mx1*my1
+c buffer particles that are leaving tile: update ppbuff, ncl
+c loop over tiles
+!$OMP PARALLEL DO
+!$OMP& PRIVATE(i,j,k,isum,ist,nh,ip,j1,ii)
+      do 40 k = 1, mxy1
+c find address offset for ordered ppbuff array
+      isum = 0
+      do 10 j = 1, 8
+      ist = ncl(j,k)
+      ncl(j,k) = isum
+      isum = isum + ist
+   10 continue
+      nh = ihole(1,1,k)
+      ip = 0
+c loop over particles leaving tile
+      do 30 j = 1, nh
+c buffer particles that are leaving tile, in direction order
+      j1 = ihole(1,j+1,k)
+      ist = ihole(2,j+1,k)
+      ii = ncl(ist,k) + 1
+      if (ii.le.npbmx) then
+         do 20 i = 1, idimp
+         ppbuff(i,ii,k) = ppart(i,j1,k)
+   20    continue
+      else
+         ip = 1
+      endif
+      ncl(ist,k) = ii
+   30 continue
+c set error
+      if (ip.gt.0) irc = ncl(8,k)
+   40 continue
+!$OMP END PARALLEL DO
+c ppbuff overflow
+      if (irc.gt.0) return
+c
+c copy incoming particles from buffer into ppart: update ppart, kpic
+c loop over tiles
+!$OMP PARALLEL DO
+!$OMP& PRIVATE(i,j,k,ii,kk,npp,kx,ky,kl,kr,kxl,kxr,ih,nh,ncoff,ist,j1,j2
+!$OMP& ,ip,ks)
+      do 100 k = 1, mxy1
+      npp = kpic(k)
+      ky = (k - 1)/mx1 + 1
+c loop over tiles in y, assume periodic boundary conditions
+      kk = (ky - 1)*mx1
+c find tile above
+      kl = ky - 1 
+      if (kl.lt.1) kl = kl + my1
+      kl = (kl - 1)*mx1
+c find tile below
+      kr = ky + 1
+      if (kr.gt.my1) kr = kr - my1
+      kr = (kr - 1)*mx1
+c loop over tiles in x, assume periodic boundary conditions
+      kx = k - (ky - 1)*mx1
+      kxl = kx - 1 
+      if (kxl.lt.1) kxl = kxl + mx1
+      kxr = kx + 1
+      if (kxr.gt.mx1) kxr = kxr - mx1
+c find tile number for different directions
+      ks(1) = kxr + kk
+      ks(2) = kxl + kk
+      ks(3) = kx + kr
+      ks(4) = kxr + kr
+      ks(5) = kxl + kr
+      ks(6) = kx + kl
+      ks(7) = kxr + kl
+      ks(8) = kxl + kl
+c loop over directions
+      nh = ihole(1,1,k)
+      ncoff = 0
+      ih = 0
+      ist = 0
+      j1 = 0
+      do 70 ii = 1, 8
+      if (ii.gt.1) ncoff = ncl(ii-1,ks(ii))
+c ip = number of particles coming from direction ii
+      ip = ncl(ii,ks(ii)) - ncoff
+      do 60 j = 1, ip
+      ih = ih + 1
+c insert incoming particles into holes
+      if (ih.le.nh) then
+         j1 = ihole(1,ih+1,k)
+c place overflow at end of array
+      else
+         j1 = npp + 1
+         npp = j1
+      endif
+      if (j1.le.nppmx) then
+         do 50 i = 1, idimp
+         ppart(i,j1,k) = ppbuff(i,j+ncoff,ks(ii))
+   50    continue
+      else
+         ist = 1
+      endif
+   60 continue
+   70 continue
+c set error
+      if (ist.gt.0) irc = j1
+c fill up remaining holes in particle array with particles from bottom
+      if (ih.lt.nh) then
+         ip = nh - ih
+         do 90 j = 1, ip
+         j1 = npp - j + 1
+         j2 = ihole(1,nh-j+2,k)
+         if (j1.gt.j2) then
+c move particle only if it is below current hole
+            do 80 i = 1, idimp
+            ppart(i,j2,k) = ppart(i,j1,k)
+   80       continue
+         endif
+   90    continue
+         npp = npp - ip
+      endif
+      kpic(k) = npp
+  100 continue
+!$OMP END PARALLEL DO
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPSIZEF2L(kpic,ncl,nppmx,nbmx,mx1,my1)
+c this subroutine finds the maximum number of particles in each tile
+c and the maximum number of particles leaving any tile which would
+c result from reordering particles with PPORDERF2L.
+c it assumes that the number of particles leaving a tile in each
+c direction has been previously stored in ncl by the GPPUSHF2L
+c subroutine.  it can be used to enlarge the arrays ppart, ppbuff and
+c ihole before they overflow.
+c input: all except nppmx, nbmx, output: nppmx, nbmx
+c kpic(k) = number of particles in tile k
+c ncl(i,k) = number of particles going to destination i, tile k
+c nppmx = return maximum number of particles in tile after reordering
+c nbmx = return maximum number of particles leaving tile
+c mx1 = (system length in x direction - 1)/mx + 1
+c my1 = (system length in y direction - 1)/my + 1
+      implicit none
+      integer nppmx, nbmx, mx1, my1
+      integer kpic, ncl
+      dimension kpic(mx1*my1), ncl(8,mx1*my1)
+c local data
+      integer mxy1, npp, nps, nbs
+      integer j, k, ii, kx, ky, kxl, kxr, kk, kl, kr
+      integer ks
+      dimension ks(8)
+      mxy1 = mx1*my1
+      nppmx = 0
+      nbmx = 0
+c loop over tiles
+      do 30 k = 1, mxy1
+      ky = (k - 1)/mx1 + 1
+c loop over tiles in y, assume periodic boundary conditions
+      kk = (ky - 1)*mx1
+c find tile above
+      kl = ky - 1 
+      if (kl.lt.1) kl = kl + my1
+      kl = (kl - 1)*mx1
+c find tile below
+      kr = ky + 1
+      if (kr.gt.my1) kr = kr - my1
+      kr = (kr - 1)*mx1
+c loop over tiles in x, assume periodic boundary conditions
+      kx = k - (ky - 1)*mx1
+      kxl = kx - 1 
+      if (kxl.lt.1) kxl = kxl + mx1
+      kxr = kx + 1
+      if (kxr.gt.mx1) kxr = kxr - mx1
+c find tile number for different directions
+      ks(1) = kxr + kk
+      ks(2) = kxl + kk
+      ks(3) = kx + kr
+      ks(4) = kxr + kr
+      ks(5) = kxl + kr
+      ks(6) = kx + kl
+      ks(7) = kxr + kl
+      ks(8) = kxl + kl
+c count particles leaving tile
+      nbs = 0
+      do 10 j = 1, 8
+      nbs = nbs + ncl(j,k)
+   10 continue
+c count particles arriving from each direction
+      nps = 0
+      do 20 ii = 1, 8
+      nps = nps + ncl(ii,ks(ii))
+   20 continue
+      npp = kpic(k) + nps - nbs
+      nppmx = max(nppmx,npp)
+      nbmx = max(nbmx,nbs)
+   30 continue
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPGROW2L(ppart,kpic,idimp,nppmx,nppmxn,mxy1)
+c this subroutine changes the maximum number of particles in each tile
+c of the segmented particle array ppart from nppmx to nppmxn, moving
+c the particles in place.  the array ppart must already have been
+c reallocated to hold idimp*nppmxn*mxy1 elements.
+c tiles are moved in reverse order, so that no data is overwritten
+c input: all, output: ppart
+c ppart(i,n,k) = i co-ordinate of particle n in tile k
+c kpic(k) = number of particles in tile k
+c idimp = size of phase space = 4
+c nppmx = old maximum number of particles in tile
+c nppmxn = new maximum number of particles in tile, must be >= nppmx
+c mxy1 = mx1*my1, where my1 = (system length in y direction - 1)/my + 1
+      implicit none
+      integer idimp, nppmx, nppmxn, mxy1
+      real ppart
+      integer kpic
+      dimension ppart(idimp*nppmxn*mxy1), kpic(mxy1)
+c local data
+      integer j, k, npp
+      if (nppmxn.le.nppmx) return
+      do 20 k = mxy1, 2, -1
+      npp = min(kpic(k),nppmx)
+      do 10 j = idimp*npp, 1, -1
+      ppart(j+idimp*nppmxn*(k-1)) = ppart(j+idimp*nppmx*(k-1))
+   10 continue
+   20 continue
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPHOLE2L(ppart,kpic,ncl,ihole,idimp,nppmx,mx,my,mx1,my1
+     1,ntmax,irc)
+c this subroutine finds the list of particles leaving tiles of mx, my
+c after the co-ordinates have been updated and periodic boundary
+c conditions applied, for example by GPPUSHF2L.  the destination is
+c found from the tile containing the new position.
+c it is used to recalculate ncl and ihole after ihole has overflowed
+c in GPPUSHF2L and has been enlarged.
+c input: all except ncl, ihole, irc
+c output: ncl, ihole, irc
+c ppart(1,n,k) = position x of particle n in tile k
+c ppart(2,n,k) = position y of particle n in tile k
+c kpic(k) = number of particles in tile k
+c ncl(i,k) = number of particles going to destination i, tile k
+c ihole(1,:,k) = location of hole in array left by departing particle
+c ihole(2,:,k) = direction destination of particle leaving hole
+c all for tile k
+c ihole(1,1,k) = ih, number of holes left (error, if negative)
+c idimp = size of phase space = 4
+c nppmx = maximum number of particles in tile
+c mx/my = number of grids in sorting cell in x/y
+c mx1 = (system length in x direction - 1)/mx + 1
+c my1 = (system length in y direction - 1)/my + 1
+c ntmax = size of hole array for particles leaving tiles
+c irc = maximum overflow, returned only if error occurs, when irc > 0
+      implicit none
+      integer idimp, nppmx, mx, my, mx1, my1, ntmax, irc
+      real ppart
+      integer kpic, ncl, ihole
+      dimension ppart(idimp,nppmx,mx1*my1)
+      dimension kpic(mx1*my1), ncl(8,mx1*my1)
+      dimension ihole(2,ntmax+1,mx1*my1)
+c local data
+      integer mxy1, npp, j, k, kx, ky, ih, nh, ist, nn, mm
+      mxy1 = mx1*my1
+c loop over tiles
+!$OMP PARALLEL DO
+!$OMP& PRIVATE(j,k,kx,ky,npp,nn,mm,ih,nh,ist)
+      do 30 k = 1, mxy1
+      ky = (k - 1)/mx1
+      kx = k - mx1*ky - 1
+      npp = kpic(k)
+      ih = 0
+      nh = 0
+c clear counters
+      do 10 j = 1, 8
+      ncl(j,k) = 0
+   10 continue
+c loop over particles in tile
+      do 20 j = 1, npp
+      nn = ppart(1,j,k)
+      mm = ppart(2,j,k)
+      nn = nn/mx - kx
+      mm = mm/my - ky
+c ist = direction particle is going, allowing for periodic tiles
+      ist = 0
+      if ((nn.eq.1).or.(nn.eq.(1-mx1))) then
+         ist = 2
+      else if (nn.ne.0) then
+         ist = 1
+      endif
+      if ((mm.eq.1).or.(mm.eq.(1-my1))) then
+         ist = ist + 6
+      else if (mm.ne.0) then
+         ist = ist + 3
+      endif
+      if (ist.gt.0) then
+         ncl(ist,k) = ncl(ist,k) + 1
+         ih = ih + 1
+         if (ih.le.ntmax) then
+            ihole(1,ih+1,k) = j
+            ihole(2,ih+1,k) = ist
+         else
+            nh = 1
+         endif
+      endif
+   20 continue
+c set error and end of file flag
+      if (nh.gt.0) then
+         irc = ih
+         ih = -ih
+      endif
+      ihole(1,1,k) = ih
+   30 continue
+!$OMP END PARALLEL DO
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPMOVIN2LT(part,ppart,kpic,nppmx,idimp,nop,mx,my,mx1,  
+     1mxy1,irc)
+c this subroutine sorts particles by x,y grid in tiles of mx, my
+c and copies to segmented array ppart
+c linear interpolation
+c input: all except ppart, kpic, output: ppart, kpic
+c part/ppart = input/output particle arrays
+c part(1,n) = position x of particle n
+c part(2,n) = position y of particle n
+c kpic = output number of particles per tile
+c nppmx = rmaximum number of particles in tile
+c idimp = size of phase space = 4
+c nop = number of particles
+c mx/my = number of grids in sorting cell in x and y
+c mx1 = (system length in x direction - 1)/mx + 1
+c mxy1 = mx1*my1, where my1 = (system length in y direction - 1)/my + 1
+c irc = maximum overflow, returned only if error occurs, when irc > 0
+      implicit none
+      integer kpic, nppmx, idimp, nop, mx, my, mx1, mxy1, irc
+      real part, ppart
+      dimension part(idimp,nop), ppart(nppmx,idimp,mxy1)
+      dimension kpic(mxy1)
+c local data
+      integer i, j, k, n, m, ip, ierr
+      ierr = 0
+c clear counter array
+      do 10 k = 1, mxy1
+      kpic(k) = 0
+   10 continue
+c find addresses of particles at each tile and reorder particles
+      do 30 j = 1, nop
+      n = part(1,j)
+      n = n/mx + 1
+      m = part(2,j)
+      m = m/my
+      m = n + mx1*m
+      ip = kpic(m) + 1
+      if (ip.le.nppmx) then
+         do 20 i = 1, idimp
+         ppart(ip,i,m) = part(i,j)
+   20    continue
+      else
+         ierr = max(ierr,ip-nppmx)
+      endif
+      kpic(m) = ip
+   30 continue
+      if (ierr.gt.0) irc = ierr
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPCHECK2LT(ppart,kpic,idimp,nppmx,nx,ny,mx,my,mx1,my1, 
+     1irc)
+c this subroutine performs a sanity check to make sure particles sorted
+c by x,y grid in tiles of mx, my, are all within bounds.
+c tiles are assumed to be arranged in 2D linear memory, and transposed
+c input: all except irc
+c output: irc
+c ppart(n,1,k) = position x of particle n in tile k
+c ppart(n,2,k) = position y of particle n in tile k
+c kpic(k) = number of reordered output particles in tile k
+c idimp = size of phase space = 4
+c nppmx = maximum number of particles in tile
+c nx/ny = system length in x/y direction
+c mx/my = number of grids in sorting cell in x/y
+c mx1 = (system length in x direction - 1)/mx + 1
+c my1 = (system length in y direction - 1)/my + 1
+c irc = particle error, returned only if error occurs, when irc > 0
+      implicit none
+      integer idimp, nppmx, nx, ny, mx, my, mx1, my1, irc
+      real ppart
+      integer kpic
+      dimension ppart(nppmx,idimp,mx1*my1)
+      dimension kpic(mx1*my1)
+c local data
+      integer mxy1, noff, moff, npp, j, k, ist, nn, mm
+      real edgelx, edgely, edgerx, edgery, dx, dy
+      mxy1 = mx1*my1
+c loop over tiles
+!$OMP PARALLEL DO
+!$OMP& PRIVATE(j,k,noff,moff,npp,nn,mm,ist,edgelx,edgely,edgerx,edgery, 
+!$OMP& dx,dy)
+      do 20 k = 1, mxy1
+      noff = (k - 1)/mx1
+      moff = my*noff
+      noff = mx*(k - mx1*noff - 1)
+      npp = kpic(k)
+      nn = min(mx,nx-noff)
+      mm = min(my,ny-moff)
+      edgelx = noff
+      edgerx = noff + nn
+      edgely = moff
+      edgery = moff + mm
+c loop over particles in tile
+      do 10 j = 1, npp
+      dx = ppart(j,1,k)
+      dy = ppart(j,2,k)
+c find particles going out of bounds
+      ist = 0
+      if (dx.lt.edgelx) ist = 1
+      if (dx.ge.edgerx) ist = 2
+      if (dy.lt.edgely) ist = ist + 3
+      if (dy.ge.edgery) ist = ist + 6
+      if (ist.gt.0) irc = k
+   10 continue
+   20 continue
+!$OMP END PARALLEL DO
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine GPPUSH2LT(ppart,fxy,kpic,qbm,dt,ek,idimp,nppmx,nx,ny,mx
+     1,my,nxv,nyv,mx1,mxy1,ipbc)
+c for 2d code, this subroutine updates particle co-ordinates and
+c velocities using leap-frog scheme in time and first-order linear
+c interpolation in space, with various boundary conditions.
+c OpenMP version using guard cells
+c data read in tiles
+c particles stored segmented array
+c 44 flops/particle, 12 loads, 4 stores
+c input: all, output: ppart, ek
+c equations used are:
+c vx(t+dt/2) = vx(t-dt/2) + (q/m)*fx(x(t),y(t))*dt,
+c vy(t+dt/2) = vy(t-dt/2) + (q/m)*fy(x(t),y(t))*dt,
+c where q/m is charge/mass, and
+c x(t+dt) = x(t) + vx(t+dt/2)*dt, y(t+dt) = y(t) + vy(t+dt/2)*dt
+c fx(x(t),y(t)) and fy(x(t),y(t)) are approximated by interpolation from
+c the nearest grid points:
+c fx(x,y) = (1-dy)*((1-dx)*fx(n,m)+dx*fx(n+1,m)) + dy*((1-dx)*fx(n,m+1)
+c    + dx*fx(n+1,m+1))
+c fy(x,y) = (1-dy)*((1-dx)*fy(n,m)+dx*fy(n+1,m)) + dy*((1-dx)*fy(n,m+1)
+c    + dx*fy(n+1,m+1))
+c where n,m = leftmost grid points and dx = x-n, dy = y-m
+c ppart(n,1,m) = position x of particle n in tile m
+c ppart(n,2,m) = position y of particle n in tile m
+c ppart(n,3,m) = velocity vx of particle n in tile m
+c ppart(n,4,m) = velocity vy of particle n in tile m
+c fxy(1,j,k) = x component of force/charge at grid (j,k)
+c fxy(2,j,k) = y component of force/charge at grid (j,k)
+c that is, convolution of electric field over particle shape
+c kpic = number of particles per tile
+c qbm = particle charge/mass
+c dt = time interval between successive calculations
+c kinetic energy/mass at time t is also calculated, using
+c ek = .125*sum((vx(t+dt/2)+vx(t-dt/2))**2+(vy(t+dt/2)+vy(t-dt/2))**2)
+c idimp = size of phase space = 4
+c nppmx = maximum number of particles in tile
+c nx/ny = system length in x/y direction
+c mx/my = number of grids in sorting cell in x/y
+c nxv = second dimension of field arrays, must be >= nx+1
+c nyv = third dimension of field arrays, must be >= ny+1
+c mx1 = (system length in x direction - 1)/mx + 1
+c mxy1 = mx1*my1, where my1 = (system length in y direction - 1)/my + 1
+c ipbc = particle boundary condition = (0,1,2,3) =
+c (none,2d periodic,2d reflecting,mixed reflecting/periodic)
+      implicit none
+      integer idimp, nppmx, nx, ny, mx, my, nxv, nyv, mx1, mxy1, ipbc
+      real qbm, dt, ek
+      real ppart, fxy
+      integer kpic
+      dimension ppart(nppmx,idimp,mxy1), fxy(2,nxv*nyv)
+      dimension kpic(mxy1)
+c local data
+      integer noff, moff, npp
+      integer i, j, k, nn, mm, lxv
+      real qtm, edgelx, edgely, edgerx, edgery, dxp, dyp, amx, amy
+      real x, y, dx, dy, vx, vy
+      real sfxy
+      dimension sfxy(2,(mx+1)*(my+1))
+      double precision sum1, sum2
+      lxv = mx + 1
+      qtm = qbm*dt
+      sum2 = 0.0d0
+c set boundary values
+      edgelx = 0.0
+      edgely = 0.0
+      edgerx = real(nx)
+      edgery = real(ny)
+      if (ipbc.eq.2) then
+         edgelx = 1.0
+         edgely = 1.0
+         edgerx = real(nx-1)
+         edgery = real(ny-1)
+      else if (ipbc.eq.3) then
+         edgelx = 1.0
+         edgerx = real(nx-1)
+      endif
+c loop over tiles
+!$OMP PARALLEL DO
+!$OMP& PRIVATE(i,j,k,noff,moff,npp,nn,mm,x,y,dxp,dyp,amx,amy,dx,dy,vx,vy
+!$OMP& ,sum1,sfxy)
+!$OMP& REDUCTION(+:sum2)
+      do 40 k = 1, mxy1
+      noff = (k - 1)/mx1
+      moff = my*noff
+      noff = mx*(k - mx1*noff - 1)
+      npp = kpic(k)
+c load local fields from global array
+      do 20 j = 1, min(my,ny-moff)+1
+      do 10 i = 1, min(mx,nx-noff)+1
+      sfxy(1,i+lxv*(j-1)) = fxy(1,i+noff+nxv*(j+moff-1))
+      sfxy(2,i+lxv*(j-1)) = fxy(2,i+noff+nxv*(j+moff-1))
+   10 continue
+   20 continue
+      sum1 = 0.0d0
+c loop over particles in tile
+      do 30 j = 1, npp
+c find interpolation weights
+      x = ppart(j,1,k)
+      y = ppart(j,2,k)
+      nn = x
+      mm = y
+      dxp = x - real(nn)
+      dyp = y - real(mm)
+      nn = nn - noff + 1 + lxv*(mm - moff)
+      amx = 1.0 - dxp
+      amy = 1.0 - dyp
+c find acceleration
+      dx = amx*sfxy(1,nn)
+      dy = amx*sfxy(2,nn)
+      dx = amy*(dxp*sfxy(1,nn+1) + dx)
+      dy = amy*(dxp*sfxy(2,nn+1) + dy)
+      vx = amx*sfxy(1,nn+lxv)
+      vy = amx*sfxy(2,nn+lxv)
+      dx = dx + dyp*(dxp*sfxy(1,nn+1+lxv) + vx) 
+      dy = dy + dyp*(dxp*sfxy(2,nn+1+lxv) + vy)
+c new velocity
+      dxp = ppart(j,3,k)
+      dyp = ppart(j,4,k)
+      vx = dxp + qtm*dx
+      vy = dyp + qtm*dy
+c average kinetic energy
+      dxp = dxp + vx
+      dyp = dyp + vy
+      sum1 = sum1 + (dxp*dxp + dyp*dyp)
+c new position
+      dx = x + vx*dt
+      dy = y + vy*dt
+c reflecting boundary conditions
+      if (ipbc.eq.2) then
+         if ((dx.lt.edgelx).or.(dx.ge.edgerx)) then
+            dx = x
+            vx = -vx
+         endif
+         if ((dy.lt.edgely).or.(dy.ge.edgery)) then
+            dy = y
+            vy = -vy
+         endif
+c mixed reflecting/periodic boundary conditions
+      else if (ipbc.eq.3) then
+         if ((dx.lt.edgelx).or.(dx.ge.edgerx)) then
+            dx = x
+            vx = -vx
+         endif
+      endif
+c set new position
+      ppart(j,1,k) = dx
+      ppart(j,2,k) = dy
+c set new velocity
+      ppart(j,3,k) = vx
+      ppart(j,4,k) = vy
+   30 continue
+      sum2 = sum2 + sum1
+   40 continue
+!$OMP END PARALLEL DO
+c normalize kinetic energy
+      ek = ek + 0.125*sum2
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine GPPUSHF2LT(ppart,fxy,kpic,ncl,ihole,qbm,dt,ek,idimp,   
+     1nppmx,nx,ny,mx,my,nxv,nyv,mx1,mxy1,ntmax,irc)
+c for 2d code, this subroutine updates particle co-ordinates and
+c velocities using leap-frog scheme in time and first-order linear
+c interpolation in space, with periodic boundary conditions.
+c also determines list of particles which are leaving this tile
+c OpenMP version using guard cells
+c data read in tiles
+c particles stored segmented array
+c 44 flops/particle, 12 loads, 4 stores
+c input: all except ncl, ihole, irc, output: ppart, ncl, ihole, ek, irc
+c equations used are:
+c vx(t+dt/2) = vx(t-dt/2) + (q/m)*fx(x(t),y(t))*dt,
+c vy(t+dt/2) = vy(t-dt/2) + (q/m)*fy(x(t),y(t))*dt,
+c where q/m is charge/mass, and
+c x(t+dt) = x(t) + vx(t+dt/2)*dt, y(t+dt) = y(t) + vy(t+dt/2)*dt
+c fx(x(t),y(t)) and fy(x(t),y(t)) are approximated by interpolation from
+c the nearest grid points:
+c fx(x,y) = (1-dy)*((1-dx)*fx(n,m)+dx*fx(n+1,m)) + dy*((1-dx)*fx(n,m+1)
+c    + dx*fx(n+1,m+1))
+c fy(x,y) = (1-dy)*((1-dx)*fy(n,m)+dx*fy(n+1,m)) + dy*((1-dx)*fy(n,m+1)
+c    + dx*fy(n+1,m+1))
+c where n,m = leftmost grid points and dx = x-n, dy = y-m
+c ppart(n,1,m) = position x of particle n in tile m
+c ppart(n,2,m) = position y of particle n in tile m
+c ppart(n,3,m) = velocity vx of particle n in tile m
+c ppart(n,4,m) = velocity vy of particle n in tile m
+c fxy(1,j,k) = x component of force/charge at grid (j,k)
+c fxy(2,j,k) = y component of force/charge at grid (j,k)
+c that is, convolution of electric field over particle shape
+c kpic(k) = number of particles in tile k
+c ncl(i,k) = number of particles going to destination i, tile k
+c ihole(1,:,k) = location of hole in array left by departing particle
+c ihole(2,:,k) = destination of particle leaving hole
+c ihole(1,1,k) = ih, number of holes left (error, if negative)
+c qbm = particle charge/mass
+c dt = time interval between successive calculations
+c kinetic energy/mass at time t is also calculated, using
+c ek = .125*sum((vx(t+dt/2)+vx(t-dt/2))**2+(vy(t+dt/2)+vy(t-dt/2))**2)
+c idimp = size of phase space = 4
+c nppmx = maximum number of particles in tile
+c nx/ny = system length in x/y direction
+c mx/my = number of grids in sorting cell in x/y
+c nxv = second dimension of field arrays, must be >= nx+1
+c nyv = third dimension of field arrays, must be >= ny+1
+c mx1 = (system length in x direction - 1)/mx + 1
+c mxy1 = mx1*my1, where my1 = (system length in y direction - 1)/my + 1
+c ntmax = size of hole array for particles leaving tiles
+c irc = maximum overflow, returned only if error occurs, when irc > 0
+c optimized version
+      implicit none
+      integer idimp, nppmx, nx, ny, mx, my, nxv, nyv, mx1, mxy1, ntmax
+      integer irc
+      real qbm, dt, ek
+      real ppart, fxy
+      integer kpic, ncl, ihole
+      dimension ppart(nppmx,idimp,mxy1), fxy(2,nxv*nyv)
+      dimension kpic(mxy1), ncl(8,mxy1)
+      dimension ihole(2,ntmax+1,mxy1)
+c local data
+      integer noff, moff, npp
+      integer i, j, k, ih, nh, nn, mm, lxv
+      real qtm, dxp, dyp, amx, amy
+      real x, y, dx, dy, vx, vy
+      real anx, any, edgelx, edgely, edgerx, edgery
+      real sfxy
+      dimension sfxy(2,(mx+1)*(my+1))
+      double precision sum1, sum2
+      lxv = mx + 1
+      qtm = qbm*dt
+      anx = real(nx)
+      any = real(ny)
+      sum2 = 0.0d0
+c loop over tiles
+!$OMP PARALLEL DO
+!$OMP& PRIVATE(i,j,k,noff,moff,npp,nn,mm,ih,nh,x,y,dxp,dyp,amx,amy,dx,dy
+!$OMP& ,vx,vy,edgelx,edgely,edgerx,edgery,sum1,sfxy)
+!$OMP& REDUCTION(+:sum2)
+      do 50 k = 1, mxy1
+      noff = (k - 1)/mx1
+      moff = my*noff
+      noff = mx*(k - mx1*noff - 1)
+      npp = kpic(k)
+      nn = min(mx,nx-noff)
+      mm = min(my,ny-moff)
+      edgelx = noff
+      edgerx = noff + nn
+      edgely = moff
+      edgery = moff + mm
+      ih = 0
+      nh = 0
+c load local fields from global array
+      do 20 j = 1, mm+1
+      do 10 i = 1, nn+1
+      sfxy(1,i+lxv*(j-1)) = fxy(1,i+noff+nxv*(j+moff-1))
+      sfxy(2,i+lxv*(j-1)) = fxy(2,i+noff+nxv*(j+moff-1))
+   10 continue
+   20 continue
+c clear counters
+      do 30 j = 1, 8
+      ncl(j,k) = 0
+   30 continue
+      sum1 = 0.0d0
+c loop over particles in tile
+      do 40 j = 1, npp
+c find interpolation weights
+      x = ppart(j,1,k)
+      y = ppart(j,2,k)
+      nn = x
+      mm = y
+      dxp = x - real(nn)
+      dyp = y - real(mm)
+      nn = nn - noff + 1 + lxv*(mm - moff)
+      amx = 1.0 - dxp
+      amy = 1.0 - dyp
+c find acceleration
+      dx = amx*sfxy(1,nn)
+      dy = amx*sfxy(2,nn)
+      dx = amy*(dxp*sfxy(1,nn+1) + dx)
+      dy = amy*(dxp*sfxy(2,nn+1) + dy)
+      vx = amx*sfxy(1,nn+lxv)
+      vy = amx*sfxy(2,nn+lxv)
+      dx = dx + dyp*(dxp*sfxy(1,nn+1+lxv) + vx) 
+      dy = dy + dyp*(dxp*sfxy(2,nn+1+lxv) + vy)
+c new velocity
+      dxp = ppart(j,3,k)
+      dyp = ppart(j,4,k)
+      vx = dxp + qtm*dx
+      vy = dyp + qtm*dy
+c average kinetic energy
+      dxp = dxp + vx
+      dyp = dyp + vy
+      sum1 = sum1 + (dxp*dxp + dyp*dyp)
+c new position
+      dx = x + vx*dt
+      dy = y + vy*dt
+c find particles going out of bounds
+      mm = 0
+c count how many particles are going in each direction in ncl
+c save their address and destination in ihole
+c use periodic boundary conditions and check for roundoff error
+c mm = direction particle is going
+      if (dx.ge.edgerx) then
+         if (dx.ge.anx) dx = dx - anx
+         mm = 2
+      else if (dx.lt.edgelx) then
+         if (dx.lt.0.0) then
+            dx = dx + anx
+            if (dx.lt.anx) then
+               mm = 1
+            else
+               dx = 0.0
+            endif
+         else
+            mm = 1
+         endif
+      endif
+      if (dy.ge.edgery) then
+         if (dy.ge.any) dy = dy - any
+         mm = mm + 6
+      else if (dy.lt.edgely) then
+         if (dy.lt.0.0) then
+            dy = dy + any
+            if (dy.lt.any) then
+               mm = mm + 3
+            else
+               dy = 0.0
+            endif
+         else
+            mm = mm + 3
+         endif
+      endif
+c set new position
+      ppart(j,1,k) = dx
+      ppart(j,2,k) = dy
+c set new velocity
+      ppart(j,3,k) = vx
+      ppart(j,4,k) = vy
+c increment counters
+      if (mm.gt.0) then
+         ncl(mm,k) = ncl(mm,k) + 1
+         ih = ih + 1
+         if (ih.le.ntmax) then
+            ihole(1,ih+1,k) = j
+            ihole(2,ih+1,k) = mm
+         else
+            nh = 1
+         endif
+      endif
+   40 continue
+      sum2 = sum2 + sum1
+c set error and end of file flag
+c ihole overflow
+      if (nh.gt.0) then
+         irc = ih
+         ih = -ih
+      endif
+      ihole(1,1,k) = ih
+   50 continue
+!$OMP END PARALLEL DO
+c normalize kinetic energy
+      ek = ek + 0.125*sum2
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine VGPPUSH2LT(ppart,fxy,kpic,qbm,dt,ek,idimp,nppmx,nx,ny, 
+     1mx,my,nxv,nyv,mx1,mxy1,ipbc)
+c for 2d code, this subroutine updates particle co-ordinates and
+c velocities using leap-frog scheme in time and first-order linear
+c interpolation in space, with various boundary conditions.
+c vectorizable/OpenMP version using guard cells
+c data read in tiles
+c particles stored segmented array
+c 44 flops/particle, 12 loads, 4 stores
+c input: all, output: ppart, ek
+c equations used are:
+c vx(t+dt/2) = vx(t-dt/2) + (q/m)*fx(x(t),y(t))*dt,
+c vy(t+dt/2) = vy(t-dt/2) + (q/m)*fy(x(t),y(t))*dt,
+c where q/m is charge/mass, and
+c x(t+dt) = x(t) + vx(t+dt/2)*dt, y(t+dt) = y(t) + vy(t+dt/2)*dt
+c fx(x(t),y(t)) and fy(x(t),y(t)) are approximated by interpolation from
+c the nearest grid points:
+c fx(x,y) = (1-dy)*((1-dx)*fx(n,m)+dx*fx(n+1,m)) + dy*((1-dx)*fx(n,m+1)
+c    + dx*fx(n+1,m+1))
+c fy(x,y) = (1-dy)*((1-dx)*fy(n,m)+dx*fy(n+1,m)) + dy*((1-dx)*fy(n,m+1)
+c    + dx*fy(n+1,m+1))
+c where n,m = leftmost grid points and dx = x-n, dy = y-m
+c ppart(n,1,m) = position x of particle n in tile m
+c ppart(n,2,m) = position y of particle n in tile m
+c ppart(n,3,m) = velocity vx of particle n in tile m
+c ppart(n,4,m) = velocity vy of particle n in tile m
+c fxy(1,j,k) = x component of force/charge at grid (j,k)
+c fxy(2,j,k) = y component of force/charge at grid (j,k)
+c that is, convolution of electric field over particle shape
+c kpic = number of particles per tile
+c qbm = particle charge/mass
+c dt = time interval between successive calculations
+c kinetic energy/mass at time t is also calculated, using
+c ek = .125*sum((vx(t+dt/2)+vx(t-dt/2))**2+(vy(t+dt/2)+vy(t-dt/2))**2)
+c idimp = size of phase space = 4
+c nppmx = maximum number of particles in tile
+c nx/ny = system length in x/y direction
+c mx/my = number of grids in sorting cell in x/y
+c nxv = second dimension of field arrays, must be >= nx+1
+c nyv = third dimension of field arrays, must be >= ny+1
+c mx1 = (system length in x direction - 1)/mx + 1
+c mxy1 = mx1*my1, where my1 = (system length in y direction - 1)/my + 1
+c ipbc = particle boundary condition = (0,1,2,3) =
+c (none,2d periodic,2d reflecting,mixed reflecting/periodic)
+      implicit none
+      integer idimp, nppmx, nx, ny, mx, my, nxv, nyv, mx1, mxy1, ipbc
+      real qbm, dt, ek
+      real ppart, fxy
+      integer kpic
+      dimension ppart(nppmx,idimp,mxy1), fxy(2,nxv*nyv)
+      dimension kpic(mxy1)
+c local data
+      integer npblk, lvect
+      parameter(npblk=32,lvect=4)
+      integer noff, moff, npp, ipp, joff, nps
+      integer i, j, k, m, nn, mm, lxv
+      real qtm, edgelx, edgely, edgerx, edgery, dxp, dyp, amx, amy
+      real x, y, dx, dy, vx, vy
+      real sfxy
+      dimension sfxy(2,(mx+1)*(my+1))
+c scratch arrays
+      integer n
+      real s, t
+      dimension n(npblk), s(npblk,lvect), t(npblk,2)
+      double precision sum1, sum2
+      lxv = mx + 1
+      qtm = qbm*dt
+      sum2 = 0.0d0
+c set boundary values
+      edgelx = 0.0
+      edgely = 0.0
+      edgerx = real(nx)
+      edgery = real(ny)
+      if (ipbc.eq.2) then
+         edgelx = 1.0
+         edgely = 1.0
+         edgerx = real(nx-1)
+         edgery = real(ny-1)
+      else if (ipbc.eq.3) then
+         edgelx = 1.0
+         edgerx = real(nx-1)
+      endif
+c loop over tiles
+!$OMP PARALLEL DO
+!$OMP& PRIVATE(i,j,k,m,noff,moff,npp,ipp,joff,nps,nn,mm,x,y,dxp,dyp,amx,
+!$OMP& amy,dx,dy,vx,vy,sum1,sfxy,n,s,t)
+!$OMP& REDUCTION(+:sum2)
+      do 100 k = 1, mxy1
+      noff = (k - 1)/mx1
+      moff = my*noff
+      noff = mx*(k - mx1*noff - 1)
+      npp = kpic(k)
+c load local fields from global array
+      do 20 j = 1, min(my,ny-moff)+1
+      do 10 i = 1, min(mx,nx-noff)+1
+      sfxy(1,i+lxv*(j-1)) = fxy(1,i+noff+nxv*(j+moff-1))
+      sfxy(2,i+lxv*(j-1)) = fxy(2,i+noff+nxv*(j+moff-1))
+   10 continue
+   20 continue
+      sum1 = 0.0d0
+c loop over particles in tile
+      ipp = npp/npblk
+c outer loop over number of full blocks
+      do 80 m = 1, ipp
+      joff = npblk*(m - 1)
+c inner loop over particles in block
+      do 30 j = 1, npblk
+c find interpolation weights
+      x = ppart(j+joff,1,k)
+      y = ppart(j+joff,2,k)
+      nn = x
+      mm = y
+      dxp = x - real(nn)
+      dyp = y - real(mm)
+      n(j) = nn - noff + lxv*(mm - moff)
+      amx = 1.0 - dxp
+      amy = 1.0 - dyp
+      s(j,1) = amx*amy
+      s(j,2) = dxp*amy
+      s(j,3) = amx*dyp
+      s(j,4) = dxp*dyp
+      t(j,1) = x
+      t(j,2) = y
+   30 continue
+c find acceleration
+      do 50 j = 1, npblk
+      nn = n(j)
+      mm = nn + lxv - 2
+      dx = 0.0
+      dy = 0.0
+!dir$ ivdep
+      do 40 i = 1, lvect
+      if (i.gt.2) nn = mm
+      dx = dx + sfxy(1,i+nn)*s(j,i)
+      dy = dy + sfxy(2,i+nn)*s(j,i)
+   40 continue
+      s(j,1) = dx
+      s(j,2) = dy
+   50 continue
+c new velocity
+      do 60 j = 1, npblk
+      x = t(j,1)
+      y = t(j,2)
+      dxp = ppart(j+joff,3,k)
+      dyp = ppart(j+joff,4,k)
+      vx = dxp + qtm*s(j,1)
+      vy = dyp + qtm*s(j,2)
+c average kinetic energy
+      dxp = dxp + vx
+      dyp = dyp + vy
+      sum1 = sum1 + (dxp*dxp + dyp*dyp)
+c new position
+      s(j,1) = x + vx*dt
+      s(j,2) = y + vy*dt
+      s(j,3) = vx
+      s(j,4) = vy
+   60 continue
+c check boundary conditions
+!dir$ novector
+      do 70 j = 1, npblk
+      dx = s(j,1)
+      dy = s(j,2)
+      vx = s(j,3)
+      vy = s(j,4)
+c reflecting boundary conditions
+      if (ipbc.eq.2) then
+         if ((dx.lt.edgelx).or.(dx.ge.edgerx)) then
+            dx = t(j,1)
+            vx = -vx
+         endif
+         if ((dy.lt.edgely).or.(dy.ge.edgery)) then
+            dy = t(j,2)
+            vy = -vy
+         endif
+c mixed reflecting/periodic boundary conditions
+      else if (ipbc.eq.3) then
+         if ((dx.lt.edgelx).or.(dx.ge.edgerx)) then
+            dx = t(j,1)
+            vx = -vx
+         endif
+      endif
+c set new position
+      ppart(j+joff,1,k) = dx
+      ppart(j+joff,2,k) = dy
+c set new velocity
+      ppart(j+joff,3,k) = vx
+      ppart(j+joff,4,k) = vy
+   70 continue
+   80 continue
+      nps = npblk*ipp + 1
+c loop over remaining particles
+      do 90 j = nps, npp
+c find interpolation weights
+      x = ppart(j,1,k)
+      y = ppart(j,2,k)
+      nn = x
+      mm = y
+      dxp = x - real(nn)
+      dyp = y - real(mm)
+      nn = nn - noff + 1 + lxv*(mm - moff)
+      amx = 1.0 - dxp
+      amy = 1.0 - dyp
+c find acceleration
+      dx = amx*sfxy(1,nn)
+      dy = amx*sfxy(2,nn)
+      dx = amy*(dxp*sfxy(1,nn+1) + dx)
+      dy = amy*(dxp*sfxy(2,nn+1) + dy)
+      vx = amx*sfxy(1,nn+lxv)
+      vy = amx*sfxy(2,nn+lxv)
+      dx = dx + dyp*(dxp*sfxy(1,nn+1+lxv) + vx) 
+      dy = dy + dyp*(dxp*sfxy(2,nn+1+lxv) + vy)
+c new velocity
+      dxp = ppart(j,3,k)
+      dyp = ppart(j,4,k)
+      vx = dxp + qtm*dx
+      vy = dyp + qtm*dy
+c average kinetic energy
+      dxp = dxp + vx
+      dyp = dyp + vy
+      sum1 = sum1 + (dxp*dxp + dyp*dyp)
+c new position
+      dx = x + vx*dt
+      dy = y + vy*dt
+c reflecting boundary conditions
+      if (ipbc.eq.2) then
+         if ((dx.lt.edgelx).or.(dx.ge.edgerx)) then
+            dx = x
+            vx = -vx
+         endif
+         if ((dy.lt.edgely).or.(dy.ge.edgery)) then
+            dy = y
+            vy = -vy
+         endif
+c mixed reflecting/periodic boundary conditions
+      else if (ipbc.eq.3) then
+         if ((dx.lt.edgelx).or.(dx.ge.edgerx)) then
+            dx = x
+            vx = -vx
+         endif
+      endif
+c set new position
+      ppart(j,1,k) = dx
+      ppart(j,2,k) = dy
+c set new velocity
+      ppart(j,3,k) = vx
+      ppart(j,4,k) = vy
+   90 continue
+      sum2 = sum2 + sum1
+  100 continue
+!$OMP END PARALLEL DO
+c normalize kinetic energy
+      ek = ek + 0.125*sum2
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine VGPPUSHF2LT(ppart,fxy,kpic,ncl,ihole,qbm,dt,ek,idimp,  
+     1nppmx,nx,ny,mx,my,nxv,nyv,mx1,mxy1,ntmax,irc)
+c for 2d code, this subroutine updates particle co-ordinates and
+c velocities using leap-frog scheme in time and first-order linear
+c interpolation in space, with periodic boundary conditions.
+c also determines list of particles which are leaving this tile
+c vectorizable/OpenMP version using guard cells
+c data read in tiles
+c particles stored segmented array
+c 44 flops/particle, 12 loads, 4 stores
+c input: all except ncl, ihole, irc, output: ppart, ncl, ihole, ek, irc
+c equations used are:
+c vx(t+dt/2) = vx(t-dt/2) + (q/m)*fx(x(t),y(t))*dt,
+c vy(t+dt/2) = vy(t-dt/2) + (q/m)*fy(x(t),y(t))*dt,
+c where q/m is charge/mass, and
+c x(t+dt) = x(t) + vx(t+dt/2)*dt, y(t+dt) = y(t) + vy(t+dt/2)*dt
+c fx(x(t),y(t)) and fy(x(t),y(t)) are approximated by interpolation from
+c the nearest grid points:
+c fx(x,y) = (1-dy)*((1-dx)*fx(n,m)+dx*fx(n+1,m)) + dy*((1-dx)*fx(n,m+1)
+c    + dx*fx(n+1,m+1))
+c fy(x,y) = (1-dy)*((1-dx)*fy(n,m)+dx*fy(n+1,m)) + dy*((1-dx)*fy(n,m+1)
+c    + dx*fy(n+1,m+1))
+c where n,m = leftmost grid points and dx = x-n, dy = y-m
+c ppart(n,1,m) = position x of particle n in tile m
+c ppart(n,2,m) = position y of particle n in tile m
+c ppart(n,3,m) = velocity vx of particle n in tile m
+c ppart(n,4,m) = velocity vy of particle n in tile m
+c fxy(1,j,k) = x component of force/charge at grid (j,k)
+c fxy(2,j,k) = y component of force/charge at grid (j,k)
+c that is, convolution of electric field over particle shape
+c kpic(k) = number of particles in tile k
+c ncl(i,k) = number of particles going to destination i, tile k
+c ihole(1,:,k) = location of hole in array left by departing particle
+c ihole(2,:,k) = destination of particle leaving hole
+c ihole(1,1,k) = ih, number of holes left (error, if negative)
+c qbm = particle charge/mass
+c dt = time interval between successive calculations
+c kinetic energy/mass at time t is also calculated, using
+c ek = .125*sum((vx(t+dt/2)+vx(t-dt/2))**2+(vy(t+dt/2)+vy(t-dt/2))**2)
+c idimp = size of phase space = 4
+c nppmx = maximum number of particles in tile
+c nx/ny = system length in x/y direction
+c mx/my = number of grids in sorting cell in x/y
+c nxv = second dimension of field arrays, must be >= nx+1
+c nyv = third dimension of field arrays, must be >= ny+1
+c mx1 = (system length in x direction - 1)/mx + 1
+c mxy1 = mx1*my1, where my1 = (system length in y direction - 1)/my + 1
+c ntmax = size of hole array for particles leaving tiles
+c irc = maximum overflow, returned only if error occurs, when irc > 0
+c optimized version
+      implicit none
+      integer idimp, nppmx, nx, ny, mx, my, nxv, nyv, mx1, mxy1, ntmax
+      integer irc
+      real qbm, dt, ek
+      real ppart, fxy
+      integer kpic, ncl, ihole
+      dimension ppart(nppmx,idimp,mxy1), fxy(2,nxv*nyv)
+      dimension kpic(mxy1), ncl(8,mxy1)
+      dimension ihole(2,ntmax+1,mxy1)
+c local data
+      integer npblk, lvect
+      parameter(npblk=32,lvect=4)
+      integer noff, moff, npp, ipp, joff, nps
+      integer i, j, k, m, ih, nh, nn, mm, lxv
+      real qtm, dxp, dyp, amx, amy
+      real x, y, dx, dy, vx, vy
+      real anx, any, edgelx, edgely, edgerx, edgery
+      real sfxy
+      dimension sfxy(2,(mx+1)*(my+1))
+c scratch arrays
+      integer n
+      real s, t
+      dimension n(npblk), s(npblk,lvect), t(npblk,2)
+      double precision sum1, sum2
+      lxv = mx + 1
+      qtm = qbm*dt
+      anx = real(nx)
+      any = real(ny)
+      sum2 = 0.0d0
+c loop over tiles
+!$OMP PARALLEL DO
+!$OMP& PRIVATE(i,j,k,m,noff,moff,npp,ipp,joff,nps,nn,mm,ih,nh,x,y,dxp,
+!$OMP& dyp,amx,amy,dx,dy,vx,vy,edgelx,edgely,edgerx,edgery,sum1,sfxy,n,
+!$OMP& s,t)
+!$OMP& REDUCTION(+:sum2)
+      do 110 k = 1, mxy1
+      noff = (k - 1)/mx1
+      moff = my*noff
+      noff = mx*(k - mx1*noff - 1)
+      npp = kpic(k)
+      nn = min(mx,nx-noff)
+      mm = min(my,ny-moff)
+      edgelx = noff
+      edgerx = noff + nn
+      edgely = moff
+      edgery = moff + mm
+      ih = 0
+      nh = 0
+c load local fields from global array
+      do 20 j = 1, mm+1
+      do 10 i = 1, nn+1
+      sfxy(1,i+lxv*(j-1)) = fxy(1,i+noff+nxv*(j+moff-1))
+      sfxy(2,i+lxv*(j-1)) = fxy(2,i+noff+nxv*(j+moff-1))
+   10 continue
+   20 continue
+c clear counters
+      do 30 j = 1, 8
+      ncl(j,k) = 0
+   30 continue
+      sum1 = 0.0d0
+c loop over particles in tile
+      ipp = npp/npblk
+c outer loop over number of full blocks
+      do 90 m = 1, ipp
+      joff = npblk*(m - 1)
+c inner loop over particles in block
+      do 40 j = 1, npblk
+c find interpolation weights
+      x = ppart(j+joff,1,k)
+      y = ppart(j+joff,2,k)
+      nn = x
+      mm = y
+      dxp = x - real(nn)
+      dyp = y - real(mm)
+      n(j) = nn - noff + lxv*(mm - moff)
+      amx = 1.0 - dxp
+      amy = 1.0 - dyp
+      s(j,1) = amx*amy
+      s(j,2) = dxp*amy
+      s(j,3) = amx*dyp
+      s(j,4) = dxp*dyp
+      t(j,1) = x
+      t(j,2) = y
+   40 continue
+c find acceleration
+      do 60 j = 1, npblk
+      nn = n(j)
+      mm = nn + lxv - 2
+      dx = 0.0
+      dy = 0.0
+!dir$ ivdep
+      do 50 i = 1, lvect
+      if (i.gt.2) nn = mm
+      dx = dx + sfxy(1,i+nn)*s(j,i)
+      dy = dy + sfxy(2,i+nn)*s(j,i)
+   50 continue
+      s(j,1) = dx
+      s(j,2) = dy
+   60 continue
+c new velocity
+      do 70 j = 1, npblk
+      x = t(j,1)
+      y = t(j,2)
+      dxp = ppart(j+joff,3,k)
+      dyp = ppart(j+joff,4,k)
+      vx = dxp + qtm*s(j,1)
+      vy = dyp + qtm*s(j,2)
+c average kinetic energy
+      dxp = dxp + vx
+      dyp = dyp + vy
+      sum1 = sum1 + (dxp*dxp + dyp*dyp)
+c new position
+      s(j,1) = x + vx*dt
+      s(j,2) = y + vy*dt
+      s(j,3) = vx
+      s(j,4) = vy
+   70 continue
+c check boundary conditions
+!dir$ novector
+      do 80 j = 1, npblk
+      dx = s(j,1)
+      dy = s(j,2)
+c find particles going out of bounds
+      mm = 0
+c count how many particles are going in each direction in ncl
+c save their address and destination in ihole
+c use periodic boundary conditions and check for roundoff error
+c mm = direction particle is going
+      if (dx.ge.edgerx) then
+         if (dx.ge.anx) dx = dx - anx
+         mm = 2
+      else if (dx.lt.edgelx) then
+         if (dx.lt.0.0) then
+            dx = dx + anx
+            if (dx.lt.anx) then
+               mm = 1
+            else
+               dx = 0.0
+            endif
+         else
+            mm = 1
+         endif
+      endif
+      if (dy.ge.edgery) then
+         if (dy.ge.any) dy = dy - any
+         mm = mm + 6
+      else if (dy.lt.edgely) then
+         if (dy.lt.0.0) then
+            dy = dy + any
+            if (dy.lt.any) then
+               mm = mm + 3
+            else
+               dy = 0.0
+            endif
+         else
+            mm = mm + 3
+         endif
+      endif
+c set new position
+      ppart(j+joff,1,k) = dx
+      ppart(j+joff,2,k) = dy
+c set new velocity
+      ppart(j+joff,3,k) = s(j,3)
+      ppart(j+joff,4,k) = s(j,4)
+c increment counters
+      if (mm.gt.0) then
+         ncl(mm,k) = ncl(mm,k) + 1
+         ih = ih + 1
+         if (ih.le.ntmax) then
+            ihole(1,ih+1,k) = j + joff
+            ihole(2,ih+1,k) = mm
+         else
+            nh = 1
+         endif
+      endif
+   80 continue
+   90 continue
+      nps = npblk*ipp + 1
+c loop over remaining particles
+      do 100 j = nps, npp
+c find interpolation weights
+      x = ppart(j,1,k)
+      y = ppart(j,2,k)
+      nn = x
+      mm = y
+      dxp = x - real(nn)
+      dyp = y - real(mm)
+      nn = nn - noff + 1 + lxv*(mm - moff)
+      amx = 1.0 - dxp
+      amy = 1.0 - dyp
+c find acceleration
+      dx = amx*sfxy(1,nn)
+      dy = amx*sfxy(2,nn)
+      dx = amy*(dxp*sfxy(1,nn+1) + dx)
+      dy = amy*(dxp*sfxy(2,nn+1) + dy)
+      vx = amx*sfxy(1,nn+lxv)
+      vy = amx*sfxy(2,nn+lxv)
+      dx = dx + dyp*(dxp*sfxy(1,nn+1+lxv) + vx) 
+      dy = dy + dyp*(dxp*sfxy(2,nn+1+lxv) + vy)
+c new velocity
+      dxp = ppart(j,3,k)
+      dyp = ppart(j,4,k)
+      vx = dxp + qtm*dx
+      vy = dyp + qtm*dy
+c average kinetic energy
+      dxp = dxp + vx
+      dyp = dyp + vy
+      sum1 = sum1 + (dxp*dxp + dyp*dyp)
+c new position
+      dx = x + vx*dt
+      dy = y + vy*dt
+c find particles going out of bounds
+      mm = 0
+c count how many particles are going in each direction in ncl
+c save their address and destination in ihole
+c use periodic boundary conditions and check for roundoff error
+c mm = direction particle is going
+      if (dx.ge.edgerx) then
+         if (dx.ge.anx) dx = dx - anx
+         mm = 2
+      else if (dx.lt.edgelx) then
+         if (dx.lt.0.0) then
+            dx = dx + anx
+            if (dx.lt.anx) then
+               mm = 1
+            else
+               dx = 0.0
+            endif
+         else
+            mm = 1
+         endif
+      endif
+      if (dy.ge.edgery) then
+         if (dy.ge.any) dy = dy - any
+         mm = mm + 6
+      else if (dy.lt.edgely) then
+         if (dy.lt.0.0) then
+            dy = dy + any
+            if (dy.lt.any) then
+               mm = mm + 3
+            else
+               dy = 0.0
+            endif
+         else
+            mm = mm + 3
+         endif
+      endif
+c set new position
+      ppart(j,1,k) = dx
+      ppart(j,2,k) = dy
+c set new velocity
+      ppart(j,3,k) = vx
+      ppart(j,4,k) = vy
+c increment counters
+      if (mm.gt.0) then
+         ncl(mm,k) = ncl(mm,k) + 1
+         ih = ih + 1
+         if (ih.le.ntmax) then
+            ihole(1,ih+1,k) = j
+            ihole(2,ih+1,k) = mm
+         else
+            nh = 1
+         endif
+      endif
+  100 continue
+      sum2 = sum2 + sum1
+c set error and end of file flag
+c ihole overflow
+      if (nh.gt.0) then
+         irc = ih
+         ih = -ih
+      endif
+      ihole(1,1,k) = ih
+  110 continue
+!$OMP END PARALLEL DO
+c normalize kinetic energy
+      ek = ek + 0.125*sum2
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine GPPOST2LT(ppart,q,kpic,qm,nppmx,idimp,mx,my,nxv,nyv,mx1
+     1,mxy1)
+c for 2d code, this subroutine calculates particle charge density
+c using first-order linear interpolation, periodic boundaries
+c OpenMP version using guard cells
+c data deposited in tiles
+c particles stored segmented array
+c 17 flops/particle, 6 loads, 4 stores
+c input: all, output: q
+c charge density is approximated by values at the nearest grid points
+c q(n,m)=qm*(1.-dx)*(1.-dy)
+c q(n+1,m)=qm*dx*(1.-dy)
+c q(n,m+1)=qm*(1.-dx)*dy
+c q(n+1,m+1)=qm*dx*dy
+c where n,m = leftmost grid points and dx = x-n, dy = y-m
+c ppart(n,1,m) = position x of particle n in tile m
+c ppart(n,2,m) = position y of particle n in tile m
+c q(j,k) = charge density at grid point j,k
+c kpic = number of particles per tile
+c qm = charge on particle, in units of e
+c nppmx = maximum number of particles in tile
+c idimp = size of phase space = 4
+c mx/my = number of grids in sorting cell in x/y
+c nxv = first dimension of charge array, must be >= nx+1
+c nyv = second dimension of charge array, must be >= ny+1
+c mx1 = (system length in x direction - 1)/mx + 1
+c mxy1 = mx1*my1, where my1 = (system length in y direction - 1)/my + 1
+      implicit none
+      integer nppmx, idimp, mx, my, nxv, nyv, mx1, mxy1
+      real qm
+      real ppart, q
+      integer kpic
+      dimension ppart(nppmx,idimp,mxy1), q(nxv,nyv)
+      dimension kpic(mxy1)
+c local data
+      integer noff, moff, npp
+      integer i, j, k, nn, mm
+      real x, y, dxp, dyp, amx, amy
+      real sq
+      dimension sq(mx+1,my+1)
+c loop over tiles
+!$OMP PARALLEL DO
+!$OMP& PRIVATE(i,j,k,noff,moff,npp,nn,mm,x,y,dxp,dyp,amx,amy,sq)
+      do 80 k = 1, mxy1
+      noff = (k - 1)/mx1
+      moff = my*noff
+      noff = mx*(k - mx1*noff - 1)
+      npp = kpic(k)
+c zero out local accumulator
+      do 20 j = 1, my+1
+      do 10 i = 1, mx+1
+      sq(i,j) = 0.0
+   10 continue
+   20 continue
+c loop over particles in tile
+      do 30 j = 1, npp
+c find interpolation weights
+      x = ppart(j,1,k)
+      y = ppart(j,2,k)
+      nn = x
+      mm = y
+      dxp = qm*(x - real(nn))
+      dyp = y - real(mm)
+      nn = nn - noff + 1
+      mm = mm - moff + 1
+      amx = qm - dxp
+      amy = 1.0 - dyp
+c deposit charge within tile to local accumulator
+      x = sq(nn,mm) + amx*amy
+      y = sq(nn+1,mm) + dxp*amy
+      sq(nn,mm) = x
+      sq(nn+1,mm) = y
+      x = sq(nn,mm+1) + amx*dyp
+      y = sq(nn+1,mm+1) + dxp*dyp
+      sq(nn,mm+1) = x
+      sq(nn+1,mm+1) = y
+   30 continue
+c deposit charge to interior points in global array
+      nn = min(mx,nxv-noff)
+      mm = min(my,nyv-moff)
+      do 50 j = 2, mm
+      do 40 i = 2, nn
+      q(i+noff,j+moff) = q(i+noff,j+moff) + sq(i,j)
+   40 continue
+   50 continue
+c deposit charge to edge points in global array
+      mm = min(my+1,nyv-moff)
+      do 60 i = 2, nn
+!$OMP ATOMIC
+      q(i+noff,1+moff) = q(i+noff,1+moff) + sq(i,1)
+      if (mm > my) then
+!$OMP ATOMIC
+         q(i+noff,mm+moff) = q(i+noff,mm+moff) + sq(i,mm)
+      endif
+   60 continue
+      nn = min(mx+1,nxv-noff)
+      do 70 j = 1, mm
+!$OMP ATOMIC
+      q(1+noff,j+moff) = q(1+noff,j+moff) + sq(1,j)
+      if (nn > mx) then
+!$OMP ATOMIC
+         q(nn+noff,j+moff) = q(nn+noff,j+moff) + sq(nn,j)
+      endif
+   70 continue
+   80 continue
+!$OMP END PARALLEL DO
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine VGPPOST2LT(ppart,q,kpic,qm,nppmx,idimp,mx,my,nxv,nyv,  
+     1mx1,mxy1)
+c for 2d code, this subroutine calculates particle charge density
+c using first-order linear interpolation, periodic boundaries
+c vectorizable/OpenMP version using guard cells
+c data deposited in tiles
+c particles stored segmented array
+c 17 flops/particle, 6 loads, 4 stores
+c input: all, output: q
+c charge density is approximated by values at the nearest grid points
+c q(n,m)=qm*(1.-dx)*(1.-dy)
+c q(n+1,m)=qm*dx*(1.-dy)
+c q(n,m+1)=qm*(1.-dx)*dy
+c q(n+1,m+1)=qm*dx*dy
+c where n,m = leftmost grid points and dx = x-n, dy = y-m
+c ppart(n,1,m) = position x of particle n in tile m
+c ppart(n,2,m) = position y of particle n in tile m
+c q(j,k) = charge density at grid point j,k
+c kpic = number of particles per tile
+c qm = charge on particle, in units of e
+c nppmx = maximum number of particles in tile
+c idimp = size of phase space = 4
+c mx/my = number of grids in sorting cell in x/y
+c nxv = first dimension of charge array, must be >= nx+1
+c nyv = second dimension of charge array, must be >= ny+1
+c mx1 = (system length in x direction - 1)/mx + 1
+c mxy1 = mx1*my1, where my1 = (system length in y direction - 1)/my + 1
+      implicit none
+      integer nppmx, idimp, mx, my, nxv, nyv, mx1, mxy1
+      real qm
+      real ppart, q
+      integer kpic
+      dimension ppart(nppmx,idimp,mxy1), q(nxv*nyv)
+      dimension kpic(mxy1)
+c local data
+      integer npblk, lvect
+      parameter(npblk=32,lvect=4)
+      integer noff, moff, npp, ipp, joff, nps
+      integer i, j, k, m, nn, mm, lxv
+      real x, y, dxp, dyp, amx, amy
+      real sq
+      dimension sq((mx+1)*(my+1))
+c scratch arrays
+      integer n
+      real s
+      dimension n(npblk), s(npblk,lvect)
+      lxv = mx + 1
+c loop over tiles
+!$OMP PARALLEL DO
+!$OMP& PRIVATE(i,j,k,m,noff,moff,npp,ipp,joff,nps,nn,mm,x,y,dxp,dyp,amx,
+!$OMP& amy,sq,n,s)
+      do 110 k = 1, mxy1
+      noff = (k - 1)/mx1
+      moff = my*noff
+      noff = mx*(k - mx1*noff - 1)
+      npp = kpic(k)
+c zero out local accumulator
+      do 10 j = 1, (mx+1)*(my+1)
+      sq(j) = 0.0
+   10 continue
+c loop over particles in tile
+      ipp = npp/npblk
+c outer loop over number of full blocks
+      do 50 m = 1, ipp
+      joff = npblk*(m - 1)
+c inner loop over particles in block
+      do 20 j = 1, npblk
+c find interpolation weights
+      x = ppart(j+joff,1,k)
+      y = ppart(j+joff,2,k)
+      nn = x
+      mm = y
+      dxp = qm*(x - real(nn))
+      dyp = y - real(mm)
+      n(j) = nn - noff + lxv*(mm - moff)
+      amx = qm - dxp
+      amy = 1.0 - dyp
+      s(j,1) = amx*amy
+      s(j,2) = dxp*amy
+      s(j,3) = amx*dyp
+      s(j,4) = dxp*dyp
+   20 continue
+c deposit charge within tile to local accumulator
+      do 40 j = 1, npblk
+      nn = n(j)
+      mm = nn + lxv - 2
+!dir$ ivdep
+      do 30 i = 1, lvect
+      if (i.gt.2) nn = mm
+      sq(i+nn) = sq(i+nn) + s(j,i)
+   30 continue
+   40 continue
+   50 continue
+      nps = npblk*ipp + 1
+c loop over remaining particles
+      do 60 j = nps, npp
+c find interpolation weights
+      x = ppart(j,1,k)
+      y = ppart(j,2,k)
+      nn = x
+      mm = y
+      dxp = qm*(x - real(nn))
+      dyp = y - real(mm)
+      nn = nn - noff + 1 + lxv*(mm - moff)
+      amx = qm - dxp
+      amy = 1.0 - dyp
+c deposit charge within tile to local accumulator
+      x = sq(nn) + amx*amy
+      y = sq(nn+1) + dxp*amy
+      sq(nn) = x
+      sq(nn+1) = y
+      x = sq(nn+lxv) + amx*dyp
+      y = sq(nn+1+lxv) + dxp*dyp
+      sq(nn+lxv) = x
+      sq(nn+1+lxv) = y
+   60 continue
+c deposit charge to interior points in global array
+      nn = min(mx,nxv-noff)
+      mm = min(my,nyv-moff)
+      do 80 j = 2, mm
+!dir$ ivdep
+      do 70 i = 2, nn
+      q(i+noff+nxv*(j+moff-1)) = q(i+noff+nxv*(j+moff-1)) +             
+     1sq(i+lxv*(j-1))
+   70 continue
+   80 continue
+c deposit charge to edge points in global array
+      mm = min(my+1,nyv-moff)
+      do 90 i = 2, nn
+!$OMP ATOMIC
+      q(i+noff+nxv*moff) = q(i+noff+nxv*moff) + sq(i)
+      if (mm > my) then
+!$OMP ATOMIC
+         q(i+noff+nxv*(mm+moff-1)) = q(i+noff+nxv*(mm+moff-1)) +        
+     1sq(i+lxv*(mm-1))
+      endif
+   90 continue
+      nn = min(mx+1,nxv-noff)
+      do 100 j = 1, mm
+!$OMP ATOMIC
+      q(1+noff+nxv*(j+moff-1)) = q(1+noff+nxv*(j+moff-1)) +             
+     1sq(1+lxv*(j-1))
+      if (nn > mx) then
+!$OMP ATOMIC
+         q(nn+noff+nxv*(j+moff-1)) = q(nn+noff+nxv*(j+moff-1)) +        
+     1sq(nn+lxv*(j-1))
+      endif
+  100 continue
+  110 continue
+!$OMP END PARALLEL DO
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine viscan2(isdata,mb,nths)
+c performs vectorizable prefix reduction of integer data
+c using binary tree method.
+      implicit none
+      integer nths
+      integer isdata, mb
+      dimension isdata(nths), mb(nths/2)
+c local data
+      integer j, kxs, lb, ns
+      ns = nths/2
+      do 10 j = 1, ns
+      mb(j) = j - 1
+   10 continue
+      kxs = 1
+   20 if (kxs.lt.nths) then
+!dir$ ivdep
+         do 30 j = 1, ns
+         lb = kxs*mb(j)
+         if ((j+lb+kxs).le.nths) then
+            isdata(j+lb+kxs) = isdata(j+lb+kxs) + isdata(2*lb+kxs)
+         endif
+         mb(j) = mb(j)/2
+   30    continue
+         kxs = kxs + kxs
+         go to 20
+      endif
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPORDER2LT(ppart,ppbuff,kpic,ncl,ihole,idimp,nppmx,nx, 
+     1ny,mx,my,mx1,my1,npbmx,ntmax,irc)
+c this subroutine sorts particles by x,y grid in tiles of mx, my
+c linear interpolation, with periodic boundary conditions
+c tiles are assumed to be arranged in 2D linear memory
+c algorithm has 3 steps.  first, one finds particles leaving tile and
+c stores their number in each directon, location, and destination in ncl
+c and ihole.  second, a prefix scan of ncl is performed and departing
+c particles are buffered in ppbuff in direction order.  finally, we copy
+c the incoming particles from other tiles into ppart.
+c input: all except ppbuff, ncl, ihole, irc
+c output: ppart, ppbuff, kpic, ncl, ihole, irc
+c ppart(n,1,m) = position x of particle n in tile m
+c ppart(n,2,m) = position y of particle n in tile m
+c ppbuff(n,i,k) = i co-ordinate of particle n in tile k
+c kpic(k) = number of particles in tile k
+c ncl(i,k) = number of particles going to destination i, tile k
+c ihole(1,:,k) = location of hole in array left by departing particle
+c ihole(2,:,k) = direction destination of particle leaving hole
+c all for tile k
+c ihole(1,1,k) = ih, number of holes left (error, if negative)
+c idimp = size of phase space = 4
+c nppmx = maximum number of particles in tile
+c nx/ny = system length in x/y direction
+c mx/my = number of grids in sorting cell in x/y
+c mx1 = (system length in x direction - 1)/mx + 1
+c my1 = (system length in y direction - 1)/my + 1
+c npbmx = size of buffer array ppbuff
+c ntmax = size of hole array for particles leaving tiles
+c irc = maximum overflow, returned only if error occurs, when irc > 0
+      implicit none
+      integer idimp, nppmx, nx, ny, mx, my, mx1, my1, npbmx, ntmax, irc
+      real ppart, ppbuff
+      integer kpic, ncl, ihole
+      dimension ppart(nppmx,idimp,mx1*my1), ppbuff(npbmx,idimp,mx1*my1)
+      dimension kpic(mx1*my1), ncl(8,mx1*my1)
+      dimension ihole(2,ntmax+1,mx1*my1)
+c local data
+      integer mxy1, noff, moff, npp, ncoff
+      integer i, j, k, ii, kx, ky, ih, nh, ist, nn, mm, isum
+      integer ip, j1, j2, kxl, kxr, kk, kl, kr
+      real anx, any, edgelx, edgely, edgerx, edgery, dx, dy
+      integer ks
+      dimension ks(8)
+      mxy1 = mx1*my1
+      anx = real(nx)
+      any = real(ny)
+c find and count particles leaving tiles and determine destination
+c update ppart, ihole, ncl
+c loop over tiles
+!$OMP PARALLEL DO
+!$OMP& PRIVATE(j,k,noff,moff,npp,nn,mm,ih,nh,ist,dx,dy,edgelx,edgely,
+!$OMP& edgerx,edgery)
+      do 30 k = 1, mxy1
+      noff = (k - 1)/mx1
+      moff = my*noff
+      noff = mx*(k - mx1*noff - 1)
+      npp = kpic(k)
+      nn = min(mx,nx-noff)
+      mm = min(my,ny-moff)
+      ih = 0
+      nh = 0
+      edgelx = noff
+      edgerx = noff + nn
+      edgely = moff
+      edgery = moff + mm
+c clear counters
+      do 10 j = 1, 8
+      ncl(j,k) = 0
+   10 continue
+c loop over particles in tile
+      do 20 j = 1, npp
+      dx = ppart(j,1,k)
+      dy = ppart(j,2,k)
+c find particles going out of bounds
+      ist = 0
+c count how many particles are going in each direction in ncl
+c save their address and destination in ihole
+c use periodic boundary conditions and check for roundoff error
+c ist = direction particle is going
+      if (dx.ge.edgerx) then
+         if (dx.ge.anx) ppart(j,1,k) = dx - anx
+         ist = 2
+      else if (dx.lt.edgelx) then
+         if (dx.lt.0.0) then
+            dx = dx + anx
+            if (dx.lt.anx) then
+               ist = 1
+            else
+               dx = 0.0
+            endif
+            ppart(j,1,k) = dx
+         else
+            ist = 1
+         endif
+      endif
+      if (dy.ge.edgery) then
+         if (dy.ge.any) ppart(j,2,k) = dy - any
+         ist = ist + 6
+      else if (dy.lt.edgely) then
+         if (dy.lt.0.0) then
+            dy = dy + any
+            if (dy.lt.any) then
+               ist = ist + 3
+            else
+               dy = 0.0
+            endif
+            ppart(j,2,k) = dy
+         else
+            ist = ist + 3
+         endif
+      endif
+      if (ist.gt.0) then
+         ncl(ist,k) = ncl(ist,k) + 1
+         ih = ih + 1
+         if (ih.le.ntmax) then
+            ihole(1,ih+1,k) = j
+            ihole(2,ih+1,k) = ist
+         else
+            nh = 1
+         endif
+      endif
+   20 continue
+c set error and end of file flag
+      if (nh.gt.0) then
+         irc = ih
+         ih = -ih
+      endif
+      ihole(1,1,k) = ih
+   30 continue
+!$OMP END PARALLEL DO
+c ihole overflow
+      if (irc.gt.0) return
+c
+c buffer particles that are leaving tile: update ppbuff, ncl
+c loop over tiles
+!$OMP PARALLEL DO
+!$OMP& PRIVATE(i,j,k,isum,ist,nh,ip,j1,ii)
+      do 70 k = 1, mxy1
+c find address offset for ordered ppbuff array
+      isum = 0
+      do 40 j = 1, 8
+      ist = ncl(j,k)
+      ncl(j,k) = isum
+      isum = isum + ist
+   40 continue
+      nh = ihole(1,1,k)
+      ip = 0
+c loop over particles leaving tile
+      do 60 j = 1, nh
+c buffer particles that are leaving tile, in direction order
+      j1 = ihole(1,j+1,k)
+      ist = ihole(2,j+1,k)
+      ii = ncl(ist,k) + 1
+      if (ii.le.npbmx) then
+         do 50 i = 1, idimp
+         ppbuff(ii,i,k) = ppart(j1,i,k)
+   50    continue
+      else
+         ip = 1
+      endif
+      ncl(ist,k) = ii
+   60 continue
+c set error
+      if (ip.gt.0) irc = ncl(8,k)
+   70 continue
+!$OMP END PARALLEL DO
+c ppbuff overflow
+      if (irc.gt.0) return
+c
+c copy incoming particles from buffer into ppart: update ppart, kpic
+c loop over tiles
+!$OMP PARALLEL DO
+!$OMP& PRIVATE(i,j,k,ii,kk,npp,kx,ky,kl,kr,kxl,kxr,ih,nh,nn,ncoff,ist,j1
+!$OMP& ,j2,ip,ks)
+      do 130 k = 1, mxy1
+      npp = kpic(k)
+      ky = (k - 1)/mx1 + 1
+c loop over tiles in y, assume periodic boundary conditions
+      kk = (ky - 1)*mx1
+c find tile above
+      kl = ky - 1 
+      if (kl.lt.1) kl = kl + my1
+      kl = (kl - 1)*mx1
+c find tile below
+      kr = ky + 1
+      if (kr.gt.my1) kr = kr - my1
+      kr = (kr - 1)*mx1
+c loop over tiles in x, assume periodic boundary conditions
+      kx = k - (ky - 1)*mx1
+      kxl = kx - 1 
+      if (kxl.lt.1) kxl = kxl + mx1
+      kxr = kx + 1
+      if (kxr.gt.mx1) kxr = kxr - mx1
+c find tile number for different directions
+      ks(1) = kxr + kk
+      ks(2) = kxl + kk
+      ks(3) = kx + kr
+      ks(4) = kxr + kr
+      ks(5) = kxl + kr
+      ks(6) = kx + kl
+      ks(7) = kxr + kl
+      ks(8) = kxl + kl
+c loop over directions
+      nh = ihole(1,1,k)
+      ncoff = 0
+      ih = 0
+      ist = 0
+      j1 = 0
+      do 100 ii = 1, 8
+      if (ii.gt.1) ncoff = ncl(ii-1,ks(ii))
+c ip = number of particles coming from direction ii
+      ip = ncl(ii,ks(ii)) - ncoff
+      do 90 j = 1, ip
+      ih = ih + 1
+c insert incoming particles into holes
+      if (ih.le.nh) then
+         j1 = ihole(1,ih+1,k)
+c place overflow at end of array
+      else
+         j1 = npp + 1
+         npp = j1
+      endif
+      if (j1.le.nppmx) then
+         do 80 i = 1, idimp
+         ppart(j1,i,k) = ppbuff(j+ncoff,i,ks(ii))
+   80    continue
+      else
+         ist = 1
+      endif
+   90 continue
+  100 continue
+c set error
+      if (ist.gt.0) irc = j1
+c fill up remaining holes in particle array with particles from bottom
+c holes with locations great than npp-ip do not need to be filled
+      if (ih.lt.nh) then
+         ip = nh - ih
+         ii = nh + 1
+         nn = ihole(1,ii,k)
+         ih = ih + 2
+         j2 = ihole(1,ih,k)
+c move particles from end into remaining holes
+c holes are processed in increasing order
+         do 120 j = 1, ip
+         j1 = npp - j + 1
+         if (j1.eq.nn) then
+            ii = ii - 1
+            nn = ihole(1,ii,k)
+         else
+            do 110 i = 1, idimp
+            ppart(j2,i,k) = ppart(j1,i,k)
+  110       continue
+            ih = ih + 1
+            j2 = ihole(1,ih,k)
+         endif
+  120    continue
+         npp = npp - ip
+      endif
+      kpic(k) = npp
+  130 continue
+!$OMP END PARALLEL DO
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPORDERF2LT(ppart,ppbuff,kpic,ncl,ihole,idimp,nppmx,mx1
+     1,my1,npbmx,ntmax,irc)
+c this subroutine sorts particles by x,y grid in tiles of mx, my
+c linear interpolation, with periodic boundary conditions
+c tiles are assumed to be arranged in 2D linear memory.
+c the algorithm has 2 steps.  first, a prefix scan of ncl is performed
+c and departing particles are buffered in ppbuff in direction order.
+c then we copy the incoming particles from other tiles into ppart.
+c it assumes that the number, location, and destination of particles 
+c leaving a tile have been previously stored in ncl and ihole by the
+c GPPUSHF2LT subroutine.
+c input: all except ppbuff, irc
+c output: ppart, ppbuff, kpic, ncl, irc
+c ppart(n,1,m) = position x of particle n in tile m
+c ppart(n,2,m) = position y of particle n in tile m
+c ppbuff(n,i,k) = i co-ordinate of particle n in tile k
+c kpic(k) = number of particles in tile k
+c ncl(i,k) = number of particles going to destination i, tile k
+c ihole(1,:,k) = location of hole in array left by departing particle
+c ihole(2,:,k) = direction destination of particle leaving hole
+c all for tile k
+c ihole(1,1,k) = ih, number of holes left (error, if negative)
+c idimp = size of phase space = 4
+c nppmx = maximum number of particles in tile
+c mx1 = (system length in x direction - 1)/mx + 1
+c my1 = (system length in y direction - 1)/my + 1
+c npbmx = size of buffer array ppbuff
+c ntmax = size of hole array for particles leaving tiles
+c irc = maximum overflow, returned only if error occurs, when irc > 0
+      implicit none
+      integer idimp, nppmx, mx1, my1, npbmx, ntmax, irc
+      real ppart, ppbuff
+      integer kpic, ncl, ihole
+      dimension ppart(nppmx,idimp,mx1*my1), ppbuff(npbmx,idimp,mx1*my1)
+      dimension kpic(mx1*my1), ncl(8,mx1*my1)
+      dimension ihole(2,ntmax+1,mx1*my1)
+c local data
+      integer mxy1, npp, ncoff
+      integer i, j, k, ii, kx, ky, ih, nh, ist, nn, isum
+      integer ip, j1, j2, kxl, kxr, kk, kl, kr
+      integer ks
+      dimension ks(8)
+      mxy1 = mx1*my1
+c buffer particles that are leaving tile: update ppbuff, ncl
+c loop over tiles
+!$OMP PARALLEL DO
+!$OMP& PRIVATE(i,j,k,isum,ist,nh,ip,j1,ii)
+      do 40 k = 1, mxy1
+c find address offset for ordered ppbuff array
+      isum = 0
+      do 10 j = 1, 8
+      ist = ncl(j,k)
+      ncl(j,k) = isum
+      isum = isum + ist
+   10 continue
+      nh = ihole(1,1,k)
+      ip = 0
+c loop over particles leaving tile
+      do 30 j = 1, nh
+c buffer particles that are leaving tile, in direction order
+      j1 = ihole(1,j+1,k)
+      ist = ihole(2,j+1,k)
+      ii = ncl(ist,k) + 1
+      if (ii.le.npbmx) then
+         do 20 i = 1, idimp
+         ppbuff(ii,i,k) = ppart(j1,i,k)
+   20    continue
+      else
+         ip = 1
+      endif
+      ncl(ist,k) = ii
    30 continue
-c deposit charge to interior points in global array
-      nn = min(mx,nxv-noff)
-      mm = min(my,nyv-moff)
-      do 50 j = 2, mm
-      do 40 i = 2, nn
-      q(i+noff,j+moff) = q(i+noff,j+moff) + sq(i,j)
+c set error
+      if (ip.gt.0) irc = ncl(8,k)
    40 continue
-   50 continue
-c deposit charge to edge points in global array
-      mm = min(my+1,nyv-moff)
-      do 60 i = 2, nn
-!$OMP ATOMIC
-      q(i+noff,1+moff) = q(i+noff,1+moff) + sq(i,1)
-      if (mm > my) then
-!$OMP ATOMIC
-         q(i+noff,mm+moff) = q(i+noff,mm+moff) + sq(i,mm)
+!$OMP END PARALLEL DO
+c ppbuff overflow
+      if (irc.gt.0) return
+c
+c copy incoming particles from buffer into ppart: update ppart, kpic
+c loop over tiles
+!$OMP PARALLEL DO
+!$OMP& PRIVATE(i,j,k,ii,kk,npp,kx,ky,kl,kr,kxl,kxr,ih,nh,nn,ncoff,ist,j1
+!$OMP& ,j2,ip,ks)
+      do 100 k = 1, mxy1
+      npp = kpic(k)
+      ky = (k - 1)/mx1 + 1
+c loop over tiles in y, assume periodic boundary conditions
+      kk = (ky - 1)*mx1
+c find tile above
+      kl = ky - 1 
+      if (kl.lt.1) kl = kl + my1
+      kl = (kl - 1)*mx1
+c find tile below
+      kr = ky + 1
+      if (kr.gt.my1) kr = kr - my1
+      kr = (kr - 1)*mx1
+c loop over tiles in x, assume periodic boundary conditions
+      kx = k - (ky - 1)*mx1
+      kxl = kx - 1 
+      if (kxl.lt.1) kxl = kxl + mx1
+      kxr = kx + 1
+      if (kxr.gt.mx1) kxr = kxr - mx1
+c find tile number for different directions
+      ks(1) = kxr + kk
+      ks(2) = kxl + kk
+      ks(3) = kx + kr
+      ks(4) = kxr + kr
+      ks(5) = kxl + kr
+      ks(6) = kx + kl
+      ks(7) = kxr + kl
+      ks(8) = kxl + kl
+c loop over directions
+      nh = ihole(1,1,k)
+      ncoff = 0
+      ih = 0
+      ist = 0
+      j1 = 0
+      do 70 ii = 1, 8
+      if (ii.gt.1) ncoff = ncl(ii-1,ks(ii))
+c ip = number of particles coming from direction ii
+      ip = ncl(ii,ks(ii)) - ncoff
+      do 60 j = 1, ip
+      ih = ih + 1
+c insert incoming particles into holes
+      if (ih.le.nh) then
+         j1 = ihole(1,ih+1,k)
+c place overflow at end of array
+      else
+         j1 = npp + 1
+         npp = j1
       endif
-   60 continue
-      nn = min(mx+1,nxv-noff)
-      do 70 j = 1, mm
-!$OMP ATOMIC
-      q(1+noff,j+moff) = q(1+noff,j+moff) + sq(1,j)
-      if (nn > mx) then
-!$OMP ATOMIC
-         q(nn+noff,j+moff) = q(nn+noff,j+moff) + sq(nn,j)
+      if (j1.le.nppmx) then
+         do 50 i = 1, idimp
+         ppart(j1,i,k) = ppbuff(j+ncoff,i,ks(ii))
+   50    continue
+      else
+         ist = 1
       endif
+   60 continue
    70 continue
-   80 continue
+c set error
+      if (ist.gt.0) irc = j1
+c fill up remaining holes in particle array with particles from bottom
+c holes with locations great than npp-ip do not need to be filled
+      if (ih.lt.nh) then
+         ip = nh - ih
+         ii = nh + 1
+         nn = ihole(1,ii,k)
+         ih = ih + 2
+         j2 = ihole(1,ih,k)
+c move particles from end into remaining holes
+c holes are processed in increasing order
+         do 90 j = 1, ip
+         j1 = npp - j + 1
+         if (j1.eq.nn) then
+            ii = ii - 1
+            nn = ihole(1,ii,k)
+         else
+            do 80 i = 1, idimp
+            ppart(j2,i,k) = ppart(j1,i,k)
+   80       continue
+            ih = ih + 1
+            j2 = ihole(1,ih,k)
+         endif
+   90    continue
+         npp = npp - ip
+      endif
+      kpic(k) = npp
+  100 continue
 !$OMP END PARALLEL DO
       return
       end
 c-----------------------------------------------------------------------
-      subroutine PPORDER2L(ppart,ppbuff,kpic,ncl,ihole,idimp,nppmx,nx,ny
-     1,mx,my,mx1,my1,npbmx,ntmax,irc)
+      subroutine VPPORDER2LT(ppart,ppbuff,kpic,ncl,ihole,idimp,nppmx,nx,
+     1ny,mx,my,mx1,my1,npbmx,ntmax,irc)
 c this subroutine sorts particles by x,y grid in tiles of mx, my
 c linear interpolation, with periodic boundary conditions
 c tiles are assumed to be arranged in 2D linear memory
@@ -745,9 +3538,9 @@ c particles are buffered in ppbuff in direction order.  finally, we copy
 c the incoming particles from other tiles into ppart.
 c input: all except ppbuff, ncl, ihole, irc
 c output: ppart, ppbuff, kpic, ncl, ihole, irc
-c ppart(1,n,k) = position x of particle n in tile k
-c ppart(2,n,k) = position y of particle n in tile k
-c ppbuff(i,n,k) = i co-ordinate of particle n in tile k
+c ppart(n,1,m) = position x of particle n in tile m
+c ppart(n,2,m) = position y of particle n in tile m
+c ppbuff(n,i,k) = i co-ordinate of particle n in tile k
 c kpic(k) = number of particles in tile k
 c ncl(i,k) = number of particles going to destination i, tile k
 c ihole(1,:,k) = location of hole in array left by departing particle
@@ -767,16 +3560,21 @@ c irc = maximum overflow, returned only if error occurs, when irc > 0
       integer idimp, nppmx, nx, ny, mx, my, mx1, my1, npbmx, ntmax, irc
       real ppart, ppbuff
       integer kpic, ncl, ihole
-      dimension ppart(idimp,nppmx,mx1*my1), ppbuff(idimp,npbmx,mx1*my1)
+      dimension ppart(nppmx,idimp,mx1*my1), ppbuff(npbmx,idimp,mx1*my1)
       dimension kpic(mx1*my1), ncl(8,mx1*my1)
       dimension ihole(2,ntmax+1,mx1*my1)
 c local data
-      integer mxy1, noff, moff, npp, ncoff
-      integer i, j, k, ii, kx, ky, ih, nh, ist, nn, mm, isum
-      integer ip, j1, j2, kxl, kxr, kk, kl, kr
+      integer npblk
+      parameter(npblk=16)
+      integer mxy1, noff, moff, npp, ipp, joff, nps, ncoff
+      integer i, j, k, m, ii, kx, ky, ih, nh, ist, nn, mm, in
+      integer ip, j1, j2, kxl, kxr, kk, kl, kr, lb, kxs
       real anx, any, edgelx, edgely, edgerx, edgery, dx, dy
-      integer ks
-      dimension ks(8)
+      integer sncl, ks
+      dimension sncl(8), ks(8)
+c scratch arrays
+      integer n
+      dimension n(npblk,3)
       mxy1 = mx1*my1
       anx = real(nx)
       any = real(ny)
@@ -805,8 +3603,8 @@ c clear counters
    10 continue
 c loop over particles in tile
       do 20 j = 1, npp
-      dx = ppart(1,j,k)
-      dy = ppart(2,j,k)
+      dx = ppart(j,1,k)
+      dy = ppart(j,2,k)
 c find particles going out of bounds
       ist = 0
 c count how many particles are going in each direction in ncl
@@ -814,7 +3612,7 @@ c save their address and destination in ihole
 c use periodic boundary conditions and check for roundoff error
 c ist = direction particle is going
       if (dx.ge.edgerx) then
-         if (dx.ge.anx) ppart(1,j,k) = dx - anx
+         if (dx.ge.anx) ppart(j,1,k) = dx - anx
          ist = 2
       else if (dx.lt.edgelx) then
          if (dx.lt.0.0) then
@@ -824,13 +3622,13 @@ c ist = direction particle is going
             else
                dx = 0.0
             endif
-            ppart(1,j,k) = dx
+            ppart(j,1,k) = dx
          else
             ist = 1
          endif
       endif
       if (dy.ge.edgery) then
-         if (dy.ge.any) ppart(2,j,k) = dy - any
+         if (dy.ge.any) ppart(j,2,k) = dy - any
          ist = ist + 6
       else if (dy.lt.edgely) then
          if (dy.lt.0.0) then
@@ -840,7 +3638,7 @@ c ist = direction particle is going
             else
                dy = 0.0
             endif
-            ppart(2,j,k) = dy
+            ppart(j,2,k) = dy
          else
             ist = ist + 3
          endif
@@ -870,35 +3668,82 @@ c
 c buffer particles that are leaving tile: update ppbuff, ncl
 c loop over tiles
 !$OMP PARALLEL DO
-!$OMP& PRIVATE(i,j,k,isum,ist,nh,ip,j1,ii)
-      do 70 k = 1, mxy1
+!$OMP& PRIVATE(i,j,k,m,kxs,lb,ist,nh,ip,ipp,nps,joff,j1,ii,sncl,ks,n)
+      do 160 k = 1, mxy1
 c find address offset for ordered ppbuff array
-      isum = 0
       do 40 j = 1, 8
-      ist = ncl(j,k)
-      ncl(j,k) = isum
-      isum = isum + ist
+      sncl(j) = ncl(j,k)
+      ks(j) = j - 1
    40 continue
+      kxs = 1
+   50 if (kxs.lt.8) then
+!dir$ ivdep
+         do 60 j = 1, 4
+         lb = kxs*ks(j)
+         sncl(j+lb+kxs) = sncl(j+lb+kxs) + sncl(2*lb+kxs)
+         ks(j) = ks(j)/2
+   60    continue
+         kxs = kxs + kxs
+         go to 50
+      endif
+      do 70 j = 1, 8
+      sncl(j) = sncl(j) - ncl(j,k)
+   70 continue
       nh = ihole(1,1,k)
       ip = 0
+c buffer particles that are leaving tile, in direction order
 c loop over particles leaving tile
-      do 60 j = 1, nh
+      ipp = nh/npblk
+c outer loop over number of full blocks
+      do 120 m = 1, ipp
+      joff = npblk*(m - 1) + 1
+c inner loop over particles in block
+      do 80 j = 1, npblk
+      n(j,1) = ihole(1,j+joff,k)
+      n(j,2) = ihole(2,j+joff,k)
+   80 continue
+c calculate offsets
+      do 90 j = 1, npblk
+      ist = n(j,2)
+      ii = sncl(ist) + 1
+      n(j,2) = ii
+      sncl(ist) = ii
+   90 continue
+c buffer particles that are leaving tile, in direction order
+      do 110 i = 1, idimp
+      do 100 j = 1, npblk
+      j1 = n(j,1)
+      ii = n(j,2)
+      if (ii.le.npbmx) then
+         ppbuff(ii,i,k) = ppart(j1,i,k)
+      else
+         ip = 1
+      endif
+  100 continue
+  110 continue
+  120 continue
+      nps = npblk*ipp + 1
+c loop over remaining particles
+      do 140 j = nps, nh
 c buffer particles that are leaving tile, in direction order
       j1 = ihole(1,j+1,k)
       ist = ihole(2,j+1,k)
-      ii = ncl(ist,k) + 1
+      ii = sncl(ist) + 1
       if (ii.le.npbmx) then
-         do 50 i = 1, idimp
-         ppbuff(i,ii,k) = ppart(i,j1,k)
-   50    continue
+         do 130 i = 1, idimp
+         ppbuff(ii,i,k) = ppart(j1,i,k)
+  130    continue
       else
          ip = 1
       endif
-      ncl(ist,k) = ii
-   60 continue
+      sncl(ist) = ii
+  140 continue
+      do 150 j = 1, 8
+      ncl(j,k) = sncl(j)
+  150 continue
 c set error
       if (ip.gt.0) irc = ncl(8,k)
-   70 continue
+  160 continue
 !$OMP END PARALLEL DO
 c ppbuff overflow
       if (irc.gt.0) return
@@ -906,9 +3751,9 @@ c
 c copy incoming particles from buffer into ppart: update ppart, kpic
 c loop over tiles
 !$OMP PARALLEL DO
-!$OMP& PRIVATE(i,j,k,ii,kk,npp,kx,ky,kl,kr,kxl,kxr,ih,nh,ncoff,ist,j1,j2
-!$OMP& ,ip,ks)
-      do 130 k = 1, mxy1
+!$OMP& PRIVATE(i,j,k,m,ii,kk,in,npp,ipp,joff,nps,kx,ky,kl,kr,kxl,kxr,ih,
+!$OMP& nh,nn,mm,ncoff,ist,j1,j2,ip,ks,n)
+      do 310 k = 1, mxy1
       npp = kpic(k)
       ky = (k - 1)/mx1 + 1
 c loop over tiles in y, assume periodic boundary conditions
@@ -942,54 +3787,130 @@ c loop over directions
       ih = 0
       ist = 0
       j1 = 0
-      do 100 ii = 1, 8
+      do 230 ii = 1, 8
       if (ii.gt.1) ncoff = ncl(ii-1,ks(ii))
 c ip = number of particles coming from direction ii
       ip = ncl(ii,ks(ii)) - ncoff
-      do 90 j = 1, ip
+c loop over particles coming from direction ii
+      ipp = ip/npblk
+c outer loop over number of full blocks
+      do 200 m = 1, ipp
+      joff = npblk*(m - 1)
+c inner loop over particles in block
+      do 170 j = 1, npblk
+c insert incoming particles into holes
+      if ((j+ih).le.nh) then
+         j1 = ihole(1,j+ih+1,k)
+c place overflow at end of array
+      else
+         j1 = npp + j + ih - nh
+      endif
+      n(j,1) = j1
+  170 continue
+      do 190 i = 1, idimp
+      do 180 j = 1, npblk
+      j1 = n(j,1)
+      if (j1.le.nppmx) then
+         ppart(j1,i,k) = ppbuff(j+joff+ncoff,i,ks(ii))
+      else
+         ist = 1
+      endif
+  180 continue
+  190 continue
+      ih = ih + npblk
+  200 continue
+      nps = npblk*ipp + 1
+c loop over remaining particles
+      do 220 j = nps, ip
       ih = ih + 1
 c insert incoming particles into holes
       if (ih.le.nh) then
          j1 = ihole(1,ih+1,k)
 c place overflow at end of array
       else
-         j1 = npp + 1
-         npp = j1
+         j1 = npp + ih - nh
       endif
       if (j1.le.nppmx) then
-         do 80 i = 1, idimp
-         ppart(i,j1,k) = ppbuff(i,j+ncoff,ks(ii))
-   80    continue
+         do 210 i = 1, idimp
+         ppart(j1,i,k) = ppbuff(j+ncoff,i,ks(ii))
+  210    continue
       else
          ist = 1
       endif
-   90 continue
-  100 continue
+  220 continue
+  230 continue
+      if (ih > nh) npp = npp + ih - nh
 c set error
       if (ist.gt.0) irc = j1
 c fill up remaining holes in particle array with particles from bottom
+c holes with locations great than npp-ip do not need to be filled
       if (ih.lt.nh) then
          ip = nh - ih
-         do 120 j = 1, ip
+c move particles from end into remaining holes
+c holes are processed in increasing order
+         ii = nh + 1
+         ipp = ip/npblk
+c outer loop over number of full blocks
+         do 280 m = 1, ipp
+         joff = npblk*(m - 1)
+c inner loop over particles in block
+         do 240 j = 1, npblk
+         n(j,2) = ihole(1,ih+j+1,k)
+         n(j,3) = ihole(1,ii-j+1,k)
+  240    continue
+         in = 1
+         mm = 1
+         nn = n(in,3)
+         do 250 j = 1, npblk
+         j1 = npp - j - joff + 1
+         n(j,1) = n(mm,2)
+         if (j1.eq.nn) then
+            in = in + 1
+            nn = n(in,3)
+            n(j,1) = -1
+         else
+            mm = mm + 1
+         endif
+  250    continue
+         do 270 i = 1, idimp
+!dir$ ivdep
+         do 260 j = 1, npblk
+         j1 = npp - j - joff + 1
+         j2 = n(j,1)
+         if (j2.gt.0) ppart(j2,i,k) = ppart(j1,i,k)
+  260    continue
+  270    continue
+         ii = ii - in + 1
+         ih = ih + mm - 1
+  280    continue
+         nps = npblk*ipp + 1
+         nn = ihole(1,ii,k)
+         ih = ih + 2
+         j2 = ihole(1,ih,k)
+c loop over remaining particles
+         do 300 j = nps, ip
          j1 = npp - j + 1
-         j2 = ihole(1,nh-j+2,k)
-         if (j1.gt.j2) then
-c move particle only if it is below current hole
-            do 110 i = 1, idimp
-            ppart(i,j2,k) = ppart(i,j1,k)
-  110       continue
+         if (j1.eq.nn) then
+            ii = ii - 1
+            nn = ihole(1,ii,k)
+         else
+            do 290 i = 1, idimp
+            ppart(j2,i,k) = ppart(j1,i,k)
+  290       continue
+            ih = ih + 1
+            j2 = ihole(1,ih,k)
          endif
-  120    continue
+  300    continue
          npp = npp - ip
       endif
       kpic(k) = npp
-  130 continue
+  310 continue
 !$OMP END PARALLEL DO
       return
       end
 c-----------------------------------------------------------------------
-      subroutine PPORDERF2L(ppart,ppbuff,kpic,ncl,ihole,idimp,nppmx,mx1,
-     1my1,npbmx,ntmax,irc)
+      subroutine VPPORDERF2LT(ppart,ppbuff,kpic,ncl,ihole,idimp,nppmx,  
+     1mx1,my1,npbmx,ntmax,irc)
 c this subroutine sorts particles by x,y grid in tiles of mx, my
 c linear interpolation, with periodic boundary conditions
 c tiles are assumed to be arranged in 2D linear memory.
@@ -998,12 +3919,12 @@ c and departing particles are buffered in ppbuff in direction order.
 c then we copy the incoming particles from other tiles into ppart.
 c it assumes that the number, location, and destination of particles 
 c leaving a tile have been previously stored in ncl and ihole by the
-c GPPUSHF2L subroutine.
+c GPPUSHF2LT subroutine.
 c input: all except ppbuff, irc
 c output: ppart, ppbuff, kpic, ncl, irc
-c ppart(1,n,k) = position x of particle n in tile k
-c ppart(2,n,k) = position y of particle n in tile k
-c ppbuff(i,n,k) = i co-ordinate of particle n in tile k
+c ppart(n,1,m) = position x of particle n in tile m
+c ppart(n,2,m) = position y of particle n in tile m
+c ppbuff(n,i,k) = i co-ordinate of particle n in tile k
 c kpic(k) = number of particles in tile k
 c ncl(i,k) = number of particles going to destination i, tile k
 c ihole(1,:,k) = location of hole in array left by departing particle
@@ -1021,48 +3942,101 @@ c irc = maximum overflow, returned only if error occurs, when irc > 0
       integer idimp, nppmx, mx1, my1, npbmx, ntmax, irc
       real ppart, ppbuff
       integer kpic, ncl, ihole
-      dimension ppart(idimp,nppmx,mx1*my1), ppbuff(idimp,npbmx,mx1*my1)
+      dimension ppart(nppmx,idimp,mx1*my1), ppbuff(npbmx,idimp,mx1*my1)
       dimension kpic(mx1*my1), ncl(8,mx1*my1)
       dimension ihole(2,ntmax+1,mx1*my1)
 c local data
+      integer npblk
+      parameter(npblk=16)
       integer mxy1, npp, ncoff
-      integer i, j, k, ii, kx, ky, ih, nh, ist, isum
+      integer i, j, k, ii, kx, ky, ih, nh, ist, nn, mm, in
       integer ip, j1, j2, kxl, kxr, kk, kl, kr
-      integer ks
-      dimension ks(8)
+      integer lb, kxs, m, ipp, nps, joff
+      integer sncl, ks
+      dimension sncl(8), ks(8)
+c scratch arrays
+      integer n
+      dimension n(npblk,3)
       mxy1 = mx1*my1
 c buffer particles that are leaving tile: update ppbuff, ncl
 c loop over tiles
 !$OMP PARALLEL DO
-!$OMP& PRIVATE(i,j,k,isum,ist,nh,ip,j1,ii)
-      do 40 k = 1, mxy1
+!$OMP& PRIVATE(i,j,k,m,kxs,lb,ist,nh,ip,ipp,nps,joff,j1,ii,sncl,ks,n)
+      do 130 k = 1, mxy1
 c find address offset for ordered ppbuff array
-      isum = 0
       do 10 j = 1, 8
-      ist = ncl(j,k)
-      ncl(j,k) = isum
-      isum = isum + ist
+      sncl(j) = ncl(j,k)
+      ks(j) = j - 1
    10 continue
+      kxs = 1
+   20 if (kxs.lt.8) then
+!dir$ ivdep
+         do 30 j = 1, 4
+         lb = kxs*ks(j)
+         sncl(j+lb+kxs) = sncl(j+lb+kxs) + sncl(2*lb+kxs)
+         ks(j) = ks(j)/2
+   30    continue
+         kxs = kxs + kxs
+         go to 20
+      endif
+      do 40 j = 1, 8
+      sncl(j) = sncl(j) - ncl(j,k)
+   40 continue
       nh = ihole(1,1,k)
       ip = 0
+c buffer particles that are leaving tile, in direction order
 c loop over particles leaving tile
-      do 30 j = 1, nh
+      ipp = nh/npblk
+c outer loop over number of full blocks
+      do 90 m = 1, ipp
+      joff = npblk*(m - 1) + 1
+c inner loop over particles in block
+      do 50 j = 1, npblk
+      n(j,1) = ihole(1,j+joff,k)
+      n(j,2) = ihole(2,j+joff,k)
+   50 continue
+c calculate offsets
+      do 60 j = 1, npblk
+      ist = n(j,2)
+      ii = sncl(ist) + 1
+      n(j,2) = ii
+      sncl(ist) = ii
+   60 continue
+c buffer particles that are leaving tile, in direction order
+      do 80 i = 1, idimp
+      do 70 j = 1, npblk
+      j1 = n(j,1)
+      ii = n(j,2)
+      if (ii.le.npbmx) then
+         ppbuff(ii,i,k) = ppart(j1,i,k)
+      else
+         ip = 1
+      endif
+   70 continue
+   80 continue
+   90 continue
+      nps = npblk*ipp + 1
+c loop over remaining particles
+      do 110 j = nps, nh
 c buffer particles that are leaving tile, in direction order
       j1 = ihole(1,j+1,k)
       ist = ihole(2,j+1,k)
-      ii = ncl(ist,k) + 1
+      ii = sncl(ist) + 1
       if (ii.le.npbmx) then
-         do 20 i = 1, idimp
-         ppbuff(i,ii,k) = ppart(i,j1,k)
-   20    continue
+         do 100 i = 1, idimp
+         ppbuff(ii,i,k) = ppart(j1,i,k)
+  100    continue
       else
          ip = 1
       endif
-      ncl(ist,k) = ii
-   30 continue
+      sncl(ist) = ii
+  110 continue
+      do 120 j = 1, 8
+      ncl(j,k) = sncl(j)
+  120 continue
 c set error
       if (ip.gt.0) irc = ncl(8,k)
-   40 continue
+  130 continue
 !$OMP END PARALLEL DO
 c ppbuff overflow
       if (irc.gt.0) return
@@ -1070,9 +4044,9 @@ c
 c copy incoming particles from buffer into ppart: update ppart, kpic
 c loop over tiles
 !$OMP PARALLEL DO
-!$OMP& PRIVATE(i,j,k,ii,kk,npp,kx,ky,kl,kr,kxl,kxr,ih,nh,ncoff,ist,j1,j2
-!$OMP& ,ip,ks)
-      do 100 k = 1, mxy1
+!$OMP& PRIVATE(i,j,k,m,ii,kk,in,npp,ipp,joff,nps,kx,ky,kl,kr,kxl,kxr,ih,
+!$OMP& nh,nn,mm,ncoff,ist,j1,j2,ip,ks,n)
+      do 280 k = 1, mxy1
       npp = kpic(k)
       ky = (k - 1)/mx1 + 1
 c loop over tiles in y, assume periodic boundary conditions
@@ -1106,48 +4080,246 @@ c loop over directions
       ih = 0
       ist = 0
       j1 = 0
-      do 70 ii = 1, 8
+      do 200 ii = 1, 8
       if (ii.gt.1) ncoff = ncl(ii-1,ks(ii))
 c ip = number of particles coming from direction ii
       ip = ncl(ii,ks(ii)) - ncoff
-      do 60 j = 1, ip
+c loop over particles coming from direction ii
+      ipp = ip/npblk
+c outer loop over number of full blocks
+      do 170 m = 1, ipp
+      joff = npblk*(m - 1)
+c inner loop over particles in block
+      do 140 j = 1, npblk
+c insert incoming particles into holes
+      if ((j+ih).le.nh) then
+         j1 = ihole(1,j+ih+1,k)
+c place overflow at end of array
+      else
+         j1 = npp + j + ih - nh
+      endif
+      n(j,1) = j1
+  140 continue
+      do 160 i = 1, idimp
+      do 150 j = 1, npblk
+      j1 = n(j,1)
+      if (j1.le.nppmx) then
+         ppart(j1,i,k) = ppbuff(j+joff+ncoff,i,ks(ii))
+      else
+         ist = 1
+      endif
+  150 continue
+  160 continue
+      ih = ih + npblk
+  170 continue
+      nps = npblk*ipp + 1
+c loop over remaining particles
+      do 190 j = nps, ip
       ih = ih + 1
 c insert incoming particles into holes
       if (ih.le.nh) then
          j1 = ihole(1,ih+1,k)
 c place overflow at end of array
       else
-         j1 = npp + 1
-         npp = j1
+         j1 = npp + ih - nh
       endif
       if (j1.le.nppmx) then
-         do 50 i = 1, idimp
-         ppart(i,j1,k) = ppbuff(i,j+ncoff,ks(ii))
-   50    continue
+         do 180 i = 1, idimp
+         ppart(j1,i,k) = ppbuff(j+ncoff,i,ks(ii))
+  180    continue
       else
          ist = 1
       endif
-   60 continue
-   70 continue
+  190 continue
+  200 continue
+      if (ih > nh) npp = npp + ih - nh
 c set error
       if (ist.gt.0) irc = j1
 c fill up remaining holes in particle array with particles from bottom
+c holes with locations great than npp-ip do not need to be filled
       if (ih.lt.nh) then
          ip = nh - ih
-         do 90 j = 1, ip
+c move particles from end into remaining holes
+c holes are processed in increasing order
+         ii = nh + 1
+c loop over particles coming from direction ii
+         ipp = ip/npblk
+c outer loop over number of full blocks
+         do 250 m = 1, ipp
+         joff = npblk*(m - 1)
+c inner loop over particles in block
+         do 210 j = 1, npblk
+         n(j,2) = ihole(1,ih+j+1,k)
+         n(j,3) = ihole(1,ii-j+1,k)
+  210    continue
+         in = 1
+         mm = 1
+         nn = n(in,3)
+         do 220 j = 1, npblk
+         j1 = npp - j - joff + 1
+         n(j,1) = n(mm,2)
+         if (j1.eq.nn) then
+            in = in + 1
+            nn = n(in,3)
+            n(j,1) = -1
+         else
+            mm = mm + 1
+         endif
+  220    continue
+         do 240 i = 1, idimp
+!dir$ ivdep
+         do 230 j = 1, npblk
+         j1 = npp - j - joff + 1
+         j2 = n(j,1)
+         if (j2.gt.0) ppart(j2,i,k) = ppart(j1,i,k)
+  230    continue
+  240    continue
+         ii = ii - in + 1
+         ih = ih + mm - 1
+  250    continue
+         nps = npblk*ipp + 1
+         nn = ihole(1,ii,k)
+         ih = ih + 2
+         j2 = ihole(1,ih,k)
+c loop over remaining particles
+         do 270 j = nps, ip
          j1 = npp - j + 1
-         j2 = ihole(1,nh-j+2,k)
-         if (j1.gt.j2) then
-c move particle only if it is below current hole
-            do 80 i = 1, idimp
-            ppart(i,j2,k) = ppart(i,j1,k)
-   80       continue
+         if (j1.eq.nn) then
+            ii = ii - 1
+            nn = ihole(1,ii,k)
+         else
+            do 260 i = 1, idimp
+            ppart(j2,i,k) = ppart(j1,i,k)
+  260       continue
+            ih = ih + 1
+            j2 = ihole(1,ih,k)
          endif
-   90    continue
+  270    continue
          npp = npp - ip
       endif
       kpic(k) = npp
-  100 continue
+  280 continue
+!$OMP END PARALLEL DO
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPGROW2LT(ppart,kpic,idimp,nppmx,nppmxn,mxy1)
+c this subroutine changes the maximum number of particles in each tile
+c of the segmented particle array ppart from nppmx to nppmxn, moving
+c the particles in place.  the array ppart must already have been
+c reallocated to hold nppmxn*idimp*mxy1 elements.
+c co-ordinates are moved in reverse order, so that no data is
+c overwritten
+c input: all, output: ppart
+c ppart(n,i,k) = i co-ordinate of particle n in tile k
+c kpic(k) = number of particles in tile k
+c idimp = size of phase space = 4
+c nppmx = old maximum number of particles in tile
+c nppmxn = new maximum number of particles in tile, must be >= nppmx
+c mxy1 = mx1*my1, where my1 = (system length in y direction - 1)/my + 1
+      implicit none
+      integer idimp, nppmx, nppmxn, mxy1
+      real ppart
+      integer kpic
+      dimension ppart(nppmxn*idimp*mxy1), kpic(mxy1)
+c local data
+      integer j, k, npp
+      if (nppmxn.le.nppmx) return
+c loop over co-ordinates in all tiles, k = i + idimp*(tile-1)
+      do 20 k = idimp*mxy1, 2, -1
+      npp = min(kpic((k-1)/idimp+1),nppmx)
+      do 10 j = npp, 1, -1
+      ppart(j+nppmxn*(k-1)) = ppart(j+nppmx*(k-1))
+   10 continue
+   20 continue
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPHOLE2LT(ppart,kpic,ncl,ihole,idimp,nppmx,mx,my,mx1,  
+     1my1,ntmax,irc)
+c this subroutine finds the list of particles leaving tiles of mx, my
+c after the co-ordinates have been updated and periodic boundary
+c conditions applied, for example by GPPUSHF2LT.  the destination is
+c found from the tile containing the new position.
+c it is used to recalculate ncl and ihole after ihole has overflowed
+c in GPPUSHF2LT and has been enlarged.
+c tiles are assumed to be transposed
+c input: all except ncl, ihole, irc
+c output: ncl, ihole, irc
+c ppart(n,1,k) = position x of particle n in tile k
+c ppart(n,2,k) = position y of particle n in tile k
+c kpic(k) = number of particles in tile k
+c ncl(i,k) = number of particles going to destination i, tile k
+c ihole(1,:,k) = location of hole in array left by departing particle
+c ihole(2,:,k) = direction destination of particle leaving hole
+c all for tile k
+c ihole(1,1,k) = ih, number of holes left (error, if negative)
+c idimp = size of phase space = 4
+c nppmx = maximum number of particles in tile
+c mx/my = number of grids in sorting cell in x/y
+c mx1 = (system length in x direction - 1)/mx + 1
+c my1 = (system length in y direction - 1)/my + 1
+c ntmax = size of hole array for particles leaving tiles
+c irc = maximum overflow, returned only if error occurs, when irc > 0
+      implicit none
+      integer idimp, nppmx, mx, my, mx1, my1, ntmax, irc
+      real ppart
+      integer kpic, ncl, ihole
+      dimension ppart(nppmx,idimp,mx1*my1)
+      dimension kpic(mx1*my1), ncl(8,mx1*my1)
+      dimension ihole(2,ntmax+1,mx1*my1)
+c local data
+      integer mxy1, npp, j, k, kx, ky, ih, nh, ist, nn, mm
+      mxy1 = mx1*my1
+c loop over tiles
+!$OMP PARALLEL DO
+!$OMP& PRIVATE(j,k,kx,ky,npp,nn,mm,ih,nh,ist)
+      do 30 k = 1, mxy1
+      ky = (k - 1)/mx1
+      kx = k - mx1*ky - 1
+      npp = kpic(k)
+      ih = 0
+      nh = 0
+c clear counters
+      do 10 j = 1, 8
+      ncl(j,k) = 0
+   10 continue
+c loop over particles in tile
+      do 20 j = 1, npp
+      nn = ppart(j,1,k)
+      mm = ppart(j,2,k)
+      nn = nn/mx - kx
+      mm = mm/my - ky
+c ist = direction particle is going, allowing for periodic tiles
+      ist = 0
+      if ((nn.eq.1).or.(nn.eq.(1-mx1))) then
+         ist = 2
+      else if (nn.ne.0) then
+         ist = 1
+      endif
+      if ((mm.eq.1).or.(mm.eq.(1-my1))) then
+         ist = ist + 6
+      else if (mm.ne.0) then
+         ist = ist + 3
+      endif
+      if (ist.gt.0) then
+         ncl(ist,k) = ncl(ist,k) + 1
+         ih = ih + 1
+         if (ih.le.ntmax) then
+            ihole(1,ih+1,k) = j
+            ihole(2,ih+1,k) = ist
+         else
+            nh = 1
+         endif
+      endif
+   20 continue
+c set error and end of file flag
+      if (nh.gt.0) then
+         irc = ih
+         ih = -ih
+      endif
+      ihole(1,1,k) = ih
+   30 continue
 !$OMP END PARALLEL DO
       return
       end
@@ -1389,8 +4561,11 @@ c parallelized with OpenMP
       integer isign, indx, indy, nxhd, nyd, nxhyd, nxyhd
       dimension f(nxhd,nyd), mixup(nxhyd), sct(nxyhd)
 c local data
-      integer nxh, ny, nxi, nyi
+      integer nxh, ny, nxi, nyi, nxybmin
       data nxi, nyi /1,1/
+c nxybmin = smallest size nxhd*nyd for which the cache-blocked y fft
+c is used, from the crossover measured with the benchmark cbfft2
+      data nxybmin /524288/
 c calculate range of indices
       nxh = 2**(indx - 1)
       ny = 2**indy
@@ -1400,13 +4575,23 @@ c perform x fft
          call FFT2RMXX(f,isign,mixup,sct,indx,indy,nyi,ny,nxhd,nyd,nxhyd
      1,nxyhd)
 c perform y fft
-         call FFT2RMXY(f,isign,mixup,sct,indx,indy,nxi,nxh,nxhd,nyd,    
+         if (nxhd*nyd.lt.nxybmin) then
+            call FFT2RMXY(f,isign,mixup,sct,indx,indy,nxi,nxh,nxhd,nyd, 
+     1nxhyd,nxyhd)
+         else
+            call FFT2RMXYB(f,isign,mixup,sct,indx,indy,nxi,nxh,nxhd,nyd,
      1nxhyd,nxyhd)
+         endif
 c forward fourier transform
       else if (isign.gt.0) then
 c perform y fft
-         call FFT2RMXY(f,isign,mixup,sct,indx,indy,nxi,nxh,nxhd,nyd,    
+         if (nxhd*nyd.lt.nxybmin) then
+            call FFT2RMXY(f,isign,mixup,sct,indx,indy,nxi,nxh,nxhd,nyd, 
+     1nxhyd,nxyhd)
+         else
+            call FFT2RMXYB(f,isign,mixup,sct,indx,indy,nxi,nxh,nxhd,nyd,
      1nxhyd,nxyhd)
+         endif
 c perform x fft
          call FFT2RMXX(f,isign,mixup,sct,indx,indy,nyi,ny,nxhd,nyd,nxhyd
      1,nxyhd)
@@ -1424,8 +4609,11 @@ c parallelized with OpenMP
       integer isign, indx, indy, nxhd, nyd, nxhyd, nxyhd
       dimension f(2,nxhd,nyd), mixup(nxhyd), sct(nxyhd)
 c local data
-      integer nxh, ny, nxi, nyi
+      integer nxh, ny, nxi, nyi, nxybmin
       data nxi, nyi /1,1/
+c nxybmin = smallest size nxhd*nyd for which the cache-blocked y fft
+c is used, from the crossover measured with the benchmark cbfft2
+      data nxybmin /2097152/
 c calculate range of indices
       nxh = 2**(indx - 1)
       ny = 2**indy
@@ -1435,13 +4623,23 @@ c perform x fft
          call FFT2RM2X(f,isign,mixup,sct,indx,indy,nyi,ny,nxhd,nyd,nxhyd
      1,nxyhd)
 c perform y fft
-         call FFT2RM2Y(f,isign,mixup,sct,indx,indy,nxi,nxh,nxhd,nyd,    
+         if (nxhd*nyd.lt.nxybmin) then
+            call FFT2RM2Y(f,isign,mixup,sct,indx,indy,nxi,nxh,nxhd,nyd, 
+     1nxhyd,nxyhd)
+         else
+            call FFT2RM2YB(f,isign,mixup,sct,indx,indy,nxi,nxh,nxhd,nyd,
      1nxhyd,nxyhd)
+         endif
 c forward fourier transform
       else if (isign.gt.0) then
 c perform y fft
-         call FFT2RM2Y(f,isign,mixup,sct,indx,indy,nxi,nxh,nxhd,nyd,    
+         if (nxhd*nyd.lt.nxybmin) then
+            call FFT2RM2Y(f,isign,mixup,sct,indx,indy,nxi,nxh,nxhd,nyd, 
      1nxhyd,nxyhd)
+         else
+            call FFT2RM2YB(f,isign,mixup,sct,indx,indy,nxi,nxh,nxhd,nyd,
+     1nxhyd,nxyhd)
+         endif
 c perform x fft
          call FFT2RM2X(f,isign,mixup,sct,indx,indy,nyi,ny,nxhd,nyd,nxhyd
      1,nxyhd)
@@ -2100,6 +5298,215 @@ c then transform in y
 !$OMP END PARALLEL DO
       return
       end
+c-----------------------------------------------------------------------
+      subroutine FFT2RMXYB(f,isign,mixup,sct,indx,indy,nxi,nxp,nxhd,nyd,
+     1nxhyd,nxyhd)
+c this subroutine performs the y part of a two dimensional real to
+c complex fast fourier transform and its inverse, for a subset of x,
+c using complex arithmetic, with OpenMP, for large grids.
+c blocks of nblk columns are copied in bit-reversed order to a
+c contiguous transposed scratch array in each thread, transformed
+c with unit stride, and then copied back.  this replaces the stride
+c nxhd memory accesses in FFT2RMXY with unit stride accesses.
+c arguments and results are the same as for FFT2RMXY
+      implicit none
+      integer isign, indx, indy, nxi, nxp, nxhd, nyd, nxhyd, nxyhd
+      complex f, sct
+      integer mixup
+      dimension f(nxhd,nyd), mixup(nxhyd), sct(nxyhd)
+c local data
+      integer nblk
+      parameter(nblk=8)
+      integer indx1, indx1y, nx, ny, nyh, ny2, nxy, nxhy, nxt
+      integer nry, nryb, nyv, i, k, k1, ii, nb
+      complex t1
+c g = scratch array for block of columns, padded by one cache line
+c to avoid associativity conflicts when ny is a large power of 2
+      complex g
+      dimension g(nyd+8,nblk)
+      if (isign.eq.0) return
+      indx1 = indx - 1
+      indx1y = max0(indx1,indy)
+      nx = 2**indx
+      ny = 2**indy
+      nyh = ny/2
+      ny2 = ny + 2
+      nxy = max0(nx,ny)
+      nxhy = 2**indx1y
+      nxt = nxi + nxp - 1
+      nryb = nxhy/ny
+      nry = nxy/ny
+      nyv = nyd + 8
+c scramble modes kx = 0, nx/2
+      if ((isign.gt.0).and.(nxi.eq.1)) then
+         do 10 k = 2, nyh
+         t1 = cmplx(aimag(f(1,ny2-k)),real(f(1,ny2-k)))
+         f(1,ny2-k) = conjg(f(1,k) - t1)
+         f(1,k) = f(1,k) + t1
+   10    continue
+      endif
+!$OMP PARALLEL DO
+!$OMP& PRIVATE(i,k,k1,ii,nb,g)
+      do 60 i = nxi, nxt, nblk
+      nb = min0(nblk,nxt-i+1)
+c copy block of columns to scratch array, with bit-reversal in y
+      do 30 k = 1, ny
+      k1 = (mixup(k) - 1)/nryb + 1
+      do 20 ii = 1, nb
+      g(k,ii) = f(i+ii-1,k1)
+   20 continue
+   30 continue
+c then transform in y
+      call FFT1YB(g,isign,sct,indy,nry,nb,nyv,nxyhd)
+c copy transformed columns back
+      do 50 k = 1, ny
+      do 40 ii = 1, nb
+      f(i+ii-1,k) = g(k,ii)
+   40 continue
+   50 continue
+   60 continue
+!$OMP END PARALLEL DO
+c unscramble modes kx = 0, nx/2
+      if ((isign.lt.0).and.(nxi.eq.1)) then
+         do 70 k = 2, nyh
+         t1 = f(1,ny2-k)
+         f(1,ny2-k) = 0.5*cmplx(aimag(f(1,k) + t1),real(f(1,k) - t1))
+         f(1,k) = 0.5*cmplx(real(f(1,k) + t1),aimag(f(1,k) - t1))
+   70    continue
+      endif
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine FFT2RM2YB(f,isign,mixup,sct,indx,indy,nxi,nxp,nxhd,nyd,
+     1nxhyd,nxyhd)
+c this subroutine performs the y part of 2 two dimensional real to
+c complex fast fourier transforms, and their inverses, for a subset of
+c x, using complex arithmetic, with OpenMP, for large grids.
+c blocks of nblk columns of both components are copied in
+c bit-reversed order to a contiguous transposed scratch array in each
+c thread, transformed with unit stride, and then copied back.
+c arguments and results are the same as for FFT2RM2Y
+      implicit none
+      integer isign, indx, indy, nxi, nxp, nxhd, nyd, nxhyd, nxyhd
+      complex f, sct
+      integer mixup
+      dimension f(2,nxhd,nyd), mixup(nxhyd), sct(nxyhd)
+c local data
+      integer nblk
+      parameter(nblk=8)
+      integer indx1, indx1y, nx, ny, nyh, ny2, nxy, nxhy, nxt
+      integer nry, nryb, nyv, i, k, k1, ii, jj, nb
+      complex t1
+c g = scratch array for block of columns, padded by one cache line
+c to avoid associativity conflicts when ny is a large power of 2
+      complex g
+      dimension g(nyd+8,2*nblk)
+      if (isign.eq.0) return
+      indx1 = indx - 1
+      indx1y = max0(indx1,indy)
+      nx = 2**indx
+      ny = 2**indy
+      nyh = ny/2
+      ny2 = ny + 2
+      nxy = max0(nx,ny)
+      nxhy = 2**indx1y
+      nxt = nxi + nxp - 1
+      nryb = nxhy/ny
+      nry = nxy/ny
+      nyv = nyd + 8
+c scramble modes kx = 0, nx/2
+      if ((isign.gt.0).and.(nxi.eq.1)) then
+         do 20 k = 2, nyh
+         do 10 jj = 1, 2
+         t1 = cmplx(aimag(f(jj,1,ny2-k)),real(f(jj,1,ny2-k)))
+         f(jj,1,ny2-k) = conjg(f(jj,1,k) - t1)
+         f(jj,1,k) = f(jj,1,k) + t1
+   10    continue
+   20    continue
+      endif
+!$OMP PARALLEL DO
+!$OMP& PRIVATE(i,k,k1,ii,jj,nb,g)
+      do 90 i = nxi, nxt, nblk
+      nb = min0(nblk,nxt-i+1)
+c copy block of columns to scratch array, with bit-reversal in y
+      do 50 k = 1, ny
+      k1 = (mixup(k) - 1)/nryb + 1
+      do 40 ii = 1, nb
+      do 30 jj = 1, 2
+      g(k,jj+2*(ii-1)) = f(jj,i+ii-1,k1)
+   30 continue
+   40 continue
+   50 continue
+c then transform in y
+      call FFT1YB(g,isign,sct,indy,nry,2*nb,nyv,nxyhd)
+c copy transformed columns back
+      do 80 k = 1, ny
+      do 70 ii = 1, nb
+      do 60 jj = 1, 2
+      f(jj,i+ii-1,k) = g(k,jj+2*(ii-1))
+   60 continue
+   70 continue
+   80 continue
+   90 continue
+!$OMP END PARALLEL DO
+c unscramble modes kx = 0, nx/2
+      if ((isign.lt.0).and.(nxi.eq.1)) then
+         do 110 k = 2, nyh
+         do 100 jj = 1, 2
+         t1 = f(jj,1,ny2-k)
+         f(jj,1,ny2-k) = 0.5*cmplx(aimag(f(jj,1,k) + t1),
+     1                             real(f(jj,1,k) - t1))
+         f(jj,1,k) = 0.5*cmplx(real(f(jj,1,k) + t1),
+     1                         aimag(f(jj,1,k) - t1))
+  100    continue
+  110    continue
+      endif
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine FFT1YB(g,isign,sct,indy,nry,nc,nyv,nxyhd)
+c this subroutine performs the butterflies for nc one dimensional
+c complex fast fourier transforms of length ny=2**indy, stored
+c contiguously in g(k,i), where the data is already bit-reversed
+c if isign = -1, inverse fourier transforms are performed
+c if isign = 1, forward fourier transforms are performed
+c sct = sine/cosine table
+c nry = stride in sct for the longest butterfly
+c nc = number of transforms
+c nyv = first dimension of g >= ny
+c nxyhd = maximum of (nx,ny)/2
+      implicit none
+      integer isign, indy, nry, nc, nyv, nxyhd
+      complex g, sct
+      dimension g(nyv,nc), sct(nxyhd)
+c local data
+      integer ny, nyh, i, j, k, l, j1, j2, k1, k2, ns, ns2, km, kmr
+      complex t1, t2
+      ny = 2**indy
+      nyh = ny/2
+      do 40 i = 1, nc
+      do 30 l = 1, indy
+      ns = 2**(l - 1)
+      ns2 = ns + ns
+      km = nyh/ns
+      kmr = km*nry
+      do 20 k = 1, km
+      k1 = ns2*(k - 1)
+      k2 = k1 + ns
+      do 10 j = 1, ns
+      j1 = j + k1
+      j2 = j + k2
+      t1 = sct(1+kmr*(j-1))
+      if (isign.gt.0) t1 = conjg(t1)
+      t2 = t1*g(j2,i)
+      g(j2,i) = g(j1,i) - t2
+      g(j1,i) = g(j1,i) + t2
+   10 continue
+   20 continue
+   30 continue
+   40 continue
+      return
+      end
 c-----------------------------------------------------------------------
       function ranorm()
 c this program calculates a random number y from a gaussian distribution
@@ -27,10 +27,20 @@ void cgppushf2l(float ppart[], float fxy[], int kpic[], int ncl[],
                 int nppmx, int nx, int ny, int mx, int my, int nxv,
                 int nyv, int mx1, int mxy1, int ntmax, int *irc);
 
+void cgppushfq2l(float ppart[], float fxy[], float q[], int kpic[],
+                 int ncl[], int ihole[], float qbm, float qm, float dt,
+                 float *ek, int idimp, int nppmx, int nx, int ny,
+                 int mx, int my, int nxv, int nyv, int mx1, int mxy1,
+                 int ntmax, int *irc);
+
 void cgppost2l(float ppart[], float q[], int kpic[], float qm,
                int nppmx, int idimp, int mx, int my, int nxv, int nyv,
                int mx1, int mxy1);
 
+void cgppost2lh(float ppart[], float q[], float qh[], int kpic[],
+                float qm, int nppmx, int idimp, int mx, int my, int nxv,
+                int nyv, int mx1, int mxy1);
+
 void cpporder2l(float ppart[], float ppbuff[], int kpic[], int ncl[],
                 int ihole[], int idimp, int nppmx, int nx, int ny,
                 int mx, int my, int mx1, int my1, int npbmx, int ntmax,
@@ -40,6 +50,80 @@ void cpporderf2l(float ppart[], float ppbuff[], int kpic[], int ncl[],
                  int ihole[], int idimp, int nppmx, int mx1, int my1,
                  int npbmx, int ntmax, int *irc);
 
+void cppsizef2l(int kpic[], int ncl[], int *nppmx, int *nbmx, int mx1,
+                int my1);
+
+void cppgrow2l(float ppart[], int kpic[], int idimp, int nppmx,
+               int nppmxn, int mxy1);
+
+void cpphole2l(float ppart[], int kpic[], int ncl[], int ihole[],
+               int idimp, int nppmx, int mx, int my, int mx1, int my1,
+               int ntmax, int *irc);
+
+void cppmovin2lt(float part[], float ppart[], int kpic[], int nppmx,
+                 int idimp, int nop, int mx, int my, int mx1, int mxy1,
+                 int *irc);
+
+void cppcheck2lt(float ppart[], int kpic[], int idimp, int nppmx, int nx,
+                 int ny, int mx, int my, int mx1, int my1, 
+                 int *irc);
+
+void cgppush2lt(float ppart[], float fxy[], int kpic[], float qbm,
+                float dt, float *ek, int idimp, int nppmx, int nx,
+                int ny, int mx, int my, int nxv, int nyv, int mx1,
+                int mxy1, int ipbc);
+
+void cgppushf2lt(float ppart[], float fxy[], int kpic[], int ncl[],
+                 int ihole[], float qbm, float dt, float *ek, int idimp,
+                 int nppmx, int nx, int ny, int mx, int my, int nxv,
+                 int nyv, int mx1, int mxy1, int ntmax, int *irc);
+
+void cvgppush2lt(float ppart[], float fxy[], int kpic[], float qbm,
+                 float dt, float *ek, int idimp, int nppmx, int nx,
+                 int ny, int mx, int my, int nxv, int nyv, int mx1,
+                 int mxy1, int ipbc);
+
+void cvgppushf2lt(float ppart[], float fxy[], int kpic[], int ncl[],
+                  int ihole[], float qbm, float dt, float *ek,
+                  int idimp, int nppmx, int nx, int ny, int mx, int my,
+                  int nxv, int nyv, int mx1, int mxy1, int ntmax,
+                  int *irc);
+
+void cgppost2lt(float ppart[], float q[], int kpic[], float qm,
+                int nppmx, int idimp, int mx, int my, int nxv, int nyv,
+                int mx1, int mxy1);
+
+void cvgppost2lt(float ppart[], float q[], int kpic[], float qm,
+                 int nppmx, int idimp, int mx, int my, int nxv, int nyv,
+                 int mx1, int mxy1);
+
+void cviscan2(int *isdata, int *mb, int nths);
+
+void cpporder2lt(float ppart[], float ppbuff[], int kpic[], int ncl[],
+                 int ihole[], int idimp, int nppmx, int nx, int ny,
+                 int mx, int my, int mx1, int my1, int npbmx, int ntmax,
+                 int *irc);
+
+void cpporderf2lt(float ppart[], float ppbuff[], int kpic[], int ncl[],
+                  int ihole[], int idimp, int nppmx, int mx1, int my1,
+                  int npbmx, int ntmax, int *irc);
+
+void cvpporder2lt(float ppart[], float ppbuff[], int kpic[], int ncl[],
+                  int ihole[], int idimp, int nppmx, int nx, int ny,
+                  int mx, int my, int mx1, int my1, int npbmx,
+                  int ntmax, int *irc);
+
+void cvpporderf2lt(float ppart[], float ppbuff[], int kpic[], int ncl[],
+                   int ihole[], int idimp, int nppmx, int mx1, int my1,
+                   int npbmx, int ntmax, int *irc);
+
+void cppgrow2lt(float ppart[], int kpic[], int idimp, int nppmx,
+                int nppmxn, int mxy1);
+
+void cpphole2lt(float ppart[], int kpic[], int ncl[], int ihole[],
+                int idimp, int nppmx, int mx, int my, int mx1, int my1,
+                int ntmax, int *irc);
+
 void ccguard2l(float fxy[], int nx, int ny, int nxe, int nye);
 
 void caguard2l(float q[], int nx, int ny, int nxe, int nye);
@@ -68,6 +152,14 @@ void cfft2rm2y(float complex f[], int isign, int mixup[],
                float complex sct[], int indx, int indy, int nxi,
                int nxp, int nxhd, int nyd, int nxhyd, int nxyhd);
 
+void cfft2rmxyb(float complex f[], int isign, int mixup[],
+                float complex sct[], int indx, int indy, int nxi,
+                int nxp, int nxhd, int nyd, int nxhyd, int nxyhd);
+
+void cfft2rm2yb(float complex f[], int isign, int mixup[],
+                float complex sct[], int indx, int indy, int nxi,
+                int nxp, int nxhd, int nyd, int nxhyd, int nxyhd);
+
 void cwfft2rmx(float complex f[], int isign, int mixup[],
                float complex sct[], int indx, int indy, int nxhd,
                int nyd, int nxhyd, int nxyhd);
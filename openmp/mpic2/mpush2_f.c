@@ -33,6 +33,12 @@ void gppushf2l_(float *ppart, float *fxy, int *kpic, int *ncl,
                 int *my, int *nxv, int *nyv, int *mx1, int *mxy1,
                 int *ntmax, int *irc);
 
+void gppushfq2l_(float *ppart, float *fxy, float *q, int *kpic,
+                 int *ncl, int *ihole, float *qbm, float *qm, float *dt,
+                 float *ek, int *idimp, int *nppmx, int *nx, int *ny,
+                 int *mx, int *my, int *nxv, int *nyv, int *mx1,
+                 int *mxy1, int *ntmax, int *irc);
+
 void gppost2l_(float *ppart, float *q, int *kpic, float *qm,
                int *nppmx, int *idimp, int *mx, int *my, int *nxv,
                int *nyv, int *mx1, int *mxy1);
@@ -41,6 +47,10 @@ void cguard2l_(float *fxy, int *nx, int *ny, int *nxe, int *nye);
 
 void aguard2l_(float *q, int *nx, int *ny, int *nxe, int *nye);
 
+void gppost2lh_(float *ppart, float *q, float *qh, int *kpic,
+                float *qm, int *nppmx, int *idimp, int *mx, int *my,
+                int *nxv, int *nyv, int *mx1, int *mxy1);
+
 void pporder2l_(float *ppart, float *ppbuff, int *kpic, int *ncl,
                 int *ihole, int *idimp, int *nppmx, int *nx, int *ny,
                 int *mx, int *my, int *mx1, int *my1, int *npbmx,
@@ -50,6 +60,81 @@ void pporderf2l_(float *ppart, float *ppbuff, int *kpic, int *ncl,
                  int *ihole, int *idimp, int *nppmx, int *mx1,
                  int *my1, int *npbmx, int *ntmax, int *irc);
 
+void ppsizef2l_(int *kpic, int *ncl, int *nppmx, int *nbmx, int *mx1,
+                int *my1);
+
+void ppgrow2l_(float *ppart, int *kpic, int *idimp, int *nppmx,
+               int *nppmxn, int *mxy1);
+
+void pphole2l_(float *ppart, int *kpic, int *ncl, int *ihole,
+               int *idimp, int *nppmx, int *mx, int *my, int *mx1,
+               int *my1, int *ntmax, int *irc);
+
+void ppmovin2lt_(float *part, float *ppart, int *kpic, int *nppmx,
+                 int *idimp, int *nop, int *mx, int *my, int *mx1,
+                 int *mxy1, int *irc);
+
+void ppcheck2lt_(float *ppart, int *kpic, int *idimp, int *nppmx,
+                 int *nx, int *ny, int *mx, int *my, int *mx1, int *my1,
+                 int *irc);
+
+void gppush2lt_(float *ppart, float *fxy, int *kpic, float *qbm,
+                float *dt, float *ek, int *idimp, int *nppmx, int *nx,
+                int *ny, int *mx, int *my, int *nxv, int *nyv, int *mx1,
+                int *mxy1, int *ipbc);
+
+void gppushf2lt_(float *ppart, float *fxy, int *kpic, int *ncl,
+                 int *ihole, float *qbm, float *dt, float *ek,
+                 int *idimp, int *nppmx, int *nx, int *ny, int *mx,
+                 int *my, int *nxv, int *nyv, int *mx1, int *mxy1,
+                 int *ntmax, int *irc);
+
+void vgppush2lt_(float *ppart, float *fxy, int *kpic, float *qbm,
+                 float *dt, float *ek, int *idimp, int *nppmx, int *nx,
+                 int *ny, int *mx, int *my, int *nxv, int *nyv,
+                 int *mx1, int *mxy1, int *ipbc);
+
+void vgppushf2lt_(float *ppart, float *fxy, int *kpic, int *ncl,
+                  int *ihole, float *qbm, float *dt, float *ek,
+                  int *idimp, int *nppmx, int *nx, int *ny, int *mx,
+                  int *my, int *nxv, int *nyv, int *mx1, int *mxy1,
+                  int *ntmax, int *irc);
+
+void gppost2lt_(float *ppart, float *q, int *kpic, float *qm,
+                int *nppmx, int *idimp, int *mx, int *my, int *nxv,
+                int *nyv, int *mx1, int *mxy1);
+
+void vgppost2lt_(float *ppart, float *q, int *kpic, float *qm,
+                 int *nppmx, int *idimp, int *mx, int *my, int *nxv,
+                 int *nyv, int *mx1, int *mxy1);
+
+void viscan2_(int *isdata, int *mb, int *nths);
+
+void pporder2lt_(float *ppart, float *ppbuff, int *kpic, int *ncl,
+                 int *ihole, int *idimp, int *nppmx, int *nx, int *ny,
+                 int *mx, int *my, int *mx1, int *my1, int *npbmx,
+                 int *ntmax, int *irc);
+
+void pporderf2lt_(float *ppart, float *ppbuff, int *kpic, int *ncl,
+                  int *ihole, int *idimp, int *nppmx, int *mx1,
+                  int *my1, int *npbmx, int *ntmax, int *irc);
+
+void vpporder2lt_(float *ppart, float *ppbuff, int *kpic, int *ncl,
+                   int *ihole, int *idimp, int *nppmx, int *nx, int *ny,
+                   int *mx, int *my, int *mx1, int *my1, int *npbmx,
+                   int *ntmax, int *irc);
+
+void vpporderf2lt_(float *ppart, float *ppbuff, int *kpic, int *ncl,
+                   int *ihole, int *idimp, int *nppmx, int *mx1,
+                   int *my1, int *npbmx, int *ntmax, int *irc);
+
+void ppgrow2lt_(float *ppart, int *kpic, int *idimp, int *nppmx,
+                int *nppmxn, int *mxy1);
+
+void pphole2lt_(float *ppart, int *kpic, int *ncl, int *ihole,
+                int *idimp, int *nppmx, int *mx, int *my, int *mx1,
+                int *my1, int *ntmax, int *irc);
+
 void mpois22_(float complex *q, float complex *fxy, int *isign,
               float complex *ffc, float *ax, float *ay, float *affp,
               float *we, int *nx, int *ny, int *nxvh, int *nyv,
@@ -74,6 +159,14 @@ void fft2rm2y_(float complex *f, int *isign, int *mixup,
                float complex *sct, int *indx, int *indy, int *nxi,
                int *nxp, int *nxhd, int *nyd, int *nxhyd, int *nxyhd);
 
+void fft2rmxyb_(float complex *f, int *isign, int *mixup,
+                float complex *sct, int *indx, int *indy, int *nxi,
+                int *nxp, int *nxhd, int *nyd, int *nxhyd, int *nxyhd);
+
+void fft2rm2yb_(float complex *f, int *isign, int *mixup,
+                float complex *sct, int *indx, int *indy, int *nxi,
+                int *nxp, int *nxhd, int *nyd, int *nxhyd, int *nxyhd);
+
 void wfft2rmx_(float complex *f, int *isign, int *mixup,
                float complex *sct, int *indx, int *indy, int *nxhd,
                int *nyd, int *nxhyd, int *nxyhd);
@@ -141,6 +234,17 @@ void cgppushf2l(float ppart[], float fxy[], int kpic[], int ncl[],
    return;
 }
 
+/*--------------------------------------------------------------------*/
+void cgppushfq2l(float ppart[], float fxy[], float q[], int kpic[],
+                 int ncl[], int ihole[], float qbm, float qm, float dt,
+                 float *ek, int idimp, int nppmx, int nx, int ny,
+                 int mx, int my, int nxv, int nyv, int mx1, int mxy1,
+                 int ntmax, int *irc) {
+   gppushfq2l_(ppart,fxy,q,kpic,ncl,ihole,&qbm,&qm,&dt,ek,&idimp,&nppmx,
+               &nx,&ny,&mx,&my,&nxv,&nyv,&mx1,&mxy1,&ntmax,irc);
+   return;
+}
+
 /*--------------------------------------------------------------------*/
 void cgppost2l(float ppart[], float q[], int kpic[], float qm,
                int nppmx, int idimp, int mx, int my, int nxv, int nyv,
@@ -150,6 +254,15 @@ void cgppost2l(float ppart[], float q[], int kpic[], float qm,
    return;
 }
 
+/*--------------------------------------------------------------------*/
+void cgppost2lh(float ppart[], float q[], float qh[], int kpic[],
+                float qm, int nppmx, int idimp, int mx, int my, int nxv,
+                int nyv, int mx1, int mxy1) {
+   gppost2lh_(ppart,q,qh,kpic,&qm,&nppmx,&idimp,&mx,&my,&nxv,&nyv,&mx1,
+              &mxy1);
+   return;
+}
+
 /*--------------------------------------------------------------------*/
 void cpporder2l(float ppart[], float ppbuff[], int kpic[], int ncl[],
                 int ihole[], int idimp, int nppmx, int nx, int ny,
@@ -169,6 +282,165 @@ void cpporderf2l(float ppart[], float ppbuff[], int kpic[], int ncl[],
    return;
 }
 
+/*--------------------------------------------------------------------*/
+void cppsizef2l(int kpic[], int ncl[], int *nppmx, int *nbmx, int mx1,
+                int my1) {
+   ppsizef2l_(kpic,ncl,nppmx,nbmx,&mx1,&my1);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppgrow2l(float ppart[], int kpic[], int idimp, int nppmx,
+               int nppmxn, int mxy1) {
+   ppgrow2l_(ppart,kpic,&idimp,&nppmx,&nppmxn,&mxy1);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cpphole2l(float ppart[], int kpic[], int ncl[], int ihole[],
+               int idimp, int nppmx, int mx, int my, int mx1, int my1,
+               int ntmax, int *irc) {
+   pphole2l_(ppart,kpic,ncl,ihole,&idimp,&nppmx,&mx,&my,&mx1,&my1,
+             &ntmax,irc);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppmovin2lt(float part[], float ppart[], int kpic[], int nppmx,
+                 int idimp, int nop, int mx, int my, int mx1, int mxy1,
+                 int *irc) {
+   ppmovin2lt_(part,ppart,kpic,&nppmx,&idimp,&nop,&mx,&my,&mx1,&mxy1,
+               irc);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppcheck2lt(float ppart[], int kpic[], int idimp, int nppmx, int nx,
+                 int ny, int mx, int my, int mx1, int my1, 
+                 int *irc) {
+   ppcheck2lt_(ppart,kpic,&idimp,&nppmx,&nx,&ny,&mx,&my,&mx1,&my1,irc);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cgppush2lt(float ppart[], float fxy[], int kpic[], float qbm,
+                float dt, float *ek, int idimp, int nppmx, int nx,
+                int ny, int mx, int my, int nxv, int nyv, int mx1,
+                int mxy1, int ipbc) {
+   gppush2lt_(ppart,fxy,kpic,&qbm,&dt,ek,&idimp,&nppmx,&nx,&ny,&mx,&my,
+              &nxv,&nyv,&mx1,&mxy1,&ipbc);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cgppushf2lt(float ppart[], float fxy[], int kpic[], int ncl[],
+                 int ihole[], float qbm, float dt, float *ek, int idimp,
+                 int nppmx, int nx, int ny, int mx, int my, int nxv,
+                 int nyv, int mx1, int mxy1, int ntmax, int *irc) {
+   gppushf2lt_(ppart,fxy,kpic,ncl,ihole,&qbm,&dt,ek,&idimp,&nppmx,&nx,
+               &ny,&mx,&my,&nxv,&nyv,&mx1,&mxy1,&ntmax,irc);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cvgppush2lt(float ppart[], float fxy[], int kpic[], float qbm,
+                 float dt, float *ek, int idimp, int nppmx, int nx,
+                 int ny, int mx, int my, int nxv, int nyv, int mx1,
+                 int mxy1, int ipbc) {
+   vgppush2lt_(ppart,fxy,kpic,&qbm,&dt,ek,&idimp,&nppmx,&nx,&ny,&mx,&my,
+               &nxv,&nyv,&mx1,&mxy1,&ipbc);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cvgppushf2lt(float ppart[], float fxy[], int kpic[], int ncl[],
+                  int ihole[], float qbm, float dt, float *ek,
+                  int idimp, int nppmx, int nx, int ny, int mx, int my,
+                  int nxv, int nyv, int mx1, int mxy1, int ntmax,
+                  int *irc) {
+   vgppushf2lt_(ppart,fxy,kpic,ncl,ihole,&qbm,&dt,ek,&idimp,&nppmx,&nx,
+                &ny,&mx,&my,&nxv,&nyv,&mx1,&mxy1,&ntmax,irc);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cgppost2lt(float ppart[], float q[], int kpic[], float qm,
+                int nppmx, int idimp, int mx, int my, int nxv, int nyv,
+                int mx1, int mxy1) {
+   gppost2lt_(ppart,q,kpic,&qm,&nppmx,&idimp,&mx,&my,&nxv,&nyv,&mx1,
+              &mxy1);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cvgppost2lt(float ppart[], float q[], int kpic[], float qm,
+                 int nppmx, int idimp, int mx, int my, int nxv, int nyv,
+                 int mx1, int mxy1) {
+   vgppost2lt_(ppart,q,kpic,&qm,&nppmx,&idimp,&mx,&my,&nxv,&nyv,&mx1,
+               &mxy1);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cviscan2(int *isdata, int *mb, int nths) {
+   viscan2_(isdata,mb,&nths);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cpporder2lt(float ppart[], float ppbuff[], int kpic[], int ncl[],
+                 int ihole[], int idimp, int nppmx, int nx, int ny,
+                 int mx, int my, int mx1, int my1, int npbmx, int ntmax,
+                 int *irc) {
+   pporder2lt_(ppart,ppbuff,kpic,ncl,ihole,&idimp,&nppmx,&nx,&ny,&mx,
+               &my,&mx1,&my1,&npbmx,&ntmax,irc);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cpporderf2lt(float ppart[], float ppbuff[], int kpic[], int ncl[],
+                  int ihole[], int idimp, int nppmx, int mx1, int my1,
+                  int npbmx, int ntmax, int *irc) {
+   pporderf2lt_(ppart,ppbuff,kpic,ncl,ihole,&idimp,&nppmx,&mx1,&my1,
+                &npbmx,&ntmax,irc);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cvpporder2lt(float ppart[], float ppbuff[], int kpic[], int ncl[],
+                  int ihole[], int idimp, int nppmx, int nx, int ny,
+                  int mx, int my, int mx1, int my1, int npbmx,
+                  int ntmax, int *irc) {
+   vpporder2lt_(ppart,ppbuff,kpic,ncl,ihole,&idimp,&nppmx,&nx,&ny,&mx,
+                &my,&mx1,&my1,&npbmx,&ntmax,irc);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cvpporderf2lt(float ppart[], float ppbuff[], int kpic[], int ncl[],
+                   int ihole[], int idimp, int nppmx, int mx1, int my1,
+                   int npbmx, int ntmax, int *irc) {
+   vpporderf2lt_(ppart,ppbuff,kpic,ncl,ihole,&idimp,&nppmx,&mx1,&my1,
+                 &npbmx,&ntmax,irc);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppgrow2lt(float ppart[], int kpic[], int idimp, int nppmx,
+                int nppmxn, int mxy1) {
+   ppgrow2lt_(ppart,kpic,&idimp,&nppmx,&nppmxn,&mxy1);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cpphole2lt(float ppart[], int kpic[], int ncl[], int ihole[],
+                int idimp, int nppmx, int mx, int my, int mx1, int my1,
+                int ntmax, int *irc) {
+   pphole2lt_(ppart,kpic,ncl,ihole,&idimp,&nppmx,&mx,&my,&mx1,&my1,
+              &ntmax,irc);
+   return;
+}
+
 /*--------------------------------------------------------------------*/
 void ccguard2l(float fxy[], int nx, int ny, int nxe, int nye) {
    cguard2l_(fxy,&nx,&ny,&nxe,&nye);
@@ -235,6 +507,24 @@ void cfft2rm2y(float complex f[], int isign, int mixup[],
    return;
 }
 
+/*--------------------------------------------------------------------*/
+void cfft2rmxyb(float complex f[], int isign, int mixup[],
+                float complex sct[], int indx, int indy, int nxi,
+                int nxp, int nxhd, int nyd, int nxhyd, int nxyhd) {
+   fft2rmxyb_(f,&isign,mixup,sct,&indx,&indy,&nxi,&nxp,&nxhd,&nyd,&nxhyd,
+              &nxyhd);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cfft2rm2yb(float complex f[], int isign, int mixup[],
+                float complex sct[], int indx, int indy, int nxi,
+                int nxp, int nxhd, int nyd, int nxhyd, int nxyhd) {
+   fft2rm2yb_(f,&isign,mixup,sct,&indx,&indy,&nxi,&nxp,&nxhd,&nyd,&nxhyd,
+              &nxyhd);
+   return;
+}
+
 /*--------------------------------------------------------------------*/
 void cwfft2rmx(float complex f[], int isign, int mixup[],
                float complex sct[], int indx, int indy, int nxhd,
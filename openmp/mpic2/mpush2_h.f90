@@ -77,6 +77,24 @@
          integer, dimension(2,ntmax+1,mxy1), intent(inout) :: ihole
          end subroutine
       end interface
+!
+      interface
+         subroutine GPPUSHFQ2L(ppart,fxy,q,kpic,ncl,ihole,qbm,qm,dt,ek, &
+     &idimp,nppmx,nx,ny,mx,my,nxv,nyv,mx1,mxy1,ntmax,irc)
+         implicit none
+         integer, intent(in) :: idimp, nppmx, nx, ny, mx, my, nxv, nyv
+         integer, intent(in) :: mx1, mxy1, ntmax
+         integer, intent(inout) :: irc
+         real, intent(in) :: qbm, qm, dt
+         real, intent(inout) :: ek
+         real, dimension(idimp,nppmx,mxy1), intent(inout) :: ppart
+         real, dimension(2,nxv,nyv), intent(in) :: fxy
+         real, dimension(nxv,nyv), intent(inout) :: q
+         integer, dimension(mxy1), intent(in) :: kpic
+         integer, dimension(8,mxy1), intent(inout) :: ncl
+         integer, dimension(2,ntmax+1,mxy1), intent(inout) :: ihole
+         end subroutine
+      end interface
 !
       interface
          subroutine GPPOST2L(ppart,q,kpic,qm,nppmx,idimp,mx,my,nxv,nyv, &
@@ -90,6 +108,20 @@
          integer, dimension(mxy1), intent(in) :: kpic
          end subroutine
       end interface
+!
+      interface
+         subroutine GPPOST2LH(ppart,q,qh,kpic,qm,nppmx,idimp,mx,my,nxv, &
+     &nyv,mx1,mxy1)
+         implicit none
+         integer, intent(in) :: nppmx, idimp, mx, my, nxv, nyv
+         integer, intent(in) :: mx1, mxy1
+         real, intent(in) :: qm
+         real, dimension(idimp,nppmx,mxy1), intent(in) :: ppart
+         real, dimension(nxv,nyv), intent(inout) :: q
+         real, dimension(2*(mx+my),mxy1), intent(inout) :: qh
+         integer, dimension(mxy1), intent(in) :: kpic
+         end subroutine
+      end interface
 !
       interface
          subroutine PPORDER2L(ppart,ppbuff,kpic,ncl,ihole,idimp,nppmx,nx&
@@ -119,6 +151,221 @@
          integer, dimension(2,ntmax+1,mx1*my1), intent(in) :: ihole
          end subroutine
       end interface
+!
+      interface
+         subroutine PPSIZEF2L(kpic,ncl,nppmx,nbmx,mx1,my1)
+         implicit none
+         integer :: nppmx, nbmx, mx1, my1
+         integer, dimension(mx1*my1) :: kpic
+         integer, dimension(8,mx1*my1) :: ncl
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPGROW2L(ppart,kpic,idimp,nppmx,nppmxn,mxy1)
+         implicit none
+         integer :: idimp, nppmx, nppmxn, mxy1
+         real, dimension(idimp*nppmxn*mxy1) :: ppart
+         integer, dimension(mxy1) :: kpic
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPHOLE2L(ppart,kpic,ncl,ihole,idimp,nppmx,mx,my,mx1,&
+     &my1,ntmax,irc)
+         implicit none
+         integer :: idimp, nppmx, mx, my, mx1, my1, ntmax, irc
+         real, dimension(idimp,nppmx,mx1*my1) :: ppart
+         integer, dimension(mx1*my1) :: kpic
+         integer, dimension(8,mx1*my1) :: ncl
+         integer, dimension(2,ntmax+1,mx1*my1) :: ihole
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPMOVIN2LT(part,ppart,kpic,nppmx,idimp,nop,mx,my,mx1&
+     &,mxy1,irc)
+         implicit none
+         integer :: nppmx, idimp, nop, mx, my, mx1, mxy1, irc
+         real, dimension(idimp,nop) :: part
+         real, dimension(nppmx,idimp,mxy1) :: ppart
+         integer, dimension(mxy1) :: kpic
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPCHECK2LT(ppart,kpic,idimp,nppmx,nx,ny,mx,my,mx1,  &
+     &my1,irc)
+         implicit none
+         integer :: idimp, nppmx, nx, ny, mx, my, mx1, my1, irc
+         real, dimension(nppmx,idimp,mx1*my1) :: ppart
+         integer, dimension(mx1*my1) :: kpic
+         end subroutine
+      end interface
+!
+      interface
+         subroutine GPPUSH2LT(ppart,fxy,kpic,qbm,dt,ek,idimp,nppmx,nx,ny&
+     &,mx,my,nxv,nyv,mx1,mxy1,ipbc)
+         implicit none
+         integer :: idimp, nppmx, nx, ny, mx, my, nxv, nyv, mx1, mxy1
+         integer :: ipbc
+         real :: qbm, dt, ek
+         real, dimension(nppmx,idimp,mxy1) :: ppart
+         real, dimension(2,nxv*nyv) :: fxy
+         integer, dimension(mxy1) :: kpic
+         end subroutine
+      end interface
+!
+      interface
+         subroutine GPPUSHF2LT(ppart,fxy,kpic,ncl,ihole,qbm,dt,ek,idimp,&
+     &nppmx,nx,ny,mx,my,nxv,nyv,mx1,mxy1,ntmax,irc)
+         implicit none
+         integer :: idimp, nppmx, nx, ny, mx, my, nxv, nyv, mx1, mxy1
+         integer :: ntmax, irc
+         real :: qbm, dt, ek
+         real, dimension(nppmx,idimp,mxy1) :: ppart
+         real, dimension(2,nxv*nyv) :: fxy
+         integer, dimension(mxy1) :: kpic
+         integer, dimension(8,mxy1) :: ncl
+         integer, dimension(2,ntmax+1,mxy1) :: ihole
+         end subroutine
+      end interface
+!
+      interface
+         subroutine VGPPUSH2LT(ppart,fxy,kpic,qbm,dt,ek,idimp,nppmx,nx, &
+     &ny,mx,my,nxv,nyv,mx1,mxy1,ipbc)
+         implicit none
+         integer :: idimp, nppmx, nx, ny, mx, my, nxv, nyv, mx1, mxy1
+         integer :: ipbc
+         real :: qbm, dt, ek
+         real, dimension(nppmx,idimp,mxy1) :: ppart
+         real, dimension(2,nxv*nyv) :: fxy
+         integer, dimension(mxy1) :: kpic
+         end subroutine
+      end interface
+!
+      interface
+         subroutine VGPPUSHF2LT(ppart,fxy,kpic,ncl,ihole,qbm,dt,ek,idimp&
+     &,nppmx,nx,ny,mx,my,nxv,nyv,mx1,mxy1,ntmax,irc)
+         implicit none
+         integer :: idimp, nppmx, nx, ny, mx, my, nxv, nyv, mx1, mxy1
+         integer :: ntmax, irc
+         real :: qbm, dt, ek
+         real, dimension(nppmx,idimp,mxy1) :: ppart
+         real, dimension(2,nxv*nyv) :: fxy
+         integer, dimension(mxy1) :: kpic
+         integer, dimension(8,mxy1) :: ncl
+         integer, dimension(2,ntmax+1,mxy1) :: ihole
+         end subroutine
+      end interface
+!
+      interface
+         subroutine GPPOST2LT(ppart,q,kpic,qm,nppmx,idimp,mx,my,nxv,nyv,&
+     &mx1,mxy1)
+         implicit none
+         integer :: nppmx, idimp, mx, my, nxv, nyv, mx1, mxy1
+         real :: qm
+         real, dimension(nppmx,idimp,mxy1) :: ppart
+         real, dimension(nxv,nyv) :: q
+         integer, dimension(mxy1) :: kpic
+         end subroutine
+      end interface
+!
+      interface
+         subroutine VGPPOST2LT(ppart,q,kpic,qm,nppmx,idimp,mx,my,nxv,nyv&
+     &,mx1,mxy1)
+         implicit none
+         integer :: nppmx, idimp, mx, my, nxv, nyv, mx1, mxy1
+         real :: qm
+         real, dimension(nppmx,idimp,mxy1) :: ppart
+         real, dimension(nxv,nyv) :: q
+         integer, dimension(mxy1) :: kpic
+         end subroutine
+      end interface
+!
+      interface
+         subroutine viscan2(isdata,mb,nths)
+         implicit none
+         integer :: nths
+         integer, dimension(nths) :: isdata
+         integer, dimension(nths/2) :: mb
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPORDER2LT(ppart,ppbuff,kpic,ncl,ihole,idimp,nppmx, &
+     &nx,ny,mx,my,mx1,my1,npbmx,ntmax,irc)
+         implicit none
+         integer :: idimp, nppmx, nx, ny, mx, my, mx1, my1, npbmx, ntmax
+         integer :: irc
+         real, dimension(nppmx,idimp,mx1*my1) :: ppart
+         real, dimension(npbmx,idimp,mx1*my1) :: ppbuff
+         integer, dimension(mx1*my1) :: kpic
+         integer, dimension(8,mx1*my1) :: ncl
+         integer, dimension(2,ntmax+1,mx1*my1) :: ihole
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPORDERF2LT(ppart,ppbuff,kpic,ncl,ihole,idimp,nppmx,&
+     &mx1,my1,npbmx,ntmax,irc)
+         implicit none
+         integer :: idimp, nppmx, mx1, my1, npbmx, ntmax, irc
+         real, dimension(nppmx,idimp,mx1*my1) :: ppart
+         real, dimension(npbmx,idimp,mx1*my1) :: ppbuff
+         integer, dimension(mx1*my1) :: kpic
+         integer, dimension(8,mx1*my1) :: ncl
+         integer, dimension(2,ntmax+1,mx1*my1) :: ihole
+         end subroutine
+      end interface
+!
+      interface
+         subroutine VPPORDER2LT(ppart,ppbuff,kpic,ncl,ihole,idimp,nppmx,&
+     &nx,ny,mx,my,mx1,my1,npbmx,ntmax,irc)
+         implicit none
+         integer :: idimp, nppmx, nx, ny, mx, my, mx1, my1, npbmx, ntmax
+         integer :: irc
+         real, dimension(nppmx,idimp,mx1*my1) :: ppart
+         real, dimension(npbmx,idimp,mx1*my1) :: ppbuff
+         integer, dimension(mx1*my1) :: kpic
+         integer, dimension(8,mx1*my1) :: ncl
+         integer, dimension(2,ntmax+1,mx1*my1) :: ihole
+         end subroutine
+      end interface
+!
+      interface
+         subroutine VPPORDERF2LT(ppart,ppbuff,kpic,ncl,ihole,idimp,nppmx&
+     &,mx1,my1,npbmx,ntmax,irc)
+         implicit none
+         integer :: idimp, nppmx, mx1, my1, npbmx, ntmax, irc
+         real, dimension(nppmx,idimp,mx1*my1) :: ppart
+         real, dimension(npbmx,idimp,mx1*my1) :: ppbuff
+         integer, dimension(mx1*my1) :: kpic
+         integer, dimension(8,mx1*my1) :: ncl
+         integer, dimension(2,ntmax+1,mx1*my1) :: ihole
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPGROW2LT(ppart,kpic,idimp,nppmx,nppmxn,mxy1)
+         implicit none
+         integer :: idimp, nppmx, nppmxn, mxy1
+         real, dimension(nppmxn*idimp*mxy1) :: ppart
+         integer, dimension(mxy1) :: kpic
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPHOLE2LT(ppart,kpic,ncl,ihole,idimp,nppmx,mx,my,mx1&
+     &,my1,ntmax,irc)
+         implicit none
+         integer :: idimp, nppmx, mx, my, mx1, my1, ntmax, irc
+         real, dimension(nppmx,idimp,mx1*my1) :: ppart
+         integer, dimension(mx1*my1) :: kpic
+         integer, dimension(8,mx1*my1) :: ncl
+         integer, dimension(2,ntmax+1,mx1*my1) :: ihole
+         end subroutine
+      end interface
 !
       interface
          subroutine CGUARD2L(fxy,nx,ny,nxe,nye)
@@ -229,6 +476,30 @@
          complex, dimension(nxyhd), intent(in) :: sct
          end subroutine
       end interface
+!
+      interface
+         subroutine FFT2RMXYB(f,isign,mixup,sct,indx,indy,nxi,nxp,nxhd, &
+     &nyd,nxhyd,nxyhd)
+         implicit none
+         integer, intent(in) :: isign, indx, indy, nxi, nxp, nxhd, nyd
+         integer, intent(in) :: nxhyd, nxyhd
+         real, dimension(2*nxhd,nyd), intent(inout) :: f
+         integer, dimension(nxhyd), intent(in) :: mixup
+         complex, dimension(nxyhd), intent(in) :: sct
+         end subroutine
+      end interface
+!
+      interface
+         subroutine FFT2RM2YB(f,isign,mixup,sct,indx,indy,nxi,nxp,nxhd, &
+     &nyd,nxhyd,nxyhd)
+         implicit none
+         integer, intent(in) :: isign, indx, indy, nxi, nxp, nxhd, nyd
+         integer, intent(in) :: nxhyd, nxyhd
+         real, dimension(2,2*nxhd,nyd), intent(inout) :: f
+         integer, dimension(nxhyd), intent(in) :: mixup
+         complex, dimension(nxyhd), intent(in) :: sct
+         end subroutine
+      end interface
 !
       interface
          function ranorm()
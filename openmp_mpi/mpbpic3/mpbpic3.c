@@ -54,9 +54,12 @@ int main(int argc, char *argv[]) {
 
 /* declare scalars for MPI code */
    int ntpose = 1;
+/* ltpose = number of blocks in x for pipelined y-z transpose */
+/* (0 = transpose whole array, then fft in z)                 */
+   int ltpose = 0;
    int nvpy, nvpz, nvp, idproc, kstrt, npmax, kyp, kzp;
    int kxyp, kyzp, kzyp, nypmx, nzpmx, nypmn, nzpmn;
-   int npp, nps, myp1, mzp1, mxyzp1, mxzyp1;
+   int npp, nps, myp1, mzp1, mxyzp1, mxzyp1, nbs;
 
 /* declare scalars for OpenMP code */
    int nppmx, nppmx0, nbmaxp, ntmaxp, npbmx, irc;
@@ -236,8 +239,12 @@ int main(int argc, char *argv[]) {
    kpic = (int *) malloc(mxyzp1*sizeof(int));
 
 /* allocate data for MPI code */
-   bs = (float complex *) malloc(ndim*kxyp*kzyp*kzp*sizeof(float complex));
-   br = (float complex *) malloc(ndim*kxyp*kzyp*kzp*sizeof(float complex));
+/* pipelined transpose keeps a separate buffer for each block */
+   nbs = ltpose > 0 ? nvpz : 1;
+   bs = (float complex *) malloc(ndim*kxyp*kzyp*kzp*nbs
+                                 *sizeof(float complex));
+   br = (float complex *) malloc(ndim*kxyp*kzyp*kzp*nbs
+                                 *sizeof(float complex));
    scr = (float *) malloc(nnxe*nypmx*sizeof(float));
    scs = (float *) malloc(nnxe*2*nzpmx*sizeof(float));
 
@@ -437,10 +444,10 @@ L500: if (nloop <= ntime)
 /* transform charge to fourier space with OpenMP: updates qt, modifies qe */
       dtimer(&dtime,&itime,-1);
       isign = -1;
-      cwppfft32rm((float complex *)qe,qs,qt,bs,br,isign,ntpose,mixup,
-                  sct,&ttp,indx,indy,indz,kstrt,nvpy,nvpz,nxeh,nye,nze,
-                  kxyp,kyp,kyzp,kzp,kxyp,nypmx,kyzp,nzpmx,kzyp,nxhyz,
-                  nxyzh);
+      cwppfft32rm((float complex *)qe,qs,qt,bs,br,isign,ntpose,ltpose,
+                  mixup,sct,&ttp,indx,indy,indz,kstrt,nvpy,nvpz,nxeh,
+                  nye,nze,kxyp,kyp,kyzp,kzp,kxyp,nypmx,kyzp,nzpmx,kzyp,
+                  nxhyz,nxyzh);
       dtimer(&dtime,&itime,1);
       time = (float) dtime;
       tfft[0] += time;
@@ -451,9 +458,9 @@ L500: if (nloop <= ntime)
       dtimer(&dtime,&itime,-1);
       isign = -1;
       cwppfft32rm3((float complex *)cue,fxyzs,cut,bs,br,isign,ntpose,
-                   mixup,sct,&ttp,indx,indy,indz,kstrt,nvpy,nvpz,nxeh,
-                   nye,nze,kxyp,kyp,kyzp,kzp,kxyp,nypmx,kyzp,nzpmx,kzyp,
-                   nxhyz,nxyzh);
+                   ltpose,mixup,sct,&ttp,indx,indy,indz,kstrt,nvpy,nvpz,
+                   nxeh,nye,nze,kxyp,kyp,kyzp,kzp,kxyp,nypmx,kyzp,nzpmx,
+                   kzyp,nxhyz,nxyzh);
       dtimer(&dtime,&itime,1);
       time = (float) dtime;
       tfft[0] += time;
@@ -512,9 +519,9 @@ L500: if (nloop <= ntime)
       dtimer(&dtime,&itime,-1);
       isign = 1;
       cwppfft32rm3((float complex *)fxyze,fxyzs,fxyzt,bs,br,isign,
-                   ntpose,mixup,sct,&ttp,indx,indy,indz,kstrt,nvpy,nvpz,
-                   nxeh,nye,nze,kxyp,kyp,kyzp,kzp,kxyp,nypmx,kyzp,nzpmx,
-                   kzyp,nxhyz,nxyzh);
+                   ntpose,ltpose,mixup,sct,&ttp,indx,indy,indz,kstrt,
+                   nvpy,nvpz,nxeh,nye,nze,kxyp,kyp,kyzp,kzp,kxyp,nypmx,
+                   kyzp,nzpmx,kzyp,nxhyz,nxyzh);
       dtimer(&dtime,&itime,1);
       time = (float) dtime;
       tfft[0] += time;
@@ -525,9 +532,9 @@ L500: if (nloop <= ntime)
       dtimer(&dtime,&itime,-1);
       isign = 1;
       cwppfft32rm3((float complex *)bxyze,fxyzs,bxyzt,bs,br,isign,
-                   ntpose,mixup,sct,&ttp,indx,indy,indz,kstrt,nvpy,nvpz,
-                   nxeh,nye,nze,kxyp,kyp,kyzp,kzp,kxyp,nypmx,kyzp,nzpmx,
-                   kzyp,nxhyz,nxyzh);
+                   ntpose,ltpose,mixup,sct,&ttp,indx,indy,indz,kstrt,
+                   nvpy,nvpz,nxeh,nye,nze,kxyp,kyp,kyzp,kzp,kxyp,nypmx,
+                   kyzp,nzpmx,kzyp,nxhyz,nxyzh);
       dtimer(&dtime,&itime,1);
       time = (float) dtime;
       tfft[0] += time;
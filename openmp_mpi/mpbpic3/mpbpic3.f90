@@ -48,9 +48,12 @@
 !
 ! declare scalars for MPI code
       integer :: ntpose = 1
+! ltpose = number of blocks in x for pipelined y-z transpose
+! (0 = transpose whole array, then fft in z)
+      integer :: ltpose = 0
       integer :: nvpy, nvpz, nvp, idproc, kstrt, npmax, kyp, kzp
       integer :: kxyp, kyzp, kzyp, nypmx, nzpmx, nypmn, nzpmn
-      integer :: npp, nps, myp1, mzp1, mxyzp1, mxzyp1
+      integer :: npp, nps, myp1, mzp1, mxyzp1, mxzyp1, nbs
 !
 ! declare scalars for OpenMP code
       integer :: nppmx, nppmx0, nbmaxp, ntmaxp, npbmx, irc
@@ -213,7 +216,10 @@
       allocate(kpic(mxyzp1))
 !
 ! allocate data for MPI code
-      allocate(bs(ndim,kxyp*kzyp,kzp),br(ndim,kxyp*kzyp,kzp))
+! pipelined transpose keeps a separate buffer for each block
+      nbs = 1
+      if (ltpose > 0) nbs = nvpz
+      allocate(bs(ndim,kxyp*kzyp,kzp*nbs),br(ndim,kxyp*kzyp,kzp*nbs))
       allocate(scr(nnxe,nypmx),scs(nnxe,2*nzpmx))
 !
 ! prepare fft tables
@@ -395,9 +401,9 @@
 ! transform charge to fourier space with OpenMP: updates qt, modifies qe
       call dtimer(dtime,itime,-1)
       isign = -1
-      call WPPFFT32RM(qe,qs,qt,bs,br,isign,ntpose,mixup,sct,ttp,indx,   &
-     &indy,indz,kstrt,nvpy,nvpz,nxeh,nye,nze,kxyp,kyp,kyzp,kzp,kxyp,    &
-     &nypmx,kyzp,nzpmx,kzyp,nxhyz,nxyzh)
+      call WPPFFT32RM(qe,qs,qt,bs,br,isign,ntpose,ltpose,mixup,sct,ttp, &
+     &indx,indy,indz,kstrt,nvpy,nvpz,nxeh,nye,nze,kxyp,kyp,kyzp,kzp,kxyp&
+     &,nypmx,kyzp,nzpmx,kzyp,nxhyz,nxyzh)
       call dtimer(dtime,itime,1)
       time = real(dtime)
       tfft(1) = tfft(1) + time
@@ -407,9 +413,9 @@
 ! modifies cue
       call dtimer(dtime,itime,-1)
       isign = -1
-      call WPPFFT32RM3(cue,fxyzs,cut,bs,br,isign,ntpose,mixup,sct,ttp,  &
-     &indx,indy,indz,kstrt,nvpy,nvpz,nxeh,nye,nze,kxyp,kyp,kyzp,kzp,kxyp&
-     &,nypmx,kyzp,nzpmx,kzyp,nxhyz,nxyzh)
+      call WPPFFT32RM3(cue,fxyzs,cut,bs,br,isign,ntpose,ltpose,mixup,sct&
+     &,ttp,indx,indy,indz,kstrt,nvpy,nvpz,nxeh,nye,nze,kxyp,kyp,kyzp,kzp&
+     &,kxyp,nypmx,kyzp,nzpmx,kzyp,nxhyz,nxyzh)
       call dtimer(dtime,itime,1)
       time = real(dtime)
       tfft(1) = tfft(1) + time
@@ -465,9 +471,9 @@
 ! modifies fxyzt
       call dtimer(dtime,itime,-1)
       isign = 1
-      call WPPFFT32RM3(fxyze,fxyzs,fxyzt,bs,br,isign,ntpose,mixup,sct,  &
-     &ttp,indx,indy,indz,kstrt,nvpy,nvpz,nxeh,nye,nze,kxyp,kyp,kyzp,kzp,&
-     &kxyp,nypmx,kyzp,nzpmx,kzyp,nxhyz,nxyzh)
+      call WPPFFT32RM3(fxyze,fxyzs,fxyzt,bs,br,isign,ntpose,ltpose,mixup&
+     &,sct,ttp,indx,indy,indz,kstrt,nvpy,nvpz,nxeh,nye,nze,kxyp,kyp,kyzp&
+     &,kzp,kxyp,nypmx,kyzp,nzpmx,kzyp,nxhyz,nxyzh)
       call dtimer(dtime,itime,1)
       time = real(dtime)
       tfft(1) = tfft(1) + time
@@ -477,9 +483,9 @@
 ! modifies bxyzt
       call dtimer(dtime,itime,-1)
       isign = 1
-      call WPPFFT32RM3(bxyze,fxyzs,bxyzt,bs,br,isign,ntpose,mixup,sct,  &
-     &ttp,indx,indy,indz,kstrt,nvpy,nvpz,nxeh,nye,nze,kxyp,kyp,kyzp,kzp,&
-     &kxyp,nypmx,kyzp,nzpmx,kzyp,nxhyz,nxyzh)
+      call WPPFFT32RM3(bxyze,fxyzs,bxyzt,bs,br,isign,ntpose,ltpose,mixup&
+     &,sct,ttp,indx,indy,indz,kstrt,nvpy,nvpz,nxeh,nye,nze,kxyp,kyp,kyzp&
+     &,kzp,kxyp,nypmx,kyzp,nzpmx,kzyp,nxhyz,nxyzh)
       call dtimer(dtime,itime,1)
       time = real(dtime)
       tfft(1) = tfft(1) + time
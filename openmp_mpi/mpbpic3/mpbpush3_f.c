@@ -196,7 +196,7 @@ void ppfft32rm3xz_(float complex *h, int *isign, int *mixup,
 
 void wppfft32rm_(float complex *f, float complex *g, float complex *h,
                  float complex *bs, float complex *br, int *isign,
-                 int *ntpose, int *mixup, float complex *sct,
+                 int *ntpose, int *ltpose, int *mixup, float complex *sct,
                  float *ttp, int *indx, int *indy, int *indz,
                  int *kstrt, int *nvpy, int *nvpz, int *nxvh, int *nyv,
                  int *nzv, int *kxyp, int *kyp, int *kyzp, int *kzp,
@@ -205,7 +205,7 @@ void wppfft32rm_(float complex *f, float complex *g, float complex *h,
 
 void wppfft32rm3_(float complex *f, float complex *g, float complex *h,
                   float complex *bs, float complex *br, int *isign,
-                  int *ntpose, int *mixup, float complex *sct,
+                  int *ntpose, int *ltpose, int *mixup, float complex *sct,
                   float *ttp, int *indx, int *indy, int *indz,
                   int *kstrt, int *nvpy, int *nvpz, int *nxvh, int *nyv,
                   int *nzv, int *kxyp, int *kyp, int *kyzp, int *kzp,
@@ -573,15 +573,15 @@ void cppfft32rm3xz(float complex h[], int isign, int mixup[],
 /*--------------------------------------------------------------------*/
 void cwppfft32rm(float complex f[], float complex g[], 
                  float complex h[], float complex bs[],
-                 float complex br[], int isign, int ntpose, int mixup[],
-                 float complex sct[], float *ttp, int indx, int indy,
-                 int indz, int kstrt, int nvpy, int nvpz, int nxvh,
-                 int nyv, int nzv, int kxyp, int kyp, int kyzp, int kzp,
-                 int kxypd, int kypd, int kyzpd, int kzpd, int kzyp,
-                 int nxhyzd, int nxyzhd) {
-   wppfft32rm_(f,g,h,bs,br,&isign,&ntpose,mixup,sct,ttp,&indx,&indy,
-               &indz,&kstrt,&nvpy,&nvpz,&nxvh,&nyv,&nzv,&kxyp,&kyp,
-               &kyzp,&kzp,&kxypd,&kypd,&kyzpd,&kzpd,&kzyp,&nxhyzd,
+                 float complex br[], int isign, int ntpose, int ltpose,
+                 int mixup[], float complex sct[], float *ttp, int indx,
+                 int indy, int indz, int kstrt, int nvpy, int nvpz,
+                 int nxvh, int nyv, int nzv, int kxyp, int kyp,
+                 int kyzp, int kzp, int kxypd, int kypd, int kyzpd,
+                 int kzpd, int kzyp, int nxhyzd, int nxyzhd) {
+   wppfft32rm_(f,g,h,bs,br,&isign,&ntpose,&ltpose,mixup,sct,ttp,&indx,
+               &indy,&indz,&kstrt,&nvpy,&nvpz,&nxvh,&nyv,&nzv,&kxyp,
+               &kyp,&kyzp,&kzp,&kxypd,&kypd,&kyzpd,&kzpd,&kzyp,&nxhyzd,
                &nxyzhd);
    return;
 }
@@ -590,14 +590,15 @@ void cwppfft32rm(float complex f[], float complex g[],
 void cwppfft32rm3(float complex f[], float complex g[],
                   float complex h[], float complex bs[],
                   float complex br[], int isign, int ntpose,
-                  int mixup[], float complex sct[], float *ttp,
-                  int indx, int indy, int indz, int kstrt, int nvpy,
-                  int nvpz, int nxvh, int nyv, int nzv, int kxyp,
-                  int kyp, int kyzp, int kzp, int kxypd, int kypd,
-                  int kyzpd, int kzpd, int kzyp, int nxhyzd, int nxyzhd) {
-   wppfft32rm3_(f,g,h,bs,br,&isign,&ntpose,mixup,sct,ttp,&indx,&indy,
-                &indz,&kstrt,&nvpy,&nvpz,&nxvh,&nyv,&nzv,&kxyp,&kyp,
-                &kyzp,&kzp,&kxypd,&kypd,&kyzpd,&kzpd,&kzyp,&nxhyzd,
+                  int ltpose, int mixup[], float complex sct[],
+                  float *ttp, int indx, int indy, int indz, int kstrt,
+                  int nvpy, int nvpz, int nxvh, int nyv, int nzv,
+                  int kxyp, int kyp, int kyzp, int kzp, int kxypd,
+                  int kypd, int kyzpd, int kzpd, int kzyp, int nxhyzd,
+                  int nxyzhd) {
+   wppfft32rm3_(f,g,h,bs,br,&isign,&ntpose,&ltpose,mixup,sct,ttp,&indx,
+                &indy,&indz,&kstrt,&nvpy,&nvpz,&nxvh,&nyv,&nzv,&kxyp,
+                &kyp,&kyzp,&kzp,&kxypd,&kypd,&kyzpd,&kzpd,&kzyp,&nxhyzd,
                 &nxyzhd);
    return;
 }
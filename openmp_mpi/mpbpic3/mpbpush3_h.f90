@@ -396,11 +396,12 @@
       end interface
 !
       interface
-         subroutine WPPFFT32RM(f,g,h,bs,br,isign,ntpose,mixup,sct,ttp,  &
-     &indx,indy,indz,kstrt,nvpy,nvpz,nxvh,nyv,nzv,kxyp,kyp,kyzp,kzp,    &
-     &kxypd,kypd,kyzpd,kzpd,kzyp,nxhyzd,nxyzhd)
+         subroutine WPPFFT32RM(f,g,h,bs,br,isign,ntpose,ltpose,mixup,   &
+     &sct,ttp,indx,indy,indz,kstrt,nvpy,nvpz,nxvh,nyv,nzv,kxyp,kyp,kyzp,&
+     &kzp,kxypd,kypd,kyzpd,kzpd,kzyp,nxhyzd,nxyzhd)
          implicit none
-         integer, intent(in) :: isign, ntpose, indx, indy, indz, kstrt
+         integer, intent(in) :: isign, ntpose, ltpose, indx, indy
+         integer, intent(in) :: indz, kstrt
          integer, intent(in) :: nvpy, nvpz, nxvh, nyv, nzv, kxyp, kyp
          integer, intent(in) :: kyzp, kzp, kxypd, kypd, kyzpd, kzpd
          integer, intent(in) :: kzyp, nxhyzd, nxyzhd
@@ -415,11 +416,12 @@
       end interface
 !
       interface
-         subroutine WPPFFT32RM3(f,g,h,bs,br,isign,ntpose,mixup,sct,ttp, &
-     &indx,indy,indz,kstrt,nvpy,nvpz,nxvh,nyv,nzv,kxyp,kyp,kyzp,kzp,    &
-     &kxypd,kypd,kyzpd,kzpd,kzyp,nxhyzd,nxyzhd)
+         subroutine WPPFFT32RM3(f,g,h,bs,br,isign,ntpose,ltpose,mixup,  &
+     &sct,ttp,indx,indy,indz,kstrt,nvpy,nvpz,nxvh,nyv,nzv,kxyp,kyp,kyzp,&
+     &kzp,kxypd,kypd,kyzpd,kzpd,kzyp,nxhyzd,nxyzhd)
          implicit none
-         integer, intent(in) :: isign, ntpose, indx, indy, indz, kstrt
+         integer, intent(in) :: isign, ntpose, ltpose, indx, indy
+         integer, intent(in) :: indz, kstrt
          integer, intent(in) :: nvpy, nvpz, nxvh, nyv, nzv, kxyp, kyp
          integer, intent(in) :: kyzp, kzp, kxypd, kypd, kyzpd, kzpd
          integer, intent(in) :: kzyp, nxhyzd, nxyzhd
@@ -29,6 +29,11 @@ c           array, distributed in x and z.
 c PPNTPOS3B performs a transpose of an n component complex vector array,
 c           distributed in x and z, to an n component complex vector
 c           array, distributed in x and y.
+c PPNTPOS3BS starts a transpose of a block of x indices of an n
+c            component complex vector array, distributed in x and z,
+c            to an n component complex vector array, distributed in x
+c            and y, using non-blocking messages.
+c PPNTPOS3BW completes a transpose started by PPNTPOS3BS.
 c PPPMOVE32 moves particles in y/z into appropriate spatial regions for
 c           tiled distributed data with 2D spatial decomposition
 c written by viktor k. decyk, ucla
@@ -1178,6 +1183,200 @@ c insert data received
   100 continue
       return
       end
+c-----------------------------------------------------------------------
+      subroutine PPNTPOS3BS(g,h,s,t,mreq,nx,ny,nz,kxyp,kyzp,kzp,kstrt,  
+     1nvpy,nvpz,ndim,nyv,nzv,kxypd,kyzpd,kzpd,jxi,jxp)
+c this subroutine starts a transpose of a block of x indices of a matrix
+c g, distributed in x and z to a matrix h, distributed in x and y, that
+c is, h(1:ndim,l+kzp*(n-1),j,k) = g(1:ndim,k+kyzp*(m-1),j,l), where
+c jxi <= j < jxi+jxp, 1 <= k <= kyzp, 1 <= l <= kzp, and
+c 1 <= m <= ny/kyzp, 1 <= n <= nz/kzp
+c and where indices n and m can be distributed across processors.
+c this subroutine posts all receives, sends all messages asynchronously
+c and copies the local block.  PPNTPOS3BW must be called with the same
+c block to complete the transpose.  several blocks can be in progress at
+c once, so that work on one block, such as an fft in z, can overlap with
+c the communication of the others.
+c g = complex input array
+c h = complex output array
+c s, t = complex scratch arrays, of size ndim*kyzp*kxyp*kzp*nvpz
+c the block starting at jxi uses the part starting at
+c ndim*kyzp*kzp*nvpz*(jxi-1)
+c mreq = receive/send requests for this block
+c nx/ny/nz = number of points in x/y/z
+c kxyp/kyzp/kzp = number of data values per block in x/y/z
+c kstrt = starting data block number
+c nvpy/nvpz = number of real or virtual processors in y/z
+c ndim = leading dimension of arrays g and h
+c nyv/nzv = first dimension of g/h
+c kxypd = second dimension of g and h
+c kzpd/kyzpd = third dimension of g/h
+c jxi = initial x index in block
+c jxp = number of x indices in block
+      implicit none
+      integer nx, ny, nz, kxyp, kyzp, kzp, kstrt, nvpy, nvpz, ndim
+      integer nyv, nzv, kxypd, kyzpd, kzpd, jxi, jxp
+      integer mreq
+      complex g, h, s, t
+      dimension g(ndim,nyv,kxypd,kzpd), h(ndim,nzv,kxypd,kyzpd)
+      dimension s(ndim,kyzp*kxyp*kzp*nvpz), t(ndim,kyzp*kxyp*kzp*nvpz)
+      dimension mreq(2*nvpz)
+c get definition of MPI constants
+      include 'mpif.h'
+c common block for parallel processing
+      integer nproc, lgrp, mreal, mint, mcplx, mdouble, lworld
+c lgrp = current communicator
+c mcplx = default datatype for complex
+      common /PPARMS/ nproc, lgrp, mreal, mint, mcplx, mdouble, lworld
+c local data
+      integer i, n, j, k, l, js, ks, kyzps, kzps, id, joff, koff, loff
+      integer moff, ld, jd, kyzxp, ll, ierr
+c js/ks = processor co-ordinates in x/z => idproc = js + nvpy*ks
+      ks = (kstrt - 1)/nvpy
+      js = kstrt - nvpy*ks - 1
+      kyzps = min(kyzp,max(0,ny-kyzp*ks))
+      kzps = min(kzp,max(0,nz-kzp*ks))
+      joff = jxi - 1
+c special case for one processor
+      if (nvpz.eq.1) then
+!$OMP PARALLEL DO PRIVATE(i,j,k,l,ll)
+         do 30 ll = 1, jxp*kzp
+         l = (ll - 1)/jxp
+         j = ll - jxp*l
+         l = l + 1
+         do 20 k = 1, kyzp
+         do 10 i = 1, ndim
+         h(i,l,j+joff,k) = g(i,k,j+joff,l)
+   10    continue
+   20    continue
+   30    continue
+!$OMP END PARALLEL DO
+         mreq(1) = MPI_REQUEST_NULL
+         mreq(2) = MPI_REQUEST_NULL
+         return
+      endif
+c kyzxp = size of each message in this block, moff = start of block
+      kyzxp = kyzp*kzp*jxp
+      moff = kyzp*kzp*nvpz*joff
+c post all receives, data from processor id is stored in message id+1
+      do 40 n = 1, nvpz
+      id = n - 1
+      if (id.ne.ks) then
+         jd = js + nvpy*id
+         call MPI_IRECV(t(1,moff+kyzxp*id+1),ndim*kyzxp,mcplx,jd,jxi,
+     1lgrp,mreq(n),ierr)
+      else
+         mreq(n) = MPI_REQUEST_NULL
+      endif
+   40 continue
+      mreq(nvpz+ks+1) = MPI_REQUEST_NULL
+c extract and send data, data to processor id is stored in message id+1
+      do 80 n = 1, nvpz
+      id = n - ks - 1
+      if (id.lt.0) id = id + nvpz
+      if (id.eq.ks) go to 80
+      koff = kyzp*id
+      ld = min(kyzp,max(0,ny-koff))
+      loff = moff + kyzxp*id
+!$OMP PARALLEL DO PRIVATE(i,j,k,l,ll)
+      do 70 ll = 1, jxp*kzps
+      l = (ll - 1)/jxp
+      j = ll - jxp*l
+      l = l + 1
+      do 60 k = 1, ld
+      do 50 i = 1, ndim
+      s(i,k+ld*(ll-1)+loff) = g(i,k+koff,j+joff,l)
+   50 continue
+   60 continue
+   70 continue
+!$OMP END PARALLEL DO
+      jd = js + nvpy*id
+      ld = ndim*ld*jxp*kzps
+      call MPI_ISEND(s(1,loff+1),ld,mcplx,jd,jxi,lgrp,mreq(nvpz+id+1),
+     1ierr)
+   80 continue
+c copy local block while messages are in flight
+      koff = kyzp*ks
+      loff = kzp*ks
+!$OMP PARALLEL DO PRIVATE(i,j,k,l,ll)
+      do 110 ll = 1, jxp*kzps
+      l = (ll - 1)/jxp
+      j = ll - jxp*l
+      l = l + 1
+      do 100 k = 1, kyzps
+      do 90 i = 1, ndim
+      h(i,l+loff,j+joff,k) = g(i,k+koff,j+joff,l)
+   90 continue
+  100 continue
+  110 continue
+!$OMP END PARALLEL DO
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPNTPOS3BW(h,t,mreq,nx,ny,nz,kxyp,kyzp,kzp,kstrt,nvpy, 
+     1nvpz,ndim,nzv,kxypd,kyzpd,jxi,jxp)
+c this subroutine completes a transpose of a block of x indices started
+c by PPNTPOS3BS, inserting data into h in the order it arrives.
+c h = complex output array
+c t = complex scratch array given to PPNTPOS3BS
+c mreq = receive/send requests for this block from PPNTPOS3BS
+c nx/ny/nz = number of points in x/y/z
+c kxyp/kyzp/kzp = number of data values per block in x/y/z
+c kstrt = starting data block number
+c nvpy/nvpz = number of real or virtual processors in y/z
+c ndim = leading dimension of array h
+c nzv = first dimension of h
+c kxypd = second dimension of h
+c kyzpd = third dimension of h
+c jxi = initial x index in block
+c jxp = number of x indices in block
+      implicit none
+      integer nx, ny, nz, kxyp, kyzp, kzp, kstrt, nvpy, nvpz, ndim
+      integer nzv, kxypd, kyzpd, jxi, jxp
+      integer mreq
+      complex h, t
+      dimension h(ndim,nzv,kxypd,kyzpd)
+      dimension t(ndim,kyzp*kxyp*kzp*nvpz)
+      dimension mreq(2*nvpz)
+c get definition of MPI constants
+      include 'mpif.h'
+c local data
+      integer i, n, j, k, l, ks, kyzps, id, joff, koff, loff, moff, ld
+      integer kyzxp, ll, ierr, istatus
+      dimension istatus(MPI_STATUS_SIZE)
+c special case for one processor
+      if (nvpz.eq.1) return
+c ks = processor co-ordinate in z
+      ks = (kstrt - 1)/nvpy
+      kyzps = min(kyzp,max(0,ny-kyzp*ks))
+      joff = jxi - 1
+      kyzxp = kyzp*kzp*jxp
+      moff = kyzp*kzp*nvpz*joff
+c insert data as it arrives
+      do 40 n = 2, nvpz
+      call MPI_WAITANY(nvpz,mreq,id,istatus,ierr)
+      if (id.eq.MPI_UNDEFINED) go to 50
+      id = id - 1
+      loff = kzp*id
+      ld = min(kzp,max(0,nz-loff))
+      koff = moff + kyzxp*id
+!$OMP PARALLEL DO PRIVATE(i,j,k,l,ll)
+      do 30 ll = 1, jxp*ld
+      l = (ll - 1)/jxp
+      j = ll - jxp*l
+      l = l + 1
+      do 20 k = 1, kyzps
+      do 10 i = 1, ndim
+      h(i,l+loff,j+joff,k) = t(i,k+kyzps*(ll-1)+koff)
+   10 continue
+   20 continue
+   30 continue
+!$OMP END PARALLEL DO
+   40 continue
+c wait for sends to complete
+   50 call MPI_WAITALL(nvpz,mreq(nvpz+1),MPI_STATUSES_IGNORE,ierr)
+      return
+      end
 c-----------------------------------------------------------------------
       subroutine PPPMOVE32(sbufr,sbufl,rbufr,rbufl,ncll,nclr,mcll,mclr, 
      1mcls,kstrt,nvpy,nvpz,idimp,nbmax,mx1,myp1,mzp1,mxzyp1,irc)
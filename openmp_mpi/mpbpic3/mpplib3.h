@@ -49,6 +49,17 @@ void cppntpos3b(float complex g[], float complex h[], float complex s[],
                 int ndim, int nyv, int nzv, int kxypd, int kyzpd,
                 int kzpd);
 
+void cppntpos3bs(float complex g[], float complex h[], float complex s[],
+                 float complex t[], int mreq[], int nx, int ny, int nz,
+                 int kxyp, int kyzp, int kzp, int kstrt, int nvpy,
+                 int nvpz, int ndim, int nyv, int nzv, int kxypd,
+                 int kyzpd, int kzpd, int jxi, int jxp);
+
+void cppntpos3bw(float complex h[], float complex t[], int mreq[],
+                 int nx, int ny, int nz, int kxyp, int kyzp, int kzp,
+                 int kstrt, int nvpy, int nvpz, int ndim, int nzv,
+                 int kxypd, int kyzpd, int jxi, int jxp);
+
 void cpppmove32(float sbufr[], float sbufl[], float rbufr[], 
                 float rbufl[], int ncll[], int nclr[], int mcll[], 
                 int mclr[], int mcls[], int kstrt, int nvpy, int nvpz,
@@ -65,6 +65,17 @@ void ppmoveg32_(float *part, float *edges, int *npp, float *sbufr,
                 int *idimp, int *npmax, int *idps, int *nbmax,
                 int *ntmax, int *info);
 
+void ppntpos3bs_(float complex *g, float complex *h, float complex *s,
+                 float complex *t, int *mreq, int *nx, int *ny, int *nz,
+                 int *kxyp, int *kyzp, int *kzp, int *kstrt, int *nvpy,
+                 int *nvpz, int *ndim, int *nyv, int *nzv, int *kxypd,
+                 int *kyzpd, int *kzpd, int *jxi, int *jxp);
+
+void ppntpos3bw_(float complex *h, float complex *t, int *mreq, int *nx,
+                 int *ny, int *nz, int *kxyp, int *kyzp, int *kzp,
+                 int *kstrt, int *nvpy, int *nvpz, int *ndim, int *nzv,
+                 int *kxypd, int *kyzpd, int *jxi, int *jxp);
+
 void pppmove32_(float *sbufr, float *sbufl, float *rbufr, float *rbufl,
                 int *ncll, int *nclr, int *mcll, int *mclr, int *mcls,
                 int *kstrt, int *nvpy, int *nvpz, int *idimp,
@@ -187,6 +198,27 @@ void cppntpos3b(float complex g[], float complex h[], float complex s[],
    return;
 }
 
+/*--------------------------------------------------------------------*/
+void cppntpos3bs(float complex g[], float complex h[], float complex s[],
+                 float complex t[], int mreq[], int nx, int ny, int nz,
+                 int kxyp, int kyzp, int kzp, int kstrt, int nvpy,
+                 int nvpz, int ndim, int nyv, int nzv, int kxypd,
+                 int kyzpd, int kzpd, int jxi, int jxp) {
+   ppntpos3bs_(g,h,s,t,mreq,&nx,&ny,&nz,&kxyp,&kyzp,&kzp,&kstrt,&nvpy,
+               &nvpz,&ndim,&nyv,&nzv,&kxypd,&kyzpd,&kzpd,&jxi,&jxp);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppntpos3bw(float complex h[], float complex t[], int mreq[],
+                 int nx, int ny, int nz, int kxyp, int kyzp, int kzp,
+                 int kstrt, int nvpy, int nvpz, int ndim, int nzv,
+                 int kxypd, int kyzpd, int jxi, int jxp) {
+   ppntpos3bw_(h,t,mreq,&nx,&ny,&nz,&kxyp,&kyzp,&kzp,&kstrt,&nvpy,&nvpz,
+               &ndim,&nzv,&kxypd,&kyzpd,&jxi,&jxp);
+   return;
+}
+
 /*--------------------------------------------------------------------*/
 void cpppmove32(float sbufr[], float sbufl[], float rbufr[], 
                 float rbufl[], int ncll[], int nclr[], int mcll[], 
@@ -48,8 +48,42 @@ int main(int argc, char *argv[]) {
 
 /* declare scalars for MPI code */
    int ntpose = 1;
+/* ltpose = (0,1) = (no,yes) use non-blocking all-to-all transpose */
+   int ltpose = 0;
+/* lpipe = (0,1) = (no,yes) overlap guard cell and particle */
+/* communication with push and reorder of interior tiles */
+   int lpipe = 0;
+/* lshm = (0,1) = (no,yes) use MPI-3 shared memory windows for */
+/* communication between processors on the same node           */
+   int lshm = 0;
+/* nshm = number of processors sharing memory on a node */
+   int nshm = 1;
+/* lpack = (0,1) = (no,yes) send particles leaving the processor */
+/* with positions compressed to 16 bit fixed point               */
+   int lpack = 0;
+/* idimpm = number of words per particle in messages */
+   int idimpm;
+/* nchkpt = number of time steps between checkpoints, 0 = never */
+   int nchkpt = 0;
+/* lrestart = (0,1) = (no,yes) restart from checkpoint file fchkpt */
+   int lrestart = 0;
+   char fchkpt[] = "mpchkpt2.dat";
+/* ndist = number of time steps between velocity and phase space */
+/* distribution diagnostics written to file fdist, 0 = never     */
+   int ndist = 0;
+/* nmv = number of velocity bins, nxb = number of bins in x */
+/* vmx = maximum velocity in distributions                  */
+   int nmv = 64, nxb = 64;
+   float vmx = 6.0;
+   char fdist[] = "fvdist2.dat";
    int nvp, idproc, kstrt, npmax, kxp, kyp, nypmx, nypmn;
-   int nyp, noff, npp, nps, myp1, mxyp1;
+   int nyp, noff, npp, nps, myp1, mxyp1, nbs;
+/* declare scalars for checkpoint: */
+/* kxps = actual size of fourier partition in x direction */
+/* isc/fsc = integer/real scalars saved in checkpoint */
+   int kxps, nvpo;
+   int isc[6];
+   float fsc[2];
 
 /* declare scalars for OpenMP code */
    int nppmx, nppmx0, nbmaxp, ntmaxp, npbmx, irc;
@@ -73,6 +107,11 @@ int main(int argc, char *argv[]) {
 /* sct = sine/cosine table for FFT */
    float complex *sct = NULL;
    double wtot[4], work[4];
+/* fvv = velocity distribution f(vx,vy) */
+/* fxv = phase space distribution f(x,vx) */
+/* fvw = scratch array for summing distributions */
+   float *fvv = NULL, *fxv = NULL, *fvw = NULL;
+   FILE *unitd = NULL;
 
 /* declare arrays for MPI code */
 /* bs/br = complex send/receive buffers for data transpose */
@@ -80,6 +119,10 @@ int main(int argc, char *argv[]) {
 /* sbufl/sbufr = particle buffers sent to nearby processors */
 /* rbufl/rbufr = particle buffers received from nearby processors */
    float *sbufl = NULL, *sbufr = NULL, *rbufl = NULL, *rbufr = NULL;
+/* psbufl/psbufr/prbufl/prbufr = particle message buffers, same as */
+/* sbufl/sbufr/rbufl/rbufr unless lpack = 1                        */
+   float *psbufl = NULL, *psbufr = NULL, *prbufl = NULL;
+   float *prbufr = NULL;
 /* edges[0:1] = lower:upper y boundaries of particle partition */
    float *edges = NULL;
 /* scr = guard cell buffer received from nearby processors */
@@ -101,7 +144,8 @@ int main(int argc, char *argv[]) {
    float time;
    struct timeval itime;
    float tdpost = 0.0, tguard = 0.0, ttp = 0.0, tfield = 0.0;
-   float tpush = 0.0, tsort = 0.0, tmov = 0.0;
+   float tpush = 0.0, tsort = 0.0, tmov = 0.0, tchkpt = 0.0;
+   float tdist = 0.0;
    float tfft[2] = {0.0,0.0};
    double dtime;
 
@@ -162,6 +206,10 @@ int main(int argc, char *argv[]) {
    kxp = (nxh - 1)/nvp + 1;
 /* kyp = number of complex grids in each field partition in y direction */
    kyp = (ny - 1)/nvp + 1;
+/* kxps = actual size of field partition in x direction */
+   kxps = nxh - kxp*idproc;
+   kxps = 0 > kxps ? 0 : kxps;
+   kxps = kxp < kxps ? kxp : kxps;
 /* npmax = maximum number of electrons in each partition */
    npmax = (np/nvp)*1.25;
 /* myp1 = number of tiles in y direction */
@@ -177,10 +225,28 @@ int main(int argc, char *argv[]) {
    mixup = (int *) malloc(nxhy*sizeof(int));
    sct = (float complex *) malloc(nxyh*sizeof(float complex));
    kpic = (int *) malloc(mxyp1*sizeof(int));
+   if (ndist > 0) {
+      fvv = (float *) malloc(nmv*nmv*sizeof(float));
+      fxv = (float *) malloc(nxb*nmv*sizeof(float));
+      j = nmv > nxb ? nmv : nxb;
+      fvw = (float *) malloc(j*nmv*sizeof(float));
+      if (kstrt==1) {
+         unitd = fopen(fdist,"wb");
+         if (unitd==NULL) {
+            printf("cannot open distribution file %s\n",fdist);
+            cppabort();
+            exit(1);
+         }
+      }
+   }
 
 /* allocate and initialize data for MPI code */
-   bs = (float complex *) malloc(ndim*kxp*kyp*sizeof(float complex));
-   br = (float complex *) malloc(ndim*kxp*kyp*sizeof(float complex));
+/* non-blocking transpose needs a separate buffer for each processor */
+   nbs = 1;
+   if (ltpose==1)
+      nbs = nvp;
+   bs = (float complex *) malloc(ndim*kxp*kyp*nbs*sizeof(float complex));
+   br = (float complex *) malloc(ndim*kxp*kyp*nbs*sizeof(float complex));
    scr = (float *) malloc(nxe*ndim*sizeof(float));
 
 /* prepare fft tables */
@@ -189,16 +255,48 @@ int main(int argc, char *argv[]) {
    isign = 0;
    cmppois22(qt,fxyt,isign,ffc,ax,ay,affp,&we,nx,ny,kstrt,nye,kxp,nyh);
 /* initialize electrons */
-   nps = 1;
-   npp = 0;
-   cpdistr2(part,edges,&npp,nps,vtx,vty,vx0,vy0,npx,npy,nx,ny,idimp,
-            npmax,idps,ipbc,&ierr);
+   if (lrestart==0) {
+      nps = 1;
+      npp = 0;
+      cpdistr2(part,edges,&npp,nps,vtx,vty,vx0,vy0,npx,npy,nx,ny,idimp,
+               npmax,idps,ipbc,&ierr);
 /* check for particle initialization error */
-   if (ierr != 0) {
+      if (ierr != 0) {
+         if (kstrt==1) {
+            printf("particle initialization error: ierr=%d\n",ierr);
+         }
+         goto L3000;
+      }
+   }
+/* restart electrons in partition from checkpoint file: */
+/* updates part, npp, ntime */
+   else {
+      dtimer(&dtime,&itime,-1);
+      cpprchkpth2(fchkpt,6,isc,2,fsc,&nvpo,&ierr);
+      if (ierr==0) {
+         if ((isc[1] != nx) || (isc[2] != ny) || (isc[3] != npx)
+            || (isc[4] != npy) || (isc[5] != idimp)) {
+            ierr = 2;
+         }
+         else {
+            ntime = isc[0];
+            we = fsc[0];
+            wke = fsc[1];
+            cpprchkptp2(2,part,edges,&npp,idimp,npmax,&ierr);
+         }
+         cpprchkptc2();
+      }
+      if (ierr != 0) {
+         if (kstrt==1) {
+            printf("checkpoint read error: ierr=%d\n",ierr);
+         }
+         goto L3000;
+      }
+      dtimer(&dtime,&itime,1);
+      tchkpt += (float) dtime;
       if (kstrt==1) {
-         printf("particle initialization error: ierr=%d\n",ierr);
+         printf("restart from ntime, nvp = %d,%d\n",ntime,nvpo);
       }
-      goto L3000;
    }
 
 /* find number of particles in each of mx, my tiles: updates kpic, nppmx */
@@ -214,16 +312,36 @@ int main(int argc, char *argv[]) {
    ntmaxp = xtras*nppmx;
    npbmx = xtras*nppmx;
    nbmaxp = 0.25*mx1*npbmx;
-   sbufl = (float *) malloc(idimp*nbmaxp*sizeof(float));
-   sbufr = (float *) malloc(idimp*nbmaxp*sizeof(float));
+/* shared memory windows hold the particle buffers being sent */
+   if (lshm==1) {
+      cppshminit2(&sbufr,&sbufl,&nclr,&ncll,&nshm,kstrt,nvp,nxe,ndim,
+                  kxp,kyp,idimp,nbmaxp,mxyp1);
+   }
+   else {
+      sbufl = (float *) malloc(idimp*nbmaxp*sizeof(float));
+      sbufr = (float *) malloc(idimp*nbmaxp*sizeof(float));
+      ncll = (int *) malloc(3*mxyp1*sizeof(int));
+      nclr = (int *) malloc(3*mxyp1*sizeof(int));
+   }
    rbufl = (float *) malloc(idimp*nbmaxp*sizeof(float));
    rbufr = (float *) malloc(idimp*nbmaxp*sizeof(float));
+   psbufl = sbufl;
+   psbufr = sbufr;
+   prbufl = rbufl;
+   prbufr = rbufr;
+   idimpm = idimp;
+/* compressed particles are sent from the original send buffers */
+   if (lpack==1) {
+      idimpm = idimp - 1;
+      sbufl = (float *) malloc(idimp*nbmaxp*sizeof(float));
+      sbufr = (float *) malloc(idimp*nbmaxp*sizeof(float));
+      prbufl = (float *) malloc(idimpm*nbmaxp*sizeof(float));
+      prbufr = (float *) malloc(idimpm*nbmaxp*sizeof(float));
+   }
    ppart = (float *) malloc(idimp*nppmx0*mxyp1*sizeof(float));
    ppbuff = (float *) malloc(idimp*npbmx*mxyp1*sizeof(float));
    ncl = (int *) malloc(8*mxyp1*sizeof(int));
    iholep = (int *) malloc(2*(ntmaxp+1)*mxyp1*sizeof(int));
-   ncll = (int *) malloc(3*mxyp1*sizeof(int));
-   nclr = (int *) malloc(3*mxyp1*sizeof(int));
    mcll = (int *) malloc(3*mxyp1*sizeof(int));
    mclr = (int *) malloc(3*mxyp1*sizeof(int));
 
@@ -272,9 +390,9 @@ L500: if (nloop <= ntime)
 /* modifies qe */
       dtimer(&dtime,&itime,-1);
       isign = -1;
-      cwppfft2rm((float complex *)qe,qt,bs,br,isign,ntpose,mixup,sct,
-                 &ttp,indx,indy,kstrt,nvp,nxeh,nye,kxp,kyp,nypmx,nxhy,
-                 nxyh);
+      cwppfft2rm((float complex *)qe,qt,bs,br,isign,ntpose,ltpose,mixup,
+                 sct,&ttp,indx,indy,kstrt,nvp,nxeh,nye,kxp,kyp,nypmx,
+                 nxhy,nxyh);
       dtimer(&dtime,&itime,1);
       time = (float) dtime;
       tfft[0] += time;
@@ -293,9 +411,9 @@ L500: if (nloop <= ntime)
 /* modifies fxyt */
       dtimer(&dtime,&itime,-1);
       isign = 1;
-      cwppfft2rm2((float complex *)fxye,fxyt,bs,br,isign,ntpose,mixup,
-                  sct,&ttp,indx,indy,kstrt,nvp,nxeh,nye,kxp,kyp,nypmx,
-                  nxhy,nxyh);
+      cwppfft2rm2((float complex *)fxye,fxyt,bs,br,isign,ntpose,ltpose,
+                  mixup,sct,&ttp,indx,indy,kstrt,nvp,nxeh,nye,kxp,kyp,
+                  nypmx,nxhy,nxyh);
       dtimer(&dtime,&itime,1);
       time = (float) dtime;
       tfft[0] += time;
@@ -303,8 +421,15 @@ L500: if (nloop <= ntime)
 
 /* copy guard cells with OpenMP: updates fxye */
       dtimer(&dtime,&itime,-1);
-      cppncguard2l(fxye,nyp,kstrt,nvp,nnxe,nypmx);
-      cppcguard2xl(fxye,nyp,nx,ndim,nxe,nypmx);
+/* start copy of guard cells in y, completed during push */
+      if (lpipe==1) {
+         cppcguard2xl(fxye,nyp-1,nx,ndim,nxe,nypmx);
+         cppincguard2l(fxye,nyp,kstrt,nvp,nnxe,nypmx);
+      }
+      else {
+         cppncguard2l(fxye,nyp,kstrt,nvp,nnxe,nypmx);
+         cppcguard2xl(fxye,nyp,nx,ndim,nxe,nypmx);
+      }
       dtimer(&dtime,&itime,1);
       time = (float) dtime;
       tguard += time;
@@ -316,9 +441,23 @@ L500: if (nloop <= ntime)
 /*    cppgppush2l(ppart,fxye,kpic,noff,nyp,qbme,dt,&wke,nx,ny,mx,my, */
 /*                idimp,nppmx0,nxe,nypmx,mx1,mxyp1,ipbc);            */
 /* updates ppart, wke, ncl, iholep, irc */
-      cppgppushf2l(ppart,fxye,kpic,ncl,iholep,noff,nyp,qbme,dt,&wke,nx,
-                   ny,mx,my,idimp,nppmx0,nxe,nypmx,mx1,mxyp1,ntmaxp,
-                   &irc);
+      if (lpipe==1) {
+/* push tiles which do not need guard cells in y while they arrive */
+         cppgppushf2lr(ppart,fxye,kpic,ncl,iholep,noff,nyp,qbme,dt,&wke,
+                       nx,ny,mx,my,idimp,nppmx0,nxe,nypmx,mx1,mxyp1,
+                       ntmaxp,1,myp1-1,&irc);
+/* finish copy of guard cells and push last row of tiles */
+         cppwncguard2l(nvp);
+         cppcguard2xl(fxye,nyp,nx,ndim,nxe,nypmx);
+         cppgppushf2lr(ppart,fxye,kpic,ncl,iholep,noff,nyp,qbme,dt,&wke,
+                       nx,ny,mx,my,idimp,nppmx0,nxe,nypmx,mx1,mxyp1,
+                       ntmaxp,myp1,myp1,&irc);
+      }
+      else {
+         cppgppushf2l(ppart,fxye,kpic,ncl,iholep,noff,nyp,qbme,dt,&wke,
+                      nx,ny,mx,my,idimp,nppmx0,nxe,nypmx,mx1,mxyp1,
+                      ntmaxp,&irc);
+      }
       dtimer(&dtime,&itime,1);
       time = (float) dtime;
       tpush += time;
@@ -347,19 +486,60 @@ L500: if (nloop <= ntime)
          cppabort();
          exit(1);
       }
+/* compress particles leaving the processor: updates psbufl, psbufr */
+      if (lpack==1) {
+         dtimer(&dtime,&itime,-1);
+         cppppack2l(sbufl,sbufr,psbufl,psbufr,ncll,nclr,edges,idimp,nx,
+                    ny,mx,my,mx1);
+         dtimer(&dtime,&itime,1);
+         time = (float) dtime;
+         tsort += time;
+      }
 /* move particles into appropriate spatial regions: */
-/* updates rbufr, rbufl, mcll, mclr */
+/* updates prbufr, prbufl, mcll, mclr */
       dtimer(&dtime,&itime,-1);
-      cpppmove2(sbufr,sbufl,rbufr,rbufl,ncll,nclr,mcll,mclr,kstrt,nvp,
-                idimp,nbmaxp,mx1);
+/* start move, completed during second part of reorder */
+      if (lpipe==1) {
+         cppipmove2(psbufr,psbufl,prbufr,prbufl,ncll,nclr,mcll,mclr,
+                    kstrt,nvp,idimpm,nbmaxp,mx1);
+      }
+      else {
+         cpppmove2(psbufr,psbufl,prbufr,prbufl,ncll,nclr,mcll,mclr,
+                   kstrt,nvp,idimpm,nbmaxp,mx1);
+      }
       dtimer(&dtime,&itime,1);
       time = (float) dtime;
       tmov += time;
 /* second part of particle reorder on x and y cell with mx, my tiles: */
 /* updates ppart, kpic */
       dtimer(&dtime,&itime,-1);
-      cppporder2lb(ppart,ppbuff,rbufl,rbufr,kpic,ncl,iholep,mcll,mclr,
-                   idimp,nppmx0,mx1,myp1,npbmx,ntmaxp,nbmaxp,&irc);
+      if (lpipe==1) {
+/* fill interior tiles while particles from other processors arrive */
+         cppporder2lbr(ppart,ppbuff,rbufl,rbufr,kpic,ncl,iholep,mcll,
+                       mclr,idimp,nppmx0,mx1,myp1,npbmx,ntmaxp,nbmaxp,2,
+                       myp1-1,&irc);
+/* finish move and fill first and last rows of tiles */
+         cppwpmove2(nvp);
+/* restore compressed particles: updates rbufl, rbufr */
+         if (lpack==1)
+            cpppunpack2l(prbufl,prbufr,rbufl,rbufr,mcll,mclr,edges,
+                         idimp,nx,ny,mx,my,mx1);
+         cppporder2lbr(ppart,ppbuff,rbufl,rbufr,kpic,ncl,iholep,mcll,
+                       mclr,idimp,nppmx0,mx1,myp1,npbmx,ntmaxp,nbmaxp,1,
+                       1,&irc);
+         if (myp1 > 1)
+            cppporder2lbr(ppart,ppbuff,rbufl,rbufr,kpic,ncl,iholep,mcll,
+                          mclr,idimp,nppmx0,mx1,myp1,npbmx,ntmaxp,nbmaxp,
+                          myp1,myp1,&irc);
+      }
+      else {
+/* restore compressed particles: updates rbufl, rbufr */
+         if (lpack==1)
+            cpppunpack2l(prbufl,prbufr,rbufl,rbufr,mcll,mclr,edges,
+                         idimp,nx,ny,mx,my,mx1);
+         cppporder2lb(ppart,ppbuff,rbufl,rbufr,kpic,ncl,iholep,mcll,mclr,
+                      idimp,nppmx0,mx1,myp1,npbmx,ntmaxp,nbmaxp,&irc);
+      }
       dtimer(&dtime,&itime,1);
       time = (float) dtime;
       tsort += time;
@@ -384,7 +564,66 @@ L500: if (nloop <= ntime)
             printf("%e %e %e\n",we,wke,wke+we);
          }
       }
+
+/* velocity and phase space distribution diagnostic: updates fvv, fxv */
+/* rank 0 writes ntime, fvv and fxv to file fdist                     */
+      if (ndist > 0) {
+         if (ntime%ndist==0) {
+            dtimer(&dtime,&itime,-1);
+            cppvdist2(ppart,kpic,fvv,fxv,vmx,nx,nmv,nxb,idimp,nppmx0,
+                      mxyp1,&irc);
+            if (irc != 0) {
+               printf("%d,cppvdist2 error: irc=%d\n",kstrt,irc);
+               cppabort();
+               exit(1);
+            }
+            cppsum(fvv,fvw,nmv*nmv);
+            cppsum(fxv,fvw,nxb*nmv);
+            if (kstrt==1) {
+               fwrite(&ntime,sizeof(int),1,unitd);
+               fwrite(fvv,sizeof(float),nmv*nmv,unitd);
+               fwrite(fxv,sizeof(float),nxb*nmv,unitd);
+            }
+            dtimer(&dtime,&itime,1);
+            tdist += (float) dtime;
+         }
+      }
       ntime += 1;
+
+/* write checkpoint with MPI-IO: electric field, charge density in */
+/* fourier space and particles of all processors are written to one */
+/* file, part is used as scratch for the particles */
+      if (nchkpt > 0) {
+         if (ntime%nchkpt==0) {
+            dtimer(&dtime,&itime,-1);
+            cpppcopyout(part,ppart,kpic,&npp,npmax,nppmx0,idimp,mxyp1,
+                        &irc);
+            if (irc != 0) {
+               printf("%d,cpppcopyout overflow error, irc=%d\n",kstrt,
+                      irc);
+               cppabort();
+               exit(1);
+            }
+            isc[0] = ntime; isc[1] = nx; isc[2] = ny; isc[3] = npx;
+            isc[4] = npy; isc[5] = idimp;
+            fsc[0] = we; fsc[1] = wke;
+            cppwchkpth2(fchkpt,6,isc,2,fsc,&ierr);
+            if (ierr==0) {
+               cppwchkpta2(fxye,nnxe,nyp,noff,ny);
+               cppwchkpta2((float *)qt,2*nye,kxps,kxp*idproc,nxh);
+               cppwchkptp2(part,edges,npp,idimp,npmax);
+               cppwchkptc2(&ierr);
+            }
+            if (ierr != 0) {
+               if (kstrt==1) {
+                  printf("checkpoint write error: ierr=%d\n",ierr);
+               }
+               goto L3000;
+            }
+            dtimer(&dtime,&itime,1);
+            tchkpt += (float) dtime;
+         }
+      }
       goto L500;
 L2000:
 
@@ -393,6 +632,8 @@ L2000:
    if (kstrt==1) {
       printf("ntime = %i\n",ntime);
       printf("MPI nodes nvp = %i\n",nvp);
+      if (lshm==1)
+         printf("MPI nodes sharing memory nshm = %i\n",nshm);
       printf("Final Field, Kinetic and Total Energies:\n");
       printf("%e %e %e\n",we,wke,wke+we);
 
@@ -404,6 +645,10 @@ L2000:
       printf("push time = %f\n",tpush);
       printf("particle move time = %f\n",tmov);
       printf("sort time = %f\n",tsort);
+      if ((nchkpt > 0) || (lrestart==1))
+         printf("checkpoint time = %f\n",tchkpt);
+      if (ndist > 0)
+         printf("distribution time = %f\n",tdist);
       tfield += tguard + tfft[0];
       printf("total solver time = %f\n",tfield);
       tsort += tmov;
@@ -421,6 +666,8 @@ L2000:
    }
 
 L3000:
+   if (unitd != NULL)
+      fclose(unitd);
    cppexit();
    return 0;
 }
@@ -42,8 +42,18 @@
 !
 ! declare scalars for MPI code
       integer :: ntpose = 1
+! ltpose = (0,1) = (no,yes) use non-blocking all-to-all transpose
+      integer :: ltpose = 0
+! lpipe = (0,1) = (no,yes) overlap guard cell and particle communication
+! with push and reorder of interior tiles
+      integer :: lpipe = 0
+! lpack = (0,1) = (no,yes) send particles leaving the processor with
+! positions compressed to 16 bit fixed point
+      integer :: lpack = 0
+! idimpm = number of words per particle in messages
+      integer :: idimpm
       integer :: nvp, idproc, kstrt, npmax, kxp, kyp, nypmx, nypmn
-      integer :: nyp, noff, npp, nps, myp1, mxyp1
+      integer :: nyp, noff, npp, nps, myp1, mxyp1, nbs
 !
 ! declare scalars for OpenMP code
       integer :: nppmx, nppmx0, nbmaxp, ntmaxp, npbmx, irc
@@ -74,6 +84,9 @@
 ! sbufl/sbufr = particle buffers sent to nearby processors
 ! rbufl/rbufr = particle buffers received from nearby processors
       real, dimension(:,:), pointer :: sbufl, sbufr, rbufl, rbufr
+! psbufl/psbufr/prbufl/prbufr = particle message buffers, same as
+! sbufl/sbufr/rbufl/rbufr unless lpack = 1
+      real, dimension(:,:), pointer :: psbufl, psbufr, prbufl, prbufr
 ! edges(1:2) = lower:upper y boundaries of particle partition
       real, dimension(:), pointer  :: edges
 ! scr = guard cell buffer received from nearby processors
@@ -169,7 +182,10 @@
       allocate(kpic(mxyp1))
 !
 ! allocate and initialize data for MPI code
-      allocate(bs(ndim,kxp,kyp),br(ndim,kxp,kyp))
+! non-blocking transpose needs a separate buffer for each processor
+      nbs = 1
+      if (ltpose==1) nbs = nvp
+      allocate(bs(ndim,kxp,kyp*nbs),br(ndim,kxp,kyp*nbs))
       allocate(scr(nxe*ndim))
 !
 ! prepare fft tables
@@ -206,6 +222,14 @@
       nbmaxp = 0.25*mx1*npbmx
       allocate(sbufl(idimp,nbmaxp),sbufr(idimp,nbmaxp))
       allocate(rbufl(idimp,nbmaxp),rbufr(idimp,nbmaxp))
+      idimpm = idimp
+      psbufl => sbufl; psbufr => sbufr
+      prbufl => rbufl; prbufr => rbufr
+      if (lpack==1) then
+         idimpm = idimp - 1
+         allocate(psbufl(idimpm,nbmaxp),psbufr(idimpm,nbmaxp))
+         allocate(prbufl(idimpm,nbmaxp),prbufr(idimpm,nbmaxp))
+      endif
       allocate(ppart(idimp,nppmx0,mxyp1))
       allocate(ppbuff(idimp,npbmx,mxyp1))
       allocate(ncl(8,mxyp1))
@@ -254,8 +278,8 @@
 ! transform charge to fourier space with OpenMP: updates qt, modifies qe
       call dtimer(dtime,itime,-1)
       isign = -1
-      call WPPFFT2RM(qe,qt,bs,br,isign,ntpose,mixup,sct,ttp,indx,indy,  &
-     &kstrt,nvp,nxeh,nye,kxp,kyp,nypmx,nxhy,nxyh)
+      call WPPFFT2RM(qe,qt,bs,br,isign,ntpose,ltpose,mixup,sct,ttp,     &
+     &indx,indy,kstrt,nvp,nxeh,nye,kxp,kyp,nypmx,nxhy,nxyh)
       call dtimer(dtime,itime,1)
       time = real(dtime)
       tfft(1) = tfft(1) + time
@@ -273,8 +297,8 @@
 ! transform force to real space with OpenMP: updates fxye, modifies fxyt
       call dtimer(dtime,itime,-1)
       isign = 1
-      call WPPFFT2RM2(fxye,fxyt,bs,br,isign,ntpose,mixup,sct,ttp,indx,  &
-     &indy,kstrt,nvp,nxeh,nye,kxp,kyp,nypmx,nxhy,nxyh)
+      call WPPFFT2RM2(fxye,fxyt,bs,br,isign,ntpose,ltpose,mixup,sct,    &
+     &ttp,indx,indy,kstrt,nvp,nxeh,nye,kxp,kyp,nypmx,nxhy,nxyh)
       call dtimer(dtime,itime,1)
       time = real(dtime)
       tfft(1) = tfft(1) + time
@@ -282,8 +306,14 @@
 !
 ! copy guard cells with OpenMP: updates fxye
       call dtimer(dtime,itime,-1)
-      call PPNCGUARD2L(fxye,nyp,kstrt,nvp,nnxe,nypmx)
-      call PPCGUARD2XL(fxye,nyp,nx,ndim,nxe,nypmx)
+! start copy of guard cells in y, completed during push
+      if (lpipe==1) then
+         call PPCGUARD2XL(fxye,nyp-1,nx,ndim,nxe,nypmx)
+         call PPINCGUARD2L(fxye,nyp,kstrt,nvp,nnxe,nypmx)
+      else
+         call PPNCGUARD2L(fxye,nyp,kstrt,nvp,nnxe,nypmx)
+         call PPCGUARD2XL(fxye,nyp,nx,ndim,nxe,nypmx)
+      endif
       call dtimer(dtime,itime,1)
       time = real(dtime)
       tguard = tguard + time
@@ -295,8 +325,21 @@
 !     call PPGPPUSH2L(ppart,fxye,kpic,noff,nyp,qbme,dt,wke,nx,ny,mx,my, &
 !    &idimp,nppmx0,nxe,nypmx,mx1,mxyp1,ipbc)
 ! updates ppart, wke, ncl, iholep, irc
-      call PPGPPUSHF2L(ppart,fxye,kpic,ncl,iholep,noff,nyp,qbme,dt,wke, &
-     &nx,ny,mx,my,idimp,nppmx0,nxe,nypmx,mx1,mxyp1,ntmaxp,irc)
+      if (lpipe==1) then
+! push tiles which do not need guard cells in y while they arrive
+         call PPGPPUSHF2LR(ppart,fxye,kpic,ncl,iholep,noff,nyp,qbme,dt,&
+     &wke,nx,ny,mx,my,idimp,nppmx0,nxe,nypmx,mx1,mxyp1,ntmaxp,1,myp1-1,&
+     &irc)
+! finish copy of guard cells and push last row of tiles
+         call PPWNCGUARD2L(nvp)
+         call PPCGUARD2XL(fxye,nyp,nx,ndim,nxe,nypmx)
+         call PPGPPUSHF2LR(ppart,fxye,kpic,ncl,iholep,noff,nyp,qbme,dt,&
+     &wke,nx,ny,mx,my,idimp,nppmx0,nxe,nypmx,mx1,mxyp1,ntmaxp,myp1,    &
+     &myp1,irc)
+      else
+         call PPGPPUSHF2L(ppart,fxye,kpic,ncl,iholep,noff,nyp,qbme,dt, &
+     &wke,nx,ny,mx,my,idimp,nppmx0,nxe,nypmx,mx1,mxyp1,ntmaxp,irc)
+      endif
       call dtimer(dtime,itime,1)
       time = real(dtime)
       tpush = tpush + time
@@ -324,19 +367,59 @@
          call PPABORT()
          stop
       endif
+! compress particles leaving the processor: updates psbufl, psbufr
+      if (lpack==1) then
+         call dtimer(dtime,itime,-1)
+         call PPPPACK2L(sbufl,sbufr,psbufl,psbufr,ncll,nclr,edges,     &
+     &idimp,nx,ny,mx,my,mx1)
+         call dtimer(dtime,itime,1)
+         time = real(dtime)
+         tsort = tsort + time
+      endif
 ! move particles into appropriate spatial regions:
-! updates rbufr, rbufl, mcll, mclr
+! updates prbufr, prbufl, mcll, mclr
       call dtimer(dtime,itime,-1)
-      call PPPMOVE2(sbufr,sbufl,rbufr,rbufl,ncll,nclr,mcll,mclr,kstrt,  &
-     &nvp,idimp,nbmaxp,mx1)
+! start move, completed during second part of reorder
+      if (lpipe==1) then
+         call PPIPMOVE2(psbufr,psbufl,prbufr,prbufl,ncll,nclr,mcll,    &
+     &mclr,kstrt,nvp,idimpm,nbmaxp,mx1)
+      else
+         call PPPMOVE2(psbufr,psbufl,prbufr,prbufl,ncll,nclr,mcll,     &
+     &mclr,kstrt,nvp,idimpm,nbmaxp,mx1)
+      endif
       call dtimer(dtime,itime,1)
       time = real(dtime)
       tmov = tmov + time
 ! second part of particle reorder on x and y cell with mx, my tiles:
 ! updates ppart, kpic
       call dtimer(dtime,itime,-1)
-      call PPPORDER2LB(ppart,ppbuff,rbufl,rbufr,kpic,ncl,iholep,mcll,   &
-     &mclr,idimp,nppmx0,mx1,myp1,npbmx,ntmaxp,nbmaxp,irc)
+      if (lpipe==1) then
+! fill interior tiles while particles from other processors arrive
+         call PPPORDER2LBR(ppart,ppbuff,rbufl,rbufr,kpic,ncl,iholep,   &
+     &mcll,mclr,idimp,nppmx0,mx1,myp1,npbmx,ntmaxp,nbmaxp,2,myp1-1,irc)
+! finish move and fill first and last rows of tiles
+         call PPWPMOVE2(nvp)
+! restore compressed particles: updates rbufl, rbufr
+         if (lpack==1) then
+            call PPPUNPACK2L(prbufl,prbufr,rbufl,rbufr,mcll,mclr,      &
+     &edges,idimp,nx,ny,mx,my,mx1)
+         endif
+         call PPPORDER2LBR(ppart,ppbuff,rbufl,rbufr,kpic,ncl,iholep,   &
+     &mcll,mclr,idimp,nppmx0,mx1,myp1,npbmx,ntmaxp,nbmaxp,1,1,irc)
+         if (myp1 > 1) then
+            call PPPORDER2LBR(ppart,ppbuff,rbufl,rbufr,kpic,ncl,iholep,&
+     &mcll,mclr,idimp,nppmx0,mx1,myp1,npbmx,ntmaxp,nbmaxp,myp1,myp1,   &
+     &irc)
+         endif
+      else
+! restore compressed particles: updates rbufl, rbufr
+         if (lpack==1) then
+            call PPPUNPACK2L(prbufl,prbufr,rbufl,rbufr,mcll,mclr,      &
+     &edges,idimp,nx,ny,mx,my,mx1)
+         endif
+         call PPPORDER2LB(ppart,ppbuff,rbufl,rbufr,kpic,ncl,iholep,    &
+     &mcll,mclr,idimp,nppmx0,mx1,myp1,npbmx,ntmaxp,nbmaxp,irc)
+      endif
       call dtimer(dtime,itime,1)
       time = real(dtime)
       tsort = tsort + time
@@ -10,9 +10,16 @@
    cppdsum performs parallel sum of a double precision vector.
    cppimax performs parallel maximum of an integer vector.
    cppdmax performs parallel maximum of a double precision vector.
+   cppshminit2 creates MPI-3 shared memory windows used for
+               communication between processors on the same node, and
+               returns particle buffers which reside in the window.
    cppncguard2l copies data to guard cells in y for scalar data, linear
                 interpolation, and distributed data with non-uniform
                 partition.
+   cppincguard2l starts copying data to guard cells in y for scalar
+                 data, using non-blocking messages.
+   cppwncguard2l waits for guard cell copy started by cppincguard2l to
+                 complete.
    cppnaguard2l adds guard cells in y for scalar array, linear
                 interpolation, and distributed data with non-uniform
                 partition.
@@ -24,14 +31,42 @@
    cppntpose performs a transpose of an n component complex vector array,
             distributed in y, to an n component complex vector array,
             distributed in x.
+   cpptposenb performs a transpose of a complex scalar array, distributed
+              in y, to a complex scalar array, distributed in x, using
+              non-blocking messages to all processors at once.
+   cppntposenb performs a transpose of an n component complex vector
+               array, distributed in y, to an n component complex vector
+               array, distributed in x, using non-blocking messages to all
+               processors at once.
    cpppmove2 moves particles into appropriate spatial regions for tiled
              distributed data.
+   cppipmove2 starts moving particles into appropriate spatial regions
+              for tiled distributed data, using non-blocking messages.
+   cppwpmove2 waits for particle move started by cppipmove2 to
+              complete.
+   cppwchkpth2 opens a shared checkpoint file for writing with MPI-IO
+               and saves the scalars.
+   cppwchkpta2 writes the rows of a distributed array to a checkpoint
+               file with a collective write.
+   cppwchkptp2 writes particles and an index of particles and partition
+               boundaries per processor to a checkpoint file with a
+               collective write.
+   cppwchkptc2 completes a checkpoint file.
+   cpprchkpth2 opens a shared checkpoint file for reading with MPI-IO
+               and reads the scalars.
+   cpprchkpta2 reads the rows of a distributed array from a checkpoint
+               file, in any partition.
+   cpprchkptp2 reads the particles in a partition from a checkpoint
+               file, written by the same or a different number of
+               processors.
+   cpprchkptc2 closes a checkpoint file opened for reading.
    written by viktor k. decyk, ucla
    copyright 1995, regents of the university of california
    update: february 26, 2018                                         */
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <complex.h>
 #include "mpi.h"
 #include "mpplib2.h"
@@ -45,12 +80,81 @@
    mdouble = default double precision type
    lworld = MPI_COMM_WORLD communicator
    msum = MPI_SUM
-   mmax = MPI_MAX */
+   mmax = MPI_MAX
+   mgsid = requests for guard cells in flight, from cppincguard2l
+   mpsid = requests for particles in flight, from cppipmove2 */
 
 static int nproc;
 static MPI_Comm lgrp, lworld;
 static MPI_Datatype mreal, mint, mcplx, mdouble;
 static MPI_Op msum, mmax;
+static MPI_Request mgsid[2], mpsid[8];
+
+/* shared memory windows for processors on the same node, from
+   cppshminit2
+   lshm = (0,1) = (no,yes) shared memory windows are used
+   lshmc = communicator for processors sharing memory with this one
+   mshmw = shared memory window
+   mshm[k] = rank in lshmc of processor k in lgrp, -1 if off node
+   shmbase[k] = base address of window segment of rank k in lshmc
+   each segment contains two guard cell slots, two sets of transpose
+   slots, one block for each processor on the node, then sbufr, sbufl,
+   nclr, ncll.  slots alternate between exchanges, counted by nshmx, so
+   that one barrier per exchange is enough
+   nshmg/nshmt/nshmb/nshmn = size of guard/transpose block/particle
+   buffer/particle offset slot
+   nshmp = number of processors on the node
+   nofft/noffp/nofpl/nofcr/nofcl = byte offset of transpose slots,
+   sbufr, sbufl, nclr, ncll
+   nshmi = parity of pending exchange from cppincguard2l/cppipmove2 */
+static int lshm = 0, nshmx = 0, nshmi = 0;
+static MPI_Comm lshmc;
+static MPI_Win mshmw = MPI_WIN_NULL;
+static int *mshm = NULL;
+static char **shmbase = NULL;
+static int nshmg, nshmt, nshmb, nshmn, nshmp;
+static MPI_Aint nofft, noffp, nofpl, nofcr, nofcl;
+/* pending non-blocking shared memory exchanges */
+static float *shmgr = NULL, *shmrr = NULL, *shmrl = NULL;
+static int *shmmr = NULL, *shmml = NULL;
+static int shmkg, shmng, shmkr, shmkl, shmmx1, shmidimp;
+
+/* shared checkpoint file written and read with MPI-IO
+   nchkmax = maximum number of scalars or arrays in a checkpoint
+   nchkal = alignment of arrays in checkpoint file, in bytes
+   nchkbf = number of particles read at a time when repartitioning */
+#define NCHKMAX         32
+#define NCHKAL          4096
+#define NCHKBF          65536
+
+/* header of checkpoint file, written by processor 0
+   magic = file identifier
+   nvp = number of processors which wrote the file
+   nis/nfs/narr = number of integer/real scalars and arrays
+   nrow[n] = length of each row of array n, in reals,
+   or size of phase space for particles
+   nrows[n] = total number of rows of array n, 0 for particles
+   noffa[n] = file offset of array n, in bytes
+   ntot[n] = total number of particles in particle array n */
+struct ppchkhead {
+   char magic[8];
+   int nvp, nis, nfs, narr;
+   int isc[NCHKMAX];
+   float fsc[NCHKMAX];
+   int nrow[NCHKMAX], nrows[NCHKMAX];
+   long long noffa[NCHKMAX], ntot[NCHKMAX];
+};
+
+static char ppchkmagic[8] = "MPCHK2";
+/* mchk = checkpoint file being written or read */
+/* nchkf = offset of next array in file being written */
+/* chkerr = error code of checkpoint being written */
+/* fchk = name of checkpoint file being written */
+static MPI_File mchk = MPI_FILE_NULL;
+static MPI_Offset nchkf = 0;
+static int chkerr = 0;
+static struct ppchkhead chkhd;
+static char fchk[256];
 
 static FILE *unit2 = NULL;
 
@@ -141,6 +245,15 @@ local data */
 /* indicate whether MPI_INIT has been called */
    ierror = MPI_Initialized(&flag);
    if (flag) {
+/* free shared memory windows */
+      if (mshmw != MPI_WIN_NULL) {
+         ierror = MPI_Win_unlock_all(mshmw);
+         ierror = MPI_Win_free(&mshmw);
+         ierror = MPI_Comm_free(&lshmc);
+         free(shmbase);
+         free(mshm);
+         lshm = 0;
+      }
 /* synchronize processes */
       ierror = MPI_Barrier(lworld);
 /* terminate MPI execution environment */
@@ -265,6 +378,217 @@ local data */
    return;
 }
 
+/*--------------------------------------------------------------------*/
+void cppshminit2(float **sbufr, float **sbufl, int **nclr, int **ncll,
+                 int *nshm, int kstrt, int nvp, int nxv, int ndim,
+                 int kxp, int kyp, int idimp, int nbmax, int mxyp1) {
+/* this subroutine creates an MPI-3 shared memory window for the
+   processors on the same node as this one.  afterwards, guard cell
+   exchanges, particle moves and transposes between processors on the
+   same node read the data directly from the window of the other
+   processor, while messages to other nodes are unchanged.
+   the particle buffers sbufr, sbufl, nclr, ncll are allocated in the
+   window, so that particles leaving to a processor on the same node
+   are copied only once.  the window is freed by cppexit.
+   output: sbufr, sbufl, nclr, ncll, nshm
+   sbufr/sbufl = buffer for particles being sent to upper/lower
+   processor, of size idimp*nbmax
+   nclr/ncll = particle number being sent to upper/lower processor, of
+   size 3*mxyp1
+   nshm = number of processors sharing memory with this one
+   kstrt = starting data block number
+   nvp = number of real or virtual processors
+   nxv = first dimension of field arrays with guard cells
+   ndim = maximum number of components in vector field arrays
+   kxp/kyp = number of data values per block in x/y in transposes
+   idimp = size of phase space = 4 or 5
+   nbmax =  size of buffers for passing particles between processors
+   mxyp1 = number of tiles in particle partition
+local data */
+   int j, nnode, idnode, disp, ierr;
+   int *ranks = NULL;
+   MPI_Aint lsize, asize;
+   MPI_Group lgroup, sgroup;
+   char *base;
+/* find processors on the same node */
+   ierr = MPI_Comm_split_type(lgrp,MPI_COMM_TYPE_SHARED,kstrt-1,
+                              MPI_INFO_NULL,&lshmc);
+   ierr = MPI_Comm_size(lshmc,&nnode);
+   ierr = MPI_Comm_rank(lshmc,&idnode);
+   nshmg = ndim*nxv;
+   nshmt = ndim*kxp*kyp;
+   nshmb = idimp*nbmax;
+   nshmn = 3*mxyp1;
+/* segment layout, each part aligned on 64 byte boundaries */
+   nofft = 64*((2*nshmg*sizeof(float) + 63)/64);
+   noffp = nofft + 64*((2*nnode*nshmt*sizeof(float complex) + 63)/64);
+   nofpl = noffp + 64*((nshmb*sizeof(float) + 63)/64);
+   nofcr = nofpl + 64*((nshmb*sizeof(float) + 63)/64);
+   nofcl = nofcr + 64*((nshmn*sizeof(int) + 63)/64);
+   lsize = nofcl + 64*((nshmn*sizeof(int) + 63)/64);
+   ierr = MPI_Win_allocate_shared(lsize,1,MPI_INFO_NULL,lshmc,&base,
+                                  &mshmw);
+/* find base address of segments of other processors on the node */
+   shmbase = (char **) malloc(nnode*sizeof(char *));
+   for (j = 0; j < nnode; j++) {
+      ierr = MPI_Win_shared_query(mshmw,j,&asize,&disp,&shmbase[j]);
+   }
+/* translate ranks in lgrp to ranks in lshmc */
+   mshm = (int *) malloc(nvp*sizeof(int));
+   ranks = (int *) malloc(nvp*sizeof(int));
+   for (j = 0; j < nvp; j++) {
+      ranks[j] = j;
+   }
+   ierr = MPI_Comm_group(lgrp,&lgroup);
+   ierr = MPI_Comm_group(lshmc,&sgroup);
+   ierr = MPI_Group_translate_ranks(lgroup,nvp,ranks,sgroup,mshm);
+   for (j = 0; j < nvp; j++) {
+      if (mshm[j]==MPI_UNDEFINED)
+         mshm[j] = -1;
+   }
+   ierr = MPI_Group_free(&sgroup);
+   ierr = MPI_Group_free(&lgroup);
+   free(ranks);
+/* open passive target epoch for the lifetime of the window */
+   ierr = MPI_Win_lock_all(MPI_MODE_NOCHECK,mshmw);
+   *sbufr = (float *) (base + noffp);
+   *sbufl = (float *) (base + nofpl);
+   *nclr = (int *) (base + nofcr);
+   *ncll = (int *) (base + nofcl);
+/* shared memory is only useful with more than one processor per node */
+   lshm = nnode > 1;
+   nshmx = 0;
+   nshmp = nnode;
+   *nshm = nnode;
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+static void cppshmsync() {
+/* this subroutine makes stores to the shared memory window visible to
+   all processors on the node, and counts the exchange
+local data */
+   int ierr;
+   ierr = MPI_Win_sync(mshmw);
+   ierr = MPI_Barrier(lshmc);
+   ierr = MPI_Win_sync(mshmw);
+   nshmx += 1;
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+static float *cppshmgslot(int k, int ip) {
+/* this function returns the guard cell slot with parity ip in the
+   window segment of processor k in lgrp */
+   return (float *) shmbase[mshm[k]] + nshmg*ip;
+}
+
+/*--------------------------------------------------------------------*/
+static float *cppshmgxch(float s[], float r[], int n, int ks, int kto,
+                         int kfrom, int moff) {
+/* this function sends n values in s from processor ks to processor kto
+   and receives n values from processor kfrom, using the shared memory
+   window for processors on the same node and messages otherwise.
+   it returns the location of the received data: r for messages, or
+   the guard cell slot of processor kfrom, which remains valid until
+   the next exchange
+local data */
+   int j, ip, ierr;
+   float *sg = NULL, *rg = NULL;
+   MPI_Request msid;
+   MPI_Status istatus;
+   ip = nshmx%2;
+/* publish data for processor on the same node */
+   if (mshm[kto] >= 0) {
+      sg = cppshmgslot(ks,ip);
+      for (j = 0; j < n; j++) {
+         sg[j] = s[j];
+      }
+   }
+/* exchange data with other nodes */
+   if (mshm[kfrom] < 0)
+      ierr = MPI_Irecv(r,n,mreal,kfrom,moff,lgrp,&msid);
+   if (mshm[kto] < 0)
+      ierr = MPI_Send(s,n,mreal,kto,moff,lgrp);
+   cppshmsync();
+   if (mshm[kfrom] >= 0) {
+      rg = cppshmgslot(kfrom,ip);
+   }
+   else {
+      ierr = MPI_Wait(&msid,&istatus);
+      rg = r;
+   }
+   return rg;
+}
+
+/*--------------------------------------------------------------------*/
+static int cppshmtpose(float complex f[], float complex g[], int nx,
+                       int ny, int kxp, int kyp, int ks, int nvp,
+                       int ndim, int nxv, int nyv) {
+/* this function performs the part of the transpose in cppntpose
+   between processors on the same node.  blocks for all processors on
+   the node are extracted into the shared memory window at once, then
+   each processor inserts the blocks meant for it directly from the
+   windows of the others.
+   returns 1 if the blocks on the node were transposed, 0 if shared
+   memory windows are not used
+local data */
+   int i, j, k, id, kxps, kyps, joff, koff, ld, ip;
+   int nnxv, nnyv;
+   float complex *sn = NULL, *tn = NULL;
+   if ((!lshm) || (ndim*kxp*kyp > nshmt))
+      return 0;
+   ip = nshmx%2;
+   kxps = nx - kxp*ks;
+   kxps = 0 > kxps ? 0 : kxps;
+   kxps = kxp < kxps ? kxp : kxps;
+   kyps = ny - kyp*ks;
+   kyps = 0 > kyps ? 0 : kyps;
+   kyps = kyp < kyps ? kyp : kyps;
+   nnxv = ndim*nxv;
+   nnyv = ndim*nyv;
+/* extract data for processors on the same node */
+   for (id = 0; id < nvp; id++) {
+      if (mshm[id] < 0)
+         continue;
+      sn = (float complex *) (shmbase[mshm[ks]] + nofft)
+         + nshmt*(nshmp*ip + mshm[id]);
+      joff = kxp*id;
+      ld = nx - joff;
+      ld = 0 > ld ? 0 : ld;
+      ld = kxp < ld ? kxp : ld;
+#pragma omp parallel for private(i,j,k)
+      for (k = 0; k < kyps; k++) {
+         for (j = 0; j < ld; j++) {
+            for (i = 0; i < ndim; i++) {
+               sn[i+ndim*(j+ld*k)] = f[i+ndim*(j+joff)+nnxv*k];
+            }
+         }
+      }
+   }
+   cppshmsync();
+/* insert data from processors on the same node */
+   for (id = 0; id < nvp; id++) {
+      if (mshm[id] < 0)
+         continue;
+      tn = (float complex *) (shmbase[mshm[id]] + nofft)
+         + nshmt*(nshmp*ip + mshm[ks]);
+      koff = kyp*id;
+      ld = ny - koff;
+      ld = 0 > ld ? 0 : ld;
+      ld = kyp < ld ? kyp : ld;
+#pragma omp parallel for private(i,j,k)
+      for (k = 0; k < ld; k++) {
+         for (j = 0; j < kxps; j++) {
+            for (i = 0; i < ndim; i++) {
+               g[i+ndim*(k+koff)+nnyv*j] = tn[i+ndim*(j+kxps*k)];
+            }
+         }
+      }
+   }
+   return 1;
+}
+
 /*--------------------------------------------------------------------*/
 void cppncguard2l(float f[], int nyp, int kstrt, int nvp, int nxv,
                   int nypmx) {
@@ -281,6 +605,7 @@ void cppncguard2l(float f[], int nyp, int kstrt, int nvp, int nxv,
    linear interpolation, for distributed data
 local data */
    int j, ks, moff, kl, kr, ierr;
+   float *rg = NULL;
    MPI_Request msid;
    MPI_Status istatus;
 /* special case for one processor */
@@ -299,6 +624,16 @@ local data */
    kl = ks - 1;
    if (kl < 0)
       kl = kl + nvp;
+/* this segment is used for shared memory windows */
+   if (lshm && (nxv <= nshmg)) {
+      rg = cppshmgxch(f,&f[nxv*nyp],nxv,ks,kl,kr,moff);
+      if (rg != &f[nxv*nyp]) {
+         for (j = 0; j < nxv; j++) {
+            f[j+nxv*nyp] = rg[j];
+         }
+      }
+      return;
+   }
 /* this segment is used for mpi computers */
    ierr = MPI_Irecv(&f[nxv*nyp],nxv,mreal,kr,moff,lgrp,&msid);
    ierr = MPI_Send(f,nxv,mreal,kl,moff,lgrp);
@@ -306,6 +641,102 @@ local data */
    return;
 }
 
+/*--------------------------------------------------------------------*/
+void cppincguard2l(float f[], int nyp, int kstrt, int nvp, int nxv,
+                   int nypmx) {
+/* this subroutine starts copying data to guard cells in non-uniform
+   partitions, using non-blocking messages.  the copy is completed by
+   cppwncguard2l.  until then, the guard cells f[nyp][j] must not be
+   accessed and the first row f[0][j] must not be modified.
+   with shared memory windows, no other communication may be started
+   until then
+   f[k][j] = real data for grid j,k in particle partition.
+   the grid is non-uniform and includes one extra guard cell.
+   output: f
+   nyp = number of primary gridpoints in field partition
+   it is assumed the nyp > 0.
+   kstrt = starting data block number
+   nvp = number of real or virtual processors
+   nxv = first dimension of f, must be >= nx
+   nypmx = maximum size of field partition, including guard cell.
+   linear interpolation, for distributed data
+local data */
+   int j, ks, moff, kl, kr, ierr;
+   float *rg = NULL;
+/* special case for one processor */
+   if (nvp==1) {
+      for (j = 0; j < nxv; j++) {
+        f[j+nxv*nyp] = f[j];
+      }
+      return;
+   }
+   ks = kstrt - 1;
+   moff = nypmx*nvp + 2;
+/* copy guard cells */
+   kr = ks + 1;
+   if (kr >= nvp)
+      kr = kr - nvp;
+   kl = ks - 1;
+   if (kl < 0)
+      kl = kl + nvp;
+/* this segment is used for shared memory windows, the data for a */
+/* processor on the same node is published now and read by the    */
+/* wait, other nodes use messages                                  */
+   if (lshm && (nxv <= nshmg)) {
+      nshmi = nshmx%2;
+      shmng = nxv;
+      if (mshm[kl] >= 0) {
+         rg = cppshmgslot(ks,nshmi);
+         for (j = 0; j < nxv; j++) {
+            rg[j] = f[j];
+         }
+         mgsid[1] = MPI_REQUEST_NULL;
+      }
+      else {
+         ierr = MPI_Isend(f,nxv,mreal,kl,moff,lgrp,&mgsid[1]);
+      }
+      if (mshm[kr] >= 0) {
+         shmgr = &f[nxv*nyp];
+         shmkg = kr;
+         mgsid[0] = MPI_REQUEST_NULL;
+      }
+      else {
+         shmgr = NULL;
+         ierr = MPI_Irecv(&f[nxv*nyp],nxv,mreal,kr,moff,lgrp,&mgsid[0]);
+      }
+      return;
+   }
+/* this segment is used for mpi computers */
+   ierr = MPI_Irecv(&f[nxv*nyp],nxv,mreal,kr,moff,lgrp,&mgsid[0]);
+   ierr = MPI_Isend(f,nxv,mreal,kl,moff,lgrp,&mgsid[1]);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppwncguard2l(int nvp) {
+/* this subroutine waits for the guard cell copy started by
+   cppincguard2l to complete
+   nvp = number of real or virtual processors
+local data */
+   int j, ierr;
+   float *rg = NULL;
+   if (nvp==1)
+      return;
+   ierr = MPI_Waitall(2,mgsid,MPI_STATUSES_IGNORE);
+/* read data published by processor on the same node */
+   if (shmng > 0) {
+      cppshmsync();
+      if (shmgr != NULL) {
+         rg = cppshmgslot(shmkg,nshmi);
+         for (j = 0; j < shmng; j++) {
+            shmgr[j] = rg[j];
+         }
+      }
+      shmng = 0;
+   }
+   return;
+}
+
 /*--------------------------------------------------------------------*/
 void cppnaguard2l(float f[], float scr[], int nyp, int nx, int kstrt,
                   int nvp, int nxv, int nypmx) {
@@ -324,6 +755,7 @@ void cppnaguard2l(float f[], float scr[], int nyp, int nx, int kstrt,
    linear interpolation, for distributed data
 local data */
    int j, nx1, ks, moff, kl, kr, ierr;
+   float *rg = NULL;
    MPI_Request msid;
    MPI_Status istatus;
    nx1 = nx + 1;
@@ -344,6 +776,15 @@ local data */
    kl = ks - 1;
    if (kl < 0)
       kl = kl + nvp;
+/* this segment is used for shared memory windows */
+   if (lshm && (nxv <= nshmg)) {
+      rg = cppshmgxch(&f[nxv*nyp],scr,nxv,ks,kr,kl,moff);
+      for (j = 0; j < nx1; j++) {
+         f[j] += rg[j];
+         f[j+nxv*nyp] = 0.0;
+      }
+      return;
+   }
 /* this segment is used for mpi computers */
    ierr = MPI_Irecv(scr,nxv,mreal,kl,moff,lgrp,&msid);
    ierr = MPI_Send(&f[nxv*nyp],nxv,mreal,kr,moff,lgrp);
@@ -376,6 +817,7 @@ void cppnacguard2l(float f[], float scr[], int nyp, int nx, int ndim,
 local data */
    int j, n, nx1, ks, moff, kl, kr, ierr;
    int nnxv;
+   float *rg = NULL;
    MPI_Request msid;
    MPI_Status istatus;
    nx1 = nx + 1;
@@ -399,6 +841,17 @@ local data */
    kl = ks - 1;
    if (kl < 0)
       kl = kl + nvp;
+/* this segment is used for shared memory windows */
+   if (lshm && (nnxv <= nshmg)) {
+      rg = cppshmgxch(&f[nnxv*nyp],scr,nnxv,ks,kr,kl,moff);
+      for (j = 0; j < nx1; j++) {
+         for (n = 0; n < ndim; n++) {
+            f[n+ndim*j] += rg[n+ndim*j];
+            f[n+ndim*(j+nxv*nyp)] = 0.0;
+         }
+      }
+      return;
+   }
 /* this segment is used for mpi computers */
    ierr = MPI_Irecv(scr,nnxv,mreal,kl,moff,lgrp,&msid);
    ierr = MPI_Send(&f[nnxv*nyp],nnxv,mreal,kr,moff,lgrp);
@@ -434,7 +887,7 @@ void cpptpose(float complex f[], float complex g[], float complex s[],
    nxv/nyv = first dimension of f/g
    kypd/kxpd = second dimension of f/g
 local data */
-   int n, j, k, ks, kxps, kyps, kxyp, id, joff, koff, ld, ierr;
+   int n, j, k, ks, kxps, kyps, kxyp, id, joff, koff, ld, lsh, ierr;
    MPI_Request msid;
    MPI_Status istatus;
    ks = kstrt - 1;
@@ -467,11 +920,15 @@ local data */
 /*       }                                                      */
 /*    }                                                         */
 /* }                                                            */
+/* processors on the same node use shared memory windows */
+   lsh = cppshmtpose(f,g,nx,ny,kxp,kyp,ks,nvp,1,nxv,nyv);
 /* this segment is used for mpi computers */
    for (n = 0; n < nvp; n++) {
       id = n - ks;
       if (id < 0)
          id += nvp;
+      if (lsh && (mshm[id] >= 0))
+         continue;
 /* extract data to send */
       joff = kxp*id;
       ld = nx - joff;
@@ -528,7 +985,7 @@ void cppntpose(float complex f[], float complex g[], float complex s[],
    nxv/nyv = first dimension of f/g
    kypd/kxpd = second dimension of f/g
 local data */
-   int i, n, j, k, ks, kxps, kyps, kxyp, id, joff, koff, ld, ierr;
+   int i, n, j, k, ks, kxps, kyps, kxyp, id, joff, koff, ld, lsh, ierr;
    int nnxv, nnyv;
    MPI_Request msid;
    MPI_Status istatus;
@@ -569,11 +1026,15 @@ local data */
 /*       }                                                  */
 /*    }                                                     */
 /* }                                                        */
+/* processors on the same node use shared memory windows */
+   lsh = cppshmtpose(f,g,nx,ny,kxp,kyp,ks,nvp,ndim,nxv,nyv);
 /* this segment is used for mpi computers */
    for (n = 0; n < nvp; n++) {
       id = n - ks;
       if (id < 0)
          id += nvp;
+      if (lsh && (mshm[id] >= 0))
+         continue;
 /* extract data to send */
       joff = kxp*id;
       ld = nx - joff;
@@ -611,6 +1072,260 @@ local data */
    return;
 }
 
+/*--------------------------------------------------------------------*/
+static void cppntunpack(float complex g[], float complex t[], int id,
+                        int ny, int kxp, int kxps, int kyp, int ndim,
+                        int nyv) {
+/* this subroutine inserts block id of transposed data in t, received
+   from processor id, into g.  used by cppntposenb
+local data */
+   int i, j, k, koff, ld, nnyv;
+   float complex *tn;
+   nnyv = ndim*nyv;
+   tn = &t[ndim*kxp*kyp*id];
+   koff = kyp*id;
+   ld = ny - koff;
+   ld = 0 > ld ? 0 : ld;
+   ld = kyp < ld ? kyp : ld;
+#pragma omp parallel for private(i,j,k)
+   for (k = 0; k < ld; k++) {
+      for (j = 0; j < kxps; j++) {
+         for (i = 0; i < ndim; i++) {
+            g[i+ndim*(k+koff)+nnyv*j] = tn[i+ndim*(j+kxps*k)];
+         }
+      }
+   }
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cpptposenb(float complex f[], float complex g[], float complex s[],
+                float complex t[], int nx, int ny, int kxp, int kyp,
+                int kstrt, int nvp, int nxv, int nyv, int kxpd,
+                int kypd) {
+/* this subroutine performs a transpose of a matrix f, distributed in y,
+   to a matrix g, distributed in x, that is,
+   g[l][j][k+kyp*m] = f[m][k][j+kxp*l], where
+   0 <= j < kxp, 0 <= k < kyp, 0 <= l < nx/kxp, 0 <= m < ny/kyp
+   and where indices l and m can be distributed across processors.
+   this subroutine posts all receives first, then sends all messages
+   asynchronously, unpacking data in the order it arrives, so that
+   packing and unpacking overlap with communication.
+   it requires nvp times the scratch memory of cpptpose
+   f = complex input array
+   g = complex output array
+   s, t = complex scratch arrays, of size kxp*kyp*nvp
+   nx/ny = number of points in x/y
+   kxp/kyp = number of data values per block in x/y
+   kstrt = starting data block number
+   nvp = number of real or virtual processors
+   nxv/nyv = first dimension of f/g
+   kypd/kxpd = second dimension of f/g
+local data */
+   cppntposenb(f,g,s,t,nx,ny,kxp,kyp,kstrt,nvp,1,nxv,nyv,kxpd,kypd);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppntposenb(float complex f[], float complex g[], float complex s[],
+                 float complex t[], int nx, int ny, int kxp, int kyp,
+                 int kstrt, int nvp, int ndim, int nxv, int nyv,
+                 int kxpd, int kypd) {
+/* this subroutine performs a transpose of a matrix f, distributed in y,
+   to a matrix g, distributed in x, that is,
+   g[l][j][k+kyp*m][1:ndim] = f[m][k][j+kxp*l][1:ndim], where
+   0 <= j < kxp, 0 <= k < kyp, 0 <= l < nx/kxp, 0 <= m < ny/kyp
+   and where indices l and m can be distributed across processors.
+   this subroutine posts all receives first, then sends all messages
+   asynchronously, unpacking data in the order it arrives, so that
+   packing and unpacking overlap with communication.
+   the local block is copied directly.
+   it requires nvp times the scratch memory of cppntpose
+   f = complex input array
+   g = complex output array
+   s, t = complex scratch arrays, of size ndim*kxp*kyp*nvp
+   nx/ny = number of points in x/y
+   kxp/kyp = number of data values per block in x/y
+   kstrt = starting data block number
+   nvp = number of real or virtual processors
+   ndim = leading dimension of arrays f and g
+   nxv/nyv = first dimension of f/g
+   kypd/kxpd = second dimension of f/g
+local data */
+   int i, n, j, k, ks, kxps, kyps, kxyp, id, joff, koff, ld, flag, ierr;
+   int nnxv, nnyv;
+   MPI_Request msid[nvp], mrid[nvp];
+   MPI_Status istatus;
+   ks = kstrt - 1;
+   kxps = nx - kxp*ks;
+   kxps = 0 > kxps ? 0 : kxps;
+   kxps = kxp < kxps ? kxp : kxps;
+   kyps = ny - kyp*ks;
+   kyps = 0 > kyps ? 0 : kyps;
+   kyps = kyp < kyps ? kyp : kyps;
+   kxyp = ndim*kxp*kyp;
+   nnxv = ndim*nxv;
+   nnyv = ndim*nyv;
+/* special case for one processor */
+   if (nvp==1) {
+#pragma omp parallel for private(i,j,k)
+      for (k = 0; k < kyp; k++) {
+         for (j = 0; j < kxp; j++) {
+            for (i = 0; i < ndim; i++) {
+               g[i+ndim*k+nnyv*j] = f[i+ndim*j+nnxv*k];
+            }
+         }
+      }
+      return;
+   }
+/* post all receives, data from processor id is stored in block id */
+   for (n = 0; n < nvp; n++) {
+      id = n - ks;
+      if (id < 0)
+         id += nvp;
+      if (id != ks)
+         ierr = MPI_Irecv(&t[kxyp*id],kxyp,mcplx,id,n,lgrp,&mrid[id]);
+   }
+   mrid[ks] = MPI_REQUEST_NULL;
+   msid[ks] = MPI_REQUEST_NULL;
+/* extract and send data, data to processor id is stored in block id */
+   for (n = 0; n < nvp; n++) {
+      id = n - ks;
+      if (id < 0)
+         id += nvp;
+      if (id==ks)
+         continue;
+      joff = kxp*id;
+      ld = nx - joff;
+      ld = 0 > ld ? 0 : ld;
+      ld = kxp < ld ? kxp : ld;
+#pragma omp parallel for private(i,j,k)
+      for (k = 0; k < kyps; k++) {
+         for (j = 0; j < ld; j++) {
+            for (i = 0; i < ndim; i++) {
+               s[i+ndim*(j+ld*k)+kxyp*id] = f[i+ndim*(j+joff)+nnxv*k];
+            }
+         }
+      }
+      ld *= ndim*kyps;
+      ierr = MPI_Isend(&s[kxyp*id],ld,mcplx,id,n,lgrp,&msid[id]);
+/* insert any data which has already arrived */
+      flag = 1;
+      while (flag) {
+         ierr = MPI_Testany(nvp,mrid,&id,&flag,&istatus);
+         if (id==MPI_UNDEFINED)
+            flag = 0;
+         if (flag)
+            cppntunpack(g,t,id,ny,kxp,kxps,kyp,ndim,nyv);
+      }
+   }
+/* copy local block while messages are in flight */
+   joff = kxp*ks;
+   koff = kyp*ks;
+#pragma omp parallel for private(i,j,k)
+   for (k = 0; k < kyps; k++) {
+      for (j = 0; j < kxps; j++) {
+         for (i = 0; i < ndim; i++) {
+            g[i+ndim*(k+koff)+nnyv*j] = f[i+ndim*(j+joff)+nnxv*k];
+         }
+      }
+   }
+/* insert remaining data as it arrives */
+   for (n = 1; n < nvp; n++) {
+      ierr = MPI_Waitany(nvp,mrid,&id,&istatus);
+      if (id==MPI_UNDEFINED)
+         break;
+      cppntunpack(g,t,id,ny,kxp,kxps,kyp,ndim,nyv);
+   }
+/* wait for sends to complete */
+   ierr = MPI_Waitall(nvp,msid,MPI_STATUSES_IGNORE);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+static int cppshmpsend(float sbufr[], float sbufl[], int ncll[],
+                       int nclr[], int ks, int idimp, int nbmax,
+                       int mx1) {
+/* this function makes sure the particles being sent by processor ks
+   reside in its shared memory window, copying them if they were not
+   allocated by cppshminit2
+   returns 1 if shared memory windows are used, 0 otherwise
+local data */
+   int j, jsr, jsl;
+   float *wsr = NULL, *wsl = NULL;
+   int *wcr = NULL, *wcl = NULL;
+   if ((!lshm) || (idimp*nbmax > nshmb) || (3*mx1 > nshmn))
+      return 0;
+   wsr = (float *) (shmbase[mshm[ks]] + noffp);
+   wsl = (float *) (shmbase[mshm[ks]] + nofpl);
+   wcr = (int *) (shmbase[mshm[ks]] + nofcr);
+   wcl = (int *) (shmbase[mshm[ks]] + nofcl);
+   if (nclr != wcr) {
+      for (j = 0; j < 3*mx1; j++) {
+         wcr[j] = nclr[j];
+      }
+   }
+   if (ncll != wcl) {
+      for (j = 0; j < 3*mx1; j++) {
+         wcl[j] = ncll[j];
+      }
+   }
+   jsr = idimp*nclr[3*mx1-1];
+   if (sbufr != wsr) {
+      for (j = 0; j < jsr; j++) {
+         wsr[j] = sbufr[j];
+      }
+   }
+   jsl = idimp*ncll[3*mx1-1];
+   if (sbufl != wsl) {
+      for (j = 0; j < jsl; j++) {
+         wsl[j] = sbufl[j];
+      }
+   }
+   return 1;
+}
+
+/*--------------------------------------------------------------------*/
+static void cppshmprecv(float rbufr[], float rbufl[], int mcll[],
+                        int mclr[], int kl, int kr, int idimp,
+                        int mx1) {
+/* this subroutine reads the particles sent by processors kl and kr,
+   if they are on the same node, directly from their shared memory
+   windows.  the windows are synchronized before and after, so that
+   the senders may reuse their buffers afterwards
+local data */
+   int j, jsr, jsl;
+   float *wsr = NULL, *wsl = NULL;
+   int *wcr = NULL, *wcl = NULL;
+   cppshmsync();
+/* particles from below were sent to the upper processor of kl */
+   if (mshm[kl] >= 0) {
+      wsr = (float *) (shmbase[mshm[kl]] + noffp);
+      wcr = (int *) (shmbase[mshm[kl]] + nofcr);
+      for (j = 0; j < 3*mx1; j++) {
+         mcll[j] = wcr[j];
+      }
+      jsr = idimp*wcr[3*mx1-1];
+      for (j = 0; j < jsr; j++) {
+         rbufl[j] = wsr[j];
+      }
+   }
+/* particles from above were sent to the lower processor of kr */
+   if (mshm[kr] >= 0) {
+      wsl = (float *) (shmbase[mshm[kr]] + nofpl);
+      wcl = (int *) (shmbase[mshm[kr]] + nofcl);
+      for (j = 0; j < 3*mx1; j++) {
+         mclr[j] = wcl[j];
+      }
+      jsl = idimp*wcl[3*mx1-1];
+      for (j = 0; j < jsl; j++) {
+         rbufr[j] = wsl[j];
+      }
+   }
+   cppshmsync();
+   return;
+}
+
 /*--------------------------------------------------------------------*/
 void cpppmove2(float sbufr[], float sbufl[], float rbufr[], 
                float rbufl[], int ncll[], int nclr[], int mcll[],
@@ -666,6 +1381,47 @@ local data */
          }
       }
    }
+/* this segment is used for shared memory windows, messages are only */
+/* sent to processors on other nodes                                */
+   else if (cppshmpsend(sbufr,sbufl,ncll,nclr,ks,idimp,nbmax,mx1)) {
+      kr = ks + 1;
+      if (kr >= nvp)
+         kr -= nvp;
+      kl = ks - 1;
+      if (kl < 0)
+         kl += nvp;
+      for (i = 0; i < 8; i++) {
+         msid[i] = MPI_REQUEST_NULL;
+      }
+/* post receives */
+      if (mshm[kl] < 0) {
+         ierr = MPI_Irecv(mcll,ncsize,mint,kl,itg[0],lgrp,&msid[0]);
+         ierr = MPI_Irecv(rbufl,nbsize,mreal,kl,itg[2],lgrp,&msid[2]);
+      }
+      if (mshm[kr] < 0) {
+         ierr = MPI_Irecv(mclr,ncsize,mint,kr,itg[1],lgrp,&msid[1]);
+         ierr = MPI_Irecv(rbufr,nbsize,mreal,kr,itg[3],lgrp,&msid[3]);
+      }
+/* send particle number offsets */
+      if (mshm[kr] < 0)
+         ierr = MPI_Isend(nclr,ncsize,mint,kr,itg[0],lgrp,&msid[4]);
+      if (mshm[kl] < 0)
+         ierr = MPI_Isend(ncll,ncsize,mint,kl,itg[1],lgrp,&msid[5]);
+      ierr = MPI_Waitall(2,msid,MPI_STATUSES_IGNORE);
+/* send particles */
+      if (mshm[kr] < 0) {
+         jsr = idimp*nclr[3*mx1-1];
+         ierr = MPI_Isend(sbufr,jsr,mreal,kr,itg[2],lgrp,&msid[6]);
+      }
+      if (mshm[kl] < 0) {
+         jsl = idimp*ncll[3*mx1-1];
+         ierr = MPI_Isend(sbufl,jsl,mreal,kl,itg[3],lgrp,&msid[7]);
+      }
+/* read particles from processors on the same node */
+      cppshmprecv(rbufr,rbufl,mcll,mclr,kl,kr,idimp,mx1);
+      ierr = MPI_Waitall(8,msid,MPI_STATUSES_IGNORE);
+      return;
+   }
 /* this segment is used for mpi computers */
    else {
 /* get particles from below and above */
@@ -702,6 +1458,563 @@ local data */
    return;
 }
 
+/*--------------------------------------------------------------------*/
+void cppipmove2(float sbufr[], float sbufl[], float rbufr[],
+                float rbufl[], int ncll[], int nclr[], int mcll[],
+                int mclr[], int kstrt, int nvp, int idimp, int nbmax,
+                int mx1) {
+/* this subroutine starts moving particles into appropriate spatial
+   regions for distributed data, with 1d domain decomposition in y,
+   using non-blocking messages.  all messages are posted at once and
+   the move is completed by cppwpmove2.  until then, rbufr, rbufl,
+   mcll, mclr must not be accessed and sbufr, sbufl, ncll, nclr must
+   not be modified.
+   with shared memory windows, no other communication may be started
+   until then
+   tiles are assumed to be arranged in 2D linear memory
+   output: rbufr, rbufl, mcll, mclr
+   sbufl = buffer for particles being sent to lower processor
+   sbufr = buffer for particles being sent to upper processor
+   rbufl = buffer for particles being received from lower processor
+   rbufr = buffer for particles being received from upper processor
+   ncll = particle number being sent to lower processor
+   nclr = particle number being sent to upper processor
+   mcll = particle number being received from lower processor
+   mclr = particle number being received from upper processor
+   kstrt = starting data block number
+   nvp = number of real or virtual processors
+   idimp = size of phase space = 4 or 5
+   nbmax =  size of buffers for passing particles between processors
+   mx1 = (system length in x direction - 1)/mx + 1
+local data */
+   int ierr, i, ks, kl, kr, jsl, jsr;
+   int nbsize, ncsize;
+   int itg[4] = {3,4,5,6};
+/* special case for one processor */
+   if (nvp==1) {
+      cpppmove2(sbufr,sbufl,rbufr,rbufl,ncll,nclr,mcll,mclr,kstrt,nvp,
+                idimp,nbmax,mx1);
+      return;
+   }
+   ks = kstrt - 1;
+   nbsize = idimp*nbmax;
+   ncsize = 3*mx1;
+/* get particles from below and above */
+   kr = ks + 1;
+   if (kr >= nvp)
+      kr -= nvp;
+   kl = ks - 1;
+   if (kl < 0)
+      kl += nvp;
+/* this segment is used for shared memory windows, particles for */
+/* processors on the same node are read by the wait              */
+   if (cppshmpsend(sbufr,sbufl,ncll,nclr,ks,idimp,nbmax,mx1)) {
+      for (i = 0; i < 8; i++) {
+         mpsid[i] = MPI_REQUEST_NULL;
+      }
+      if (mshm[kl] < 0) {
+         ierr = MPI_Irecv(mcll,ncsize,mint,kl,itg[0],lgrp,&mpsid[0]);
+         ierr = MPI_Irecv(rbufl,nbsize,mreal,kl,itg[2],lgrp,&mpsid[2]);
+         ierr = MPI_Isend(ncll,ncsize,mint,kl,itg[1],lgrp,&mpsid[5]);
+         jsl = idimp*ncll[3*mx1-1];
+         ierr = MPI_Isend(sbufl,jsl,mreal,kl,itg[3],lgrp,&mpsid[7]);
+      }
+      if (mshm[kr] < 0) {
+         ierr = MPI_Irecv(mclr,ncsize,mint,kr,itg[1],lgrp,&mpsid[1]);
+         ierr = MPI_Irecv(rbufr,nbsize,mreal,kr,itg[3],lgrp,&mpsid[3]);
+         ierr = MPI_Isend(nclr,ncsize,mint,kr,itg[0],lgrp,&mpsid[4]);
+         jsr = idimp*nclr[3*mx1-1];
+         ierr = MPI_Isend(sbufr,jsr,mreal,kr,itg[2],lgrp,&mpsid[6]);
+      }
+      shmrr = rbufr;
+      shmrl = rbufl;
+      shmml = mcll;
+      shmmr = mclr;
+      shmkl = kl;
+      shmkr = kr;
+      shmidimp = idimp;
+      shmmx1 = mx1;
+      return;
+   }
+/* post receives */
+   ierr = MPI_Irecv(mcll,ncsize,mint,kl,itg[0],lgrp,&mpsid[0]);
+   ierr = MPI_Irecv(mclr,ncsize,mint,kr,itg[1],lgrp,&mpsid[1]);
+   ierr = MPI_Irecv(rbufl,nbsize,mreal,kl,itg[2],lgrp,&mpsid[2]);
+   ierr = MPI_Irecv(rbufr,nbsize,mreal,kr,itg[3],lgrp,&mpsid[3]);
+/* send particle number offsets */
+   ierr = MPI_Isend(nclr,ncsize,mint,kr,itg[0],lgrp,&mpsid[4]);
+   ierr = MPI_Isend(ncll,ncsize,mint,kl,itg[1],lgrp,&mpsid[5]);
+/* send particles */
+   jsr = idimp*nclr[3*mx1-1];
+   ierr = MPI_Isend(sbufr,jsr,mreal,kr,itg[2],lgrp,&mpsid[6]);
+   jsl = idimp*ncll[3*mx1-1];
+   ierr = MPI_Isend(sbufl,jsl,mreal,kl,itg[3],lgrp,&mpsid[7]);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppwpmove2(int nvp) {
+/* this subroutine waits for the particle move started by cppipmove2
+   to complete
+   nvp = number of real or virtual processors
+local data */
+   int ierr;
+   if (nvp==1)
+      return;
+   ierr = MPI_Waitall(8,mpsid,MPI_STATUSES_IGNORE);
+/* read particles from processors on the same node */
+   if (shmmx1 > 0) {
+      cppshmprecv(shmrr,shmrl,shmml,shmmr,shmkl,shmkr,shmidimp,shmmx1);
+      shmmx1 = 0;
+   }
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppwchkpth2(char *fname, int nis, int isc[], int nfs, float fsc[],
+                 int *irc) {
+/* this subroutine opens a shared checkpoint file for writing by all
+   processors with MPI-IO, and saves the scalars, which should be the
+   same on all processors.  distributed arrays are then written by
+   cppwchkpta2 and particles by cppwchkptp2, and the file is completed
+   by cppwchkptc2.  the file is written as fname.tmp and renamed when
+   complete, so that an interrupted checkpoint does not destroy the
+   previous one
+   input: all, output: irc
+   fname = name of checkpoint file
+   nis/nfs = number of integer/real scalars, <= 32
+   isc/fsc = integer/real scalars
+   irc = error code: 0 = ok, 1 = cannot create file, 4 = too many
+   scalars
+local data */
+   int n, ierr;
+   char ftmp[264];
+   MPI_Info minfo;
+   *irc = 0;
+   if ((nis > NCHKMAX) || (nfs > NCHKMAX) || (strlen(fname) > 255)) {
+      *irc = 4;
+      return;
+   }
+   memset(&chkhd,0,sizeof(struct ppchkhead));
+   memcpy(chkhd.magic,ppchkmagic,8);
+   chkhd.nvp = nproc;
+   chkhd.nis = nis;
+   chkhd.nfs = nfs;
+   for (n = 0; n < nis; n++) {
+      chkhd.isc[n] = isc[n];
+   }
+   for (n = 0; n < nfs; n++) {
+      chkhd.fsc[n] = fsc[n];
+   }
+   strcpy(fchk,fname);
+   sprintf(ftmp,"%s.tmp",fname);
+/* collective buffering lets a few aggregators access the file */
+   MPI_Info_create(&minfo);
+   MPI_Info_set(minfo,"romio_cb_write","enable");
+   ierr = MPI_File_open(lgrp,ftmp,MPI_MODE_WRONLY|MPI_MODE_CREATE,
+                        minfo,&mchk);
+   MPI_Info_free(&minfo);
+   if (ierr != MPI_SUCCESS) {
+      mchk = MPI_FILE_NULL;
+      *irc = 1;
+      return;
+   }
+/* discard any previous contents */
+   ierr = MPI_File_set_size(mchk,0);
+/* first block is reserved for header */
+   nchkf = NCHKAL;
+   chkerr = 0;
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppwchkpta2(float f[], int nrow, int nrp, int noffr, int nrows) {
+/* this subroutine writes a distributed array to the checkpoint file
+   opened by cppwchkpth2, with a collective write.  the array is
+   stored as nrows global rows, each processor writes its nrp rows,
+   which start at global row noffr.  the rows may be the nyp rows
+   of a particle partition, or the kxp rows of an array transposed
+   in fourier space, with complex data counted as two reals
+   input: all
+   f = distributed array, first nrp rows are written
+   nrow = length of each row, in reals
+   nrp = number of rows in this processor
+   noffr = global row number of first row in this processor
+   nrows = total number of rows, sum of nrp over processors
+local data */
+   int n, nsz, ierr;
+   MPI_Offset noff;
+   MPI_Status istatus;
+   if (mchk==MPI_FILE_NULL)
+      return;
+   n = chkhd.narr;
+   if (n >= NCHKMAX) {
+      chkerr = 4;
+      return;
+   }
+   ierr = MPI_Type_size(mreal,&nsz);
+   chkhd.nrow[n] = nrow;
+   chkhd.nrows[n] = nrows;
+   chkhd.noffa[n] = nchkf;
+   noff = nchkf + (MPI_Offset) nsz*nrow*(MPI_Offset) noffr;
+   ierr = MPI_File_write_at_all(mchk,noff,f,nrow*nrp,mreal,&istatus);
+   if (ierr != MPI_SUCCESS)
+      chkerr = 2;
+/* next array starts on a block boundary */
+   noff = (MPI_Offset) nsz*nrow*(MPI_Offset) nrows;
+   nchkf += NCHKAL*((noff + NCHKAL - 1)/NCHKAL);
+   chkhd.narr = n + 1;
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppwchkptp2(float part[], float edges[], int npp, int idimp,
+                 int npmax) {
+/* this subroutine writes particles to the checkpoint file opened by
+   cppwchkpth2, with a collective write.  an index with the number of
+   particles and the partition boundaries of each processor is written
+   first, followed by the particles of each processor in processor
+   order, which is also the order of the partitions in y
+   input: all
+   part[n][i] = coordinate i of particle n in partition
+   edges[0:1] = lower:upper boundary of particle partition
+   npp = number of particles in partition
+   idimp = size of phase space = 4
+   npmax = maximum number of particles in each partition
+local data */
+   int j, n, ks, nsz, ierr;
+   long long nsum, ntot;
+   MPI_Offset noff;
+   MPI_Status istatus;
+   int *kpp = NULL;
+   float *edgs = NULL;
+   if (mchk==MPI_FILE_NULL)
+      return;
+   n = chkhd.narr;
+   if (n >= NCHKMAX) {
+      chkerr = 4;
+      return;
+   }
+   ierr = MPI_Comm_rank(lgrp,&ks);
+   ierr = MPI_Type_size(mreal,&nsz);
+/* find particle index */
+   kpp = (int *) malloc(nproc*sizeof(int));
+   edgs = (float *) malloc(2*nproc*sizeof(float));
+   ierr = MPI_Allgather(&npp,1,mint,kpp,1,mint,lgrp);
+   ierr = MPI_Allgather(edges,2,mreal,edgs,2,mreal,lgrp);
+   nsum = 0;
+   ntot = 0;
+   for (j = 0; j < nproc; j++) {
+      if (j < ks)
+         nsum += kpp[j];
+      ntot += kpp[j];
+   }
+   chkhd.nrow[n] = idimp;
+   chkhd.nrows[n] = 0;
+   chkhd.noffa[n] = nchkf;
+   chkhd.ntot[n] = ntot;
+/* processor 0 writes the index */
+   if (ks==0) {
+      ierr = MPI_File_write_at(mchk,nchkf,kpp,nproc,mint,&istatus);
+      if (ierr != MPI_SUCCESS)
+         chkerr = 2;
+      noff = nchkf + sizeof(int)*(MPI_Offset) nproc;
+      ierr = MPI_File_write_at(mchk,noff,edgs,2*nproc,mreal,&istatus);
+      if (ierr != MPI_SUCCESS)
+         chkerr = 2;
+   }
+   free(edgs);
+   free(kpp);
+   noff = (sizeof(int) + 2*nsz)*(MPI_Offset) nproc;
+   nchkf += NCHKAL*((noff + NCHKAL - 1)/NCHKAL);
+/* write particles */
+   noff = nchkf + (MPI_Offset) nsz*idimp*(MPI_Offset) nsum;
+   ierr = MPI_File_write_at_all(mchk,noff,part,idimp*npp,mreal,
+                                &istatus);
+   if (ierr != MPI_SUCCESS)
+      chkerr = 2;
+   noff = (MPI_Offset) nsz*idimp*(MPI_Offset) ntot;
+   nchkf += NCHKAL*((noff + NCHKAL - 1)/NCHKAL);
+   chkhd.narr = n + 1;
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppwchkptc2(int *irc) {
+/* this subroutine completes the checkpoint file written by cppwchkpth2,
+   cppwchkpta2 and cppwchkptp2.  processor 0 writes the header, and
+   renames the file after it is closed
+   output: irc
+   irc = error code: 0 = ok, 1 = file not open, 2 = write error,
+   3 = rename error, 4 = too many arrays
+local data */
+   int ks, ierr;
+   char ftmp[264];
+   MPI_Status istatus;
+   if (mchk==MPI_FILE_NULL) {
+      *irc = 1;
+      return;
+   }
+   ierr = MPI_Comm_rank(lgrp,&ks);
+   if (ks==0) {
+      ierr = MPI_File_write_at(mchk,0,&chkhd,sizeof(struct ppchkhead),
+                               MPI_BYTE,&istatus);
+      if (ierr != MPI_SUCCESS)
+         chkerr = 2;
+   }
+   ierr = MPI_File_sync(mchk);
+   if (ierr != MPI_SUCCESS)
+      chkerr = 2;
+   ierr = MPI_File_close(&mchk);
+   mchk = MPI_FILE_NULL;
+   ierr = MPI_Allreduce(&chkerr,irc,1,mint,mmax,lgrp);
+/* rename completed file */
+   if (ks==0) {
+      if (*irc==0) {
+         sprintf(ftmp,"%s.tmp",fchk);
+         if (rename(ftmp,fchk) != 0)
+            *irc = 3;
+      }
+   }
+   ierr = MPI_Bcast(irc,1,mint,0,lgrp);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cpprchkpth2(char *fname, int nis, int isc[], int nfs, float fsc[],
+                 int *nvpo, int *irc) {
+/* this subroutine opens a checkpoint file written by cppwchkpth2 for
+   reading by all processors with MPI-IO, and reads the scalars.
+   the arrays are then read by cpprchkpta2 and cpprchkptp2, and the
+   file is closed by cpprchkptc2
+   input: fname, nis, nfs, output: isc, fsc, nvpo, irc
+   fname = name of checkpoint file
+   nis/nfs = number of integer/real scalars expected
+   isc/fsc = integer/real scalars
+   nvpo = number of processors which wrote the file
+   irc = error code: 0 = ok, 1 = cannot open file, 2 = not a valid
+   checkpoint file, or wrong number of scalars
+local data */
+   int n, ks, ierr;
+   MPI_Info minfo;
+   MPI_Status istatus;
+   *irc = 0;
+   MPI_Info_create(&minfo);
+   MPI_Info_set(minfo,"romio_cb_read","enable");
+   ierr = MPI_File_open(lgrp,fname,MPI_MODE_RDONLY,minfo,&mchk);
+   MPI_Info_free(&minfo);
+   if (ierr != MPI_SUCCESS) {
+      mchk = MPI_FILE_NULL;
+      *irc = 1;
+      return;
+   }
+/* processor 0 reads the header and broadcasts it */
+   ierr = MPI_Comm_rank(lgrp,&ks);
+   memset(&chkhd,0,sizeof(struct ppchkhead));
+   if (ks==0) {
+      ierr = MPI_File_read_at(mchk,0,&chkhd,sizeof(struct ppchkhead),
+                              MPI_BYTE,&istatus);
+   }
+   ierr = MPI_Bcast(&chkhd,sizeof(struct ppchkhead),MPI_BYTE,0,lgrp);
+   if ((memcmp(chkhd.magic,ppchkmagic,8) != 0) || (chkhd.nis != nis)
+      || (chkhd.nfs != nfs) || (chkhd.narr > NCHKMAX)
+      || (chkhd.nvp < 1)) {
+      cpprchkptc2();
+      *irc = 2;
+      return;
+   }
+   for (n = 0; n < nis; n++) {
+      isc[n] = chkhd.isc[n];
+   }
+   for (n = 0; n < nfs; n++) {
+      fsc[n] = chkhd.fsc[n];
+   }
+   *nvpo = chkhd.nvp;
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cpprchkpta2(int n, float f[], int nrow, int nrp, int noffr,
+                 int nrows, int *irc) {
+/* this subroutine reads a distributed array from the checkpoint file
+   opened by cpprchkpth2, with a collective read.  each processor reads
+   nrp rows starting at global row noffr, so the partition need not be
+   the same as the one which wrote the file
+   input: n, nrow, nrp, noffr, nrows, output: f, irc
+   n = array number in checkpoint file, starting with 0
+   f = distributed array, first nrp rows are read
+   nrow = length of each row, in reals
+   nrp = number of rows in this processor
+   noffr = global row number of first row in this processor
+   nrows = total number of rows
+   irc = error code: 0 = ok, 2 = read error, 3 = array not found or
+   wrong size
+local data */
+   int nsz, ierr, jerr;
+   MPI_Offset noff;
+   MPI_Status istatus;
+   if ((mchk==MPI_FILE_NULL) || (n >= chkhd.narr)
+      || (chkhd.nrows[n] != nrows) || (chkhd.nrow[n] != nrow)) {
+      *irc = 3;
+      return;
+   }
+   ierr = MPI_Type_size(mreal,&nsz);
+   noff = chkhd.noffa[n] + (MPI_Offset) nsz*nrow*(MPI_Offset) noffr;
+   ierr = MPI_File_read_at_all(mchk,noff,f,nrow*nrp,mreal,&istatus);
+   jerr = 0;
+   if (ierr != MPI_SUCCESS)
+      jerr = 2;
+   ierr = MPI_Allreduce(&jerr,irc,1,mint,mmax,lgrp);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cpprchkptp2(int n, float part[], float edges[], int *npp,
+                 int idimp, int npmax, int *irc) {
+/* this subroutine reads particles from the checkpoint file opened by
+   cpprchkpth2, with collective reads.  from the index, each processor
+   finds the processors which wrote the file whose partitions overlap
+   its own partition in y, reads their particles, and keeps those
+   inside its own partition.  if the partitions are the same, each
+   processor reads only the particles it wrote.  otherwise, the file
+   may have been written by a different number of processors, and the
+   particles are read in blocks of at most nchkbf particles
+   input: n, edges, idimp, npmax, output: part, npp, irc
+   n = array number in checkpoint file, starting with 0
+   part[n][i] = coordinate i of particle n in partition
+   edges[0:1] = lower:upper boundary of particle partition
+   npp = number of particles read in partition
+   idimp = size of phase space = 4
+   npmax = maximum number of particles in each partition
+   irc = error code: 0 = ok, 2 = read error, 3 = array not found,
+   wrong size, too many particles, or particles outside all partitions
+local data */
+/* iy = partitioned co-ordinate */
+   int iy = 1;
+   int i, j, j1, j2, k, ks, nvpo, mpp, nps, nsz, nit, it, ierr, jerr;
+   int lsame;
+   long long nsum, mtot, ntot;
+   MPI_Offset noff, noffp;
+   MPI_Status istatus;
+   int *kpp = NULL;
+   float yt;
+   float *edgs = NULL, *buf = NULL;
+   if ((mchk==MPI_FILE_NULL) || (n >= chkhd.narr)
+      || (chkhd.nrows[n] != 0) || (chkhd.nrow[n] != idimp)) {
+      *irc = 3;
+      return;
+   }
+   ierr = MPI_Comm_rank(lgrp,&ks);
+   ierr = MPI_Type_size(mreal,&nsz);
+   nvpo = chkhd.nvp;
+/* read particle index */
+   kpp = (int *) malloc(nvpo*sizeof(int));
+   edgs = (float *) malloc(2*nvpo*sizeof(float));
+   jerr = 0;
+   ierr = MPI_File_read_at_all(mchk,chkhd.noffa[n],kpp,nvpo,mint,
+                               &istatus);
+   if (ierr != MPI_SUCCESS)
+      jerr = 2;
+   noff = chkhd.noffa[n] + sizeof(int)*(MPI_Offset) nvpo;
+   ierr = MPI_File_read_at_all(mchk,noff,edgs,2*nvpo,mreal,&istatus);
+   if (ierr != MPI_SUCCESS)
+      jerr = 2;
+   noff = (sizeof(int) + 2*nsz)*(MPI_Offset) nvpo;
+   noffp = chkhd.noffa[n] + NCHKAL*((noff + NCHKAL - 1)/NCHKAL);
+/* find range of processors j1:j2 whose partitions overlap this one */
+   nsum = 0;
+   mtot = 0;
+   j1 = nvpo;
+   j2 = -1;
+   for (j = 0; j < nvpo; j++) {
+      if ((edgs[2*j] < edges[1]) && (edgs[2*j+1] > edges[0])) {
+         if (j1==nvpo)
+            j1 = j;
+         j2 = j;
+         mtot += kpp[j];
+      }
+      else if (j1==nvpo) {
+         nsum += kpp[j];
+      }
+   }
+/* same partition: read own particles directly */
+   lsame = (nvpo==nproc) && (j1==ks) && (j2==ks)
+        && (edgs[2*ks]==edges[0]) && (edgs[2*ks+1]==edges[1]);
+   free(edgs);
+   free(kpp);
+   if (lsame) {
+      mpp = (int) mtot;
+      nit = 0;
+      if (mpp > npmax)
+         jerr = 3;
+   }
+/* different partition: read overlapping particles in blocks */
+   else {
+      mpp = 0;
+      nit = (mtot + NCHKBF - 1)/NCHKBF;
+   }
+   ierr = MPI_Allreduce(&jerr,irc,1,mint,mmax,lgrp);
+   if (*irc != 0)
+      return;
+   noff = noffp + (MPI_Offset) nsz*idimp*(MPI_Offset) nsum;
+   ierr = MPI_File_read_at_all(mchk,noff,part,idimp*mpp,mreal,
+                               &istatus);
+   if (ierr != MPI_SUCCESS)
+      jerr = 2;
+/* all processors must take part in the same number of reads */
+   ierr = MPI_Allreduce(&nit,&it,1,mint,mmax,lgrp);
+   if (it > 0) {
+      buf = (float *) malloc(idimp*NCHKBF*sizeof(float));
+      for (k = 0; k < it; k++) {
+         nps = 0;
+         if (k < nit) {
+            nps = mtot - (long long) NCHKBF*k;
+            nps = nps < NCHKBF ? nps : NCHKBF;
+         }
+         noff = noffp + (MPI_Offset) nsz*idimp*(MPI_Offset) nsum;
+         ierr = MPI_File_read_at_all(mchk,noff,buf,idimp*nps,mreal,
+                                     &istatus);
+         if (ierr != MPI_SUCCESS)
+            jerr = 2;
+         nsum += nps;
+/* keep particles inside partition */
+         for (j = 0; j < nps; j++) {
+            yt = buf[iy+idimp*j];
+            if ((yt >= edges[0]) && (yt < edges[1])) {
+               if (mpp < npmax) {
+                  for (i = 0; i < idimp; i++) {
+                     part[i+idimp*mpp] = buf[i+idimp*j];
+                  }
+               }
+               else {
+                  jerr = 3;
+               }
+               mpp += 1;
+            }
+         }
+      }
+      free(buf);
+   }
+/* check that every particle was read by one processor */
+   mtot = mpp;
+   ierr = MPI_Allreduce(&mtot,&ntot,1,MPI_LONG_LONG,msum,lgrp);
+   if (ntot != chkhd.ntot[n])
+      jerr = 3;
+   ierr = MPI_Allreduce(&jerr,irc,1,mint,mmax,lgrp);
+   *npp = mpp < npmax ? mpp : npmax;
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cpprchkptc2() {
+/* this subroutine closes the checkpoint file opened by cpprchkpth2 */
+   int ierr;
+   if (mchk != MPI_FILE_NULL)
+      ierr = MPI_File_close(&mchk);
+   mchk = MPI_FILE_NULL;
+   return;
+}
+
 /* Interfaces to Fortran */
 
 /*--------------------------------------------------------------------*/
@@ -757,6 +2070,19 @@ void cppncguard2l_(float *f, int *nyp, int *kstrt, int *nvp, int *nxv,
    return;
 }
  
+/*--------------------------------------------------------------------*/
+void cppincguard2l_(float *f, int *nyp, int *kstrt, int *nvp, int *nxv,
+                    int *nypmx) {
+   cppincguard2l(f,*nyp,*kstrt,*nvp,*nxv,*nypmx);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppwncguard2l_(int *nvp) {
+   cppwncguard2l(*nvp);
+   return;
+}
+
 /*--------------------------------------------------------------------*/
 void cppnaguard2l_(float *f, float *scr, int *nyp, int *nx, int *kstrt,
                    int *nvp, int *nxv, int *nypmx) {
@@ -790,6 +2116,26 @@ void cppntpose_(float complex *f, float complex *g, float complex *s,
    return;
 }
 
+/*--------------------------------------------------------------------*/
+void cpptposenb_(float complex *f, float complex *g, float complex *s,
+                 float complex *t, int *nx, int *ny, int *kxp, int *kyp,
+                 int *kstrt, int *nvp, int *nxv, int *nyv, int *kxpd,
+                 int *kypd) {
+   cpptposenb(f,g,s,t,*nx,*ny,*kxp,*kyp,*kstrt,*nvp,*nxv,*nyv,*kxpd,
+              *kypd);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppntposenb_(float complex *f, float complex *g, float complex *s,
+                  float complex *t, int *nx, int *ny, int *kxp, int *kyp,
+                  int *kstrt, int *nvp, int *ndim, int *nxv, int *nyv,
+                  int *kxpd, int *kypd) {
+   cppntposenb(f,g,s,t,*nx,*ny,*kxp,*kyp,*kstrt,*nvp,*ndim,*nxv,*nyv,
+               *kxpd,*kypd);
+   return;
+}
+
 /*--------------------------------------------------------------------*/
 void cpppmove2_(float *sbufr, float *sbufl, float *rbufr, float *rbufl,
                 int *ncll, int *nclr, int *mcll, int *mclr, int *kstrt,
@@ -798,3 +2144,18 @@ void cpppmove2_(float *sbufr, float *sbufl, float *rbufr, float *rbufl,
              *idimp,*nbmax,*mx1);
    return;
 }
+
+/*--------------------------------------------------------------------*/
+void cppipmove2_(float *sbufr, float *sbufl, float *rbufr, float *rbufl,
+                 int *ncll, int *nclr, int *mcll, int *mclr, int *kstrt,
+                 int *nvp, int *idimp, int *nbmax, int *mx1) {
+   cppipmove2(sbufr,sbufl,rbufr,rbufl,ncll,nclr,mcll,mclr,*kstrt,*nvp,
+              *idimp,*nbmax,*mx1);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppwpmove2_(int *nvp) {
+   cppwpmove2(*nvp);
+   return;
+}
@@ -13,6 +13,10 @@ c PPDMAX performs parallel maximum of a double precision vector.
 c PPNCGUARD2L copies data to guard cells in y for scalar data, linear
 c             interpolation, and distributed data with non-uniform
 c             partition.
+c PPINCGUARD2L starts copying data to guard cells in y for scalar data,
+c              using non-blocking messages.
+c PPWNCGUARD2L waits for guard cell copy started by PPINCGUARD2L to
+c              complete.
 c PPNAGUARD2L adds guard cells in y for scalar array, linear
 c             interpolation, and distributed data with non-uniform
 c             partition.
@@ -24,8 +28,33 @@ c         in y, to a complex scalar array, distributed in x.
 c PPNTPOSE performs a transpose of an n component complex vector array,
 c          distributed in y, to an n component complex vector array,
 c          distributed in x.
+c PPTPOSENB performs a transpose of a complex scalar array, distributed
+c           in y, to a complex scalar array, distributed in x, using
+c           non-blocking messages to all processors at once.
+c PPNTPOSENB performs a transpose of an n component complex vector
+c            array, distributed in y, to an n component complex vector
+c            array, distributed in x, using non-blocking messages to all
+c            processors at once.
 c PPPMOVE2 moves particles into appropriate spatial regions for tiled
 c          distributed data.
+c PPIPMOVE2 starts moving particles into appropriate spatial regions for
+c           tiled distributed data, using non-blocking messages.
+c PPWPMOVE2 waits for particle move started by PPIPMOVE2 to complete.
+c PPWCHKPTH2 opens a shared checkpoint file for writing with MPI-IO
+c            and saves the scalars.
+c PPWCHKPTA2 writes the rows of a distributed array to a checkpoint
+c            file with a collective write.
+c PPWCHKPTP2 writes particles and an index of particles per processor
+c            to a checkpoint file with a collective write.
+c PPWCHKPTC2 completes a checkpoint file.
+c PPRCHKPTH2 opens a shared checkpoint file for reading with MPI-IO
+c            and reads the scalars.
+c PPRCHKPTA2 reads the rows of a distributed array from a checkpoint
+c            file, in any partition.
+c PPRCHKPTP2 reads the particles inside the partition from a
+c            checkpoint file, written by the same or a different number
+c            of processors.
+c PPRCHKPTC2 closes a checkpoint file opened for reading.
 c written by viktor k. decyk, ucla
 c copyright 1995, regents of the university of california
 c update: May 9, 2015
@@ -376,6 +405,85 @@ c this segment is used for mpi computers
       call MPI_WAIT(msid,istatus,ierr)
       return
       end
+c-----------------------------------------------------------------------
+      subroutine PPINCGUARD2L(f,nyp,kstrt,nvp,nxv,nypmx)
+c this subroutine starts copying data to guard cells in non-uniform
+c partitions, using non-blocking messages.  the copy is completed by
+c PPWNCGUARD2L.  until then, the guard cells f(:,nyp+1) must not be
+c accessed and the first row f(:,1) must not be modified
+c f(j,k) = real data for grid j,k in particle partition.
+c the grid is non-uniform and includes one extra guard cell.
+c output: f
+c nyp = number of primary gridpoints in field partition
+c it is assumed the nyp > 0.
+c kstrt = starting data block number
+c nvp = number of real or virtual processors
+c nxv = first dimension of f, must be >= nx
+c nypmx = maximum size of field partition, including guard cell.
+c linear interpolation, for distributed data
+      implicit none
+      integer nyp, kstrt, nvp, nxv, nypmx
+      real f
+      dimension f(nxv,nypmx)
+c common block for parallel processing
+      integer nproc, lgrp, lstat, mreal, mint, mcplx, mdouble, lworld
+c lstat = length of status array
+      parameter(lstat=10)
+c lgrp = current communicator
+c mreal = default datatype for reals
+      common /PPARMS/ nproc, lgrp, mreal, mint, mcplx, mdouble, lworld
+c common block for messages in flight
+c mgsid = requests for guard cells in flight, from PPINCGUARD2L
+c mpsid = requests for particles in flight, from PPIPMOVE2
+      integer mgsid, mpsid
+      dimension mgsid(2), mpsid(8)
+      common /PPREQS/ mgsid, mpsid
+      save /PPREQS/
+c local data
+      integer j, ks, moff, kl, kr
+      integer ierr
+c special case for one processor
+      if (nvp.eq.1) then
+         do 10 j = 1, nxv
+         f(j,nyp+1) = f(j,1)
+   10    continue
+         return
+      endif
+      ks = kstrt - 1
+      moff = nypmx*nvp + 2
+c copy to guard cells
+      kr = ks + 1
+      if (kr.ge.nvp) kr = kr - nvp
+      kl = ks - 1
+      if (kl.lt.0)  kl = kl + nvp
+      ks = nyp + 1
+c this segment is used for mpi computers
+      call MPI_IRECV(f(1,ks),nxv,mreal,kr,moff,lgrp,mgsid(1),ierr)
+      call MPI_ISEND(f,nxv,mreal,kl,moff,lgrp,mgsid(2),ierr)
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPWNCGUARD2L(nvp)
+c this subroutine waits for the guard cell copy started by PPINCGUARD2L
+c to complete
+c nvp = number of real or virtual processors
+      implicit none
+      integer nvp
+c lstat = length of status array
+      integer lstat
+      parameter(lstat=10)
+c common block for messages in flight
+      integer mgsid, mpsid
+      dimension mgsid(2), mpsid(8)
+      common /PPREQS/ mgsid, mpsid
+      save /PPREQS/
+c local data
+      integer istatus, ierr
+      dimension istatus(lstat,2)
+      if (nvp.eq.1) return
+      call MPI_WAITALL(2,mgsid,istatus,ierr)
+      return
+      end
 c-----------------------------------------------------------------------
       subroutine PPNAGUARD2L(f,scr,nyp,nx,kstrt,nvp,nxv,nypmx)
 c this subroutine adds data from guard cells in non-uniform partitions
@@ -700,6 +808,178 @@ c insert data received
   100 continue
       return
       end
+c-----------------------------------------------------------------------
+      subroutine PPTPOSENB(f,g,s,t,nx,ny,kxp,kyp,kstrt,nvp,nxv,nyv,kxpd,
+     1kypd)
+c this subroutine performs a transpose of a matrix f, distributed in y,
+c to a matrix g, distributed in x, that is,
+c g(k+kyp*(m-1),j,l) = f(j+kxp*(l-1),k,m), where
+c 1 <= j <= kxp, 1 <= k <= kyp, 1 <= l <= nx/kxp, 1 <= m <= ny/kyp
+c and where indices l and m can be distributed across processors.
+c this subroutine posts all receives first, then sends all messages
+c asynchronously, unpacking data in the order it arrives, so that
+c packing and unpacking overlap with communication.
+c it requires nvp times the scratch memory of PPTPOSE
+c f = complex input array
+c g = complex output array
+c s, t = complex scratch arrays, of size kxp*kyp*nvp
+c nx/ny = number of points in x/y
+c kxp/kyp = number of data values per block in x/y
+c kstrt = starting data block number
+c nvp = number of real or virtual processors
+c nxv/nyv = first dimension of f/g
+c kypd/kxpd = second dimension of f/g
+      implicit none
+      integer nx, ny, kxp, kyp, kstrt, nvp, nxv, nyv, kxpd, kypd
+      complex f, g, s, t
+      dimension f(nxv,kypd), g(nyv,kxpd)
+      dimension s(kxp*kyp,nvp), t(kxp*kyp,nvp)
+      call PPNTPOSENB(f,g,s,t,nx,ny,kxp,kyp,kstrt,nvp,1,nxv,nyv,kxpd,   
+     1kypd)
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPNTPOSENB(f,g,s,t,nx,ny,kxp,kyp,kstrt,nvp,ndim,nxv,nyv
+     1,kxpd,kypd)
+c this subroutine performs a transpose of a matrix f, distributed in y,
+c to a matrix g, distributed in x, that is,
+c g(1:ndim,k+kyp*(m-1),j,l) = f(1:ndim,j+kxp*(l-1),k,m), where
+c 1 <= j <= kxp, 1 <= k <= kyp, 1 <= l <= nx/kxp, 1 <= m <= ny/kyp
+c and where indices l and m can be distributed across processors.
+c this subroutine posts all receives first, then sends all messages
+c asynchronously, unpacking data in the order it arrives, so that
+c packing and unpacking overlap with communication.
+c the local block is copied directly.
+c it requires nvp times the scratch memory of PPNTPOSE
+c f = complex input array
+c g = complex output array
+c s, t = complex scratch arrays, of size ndim*kxp*kyp*nvp
+c nx/ny = number of points in x/y
+c kxp/kyp = number of data values per block in x/y
+c kstrt = starting data block number
+c nvp = number of real or virtual processors
+c ndim = leading dimension of arrays f and g
+c nxv/nyv = first dimension of f/g
+c kypd/kxpd = second dimension of f/g
+      implicit none
+      integer nx, ny, kxp, kyp, kstrt, nvp, ndim, nxv, nyv, kxpd, kypd
+      complex f, g, s, t
+      dimension f(ndim,nxv,kypd), g(ndim,nyv,kxpd)
+      dimension s(ndim,kxp*kyp,nvp), t(ndim,kxp*kyp,nvp)
+      include 'mpif.h'
+c common block for parallel processing
+      integer nproc, lgrp, mreal, mint, mcplx, mdouble, lworld
+c lgrp = current communicator
+c mcplx = default datatype for complex
+      common /PPARMS/ nproc, lgrp, mreal, mint, mcplx, mdouble, lworld
+c local data
+      integer i, n, j, k, ks, kxps, kyps, kxyp, id, joff, koff, ld
+      integer ierr, msid, mrid, istatus
+      logical flag
+      dimension msid(nvp), mrid(nvp), istatus(MPI_STATUS_SIZE)
+      ks = kstrt - 1
+      kxps = min(kxp,max(0,nx-kxp*ks))
+      kyps = min(kyp,max(0,ny-kyp*ks))
+      kxyp = ndim*kxp*kyp
+c special case for one processor
+      if (nvp.eq.1) then
+!$OMP PARALLEL DO PRIVATE(i,j,k)
+         do 30 k = 1, kyp
+         do 20 j = 1, kxp
+         do 10 i = 1, ndim
+         g(i,k,j) = f(i,j,k)
+   10    continue
+   20    continue
+   30    continue
+!$OMP END PARALLEL DO
+         return
+      endif
+c post all receives, data from processor id is stored in block id+1
+      do 40 n = 1, nvp
+      id = n - ks - 1
+      if (id.lt.0) id = id + nvp
+      if (id.ne.ks) then
+         call MPI_IRECV(t(1,1,id+1),kxyp,mcplx,id,n,lgrp,mrid(id+1),ierr
+     1)
+      endif
+   40 continue
+      mrid(ks+1) = MPI_REQUEST_NULL
+      msid(ks+1) = MPI_REQUEST_NULL
+c extract and send data, data to processor id is stored in block id+1
+      do 90 n = 1, nvp
+      id = n - ks - 1
+      if (id.lt.0) id = id + nvp
+      if (id.eq.ks) go to 90
+      joff = kxp*id
+      ld = min(kxp,max(0,nx-joff))
+!$OMP PARALLEL DO PRIVATE(i,j,k)
+      do 70 k = 1, kyps
+      do 60 j = 1, ld
+      do 50 i = 1, ndim
+      s(i,j+ld*(k-1),id+1) = f(i,j+joff,k)
+   50 continue
+   60 continue
+   70 continue
+!$OMP END PARALLEL DO
+      ld = ndim*ld*kyps
+      call MPI_ISEND(s(1,1,id+1),ld,mcplx,id,n,lgrp,msid(id+1),ierr)
+c insert any data which has already arrived
+      flag = .true.
+   80 if (flag) then
+         call MPI_TESTANY(nvp,mrid,id,flag,istatus,ierr)
+         if (id.eq.MPI_UNDEFINED) flag = .false.
+         if (flag) then
+            call PPNTUNPACK(g,t(1,1,id),id-1,ny,kxp,kxps,kyp,ndim,nyv,
+     1kxpd)
+         endif
+         go to 80
+      endif
+   90 continue
+c copy local block while messages are in flight
+      joff = kxp*ks
+      koff = kyp*ks
+!$OMP PARALLEL DO PRIVATE(i,j,k)
+      do 120 k = 1, kyps
+      do 110 j = 1, kxps
+      do 100 i = 1, ndim
+      g(i,k+koff,j) = f(i,j+joff,k)
+  100 continue
+  110 continue
+  120 continue
+!$OMP END PARALLEL DO
+c insert remaining data as it arrives
+      do 130 n = 2, nvp
+      call MPI_WAITANY(nvp,mrid,id,istatus,ierr)
+      if (id.eq.MPI_UNDEFINED) go to 140
+      call PPNTUNPACK(g,t(1,1,id),id-1,ny,kxp,kxps,kyp,ndim,nyv,kxpd)
+  130 continue
+c wait for sends to complete
+  140 call MPI_WAITALL(nvp,msid,MPI_STATUSES_IGNORE,ierr)
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPNTUNPACK(g,t,id,ny,kxp,kxps,kyp,ndim,nyv,kxpd)
+c this subroutine inserts a block of transposed data t, received from
+c processor id, into g.  used by PPNTPOSENB
+      implicit none
+      integer id, ny, kxp, kxps, kyp, ndim, nyv, kxpd
+      complex g, t
+      dimension g(ndim,nyv,kxpd), t(ndim,kxp*kyp)
+c local data
+      integer i, j, k, koff, ld
+      koff = kyp*id
+      ld = min(kyp,max(0,ny-koff))
+!$OMP PARALLEL DO PRIVATE(i,j,k)
+      do 30 k = 1, ld
+      do 20 j = 1, kxps
+      do 10 i = 1, ndim
+      g(i,k+koff,j) = t(i,j+kxps*(k-1))
+   10 continue
+   20 continue
+   30 continue
+!$OMP END PARALLEL DO
+      return
+      end
 c-----------------------------------------------------------------------
       subroutine PPPMOVE2(sbufr,sbufl,rbufr,rbufl,ncll,nclr,mcll,mclr,  
      1kstrt,nvp,idimp,nbmax,mx1)
@@ -800,4 +1080,765 @@ c make sure sbufr, sbufl, ncll, and nclr have been sent
       endif
       return
       end
-
+c-----------------------------------------------------------------------
+      subroutine PPIPMOVE2(sbufr,sbufl,rbufr,rbufl,ncll,nclr,mcll,mclr, 
+     1kstrt,nvp,idimp,nbmax,mx1)
+c this subroutine starts moving particles into appropriate spatial
+c regions for distributed data, with 1d domain decomposition in y,
+c using non-blocking messages.  all messages are posted at once and the
+c move is completed by PPWPMOVE2.  until then, rbufr, rbufl, mcll, mclr
+c must not be accessed and sbufr, sbufl, ncll, nclr must not be modified
+c tiles are assumed to be arranged in 2D linear memory
+c output: rbufr, rbufl, mcll, mclr
+c sbufl = buffer for particles being sent to lower processor
+c sbufr = buffer for particles being sent to upper processor
+c rbufl = buffer for particles being received from lower processor
+c rbufr = buffer for particles being received from upper processor
+c ncll = particle number being sent to lower processor
+c nclr = particle number being sent to upper processor
+c mcll = particle number being received from lower processor
+c mclr = particle number being received from upper processor
+c kstrt = starting data block number
+c nvp = number of real or virtual processors
+c idimp = size of phase space = 4 or 5
+c nbmax =  size of buffers for passing particles between processors
+c mx1 = (system length in x direction - 1)/mx + 1
+      implicit none
+      integer kstrt, nvp, idimp, nbmax, mx1
+      real sbufr, sbufl, rbufr, rbufl
+      integer ncll, nclr, mcll, mclr
+      dimension sbufl(idimp,nbmax), sbufr(idimp,nbmax)
+      dimension rbufl(idimp,nbmax), rbufr(idimp,nbmax)
+      dimension ncll(3,mx1), nclr(3,mx1), mcll(3,mx1), mclr(3,mx1)
+c common block for parallel processing
+      integer nproc, lgrp, mreal, mint, mcplx, mdouble, lworld
+c lgrp = current communicator
+c mint = default datatype for integers
+c mreal = default datatype for reals
+      common /PPARMS/ nproc, lgrp, mreal, mint, mcplx, mdouble, lworld
+c common block for messages in flight
+      integer mgsid, mpsid
+      dimension mgsid(2), mpsid(8)
+      common /PPREQS/ mgsid, mpsid
+      save /PPREQS/
+c local data
+      integer ierr, ks, kl, kr, jsl, jsr
+      integer nbsize, ncsize
+      integer itg
+      dimension itg(4)
+      data itg /3,4,5,6/
+c special case for one processor
+      if (nvp.eq.1) then
+         call PPPMOVE2(sbufr,sbufl,rbufr,rbufl,ncll,nclr,mcll,mclr,kstrt
+     1,nvp,idimp,nbmax,mx1)
+         return
+      endif
+      ks = kstrt - 1
+      nbsize = idimp*nbmax
+      ncsize = 3*mx1
+c get particles from below and above
+      kr = ks + 1
+      if (kr.ge.nvp) kr = kr - nvp
+      kl = ks - 1
+      if (kl.lt.0) kl = kl + nvp
+c post receives
+      call MPI_IRECV(mcll,ncsize,mint,kl,itg(1),lgrp,mpsid(1),ierr)
+      call MPI_IRECV(mclr,ncsize,mint,kr,itg(2),lgrp,mpsid(2),ierr)
+      call MPI_IRECV(rbufl,nbsize,mreal,kl,itg(3),lgrp,mpsid(3),ierr)
+      call MPI_IRECV(rbufr,nbsize,mreal,kr,itg(4),lgrp,mpsid(4),ierr)
+c send particle number offsets
+      call MPI_ISEND(nclr,ncsize,mint,kr,itg(1),lgrp,mpsid(5),ierr)
+      call MPI_ISEND(ncll,ncsize,mint,kl,itg(2),lgrp,mpsid(6),ierr)
+c send particles
+      jsr = idimp*nclr(3,mx1)
+      call MPI_ISEND(sbufr,jsr,mreal,kr,itg(3),lgrp,mpsid(7),ierr)
+      jsl = idimp*ncll(3,mx1)
+      call MPI_ISEND(sbufl,jsl,mreal,kl,itg(4),lgrp,mpsid(8),ierr)
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPWPMOVE2(nvp)
+c this subroutine waits for the particle move started by PPIPMOVE2 to
+c complete
+c nvp = number of real or virtual processors
+      implicit none
+      integer nvp
+c lstat = length of status array
+      integer lstat
+      parameter(lstat=10)
+c common block for messages in flight
+      integer mgsid, mpsid
+      dimension mgsid(2), mpsid(8)
+      common /PPREQS/ mgsid, mpsid
+      save /PPREQS/
+c local data
+      integer istatus, ierr
+      dimension istatus(lstat,8)
+      if (nvp.eq.1) return
+      call MPI_WAITALL(8,mpsid,istatus,ierr)
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPWCHKPTH2(fname,nis,isc,nfs,fsc,irc)
+c this subroutine opens a shared checkpoint file for writing by all
+c processors with MPI-IO, and saves the scalars, which should be the
+c same on all processors.  distributed arrays are then written by
+c PPWCHKPTA2 and particles by PPWCHKPTP2, and the file is completed by
+c PPWCHKPTC2
+c input: all, output: irc
+c fname = name of checkpoint file
+c nis/nfs = number of integer/real scalars, <= 32
+c isc/fsc = integer/real scalars
+c irc = error code: 0 = ok, 1 = cannot create file, 4 = too many
+c scalars
+      implicit none
+      integer nis, nfs, irc
+      integer isc
+      real fsc
+      character*(*) fname
+      dimension isc(nis), fsc(nfs)
+c get definition of MPI constants
+      include 'mpif.h'
+c common block for parallel processing
+      integer nproc, lgrp, lstat, mreal, mint, mcplx, mdouble, lworld
+      integer msum, mmax
+c lstat = length of status array
+      parameter(lstat=10)
+c lgrp = current communicator
+c mreal = default datatype for reals
+c mint = default datatype for integers
+      common /PPARMS/ nproc, lgrp, mreal, mint, mcplx, mdouble, lworld
+c msum = MPI_SUM
+c mmax = MPI_MAX
+      common /PPARMSX/ msum, mmax
+c common block for checkpoint file, the header has the same layout
+c as the one written by the C library
+c nchkmax = maximum number of scalars or arrays in a checkpoint
+c nchkal = alignment of arrays in checkpoint file, in bytes
+c lchkh = size of integer header
+      integer nchkmax, nchkal, lchkh
+      parameter(nchkmax=32,nchkal=4096,lchkh=4+3*nchkmax)
+c nchkf = offset of next array in file being written
+c nchkh(1:32) = file offset of each array, in bytes
+c nchkh(33:64) = total number of particles in each particle array
+c mchk = checkpoint file handle
+c chkerr = error code of checkpoint being written
+c ichkh(1:4) = nvp, nis, nfs, narr
+c ichkh(5:36) = integer scalars
+c ichkh(37:68) = length of each row of each array, in reals,
+c or size of phase space for particles
+c ichkh(69:100) = total number of rows of each array, 0 for particles
+c fchkh = real scalars
+      integer(kind=MPI_OFFSET_KIND) nchkf, nchkh
+      integer mchk, chkerr, ichkh
+      real fchkh
+      dimension nchkh(2*nchkmax), ichkh(lchkh), fchkh(nchkmax)
+      common /PPCHKP/ nchkf, nchkh, mchk, chkerr, ichkh, fchkh
+      save /PPCHKP/
+c local data
+      integer j, minfo, ierr
+      integer(kind=MPI_OFFSET_KIND) nzero
+      irc = 0
+      if ((nis.gt.nchkmax).or.(nfs.gt.nchkmax)) then
+         irc = 4
+         return
+      endif
+      do 10 j = 1, lchkh
+      ichkh(j) = 0
+   10 continue
+      do 20 j = 1, nchkmax
+      fchkh(j) = 0.0
+   20 continue
+      do 30 j = 1, 2*nchkmax
+      nchkh(j) = 0
+   30 continue
+      ichkh(1) = nproc
+      ichkh(2) = nis
+      ichkh(3) = nfs
+      do 40 j = 1, nis
+      ichkh(j+4) = isc(j)
+   40 continue
+      do 50 j = 1, nfs
+      fchkh(j) = fsc(j)
+   50 continue
+c collective buffering lets a few aggregators access the file
+      call MPI_INFO_CREATE(minfo,ierr)
+      call MPI_INFO_SET(minfo,'romio_cb_write','enable',ierr)
+      call MPI_FILE_OPEN(lgrp,fname,MPI_MODE_WRONLY+MPI_MODE_CREATE,
+     1minfo,mchk,ierr)
+      call MPI_INFO_FREE(minfo,ierr)
+      if (ierr.ne.MPI_SUCCESS) then
+         mchk = MPI_FILE_NULL
+         irc = 1
+         return
+      endif
+c discard any previous contents
+      nzero = 0
+      call MPI_FILE_SET_SIZE(mchk,nzero,ierr)
+c first block is reserved for header
+      nchkf = nchkal
+      chkerr = 0
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPWCHKPTA2(f,nrow,nrp,noffr,nrows)
+c this subroutine writes a distributed array to the checkpoint file
+c opened by PPWCHKPTH2, with a collective write.  the array is stored
+c as nrows global rows, each processor writes its nrp rows, which
+c start at global row noffr.  the rows may be the nyp rows of a
+c particle partition, or the kxp rows of an array transposed in
+c fourier space, with complex data counted as two reals
+c input: all
+c f = distributed array, first nrp rows are written
+c nrow = length of each row, in reals
+c nrp = number of rows in this processor
+c noffr = global row number of first row in this processor
+c nrows = total number of rows, sum of nrp over processors
+      implicit none
+      integer nrow, nrp, noffr, nrows
+      real f
+      dimension f(nrow,nrp)
+c get definition of MPI constants
+      include 'mpif.h'
+c common block for parallel processing
+      integer nproc, lgrp, lstat, mreal, mint, mcplx, mdouble, lworld
+      integer msum, mmax
+c lstat = length of status array
+      parameter(lstat=10)
+c lgrp = current communicator
+c mreal = default datatype for reals
+c mint = default datatype for integers
+      common /PPARMS/ nproc, lgrp, mreal, mint, mcplx, mdouble, lworld
+c msum = MPI_SUM
+c mmax = MPI_MAX
+      common /PPARMSX/ msum, mmax
+c common block for checkpoint file
+      integer nchkmax, nchkal, lchkh
+      parameter(nchkmax=32,nchkal=4096,lchkh=4+3*nchkmax)
+      integer(kind=MPI_OFFSET_KIND) nchkf, nchkh
+      integer mchk, chkerr, ichkh
+      real fchkh
+      dimension nchkh(2*nchkmax), ichkh(lchkh), fchkh(nchkmax)
+      common /PPCHKP/ nchkf, nchkh, mchk, chkerr, ichkh, fchkh
+c local data
+      integer n, nsz, ierr
+      integer istatus
+      integer(kind=MPI_OFFSET_KIND) noff, nbytes
+      dimension istatus(lstat)
+      if (mchk.eq.MPI_FILE_NULL) return
+      n = ichkh(4) + 1
+      if (n.gt.nchkmax) then
+         chkerr = 4
+         return
+      endif
+      call MPI_TYPE_SIZE(mreal,nsz,ierr)
+      ichkh(n+36) = nrow
+      ichkh(n+68) = nrows
+      nchkh(n) = nchkf
+      nbytes = nsz*nrow
+      noff = nchkf + nbytes*noffr
+      call MPI_FILE_WRITE_AT_ALL(mchk,noff,f,nrow*nrp,mreal,istatus,
+     1ierr)
+      if (ierr.ne.MPI_SUCCESS) chkerr = 2
+c next array starts on a block boundary
+      nbytes = nbytes*nrows
+      nchkf = nchkf + nchkal*((nbytes + nchkal - 1)/nchkal)
+      ichkh(4) = n
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPWCHKPTP2(part,edges,npp,idimp,npmax)
+c this subroutine writes particles to the checkpoint file opened by
+c PPWCHKPTH2, with a collective write.  an index with the number of
+c particles and the partition boundaries of each processor is written
+c first, followed by the particles of each processor in processor
+c order, which is also the order of the partitions in y
+c input: all
+c part(i,n) = coordinate i of particle n in partition
+c edges(1:2) = lower:upper boundary of particle partition
+c npp = number of particles in partition
+c idimp = size of phase space = 4
+c npmax = maximum number of particles in each partition
+      implicit none
+      integer npp, idimp, npmax
+      real part, edges
+      dimension part(idimp,npmax), edges(2)
+c get definition of MPI constants
+      include 'mpif.h'
+c common block for parallel processing
+      integer nproc, lgrp, lstat, mreal, mint, mcplx, mdouble, lworld
+      integer msum, mmax
+c lstat = length of status array
+      parameter(lstat=10)
+c lgrp = current communicator
+c mreal = default datatype for reals
+c mint = default datatype for integers
+      common /PPARMS/ nproc, lgrp, mreal, mint, mcplx, mdouble, lworld
+c msum = MPI_SUM
+c mmax = MPI_MAX
+      common /PPARMSX/ msum, mmax
+c common block for checkpoint file
+      integer nchkmax, nchkal, lchkh
+      parameter(nchkmax=32,nchkal=4096,lchkh=4+3*nchkmax)
+      integer(kind=MPI_OFFSET_KIND) nchkf, nchkh
+      integer mchk, chkerr, ichkh
+      real fchkh
+      dimension nchkh(2*nchkmax), ichkh(lchkh), fchkh(nchkmax)
+      common /PPCHKP/ nchkf, nchkh, mchk, chkerr, ichkh, fchkh
+c local data
+      integer n, ks, nsz, nisz, ierr
+      integer istatus
+      integer(kind=MPI_OFFSET_KIND) mpp, nsum, ntot, noff, nbytes
+      dimension istatus(lstat)
+      if (mchk.eq.MPI_FILE_NULL) return
+      n = ichkh(4) + 1
+      if (n.gt.nchkmax) then
+         chkerr = 4
+         return
+      endif
+      call MPI_COMM_RANK(lgrp,ks,ierr)
+      call MPI_TYPE_SIZE(mreal,nsz,ierr)
+      call MPI_TYPE_SIZE(mint,nisz,ierr)
+c find location of particles in file
+      mpp = npp
+      call MPI_EXSCAN(mpp,nsum,1,MPI_INTEGER8,msum,lgrp,ierr)
+      if (ks.eq.0) nsum = 0
+      call MPI_ALLREDUCE(mpp,ntot,1,MPI_INTEGER8,msum,lgrp,ierr)
+      ichkh(n+36) = idimp
+      ichkh(n+68) = 0
+      nchkh(n) = nchkf
+      nchkh(n+nchkmax) = ntot
+c each processor writes its entry in the index
+      noff = nchkf + nisz*ks
+      call MPI_FILE_WRITE_AT_ALL(mchk,noff,npp,1,mint,istatus,ierr)
+      if (ierr.ne.MPI_SUCCESS) chkerr = 2
+      noff = nchkf + nisz*nproc + 2*nsz*ks
+      call MPI_FILE_WRITE_AT_ALL(mchk,noff,edges,2,mreal,istatus,ierr)
+      if (ierr.ne.MPI_SUCCESS) chkerr = 2
+      nbytes = nisz + 2*nsz
+      nbytes = nbytes*nproc
+      nchkf = nchkf + nchkal*((nbytes + nchkal - 1)/nchkal)
+c write particles
+      nbytes = nsz*idimp
+      noff = nchkf + nbytes*nsum
+      call MPI_FILE_WRITE_AT_ALL(mchk,noff,part,idimp*npp,mreal,istatus
+     1,ierr)
+      if (ierr.ne.MPI_SUCCESS) chkerr = 2
+      nbytes = nbytes*ntot
+      nchkf = nchkf + nchkal*((nbytes + nchkal - 1)/nchkal)
+      ichkh(4) = n
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPWCHKPTC2(irc)
+c this subroutine completes the checkpoint file written by PPWCHKPTH2,
+c PPWCHKPTA2 and PPWCHKPTP2.  processor 0 writes the header.  the
+c file is written in place: the C wrappers in mpplib2_f.c open
+c fname.tmp and rename it after this call
+c output: irc
+c irc = error code: 0 = ok, 1 = file not open, 2 = write error,
+c 4 = too many arrays
+      implicit none
+      integer irc
+c get definition of MPI constants
+      include 'mpif.h'
+c common block for parallel processing
+      integer nproc, lgrp, lstat, mreal, mint, mcplx, mdouble, lworld
+      integer msum, mmax
+c lstat = length of status array
+      parameter(lstat=10)
+c lgrp = current communicator
+c mreal = default datatype for reals
+c mint = default datatype for integers
+      common /PPARMS/ nproc, lgrp, mreal, mint, mcplx, mdouble, lworld
+c msum = MPI_SUM
+c mmax = MPI_MAX
+      common /PPARMSX/ msum, mmax
+c common block for checkpoint file
+      integer nchkmax, nchkal, lchkh
+      parameter(nchkmax=32,nchkal=4096,lchkh=4+3*nchkmax)
+      integer(kind=MPI_OFFSET_KIND) nchkf, nchkh
+      integer mchk, chkerr, ichkh
+      real fchkh
+      dimension nchkh(2*nchkmax), ichkh(lchkh), fchkh(nchkmax)
+      common /PPCHKP/ nchkf, nchkh, mchk, chkerr, ichkh, fchkh
+c local data
+      integer ks, ierr
+      integer istatus
+      integer(kind=MPI_OFFSET_KIND) noff
+      character*8 cmagic
+      dimension istatus(lstat)
+      if (mchk.eq.MPI_FILE_NULL) then
+         irc = 1
+         return
+      endif
+      call MPI_COMM_RANK(lgrp,ks,ierr)
+c header is written in the layout of the C structure
+      if (ks.eq.0) then
+         cmagic = 'MPCHK2'//char(0)//char(0)
+         noff = 0
+         call MPI_FILE_WRITE_AT(mchk,noff,cmagic,8,MPI_CHARACTER,
+     1istatus,ierr)
+         if (ierr.ne.MPI_SUCCESS) chkerr = 2
+         noff = 8
+         call MPI_FILE_WRITE_AT(mchk,noff,ichkh,nchkmax+4,mint,istatus,
+     1ierr)
+         if (ierr.ne.MPI_SUCCESS) chkerr = 2
+         noff = 152
+         call MPI_FILE_WRITE_AT(mchk,noff,fchkh,nchkmax,mreal,istatus,
+     1ierr)
+         if (ierr.ne.MPI_SUCCESS) chkerr = 2
+         noff = 280
+         call MPI_FILE_WRITE_AT(mchk,noff,ichkh(nchkmax+5),2*nchkmax,
+     1mint,istatus,ierr)
+         if (ierr.ne.MPI_SUCCESS) chkerr = 2
+         noff = 536
+         call MPI_FILE_WRITE_AT(mchk,noff,nchkh,2*nchkmax,MPI_INTEGER8,
+     1istatus,ierr)
+         if (ierr.ne.MPI_SUCCESS) chkerr = 2
+      endif
+      call MPI_FILE_SYNC(mchk,ierr)
+      if (ierr.ne.MPI_SUCCESS) chkerr = 2
+      call MPI_FILE_CLOSE(mchk,ierr)
+      mchk = MPI_FILE_NULL
+      call MPI_ALLREDUCE(chkerr,irc,1,mint,mmax,lgrp,ierr)
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPRCHKPTH2(fname,nis,isc,nfs,fsc,nvpo,irc)
+c this subroutine opens a checkpoint file written by PPWCHKPTH2 for
+c reading by all processors with MPI-IO, and reads the scalars.
+c the arrays are then read by PPRCHKPTA2 and PPRCHKPTP2, and the file
+c is closed by PPRCHKPTC2
+c input: fname, nis, nfs, output: isc, fsc, nvpo, irc
+c fname = name of checkpoint file
+c nis/nfs = number of integer/real scalars expected
+c isc/fsc = integer/real scalars
+c nvpo = number of processors which wrote the file
+c irc = error code: 0 = ok, 1 = cannot open file, 2 = not a valid
+c checkpoint file, or wrong number of scalars
+      implicit none
+      integer nis, nfs, nvpo, irc
+      integer isc
+      real fsc
+      character*(*) fname
+      dimension isc(nis), fsc(nfs)
+c get definition of MPI constants
+      include 'mpif.h'
+c common block for parallel processing
+      integer nproc, lgrp, lstat, mreal, mint, mcplx, mdouble, lworld
+      integer msum, mmax
+c lstat = length of status array
+      parameter(lstat=10)
+c lgrp = current communicator
+c mreal = default datatype for reals
+c mint = default datatype for integers
+      common /PPARMS/ nproc, lgrp, mreal, mint, mcplx, mdouble, lworld
+c msum = MPI_SUM
+c mmax = MPI_MAX
+      common /PPARMSX/ msum, mmax
+c common block for checkpoint file
+      integer nchkmax, nchkal, lchkh
+      parameter(nchkmax=32,nchkal=4096,lchkh=4+3*nchkmax)
+      integer(kind=MPI_OFFSET_KIND) nchkf, nchkh
+      integer mchk, chkerr, ichkh
+      real fchkh
+      dimension nchkh(2*nchkmax), ichkh(lchkh), fchkh(nchkmax)
+      common /PPCHKP/ nchkf, nchkh, mchk, chkerr, ichkh, fchkh
+c local data
+      integer j, ks, minfo, ierr
+      integer istatus
+      integer(kind=MPI_OFFSET_KIND) noff
+      character*8 cmagic, cmg
+      dimension istatus(lstat)
+      irc = 0
+      call MPI_INFO_CREATE(minfo,ierr)
+      call MPI_INFO_SET(minfo,'romio_cb_read','enable',ierr)
+      call MPI_FILE_OPEN(lgrp,fname,MPI_MODE_RDONLY,minfo,mchk,ierr)
+      call MPI_INFO_FREE(minfo,ierr)
+      if (ierr.ne.MPI_SUCCESS) then
+         mchk = MPI_FILE_NULL
+         irc = 1
+         return
+      endif
+c processor 0 reads the header and broadcasts it
+      call MPI_COMM_RANK(lgrp,ks,ierr)
+      cmagic = ' '
+      do 10 j = 1, lchkh
+      ichkh(j) = 0
+   10 continue
+      if (ks.eq.0) then
+         noff = 0
+         call MPI_FILE_READ_AT(mchk,noff,cmagic,8,MPI_CHARACTER,istatus,
+     1ierr)
+         noff = 8
+         call MPI_FILE_READ_AT(mchk,noff,ichkh,nchkmax+4,mint,istatus,
+     1ierr)
+         noff = 152
+         call MPI_FILE_READ_AT(mchk,noff,fchkh,nchkmax,mreal,istatus,
+     1ierr)
+         noff = 280
+         call MPI_FILE_READ_AT(mchk,noff,ichkh(nchkmax+5),2*nchkmax,
+     1mint,istatus,ierr)
+         noff = 536
+         call MPI_FILE_READ_AT(mchk,noff,nchkh,2*nchkmax,MPI_INTEGER8,
+     1istatus,ierr)
+      endif
+      call MPI_BCAST(cmagic,8,MPI_CHARACTER,0,lgrp,ierr)
+      call MPI_BCAST(ichkh,lchkh,mint,0,lgrp,ierr)
+      call MPI_BCAST(fchkh,nchkmax,mreal,0,lgrp,ierr)
+      call MPI_BCAST(nchkh,2*nchkmax,MPI_INTEGER8,0,lgrp,ierr)
+      cmg = 'MPCHK2'//char(0)//char(0)
+      if ((cmagic.ne.cmg).or.(ichkh(1).lt.1).or.(ichkh(2).ne.nis).or.
+     1(ichkh(3).ne.nfs).or.(ichkh(4).gt.nchkmax)) then
+         call PPRCHKPTC2
+         irc = 2
+         return
+      endif
+      do 20 j = 1, nis
+      isc(j) = ichkh(j+4)
+   20 continue
+      do 30 j = 1, nfs
+      fsc(j) = fchkh(j)
+   30 continue
+      nvpo = ichkh(1)
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPRCHKPTA2(n,f,nrow,nrp,noffr,nrows,irc)
+c this subroutine reads a distributed array from the checkpoint file
+c opened by PPRCHKPTH2, with a collective read.  each processor reads
+c nrp rows starting at global row noffr, so the partition need not be
+c the same as the one which wrote the file
+c input: n, nrow, nrp, noffr, nrows, output: f, irc
+c n = array number in checkpoint file, starting with 1
+c f = distributed array, first nrp rows are read
+c nrow = length of each row, in reals
+c nrp = number of rows in this processor
+c noffr = global row number of first row in this processor
+c nrows = total number of rows
+c irc = error code: 0 = ok, 2 = read error, 3 = array not found or
+c wrong size
+      implicit none
+      integer n, nrow, nrp, noffr, nrows, irc
+      real f
+      dimension f(nrow,nrp)
+c get definition of MPI constants
+      include 'mpif.h'
+c common block for parallel processing
+      integer nproc, lgrp, lstat, mreal, mint, mcplx, mdouble, lworld
+      integer msum, mmax
+c lstat = length of status array
+      parameter(lstat=10)
+c lgrp = current communicator
+c mreal = default datatype for reals
+c mint = default datatype for integers
+      common /PPARMS/ nproc, lgrp, mreal, mint, mcplx, mdouble, lworld
+c msum = MPI_SUM
+c mmax = MPI_MAX
+      common /PPARMSX/ msum, mmax
+c common block for checkpoint file
+      integer nchkmax, nchkal, lchkh
+      parameter(nchkmax=32,nchkal=4096,lchkh=4+3*nchkmax)
+      integer(kind=MPI_OFFSET_KIND) nchkf, nchkh
+      integer mchk, chkerr, ichkh
+      real fchkh
+      dimension nchkh(2*nchkmax), ichkh(lchkh), fchkh(nchkmax)
+      common /PPCHKP/ nchkf, nchkh, mchk, chkerr, ichkh, fchkh
+c local data
+      integer nsz, ierr, jerr
+      integer istatus
+      integer(kind=MPI_OFFSET_KIND) noff, nbytes
+      dimension istatus(lstat)
+      if ((mchk.eq.MPI_FILE_NULL).or.(n.lt.1).or.(n.gt.ichkh(4))) then
+         irc = 3
+         return
+      endif
+      if ((ichkh(n+36).ne.nrow).or.(ichkh(n+68).ne.nrows)) then
+         irc = 3
+         return
+      endif
+      call MPI_TYPE_SIZE(mreal,nsz,ierr)
+      nbytes = nsz*nrow
+      noff = nchkh(n) + nbytes*noffr
+      call MPI_FILE_READ_AT_ALL(mchk,noff,f,nrow*nrp,mreal,istatus,ierr)
+      jerr = 0
+      if (ierr.ne.MPI_SUCCESS) jerr = 2
+      call MPI_ALLREDUCE(jerr,irc,1,mint,mmax,lgrp,ierr)
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPRCHKPTP2(n,part,edges,npp,idimp,npmax,irc)
+c this subroutine reads particles from the checkpoint file opened by
+c PPRCHKPTH2, with collective reads.  from the index, each processor
+c finds the processors which wrote the file whose partitions overlap
+c its own partition in y, reads their particles, and keeps those
+c inside its own partition.  if the partitions are the same, each
+c processor reads only the particles it wrote.  otherwise, the file
+c may have been written by a different number of processors, and the
+c particles are read in blocks of at most nchkbf particles, into the
+c unused part of the particle array
+c input: n, edges, idimp, npmax, output: part, npp, irc
+c n = array number in checkpoint file, starting with 1
+c part(i,n) = coordinate i of particle n in partition
+c edges(1:2) = lower:upper boundary of particle partition
+c npp = number of particles read in partition
+c idimp = size of phase space = 4
+c npmax = maximum number of particles in each partition
+c irc = error code: 0 = ok, 2 = read error, 3 = array not found,
+c wrong size, too many particles, or particles outside all partitions
+      implicit none
+      integer n, npp, idimp, npmax, irc
+      real part, edges
+      dimension part(idimp,npmax), edges(2)
+c get definition of MPI constants
+      include 'mpif.h'
+c common block for parallel processing
+      integer nproc, lgrp, lstat, mreal, mint, mcplx, mdouble, lworld
+      integer msum, mmax
+c lstat = length of status array
+      parameter(lstat=10)
+c lgrp = current communicator
+c mreal = default datatype for reals
+c mint = default datatype for integers
+      common /PPARMS/ nproc, lgrp, mreal, mint, mcplx, mdouble, lworld
+c msum = MPI_SUM
+c mmax = MPI_MAX
+      common /PPARMSX/ msum, mmax
+c common block for checkpoint file
+      integer nchkmax, nchkal, lchkh
+      parameter(nchkmax=32,nchkal=4096,lchkh=4+3*nchkmax)
+      integer(kind=MPI_OFFSET_KIND) nchkf, nchkh
+      integer mchk, chkerr, ichkh
+      real fchkh
+      dimension nchkh(2*nchkmax), ichkh(lchkh), fchkh(nchkmax)
+      common /PPCHKP/ nchkf, nchkh, mchk, chkerr, ichkh, fchkh
+c nchkbf = maximum number of particles read in one block
+c nvpmx = maximum number of processors which wrote the file
+      integer nchkbf, nvpmx
+      parameter(nchkbf=65536,nvpmx=16384)
+c local data
+      integer i, j, j1, j2, ks, nvpo, mpp, mps, nps, npt, nsz, nisz
+      integer ierr, jerr
+      integer kpp, istatus
+      integer(kind=MPI_OFFSET_KIND) noffp, nbytes, nsum, mtot, ntot
+      logical lsame
+      real edgs, yt
+      dimension kpp(nvpmx), edgs(2,nvpmx), istatus(lstat)
+      if ((mchk.eq.MPI_FILE_NULL).or.(n.lt.1).or.(n.gt.ichkh(4))) then
+         irc = 3
+         return
+      endif
+      nvpo = ichkh(1)
+      if ((ichkh(n+36).ne.idimp).or.(ichkh(n+68).ne.0).or.
+     1(nvpo.gt.nvpmx)) then
+         irc = 3
+         return
+      endif
+      call MPI_COMM_RANK(lgrp,ks,ierr)
+      call MPI_TYPE_SIZE(mreal,nsz,ierr)
+      call MPI_TYPE_SIZE(mint,nisz,ierr)
+c read particle index
+      jerr = 0
+      call MPI_FILE_READ_AT_ALL(mchk,nchkh(n),kpp,nvpo,mint,istatus,ierr
+     1)
+      if (ierr.ne.MPI_SUCCESS) jerr = 2
+      noffp = nchkh(n) + nisz*nvpo
+      call MPI_FILE_READ_AT_ALL(mchk,noffp,edgs,2*nvpo,mreal,istatus,
+     1ierr)
+      if (ierr.ne.MPI_SUCCESS) jerr = 2
+      nbytes = nisz + 2*nsz
+      nbytes = nbytes*nvpo
+      noffp = nchkh(n) + nchkal*((nbytes + nchkal - 1)/nchkal)
+c find range of processors j1:j2 whose partitions overlap this one
+      nsum = 0
+      mtot = 0
+      j1 = nvpo + 1
+      j2 = 0
+      do 10 j = 1, nvpo
+      if ((edgs(1,j).lt.edges(2)).and.(edgs(2,j).gt.edges(1))) then
+         if (j1.gt.nvpo) j1 = j
+         j2 = j
+         mtot = mtot + kpp(j)
+      else if (j1.gt.nvpo) then
+         nsum = nsum + kpp(j)
+      endif
+   10 continue
+c same partition: read own particles directly
+      lsame = ((nvpo.eq.nproc).and.(j1.eq.(ks+1)).and.(j2.eq.(ks+1)))
+      if (lsame) lsame = ((edgs(1,ks+1).eq.edges(1)).and.
+     1(edgs(2,ks+1).eq.edges(2)))
+      mpp = 0
+      if (lsame) then
+         mpp = mtot
+         mtot = 0
+         if (mpp.gt.npmax) jerr = 3
+      endif
+      call MPI_ALLREDUCE(jerr,irc,1,mint,mmax,lgrp,ierr)
+      if (irc.ne.0) return
+      nbytes = nsz*idimp
+      nbytes = noffp + nbytes*nsum
+      call MPI_FILE_READ_AT_ALL(mchk,nbytes,part,idimp*mpp,mreal,
+     1istatus,ierr)
+      if (ierr.ne.MPI_SUCCESS) jerr = 2
+      if (lsame) nsum = nsum + mpp
+c different partition: read overlapping particles in blocks, until no
+c processor has particles left to read
+c mtot = particles not yet read, nsum = particles in file before them
+   20 nps = min(mtot,int(min(nchkbf,npmax-mpp),kind=MPI_OFFSET_KIND))
+      mps = mpp
+c particles are read into the unused part of the particle array
+      if ((nps.le.0).and.(mtot.gt.0)) then
+         jerr = 3
+         nps = 0
+         mtot = 0
+      endif
+      call MPI_ALLREDUCE(nps,npt,1,mint,mmax,lgrp,ierr)
+      if (npt.gt.0) then
+         nbytes = nsz*idimp
+         nbytes = noffp + nbytes*nsum
+         call MPI_FILE_READ_AT_ALL(mchk,nbytes,part(1,min(mps+1,npmax)),
+     1idimp*nps,mreal,istatus,ierr)
+         if (ierr.ne.MPI_SUCCESS) jerr = 2
+         nsum = nsum + nps
+         mtot = mtot - nps
+c keep particles inside partition
+         do 40 j = 1, nps
+         yt = part(2,mps+j)
+         if ((yt.ge.edges(1)).and.(yt.lt.edges(2))) then
+            mpp = mpp + 1
+            do 30 i = 1, idimp
+            part(i,mpp) = part(i,mps+j)
+   30       continue
+         endif
+   40    continue
+         go to 20
+      endif
+c check that every particle was read by one processor
+      mtot = mpp
+      call MPI_ALLREDUCE(mtot,ntot,1,MPI_INTEGER8,msum,lgrp,ierr)
+      if (ntot.ne.nchkh(n+nchkmax)) jerr = 3
+      call MPI_ALLREDUCE(jerr,irc,1,mint,mmax,lgrp,ierr)
+      npp = mpp
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPRCHKPTC2
+c this subroutine closes the checkpoint file opened by PPRCHKPTH2
+      implicit none
+c get definition of MPI constants
+      include 'mpif.h'
+c common block for checkpoint file
+      integer nchkmax, nchkal, lchkh
+      parameter(nchkmax=32,nchkal=4096,lchkh=4+3*nchkmax)
+      integer(kind=MPI_OFFSET_KIND) nchkf, nchkh
+      integer mchk, chkerr, ichkh
+      real fchkh
+      dimension nchkh(2*nchkmax), ichkh(lchkh), fchkh(nchkmax)
+      common /PPCHKP/ nchkf, nchkh, mchk, chkerr, ichkh, fchkh
+c local data
+      integer ierr
+      if (mchk.ne.MPI_FILE_NULL) call MPI_FILE_CLOSE(mchk,ierr)
+      mchk = MPI_FILE_NULL
+      return
+      end
@@ -13,6 +13,10 @@
 ! PPNCGUARD2L copies data to guard cells in y for scalar data, linear
 !             interpolation, and distributed data with non-uniform
 !             partition.
+! PPINCGUARD2L starts copying data to guard cells in y for scalar data,
+!              using non-blocking messages.
+! PPWNCGUARD2L waits for guard cell copy started by PPINCGUARD2L to
+!              complete.
 ! PPNAGUARD2L adds guard cells in y for scalar array, linear
 !             interpolation, and distributed data with non-uniform
 !             partition.
@@ -24,8 +28,18 @@
 ! PPNTPOSE performs a transpose of an n component complex vector array,
 !          distributed in y, to an n component complex vector array,
 !          distributed in x.
+! PPTPOSENB performs a transpose of a complex scalar array, distributed
+!           in y, to a complex scalar array, distributed in x, using
+!           non-blocking messages to all processors at once.
+! PPNTPOSENB performs a transpose of an n component complex vector
+!            array, distributed in y, to an n component complex vector
+!            array, distributed in x, using non-blocking messages to all
+!            processors at once.
 ! PPPMOVE2 moves particles into appropriate spatial regions for tiled
 !          distributed data.
+! PPIPMOVE2 starts moving particles into appropriate spatial regions for
+!           tiled distributed data, using non-blocking messages.
+! PPWPMOVE2 waits for particle move started by PPIPMOVE2 to complete.
 ! written by viktor k. decyk, ucla
 ! copyright 1995, regents of the university of california
 ! update: may 9, 2015
@@ -47,13 +61,19 @@
 ! msum = MPI_SUM
 ! mmax = MPI_MAX
       integer :: msum, mmax
+! mgsid = requests for guard cells in flight, from PPINCGUARD2L
+! mpsid = requests for particles in flight, from PPIPMOVE2
+      integer, dimension(2) :: mgsid
+      integer, dimension(8) :: mpsid
       save
 !
       private
       public :: PPINIT2, PPEXIT, PPABORT, PWTIMERA
       public :: PPSUM, PPDSUM, PPIMAX, PPDMAX
-      public :: PPNCGUARD2L, PPNAGUARD2L, PPNACGUARD2L
-      public :: PPTPOSE, PPNTPOSE, PPPMOVE2
+      public :: PPNCGUARD2L, PPINCGUARD2L, PPWNCGUARD2L
+      public :: PPNAGUARD2L, PPNACGUARD2L
+      public :: PPTPOSE, PPNTPOSE, PPTPOSENB, PPNTPOSENB
+      public :: PPPMOVE2, PPIPMOVE2, PPWPMOVE2
 !
       contains
 !
@@ -331,6 +351,64 @@
       call MPI_WAIT(msid,istatus,ierr)
       end subroutine
 !
+!-----------------------------------------------------------------------
+      subroutine PPINCGUARD2L(f,nyp,kstrt,nvp,nxv,nypmx)
+! this subroutine starts copying data to guard cells in non-uniform
+! partitions, using non-blocking messages.  the copy is completed by
+! PPWNCGUARD2L.  until then, the guard cells f(:,nyp+1) must not be
+! accessed and the first row f(:,1) must not be modified
+! f(j,k) = real data for grid j,k in particle partition.
+! the grid is non-uniform and includes one extra guard cell.
+! output: f
+! nyp = number of primary gridpoints in field partition
+! it is assumed the nyp > 0.
+! kstrt = starting data block number
+! nvp = number of real or virtual processors
+! nxv = first dimension of f, must be >= nx
+! nypmx = maximum size of field partition, including guard cell.
+! linear interpolation, for distributed data
+      implicit none
+      integer, intent(in) :: nyp, kstrt, nvp, nxv, nypmx
+      real, dimension(nxv,nypmx), intent(inout) :: f
+! lgrp = current communicator
+! mreal = default datatype for reals
+! local data
+      integer :: j, ks, moff, kl, kr
+      integer :: ierr
+! special case for one processor
+      if (nvp==1) then
+         do j = 1, nxv
+            f(j,nyp+1) = f(j,1)
+         enddo
+         return
+      endif
+      ks = kstrt - 1
+      moff = nypmx*nvp + 2
+! copy to guard cells
+      kr = ks + 1
+      if (kr >= nvp) kr = kr - nvp
+      kl = ks - 1
+      if (kl < 0)  kl = kl + nvp
+      ks = nyp + 1
+! this segment is used for mpi computers
+      call MPI_IRECV(f(1,ks),nxv,mreal,kr,moff,lgrp,mgsid(1),ierr)
+      call MPI_ISEND(f,nxv,mreal,kl,moff,lgrp,mgsid(2),ierr)
+      end subroutine
+!
+!-----------------------------------------------------------------------
+      subroutine PPWNCGUARD2L(nvp)
+! this subroutine waits for the guard cell copy started by PPINCGUARD2L
+! to complete
+! nvp = number of real or virtual processors
+      implicit none
+      integer, intent(in) :: nvp
+! local data
+      integer :: ierr
+      integer, dimension(lstat,2) :: istatus
+      if (nvp==1) return
+      call MPI_WAITALL(2,mgsid,istatus,ierr)
+      end subroutine
+!
 !-----------------------------------------------------------------------
       subroutine PPNAGUARD2L(f,scr,nyp,nx,kstrt,nvp,nxv,nypmx)
 ! this subroutine adds data from guard cells in non-uniform partitions
@@ -637,6 +715,176 @@
       enddo
       end subroutine
 !
+!-----------------------------------------------------------------------
+      subroutine PPTPOSENB(f,g,s,t,nx,ny,kxp,kyp,kstrt,nvp,nxv,nyv,kxpd,&
+     &kypd)
+! this subroutine performs a transpose of a matrix f, distributed in y,
+! to a matrix g, distributed in x, that is,
+! g(k+kyp*(m-1),j,l) = f(j+kxp*(l-1),k,m), where
+! 1 <= j <= kxp, 1 <= k <= kyp, 1 <= l <= nx/kxp, 1 <= m <= ny/kyp
+! and where indices l and m can be distributed across processors.
+! this subroutine posts all receives first, then sends all messages
+! asynchronously, unpacking data in the order it arrives, so that
+! packing and unpacking overlap with communication.
+! it requires nvp times the scratch memory of PPTPOSE
+! f = complex input array
+! g = complex output array
+! s, t = complex scratch arrays, of size kxp*kyp*nvp
+! nx/ny = number of points in x/y
+! kxp/kyp = number of data values per block in x/y
+! kstrt = starting data block number
+! nvp = number of real or virtual processors
+! nxv/nyv = first dimension of f/g
+! kypd/kxpd = second dimension of f/g
+      implicit none
+      integer, intent(in) :: nx, ny, kxp, kyp, kstrt, nvp, nxv, nyv
+      integer, intent(in) :: kxpd, kypd
+      complex, dimension(nxv,kypd), intent(in) :: f
+      complex, dimension(nyv,kxpd), intent(inout) :: g
+      complex, dimension(kxp*kyp,nvp), intent(inout) :: s, t
+      call PPNTPOSENB(f,g,s,t,nx,ny,kxp,kyp,kstrt,nvp,1,nxv,nyv,kxpd,   &
+     &kypd)
+      end subroutine
+!
+!-----------------------------------------------------------------------
+      subroutine PPNTPOSENB(f,g,s,t,nx,ny,kxp,kyp,kstrt,nvp,ndim,nxv,nyv&
+     &,kxpd,kypd)
+! this subroutine performs a transpose of a matrix f, distributed in y,
+! to a matrix g, distributed in x, that is,
+! g(1:ndim,k+kyp*(m-1),j,l) = f(1:ndim,j+kxp*(l-1),k,m), where
+! 1 <= j <= kxp, 1 <= k <= kyp, 1 <= l <= nx/kxp, 1 <= m <= ny/kyp
+! and where indices l and m can be distributed across processors.
+! this subroutine posts all receives first, then sends all messages
+! asynchronously, unpacking data in the order it arrives, so that
+! packing and unpacking overlap with communication.
+! the local block is copied directly.
+! it requires nvp times the scratch memory of PPNTPOSE
+! f = complex input array
+! g = complex output array
+! s, t = complex scratch arrays, of size ndim*kxp*kyp*nvp
+! nx/ny = number of points in x/y
+! kxp/kyp = number of data values per block in x/y
+! kstrt = starting data block number
+! nvp = number of real or virtual processors
+! ndim = leading dimension of arrays f and g
+! nxv/nyv = first dimension of f/g
+! kypd/kxpd = second dimension of f/g
+      implicit none
+      integer, intent(in) :: nx, ny, kxp, kyp, kstrt, nvp, ndim
+      integer, intent(in) :: nxv, nyv, kxpd, kypd
+      complex, dimension(ndim,nxv,kypd), intent(in) :: f
+      complex, dimension(ndim,nyv,kxpd), intent(inout) :: g
+      complex, dimension(ndim,kxp*kyp,nvp), intent(inout) :: s, t
+! lgrp = current communicator
+! mcplx = default datatype for complex
+! local data
+      integer :: i, n, j, k, ks, kxps, kyps, kxyp, id, joff, koff, ld
+      integer :: ierr
+      logical :: flag
+      integer, dimension(nvp) :: msid, mrid
+      integer, dimension(lstat) :: istatus
+      ks = kstrt - 1
+      kxps = min(kxp,max(0,nx-kxp*ks))
+      kyps = min(kyp,max(0,ny-kyp*ks))
+      kxyp = ndim*kxp*kyp
+! special case for one processor
+      if (nvp==1) then
+!$OMP PARALLEL DO PRIVATE(i,j,k)
+         do k = 1, kyp
+            do j = 1, kxp
+               do i = 1, ndim
+                  g(i,k,j) = f(i,j,k)
+               enddo
+            enddo
+         enddo
+!$OMP END PARALLEL DO
+         return
+      endif
+! post all receives, data from processor id is stored in block id+1
+      do n = 1, nvp
+         id = n - ks - 1
+         if (id.lt.0) id = id + nvp
+         if (id /= ks) then
+            call MPI_IRECV(t(1,1,id+1),kxyp,mcplx,id,n,lgrp,mrid(id+1),  &
+     &ierr)
+         endif
+      enddo
+      mrid(ks+1) = MPI_REQUEST_NULL
+      msid(ks+1) = MPI_REQUEST_NULL
+! extract and send data, data to processor id is stored in block id+1
+      do n = 1, nvp
+         id = n - ks - 1
+         if (id.lt.0) id = id + nvp
+         if (id==ks) cycle
+         joff = kxp*id
+         ld = min(kxp,max(0,nx-joff))
+!$OMP PARALLEL DO PRIVATE(i,j,k)
+         do k = 1, kyps
+            do j = 1, ld
+               do i = 1, ndim
+                  s(i,j+ld*(k-1),id+1) = f(i,j+joff,k)
+               enddo
+            enddo
+         enddo
+!$OMP END PARALLEL DO
+         ld = ndim*ld*kyps
+         call MPI_ISEND(s(1,1,id+1),ld,mcplx,id,n,lgrp,msid(id+1),ierr)
+! insert any data which has already arrived
+         flag = .true.
+         do while (flag)
+            call MPI_TESTANY(nvp,mrid,id,flag,istatus,ierr)
+            if (id==MPI_UNDEFINED) flag = .false.
+            if (flag) then
+               call PPNTUNPACK(g,t(1,1,id),id-1,ny,kxp,kxps,kyp,ndim,nyv&
+     &,kxpd)
+            endif
+         enddo
+      enddo
+! copy local block while messages are in flight
+      joff = kxp*ks
+      koff = kyp*ks
+!$OMP PARALLEL DO PRIVATE(i,j,k)
+      do k = 1, kyps
+         do j = 1, kxps
+            do i = 1, ndim
+               g(i,k+koff,j) = f(i,j+joff,k)
+            enddo
+         enddo
+      enddo
+!$OMP END PARALLEL DO
+! insert remaining data as it arrives
+      do n = 2, nvp
+         call MPI_WAITANY(nvp,mrid,id,istatus,ierr)
+         if (id==MPI_UNDEFINED) exit
+         call PPNTUNPACK(g,t(1,1,id),id-1,ny,kxp,kxps,kyp,ndim,nyv,kxpd)
+      enddo
+! wait for sends to complete
+      call MPI_WAITALL(nvp,msid,MPI_STATUSES_IGNORE,ierr)
+      end subroutine
+!
+!-----------------------------------------------------------------------
+      subroutine PPNTUNPACK(g,t,id,ny,kxp,kxps,kyp,ndim,nyv,kxpd)
+! this subroutine inserts a block of transposed data t, received from
+! processor id, into g.  used by PPNTPOSENB
+      implicit none
+      integer, intent(in) :: id, ny, kxp, kxps, kyp, ndim, nyv, kxpd
+      complex, dimension(ndim,nyv,kxpd), intent(inout) :: g
+      complex, dimension(ndim,kxp*kyp), intent(in) :: t
+! local data
+      integer :: i, j, k, koff, ld
+      koff = kyp*id
+      ld = min(kyp,max(0,ny-koff))
+!$OMP PARALLEL DO PRIVATE(i,j,k)
+      do k = 1, ld
+         do j = 1, kxps
+            do i = 1, ndim
+               g(i,k+koff,j) = t(i,j+kxps*(k-1))
+            enddo
+         enddo
+      enddo
+!$OMP END PARALLEL DO
+      end subroutine
+!
 !-----------------------------------------------------------------------
       subroutine PPPMOVE2(sbufr,sbufl,rbufr,rbufl,ncll,nclr,mcll,mclr,  &
      &kstrt,nvp,idimp,nbmax,mx1)
@@ -732,6 +980,86 @@
          enddo
       endif
       end subroutine
+!
+!-----------------------------------------------------------------------
+      subroutine PPIPMOVE2(sbufr,sbufl,rbufr,rbufl,ncll,nclr,mcll,mclr, &
+     &kstrt,nvp,idimp,nbmax,mx1)
+! this subroutine starts moving particles into appropriate spatial
+! regions for distributed data, with 1d domain decomposition in y,
+! using non-blocking messages.  all messages are posted at once and the
+! move is completed by PPWPMOVE2.  until then, rbufr, rbufl, mcll, mclr
+! must not be accessed and sbufr, sbufl, ncll, nclr must not be modified
+! tiles are assumed to be arranged in 2D linear memory
+! output: rbufr, rbufl, mcll, mclr
+! sbufl = buffer for particles being sent to lower processor
+! sbufr = buffer for particles being sent to upper processor
+! rbufl = buffer for particles being received from lower processor
+! rbufr = buffer for particles being received from upper processor
+! ncll = particle number being sent to lower processor
+! nclr = particle number being sent to upper processor
+! mcll = particle number being received from lower processor
+! mclr = particle number being received from upper processor
+! kstrt = starting data block number
+! nvp = number of real or virtual processors
+! idimp = size of phase space = 4 or 5
+! nbmax =  size of buffers for passing particles between processors
+! mx1 = (system length in x direction - 1)/mx + 1
+      implicit none
+      integer, intent(in) :: kstrt, nvp, idimp, nbmax, mx1
+      real, dimension(idimp,nbmax), intent(in) :: sbufl, sbufr
+      real, dimension(idimp,nbmax), intent(inout) :: rbufl, rbufr
+      integer, dimension(3,mx1), intent(in) :: ncll, nclr
+      integer, dimension(3,mx1), intent(inout) :: mcll, mclr
+! lgrp = current communicator
+! mint = default datatype for integers
+! mreal = default datatype for reals
+! local data
+      integer :: ierr, ks, kl, kr, jsl, jsr
+      integer :: nbsize, ncsize
+      integer, dimension(4) :: itg
+      data itg /3,4,5,6/
+! special case for one processor
+      if (nvp==1) then
+         call PPPMOVE2(sbufr,sbufl,rbufr,rbufl,ncll,nclr,mcll,mclr,     &
+     &kstrt,nvp,idimp,nbmax,mx1)
+         return
+      endif
+      ks = kstrt - 1
+      nbsize = idimp*nbmax
+      ncsize = 3*mx1
+! get particles from below and above
+      kr = ks + 1
+      if (kr >= nvp) kr = kr - nvp
+      kl = ks - 1
+      if (kl < 0) kl = kl + nvp
+! post receives
+      call MPI_IRECV(mcll,ncsize,mint,kl,itg(1),lgrp,mpsid(1),ierr)
+      call MPI_IRECV(mclr,ncsize,mint,kr,itg(2),lgrp,mpsid(2),ierr)
+      call MPI_IRECV(rbufl,nbsize,mreal,kl,itg(3),lgrp,mpsid(3),ierr)
+      call MPI_IRECV(rbufr,nbsize,mreal,kr,itg(4),lgrp,mpsid(4),ierr)
+! send particle number offsets
+      call MPI_ISEND(nclr,ncsize,mint,kr,itg(1),lgrp,mpsid(5),ierr)
+      call MPI_ISEND(ncll,ncsize,mint,kl,itg(2),lgrp,mpsid(6),ierr)
+! send particles
+      jsr = idimp*nclr(3,mx1)
+      call MPI_ISEND(sbufr,jsr,mreal,kr,itg(3),lgrp,mpsid(7),ierr)
+      jsl = idimp*ncll(3,mx1)
+      call MPI_ISEND(sbufl,jsl,mreal,kl,itg(4),lgrp,mpsid(8),ierr)
+      end subroutine
+!
+!-----------------------------------------------------------------------
+      subroutine PPWPMOVE2(nvp)
+! this subroutine waits for the particle move started by PPIPMOVE2 to
+! complete
+! nvp = number of real or virtual processors
+      implicit none
+      integer, intent(in) :: nvp
+! local data
+      integer :: ierr
+      integer, dimension(lstat,8) :: istatus
+      if (nvp==1) return
+      call MPI_WAITALL(8,mpsid,istatus,ierr)
+      end subroutine
 !
       end module
 !
@@ -814,6 +1142,23 @@
       call SUB(f,nyp,kstrt,nvp,nxv,nypmx)
       end subroutine
 !
+!-----------------------------------------------------------------------
+      subroutine PPINCGUARD2L(f,nyp,kstrt,nvp,nxv,nypmx)
+      use mpplib2, only: SUB => PPINCGUARD2L
+      implicit none
+      integer, intent(in) :: nyp, kstrt, nvp, nxv, nypmx
+      real, dimension(nxv,nypmx), intent(inout) :: f
+      call SUB(f,nyp,kstrt,nvp,nxv,nypmx)
+      end subroutine
+!
+!-----------------------------------------------------------------------
+      subroutine PPWNCGUARD2L(nvp)
+      use mpplib2, only: SUB => PPWNCGUARD2L
+      implicit none
+      integer, intent(in) :: nvp
+      call SUB(nvp)
+      end subroutine
+!
 !-----------------------------------------------------------------------
       subroutine PPNAGUARD2L(f,scr,nyp,nx,kstrt,nvp,nxv,nypmx)
       use mpplib2, only: SUB => PPNAGUARD2L
@@ -860,6 +1205,32 @@
       call SUB(f,g,s,t,nx,ny,kxp,kyp,kstrt,nvp,ndim,nxv,nyv,kxpd,kypd)
       end subroutine
 !
+!-----------------------------------------------------------------------
+      subroutine PPTPOSENB(f,g,s,t,nx,ny,kxp,kyp,kstrt,nvp,nxv,nyv,kxpd,&
+     &kypd)
+      use mpplib2, only: SUB => PPTPOSENB
+      implicit none
+      integer, intent(in) :: nx, ny, kxp, kyp, kstrt, nvp, nxv, nyv
+      integer, intent(in) :: kxpd, kypd
+      complex, dimension(nxv,kypd), intent(in) :: f
+      complex, dimension(nyv,kxpd), intent(inout) :: g
+      complex, dimension(kxp*kyp,nvp), intent(inout) :: s, t
+      call SUB(f,g,s,t,nx,ny,kxp,kyp,kstrt,nvp,nxv,nyv,kxpd,kypd)
+      end subroutine
+!
+!-----------------------------------------------------------------------
+      subroutine PPNTPOSENB(f,g,s,t,nx,ny,kxp,kyp,kstrt,nvp,ndim,nxv,nyv&
+     &,kxpd,kypd)
+      use mpplib2, only: SUB => PPNTPOSENB
+      implicit none
+      integer, intent(in) :: nx, ny, kxp, kyp, kstrt, nvp, ndim
+      integer, intent(in) :: nxv, nyv, kxpd, kypd
+      complex, dimension(ndim,nxv,kypd), intent(in) :: f
+      complex, dimension(ndim,nyv,kxpd), intent(inout) :: g
+      complex, dimension(ndim,kxp*kyp,nvp), intent(inout) :: s, t
+      call SUB(f,g,s,t,nx,ny,kxp,kyp,kstrt,nvp,ndim,nxv,nyv,kxpd,kypd)
+      end subroutine
+!
 !-----------------------------------------------------------------------
       subroutine PPPMOVE2(sbufr,sbufl,rbufr,rbufl,ncll,nclr,mcll,mclr,  &
      &kstrt,nvp,idimp,nbmax,mx1)
@@ -873,5 +1244,27 @@
       call SUB(sbufr,sbufl,rbufr,rbufl,ncll,nclr,mcll,mclr,kstrt,nvp,   &
      &idimp,nbmax,mx1)
       end subroutine
+!
+!-----------------------------------------------------------------------
+      subroutine PPIPMOVE2(sbufr,sbufl,rbufr,rbufl,ncll,nclr,mcll,mclr, &
+     &kstrt,nvp,idimp,nbmax,mx1)
+      use mpplib2, only: SUB => PPIPMOVE2
+      implicit none
+      integer, intent(in) :: kstrt, nvp, idimp, nbmax, mx1
+      real, dimension(idimp,nbmax), intent(in) :: sbufl, sbufr
+      real, dimension(idimp,nbmax), intent(inout) :: rbufl, rbufr
+      integer, dimension(3,mx1), intent(in) :: ncll, nclr
+      integer, dimension(3,mx1), intent(inout) :: mcll, mclr
+      call SUB(sbufr,sbufl,rbufr,rbufl,ncll,nclr,mcll,mclr,kstrt,nvp,   &
+     &idimp,nbmax,mx1)
+      end subroutine
+!
+!-----------------------------------------------------------------------
+      subroutine PPWPMOVE2(nvp)
+      use mpplib2, only: SUB => PPWPMOVE2
+      implicit none
+      integer, intent(in) :: nvp
+      call SUB(nvp)
+      end subroutine
 
 
@@ -16,9 +16,18 @@ void cppimax(int f[], int g[], int nxp);
 
 void cppdmax(double f[], double g[], int nxp);
 
+void cppshminit2(float **sbufr, float **sbufl, int **nclr, int **ncll,
+                 int *nshm, int kstrt, int nvp, int nxv, int ndim,
+                 int kxp, int kyp, int idimp, int nbmax, int mxyp1);
+
 void cppncguard2l(float f[], int nyp, int kstrt, int nvp, int nxv,
                   int nypmx);
 
+void cppincguard2l(float f[], int nyp, int kstrt, int nvp, int nxv,
+                   int nypmx);
+
+void cppwncguard2l(int nvp);
+
 void cppnaguard2l(float f[], float scr[], int nyp, int nx, int kstrt,
                   int nvp, int nxv, int nypmx);
 
@@ -34,7 +43,45 @@ void cppntpose(float complex f[], float complex g[], float complex s[],
                int kstrt, int nvp, int ndim, int nxv, int nyv, int kxpd,
                int kypd);
 
+void cpptposenb(float complex f[], float complex g[], float complex s[],
+                float complex t[], int nx, int ny, int kxp, int kyp,
+                int kstrt, int nvp, int nxv, int nyv, int kxpd,
+                int kypd);
+
+void cppntposenb(float complex f[], float complex g[], float complex s[],
+                 float complex t[], int nx, int ny, int kxp, int kyp,
+                 int kstrt, int nvp, int ndim, int nxv, int nyv,
+                 int kxpd, int kypd);
+
 void cpppmove2(float sbufr[], float sbufl[], float rbufr[], 
                float rbufl[], int ncll[], int nclr[], int mcll[],
                int mclr[], int kstrt, int nvp, int idimp, int nbmax,
                int mx1);
+
+void cppipmove2(float sbufr[], float sbufl[], float rbufr[],
+                float rbufl[], int ncll[], int nclr[], int mcll[],
+                int mclr[], int kstrt, int nvp, int idimp, int nbmax,
+                int mx1);
+
+void cppwpmove2(int nvp);
+
+void cppwchkpth2(char *fname, int nis, int isc[], int nfs, float fsc[],
+                 int *irc);
+
+void cppwchkpta2(float f[], int nrow, int nrp, int noffr, int nrows);
+
+void cppwchkptp2(float part[], float edges[], int npp, int idimp,
+                 int npmax);
+
+void cppwchkptc2(int *irc);
+
+void cpprchkpth2(char *fname, int nis, int isc[], int nfs, float fsc[],
+                 int *nvpo, int *irc);
+
+void cpprchkpta2(int n, float f[], int nrow, int nrp, int noffr,
+                 int nrows, int *irc);
+
+void cpprchkptp2(int n, float part[], float edges[], int *npp,
+                 int idimp, int npmax, int *irc);
+
+void cpprchkptc2();
@@ -1,6 +1,10 @@
 /* Basic parallel PIC library for MPI communications with OpenMP */
 /* Wrappers for calling the Fortran routines from a C main program */
 
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <complex.h>
 
 void ppinit2_(int *idproc, int *nvp, int *argc, char *argv[]);
@@ -22,6 +26,11 @@ void ppdmax_(double *f, double *g, int *nxp);
 void ppncguard2l_(float *f, int *nyp, int *kstrt, int *nvp, int *nxv,
                   int *nypmx);
 
+void ppincguard2l_(float *f, int *nyp, int *kstrt, int *nvp, int *nxv,
+                   int *nypmx);
+
+void ppwncguard2l_(int *nvp);
+
 void ppnaguard2l_(float *f, float *scr, int *nyp, int *nx, int *kstrt,
                   int *nvp, int *nxv, int *nypmx);
 
@@ -38,16 +47,58 @@ void ppntpose_(float complex *f, float complex *g, float complex *s,
                int *kstrt, int *nvp, int *ndim, int *nxv, int *nyv,
                int *kxpd, int *kypd);
 
+void pptposenb_(float complex *f, float complex *g, float complex *s,
+                float complex *t, int *nx, int *ny, int *kxp, int *kyp,
+                int *kstrt, int *nvp, int *nxv, int *nyv, int *kxpd,
+                int *kypd);
+
+void ppntposenb_(float complex *f, float complex *g, float complex *s,
+                 float complex *t, int *nx, int *ny, int *kxp, int *kyp,
+                 int *kstrt, int *nvp, int *ndim, int *nxv, int *nyv,
+                 int *kxpd, int *kypd);
+
 void pppmove2_(float *sbufr, float *sbufl, float *rbufr, float *rbufl,
                int *ncll, int *nclr, int *mcll, int *mclr, int *kstrt,
                int *nvp, int *idimp, int *nbmax, int *mx1);
 
+void ppipmove2_(float *sbufr, float *sbufl, float *rbufr, float *rbufl,
+                int *ncll, int *nclr, int *mcll, int *mclr, int *kstrt,
+                int *nvp, int *idimp, int *nbmax, int *mx1);
+
+void ppwpmove2_(int *nvp);
+
+void ppwchkpth2_(char *fname, int *nis, int *isc, int *nfs, float *fsc,
+                 int *irc, size_t lfname);
+
+void ppwchkpta2_(float *f, int *nrow, int *nrp, int *noffr, int *nrows);
+
+void ppwchkptp2_(float *part, float *edges, int *npp, int *idimp,
+                 int *npmax);
+
+void ppwchkptc2_(int *irc);
+
+void pprchkpth2_(char *fname, int *nis, int *isc, int *nfs, float *fsc,
+                 int *nvpo, int *irc, size_t lfname);
+
+void pprchkpta2_(int *n, float *f, int *nrow, int *nrp, int *noffr,
+                 int *nrows, int *irc);
+
+void pprchkptp2_(int *n, float *part, float *edges, int *npp,
+                 int *idimp, int *npmax, int *irc);
+
+void pprchkptc2_();
 
 /* Interfaces to C */
 
+/* fchk = name of checkpoint file being written */
+/* kchkid = processor id, processor 0 renames the checkpoint file */
+static char fchk[256];
+static int kchkid = 0;
+
 /*--------------------------------------------------------------------*/
 void cppinit2(int *idproc, int *nvp, int argc, char *argv[]) {
    ppinit2_(idproc,nvp,&argc,argv);
+   kchkid = *idproc;
    return;
 }
 
@@ -98,6 +149,19 @@ void cppncguard2l(float f[], int nyp, int kstrt, int nvp, int nxv,
    return;
 }
 
+/*--------------------------------------------------------------------*/
+void cppincguard2l(float f[], int nyp, int kstrt, int nvp, int nxv,
+                   int nypmx) {
+   ppincguard2l_(f,&nyp,&kstrt,&nvp,&nxv,&nypmx);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppwncguard2l(int nvp) {
+   ppwncguard2l_(&nvp);
+   return;
+}
+
 /*--------------------------------------------------------------------*/
 void cppnaguard2l(float f[], float scr[], int nyp, int nx, int kstrt,
                   int nvp, int nxv, int nypmx) {
@@ -132,6 +196,26 @@ void cppntpose(float complex f[], float complex g[], float complex s[],
    return;
 }
 
+/*--------------------------------------------------------------------*/
+void cpptposenb(float complex f[], float complex g[], float complex s[],
+                float complex t[], int nx, int ny, int kxp, int kyp,
+                int kstrt, int nvp, int nxv, int nyv, int kxpd,
+                int kypd) {
+   pptposenb_(f,g,s,t,&nx,&ny,&kxp,&kyp,&kstrt,&nvp,&nxv,&nyv,&kxpd,
+              &kypd);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppntposenb(float complex f[], float complex g[], float complex s[],
+                 float complex t[], int nx, int ny, int kxp, int kyp,
+                 int kstrt, int nvp, int ndim, int nxv, int nyv,
+                 int kxpd, int kypd) {
+   ppntposenb_(f,g,s,t,&nx,&ny,&kxp,&kyp,&kstrt,&nvp,&ndim,&nxv,&nyv,
+               &kxpd,&kypd);
+   return;
+}
+
 /*--------------------------------------------------------------------*/
 void cpppmove2(float sbufr[], float sbufl[], float rbufr[], 
                float rbufl[], int ncll[], int nclr[], int mcll[],
@@ -141,3 +225,109 @@ void cpppmove2(float sbufr[], float sbufl[], float rbufr[],
              &idimp,&nbmax,&mx1);
    return;
 }
+
+/*--------------------------------------------------------------------*/
+void cppipmove2(float sbufr[], float sbufl[], float rbufr[],
+                float rbufl[], int ncll[], int nclr[], int mcll[],
+                int mclr[], int kstrt, int nvp, int idimp, int nbmax,
+                int mx1) {
+   ppipmove2_(sbufr,sbufl,rbufr,rbufl,ncll,nclr,mcll,mclr,&kstrt,&nvp,
+              &idimp,&nbmax,&mx1);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppwpmove2(int nvp) {
+   ppwpmove2_(&nvp);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppwchkpth2(char *fname, int nis, int isc[], int nfs, float fsc[],
+                 int *irc) {
+/* the file is written as fname.tmp and renamed by cppwchkptc2 */
+   char ftmp[264];
+   if (strlen(fname) > 255) {
+      *irc = 4;
+      return;
+   }
+   strcpy(fchk,fname);
+   sprintf(ftmp,"%s.tmp",fname);
+   ppwchkpth2_(ftmp,&nis,isc,&nfs,fsc,irc,strlen(ftmp));
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppwchkpta2(float f[], int nrow, int nrp, int noffr, int nrows) {
+   ppwchkpta2_(f,&nrow,&nrp,&noffr,&nrows);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppwchkptp2(float part[], float edges[], int npp, int idimp,
+                 int npmax) {
+   ppwchkptp2_(part,edges,&npp,&idimp,&npmax);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppwchkptc2(int *irc) {
+/* irc = 3 if the completed file cannot be renamed */
+   int one = 1;
+   int jrc[1];
+   char ftmp[264];
+   ppwchkptc2_(irc);
+   if ((*irc==0) && (kchkid==0)) {
+      sprintf(ftmp,"%s.tmp",fchk);
+      if (rename(ftmp,fchk) != 0)
+         *irc = 3;
+   }
+   ppimax_(irc,jrc,&one);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cpprchkpth2(char *fname, int nis, int isc[], int nfs, float fsc[],
+                 int *nvpo, int *irc) {
+   pprchkpth2_(fname,&nis,isc,&nfs,fsc,nvpo,irc,strlen(fname));
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cpprchkpta2(int n, float f[], int nrow, int nrp, int noffr,
+                 int nrows, int *irc) {
+/* arrays in the checkpoint file are numbered from 0 in C, 1 in Fortran */
+   int n1;
+   n1 = n + 1;
+   pprchkpta2_(&n1,f,&nrow,&nrp,&noffr,&nrows,irc);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cpprchkptp2(int n, float part[], float edges[], int *npp,
+                 int idimp, int npmax, int *irc) {
+   int n1;
+   n1 = n + 1;
+   pprchkptp2_(&n1,part,edges,npp,&idimp,&npmax,irc);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cpprchkptc2() {
+   pprchkptc2_();
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppshminit2(float **sbufr, float **sbufl, int **nclr, int **ncll,
+                 int *nshm, int kstrt, int nvp, int nxv, int ndim,
+                 int kxp, int kyp, int idimp, int nbmax, int mxyp1) {
+/* the Fortran library has no MPI-3 shared memory windows, so the */
+/* particle buffers are allocated normally and all messages are sent */
+   *sbufl = (float *) malloc(idimp*nbmax*sizeof(float));
+   *sbufr = (float *) malloc(idimp*nbmax*sizeof(float));
+   *ncll = (int *) malloc(3*mxyp1*sizeof(int));
+   *nclr = (int *) malloc(3*mxyp1*sizeof(int));
+   *nshm = 1;
+   return;
+}
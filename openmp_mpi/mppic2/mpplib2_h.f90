@@ -70,6 +70,21 @@
          real, dimension(nxv,nypmx), intent(inout) :: f
          end subroutine
       end interface
+!
+      interface
+         subroutine PPINCGUARD2L(f,nyp,kstrt,nvp,nxv,nypmx)
+         implicit none
+         integer, intent(in) :: nyp, kstrt, nvp, nxv, nypmx
+         real, dimension(nxv,nypmx), intent(inout) :: f
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPWNCGUARD2L(nvp)
+         implicit none
+         integer, intent(in) :: nvp
+         end subroutine
+      end interface
 !
       interface
          subroutine PPNAGUARD2L(f,scr,nyp,nx,kstrt,nvp,nxv,nypmx)
@@ -112,6 +127,30 @@
          complex, dimension(ndim,kxp*kyp), intent(inout) :: s, t
          end subroutine
       end interface
+!
+      interface
+         subroutine PPTPOSENB(f,g,s,t,nx,ny,kxp,kyp,kstrt,nvp,nxv,nyv,  &
+     &kxpd,kypd)
+         implicit none
+         integer, intent(in) :: nx, ny, kxp, kyp, kstrt, nvp, nxv, nyv
+         integer, intent(in) :: kxpd, kypd
+         real, dimension(2*nxv,kypd), intent(in) :: f
+         complex, dimension(nyv,kxpd), intent(inout) :: g
+         complex, dimension(kxp*kyp,nvp), intent(inout) :: s, t
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPNTPOSENB(f,g,s,t,nx,ny,kxp,kyp,kstrt,nvp,ndim,nxv,&
+     &nyv,kxpd,kypd)
+         implicit none
+         integer, intent(in) :: nx, ny, kxp, kyp, kstrt, nvp, ndim
+         integer, intent(in) :: nxv, nyv, kxpd, kypd
+         real, dimension(ndim,2*nxv,kypd), intent(in) :: f
+         complex, dimension(ndim,nyv,kxpd), intent(inout) :: g
+         complex, dimension(ndim,kxp*kyp,nvp), intent(inout) :: s, t
+         end subroutine
+      end interface
 !
       interface
          subroutine PPPMOVE2(sbufr,sbufl,rbufr,rbufl,ncll,nclr,mcll,mclr&
@@ -124,6 +163,96 @@
          integer, dimension(3,mx1), intent(inout) :: mcll, mclr
          end subroutine
       end interface
+!
+      interface
+         subroutine PPIPMOVE2(sbufr,sbufl,rbufr,rbufl,ncll,nclr,mcll,   &
+     &mclr,kstrt,nvp,idimp,nbmax,mx1)
+         implicit none
+         integer, intent(in) :: kstrt, nvp, idimp, nbmax, mx1
+         real, dimension(idimp,nbmax), intent(in) :: sbufr, sbufl
+         real, dimension(idimp,nbmax), intent(inout) :: rbufr, rbufl
+         integer, dimension(3,mx1), intent(in) :: ncll, nclr
+         integer, dimension(3,mx1), intent(inout) :: mcll, mclr
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPWPMOVE2(nvp)
+         implicit none
+         integer, intent(in) :: nvp
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPWCHKPTH2(fname,nis,isc,nfs,fsc,irc)
+         implicit none
+         integer, intent(in) :: nis, nfs
+         integer, intent(inout) :: irc
+         character(len=*), intent(in) :: fname
+         integer, dimension(nis), intent(in) :: isc
+         real, dimension(nfs), intent(in) :: fsc
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPWCHKPTA2(f,nrow,nrp,noffr,nrows)
+         implicit none
+         integer, intent(in) :: nrow, nrp, noffr, nrows
+         real, dimension(nrow,nrp), intent(in) :: f
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPWCHKPTP2(part,edges,npp,idimp,npmax)
+         implicit none
+         integer, intent(in) :: npp, idimp, npmax
+         real, dimension(idimp,npmax), intent(in) :: part
+         real, dimension(2), intent(in) :: edges
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPWCHKPTC2(irc)
+         implicit none
+         integer, intent(inout) :: irc
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPRCHKPTH2(fname,nis,isc,nfs,fsc,nvpo,irc)
+         implicit none
+         integer, intent(in) :: nis, nfs
+         integer, intent(inout) :: nvpo, irc
+         character(len=*), intent(in) :: fname
+         integer, dimension(nis), intent(inout) :: isc
+         real, dimension(nfs), intent(inout) :: fsc
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPRCHKPTA2(n,f,nrow,nrp,noffr,nrows,irc)
+         implicit none
+         integer, intent(in) :: n, nrow, nrp, noffr, nrows
+         integer, intent(inout) :: irc
+         real, dimension(nrow,nrp), intent(inout) :: f
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPRCHKPTP2(n,part,edges,npp,idimp,npmax,irc)
+         implicit none
+         integer, intent(in) :: n, idimp, npmax
+         integer, intent(inout) :: npp, irc
+         real, dimension(idimp,npmax), intent(inout) :: part
+         real, dimension(2), intent(in) :: edges
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPRCHKPTC2()
+         implicit none
+         end subroutine
+      end interface
 !
       end module
 
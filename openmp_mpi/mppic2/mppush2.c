@@ -623,6 +623,29 @@ void cppgppushf2l(float ppart[], float fxy[], int kpic[], int ncl[],
    ntmax = size of hole array for particles leaving tiles
    irc = maximum overflow, returned only if error occurs, when irc > 0
    optimized version
+local data                                                            */
+   cppgppushf2lr(ppart,fxy,kpic,ncl,ihole,noff,nyp,qbm,dt,ek,nx,ny,mx,my,
+                 idimp,nppmx,nxv,nypmx,mx1,mxyp1,ntmax,1,mxyp1/mx1,irc);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppgppushf2lr(float ppart[], float fxy[], int kpic[], int ncl[],
+                   int ihole[], int noff, int nyp, float qbm, float dt,
+                   float *ek, int nx, int ny, int mx, int my, int idimp,
+                   int nppmx, int nxv, int nypmx, int mx1, int mxyp1,
+                   int ntmax, int kyl, int kyh, int *irc) {
+/* for 2d code, this subroutine updates particle co-ordinates and
+   velocities using leap-frog scheme in time and first-order linear
+   interpolation in space, with periodic boundary conditions
+   also determines list of particles which are leaving this tile
+   same as cppgppushf2l, except only rows of tiles kyl to kyh are pushed.
+   since only the last row of tiles uses the guard cells in y, the other
+   rows can be pushed while the guard cells are being communicated
+   kyl/kyh = first/last row of tiles in y to be pushed, 1 <= kyl,
+   kyh <= myp1, where myp1=(partition length in y direction-1)/my+1
+   other arguments are described in cppgppushf2l
+   ek is accumulated, not initialized
 local data                                                            */
 #define MXV             33
 #define MYV             33
@@ -647,7 +670,7 @@ local data                                                            */
 private(i,j,k,noffp,moffp,nppp,npoff,nn,mm,ih,nh,mnoff,x,y,dxp,dyp, \
 amx,amy,dx,dy,vx,vy,edgelx,edgely,edgerx,edgery,sum1,sfxy) \
 reduction(+:sum2)
-   for (k = 0; k < mxyp1; k++) {
+   for (k = mx1*(kyl-1); k < mx1*kyh; k++) {
       noffp = k/mx1;
       moffp = my*noffp;
       noffp = mx*(k - mx1*noffp);
@@ -1335,6 +1358,27 @@ void cppporder2lb(float ppart[], float ppbuff[], float rbufl[],
    ntmax = size of hole array for particles leaving tiles
    nbmax =  size of buffers for passing particles between processors
    irc = maximum overflow, returned only if error occurs, when irc > 0
+local data                                                            */
+   cppporder2lbr(ppart,ppbuff,rbufl,rbufr,kpic,ncl,ihole,mcll,mclr,idimp,
+                 nppmx,mx1,myp1,npbmx,ntmax,nbmax,1,myp1,irc);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppporder2lbr(float ppart[], float ppbuff[], float rbufl[],
+                   float rbufr[], int kpic[], int ncl[], int ihole[],
+                   int mcll[], int mclr[], int idimp, int nppmx,
+                   int mx1, int myp1, int npbmx, int ntmax, int nbmax,
+                   int kyl, int kyh, int *irc) {
+/* this subroutine performs second part of a particle sort by x,y grid
+   in tiles of mx, my
+   same as cppporder2lb, except only rows of tiles kyl to kyh are filled.
+   since only the first and last rows of tiles use rbufl and rbufr, the
+   other rows can be filled while the particles from other processors
+   are being communicated
+   kyl/kyh = first/last row of tiles in y to be filled,
+   1 <= kyl, kyh <= myp1
+   other arguments are described in cppporder2lb
 local data                                                            */
    int mxyp1, nppp, ncoff, noff, moff;
    int i, j, k, ii, kx, ky, ih, nh, ist;
@@ -1346,7 +1390,7 @@ local data                                                            */
 #pragma omp parallel for \
 private(i,j,k,ii,kk,nppp,kx,ky,kl,kr,kxl,kxr,ih,nh,ncoff,noff,moff, \
 ist,j1,j2,ip,ks)
-   for (k = 0; k < mxyp1; k++) {
+   for (k = mx1*(kyl-1); k < mx1*kyh; k++) {
       nppp = kpic[k];
       ky = k/mx1;
 /* loop over tiles in y */
@@ -1465,6 +1509,181 @@ ist,j1,j2,ip,ks)
    return;
 }
 
+/*--------------------------------------------------------------------*/
+static int cpppenc2(float x, float y, int ixo, int iyo, int nx, int ny,
+                    int mx, int my, int sx, int sy) {
+/* this function encodes particle position x, y as 16 bit fixed point
+   offsets from grid point ixo, iyo, with sx, sy steps per grid cell,
+   assuming periodic boundary conditions
+local data                                                            */
+   int ic, ix, iy;
+/* find x offset in cells, then in steps */
+   ic = (int) x;
+   ix = ic - ixo;
+   if (ix >= 3*mx)
+      ix -= nx;
+   else if (ix < 0)
+      ix += nx;
+   ix = sx*ix + (int) (((float) sx)*(x - (float) ic));
+   ix = ix < 0 ? 0 : ix;
+   ix = ix < 3*mx*sx ? ix : 3*mx*sx - 1;
+/* find y offset in cells, then in steps */
+   ic = (int) y;
+   iy = ic - iyo;
+   if (iy >= my)
+      iy -= ny;
+   else if (iy < 0)
+      iy += ny;
+   iy = sy*iy + (int) (((float) sy)*(y - (float) ic));
+   iy = iy < 0 ? 0 : iy;
+   iy = iy < my*sy ? iy : my*sy - 1;
+   return ix + 65536*iy;
+}
+
+/*--------------------------------------------------------------------*/
+static void cpppdec2(int n, float *x, float *y, int ixo, int iyo,
+                     int nx, int sx, int sy) {
+/* this subroutine decodes particle position x, y from 16 bit fixed
+   point offsets from grid point ixo, iyo, encoded by cpppenc2.
+   the position is placed in the middle of its step
+local data                                                            */
+   int ic, ix, iy;
+   ix = n - 65536*(n/65536);
+   iy = n/65536;
+   ic = ix/sx + ixo;
+   if (ic < 0)
+      ic += nx;
+   else if (ic >= nx)
+      ic -= nx;
+   *x = (float) ic + ((float) (ix - sx*(ix/sx)) + 0.5)/(float) sx;
+   *y = (float) (iy/sy + iyo) + ((float) (iy - sy*(iy/sy)) + 0.5)
+      /(float) sy;
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppppack2l(float sbufl[], float sbufr[], float psbufl[],
+                float psbufr[], int ncll[], int nclr[], float edges[],
+                int idimp, int nx, int ny, int mx, int my, int mx1) {
+/* this subroutine compresses particles leaving the processor, which
+   were buffered in sbufl and sbufr by cppporderf2la, so that cpppmove2
+   sends idimp-1 instead of idimp words per particle.
+   the first word holds the position as 16 bit fixed point offsets:
+   x from one tile to the left of the sending tile, and y from the edge
+   of the receiving partition, one tile below for sbufl.  each grid
+   cell is divided into a power of two steps, so that the position
+   stays in the same grid cell and tile.  y uses at most 15 bits, so
+   that the word is never a NaN.  the velocities are copied unchanged.
+   the positions are restored by cpppunpack2l
+   input: all except psbufl, psbufr
+   output: psbufl, psbufr
+   sbufl/sbufr = buffer for particles being sent to lower/upper
+   processor
+   psbufl/psbufr = compressed particles, idimp-1 words each
+   ncll/nclr = number offset being sent to lower/upper processor
+   edges[0:1] = lower:upper boundary of particle partition
+   idimp = size of phase space = 4
+   nx/ny = system length in x/y direction
+   mx/my = number of grids in sorting cell in x/y,
+   3*mx <= 65536 and my <= 32640
+   mx1 = (system length in x direction - 1)/mx + 1
+local data                                                            */
+   int i, j, k, jl, nw, sx, sy, iyl, iyr;
+   union {float f; int n;} pw;
+   nw = idimp - 1;
+/* find largest power of two steps per grid cell which fit */
+   sx = 1;
+   while (6*mx*sx <= 65536)
+      sx += sx;
+   sy = 1;
+   while (2*my*sy <= 32640)
+      sy += sy;
+   iyl = (int) edges[0] - my;
+   iyr = (int) edges[1];
+/* loop over tiles in x, particles are stored in tile order */
+#pragma omp parallel for private(i,j,k,jl,pw)
+   for (k = 0; k < mx1; k++) {
+/* particles going to lower processor */
+      jl = k > 0 ? ncll[3*k-1] : 0;
+      for (j = jl; j < ncll[3*k+2]; j++) {
+         pw.n = cpppenc2(sbufl[idimp*j],sbufl[1+idimp*j],mx*(k-1),iyl,
+                         nx,ny,mx,my,sx,sy);
+         psbufl[nw*j] = pw.f;
+         for (i = 2; i < idimp; i++) {
+            psbufl[i-1+nw*j] = sbufl[i+idimp*j];
+         }
+      }
+/* particles going to upper processor */
+      jl = k > 0 ? nclr[3*k-1] : 0;
+      for (j = jl; j < nclr[3*k+2]; j++) {
+         pw.n = cpppenc2(sbufr[idimp*j],sbufr[1+idimp*j],mx*(k-1),iyr,
+                         nx,ny,mx,my,sx,sy);
+         psbufr[nw*j] = pw.f;
+         for (i = 2; i < idimp; i++) {
+            psbufr[i-1+nw*j] = sbufr[i+idimp*j];
+         }
+      }
+   }
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cpppunpack2l(float prbufl[], float prbufr[], float rbufl[],
+                  float rbufr[], int mcll[], int mclr[], float edges[],
+                  int idimp, int nx, int ny, int mx, int my, int mx1) {
+/* this subroutine restores particles compressed by cppppack2l and
+   received by cpppmove2 in prbufl and prbufr, for use by cppporder2lb
+   input: all except rbufl, rbufr
+   output: rbufl, rbufr
+   prbufl/prbufr = compressed particles received from lower/upper
+   processor, idimp-1 words each
+   rbufl/rbufr = buffer for particles being received from lower/upper
+   processor
+   mcll/mclr = number offset being received from lower/upper processor
+   edges[0:1] = lower:upper boundary of particle partition
+   idimp = size of phase space = 4
+   nx/ny = system length in x/y direction
+   mx/my = number of grids in sorting cell in x/y
+   mx1 = (system length in x direction - 1)/mx + 1
+local data                                                            */
+   int i, j, k, jl, nw, sx, sy, iyl, iyr;
+   union {float f; int n;} pw;
+   nw = idimp - 1;
+   sx = 1;
+   while (6*mx*sx <= 65536)
+      sx += sx;
+   sy = 1;
+   while (2*my*sy <= 32640)
+      sy += sy;
+   iyl = (int) edges[0];
+   iyr = (int) edges[1] - my;
+/* loop over tiles in x of sending processor */
+#pragma omp parallel for private(i,j,k,jl,pw)
+   for (k = 0; k < mx1; k++) {
+/* particles coming from lower processor */
+      jl = k > 0 ? mcll[3*k-1] : 0;
+      for (j = jl; j < mcll[3*k+2]; j++) {
+         pw.f = prbufl[nw*j];
+         cpppdec2(pw.n,&rbufl[idimp*j],&rbufl[1+idimp*j],mx*(k-1),iyl,
+                  nx,sx,sy);
+         for (i = 2; i < idimp; i++) {
+            rbufl[i+idimp*j] = prbufl[i-1+nw*j];
+         }
+      }
+/* particles coming from upper processor */
+      jl = k > 0 ? mclr[3*k-1] : 0;
+      for (j = jl; j < mclr[3*k+2]; j++) {
+         pw.f = prbufr[nw*j];
+         cpppdec2(pw.n,&rbufr[idimp*j],&rbufr[1+idimp*j],mx*(k-1),iyr,
+                  nx,sx,sy);
+         for (i = 2; i < idimp; i++) {
+            rbufr[i+idimp*j] = prbufr[i-1+nw*j];
+         }
+      }
+   }
+   return;
+}
+
 /*--------------------------------------------------------------------*/
 void cppcguard2xl(float fxy[], int nyp, int nx, int ndim, int nxe,
                   int nypmx) {
@@ -2390,12 +2609,13 @@ private(i,j,k,m,ns,ns2,km,kmr,k1,k2,j1,j2,koff,s,t1,t2)
 /*--------------------------------------------------------------------*/
 void cwppfft2rm(float complex f[], float complex g[],
                 float complex bs[], float complex br[], int isign,
-                int ntpose, int mixup[], float complex sct[],
-                float *ttp, int indx, int indy, int kstrt, int nvp,
-                int nxvh, int nyv, int kxp, int kyp, int kypd,
-                int nxhyd, int nxyhd) {
+                int ntpose, int ltpose, int mixup[],
+                float complex sct[], float *ttp, int indx, int indy,
+                int kstrt, int nvp, int nxvh, int nyv, int kxp,
+                int kyp, int kypd, int nxhyd, int nxyhd) {
 /* wrapper function for parallel real to complex fft */
 /* parallelized with OpenMP */
+/* ltpose = (0,1) = (no,yes) use non-blocking transpose */
 /* local data */
    int nxh, ny, ks, kxpp, kypp;
    static int kxpi = 1, kypi = 1;
@@ -2418,7 +2638,11 @@ void cwppfft2rm(float complex f[], float complex g[],
                  nxhyd,nxyhd);
 /* transpose f array to g */
       cpwtimera(-1,ttp,&dtime);
-      cpptpose(f,g,bs,br,nxh,ny,kxp,kyp,kstrt,nvp,nxvh,nyv,kxp,kypd);
+      if (ltpose==1)
+         cpptposenb(f,g,bs,br,nxh,ny,kxp,kyp,kstrt,nvp,nxvh,nyv,kxp,
+                    kypd);
+      else
+         cpptpose(f,g,bs,br,nxh,ny,kxp,kyp,kstrt,nvp,nxvh,nyv,kxp,kypd);
       cpwtimera(1,ttp,&dtime);
 /* perform y fft */
       cppfft2rmxy(g,isign,mixup,sct,indx,indy,kstrt,kxpi,kxpp,nyv,kxp,
@@ -2426,7 +2650,12 @@ void cwppfft2rm(float complex f[], float complex g[],
 /* transpose g array to f */
       if (ntpose==0) {
          cpwtimera(-1,&tf,&dtime);
-         cpptpose(g,f,br,bs,ny,nxh,kyp,kxp,kstrt,nvp,nyv,nxvh,kypd,kxp);
+         if (ltpose==1)
+            cpptposenb(g,f,br,bs,ny,nxh,kyp,kxp,kstrt,nvp,nyv,nxvh,kypd,
+                       kxp);
+         else
+            cpptpose(g,f,br,bs,ny,nxh,kyp,kxp,kstrt,nvp,nyv,nxvh,kypd,
+                     kxp);
          cpwtimera(1,&tf,&dtime);
       }
    }
@@ -2435,7 +2664,12 @@ void cwppfft2rm(float complex f[], float complex g[],
 /* transpose f array to g */
       if (ntpose==0) {
          cpwtimera(-1,&tf,&dtime);
-         cpptpose(f,g,bs,br,nxh,ny,kxp,kyp,kstrt,nvp,nxvh,nyv,kxp,kypd);
+         if (ltpose==1)
+            cpptposenb(f,g,bs,br,nxh,ny,kxp,kyp,kstrt,nvp,nxvh,nyv,kxp,
+                       kypd);
+         else
+            cpptpose(f,g,bs,br,nxh,ny,kxp,kyp,kstrt,nvp,nxvh,nyv,kxp,
+                     kypd);
          cpwtimera(1,&tf,&dtime);
       }
 /* perform y fft */
@@ -2443,7 +2677,11 @@ void cwppfft2rm(float complex f[], float complex g[],
                  nxhyd,nxyhd);
 /* transpose g array to f */
       cpwtimera(-1,ttp,&dtime);
-      cpptpose(g,f,br,bs,ny,nxh,kyp,kxp,kstrt,nvp,nyv,nxvh,kypd,kxp);
+      if (ltpose==1)
+         cpptposenb(g,f,br,bs,ny,nxh,kyp,kxp,kstrt,nvp,nyv,nxvh,kypd,
+                    kxp);
+      else
+         cpptpose(g,f,br,bs,ny,nxh,kyp,kxp,kstrt,nvp,nyv,nxvh,kypd,kxp);
       cpwtimera(1,ttp,&dtime);
 /* perform x fft */
       cppfft2rmxx(f,isign,mixup,sct,indx,indy,kstrt,kypi,kypp,nxvh,kypd,
@@ -2457,12 +2695,13 @@ void cwppfft2rm(float complex f[], float complex g[],
 /*--------------------------------------------------------------------*/
 void cwppfft2rm2(float complex f[], float complex g[],
                  float complex bs[], float complex br[], int isign,
-                 int ntpose, int mixup[], float complex sct[],
-                 float *ttp, int indx, int indy, int kstrt, int nvp,
-                 int nxvh, int nyv, int kxp, int kyp, int kypd,
-                 int nxhyd, int nxyhd) {
+                 int ntpose, int ltpose, int mixup[],
+                 float complex sct[], float *ttp, int indx, int indy,
+                 int kstrt, int nvp, int nxvh, int nyv, int kxp,
+                 int kyp, int kypd, int nxhyd, int nxyhd) {
 /* wrapper function for parallel real to complex fft */
 /* parallelized with OpenMP */
+/* ltpose = (0,1) = (no,yes) use non-blocking transpose */
 /* local data */
    int nxh, ny, ks, kxpp, kypp;
    static int kxpi = 1, kypi = 1;
@@ -2485,7 +2724,12 @@ void cwppfft2rm2(float complex f[], float complex g[],
                    kypd,nxhyd,nxyhd);
 /* transpose f array to g */
       cpwtimera(-1,ttp,&dtime);
-      cppntpose(f,g,bs,br,nxh,ny,kxp,kyp,kstrt,nvp,2,nxvh,nyv,kxp,kypd);
+      if (ltpose==1)
+         cppntposenb(f,g,bs,br,nxh,ny,kxp,kyp,kstrt,nvp,2,nxvh,nyv,kxp,
+                     kypd);
+      else
+         cppntpose(f,g,bs,br,nxh,ny,kxp,kyp,kstrt,nvp,2,nxvh,nyv,kxp,
+                   kypd);
       cpwtimera(1,ttp,&dtime);
 /* perform y fft */
       cppfft2rm2xy(g,isign,mixup,sct,indx,indy,kstrt,kxpi,kxpp,nyv,kxp,
@@ -2493,8 +2737,12 @@ void cwppfft2rm2(float complex f[], float complex g[],
 /* transpose g array to f */
       if (ntpose==0) {
          cpwtimera(-1,&tf,&dtime);
-         cppntpose(g,f,br,bs,ny,nxh,kyp,kxp,kstrt,nvp,2,nyv,nxvh,kypd,
-                   kxp);
+         if (ltpose==1)
+            cppntposenb(g,f,br,bs,ny,nxh,kyp,kxp,kstrt,nvp,2,nyv,nxvh,
+                        kypd,kxp);
+         else
+            cppntpose(g,f,br,bs,ny,nxh,kyp,kxp,kstrt,nvp,2,nyv,nxvh,
+                      kypd,kxp);
          cpwtimera(1,&tf,&dtime);
       }
    }
@@ -2503,8 +2751,12 @@ void cwppfft2rm2(float complex f[], float complex g[],
 /* transpose f array to g */
       if (ntpose==0) {
          cpwtimera(-1,&tf,&dtime);
-         cppntpose(f,g,bs,br,nxh,ny,kxp,kyp,kstrt,nvp,2,nxvh,nyv,kxp,
-                   kypd);
+         if (ltpose==1)
+            cppntposenb(f,g,bs,br,nxh,ny,kxp,kyp,kstrt,nvp,2,nxvh,nyv,
+                        kxp,kypd);
+         else
+            cppntpose(f,g,bs,br,nxh,ny,kxp,kyp,kstrt,nvp,2,nxvh,nyv,kxp,
+                      kypd);
          cpwtimera(1,&tf,&dtime);
       }
 /* perform y fft */
@@ -2512,7 +2764,12 @@ void cwppfft2rm2(float complex f[], float complex g[],
                   nxhyd,nxyhd);
 /* transpose g array to f */
       cpwtimera(-1,ttp,&dtime);
-      cppntpose(g,f,br,bs,ny,nxh,kyp,kxp,kstrt,nvp,2,nyv,nxvh,kypd,kxp);
+      if (ltpose==1)
+         cppntposenb(g,f,br,bs,ny,nxh,kyp,kxp,kstrt,nvp,2,nyv,nxvh,kypd,
+                     kxp);
+      else
+         cppntpose(g,f,br,bs,ny,nxh,kyp,kxp,kstrt,nvp,2,nyv,nxvh,kypd,
+                   kxp);
       cpwtimera(1,ttp,&dtime);
 /* perform x fft */
       cppfft2rm2xx(f,isign,mixup,sct,indx,indy,kstrt,kypi,kypp,nxvh,
@@ -2565,6 +2822,122 @@ local data                                                            */
    return;
 }
 
+/*--------------------------------------------------------------------*/
+void cppvdist2(float ppart[], int kpic[], float fvv[], float fxv[],
+               float vmx, int nx, int nmv, int nxb, int idimp,
+               int nppmx, int mxyp1, int *irc) {
+/* for 2d code, this subroutine calculates the velocity distribution
+   f(vx,vy) and the phase space distribution f(x,vx) of the particles
+   in the partition, by counting particles in bins
+   OpenMP version, each thread counts the particles in its tiles in a
+   private histogram, which are then added together.
+   bin numbers for a block of npblk particles are calculated first in
+   a loop that can be vectorized, then the particles are counted.
+   particles with |vx| or |vy| >= vmx are not counted.
+   input: all except fvv, fxv, irc, output: fvv, fxv, irc
+   ppart[m][n][0] = position x of particle n in tile m
+   ppart[m][n][2] = velocity vx of particle n in tile m
+   ppart[m][n][3] = velocity vy of particle n in tile m
+   kpic = number of particles per tile
+   fvv[j][i] = number of particles with vx in bin i, vy in bin j
+   fxv[j][i] = number of particles with x in bin i, vx in bin j
+   velocity bin i covers -vmx + (2*vmx/nmv)*(i,i+1)
+   position bin i covers (nx/nxb)*(i,i+1)
+   vmx = maximum velocity counted
+   nx = system length in x direction
+   nmv = number of velocity bins in each direction
+   nxb = number of position bins in x direction
+   idimp = size of phase space = 4
+   nppmx = maximum number of particles in tile
+   mxyp1 = total number of tiles in partition
+   irc = error code, returned only if error occurs, when irc > 0
+   the distributions must be summed over processors with cppsum
+local data                                                            */
+#define NPBLK             32
+   int j, k, m, nn, npoff, nppp, joff, nhv, nhx, ix, iv, iw, ierr;
+   int *ifv;
+   int nvv[NPBLK], nxv[NPBLK];
+   float dv, dxb, ax, avx, avy, anmv;
+   nhv = nmv*nmv;
+   nhx = nxb*nmv;
+   dv = ((float) nmv)/(vmx + vmx);
+   dxb = ((float) nxb)/((float) nx);
+   anmv = (float) nmv;
+   for (j = 0; j < nhv; j++) {
+      fvv[j] = 0.0f;
+   }
+   for (j = 0; j < nhx; j++) {
+      fxv[j] = 0.0f;
+   }
+   ierr = 0;
+#pragma omp parallel \
+private(j,k,m,nn,npoff,nppp,joff,ix,iv,iw,ax,avx,avy,ifv,nvv,nxv)
+   {
+/* private histogram for this thread */
+      ifv = (int *) calloc(nhv+nhx,sizeof(int));
+/* loop over tiles */
+#pragma omp for
+      for (k = 0; k < mxyp1; k++) {
+         if (ifv==NULL)
+            continue;
+         nppp = kpic[k];
+         npoff = idimp*nppmx*k;
+/* loop over blocks of particles in tile */
+         for (joff = 0; joff < nppp; joff += NPBLK) {
+            nn = nppp - joff;
+            nn = nn < NPBLK ? nn : NPBLK;
+/* calculate bin numbers, -1 if outside range */
+            for (j = 0; j < nn; j++) {
+               m = idimp*(j + joff) + npoff;
+               ax = dxb*ppart[m];
+               avx = dv*(ppart[m+2] + vmx);
+               avy = dv*(ppart[m+3] + vmx);
+/* clamp to avoid overflow in conversion to integer */
+               avx = avx > -1.0f ? avx : -1.0f;
+               avx = avx < anmv ? avx : anmv;
+               avy = avy > -1.0f ? avy : -1.0f;
+               avy = avy < anmv ? avy : anmv;
+               ix = ax;
+               iv = avx;
+               iw = avy;
+               iv = ((avx >= 0.0f) && (iv < nmv)) ? iv : -1;
+               iw = ((avy >= 0.0f) && (iw < nmv)) ? iw : -1;
+               ix = ((ax >= 0.0f) && (ix < nxb)) ? ix : -1;
+               nvv[j] = ((iv >= 0) && (iw >= 0)) ? iv + nmv*iw : -1;
+               nxv[j] = ((ix >= 0) && (iv >= 0)) ? ix + nxb*iv : -1;
+            }
+/* count particles */
+            for (j = 0; j < nn; j++) {
+               if (nvv[j] >= 0)
+                  ifv[nvv[j]] += 1;
+               if (nxv[j] >= 0)
+                  ifv[nhv+nxv[j]] += 1;
+            }
+         }
+      }
+/* add private histograms */
+#pragma omp critical
+      {
+         if (ifv != NULL) {
+            for (j = 0; j < nhv; j++) {
+               fvv[j] += (float) ifv[j];
+            }
+            for (j = 0; j < nhx; j++) {
+               fxv[j] += (float) ifv[j+nhv];
+            }
+         }
+         else {
+            ierr = 1;
+         }
+      }
+      free(ifv);
+   }
+   if (ierr > 0)
+      *irc = ierr;
+   return;
+#undef NPBLK
+}
+
 /* Interfaces to Fortran */
 
 /*--------------------------------------------------------------------*/
@@ -2635,6 +3008,19 @@ void cppgppushf2l_(float *ppart, float *fxy, int *kpic, int *ncl,
    return;
 }
 
+/*--------------------------------------------------------------------*/
+void cppgppushf2lr_(float *ppart, float *fxy, int *kpic, int *ncl,
+                    int *ihole, int *noff, int *nyp, float *qbm,
+                    float *dt, float *ek, int *nx, int *ny, int *mx,
+                    int *my, int *idimp, int *nppmx, int *nxv,
+                    int *nypmx, int *mx1, int *mxyp1, int *ntmax,
+                    int *kyl, int *kyh, int *irc) {
+   cppgppushf2lr(ppart,fxy,kpic,ncl,ihole,*noff,*nyp,*qbm,*dt,ek,*nx,
+                 *ny,*mx,*my,*idimp,*nppmx,*nxv,*nypmx,*mx1,*mxyp1,
+                 *ntmax,*kyl,*kyh,irc);
+   return;
+}
+
 /*--------------------------------------------------------------------*/
 void cppgppost2l_(float *ppart, float *q, int *kpic, int *noff,
                   float *qm, int *idimp, int *nppmx, int *mx, int *my,
@@ -2679,6 +3065,38 @@ void cppporder2lb_(float *ppart, float *ppbuff, float *rbufl,
    return;
 }
 
+/*--------------------------------------------------------------------*/
+void cppporder2lbr_(float *ppart, float *ppbuff, float *rbufl,
+                    float *rbufr, int *kpic, int *ncl, int *ihole,
+                    int *mcll, int *mclr, int *idimp, int *nppmx,
+                    int *mx1, int *myp1, int *npbmx, int *ntmax,
+                    int *nbmax, int *kyl, int *kyh, int *irc) {
+   cppporder2lbr(ppart,ppbuff,rbufl,rbufr,kpic,ncl,ihole,mcll,mclr,
+                 *idimp,*nppmx,*mx1,*myp1,*npbmx,*ntmax,*nbmax,*kyl,
+                 *kyh,irc);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppppack2l_(float *sbufl, float *sbufr, float *psbufl,
+                 float *psbufr, int *ncll, int *nclr, float *edges,
+                 int *idimp, int *nx, int *ny, int *mx, int *my,
+                 int *mx1) {
+   cppppack2l(sbufl,sbufr,psbufl,psbufr,ncll,nclr,edges,*idimp,*nx,*ny,
+              *mx,*my,*mx1);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cpppunpack2l_(float *prbufl, float *prbufr, float *rbufl,
+                   float *rbufr, int *mcll, int *mclr, float *edges,
+                   int *idimp, int *nx, int *ny, int *mx, int *my,
+                   int *mx1) {
+   cpppunpack2l(prbufl,prbufr,rbufl,rbufr,mcll,mclr,edges,*idimp,*nx,
+                *ny,*mx,*my,*mx1);
+   return;
+}
+
 /*--------------------------------------------------------------------*/
 void cppcguard2xl_(float *fxy, int *nyp, int *nx, int *ndim, int *nxe,
                    int *nypmx) {
@@ -2751,23 +3169,34 @@ void cppfft2rm2xy_(float complex *g, int *isign, int *mixup,
 
 /*--------------------------------------------------------------------*/
 void cwppfft2rm_(float complex *f, float complex *g, float complex *bs,
-                 float complex *br, int *isign, int *ntpose, int *mixup,
-                 float complex *sct, float *ttp, int *indx, int *indy,
-                 int *kstrt, int *nvp, int *nxvh, int *nyv, int *kxp,
-                 int *kyp, int *kypd, int *nxhyd, int *nxyhd) {
-   cwppfft2rm(f,g,bs,br,*isign,*ntpose,mixup,sct,ttp,*indx,*indy,*kstrt,
-              *nvp,*nxvh,*nyv,*kxp,*kyp,*kypd,*nxhyd,*nxyhd);
+                 float complex *br, int *isign, int *ntpose, int *ltpose,
+                 int *mixup, float complex *sct, float *ttp, int *indx,
+                 int *indy, int *kstrt, int *nvp, int *nxvh, int *nyv,
+                 int *kxp, int *kyp, int *kypd, int *nxhyd, int *nxyhd) {
+   cwppfft2rm(f,g,bs,br,*isign,*ntpose,*ltpose,mixup,sct,ttp,*indx,
+              *indy,*kstrt,*nvp,*nxvh,*nyv,*kxp,*kyp,*kypd,*nxhyd,
+              *nxyhd);
    return;
 }
 
 /*--------------------------------------------------------------------*/
 void cwppfft2rm2_(float complex *f, float complex *g, float complex *bs,
                   float complex *br, int *isign, int *ntpose,
-                  int *mixup, float complex *sct, float *ttp, int *indx,
-                  int *indy, int *kstrt, int *nvp, int *nxvh, int *nyv,
-                  int *kxp, int *kyp, int *kypd, int *nxhyd,
-                  int *nxyhd) {
-   cwppfft2rm2(f,g,bs,br,*isign,*ntpose,mixup,sct,ttp,*indx,*indy,
-               *kstrt,*nvp,*nxvh,*nyv,*kxp,*kyp,*kypd,*nxhyd,*nxyhd);
+                  int *ltpose, int *mixup, float complex *sct,
+                  float *ttp, int *indx, int *indy, int *kstrt,
+                  int *nvp, int *nxvh, int *nyv, int *kxp, int *kyp,
+                  int *kypd, int *nxhyd, int *nxyhd) {
+   cwppfft2rm2(f,g,bs,br,*isign,*ntpose,*ltpose,mixup,sct,ttp,*indx,
+               *indy,*kstrt,*nvp,*nxvh,*nyv,*kxp,*kyp,*kypd,*nxhyd,
+               *nxyhd);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppvdist2_(float *ppart, int *kpic, float *fvv, float *fxv,
+                float *vmx, int *nx, int *nmv, int *nxb, int *idimp,
+                int *nppmx, int *mxyp1, int *irc) {
+   cppvdist2(ppart,kpic,fvv,fxv,*vmx,*nx,*nmv,*nxb,*idimp,*nppmx,
+             *mxyp1,irc);
    return;
 }
@@ -559,6 +559,33 @@ c optimized version
       dimension ppart(idimp,nppmx,mxyp1), fxy(2,nxv,nypmx)
       dimension kpic(mxyp1), ncl(8,mxyp1)
       dimension ihole(2,ntmax+1,mxyp1)
+      call PPGPPUSHF2LR(ppart,fxy,kpic,ncl,ihole,noff,nyp,qbm,dt,ek,nx,
+     1ny,mx,my,idimp,nppmx,nxv,nypmx,mx1,mxyp1,ntmax,1,mxyp1/mx1,irc)
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPGPPUSHF2LR(ppart,fxy,kpic,ncl,ihole,noff,nyp,qbm,dt,
+     1ek,nx,ny,mx,my,idimp,nppmx,nxv,nypmx,mx1,mxyp1,ntmax,kyl,kyh,irc)
+c for 2d code, this subroutine updates particle co-ordinates and
+c velocities using leap-frog scheme in time and first-order linear
+c interpolation in space, with periodic boundary conditions
+c also determines list of particles which are leaving this tile
+c same as PPGPPUSHF2L, except only rows of tiles kyl to kyh are pushed.
+c since only the last row of tiles uses the guard cells in y, the other
+c rows can be pushed while the guard cells are being communicated
+c kyl/kyh = first/last row of tiles in y to be pushed, 1 <= kyl,
+c kyh <= myp1, where myp1=(partition length in y direction-1)/my+1
+c other arguments are described in PPGPPUSHF2L
+c ek is accumulated, not initialized
+      implicit none
+      integer noff, nyp, nx, ny, mx, my, idimp, nppmx, nxv, nypmx
+      integer mx1, mxyp1, ntmax, kyl, kyh, irc
+      real qbm, dt, ek
+      real ppart, fxy
+      integer kpic, ncl, ihole
+      dimension ppart(idimp,nppmx,mxyp1), fxy(2,nxv,nypmx)
+      dimension kpic(mxyp1), ncl(8,mxyp1)
+      dimension ihole(2,ntmax+1,mxyp1)
 c local data
       integer MXV, MYV
       parameter(MXV=33,MYV=33)
@@ -582,7 +609,7 @@ c loop over tiles
 !$OMP& PRIVATE(i,j,k,noffp,moffp,nppp,nn,mm,ih,nh,mnoff,x,y,dxp,dyp,amx,
 !$OMP& amy,dx,dy,vx,vy,edgelx,edgely,edgerx,edgery,sum1,sfxy)
 !$OMP& REDUCTION(+:sum2)
-      do 50 k = 1, mxyp1
+      do 50 k = mx1*(kyl-1)+1, mx1*kyh
       noffp = (k - 1)/mx1
       moffp = my*noffp
       noffp = mx*(k - mx1*noffp - 1)
@@ -1256,6 +1283,33 @@ c irc = maximum overflow, returned only if error occurs, when irc > 0
       dimension kpic(mx1*myp1), ncl(8,mx1*myp1)
       dimension ihole(2,ntmax+1,mx1*myp1)
       dimension mcll(3,mx1), mclr(3,mx1)
+      call PPPORDER2LBR(ppart,ppbuff,rbufl,rbufr,kpic,ncl,ihole,mcll,
+     1mclr,idimp,nppmx,mx1,myp1,npbmx,ntmax,nbmax,1,myp1,irc)
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPPORDER2LBR(ppart,ppbuff,rbufl,rbufr,kpic,ncl,ihole,
+     1mcll,mclr,idimp,nppmx,mx1,myp1,npbmx,ntmax,nbmax,kyl,kyh,irc)
+c this subroutine performs second part of a particle sort by x,y grid
+c in tiles of mx, my
+c same as PPPORDER2LB, except only rows of tiles kyl to kyh are filled.
+c since only the first and last rows of tiles use rbufl and rbufr, the
+c other rows can be filled while the particles from other processors
+c are being communicated
+c kyl/kyh = first/last row of tiles in y to be filled,
+c 1 <= kyl, kyh <= myp1
+c other arguments are described in PPPORDER2LB
+      implicit none
+      integer idimp, nppmx, mx1, myp1, npbmx
+      integer ntmax, nbmax, kyl, kyh, irc
+      real ppart, ppbuff, rbufl, rbufr
+      integer kpic, ncl, ihole, mcll, mclr
+      dimension ppart(idimp,nppmx,mx1*myp1)
+      dimension ppbuff(idimp,npbmx,mx1*myp1)
+      dimension rbufl(idimp,nbmax), rbufr(idimp,nbmax)
+      dimension kpic(mx1*myp1), ncl(8,mx1*myp1)
+      dimension ihole(2,ntmax+1,mx1*myp1)
+      dimension mcll(3,mx1), mclr(3,mx1)
 c local data
       integer mxyp1, nppp, ncoff, noff, moff
       integer i, j, k, ii, kx, ky, ih, nh, ist
@@ -1268,7 +1322,7 @@ c loop over tiles
 !$OMP PARALLEL DO
 !$OMP& PRIVATE(i,j,k,ii,kk,nppp,kx,ky,kl,kr,kxl,kxr,ih,nh,ncoff,noff,
 !$OMP& moff,ist,j1,j2,ip,ks)
-      do 200 k = 1, mxyp1
+      do 200 k = mx1*(kyl-1)+1, mx1*kyh
       nppp = kpic(k)
       ky = (k - 1)/mx1 + 1
 c loop over tiles in y
@@ -1369,6 +1423,200 @@ c move particle only if it is below current hole
 !$OMP END PARALLEL DO
       return
       end
+c-----------------------------------------------------------------------
+      subroutine PPPPACK2L(sbufl,sbufr,psbufl,psbufr,ncll,nclr,edges,
+     1idimp,nx,ny,mx,my,mx1)
+c this subroutine compresses particles leaving the processor, which
+c were buffered in sbufl and sbufr by PPPORDERF2LA, so that PPPMOVE2
+c sends idimp-1 instead of idimp words per particle.
+c the first word holds the position as 16 bit fixed point offsets:
+c x from one tile to the left of the sending tile, and y from the edge
+c of the receiving partition, one tile below for sbufl.  each grid
+c cell is divided into a power of two steps, so that the position
+c stays in the same grid cell and tile.  y uses at most 15 bits, so
+c that the word is never a NaN.  the velocities are copied unchanged.
+c the positions are restored by PPPUNPACK2L
+c input: all except psbufl, psbufr
+c output: psbufl, psbufr
+c sbufl/sbufr = buffer for particles being sent to lower/upper
+c processor
+c psbufl/psbufr = compressed particles, idimp-1 words each
+c ncll/nclr = number offset being sent to lower/upper processor
+c edges(1:2) = lower:upper boundary of particle partition
+c idimp = size of phase space = 4
+c nx/ny = system length in x/y direction
+c mx/my = number of grids in sorting cell in x/y,
+c 3*mx <= 65536 and my <= 32640
+c mx1 = (system length in x direction - 1)/mx + 1
+      implicit none
+      integer idimp, nx, ny, mx, my, mx1
+      real sbufl, sbufr, psbufl, psbufr, edges
+      integer ncll, nclr
+      dimension sbufl(idimp,*), sbufr(idimp,*)
+      dimension psbufl(idimp-1,*), psbufr(idimp-1,*)
+      dimension ncll(3,mx1), nclr(3,mx1), edges(2)
+c local data
+      integer i, j, k, jl, sx, sy, iyl, iyr, ic, ix, iy
+c find largest power of two steps per grid cell which fit
+      sx = 1
+   10 if ((6*mx*sx).le.65536) then
+         sx = sx + sx
+         go to 10
+      endif
+      sy = 1
+   20 if ((2*my*sy).le.32640) then
+         sy = sy + sy
+         go to 20
+      endif
+      iyl = int(edges(1)) - my
+      iyr = int(edges(2))
+c loop over tiles in x, particles are stored in tile order
+!$OMP PARALLEL DO PRIVATE(i,j,k,jl,ic,ix,iy)
+      do 70 k = 1, mx1
+c particles going to lower processor
+      jl = 0
+      if (k.gt.1) jl = ncll(3,k-1)
+      do 40 j = jl+1, ncll(3,k)
+      ic = int(sbufl(1,j))
+      ix = ic - mx*(k - 2)
+      if (ix.ge.(3*mx)) then
+         ix = ix - nx
+      else if (ix.lt.0) then
+         ix = ix + nx
+      endif
+      ix = sx*ix + int(real(sx)*(sbufl(1,j) - real(ic)))
+      ix = min(max(ix,0),3*mx*sx-1)
+      ic = int(sbufl(2,j))
+      iy = ic - iyl
+      if (iy.ge.my) then
+         iy = iy - ny
+      else if (iy.lt.0) then
+         iy = iy + ny
+      endif
+      iy = sy*iy + int(real(sy)*(sbufl(2,j) - real(ic)))
+      iy = min(max(iy,0),my*sy-1)
+      psbufl(1,j) = transfer(ix+65536*iy,psbufl(1,j))
+      do 30 i = 3, idimp
+      psbufl(i-1,j) = sbufl(i,j)
+   30 continue
+   40 continue
+c particles going to upper processor
+      jl = 0
+      if (k.gt.1) jl = nclr(3,k-1)
+      do 60 j = jl+1, nclr(3,k)
+      ic = int(sbufr(1,j))
+      ix = ic - mx*(k - 2)
+      if (ix.ge.(3*mx)) then
+         ix = ix - nx
+      else if (ix.lt.0) then
+         ix = ix + nx
+      endif
+      ix = sx*ix + int(real(sx)*(sbufr(1,j) - real(ic)))
+      ix = min(max(ix,0),3*mx*sx-1)
+      ic = int(sbufr(2,j))
+      iy = ic - iyr
+      if (iy.ge.my) then
+         iy = iy - ny
+      else if (iy.lt.0) then
+         iy = iy + ny
+      endif
+      iy = sy*iy + int(real(sy)*(sbufr(2,j) - real(ic)))
+      iy = min(max(iy,0),my*sy-1)
+      psbufr(1,j) = transfer(ix+65536*iy,psbufr(1,j))
+      do 50 i = 3, idimp
+      psbufr(i-1,j) = sbufr(i,j)
+   50 continue
+   60 continue
+   70 continue
+!$OMP END PARALLEL DO
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine PPPUNPACK2L(prbufl,prbufr,rbufl,rbufr,mcll,mclr,edges,
+     1idimp,nx,ny,mx,my,mx1)
+c this subroutine restores particles compressed by PPPPACK2L and
+c received by PPPMOVE2 in prbufl and prbufr, for use by PPPORDER2LB.
+c the position is placed in the middle of its step
+c input: all except rbufl, rbufr
+c output: rbufl, rbufr
+c prbufl/prbufr = compressed particles received from lower/upper
+c processor, idimp-1 words each
+c rbufl/rbufr = buffer for particles being received from lower/upper
+c processor
+c mcll/mclr = number offset being received from lower/upper processor
+c edges(1:2) = lower:upper boundary of particle partition
+c idimp = size of phase space = 4
+c nx/ny = system length in x/y direction
+c mx/my = number of grids in sorting cell in x/y
+c mx1 = (system length in x direction - 1)/mx + 1
+      implicit none
+      integer idimp, nx, ny, mx, my, mx1
+      real prbufl, prbufr, rbufl, rbufr, edges
+      integer mcll, mclr
+      dimension prbufl(idimp-1,*), prbufr(idimp-1,*)
+      dimension rbufl(idimp,*), rbufr(idimp,*)
+      dimension mcll(3,mx1), mclr(3,mx1), edges(2)
+c local data
+      integer i, j, k, jl, sx, sy, iyl, iyr, ic, ix, iy, n
+      sx = 1
+   10 if ((6*mx*sx).le.65536) then
+         sx = sx + sx
+         go to 10
+      endif
+      sy = 1
+   20 if ((2*my*sy).le.32640) then
+         sy = sy + sy
+         go to 20
+      endif
+      iyl = int(edges(1))
+      iyr = int(edges(2)) - my
+c loop over tiles in x of sending processor
+!$OMP PARALLEL DO PRIVATE(i,j,k,jl,ic,ix,iy,n)
+      do 70 k = 1, mx1
+c particles coming from lower processor
+      jl = 0
+      if (k.gt.1) jl = mcll(3,k-1)
+      do 40 j = jl+1, mcll(3,k)
+      n = transfer(prbufl(1,j),n)
+      ix = n - 65536*(n/65536)
+      iy = n/65536
+      ic = ix/sx + mx*(k - 2)
+      if (ic.lt.0) then
+         ic = ic + nx
+      else if (ic.ge.nx) then
+         ic = ic - nx
+      endif
+      rbufl(1,j) = real(ic) + (real(ix - sx*(ix/sx)) + 0.5)/real(sx)
+      rbufl(2,j) = real(iy/sy + iyl)
+     1           + (real(iy - sy*(iy/sy)) + 0.5)/real(sy)
+      do 30 i = 3, idimp
+      rbufl(i,j) = prbufl(i-1,j)
+   30 continue
+   40 continue
+c particles coming from upper processor
+      jl = 0
+      if (k.gt.1) jl = mclr(3,k-1)
+      do 60 j = jl+1, mclr(3,k)
+      n = transfer(prbufr(1,j),n)
+      ix = n - 65536*(n/65536)
+      iy = n/65536
+      ic = ix/sx + mx*(k - 2)
+      if (ic.lt.0) then
+         ic = ic + nx
+      else if (ic.ge.nx) then
+         ic = ic - nx
+      endif
+      rbufr(1,j) = real(ic) + (real(ix - sx*(ix/sx)) + 0.5)/real(sx)
+      rbufr(2,j) = real(iy/sy + iyr)
+     1           + (real(iy - sy*(iy/sy)) + 0.5)/real(sy)
+      do 50 i = 3, idimp
+      rbufr(i,j) = prbufr(i-1,j)
+   50 continue
+   60 continue
+   70 continue
+!$OMP END PARALLEL DO
+      return
+      end
 c-----------------------------------------------------------------------
       subroutine PPCGUARD2XL(fxy,nyp,nx,ndim,nxe,nypmx)
 c replicate extended periodic vector field in x direction
@@ -1605,17 +1853,18 @@ c sine/cosine table for the angles 2*n*pi/nxy
       return
       end
 c-----------------------------------------------------------------------
-      subroutine WPPFFT2RM(f,g,bs,br,isign,ntpose,mixup,sct,ttp,indx,   
-     1indy,kstrt,nvp,nxvh,nyv,kxp,kyp,kypd,nxhyd,nxyhd)
+      subroutine WPPFFT2RM(f,g,bs,br,isign,ntpose,ltpose,mixup,sct,ttp,i
+     1ndx,indy,kstrt,nvp,nxvh,nyv,kxp,kyp,kypd,nxhyd,nxyhd)
 c wrapper function for parallel real to complex fft
 c parallelized with OpenMP
+c ltpose = (0,1) = (no,yes) use non-blocking transpose
       implicit none
-      integer isign, ntpose, indx, indy, kstrt, nvp, nxvh, nyv, kxp, kyp
-      integer kypd, nxhyd, nxyhd, mixup
+      integer isign, ntpose, ltpose, indx, indy, kstrt, nvp, nxvh, nyv
+      integer kxp, kyp, kypd, nxhyd, nxyhd, mixup
       real ttp
       complex f, g, bs, br, sct
       dimension f(nxvh,kypd), g(nyv,kxp)
-      dimension bs(kxp,kyp), br(kxp,kyp)
+      dimension bs(kxp*kyp,*), br(kxp*kyp,*)
       dimension mixup(nxhyd), sct(nxyhd)
 c local data
       integer nxh, ny, kxpi, kypi, ks, kxpp, kypp
@@ -1635,8 +1884,13 @@ c perform x fft
      1nxvh,kypd,nxhyd,nxyhd)
 c transpose f array to g
          call PWTIMERA(-1,ttp,dtime)
-         call PPTPOSE(f,g,bs,br,nxh,ny,kxp,kyp,kstrt,nvp,nxvh,nyv,kxp,  
-     1kypd)
+         if (ltpose.eq.1) then
+            call PPTPOSENB(f,g,bs,br,nxh,ny,kxp,kyp,kstrt,nvp,nxvh,nyv,k
+     1xp,kypd)
+         else
+            call PPTPOSE(f,g,bs,br,nxh,ny,kxp,kyp,kstrt,nvp,nxvh,nyv,kxp
+     1,kypd)
+         endif
          call PWTIMERA(1,ttp,dtime)
 c perform y fft
          call PPFFT2RMXY(g,isign,mixup,sct,indx,indy,kstrt,kxpi,kxpp,nyv
@@ -1644,8 +1898,13 @@ c perform y fft
 c transpose g array to f
          if (ntpose.eq.0) then
             call PWTIMERA(-1,tf,dtime)
-            call PPTPOSE(g,f,br,bs,ny,nxh,kyp,kxp,kstrt,nvp,nyv,nxvh,   
+            if (ltpose.eq.1) then
+               call PPTPOSENB(g,f,br,bs,ny,nxh,kyp,kxp,kstrt,nvp,nyv,nxv
+     1h,kypd,kxp)
+            else
+               call PPTPOSE(g,f,br,bs,ny,nxh,kyp,kxp,kstrt,nvp,nyv,nxvh,
      1kypd,kxp)
+            endif
             call PWTIMERA(1,tf,dtime)
          endif
 c forward fourier transform
@@ -1653,8 +1912,13 @@ c forward fourier transform
 c transpose f array to g
          if (ntpose.eq.0) then
             call PWTIMERA(-1,tf,dtime)
-            call PPTPOSE(f,g,bs,br,nxh,ny,kxp,kyp,kstrt,nvp,nxvh,nyv,kxp
-     1,kypd)
+            if (ltpose.eq.1) then
+               call PPTPOSENB(f,g,bs,br,nxh,ny,kxp,kyp,kstrt,nvp,nxvh,ny
+     1v,kxp,kypd)
+            else
+               call PPTPOSE(f,g,bs,br,nxh,ny,kxp,kyp,kstrt,nvp,nxvh,nyv,
+     1kxp,kypd)
+            endif
             call PWTIMERA(1,tf,dtime)
          endif
 c perform y fft
@@ -1662,8 +1926,13 @@ c perform y fft
      1,kxp,nxhyd,nxyhd)
 c transpose g array to f
          call PWTIMERA(-1,ttp,dtime)
-         call PPTPOSE(g,f,br,bs,ny,nxh,kyp,kxp,kstrt,nvp,nyv,nxvh,kypd, 
-     1kxp)
+         if (ltpose.eq.1) then
+            call PPTPOSENB(g,f,br,bs,ny,nxh,kyp,kxp,kstrt,nvp,nyv,nxvh,k
+     1ypd,kxp)
+         else
+            call PPTPOSE(g,f,br,bs,ny,nxh,kyp,kxp,kstrt,nvp,nyv,nxvh,kyp
+     1d,kxp)
+         endif
          call PWTIMERA(1,ttp,dtime)
 c perform x fft
          call PPFFT2RMXX(f,isign,mixup,sct,indx,indy,kstrt,kypi,kypp,   
@@ -1673,17 +1942,18 @@ c perform x fft
       return
       end
 c-----------------------------------------------------------------------
-      subroutine WPPFFT2RM2(f,g,bs,br,isign,ntpose,mixup,sct,ttp,indx,  
-     1indy,kstrt,nvp,nxvh,nyv,kxp,kyp,kypd,nxhyd,nxyhd)
+      subroutine WPPFFT2RM2(f,g,bs,br,isign,ntpose,ltpose,mixup,sct,ttp,
+     1indx,indy,kstrt,nvp,nxvh,nyv,kxp,kyp,kypd,nxhyd,nxyhd)
 c wrapper function for parallel real to complex fft
 c parallelized with OpenMP
+c ltpose = (0,1) = (no,yes) use non-blocking transpose
       implicit none
-      integer isign, ntpose, indx, indy, kstrt, nvp, nxvh, nyv, kxp, kyp
-      integer kypd, nxhyd, nxyhd, mixup
+      integer isign, ntpose, ltpose, indx, indy, kstrt, nvp, nxvh, nyv
+      integer kxp, kyp, kypd, nxhyd, nxyhd, mixup
       real ttp
       complex f, g, bs, br, sct
       dimension f(2,nxvh,kypd), g(2,nyv,kxp)
-      dimension bs(2,kxp,kyp), br(2,kxp,kyp)
+      dimension bs(2,kxp*kyp,*), br(2,kxp*kyp,*)
       dimension mixup(nxhyd), sct(nxyhd)
 c local data
       integer nxh, ny, kxpi, kypi, ks, kxpp, kypp
@@ -1703,8 +1973,13 @@ c perform x fft
      1nxvh,kypd,nxhyd,nxyhd)
 c transpose f array to g
          call PWTIMERA(-1,ttp,dtime)
-         call PPNTPOSE(f,g,bs,br,nxh,ny,kxp,kyp,kstrt,nvp,2,nxvh,nyv,kxp
-     1,kypd)
+         if (ltpose.eq.1) then
+            call PPNTPOSENB(f,g,bs,br,nxh,ny,kxp,kyp,kstrt,nvp,2,nxvh,ny
+     1v,kxp,kypd)
+         else
+            call PPNTPOSE(f,g,bs,br,nxh,ny,kxp,kyp,kstrt,nvp,2,nxvh,nyv,
+     1kxp,kypd)
+         endif
          call PWTIMERA(1,ttp,dtime)
 c perform y fft
          call PPFFT2RM2XY(g,isign,mixup,sct,indx,indy,kstrt,kxpi,kxpp,  
@@ -1712,8 +1987,13 @@ c perform y fft
 c transpose g array to f
          if (ntpose.eq.0) then
             call PWTIMERA(-1,tf,dtime)
-            call PPNTPOSE(g,f,br,bs,ny,nxh,kyp,kxp,kstrt,nvp,2,nyv,nxvh,
-     1kypd,kxp)
+            if (ltpose.eq.1) then
+               call PPNTPOSENB(g,f,br,bs,ny,nxh,kyp,kxp,kstrt,nvp,2,nyv,
+     1nxvh,kypd,kxp)
+            else
+               call PPNTPOSE(g,f,br,bs,ny,nxh,kyp,kxp,kstrt,nvp,2,nyv,nx
+     1vh,kypd,kxp)
+            endif
             call PWTIMERA(1,tf,dtime)
          endif
 c forward fourier transform
@@ -2527,3 +2807,100 @@ c loop over particles in tile
       if (ierr.gt.0) irc = ierr
       return
       end
+c-----------------------------------------------------------------------
+      subroutine PPVDIST2(ppart,kpic,fvv,fxv,vmx,nx,nmv,nxb,idimp,nppmx,
+     1mxyp1,irc)
+c for 2d code, this subroutine calculates the velocity distribution
+c f(vx,vy) and the phase space distribution f(x,vx) of the particles
+c in the partition, by counting particles in bins
+c OpenMP version, each thread counts the particles in its tiles in a
+c private copy of fvv and fxv, which are then added together.
+c bin numbers for a block of npblk particles are calculated first in
+c a loop that can be vectorized, then the particles are counted.
+c particles with |vx| or |vy| >= vmx are not counted.
+c input: all except fvv, fxv, irc, output: fvv, fxv, irc
+c ppart(1,n,m) = position x of particle n in tile m
+c ppart(3,n,m) = velocity vx of particle n in tile m
+c ppart(4,n,m) = velocity vy of particle n in tile m
+c kpic = number of particles per tile
+c fvv(i,j) = number of particles with vx in bin i, vy in bin j
+c fxv(i,j) = number of particles with x in bin i, vx in bin j
+c velocity bin i covers -vmx + (2*vmx/nmv)*(i-1,i)
+c position bin i covers (nx/nxb)*(i-1,i)
+c vmx = maximum velocity counted
+c nx = system length in x direction
+c nmv = number of velocity bins in each direction
+c nxb = number of position bins in x direction
+c idimp = size of phase space = 4
+c nppmx = maximum number of particles in tile
+c mxyp1 = total number of tiles in partition
+c irc = error code, returned only if error occurs, when irc > 0
+c the distributions must be summed over processors with PPSUM
+      implicit none
+      integer nx, nmv, nxb, idimp, nppmx, mxyp1, irc
+      real vmx
+      real ppart, fvv, fxv
+      integer kpic
+      dimension ppart(idimp,nppmx,mxyp1)
+      dimension fvv(nmv,nmv), fxv(nxb,nmv)
+      dimension kpic(mxyp1)
+c local data
+      integer npblk
+      parameter(npblk=32)
+      integer i, j, k, nn, nppp, joff, ix, iv, iw
+      real dv, dxb, ax, avx, avy, anmv
+      integer ivb, iwb, ixb
+      dimension ivb(npblk), iwb(npblk), ixb(npblk)
+      dv = real(nmv)/(vmx + vmx)
+      dxb = real(nxb)/real(nx)
+      anmv = real(nmv)
+      do 20 j = 1, nmv
+      do 10 i = 1, nmv
+      fvv(i,j) = 0.0
+   10 continue
+   20 continue
+      do 40 j = 1, nmv
+      do 30 i = 1, nxb
+      fxv(i,j) = 0.0
+   30 continue
+   40 continue
+c loop over tiles
+!$OMP PARALLEL DO
+!$OMP& PRIVATE(j,k,nn,nppp,joff,ix,iv,iw,ax,avx,avy,ivb,iwb,ixb)
+!$OMP& REDUCTION(+:fvv,fxv)
+      do 70 k = 1, mxyp1
+      nppp = kpic(k)
+c loop over blocks of particles in tile
+      do 60 joff = 0, nppp-1, npblk
+      nn = min(nppp-joff,npblk)
+c calculate bin numbers, 0 if outside range
+      do 50 j = 1, nn
+      ax = dxb*ppart(1,j+joff,k)
+      avx = dv*(ppart(3,j+joff,k) + vmx)
+      avy = dv*(ppart(4,j+joff,k) + vmx)
+c clamp to avoid overflow in conversion to integer
+      avx = min(max(avx,-1.0),anmv)
+      avy = min(max(avy,-1.0),anmv)
+      ix = ax + 1.0
+      iv = avx + 1.0
+      iw = avy + 1.0
+      if ((avx.lt.0.0).or.(iv.gt.nmv)) iv = 0
+      if ((avy.lt.0.0).or.(iw.gt.nmv)) iw = 0
+      if ((ax.lt.0.0).or.(ix.gt.nxb)) ix = 0
+      ivb(j) = iv
+      iwb(j) = iw
+      ixb(j) = ix
+   50 continue
+c count particles
+      do 55 j = 1, nn
+      iv = ivb(j)
+      iw = iwb(j)
+      ix = ixb(j)
+      if ((iv.gt.0).and.(iw.gt.0)) fvv(iv,iw) = fvv(iv,iw) + 1.0
+      if ((ix.gt.0).and.(iv.gt.0)) fxv(ix,iv) = fxv(ix,iv) + 1.0
+   55 continue
+   60 continue
+   70 continue
+!$OMP END PARALLEL DO
+      return
+      end
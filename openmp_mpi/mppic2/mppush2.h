@@ -32,6 +32,12 @@ void cppgppushf2l(float ppart[], float fxy[], int kpic[], int ncl[],
                   int nppmx, int nxv, int nypmx, int mx1, int mxyp1,
                   int ntmax, int *irc);
 
+void cppgppushf2lr(float ppart[], float fxy[], int kpic[], int ncl[],
+                   int ihole[], int noff, int nyp, float qbm, float dt,
+                   float *ek, int nx, int ny, int mx, int my, int idimp,
+                   int nppmx, int nxv, int nypmx, int mx1, int mxyp1,
+                   int ntmax, int kyl, int kyh, int *irc);
+
 void cppgppost2l(float ppart[], float q[], int kpic[], int noff, 
                  float qm, int idimp, int nppmx, int mx, int my,
                  int nxv, int nypmx, int mx1, int mxyp1);
@@ -52,6 +58,20 @@ void cppporder2lb(float ppart[], float ppbuff[], float rbufl[],
                   int mcll[], int mclr[], int idimp, int nppmx, int mx1,
                   int myp1, int npbmx, int ntmax, int nbmax, int *irc);
 
+void cppporder2lbr(float ppart[], float ppbuff[], float rbufl[],
+                   float rbufr[], int kpic[], int ncl[], int ihole[],
+                   int mcll[], int mclr[], int idimp, int nppmx,
+                   int mx1, int myp1, int npbmx, int ntmax, int nbmax,
+                   int kyl, int kyh, int *irc);
+
+void cppppack2l(float sbufl[], float sbufr[], float psbufl[],
+                float psbufr[], int ncll[], int nclr[], float edges[],
+                int idimp, int nx, int ny, int mx, int my, int mx1);
+
+void cpppunpack2l(float prbufl[], float prbufr[], float rbufl[],
+                  float rbufr[], int mcll[], int mclr[], float edges[],
+                  int idimp, int nx, int ny, int mx, int my, int mx1);
+
 void cppcguard2xl(float fxy[], int nyp, int nx, int ndim, int nxe,
                   int nypmx);
 
@@ -87,14 +107,21 @@ void cppfft2rm2xy(float complex g[], int isign, int mixup[],
 
 void cwppfft2rm(float complex f[], float complex g[],
                 float complex bs[], float complex br[], int isign,
-                int ntpose, int mixup[], float complex sct[],
-                float *ttp, int indx, int indy, int kstrt, int nvp,
-                int nxvh, int nyv, int kxp, int kyp, int kypd,
-                int nxhyd, int nxyhd);
+                int ntpose, int ltpose, int mixup[],
+                float complex sct[], float *ttp, int indx, int indy,
+                int kstrt, int nvp, int nxvh, int nyv, int kxp,
+                int kyp, int kypd, int nxhyd, int nxyhd);
 
 void cwppfft2rm2(float complex f[], float complex g[],
                  float complex bs[], float complex br[], int isign,
-                 int ntpose, int mixup[], float complex sct[],
-                 float *ttp, int indx, int indy, int kstrt, int nvp,
-                 int nxvh, int nyv, int kxp, int kyp, int kypd,
-                 int nxhyd, int nxyhd);
+                 int ntpose, int ltpose, int mixup[],
+                 float complex sct[], float *ttp, int indx, int indy,
+                 int kstrt, int nvp, int nxvh, int nyv, int kxp,
+                 int kyp, int kypd, int nxhyd, int nxyhd);
+
+void cpppcopyout(float part[], float ppart[], int kpic[], int *npp,
+                 int npmax, int nppmx, int idimp, int mxyp1, int *irc);
+
+void cppvdist2(float ppart[], int kpic[], float fvv[], float fxv[],
+               float vmx, int nx, int nmv, int nxb, int idimp,
+               int nppmx, int mxyp1, int *irc);
@@ -37,6 +37,13 @@ void ppgppushf2l_(float *ppart, float *fxy, int *kpic, int *ncl,
                   int *my, int *idimp, int *nppmx, int *nxv, int *nypmx,
                   int *mx1, int *mxyp1, int *ntmax, int *irc);
 
+void ppgppushf2lr_(float *ppart, float *fxy, int *kpic, int *ncl,
+                   int *ihole, int *noff, int *nyp, float *qbm,
+                   float *dt, float *ek, int *nx, int *ny, int *mx,
+                   int *my, int *idimp, int *nppmx, int *nxv,
+                   int *nypmx, int *mx1, int *mxyp1, int *ntmax,
+                   int *kyl, int *kyh, int *irc);
+
 void ppgppost2l_(float *ppart, float *q, int *kpic, int *noff,
                  float *qm, int *idimp, int *nppmx, int *mx, int *my,
                  int *nxv, int *nypmx, int *mx1, int *mxyp1);
@@ -60,6 +67,22 @@ void ppporder2lb_(float *ppart, float *ppbuff, float *rbufl,
                   int *mx1, int *myp1, int *npbmx, int *ntmax,
                   int *nbmax, int *irc);
 
+void ppporder2lbr_(float *ppart, float *ppbuff, float *rbufl,
+                   float *rbufr, int *kpic, int *ncl, int *ihole,
+                   int *mcll, int *mclr, int *idimp, int *nppmx,
+                   int *mx1, int *myp1, int *npbmx, int *ntmax,
+                   int *nbmax, int *kyl, int *kyh, int *irc);
+
+void ppppack2l_(float *sbufl, float *sbufr, float *psbufl,
+                float *psbufr, int *ncll, int *nclr, float *edges,
+                int *idimp, int *nx, int *ny, int *mx, int *my,
+                int *mx1);
+
+void pppunpack2l_(float *prbufl, float *prbufr, float *rbufl,
+                  float *rbufr, int *mcll, int *mclr, float *edges,
+                  int *idimp, int *nx, int *ny, int *mx, int *my,
+                  int *mx1);
+
 void ppcguard2xl_(float *fxy, int *nyp, int *nx, int *ndim, int *nxe,
                   int *nypmx);
 
@@ -94,16 +117,24 @@ void ppfft2rm2xy_(float complex *g, int *isign, int *mixup,
                   int *nxyhd);
 
 void wppfft2rm_(float complex *f, float complex *g, float complex *bs,
-                float complex *br, int *isign, int *ntpose, int *mixup,
-                float complex *sct, float *ttp, int *indx, int *indy,
-                int *kstrt, int *nvp, int *nxvh, int *nyv, int *kxp,
-                int *kyp, int *kypd, int *nxhyd, int *nxyhd);
+                float complex *br, int *isign, int *ntpose, int *ltpose,
+                int *mixup, float complex *sct, float *ttp, int *indx,
+                int *indy, int *kstrt, int *nvp, int *nxvh, int *nyv,
+                int *kxp, int *kyp, int *kypd, int *nxhyd, int *nxyhd);
 
 void wppfft2rm2_(float complex *f, float complex *g, float complex *bs,
-                 float complex *br, int *isign, int *ntpose, int *mixup,
-                 float complex *sct, float *ttp, int *indx, int *indy,
-                 int *kstrt, int *nvp, int *nxvh, int *nyv, int *kxp,
-                 int *kyp, int *kypd, int *nxhyd, int *nxyhd);
+                 float complex *br, int *isign, int *ntpose, int *ltpose,
+                 int *mixup, float complex *sct, float *ttp, int *indx,
+                 int *indy, int *kstrt, int *nvp, int *nxvh, int *nyv,
+                 int *kxp, int *kyp, int *kypd, int *nxhyd, int *nxyhd);
+
+void pppcopyout_(float *part, float *ppart, int *kpic, int *npp,
+                 int *npmax, int *nppmx, int *idimp, int *mxyp1,
+                 int *irc);
+
+void ppvdist2_(float *ppart, int *kpic, float *fvv, float *fxv,
+               float *vmx, int *nx, int *nmv, int *nxb, int *idimp,
+               int *nppmx, int *mxyp1, int *irc);
 
 /* Interfaces to C */
 
@@ -177,6 +208,18 @@ void cppgppushf2l(float ppart[], float fxy[], int kpic[], int ncl[],
    return;
 }
 
+/*--------------------------------------------------------------------*/
+void cppgppushf2lr(float ppart[], float fxy[], int kpic[], int ncl[],
+                   int ihole[], int noff, int nyp, float qbm, float dt,
+                   float *ek, int nx, int ny, int mx, int my, int idimp,
+                   int nppmx, int nxv, int nypmx, int mx1, int mxyp1,
+                   int ntmax, int kyl, int kyh, int *irc) {
+   ppgppushf2lr_(ppart,fxy,kpic,ncl,ihole,&noff,&nyp,&qbm,&dt,ek,&nx,
+                 &ny,&mx,&my,&idimp,&nppmx,&nxv,&nypmx,&mx1,&mxyp1,
+                 &ntmax,&kyl,&kyh,irc);
+   return;
+}
+
 /*--------------------------------------------------------------------*/
 void cppgppost2l(float ppart[], float q[], int kpic[], int noff, 
                  float qm, int idimp, int nppmx, int mx, int my,
@@ -218,6 +261,36 @@ void cppporder2lb(float ppart[], float ppbuff[], float rbufl[],
    return;
 }
 
+/*--------------------------------------------------------------------*/
+void cppporder2lbr(float ppart[], float ppbuff[], float rbufl[],
+                   float rbufr[], int kpic[], int ncl[], int ihole[],
+                   int mcll[], int mclr[], int idimp, int nppmx,
+                   int mx1, int myp1, int npbmx, int ntmax, int nbmax,
+                   int kyl, int kyh, int *irc) {
+   ppporder2lbr_(ppart,ppbuff,rbufl,rbufr,kpic,ncl,ihole,mcll,mclr,
+                 &idimp,&nppmx,&mx1,&myp1,&npbmx,&ntmax,&nbmax,&kyl,
+                 &kyh,irc);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppppack2l(float sbufl[], float sbufr[], float psbufl[],
+                float psbufr[], int ncll[], int nclr[], float edges[],
+                int idimp, int nx, int ny, int mx, int my, int mx1) {
+   ppppack2l_(sbufl,sbufr,psbufl,psbufr,ncll,nclr,edges,&idimp,&nx,&ny,
+              &mx,&my,&mx1);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cpppunpack2l(float prbufl[], float prbufr[], float rbufl[],
+                  float rbufr[], int mcll[], int mclr[], float edges[],
+                  int idimp, int nx, int ny, int mx, int my, int mx1) {
+   pppunpack2l_(prbufl,prbufr,rbufl,rbufr,mcll,mclr,edges,&idimp,&nx,
+                &ny,&mx,&my,&mx1);
+   return;
+}
+
 /*--------------------------------------------------------------------*/
 void cppcguard2xl(float fxy[], int nyp, int nx, int ndim, int nxe,
                   int nypmx) {
@@ -291,23 +364,41 @@ void cppfft2rm2xy(float complex g[], int isign, int mixup[],
 /*--------------------------------------------------------------------*/
 void cwppfft2rm(float complex f[], float complex g[],
                 float complex bs[], float complex br[], int isign,
-                int ntpose, int mixup[], float complex sct[],
-                float *ttp, int indx, int indy, int kstrt, int nvp,
-                int nxvh, int nyv, int kxp, int kyp, int kypd,
-                int nxhyd, int nxyhd) {
-   wppfft2rm_(f,g,bs,br,&isign,&ntpose,mixup,sct,ttp,&indx,&indy,&kstrt,
-              &nvp,&nxvh,&nyv,&kxp,&kyp,&kypd,&nxhyd,&nxyhd);
+                int ntpose, int ltpose, int mixup[],
+                float complex sct[], float *ttp, int indx, int indy,
+                int kstrt, int nvp, int nxvh, int nyv, int kxp,
+                int kyp, int kypd, int nxhyd, int nxyhd) {
+   wppfft2rm_(f,g,bs,br,&isign,&ntpose,&ltpose,mixup,sct,ttp,&indx,
+              &indy,&kstrt,&nvp,&nxvh,&nyv,&kxp,&kyp,&kypd,&nxhyd,
+              &nxyhd);
    return;
 }
 
 /*--------------------------------------------------------------------*/
 void cwppfft2rm2(float complex f[], float complex g[],
                  float complex bs[], float complex br[], int isign,
-                 int ntpose, int mixup[], float complex sct[],
-                 float *ttp, int indx, int indy, int kstrt, int nvp,
-                 int nxvh, int nyv, int kxp, int kyp, int kypd,
-                 int nxhyd, int nxyhd) {
-   wppfft2rm2_(f,g,bs,br,&isign,&ntpose,mixup,sct,ttp,&indx,&indy,&kstrt,
-               &nvp,&nxvh,&nyv,&kxp,&kyp,&kypd,&nxhyd,&nxyhd);
+                 int ntpose, int ltpose, int mixup[],
+                 float complex sct[], float *ttp, int indx, int indy,
+                 int kstrt, int nvp, int nxvh, int nyv, int kxp,
+                 int kyp, int kypd, int nxhyd, int nxyhd) {
+   wppfft2rm2_(f,g,bs,br,&isign,&ntpose,&ltpose,mixup,sct,ttp,&indx,
+               &indy,&kstrt,&nvp,&nxvh,&nyv,&kxp,&kyp,&kypd,&nxhyd,
+               &nxyhd);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cpppcopyout(float part[], float ppart[], int kpic[], int *npp,
+                 int npmax, int nppmx, int idimp, int mxyp1, int *irc) {
+   pppcopyout_(part,ppart,kpic,npp,&npmax,&nppmx,&idimp,&mxyp1,irc);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cppvdist2(float ppart[], int kpic[], float fvv[], float fxv[],
+               float vmx, int nx, int nmv, int nxb, int idimp,
+               int nppmx, int mxyp1, int *irc) {
+   ppvdist2_(ppart,kpic,fvv,fxv,&vmx,&nx,&nmv,&nxb,&idimp,&nppmx,
+             &mxyp1,irc);
    return;
 }
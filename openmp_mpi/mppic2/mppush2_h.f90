@@ -93,6 +93,24 @@
          integer, dimension(2,ntmax+1,mxyp1), intent(inout) :: ihole
          end subroutine
       end interface
+!
+      interface
+         subroutine PPGPPUSHF2LR(ppart,fxy,kpic,ncl,ihole,noff,nyp,qbm, &
+     &dt,ek,nx,ny,mx,my,idimp,nppmx,nxv,nypmx,mx1,mxyp1,ntmax,kyl,kyh,  &
+     &irc)
+         implicit none
+         integer, intent(in) :: noff, nyp, nx, ny, mx, my, idimp, nppmx
+         integer, intent(in) :: nxv, nypmx, mx1, mxyp1, ntmax, kyl, kyh
+         integer, intent(inout) :: irc
+         real, intent(in) :: qbm, dt
+         real, intent(inout) :: ek
+         real, dimension(idimp,nppmx,mxyp1), intent(inout) :: ppart
+         real, dimension(2,nxv,nypmx), intent(in) :: fxy
+         integer, dimension(mxyp1), intent(in) :: kpic
+         integer, dimension(8,mxyp1), intent(inout) :: ncl
+         integer, dimension(2,ntmax+1,mxyp1), intent(inout) :: ihole
+         end subroutine
+      end interface
 !
       interface
          subroutine PPGPPOST2L(ppart,q,kpic,noff,qm,idimp,nppmx,mx,my,  &
@@ -157,6 +175,47 @@
          integer, dimension(3,mx1), intent(in) :: mcll, mclr
          end subroutine
       end interface
+!
+      interface
+         subroutine PPPORDER2LBR(ppart,ppbuff,rbufl,rbufr,kpic,ncl,ihole&
+     &,mcll,mclr,idimp,nppmx,mx1,myp1,npbmx,ntmax,nbmax,kyl,kyh,irc)
+         implicit none
+         integer, intent(in) :: idimp, nppmx, mx1, myp1, npbmx, ntmax
+         integer, intent(in) :: nbmax, kyl, kyh
+         integer, intent(inout) :: irc
+         real, dimension(idimp,nppmx,mx1*myp1), intent(inout) :: ppart
+         real, dimension(idimp,npbmx,mx1*myp1), intent(in) :: ppbuff
+         real, dimension(idimp,nbmax), intent(in) :: rbufl, rbufr
+         integer, dimension(mx1*myp1), intent(inout) :: kpic
+         integer, dimension(8,mx1*myp1), intent(in) :: ncl
+         integer, dimension(2,ntmax+1,mx1*myp1), intent(in) :: ihole
+         integer, dimension(3,mx1), intent(in) :: mcll, mclr
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPPPACK2L(sbufl,sbufr,psbufl,psbufr,ncll,nclr,edges&
+     &,idimp,nx,ny,mx,my,mx1)
+         implicit none
+         integer, intent(in) :: idimp, nx, ny, mx, my, mx1
+         real, dimension(idimp,*), intent(in) :: sbufl, sbufr
+         real, dimension(idimp-1,*), intent(inout) :: psbufl, psbufr
+         integer, dimension(3,mx1), intent(in) :: ncll, nclr
+         real, dimension(2), intent(in) :: edges
+         end subroutine
+      end interface
+!
+      interface
+         subroutine PPPUNPACK2L(prbufl,prbufr,rbufl,rbufr,mcll,mclr,   &
+     &edges,idimp,nx,ny,mx,my,mx1)
+         implicit none
+         integer, intent(in) :: idimp, nx, ny, mx, my, mx1
+         real, dimension(idimp-1,*), intent(in) :: prbufl, prbufr
+         real, dimension(idimp,*), intent(inout) :: rbufl, rbufr
+         integer, dimension(3,mx1), intent(in) :: mcll, mclr
+         real, dimension(2), intent(in) :: edges
+         end subroutine
+      end interface
 !
       interface
          subroutine PPCGUARD2XL(fxy,nyp,nx,ndim,nxe,nypmx)
@@ -197,30 +256,32 @@
       end interface
 !
       interface
-         subroutine WPPFFT2RM(f,g,bs,br,isign,ntpose,mixup,sct,ttp,indx,&
-     &indy,kstrt,nvp,nxvh,nyv,kxp,kyp,kypd,nxhyd,nxyhd)
+         subroutine WPPFFT2RM(f,g,bs,br,isign,ntpose,ltpose,mixup,sct,  &
+     &ttp,indx,indy,kstrt,nvp,nxvh,nyv,kxp,kyp,kypd,nxhyd,nxyhd)
          implicit none
-         integer, intent(in) :: isign, ntpose, indx, indy, kstrt, nvp
+         integer, intent(in) :: isign, ntpose, ltpose, indx, indy
+         integer, intent(in) :: kstrt, nvp
          integer, intent(in) :: nxvh, nyv, kxp, kyp, kypd, nxhyd, nxyhd
          real, intent(inout) :: ttp
          real, dimension(2*nxvh,kypd), intent(inout) :: f
          complex, dimension(nyv,kxp), intent(inout) :: g
-         complex, dimension(kxp,kyp), intent(inout) :: bs, br
+         complex, dimension(kxp*kyp,*), intent(inout) :: bs, br
          integer, dimension(nxhyd), intent(in) :: mixup
          complex, dimension(nxyhd), intent(in) :: sct
          end subroutine
       end interface
 !
       interface
-         subroutine WPPFFT2RM2(f,g,bs,br,isign,ntpose,mixup,sct,ttp,indx&
-     &,indy,kstrt,nvp,nxvh,nyv,kxp,kyp,kypd,nxhyd,nxyhd)
+         subroutine WPPFFT2RM2(f,g,bs,br,isign,ntpose,ltpose,mixup,sct, &
+     &ttp,indx,indy,kstrt,nvp,nxvh,nyv,kxp,kyp,kypd,nxhyd,nxyhd)
          implicit none
-         integer, intent(in) :: isign, ntpose, indx, indy, kstrt, nvp
+         integer, intent(in) :: isign, ntpose, ltpose, indx, indy
+         integer, intent(in) :: kstrt, nvp
          integer, intent(in) :: nxvh, nyv, kxp, kyp, kypd, nxhyd, nxyhd
          real, intent(inout) :: ttp
          real, dimension(2,2*nxvh,kypd), intent(inout) :: f
          complex, dimension(2,nyv,kxp), intent(inout) :: g
-         complex, dimension(2,kxp,kyp), intent(inout) :: bs, br
+         complex, dimension(2,kxp*kyp,*), intent(inout) :: bs, br
          integer, dimension(nxhyd), intent(in) :: mixup
          complex, dimension(nxyhd), intent(in) :: sct
          end subroutine
@@ -273,6 +334,20 @@
          complex, dimension(nxyhd), intent(in) :: sct
          end subroutine
       end interface
+!
+      interface
+         subroutine PPVDIST2(ppart,kpic,fvv,fxv,vmx,nx,nmv,nxb,idimp,    &
+     &nppmx,mxyp1,irc)
+         implicit none
+         integer, intent(in) :: nx, nmv, nxb, idimp, nppmx, mxyp1
+         integer, intent(inout) :: irc
+         real, intent(in) :: vmx
+         real, dimension(idimp,nppmx,mxyp1), intent(in) :: ppart
+         real, dimension(nmv,nmv), intent(inout) :: fvv
+         real, dimension(nxb,nmv), intent(inout) :: fxv
+         integer, dimension(mxyp1), intent(in) :: kpic
+         end subroutine
+      end interface
 !
       interface
          function ranorm()
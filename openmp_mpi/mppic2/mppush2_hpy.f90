@@ -245,17 +245,18 @@
       end interface
 !
       interface
-         subroutine WPPFFT2RM(f,g,bs,br,isign,ntpose,mixup,sct,ttp,indx,&
-     &indy,kstrt,nvp,nxvh,nyv,kxp,kyp,kypd,nxhyd,nxyhd)
+         subroutine WPPFFT2RM(f,g,bs,br,isign,ntpose,ltpose,mixup,sct,  &
+     &ttp,indx,indy,kstrt,nvp,nxvh,nyv,kxp,kyp,kypd,nxhyd,nxyhd)
          implicit none
-         integer, intent(in) :: isign, ntpose, indx, indy, kstrt, nvp
+         integer, intent(in) :: isign, ntpose, ltpose, indx, indy
+         integer, intent(in) :: kstrt, nvp
          integer, intent(in) :: nxvh, nyv, kxp, kyp, kypd, nxhyd, nxyhd
          real, intent(inout) :: ttp
 !        real, dimension(2*nxvh,kypd), intent(inout) :: f
          real, dimension(*), intent(inout) :: f
 !        complex, dimension(nyv,kxp), intent(inout) :: g
          complex, dimension(*), intent(inout) :: g
-!        complex, dimension(kxp,kyp), intent(inout) :: bs, br
+!        complex, dimension(kxp*kyp,*), intent(inout) :: bs, br
          complex, dimension(*), intent(inout) :: bs, br
 !        integer, dimension(nxhyd), intent(in) :: mixup
          integer, dimension(*), intent(in) :: mixup
@@ -265,17 +266,18 @@
       end interface
 !
       interface
-         subroutine WPPFFT2RM2(f,g,bs,br,isign,ntpose,mixup,sct,ttp,indx&
-     &,indy,kstrt,nvp,nxvh,nyv,kxp,kyp,kypd,nxhyd,nxyhd)
+         subroutine WPPFFT2RM2(f,g,bs,br,isign,ntpose,ltpose,mixup,sct, &
+     &ttp,indx,indy,kstrt,nvp,nxvh,nyv,kxp,kyp,kypd,nxhyd,nxyhd)
          implicit none
-         integer, intent(in) :: isign, ntpose, indx, indy, kstrt, nvp
+         integer, intent(in) :: isign, ntpose, ltpose, indx, indy
+         integer, intent(in) :: kstrt, nvp
          integer, intent(in) :: nxvh, nyv, kxp, kyp, kypd, nxhyd, nxyhd
          real, intent(inout) :: ttp
 !        real, dimension(2,2*nxvh,kypd), intent(inout) :: f
          real, dimension(*), intent(inout) :: f
 !        complex, dimension(2,nyv,kxp), intent(inout) :: g
          complex, dimension(*), intent(inout) :: g
-!        complex, dimension(2,kxp,kyp), intent(inout) :: bs, br
+!        complex, dimension(2,kxp*kyp,*), intent(inout) :: bs, br
          complex, dimension(*), intent(inout) :: bs, br
 !        integer, dimension(nxhyd), intent(in) :: mixup
          integer, dimension(*), intent(in) :: mixup
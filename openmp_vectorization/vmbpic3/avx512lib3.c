@@ -81,8 +81,10 @@ void cknciscan2(int *isdata, int nths) {
 /* performs local prefix reduction of integer data shared by threads */
 /* using binary tree method. */
 /* requires KNC, isdata needs to be 64 byte aligned */
+/* without KNC, a scalar loop is used */
 /* local data */
    int j, ns, isum, ist;
+#ifdef __MIC__
    __m512i v_m1, v_m2, v_it, v_is, v_ioff;
    ns = 16*(nths/16);
    v_m1 = _mm512_set_epi32(11,11,11,11,11,10,9,8,3,3,3,3,3,2,1,0);
@@ -119,6 +121,10 @@ void cknciscan2(int *isdata, int nths) {
    }
    if (ns > 0)
       isum = isdata[ns-1];
+#else
+   ns = 0;
+   isum = 0;
+#endif
 /* loop over remaining elements */
    for (j = ns; j < nths; j++) {
       ist = isdata[j];
@@ -0,0 +1,2147 @@
+/* AVX-512F/AVX2 C Library for Skeleton 3D Electromagnetic OpenMP/Vector */
+/* PIC Code                                                              */
+/* the particle push, current deposit and particle reordering procedures */
+/* are compiled for both instruction sets, and the best one available on */
+/* the host is selected at run time with cpuid                           */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <immintrin.h>
+#include "avxmbpush3.h"
+
+/* target attributes for procedures compiled for one instruction set */
+#define AVX512F __attribute__((target("avx512f,fma")))
+#define AVX2 __attribute__((target("avx2,fma")))
+
+/* isa = instruction set found by cavxcheck, -1 if not checked yet */
+static int isa = -1;
+
+/*--------------------------------------------------------------------*/
+int cavxcheck() {
+/* this function determines with cpuid which instruction set is used by
+   the procedures in this library.  the result is saved for later calls
+   returns 2 if AVX-512F is available, 1 if only AVX2 and FMA are
+   available, and 0 if neither is available.  in the last case, the
+   procedures in this library must not be called
+local data                                                            */
+   if (isa < 0) {
+      __builtin_cpu_init();
+      isa = 0;
+      if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+         isa = 1;
+      if (__builtin_cpu_supports("avx512f"))
+         isa = 2;
+   }
+   return isa;
+}
+
+/*--------------------------------------------------------------------*/
+static void cavxgetf3l(float sf[], float f[], int noff, int moff,
+                       int loff, int nn, int mm, int ll, int mxv,
+                       int mxyv, int nxv, int nxyv) {
+/* copy field with 4 components per grid point from global array f to
+   local tile array sf, one contiguous row in x at a time
+local data                                                            */
+   int j, k;
+   for (k = 0; k < ll; k++) {
+      for (j = 0; j < mm; j++) {
+         memcpy(&sf[4*(mxv*j+mxyv*k)],
+                &f[4*(noff+nxv*(j+moff)+nxyv*(k+loff))],
+                4*nn*sizeof(float));
+      }
+   }
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+static void cavxputj3l(float cu[], float scu[], int noff, int moff,
+                       int loff, int mx, int my, int mz, int nxv,
+                       int nyv, int nzv, int mxv, int mxyv) {
+/* add current in local tile array scu to global array cu, interior
+   points directly and edge points with atomic updates
+local data                                                            */
+   int i, j, k, nn, mm, ll, nm, lm, nxyv;
+   nxyv = nxv*nyv;
+/* deposit current to interior points in global array */
+   nn = nxv - noff;
+   nn = mx < nn ? mx : nn;
+   mm = nyv - moff;
+   mm = my < mm ? my : mm;
+   ll = nzv - loff;
+   ll = mz < ll ? mz : ll;
+   for (k = 1; k < ll; k++) {
+      for (j = 1; j < mm; j++) {
+         for (i = 1; i < nn; i++) {
+            cu[4*(i+noff+nxv*(j+moff)+nxyv*(k+loff))]
+            += scu[4*(i+mxv*j+mxyv*k)];
+            cu[1+4*(i+noff+nxv*(j+moff)+nxyv*(k+loff))]
+            += scu[1+4*(i+mxv*j+mxyv*k)];
+            cu[2+4*(i+noff+nxv*(j+moff)+nxyv*(k+loff))]
+            += scu[2+4*(i+mxv*j+mxyv*k)];
+         }
+      }
+   }
+/* deposit current to edge points in global array */
+   lm = nzv - loff;
+   lm = mz+1 < lm ? mz+1 : lm;
+   for (j = 1; j < mm; j++) {
+      for (i = 1; i < nn; i++) {
+#pragma omp atomic
+         cu[4*(i+noff+nxv*(j+moff)+nxyv*loff)] += scu[4*(i+mxv*j)];
+#pragma omp atomic
+         cu[1+4*(i+noff+nxv*(j+moff)+nxyv*loff)] += scu[1+4*(i+mxv*j)];
+#pragma omp atomic
+         cu[2+4*(i+noff+nxv*(j+moff)+nxyv*loff)] += scu[2+4*(i+mxv*j)];
+         if (lm > mz) {
+#pragma omp atomic
+            cu[4*(i+noff+nxv*(j+moff)+nxyv*(lm+loff-1))]
+            += scu[4*(i+mxv*j+mxyv*(lm-1))];
+#pragma omp atomic
+            cu[1+4*(i+noff+nxv*(j+moff)+nxyv*(lm+loff-1))]
+            += scu[1+4*(i+mxv*j+mxyv*(lm-1))];
+#pragma omp atomic
+            cu[2+4*(i+noff+nxv*(j+moff)+nxyv*(lm+loff-1))]
+            += scu[2+4*(i+mxv*j+mxyv*(lm-1))];
+         }
+      }
+   }
+   nm = nxv - noff;
+   nm = mx+1 < nm ? mx+1 : nm;
+   mm = nyv - moff;
+   mm = my+1 < mm ? my+1 : mm;
+   for (k = 0; k < ll; k++) {
+      for (i = 1; i < nn; i++) {
+#pragma omp atomic
+         cu[4*(i+noff+nxv*moff+nxyv*(k+loff))] += scu[4*(i+mxyv*k)];
+#pragma omp atomic
+         cu[1+4*(i+noff+nxv*moff+nxyv*(k+loff))] += scu[1+4*(i+mxyv*k)];
+#pragma omp atomic
+         cu[2+4*(i+noff+nxv*moff+nxyv*(k+loff))] += scu[2+4*(i+mxyv*k)];
+         if (mm > my) {
+#pragma omp atomic
+            cu[4*(i+noff+nxv*(mm+moff-1)+nxyv*(k+loff))]
+            += scu[4*(i+mxv*(mm-1)+mxyv*k)];
+#pragma omp atomic
+            cu[1+4*(i+noff+nxv*(mm+moff-1)+nxyv*(k+loff))]
+            += scu[1+4*(i+mxv*(mm-1)+mxyv*k)];
+#pragma omp atomic
+            cu[2+4*(i+noff+nxv*(mm+moff-1)+nxyv*(k+loff))]
+            += scu[2+4*(i+mxv*(mm-1)+mxyv*k)];
+         }
+      }
+      for (j = 0; j < mm; j++) {
+#pragma omp atomic
+         cu[4*(noff+nxv*(j+moff)+nxyv*(k+loff))] += scu[4*(mxv*j+mxyv*k)];
+#pragma omp atomic
+         cu[1+4*(noff+nxv*(j+moff)+nxyv*(k+loff))]
+         += scu[1+4*(mxv*j+mxyv*k)];
+#pragma omp atomic
+         cu[2+4*(noff+nxv*(j+moff)+nxyv*(k+loff))]
+         += scu[2+4*(mxv*j+mxyv*k)];
+         if (nm > mx) {
+#pragma omp atomic
+            cu[4*(nm+noff-1+nxv*(j+moff)+nxyv*(k+loff))]
+            += scu[4*(nm-1+mxv*j+mxyv*k)];
+#pragma omp atomic
+            cu[1+4*(nm+noff-1+nxv*(j+moff)+nxyv*(k+loff))]
+            += scu[1+4*(nm-1+mxv*j+mxyv*k)];
+#pragma omp atomic
+            cu[2+4*(nm+noff-1+nxv*(j+moff)+nxyv*(k+loff))]
+            += scu[2+4*(nm-1+mxv*j+mxyv*k)];
+         }
+      }
+   }
+   if (lm > mz) {
+      for (i = 1; i < nn; i++) {
+#pragma omp atomic
+         cu[4*(i+noff+nxv*moff+nxyv*(lm+loff-1))]
+         += scu[4*(i+mxyv*(lm-1))];
+#pragma omp atomic
+         cu[1+4*(i+noff+nxv*moff+nxyv*(lm+loff-1))]
+         += scu[1+4*(i+mxyv*(lm-1))];
+#pragma omp atomic
+         cu[2+4*(i+noff+nxv*moff+nxyv*(lm+loff-1))]
+         += scu[2+4*(i+mxyv*(lm-1))];
+         if (mm > my) {
+#pragma omp atomic
+            cu[4*(i+noff+nxv*(mm+moff-1)+nxyv*(lm+loff-1))]
+            += scu[4*(i+mxv*(mm-1)+mxyv*(lm-1))];
+#pragma omp atomic
+            cu[1+4*(i+noff+nxv*(mm+moff-1)+nxyv*(lm+loff-1))]
+            += scu[1+4*(i+mxv*(mm-1)+mxyv*(lm-1))];
+#pragma omp atomic
+            cu[2+4*(i+noff+nxv*(mm+moff-1)+nxyv*(lm+loff-1))]
+            += scu[2+4*(i+mxv*(mm-1)+mxyv*(lm-1))];
+         }
+      }
+      for (j = 0; j < mm; j++) {
+#pragma omp atomic
+         cu[4*(noff+nxv*(j+moff)+nxyv*(lm+loff-1))]
+         += scu[4*(mxv*j+mxyv*(lm-1))];
+#pragma omp atomic
+         cu[1+4*(noff+nxv*(j+moff)+nxyv*(lm+loff-1))]
+         += scu[1+4*(mxv*j+mxyv*(lm-1))];
+#pragma omp atomic
+         cu[2+4*(noff+nxv*(j+moff)+nxyv*(lm+loff-1))]
+         += scu[2+4*(mxv*j+mxyv*(lm-1))];
+         if (nm > mx) {
+#pragma omp atomic
+            cu[4*(nm+noff-1+nxv*(j+moff)+nxyv*(lm+loff-1))]
+            += scu[4*(nm-1+mxv*j+mxyv*(lm-1))];
+#pragma omp atomic
+            cu[1+4*(nm+noff-1+nxv*(j+moff)+nxyv*(lm+loff-1))]
+            += scu[1+4*(nm-1+mxv*j+mxyv*(lm-1))];
+#pragma omp atomic
+            cu[2+4*(nm+noff-1+nxv*(j+moff)+nxyv*(lm+loff-1))]
+            += scu[2+4*(nm-1+mxv*j+mxyv*(lm-1))];
+         }
+      }
+   }
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+static inline AVX512F __m512 cavx512gint3(float s[], __m512i v_i[],
+                                          __m512 v_amx, __m512 v_amy,
+                                          __m512 v_dyp, __m512 v_dx1,
+                                          __m512 v_amz, __m512 v_dzp) {
+/* interpolate one component of a local tile field for 16 particles
+   from the 8 nearest grid points, whose addresses are in v_i       */
+   __m512 a, b;
+   a = _mm512_mul_ps(v_amx,_mm512_i32gather_ps(v_i[0],s,4));
+   a = _mm512_fmadd_ps(v_amy,_mm512_i32gather_ps(v_i[1],s,4),a);
+   a = _mm512_fmadd_ps(v_dyp,_mm512_i32gather_ps(v_i[2],s,4),a);
+   a = _mm512_fmadd_ps(v_dx1,_mm512_i32gather_ps(v_i[3],s,4),a);
+   b = _mm512_mul_ps(v_amx,_mm512_i32gather_ps(v_i[4],s,4));
+   b = _mm512_fmadd_ps(v_amy,_mm512_i32gather_ps(v_i[5],s,4),b);
+   b = _mm512_fmadd_ps(v_dyp,_mm512_i32gather_ps(v_i[6],s,4),b);
+   b = _mm512_fmadd_ps(v_dx1,_mm512_i32gather_ps(v_i[7],s,4),b);
+   return _mm512_fmadd_ps(v_dzp,b,_mm512_mul_ps(v_amz,a));
+}
+
+/*--------------------------------------------------------------------*/
+static inline AVX2 __m256 cavx2gint3(float s[], __m256i v_i[],
+                                     __m256 v_amx, __m256 v_amy,
+                                     __m256 v_dyp, __m256 v_dx1,
+                                     __m256 v_amz, __m256 v_dzp) {
+/* interpolate one component of a local tile field for 8 particles
+   from the 8 nearest grid points, whose addresses are in v_i      */
+   __m256 a, b;
+   a = _mm256_mul_ps(v_amx,_mm256_i32gather_ps(s,v_i[0],4));
+   a = _mm256_fmadd_ps(v_amy,_mm256_i32gather_ps(s,v_i[1],4),a);
+   a = _mm256_fmadd_ps(v_dyp,_mm256_i32gather_ps(s,v_i[2],4),a);
+   a = _mm256_fmadd_ps(v_dx1,_mm256_i32gather_ps(s,v_i[3],4),a);
+   b = _mm256_mul_ps(v_amx,_mm256_i32gather_ps(s,v_i[4],4));
+   b = _mm256_fmadd_ps(v_amy,_mm256_i32gather_ps(s,v_i[5],4),b);
+   b = _mm256_fmadd_ps(v_dyp,_mm256_i32gather_ps(s,v_i[6],4),b);
+   b = _mm256_fmadd_ps(v_dx1,_mm256_i32gather_ps(s,v_i[7],4),b);
+   return _mm256_fmadd_ps(v_dzp,b,_mm256_mul_ps(v_amz,a));
+}
+
+/*--------------------------------------------------------------------*/
+static AVX512F void cavx512bppush3lt(float ppart[], float fxyz[],
+                                     float bxyz[], int kpic[], float qbm,
+                                     float dt, float dtc, float ci,
+                                     float *ek, int idimp, int nppmx,
+                                     int nx, int ny, int nz, int mx,
+                                     int my, int mz, int nxv, int nyv,
+                                     int nzv, int mx1, int my1,
+                                     int mxyz1, int ipbc, int lrel) {
+/* AVX-512F version of cgbppush3lt (lrel = 0) and cgrbppush3lt (lrel = 1)
+   particles are processed in blocks of 16, the last block is masked
+local data                                                            */
+#define MXV             17
+#define MYV             17
+#define MZV             17
+#define NV              16
+   int mxy1, noff, moff, loff, npoff, npp;
+   int i, j, k, l, nn, mm, ll, mxv, myv, mxyv, nxyv;
+   float qtmh, ci2, edgelx, edgely, edgelz, edgerx, edgery, edgerz;
+   double sum1, sum2;
+   __m512i v_noff, v_moff, v_loff, v_mxv4, v_mxyv4, v_nn, v_mm, v_ll;
+   __m512i v_i[8];
+   __m512 v_qtmh, v_ci2, v_dtc, v_one, v_two, v_half, v_zero;
+   __m512 v_edgelx, v_edgely, v_edgelz, v_edgerx, v_edgery, v_edgerz;
+   __m512 v_xoff, v_yoff, v_zoff, v_x, v_y, v_z, v_vx, v_vy, v_vz;
+   __m512 v_dxp, v_dyp, v_dzp, v_amx, v_amy, v_amz, v_dx1;
+   __m512 v_dx, v_dy, v_dz, v_ox, v_oy, v_oz, v_acx, v_acy, v_acz;
+   __m512 v_omxt, v_omyt, v_omzt, v_omt, v_anorm, v_at, v_gami;
+   __m512 v_rot1, v_rot2, v_rot3, v_rot4, v_rot5, v_rot6, v_rot7;
+   __m512 v_rot8, v_rot9;
+   __m512d v_sum1;
+   __mmask16 msk, mskr;
+   float sfxyz[4*MXV*MYV*MZV], sbxyz[4*MXV*MYV*MZV];
+/* float sfxyz[4*(mx+1)*(my+1)*(mz+1)]; */
+/* float sbxyz[4*(mx+1)*(my+1)*(mz+1)]; */
+   mxy1 = mx1*my1;
+/* mxv = MXV; */
+/* myv = MYV; */
+   mxv = mx+1;
+   myv = my+1;
+   mxyv = mxv*myv;
+   nxyv = nxv*nyv;
+   qtmh = 0.5f*qbm*dt;
+   ci2 = ci*ci;
+   sum2 = 0.0;
+/* set boundary values */
+   edgelx = 0.0f;
+   edgely = 0.0f;
+   edgelz = 0.0f;
+   edgerx = (float) nx;
+   edgery = (float) ny;
+   edgerz = (float) nz;
+   if (ipbc==2) {
+      edgelx = 1.0f;
+      edgely = 1.0f;
+      edgelz = 1.0f;
+      edgerx = (float) (nx-1);
+      edgery = (float) (ny-1);
+      edgerz = (float) (nz-1);
+   }
+   else if (ipbc==3) {
+      edgelx = 1.0f;
+      edgely = 1.0f;
+      edgerx = (float) (nx-1);
+      edgery = (float) (ny-1);
+   }
+   v_mxv4 = _mm512_set1_epi32(4*mxv);
+   v_mxyv4 = _mm512_set1_epi32(4*mxyv);
+   v_qtmh = _mm512_set1_ps(qtmh);
+   v_ci2 = _mm512_set1_ps(ci2);
+   v_dtc = _mm512_set1_ps(dtc);
+   v_one = _mm512_set1_ps(1.0f);
+   v_two = _mm512_set1_ps(2.0f);
+   v_half = _mm512_set1_ps(0.5f);
+   v_zero = _mm512_setzero_ps();
+   v_edgelx = _mm512_set1_ps(edgelx);
+   v_edgely = _mm512_set1_ps(edgely);
+   v_edgelz = _mm512_set1_ps(edgelz);
+   v_edgerx = _mm512_set1_ps(edgerx);
+   v_edgery = _mm512_set1_ps(edgery);
+   v_edgerz = _mm512_set1_ps(edgerz);
+/* error if local array is too small                */
+/* if ((mx >= MXV) || (my >= MYV) || (mz >= MZV))   */
+/*    return;                                       */
+/* loop over tiles */
+#pragma omp parallel for \
+private(i,j,k,l,noff,moff,loff,npp,npoff,nn,mm,ll,sum1,v_noff,v_moff, \
+v_loff,v_nn,v_mm,v_ll,v_i,v_xoff,v_yoff,v_zoff,v_x,v_y,v_z,v_vx,v_vy, \
+v_vz,v_dxp,v_dyp,v_dzp,v_amx,v_amy,v_amz,v_dx1,v_dx,v_dy,v_dz,v_ox, \
+v_oy,v_oz,v_acx,v_acy,v_acz,v_omxt,v_omyt,v_omzt,v_omt,v_anorm,v_at, \
+v_gami,v_rot1,v_rot2,v_rot3,v_rot4,v_rot5,v_rot6,v_rot7,v_rot8,v_rot9, \
+v_sum1,msk,mskr,sfxyz,sbxyz) \
+reduction(+:sum2)
+   for (l = 0; l < mxyz1; l++) {
+      loff = l/mxy1;
+      k = l - mxy1*loff;
+      loff = mz*loff;
+      noff = k/mx1;
+      moff = my*noff;
+      noff = mx*(k - mx1*noff);
+      v_noff = _mm512_set1_epi32(noff);
+      v_moff = _mm512_set1_epi32(moff);
+      v_loff = _mm512_set1_epi32(loff);
+/* positions used for inactive lanes in last block */
+      v_xoff = _mm512_set1_ps((float) noff);
+      v_yoff = _mm512_set1_ps((float) moff);
+      v_zoff = _mm512_set1_ps((float) loff);
+      npp = kpic[l];
+      npoff = idimp*nppmx*l;
+/* load local fields from global array */
+      nn = (mx < nx-noff ? mx : nx-noff) + 1;
+      mm = (my < ny-moff ? my : ny-moff) + 1;
+      ll = (mz < nz-loff ? mz : nz-loff) + 1;
+      cavxgetf3l(sfxyz,fxyz,noff,moff,loff,nn,mm,ll,mxv,mxyv,nxv,nxyv);
+      cavxgetf3l(sbxyz,bxyz,noff,moff,loff,nn,mm,ll,mxv,mxyv,nxv,nxyv);
+      v_sum1 = _mm512_setzero_pd();
+/* loop over particles in tile in blocks of 16 */
+      for (j = 0; j < npp; j+=NV) {
+         i = npp - j;
+         msk = i < NV ? (__mmask16) ((1 << i) - 1) : (__mmask16) 0xFFFF;
+/* find interpolation weights */
+         v_x = _mm512_mask_loadu_ps(v_xoff,msk,&ppart[j+npoff]);
+         v_y = _mm512_mask_loadu_ps(v_yoff,msk,&ppart[j+nppmx+npoff]);
+         v_z = _mm512_mask_loadu_ps(v_zoff,msk,&ppart[j+2*nppmx+npoff]);
+         v_nn = _mm512_cvttps_epi32(v_x);
+         v_mm = _mm512_cvttps_epi32(v_y);
+         v_ll = _mm512_cvttps_epi32(v_z);
+         v_dxp = _mm512_sub_ps(v_x,_mm512_cvtepi32_ps(v_nn));
+         v_dyp = _mm512_sub_ps(v_y,_mm512_cvtepi32_ps(v_mm));
+         v_dzp = _mm512_sub_ps(v_z,_mm512_cvtepi32_ps(v_ll));
+/* nn = 4*(nn - noff + mxv*(mm - moff) + mxyv*(ll - loff)) */
+         v_nn = _mm512_slli_epi32(_mm512_sub_epi32(v_nn,v_noff),2);
+         v_mm = _mm512_mullo_epi32(v_mxv4,_mm512_sub_epi32(v_mm,v_moff));
+         v_ll = _mm512_mullo_epi32(v_mxyv4,_mm512_sub_epi32(v_ll,v_loff));
+         v_i[0] = _mm512_add_epi32(_mm512_add_epi32(v_nn,v_mm),v_ll);
+         v_i[1] = _mm512_add_epi32(v_i[0],_mm512_set1_epi32(4));
+         v_i[2] = _mm512_add_epi32(v_i[0],v_mxv4);
+         v_i[3] = _mm512_add_epi32(v_i[2],_mm512_set1_epi32(4));
+         v_i[4] = _mm512_add_epi32(v_i[0],v_mxyv4);
+         v_i[5] = _mm512_add_epi32(v_i[1],v_mxyv4);
+         v_i[6] = _mm512_add_epi32(v_i[2],v_mxyv4);
+         v_i[7] = _mm512_add_epi32(v_i[3],v_mxyv4);
+         v_amx = _mm512_sub_ps(v_one,v_dxp);
+         v_amy = _mm512_sub_ps(v_one,v_dyp);
+         v_dx1 = _mm512_mul_ps(v_dxp,v_dyp);
+         v_dyp = _mm512_mul_ps(v_amx,v_dyp);
+         v_amx = _mm512_mul_ps(v_amx,v_amy);
+         v_amz = _mm512_sub_ps(v_one,v_dzp);
+         v_amy = _mm512_mul_ps(v_dxp,v_amy);
+/* find electric field */
+         v_dx = cavx512gint3(&sfxyz[0],v_i,v_amx,v_amy,v_dyp,v_dx1,v_amz,
+                             v_dzp);
+         v_dy = cavx512gint3(&sfxyz[1],v_i,v_amx,v_amy,v_dyp,v_dx1,v_amz,
+                             v_dzp);
+         v_dz = cavx512gint3(&sfxyz[2],v_i,v_amx,v_amy,v_dyp,v_dx1,v_amz,
+                             v_dzp);
+/* find magnetic field */
+         v_ox = cavx512gint3(&sbxyz[0],v_i,v_amx,v_amy,v_dyp,v_dx1,v_amz,
+                             v_dzp);
+         v_oy = cavx512gint3(&sbxyz[1],v_i,v_amx,v_amy,v_dyp,v_dx1,v_amz,
+                             v_dzp);
+         v_oz = cavx512gint3(&sbxyz[2],v_i,v_amx,v_amy,v_dyp,v_dx1,v_amz,
+                             v_dzp);
+/* calculate half impulse */
+         v_dx = _mm512_mul_ps(v_dx,v_qtmh);
+         v_dy = _mm512_mul_ps(v_dy,v_qtmh);
+         v_dz = _mm512_mul_ps(v_dz,v_qtmh);
+/* half acceleration */
+         v_vx = _mm512_maskz_loadu_ps(msk,&ppart[j+3*nppmx+npoff]);
+         v_vy = _mm512_maskz_loadu_ps(msk,&ppart[j+4*nppmx+npoff]);
+         v_vz = _mm512_maskz_loadu_ps(msk,&ppart[j+5*nppmx+npoff]);
+         v_acx = _mm512_add_ps(v_vx,v_dx);
+         v_acy = _mm512_add_ps(v_vy,v_dy);
+         v_acz = _mm512_add_ps(v_vz,v_dz);
+         v_at = _mm512_mul_ps(v_acx,v_acx);
+         v_at = _mm512_fmadd_ps(v_acy,v_acy,v_at);
+         v_at = _mm512_fmadd_ps(v_acz,v_acz,v_at);
+         if (lrel) {
+/* find inverse gamma */
+            v_gami = _mm512_div_ps(v_one,_mm512_sqrt_ps(_mm512_fmadd_ps(
+                     v_at,v_ci2,v_one)));
+/* time-centered kinetic energy */
+            v_at = _mm512_div_ps(_mm512_mul_ps(v_gami,v_at),
+                                 _mm512_add_ps(v_one,v_gami));
+/* renormalize magnetic field */
+            v_omt = _mm512_mul_ps(v_qtmh,v_gami);
+         }
+         else {
+            v_omt = v_qtmh;
+         }
+/* time-centered kinetic energy, inactive lanes are zeroed */
+         v_at = _mm512_maskz_mov_ps(msk,v_at);
+         v_sum1 = _mm512_add_pd(v_sum1,_mm512_cvtps_pd(
+                  _mm512_castps512_ps256(v_at)));
+         v_sum1 = _mm512_add_pd(v_sum1,_mm512_cvtps_pd(_mm256_castpd_ps(
+                  _mm512_extractf64x4_pd(_mm512_castps_pd(v_at),1))));
+/* calculate cyclotron frequency */
+         v_omxt = _mm512_mul_ps(v_omt,v_ox);
+         v_omyt = _mm512_mul_ps(v_omt,v_oy);
+         v_omzt = _mm512_mul_ps(v_omt,v_oz);
+/* calculate rotation matrix */
+         v_omt = _mm512_mul_ps(v_omxt,v_omxt);
+         v_omt = _mm512_fmadd_ps(v_omyt,v_omyt,v_omt);
+         v_omt = _mm512_fmadd_ps(v_omzt,v_omzt,v_omt);
+         v_anorm = _mm512_div_ps(v_two,_mm512_add_ps(v_one,v_omt));
+         v_omt = _mm512_mul_ps(v_half,_mm512_sub_ps(v_one,v_omt));
+         v_rot4 = _mm512_mul_ps(v_omxt,v_omyt);
+         v_rot7 = _mm512_mul_ps(v_omxt,v_omzt);
+         v_rot8 = _mm512_mul_ps(v_omyt,v_omzt);
+         v_rot1 = _mm512_fmadd_ps(v_omxt,v_omxt,v_omt);
+         v_rot5 = _mm512_fmadd_ps(v_omyt,v_omyt,v_omt);
+         v_rot9 = _mm512_fmadd_ps(v_omzt,v_omzt,v_omt);
+         v_rot2 = _mm512_add_ps(v_omzt,v_rot4);
+         v_rot4 = _mm512_sub_ps(v_rot4,v_omzt);
+         v_rot3 = _mm512_sub_ps(v_rot7,v_omyt);
+         v_rot7 = _mm512_add_ps(v_rot7,v_omyt);
+         v_rot6 = _mm512_add_ps(v_omxt,v_rot8);
+         v_rot8 = _mm512_sub_ps(v_rot8,v_omxt);
+/* new velocity */
+         v_vx = _mm512_mul_ps(v_rot1,v_acx);
+         v_vx = _mm512_fmadd_ps(v_rot2,v_acy,v_vx);
+         v_vx = _mm512_fmadd_ps(v_rot3,v_acz,v_vx);
+         v_vx = _mm512_fmadd_ps(v_vx,v_anorm,v_dx);
+         v_vy = _mm512_mul_ps(v_rot4,v_acx);
+         v_vy = _mm512_fmadd_ps(v_rot5,v_acy,v_vy);
+         v_vy = _mm512_fmadd_ps(v_rot6,v_acz,v_vy);
+         v_vy = _mm512_fmadd_ps(v_vy,v_anorm,v_dy);
+         v_vz = _mm512_mul_ps(v_rot7,v_acx);
+         v_vz = _mm512_fmadd_ps(v_rot8,v_acy,v_vz);
+         v_vz = _mm512_fmadd_ps(v_rot9,v_acz,v_vz);
+         v_vz = _mm512_fmadd_ps(v_vz,v_anorm,v_dz);
+/* update inverse gamma */
+         if (lrel) {
+            v_at = _mm512_mul_ps(v_vx,v_vx);
+            v_at = _mm512_fmadd_ps(v_vy,v_vy,v_at);
+            v_at = _mm512_fmadd_ps(v_vz,v_vz,v_at);
+            v_at = _mm512_div_ps(v_dtc,_mm512_sqrt_ps(_mm512_fmadd_ps(
+                   v_at,v_ci2,v_one)));
+         }
+         else {
+            v_at = v_dtc;
+         }
+/* new position */
+         v_dx = _mm512_fmadd_ps(v_vx,v_at,v_x);
+         v_dy = _mm512_fmadd_ps(v_vy,v_at,v_y);
+         v_dz = _mm512_fmadd_ps(v_vz,v_at,v_z);
+/* reflecting boundary conditions */
+         if ((ipbc==2) || (ipbc==3)) {
+            mskr = _mm512_cmp_ps_mask(v_dx,v_edgelx,_CMP_LT_OQ)
+                 | _mm512_cmp_ps_mask(v_dx,v_edgerx,_CMP_GE_OQ);
+            v_dx = _mm512_mask_blend_ps(mskr,v_dx,v_x);
+            v_vx = _mm512_mask_sub_ps(v_vx,mskr,v_zero,v_vx);
+            mskr = _mm512_cmp_ps_mask(v_dy,v_edgely,_CMP_LT_OQ)
+                 | _mm512_cmp_ps_mask(v_dy,v_edgery,_CMP_GE_OQ);
+            v_dy = _mm512_mask_blend_ps(mskr,v_dy,v_y);
+            v_vy = _mm512_mask_sub_ps(v_vy,mskr,v_zero,v_vy);
+/* mixed reflecting/periodic boundary conditions do not reflect in z */
+            if (ipbc==2) {
+               mskr = _mm512_cmp_ps_mask(v_dz,v_edgelz,_CMP_LT_OQ)
+                    | _mm512_cmp_ps_mask(v_dz,v_edgerz,_CMP_GE_OQ);
+               v_dz = _mm512_mask_blend_ps(mskr,v_dz,v_z);
+               v_vz = _mm512_mask_sub_ps(v_vz,mskr,v_zero,v_vz);
+            }
+         }
+/* set new position */
+         _mm512_mask_storeu_ps(&ppart[j+npoff],msk,v_dx);
+         _mm512_mask_storeu_ps(&ppart[j+nppmx+npoff],msk,v_dy);
+         _mm512_mask_storeu_ps(&ppart[j+2*nppmx+npoff],msk,v_dz);
+/* set new velocity */
+         _mm512_mask_storeu_ps(&ppart[j+3*nppmx+npoff],msk,v_vx);
+         _mm512_mask_storeu_ps(&ppart[j+4*nppmx+npoff],msk,v_vy);
+         _mm512_mask_storeu_ps(&ppart[j+5*nppmx+npoff],msk,v_vz);
+      }
+      sum1 = _mm512_reduce_add_pd(v_sum1);
+      sum2 += sum1;
+   }
+/* normalize kinetic energy */
+   if (lrel)
+      *ek += sum2;
+   else
+      *ek += 0.5f*sum2;
+   return;
+#undef NV
+#undef MXV
+#undef MYV
+#undef MZV
+}
+
+/*--------------------------------------------------------------------*/
+static AVX2 void cavx2bppush3lt(float ppart[], float fxyz[],
+                                float bxyz[], int kpic[], float qbm,
+                                float dt, float dtc, float ci, float *ek,
+                                int idimp, int nppmx, int nx, int ny,
+                                int nz, int mx, int my, int mz, int nxv,
+                                int nyv, int nzv, int mx1, int my1,
+                                int mxyz1, int ipbc, int lrel) {
+/* AVX2 version of cgbppush3lt (lrel = 0) and cgrbppush3lt (lrel = 1)
+   particles are processed in blocks of 8, the last block is masked
+local data                                                            */
+#define MXV             17
+#define MYV             17
+#define MZV             17
+#define NV              8
+   int mxy1, noff, moff, loff, npoff, npp;
+   int j, k, l, nn, mm, ll, mxv, myv, mxyv, nxyv;
+   float qtmh, ci2, edgelx, edgely, edgelz, edgerx, edgery, edgerz;
+   double sum1, sum2;
+   __m256i v_noff, v_moff, v_loff, v_mxv4, v_mxyv4, v_nn, v_mm, v_ll;
+   __m256i v_i[8], v_it, v_msk;
+   __m256 v_qtmh, v_ci2, v_dtc, v_one, v_two, v_half, v_zero;
+   __m256 v_edgelx, v_edgely, v_edgelz, v_edgerx, v_edgery, v_edgerz;
+   __m256 v_xoff, v_yoff, v_zoff, v_x, v_y, v_z, v_vx, v_vy, v_vz;
+   __m256 v_dxp, v_dyp, v_dzp, v_amx, v_amy, v_amz, v_dx1;
+   __m256 v_dx, v_dy, v_dz, v_ox, v_oy, v_oz, v_acx, v_acy, v_acz;
+   __m256 v_omxt, v_omyt, v_omzt, v_omt, v_anorm, v_at, v_gami;
+   __m256 v_rot1, v_rot2, v_rot3, v_rot4, v_rot5, v_rot6, v_rot7;
+   __m256 v_rot8, v_rot9, v_mskr;
+   __m256d v_sum1;
+   double dd[4];
+   float sfxyz[4*MXV*MYV*MZV], sbxyz[4*MXV*MYV*MZV];
+/* float sfxyz[4*(mx+1)*(my+1)*(mz+1)]; */
+/* float sbxyz[4*(mx+1)*(my+1)*(mz+1)]; */
+   mxy1 = mx1*my1;
+/* mxv = MXV; */
+/* myv = MYV; */
+   mxv = mx+1;
+   myv = my+1;
+   mxyv = mxv*myv;
+   nxyv = nxv*nyv;
+   qtmh = 0.5f*qbm*dt;
+   ci2 = ci*ci;
+   sum2 = 0.0;
+/* set boundary values */
+   edgelx = 0.0f;
+   edgely = 0.0f;
+   edgelz = 0.0f;
+   edgerx = (float) nx;
+   edgery = (float) ny;
+   edgerz = (float) nz;
+   if (ipbc==2) {
+      edgelx = 1.0f;
+      edgely = 1.0f;
+      edgelz = 1.0f;
+      edgerx = (float) (nx-1);
+      edgery = (float) (ny-1);
+      edgerz = (float) (nz-1);
+   }
+   else if (ipbc==3) {
+      edgelx = 1.0f;
+      edgely = 1.0f;
+      edgerx = (float) (nx-1);
+      edgery = (float) (ny-1);
+   }
+   v_it = _mm256_setr_epi32(0,1,2,3,4,5,6,7);
+   v_mxv4 = _mm256_set1_epi32(4*mxv);
+   v_mxyv4 = _mm256_set1_epi32(4*mxyv);
+   v_qtmh = _mm256_set1_ps(qtmh);
+   v_ci2 = _mm256_set1_ps(ci2);
+   v_dtc = _mm256_set1_ps(dtc);
+   v_one = _mm256_set1_ps(1.0f);
+   v_two = _mm256_set1_ps(2.0f);
+   v_half = _mm256_set1_ps(0.5f);
+   v_zero = _mm256_setzero_ps();
+   v_edgelx = _mm256_set1_ps(edgelx);
+   v_edgely = _mm256_set1_ps(edgely);
+   v_edgelz = _mm256_set1_ps(edgelz);
+   v_edgerx = _mm256_set1_ps(edgerx);
+   v_edgery = _mm256_set1_ps(edgery);
+   v_edgerz = _mm256_set1_ps(edgerz);
+/* error if local array is too small                */
+/* if ((mx >= MXV) || (my >= MYV) || (mz >= MZV))   */
+/*    return;                                       */
+/* loop over tiles */
+#pragma omp parallel for \
+private(j,k,l,noff,moff,loff,npp,npoff,nn,mm,ll,sum1,v_noff,v_moff, \
+v_loff,v_nn,v_mm,v_ll,v_i,v_msk,v_xoff,v_yoff,v_zoff,v_x,v_y,v_z,v_vx, \
+v_vy,v_vz,v_dxp,v_dyp,v_dzp,v_amx,v_amy,v_amz,v_dx1,v_dx,v_dy,v_dz, \
+v_ox,v_oy,v_oz,v_acx,v_acy,v_acz,v_omxt,v_omyt,v_omzt,v_omt,v_anorm, \
+v_at,v_gami,v_rot1,v_rot2,v_rot3,v_rot4,v_rot5,v_rot6,v_rot7,v_rot8, \
+v_rot9,v_mskr,v_sum1,dd,sfxyz,sbxyz) \
+reduction(+:sum2)
+   for (l = 0; l < mxyz1; l++) {
+      loff = l/mxy1;
+      k = l - mxy1*loff;
+      loff = mz*loff;
+      noff = k/mx1;
+      moff = my*noff;
+      noff = mx*(k - mx1*noff);
+      v_noff = _mm256_set1_epi32(noff);
+      v_moff = _mm256_set1_epi32(moff);
+      v_loff = _mm256_set1_epi32(loff);
+/* positions used for inactive lanes in last block */
+      v_xoff = _mm256_set1_ps((float) noff);
+      v_yoff = _mm256_set1_ps((float) moff);
+      v_zoff = _mm256_set1_ps((float) loff);
+      npp = kpic[l];
+      npoff = idimp*nppmx*l;
+/* load local fields from global array */
+      nn = (mx < nx-noff ? mx : nx-noff) + 1;
+      mm = (my < ny-moff ? my : ny-moff) + 1;
+      ll = (mz < nz-loff ? mz : nz-loff) + 1;
+      cavxgetf3l(sfxyz,fxyz,noff,moff,loff,nn,mm,ll,mxv,mxyv,nxv,nxyv);
+      cavxgetf3l(sbxyz,bxyz,noff,moff,loff,nn,mm,ll,mxv,mxyv,nxv,nxyv);
+      v_sum1 = _mm256_setzero_pd();
+/* loop over particles in tile in blocks of 8 */
+      for (j = 0; j < npp; j+=NV) {
+         v_msk = _mm256_cmpgt_epi32(_mm256_set1_epi32(npp-j),v_it);
+/* find interpolation weights */
+         v_x = _mm256_blendv_ps(v_xoff,_mm256_maskload_ps(&ppart[j+npoff],
+               v_msk),_mm256_castsi256_ps(v_msk));
+         v_y = _mm256_blendv_ps(v_yoff,_mm256_maskload_ps(
+               &ppart[j+nppmx+npoff],v_msk),_mm256_castsi256_ps(v_msk));
+         v_z = _mm256_blendv_ps(v_zoff,_mm256_maskload_ps(
+               &ppart[j+2*nppmx+npoff],v_msk),_mm256_castsi256_ps(v_msk));
+         v_nn = _mm256_cvttps_epi32(v_x);
+         v_mm = _mm256_cvttps_epi32(v_y);
+         v_ll = _mm256_cvttps_epi32(v_z);
+         v_dxp = _mm256_sub_ps(v_x,_mm256_cvtepi32_ps(v_nn));
+         v_dyp = _mm256_sub_ps(v_y,_mm256_cvtepi32_ps(v_mm));
+         v_dzp = _mm256_sub_ps(v_z,_mm256_cvtepi32_ps(v_ll));
+/* nn = 4*(nn - noff + mxv*(mm - moff) + mxyv*(ll - loff)) */
+         v_nn = _mm256_slli_epi32(_mm256_sub_epi32(v_nn,v_noff),2);
+         v_mm = _mm256_mullo_epi32(v_mxv4,_mm256_sub_epi32(v_mm,v_moff));
+         v_ll = _mm256_mullo_epi32(v_mxyv4,_mm256_sub_epi32(v_ll,v_loff));
+         v_i[0] = _mm256_add_epi32(_mm256_add_epi32(v_nn,v_mm),v_ll);
+         v_i[1] = _mm256_add_epi32(v_i[0],_mm256_set1_epi32(4));
+         v_i[2] = _mm256_add_epi32(v_i[0],v_mxv4);
+         v_i[3] = _mm256_add_epi32(v_i[2],_mm256_set1_epi32(4));
+         v_i[4] = _mm256_add_epi32(v_i[0],v_mxyv4);
+         v_i[5] = _mm256_add_epi32(v_i[1],v_mxyv4);
+         v_i[6] = _mm256_add_epi32(v_i[2],v_mxyv4);
+         v_i[7] = _mm256_add_epi32(v_i[3],v_mxyv4);
+         v_amx = _mm256_sub_ps(v_one,v_dxp);
+         v_amy = _mm256_sub_ps(v_one,v_dyp);
+         v_dx1 = _mm256_mul_ps(v_dxp,v_dyp);
+         v_dyp = _mm256_mul_ps(v_amx,v_dyp);
+         v_amx = _mm256_mul_ps(v_amx,v_amy);
+         v_amz = _mm256_sub_ps(v_one,v_dzp);
+         v_amy = _mm256_mul_ps(v_dxp,v_amy);
+/* find electric field */
+         v_dx = cavx2gint3(&sfxyz[0],v_i,v_amx,v_amy,v_dyp,v_dx1,v_amz,
+                           v_dzp);
+         v_dy = cavx2gint3(&sfxyz[1],v_i,v_amx,v_amy,v_dyp,v_dx1,v_amz,
+                           v_dzp);
+         v_dz = cavx2gint3(&sfxyz[2],v_i,v_amx,v_amy,v_dyp,v_dx1,v_amz,
+                           v_dzp);
+/* find magnetic field */
+         v_ox = cavx2gint3(&sbxyz[0],v_i,v_amx,v_amy,v_dyp,v_dx1,v_amz,
+                           v_dzp);
+         v_oy = cavx2gint3(&sbxyz[1],v_i,v_amx,v_amy,v_dyp,v_dx1,v_amz,
+                           v_dzp);
+         v_oz = cavx2gint3(&sbxyz[2],v_i,v_amx,v_amy,v_dyp,v_dx1,v_amz,
+                           v_dzp);
+/* calculate half impulse */
+         v_dx = _mm256_mul_ps(v_dx,v_qtmh);
+         v_dy = _mm256_mul_ps(v_dy,v_qtmh);
+         v_dz = _mm256_mul_ps(v_dz,v_qtmh);
+/* half acceleration */
+         v_vx = _mm256_maskload_ps(&ppart[j+3*nppmx+npoff],v_msk);
+         v_vy = _mm256_maskload_ps(&ppart[j+4*nppmx+npoff],v_msk);
+         v_vz = _mm256_maskload_ps(&ppart[j+5*nppmx+npoff],v_msk);
+         v_acx = _mm256_add_ps(v_vx,v_dx);
+         v_acy = _mm256_add_ps(v_vy,v_dy);
+         v_acz = _mm256_add_ps(v_vz,v_dz);
+         v_at = _mm256_mul_ps(v_acx,v_acx);
+         v_at = _mm256_fmadd_ps(v_acy,v_acy,v_at);
+         v_at = _mm256_fmadd_ps(v_acz,v_acz,v_at);
+         if (lrel) {
+/* find inverse gamma */
+            v_gami = _mm256_div_ps(v_one,_mm256_sqrt_ps(_mm256_fmadd_ps(
+                     v_at,v_ci2,v_one)));
+/* time-centered kinetic energy */
+            v_at = _mm256_div_ps(_mm256_mul_ps(v_gami,v_at),
+                                 _mm256_add_ps(v_one,v_gami));
+/* renormalize magnetic field */
+            v_omt = _mm256_mul_ps(v_qtmh,v_gami);
+         }
+         else {
+            v_omt = v_qtmh;
+         }
+/* time-centered kinetic energy, inactive lanes are zeroed */
+         v_at = _mm256_and_ps(v_at,_mm256_castsi256_ps(v_msk));
+         v_sum1 = _mm256_add_pd(v_sum1,_mm256_cvtps_pd(
+                  _mm256_castps256_ps128(v_at)));
+         v_sum1 = _mm256_add_pd(v_sum1,_mm256_cvtps_pd(
+                  _mm256_extractf128_ps(v_at,1)));
+/* calculate cyclotron frequency */
+         v_omxt = _mm256_mul_ps(v_omt,v_ox);
+         v_omyt = _mm256_mul_ps(v_omt,v_oy);
+         v_omzt = _mm256_mul_ps(v_omt,v_oz);
+/* calculate rotation matrix */
+         v_omt = _mm256_mul_ps(v_omxt,v_omxt);
+         v_omt = _mm256_fmadd_ps(v_omyt,v_omyt,v_omt);
+         v_omt = _mm256_fmadd_ps(v_omzt,v_omzt,v_omt);
+         v_anorm = _mm256_div_ps(v_two,_mm256_add_ps(v_one,v_omt));
+         v_omt = _mm256_mul_ps(v_half,_mm256_sub_ps(v_one,v_omt));
+         v_rot4 = _mm256_mul_ps(v_omxt,v_omyt);
+         v_rot7 = _mm256_mul_ps(v_omxt,v_omzt);
+         v_rot8 = _mm256_mul_ps(v_omyt,v_omzt);
+         v_rot1 = _mm256_fmadd_ps(v_omxt,v_omxt,v_omt);
+         v_rot5 = _mm256_fmadd_ps(v_omyt,v_omyt,v_omt);
+         v_rot9 = _mm256_fmadd_ps(v_omzt,v_omzt,v_omt);
+         v_rot2 = _mm256_add_ps(v_omzt,v_rot4);
+         v_rot4 = _mm256_sub_ps(v_rot4,v_omzt);
+         v_rot3 = _mm256_sub_ps(v_rot7,v_omyt);
+         v_rot7 = _mm256_add_ps(v_rot7,v_omyt);
+         v_rot6 = _mm256_add_ps(v_omxt,v_rot8);
+         v_rot8 = _mm256_sub_ps(v_rot8,v_omxt);
+/* new velocity */
+         v_vx = _mm256_mul_ps(v_rot1,v_acx);
+         v_vx = _mm256_fmadd_ps(v_rot2,v_acy,v_vx);
+         v_vx = _mm256_fmadd_ps(v_rot3,v_acz,v_vx);
+         v_vx = _mm256_fmadd_ps(v_vx,v_anorm,v_dx);
+         v_vy = _mm256_mul_ps(v_rot4,v_acx);
+         v_vy = _mm256_fmadd_ps(v_rot5,v_acy,v_vy);
+         v_vy = _mm256_fmadd_ps(v_rot6,v_acz,v_vy);
+         v_vy = _mm256_fmadd_ps(v_vy,v_anorm,v_dy);
+         v_vz = _mm256_mul_ps(v_rot7,v_acx);
+         v_vz = _mm256_fmadd_ps(v_rot8,v_acy,v_vz);
+         v_vz = _mm256_fmadd_ps(v_rot9,v_acz,v_vz);
+         v_vz = _mm256_fmadd_ps(v_vz,v_anorm,v_dz);
+/* update inverse gamma */
+         if (lrel) {
+            v_at = _mm256_mul_ps(v_vx,v_vx);
+            v_at = _mm256_fmadd_ps(v_vy,v_vy,v_at);
+            v_at = _mm256_fmadd_ps(v_vz,v_vz,v_at);
+            v_at = _mm256_div_ps(v_dtc,_mm256_sqrt_ps(_mm256_fmadd_ps(
+                   v_at,v_ci2,v_one)));
+         }
+         else {
+            v_at = v_dtc;
+         }
+/* new position */
+         v_dx = _mm256_fmadd_ps(v_vx,v_at,v_x);
+         v_dy = _mm256_fmadd_ps(v_vy,v_at,v_y);
+         v_dz = _mm256_fmadd_ps(v_vz,v_at,v_z);
+/* reflecting boundary conditions */
+         if ((ipbc==2) || (ipbc==3)) {
+            v_mskr = _mm256_or_ps(_mm256_cmp_ps(v_dx,v_edgelx,_CMP_LT_OQ),
+                     _mm256_cmp_ps(v_dx,v_edgerx,_CMP_GE_OQ));
+            v_dx = _mm256_blendv_ps(v_dx,v_x,v_mskr);
+            v_vx = _mm256_blendv_ps(v_vx,_mm256_sub_ps(v_zero,v_vx),
+                                    v_mskr);
+            v_mskr = _mm256_or_ps(_mm256_cmp_ps(v_dy,v_edgely,_CMP_LT_OQ),
+                     _mm256_cmp_ps(v_dy,v_edgery,_CMP_GE_OQ));
+            v_dy = _mm256_blendv_ps(v_dy,v_y,v_mskr);
+            v_vy = _mm256_blendv_ps(v_vy,_mm256_sub_ps(v_zero,v_vy),
+                                    v_mskr);
+/* mixed reflecting/periodic boundary conditions do not reflect in z */
+            if (ipbc==2) {
+               v_mskr = _mm256_or_ps(_mm256_cmp_ps(v_dz,v_edgelz,
+                        _CMP_LT_OQ),_mm256_cmp_ps(v_dz,v_edgerz,
+                        _CMP_GE_OQ));
+               v_dz = _mm256_blendv_ps(v_dz,v_z,v_mskr);
+               v_vz = _mm256_blendv_ps(v_vz,_mm256_sub_ps(v_zero,v_vz),
+                                       v_mskr);
+            }
+         }
+/* set new position */
+         _mm256_maskstore_ps(&ppart[j+npoff],v_msk,v_dx);
+         _mm256_maskstore_ps(&ppart[j+nppmx+npoff],v_msk,v_dy);
+         _mm256_maskstore_ps(&ppart[j+2*nppmx+npoff],v_msk,v_dz);
+/* set new velocity */
+         _mm256_maskstore_ps(&ppart[j+3*nppmx+npoff],v_msk,v_vx);
+         _mm256_maskstore_ps(&ppart[j+4*nppmx+npoff],v_msk,v_vy);
+         _mm256_maskstore_ps(&ppart[j+5*nppmx+npoff],v_msk,v_vz);
+      }
+      _mm256_storeu_pd(dd,v_sum1);
+      sum1 = (dd[0] + dd[1]) + (dd[2] + dd[3]);
+      sum2 += sum1;
+   }
+/* normalize kinetic energy */
+   if (lrel)
+      *ek += sum2;
+   else
+      *ek += 0.5f*sum2;
+   return;
+#undef NV
+#undef MXV
+#undef MYV
+#undef MZV
+}
+
+/*--------------------------------------------------------------------*/
+static AVX512F void cavx512jppost3lt(float ppart[], float cu[],
+                                     int kpic[], float qm, float dt,
+                                     float ci, int nppmx, int idimp,
+                                     int nx, int ny, int nz, int mx,
+                                     int my, int mz, int nxv, int nyv,
+                                     int nzv, int mx1, int my1,
+                                     int mxyz1, int ipbc, int lrel) {
+/* AVX-512F version of cgjppost3lt (lrel = 0) and cgrjppost3lt
+   (lrel = 1).  weights, addresses and velocities are calculated for 16
+   particles at a time, then the current of each particle is added to
+   the local accumulator with 256 bit vectors, two grid points at a time
+local data                                                            */
+#define MXV             17
+#define MYV             17
+#define MZV             17
+#define NV              16
+   int mxy1, noff, moff, loff, npoff, npp, nps;
+   int i, j, k, l, nn, mm, mxv, myv, mxyv;
+   float ci2, edgelx, edgely, edgelz, edgerx, edgery, edgerz;
+   __m512i v_noff, v_moff, v_loff, v_mxv4, v_mxyv4, v_nn, v_mm, v_ll;
+   __m512 v_qm, v_ci2, v_dt, v_one, v_zero;
+   __m512 v_edgelx, v_edgely, v_edgelz, v_edgerx, v_edgery, v_edgerz;
+   __m512 v_xoff, v_yoff, v_zoff, v_x, v_y, v_z, v_vx, v_vy, v_vz;
+   __m512 v_ux, v_uy, v_uz, v_dxp, v_dyp, v_dzp, v_amx, v_amy, v_amz;
+   __m512 v_dx1, v_dx, v_dy, v_dz, v_at;
+   __m256 a, b, v_v;
+   __mmask16 msk, mskr;
+   __attribute__((aligned(64))) int kk[NV];
+   __attribute__((aligned(64))) float sw[8*NV], sv[3*NV];
+   float scu[4*MXV*MYV*MZV];
+/* float scu[4*(mx+1)*(my+1)*(mz+1)]; */
+   mxy1 = mx1*my1;
+/* mxv = MXV; */
+/* myv = MYV; */
+   mxv = mx+1;
+   myv = my+1;
+   mxyv = mxv*myv;
+   ci2 = ci*ci;
+/* set boundary values */
+   edgelx = 0.0f;
+   edgely = 0.0f;
+   edgelz = 0.0f;
+   edgerx = (float) nx;
+   edgery = (float) ny;
+   edgerz = (float) nz;
+   if (ipbc==2) {
+      edgelx = 1.0f;
+      edgely = 1.0f;
+      edgelz = 1.0f;
+      edgerx = (float) (nx-1);
+      edgery = (float) (ny-1);
+      edgerz = (float) (nz-1);
+   }
+   else if (ipbc==3) {
+      edgelx = 1.0f;
+      edgely = 1.0f;
+      edgerx = (float) (nx-1);
+      edgery = (float) (ny-1);
+   }
+   v_mxv4 = _mm512_set1_epi32(4*mxv);
+   v_mxyv4 = _mm512_set1_epi32(4*mxyv);
+   v_qm = _mm512_set1_ps(qm);
+   v_ci2 = _mm512_set1_ps(ci2);
+   v_dt = _mm512_set1_ps(dt);
+   v_one = _mm512_set1_ps(1.0f);
+   v_zero = _mm512_setzero_ps();
+   v_edgelx = _mm512_set1_ps(edgelx);
+   v_edgely = _mm512_set1_ps(edgely);
+   v_edgelz = _mm512_set1_ps(edgelz);
+   v_edgerx = _mm512_set1_ps(edgerx);
+   v_edgery = _mm512_set1_ps(edgery);
+   v_edgerz = _mm512_set1_ps(edgerz);
+/* error if local array is too small                */
+/* if ((mx >= MXV) || (my >= MYV) || (mz >= MZV))   */
+/*    return;                                       */
+/* loop over tiles */
+#pragma omp parallel for \
+private(i,j,k,l,noff,moff,loff,npp,npoff,nps,nn,mm,v_noff,v_moff, \
+v_loff,v_nn,v_mm,v_ll,v_xoff,v_yoff,v_zoff,v_x,v_y,v_z,v_vx,v_vy,v_vz, \
+v_ux,v_uy,v_uz,v_dxp,v_dyp,v_dzp,v_amx,v_amy,v_amz,v_dx1,v_dx,v_dy, \
+v_dz,v_at,a,b,v_v,msk,mskr,kk,sw,sv,scu)
+   for (l = 0; l < mxyz1; l++) {
+      loff = l/mxy1;
+      k = l - mxy1*loff;
+      loff = mz*loff;
+      noff = k/mx1;
+      moff = my*noff;
+      noff = mx*(k - mx1*noff);
+      v_noff = _mm512_set1_epi32(noff);
+      v_moff = _mm512_set1_epi32(moff);
+      v_loff = _mm512_set1_epi32(loff);
+/* positions used for inactive lanes in last block */
+      v_xoff = _mm512_set1_ps((float) noff);
+      v_yoff = _mm512_set1_ps((float) moff);
+      v_zoff = _mm512_set1_ps((float) loff);
+      npp = kpic[l];
+      npoff = idimp*nppmx*l;
+/* zero out local accumulator */
+      memset(scu,0,4*mxyv*(mz+1)*sizeof(float));
+/* loop over particles in tile in blocks of 16 */
+      for (j = 0; j < npp; j+=NV) {
+         nps = npp - j;
+         nps = nps < NV ? nps : NV;
+         msk = (__mmask16) ((1 << nps) - 1);
+/* find interpolation weights */
+         v_x = _mm512_mask_loadu_ps(v_xoff,msk,&ppart[j+npoff]);
+         v_y = _mm512_mask_loadu_ps(v_yoff,msk,&ppart[j+nppmx+npoff]);
+         v_z = _mm512_mask_loadu_ps(v_zoff,msk,&ppart[j+2*nppmx+npoff]);
+         v_nn = _mm512_cvttps_epi32(v_x);
+         v_mm = _mm512_cvttps_epi32(v_y);
+         v_ll = _mm512_cvttps_epi32(v_z);
+         v_dxp = _mm512_mul_ps(v_qm,_mm512_sub_ps(v_x,
+                 _mm512_cvtepi32_ps(v_nn)));
+         v_dyp = _mm512_sub_ps(v_y,_mm512_cvtepi32_ps(v_mm));
+         v_dzp = _mm512_sub_ps(v_z,_mm512_cvtepi32_ps(v_ll));
+/* nn = 4*(nn - noff + mxv*(mm - moff) + mxyv*(ll - loff)) */
+         v_nn = _mm512_slli_epi32(_mm512_sub_epi32(v_nn,v_noff),2);
+         v_mm = _mm512_mullo_epi32(v_mxv4,_mm512_sub_epi32(v_mm,v_moff));
+         v_ll = _mm512_mullo_epi32(v_mxyv4,_mm512_sub_epi32(v_ll,v_loff));
+         v_nn = _mm512_add_epi32(_mm512_add_epi32(v_nn,v_mm),v_ll);
+         _mm512_store_epi32(kk,v_nn);
+         v_amx = _mm512_sub_ps(v_qm,v_dxp);
+         v_amy = _mm512_sub_ps(v_one,v_dyp);
+         v_dx1 = _mm512_mul_ps(v_dxp,v_dyp);
+         v_dyp = _mm512_mul_ps(v_amx,v_dyp);
+         v_amx = _mm512_mul_ps(v_amx,v_amy);
+         v_amz = _mm512_sub_ps(v_one,v_dzp);
+         v_amy = _mm512_mul_ps(v_dxp,v_amy);
+/* weights for the 8 grid points */
+         _mm512_store_ps(&sw[0],_mm512_mul_ps(v_amx,v_amz));
+         _mm512_store_ps(&sw[NV],_mm512_mul_ps(v_amy,v_amz));
+         _mm512_store_ps(&sw[2*NV],_mm512_mul_ps(v_dyp,v_amz));
+         _mm512_store_ps(&sw[3*NV],_mm512_mul_ps(v_dx1,v_amz));
+         _mm512_store_ps(&sw[4*NV],_mm512_mul_ps(v_amx,v_dzp));
+         _mm512_store_ps(&sw[5*NV],_mm512_mul_ps(v_amy,v_dzp));
+         _mm512_store_ps(&sw[6*NV],_mm512_mul_ps(v_dyp,v_dzp));
+         _mm512_store_ps(&sw[7*NV],_mm512_mul_ps(v_dx1,v_dzp));
+         v_ux = _mm512_maskz_loadu_ps(msk,&ppart[j+3*nppmx+npoff]);
+         v_uy = _mm512_maskz_loadu_ps(msk,&ppart[j+4*nppmx+npoff]);
+         v_uz = _mm512_maskz_loadu_ps(msk,&ppart[j+5*nppmx+npoff]);
+/* find inverse gamma */
+         if (lrel) {
+            v_at = _mm512_mul_ps(v_ux,v_ux);
+            v_at = _mm512_fmadd_ps(v_uy,v_uy,v_at);
+            v_at = _mm512_fmadd_ps(v_uz,v_uz,v_at);
+            v_at = _mm512_div_ps(v_one,_mm512_sqrt_ps(_mm512_fmadd_ps(
+                   v_at,v_ci2,v_one)));
+            v_vx = _mm512_mul_ps(v_ux,v_at);
+            v_vy = _mm512_mul_ps(v_uy,v_at);
+            v_vz = _mm512_mul_ps(v_uz,v_at);
+         }
+         else {
+            v_vx = v_ux;
+            v_vy = v_uy;
+            v_vz = v_uz;
+         }
+         _mm512_store_ps(&sv[0],v_vx);
+         _mm512_store_ps(&sv[NV],v_vy);
+         _mm512_store_ps(&sv[2*NV],v_vz);
+/* deposit current within tile to local accumulator */
+         for (i = 0; i < nps; i++) {
+            nn = kk[i];
+            v_v = _mm256_setr_ps(sv[i],sv[i+NV],sv[i+2*NV],0.0f,sv[i],
+                                 sv[i+NV],sv[i+2*NV],0.0f);
+            mm = nn + 4*mxv;
+            a = _mm256_setr_ps(sw[i],sw[i],sw[i],sw[i],sw[i+NV],
+                               sw[i+NV],sw[i+NV],sw[i+NV]);
+            b = _mm256_loadu_ps(&scu[nn]);
+            _mm256_storeu_ps(&scu[nn],_mm256_fmadd_ps(v_v,a,b));
+            a = _mm256_setr_ps(sw[i+2*NV],sw[i+2*NV],sw[i+2*NV],
+                               sw[i+2*NV],sw[i+3*NV],sw[i+3*NV],
+                               sw[i+3*NV],sw[i+3*NV]);
+            b = _mm256_loadu_ps(&scu[mm]);
+            _mm256_storeu_ps(&scu[mm],_mm256_fmadd_ps(v_v,a,b));
+            nn += 4*mxyv;
+            mm += 4*mxyv;
+            a = _mm256_setr_ps(sw[i+4*NV],sw[i+4*NV],sw[i+4*NV],
+                               sw[i+4*NV],sw[i+5*NV],sw[i+5*NV],
+                               sw[i+5*NV],sw[i+5*NV]);
+            b = _mm256_loadu_ps(&scu[nn]);
+            _mm256_storeu_ps(&scu[nn],_mm256_fmadd_ps(v_v,a,b));
+            a = _mm256_setr_ps(sw[i+6*NV],sw[i+6*NV],sw[i+6*NV],
+                               sw[i+6*NV],sw[i+7*NV],sw[i+7*NV],
+                               sw[i+7*NV],sw[i+7*NV]);
+            b = _mm256_loadu_ps(&scu[mm]);
+            _mm256_storeu_ps(&scu[mm],_mm256_fmadd_ps(v_v,a,b));
+         }
+/* advance position half a time-step */
+         v_dx = _mm512_fmadd_ps(v_vx,v_dt,v_x);
+         v_dy = _mm512_fmadd_ps(v_vy,v_dt,v_y);
+         v_dz = _mm512_fmadd_ps(v_vz,v_dt,v_z);
+/* reflecting boundary conditions */
+         if ((ipbc==2) || (ipbc==3)) {
+            mskr = _mm512_cmp_ps_mask(v_dx,v_edgelx,_CMP_LT_OQ)
+                 | _mm512_cmp_ps_mask(v_dx,v_edgerx,_CMP_GE_OQ);
+            v_dx = _mm512_mask_blend_ps(mskr,v_dx,v_x);
+            _mm512_mask_storeu_ps(&ppart[j+3*nppmx+npoff],msk & mskr,
+                                  _mm512_sub_ps(v_zero,v_ux));
+            mskr = _mm512_cmp_ps_mask(v_dy,v_edgely,_CMP_LT_OQ)
+                 | _mm512_cmp_ps_mask(v_dy,v_edgery,_CMP_GE_OQ);
+            v_dy = _mm512_mask_blend_ps(mskr,v_dy,v_y);
+            _mm512_mask_storeu_ps(&ppart[j+4*nppmx+npoff],msk & mskr,
+                                  _mm512_sub_ps(v_zero,v_uy));
+/* mixed reflecting/periodic boundary conditions do not reflect in z */
+            if (ipbc==2) {
+               mskr = _mm512_cmp_ps_mask(v_dz,v_edgelz,_CMP_LT_OQ)
+                    | _mm512_cmp_ps_mask(v_dz,v_edgerz,_CMP_GE_OQ);
+               v_dz = _mm512_mask_blend_ps(mskr,v_dz,v_z);
+               _mm512_mask_storeu_ps(&ppart[j+5*nppmx+npoff],msk & mskr,
+                                     _mm512_sub_ps(v_zero,v_uz));
+            }
+         }
+/* set new position */
+         _mm512_mask_storeu_ps(&ppart[j+npoff],msk,v_dx);
+         _mm512_mask_storeu_ps(&ppart[j+nppmx+npoff],msk,v_dy);
+         _mm512_mask_storeu_ps(&ppart[j+2*nppmx+npoff],msk,v_dz);
+      }
+/* deposit current to global array */
+      cavxputj3l(cu,scu,noff,moff,loff,mx,my,mz,nxv,nyv,nzv,mxv,mxyv);
+   }
+   return;
+#undef NV
+#undef MXV
+#undef MYV
+#undef MZV
+}
+
+/*--------------------------------------------------------------------*/
+static AVX2 void cavx2jppost3lt(float ppart[], float cu[], int kpic[],
+                                float qm, float dt, float ci, int nppmx,
+                                int idimp, int nx, int ny, int nz,
+                                int mx, int my, int mz, int nxv, int nyv,
+                                int nzv, int mx1, int my1, int mxyz1,
+                                int ipbc, int lrel) {
+/* AVX2 version of cgjppost3lt (lrel = 0) and cgrjppost3lt (lrel = 1)
+   weights, addresses and velocities are calculated for 8 particles at
+   a time, then the current of each particle is added to the local
+   accumulator with 256 bit vectors, two grid points at a time
+local data                                                            */
+#define MXV             17
+#define MYV             17
+#define MZV             17
+#define NV              8
+   int mxy1, noff, moff, loff, npoff, npp, nps;
+   int i, j, k, l, nn, mm, mxv, myv, mxyv;
+   float ci2, edgelx, edgely, edgelz, edgerx, edgery, edgerz;
+   __m256i v_noff, v_moff, v_loff, v_mxv4, v_mxyv4, v_nn, v_mm, v_ll;
+   __m256i v_it, v_msk, v_mskr;
+   __m256 v_qm, v_ci2, v_dt, v_one, v_zero;
+   __m256 v_edgelx, v_edgely, v_edgelz, v_edgerx, v_edgery, v_edgerz;
+   __m256 v_xoff, v_yoff, v_zoff, v_x, v_y, v_z, v_vx, v_vy, v_vz;
+   __m256 v_ux, v_uy, v_uz, v_dxp, v_dyp, v_dzp, v_amx, v_amy, v_amz;
+   __m256 v_dx1, v_dx, v_dy, v_dz, v_at, v_ms;
+   __m256 a, b, v_v;
+   __attribute__((aligned(32))) int kk[NV];
+   __attribute__((aligned(32))) float sw[8*NV], sv[3*NV];
+   float scu[4*MXV*MYV*MZV];
+/* float scu[4*(mx+1)*(my+1)*(mz+1)]; */
+   mxy1 = mx1*my1;
+/* mxv = MXV; */
+/* myv = MYV; */
+   mxv = mx+1;
+   myv = my+1;
+   mxyv = mxv*myv;
+   ci2 = ci*ci;
+/* set boundary values */
+   edgelx = 0.0f;
+   edgely = 0.0f;
+   edgelz = 0.0f;
+   edgerx = (float) nx;
+   edgery = (float) ny;
+   edgerz = (float) nz;
+   if (ipbc==2) {
+      edgelx = 1.0f;
+      edgely = 1.0f;
+      edgelz = 1.0f;
+      edgerx = (float) (nx-1);
+      edgery = (float) (ny-1);
+      edgerz = (float) (nz-1);
+   }
+   else if (ipbc==3) {
+      edgelx = 1.0f;
+      edgely = 1.0f;
+      edgerx = (float) (nx-1);
+      edgery = (float) (ny-1);
+   }
+   v_it = _mm256_setr_epi32(0,1,2,3,4,5,6,7);
+   v_mxv4 = _mm256_set1_epi32(4*mxv);
+   v_mxyv4 = _mm256_set1_epi32(4*mxyv);
+   v_qm = _mm256_set1_ps(qm);
+   v_ci2 = _mm256_set1_ps(ci2);
+   v_dt = _mm256_set1_ps(dt);
+   v_one = _mm256_set1_ps(1.0f);
+   v_zero = _mm256_setzero_ps();
+   v_edgelx = _mm256_set1_ps(edgelx);
+   v_edgely = _mm256_set1_ps(edgely);
+   v_edgelz = _mm256_set1_ps(edgelz);
+   v_edgerx = _mm256_set1_ps(edgerx);
+   v_edgery = _mm256_set1_ps(edgery);
+   v_edgerz = _mm256_set1_ps(edgerz);
+/* error if local array is too small                */
+/* if ((mx >= MXV) || (my >= MYV) || (mz >= MZV))   */
+/*    return;                                       */
+/* loop over tiles */
+#pragma omp parallel for \
+private(i,j,k,l,noff,moff,loff,npp,npoff,nps,nn,mm,v_noff,v_moff, \
+v_loff,v_nn,v_mm,v_ll,v_msk,v_mskr,v_xoff,v_yoff,v_zoff,v_x,v_y,v_z, \
+v_vx,v_vy,v_vz,v_ux,v_uy,v_uz,v_dxp,v_dyp,v_dzp,v_amx,v_amy,v_amz, \
+v_dx1,v_dx,v_dy,v_dz,v_at,v_ms,a,b,v_v,kk,sw,sv,scu)
+   for (l = 0; l < mxyz1; l++) {
+      loff = l/mxy1;
+      k = l - mxy1*loff;
+      loff = mz*loff;
+      noff = k/mx1;
+      moff = my*noff;
+      noff = mx*(k - mx1*noff);
+      v_noff = _mm256_set1_epi32(noff);
+      v_moff = _mm256_set1_epi32(moff);
+      v_loff = _mm256_set1_epi32(loff);
+/* positions used for inactive lanes in last block */
+      v_xoff = _mm256_set1_ps((float) noff);
+      v_yoff = _mm256_set1_ps((float) moff);
+      v_zoff = _mm256_set1_ps((float) loff);
+      npp = kpic[l];
+      npoff = idimp*nppmx*l;
+/* zero out local accumulator */
+      memset(scu,0,4*mxyv*(mz+1)*sizeof(float));
+/* loop over particles in tile in blocks of 8 */
+      for (j = 0; j < npp; j+=NV) {
+         nps = npp - j;
+         nps = nps < NV ? nps : NV;
+         v_msk = _mm256_cmpgt_epi32(_mm256_set1_epi32(nps),v_it);
+         v_ms = _mm256_castsi256_ps(v_msk);
+/* find interpolation weights */
+         v_x = _mm256_blendv_ps(v_xoff,_mm256_maskload_ps(&ppart[j+npoff],
+               v_msk),v_ms);
+         v_y = _mm256_blendv_ps(v_yoff,_mm256_maskload_ps(
+               &ppart[j+nppmx+npoff],v_msk),v_ms);
+         v_z = _mm256_blendv_ps(v_zoff,_mm256_maskload_ps(
+               &ppart[j+2*nppmx+npoff],v_msk),v_ms);
+         v_nn = _mm256_cvttps_epi32(v_x);
+         v_mm = _mm256_cvttps_epi32(v_y);
+         v_ll = _mm256_cvttps_epi32(v_z);
+         v_dxp = _mm256_mul_ps(v_qm,_mm256_sub_ps(v_x,
+                 _mm256_cvtepi32_ps(v_nn)));
+         v_dyp = _mm256_sub_ps(v_y,_mm256_cvtepi32_ps(v_mm));
+         v_dzp = _mm256_sub_ps(v_z,_mm256_cvtepi32_ps(v_ll));
+/* nn = 4*(nn - noff + mxv*(mm - moff) + mxyv*(ll - loff)) */
+         v_nn = _mm256_slli_epi32(_mm256_sub_epi32(v_nn,v_noff),2);
+         v_mm = _mm256_mullo_epi32(v_mxv4,_mm256_sub_epi32(v_mm,v_moff));
+         v_ll = _mm256_mullo_epi32(v_mxyv4,_mm256_sub_epi32(v_ll,v_loff));
+         v_nn = _mm256_add_epi32(_mm256_add_epi32(v_nn,v_mm),v_ll);
+         _mm256_store_si256((__m256i *)kk,v_nn);
+         v_amx = _mm256_sub_ps(v_qm,v_dxp);
+         v_amy = _mm256_sub_ps(v_one,v_dyp);
+         v_dx1 = _mm256_mul_ps(v_dxp,v_dyp);
+         v_dyp = _mm256_mul_ps(v_amx,v_dyp);
+         v_amx = _mm256_mul_ps(v_amx,v_amy);
+         v_amz = _mm256_sub_ps(v_one,v_dzp);
+         v_amy = _mm256_mul_ps(v_dxp,v_amy);
+/* weights for the 8 grid points */
+         _mm256_store_ps(&sw[0],_mm256_mul_ps(v_amx,v_amz));
+         _mm256_store_ps(&sw[NV],_mm256_mul_ps(v_amy,v_amz));
+         _mm256_store_ps(&sw[2*NV],_mm256_mul_ps(v_dyp,v_amz));
+         _mm256_store_ps(&sw[3*NV],_mm256_mul_ps(v_dx1,v_amz));
+         _mm256_store_ps(&sw[4*NV],_mm256_mul_ps(v_amx,v_dzp));
+         _mm256_store_ps(&sw[5*NV],_mm256_mul_ps(v_amy,v_dzp));
+         _mm256_store_ps(&sw[6*NV],_mm256_mul_ps(v_dyp,v_dzp));
+         _mm256_store_ps(&sw[7*NV],_mm256_mul_ps(v_dx1,v_dzp));
+         v_ux = _mm256_maskload_ps(&ppart[j+3*nppmx+npoff],v_msk);
+         v_uy = _mm256_maskload_ps(&ppart[j+4*nppmx+npoff],v_msk);
+         v_uz = _mm256_maskload_ps(&ppart[j+5*nppmx+npoff],v_msk);
+/* find inverse gamma */
+         if (lrel) {
+            v_at = _mm256_mul_ps(v_ux,v_ux);
+            v_at = _mm256_fmadd_ps(v_uy,v_uy,v_at);
+            v_at = _mm256_fmadd_ps(v_uz,v_uz,v_at);
+            v_at = _mm256_div_ps(v_one,_mm256_sqrt_ps(_mm256_fmadd_ps(
+                   v_at,v_ci2,v_one)));
+            v_vx = _mm256_mul_ps(v_ux,v_at);
+            v_vy = _mm256_mul_ps(v_uy,v_at);
+            v_vz = _mm256_mul_ps(v_uz,v_at);
+         }
+         else {
+            v_vx = v_ux;
+            v_vy = v_uy;
+            v_vz = v_uz;
+         }
+         _mm256_store_ps(&sv[0],v_vx);
+         _mm256_store_ps(&sv[NV],v_vy);
+         _mm256_store_ps(&sv[2*NV],v_vz);
+/* deposit current within tile to local accumulator */
+         for (i = 0; i < nps; i++) {
+            nn = kk[i];
+            v_v = _mm256_setr_ps(sv[i],sv[i+NV],sv[i+2*NV],0.0f,sv[i],
+                                 sv[i+NV],sv[i+2*NV],0.0f);
+            mm = nn + 4*mxv;
+            a = _mm256_setr_ps(sw[i],sw[i],sw[i],sw[i],sw[i+NV],
+                               sw[i+NV],sw[i+NV],sw[i+NV]);
+            b = _mm256_loadu_ps(&scu[nn]);
+            _mm256_storeu_ps(&scu[nn],_mm256_fmadd_ps(v_v,a,b));
+            a = _mm256_setr_ps(sw[i+2*NV],sw[i+2*NV],sw[i+2*NV],
+                               sw[i+2*NV],sw[i+3*NV],sw[i+3*NV],
+                               sw[i+3*NV],sw[i+3*NV]);
+            b = _mm256_loadu_ps(&scu[mm]);
+            _mm256_storeu_ps(&scu[mm],_mm256_fmadd_ps(v_v,a,b));
+            nn += 4*mxyv;
+            mm += 4*mxyv;
+            a = _mm256_setr_ps(sw[i+4*NV],sw[i+4*NV],sw[i+4*NV],
+                               sw[i+4*NV],sw[i+5*NV],sw[i+5*NV],
+                               sw[i+5*NV],sw[i+5*NV]);
+            b = _mm256_loadu_ps(&scu[nn]);
+            _mm256_storeu_ps(&scu[nn],_mm256_fmadd_ps(v_v,a,b));
+            a = _mm256_setr_ps(sw[i+6*NV],sw[i+6*NV],sw[i+6*NV],
+                               sw[i+6*NV],sw[i+7*NV],sw[i+7*NV],
+                               sw[i+7*NV],sw[i+7*NV]);
+            b = _mm256_loadu_ps(&scu[mm]);
+            _mm256_storeu_ps(&scu[mm],_mm256_fmadd_ps(v_v,a,b));
+         }
+/* advance position half a time-step */
+         v_dx = _mm256_fmadd_ps(v_vx,v_dt,v_x);
+         v_dy = _mm256_fmadd_ps(v_vy,v_dt,v_y);
+         v_dz = _mm256_fmadd_ps(v_vz,v_dt,v_z);
+/* reflecting boundary conditions */
+         if ((ipbc==2) || (ipbc==3)) {
+            v_at = _mm256_or_ps(_mm256_cmp_ps(v_dx,v_edgelx,_CMP_LT_OQ),
+                   _mm256_cmp_ps(v_dx,v_edgerx,_CMP_GE_OQ));
+            v_dx = _mm256_blendv_ps(v_dx,v_x,v_at);
+            v_mskr = _mm256_castps_si256(_mm256_and_ps(v_at,v_ms));
+            _mm256_maskstore_ps(&ppart[j+3*nppmx+npoff],v_mskr,
+                                _mm256_sub_ps(v_zero,v_ux));
+            v_at = _mm256_or_ps(_mm256_cmp_ps(v_dy,v_edgely,_CMP_LT_OQ),
+                   _mm256_cmp_ps(v_dy,v_edgery,_CMP_GE_OQ));
+            v_dy = _mm256_blendv_ps(v_dy,v_y,v_at);
+            v_mskr = _mm256_castps_si256(_mm256_and_ps(v_at,v_ms));
+            _mm256_maskstore_ps(&ppart[j+4*nppmx+npoff],v_mskr,
+                                _mm256_sub_ps(v_zero,v_uy));
+/* mixed reflecting/periodic boundary conditions do not reflect in z */
+            if (ipbc==2) {
+               v_at = _mm256_or_ps(_mm256_cmp_ps(v_dz,v_edgelz,
+                      _CMP_LT_OQ),_mm256_cmp_ps(v_dz,v_edgerz,
+                      _CMP_GE_OQ));
+               v_dz = _mm256_blendv_ps(v_dz,v_z,v_at);
+               v_mskr = _mm256_castps_si256(_mm256_and_ps(v_at,v_ms));
+               _mm256_maskstore_ps(&ppart[j+5*nppmx+npoff],v_mskr,
+                                   _mm256_sub_ps(v_zero,v_uz));
+            }
+         }
+/* set new position */
+         _mm256_maskstore_ps(&ppart[j+npoff],v_msk,v_dx);
+         _mm256_maskstore_ps(&ppart[j+nppmx+npoff],v_msk,v_dy);
+         _mm256_maskstore_ps(&ppart[j+2*nppmx+npoff],v_msk,v_dz);
+      }
+/* deposit current to global array */
+      cavxputj3l(cu,scu,noff,moff,loff,mx,my,mz,nxv,nyv,nzv,mxv,mxyv);
+   }
+   return;
+#undef NV
+#undef MXV
+#undef MYV
+#undef MZV
+}
+
+/*--------------------------------------------------------------------*/
+static AVX512F void cavx512pphole3lt(float ppart[], int kpic[],
+                                     int ncl[], int ihole[], int idimp,
+                                     int nppmx, int nx, int ny, int nz,
+                                     int mx, int my, int mz, int mx1,
+                                     int my1, int mz1, int ntmax,
+                                     int *irc) {
+/* AVX-512F version of the first step of cvpporder3lt: finds particles
+   leaving tile, applies periodic boundary conditions, and stores their
+   number in each direction, location, and destination in ncl and ihole
+   particles are processed in blocks of 16, the last block is masked
+local data                                                            */
+#define NV              16
+   int mxy1, mxyz1, noff, moff, loff, npp, npoff, nps;
+   int j, k, l, nn, mm, ll, ih, nh, ist, i;
+   __m512 v_anx, v_any, v_anz, v_zero, v_one, v_three, v_nine;
+   __m512 v_edgelx, v_edgely, v_edgelz, v_edgerx, v_edgery, v_edgerz;
+   __m512 v_dx, v_dy, v_dz, v_it, v_ist;
+   __mmask16 msk, mr, ml, mm1;
+   __attribute__((aligned(64))) int n[NV];
+   mxy1 = mx1*my1;
+   mxyz1 = mxy1*mz1;
+   v_anx = _mm512_set1_ps((float) nx);
+   v_any = _mm512_set1_ps((float) ny);
+   v_anz = _mm512_set1_ps((float) nz);
+   v_zero = _mm512_setzero_ps();
+   v_one = _mm512_set1_ps(1.0f);
+   v_three = _mm512_set1_ps(3.0f);
+   v_nine = _mm512_set1_ps(9.0f);
+/* find and count particles leaving tiles and determine destination */
+/* update ppart, ihole, ncl */
+/* loop over tiles */
+#pragma omp parallel for \
+private(i,j,k,l,noff,moff,loff,npp,npoff,nps,nn,mm,ll,ih,nh,ist, \
+v_edgelx,v_edgely,v_edgelz,v_edgerx,v_edgery,v_edgerz,v_dx,v_dy,v_dz, \
+v_it,v_ist,msk,mr,ml,mm1,n)
+   for (l = 0; l < mxyz1; l++) {
+      loff = l/mxy1;
+      k = l - mxy1*loff;
+      loff = mz*loff;
+      noff = k/mx1;
+      moff = my*noff;
+      noff = mx*(k - mx1*noff);
+      npp = kpic[l];
+      npoff = idimp*nppmx*l;
+      nn = nx - noff;
+      nn = mx < nn ? mx : nn;
+      mm = ny - moff;
+      mm = my < mm ? my : mm;
+      ll = nz - loff;
+      ll = mz < ll ? mz : ll;
+      ih = 0;
+      nh = 0;
+      v_edgelx = _mm512_set1_ps((float) noff);
+      v_edgerx = _mm512_set1_ps((float) (noff + nn));
+      v_edgely = _mm512_set1_ps((float) moff);
+      v_edgery = _mm512_set1_ps((float) (moff + mm));
+      v_edgelz = _mm512_set1_ps((float) loff);
+      v_edgerz = _mm512_set1_ps((float) (loff + ll));
+/* clear counters */
+      for (j = 0; j < 26; j++) {
+         ncl[j+26*l] = 0;
+      }
+/* loop over particles in tile in blocks of 16 */
+      for (j = 0; j < npp; j+=NV) {
+         nps = npp - j;
+         nps = nps < NV ? nps : NV;
+         msk = (__mmask16) ((1 << nps) - 1);
+         v_dx = _mm512_mask_loadu_ps(v_edgelx,msk,&ppart[j+npoff]);
+         v_dy = _mm512_mask_loadu_ps(v_edgely,msk,&ppart[j+nppmx+npoff]);
+         v_dz = _mm512_mask_loadu_ps(v_edgelz,msk,
+                                     &ppart[j+2*nppmx+npoff]);
+/* find particles going out of bounds */
+/* use periodic boundary conditions and check for roundoff error */
+/* ist = direction particle is going                             */
+         mr = _mm512_cmp_ps_mask(v_dx,v_edgerx,_CMP_GE_OQ);
+         ml = _mm512_cmp_ps_mask(v_dx,v_edgelx,_CMP_LT_OQ);
+         v_ist = _mm512_mask_mov_ps(v_zero,ml,v_one);
+         v_ist = _mm512_mask_mov_ps(v_ist,mr,_mm512_set1_ps(2.0f));
+         mm1 = _mm512_mask_cmp_ps_mask(mr,v_dx,v_anx,_CMP_GE_OQ);
+         v_dx = _mm512_mask_sub_ps(v_dx,mm1,v_dx,v_anx);
+         mm1 = _mm512_mask_cmp_ps_mask(ml,v_dx,v_zero,_CMP_LT_OQ);
+         v_dx = _mm512_mask_add_ps(v_dx,mm1,v_dx,v_anx);
+         mm1 = _mm512_mask_cmp_ps_mask(mm1,v_dx,v_anx,_CMP_GE_OQ);
+         v_dx = _mm512_mask_mov_ps(v_dx,mm1,v_zero);
+         v_ist = _mm512_mask_mov_ps(v_ist,mm1,v_zero);
+         mr = _mm512_cmp_ps_mask(v_dy,v_edgery,_CMP_GE_OQ);
+         ml = _mm512_cmp_ps_mask(v_dy,v_edgely,_CMP_LT_OQ);
+         v_it = _mm512_mask_mov_ps(v_zero,ml,v_one);
+         v_it = _mm512_mask_mov_ps(v_it,mr,_mm512_set1_ps(2.0f));
+         mm1 = _mm512_mask_cmp_ps_mask(mr,v_dy,v_any,_CMP_GE_OQ);
+         v_dy = _mm512_mask_sub_ps(v_dy,mm1,v_dy,v_any);
+         mm1 = _mm512_mask_cmp_ps_mask(ml,v_dy,v_zero,_CMP_LT_OQ);
+         v_dy = _mm512_mask_add_ps(v_dy,mm1,v_dy,v_any);
+         mm1 = _mm512_mask_cmp_ps_mask(mm1,v_dy,v_any,_CMP_GE_OQ);
+         v_dy = _mm512_mask_mov_ps(v_dy,mm1,v_zero);
+         v_it = _mm512_mask_mov_ps(v_it,mm1,v_zero);
+         v_ist = _mm512_fmadd_ps(v_three,v_it,v_ist);
+         mr = _mm512_cmp_ps_mask(v_dz,v_edgerz,_CMP_GE_OQ);
+         ml = _mm512_cmp_ps_mask(v_dz,v_edgelz,_CMP_LT_OQ);
+         v_it = _mm512_mask_mov_ps(v_zero,ml,v_one);
+         v_it = _mm512_mask_mov_ps(v_it,mr,_mm512_set1_ps(2.0f));
+         mm1 = _mm512_mask_cmp_ps_mask(mr,v_dz,v_anz,_CMP_GE_OQ);
+         v_dz = _mm512_mask_sub_ps(v_dz,mm1,v_dz,v_anz);
+         mm1 = _mm512_mask_cmp_ps_mask(ml,v_dz,v_zero,_CMP_LT_OQ);
+         v_dz = _mm512_mask_add_ps(v_dz,mm1,v_dz,v_anz);
+         mm1 = _mm512_mask_cmp_ps_mask(mm1,v_dz,v_anz,_CMP_GE_OQ);
+         v_dz = _mm512_mask_mov_ps(v_dz,mm1,v_zero);
+         v_it = _mm512_mask_mov_ps(v_it,mm1,v_zero);
+         v_ist = _mm512_fmadd_ps(v_nine,v_it,v_ist);
+         _mm512_mask_storeu_ps(&ppart[j+npoff],msk,v_dx);
+         _mm512_mask_storeu_ps(&ppart[j+nppmx+npoff],msk,v_dy);
+         _mm512_mask_storeu_ps(&ppart[j+2*nppmx+npoff],msk,v_dz);
+         _mm512_store_epi32(n,_mm512_cvttps_epi32(v_ist));
+/* count how many particles are going in each direction in ncl */
+/* save their address and destination in ihole                 */
+         for (i = 0; i < nps; i++) {
+            ist = n[i];
+            if (ist > 0) {
+               ncl[ist+26*l-1] += 1;
+               ih += 1;
+               if (ih <= ntmax) {
+                  ihole[2*(ih+(ntmax+1)*l)] = i + j + 1;
+                  ihole[1+2*(ih+(ntmax+1)*l)] = ist;
+               }
+               else {
+                  nh = 1;
+               }
+            }
+         }
+      }
+/* set error and end of file flag */
+      if (nh > 0) {
+         *irc = ih;
+         ih = -ih;
+      }
+      ihole[2*(ntmax+1)*l] = ih;
+   }
+   return;
+#undef NV
+}
+
+/*--------------------------------------------------------------------*/
+static AVX2 void cavx2pphole3lt(float ppart[], int kpic[], int ncl[],
+                                int ihole[], int idimp, int nppmx,
+                                int nx, int ny, int nz, int mx, int my,
+                                int mz, int mx1, int my1, int mz1,
+                                int ntmax, int *irc) {
+/* AVX2 version of the first step of cvpporder3lt: finds particles
+   leaving tile, applies periodic boundary conditions, and stores their
+   number in each direction, location, and destination in ncl and ihole
+   particles are processed in blocks of 8, the last block is masked
+local data                                                            */
+#define NV              8
+   int mxy1, mxyz1, noff, moff, loff, npp, npoff, nps;
+   int j, k, l, nn, mm, ll, ih, nh, ist, i;
+   __m256i v_msk, v_iv;
+   __m256 v_anx, v_any, v_anz, v_zero, v_one, v_two, v_three, v_nine;
+   __m256 v_edgelx, v_edgely, v_edgelz, v_edgerx, v_edgery, v_edgerz;
+   __m256 v_dx, v_dy, v_dz, v_it, v_ist, v_ms, v_mr, v_ml, v_m1;
+   __attribute__((aligned(32))) int n[NV];
+   mxy1 = mx1*my1;
+   mxyz1 = mxy1*mz1;
+   v_iv = _mm256_setr_epi32(0,1,2,3,4,5,6,7);
+   v_anx = _mm256_set1_ps((float) nx);
+   v_any = _mm256_set1_ps((float) ny);
+   v_anz = _mm256_set1_ps((float) nz);
+   v_zero = _mm256_setzero_ps();
+   v_one = _mm256_set1_ps(1.0f);
+   v_two = _mm256_set1_ps(2.0f);
+   v_three = _mm256_set1_ps(3.0f);
+   v_nine = _mm256_set1_ps(9.0f);
+/* find and count particles leaving tiles and determine destination */
+/* update ppart, ihole, ncl */
+/* loop over tiles */
+#pragma omp parallel for \
+private(i,j,k,l,noff,moff,loff,npp,npoff,nps,nn,mm,ll,ih,nh,ist,v_msk, \
+v_edgelx,v_edgely,v_edgelz,v_edgerx,v_edgery,v_edgerz,v_dx,v_dy,v_dz, \
+v_it,v_ist,v_ms,v_mr,v_ml,v_m1,n)
+   for (l = 0; l < mxyz1; l++) {
+      loff = l/mxy1;
+      k = l - mxy1*loff;
+      loff = mz*loff;
+      noff = k/mx1;
+      moff = my*noff;
+      noff = mx*(k - mx1*noff);
+      npp = kpic[l];
+      npoff = idimp*nppmx*l;
+      nn = nx - noff;
+      nn = mx < nn ? mx : nn;
+      mm = ny - moff;
+      mm = my < mm ? my : mm;
+      ll = nz - loff;
+      ll = mz < ll ? mz : ll;
+      ih = 0;
+      nh = 0;
+      v_edgelx = _mm256_set1_ps((float) noff);
+      v_edgerx = _mm256_set1_ps((float) (noff + nn));
+      v_edgely = _mm256_set1_ps((float) moff);
+      v_edgery = _mm256_set1_ps((float) (moff + mm));
+      v_edgelz = _mm256_set1_ps((float) loff);
+      v_edgerz = _mm256_set1_ps((float) (loff + ll));
+/* clear counters */
+      for (j = 0; j < 26; j++) {
+         ncl[j+26*l] = 0;
+      }
+/* loop over particles in tile in blocks of 8 */
+      for (j = 0; j < npp; j+=NV) {
+         nps = npp - j;
+         nps = nps < NV ? nps : NV;
+         v_msk = _mm256_cmpgt_epi32(_mm256_set1_epi32(nps),v_iv);
+         v_ms = _mm256_castsi256_ps(v_msk);
+         v_dx = _mm256_blendv_ps(v_edgelx,_mm256_maskload_ps(
+                &ppart[j+npoff],v_msk),v_ms);
+         v_dy = _mm256_blendv_ps(v_edgely,_mm256_maskload_ps(
+                &ppart[j+nppmx+npoff],v_msk),v_ms);
+         v_dz = _mm256_blendv_ps(v_edgelz,_mm256_maskload_ps(
+                &ppart[j+2*nppmx+npoff],v_msk),v_ms);
+/* find particles going out of bounds */
+/* use periodic boundary conditions and check for roundoff error */
+/* ist = direction particle is going                             */
+         v_mr = _mm256_cmp_ps(v_dx,v_edgerx,_CMP_GE_OQ);
+         v_ml = _mm256_cmp_ps(v_dx,v_edgelx,_CMP_LT_OQ);
+         v_ist = _mm256_blendv_ps(v_zero,v_one,v_ml);
+         v_ist = _mm256_blendv_ps(v_ist,v_two,v_mr);
+         v_m1 = _mm256_and_ps(v_mr,_mm256_cmp_ps(v_dx,v_anx,_CMP_GE_OQ));
+         v_dx = _mm256_blendv_ps(v_dx,_mm256_sub_ps(v_dx,v_anx),v_m1);
+         v_m1 = _mm256_and_ps(v_ml,_mm256_cmp_ps(v_dx,v_zero,_CMP_LT_OQ));
+         v_dx = _mm256_blendv_ps(v_dx,_mm256_add_ps(v_dx,v_anx),v_m1);
+         v_m1 = _mm256_and_ps(v_m1,_mm256_cmp_ps(v_dx,v_anx,_CMP_GE_OQ));
+         v_dx = _mm256_blendv_ps(v_dx,v_zero,v_m1);
+         v_ist = _mm256_blendv_ps(v_ist,v_zero,v_m1);
+         v_mr = _mm256_cmp_ps(v_dy,v_edgery,_CMP_GE_OQ);
+         v_ml = _mm256_cmp_ps(v_dy,v_edgely,_CMP_LT_OQ);
+         v_it = _mm256_blendv_ps(v_zero,v_one,v_ml);
+         v_it = _mm256_blendv_ps(v_it,v_two,v_mr);
+         v_m1 = _mm256_and_ps(v_mr,_mm256_cmp_ps(v_dy,v_any,_CMP_GE_OQ));
+         v_dy = _mm256_blendv_ps(v_dy,_mm256_sub_ps(v_dy,v_any),v_m1);
+         v_m1 = _mm256_and_ps(v_ml,_mm256_cmp_ps(v_dy,v_zero,_CMP_LT_OQ));
+         v_dy = _mm256_blendv_ps(v_dy,_mm256_add_ps(v_dy,v_any),v_m1);
+         v_m1 = _mm256_and_ps(v_m1,_mm256_cmp_ps(v_dy,v_any,_CMP_GE_OQ));
+         v_dy = _mm256_blendv_ps(v_dy,v_zero,v_m1);
+         v_it = _mm256_blendv_ps(v_it,v_zero,v_m1);
+         v_ist = _mm256_fmadd_ps(v_three,v_it,v_ist);
+         v_mr = _mm256_cmp_ps(v_dz,v_edgerz,_CMP_GE_OQ);
+         v_ml = _mm256_cmp_ps(v_dz,v_edgelz,_CMP_LT_OQ);
+         v_it = _mm256_blendv_ps(v_zero,v_one,v_ml);
+         v_it = _mm256_blendv_ps(v_it,v_two,v_mr);
+         v_m1 = _mm256_and_ps(v_mr,_mm256_cmp_ps(v_dz,v_anz,_CMP_GE_OQ));
+         v_dz = _mm256_blendv_ps(v_dz,_mm256_sub_ps(v_dz,v_anz),v_m1);
+         v_m1 = _mm256_and_ps(v_ml,_mm256_cmp_ps(v_dz,v_zero,_CMP_LT_OQ));
+         v_dz = _mm256_blendv_ps(v_dz,_mm256_add_ps(v_dz,v_anz),v_m1);
+         v_m1 = _mm256_and_ps(v_m1,_mm256_cmp_ps(v_dz,v_anz,_CMP_GE_OQ));
+         v_dz = _mm256_blendv_ps(v_dz,v_zero,v_m1);
+         v_it = _mm256_blendv_ps(v_it,v_zero,v_m1);
+         v_ist = _mm256_fmadd_ps(v_nine,v_it,v_ist);
+         _mm256_maskstore_ps(&ppart[j+npoff],v_msk,v_dx);
+         _mm256_maskstore_ps(&ppart[j+nppmx+npoff],v_msk,v_dy);
+         _mm256_maskstore_ps(&ppart[j+2*nppmx+npoff],v_msk,v_dz);
+         _mm256_store_si256((__m256i *)n,_mm256_cvttps_epi32(v_ist));
+/* count how many particles are going in each direction in ncl */
+/* save their address and destination in ihole                 */
+         for (i = 0; i < nps; i++) {
+            ist = n[i];
+            if (ist > 0) {
+               ncl[ist+26*l-1] += 1;
+               ih += 1;
+               if (ih <= ntmax) {
+                  ihole[2*(ih+(ntmax+1)*l)] = i + j + 1;
+                  ihole[1+2*(ih+(ntmax+1)*l)] = ist;
+               }
+               else {
+                  nh = 1;
+               }
+            }
+         }
+      }
+/* set error and end of file flag */
+      if (nh > 0) {
+         *irc = ih;
+         ih = -ih;
+      }
+      ihole[2*(ntmax+1)*l] = ih;
+   }
+   return;
+#undef NV
+}
+
+/*--------------------------------------------------------------------*/
+void cavxgbppush3lt(float ppart[], float fxyz[], float bxyz[],
+                    int kpic[], float qbm, float dt, float dtc,
+                    float *ek, int idimp, int nppmx, int nx, int ny,
+                    int nz, int mx, int my, int mz, int nxv, int nyv,
+                    int nzv, int mx1, int my1, int mxyz1, int ipbc) {
+/* for 3d code, this subroutine updates particle co-ordinates and
+   velocities using leap-frog scheme in time and first-order linear
+   interpolation in space, with magnetic field.  Using the Boris Mover.
+   OpenMP/vector version using guard cells
+   data read in tiles
+   particles stored segmented array
+   190 flops/particle, 1 divide, 54 loads, 6 stores
+   input: all, output: ppart, ek
+   same algorithm and arguments as cgbppush3lt.  uses AVX-512F if
+   available, otherwise AVX2, as found by cavxcheck
+   requires AVX2, and fxyz, bxyz with 4 components per grid point
+local data                                                            */
+   if (cavxcheck()==2)
+      cavx512bppush3lt(ppart,fxyz,bxyz,kpic,qbm,dt,dtc,0.0f,ek,idimp,
+                       nppmx,nx,ny,nz,mx,my,mz,nxv,nyv,nzv,mx1,my1,
+                       mxyz1,ipbc,0);
+   else
+      cavx2bppush3lt(ppart,fxyz,bxyz,kpic,qbm,dt,dtc,0.0f,ek,idimp,
+                     nppmx,nx,ny,nz,mx,my,mz,nxv,nyv,nzv,mx1,my1,mxyz1,
+                     ipbc,0);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cavxgrbppush3lt(float ppart[], float fxyz[], float bxyz[],
+                     int kpic[], float qbm, float dt, float dtc,
+                     float ci, float *ek, int idimp, int nppmx, int nx,
+                     int ny, int nz, int mx, int my, int mz, int nxv,
+                     int nyv, int nzv, int mx1, int my1, int mxyz1,
+                     int ipbc) {
+/* for 3d code, this subroutine updates particle co-ordinates and
+   velocities using leap-frog scheme in time and first-order linear
+   interpolation in space, for relativistic particles with magnetic field
+   Using the Boris Mover.
+   OpenMP/vector version using guard cells
+   data read in tiles
+   particles stored segmented array
+   202 flops/particle, 4 divides, 2 sqrts, 54 loads, 6 stores
+   input: all, output: ppart, ek
+   same algorithm and arguments as cgrbppush3lt.  uses AVX-512F if
+   available, otherwise AVX2, as found by cavxcheck
+   requires AVX2, and fxyz, bxyz with 4 components per grid point
+local data                                                            */
+   if (cavxcheck()==2)
+      cavx512bppush3lt(ppart,fxyz,bxyz,kpic,qbm,dt,dtc,ci,ek,idimp,
+                       nppmx,nx,ny,nz,mx,my,mz,nxv,nyv,nzv,mx1,my1,
+                       mxyz1,ipbc,1);
+   else
+      cavx2bppush3lt(ppart,fxyz,bxyz,kpic,qbm,dt,dtc,ci,ek,idimp,nppmx,
+                     nx,ny,nz,mx,my,mz,nxv,nyv,nzv,mx1,my1,mxyz1,ipbc,
+                     1);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cavxgjppost3lt(float ppart[], float cu[], int kpic[], float qm,
+                    float dt, int nppmx, int idimp, int nx, int ny,
+                    int nz, int mx, int my, int mz, int nxv, int nyv,
+                    int nzv, int mx1, int my1, int mxyz1, int ipbc) {
+/* for 3d code, this subroutine calculates particle current density
+   using first-order linear interpolation
+   in addition, particle positions are advanced a half time-step
+   OpenMP/vector version using guard cells
+   data deposited in tiles
+   particles stored segmented array
+   69 flops/particle, 30 loads, 27 stores
+   input: all, output: ppart, cu
+   same algorithm and arguments as cgjppost3lt.  uses AVX-512F if
+   available, otherwise AVX2, as found by cavxcheck
+   requires AVX2, and cu with 4 components per grid point
+local data                                                            */
+   if (cavxcheck()==2)
+      cavx512jppost3lt(ppart,cu,kpic,qm,dt,0.0f,nppmx,idimp,nx,ny,nz,
+                       mx,my,mz,nxv,nyv,nzv,mx1,my1,mxyz1,ipbc,0);
+   else
+      cavx2jppost3lt(ppart,cu,kpic,qm,dt,0.0f,nppmx,idimp,nx,ny,nz,mx,
+                     my,mz,nxv,nyv,nzv,mx1,my1,mxyz1,ipbc,0);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cavxgrjppost3lt(float ppart[], float cu[], int kpic[], float qm,
+                     float dt, float ci, int nppmx, int idimp, int nx,
+                     int ny, int nz, int mx, int my, int mz, int nxv,
+                     int nyv, int nzv, int mx1, int my1, int mxyz1,
+                     int ipbc) {
+/* for 3d code, this subroutine calculates particle current density
+   using first-order linear interpolation for relativistic particles
+   in addition, particle positions are advanced a half time-step
+   OpenMP/vector version using guard cells
+   data deposited in tiles
+   particles stored segmented array
+   79 flops/particle, 1 divide, 1 sqrt, 30 loads, 27 stores
+   input: all, output: ppart, cu
+   same algorithm and arguments as cgrjppost3lt.  uses AVX-512F if
+   available, otherwise AVX2, as found by cavxcheck
+   requires AVX2, and cu with 4 components per grid point
+local data                                                            */
+   if (cavxcheck()==2)
+      cavx512jppost3lt(ppart,cu,kpic,qm,dt,ci,nppmx,idimp,nx,ny,nz,mx,
+                       my,mz,nxv,nyv,nzv,mx1,my1,mxyz1,ipbc,1);
+   else
+      cavx2jppost3lt(ppart,cu,kpic,qm,dt,ci,nppmx,idimp,nx,ny,nz,mx,my,
+                     mz,nxv,nyv,nzv,mx1,my1,mxyz1,ipbc,1);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cavxpporder3lt(float ppart[], float ppbuff[], int kpic[], int ncl[],
+                    int ihole[], int idimp, int nppmx, int nx, int ny,
+                    int nz, int mx, int my, int mz, int mx1, int my1,
+                    int mz1, int npbmx, int ntmax, int *irc) {
+/* this subroutine sorts particles by x,y,z grid in tiles of mx, my, mz
+   linear interpolation, with periodic boundary conditions
+   tiles are assumed to be arranged in 3D linear memory
+   algorithm has 3 steps.  first, one finds particles leaving tile and
+   stores their number in each directon, location, and destination in ncl
+   and ihole.  second, a prefix scan of ncl is performed and departing
+   particles are buffered in ppbuff in direction order.  finally, we copy
+   the incoming particles from other tiles into ppart.
+   same algorithm and arguments as cvpporder3lt.  the first step uses
+   AVX-512F if available, otherwise AVX2, as found by cavxcheck, the
+   last two steps are performed by cavxpporderf3lt
+   requires AVX2
+local data                                                            */
+   if (cavxcheck()==2)
+      cavx512pphole3lt(ppart,kpic,ncl,ihole,idimp,nppmx,nx,ny,nz,mx,my,
+                       mz,mx1,my1,mz1,ntmax,irc);
+   else
+      cavx2pphole3lt(ppart,kpic,ncl,ihole,idimp,nppmx,nx,ny,nz,mx,my,mz,
+                     mx1,my1,mz1,ntmax,irc);
+/* ihole overflow */
+   if (*irc > 0)
+      return;
+   cavxpporderf3lt(ppart,ppbuff,kpic,ncl,ihole,idimp,nppmx,mx1,my1,mz1,
+                   npbmx,ntmax,irc);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cavxpporderf3lt(float ppart[], float ppbuff[], int kpic[],
+                     int ncl[], int ihole[], int idimp, int nppmx,
+                     int mx1, int my1, int mz1, int npbmx, int ntmax,
+                     int *irc) {
+/* this subroutine sorts particles by x,y,z grid in tiles of mx, my, mz
+   linear interpolation, with periodic boundary conditions
+   tiles are assumed to be arranged in 3D linear memory
+   the algorithm has 2 steps.  first, a prefix scan of ncl is performed
+   and departing particles are buffered in ppbuff in direction order.
+   then we copy the incoming particles from other tiles into ppart.
+   it assumes that the number, location, and destination of particles 
+   leaving a tile have been previously stored in ncl and ihole by the
+   cvgppushf3lt subroutine.
+   same algorithm and arguments as cvpporderf3lt
+   input: all except ppbuff, irc
+   output: ppart, ppbuff, kpic, ncl, irc
+   ppart[m][0][n] = position x of particle n in tile m
+   ppart[m][1][n] = position y of particle n in tile m
+   ppart[m][2][n] = position z of particle n in tile m
+   ppbuff[m][i][n] = i co-ordinate of particle n in tile m
+   kpic[m] = number of particles in tile m
+   ncl[m][i] = number of particles going to destination i, tile m
+   ihole[m][:][0] = location of hole in array left by departing particle
+   ihole[m][:][1] = direction destination of particle leaving hole
+   all for tile m
+   ihole[m][0][0] = ih, number of holes left (error, if negative)
+   idimp = size of phase space = 6
+   nppmx = maximum number of particles in tile
+   mx1 = (system length in x direction - 1)/mx + 1
+   my1 = (system length in y direction - 1)/my + 1
+   mz1 = (system length in z direction - 1)/mz + 1
+   npbmx = size of buffer array ppbuff
+   ntmax = size of hole array for particles leaving tiles
+   irc = maximum overflow, returned only if error occurs, when irc > 0
+local data                                                            */
+#define NPBLK             16
+   int mxy1, mxyz1, npp, ncoff, npoff, nboff;
+   int i, j, k, l, ii, kx, ky, kz, ih, nh, ist, nn, ll, mm, in;
+   int ip, j1, j2, kxl, kxr, kk, kl, kr, lk, lr;
+   int lb, kxs, m, ipp, nps, joff;
+   __attribute__((aligned(64))) int sncl[26], ks[26];
+/* scratch arrays */
+   __attribute__((aligned(64))) int n[NPBLK*3];
+   mxy1 = mx1*my1;
+   mxyz1 = mxy1*mz1;
+/* buffer particles that are leaving tile: update ppbuff, ncl */
+/* loop over tiles */
+#pragma omp parallel for \
+private(i,j,l,m,npoff,nboff,kxs,lb,ist,nh,ip,ipp,nps,joff,j1,ii,sncl, \
+ks,n)
+   for (l = 0; l < mxyz1; l++) {
+      npoff = idimp*nppmx*l;
+      nboff = idimp*npbmx*l;
+/* find address offset for ordered ppbuff array */
+/* find address offset for ordered ppbuff array */
+      for (j = 0; j < 26; j++) {
+         sncl[j] = ncl[j+26*l];
+         ks[j] = j;
+      }
+      kxs = 1;
+      while (kxs < 26) {
+         for (j = 0; j < 13; j++) {
+            lb = kxs*ks[j];
+            if ((j+lb+kxs) < 26)
+               sncl[j+lb+kxs] += sncl[2*lb+kxs-1];
+            ks[j] >>= 1;
+         }     
+         kxs <<= 1;
+      }
+      for (j = 0; j < 26; j++) {
+         sncl[j] -= ncl[j+26*l];
+      }
+      nh = ihole[2*(ntmax+1)*l];
+      ip = 0;
+/* buffer particles that are leaving tile, in direction order */
+/* loop over particles leaving tile */
+      ipp = nh/NPBLK;
+/* outer loop over number of full blocks */
+      for (m = 0; m < ipp; m++) {
+         joff = NPBLK*m + 1;
+/* inner loop over particles in block */
+         for (j = 0; j < NPBLK; j++) {
+            n[j] = ihole[2*(j+joff+(ntmax+1)*l)] - 1;
+            n[j+NPBLK] = ihole[1+2*(j+joff+(ntmax+1)*l)];
+         }
+/* calculate offsets */
+         for (j = 0; j < NPBLK; j++) {
+            ist = n[j+NPBLK];
+            ii = sncl[ist-1];
+            n[j+NPBLK] = ii;
+            sncl[ist-1] = ii + 1;
+         }
+/* buffer particles that are leaving tile, in direction order */
+         for (i = 0; i < idimp; i++) {
+            for (j = 0; j < NPBLK; j++) {
+               j1 = n[j];
+               ii = n[j+NPBLK];
+               if (ii < npbmx) {
+                 ppbuff[ii+npbmx*i+nboff]
+                  = ppart[j1+nppmx*i+npoff];
+               }
+               else {
+                  ip = 1;
+               }
+            }
+         }
+      }
+      nps = NPBLK*ipp;
+/* loop over remaining particles */
+      for (j = nps; j < nh; j++) {
+/* buffer particles that are leaving tile, in direction order */
+         j1 = ihole[2*(j+1+(ntmax+1)*l)] - 1;
+         ist = ihole[1+2*(j+1+(ntmax+1)*l)];
+         ii = sncl[ist-1];
+         if (ii < npbmx) {
+            for (i = 0; i < idimp; i++) {
+               ppbuff[ii+npbmx*i+nboff]
+               = ppart[j1+nppmx*i+npoff];
+            }
+         }
+         else {
+            ip = 1;
+         }
+         sncl[ist-1] = ii + 1;
+      }
+      for (j = 0; j < 26; j++) {
+         ncl[j+26*l] = sncl[j];
+      }
+/* set error */
+      if (ip > 0)
+         *irc = ncl[25+26*l];
+   }
+/* ppbuff overflow */
+   if (*irc > 0)
+      return;
+
+/* copy incoming particles from buffer into ppart: update ppart, kpic */
+/* loop over tiles */
+#pragma omp parallel for \
+private(i,j,k,l,m,ii,kk,in,npp,npoff,nboff,ipp,joff,nps,kx,ky,kz,kl,kr, \
+kxl,kxr,lk,ll,lr,ih,nh,nn,mm,ncoff,ist,j1,j2,ip,ks,n)
+   for (l = 0; l < mxyz1; l++) {
+      npp = kpic[l];
+      npoff = idimp*nppmx*l;
+      kz = l/mxy1;
+      k = l - mxy1*kz;
+/* loop over tiles in z, assume periodic boundary conditions */
+      lk = kz*mxy1;
+/* find tile behind */
+      ll = kz - 1;
+      if (ll < 0)
+         ll += mz1;
+      ll = ll*mxy1;
+/* find tile in front */
+      lr = kz + 1;
+      if (lr >= mz1)
+         lr -= mz1;
+      lr = lr*mxy1;
+      ky = k/mx1;
+/* loop over tiles in y, assume periodic boundary conditions */
+      kk = ky*mx1;
+/* find tile above */
+      kl = ky - 1;
+      if (kl < 0)
+         kl += my1;
+      kl = kl*mx1;
+/* find tile below */
+      kr = ky + 1;
+      if (kr >= my1)
+         kr -= my1;
+      kr = kr*mx1;
+/* loop over tiles in x, assume periodic boundary conditions */
+      kx = k - ky*mx1;
+      kxl = kx - 1 ;
+      if (kxl < 0)
+         kxl += mx1;
+      kxr = kx + 1;
+      if (kxr >= mx1)
+         kxr -= mx1;
+/* find tile number for different directions */
+      ks[0] = kxr + kk + lk;
+      ks[1] = kxl + kk + lk;
+      ks[2] = kx + kr + lk;
+      ks[3] = kxr + kr + lk;
+      ks[4] = kxl + kr + lk;
+      ks[5] = kx + kl + lk;
+      ks[6] = kxr + kl + lk;
+      ks[7] = kxl + kl + lk;
+      ks[8] = kx + kk + lr;
+      ks[9] = kxr + kk + lr;
+      ks[10] = kxl + kk + lr;
+      ks[11] = kx + kr + lr;
+      ks[12] = kxr + kr + lr;
+      ks[13] = kxl + kr + lr;
+      ks[14] = kx + kl + lr;
+      ks[15] = kxr + kl + lr;
+      ks[16] = kxl + kl + lr;
+      ks[17] = kx + kk + ll;
+      ks[18] = kxr + kk + ll;
+      ks[19] = kxl + kk + ll;
+      ks[20] = kx + kr + ll;
+      ks[21] = kxr + kr + ll;
+      ks[22] = kxl + kr + ll;
+      ks[23] = kx + kl + ll;
+      ks[24] = kxr + kl + ll;
+      ks[25] = kxl + kl + ll;
+/* loop over directions */
+      nh = ihole[2*(ntmax+1)*l];
+      ncoff = 0;
+      ih = 0;
+      ist = 0;
+      j1 = 0;
+      for (ii = 0; ii < 26; ii++) {
+         nboff = idimp*npbmx*ks[ii];
+         if (ii > 0)
+            ncoff = ncl[ii-1+26*ks[ii]];
+/* ip = number of particles coming from direction ii */
+         ip = ncl[ii+26*ks[ii]] - ncoff;
+/* loop over particles coming from direction ii */
+         ipp = ip/NPBLK;
+/* outer loop over number of full blocks */
+         for (m = 0; m < ipp; m++) {
+            joff = NPBLK*m;
+/* inner loop over particles in block */
+            for (j = 0; j < NPBLK; j++) {
+/* insert incoming particles into holes */
+               if ((j+ih) < nh) {
+                  j1 = ihole[2*(j+ih+1+(ntmax+1)*l)] - 1;
+               }
+/* place overflow at end of array */
+               else {
+                  j1 = npp + j + ih - nh;
+               }
+               n[j] = j1;
+            }
+            for (i = 0; i < idimp; i++) {
+               for (j = 0; j < NPBLK; j++) {
+                  j1 = n[j];
+                  if (j1 < nppmx) {
+                     ppart[j1+nppmx*i+npoff]
+                     = ppbuff[j+joff+ncoff+npbmx*i+nboff];
+                  }
+                  else {
+                    ist = 1;
+                  }
+               }
+            }
+            ih += NPBLK;
+         }
+         nps = NPBLK*ipp;
+/* loop over remaining particles */
+         for (j = nps; j < ip; j++) {
+            ih += 1;
+/* insert incoming particles into holes */
+            if (ih <= nh) {
+               j1 = ihole[2*(ih+(ntmax+1)*l)] - 1;
+            }
+/* place overflow at end of array */
+            else {
+               j1 = npp + ih - nh - 1;
+            }
+            if (j1 < nppmx) {
+               for (i = 0; i < idimp; i++) {
+                  ppart[j1+nppmx*i+npoff]
+                  = ppbuff[j+ncoff+npbmx*i+nboff];
+                }
+            }
+            else {
+               ist = 1;
+            }
+         }
+      }
+      if (ih > nh)
+         npp = npp + ih - nh;
+/* set error */
+      if (ist > 0)
+         *irc = j1+1;
+/* fill up remaining holes in particle array with particles from bottom */
+/* holes with locations great than npp-ip do not need to be filled */
+      if (ih < nh) {
+         ip = nh - ih;
+/* move particles from end into remaining holes */
+/* holes are processed in increasing order      */
+         ii = nh;
+         ipp = ip/NPBLK;
+/* outer loop over number of full blocks */
+         for (m = 0; m < ipp; m++) {
+            joff = NPBLK*m;
+/* inner loop over particles in block */
+            for (j = 0; j < NPBLK; j++) {
+               n[j+NPBLK] = ihole[2*(ih+j+1+(ntmax+1)*l)] - 1;
+               n[j+2*NPBLK] = ihole[2*(ii-j+(ntmax+1)*l)] - 1;
+            }
+            in = 0;
+            mm = 0;
+            nn = n[in+2*NPBLK];
+            for (j = 0; j < NPBLK; j++) {
+               j1 = npp - j - joff - 1;
+               n[j] = n[mm+NPBLK];
+               if (j1==nn) {
+                  in += 1;
+                  nn = n[in+2*NPBLK];
+                  n[j] = -1;
+               }
+               else {
+                  mm += 1;
+               }
+            }
+            for (i = 0; i < idimp; i++) {
+               for (j = 0; j < NPBLK; j++) {
+                  j1 = npp - j - joff - 1;
+                  j2 = n[j];
+                  if (j2 >= 0) {
+                     ppart[j2+nppmx*i+npoff]
+                     = ppart[j1+nppmx*i+npoff];
+                  }
+               }
+            }
+            ii -= in;
+            ih += mm;
+         }
+         nps = NPBLK*ipp;
+         nn = ihole[2*(ii+(ntmax+1)*l)] - 1;
+         ih += 1;
+         j2 = ihole[2*(ih+(ntmax+1)*l)] - 1;
+/* loop over remaining particles */
+         for (j = nps; j < ip; j++) {
+            j1 = npp - j - 1;
+            if (j1==nn) {
+               ii -= 1;
+               nn = ihole[2*(ii+(ntmax+1)*l)] - 1;
+            }
+            else {
+               for (i = 0; i < idimp; i++) {
+                  ppart[j2+nppmx*i+npoff]
+                  = ppart[j1+nppmx*i+npoff];
+               }
+               ih += 1;
+               j2 = ihole[2*(ih+(ntmax+1)*l)] - 1;
+            }
+         }
+         npp -= ip;
+      }
+      kpic[l] = npp;
+   }
+   return;
+}
+
+/* Interfaces to Fortran */
+
+/*--------------------------------------------------------------------*/
+int cavxcheck_() {
+   return cavxcheck();
+}
+
+/*--------------------------------------------------------------------*/
+void cavxgbppush3lt_(float *ppart, float *fxyz, float *bxyz, int *kpic,
+                     float *qbm, float *dt, float *dtc, float *ek,
+                     int *idimp, int *nppmx, int *nx, int *ny, int *nz,
+                     int *mx, int *my, int *mz, int *nxv, int *nyv,
+                     int *nzv, int *mx1, int *my1, int *mxyz1,
+                     int *ipbc) {
+   cavxgbppush3lt(ppart,fxyz,bxyz,kpic,*qbm,*dt,*dtc,ek,*idimp,*nppmx,
+                  *nx,*ny,*nz,*mx,*my,*mz,*nxv,*nyv,*nzv,*mx1,*my1,
+                  *mxyz1,*ipbc);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cavxgrbppush3lt_(float *ppart, float *fxyz, float *bxyz, int *kpic,
+                      float *qbm, float *dt, float *dtc, float *ci,
+                      float *ek, int *idimp, int *nppmx, int *nx,
+                      int *ny, int *nz, int *mx, int *my, int *mz,
+                      int *nxv, int *nyv, int *nzv, int *mx1, int *my1,
+                      int *mxyz1, int *ipbc) {
+   cavxgrbppush3lt(ppart,fxyz,bxyz,kpic,*qbm,*dt,*dtc,*ci,ek,*idimp,
+                   *nppmx,*nx,*ny,*nz,*mx,*my,*mz,*nxv,*nyv,*nzv,*mx1,
+                   *my1,*mxyz1,*ipbc);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cavxgjppost3lt_(float *ppart, float *cu, int *kpic, float *qm,
+                     float *dt, int *nppmx, int *idimp, int *nx,
+                     int *ny, int *nz, int *mx, int *my, int *mz,
+                     int *nxv, int *nyv, int *nzv, int *mx1, int *my1,
+                     int *mxyz1, int *ipbc) {
+   cavxgjppost3lt(ppart,cu,kpic,*qm,*dt,*nppmx,*idimp,*nx,*ny,*nz,*mx,
+                  *my,*mz,*nxv,*nyv,*nzv,*mx1,*my1,*mxyz1,*ipbc);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cavxgrjppost3lt_(float *ppart, float *cu, int *kpic, float *qm,
+                      float *dt, float *ci, int *nppmx, int *idimp,
+                      int *nx, int *ny, int *nz, int *mx, int *my,
+                      int *mz, int *nxv, int *nyv, int *nzv, int *mx1,
+                      int *my1, int *mxyz1, int *ipbc) {
+   cavxgrjppost3lt(ppart,cu,kpic,*qm,*dt,*ci,*nppmx,*idimp,*nx,*ny,*nz,
+                   *mx,*my,*mz,*nxv,*nyv,*nzv,*mx1,*my1,*mxyz1,*ipbc);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cavxpporder3lt_(float *ppart, float *ppbuff, int *kpic, int *ncl,
+                     int *ihole, int *idimp, int *nppmx, int *nx,
+                     int *ny, int *nz, int *mx, int *my, int *mz,
+                     int *mx1, int *my1, int *mz1, int *npbmx,
+                     int *ntmax, int *irc) {
+   cavxpporder3lt(ppart,ppbuff,kpic,ncl,ihole,*idimp,*nppmx,*nx,*ny,*nz,
+                  *mx,*my,*mz,*mx1,*my1,*mz1,*npbmx,*ntmax,irc);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cavxpporderf3lt_(float *ppart, float *ppbuff, int *kpic, int *ncl,
+                      int *ihole, int *idimp, int *nppmx, int *mx1,
+                      int *my1, int *mz1, int *npbmx, int *ntmax,
+                      int *irc) {
+   cavxpporderf3lt(ppart,ppbuff,kpic,ncl,ihole,*idimp,*nppmx,*mx1,*my1,
+                   *mz1,*npbmx,*ntmax,irc);
+   return;
+}
+
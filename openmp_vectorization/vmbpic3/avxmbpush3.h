@@ -0,0 +1,38 @@
+/* header file for avxmbpush3.c */
+
+int cavxcheck();
+
+void cavxgbppush3lt(float ppart[], float fxyz[], float bxyz[],
+                    int kpic[], float qbm, float dt, float dtc,
+                    float *ek, int idimp, int nppmx, int nx, int ny,
+                    int nz, int mx, int my, int mz, int nxv, int nyv,
+                    int nzv, int mx1, int my1, int mxyz1, int ipbc);
+
+void cavxgrbppush3lt(float ppart[], float fxyz[], float bxyz[],
+                     int kpic[], float qbm, float dt, float dtc,
+                     float ci, float *ek, int idimp, int nppmx, int nx,
+                     int ny, int nz, int mx, int my, int mz, int nxv,
+                     int nyv, int nzv, int mx1, int my1, int mxyz1,
+                     int ipbc);
+
+void cavxgjppost3lt(float ppart[], float cu[], int kpic[], float qm,
+                    float dt, int nppmx, int idimp, int nx, int ny,
+                    int nz, int mx, int my, int mz, int nxv, int nyv,
+                    int nzv, int mx1, int my1, int mxyz1, int ipbc);
+
+void cavxgrjppost3lt(float ppart[], float cu[], int kpic[], float qm,
+                     float dt, float ci, int nppmx, int idimp, int nx,
+                     int ny, int nz, int mx, int my, int mz, int nxv,
+                     int nyv, int nzv, int mx1, int my1, int mxyz1,
+                     int ipbc);
+
+void cavxpporder3lt(float ppart[], float ppbuff[], int kpic[], int ncl[],
+                    int ihole[], int idimp, int nppmx, int nx, int ny,
+                    int nz, int mx, int my, int mz, int mx1, int my1,
+                    int mz1, int npbmx, int ntmax, int *irc);
+
+void cavxpporderf3lt(float ppart[], float ppbuff[], int kpic[],
+                     int ncl[], int ihole[], int idimp, int nppmx,
+                     int mx1, int my1, int mz1, int npbmx, int ntmax,
+                     int *irc);
+
@@ -0,0 +1,101 @@
+!-----------------------------------------------------------------------
+! Interface file for avxmbpush3.c
+      module avxmbpush3_h
+      implicit none
+!
+      interface
+         function cavxcheck()
+         implicit none
+         integer :: cavxcheck
+         end function
+      end interface
+!
+      interface
+         subroutine cavxgbppush3lt(ppart,fxyz,bxyz,kpic,qbm,dt,dtc,ek,  &
+     &idimp,nppmx,nx,ny,nz,mx,my,mz,nxv,nyv,nzv,mx1,my1,mxyz1,ipbc)
+         implicit none
+         integer, intent(in) :: idimp, nppmx, nx, ny, nz, mx, my, mz
+         integer, intent(in) :: nxv, nyv, nzv, mx1, my1, mxyz1, ipbc
+         real, intent(in) :: qbm, dt, dtc
+         real, intent(inout) :: ek
+         real, dimension(nppmx,idimp,mxyz1), intent(inout) :: ppart
+         real, dimension(4,nxv,nyv,nzv), intent(in) :: fxyz, bxyz
+         integer, dimension(mxyz1), intent(in) :: kpic
+         end subroutine
+      end interface
+!
+      interface
+         subroutine cavxgrbppush3lt(ppart,fxyz,bxyz,kpic,qbm,dt,dtc,ci, &
+     &ek,idimp,nppmx,nx,ny,nz,mx,my,mz,nxv,nyv,nzv,mx1,my1,mxyz1,ipbc)
+         implicit none
+         integer, intent(in) :: idimp, nppmx, nx, ny, nz, mx, my, mz
+         integer, intent(in) :: nxv, nyv, nzv, mx1, my1, mxyz1, ipbc
+         real, intent(in) :: qbm, dt, dtc, ci
+         real, intent(inout) :: ek
+         real, dimension(nppmx,idimp,mxyz1), intent(inout) :: ppart
+         real, dimension(4,nxv,nyv,nzv), intent(in) :: fxyz, bxyz
+         integer, dimension(mxyz1), intent(in) :: kpic
+         end subroutine
+      end interface
+!
+      interface
+         subroutine cavxgjppost3lt(ppart,cu,kpic,qm,dt,nppmx,idimp,nx,ny&
+     &,nz,mx,my,mz,nxv,nyv,nzv,mx1,my1,mxyz1,ipbc)
+         implicit none
+         integer, intent(in) :: nppmx, idimp, nx, ny, nz, mx, my, mz
+         integer, intent(in) :: nxv, nyv, nzv, mx1, my1, mxyz1, ipbc
+         real, intent(in) :: qm, dt
+         real, dimension(nppmx,idimp,mxyz1), intent(inout) :: ppart
+         real, dimension(4,nxv,nyv,nzv), intent(inout) :: cu
+         integer, dimension(mxyz1), intent(in) :: kpic
+         end subroutine
+      end interface
+!
+      interface
+         subroutine cavxgrjppost3lt(ppart,cu,kpic,qm,dt,ci,nppmx,idimp, &
+     &nx,ny,nz,mx,my,mz,nxv,nyv,nzv,mx1,my1,mxyz1,ipbc)
+         implicit none
+         integer, intent(in) :: nppmx, idimp, nx, ny, nz, mx, my, mz
+         integer, intent(in) :: nxv, nyv, nzv, mx1, my1, mxyz1, ipbc
+         real, intent(in) :: qm, dt, ci
+         real, dimension(nppmx,idimp,mxyz1), intent(inout) :: ppart
+         real, dimension(4,nxv,nyv,nzv), intent(inout) :: cu
+         integer, dimension(mxyz1), intent(in) :: kpic
+         end subroutine
+      end interface
+!
+      interface
+         subroutine cavxpporder3lt(ppart,ppbuff,kpic,ncl,ihole,idimp,   &
+     &nppmx,nx,ny,nz,mx,my,mz,mx1,my1,mz1,npbmx,ntmax,irc)
+         implicit none
+         integer, intent(in) :: idimp, nppmx, nx, ny, nz, mx, my, mz
+         integer, intent(in) :: mx1, my1, mz1, npbmx, ntmax
+         integer, intent(inout) :: irc
+         real, dimension(nppmx,idimp,mx1*my1*mz1), intent(inout) ::     &
+     &ppart
+         real, dimension(npbmx,idimp,mx1*my1*mz1), intent(inout) ::     &
+     &ppbuff
+         integer, dimension(mx1*my1*mz1), intent(inout) :: kpic
+         integer, dimension(26,mx1*my1*mz1), intent(inout) :: ncl
+         integer, dimension(2,ntmax+1,mx1*my1*mz1), intent(inout) :: ihole
+         end subroutine
+      end interface
+!
+      interface
+         subroutine cavxpporderf3lt(ppart,ppbuff,kpic,ncl,ihole,idimp,  &
+     &nppmx,mx1,my1,mz1,npbmx,ntmax,irc)
+         implicit none
+         integer, intent(in) :: idimp, nppmx, mx1, my1, mz1, npbmx
+         integer, intent(in) :: ntmax
+         integer, intent(inout) :: irc
+         real, dimension(nppmx,idimp,mx1*my1*mz1), intent(inout) ::     &
+     &ppart
+         real, dimension(npbmx,idimp,mx1*my1*mz1), intent(inout) ::     &
+     &ppbuff
+         integer, dimension(mx1*my1*mz1), intent(inout) :: kpic
+         integer, dimension(26,mx1*my1*mz1), intent(inout) :: ncl
+         integer, dimension(2,ntmax+1,mx1*my1*mz1), intent(in) :: ihole
+         end subroutine
+      end interface
+!
+      end module
@@ -9,6 +9,8 @@
 #include <immintrin.h>
 #include "kncmbpush3.h"
 
+#ifdef __MIC__
+
 /*--------------------------------------------------------------------*/
 void ckncgbppush3lt(float ppart[], float fxyz[], float bxyz[],
                     int kpic[], float qbm, float dt, float dtc,
@@ -21809,6 +21811,288 @@ void ckncwfft3rm3(float complex f[], int isign, int mixup[],
    return;
 }
 
+#else
+
+/* KNC intrinsics are only available when compiling for the Xeon Phi */
+/* coprocessor (__MIC__).  Otherwise these procedures abort, and the  */
+/* autovector (kvec = 1) or AVX-512F/AVX2 (kvec = 3) versions must be */
+/* used.                                                              */
+
+static void cknc_none(const char *name) {
+   fprintf(stderr,"%s: KNC version not available in this build\n",name);
+   exit(1);
+}
+
+/*--------------------------------------------------------------------*/
+void ckncgbppush3lt(float ppart[], float fxyz[], float bxyz[],
+                    int kpic[], float qbm, float dt, float dtc,
+                    float *ek, int idimp, int nppmx, int nx, int ny,
+                    int nz, int mx, int my, int mz, int nxv, int nyv,
+                    int nzv, int mx1, int my1, int mxyz1,int ipbc) {
+   cknc_none("ckncgbppush3lt");
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void ckncgbppushf3lt(float ppart[], float fxyz[], float bxyz[],
+                     int kpic[], int ncl[], int ihole[], float qbm,
+                     float dt, float dtc, float *ek, int idimp,
+                     int nppmx, int nx, int ny, int nz, int mx, int my,
+                     int mz, int nxv, int nyv, int nzv, int mx1,
+                     int my1, int mxyz1, int ntmax, int *irc) {
+   cknc_none("ckncgbppushf3lt");
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void ckncgrbppush3lt(float ppart[], float fxyz[], float bxyz[],
+                     int kpic[], float qbm, float dt, float dtc,
+                     float ci, float *ek, int idimp, int nppmx, int nx,
+                     int ny, int nz, int mx, int my, int mz, int nxv,
+                     int nyv, int nzv, int mx1, int my1, int mxyz1,
+                     int ipbc) {
+   cknc_none("ckncgrbppush3lt");
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void ckncgrbppushf3lt(float ppart[], float fxyz[], float bxyz[],
+                      int kpic[], int ncl[], int ihole[], float qbm,
+                      float dt, float dtc, float ci, float *ek,
+                      int idimp, int nppmx, int nx, int ny, int nz,
+                      int mx, int my, int mz, int nxv, int nyv, int nzv,
+                      int mx1, int my1, int mxyz1, int ntmax,
+                      int *irc) {
+   cknc_none("ckncgrbppushf3lt");
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void ckncgppost3lt(float ppart[], float q[], int kpic[], float qm,
+                   int nppmx, int idimp, int mx, int my, int mz,
+                   int nxv, int nyv, int nzv, int mx1, int my1,
+                   int mxyz1) {
+   cknc_none("ckncgppost3lt");
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cknc2gppost3lt(float ppart[], float q[], int kpic[], float qm,
+                    int nppmx, int idimp, int mx, int my, int mz,
+                    int nxv, int nyv, int nzv, int mx1, int my1,
+                    int mxyz1) {
+   cknc_none("cknc2gppost3lt");
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void ckncgjppost3lt(float ppart[], float cu[], int kpic[], float qm,
+                    float dt, int nppmx, int idimp, int nx, int ny,
+                    int nz, int mx, int my, int mz, int nxv, int nyv,
+                    int nzv, int mx1, int my1, int mxyz1, int ipbc) {
+   cknc_none("ckncgjppost3lt");
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void ckncgjppostf3lt(float ppart[], float cu[], int kpic[], int ncl[],
+                     int ihole[], float qm, float dt, int nppmx,
+                     int idimp, int nx, int ny, int nz, int mx, int my,
+                     int mz, int nxv, int nyv, int nzv, int mx1,
+                     int my1, int mxyz1, int ntmax, int *irc) {
+   cknc_none("ckncgjppostf3lt");
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void ckncgrjppost3lt(float ppart[], float cu[], int kpic[], float qm,
+                     float dt, float ci, int nppmx, int idimp, int nx,
+                     int ny, int nz, int mx, int my, int mz, int nxv,
+                     int nyv, int nzv, int mx1, int my1, int mxyz1,
+                     int ipbc) {
+   cknc_none("ckncgrjppost3lt");
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void ckncgrjppostf3lt(float ppart[], float cu[], int kpic[], int ncl[],
+                      int ihole[], float qm, float dt, float ci,
+                      int nppmx, int idimp, int nx, int ny, int nz,
+                      int mx, int my, int mz, int nxv, int nyv, int nzv,
+                      int mx1, int my1, int mxyz1, int ntmax,
+                      int *irc) {
+   cknc_none("ckncgrjppostf3lt");
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cknc2gjppost3lt(float ppart[], float cu[], int kpic[], float qm,
+                     float dt, int nppmx, int idimp, int nx, int ny,
+                     int nz, int mx, int my, int mz, int nxv, int nyv,
+                     int nzv, int mx1, int my1, int mxyz1, int ipbc) {
+   cknc_none("cknc2gjppost3lt");
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cknc2grjppost3lt(float ppart[], float cu[], int kpic[], float qm,
+                      float dt, float ci, int nppmx, int idimp, int nx,
+                      int ny, int nz, int mx, int my, int mz, int nxv,
+                      int nyv, int nzv, int mx1, int my1, int mxyz1,
+                      int ipbc) {
+   cknc_none("cknc2grjppost3lt");
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void ckncpporder3lt(float ppart[], float ppbuff[], int kpic[],
+                    int ncl[], int ihole[], int idimp, int nppmx, 
+                    int nx, int ny, int nz, int mx, int my, int mz,
+                    int mx1, int my1, int mz1, int npbmx, int ntmax,
+                    int *irc) {
+   cknc_none("ckncpporder3lt");
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void ckncpporderf3lt(float ppart[], float ppbuff[], int kpic[],
+                     int ncl[], int ihole[], int idimp, int nppmx,
+                     int mx1, int my1, int mz1, int npbmx, int ntmax,
+                     int *irc) {
+   cknc_none("ckncpporderf3lt");
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void ckncpp2order3lt(float ppart[], float ppbuff[], int kpic[],
+                     int ncl[], int ihole[], int idimp, int nppmx, 
+                     int nx, int ny, int nz, int mx, int my, int mz,
+                     int mx1, int my1, int mz1, int npbmx, int ntmax,
+                     int *irc) {
+   cknc_none("ckncpp2order3lt");
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cknccguard3l(float fxyz[], int nx, int ny, int nz, int nxe,
+                  int nye, int nze) {
+   cknc_none("cknccguard3l");
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void ckncacguard3l(float cu[], int nx, int ny, int nz, int nxe, int nye,
+                   int nze) {
+   cknc_none("ckncacguard3l");
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void ckncaguard3l(float q[], int nx, int ny, int nz, int nxe, int nye,
+                  int nze) {
+   cknc_none("ckncaguard3l");
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void ckncmpois33(float complex q[], float complex fxyz[], int isign,
+                 float complex ffc[], float ax, float ay, float az,
+                 float affp, float *we, int nx, int ny, int nz,
+                 int nxvh, int nyv, int nzv, int nxhd, int nyhd,
+                 int nzhd) {
+   cknc_none("ckncmpois33");
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void ckncmcuperp3(float complex cu[], int nx, int ny, int nz, int nxvh,
+                  int nyv, int nzv) {
+   cknc_none("ckncmcuperp3");
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void ckncmibpois33(float complex cu[], float complex bxyz[],
+                   float complex ffc[], float ci, float *wm, int nx,
+                   int ny, int nz, int nxvh, int nyv, int nzv, int nxhd,
+                   int nyhd, int nzhd) {
+   cknc_none("ckncmibpois33");
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void ckncmmaxwel3(float complex exyz[], float complex bxyz[],
+                  float complex cu[], float complex ffc[], float ci,
+                  float dt, float *wf, float *wm, int nx, int ny,
+                  int nz, int nxvh, int nyv, int nzv, int nxhd,
+                  int nyhd, int nzhd) {
+   cknc_none("ckncmmaxwel3");
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void ckncmemfield3(float complex fxyz[], float complex exyz[],
+                   float complex ffc[], int isign, int nx, int ny,
+                   int nz, int nxvh, int nyv, int nzv, int nxhd,
+                   int nyhd, int nzhd) {
+   cknc_none("ckncmemfield3");
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void ckncfft3rmxy(float complex f[], int isign, int mixup[],
+                  float complex sct[], int indx, int indy, int indz,
+                  int nzi, int nzp, int nxhd, int nyd, int nzd,
+                  int nxhyzd, int nxyzhd) {
+   cknc_none("ckncfft3rmxy");
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void ckncfft3rmz(float complex f[], int isign, int mixup[],
+                 float complex sct[], int indx, int indy, int indz,
+                 int nyi, int nyp, int nxhd, int nyd, int nzd,
+                 int nxhyzd, int nxyzhd) {
+   cknc_none("ckncfft3rmz");
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void ckncfft3rm3xy(float complex f[], int isign, int mixup[],
+                   float complex sct[], int indx, int indy, int indz,
+                   int nzi, int nzp, int nxhd, int nyd, int nzd,
+                   int nxhyzd, int nxyzhd) {
+   cknc_none("ckncfft3rm3xy");
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void ckncfft3rm3z(float complex f[], int isign, int mixup[],
+                  float complex sct[], int indx, int indy, int indz,
+                  int nyi, int nyp, int nxhd, int nyd, int nzd,
+                  int nxhyzd, int nxyzhd) {
+   cknc_none("ckncfft3rm3z");
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void ckncwfft3rmx(float complex f[], int isign, int mixup[],
+                  float complex sct[], int indx, int indy, int indz,
+                  int nxhd, int nyd, int nzd, int nxhyzd, int nxyzhd) {
+   cknc_none("ckncwfft3rmx");
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void ckncwfft3rm3(float complex f[], int isign, int mixup[],
+                  float complex sct[], int indx, int indy, int indz,
+                  int nxhd, int nyd, int nzd, int nxhyzd, int nxyzhd) {
+   cknc_none("ckncwfft3rm3");
+   return;
+}
+
+#endif
+
 /* Interfaces to Fortran */
 
 /*--------------------------------------------------------------------*/
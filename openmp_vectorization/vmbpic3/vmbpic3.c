@@ -9,6 +9,7 @@
 #include "omplib.h"
 #include "avx512lib3.h"
 #include "kncmbpush3.h"
+#include "avxmbpush3.h"
 
 void dtimer(double *time, struct timeval *itime, int icntrl);
 
@@ -42,7 +43,7 @@ int main(int argc, char *argv[]) {
    int mx = 8, my = 8, mz = 8;
 /* xtras = fraction of extra particles needed for particle management */
    float xtras = 0.2;
-/* kvec = (1,2) = run (autovector,KNC) version */
+/* kvec = (1,2,3) = run (autovector,KNC,AVX-512F/AVX2) version */
    int kvec = 1;
 
 /* declare scalars for standard code */
@@ -99,6 +100,19 @@ int main(int argc, char *argv[]) {
 /* scanf("%i",&nvp);                   */
 /* initialize for shared memory parallel processing */
    cinit_omp(nvp);
+/* find instruction set for AVX-512F/AVX2 version */
+   if (kvec==3) {
+      if (cavxcheck()==2) {
+         printf("using AVX-512F version\n");
+      }
+      else if (cavxcheck()==1) {
+         printf("using AVX2 version\n");
+      }
+      else {
+         printf("AVX2 not available, using autovector version\n");
+         kvec = 1;
+      }
+   }
 
 /* initialize scalars for standard code */
 /* np = total number of particles in simulation */
@@ -228,6 +242,12 @@ L500: if (nloop <= ntime)
 /*          ckncgrjppostf3lt(ppartt,cue,kpic,ncl,ihole,qme,dth,ci,   */
 /*                           nppmx0,idimp,nx,ny,nz,mx,my,mz,nxe,nye, */
 /*                           nze,mx1,my1,mxyz1,ntmax,&irc);          */
+/* AVX-512F/AVX2 function */
+         else if (kvec==3)
+/* updates ppart, cue */
+            cavxgrjppost3lt(ppartt,cue,kpic,qme,dth,ci,nppmx0,idimp,nx,
+                            ny,nz,mx,my,mz,nxe,nye,nze,mx1,my1,mxyz1,
+                            ipbc);
       }
       else {
          if (kvec==1)
@@ -249,6 +269,11 @@ L500: if (nloop <= ntime)
 /*          ckncgjppostf3lt(ppartt,cue,kpic,ncl,ihole,qme,dth,nppmx0, */
 /*                          idimp,nx,ny,nz,mx,my,mz,nxe,nye,nze,mx1,  */
 /*                          my1 mxyz1,ntmax,&irc);                    */
+/* AVX-512F/AVX2 function */
+         else if (kvec==3)
+/* updates ppart, cue */
+            cavxgjppost3lt(ppartt,cue,kpic,qme,dth,nppmx0,idimp,nx,ny,
+                           nz,mx,my,mz,nxe,nye,nze,mx1,my1,mxyz1,ipbc);
       }
       dtimer(&dtime,&itime,1);
       time = (float) dtime;
@@ -280,6 +305,11 @@ L500: if (nloop <= ntime)
 /* updates ppartt, ppbuff, kpic, ncl, and irc */
 /*       ckncpporderf3lt(ppartt,ppbuff,kpic,ncl,ihole,idimp,nppmx0, */
 /*                       mx1,my1,mz1,npbmx,ntmax,&irc);             */
+/* AVX-512F/AVX2 function */
+      else if (kvec==3)
+/* updates ppartt, ppbuff, kpic, ncl, ihole, and irc */
+         cavxpporder3lt(ppartt,ppbuff,kpic,ncl,ihole,idimp,nppmx0,nx,
+                        ny,nz,mx,my,mz,mx1,my1,mz1,npbmx,ntmax,&irc);
       dtimer(&dtime,&itime,1);
       time = (float) dtime;
       tsort += time;
@@ -291,7 +321,7 @@ L500: if (nloop <= ntime)
 /* deposit charge with OpenMP: updates qe */
       dtimer(&dtime,&itime,-1);
       cset_szero3(qe,mx,my,mz,nxe,nye,nze,mx1,my1,mxyz1);
-      if (kvec==1)
+      if ((kvec==1) || (kvec==3))
          cvgppost3lt(ppartt,qe,kpic,qme,nppmx0,idimp,mx,my,mz,nxe,nye,
                      nze,mx1,my1,mxyz1);
 /* KNC function */
@@ -304,7 +334,7 @@ L500: if (nloop <= ntime)
 
 /* add guard cells with OpenMP: updates cue, qe */
       dtimer(&dtime,&itime,-1);
-      if (kvec==1) {
+      if ((kvec==1) || (kvec==3)) {
          cacguard3l(cue,nx,ny,nz,nxe,nye,nze);
          caguard3l(qe,nx,ny,nz,nxe,nye,nze);
       }
@@ -320,7 +350,7 @@ L500: if (nloop <= ntime)
 /* transform charge to fourier space with OpenMP: updates qe */
       dtimer(&dtime,&itime,-1);
       isign = -1;
-      if (kvec==1)
+      if ((kvec==1) || (kvec==3))
          cwfft3rvmx((float complex *)qe,isign,mixup,sct,indx,indy,indz,
                     nxeh,nye,nze,nxhyz,nxyzh);
 /* KNC function */
@@ -334,7 +364,7 @@ L500: if (nloop <= ntime)
 /* transform current to fourier space with OpenMP: update cue */
       dtimer(&dtime,&itime,-1);
       isign = -1;
-      if (kvec==1)
+      if ((kvec==1) || (kvec==3))
          cwfft3rvm3((float complex *)cue,isign,mixup,sct,indx,indy,indz,
                      nxeh,nye,nze,nxhyz,nxyzh);
 /* KNC function */
@@ -347,7 +377,7 @@ L500: if (nloop <= ntime)
 
 /* take transverse part of current with OpenMP: updates cue */
       dtimer(&dtime,&itime,-1);
-      if (kvec==1)
+      if ((kvec==1) || (kvec==3))
          cmcuperp3((float complex *)cue,nx,ny,nz,nxeh,nye,nze);
 /* KNC function */
       else if (kvec==2)
@@ -360,7 +390,7 @@ L500: if (nloop <= ntime)
 /* updates exyz, bxyz, wf, wm                                     */
       dtimer(&dtime,&itime,-1);
       if (ntime==0) {
-         if (kvec==1)
+         if ((kvec==1) || (kvec==3))
             cvmibpois33((float complex *)cue,bxyz,ffc,ci,&wm,nx,ny,nz,
                         nxeh,nye,nze,nxh,nyh,nzh);
 /* KNC function */
@@ -371,7 +401,7 @@ L500: if (nloop <= ntime)
          dth = 0.5*dt;
       }
       else {
-         if (kvec==1)
+         if ((kvec==1) || (kvec==3))
             cvmmaxwel3(exyz,bxyz,(float complex *)cue,ffc,ci,dt,&wf,&wm,
                        nx,ny,nz,nxeh,nye,nze,nxh,nyh,nzh);
 /* KNC function */
@@ -387,7 +417,7 @@ L500: if (nloop <= ntime)
 /* updates fxyze, we */
       dtimer(&dtime,&itime,-1);
       isign = -1;
-      if (kvec==1)
+      if ((kvec==1) || (kvec==3))
          cvmpois33((float complex *)qe,(float complex *)fxyze,isign,ffc,
                    ax,ay,az,affp,&we,nx,ny,nz,nxeh,nye,nze,nxh,nyh,nzh);
 /* KNC function */
@@ -403,7 +433,7 @@ L500: if (nloop <= ntime)
 /* updates fxyze */
       dtimer(&dtime,&itime,-1);
       isign = 1;
-      if (kvec==1)
+      if ((kvec==1) || (kvec==3))
          cvmemfield3((float complex *)fxyze,exyz,ffc,isign,nx,ny,nz,
                      nxeh,nye,nze,nxh,nyh,nzh);
 /* KNC function */
@@ -412,7 +442,7 @@ L500: if (nloop <= ntime)
                         nxeh,nye,nze,nxh,nyh,nzh);
 /* copy magnetic field with OpenMP: updates bxyze */
       isign = -1;
-      if (kvec==1)
+      if ((kvec==1) || (kvec==3))
          cvmemfield3((float complex *)bxyze,bxyz,ffc,isign,nx,ny,nz,
                      nxeh,nye,nze,nxh,nyh,nzh);
 /* KNC function */
@@ -426,7 +456,7 @@ L500: if (nloop <= ntime)
 /* transform force to real space with OpenMP: updates fxyze */
       dtimer(&dtime,&itime,-1);
       isign = 1;
-      if (kvec==1)
+      if ((kvec==1) || (kvec==3))
          cwfft3rvm3((float complex *)fxyze,isign,mixup,sct,indx,indy,
                     indz,nxeh,nye,nze,nxhyz,nxyzh);
 /* KNC function */
@@ -440,7 +470,7 @@ L500: if (nloop <= ntime)
 /* transform magnetic force to real space with OpenMP: updates bxyze */
       dtimer(&dtime,&itime,-1);
       isign = 1;
-      if (kvec==1)
+      if ((kvec==1) || (kvec==3))
          cwfft3rvm3((float complex *)bxyze,isign,mixup,sct,indx,indy,
                     indz,nxeh,nye,nze,nxhyz,nxyzh);
 /* KNC function */
@@ -453,7 +483,7 @@ L500: if (nloop <= ntime)
 
 /* copy guard cells with OpenMP: updates fxyze, bxyze */
       dtimer(&dtime,&itime,-1);
-      if (kvec==1) {
+      if ((kvec==1) || (kvec==3)) {
          ccguard3l(fxyze,nx,ny,nz,nxe,nye,nze);
          ccguard3l(bxyze,nx,ny,nz,nxe,nye,nze);
       }
@@ -495,6 +525,12 @@ L500: if (nloop <= ntime)
 /*          ckncgrbppushf3lt(ppartt,fxyze,bxyze,kpic,ncl,ihole,qbme,dt, */
 /*                           dth,ci,&wke,idimp,nppmx0,nx,ny,nz,mx,my,   */
 /*                           mz,nxe,nye,nze,mx1,my1,mxyz1,ntmax,&irc);  */
+/* AVX-512F/AVX2 function */
+         else if (kvec==3)
+/* updates ppart, wke */
+            cavxgrbppush3lt(ppartt,fxyze,bxyze,kpic,qbme,dt,dth,ci,
+                            &wke,idimp,nppmx0,nx,ny,nz,mx,my,mz,nxe,
+                            nye,nze,mx1,my1,mxyz1,ipbc);
       }
       else {
          if (kvec==1)
@@ -522,6 +558,12 @@ L500: if (nloop <= ntime)
 /*          ckncgbppushf3lt(ppartt,fxyze,bxyze,kpic,ncl,ihole,qbme,dt,  */
 /*                          dt,dth,&wke,idimp,nppmx0,nx,ny,nz,mx,my,mz, */
 /*                          nxe,nye,nze,mx1,my1,mxyz1,ntmax,&irc);      */
+/* AVX-512F/AVX2 function */
+         else if (kvec==3)
+/* updates ppart, wke */
+            cavxgbppush3lt(ppartt,fxyze,bxyze,kpic,qbme,dt,dth,&wke,
+                           idimp,nppmx0,nx,ny,nz,mx,my,mz,nxe,nye,nze,
+                           mx1,my1,mxyz1,ipbc);
       }
       dtimer(&dtime,&itime,1);
       time = (float) dtime;
@@ -553,6 +595,11 @@ L500: if (nloop <= ntime)
 /* updates ppartt, ppbuff, kpic, ncl, and irc */
 /*       ckncpporderf3lt(ppartt,ppbuff,kpic,ncl,ihole,idimp,nppmx0, */
 /*                       mx1,my1,mz1,npbmx,ntmax,&irc);             */
+/* AVX-512F/AVX2 function */
+      else if (kvec==3)
+/* updates ppartt, ppbuff, kpic, ncl, ihole, and irc */
+         cavxpporder3lt(ppartt,ppbuff,kpic,ncl,ihole,idimp,nppmx0,nx,
+                        ny,nz,mx,my,mz,mx1,my1,mz1,npbmx,ntmax,&irc);
       dtimer(&dtime,&itime,1);
       time = (float) dtime;
       tsort += time;
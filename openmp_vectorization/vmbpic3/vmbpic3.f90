@@ -4,6 +4,7 @@
       program vmbpic3
       use avx512flib3_h
       use kncmbpush3_h
+      use avxmbpush3_h
       use vmbpush3_h
       use omplib_h
       implicit none
@@ -36,7 +37,7 @@
       integer :: mx = 8, my = 8, mz = 8
 ! xtras = fraction of extra particles needed for particle management
       real :: xtras = 0.2
-! kvec = (1,2) = run (autovector,KNC) version
+! kvec = (1,2,3) = run (autovector,KNC,AVX-512F/AVX2) version
       integer :: kvec = 1
 !
 ! declare scalars for standard code
@@ -94,6 +95,17 @@
 !     read (5,*) nvp
 ! initialize for shared memory parallel processing
       call INIT_OMP(nvp)
+! find instruction set for AVX-512F/AVX2 version
+      if (kvec==3) then
+         if (cavxcheck()==2) then
+            write (*,*) 'using AVX-512F version'
+         else if (cavxcheck()==1) then
+            write (*,*) 'using AVX2 version'
+         else
+            write (*,*) 'AVX2 not available, using autovector version'
+            kvec = 1
+         endif
+      endif
 !
 ! initialize scalars for standard code
 ! np = total number of particles in simulation
@@ -219,6 +231,11 @@
 !           call ckncgrjppostf3lt(ppartt,cue,kpic,ncl,ihole,qme,dth,ci, &
 !    &nppmx0,idimp,nx,ny,nz,mx,my,mz,nxe,nye,nze,mx1,my1,mxyz1,ntmax,irc&
 !    &)
+! AVX-512F/AVX2 function
+         else if (kvec==3) then
+! updates ppart, cue
+            call cavxgrjppost3lt(ppartt,cue,kpic,qme,dth,ci,nppmx0,idimp&
+     &,nx,ny,nz,mx,my,mz,nxe,nye,nze,mx1,my1,mxyz1,ipbc)
          endif
       else
          if (kvec==1) then
@@ -243,6 +260,11 @@
 !           call ckncgjppostf3lt(ppartt,cue,kpic,ncl,ihole,qme,dth,     &
 !    &nppmx0,idimp,nx,ny,nz,mx,my,mz,nxe,nye,nze,mx1,my1,mxyz1,ntmax,irc&
 !    &)
+! AVX-512F/AVX2 function
+         else if (kvec==3) then
+! updates ppart, cue
+            call cavxgjppost3lt(ppartt,cue,kpic,qme,dth,nppmx0,idimp,nx,&
+     &ny,nz,mx,my,mz,nxe,nye,nze,mx1,my1,mxyz1,ipbc)
          endif
       endif
       call dtimer(dtime,itime,1)
@@ -280,6 +302,11 @@
 ! updates ppartt, ppbuff, kpic, ncl, and irc
 !        call ckncpporderf3lt(ppartt,ppbuff,kpic,ncl,ihole,idimp,nppmx0,&
 !    &mx1,my1,mz1,npbmx,ntmax,irc)
+! AVX-512F/AVX2 function
+      else if (kvec==3) then
+! updates ppartt, ppbuff, kpic, ncl, ihole, and irc
+         call cavxpporder3lt(ppartt,ppbuff,kpic,ncl,ihole,idimp,nppmx0, &
+     &nx,ny,nz,mx,my,mz,mx1,my1,mz1,npbmx,ntmax,irc)
       endif
       call dtimer(dtime,itime,1)
       time = real(dtime)
@@ -293,7 +320,7 @@
       call dtimer(dtime,itime,-1)
 ! zero out charge density
       call SET_SZERO3(qe,mx,my,mz,nxe,nye,nze,mx1,my1,mxyz1)
-      if (kvec==1) then
+      if ((kvec==1).or.(kvec==3)) then
 !        call GPPOST3LT(ppartt,qe,kpic,qme,nppmx0,idimp,mx,my,mz,nxe,   &
 !    &nye,nze,mx1,my1,mxyz1)
          call VGPPOST3LT(ppartt,qe,kpic,qme,nppmx0,idimp,mx,my,mz,nxe,  &
@@ -309,7 +336,7 @@
 !
 ! add guard cells with OpenMP: updates cue, qe
       call dtimer(dtime,itime,-1)
-      if (kvec==1) then
+      if ((kvec==1).or.(kvec==3)) then
          call ACGUARD3L(cue,nx,ny,nz,nxe,nye,nze)
          call AGUARD3L(qe,nx,ny,nz,nxe,nye,nze)
 ! KNC function
@@ -324,7 +351,7 @@
 ! transform charge to fourier space with OpenMP: updates qe
       call dtimer(dtime,itime,-1)
       isign = -1
-      if (kvec==1) then
+      if ((kvec==1).or.(kvec==3)) then
          call WFFT3RVMX(qe,isign,mixup,sct,indx,indy,indz,nxeh,nye,nze, &
      &nxhyz,nxyzh)
 ! KNC function
@@ -339,7 +366,7 @@
 ! transform current to fourier space with OpenMP: update cue
       call dtimer(dtime,itime,-1)
       isign = -1
-      if (kvec==1) then
+      if ((kvec==1).or.(kvec==3)) then
          call WFFT3RVM3(cue,isign,mixup,sct,indx,indy,indz,nxeh,nye,nze,&
      &nxhyz,nxyzh)
 ! KNC function
@@ -353,7 +380,7 @@
 !
 ! take transverse part of current with OpenMP: updates cue
       call dtimer(dtime,itime,-1)
-      if (kvec==1) then
+      if ((kvec==1).or.(kvec==3)) then
          call MCUPERP3(cue,nx,ny,nz,nxeh,nye,nze)
 ! KNC function
       else if (kvec==2) then
@@ -367,7 +394,7 @@
 ! updates exyz, bxyz, wf, wm
       call dtimer(dtime,itime,-1)
       if (ntime==0) then
-         if (kvec==1) then
+         if ((kvec==1).or.(kvec==3)) then
             call VMIBPOIS33(cue,bxyz,ffc,ci,wm,nx,ny,nz,nxeh,nye,nze,nxh&
      &,nyh,nzh)
 ! KNC function
@@ -378,7 +405,7 @@
          wf = 0.0
          dth = 0.5*dt
       else
-         if (kvec==1) then
+         if ((kvec==1).or.(kvec==3)) then
             call VMMAXWEL3(exyz,bxyz,cue,ffc,ci,dt,wf,wm,nx,ny,nz,nxeh, &
      &nye,nze,nxh,nyh,nzh)
 ! KNC function
@@ -395,7 +422,7 @@
 ! updates fxyze, we
       call dtimer(dtime,itime,-1)
       isign = -1
-      if (kvec==1) then
+      if ((kvec==1).or.(kvec==3)) then
          call VMPOIS33(qe,fxyze,isign,ffc,ax,ay,az,affp,we,nx,ny,nz,nxeh&
      &,nye,nze,nxh,nyh,nzh)
 ! KNC function
@@ -411,7 +438,7 @@
 ! updates fxyze
       call dtimer(dtime,itime,-1)
       isign = 1
-      if (kvec==1) then
+      if ((kvec==1).or.(kvec==3)) then
          call VMEMFIELD3(fxyze,exyz,ffc,isign,nx,ny,nz,nxeh,nye,nze,nxh,&
      &nyh,nzh)
 ! KNC function
@@ -421,7 +448,7 @@
       endif
 ! copy magnetic field with OpenMP: updates bxyze
       isign = -1
-      if (kvec==1) then
+      if ((kvec==1).or.(kvec==3)) then
          call VMEMFIELD3(bxyze,bxyz,ffc,isign,nx,ny,nz,nxeh,nye,nze,nxh,&
      &nyh,nzh)
 ! KNC function
@@ -436,7 +463,7 @@
 ! transform electric force to real space with OpenMP: updates fxyze
       call dtimer(dtime,itime,-1)
       isign = 1
-      if (kvec==1) then
+      if ((kvec==1).or.(kvec==3)) then
          call WFFT3RVM3(fxyze,isign,mixup,sct,indx,indy,indz,nxeh,nye,  &
      &nze,nxhyz,nxyzh)
 ! KNC function
@@ -451,7 +478,7 @@
 ! transform magnetic force to real space with OpenMP: updates bxyze
       call dtimer(dtime,itime,-1)
       isign = 1
-      if (kvec==1) then
+      if ((kvec==1).or.(kvec==3)) then
          call WFFT3RVM3(bxyze,isign,mixup,sct,indx,indy,indz,nxeh,nye,  &
      &nze,nxhyz,nxyzh)
 ! KNC function
@@ -465,7 +492,7 @@
 !
 ! copy guard cells with OpenMP: updates fxyze, bxyze
       call dtimer(dtime,itime,-1)
-      if (kvec==1) then
+      if ((kvec==1).or.(kvec==3)) then
          call CGUARD3L(fxyze,nx,ny,nz,nxe,nye,nze)
          call CGUARD3L(bxyze,nx,ny,nz,nxe,nye,nze)
 ! KNC function
@@ -508,6 +535,11 @@
 !           call ckncgrbppushf3lt(ppartt,fxyze,bxyze,kpic,ncl,ihole,qbme&
 !    &,dt,dth,ci,wke,idimp,nppmx0,nx,ny,nz,mx,my,mz,nxe,nye,nze,mx1,my1,&
 !    &mxyz1,ntmax,irc)
+! AVX-512F/AVX2 function
+         else if (kvec==3) then
+! updates ppart, wke
+            call cavxgrbppush3lt(ppartt,fxyze,bxyze,kpic,qbme,dt,dth,ci,&
+     &wke,idimp,nppmx0,nx,ny,nz,mx,my,mz,nxe,nye,nze,mx1,my1,mxyz1,ipbc)
          endif
       else
          if (kvec==1) then
@@ -537,6 +569,11 @@
 !           call ckncgbppushf3lt(ppartt,fxyze,bxyze,kpic,ncl,ihole,qbme,&
 !    &dt,dth,wke,idimp,nppmx0,nx,ny,nz,mx,my,mz,nxe,nye,nze,mx1,my1,    &
 !    &mxyz1,ntmax,irc)
+! AVX-512F/AVX2 function
+         else if (kvec==3) then
+! updates ppart, wke
+            call cavxgbppush3lt(ppartt,fxyze,bxyze,kpic,qbme,dt,dth,wke,&
+     &idimp,nppmx0,nx,ny,nz,mx,my,mz,nxe,nye,nze,mx1,my1,mxyz1,ipbc)
          endif
       endif
       call dtimer(dtime,itime,1)
@@ -574,6 +611,11 @@
 ! updates ppartt, ppbuff, kpic, ncl, and irc
 !        call ckncpporderf3lt(ppartt,ppbuff,kpic,ncl,ihole,idimp,nppmx0,&
 !    &mx1,my1,mz1,npbmx,ntmax,irc)
+! AVX-512F/AVX2 function
+      else if (kvec==3) then
+! updates ppartt, ppbuff, kpic, ncl, ihole, and irc
+         call cavxpporder3lt(ppartt,ppbuff,kpic,ncl,ihole,idimp,nppmx0, &
+     &nx,ny,nz,mx,my,mz,mx1,my1,mz1,npbmx,ntmax,irc)
       endif
       call dtimer(dtime,itime,1)
       time = real(dtime)
@@ -13,6 +13,10 @@ int main(int argc, char *argv[]) {
 /* indx/indy = exponent which determines grid points in x/y direction: */
 /* nx = 2**indx, ny = 2**indy */
    int indx =   9, indy =   9;
+/* nxg/nyg = number of grid points in x/y direction for a mixed radix */
+/* FFT, which replace 2**indx/2**indy if > 0.  nxg/nyg must be even, */
+/* and nxg/2 and nyg must not have prime factors larger than 127     */
+   int nxg =   0, nyg =   0;
 /* npx/npy = number of electrons distributed in x/y direction */
    int npx =  3072, npy =   3072;
 /* ndim = number of velocity coordinates = 3 */
@@ -38,7 +42,8 @@ int main(int argc, char *argv[]) {
 /* declare scalars for standard code */
    int j;
    int np, nx, ny, nxh, nyh, nxe, nye, nxeh, nxyh, nxhy;
-   int ny1, ntime, nloop, isign;
+   int ny1, ntime, nloop, isign, mrfft, nf;
+   int fac[32];
    float qbme, affp, dth;
 
 /* declare arrays for standard code: */
@@ -53,7 +58,7 @@ int main(int argc, char *argv[]) {
 /* ffc = form factor array for poisson solver */
 /* sct = sine/cosine table for FFT */
    float complex *ffc = NULL, *sct = NULL;
-/* mixup = bit reverse table for FFT */
+/* mixup = bit or digit reverse table for FFT */
 /* npicy = scratch array for reordering particles */
    int *mixup = NULL, *npicy = NULL;
 
@@ -68,9 +73,26 @@ int main(int argc, char *argv[]) {
 /* np = total number of particles in simulation */
 /* nx/ny = number of grid points in x/y direction */
    np = npx*npy; nx = 1L<<indx; ny = 1L<<indy;
+/* mrfft = (0,1) = use (radix 2,mixed radix) FFT */
+   mrfft = (nxg > 0) || (nyg > 0);
+   if (nxg > 0) nx = nxg;
+   if (nyg > 0) ny = nyg;
    nxh = nx/2; nyh = 1 > ny/2 ? 1 : ny/2;
    nxe = nx + 2; nye = ny + 1; nxeh = nxe/2;
    nxyh = (nx > ny ? nx : ny)/2; nxhy = nxh > ny ? nxh : ny;
+/* mixed radix FFT tables hold both x and y directions */
+   if (mrfft) {
+      nxyh = nx + ny; nxhy = nxh + ny;
+/* check that grid can be factored */
+      cfftmrfac(fac,nxh,&nf);
+      if ((nf >= 0) && ((nx%2)==0) && ((ny%2)==0))
+         cfftmrfac(fac,ny,&nf);
+      if ((nf < 0) || ((nx%2) != 0) || ((ny%2) != 0)) {
+         printf("unsupported grid for mixed radix FFT: nx,ny=%d,%d\n",
+                nx,ny);
+         exit(1);
+      }
+   }
    ny1 = ny + 1;
 /* nloop = number of time steps in simulation */
 /* ntime = current time step */
@@ -95,7 +117,10 @@ int main(int argc, char *argv[]) {
    npicy = (int *) malloc(ny1*sizeof(int));
 
 /* prepare fft tables */
-   cwfft2rinit(mixup,sct,indx,indy,nxhy,nxyh);
+   if (mrfft)
+      cwfft2rninit(mixup,sct,nx,ny,nxhy,nxyh);
+   else
+      cwfft2rinit(mixup,sct,indx,indy,nxhy,nxyh);
 /* calculate form factors */
    isign = 0;
    cpois23((float complex *)qe,(float complex *)fxyze,isign,ffc,ax,ay,
@@ -153,8 +178,12 @@ L500: if (nloop <= ntime)
 /* transform charge to fourier space with standard procedure: updates qe */
       dtimer(&dtime,&itime,-1);
       isign = -1;
-      cwfft2rx((float complex *)qe,isign,mixup,sct,indx,indy,nxeh,nye,
-               nxhy,nxyh);
+      if (mrfft)
+         cwfft2rnx((float complex *)qe,isign,mixup,sct,nx,ny,nxeh,nye,
+                   nxhy,nxyh);
+      else
+         cwfft2rx((float complex *)qe,isign,mixup,sct,indx,indy,nxeh,
+                  nye,nxhy,nxyh);
       dtimer(&dtime,&itime,1);
       time = (float) dtime;
       tfft += time;
@@ -162,8 +191,12 @@ L500: if (nloop <= ntime)
 /* transform current to fourier space with standard procedure: update cue */
       dtimer(&dtime,&itime,-1);
       isign = -1;
-      cwfft2r3((float complex *)cue,isign,mixup,sct,indx,indy,nxeh,nye,
-               nxhy,nxyh);
+      if (mrfft)
+         cwfft2rn3((float complex *)cue,isign,mixup,sct,nx,ny,nxeh,nye,
+                   nxhy,nxyh);
+      else
+         cwfft2r3((float complex *)cue,isign,mixup,sct,indx,indy,nxeh,
+                  nye,nxhy,nxyh);
       dtimer(&dtime,&itime,1);
       time = (float) dtime;
       tfft += time;
@@ -221,8 +254,12 @@ L500: if (nloop <= ntime)
 /* updates fxyze                                                   */
       dtimer(&dtime,&itime,-1);
       isign = 1;
-      cwfft2r3((float complex *)fxyze,isign,mixup,sct,indx,indy,nxeh,nye,
-               nxhy,nxyh);
+      if (mrfft)
+         cwfft2rn3((float complex *)fxyze,isign,mixup,sct,nx,ny,nxeh,nye,
+                   nxhy,nxyh);
+      else
+         cwfft2r3((float complex *)fxyze,isign,mixup,sct,indx,indy,nxeh,
+                  nye,nxhy,nxyh);
       dtimer(&dtime,&itime,1);
       time = (float) dtime;
       tfft += time;
@@ -231,8 +268,12 @@ L500: if (nloop <= ntime)
 /* updates bxyze                                                   */
       dtimer(&dtime,&itime,-1);
       isign = 1;
-      cwfft2r3((float complex *)bxyze,isign,mixup,sct,indx,indy,nxeh,nye,
-               nxhy,nxyh);
+      if (mrfft)
+         cwfft2rn3((float complex *)bxyze,isign,mixup,sct,nx,ny,nxeh,nye,
+                   nxhy,nxyh);
+      else
+         cwfft2r3((float complex *)bxyze,isign,mixup,sct,indx,indy,nxeh,
+                  nye,nxhy,nxyh);
       dtimer(&dtime,&itime,1);
       time = (float) dtime;
       tfft += time;
@@ -7,6 +7,10 @@
 ! indx/indy = exponent which determines grid points in x/y direction:
 ! nx = 2**indx, ny = 2**indy.
       integer, parameter :: indx =   9, indy =   9
+! nxg/nyg = number of grid points in x/y direction for a mixed radix
+! FFT, which replace 2**indx/2**indy if > 0.  nxg/nyg must be even,
+! and nxg/2 and nyg must not have prime factors larger than 127
+      integer, parameter :: nxg =   0, nyg =   0
 ! npx/npy = number of electrons distributed in x/y direction.
       integer, parameter :: npx =  3072, npy =   3072
 ! ndim = number of velocity coordinates = 3
@@ -33,7 +37,9 @@
       real :: wke = 0.0, we = 0.0, wf = 0.0, wm = 0.0, wt = 0.0
 ! declare scalars for standard code
       integer :: np, nx, ny, nxh, nyh, nxe, nye, nxeh, nxyh, nxhy
-      integer :: ny1, ntime, nloop, isign
+      integer :: ny1, ntime, nloop, isign, nf
+      logical :: mrfft
+      integer, dimension(32) :: fac
       real :: qbme, affp, dth
 !
 ! declare arrays for standard code:
@@ -48,7 +54,7 @@
       complex, dimension(:,:,:), pointer :: exyz, bxyz
 ! ffc = form factor array for poisson solver
       complex, dimension(:,:), pointer :: ffc
-! mixup = bit reverse table for FFT
+! mixup = bit or digit reverse table for FFT
       integer, dimension(:), pointer :: mixup
 ! sct = sine/cosine table for FFT
       complex, dimension(:), pointer :: sct
@@ -66,9 +72,27 @@
 ! np = total number of particles in simulation
 ! nx/ny = number of grid points in x/y direction
       np = npx*npy; nx = 2**indx; ny = 2**indy
+! mrfft = (.false.,.true.) = use (radix 2,mixed radix) FFT
+      mrfft = (nxg > 0).or.(nyg > 0)
+      if (nxg > 0) nx = nxg
+      if (nyg > 0) ny = nyg
       nxh = nx/2; nyh = max(1,ny/2)
       nxe = nx + 2; nye = ny + 1; nxeh = nxe/2
       nxyh = max(nx,ny)/2; nxhy = max(nxh,ny); ny1 = ny + 1
+! mixed radix FFT tables hold both x and y directions
+      if (mrfft) then
+         nxyh = nx + ny; nxhy = nxh + ny
+! check that grid can be factored
+         call FFTMRFAC(fac,nxh,nf)
+         if ((nf >= 0).and.(mod(nx,2)==0).and.(mod(ny,2)==0)) then
+            call FFTMRFAC(fac,ny,nf)
+         endif
+         if ((nf < 0).or.(mod(nx,2) /= 0).or.(mod(ny,2) /= 0)) then
+            write (*,*) 'unsupported grid for mixed radix FFT: nx,ny=', &
+     &nx, ny
+            stop
+         endif
+      endif
 ! nloop = number of time steps in simulation
 ! ntime = current time step
       nloop = tend/dt + .0001; ntime = 0
@@ -86,7 +110,11 @@
       allocate(npicy(ny1))
 !
 ! prepare fft tables
-      call WFFT2RINIT(mixup,sct,indx,indy,nxhy,nxyh)
+      if (mrfft) then
+         call WFFT2RNINIT(mixup,sct,nx,ny,nxhy,nxyh)
+      else
+         call WFFT2RINIT(mixup,sct,indx,indy,nxhy,nxyh)
+      endif
 ! calculate form factors
       isign = 0
       call POIS23(qe,fxyze,isign,ffc,ax,ay,affp,we,nx,ny,nxeh,nye,nxh,  &
@@ -144,7 +172,11 @@
 ! transform charge to fourier space with standard procedure: updates qe
       call dtimer(dtime,itime,-1)
       isign = -1
-      call WFFT2RX(qe,isign,mixup,sct,indx,indy,nxeh,nye,nxhy,nxyh)
+      if (mrfft) then
+         call WFFT2RNX(qe,isign,mixup,sct,nx,ny,nxeh,nye,nxhy,nxyh)
+      else
+         call WFFT2RX(qe,isign,mixup,sct,indx,indy,nxeh,nye,nxhy,nxyh)
+      endif
       call dtimer(dtime,itime,1)
       time = real(dtime)
       tfft = tfft + time
@@ -152,7 +184,11 @@
 ! transform current to fourier space with standard procedure: update cue
       call dtimer(dtime,itime,-1)
       isign = -1
-      call WFFT2R3(cue,isign,mixup,sct,indx,indy,nxeh,nye,nxhy,nxyh)
+      if (mrfft) then
+         call WFFT2RN3(cue,isign,mixup,sct,nx,ny,nxeh,nye,nxhy,nxyh)
+      else
+         call WFFT2R3(cue,isign,mixup,sct,indx,indy,nxeh,nye,nxhy,nxyh)
+      endif
       call dtimer(dtime,itime,1)
       time = real(dtime)
       tfft = tfft + time
@@ -205,7 +241,12 @@
 ! updates fxyze
       call dtimer(dtime,itime,-1)
       isign = 1
-      call WFFT2R3(fxyze,isign,mixup,sct,indx,indy,nxeh,nye,nxhy,nxyh)
+      if (mrfft) then
+         call WFFT2RN3(fxyze,isign,mixup,sct,nx,ny,nxeh,nye,nxhy,nxyh)
+      else
+         call WFFT2R3(fxyze,isign,mixup,sct,indx,indy,nxeh,nye,nxhy,nxyh&
+     &)
+      endif
       call dtimer(dtime,itime,1)
       time = real(dtime)
       tfft = tfft + time
@@ -214,7 +255,12 @@
 ! updates bxyze
       call dtimer(dtime,itime,-1)
       isign = 1
-      call WFFT2R3(bxyze,isign,mixup,sct,indx,indy,nxeh,nye,nxhy,nxyh)
+      if (mrfft) then
+         call WFFT2RN3(bxyze,isign,mixup,sct,nx,ny,nxeh,nye,nxhy,nxyh)
+      else
+         call WFFT2R3(bxyze,isign,mixup,sct,indx,indy,nxeh,nye,nxhy,nxyh&
+     &)
+      endif
       call dtimer(dtime,itime,1)
       time = real(dtime)
       tfft = tfft + time
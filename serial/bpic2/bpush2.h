@@ -89,3 +89,36 @@ void cwfft2rx(float complex f[], int isign, int mixup[],
 void cwfft2r3(float complex f[],int isign, int mixup[],
               float complex sct[], int indx, int indy, int nxhd, int nyd,
               int nxhyd, int nxyhd);
+
+void cfftmrfac(int fac[], int n, int *nf);
+
+void cfft1mr(float complex f[], int isign, int mixup[],
+             float complex sct[], int n, int nrs, int nes, int nvs,
+             int nvp);
+
+void cwfft2rninit(int mixup[], float complex sct[], int nx, int ny,
+                  int nxhyd, int nxyd);
+
+void cfft2rnxx(float complex f[], int isign, int mixup[],
+               float complex sct[], int nx, int ny, int nyi, int nyp,
+               int nxhd, int nyd, int nxhyd, int nxyd);
+
+void cfft2rnxy(float complex f[], int isign, int mixup[],
+               float complex sct[], int nx, int ny, int nxi, int nxp,
+               int nxhd, int nyd, int nxhyd, int nxyd);
+
+void cfft2rn3x(float complex f[], int isign, int mixup[],
+               float complex sct[], int nx, int ny, int nyi, int nyp,
+               int nxhd, int nyd, int nxhyd, int nxyd);
+
+void cfft2rn3y(float complex f[], int isign, int mixup[],
+               float complex sct[], int nx, int ny, int nxi, int nxp,
+               int nxhd, int nyd, int nxhyd, int nxyd);
+
+void cwfft2rnx(float complex f[], int isign, int mixup[],
+               float complex sct[], int nx, int ny, int nxhd, int nyd,
+               int nxhyd, int nxyd);
+
+void cwfft2rn3(float complex f[], int isign, int mixup[],
+               float complex sct[], int nx, int ny, int nxhd, int nyd,
+               int nxhyd, int nxyd);
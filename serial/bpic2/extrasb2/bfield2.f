@@ -1002,3 +1002,222 @@ c mode numbers ky = 0, ny/2
       endif
       return
       end
+c-----------------------------------------------------------------------
+      subroutine WKMODES2(pott,pkw,wm,dt,it,nt,ny,modesx,modesy,modesxd,
+     1modesyd,iw,iwd)
+c this subroutine accumulates a windowed discrete fourier transform in
+c time of the modes in pott, extracted by RDMODES2, for the frequencies
+c in wm, so that a frequency-wavenumber spectrum can be obtained without
+c storing the modes at each time step
+c pkw(j,k,l) = pkw(j,k,l) + dt*w(it)*pott(j,k)*exp(i*wm(l)*dt*(it-1))
+c where w(it) = 0.5*(1 - cos(2*pi*(it-1)/(nt-1))) is a hann window
+c a mode varying as exp(-i*w0*t) has a peak at wm(l) = w0
+c pkw must be zeroed before the first sample
+c pott = unpacked complex modes at sample it
+c pkw = accumulated transform for each mode and frequency
+c wm = frequencies to be calculated
+c dt = time interval between samples
+c it = sample number, 1 <= it <= nt, other samples are ignored
+c nt = total number of samples in window
+c ny = system length in y direction
+c modesx/modesy = number of modes stored in x/y direction
+c modesxd = first dimension of arrays pott, pkw, modesxd >= modesx
+c modesyd = second dimension of arrays pott, pkw,
+c where modesyd  >= min(2*modesy-1,ny)
+c iw = number of frequencies
+c iwd = third dimension of array pkw, iwd >= iw
+      implicit none
+      integer it, nt, ny, modesx, modesy, modesxd, modesyd, iw, iwd
+      real dt
+      complex pott, pkw
+      real wm
+      dimension pott(modesxd,modesyd), pkw(modesxd,modesyd,iwd)
+      dimension wm(iw)
+c local data
+      integer kmax, j, k, l
+      complex zt
+      double precision tt, wt
+      if ((it.lt.1).or.(it.gt.nt)) return
+      kmax = min0(2*modesy-1,ny)
+c hann window
+      wt = 1.0d0
+      if (nt.gt.1) then
+         wt = 6.283185307179586d0*dble(it-1)/dble(nt-1)
+         wt = 0.5d0*(1.0d0 - dcos(wt))
+      endif
+      wt = dble(dt)*wt
+      tt = dble(dt)*dble(it-1)
+      do 30 l = 1, iw
+      zt = cmplx(real(wt*dcos(dble(wm(l))*tt)),
+     1           real(wt*dsin(dble(wm(l))*tt)))
+      do 20 k = 1, kmax
+      do 10 j = 1, modesx
+      pkw(j,k,l) = pkw(j,k,l) + zt*pott(j,k)
+   10 continue
+   20 continue
+   30 continue
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine WKPOW2(pkw,wkp,dt,nt,ny,modesx,modesy,modesxd,modesyd,
+     1iw,iwd)
+c this subroutine calculates the frequency-wavenumber power spectrum
+c from the transform accumulated by WKMODES2 over nt samples
+c wkp(j,k,l) = |pkw(j,k,l)|**2/(dt*sum(w(it)**2))
+c where w(it) is the hann window used by WKMODES2
+c pkw = accumulated transform for each mode and frequency
+c wkp = power spectrum for each mode and frequency
+c dt = time interval between samples
+c nt = total number of samples in window
+c ny = system length in y direction
+c modesx/modesy = number of modes stored in x/y direction
+c modesxd = first dimension of arrays pkw, wkp, modesxd >= modesx
+c modesyd = second dimension of arrays pkw, wkp,
+c where modesyd  >= min(2*modesy-1,ny)
+c iw = number of frequencies
+c iwd = third dimension of arrays pkw, wkp, iwd >= iw
+      implicit none
+      integer nt, ny, modesx, modesy, modesxd, modesyd, iw, iwd
+      real dt
+      complex pkw
+      real wkp
+      dimension pkw(modesxd,modesyd,iwd), wkp(modesxd,modesyd,iwd)
+c local data
+      integer kmax, j, k, l
+      real anorm
+      double precision wt, sum1
+      kmax = min0(2*modesy-1,ny)
+c sum squares of hann window
+      sum1 = 1.0d0
+      if (nt.gt.1) then
+         sum1 = 0.0d0
+         do 10 j = 1, nt
+         wt = 6.283185307179586d0*dble(j-1)/dble(nt-1)
+         wt = 0.5d0*(1.0d0 - dcos(wt))
+         sum1 = sum1 + wt*wt
+   10    continue
+      endif
+      anorm = 1.0/real(dble(dt)*sum1)
+      do 40 l = 1, iw
+      do 30 k = 1, kmax
+      do 20 j = 1, modesx
+      wkp(j,k,l) = anorm*(real(pkw(j,k,l))**2 + aimag(pkw(j,k,l))**2)
+   20 continue
+   30 continue
+   40 continue
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine WKVMODES2(vpott,vpkw,wm,dt,it,nt,ny,modesx,modesy,ndim,
+     1modesxd,modesyd,iw,iwd)
+c this subroutine accumulates a windowed discrete fourier transform in
+c time of the vector modes in vpott, extracted by RDVMODES2, for the
+c frequencies in wm
+c vpkw(i,j,k,l) = vpkw(i,j,k,l) + dt*w(it)*vpott(i,j,k)*
+c                 exp(i*wm(l)*dt*(it-1))
+c where w(it) = 0.5*(1 - cos(2*pi*(it-1)/(nt-1))) is a hann window
+c vpkw must be zeroed before the first sample
+c vpott = unpacked complex vector modes at sample it
+c vpkw = accumulated transform for each component, mode and frequency
+c wm = frequencies to be calculated
+c dt = time interval between samples
+c it = sample number, 1 <= it <= nt, other samples are ignored
+c nt = total number of samples in window
+c ny = system length in y direction
+c modesx/modesy = number of modes stored in x/y direction
+c ndim = number of field arrays, must be >= 1
+c modesxd = second dimension of arrays vpott, vpkw, modesxd >= modesx
+c modesyd = third dimension of arrays vpott, vpkw,
+c where modesyd  >= min(2*modesy-1,ny)
+c iw = number of frequencies
+c iwd = fourth dimension of array vpkw, iwd >= iw
+      implicit none
+      integer it, nt, ny, modesx, modesy, ndim, modesxd, modesyd
+      integer iw, iwd
+      real dt
+      complex vpott, vpkw
+      real wm
+      dimension vpott(ndim,modesxd,modesyd)
+      dimension vpkw(ndim,modesxd,modesyd,iwd)
+      dimension wm(iw)
+c local data
+      integer kmax, i, j, k, l
+      complex zt
+      double precision tt, wt
+      if ((it.lt.1).or.(it.gt.nt)) return
+      kmax = min0(2*modesy-1,ny)
+c hann window
+      wt = 1.0d0
+      if (nt.gt.1) then
+         wt = 6.283185307179586d0*dble(it-1)/dble(nt-1)
+         wt = 0.5d0*(1.0d0 - dcos(wt))
+      endif
+      wt = dble(dt)*wt
+      tt = dble(dt)*dble(it-1)
+      do 40 l = 1, iw
+      zt = cmplx(real(wt*dcos(dble(wm(l))*tt)),
+     1           real(wt*dsin(dble(wm(l))*tt)))
+      do 30 k = 1, kmax
+      do 20 j = 1, modesx
+      do 10 i = 1, ndim
+      vpkw(i,j,k,l) = vpkw(i,j,k,l) + zt*vpott(i,j,k)
+   10 continue
+   20 continue
+   30 continue
+   40 continue
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine WKVPOW2(vpkw,vwkp,dt,nt,ny,modesx,modesy,ndim,modesxd,
+     1modesyd,iw,iwd)
+c this subroutine calculates the frequency-wavenumber power spectrum of
+c each vector component from the transform accumulated by WKVMODES2
+c vwkp(i,j,k,l) = |vpkw(i,j,k,l)|**2/(dt*sum(w(it)**2))
+c where w(it) is the hann window used by WKVMODES2
+c vpkw = accumulated transform for each component, mode and frequency
+c vwkp = power spectrum for each component, mode and frequency
+c dt = time interval between samples
+c nt = total number of samples in window
+c ny = system length in y direction
+c modesx/modesy = number of modes stored in x/y direction
+c ndim = number of field arrays, must be >= 1
+c modesxd = second dimension of arrays vpkw, vwkp, modesxd >= modesx
+c modesyd = third dimension of arrays vpkw, vwkp,
+c where modesyd  >= min(2*modesy-1,ny)
+c iw = number of frequencies
+c iwd = fourth dimension of arrays vpkw, vwkp, iwd >= iw
+      implicit none
+      integer nt, ny, modesx, modesy, ndim, modesxd, modesyd, iw, iwd
+      real dt
+      complex vpkw
+      real vwkp
+      dimension vpkw(ndim,modesxd,modesyd,iwd)
+      dimension vwkp(ndim,modesxd,modesyd,iwd)
+c local data
+      integer kmax, i, j, k, l
+      real anorm
+      double precision wt, sum1
+      kmax = min0(2*modesy-1,ny)
+c sum squares of hann window
+      sum1 = 1.0d0
+      if (nt.gt.1) then
+         sum1 = 0.0d0
+         do 10 j = 1, nt
+         wt = 6.283185307179586d0*dble(j-1)/dble(nt-1)
+         wt = 0.5d0*(1.0d0 - dcos(wt))
+         sum1 = sum1 + wt*wt
+   10    continue
+      endif
+      anorm = 1.0/real(dble(dt)*sum1)
+      do 50 l = 1, iw
+      do 40 k = 1, kmax
+      do 30 j = 1, modesx
+      do 20 i = 1, ndim
+      vwkp(i,j,k,l) = anorm*(real(vpkw(i,j,k,l))**2
+     1                     + aimag(vpkw(i,j,k,l))**2)
+   20 continue
+   30 continue
+   40 continue
+   50 continue
+      return
+      end
@@ -43,3 +43,19 @@ void crdvmodes2(float complex vpot[], float complex vpott[], int nx,
 void cwrvmodes2(float complex vpot[], float complex vpott[], int nx,
                 int ny, int modesx, int modesy, int ndim, int nxvh,
                 int nyv, int modesxd, int modesyd);
+
+void cwkmodes2(float complex pott[], float complex pkw[], float wm[],
+               float dt, int it, int nt, int ny, int modesx, int modesy,
+               int modesxd, int modesyd, int iw, int iwd);
+
+void cwkpow2(float complex pkw[], float wkp[], float dt, int nt, int ny,
+             int modesx, int modesy, int modesxd, int modesyd, int iw,
+             int iwd);
+
+void cwkvmodes2(float complex vpott[], float complex vpkw[], float wm[],
+                float dt, int it, int nt, int ny, int modesx, int modesy,
+                int ndim, int modesxd, int modesyd, int iw, int iwd);
+
+void cwkvpow2(float complex vpkw[], float vwkp[], float dt, int nt,
+              int ny, int modesx, int modesy, int ndim, int modesxd,
+              int modesyd, int iw, int iwd);
@@ -47,6 +47,24 @@ void wrvmodes2_(float complex *vpot, float complex *vpott, int *nx,
                 int *ny, int *modesx, int *modesy, int *ndim, int *nxvh,
                 int *nyv, int *modesxd, int *modesyd);
 
+void wkmodes2_(float complex *pott, float complex *pkw, float *wm,
+               float *dt, int *it, int *nt, int *ny, int *modesx,
+               int *modesy, int *modesxd, int *modesyd, int *iw,
+               int *iwd);
+
+void wkpow2_(float complex *pkw, float *wkp, float *dt, int *nt,
+             int *ny, int *modesx, int *modesy, int *modesxd,
+             int *modesyd, int *iw, int *iwd);
+
+void wkvmodes2_(float complex *vpott, float complex *vpkw, float *wm,
+                float *dt, int *it, int *nt, int *ny, int *modesx,
+                int *modesy, int *ndim, int *modesxd, int *modesyd,
+                int *iw, int *iwd);
+
+void wkvpow2_(float complex *vpkw, float *vwkp, float *dt, int *nt,
+              int *ny, int *modesx, int *modesy, int *ndim, int *modesxd,
+              int *modesyd, int *iw, int *iwd);
+
 /* Interfaces to C */
 
 /*--------------------------------------------------------------------*/
@@ -145,3 +163,39 @@ void cwrvmodes2(float complex vpot[], float complex vpott[], int nx,
    return;
 }
 
+
+/*--------------------------------------------------------------------*/
+void cwkmodes2(float complex pott[], float complex pkw[], float wm[],
+               float dt, int it, int nt, int ny, int modesx, int modesy,
+               int modesxd, int modesyd, int iw, int iwd) {
+   wkmodes2_(pott,pkw,wm,&dt,&it,&nt,&ny,&modesx,&modesy,&modesxd,
+             &modesyd,&iw,&iwd);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cwkpow2(float complex pkw[], float wkp[], float dt, int nt, int ny,
+             int modesx, int modesy, int modesxd, int modesyd, int iw,
+             int iwd) {
+   wkpow2_(pkw,wkp,&dt,&nt,&ny,&modesx,&modesy,&modesxd,&modesyd,&iw,
+           &iwd);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cwkvmodes2(float complex vpott[], float complex vpkw[], float wm[],
+                float dt, int it, int nt, int ny, int modesx, int modesy,
+                int ndim, int modesxd, int modesyd, int iw, int iwd) {
+   wkvmodes2_(vpott,vpkw,wm,&dt,&it,&nt,&ny,&modesx,&modesy,&ndim,
+              &modesxd,&modesyd,&iw,&iwd);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cwkvpow2(float complex vpkw[], float vwkp[], float dt, int nt,
+              int ny, int modesx, int modesy, int ndim, int modesxd,
+              int modesyd, int iw, int iwd) {
+   wkvpow2_(vpkw,vwkp,&dt,&nt,&ny,&modesx,&modesy,&ndim,&modesxd,
+            &modesyd,&iw,&iwd);
+   return;
+}
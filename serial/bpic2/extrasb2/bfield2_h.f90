@@ -125,5 +125,58 @@
          complex, dimension(ndim,modesxd,modesyd), intent(in) :: vpott
          end subroutine
       end interface
+!
+      interface
+         subroutine WKMODES2(pott,pkw,wm,dt,it,nt,ny,modesx,modesy,     &
+     &modesxd,modesyd,iw,iwd)
+         implicit none
+         integer, intent(in) :: it, nt, ny, modesx, modesy
+         integer, intent(in) :: modesxd, modesyd, iw, iwd
+         real, intent(in) :: dt
+         complex, dimension(modesxd,modesyd), intent(in) :: pott
+         complex, dimension(modesxd,modesyd,iwd), intent(inout) :: pkw
+         real, dimension(iw), intent(in) :: wm
+         end subroutine
+      end interface
+!
+      interface
+         subroutine WKPOW2(pkw,wkp,dt,nt,ny,modesx,modesy,modesxd,      &
+     &modesyd,iw,iwd)
+         implicit none
+         integer, intent(in) :: nt, ny, modesx, modesy
+         integer, intent(in) :: modesxd, modesyd, iw, iwd
+         real, intent(in) :: dt
+         complex, dimension(modesxd,modesyd,iwd), intent(in) :: pkw
+         real, dimension(modesxd,modesyd,iwd), intent(inout) :: wkp
+         end subroutine
+      end interface
+!
+      interface
+         subroutine WKVMODES2(vpott,vpkw,wm,dt,it,nt,ny,modesx,modesy,  &
+     &ndim,modesxd,modesyd,iw,iwd)
+         implicit none
+         integer, intent(in) :: it, nt, ny, modesx, modesy, ndim
+         integer, intent(in) :: modesxd, modesyd, iw, iwd
+         real, intent(in) :: dt
+         complex, dimension(ndim,modesxd,modesyd), intent(in) :: vpott
+         complex, dimension(ndim,modesxd,modesyd,iwd), intent(inout) :: &
+     &vpkw
+         real, dimension(iw), intent(in) :: wm
+         end subroutine
+      end interface
+!
+      interface
+         subroutine WKVPOW2(vpkw,vwkp,dt,nt,ny,modesx,modesy,ndim,      &
+     &modesxd,modesyd,iw,iwd)
+         implicit none
+         integer, intent(in) :: nt, ny, modesx, modesy, ndim
+         integer, intent(in) :: modesxd, modesyd, iw, iwd
+         real, intent(in) :: dt
+         complex, dimension(ndim,modesxd,modesyd,iwd), intent(in) ::    &
+     &vpkw
+         real, dimension(ndim,modesxd,modesyd,iwd), intent(inout) ::    &
+     &vwkp
+         end subroutine
+      end interface
 !
       end module
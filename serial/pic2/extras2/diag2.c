@@ -0,0 +1,285 @@
+/* C Library for Skeleton 2D Electrostatic PIC Code diagnostics sink */
+/* a sink copies the unpacked fourier modes pott into a ring of       */
+/* preallocated record buffers, and a background thread appends the   */
+/* records to a binary time series file, so the time loop only waits  */
+/* when the ring is full.                                              */
+/* file format: a header diaghead, followed by one record per call to */
+/* cdiagwrite2, containing ntime, a pad word, and modesx columns of    */
+/* modesyd complex modes, kx = 0,1,...,modesx-1, ky fastest            */
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <complex.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "diag2.h"
+
+/* ndiagmax = maximum number of sinks open at one time */
+#define NDIAGMAX                 8
+
+/* header of time series file                                */
+/* magic = file identifier                                   */
+/* nx/ny = system length, modesx/modesy = modes kept in x/y  */
+/* modesyd = number of complex modes in y per column         */
+/* kx0/nkx = first mode number and number of modes in x kept */
+/* in this file, nfile = number of files in the time series  */
+struct diaghead {
+   char magic[8];
+   int nx, ny, modesx, modesy, modesyd, kx0, nkx, nfile;
+};
+
+/* sink state                                                      */
+/* fd = file descriptor, nrec = size of one record in bytes        */
+/* ring = nbuf record buffers, ifill = next buffer to fill         */
+/* iwrite = next buffer to write, nfull = number of filled buffers */
+/* ldone = (0,1) = (no,yes) no more records will be added          */
+/* wrc = error code of the background writer                       */
+struct diagsink {
+   int lopen, fd, nbuf, ifill, iwrite, nfull, ldone, wrc;
+   int modesx, modesyd;
+   long nrec;
+   char *ring;
+   pthread_mutex_t lock;
+   pthread_cond_t cfull, cfree;
+   pthread_t writer;
+};
+
+static struct diagsink sinks[NDIAGMAX];
+
+static char diagmagic[8] = "FMODES2";
+
+/*--------------------------------------------------------------------*/
+static void *cdiagwr2(void *arg) {
+/* this function is run by the background thread of a sink.  it waits
+   for filled record buffers and appends them to the file in order,
+   until the sink is closed and the ring is empty.
+   a write error sets wrc = 2, and later records are discarded
+local data                                                            */
+   struct diagsink *ds = (struct diagsink *) arg;
+   int ierr = 0;
+   long nn;
+   ssize_t nw;
+   char *buf;
+   pthread_mutex_lock(&ds->lock);
+   for (;;) {
+      while ((ds->nfull==0) && (!ds->ldone)) {
+         pthread_cond_wait(&ds->cfull,&ds->lock);
+      }
+      if (ds->nfull==0)
+         break;
+      buf = &ds->ring[ds->nrec*ds->iwrite];
+      pthread_mutex_unlock(&ds->lock);
+      nn = 0;
+      while ((ierr==0) && (nn < ds->nrec)) {
+         nw = write(ds->fd,&buf[nn],ds->nrec-nn);
+         if (nw <= 0)
+            ierr = 2;
+         else
+            nn += nw;
+      }
+      pthread_mutex_lock(&ds->lock);
+      ds->wrc = ierr;
+      ds->iwrite = (ds->iwrite + 1)%ds->nbuf;
+      ds->nfull -= 1;
+      pthread_cond_signal(&ds->cfree);
+   }
+   pthread_mutex_unlock(&ds->lock);
+   return NULL;
+}
+
+/*--------------------------------------------------------------------*/
+void cdiagopen2(char *fname, int nx, int ny, int modesx, int modesy,
+                int modesyd, int nbuf, int *nd, int *irc) {
+/* this subroutine creates time series file fname for the fourier modes
+   extracted by crdmodes2, allocates a ring of nbuf record buffers, and
+   starts the background thread which writes them
+   input: all except nd, irc, output: nd, irc
+   fname = name of time series file
+   nx/ny = system length in x/y direction
+   modesx/modesy = number of modes stored in x/y direction
+   modesyd = number of modes in y kept per column, >= min(2*modesy-1,ny)
+   nbuf = number of record buffers, at least 2 are used
+   nd = sink number, to be passed to cdiagwrite2 and cdiagclose2
+   irc = error code: 0 = ok, 1 = cannot create file or allocate
+   buffers, 3 = too many sinks open
+local data                                                            */
+   int n;
+   long nn;
+   ssize_t nw;
+   struct diaghead dh;
+   struct diagsink *ds;
+   *nd = -1;
+   *irc = 0;
+   for (n = 0; n < NDIAGMAX; n++) {
+      if (!sinks[n].lopen)
+         break;
+   }
+   if (n==NDIAGMAX) {
+      *irc = 3;
+      return;
+   }
+   ds = &sinks[n];
+   memset(ds,0,sizeof(struct diagsink));
+   ds->nbuf = nbuf > 2 ? nbuf : 2;
+   ds->modesx = modesx;
+   ds->modesyd = modesyd;
+   ds->nrec = 2*sizeof(int) + sizeof(float complex)*modesx*modesyd;
+   ds->ring = (char *) malloc(ds->nrec*ds->nbuf);
+   ds->fd = open(fname,O_WRONLY|O_CREAT|O_TRUNC,0644);
+   if ((ds->ring==NULL) || (ds->fd < 0)) {
+      if (ds->fd >= 0)
+         close(ds->fd);
+      free(ds->ring);
+      *irc = 1;
+      return;
+   }
+/* write header */
+   memset(&dh,0,sizeof(dh));
+   memcpy(dh.magic,diagmagic,8);
+   dh.nx = nx; dh.ny = ny; dh.modesx = modesx; dh.modesy = modesy;
+   dh.modesyd = modesyd; dh.kx0 = 0; dh.nkx = modesx; dh.nfile = 1;
+   nw = write(ds->fd,&dh,sizeof(dh));
+   nn = nw;
+   if (nn != sizeof(dh)) {
+      close(ds->fd);
+      free(ds->ring);
+      *irc = 1;
+      return;
+   }
+   pthread_mutex_init(&ds->lock,NULL);
+   pthread_cond_init(&ds->cfull,NULL);
+   pthread_cond_init(&ds->cfree,NULL);
+   if (pthread_create(&ds->writer,NULL,cdiagwr2,ds) != 0) {
+      pthread_mutex_destroy(&ds->lock);
+      pthread_cond_destroy(&ds->cfull);
+      pthread_cond_destroy(&ds->cfree);
+      close(ds->fd);
+      free(ds->ring);
+      *irc = 1;
+      return;
+   }
+   ds->lopen = 1;
+   *nd = n;
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cdiagwrite2(int nd, float complex pott[], int ntime, int modesxd,
+                 int *irc) {
+/* this subroutine copies the fourier modes in pott into the next free
+   record buffer of sink nd and passes it to the background writer.
+   it waits only if all nbuf buffers are still waiting to be written.
+   pott may be modified as soon as this subroutine returns
+   input: all except irc, output: irc
+   nd = sink number returned by cdiagopen2
+   pott[k][j] = mode kx = j, ky index k, as stored by crdmodes2
+   ntime = time step stored with record
+   modesxd = first dimension of pott, must be >= modesx
+   irc = error code: 0 = ok, 2 = write error in earlier record,
+   3 = sink not open
+local data                                                            */
+   int j, k, modesx, modesyd;
+   int *ihd;
+   float complex *rec;
+   struct diagsink *ds;
+   if ((nd < 0) || (nd >= NDIAGMAX) || (!sinks[nd].lopen)) {
+      *irc = 3;
+      return;
+   }
+   ds = &sinks[nd];
+   modesx = ds->modesx;
+   modesyd = ds->modesyd;
+/* wait for a free buffer */
+   pthread_mutex_lock(&ds->lock);
+   while (ds->nfull==ds->nbuf) {
+      pthread_cond_wait(&ds->cfree,&ds->lock);
+   }
+   pthread_mutex_unlock(&ds->lock);
+/* copy modes into record, transposing to kx columns */
+   ihd = (int *) &ds->ring[ds->nrec*ds->ifill];
+   ihd[0] = ntime;
+   ihd[1] = 0;
+   rec = (float complex *) &ihd[2];
+   for (j = 0; j < modesx; j++) {
+      for (k = 0; k < modesyd; k++) {
+         rec[k+modesyd*j] = pott[j+modesxd*k];
+      }
+   }
+/* pass record to writer */
+   pthread_mutex_lock(&ds->lock);
+   ds->ifill = (ds->ifill + 1)%ds->nbuf;
+   ds->nfull += 1;
+   pthread_cond_signal(&ds->cfull);
+   *irc = ds->wrc;
+   pthread_mutex_unlock(&ds->lock);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cdiagclose2(int nd, int *irc) {
+/* this subroutine waits for all records of sink nd to be written,
+   stops the background thread, closes the file and frees the buffers
+   irc = error code: 0 = ok, 2 = write error, 3 = sink not open
+local data                                                            */
+   struct diagsink *ds;
+   if ((nd < 0) || (nd >= NDIAGMAX) || (!sinks[nd].lopen)) {
+      *irc = 3;
+      return;
+   }
+   ds = &sinks[nd];
+   pthread_mutex_lock(&ds->lock);
+   ds->ldone = 1;
+   pthread_cond_signal(&ds->cfull);
+   pthread_mutex_unlock(&ds->lock);
+   pthread_join(ds->writer,NULL);
+   if (close(ds->fd) != 0)
+      ds->wrc = 2;
+   *irc = ds->wrc;
+   pthread_mutex_destroy(&ds->lock);
+   pthread_cond_destroy(&ds->cfull);
+   pthread_cond_destroy(&ds->cfree);
+   free(ds->ring);
+   ds->ring = NULL;
+   ds->lopen = 0;
+   return;
+}
+
+/* Interfaces to Fortran */
+
+/*--------------------------------------------------------------------*/
+void cdiagopen2_(char *fname, int *nx, int *ny, int *modesx,
+                 int *modesy, int *modesyd, int *nbuf, int *nd,
+                 int *irc, size_t lfname) {
+/* lfname = length of fortran character variable fname, which is */
+/* blank padded and not null terminated                          */
+   char cname[256];
+   size_t lf;
+   lf = lfname;
+   while ((lf > 0) && (fname[lf-1]==' '))
+      lf -= 1;
+   if (lf >= sizeof(cname)) {
+      *nd = -1;
+      *irc = 1;
+      return;
+   }
+   memcpy(cname,fname,lf);
+   cname[lf] = '\0';
+   cdiagopen2(cname,*nx,*ny,*modesx,*modesy,*modesyd,*nbuf,nd,irc);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cdiagwrite2_(int *nd, float complex *pott, int *ntime,
+                  int *modesxd, int *irc) {
+   cdiagwrite2(*nd,pott,*ntime,*modesxd,irc);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cdiagclose2_(int *nd, int *irc) {
+   cdiagclose2(*nd,irc);
+   return;
+}
@@ -0,0 +1,9 @@
+/* header file for diag2.c */
+
+void cdiagopen2(char *fname, int nx, int ny, int modesx, int modesy,
+                int modesyd, int nbuf, int *nd, int *irc);
+
+void cdiagwrite2(int nd, float complex pott[], int ntime, int modesxd,
+                 int *irc);
+
+void cdiagclose2(int nd, int *irc);
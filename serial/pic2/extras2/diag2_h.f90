@@ -0,0 +1,33 @@
+!-----------------------------------------------------------------------
+! Interface file for diag2.c
+      module diag2_h
+      implicit none
+!
+      interface
+         subroutine cdiagopen2(fname,nx,ny,modesx,modesy,modesyd,nbuf,nd&
+     &,irc)
+         implicit none
+         character(len=*), intent(in) :: fname
+         integer, intent(in) :: nx, ny, modesx, modesy, modesyd, nbuf
+         integer, intent(inout) :: nd, irc
+         end subroutine
+      end interface
+!
+      interface
+         subroutine cdiagwrite2(nd,pott,ntime,modesxd,irc)
+         implicit none
+         integer, intent(in) :: nd, ntime, modesxd
+         integer, intent(inout) :: irc
+         complex, dimension(modesxd,*), intent(in) :: pott
+         end subroutine
+      end interface
+!
+      interface
+         subroutine cdiagclose2(nd,irc)
+         implicit none
+         integer, intent(in) :: nd
+         integer, intent(inout) :: irc
+         end subroutine
+      end interface
+!
+      end module
@@ -21,3 +21,11 @@ void crdmodes2(float complex pot[], float complex pott[], int nx,
 void cwrmodes2(float complex pot[], float complex pott[], int nx, 
                int ny, int modesx, int modesy, int nxvh, int nyv, 
                int modesxd, int modesyd);
+
+void cwkmodes2(float complex pott[], float complex pkw[], float wm[],
+               float dt, int it, int nt, int ny, int modesx, int modesy,
+               int modesxd, int modesyd, int iw, int iwd);
+
+void cwkpow2(float complex pkw[], float wkp[], float dt, int nt, int ny,
+             int modesx, int modesy, int modesxd, int modesyd, int iw,
+             int iwd);
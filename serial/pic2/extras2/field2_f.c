@@ -25,6 +25,15 @@ void wrmodes2_(float complex *pot, float complex *pott, int *nx,
                int *ny, int *modesx, int *modesy, int *nxvh, int *nyv,
                int *modesxd, int *modesyd);
 
+void wkmodes2_(float complex *pott, float complex *pkw, float *wm,
+               float *dt, int *it, int *nt, int *ny, int *modesx,
+               int *modesy, int *modesxd, int *modesyd, int *iw,
+               int *iwd);
+
+void wkpow2_(float complex *pkw, float *wkp, float *dt, int *nt,
+             int *ny, int *modesx, int *modesy, int *modesxd,
+             int *modesyd, int *iw, int *iwd);
+
 /* Interfaces to C */
 
 /*--------------------------------------------------------------------*/
@@ -75,3 +84,21 @@ void cwrmodes2(float complex pot[], float complex pott[], int nx,
    return;
 }
 
+
+/*--------------------------------------------------------------------*/
+void cwkmodes2(float complex pott[], float complex pkw[], float wm[],
+               float dt, int it, int nt, int ny, int modesx, int modesy,
+               int modesxd, int modesyd, int iw, int iwd) {
+   wkmodes2_(pott,pkw,wm,&dt,&it,&nt,&ny,&modesx,&modesy,&modesxd,
+             &modesyd,&iw,&iwd);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cwkpow2(float complex pkw[], float wkp[], float dt, int nt, int ny,
+             int modesx, int modesy, int modesxd, int modesyd, int iw,
+             int iwd) {
+   wkpow2_(pkw,wkp,&dt,&nt,&ny,&modesx,&modesy,&modesxd,&modesyd,&iw,
+           &iwd);
+   return;
+}
@@ -63,5 +63,30 @@
          complex, dimension(modesxd,modesyd), intent(in) :: pott
          end subroutine
       end interface
+!
+      interface
+         subroutine WKMODES2(pott,pkw,wm,dt,it,nt,ny,modesx,modesy,     &
+     &modesxd,modesyd,iw,iwd)
+         implicit none
+         integer, intent(in) :: it, nt, ny, modesx, modesy
+         integer, intent(in) :: modesxd, modesyd, iw, iwd
+         real, intent(in) :: dt
+         complex, dimension(modesxd,modesyd), intent(in) :: pott
+         complex, dimension(modesxd,modesyd,iwd), intent(inout) :: pkw
+         real, dimension(iw), intent(in) :: wm
+         end subroutine
+      end interface
+!
+      interface
+         subroutine WKPOW2(pkw,wkp,dt,nt,ny,modesx,modesy,modesxd,      &
+     &modesyd,iw,iwd)
+         implicit none
+         integer, intent(in) :: nt, ny, modesx, modesy
+         integer, intent(in) :: modesxd, modesyd, iw, iwd
+         real, intent(in) :: dt
+         complex, dimension(modesxd,modesyd,iwd), intent(in) :: pkw
+         real, dimension(modesxd,modesyd,iwd), intent(inout) :: wkp
+         end subroutine
+      end interface
 !
       end module
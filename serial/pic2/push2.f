@@ -1362,6 +1362,711 @@ c first transform in y
   170 continue
       return
       end
+c-----------------------------------------------------------------------
+      subroutine FFTMRFAC(fac,n,nf)
+c this subroutine factors the length n of a mixed radix fast fourier
+c transform into the radices of the transform stages, in the order in
+c which the stages are performed: radix 4, then 2, 3, 5 and any
+c remaining prime factors, in increasing order
+c input: n, output: fac, nf
+c fac = array of radices, with dimension at least 32
+c n = length of transform
+c nf = number of radices, nf = -1 if n < 1 or if n has a prime factor
+c larger than 127
+      implicit none
+      integer n, nf
+      integer fac
+      dimension fac(32)
+c local data
+      integer l, m, np
+      nf = -1
+      if (n.lt.1) return
+      l = 0
+      m = n
+   10 if (mod(m,4).eq.0) then
+         l = l + 1
+         fac(l) = 4
+         m = m/4
+         go to 10
+      endif
+      np = 2
+   20 if (m.gt.1) then
+         if (mod(m,np).eq.0) then
+            if (np.gt.127) return
+            l = l + 1
+            fac(l) = np
+            m = m/np
+         else if (np.eq.2) then
+            np = 3
+         else
+            np = np + 2
+         endif
+         go to 20
+      endif
+      nf = l
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine FFT1MR(f,isign,mixup,sct,n,nrs,nes,nvs,nvp)
+c this subroutine performs multiple one dimensional mixed radix complex
+c fast fourier transforms of length n, without normalization.
+c element m of vector i is stored in f(1+nes*(m-1)+nvs*(i-1)),
+c where 1 <= i <= nvp
+c the length n may contain any prime factors less than 128, the radix
+c 4, 2, 3 and 5 stages are the fastest, other primes use a direct
+c discrete fourier transform of length equal to the prime.
+c for isign = (-1,1), input: all, output: f
+c if isign = -1, the inverse transform is performed
+c f(m) = sum(f(k)*exp(-sqrt(-1)*2pi*(m-1)*(k-1)/n))
+c if isign = 1, the forward transform is performed
+c f(k) = sum(f(m)*exp(sqrt(-1)*2pi*(m-1)*(k-1)/n))
+c mixup = array of digit reversed addresses, where mixup(j) is the
+c address whose element is moved to address j, negative for the first
+c address of each permutation cycle
+c sct = sine/cosine table, where
+c sct(1+nrs*(j-1)) = exp(-sqrt(-1)*2pi*(j-1)/n)
+c nrs = stride in sct table
+c nes = stride between elements of a vector
+c nvs = stride between vectors
+c nvp = number of vectors
+      implicit none
+      integer isign, n, nrs, nes, nvs, nvp
+      complex f, sct
+      integer mixup
+      dimension f(*), mixup(n), sct(*)
+c local data
+      integer nf, fac
+      integer i, j, k, l, m, q, r, j1, k1, kk, ns, nsp, np, km, kmr
+      integer nrp, joff
+      complex t1, t2, t3, t4, t5, t6, w1, w2, w3, w4, tp
+      dimension fac(32), tp(128)
+      if (isign.eq.0) return
+      call FFTMRFAC(fac,n,nf)
+      if (nf.lt.0) return
+c reorder array elements in digit reversed order, one cycle at a time
+      do 30 j = 1, n
+      if (mixup(j).gt.0) go to 30
+      do 20 i = 1, nvp
+      joff = 1 + nvs*(i - 1)
+      t1 = f(nes*(j-1)+joff)
+      k = j
+      k1 = -mixup(j)
+   10 if (k1.ne.j) then
+         f(nes*(k-1)+joff) = f(nes*(k1-1)+joff)
+         k = k1
+         k1 = mixup(k)
+         go to 10
+      endif
+      f(nes*(k-1)+joff) = t1
+   20 continue
+   30 continue
+c transform stages, combining np transforms of length ns into one
+c transform of length ns*np
+      ns = 1
+      do 150 l = 1, nf
+      np = fac(l)
+      nsp = ns*np
+      km = n/nsp
+      kmr = nrs*km
+      nrp = nrs*(n/np)
+c roots of unity for the butterflies
+      t1 = sct(1+nrp)
+      t2 = t1
+      if (np.gt.2) t2 = sct(1+2*nrp)
+      if (isign.gt.0) then
+         t1 = conjg(t1)
+         t2 = conjg(t2)
+      endif
+      m = nes*ns
+      do 140 k = 1, km
+      k1 = nsp*(k - 1)
+      do 130 j = 1, ns
+      j1 = nes*(j + k1 - 1)
+      w1 = sct(1+kmr*(j-1))
+      w2 = sct(1+2*kmr*(j-1))
+      if (isign.gt.0) then
+         w1 = conjg(w1)
+         w2 = conjg(w2)
+      endif
+c radix 2
+      if (np.eq.2) then
+         do 40 i = 1, nvp
+         joff = j1 + 1 + nvs*(i - 1)
+         t3 = w1*f(m+joff)
+         f(m+joff) = f(joff) - t3
+         f(joff) = f(joff) + t3
+   40    continue
+c radix 4
+      else if (np.eq.4) then
+         w3 = sct(1+3*kmr*(j-1))
+         if (isign.gt.0) w3 = conjg(w3)
+         do 50 i = 1, nvp
+         joff = j1 + 1 + nvs*(i - 1)
+         t3 = w2*f(2*m+joff)
+         t4 = f(joff) - t3
+         t3 = f(joff) + t3
+         t5 = w1*f(m+joff)
+         t6 = w3*f(3*m+joff)
+         w4 = t5 + t6
+         t5 = t1*(t5 - t6)
+         f(joff) = t3 + w4
+         f(m+joff) = t4 + t5
+         f(2*m+joff) = t3 - w4
+         f(3*m+joff) = t4 - t5
+   50    continue
+c radix 3
+      else if (np.eq.3) then
+         do 60 i = 1, nvp
+         joff = j1 + 1 + nvs*(i - 1)
+         t3 = w1*f(m+joff)
+         t4 = w2*f(2*m+joff)
+         w4 = t3 + t4
+         t3 = aimag(t1)*cmplx(aimag(t4-t3),real(t3-t4))
+         t4 = f(joff) + real(t1)*w4
+         f(joff) = f(joff) + w4
+         f(m+joff) = t4 + t3
+         f(2*m+joff) = t4 - t3
+   60    continue
+c radix 5
+      else if (np.eq.5) then
+         w3 = sct(1+3*kmr*(j-1))
+         w4 = sct(1+4*kmr*(j-1))
+         if (isign.gt.0) then
+            w3 = conjg(w3)
+            w4 = conjg(w4)
+         endif
+         do 70 i = 1, nvp
+         joff = j1 + 1 + nvs*(i - 1)
+         tp(2) = w1*f(m+joff)
+         tp(3) = w2*f(2*m+joff)
+         tp(4) = w3*f(3*m+joff)
+         tp(5) = w4*f(4*m+joff)
+         t3 = tp(2) + tp(5)
+         t4 = tp(3) + tp(4)
+         t5 = tp(2) - tp(5)
+         t6 = tp(3) - tp(4)
+         tp(2) = cmplx(-aimag(t5),real(t5))
+         tp(3) = cmplx(-aimag(t6),real(t6))
+         tp(4) = f(joff) + real(t1)*t3 + real(t2)*t4
+         tp(5) = f(joff) + real(t2)*t3 + real(t1)*t4
+         tp(6) = aimag(t1)*tp(2) + aimag(t2)*tp(3)
+         tp(7) = aimag(t2)*tp(2) - aimag(t1)*tp(3)
+         f(joff) = f(joff) + t3 + t4
+         f(m+joff) = tp(4) + tp(6)
+         f(2*m+joff) = tp(5) + tp(7)
+         f(3*m+joff) = tp(5) - tp(7)
+         f(4*m+joff) = tp(4) - tp(6)
+   70    continue
+c other prime radix, direct discrete fourier transform
+      else
+         do 120 i = 1, nvp
+         joff = j1 + 1 + nvs*(i - 1)
+         tp(1) = f(joff)
+         do 80 r = 2, np
+         t3 = sct(1+kmr*(r-1)*(j-1))
+         if (isign.gt.0) t3 = conjg(t3)
+         tp(r) = t3*f(m*(r-1)+joff)
+   80    continue
+         do 110 q = 1, np
+         t3 = tp(1)
+         kk = 0
+         do 100 r = 2, np
+         kk = kk + q - 1
+         if (kk.ge.np) kk = kk - np
+         t4 = sct(1+nrp*kk)
+         if (isign.gt.0) t4 = conjg(t4)
+         t3 = t3 + t4*tp(r)
+  100    continue
+         f(m*(q-1)+joff) = t3
+  110    continue
+  120    continue
+      endif
+  130 continue
+  140 continue
+      ns = nsp
+  150 continue
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine WFFT2RNINIT(mixup,sct,nx,ny,nxhyd,nxyd)
+c this subroutine calculates tables needed by a two dimensional
+c real to complex mixed radix fast fourier transform and its inverse,
+c for grids whose sizes need not be powers of 2.
+c input: nx, ny, nxhyd, nxyd
+c output: mixup, sct
+c mixup = array of digit reversed addresses, for the x transform of
+c length nx/2 in mixup(1:nx/2) and for the y transform of length ny
+c in mixup(nx/2+1:nx/2+ny)
+c sct = sine/cosine table, for the angles 2*n*pi/nx in sct(1:nx) and
+c for the angles 2*n*pi/ny in sct(nx+1:nx+ny)
+c nx/ny = number of points in x/y direction, nx and ny must be even,
+c and nx/2 and ny must not have prime factors larger than 127
+c nxhyd = dimension of mixup >= nx/2 + ny
+c nxyd = dimension of sct >= nx + ny
+      implicit none
+      integer nx, ny, nxhyd, nxyd
+      integer mixup
+      complex sct
+      dimension mixup(nxhyd), sct(nxyd)
+c local data
+      integer nxh, n, nf, moff, fac
+      integer i, j, k, l, m, ll, mr
+      real dnx, arg
+      dimension fac(32)
+      nxh = nx/2
+      do 50 i = 1, 2
+      if (i.eq.1) then
+         n = nxh
+         moff = 0
+      else
+         n = ny
+         moff = nxh
+      endif
+      call FFTMRFAC(fac,n,nf)
+c digit-reverse index table: mixup(j) = 1 + digits of (j - 1) reversed,
+c with the radix of the last transform stage as the leading digit
+      do 20 j = 1, n
+      m = n
+      k = j - 1
+      ll = 0
+      mr = 1
+      do 10 l = nf, 1, -1
+      m = m/fac(l)
+      ll = ll + mr*(k/m)
+      k = k - m*(k/m)
+      mr = mr*fac(l)
+   10 continue
+      mixup(j+moff) = ll + 1
+   20 continue
+c negate the first address of each permutation cycle
+      do 40 j = 1, n
+      k = mixup(j+moff)
+      if (k.eq.j) go to 40
+   30 if (k.gt.j) then
+         k = mixup(k+moff)
+         go to 30
+      endif
+      if (k.eq.j) mixup(j+moff) = -mixup(j+moff)
+   40 continue
+   50 continue
+c sine/cosine table for the angles 2*n*pi/nx and 2*n*pi/ny
+      dnx = 6.28318530717959/real(nx)
+      do 60 j = 1, nx
+      arg = dnx*real(j - 1)
+      sct(j) = cmplx(cos(arg),-sin(arg))
+   60 continue
+      dnx = 6.28318530717959/real(ny)
+      do 70 j = 1, ny
+      arg = dnx*real(j - 1)
+      sct(j+nx) = cmplx(cos(arg),-sin(arg))
+   70 continue
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine WFFT2RNX(f,isign,mixup,sct,nx,ny,nxhd,nyd,nxhyd,nxyd)
+c wrapper function for real to complex mixed radix fft, with packed
+c data
+      implicit none
+      complex f, sct
+      integer mixup
+      integer isign, nx, ny, nxhd, nyd, nxhyd, nxyd
+      dimension f(nxhd,nyd), mixup(nxhyd), sct(nxyd)
+c local data
+      integer nxh, nxi, nyi
+      data nxi, nyi /1,1/
+c calculate range of indices
+      nxh = nx/2
+c inverse fourier transform
+      if (isign.lt.0) then
+c perform x fft
+         call FFT2RNXX(f,isign,mixup,sct,nx,ny,nyi,ny,nxhd,nyd,nxhyd,
+     1nxyd)
+c perform y fft
+         call FFT2RNXY(f,isign,mixup,sct,nx,ny,nxi,nxh,nxhd,nyd,nxhyd,
+     1nxyd)
+c forward fourier transform
+      else if (isign.gt.0) then
+c perform y fft
+         call FFT2RNXY(f,isign,mixup,sct,nx,ny,nxi,nxh,nxhd,nyd,nxhyd,
+     1nxyd)
+c perform x fft
+         call FFT2RNXX(f,isign,mixup,sct,nx,ny,nyi,ny,nxhd,nyd,nxhyd,
+     1nxyd)
+      endif
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine WFFT2RN2(f,isign,mixup,sct,nx,ny,nxhd,nyd,nxhyd,nxyd)
+c wrapper function for 2 2d real to complex mixed radix ffts
+      implicit none
+      complex f, sct
+      integer mixup
+      integer isign, nx, ny, nxhd, nyd, nxhyd, nxyd
+      dimension f(2,nxhd,nyd), mixup(nxhyd), sct(nxyd)
+c local data
+      integer nxh, nxi, nyi
+      data nxi, nyi /1,1/
+c calculate range of indices
+      nxh = nx/2
+c inverse fourier transform
+      if (isign.lt.0) then
+c perform x fft
+         call FFT2RN2X(f,isign,mixup,sct,nx,ny,nyi,ny,nxhd,nyd,nxhyd,
+     1nxyd)
+c perform y fft
+         call FFT2RN2Y(f,isign,mixup,sct,nx,ny,nxi,nxh,nxhd,nyd,nxhyd,
+     1nxyd)
+c forward fourier transform
+      else if (isign.gt.0) then
+c perform y fft
+         call FFT2RN2Y(f,isign,mixup,sct,nx,ny,nxi,nxh,nxhd,nyd,nxhyd,
+     1nxyd)
+c perform x fft
+         call FFT2RN2X(f,isign,mixup,sct,nx,ny,nyi,ny,nxhd,nyd,nxhyd,
+     1nxyd)
+      endif
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine FFT2RNXX(f,isign,mixup,sct,nx,ny,nyi,nyp,nxhd,nyd,nxhyd
+     1,nxyd)
+c this subroutine performs the x part of a two dimensional real to
+c complex mixed radix fast fourier transform and its inverse, for a
+c subset of y, using complex arithmetic.
+c for isign = (-1,1), input: all, output: f
+c nx/ny = number of points in x/y direction, nx and ny must be even
+c if isign = -1, an inverse fourier transform is performed
+c f(n,m) = (1/nx*ny)*sum(f(j,k)*
+c       exp(-sqrt(-1)*2pi*n*j/nx)*exp(-sqrt(-1)*2pi*m*k/ny))
+c if isign = 1, a forward fourier transform is performed
+c f(j,k) = sum(f(n,m)*exp(sqrt(-1)*2pi*n*j/nx)*exp(sqrt(-1)*2pi*m*k/ny))
+c mixup = array of digit reversed addresses, from WFFT2RNINIT
+c sct = sine/cosine table, from WFFT2RNINIT
+c nyi = initial y index used
+c nyp = number of y indices used
+c nxhd = first dimension of f >= nx/2
+c nyd = second dimension of f >= ny
+c nxhyd = dimension of mixup >= nx/2 + ny
+c nxyd = dimension of sct >= nx + ny
+c fourier coefficients are stored as follows:
+c f(j,k) = mode j-1,k-1, where 1 <= j <= nx/2 and 1 <= k <= ny,
+c except for f(1,k) =  mode nx/2,k-1, where ny/2+2 <= k <= ny, and
+c aimag(f(1,1)) = real part of mode nx/2,0 and
+c aimag(f(1,ny/2+1)) = real part of mode nx/2,ny/2
+      implicit none
+      integer isign, nx, ny, nyi, nyp, nxhd, nyd, nxhyd, nxyd
+      complex f, sct
+      integer mixup
+      dimension f(nxhd,nyd), mixup(nxhyd), sct(nxyd)
+c local data
+      integer nxh, nxhh, nxh2, nyt, j, k
+      real ani
+      complex t1, t2, t3
+      if (isign.eq.0) return
+      nxh = nx/2
+      nxhh = nxh/2
+      nxh2 = nxh + 2
+      nyt = nyi + nyp - 1
+      if (isign.gt.0) go to 100
+c inverse fourier transform
+c first transform in x
+      call FFT1MR(f(1,nyi),isign,mixup,sct,nxh,2,1,nxhd,nyp)
+c unscramble coefficients and normalize
+      ani = 1.0/real(2*nx*ny)
+      do 80 j = 2, nxh - nxhh
+      t3 = cmplx(aimag(sct(j)),-real(sct(j)))
+      do 70 k = nyi, nyt
+      t2 = conjg(f(nxh2-j,k))
+      t1 = f(j,k) + t2
+      t2 = (f(j,k) - t2)*t3
+      f(j,k) = ani*(t1 + t2)
+      f(nxh2-j,k) = ani*conjg(t1 - t2)
+   70 continue
+   80 continue
+      ani = 2.0*ani
+      do 90 k = nyi, nyt
+      if (nxh.eq.(2*nxhh)) f(nxhh+1,k) = ani*conjg(f(nxhh+1,k))
+      f(1,k) = ani*cmplx(real(f(1,k)) + aimag(f(1,k)),                  
+     1                   real(f(1,k)) - aimag(f(1,k)))
+   90 continue
+      return
+c forward fourier transform
+c scramble coefficients
+  100 do 120 j = 2, nxh - nxhh
+      t3 = cmplx(aimag(sct(j)),real(sct(j)))
+      do 110 k = nyi, nyt
+      t2 = conjg(f(nxh2-j,k))
+      t1 = f(j,k) + t2
+      t2 = (f(j,k) - t2)*t3
+      f(j,k) = t1 + t2
+      f(nxh2-j,k) = conjg(t1 - t2)
+  110 continue
+  120 continue
+      do 130 k = nyi, nyt
+      if (nxh.eq.(2*nxhh)) f(nxhh+1,k) = 2.0*conjg(f(nxhh+1,k))
+      f(1,k) = cmplx(real(f(1,k)) + aimag(f(1,k)),                      
+     1               real(f(1,k)) - aimag(f(1,k)))
+  130 continue
+c then transform in x
+      call FFT1MR(f(1,nyi),isign,mixup,sct,nxh,2,1,nxhd,nyp)
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine FFT2RNXY(f,isign,mixup,sct,nx,ny,nxi,nxp,nxhd,nyd,nxhyd
+     1,nxyd)
+c this subroutine performs the y part of a two dimensional real to
+c complex mixed radix fast fourier transform and its inverse, for a
+c subset of x, using complex arithmetic
+c for isign = (-1,1), input: all, output: f
+c nx/ny = number of points in x/y direction, nx and ny must be even
+c if isign = -1, an inverse fourier transform is performed
+c f(n,m) = (1/nx*ny)*sum(f(j,k)*
+c       exp(-sqrt(-1)*2pi*n*j/nx)*exp(-sqrt(-1)*2pi*m*k/ny))
+c if isign = 1, a forward fourier transform is performed
+c f(j,k) = sum(f(n,m)*exp(sqrt(-1)*2pi*n*j/nx)*exp(sqrt(-1)*2pi*m*k/ny))
+c mixup = array of digit reversed addresses, from WFFT2RNINIT
+c sct = sine/cosine table, from WFFT2RNINIT
+c nxi = initial x index used
+c nxp = number of x indices used
+c nxhd = first dimension of f >= nx/2
+c nyd = second dimension of f >= ny
+c nxhyd = dimension of mixup >= nx/2 + ny
+c nxyd = dimension of sct >= nx + ny
+c fourier coefficients are stored as follows:
+c f(j,k) = mode j-1,k-1, where 1 <= j <= nx/2 and 1 <= k <= ny,
+c except for f(1,k) =  mode nx/2,k-1, where ny/2+2 <= k <= ny, and
+c aimag(f(1,1)) = real part of mode nx/2,0 and
+c aimag(f(1,ny/2+1)) = real part of mode nx/2,ny/2
+      implicit none
+      integer isign, nx, ny, nxi, nxp, nxhd, nyd, nxhyd, nxyd
+      complex f, sct
+      integer mixup
+      dimension f(nxhd,nyd), mixup(nxhyd), sct(nxyd)
+c local data
+      integer nxh, nyh, ny2, k
+      complex t1
+      if (isign.eq.0) return
+      nxh = nx/2
+      nyh = ny/2
+      ny2 = ny + 2
+      if (isign.gt.0) go to 80
+c inverse fourier transform
+c transform in y
+      call FFT1MR(f(nxi,1),isign,mixup(nxh+1),sct(nx+1),ny,1,nxhd,1,nxp
+     1)
+c unscramble modes kx = 0, nx/2
+      do 70 k = 2, nyh
+      if (nxi.eq.1) then
+         t1 = f(1,ny2-k)
+         f(1,ny2-k) = 0.5*cmplx(aimag(f(1,k) + t1),real(f(1,k) - t1))
+         f(1,k) = 0.5*cmplx(real(f(1,k) + t1),aimag(f(1,k) - t1))
+      endif
+   70 continue
+      return
+c forward fourier transform
+c scramble modes kx = 0, nx/2
+   80 do 90 k = 2, nyh
+      if (nxi.eq.1) then
+         t1 = cmplx(aimag(f(1,ny2-k)),real(f(1,ny2-k)))
+         f(1,ny2-k) = conjg(f(1,k) - t1)
+         f(1,k) = f(1,k) + t1
+      endif
+   90 continue
+c transform in y
+      call FFT1MR(f(nxi,1),isign,mixup(nxh+1),sct(nx+1),ny,1,nxhd,1,nxp
+     1)
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine FFT2RN2X(f,isign,mixup,sct,nx,ny,nyi,nyp,nxhd,nyd,nxhyd
+     1,nxyd)
+c this subroutine performs the x part of 2 two dimensional real to
+c complex mixed radix fast fourier transforms, and their inverses, for
+c a subset of y, using complex arithmetic
+c for isign = (-1,1), input: all, output: f
+c nx/ny = number of points in x/y direction, nx and ny must be even
+c if isign = -1, two inverse fourier transforms are performed
+c f(1:2,n,m) = (1/nx*ny)*sum(f(1:2,j,k)*
+c       exp(-sqrt(-1)*2pi*n*j/nx)*exp(-sqrt(-1)*2pi*m*k/ny))
+c if isign = 1, two forward fourier transforms are performed
+c f(1:2,j,k) = sum(f(1:2,n,m)*exp(sqrt(-1)*2pi*n*j/nx)*
+c       exp(sqrt(-1)*2pi*m*k/ny))
+c mixup = array of digit reversed addresses, from WFFT2RNINIT
+c sct = sine/cosine table, from WFFT2RNINIT
+c nyi = initial y index used
+c nyp = number of y indices used
+c nxhd = second dimension of f
+c nyd = third dimension of f
+c nxhyd = dimension of mixup >= nx/2 + ny
+c nxyd = dimension of sct >= nx + ny
+c fourier coefficients are stored as follows:
+c f(1:2,j,k) = mode j-1,k-1, where 1 <= j <= nx/2 and 1 <= k <= ny,
+c except for f(1:2,1,k) =  mode nx/2,k-1, where ny/2+2 <= k <= ny, and
+c aimag(f(1:2,1,1)) = real part of mode nx/2,0 and
+c aimag(f(1:2,1,ny/2+1)) = real part of mode nx/2,ny/2
+      implicit none
+      integer isign, nx, ny, nyi, nyp, nxhd, nyd, nxhyd, nxyd
+      complex f, sct
+      integer mixup
+      dimension f(2,nxhd,nyd), mixup(nxhyd), sct(nxyd)
+c local data
+      integer nxh, nxhh, nxh2, nyt, j, k, jj
+      real at1, ani
+      complex t1, t2, t3
+      if (isign.eq.0) return
+      nxh = nx/2
+      nxhh = nxh/2
+      nxh2 = nxh + 2
+      nyt = nyi + nyp - 1
+      if (isign.gt.0) go to 140
+c inverse fourier transform
+c swap complex components
+      do 20 k = nyi, nyt
+      do 10 j = 1, nxh
+      at1 = aimag(f(1,j,k))
+      f(1,j,k) = cmplx(real(f(1,j,k)),real(f(2,j,k)))
+      f(2,j,k) = cmplx(at1,aimag(f(2,j,k)))
+   10 continue
+   20 continue
+c first transform in x
+      do 30 jj = 1, 2
+      call FFT1MR(f(jj,1,nyi),isign,mixup,sct,nxh,2,2,2*nxhd,nyp)
+   30 continue
+c unscramble coefficients and normalize
+      ani = 1.0/real(2*nx*ny)
+      do 100 j = 2, nxh - nxhh
+      t3 = cmplx(aimag(sct(j)),-real(sct(j)))
+      do 90 k = nyi, nyt
+      do 80 jj = 1, 2
+      t2 = conjg(f(jj,nxh2-j,k))
+      t1 = f(jj,j,k) + t2
+      t2 = (f(jj,j,k) - t2)*t3
+      f(jj,j,k) = ani*(t1 + t2)
+      f(jj,nxh2-j,k) = ani*conjg(t1 - t2)
+   80 continue
+   90 continue
+  100 continue
+      ani = 2.0*ani
+      do 120 k = nyi, nyt
+      do 110 jj = 1, 2
+      if (nxh.eq.(2*nxhh)) then
+         f(jj,nxhh+1,k) = ani*conjg(f(jj,nxhh+1,k))
+      endif
+      f(jj,1,k) = ani*cmplx(real(f(jj,1,k)) + aimag(f(jj,1,k)),         
+     1                      real(f(jj,1,k)) - aimag(f(jj,1,k)))
+  110 continue
+  120 continue
+      return
+c forward fourier transform
+c scramble coefficients
+  140 do 170 j = 2, nxh - nxhh
+      t3 = cmplx(aimag(sct(j)),real(sct(j)))
+      do 160 k = nyi, nyt
+      do 150 jj = 1, 2
+      t2 = conjg(f(jj,nxh2-j,k))
+      t1 = f(jj,j,k) + t2
+      t2 = (f(jj,j,k) - t2)*t3
+      f(jj,j,k) = t1 + t2
+      f(jj,nxh2-j,k) = conjg(t1 - t2)
+  150 continue
+  160 continue
+  170 continue
+      do 190 k = nyi, nyt
+      do 180 jj = 1, 2
+      if (nxh.eq.(2*nxhh)) then
+         f(jj,nxhh+1,k) = 2.0*conjg(f(jj,nxhh+1,k))
+      endif
+      f(jj,1,k) = cmplx(real(f(jj,1,k)) + aimag(f(jj,1,k)),             
+     1                  real(f(jj,1,k)) - aimag(f(jj,1,k)))
+  180 continue
+  190 continue
+c then transform in x
+      do 200 jj = 1, 2
+      call FFT1MR(f(jj,1,nyi),isign,mixup,sct,nxh,2,2,2*nxhd,nyp)
+  200 continue
+c swap complex components
+      do 220 k = nyi, nyt
+      do 210 j = 1, nxh
+      at1 = aimag(f(1,j,k))
+      f(1,j,k) = cmplx(real(f(1,j,k)),real(f(2,j,k)))
+      f(2,j,k) = cmplx(at1,aimag(f(2,j,k)))
+  210 continue
+  220 continue
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine FFT2RN2Y(f,isign,mixup,sct,nx,ny,nxi,nxp,nxhd,nyd,nxhyd
+     1,nxyd)
+c this subroutine performs the y part of 2 two dimensional real to
+c complex mixed radix fast fourier transforms, and their inverses, for
+c a subset of x, using complex arithmetic
+c for isign = (-1,1), input: all, output: f
+c nx/ny = number of points in x/y direction, nx and ny must be even
+c if isign = -1, two inverse fourier transforms are performed
+c f(1:2,n,m) = (1/nx*ny)*sum(f(1:2,j,k)*
+c       exp(-sqrt(-1)*2pi*n*j/nx)*exp(-sqrt(-1)*2pi*m*k/ny))
+c if isign = 1, two forward fourier transforms are performed
+c f(1:2,j,k) = sum(f(1:2,n,m)*exp(sqrt(-1)*2pi*n*j/nx)*
+c       exp(sqrt(-1)*2pi*m*k/ny))
+c mixup = array of digit reversed addresses, from WFFT2RNINIT
+c sct = sine/cosine table, from WFFT2RNINIT
+c nxi = initial x index used
+c nxp = number of x indices used
+c nxhd = second dimension of f
+c nyd = third dimension of f
+c nxhyd = dimension of mixup >= nx/2 + ny
+c nxyd = dimension of sct >= nx + ny
+c fourier coefficients are stored as follows:
+c f(1:2,j,k) = mode j-1,k-1, where 1 <= j <= nx/2 and 1 <= k <= ny,
+c except for f(1:2,1,k) =  mode nx/2,k-1, where ny/2+2 <= k <= ny, and
+c aimag(f(1:2,1,1)) = real part of mode nx/2,0 and
+c aimag(f(1:2,1,ny/2+1)) = real part of mode nx/2,ny/2
+      implicit none
+      integer isign, nx, ny, nxi, nxp, nxhd, nyd, nxhyd, nxyd
+      complex f, sct
+      integer mixup
+      dimension f(2,nxhd,nyd), mixup(nxhyd), sct(nxyd)
+c local data
+      integer nxh, nyh, ny2, k, jj
+      complex t1
+      if (isign.eq.0) return
+      nxh = nx/2
+      nyh = ny/2
+      ny2 = ny + 2
+      if (isign.gt.0) go to 90
+c inverse fourier transform
+c transform in y
+      call FFT1MR(f(1,nxi,1),isign,mixup(nxh+1),sct(nx+1),ny,1,2*nxhd,1
+     1,2*nxp)
+c unscramble modes kx = 0, nx/2
+      do 80 k = 2, nyh
+      if (nxi.eq.1) then
+         do 70 jj = 1, 2
+         t1 = f(jj,1,ny2-k)
+         f(jj,1,ny2-k) = 0.5*cmplx(aimag(f(jj,1,k) + t1),               
+     1                             real(f(jj,1,k) - t1))
+         f(jj,1,k) = 0.5*cmplx(real(f(jj,1,k) + t1),                    
+     1                         aimag(f(jj,1,k) - t1))
+   70    continue
+      endif
+   80 continue
+      return
+c forward fourier transform
+c scramble modes kx = 0, nx/2
+   90 do 110 k = 2, nyh
+      if (nxi.eq.1) then
+         do 100 jj = 1, 2
+         t1 = cmplx(aimag(f(jj,1,ny2-k)),real(f(jj,1,ny2-k)))
+         f(jj,1,ny2-k) = conjg(f(jj,1,k) - t1)
+         f(jj,1,k) = f(jj,1,k) + t1
+  100    continue
+      endif
+  110 continue
+c transform in y
+      call FFT1MR(f(1,nxi,1),isign,mixup(nxh+1),sct(nx+1),ny,1,2*nxhd,1
+     1,2*nxp)
+      return
+      end
 c-----------------------------------------------------------------------
       subroutine GSPOST2L(part,q,qm,nop,idimp,nxv,nxyv)
 c for 2d code, this subroutine calculates particle charge density
@@ -61,6 +61,38 @@ void wfft2r2_(float complex *f, int *isign, int *mixup, float complex *sct,
               int *indx, int *indy, int *nxhd, int *nyd, int *nxhyd,
               int *nxyhd);
 
+void fftmrfac_(int *fac, int *n, int *nf);
+
+void fft1mr_(float complex *f, int *isign, int *mixup, float complex *sct,
+             int *n, int *nrs, int *nes, int *nvs, int *nvp);
+
+void wfft2rninit_(int *mixup, float complex *sct, int *nx, int *ny,
+                  int *nxhyd, int *nxyd);
+
+void fft2rnxx_(float complex *f, int *isign, int *mixup,
+               float complex *sct, int *nx, int *ny, int *nyi, int *nyp,
+               int *nxhd, int *nyd, int *nxhyd, int *nxyd);
+
+void fft2rnxy_(float complex *f, int *isign, int *mixup,
+               float complex *sct, int *nx, int *ny, int *nxi, int *nxp,
+               int *nxhd, int *nyd, int *nxhyd, int *nxyd);
+
+void fft2rn2x_(float complex *f, int *isign, int *mixup,
+               float complex *sct, int *nx, int *ny, int *nyi, int *nyp,
+               int *nxhd, int *nyd, int *nxhyd, int *nxyd);
+
+void fft2rn2y_(float complex *f, int *isign, int *mixup,
+               float complex *sct, int *nx, int *ny, int *nxi, int *nxp,
+               int *nxhd, int *nyd, int *nxhyd, int *nxyd);
+
+void wfft2rnx_(float complex *f, int *isign, int *mixup,
+               float complex *sct, int *nx, int *ny, int *nxhd, int *nyd,
+               int *nxhyd, int *nxyd);
+
+void wfft2rn2_(float complex *f, int *isign, int *mixup,
+               float complex *sct, int *nx, int *ny, int *nxhd, int *nyd,
+               int *nxhyd, int *nxyd);
+
 /* Interfaces to C */
 
 double ranorm() {
@@ -189,3 +221,75 @@ void cwfft2r2(float complex f[], int isign, int mixup[],
    return;
 }
 
+/*--------------------------------------------------------------------*/
+void cfftmrfac(int fac[], int n, int *nf) {
+   fftmrfac_(fac,&n,nf);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cfft1mr(float complex f[], int isign, int mixup[],
+             float complex sct[], int n, int nrs, int nes, int nvs,
+             int nvp) {
+   fft1mr_(f,&isign,mixup,sct,&n,&nrs,&nes,&nvs,&nvp);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cwfft2rninit(int mixup[], float complex sct[], int nx, int ny,
+                  int nxhyd, int nxyd) {
+   wfft2rninit_(mixup,sct,&nx,&ny,&nxhyd,&nxyd);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cfft2rnxx(float complex f[], int isign, int mixup[],
+               float complex sct[], int nx, int ny, int nyi, int nyp,
+               int nxhd, int nyd, int nxhyd, int nxyd) {
+   fft2rnxx_(f,&isign,mixup,sct,&nx,&ny,&nyi,&nyp,&nxhd,&nyd,&nxhyd,
+             &nxyd);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cfft2rnxy(float complex f[], int isign, int mixup[],
+               float complex sct[], int nx, int ny, int nxi, int nxp,
+               int nxhd, int nyd, int nxhyd, int nxyd) {
+   fft2rnxy_(f,&isign,mixup,sct,&nx,&ny,&nxi,&nxp,&nxhd,&nyd,&nxhyd,
+             &nxyd);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cfft2rn2x(float complex f[], int isign, int mixup[],
+               float complex sct[], int nx, int ny, int nyi, int nyp,
+               int nxhd, int nyd, int nxhyd, int nxyd) {
+   fft2rn2x_(f,&isign,mixup,sct,&nx,&ny,&nyi,&nyp,&nxhd,&nyd,&nxhyd,
+             &nxyd);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cfft2rn2y(float complex f[], int isign, int mixup[],
+               float complex sct[], int nx, int ny, int nxi, int nxp,
+               int nxhd, int nyd, int nxhyd, int nxyd) {
+   fft2rn2y_(f,&isign,mixup,sct,&nx,&ny,&nxi,&nxp,&nxhd,&nyd,&nxhyd,
+             &nxyd);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cwfft2rnx(float complex f[], int isign, int mixup[],
+               float complex sct[], int nx, int ny, int nxhd, int nyd,
+               int nxhyd, int nxyd) {
+   wfft2rnx_(f,&isign,mixup,sct,&nx,&ny,&nxhd,&nyd,&nxhyd,&nxyd);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cwfft2rn2(float complex f[], int isign, int mixup[],
+               float complex sct[], int nx, int ny, int nxhd, int nyd,
+               int nxhyd, int nxyd) {
+   wfft2rn2_(f,&isign,mixup,sct,&nx,&ny,&nxhd,&nyd,&nxhyd,&nxyd);
+   return;
+}
@@ -153,6 +153,104 @@
          complex, dimension(nxyhd), intent(in) :: sct
          end subroutine
       end interface
+!
+      interface
+         subroutine FFTMRFAC(fac,n,nf)
+         implicit none
+         integer, intent(in) :: n
+         integer, intent(inout) :: nf
+         integer, dimension(32), intent(inout) :: fac
+         end subroutine
+      end interface
+!
+      interface
+         subroutine FFT1MR(f,isign,mixup,sct,n,nrs,nes,nvs,nvp)
+         implicit none
+         integer, intent(in) :: isign, n, nrs, nes, nvs, nvp
+         complex, dimension(*), intent(inout) :: f
+         integer, dimension(n), intent(in) :: mixup
+         complex, dimension(*), intent(in) :: sct
+         end subroutine
+      end interface
+!
+      interface
+         subroutine WFFT2RNINIT(mixup,sct,nx,ny,nxhyd,nxyd)
+         implicit none
+         integer, intent(in) :: nx, ny, nxhyd, nxyd
+         integer, dimension(nxhyd), intent(inout) :: mixup
+         complex, dimension(nxyd), intent(inout) :: sct
+         end subroutine
+      end interface
+!
+      interface
+         subroutine WFFT2RNX(f,isign,mixup,sct,nx,ny,nxhd,nyd,nxhyd,nxyd&
+     &)
+         implicit none
+         integer, intent(in) :: isign, nx, ny, nxhd, nyd, nxhyd, nxyd
+         real, dimension(2*nxhd,nyd), intent(inout) :: f
+         integer, dimension(nxhyd), intent(in) :: mixup
+         complex, dimension(nxyd), intent(in) :: sct
+         end subroutine
+      end interface
+!
+      interface
+         subroutine WFFT2RN2(f,isign,mixup,sct,nx,ny,nxhd,nyd,nxhyd,nxyd&
+     &)
+         implicit none
+         integer, intent(in) :: isign, nx, ny, nxhd, nyd, nxhyd, nxyd
+         real, dimension(2,2*nxhd,nyd), intent(inout) :: f
+         integer, dimension(nxhyd), intent(in) :: mixup
+         complex, dimension(nxyd), intent(in) :: sct
+         end subroutine
+      end interface
+!
+      interface
+         subroutine FFT2RNXX(f,isign,mixup,sct,nx,ny,nyi,nyp,nxhd,nyd,  &
+     &nxhyd,nxyd)
+         implicit none
+         integer, intent(in) :: isign, nx, ny, nyi, nyp, nxhd, nyd
+         integer, intent(in) :: nxhyd, nxyd
+         real, dimension(2*nxhd,nyd), intent(inout) :: f
+         integer, dimension(nxhyd), intent(in) :: mixup
+         complex, dimension(nxyd), intent(in) :: sct
+         end subroutine
+      end interface
+!
+      interface
+         subroutine FFT2RNXY(f,isign,mixup,sct,nx,ny,nxi,nxp,nxhd,nyd,  &
+     &nxhyd,nxyd)
+         implicit none
+         integer, intent(in) :: isign, nx, ny, nxi, nxp, nxhd, nyd
+         integer, intent(in) :: nxhyd, nxyd
+         real, dimension(2*nxhd,nyd), intent(inout) :: f
+         integer, dimension(nxhyd), intent(in) :: mixup
+         complex, dimension(nxyd), intent(in) :: sct
+         end subroutine
+      end interface
+!
+      interface
+         subroutine FFT2RN2X(f,isign,mixup,sct,nx,ny,nyi,nyp,nxhd,nyd,  &
+     &nxhyd,nxyd)
+         implicit none
+         integer, intent(in) :: isign, nx, ny, nyi, nyp, nxhd, nyd
+         integer, intent(in) :: nxhyd, nxyd
+         real, dimension(2,2*nxhd,nyd), intent(inout) :: f
+         integer, dimension(nxhyd), intent(in) :: mixup
+         complex, dimension(nxyd), intent(in) :: sct
+         end subroutine
+      end interface
+!
+      interface
+         subroutine FFT2RN2Y(f,isign,mixup,sct,nx,ny,nxi,nxp,nxhd,nyd,  &
+     &nxhyd,nxyd)
+         implicit none
+         integer, intent(in) :: isign, nx, ny, nxi, nxp, nxhd, nyd
+         integer, intent(in) :: nxhyd, nxyd
+         real, dimension(2,2*nxhd,nyd), intent(inout) :: f
+         integer, dimension(nxhyd), intent(in) :: mixup
+         complex, dimension(nxyd), intent(in) :: sct
+         end subroutine
+      end interface
 !
       interface
          function ranorm()
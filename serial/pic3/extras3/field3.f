@@ -971,3 +971,124 @@ c mode numbers ky = 0
       return
       end
 
+c-----------------------------------------------------------------------
+      subroutine WKMODES3(pott,pkw,wm,dt,it,nt,ny,nz,modesx,modesy,
+     1modesz,modesxd,modesyd,modeszd,iw,iwd)
+c this subroutine accumulates a windowed discrete fourier transform in
+c time of the modes in pott, extracted by RDMODES3, for the frequencies
+c in wm, so that a frequency-wavenumber spectrum can be obtained without
+c storing the modes at each time step
+c pkw(j,k,l,n) = pkw(j,k,l,n) + dt*w(it)*pott(j,k,l)*
+c                exp(i*wm(n)*dt*(it-1))
+c where w(it) = 0.5*(1 - cos(2*pi*(it-1)/(nt-1))) is a hann window
+c a mode varying as exp(-i*w0*t) has a peak at wm(n) = w0
+c pkw must be zeroed before the first sample
+c pott = unpacked complex modes at sample it
+c pkw = accumulated transform for each mode and frequency
+c wm = frequencies to be calculated
+c dt = time interval between samples
+c it = sample number, 1 <= it <= nt, other samples are ignored
+c nt = total number of samples in window
+c ny/nz = system length in y/z direction
+c modesx/modesy/modesz = number of modes stored in x/y/z direction
+c modesxd = first dimension of arrays pott, pkw, modesxd >= modesx
+c modesyd = second dimension of arrays pott, pkw,
+c where modesyd  >= min(2*modesy-1,ny)
+c modeszd = third dimension of arrays pott, pkw,
+c where modeszd  >= min(2*modesz-1,nz)
+c iw = number of frequencies
+c iwd = fourth dimension of array pkw, iwd >= iw
+      implicit none
+      integer it, nt, ny, nz, modesx, modesy, modesz
+      integer modesxd, modesyd, modeszd, iw, iwd
+      real dt
+      complex pott, pkw
+      real wm
+      dimension pott(modesxd,modesyd,modeszd)
+      dimension pkw(modesxd,modesyd,modeszd,iwd)
+      dimension wm(iw)
+c local data
+      integer kmax, lmax, j, k, l, n
+      complex zt
+      double precision tt, wt
+      if ((it.lt.1).or.(it.gt.nt)) return
+      kmax = min0(2*modesy-1,ny)
+      lmax = min0(2*modesz-1,nz)
+c hann window
+      wt = 1.0d0
+      if (nt.gt.1) then
+         wt = 6.283185307179586d0*dble(it-1)/dble(nt-1)
+         wt = 0.5d0*(1.0d0 - dcos(wt))
+      endif
+      wt = dble(dt)*wt
+      tt = dble(dt)*dble(it-1)
+      do 40 n = 1, iw
+      zt = cmplx(real(wt*dcos(dble(wm(n))*tt)),
+     1           real(wt*dsin(dble(wm(n))*tt)))
+      do 30 l = 1, lmax
+      do 20 k = 1, kmax
+      do 10 j = 1, modesx
+      pkw(j,k,l,n) = pkw(j,k,l,n) + zt*pott(j,k,l)
+   10 continue
+   20 continue
+   30 continue
+   40 continue
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine WKPOW3(pkw,wkp,dt,nt,ny,nz,modesx,modesy,modesz,
+     1modesxd,modesyd,modeszd,iw,iwd)
+c this subroutine calculates the frequency-wavenumber power spectrum
+c from the transform accumulated by WKMODES3 over nt samples
+c wkp(j,k,l,n) = |pkw(j,k,l,n)|**2/(dt*sum(w(it)**2))
+c where w(it) is the hann window used by WKMODES3
+c pkw = accumulated transform for each mode and frequency
+c wkp = power spectrum for each mode and frequency
+c dt = time interval between samples
+c nt = total number of samples in window
+c ny/nz = system length in y/z direction
+c modesx/modesy/modesz = number of modes stored in x/y/z direction
+c modesxd = first dimension of arrays pkw, wkp, modesxd >= modesx
+c modesyd = second dimension of arrays pkw, wkp,
+c where modesyd  >= min(2*modesy-1,ny)
+c modeszd = third dimension of arrays pkw, wkp,
+c where modeszd  >= min(2*modesz-1,nz)
+c iw = number of frequencies
+c iwd = fourth dimension of arrays pkw, wkp, iwd >= iw
+      implicit none
+      integer nt, ny, nz, modesx, modesy, modesz
+      integer modesxd, modesyd, modeszd, iw, iwd
+      real dt
+      complex pkw
+      real wkp
+      dimension pkw(modesxd,modesyd,modeszd,iwd)
+      dimension wkp(modesxd,modesyd,modeszd,iwd)
+c local data
+      integer kmax, lmax, j, k, l, n
+      real anorm
+      double precision wt, sum1
+      kmax = min0(2*modesy-1,ny)
+      lmax = min0(2*modesz-1,nz)
+c sum squares of hann window
+      sum1 = 1.0d0
+      if (nt.gt.1) then
+         sum1 = 0.0d0
+         do 10 j = 1, nt
+         wt = 6.283185307179586d0*dble(j-1)/dble(nt-1)
+         wt = 0.5d0*(1.0d0 - dcos(wt))
+         sum1 = sum1 + wt*wt
+   10    continue
+      endif
+      anorm = 1.0/real(dble(dt)*sum1)
+      do 50 n = 1, iw
+      do 40 l = 1, lmax
+      do 30 k = 1, kmax
+      do 20 j = 1, modesx
+      wkp(j,k,l,n) = anorm*(real(pkw(j,k,l,n))**2
+     1                    + aimag(pkw(j,k,l,n))**2)
+   20 continue
+   30 continue
+   40 continue
+   50 continue
+      return
+      end
@@ -23,3 +23,12 @@ void cwrmodes3(float complex pot[], float complex pott[], int nx,
                int ny, int nz, int modesx, int modesy, int modesz,
                int nxvh, int nyv, int nzv, int modesxd, int modesyd,
                int modeszd);
+
+void cwkmodes3(float complex pott[], float complex pkw[], float wm[],
+               float dt, int it, int nt, int ny, int nz, int modesx,
+               int modesy, int modesz, int modesxd, int modesyd,
+               int modeszd, int iw, int iwd);
+
+void cwkpow3(float complex pkw[], float wkp[], float dt, int nt, int ny,
+             int nz, int modesx, int modesy, int modesz, int modesxd,
+             int modesyd, int modeszd, int iw, int iwd);
@@ -27,6 +27,16 @@ void wrmodes3_(float complex *pot, float complex *pott, int *nx,
                int *nxvh, int *nyv, int *nzv, int *modesxd,
                int *modesyd, int *modeszd);
 
+void wkmodes3_(float complex *pott, float complex *pkw, float *wm,
+               float *dt, int *it, int *nt, int *ny, int *nz,
+               int *modesx, int *modesy, int *modesz, int *modesxd,
+               int *modesyd, int *modeszd, int *iw, int *iwd);
+
+void wkpow3_(float complex *pkw, float *wkp, float *dt, int *nt,
+             int *ny, int *nz, int *modesx, int *modesy, int *modesz,
+             int *modesxd, int *modesyd, int *modeszd, int *iw,
+             int *iwd);
+
 /* Interfaces to C */
 
 /*--------------------------------------------------------------------*/
@@ -78,3 +88,22 @@ void cwrmodes3(float complex pot[], float complex pott[], int nx,
              &nzv,&modesxd,&modesyd,&modeszd);
    return;
 }
+
+/*--------------------------------------------------------------------*/
+void cwkmodes3(float complex pott[], float complex pkw[], float wm[],
+               float dt, int it, int nt, int ny, int nz, int modesx,
+               int modesy, int modesz, int modesxd, int modesyd,
+               int modeszd, int iw, int iwd) {
+   wkmodes3_(pott,pkw,wm,&dt,&it,&nt,&ny,&nz,&modesx,&modesy,&modesz,
+             &modesxd,&modesyd,&modeszd,&iw,&iwd);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cwkpow3(float complex pkw[], float wkp[], float dt, int nt, int ny,
+             int nz, int modesx, int modesy, int modesz, int modesxd,
+             int modesyd, int modeszd, int iw, int iwd) {
+   wkpow3_(pkw,wkp,&dt,&nt,&ny,&nz,&modesx,&modesy,&modesz,&modesxd,
+           &modesyd,&modeszd,&iw,&iwd);
+   return;
+}
@@ -66,5 +66,33 @@
          complex, dimension(modesxd,modesyd,modeszd) :: pott
          end subroutine
       end interface
+!
+      interface
+         subroutine WKMODES3(pott,pkw,wm,dt,it,nt,ny,nz,modesx,modesy,  &
+     &modesz,modesxd,modesyd,modeszd,iw,iwd)
+         implicit none
+         integer, intent(in) :: it, nt, ny, nz, modesx, modesy, modesz
+         integer, intent(in) :: modesxd, modesyd, modeszd, iw, iwd
+         real, intent(in) :: dt
+         complex, dimension(modesxd,modesyd,modeszd), intent(in) :: pott
+         complex, dimension(modesxd,modesyd,modeszd,iwd), intent(inout) &
+     &:: pkw
+         real, dimension(iw), intent(in) :: wm
+         end subroutine
+      end interface
+!
+      interface
+         subroutine WKPOW3(pkw,wkp,dt,nt,ny,nz,modesx,modesy,modesz,    &
+     &modesxd,modesyd,modeszd,iw,iwd)
+         implicit none
+         integer, intent(in) :: nt, ny, nz, modesx, modesy, modesz
+         integer, intent(in) :: modesxd, modesyd, modeszd, iw, iwd
+         real, intent(in) :: dt
+         complex, dimension(modesxd,modesyd,modeszd,iwd), intent(in) :: &
+     &pkw
+         real, dimension(modesxd,modesyd,modeszd,iwd), intent(inout) :: &
+     &wkp
+         end subroutine
+      end interface
 !
       end module
@@ -13,6 +13,11 @@ int main(int argc, char *argv[]) {
 /* indx/indy/indz = exponent which determines grid points in x/y/z: */
 /* direction: nx = 2**indx, ny = 2**indy, nz = 2**indz */
    int indx =   7, indy =   7, indz =   7;
+/* nxg/nyg/nzg = number of grid points in x/y/z direction for a mixed */
+/* radix FFT, which replace 2**indx/2**indy/2**indz if > 0.  nxg, nyg */
+/* and nzg must be even, and nxg/2, nyg and nzg must not have prime   */
+/* factors larger than 127                                            */
+   int nxg =   0, nyg =   0, nzg =   0;
 /* npx/npy/npz = number of electrons distributed in x/y/z direction */
    int npx =  384, npy =   384, npz =   384;
 /* ndim = number of velocity coordinates = 3 */
@@ -36,7 +41,8 @@ int main(int argc, char *argv[]) {
 /* declare scalars for standard code */
    int j;
    int np, nx, ny, nz, nxh, nyh, nzh, nxe, nye, nze, nxeh;
-   int nxyzh, nxhyz, ny1, nyz1, ntime, nloop, isign;
+   int nxyzh, nxhyz, ny1, nyz1, ntime, nloop, isign, mrfft, nf;
+   int fac[32];
    float qbme, affp;
 
 /* declare arrays for standard code: */
@@ -48,7 +54,7 @@ int main(int argc, char *argv[]) {
    float *fxyze = NULL;
 /* ffc = form factor array for poisson solver */
    float complex *ffc = NULL;
-/* mixup = bit reverse table for FFT */
+/* mixup = bit or digit reverse table for FFT */
    int *mixup = NULL;
 /* sct = sine/cosine table for FFT */
    float complex *sct = NULL;
@@ -66,10 +72,30 @@ int main(int argc, char *argv[]) {
 /* np = total number of particles in simulation */
 /* nx/ny/nz = number of grid points in x/y direction */
    np = npx*npy*npz; nx = 1L<<indx; ny = 1L<<indy; nz = 1L<<indz;
+/* mrfft = (0,1) = use (radix 2,mixed radix) FFT */
+   mrfft = (nxg > 0) || (nyg > 0) || (nzg > 0);
+   if (nxg > 0) nx = nxg;
+   if (nyg > 0) ny = nyg;
+   if (nzg > 0) nz = nzg;
    nxh = nx/2; nyh = 1 > ny/2 ? 1 : ny/2; nzh = 1 > nz/2 ? 1 : nz/2;
    nxe = nx + 2; nye = ny + 1; nze = nz + 1; nxeh = nxe/2;
    nxyzh = (nx > ny ? nx : ny); nxyzh = (nxyzh > nz ? nxyzh : nz)/2;
    nxhyz = nxh > ny ? nxh : ny; nxhyz = nxhyz > nz ? nxhyz : nz;
+/* mixed radix FFT tables hold the x, y and z directions */
+   if (mrfft) {
+      nxyzh = nx + ny + nz; nxhyz = nxh + ny + nz;
+/* check that grid can be factored */
+      cfftmrfac(fac,nxh,&nf);
+      if (nf >= 0)
+         cfftmrfac(fac,ny,&nf);
+      if (nf >= 0)
+         cfftmrfac(fac,nz,&nf);
+      if ((nf < 0) || ((nx%2) != 0) || ((ny%2) != 0) || ((nz%2) != 0)) {
+         printf("unsupported grid for mixed radix FFT: nx,ny,nz=%d,%d,%d\n",
+                nx,ny,nz);
+         exit(1);
+      }
+   }
    ny1 = ny + 1; nyz1 = ny1*(nz + 1);
 /* nloop = number of time steps in simulation */
 /* ntime = current time step */
@@ -89,7 +115,10 @@ int main(int argc, char *argv[]) {
    npic = (int *) malloc(nyz1*sizeof(int));
 
 /* prepare fft tables */
-   cwfft3rinit(mixup,sct,indx,indy,indz,nxhyz,nxyzh);
+   if (mrfft)
+      cwfft3rninit(mixup,sct,nx,ny,nz,nxhyz,nxyzh);
+   else
+      cwfft3rinit(mixup,sct,indx,indy,indz,nxhyz,nxyzh);
 /* calculate form factors */
    isign = 0;
    cpois33((float complex *)qe,(float complex *)fxyze,isign,ffc,ax,ay,az,
@@ -124,8 +153,12 @@ L500: if (nloop <= ntime)
 /* transform charge to fourier space with standard procedure: updates qe */
       dtimer(&dtime,&itime,-1);
       isign = -1;
-      cwfft3rx((float complex *)qe,isign,mixup,sct,indx,indy,indz,nxeh,
-               nye,nze,nxhyz,nxyzh);
+      if (mrfft)
+         cwfft3rnx((float complex *)qe,isign,mixup,sct,nx,ny,nz,nxeh,nye,
+                   nze,nxhyz,nxyzh);
+      else
+         cwfft3rx((float complex *)qe,isign,mixup,sct,indx,indy,indz,
+                  nxeh,nye,nze,nxhyz,nxyzh);
       dtimer(&dtime,&itime,1);
       time = (float) dtime;
       tfft += time;
@@ -143,8 +176,12 @@ L500: if (nloop <= ntime)
 /* transform force to real space with standard procedure: updates fxyze */
       dtimer(&dtime,&itime,-1);
       isign = 1;
-      cwfft3r3((float complex *)fxyze,isign,mixup,sct,indx,indy,indz,
-               nxeh,nye,nze,nxhyz,nxyzh);
+      if (mrfft)
+         cwfft3rn3((float complex *)fxyze,isign,mixup,sct,nx,ny,nz,nxeh,
+                   nye,nze,nxhyz,nxyzh);
+      else
+         cwfft3r3((float complex *)fxyze,isign,mixup,sct,indx,indy,indz,
+                  nxeh,nye,nze,nxhyz,nxyzh);
       dtimer(&dtime,&itime,1);
       time = (float) dtime;
       tfft += time;
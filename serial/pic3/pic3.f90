@@ -7,6 +7,11 @@
 ! indx/indy/indz = exponent which determines grid points in x/y/z
 ! direction: nx = 2**indx, ny = 2**indy, nz = 2**indz.
       integer, parameter :: indx =   7, indy =   7, indz =   7
+! nxg/nyg/nzg = number of grid points in x/y/z direction for a mixed
+! radix FFT, which replace 2**indx/2**indy/2**indz if > 0.  nxg, nyg
+! and nzg must be even, and nxg/2, nyg and nzg must not have prime
+! factors larger than 127
+      integer, parameter :: nxg =   0, nyg =   0, nzg =   0
 ! npx/npy/npz = number of electrons distributed in x/y/z direction.
       integer, parameter :: npx =  384, npy =   384, npz =   384
 ! ndim = number of velocity coordinates = 3
@@ -29,7 +34,9 @@
       real :: wke = 0.0, we = 0.0, wt = 0.0
 ! declare scalars for standard code
       integer :: np, nx, ny, nz, nxh, nyh, nzh, nxe, nye, nze, nxeh
-      integer :: nxyzh, nxhyz, ny1, nyz1, ntime, nloop, isign
+      integer :: nxyzh, nxhyz, ny1, nyz1, ntime, nloop, isign, nf
+      logical :: mrfft
+      integer, dimension(32) :: fac
       real :: qbme, affp
 !
 ! declare arrays for standard code:
@@ -41,7 +48,7 @@
       real, dimension(:,:,:,:), pointer :: fxyze
 ! ffc = form factor array for poisson solver
       complex, dimension(:,:,:), pointer :: ffc
-! mixup = bit reverse table for FFT
+! mixup = bit or digit reverse table for FFT
       integer, dimension(:), pointer :: mixup
 ! sct = sine/cosine table for FFT
       complex, dimension(:), pointer :: sct
@@ -59,9 +66,28 @@
 ! np = total number of particles in simulation
 ! nx/ny/nz = number of grid points in x/y/z direction
       np = npx*npy*npz; nx = 2**indx; ny = 2**indy; nz = 2**indz
+! mrfft = (.false.,.true.) = use (radix 2,mixed radix) FFT
+      mrfft = (nxg > 0).or.(nyg > 0).or.(nzg > 0)
+      if (nxg > 0) nx = nxg
+      if (nyg > 0) ny = nyg
+      if (nzg > 0) nz = nzg
       nxh = nx/2; nyh = max(1,ny/2); nzh = max(1,nz/2)
       nxe = nx + 2; nye = ny + 1; nze = nz + 1; nxeh = nxe/2
       nxyzh = max(nx,ny,nz)/2; nxhyz = max(nxh,ny,nz)
+! mixed radix FFT tables hold the x, y and z directions
+      if (mrfft) then
+         nxyzh = nx + ny + nz; nxhyz = nxh + ny + nz
+! check that grid can be factored
+         call FFTMRFAC(fac,nxh,nf)
+         if (nf >= 0) call FFTMRFAC(fac,ny,nf)
+         if (nf >= 0) call FFTMRFAC(fac,nz,nf)
+         if ((nf < 0).or.(mod(nx,2) /= 0).or.(mod(ny,2) /= 0).or.       &
+     &(mod(nz,2) /= 0)) then
+            write (*,*) 'unsupported grid for mixed radix FFT: nx,ny,nz=&
+     &', nx, ny, nz
+            stop
+         endif
+      endif
       ny1 = ny + 1; nyz1 = ny1*(nz + 1)
 ! nloop = number of time steps in simulation
 ! ntime = current time step
@@ -77,7 +103,11 @@
       allocate(npic(nyz1))
 !
 ! prepare fft tables
-      call WFFT3RINIT(mixup,sct,indx,indy,indz,nxhyz,nxyzh)
+      if (mrfft) then
+         call WFFT3RNINIT(mixup,sct,nx,ny,nz,nxhyz,nxyzh)
+      else
+         call WFFT3RINIT(mixup,sct,indx,indy,indz,nxhyz,nxyzh)
+      endif
 ! calculate form factors
       isign = 0
       call POIS33(qe,fxyze,isign,ffc,ax,ay,az,affp,we,nx,ny,nz,nxeh,nye,&
@@ -110,8 +140,13 @@
 ! transform charge to fourier space with standard procedure: updates qe
       call dtimer(dtime,itime,-1)
       isign = -1
-      call WFFT3RX(qe,isign,mixup,sct,indx,indy,indz,nxeh,nye,nze,nxhyz,&
+      if (mrfft) then
+         call WFFT3RNX(qe,isign,mixup,sct,nx,ny,nz,nxeh,nye,nze,nxhyz,  &
      &nxyzh)
+      else
+         call WFFT3RX(qe,isign,mixup,sct,indx,indy,indz,nxeh,nye,nze,   &
+     &nxhyz,nxyzh)
+      endif
       call dtimer(dtime,itime,1)
       time = real(dtime)
       tfft = tfft + time
@@ -129,8 +164,13 @@
 ! transform force to real space with standard procedure: updates fxyze
       call dtimer(dtime,itime,-1)
       isign = 1
-      call WFFT3R3(fxyze,isign,mixup,sct,indx,indy,indz,nxeh,nye,nze,   &
+      if (mrfft) then
+         call WFFT3RN3(fxyze,isign,mixup,sct,nx,ny,nz,nxeh,nye,nze,     &
+     &nxhyz,nxyzh)
+      else
+         call WFFT3R3(fxyze,isign,mixup,sct,indx,indy,indz,nxeh,nye,nze,&
      &nxhyz,nxyzh)
+      endif
       call dtimer(dtime,itime,1)
       time = real(dtime)
       tfft = tfft + time
@@ -2103,6 +2103,832 @@ void cwfft3r3(float complex f[], int isign, int mixup[],
    return;
 }
 
+/*--------------------------------------------------------------------*/
+void cfftmrfac(int fac[], int n, int *nf) {
+/* this subroutine factors the length n of a mixed radix fast fourier
+   transform into the radices of the transform stages, in the order in
+   which the stages are performed: radix 4, then 2, 3, 5 and any
+   remaining prime factors, in increasing order
+   input: n, output: fac, nf
+   fac = array of radices, with dimension at least 32
+   n = length of transform
+   nf = number of radices, nf = -1 if n < 1 or if n has a prime factor
+   larger than 127
+local data                                                            */
+   int l, m, np;
+   *nf = -1;
+   if (n < 1)
+      return;
+   l = 0;
+   m = n;
+   while ((m%4)==0) {
+      fac[l] = 4;
+      l += 1;
+      m = m/4;
+   }
+   np = 2;
+   while (m > 1) {
+      if ((m%np)==0) {
+         if (np > 127)
+            return;
+         fac[l] = np;
+         l += 1;
+         m = m/np;
+      }
+      else
+         np = np==2 ? 3 : np + 2;
+   }
+   *nf = l;
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cfft1mr(float complex f[], int isign, int mixup[],
+             float complex sct[], int n, int nrs, int nes, int nvs,
+             int nvp) {
+/* this subroutine performs multiple one dimensional mixed radix complex
+   fast fourier transforms of length n, without normalization.
+   element m of vector i is stored in f[nes*m+nvs*i], 0 <= i < nvp
+   the length n may contain any prime factors less than 128, the radix
+   4, 2, 3 and 5 stages are the fastest, other primes use a direct
+   discrete fourier transform of length equal to the prime.
+   for isign = (-1,1), input: all, output: f
+   if isign = -1, the inverse transform is performed
+   f[nes*m] = sum(f[nes*k]*exp(-sqrt(-1)*2pi*m*k/n))
+   if isign = 1, the forward transform is performed
+   f[nes*k] = sum(f[nes*m]*exp(sqrt(-1)*2pi*m*k/n))
+   mixup = array of digit reversed addresses, where mixup[j]-1 is the
+   address whose element is moved to address j, negative for the first
+   address of each permutation cycle
+   sct = sine/cosine table, where sct[nrs*j] = exp(-sqrt(-1)*2pi*j/n)
+   nrs = stride in sct table
+   nes = stride between elements of a vector
+   nvs = stride between vectors
+   nvp = number of vectors
+local data                                                            */
+   int nf, fac[32];
+   int i, j, k, l, m, q, r, j1, k1, kk, ns, nsp, np, km, kmr, nrp, joff;
+   float complex t1, t2, t3, t4, t5, t6, w1, w2, w3, w4, tp[128];
+   if (isign==0)
+      return;
+   cfftmrfac(fac,n,&nf);
+   if (nf < 0)
+      return;
+/* reorder array elements in digit reversed order, one cycle at a time */
+   for (j = 0; j < n; j++) {
+      if (mixup[j] > 0)
+         continue;
+      for (i = 0; i < nvp; i++) {
+         joff = nvs*i;
+         t1 = f[nes*j+joff];
+         k = j;
+         k1 = -mixup[j] - 1;
+         while (k1 != j) {
+            f[nes*k+joff] = f[nes*k1+joff];
+            k = k1;
+            k1 = mixup[k] - 1;
+         }
+         f[nes*k+joff] = t1;
+      }
+   }
+/* transform stages, combining np transforms of length ns into one */
+/* transform of length ns*np                                       */
+   ns = 1;
+   for (l = 0; l < nf; l++) {
+      np = fac[l];
+      nsp = ns*np;
+      km = n/nsp;
+      kmr = nrs*km;
+      nrp = nrs*(n/np);
+/* roots of unity for the butterflies */
+      t1 = sct[nrp];
+      t2 = np > 2 ? sct[2*nrp] : t1;
+      if (isign > 0) {
+         t1 = conjf(t1);
+         t2 = conjf(t2);
+      }
+      m = nes*ns;
+      for (k = 0; k < km; k++) {
+         k1 = nsp*k;
+         for (j = 0; j < ns; j++) {
+            j1 = nes*(j + k1);
+            w1 = sct[kmr*j];
+            w2 = sct[2*kmr*j];
+            if (isign > 0) {
+               w1 = conjf(w1);
+               w2 = conjf(w2);
+            }
+/* radix 2 */
+            if (np==2) {
+               for (i = 0; i < nvp; i++) {
+                  joff = j1 + nvs*i;
+                  t3 = w1*f[m+joff];
+                  f[m+joff] = f[joff] - t3;
+                  f[joff] += t3;
+               }
+            }
+/* radix 4 */
+            else if (np==4) {
+               w3 = sct[3*kmr*j];
+               if (isign > 0)
+                  w3 = conjf(w3);
+               for (i = 0; i < nvp; i++) {
+                  joff = j1 + nvs*i;
+                  t3 = w2*f[2*m+joff];
+                  t4 = f[joff] - t3;
+                  t3 += f[joff];
+                  t5 = w1*f[m+joff];
+                  t6 = w3*f[3*m+joff];
+                  w4 = t5 + t6;
+                  t5 = t1*(t5 - t6);
+                  f[joff] = t3 + w4;
+                  f[m+joff] = t4 + t5;
+                  f[2*m+joff] = t3 - w4;
+                  f[3*m+joff] = t4 - t5;
+               }
+            }
+/* radix 3 */
+            else if (np==3) {
+               for (i = 0; i < nvp; i++) {
+                  joff = j1 + nvs*i;
+                  t3 = w1*f[m+joff];
+                  t4 = w2*f[2*m+joff];
+                  w4 = t3 + t4;
+                  t3 = cimagf(t1)*(t3 - t4)*_Complex_I;
+                  t4 = f[joff] + crealf(t1)*w4;
+                  f[joff] += w4;
+                  f[m+joff] = t4 + t3;
+                  f[2*m+joff] = t4 - t3;
+               }
+            }
+/* radix 5 */
+            else if (np==5) {
+               w3 = sct[3*kmr*j];
+               w4 = sct[4*kmr*j];
+               if (isign > 0) {
+                  w3 = conjf(w3);
+                  w4 = conjf(w4);
+               }
+               for (i = 0; i < nvp; i++) {
+                  joff = j1 + nvs*i;
+                  tp[1] = w1*f[m+joff];
+                  tp[2] = w2*f[2*m+joff];
+                  tp[3] = w3*f[3*m+joff];
+                  tp[4] = w4*f[4*m+joff];
+                  t3 = tp[1] + tp[4];
+                  t4 = tp[2] + tp[3];
+                  tp[1] = (tp[1] - tp[4])*_Complex_I;
+                  tp[2] = (tp[2] - tp[3])*_Complex_I;
+                  tp[3] = f[joff] + crealf(t1)*t3 + crealf(t2)*t4;
+                  tp[4] = f[joff] + crealf(t2)*t3 + crealf(t1)*t4;
+                  tp[5] = cimagf(t1)*tp[1] + cimagf(t2)*tp[2];
+                  tp[6] = cimagf(t2)*tp[1] - cimagf(t1)*tp[2];
+                  f[joff] += t3 + t4;
+                  f[m+joff] = tp[3] + tp[5];
+                  f[2*m+joff] = tp[4] + tp[6];
+                  f[3*m+joff] = tp[4] - tp[6];
+                  f[4*m+joff] = tp[3] - tp[5];
+               }
+            }
+/* other prime radix, direct discrete fourier transform */
+            else {
+               for (i = 0; i < nvp; i++) {
+                  joff = j1 + nvs*i;
+                  tp[0] = f[joff];
+                  for (r = 1; r < np; r++) {
+                     t3 = sct[kmr*r*j];
+                     if (isign > 0)
+                        t3 = conjf(t3);
+                     tp[r] = t3*f[m*r+joff];
+                  }
+                  for (q = 0; q < np; q++) {
+                     t3 = tp[0];
+                     kk = 0;
+                     for (r = 1; r < np; r++) {
+                        kk += q;
+                        if (kk >= np)
+                           kk -= np;
+                        t4 = sct[nrp*kk];
+                        if (isign > 0)
+                           t4 = conjf(t4);
+                        t3 += t4*tp[r];
+                     }
+                     f[m*q+joff] = t3;
+                  }
+               }
+            }
+         }
+      }
+      ns = nsp;
+   }
+   return;
+}
+
+
+/*--------------------------------------------------------------------*/
+void cwfft3rninit(int mixup[], float complex sct[], int nx, int ny,
+                  int nz, int nxhyzd, int nxyzd) {
+/* this subroutine calculates tables needed by a three dimensional
+   real to complex mixed radix fast fourier transform and its inverse,
+   for grids whose sizes need not be powers of 2.
+   input: nx, ny, nz, nxhyzd, nxyzd
+   output: mixup, sct
+   mixup = array of digit reversed addresses, for the x transform of
+   length nx/2 in mixup[0:nx/2-1], for the y transform of length ny in
+   mixup[nx/2:nx/2+ny-1] and for the z transform of length nz in
+   mixup[nx/2+ny:nx/2+ny+nz-1]
+   sct = sine/cosine table, for the angles 2*n*pi/nx in sct[0:nx-1],
+   for the angles 2*n*pi/ny in sct[nx:nx+ny-1] and for the angles
+   2*n*pi/nz in sct[nx+ny:nx+ny+nz-1]
+   nx/ny/nz = number of points in x/y/z direction, nx, ny and nz must
+   be even, and nx/2, ny and nz must not have prime factors larger than
+   127
+   nxhyzd = dimension of mixup >= nx/2 + ny + nz
+   nxyzd = dimension of sct >= nx + ny + nz
+local data                                                            */
+   int nxh, n, nf, moff, soff, fac[32];
+   int i, j, k, l, m, ll, mr;
+   float dnx, arg;
+   nxh = nx/2;
+   for (i = 0; i < 3; i++) {
+      n = i==0 ? nxh : (i==1 ? ny : nz);
+      moff = i==0 ? 0 : (i==1 ? nxh : nxh + ny);
+      cfftmrfac(fac,n,&nf);
+/* digit-reverse index table: mixup[j] = 1 + digits of j reversed, */
+/* with the radix of the last transform stage as the leading digit */
+      for (j = 0; j < n; j++) {
+         m = n;
+         k = j;
+         ll = 0;
+         mr = 1;
+         for (l = nf-1; l >= 0; l--) {
+            m = m/fac[l];
+            ll += mr*(k/m);
+            k = k - m*(k/m);
+            mr = mr*fac[l];
+         }
+         mixup[j+moff] = ll + 1;
+      }
+/* negate the first address of each permutation cycle */
+      for (j = 0; j < n; j++) {
+         k = mixup[j+moff] - 1;
+         if (k==j)
+            continue;
+         while (k > j) {
+            k = mixup[k+moff] - 1;
+         }
+         if (k==j)
+            mixup[j+moff] = -mixup[j+moff];
+      }
+   }
+/* sine/cosine table for the angles 2*n*pi/nx, 2*n*pi/ny, 2*n*pi/nz */
+   for (i = 0; i < 3; i++) {
+      n = i==0 ? nx : (i==1 ? ny : nz);
+      soff = i==0 ? 0 : (i==1 ? nx : nx + ny);
+      dnx = 6.28318530717959/(float) n;
+      for (j = 0; j < n; j++) {
+         arg = dnx*(float) j;
+         sct[j+soff] = cosf(arg) - sinf(arg)*_Complex_I;
+      }
+   }
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cfft3rnxy(float complex f[], int isign, int mixup[],
+               float complex sct[], int nx, int ny, int nz, int nzi,
+               int nzp, int nxhd, int nyd, int nzd, int nxhyzd,
+               int nxyzd) {
+/* this subroutine performs the x-y part of a three dimensional real to
+   complex mixed radix fast fourier transform and its inverse, for a
+   subset of z, using complex arithmetic
+   for isign = (-1,1), input: all, output: f
+   nx/ny/nz = number of points in x/y/z direction, nx, ny and nz must
+   be even
+   if isign = -1, an inverse fourier transform is performed
+   f[i][m][n] = (1/nx*ny*nz)*sum(f[i][k][j]*exp(-sqrt(-1)*2pi*n*j/nx)*
+         exp(-sqrt(-1)*2pi*m*k/ny))
+   if isign = 1, a forward fourier transform is performed
+   f[l][k][j] = sum(f[l][m][n]*exp(sqrt(-1)*2pi*n*j/nx)*
+         exp(sqrt(-1)*2pi*m*k/ny))
+   mixup = array of digit reversed addresses, from cwfft3rninit
+   sct = sine/cosine table, from cwfft3rninit
+   nzi = initial z index used
+   nzp = number of z indices used
+   nxhd = first dimension of f >= nx/2
+   nyd,nzd = second and third dimensions of f
+   nxhyzd = dimension of mixup >= nx/2 + ny + nz
+   nxyzd = dimension of sct >= nx + ny + nz
+   fourier coefficients are stored as for cfft3rxy
+local data                                                            */
+   int nxh, nxhh, nyh, nzt, nxhyd;
+   int j, k, n, nn, k1, joff;
+   float ani;
+   float complex t1, t2, t3;
+   if (isign==0)
+      return;
+   nxh = nx/2;
+   nxhh = nxh/2;
+   nyh = ny/2;
+   nzt = nzi + nzp - 1;
+   nxhyd = nxhd*nyd;
+   if (isign > 0)
+      goto L100;
+/* inverse fourier transform */
+   ani = 0.5/(((float) nx)*((float) ny)*((float) nz));
+   for (n = nzi-1; n < nzt; n++) {
+      nn = nxhyd*n;
+/* first transform in x */
+      cfft1mr(&f[nn],isign,mixup,sct,nxh,2,1,nxhd,ny);
+/* unscramble coefficients and normalize */
+      for (j = 1; j < nxh-nxhh; j++) {
+         t3 = cimagf(sct[j]) - crealf(sct[j])*_Complex_I;
+         for (k = 0; k < ny; k++) {
+            joff = nxhd*k + nn;
+            t2 = conjf(f[nxh-j+joff]);
+            t1 = f[j+joff] + t2;
+            t2 = (f[j+joff] - t2)*t3;
+            f[j+joff] = ani*(t1 + t2);
+            f[nxh-j+joff] = ani*conjf(t1 - t2);
+         }
+      }
+      for (k = 0; k < ny; k++) {
+         joff = nxhd*k + nn;
+         if (nxh==2*nxhh)
+            f[nxhh+joff] = 2.0*ani*conjf(f[nxhh+joff]);
+         f[joff] = 2.0*ani*((crealf(f[joff]) + cimagf(f[joff]))
+                   + (crealf(f[joff]) - cimagf(f[joff]))*_Complex_I);
+      }
+/* then transform in y */
+      cfft1mr(&f[nn],isign,&mixup[nxh],&sct[nx],ny,1,nxhd,1,nxh);
+/* unscramble modes kx = 0, nx/2 */
+      for (k = 1; k < nyh; k++) {
+         joff = nxhd*k;
+         k1 = nxhd*ny - joff + nn;
+         joff += nn;
+         t1 = f[k1];
+         f[k1] = 0.5*(cimagf(f[joff] + t1)
+                  + crealf(f[joff] - t1)*_Complex_I);
+         f[joff] = 0.5*(crealf(f[joff] + t1)
+                    + cimagf(f[joff] - t1)*_Complex_I);
+      }
+   }
+   return;
+/* forward fourier transform */
+L100: for (n = nzi-1; n < nzt; n++) {
+      nn = nxhyd*n;
+/* scramble modes kx = 0, nx/2 */
+      for (k = 1; k < nyh; k++) {
+         joff = nxhd*k;
+         k1 = nxhd*ny - joff + nn;
+         joff += nn;
+         t1 = cimagf(f[k1]) + crealf(f[k1])*_Complex_I;
+         f[k1] = conjf(f[joff] - t1);
+         f[joff] += t1;
+      }
+/* then transform in y */
+      cfft1mr(&f[nn],isign,&mixup[nxh],&sct[nx],ny,1,nxhd,1,nxh);
+/* scramble coefficients */
+      for (j = 1; j < nxh-nxhh; j++) {
+         t3 = cimagf(sct[j]) + crealf(sct[j])*_Complex_I;
+         for (k = 0; k < ny; k++) {
+            joff = nxhd*k + nn;
+            t2 = conjf(f[nxh-j+joff]);
+            t1 = f[j+joff] + t2;
+            t2 = (f[j+joff] - t2)*t3;
+            f[j+joff] = t1 + t2;
+            f[nxh-j+joff] = conjf(t1 - t2);
+         }
+      }
+      for (k = 0; k < ny; k++) {
+         joff = nxhd*k + nn;
+         if (nxh==2*nxhh)
+            f[nxhh+joff] = 2.0*conjf(f[nxhh+joff]);
+         f[joff] = (crealf(f[joff]) + cimagf(f[joff]))
+                   + (crealf(f[joff]) - cimagf(f[joff]))*_Complex_I;
+      }
+/* finally transform in x */
+      cfft1mr(&f[nn],isign,mixup,sct,nxh,2,1,nxhd,ny);
+   }
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cfft3rnxz(float complex f[], int isign, int mixup[],
+               float complex sct[], int nx, int ny, int nz, int nyi,
+               int nyp, int nxhd, int nyd, int nzd, int nxhyzd,
+               int nxyzd) {
+/* this subroutine performs the z part of a three dimensional real to
+   complex mixed radix fast fourier transform and its inverse, for a
+   subset of y, using complex arithmetic
+   for isign = (-1,1), input: all, output: f
+   nx/ny/nz = number of points in x/y/z direction, nx, ny and nz must
+   be even
+   if isign = -1, an inverse fourier transform is performed
+   f[l][k][j] = sum(f[i][k][j]*exp(-sqrt(-1)*2pi*l*i/nz))
+   if isign = 1, a forward fourier transform is performed
+   f[i][m][n] = sum(f[l][m][n]*exp(sqrt(-1)*2pi*l*i/nz))
+   mixup = array of digit reversed addresses, from cwfft3rninit
+   sct = sine/cosine table, from cwfft3rninit
+   nyi = initial y index used
+   nyp = number of y indices used
+   nxhd = first dimension of f >= nx/2
+   nyd,nzd = second and third dimensions of f
+   nxhyzd = dimension of mixup >= nx/2 + ny + nz
+   nxyzd = dimension of sct >= nx + ny + nz
+   fourier coefficients are stored as for cfft3rxz
+local data                                                            */
+   int nxh, nyh, nzh, nyt, nxhyd;
+   int n, ll, l1, i0, i1;
+   float complex t1;
+   if (isign==0)
+      return;
+   nxh = nx/2;
+   nyh = ny/2;
+   nzh = nz/2;
+   nyt = nyi + nyp - 1;
+   nxhyd = nxhd*nyd;
+   if (isign > 0)
+      goto L80;
+/* inverse fourier transform */
+/* finally transform in z */
+   for (n = nyi-1; n < nyt; n++) {
+      cfft1mr(&f[nxhd*n],isign,&mixup[nxh+ny],&sct[nx+ny],nz,1,nxhyd,1,
+              nxh);
+   }
+/* unscramble modes kx = 0, nx/2 */
+   for (n = 1; n < nzh; n++) {
+      ll = nxhyd*n;
+      l1 = nxhyd*nz - ll;
+      if (nyi==1) {
+         t1 = f[l1];
+         f[l1] = 0.5*(cimagf(f[ll] + t1)
+                    + crealf(f[ll] - t1)*_Complex_I);
+         f[ll] = 0.5*(crealf(f[ll] + t1)
+                    + cimagf(f[ll] - t1)*_Complex_I);
+      }
+      if ((nyi <= (nyh+1)) && (nyt >= (nyh+1))) {
+         i1 = nxhd*nyh;
+         i0 = i1 + ll;
+         i1 += l1;
+         t1 = f[i1];
+         f[i1] = 0.5*(cimagf(f[i0] + t1)
+                  +   crealf(f[i0] - t1)*_Complex_I);
+         f[i0] = 0.5*(crealf(f[i0] + t1)
+                    + cimagf(f[i0] - t1)*_Complex_I);
+      }
+   }
+   return;
+/* forward fourier transform */
+/* scramble modes kx = 0, nx/2 */
+L80: for (n = 1; n < nzh; n++) {
+      ll = nxhyd*n;
+      l1 = nxhyd*nz - ll;
+      if (nyi==1) {
+         t1 = cimagf(f[l1]) + crealf(f[l1])*_Complex_I;
+         f[l1] = conjf(f[ll] - t1);
+         f[ll] += t1;
+      }
+      if ((nyi <= (nyh+1)) && (nyt >= (nyh+1))) {
+         i1 = nxhd*nyh;
+         i0 = i1 + ll;
+         i1 += l1;
+         t1 = cimagf(f[i1]) + crealf(f[i1])*_Complex_I;
+         f[i1] = conjf(f[i0] - t1);
+         f[i0] += t1;
+      }
+   }
+/* first transform in z */
+   for (n = nyi-1; n < nyt; n++) {
+      cfft1mr(&f[nxhd*n],isign,&mixup[nxh+ny],&sct[nx+ny],nz,1,nxhyd,1,
+              nxh);
+   }
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cfft3rn3xy(float complex f[], int isign, int mixup[],
+                float complex sct[], int nx, int ny, int nz, int nzi,
+                int nzp, int nxhd, int nyd, int nzd, int nxhyzd,
+                int nxyzd) {
+/* this subroutine performs the x-y part of 3 three dimensional complex
+   to real mixed radix fast fourier transforms and their inverses, for
+   a subset of z, using complex arithmetic
+   for isign = (-1,1), input: all, output: f
+   nx/ny/nz = number of points in x/y/z direction, nx, ny and nz must
+   be even
+   if isign = -1, three inverse fourier transforms are performed
+   f[i][m][n][0:2] = (1/nx*ny*nz)*sum(f[i][k][j][0:2]*
+         exp(-sqrt(-1)*2pi*n*j/nx)*exp(-sqrt(-1)*2pi*m*k/ny))
+   if isign = 1, three forward fourier transforms are performed
+   f[l][k][j][0:2] = sum(f[l][m][n][0:2]*exp(sqrt(-1)*2pi*n*j/nx)*
+         exp(sqrt(-1)*2pi*m*k/ny))
+   mixup = array of digit reversed addresses, from cwfft3rninit
+   sct = sine/cosine table, from cwfft3rninit
+   nzi = initial z index used
+   nzp = number of z indices used
+   nxhd = second dimension of f >= nx/2
+   nyd,nzd = third and fourth dimensions of f
+   nxhyzd = dimension of mixup >= nx/2 + ny + nz
+   nxyzd = dimension of sct >= nx + ny + nz
+   fourier coefficients are stored as for cfft3r3xy
+local data                                                            */
+   int nxh, nxhh, nyh, nzt, nxhd3, nxhyd;
+   int j, k, n, nn, jj, k1, joff;
+   float at1, at2, ani;
+   float complex t1, t2, t3;
+   if (isign==0)
+      return;
+   nxh = nx/2;
+   nxhh = nxh/2;
+   nyh = ny/2;
+   nzt = nzi + nzp - 1;
+   nxhd3 = 3*nxhd;
+   nxhyd = nxhd3*nyd;
+   if (isign > 0)
+      goto L140;
+/* inverse fourier transform */
+   ani = 0.5/(((float) nx)*((float) ny)*((float) nz));
+   for (n = nzi-1; n < nzt; n++) {
+      nn = nxhyd*n;
+/* swap complex components */
+      for (k = 0; k < ny; k++) {
+         joff = nxhd3*k + nn;
+         for (j = 0; j < nxh; j++) {
+            at1 = crealf(f[2+3*j+joff]);
+            f[2+3*j+joff] = crealf(f[1+3*j+joff])
+                            + cimagf(f[2+3*j+joff])*_Complex_I;
+            at2 = cimagf(f[1+3*j+joff]);
+            f[1+3*j+joff] = cimagf(f[3*j+joff]) + at1*_Complex_I;
+            f[3*j+joff] = crealf(f[3*j+joff]) + at2*_Complex_I;
+         }
+      }
+/* first transform in x */
+      for (jj = 0; jj < 3; jj++) {
+         cfft1mr(&f[jj+nn],isign,mixup,sct,nxh,2,3,nxhd3,ny);
+      }
+/* unscramble coefficients and normalize */
+      for (j = 1; j < nxh-nxhh; j++) {
+         t3 = cimagf(sct[j]) - crealf(sct[j])*_Complex_I;
+         for (k = 0; k < ny; k++) {
+            joff = nxhd3*k + nn;
+            for (jj = 0; jj < 3; jj++) {
+               t2 = conjf(f[jj+3*(nxh-j)+joff]);
+               t1 = f[jj+3*j+joff] + t2;
+               t2 = (f[jj+3*j+joff] - t2)*t3;
+               f[jj+3*j+joff] = ani*(t1 + t2);
+               f[jj+3*(nxh-j)+joff] = ani*conjf(t1 - t2);
+            }
+         }
+      }
+      for (k = 0; k < ny; k++) {
+         joff = nxhd3*k + nn;
+         for (jj = 0; jj < 3; jj++) {
+            if (nxh==2*nxhh)
+               f[jj+3*nxhh+joff] = 2.0*ani*conjf(f[jj+3*nxhh+joff]);
+            f[jj+joff] = 2.0*ani*((crealf(f[jj+joff])
+                         + cimagf(f[jj+joff]))
+                         + (crealf(f[jj+joff])
+                         - cimagf(f[jj+joff]))*_Complex_I);
+         }
+      }
+/* then transform in y */
+      cfft1mr(&f[nn],isign,&mixup[nxh],&sct[nx],ny,1,nxhd3,1,3*nxh);
+/* unscramble modes kx = 0, nx/2 */
+      for (k = 1; k < nyh; k++) {
+         joff = nxhd3*k;
+         k1 = nxhd3*ny - joff + nn;
+         joff += nn;
+         for (jj = 0; jj < 3; jj++) {
+            t1 = f[jj+k1];
+            f[jj+k1] = 0.5*(cimagf(f[jj+joff] + t1)
+                        + crealf(f[jj+joff] - t1)*_Complex_I);
+            f[jj+joff] = 0.5*(crealf(f[jj+joff] + t1)
+                          + cimagf(f[jj+joff] - t1)*_Complex_I);
+         }
+      }
+   }
+   return;
+/* forward fourier transform */
+L140: for (n = nzi-1; n < nzt; n++) {
+      nn = nxhyd*n;
+/* scramble modes kx = 0, nx/2 */
+      for (k = 1; k < nyh; k++) {
+         joff = nxhd3*k;
+         k1 = nxhd3*ny - joff + nn;
+         joff += nn;
+         for (jj = 0; jj < 3; jj++) {
+            t1 = cimagf(f[jj+k1]) + crealf(f[jj+k1])*_Complex_I;
+            f[jj+k1] = conjf(f[jj+joff] - t1);
+            f[jj+joff] += t1;
+         }
+      }
+/* then transform in y */
+      cfft1mr(&f[nn],isign,&mixup[nxh],&sct[nx],ny,1,nxhd3,1,3*nxh);
+/* scramble coefficients */
+      for (j = 1; j < nxh-nxhh; j++) {
+         t3 = cimagf(sct[j]) + crealf(sct[j])*_Complex_I;
+         for (k = 0; k < ny; k++) {
+            joff = nxhd3*k + nn;
+            for (jj = 0; jj < 3; jj++) {
+               t2 = conjf(f[jj+3*(nxh-j)+joff]);
+               t1 = f[jj+3*j+joff] + t2;
+               t2 = (f[jj+3*j+joff] - t2)*t3;
+               f[jj+3*j+joff] = t1 + t2;
+               f[jj+3*(nxh-j)+joff] = conjf(t1 - t2);
+            }
+         }
+      }
+      for (k = 0; k < ny; k++) {
+         joff = nxhd3*k + nn;
+         for (jj = 0; jj < 3; jj++) {
+            if (nxh==2*nxhh)
+               f[jj+3*nxhh+joff] = 2.0*conjf(f[jj+3*nxhh+joff]);
+            f[jj+joff] = (crealf(f[jj+joff]) + cimagf(f[jj+joff]))
+                       + (crealf(f[jj+joff])
+                       - cimagf(f[jj+joff]))*_Complex_I;
+         }
+      }
+/* finally transform in x */
+      for (jj = 0; jj < 3; jj++) {
+         cfft1mr(&f[jj+nn],isign,mixup,sct,nxh,2,3,nxhd3,ny);
+      }
+/* swap complex components */
+      for (k = 0; k < ny; k++) {
+         joff = nxhd3*k + nn;
+         for (j = 0; j < nxh; j++) {
+            at1 = crealf(f[2+3*j+joff]);
+            f[2+3*j+joff] = cimagf(f[1+3*j+joff])
+                            + cimagf(f[2+3*j+joff])*_Complex_I;
+            at2 = crealf(f[1+3*j+joff]);
+            f[1+3*j+joff] = at1 + cimagf(f[3*j+joff])*_Complex_I;
+            f[3*j+joff] = crealf(f[3*j+joff]) + at2*_Complex_I;
+         }
+      }
+   }
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cfft3rn3z(float complex f[], int isign, int mixup[],
+               float complex sct[], int nx, int ny, int nz, int nyi,
+               int nyp, int nxhd, int nyd, int nzd, int nxhyzd,
+               int nxyzd) {
+/* this subroutine performs the z part of 3 three dimensional complex to
+   real mixed radix fast fourier transforms and their inverses, for a
+   subset of y, using complex arithmetic
+   for isign = (-1,1), input: all, output: f
+   nx/ny/nz = number of points in x/y/z direction, nx, ny and nz must
+   be even
+   if isign = -1, three inverse fourier transforms are performed
+   f[l][k][j][0:2] = sum(f[i][k][j][0:2]*exp(-sqrt(-1)*2pi*l*i/nz))
+   if isign = 1, three forward fourier transforms are performed
+   f[i][m][n][0:2] = sum(f[l][m][n][0:2]*exp(sqrt(-1)*2pi*l*i/nz))
+   mixup = array of digit reversed addresses, from cwfft3rninit
+   sct = sine/cosine table, from cwfft3rninit
+   nyi = initial y index used
+   nyp = number of y indices used
+   nxhd = second dimension of f >= nx/2
+   nyd,nzd = third and fourth dimensions of f
+   nxhyzd = dimension of mixup >= nx/2 + ny + nz
+   nxyzd = dimension of sct >= nx + ny + nz
+   fourier coefficients are stored as for cfft3r3z
+local data                                                            */
+   int nxh, nyh, nzh, nyt, nxhd3, nxhyd;
+   int n, jj, ll, l1, i0, i1;
+   float complex t1;
+   if (isign==0)
+      return;
+   nxh = nx/2;
+   nyh = ny/2;
+   nzh = nz/2;
+   nyt = nyi + nyp - 1;
+   nxhd3 = 3*nxhd;
+   nxhyd = nxhd3*nyd;
+   if (isign > 0)
+      goto L90;
+/* inverse fourier transform */
+/* finally transform in z */
+   for (n = nyi-1; n < nyt; n++) {
+      cfft1mr(&f[nxhd3*n],isign,&mixup[nxh+ny],&sct[nx+ny],nz,1,nxhyd,
+              1,3*nxh);
+   }
+/* unscramble modes kx = 0, nx/2 */
+   for (n = 1; n < nzh; n++) {
+      ll = nxhyd*n;
+      l1 = nxhyd*nz - ll;
+      if (nyi==1) {
+         for (jj = 0; jj < 3; jj++) {
+            t1 = f[jj+l1];
+            f[jj+l1] = 0.5*(cimagf(f[jj+ll] + t1)
+                          + crealf(f[jj+ll] - t1)*_Complex_I);
+            f[jj+ll] = 0.5*(crealf(f[jj+ll] + t1)
+                          + cimagf(f[jj+ll] - t1)*_Complex_I);
+         }
+      }
+      if ((nyi <= (nyh+1)) && (nyt >= (nyh+1))) {
+         for (jj = 0; jj < 3; jj++) {
+            i1 = nxhd3*nyh;
+            i0 = i1 + ll;
+            i1 += l1;
+            t1 = f[jj+i1];
+            f[jj+i1] = 0.5*(cimagf(f[jj+i0] + t1)
+                        +   crealf(f[jj+i0] - t1)*_Complex_I);
+            f[jj+i0] = 0.5*(crealf(f[jj+i0] + t1)
+                          + cimagf(f[jj+i0] - t1)*_Complex_I);
+         }
+      }
+   }
+   return;
+/* forward fourier transform */
+/* scramble modes kx = 0, nx/2 */
+L90: for (n = 1; n < nzh; n++) {
+      ll = nxhyd*n;
+      l1 = nxhyd*nz - ll;
+      if (nyi==1) {
+         for (jj = 0; jj < 3; jj++) {
+            t1 = cimagf(f[jj+l1]) + crealf(f[jj+l1])*_Complex_I;
+            f[jj+l1] = conjf(f[jj+ll] - t1);
+            f[jj+ll] += t1;
+         }
+      }
+      if ((nyi <= (nyh+1)) && (nyt >= (nyh+1))) {
+         for (jj = 0; jj < 3; jj++) {
+            i1 = nxhd3*nyh;
+            i0 = i1 + ll;
+            i1 += l1;
+            t1 = cimagf(f[jj+i1]) + crealf(f[jj+i1])*_Complex_I;
+            f[jj+i1] = conjf(f[jj+i0] - t1);
+            f[jj+i0] += t1;
+         }
+      }
+   }
+/* first transform in z */
+   for (n = nyi-1; n < nyt; n++) {
+      cfft1mr(&f[nxhd3*n],isign,&mixup[nxh+ny],&sct[nx+ny],nz,1,nxhyd,
+              1,3*nxh);
+   }
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cwfft3rnx(float complex f[], int isign, int mixup[],
+               float complex sct[], int nx, int ny, int nz, int nxhd,
+               int nyd, int nzd, int nxhyzd, int nxyzd) {
+/* wrapper function for real to complex mixed radix fft, with packed */
+/* data */
+/* local data */
+   static int nyi = 1, nzi = 1;
+/* inverse fourier transform */
+   if (isign < 0) {
+/* perform xy fft */
+      cfft3rnxy(f,isign,mixup,sct,nx,ny,nz,nzi,nz,nxhd,nyd,nzd,nxhyzd,
+                nxyzd);
+/* perform z fft */
+      cfft3rnxz(f,isign,mixup,sct,nx,ny,nz,nyi,ny,nxhd,nyd,nzd,nxhyzd,
+                nxyzd);
+   }
+/* forward fourier transform */
+   else if (isign > 0) {
+/* perform z fft */
+      cfft3rnxz(f,isign,mixup,sct,nx,ny,nz,nyi,ny,nxhd,nyd,nzd,nxhyzd,
+                nxyzd);
+/* perform xy fft */
+      cfft3rnxy(f,isign,mixup,sct,nx,ny,nz,nzi,nz,nxhd,nyd,nzd,nxhyzd,
+                nxyzd);
+   }
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cwfft3rn3(float complex f[], int isign, int mixup[],
+               float complex sct[], int nx, int ny, int nz, int nxhd,
+               int nyd, int nzd, int nxhyzd, int nxyzd) {
+/* wrapper function for 3 3d real to complex mixed radix ffts, with */
+/* packed data */
+/* local data */
+   static int nyi = 1, nzi = 1;
+/* inverse fourier transform */
+   if (isign < 0) {
+/* perform xy fft */
+      cfft3rn3xy(f,isign,mixup,sct,nx,ny,nz,nzi,nz,nxhd,nyd,nzd,nxhyzd,
+                 nxyzd);
+/* perform z fft */
+      cfft3rn3z(f,isign,mixup,sct,nx,ny,nz,nyi,ny,nxhd,nyd,nzd,nxhyzd,
+                nxyzd);
+   }
+/* forward fourier transform */
+   else if (isign > 0) {
+/* perform z fft */
+      cfft3rn3z(f,isign,mixup,sct,nx,ny,nz,nyi,ny,nxhd,nyd,nzd,nxhyzd,
+                nxyzd);
+/* perform xy fft */
+      cfft3rn3xy(f,isign,mixup,sct,nx,ny,nz,nzi,nz,nxhd,nyd,nzd,nxhyzd,
+                 nxyzd);
+   }
+   return;
+}
+
 /* Interfaces to Fortran */
 
 /*--------------------------------------------------------------------*/
@@ -2188,3 +3014,28 @@ void cwfft3r3_(float complex *f, int *isign, int *mixup,
    return;
 }
 
+/*--------------------------------------------------------------------*/
+void cwfft3rninit_(int *mixup, float complex *sct, int *nx, int *ny,
+                   int *nz, int *nxhyzd, int *nxyzd) {
+   cwfft3rninit(mixup,sct,*nx,*ny,*nz,*nxhyzd,*nxyzd);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cwfft3rnx_(float complex *f, int *isign, int *mixup,
+                float complex *sct, int *nx, int *ny, int *nz,
+                int *nxhd, int *nyd, int *nzd, int *nxhyzd, int *nxyzd) {
+   cwfft3rnx(f,*isign,mixup,sct,*nx,*ny,*nz,*nxhd,*nyd,*nzd,*nxhyzd,
+             *nxyzd);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cwfft3rn3_(float complex *f, int *isign, int *mixup,
+                float complex *sct, int *nx, int *ny, int *nz,
+                int *nxhd, int *nyd, int *nzd, int *nxhyzd, int *nxyzd) {
+   cwfft3rn3(f,*isign,mixup,sct,*nx,*ny,*nz,*nxhd,*nyd,*nzd,*nxhyzd,
+             *nxyzd);
+   return;
+}
+
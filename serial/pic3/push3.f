@@ -1860,6 +1860,810 @@ c first transform in z
   230 continue
       return
       end
+c-----------------------------------------------------------------------
+      subroutine FFTMRFAC(fac,n,nf)
+c this subroutine factors the length n of a mixed radix fast fourier
+c transform into the radices of the transform stages, in the order in
+c which the stages are performed: radix 4, then 2, 3, 5 and any
+c remaining prime factors, in increasing order
+c input: n, output: fac, nf
+c fac = array of radices, with dimension at least 32
+c n = length of transform
+c nf = number of radices, nf = -1 if n < 1 or if n has a prime factor
+c larger than 127
+      implicit none
+      integer n, nf
+      integer fac
+      dimension fac(32)
+c local data
+      integer l, m, np
+      nf = -1
+      if (n.lt.1) return
+      l = 0
+      m = n
+   10 if (mod(m,4).eq.0) then
+         l = l + 1
+         fac(l) = 4
+         m = m/4
+         go to 10
+      endif
+      np = 2
+   20 if (m.gt.1) then
+         if (mod(m,np).eq.0) then
+            if (np.gt.127) return
+            l = l + 1
+            fac(l) = np
+            m = m/np
+         else if (np.eq.2) then
+            np = 3
+         else
+            np = np + 2
+         endif
+         go to 20
+      endif
+      nf = l
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine FFT1MR(f,isign,mixup,sct,n,nrs,nes,nvs,nvp)
+c this subroutine performs multiple one dimensional mixed radix complex
+c fast fourier transforms of length n, without normalization.
+c element m of vector i is stored in f(1+nes*(m-1)+nvs*(i-1)),
+c where 1 <= i <= nvp
+c the length n may contain any prime factors less than 128, the radix
+c 4, 2, 3 and 5 stages are the fastest, other primes use a direct
+c discrete fourier transform of length equal to the prime.
+c for isign = (-1,1), input: all, output: f
+c if isign = -1, the inverse transform is performed
+c f(m) = sum(f(k)*exp(-sqrt(-1)*2pi*(m-1)*(k-1)/n))
+c if isign = 1, the forward transform is performed
+c f(k) = sum(f(m)*exp(sqrt(-1)*2pi*(m-1)*(k-1)/n))
+c mixup = array of digit reversed addresses, where mixup(j) is the
+c address whose element is moved to address j, negative for the first
+c address of each permutation cycle
+c sct = sine/cosine table, where
+c sct(1+nrs*(j-1)) = exp(-sqrt(-1)*2pi*(j-1)/n)
+c nrs = stride in sct table
+c nes = stride between elements of a vector
+c nvs = stride between vectors
+c nvp = number of vectors
+      implicit none
+      integer isign, n, nrs, nes, nvs, nvp
+      complex f, sct
+      integer mixup
+      dimension f(*), mixup(n), sct(*)
+c local data
+      integer nf, fac
+      integer i, j, k, l, m, q, r, j1, k1, kk, ns, nsp, np, km, kmr
+      integer nrp, joff
+      complex t1, t2, t3, t4, t5, t6, w1, w2, w3, w4, tp
+      dimension fac(32), tp(128)
+      if (isign.eq.0) return
+      call FFTMRFAC(fac,n,nf)
+      if (nf.lt.0) return
+c reorder array elements in digit reversed order, one cycle at a time
+      do 30 j = 1, n
+      if (mixup(j).gt.0) go to 30
+      do 20 i = 1, nvp
+      joff = 1 + nvs*(i - 1)
+      t1 = f(nes*(j-1)+joff)
+      k = j
+      k1 = -mixup(j)
+   10 if (k1.ne.j) then
+         f(nes*(k-1)+joff) = f(nes*(k1-1)+joff)
+         k = k1
+         k1 = mixup(k)
+         go to 10
+      endif
+      f(nes*(k-1)+joff) = t1
+   20 continue
+   30 continue
+c transform stages, combining np transforms of length ns into one
+c transform of length ns*np
+      ns = 1
+      do 150 l = 1, nf
+      np = fac(l)
+      nsp = ns*np
+      km = n/nsp
+      kmr = nrs*km
+      nrp = nrs*(n/np)
+c roots of unity for the butterflies
+      t1 = sct(1+nrp)
+      t2 = t1
+      if (np.gt.2) t2 = sct(1+2*nrp)
+      if (isign.gt.0) then
+         t1 = conjg(t1)
+         t2 = conjg(t2)
+      endif
+      m = nes*ns
+      do 140 k = 1, km
+      k1 = nsp*(k - 1)
+      do 130 j = 1, ns
+      j1 = nes*(j + k1 - 1)
+      w1 = sct(1+kmr*(j-1))
+      w2 = sct(1+2*kmr*(j-1))
+      if (isign.gt.0) then
+         w1 = conjg(w1)
+         w2 = conjg(w2)
+      endif
+c radix 2
+      if (np.eq.2) then
+         do 40 i = 1, nvp
+         joff = j1 + 1 + nvs*(i - 1)
+         t3 = w1*f(m+joff)
+         f(m+joff) = f(joff) - t3
+         f(joff) = f(joff) + t3
+   40    continue
+c radix 4
+      else if (np.eq.4) then
+         w3 = sct(1+3*kmr*(j-1))
+         if (isign.gt.0) w3 = conjg(w3)
+         do 50 i = 1, nvp
+         joff = j1 + 1 + nvs*(i - 1)
+         t3 = w2*f(2*m+joff)
+         t4 = f(joff) - t3
+         t3 = f(joff) + t3
+         t5 = w1*f(m+joff)
+         t6 = w3*f(3*m+joff)
+         w4 = t5 + t6
+         t5 = t1*(t5 - t6)
+         f(joff) = t3 + w4
+         f(m+joff) = t4 + t5
+         f(2*m+joff) = t3 - w4
+         f(3*m+joff) = t4 - t5
+   50    continue
+c radix 3
+      else if (np.eq.3) then
+         do 60 i = 1, nvp
+         joff = j1 + 1 + nvs*(i - 1)
+         t3 = w1*f(m+joff)
+         t4 = w2*f(2*m+joff)
+         w4 = t3 + t4
+         t3 = aimag(t1)*cmplx(aimag(t4-t3),real(t3-t4))
+         t4 = f(joff) + real(t1)*w4
+         f(joff) = f(joff) + w4
+         f(m+joff) = t4 + t3
+         f(2*m+joff) = t4 - t3
+   60    continue
+c radix 5
+      else if (np.eq.5) then
+         w3 = sct(1+3*kmr*(j-1))
+         w4 = sct(1+4*kmr*(j-1))
+         if (isign.gt.0) then
+            w3 = conjg(w3)
+            w4 = conjg(w4)
+         endif
+         do 70 i = 1, nvp
+         joff = j1 + 1 + nvs*(i - 1)
+         tp(2) = w1*f(m+joff)
+         tp(3) = w2*f(2*m+joff)
+         tp(4) = w3*f(3*m+joff)
+         tp(5) = w4*f(4*m+joff)
+         t3 = tp(2) + tp(5)
+         t4 = tp(3) + tp(4)
+         t5 = tp(2) - tp(5)
+         t6 = tp(3) - tp(4)
+         tp(2) = cmplx(-aimag(t5),real(t5))
+         tp(3) = cmplx(-aimag(t6),real(t6))
+         tp(4) = f(joff) + real(t1)*t3 + real(t2)*t4
+         tp(5) = f(joff) + real(t2)*t3 + real(t1)*t4
+         tp(6) = aimag(t1)*tp(2) + aimag(t2)*tp(3)
+         tp(7) = aimag(t2)*tp(2) - aimag(t1)*tp(3)
+         f(joff) = f(joff) + t3 + t4
+         f(m+joff) = tp(4) + tp(6)
+         f(2*m+joff) = tp(5) + tp(7)
+         f(3*m+joff) = tp(5) - tp(7)
+         f(4*m+joff) = tp(4) - tp(6)
+   70    continue
+c other prime radix, direct discrete fourier transform
+      else
+         do 120 i = 1, nvp
+         joff = j1 + 1 + nvs*(i - 1)
+         tp(1) = f(joff)
+         do 80 r = 2, np
+         t3 = sct(1+kmr*(r-1)*(j-1))
+         if (isign.gt.0) t3 = conjg(t3)
+         tp(r) = t3*f(m*(r-1)+joff)
+   80    continue
+         do 110 q = 1, np
+         t3 = tp(1)
+         kk = 0
+         do 100 r = 2, np
+         kk = kk + q - 1
+         if (kk.ge.np) kk = kk - np
+         t4 = sct(1+nrp*kk)
+         if (isign.gt.0) t4 = conjg(t4)
+         t3 = t3 + t4*tp(r)
+  100    continue
+         f(m*(q-1)+joff) = t3
+  110    continue
+  120    continue
+      endif
+  130 continue
+  140 continue
+      ns = nsp
+  150 continue
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine WFFT3RNINIT(mixup,sct,nx,ny,nz,nxhyzd,nxyzd)
+c this subroutine calculates tables needed by a three dimensional
+c real to complex mixed radix fast fourier transform and its inverse,
+c for grids whose sizes need not be powers of 2.
+c input: nx, ny, nz, nxhyzd, nxyzd
+c output: mixup, sct
+c mixup = array of digit reversed addresses, for the x transform of
+c length nx/2 in mixup(1:nx/2), for the y transform of length ny in
+c mixup(nx/2+1:nx/2+ny) and for the z transform of length nz in
+c mixup(nx/2+ny+1:nx/2+ny+nz)
+c sct = sine/cosine table, for the angles 2*n*pi/nx in sct(1:nx),
+c for the angles 2*n*pi/ny in sct(nx+1:nx+ny) and for the angles
+c 2*n*pi/nz in sct(nx+ny+1:nx+ny+nz)
+c nx/ny/nz = number of points in x/y/z direction, nx, ny and nz must
+c be even, and nx/2, ny and nz must not have prime factors larger than
+c 127
+c nxhyzd = dimension of mixup >= nx/2 + ny + nz
+c nxyzd = dimension of sct >= nx + ny + nz
+      implicit none
+      integer nx, ny, nz, nxhyzd, nxyzd
+      integer mixup
+      complex sct
+      dimension mixup(nxhyzd), sct(nxyzd)
+c local data
+      integer nxh, n, nf, moff, soff, fac
+      integer i, j, k, l, m, ll, mr
+      real dnx, arg
+      dimension fac(32)
+      nxh = nx/2
+      do 50 i = 1, 3
+      if (i.eq.1) then
+         n = nxh
+         moff = 0
+      else if (i.eq.2) then
+         n = ny
+         moff = nxh
+      else
+         n = nz
+         moff = nxh + ny
+      endif
+      call FFTMRFAC(fac,n,nf)
+c digit-reverse index table: mixup(j) = 1 + digits of (j - 1) reversed,
+c with the radix of the last transform stage as the leading digit
+      do 20 j = 1, n
+      m = n
+      k = j - 1
+      ll = 0
+      mr = 1
+      do 10 l = nf, 1, -1
+      m = m/fac(l)
+      ll = ll + mr*(k/m)
+      k = k - m*(k/m)
+      mr = mr*fac(l)
+   10 continue
+      mixup(j+moff) = ll + 1
+   20 continue
+c negate the first address of each permutation cycle
+      do 40 j = 1, n
+      k = mixup(j+moff)
+      if (k.eq.j) go to 40
+   30 if (k.gt.j) then
+         k = mixup(k+moff)
+         go to 30
+      endif
+      if (k.eq.j) mixup(j+moff) = -mixup(j+moff)
+   40 continue
+   50 continue
+c sine/cosine table for the angles 2*n*pi/nx, 2*n*pi/ny, 2*n*pi/nz
+      do 70 i = 1, 3
+      if (i.eq.1) then
+         n = nx
+         soff = 0
+      else if (i.eq.2) then
+         n = ny
+         soff = nx
+      else
+         n = nz
+         soff = nx + ny
+      endif
+      dnx = 6.28318530717959/real(n)
+      do 60 j = 1, n
+      arg = dnx*real(j - 1)
+      sct(j+soff) = cmplx(cos(arg),-sin(arg))
+   60 continue
+   70 continue
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine WFFT3RNX(f,isign,mixup,sct,nx,ny,nz,nxhd,nyd,nzd,nxhyzd
+     1,nxyzd)
+c wrapper function for real to complex mixed radix fft
+      implicit none
+      complex f, sct
+      integer mixup
+      integer isign, nx, ny, nz, nxhd, nyd, nzd, nxhyzd, nxyzd
+      dimension f(nxhd,nyd,nzd), mixup(nxhyzd), sct(nxyzd)
+c local data
+      integer nyi, nzi
+      data nyi, nzi /1,1/
+c inverse fourier transform
+      if (isign.lt.0) then
+c perform xy fft
+         call FFT3RNXY(f,isign,mixup,sct,nx,ny,nz,nzi,nz,nxhd,nyd,nzd,
+     1nxhyzd,nxyzd)
+c perform z fft
+         call FFT3RNXZ(f,isign,mixup,sct,nx,ny,nz,nyi,ny,nxhd,nyd,nzd,
+     1nxhyzd,nxyzd)
+c forward fourier transform
+      else if (isign.gt.0) then
+c perform z fft
+         call FFT3RNXZ(f,isign,mixup,sct,nx,ny,nz,nyi,ny,nxhd,nyd,nzd,
+     1nxhyzd,nxyzd)
+c perform xy fft
+         call FFT3RNXY(f,isign,mixup,sct,nx,ny,nz,nzi,nz,nxhd,nyd,nzd,
+     1nxhyzd,nxyzd)
+      endif
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine WFFT3RN3(f,isign,mixup,sct,nx,ny,nz,nxhd,nyd,nzd,nxhyzd
+     1,nxyzd)
+c wrapper function for 3 3d real to complex mixed radix ffts
+      implicit none
+      complex f, sct
+      integer mixup
+      integer isign, nx, ny, nz, nxhd, nyd, nzd, nxhyzd, nxyzd
+      dimension f(3,nxhd,nyd,nzd), mixup(nxhyzd), sct(nxyzd)
+c local data
+      integer nyi, nzi
+      data nyi, nzi /1,1/
+c inverse fourier transform
+      if (isign.lt.0) then
+c perform xy fft
+         call FFT3RN3XY(f,isign,mixup,sct,nx,ny,nz,nzi,nz,nxhd,nyd,nzd,
+     1nxhyzd,nxyzd)
+c perform z fft
+         call FFT3RN3Z(f,isign,mixup,sct,nx,ny,nz,nyi,ny,nxhd,nyd,nzd,
+     1nxhyzd,nxyzd)
+c forward fourier transform
+      else if (isign.gt.0) then
+c perform z fft
+         call FFT3RN3Z(f,isign,mixup,sct,nx,ny,nz,nyi,ny,nxhd,nyd,nzd,
+     1nxhyzd,nxyzd)
+c perform xy fft
+         call FFT3RN3XY(f,isign,mixup,sct,nx,ny,nz,nzi,nz,nxhd,nyd,nzd,
+     1nxhyzd,nxyzd)
+      endif
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine FFT3RNXY(f,isign,mixup,sct,nx,ny,nz,nzi,nzp,nxhd,nyd,nz
+     1d,nxhyzd,nxyzd)
+c this subroutine performs the x-y part of a three dimensional real to
+c complex mixed radix fast fourier transform and its inverse, for a
+c subset of z, using complex arithmetic
+c for isign = (-1,1), input: all, output: f
+c nx/ny/nz = number of points in x/y/z direction, nx, ny and nz must
+c be even
+c if isign = -1, an inverse fourier transform is performed
+c f(n,m,i) = (1/nx*ny*nz)*sum(f(j,k,i)*exp(-sqrt(-1)*2pi*n*j/nx)*
+c       exp(-sqrt(-1)*2pi*m*k/ny))
+c if isign = 1, a forward fourier transform is performed
+c f(j,k,l) = sum(f(n,m,l)*exp(sqrt(-1)*2pi*n*j/nx)*
+c       exp(sqrt(-1)*2pi*m*k/ny))
+c mixup = array of digit reversed addresses, from WFFT3RNINIT
+c sct = sine/cosine table, from WFFT3RNINIT
+c nzi = initial z index used
+c nzp = number of z indices used
+c nxhd = first dimension of f >= nx/2
+c nyd,nzd = second and third dimensions of f
+c nxhyzd = dimension of mixup >= nx/2 + ny + nz
+c nxyzd = dimension of sct >= nx + ny + nz
+c fourier coefficients are stored as for FFT3RXY
+      implicit none
+      integer isign, nx, ny, nz, nzi, nzp, nxhd, nyd, nzd
+      integer nxhyzd, nxyzd
+      complex f, sct
+      integer mixup
+      dimension f(nxhd,nyd,nzd), mixup(nxhyzd), sct(nxyzd)
+c local data
+      integer nxh, nxhh, nxh2, nyh, ny2, nzt, j, k, n
+      real ani
+      complex t1, t2, t3
+      if (isign.eq.0) return
+      nxh = nx/2
+      nxhh = nxh/2
+      nxh2 = nxh + 2
+      nyh = ny/2
+      ny2 = ny + 2
+      nzt = nzi + nzp - 1
+      if (isign.gt.0) go to 80
+c inverse fourier transform
+      ani = 0.5/(real(nx)*real(ny)*real(nz))
+      do 70 n = nzi, nzt
+c first transform in x
+      call FFT1MR(f(1,1,n),isign,mixup,sct,nxh,2,1,nxhd,ny)
+c unscramble coefficients and normalize
+      do 20 j = 2, nxh - nxhh
+      t3 = cmplx(aimag(sct(j)),-real(sct(j)))
+      do 10 k = 1, ny
+      t2 = conjg(f(nxh2-j,k,n))
+      t1 = f(j,k,n) + t2
+      t2 = (f(j,k,n) - t2)*t3
+      f(j,k,n) = ani*(t1 + t2)
+      f(nxh2-j,k,n) = ani*conjg(t1 - t2)
+   10 continue
+   20 continue
+      do 30 k = 1, ny
+      if (nxh.eq.(2*nxhh)) f(nxhh+1,k,n) = 2.0*ani*conjg(f(nxhh+1,k,n))
+      f(1,k,n) = 2.0*ani*cmplx(real(f(1,k,n)) + aimag(f(1,k,n)),
+     1                         real(f(1,k,n)) - aimag(f(1,k,n)))
+   30 continue
+c then transform in y
+      call FFT1MR(f(1,1,n),isign,mixup(nxh+1),sct(nx+1),ny,1,nxhd,1,nxh
+     1)
+c unscramble modes kx = 0, nx/2
+      do 60 k = 2, nyh
+      t1 = f(1,ny2-k,n)
+      f(1,ny2-k,n) = 0.5*cmplx(aimag(f(1,k,n) + t1),
+     1                         real(f(1,k,n) - t1))
+      f(1,k,n) = 0.5*cmplx(real(f(1,k,n) + t1),aimag(f(1,k,n) - t1))
+   60 continue
+   70 continue
+      return
+c forward fourier transform
+   80 do 140 n = nzi, nzt
+c scramble modes kx = 0, nx/2
+      do 90 k = 2, nyh
+      t1 = cmplx(aimag(f(1,ny2-k,n)),real(f(1,ny2-k,n)))
+      f(1,ny2-k,n) = conjg(f(1,k,n) - t1)
+      f(1,k,n) = f(1,k,n) + t1
+   90 continue
+c then transform in y
+      call FFT1MR(f(1,1,n),isign,mixup(nxh+1),sct(nx+1),ny,1,nxhd,1,nxh
+     1)
+c scramble coefficients
+      do 110 j = 2, nxh - nxhh
+      t3 = cmplx(aimag(sct(j)),real(sct(j)))
+      do 100 k = 1, ny
+      t2 = conjg(f(nxh2-j,k,n))
+      t1 = f(j,k,n) + t2
+      t2 = (f(j,k,n) - t2)*t3
+      f(j,k,n) = t1 + t2
+      f(nxh2-j,k,n) = conjg(t1 - t2)
+  100 continue
+  110 continue
+      do 120 k = 1, ny
+      if (nxh.eq.(2*nxhh)) f(nxhh+1,k,n) = 2.0*conjg(f(nxhh+1,k,n))
+      f(1,k,n) = cmplx(real(f(1,k,n)) + aimag(f(1,k,n)),
+     1                 real(f(1,k,n)) - aimag(f(1,k,n)))
+  120 continue
+c finally transform in x
+      call FFT1MR(f(1,1,n),isign,mixup,sct,nxh,2,1,nxhd,ny)
+  140 continue
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine FFT3RNXZ(f,isign,mixup,sct,nx,ny,nz,nyi,nyp,nxhd,nyd,nz
+     1d,nxhyzd,nxyzd)
+c this subroutine performs the z part of a three dimensional real to
+c complex mixed radix fast fourier transform and its inverse, for a
+c subset of y, using complex arithmetic
+c for isign = (-1,1), input: all, output: f
+c nx/ny/nz = number of points in x/y/z direction, nx, ny and nz must
+c be even
+c if isign = -1, an inverse fourier transform is performed
+c f(j,k,l) = sum(f(j,k,i)*exp(-sqrt(-1)*2pi*l*i/nz))
+c if isign = 1, a forward fourier transform is performed
+c f(n,m,i) = sum(f(n,m,l)*exp(sqrt(-1)*2pi*l*i/nz))
+c mixup = array of digit reversed addresses, from WFFT3RNINIT
+c sct = sine/cosine table, from WFFT3RNINIT
+c nyi = initial y index used
+c nyp = number of y indices used
+c nxhd = first dimension of f >= nx/2
+c nyd,nzd = second and third dimensions of f
+c nxhyzd = dimension of mixup >= nx/2 + ny + nz
+c nxyzd = dimension of sct >= nx + ny + nz
+c fourier coefficients are stored as for FFT3RXZ
+      implicit none
+      integer isign, nx, ny, nz, nyi, nyp, nxhd, nyd, nzd
+      integer nxhyzd, nxyzd
+      complex f, sct
+      integer mixup
+      dimension f(nxhd,nyd,nzd), mixup(nxhyzd), sct(nxyzd)
+c local data
+      integer nxh, nyh, nzh, nz2, nyt, n
+      complex t1
+      if (isign.eq.0) return
+      nxh = nx/2
+      nyh = ny/2
+      nzh = nz/2
+      nz2 = nz + 2
+      nyt = nyi + nyp - 1
+      if (isign.gt.0) go to 100
+c inverse fourier transform
+c finally transform in z
+      do 10 n = nyi, nyt
+      call FFT1MR(f(1,n,1),isign,mixup(nxh+ny+1),sct(nx+ny+1),nz,1,nxhd*
+     1nyd,1,nxh)
+   10 continue
+c unscramble modes kx = 0, nx/2
+      do 90 n = 2, nzh
+      if (nyi.eq.1) then
+         t1 = f(1,1,nz2-n)
+         f(1,1,nz2-n) = 0.5*cmplx(aimag(f(1,1,n) + t1),
+     1                            real(f(1,1,n) - t1))
+         f(1,1,n) = 0.5*cmplx(real(f(1,1,n) + t1),aimag(f(1,1,n) - t1))
+      endif
+      if ((nyi.le.nyh+1).and.(nyt.ge.nyh+1)) then
+         t1 = f(1,nyh+1,nz2-n)
+         f(1,nyh+1,nz2-n) = 0.5*cmplx(aimag(f(1,nyh+1,n) + t1),
+     1                                real(f(1,nyh+1,n) - t1))
+         f(1,nyh+1,n) = 0.5*cmplx(real(f(1,nyh+1,n) + t1),
+     1                            aimag(f(1,nyh+1,n) - t1))
+      endif
+   90 continue
+      return
+c forward fourier transform
+c scramble modes kx = 0, nx/2
+  100 do 110 n = 2, nzh
+      if (nyi.eq.1) then
+         t1 = cmplx(aimag(f(1,1,nz2-n)),real(f(1,1,nz2-n)))
+         f(1,1,nz2-n) = conjg(f(1,1,n) - t1)
+         f(1,1,n) = f(1,1,n) + t1
+      endif
+      if ((nyi.le.nyh+1).and.(nyt.ge.nyh+1)) then
+         t1 = cmplx(aimag(f(1,nyh+1,nz2-n)),real(f(1,nyh+1,nz2-n)))
+         f(1,nyh+1,nz2-n) = conjg(f(1,nyh+1,n) - t1)
+         f(1,nyh+1,n) = f(1,nyh+1,n) + t1
+      endif
+  110 continue
+c first transform in z
+      do 120 n = nyi, nyt
+      call FFT1MR(f(1,n,1),isign,mixup(nxh+ny+1),sct(nx+ny+1),nz,1,nxhd*
+     1nyd,1,nxh)
+  120 continue
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine FFT3RN3XY(f,isign,mixup,sct,nx,ny,nz,nzi,nzp,nxhd,nyd,n
+     1zd,nxhyzd,nxyzd)
+c this subroutine performs the x-y part of 3 three dimensional complex
+c to real mixed radix fast fourier transforms and their inverses, for
+c a subset of z, using complex arithmetic
+c for isign = (-1,1), input: all, output: f
+c nx/ny/nz = number of points in x/y/z direction, nx, ny and nz must
+c be even
+c if isign = -1, three inverse fourier transforms are performed
+c f(1:3,n,m,i) = (1/nx*ny*nz)*sum(f(1:3,j,k,i)*
+c       exp(-sqrt(-1)*2pi*n*j/nx)*exp(-sqrt(-1)*2pi*m*k/ny))
+c if isign = 1, three forward fourier transforms are performed
+c f(1:3,j,k,l) = sum(f(1:3,n,m,l)*exp(sqrt(-1)*2pi*n*j/nx)*
+c       exp(sqrt(-1)*2pi*m*k/ny))
+c mixup = array of digit reversed addresses, from WFFT3RNINIT
+c sct = sine/cosine table, from WFFT3RNINIT
+c nzi = initial z index used
+c nzp = number of z indices used
+c nxhd = second dimension of f >= nx/2
+c nyd,nzd = third and fourth dimensions of f
+c nxhyzd = dimension of mixup >= nx/2 + ny + nz
+c nxyzd = dimension of sct >= nx + ny + nz
+c fourier coefficients are stored as for FFT3R3XY
+      implicit none
+      integer isign, nx, ny, nz, nzi, nzp, nxhd, nyd, nzd
+      integer nxhyzd, nxyzd
+      complex f, sct
+      integer mixup
+      dimension f(3,nxhd,nyd,nzd), mixup(nxhyzd), sct(nxyzd)
+c local data
+      integer nxh, nxhh, nxh2, nyh, ny2, nzt, j, k, n, jj
+      real at1, at2, ani
+      complex t1, t2, t3
+      if (isign.eq.0) return
+      nxh = nx/2
+      nxhh = nxh/2
+      nxh2 = nxh + 2
+      nyh = ny/2
+      ny2 = ny + 2
+      nzt = nzi + nzp - 1
+      if (isign.gt.0) go to 140
+c inverse fourier transform
+      ani = 0.5/(real(nx)*real(ny)*real(nz))
+      do 130 n = nzi, nzt
+c swap complex components
+      do 20 k = 1, ny
+      do 10 j = 1, nxh
+      at1 = real(f(3,j,k,n))
+      f(3,j,k,n) = cmplx(real(f(2,j,k,n)),aimag(f(3,j,k,n)))
+      at2 = aimag(f(2,j,k,n))
+      f(2,j,k,n) = cmplx(aimag(f(1,j,k,n)),at1)
+      f(1,j,k,n) = cmplx(real(f(1,j,k,n)),at2)
+   10 continue
+   20 continue
+c first transform in x
+      do 30 jj = 1, 3
+      call FFT1MR(f(jj,1,1,n),isign,mixup,sct,nxh,2,3,3*nxhd,ny)
+   30 continue
+c unscramble coefficients and normalize
+      do 60 j = 2, nxh - nxhh
+      t3 = cmplx(aimag(sct(j)),-real(sct(j)))
+      do 50 k = 1, ny
+      do 40 jj = 1, 3
+      t2 = conjg(f(jj,nxh2-j,k,n))
+      t1 = f(jj,j,k,n) + t2
+      t2 = (f(jj,j,k,n) - t2)*t3
+      f(jj,j,k,n) = ani*(t1 + t2)
+      f(jj,nxh2-j,k,n) = ani*conjg(t1 - t2)
+   40 continue
+   50 continue
+   60 continue
+      do 80 k = 1, ny
+      do 70 jj = 1, 3
+      if (nxh.eq.(2*nxhh)) then
+         f(jj,nxhh+1,k,n) = 2.0*ani*conjg(f(jj,nxhh+1,k,n))
+      endif
+      f(jj,1,k,n) = 2.0*ani*cmplx(real(f(jj,1,k,n)) + aimag(f(jj,1,k,n)
+     1),real(f(jj,1,k,n)) - aimag(f(jj,1,k,n)))
+   70 continue
+   80 continue
+c then transform in y
+      call FFT1MR(f(1,1,1,n),isign,mixup(nxh+1),sct(nx+1),ny,1,3*nxhd,1,
+     13*nxh)
+c unscramble modes kx = 0, nx/2
+      do 120 k = 2, nyh
+      do 110 jj = 1, 3
+      t1 = f(jj,1,ny2-k,n)
+      f(jj,1,ny2-k,n) = 0.5*cmplx(aimag(f(jj,1,k,n) + t1),
+     1                            real(f(jj,1,k,n) - t1))
+      f(jj,1,k,n) = 0.5*cmplx(real(f(jj,1,k,n) + t1),
+     1                        aimag(f(jj,1,k,n) - t1))
+  110 continue
+  120 continue
+  130 continue
+      return
+c forward fourier transform
+  140 do 270 n = nzi, nzt
+c scramble modes kx = 0, nx/2
+      do 160 k = 2, nyh
+      do 150 jj = 1, 3
+      t1 = cmplx(aimag(f(jj,1,ny2-k,n)),real(f(jj,1,ny2-k,n)))
+      f(jj,1,ny2-k,n) = conjg(f(jj,1,k,n) - t1)
+      f(jj,1,k,n) = f(jj,1,k,n) + t1
+  150 continue
+  160 continue
+c then transform in y
+      call FFT1MR(f(1,1,1,n),isign,mixup(nxh+1),sct(nx+1),ny,1,3*nxhd,1,
+     13*nxh)
+c scramble coefficients
+      do 190 j = 2, nxh - nxhh
+      t3 = cmplx(aimag(sct(j)),real(sct(j)))
+      do 180 k = 1, ny
+      do 170 jj = 1, 3
+      t2 = conjg(f(jj,nxh2-j,k,n))
+      t1 = f(jj,j,k,n) + t2
+      t2 = (f(jj,j,k,n) - t2)*t3
+      f(jj,j,k,n) = t1 + t2
+      f(jj,nxh2-j,k,n) = conjg(t1 - t2)
+  170 continue
+  180 continue
+  190 continue
+      do 210 k = 1, ny
+      do 200 jj = 1, 3
+      if (nxh.eq.(2*nxhh)) then
+         f(jj,nxhh+1,k,n) = 2.0*conjg(f(jj,nxhh+1,k,n))
+      endif
+      f(jj,1,k,n) = cmplx(real(f(jj,1,k,n)) + aimag(f(jj,1,k,n)),
+     1                    real(f(jj,1,k,n)) - aimag(f(jj,1,k,n)))
+  200 continue
+  210 continue
+c finally transform in x
+      do 220 jj = 1, 3
+      call FFT1MR(f(jj,1,1,n),isign,mixup,sct,nxh,2,3,3*nxhd,ny)
+  220 continue
+c swap complex components
+      do 240 k = 1, ny
+      do 230 j = 1, nxh
+      at1 = real(f(3,j,k,n))
+      f(3,j,k,n) = cmplx(aimag(f(2,j,k,n)),aimag(f(3,j,k,n)))
+      at2 = real(f(2,j,k,n))
+      f(2,j,k,n) = cmplx(at1,aimag(f(1,j,k,n)))
+      f(1,j,k,n) = cmplx(real(f(1,j,k,n)),at2)
+  230 continue
+  240 continue
+  270 continue
+      return
+      end
+c-----------------------------------------------------------------------
+      subroutine FFT3RN3Z(f,isign,mixup,sct,nx,ny,nz,nyi,nyp,nxhd,nyd,nz
+     1d,nxhyzd,nxyzd)
+c this subroutine performs the z part of 3 three dimensional complex to
+c real mixed radix fast fourier transforms and their inverses, for a
+c subset of y, using complex arithmetic
+c for isign = (-1,1), input: all, output: f
+c nx/ny/nz = number of points in x/y/z direction, nx, ny and nz must
+c be even
+c if isign = -1, three inverse fourier transforms are performed
+c f(1:3,j,k,l) = sum(f(1:3,j,k,i)*exp(-sqrt(-1)*2pi*l*i/nz))
+c if isign = 1, three forward fourier transforms are performed
+c f(1:3,n,m,i) = sum(f(1:3,n,m,l)*exp(sqrt(-1)*2pi*l*i/nz))
+c mixup = array of digit reversed addresses, from WFFT3RNINIT
+c sct = sine/cosine table, from WFFT3RNINIT
+c nyi = initial y index used
+c nyp = number of y indices used
+c nxhd = second dimension of f >= nx/2
+c nyd,nzd = third and fourth dimensions of f
+c nxhyzd = dimension of mixup >= nx/2 + ny + nz
+c nxyzd = dimension of sct >= nx + ny + nz
+c fourier coefficients are stored as for FFT3R3Z
+      implicit none
+      integer isign, nx, ny, nz, nyi, nyp, nxhd, nyd, nzd
+      integer nxhyzd, nxyzd
+      complex f, sct
+      integer mixup
+      dimension f(3,nxhd,nyd,nzd), mixup(nxhyzd), sct(nxyzd)
+c local data
+      integer nxh, nyh, nzh, nz2, nyt, n, jj
+      complex t1
+      if (isign.eq.0) return
+      nxh = nx/2
+      nyh = ny/2
+      nzh = nz/2
+      nz2 = nz + 2
+      nyt = nyi + nyp - 1
+      if (isign.gt.0) go to 120
+c inverse fourier transform
+c finally transform in z
+      do 10 n = nyi, nyt
+      call FFT1MR(f(1,1,n,1),isign,mixup(nxh+ny+1),sct(nx+ny+1),nz,1,3*
+     1nxhd*nyd,1,3*nxh)
+   10 continue
+c unscramble modes kx = 0, nx/2
+      do 110 n = 2, nzh
+      if (nyi.eq.1) then
+         do 90 jj = 1, 3
+         t1 = f(jj,1,1,nz2-n)
+         f(jj,1,1,nz2-n) = 0.5*cmplx(aimag(f(jj,1,1,n) + t1),
+     1                               real(f(jj,1,1,n) - t1))
+         f(jj,1,1,n) = 0.5*cmplx(real(f(jj,1,1,n) + t1),
+     1                           aimag(f(jj,1,1,n) - t1))
+   90    continue
+      endif
+      if ((nyi.le.nyh+1).and.(nyt.ge.nyh+1)) then
+         do 100 jj = 1, 3
+         t1 = f(jj,1,nyh+1,nz2-n)
+         f(jj,1,nyh+1,nz2-n) = 0.5*cmplx(aimag(f(jj,1,nyh+1,n) + t1),
+     1                                  real(f(jj,1,nyh+1,n) - t1))
+         f(jj,1,nyh+1,n) = 0.5*cmplx(real(f(jj,1,nyh+1,n) + t1),
+     1                              aimag(f(jj,1,nyh+1,n) - t1))
+  100    continue
+      endif
+  110 continue
+      return
+c forward fourier transform
+c scramble modes kx = 0, nx/2
+  120 do 150 n = 2, nzh
+      if (nyi.eq.1) then
+         do 130 jj = 1, 3
+         t1 = cmplx(aimag(f(jj,1,1,nz2-n)),real(f(jj,1,1,nz2-n)))
+         f(jj,1,1,nz2-n) = conjg(f(jj,1,1,n) - t1)
+         f(jj,1,1,n) = f(jj,1,1,n) + t1
+  130    continue
+      endif
+      if ((nyi.le.nyh+1).and.(nyt.ge.nyh+1)) then
+         do 140 jj = 1, 3
+         t1 = cmplx(aimag(f(jj,1,nyh+1,nz2-n)),
+     1              real(f(jj,1,nyh+1,nz2-n)))
+         f(jj,1,nyh+1,nz2-n) = conjg(f(jj,1,nyh+1,n) - t1)
+         f(jj,1,nyh+1,n) = f(jj,1,nyh+1,n) + t1
+  140    continue
+      endif
+  150 continue
+c first transform in z
+      do 160 n = nyi, nyt
+      call FFT1MR(f(1,1,n,1),isign,mixup(nxh+ny+1),sct(nx+ny+1),nz,1,3*
+     1nxhd*nyd,1,3*nxh)
+  160 continue
+      return
+      end
 c-----------------------------------------------------------------------
       subroutine GSPOST3L(part,q,qm,nop,idimp,nxv,nyv,nxyzv)
 c for 3d code, this subroutine calculates particle charge density
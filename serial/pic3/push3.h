@@ -59,3 +59,40 @@ void cwfft3rx(float complex f[], int isign, int mixup[],
 void cwfft3r3(float complex f[], int isign, int mixup[],
               float complex sct[], int indx, int indy, int indz,
               int nxhd, int nyd, int nzd, int nxhyzd, int nxyzhd);
+
+void cfftmrfac(int fac[], int n, int *nf);
+
+void cfft1mr(float complex f[], int isign, int mixup[],
+             float complex sct[], int n, int nrs, int nes, int nvs,
+             int nvp);
+
+void cwfft3rninit(int mixup[], float complex sct[], int nx, int ny,
+                  int nz, int nxhyzd, int nxyzd);
+
+void cfft3rnxy(float complex f[], int isign, int mixup[],
+               float complex sct[], int nx, int ny, int nz, int nzi,
+               int nzp, int nxhd, int nyd, int nzd, int nxhyzd,
+               int nxyzd);
+
+void cfft3rnxz(float complex f[], int isign, int mixup[],
+               float complex sct[], int nx, int ny, int nz, int nyi,
+               int nyp, int nxhd, int nyd, int nzd, int nxhyzd,
+               int nxyzd);
+
+void cfft3rn3xy(float complex f[], int isign, int mixup[],
+                float complex sct[], int nx, int ny, int nz, int nzi,
+                int nzp, int nxhd, int nyd, int nzd, int nxhyzd,
+                int nxyzd);
+
+void cfft3rn3z(float complex f[], int isign, int mixup[],
+               float complex sct[], int nx, int ny, int nz, int nyi,
+               int nyp, int nxhd, int nyd, int nzd, int nxhyzd,
+               int nxyzd);
+
+void cwfft3rnx(float complex f[], int isign, int mixup[],
+               float complex sct[], int nx, int ny, int nz, int nxhd,
+               int nyd, int nzd, int nxhyzd, int nxyzd);
+
+void cwfft3rn3(float complex f[], int isign, int mixup[],
+               float complex sct[], int nx, int ny, int nz, int nxhd,
+               int nyd, int nzd, int nxhyzd, int nxyzd);
@@ -65,6 +65,42 @@ void wfft3r3_(float complex *f, int *isign, int *mixup,
               float complex *sct, int *indx, int *indy, int *indz,
               int *nxhd, int *nyd, int *nzd, int *nxhyzd, int *nxyzhd);
 
+void fftmrfac_(int *fac, int *n, int *nf);
+
+void fft1mr_(float complex *f, int *isign, int *mixup, float complex *sct,
+             int *n, int *nrs, int *nes, int *nvs, int *nvp);
+
+void wfft3rninit_(int *mixup, float complex *sct, int *nx, int *ny,
+                  int *nz, int *nxhyzd, int *nxyzd);
+
+void fft3rnxy_(float complex *f, int *isign, int *mixup,
+               float complex *sct, int *nx, int *ny, int *nz, int *nzi,
+               int *nzp, int *nxhd, int *nyd, int *nzd, int *nxhyzd,
+               int *nxyzd);
+
+void fft3rnxz_(float complex *f, int *isign, int *mixup,
+               float complex *sct, int *nx, int *ny, int *nz, int *nyi,
+               int *nyp, int *nxhd, int *nyd, int *nzd, int *nxhyzd,
+               int *nxyzd);
+
+void fft3rn3xy_(float complex *f, int *isign, int *mixup,
+                float complex *sct, int *nx, int *ny, int *nz, int *nzi,
+                int *nzp, int *nxhd, int *nyd, int *nzd, int *nxhyzd,
+                int *nxyzd);
+
+void fft3rn3z_(float complex *f, int *isign, int *mixup,
+               float complex *sct, int *nx, int *ny, int *nz, int *nyi,
+               int *nyp, int *nxhd, int *nyd, int *nzd, int *nxhyzd,
+               int *nxyzd);
+
+void wfft3rnx_(float complex *f, int *isign, int *mixup,
+               float complex *sct, int *nx, int *ny, int *nz, int *nxhd,
+               int *nyd, int *nzd, int *nxhyzd, int *nxyzd);
+
+void wfft3rn3_(float complex *f, int *isign, int *mixup,
+               float complex *sct, int *nx, int *ny, int *nz, int *nxhd,
+               int *nyd, int *nzd, int *nxhyzd, int *nxyzd);
+
 /* Interfaces to C */
 
 double ranorm() {
@@ -196,3 +232,82 @@ void cwfft3r3(float complex f[], int isign, int mixup[],
             &nxhyzd,&nxyzhd);
    return;
 }
+
+/*--------------------------------------------------------------------*/
+void cfftmrfac(int fac[], int n, int *nf) {
+   fftmrfac_(fac,&n,nf);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cfft1mr(float complex f[], int isign, int mixup[],
+             float complex sct[], int n, int nrs, int nes, int nvs,
+             int nvp) {
+   fft1mr_(f,&isign,mixup,sct,&n,&nrs,&nes,&nvs,&nvp);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cwfft3rninit(int mixup[], float complex sct[], int nx, int ny,
+                  int nz, int nxhyzd, int nxyzd) {
+   wfft3rninit_(mixup,sct,&nx,&ny,&nz,&nxhyzd,&nxyzd);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cfft3rnxy(float complex f[], int isign, int mixup[],
+               float complex sct[], int nx, int ny, int nz, int nzi,
+               int nzp, int nxhd, int nyd, int nzd, int nxhyzd,
+               int nxyzd) {
+   fft3rnxy_(f,&isign,mixup,sct,&nx,&ny,&nz,&nzi,&nzp,&nxhd,&nyd,&nzd,
+             &nxhyzd,&nxyzd);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cfft3rnxz(float complex f[], int isign, int mixup[],
+               float complex sct[], int nx, int ny, int nz, int nyi,
+               int nyp, int nxhd, int nyd, int nzd, int nxhyzd,
+               int nxyzd) {
+   fft3rnxz_(f,&isign,mixup,sct,&nx,&ny,&nz,&nyi,&nyp,&nxhd,&nyd,&nzd,
+             &nxhyzd,&nxyzd);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cfft3rn3xy(float complex f[], int isign, int mixup[],
+                float complex sct[], int nx, int ny, int nz, int nzi,
+                int nzp, int nxhd, int nyd, int nzd, int nxhyzd,
+                int nxyzd) {
+   fft3rn3xy_(f,&isign,mixup,sct,&nx,&ny,&nz,&nzi,&nzp,&nxhd,&nyd,&nzd,
+              &nxhyzd,&nxyzd);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cfft3rn3z(float complex f[], int isign, int mixup[],
+               float complex sct[], int nx, int ny, int nz, int nyi,
+               int nyp, int nxhd, int nyd, int nzd, int nxhyzd,
+               int nxyzd) {
+   fft3rn3z_(f,&isign,mixup,sct,&nx,&ny,&nz,&nyi,&nyp,&nxhd,&nyd,&nzd,
+             &nxhyzd,&nxyzd);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cwfft3rnx(float complex f[], int isign, int mixup[],
+               float complex sct[], int nx, int ny, int nz, int nxhd,
+               int nyd, int nzd, int nxhyzd, int nxyzd) {
+   wfft3rnx_(f,&isign,mixup,sct,&nx,&ny,&nz,&nxhd,&nyd,&nzd,&nxhyzd,
+             &nxyzd);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cwfft3rn3(float complex f[], int isign, int mixup[],
+               float complex sct[], int nx, int ny, int nz, int nxhd,
+               int nyd, int nzd, int nxhyzd, int nxyzd) {
+   wfft3rn3_(f,&isign,mixup,sct,&nx,&ny,&nz,&nxhd,&nyd,&nzd,&nxhyzd,
+             &nxyzd);
+   return;
+}
@@ -157,6 +157,106 @@
          complex, dimension(nxyzhd), intent(in) :: sct
          end subroutine
       end interface
+!
+      interface
+         subroutine FFTMRFAC(fac,n,nf)
+         implicit none
+         integer, intent(in) :: n
+         integer, intent(inout) :: nf
+         integer, dimension(32), intent(inout) :: fac
+         end subroutine
+      end interface
+!
+      interface
+         subroutine FFT1MR(f,isign,mixup,sct,n,nrs,nes,nvs,nvp)
+         implicit none
+         integer, intent(in) :: isign, n, nrs, nes, nvs, nvp
+         complex, dimension(*), intent(inout) :: f
+         integer, dimension(n), intent(in) :: mixup
+         complex, dimension(*), intent(in) :: sct
+         end subroutine
+      end interface
+!
+      interface
+         subroutine WFFT3RNINIT(mixup,sct,nx,ny,nz,nxhyzd,nxyzd)
+         implicit none
+         integer, intent(in) :: nx, ny, nz, nxhyzd, nxyzd
+         integer, dimension(nxhyzd), intent(inout) :: mixup
+         complex, dimension(nxyzd), intent(inout) :: sct
+         end subroutine
+      end interface
+!
+      interface
+         subroutine WFFT3RNX(f,isign,mixup,sct,nx,ny,nz,nxhd,nyd,nzd,&
+     &nxhyzd,nxyzd)
+         implicit none
+         integer, intent(in) :: isign, nx, ny, nz, nxhd, nyd, nzd
+         integer, intent(in) :: nxhyzd, nxyzd
+         real, dimension(2*nxhd,nyd,nzd), intent(inout) :: f
+         integer, dimension(nxhyzd), intent(in) :: mixup
+         complex, dimension(nxyzd), intent(in) :: sct
+         end subroutine
+      end interface
+!
+      interface
+         subroutine WFFT3RN3(f,isign,mixup,sct,nx,ny,nz,nxhd,nyd,nzd,&
+     &nxhyzd,nxyzd)
+         implicit none
+         integer, intent(in) :: isign, nx, ny, nz, nxhd, nyd, nzd
+         integer, intent(in) :: nxhyzd, nxyzd
+         real, dimension(3,2*nxhd,nyd,nzd), intent(inout) :: f
+         integer, dimension(nxhyzd), intent(in) :: mixup
+         complex, dimension(nxyzd), intent(in) :: sct
+         end subroutine
+      end interface
+!
+      interface
+         subroutine FFT3RNXY(f,isign,mixup,sct,nx,ny,nz,nzi,nzp,        &
+     &nxhd,nyd,nzd,nxhyzd,nxyzd)
+         implicit none
+         integer, intent(in) :: isign, nx, ny, nz, nzi, nzp
+         integer, intent(in) :: nxhd, nyd, nzd, nxhyzd, nxyzd
+         real, dimension(2*nxhd,nyd,nzd), intent(inout) :: f
+         integer, dimension(nxhyzd), intent(in) :: mixup
+         complex, dimension(nxyzd), intent(in) :: sct
+         end subroutine
+      end interface
+!
+      interface
+         subroutine FFT3RNXZ(f,isign,mixup,sct,nx,ny,nz,nyi,nyp,        &
+     &nxhd,nyd,nzd,nxhyzd,nxyzd)
+         implicit none
+         integer, intent(in) :: isign, nx, ny, nz, nyi, nyp
+         integer, intent(in) :: nxhd, nyd, nzd, nxhyzd, nxyzd
+         real, dimension(2*nxhd,nyd,nzd), intent(inout) :: f
+         integer, dimension(nxhyzd), intent(in) :: mixup
+         complex, dimension(nxyzd), intent(in) :: sct
+         end subroutine
+      end interface
+!
+      interface
+         subroutine FFT3RN3XY(f,isign,mixup,sct,nx,ny,nz,nzi,nzp,       &
+     &nxhd,nyd,nzd,nxhyzd,nxyzd)
+         implicit none
+         integer, intent(in) :: isign, nx, ny, nz, nzi, nzp
+         integer, intent(in) :: nxhd, nyd, nzd, nxhyzd, nxyzd
+         real, dimension(3,2*nxhd,nyd,nzd), intent(inout) :: f
+         integer, dimension(nxhyzd), intent(in) :: mixup
+         complex, dimension(nxyzd), intent(in) :: sct
+         end subroutine
+      end interface
+!
+      interface
+         subroutine FFT3RN3Z(f,isign,mixup,sct,nx,ny,nz,nyi,nyp,        &
+     &nxhd,nyd,nzd,nxhyzd,nxyzd)
+         implicit none
+         integer, intent(in) :: isign, nx, ny, nz, nyi, nyp
+         integer, intent(in) :: nxhd, nyd, nzd, nxhyzd, nxyzd
+         real, dimension(3,2*nxhd,nyd,nzd), intent(inout) :: f
+         integer, dimension(nxhyzd), intent(in) :: mixup
+         complex, dimension(nxyzd), intent(in) :: sct
+         end subroutine
+      end interface
 !
       interface
          function ranorm()
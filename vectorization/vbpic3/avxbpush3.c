@@ -0,0 +1,1176 @@
+/* AVX-512F/AVX2 C Library for Skeleton 3D Electromagnetic Vector PIC */
+/* Code                                                                */
+/* the particle push and current deposit procedures are compiled for   */
+/* both instruction sets, and the best one available on the host is    */
+/* selected at run time with cpuid                                     */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <immintrin.h>
+#include "avxbpush3.h"
+
+/* target attributes for procedures compiled for one instruction set */
+#define AVX512F __attribute__((target("avx512f,fma")))
+#define AVX2 __attribute__((target("avx2,fma")))
+
+/* isa = instruction set found by cavxcheck, -1 if not checked yet */
+static int isa = -1;
+
+/*--------------------------------------------------------------------*/
+int cavxcheck() {
+/* this function determines with cpuid which instruction set is used by
+   the procedures in this library.  the result is saved for later calls
+   returns 2 if AVX-512F is available, 1 if only AVX2 and FMA are
+   available, and 0 if neither is available.  in the last case, the
+   procedures in this library must not be called
+local data                                                            */
+   if (isa < 0) {
+      __builtin_cpu_init();
+      isa = 0;
+      if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+         isa = 1;
+      if (__builtin_cpu_supports("avx512f"))
+         isa = 2;
+   }
+   return isa;
+}
+
+/*--------------------------------------------------------------------*/
+static inline AVX512F __m512 cavx512gint3(float s[], __m512i v_i[],
+                                          __m512 v_amx, __m512 v_amy,
+                                          __m512 v_dyp, __m512 v_dx1,
+                                          __m512 v_amz, __m512 v_dzp) {
+/* interpolate one component of a field for 16 particles from the
+   8 nearest grid points, whose addresses are in v_i             */
+   __m512 a, b;
+   a = _mm512_mul_ps(v_amx,_mm512_i32gather_ps(v_i[0],s,4));
+   a = _mm512_fmadd_ps(v_amy,_mm512_i32gather_ps(v_i[1],s,4),a);
+   a = _mm512_fmadd_ps(v_dyp,_mm512_i32gather_ps(v_i[2],s,4),a);
+   a = _mm512_fmadd_ps(v_dx1,_mm512_i32gather_ps(v_i[3],s,4),a);
+   b = _mm512_mul_ps(v_amx,_mm512_i32gather_ps(v_i[4],s,4));
+   b = _mm512_fmadd_ps(v_amy,_mm512_i32gather_ps(v_i[5],s,4),b);
+   b = _mm512_fmadd_ps(v_dyp,_mm512_i32gather_ps(v_i[6],s,4),b);
+   b = _mm512_fmadd_ps(v_dx1,_mm512_i32gather_ps(v_i[7],s,4),b);
+   return _mm512_fmadd_ps(v_dzp,b,_mm512_mul_ps(v_amz,a));
+}
+
+/*--------------------------------------------------------------------*/
+static inline AVX2 __m256 cavx2gint3(float s[], __m256i v_i[],
+                                     __m256 v_amx, __m256 v_amy,
+                                     __m256 v_dyp, __m256 v_dx1,
+                                     __m256 v_amz, __m256 v_dzp) {
+/* interpolate one component of a field for 8 particles from the
+   8 nearest grid points, whose addresses are in v_i             */
+   __m256 a, b;
+   a = _mm256_mul_ps(v_amx,_mm256_i32gather_ps(s,v_i[0],4));
+   a = _mm256_fmadd_ps(v_amy,_mm256_i32gather_ps(s,v_i[1],4),a);
+   a = _mm256_fmadd_ps(v_dyp,_mm256_i32gather_ps(s,v_i[2],4),a);
+   a = _mm256_fmadd_ps(v_dx1,_mm256_i32gather_ps(s,v_i[3],4),a);
+   b = _mm256_mul_ps(v_amx,_mm256_i32gather_ps(s,v_i[4],4));
+   b = _mm256_fmadd_ps(v_amy,_mm256_i32gather_ps(s,v_i[5],4),b);
+   b = _mm256_fmadd_ps(v_dyp,_mm256_i32gather_ps(s,v_i[6],4),b);
+   b = _mm256_fmadd_ps(v_dx1,_mm256_i32gather_ps(s,v_i[7],4),b);
+   return _mm256_fmadd_ps(v_dzp,b,_mm256_mul_ps(v_amz,a));
+}
+
+/*--------------------------------------------------------------------*/
+static AVX512F void cavx512bpush3lt(float part[], float fxyz[], float bxyz[],
+                                    float qbm, float dt, float dtc, float ci,
+                                    float *ek, int idimp, int nop, int npe,
+                                    int nx, int ny, int nz, int nxv, int nyv,
+                                    int nzv, int ipbc, int lrel) {
+/* AVX-512F version of cgbpush3lt (lrel = 0) and cgrbpush3lt (lrel = 1)
+   particles are processed in blocks of 16, the last block is masked
+local data                                                            */
+#define NV              16
+   int j, nps, nxyv;
+   float qtmh, ci2, edgelx, edgely, edgelz, edgerx, edgery, edgerz;
+   double sum1;
+   __m512i v_nxv4, v_nxyv4, v_nn, v_mm, v_ll;
+   __m512i v_i[8];
+   __m512 v_qtmh, v_ci2, v_dtc, v_one, v_two, v_half, v_zero;
+   __m512 v_edgelx, v_edgely, v_edgelz, v_edgerx, v_edgery, v_edgerz;
+   __m512 v_x, v_y, v_z, v_vx, v_vy, v_vz, v_ux, v_uy, v_uz;
+   __m512 v_dxp, v_dyp, v_dzp, v_amx, v_amy, v_amz, v_dx1;
+   __m512 v_dx, v_dy, v_dz, v_ox, v_oy, v_oz, v_acx, v_acy, v_acz;
+   __m512 v_omxt, v_omyt, v_omzt, v_omt, v_anorm, v_at, v_gami;
+   __m512 v_rot1, v_rot2, v_rot3, v_rot4, v_rot5, v_rot6, v_rot7;
+   __m512 v_rot8, v_rot9;
+   __m512d v_sum1;
+   __mmask16 msk, mskr;
+   nxyv = nxv*nyv;
+   qtmh = 0.5f*qbm*dt;
+   ci2 = ci*ci;
+/* set boundary values */
+   edgelx = 0.0f;
+   edgely = 0.0f;
+   edgelz = 0.0f;
+   edgerx = (float) nx;
+   edgery = (float) ny;
+   edgerz = (float) nz;
+   if (ipbc==2) {
+      edgelx = 1.0f;
+      edgely = 1.0f;
+      edgelz = 1.0f;
+      edgerx = (float) (nx-1);
+      edgery = (float) (ny-1);
+      edgerz = (float) (nz-1);
+   }
+   else if (ipbc==3) {
+      edgelx = 1.0f;
+      edgely = 1.0f;
+      edgerx = (float) (nx-1);
+      edgery = (float) (ny-1);
+   }
+   v_nxv4 = _mm512_set1_epi32(4*nxv);
+   v_nxyv4 = _mm512_set1_epi32(4*nxyv);
+   v_one = _mm512_set1_ps(1.0f);
+   v_zero = _mm512_setzero_ps();
+   v_edgelx = _mm512_set1_ps(edgelx);
+   v_edgely = _mm512_set1_ps(edgely);
+   v_edgelz = _mm512_set1_ps(edgelz);
+   v_edgerx = _mm512_set1_ps(edgerx);
+   v_edgery = _mm512_set1_ps(edgery);
+   v_edgerz = _mm512_set1_ps(edgerz);
+   v_qtmh = _mm512_set1_ps(qtmh);
+   v_ci2 = _mm512_set1_ps(ci2);
+   v_dtc = _mm512_set1_ps(dtc);
+   v_two = _mm512_set1_ps(2.0f);
+   v_half = _mm512_set1_ps(0.5f);
+   v_sum1 = _mm512_setzero_pd();
+/* loop over particles in blocks of 16 */
+   for (j = 0; j < nop; j+=NV) {
+      nps = nop - j;
+      nps = nps < NV ? nps : NV;
+      msk = (__mmask16) ((1 << nps) - 1);
+/* find interpolation weights */
+      v_x = _mm512_maskz_loadu_ps(msk,&part[j]);
+      v_y = _mm512_maskz_loadu_ps(msk,&part[j+npe]);
+      v_z = _mm512_maskz_loadu_ps(msk,&part[j+2*npe]);
+      v_nn = _mm512_cvttps_epi32(v_x);
+      v_mm = _mm512_cvttps_epi32(v_y);
+      v_ll = _mm512_cvttps_epi32(v_z);
+      v_dxp = _mm512_sub_ps(v_x,_mm512_cvtepi32_ps(v_nn));
+      v_dyp = _mm512_sub_ps(v_y,_mm512_cvtepi32_ps(v_mm));
+      v_dzp = _mm512_sub_ps(v_z,_mm512_cvtepi32_ps(v_ll));
+/* nn = 4*(nn + nxv*mm + nxyv*ll) */
+      v_mm = _mm512_mullo_epi32(v_nxv4,v_mm);
+      v_ll = _mm512_mullo_epi32(v_nxyv4,v_ll);
+      v_nn = _mm512_add_epi32(_mm512_slli_epi32(v_nn,2),
+             _mm512_add_epi32(v_mm,v_ll));
+      v_amx = _mm512_sub_ps(v_one,v_dxp);
+      v_amy = _mm512_sub_ps(v_one,v_dyp);
+      v_dx1 = _mm512_mul_ps(v_dxp,v_dyp);
+      v_dyp = _mm512_mul_ps(v_amx,v_dyp);
+      v_amx = _mm512_mul_ps(v_amx,v_amy);
+      v_amz = _mm512_sub_ps(v_one,v_dzp);
+      v_amy = _mm512_mul_ps(v_dxp,v_amy);
+      v_i[0] = v_nn;
+      v_i[1] = _mm512_add_epi32(v_i[0],_mm512_set1_epi32(4));
+      v_i[2] = _mm512_add_epi32(v_i[0],v_nxv4);
+      v_i[3] = _mm512_add_epi32(v_i[2],_mm512_set1_epi32(4));
+      v_i[4] = _mm512_add_epi32(v_i[0],v_nxyv4);
+      v_i[5] = _mm512_add_epi32(v_i[1],v_nxyv4);
+      v_i[6] = _mm512_add_epi32(v_i[2],v_nxyv4);
+      v_i[7] = _mm512_add_epi32(v_i[3],v_nxyv4);
+/* find electric field */
+      v_dx = cavx512gint3(&fxyz[0],v_i,v_amx,v_amy,v_dyp,v_dx1,
+                          v_amz,v_dzp);
+      v_dy = cavx512gint3(&fxyz[1],v_i,v_amx,v_amy,v_dyp,v_dx1,
+                          v_amz,v_dzp);
+      v_dz = cavx512gint3(&fxyz[2],v_i,v_amx,v_amy,v_dyp,v_dx1,
+                          v_amz,v_dzp);
+/* find magnetic field */
+      v_ox = cavx512gint3(&bxyz[0],v_i,v_amx,v_amy,v_dyp,v_dx1,
+                          v_amz,v_dzp);
+      v_oy = cavx512gint3(&bxyz[1],v_i,v_amx,v_amy,v_dyp,v_dx1,
+                          v_amz,v_dzp);
+      v_oz = cavx512gint3(&bxyz[2],v_i,v_amx,v_amy,v_dyp,v_dx1,
+                          v_amz,v_dzp);
+/* calculate half impulse */
+      v_dx = _mm512_mul_ps(v_dx,v_qtmh);
+      v_dy = _mm512_mul_ps(v_dy,v_qtmh);
+      v_dz = _mm512_mul_ps(v_dz,v_qtmh);
+/* half acceleration */
+      v_ux = _mm512_maskz_loadu_ps(msk,&part[j+3*npe]);
+      v_uy = _mm512_maskz_loadu_ps(msk,&part[j+4*npe]);
+      v_uz = _mm512_maskz_loadu_ps(msk,&part[j+5*npe]);
+      v_acx = _mm512_add_ps(v_ux,v_dx);
+      v_acy = _mm512_add_ps(v_uy,v_dy);
+      v_acz = _mm512_add_ps(v_uz,v_dz);
+      v_at = _mm512_mul_ps(v_acx,v_acx);
+      v_at = _mm512_fmadd_ps(v_acy,v_acy,v_at);
+      v_at = _mm512_fmadd_ps(v_acz,v_acz,v_at);
+      if (lrel) {
+/* find inverse gamma */
+         v_gami = _mm512_div_ps(v_one,_mm512_sqrt_ps(_mm512_fmadd_ps(
+                  v_at,v_ci2,v_one)));
+/* time-centered kinetic energy */
+         v_at = _mm512_div_ps(_mm512_mul_ps(v_gami,v_at),
+                _mm512_add_ps(v_one,v_gami));
+/* renormalize magnetic field */
+         v_omt = _mm512_mul_ps(v_qtmh,v_gami);
+      }
+      else {
+         v_omt = v_qtmh;
+      }
+/* time-centered kinetic energy, inactive lanes are zeroed */
+      v_at = _mm512_maskz_mov_ps(msk,v_at);
+      v_sum1 = _mm512_add_pd(v_sum1,_mm512_cvtps_pd(
+               _mm512_castps512_ps256(v_at)));
+      v_sum1 = _mm512_add_pd(v_sum1,_mm512_cvtps_pd(_mm256_castpd_ps(
+               _mm512_extractf64x4_pd(_mm512_castps_pd(v_at),1))));
+/* calculate cyclotron frequency */
+      v_omxt = _mm512_mul_ps(v_omt,v_ox);
+      v_omyt = _mm512_mul_ps(v_omt,v_oy);
+      v_omzt = _mm512_mul_ps(v_omt,v_oz);
+/* calculate rotation matrix */
+      v_omt = _mm512_mul_ps(v_omxt,v_omxt);
+      v_omt = _mm512_fmadd_ps(v_omyt,v_omyt,v_omt);
+      v_omt = _mm512_fmadd_ps(v_omzt,v_omzt,v_omt);
+      v_anorm = _mm512_div_ps(v_two,_mm512_add_ps(v_one,v_omt));
+      v_omt = _mm512_mul_ps(v_half,_mm512_sub_ps(v_one,v_omt));
+      v_rot4 = _mm512_mul_ps(v_omxt,v_omyt);
+      v_rot7 = _mm512_mul_ps(v_omxt,v_omzt);
+      v_rot8 = _mm512_mul_ps(v_omyt,v_omzt);
+      v_rot1 = _mm512_fmadd_ps(v_omxt,v_omxt,v_omt);
+      v_rot5 = _mm512_fmadd_ps(v_omyt,v_omyt,v_omt);
+      v_rot9 = _mm512_fmadd_ps(v_omzt,v_omzt,v_omt);
+      v_rot2 = _mm512_add_ps(v_omzt,v_rot4);
+      v_rot4 = _mm512_sub_ps(v_rot4,v_omzt);
+      v_rot3 = _mm512_sub_ps(v_rot7,v_omyt);
+      v_rot7 = _mm512_add_ps(v_rot7,v_omyt);
+      v_rot6 = _mm512_add_ps(v_omxt,v_rot8);
+      v_rot8 = _mm512_sub_ps(v_rot8,v_omxt);
+/* new velocity */
+      v_vx = _mm512_mul_ps(v_rot1,v_acx);
+      v_vx = _mm512_fmadd_ps(v_rot2,v_acy,v_vx);
+      v_vx = _mm512_fmadd_ps(v_rot3,v_acz,v_vx);
+      v_vx = _mm512_fmadd_ps(v_vx,v_anorm,v_dx);
+      v_vy = _mm512_mul_ps(v_rot4,v_acx);
+      v_vy = _mm512_fmadd_ps(v_rot5,v_acy,v_vy);
+      v_vy = _mm512_fmadd_ps(v_rot6,v_acz,v_vy);
+      v_vy = _mm512_fmadd_ps(v_vy,v_anorm,v_dy);
+      v_vz = _mm512_mul_ps(v_rot7,v_acx);
+      v_vz = _mm512_fmadd_ps(v_rot8,v_acy,v_vz);
+      v_vz = _mm512_fmadd_ps(v_rot9,v_acz,v_vz);
+      v_vz = _mm512_fmadd_ps(v_vz,v_anorm,v_dz);
+/* update inverse gamma */
+      if (lrel) {
+         v_at = _mm512_mul_ps(v_vx,v_vx);
+         v_at = _mm512_fmadd_ps(v_vy,v_vy,v_at);
+         v_at = _mm512_fmadd_ps(v_vz,v_vz,v_at);
+         v_at = _mm512_div_ps(v_dtc,_mm512_sqrt_ps(_mm512_fmadd_ps(
+                v_at,v_ci2,v_one)));
+      }
+      else {
+         v_at = v_dtc;
+      }
+/* new position */
+      v_dx = _mm512_fmadd_ps(v_vx,v_at,v_x);
+      v_dy = _mm512_fmadd_ps(v_vy,v_at,v_y);
+      v_dz = _mm512_fmadd_ps(v_vz,v_at,v_z);
+/* periodic boundary conditions */
+      if (ipbc==1) {
+         mskr = _mm512_cmp_ps_mask(v_dx,v_edgelx,_CMP_LT_OQ);
+         v_dx = _mm512_mask_add_ps(v_dx,mskr,v_dx,v_edgerx);
+         mskr = _mm512_cmp_ps_mask(v_dx,v_edgerx,_CMP_GE_OQ);
+         v_dx = _mm512_mask_sub_ps(v_dx,mskr,v_dx,v_edgerx);
+         mskr = _mm512_cmp_ps_mask(v_dy,v_edgely,_CMP_LT_OQ);
+         v_dy = _mm512_mask_add_ps(v_dy,mskr,v_dy,v_edgery);
+         mskr = _mm512_cmp_ps_mask(v_dy,v_edgery,_CMP_GE_OQ);
+         v_dy = _mm512_mask_sub_ps(v_dy,mskr,v_dy,v_edgery);
+         mskr = _mm512_cmp_ps_mask(v_dz,v_edgelz,_CMP_LT_OQ);
+         v_dz = _mm512_mask_add_ps(v_dz,mskr,v_dz,v_edgerz);
+         mskr = _mm512_cmp_ps_mask(v_dz,v_edgerz,_CMP_GE_OQ);
+         v_dz = _mm512_mask_sub_ps(v_dz,mskr,v_dz,v_edgerz);
+      }
+/* reflecting boundary conditions */
+      else if (ipbc==2) {
+         mskr = _mm512_cmp_ps_mask(v_dx,v_edgelx,_CMP_LT_OQ)
+              | _mm512_cmp_ps_mask(v_dx,v_edgerx,_CMP_GE_OQ);
+         v_dx = _mm512_mask_blend_ps(mskr,v_dx,v_x);
+         v_vx = _mm512_mask_sub_ps(v_vx,mskr,v_zero,v_vx);
+         mskr = _mm512_cmp_ps_mask(v_dy,v_edgely,_CMP_LT_OQ)
+              | _mm512_cmp_ps_mask(v_dy,v_edgery,_CMP_GE_OQ);
+         v_dy = _mm512_mask_blend_ps(mskr,v_dy,v_y);
+         v_vy = _mm512_mask_sub_ps(v_vy,mskr,v_zero,v_vy);
+         mskr = _mm512_cmp_ps_mask(v_dz,v_edgelz,_CMP_LT_OQ)
+              | _mm512_cmp_ps_mask(v_dz,v_edgerz,_CMP_GE_OQ);
+         v_dz = _mm512_mask_blend_ps(mskr,v_dz,v_z);
+         v_vz = _mm512_mask_sub_ps(v_vz,mskr,v_zero,v_vz);
+      }
+/* mixed reflecting/periodic boundary conditions */
+      else if (ipbc==3) {
+         mskr = _mm512_cmp_ps_mask(v_dx,v_edgelx,_CMP_LT_OQ)
+              | _mm512_cmp_ps_mask(v_dx,v_edgerx,_CMP_GE_OQ);
+         v_dx = _mm512_mask_blend_ps(mskr,v_dx,v_x);
+         v_vx = _mm512_mask_sub_ps(v_vx,mskr,v_zero,v_vx);
+         mskr = _mm512_cmp_ps_mask(v_dy,v_edgely,_CMP_LT_OQ)
+              | _mm512_cmp_ps_mask(v_dy,v_edgery,_CMP_GE_OQ);
+         v_dy = _mm512_mask_blend_ps(mskr,v_dy,v_y);
+         v_vy = _mm512_mask_sub_ps(v_vy,mskr,v_zero,v_vy);
+         mskr = _mm512_cmp_ps_mask(v_dz,v_edgelz,_CMP_LT_OQ);
+         v_dz = _mm512_mask_add_ps(v_dz,mskr,v_dz,v_edgerz);
+         mskr = _mm512_cmp_ps_mask(v_dz,v_edgerz,_CMP_GE_OQ);
+         v_dz = _mm512_mask_sub_ps(v_dz,mskr,v_dz,v_edgerz);
+      }
+/* set new position */
+      _mm512_mask_storeu_ps(&part[j],msk,v_dx);
+      _mm512_mask_storeu_ps(&part[j+npe],msk,v_dy);
+      _mm512_mask_storeu_ps(&part[j+2*npe],msk,v_dz);
+/* set new velocity */
+      _mm512_mask_storeu_ps(&part[j+3*npe],msk,v_vx);
+      _mm512_mask_storeu_ps(&part[j+4*npe],msk,v_vy);
+      _mm512_mask_storeu_ps(&part[j+5*npe],msk,v_vz);
+   }
+   sum1 = _mm512_reduce_add_pd(v_sum1);
+/* normalize kinetic energy */
+   if (lrel)
+      *ek += sum1;
+   else
+      *ek += 0.5f*sum1;
+   return;
+#undef NV
+}
+
+/*--------------------------------------------------------------------*/
+static AVX2 void cavx2bpush3lt(float part[], float fxyz[], float bxyz[],
+                               float qbm, float dt, float dtc, float ci,
+                               float *ek, int idimp, int nop, int npe,
+                               int nx, int ny, int nz, int nxv, int nyv,
+                               int nzv, int ipbc, int lrel) {
+/* AVX2 version of cgbpush3lt (lrel = 0) and cgrbpush3lt (lrel = 1)
+   particles are processed in blocks of 8, the last block is masked
+local data                                                            */
+#define NV              8
+   int j, nps, nxyv;
+   float qtmh, ci2, edgelx, edgely, edgelz, edgerx, edgery, edgerz;
+   double sum1;
+   __m256i v_nxv4, v_nxyv4, v_nn, v_mm, v_ll;
+   __m256i v_i[8];
+   __m256 v_qtmh, v_ci2, v_dtc, v_one, v_two, v_half, v_zero;
+   __m256 v_edgelx, v_edgely, v_edgelz, v_edgerx, v_edgery, v_edgerz;
+   __m256 v_x, v_y, v_z, v_vx, v_vy, v_vz, v_ux, v_uy, v_uz;
+   __m256 v_dxp, v_dyp, v_dzp, v_amx, v_amy, v_amz, v_dx1;
+   __m256 v_dx, v_dy, v_dz, v_ox, v_oy, v_oz, v_acx, v_acy, v_acz;
+   __m256 v_omxt, v_omyt, v_omzt, v_omt, v_anorm, v_at, v_gami;
+   __m256 v_rot1, v_rot2, v_rot3, v_rot4, v_rot5, v_rot6, v_rot7;
+   __m256 v_rot8, v_rot9;
+   __m256d v_sum1;
+   __m256i v_it, v_msk;
+   __m256 v_ms;
+   double dd[4];
+   nxyv = nxv*nyv;
+   qtmh = 0.5f*qbm*dt;
+   ci2 = ci*ci;
+/* set boundary values */
+   edgelx = 0.0f;
+   edgely = 0.0f;
+   edgelz = 0.0f;
+   edgerx = (float) nx;
+   edgery = (float) ny;
+   edgerz = (float) nz;
+   if (ipbc==2) {
+      edgelx = 1.0f;
+      edgely = 1.0f;
+      edgelz = 1.0f;
+      edgerx = (float) (nx-1);
+      edgery = (float) (ny-1);
+      edgerz = (float) (nz-1);
+   }
+   else if (ipbc==3) {
+      edgelx = 1.0f;
+      edgely = 1.0f;
+      edgerx = (float) (nx-1);
+      edgery = (float) (ny-1);
+   }
+   v_it = _mm256_setr_epi32(0,1,2,3,4,5,6,7);
+   v_nxv4 = _mm256_set1_epi32(4*nxv);
+   v_nxyv4 = _mm256_set1_epi32(4*nxyv);
+   v_one = _mm256_set1_ps(1.0f);
+   v_zero = _mm256_setzero_ps();
+   v_edgelx = _mm256_set1_ps(edgelx);
+   v_edgely = _mm256_set1_ps(edgely);
+   v_edgelz = _mm256_set1_ps(edgelz);
+   v_edgerx = _mm256_set1_ps(edgerx);
+   v_edgery = _mm256_set1_ps(edgery);
+   v_edgerz = _mm256_set1_ps(edgerz);
+   v_qtmh = _mm256_set1_ps(qtmh);
+   v_ci2 = _mm256_set1_ps(ci2);
+   v_dtc = _mm256_set1_ps(dtc);
+   v_two = _mm256_set1_ps(2.0f);
+   v_half = _mm256_set1_ps(0.5f);
+   v_sum1 = _mm256_setzero_pd();
+/* loop over particles in blocks of 8 */
+   for (j = 0; j < nop; j+=NV) {
+      nps = nop - j;
+      nps = nps < NV ? nps : NV;
+      v_msk = _mm256_cmpgt_epi32(_mm256_set1_epi32(nps),v_it);
+      v_ms = _mm256_castsi256_ps(v_msk);
+/* find interpolation weights */
+      v_x = _mm256_maskload_ps(&part[j],v_msk);
+      v_y = _mm256_maskload_ps(&part[j+npe],v_msk);
+      v_z = _mm256_maskload_ps(&part[j+2*npe],v_msk);
+      v_nn = _mm256_cvttps_epi32(v_x);
+      v_mm = _mm256_cvttps_epi32(v_y);
+      v_ll = _mm256_cvttps_epi32(v_z);
+      v_dxp = _mm256_sub_ps(v_x,_mm256_cvtepi32_ps(v_nn));
+      v_dyp = _mm256_sub_ps(v_y,_mm256_cvtepi32_ps(v_mm));
+      v_dzp = _mm256_sub_ps(v_z,_mm256_cvtepi32_ps(v_ll));
+/* nn = 4*(nn + nxv*mm + nxyv*ll) */
+      v_mm = _mm256_mullo_epi32(v_nxv4,v_mm);
+      v_ll = _mm256_mullo_epi32(v_nxyv4,v_ll);
+      v_nn = _mm256_add_epi32(_mm256_slli_epi32(v_nn,2),
+             _mm256_add_epi32(v_mm,v_ll));
+      v_amx = _mm256_sub_ps(v_one,v_dxp);
+      v_amy = _mm256_sub_ps(v_one,v_dyp);
+      v_dx1 = _mm256_mul_ps(v_dxp,v_dyp);
+      v_dyp = _mm256_mul_ps(v_amx,v_dyp);
+      v_amx = _mm256_mul_ps(v_amx,v_amy);
+      v_amz = _mm256_sub_ps(v_one,v_dzp);
+      v_amy = _mm256_mul_ps(v_dxp,v_amy);
+      v_i[0] = v_nn;
+      v_i[1] = _mm256_add_epi32(v_i[0],_mm256_set1_epi32(4));
+      v_i[2] = _mm256_add_epi32(v_i[0],v_nxv4);
+      v_i[3] = _mm256_add_epi32(v_i[2],_mm256_set1_epi32(4));
+      v_i[4] = _mm256_add_epi32(v_i[0],v_nxyv4);
+      v_i[5] = _mm256_add_epi32(v_i[1],v_nxyv4);
+      v_i[6] = _mm256_add_epi32(v_i[2],v_nxyv4);
+      v_i[7] = _mm256_add_epi32(v_i[3],v_nxyv4);
+/* find electric field */
+      v_dx = cavx2gint3(&fxyz[0],v_i,v_amx,v_amy,v_dyp,v_dx1,
+                        v_amz,v_dzp);
+      v_dy = cavx2gint3(&fxyz[1],v_i,v_amx,v_amy,v_dyp,v_dx1,
+                        v_amz,v_dzp);
+      v_dz = cavx2gint3(&fxyz[2],v_i,v_amx,v_amy,v_dyp,v_dx1,
+                        v_amz,v_dzp);
+/* find magnetic field */
+      v_ox = cavx2gint3(&bxyz[0],v_i,v_amx,v_amy,v_dyp,v_dx1,
+                        v_amz,v_dzp);
+      v_oy = cavx2gint3(&bxyz[1],v_i,v_amx,v_amy,v_dyp,v_dx1,
+                        v_amz,v_dzp);
+      v_oz = cavx2gint3(&bxyz[2],v_i,v_amx,v_amy,v_dyp,v_dx1,
+                        v_amz,v_dzp);
+/* calculate half impulse */
+      v_dx = _mm256_mul_ps(v_dx,v_qtmh);
+      v_dy = _mm256_mul_ps(v_dy,v_qtmh);
+      v_dz = _mm256_mul_ps(v_dz,v_qtmh);
+/* half acceleration */
+      v_ux = _mm256_maskload_ps(&part[j+3*npe],v_msk);
+      v_uy = _mm256_maskload_ps(&part[j+4*npe],v_msk);
+      v_uz = _mm256_maskload_ps(&part[j+5*npe],v_msk);
+      v_acx = _mm256_add_ps(v_ux,v_dx);
+      v_acy = _mm256_add_ps(v_uy,v_dy);
+      v_acz = _mm256_add_ps(v_uz,v_dz);
+      v_at = _mm256_mul_ps(v_acx,v_acx);
+      v_at = _mm256_fmadd_ps(v_acy,v_acy,v_at);
+      v_at = _mm256_fmadd_ps(v_acz,v_acz,v_at);
+      if (lrel) {
+/* find inverse gamma */
+         v_gami = _mm256_div_ps(v_one,_mm256_sqrt_ps(_mm256_fmadd_ps(
+                  v_at,v_ci2,v_one)));
+/* time-centered kinetic energy */
+         v_at = _mm256_div_ps(_mm256_mul_ps(v_gami,v_at),
+                _mm256_add_ps(v_one,v_gami));
+/* renormalize magnetic field */
+         v_omt = _mm256_mul_ps(v_qtmh,v_gami);
+      }
+      else {
+         v_omt = v_qtmh;
+      }
+/* time-centered kinetic energy, inactive lanes are zeroed */
+      v_at = _mm256_and_ps(v_at,v_ms);
+      v_sum1 = _mm256_add_pd(v_sum1,_mm256_cvtps_pd(
+               _mm256_castps256_ps128(v_at)));
+      v_sum1 = _mm256_add_pd(v_sum1,_mm256_cvtps_pd(
+               _mm256_extractf128_ps(v_at,1)));
+/* calculate cyclotron frequency */
+      v_omxt = _mm256_mul_ps(v_omt,v_ox);
+      v_omyt = _mm256_mul_ps(v_omt,v_oy);
+      v_omzt = _mm256_mul_ps(v_omt,v_oz);
+/* calculate rotation matrix */
+      v_omt = _mm256_mul_ps(v_omxt,v_omxt);
+      v_omt = _mm256_fmadd_ps(v_omyt,v_omyt,v_omt);
+      v_omt = _mm256_fmadd_ps(v_omzt,v_omzt,v_omt);
+      v_anorm = _mm256_div_ps(v_two,_mm256_add_ps(v_one,v_omt));
+      v_omt = _mm256_mul_ps(v_half,_mm256_sub_ps(v_one,v_omt));
+      v_rot4 = _mm256_mul_ps(v_omxt,v_omyt);
+      v_rot7 = _mm256_mul_ps(v_omxt,v_omzt);
+      v_rot8 = _mm256_mul_ps(v_omyt,v_omzt);
+      v_rot1 = _mm256_fmadd_ps(v_omxt,v_omxt,v_omt);
+      v_rot5 = _mm256_fmadd_ps(v_omyt,v_omyt,v_omt);
+      v_rot9 = _mm256_fmadd_ps(v_omzt,v_omzt,v_omt);
+      v_rot2 = _mm256_add_ps(v_omzt,v_rot4);
+      v_rot4 = _mm256_sub_ps(v_rot4,v_omzt);
+      v_rot3 = _mm256_sub_ps(v_rot7,v_omyt);
+      v_rot7 = _mm256_add_ps(v_rot7,v_omyt);
+      v_rot6 = _mm256_add_ps(v_omxt,v_rot8);
+      v_rot8 = _mm256_sub_ps(v_rot8,v_omxt);
+/* new velocity */
+      v_vx = _mm256_mul_ps(v_rot1,v_acx);
+      v_vx = _mm256_fmadd_ps(v_rot2,v_acy,v_vx);
+      v_vx = _mm256_fmadd_ps(v_rot3,v_acz,v_vx);
+      v_vx = _mm256_fmadd_ps(v_vx,v_anorm,v_dx);
+      v_vy = _mm256_mul_ps(v_rot4,v_acx);
+      v_vy = _mm256_fmadd_ps(v_rot5,v_acy,v_vy);
+      v_vy = _mm256_fmadd_ps(v_rot6,v_acz,v_vy);
+      v_vy = _mm256_fmadd_ps(v_vy,v_anorm,v_dy);
+      v_vz = _mm256_mul_ps(v_rot7,v_acx);
+      v_vz = _mm256_fmadd_ps(v_rot8,v_acy,v_vz);
+      v_vz = _mm256_fmadd_ps(v_rot9,v_acz,v_vz);
+      v_vz = _mm256_fmadd_ps(v_vz,v_anorm,v_dz);
+/* update inverse gamma */
+      if (lrel) {
+         v_at = _mm256_mul_ps(v_vx,v_vx);
+         v_at = _mm256_fmadd_ps(v_vy,v_vy,v_at);
+         v_at = _mm256_fmadd_ps(v_vz,v_vz,v_at);
+         v_at = _mm256_div_ps(v_dtc,_mm256_sqrt_ps(_mm256_fmadd_ps(
+                v_at,v_ci2,v_one)));
+      }
+      else {
+         v_at = v_dtc;
+      }
+/* new position */
+      v_dx = _mm256_fmadd_ps(v_vx,v_at,v_x);
+      v_dy = _mm256_fmadd_ps(v_vy,v_at,v_y);
+      v_dz = _mm256_fmadd_ps(v_vz,v_at,v_z);
+/* periodic boundary conditions */
+      if (ipbc==1) {
+         v_dx = _mm256_blendv_ps(v_dx,_mm256_add_ps(v_dx,v_edgerx),
+                _mm256_cmp_ps(v_dx,v_edgelx,_CMP_LT_OQ));
+         v_dx = _mm256_blendv_ps(v_dx,_mm256_sub_ps(v_dx,v_edgerx),
+                _mm256_cmp_ps(v_dx,v_edgerx,_CMP_GE_OQ));
+         v_dy = _mm256_blendv_ps(v_dy,_mm256_add_ps(v_dy,v_edgery),
+                _mm256_cmp_ps(v_dy,v_edgely,_CMP_LT_OQ));
+         v_dy = _mm256_blendv_ps(v_dy,_mm256_sub_ps(v_dy,v_edgery),
+                _mm256_cmp_ps(v_dy,v_edgery,_CMP_GE_OQ));
+         v_dz = _mm256_blendv_ps(v_dz,_mm256_add_ps(v_dz,v_edgerz),
+                _mm256_cmp_ps(v_dz,v_edgelz,_CMP_LT_OQ));
+         v_dz = _mm256_blendv_ps(v_dz,_mm256_sub_ps(v_dz,v_edgerz),
+                _mm256_cmp_ps(v_dz,v_edgerz,_CMP_GE_OQ));
+      }
+/* reflecting boundary conditions */
+      else if (ipbc==2) {
+         v_at = _mm256_or_ps(_mm256_cmp_ps(v_dx,v_edgelx,_CMP_LT_OQ),
+                _mm256_cmp_ps(v_dx,v_edgerx,_CMP_GE_OQ));
+         v_dx = _mm256_blendv_ps(v_dx,v_x,v_at);
+         v_vx = _mm256_blendv_ps(v_vx,_mm256_sub_ps(v_zero,v_vx),v_at);
+         v_at = _mm256_or_ps(_mm256_cmp_ps(v_dy,v_edgely,_CMP_LT_OQ),
+                _mm256_cmp_ps(v_dy,v_edgery,_CMP_GE_OQ));
+         v_dy = _mm256_blendv_ps(v_dy,v_y,v_at);
+         v_vy = _mm256_blendv_ps(v_vy,_mm256_sub_ps(v_zero,v_vy),v_at);
+         v_at = _mm256_or_ps(_mm256_cmp_ps(v_dz,v_edgelz,_CMP_LT_OQ),
+                _mm256_cmp_ps(v_dz,v_edgerz,_CMP_GE_OQ));
+         v_dz = _mm256_blendv_ps(v_dz,v_z,v_at);
+         v_vz = _mm256_blendv_ps(v_vz,_mm256_sub_ps(v_zero,v_vz),v_at);
+      }
+/* mixed reflecting/periodic boundary conditions */
+      else if (ipbc==3) {
+         v_at = _mm256_or_ps(_mm256_cmp_ps(v_dx,v_edgelx,_CMP_LT_OQ),
+                _mm256_cmp_ps(v_dx,v_edgerx,_CMP_GE_OQ));
+         v_dx = _mm256_blendv_ps(v_dx,v_x,v_at);
+         v_vx = _mm256_blendv_ps(v_vx,_mm256_sub_ps(v_zero,v_vx),v_at);
+         v_at = _mm256_or_ps(_mm256_cmp_ps(v_dy,v_edgely,_CMP_LT_OQ),
+                _mm256_cmp_ps(v_dy,v_edgery,_CMP_GE_OQ));
+         v_dy = _mm256_blendv_ps(v_dy,v_y,v_at);
+         v_vy = _mm256_blendv_ps(v_vy,_mm256_sub_ps(v_zero,v_vy),v_at);
+         v_dz = _mm256_blendv_ps(v_dz,_mm256_add_ps(v_dz,v_edgerz),
+                _mm256_cmp_ps(v_dz,v_edgelz,_CMP_LT_OQ));
+         v_dz = _mm256_blendv_ps(v_dz,_mm256_sub_ps(v_dz,v_edgerz),
+                _mm256_cmp_ps(v_dz,v_edgerz,_CMP_GE_OQ));
+      }
+/* set new position */
+      _mm256_maskstore_ps(&part[j],v_msk,v_dx);
+      _mm256_maskstore_ps(&part[j+npe],v_msk,v_dy);
+      _mm256_maskstore_ps(&part[j+2*npe],v_msk,v_dz);
+/* set new velocity */
+      _mm256_maskstore_ps(&part[j+3*npe],v_msk,v_vx);
+      _mm256_maskstore_ps(&part[j+4*npe],v_msk,v_vy);
+      _mm256_maskstore_ps(&part[j+5*npe],v_msk,v_vz);
+   }
+   _mm256_storeu_pd(dd,v_sum1);
+   sum1 = (dd[0] + dd[1]) + (dd[2] + dd[3]);
+/* normalize kinetic energy */
+   if (lrel)
+      *ek += sum1;
+   else
+      *ek += 0.5f*sum1;
+   return;
+#undef NV
+}
+
+/*--------------------------------------------------------------------*/
+static AVX512F void cavx512jpost3lt(float part[], float cu[], float qm,
+                                    float dt, float ci, int nop, int npe,
+                                    int idimp, int nx, int ny, int nz,
+                                    int nxv, int nyv, int nzv, int ipbc,
+                                    int lrel) {
+/* AVX-512F version of cgjpost3lt (lrel = 0) and cgrjpost3lt (lrel = 1)
+   weights, addresses and velocities are calculated for 16 particles
+   at a time, then the current of each particle is added to the global
+   array with 256 bit vectors, two grid points at a time
+local data                                                            */
+#define NV              16
+   int i, j, nps, nn, mm, nxyv;
+   float ci2, edgelx, edgely, edgelz, edgerx, edgery, edgerz;
+   __m512i v_nxv4, v_nxyv4, v_nn, v_mm, v_ll;
+   __m512 v_qm, v_ci2, v_dt, v_one, v_zero;
+   __m512 v_edgelx, v_edgely, v_edgelz, v_edgerx, v_edgery, v_edgerz;
+   __m512 v_x, v_y, v_z, v_vx, v_vy, v_vz, v_ux, v_uy, v_uz;
+   __m512 v_dxp, v_dyp, v_dzp, v_amx, v_amy, v_amz, v_dx1;
+   __m512 v_dx, v_dy, v_dz, v_at;
+   __m256 a, b, v_v;
+   __mmask16 msk, mskr;
+   __attribute__((aligned(64))) int kk[NV];
+   __attribute__((aligned(64))) float sw[8*NV], sv[3*NV];
+   nxyv = nxv*nyv;
+   ci2 = ci*ci;
+/* set boundary values */
+   edgelx = 0.0f;
+   edgely = 0.0f;
+   edgelz = 0.0f;
+   edgerx = (float) nx;
+   edgery = (float) ny;
+   edgerz = (float) nz;
+   if (ipbc==2) {
+      edgelx = 1.0f;
+      edgely = 1.0f;
+      edgelz = 1.0f;
+      edgerx = (float) (nx-1);
+      edgery = (float) (ny-1);
+      edgerz = (float) (nz-1);
+   }
+   else if (ipbc==3) {
+      edgelx = 1.0f;
+      edgely = 1.0f;
+      edgerx = (float) (nx-1);
+      edgery = (float) (ny-1);
+   }
+   v_nxv4 = _mm512_set1_epi32(4*nxv);
+   v_nxyv4 = _mm512_set1_epi32(4*nxyv);
+   v_one = _mm512_set1_ps(1.0f);
+   v_zero = _mm512_setzero_ps();
+   v_edgelx = _mm512_set1_ps(edgelx);
+   v_edgely = _mm512_set1_ps(edgely);
+   v_edgelz = _mm512_set1_ps(edgelz);
+   v_edgerx = _mm512_set1_ps(edgerx);
+   v_edgery = _mm512_set1_ps(edgery);
+   v_edgerz = _mm512_set1_ps(edgerz);
+   v_qm = _mm512_set1_ps(qm);
+   v_ci2 = _mm512_set1_ps(ci2);
+   v_dt = _mm512_set1_ps(dt);
+/* loop over particles in blocks of 16 */
+   for (j = 0; j < nop; j+=NV) {
+      nps = nop - j;
+      nps = nps < NV ? nps : NV;
+      msk = (__mmask16) ((1 << nps) - 1);
+/* find interpolation weights */
+      v_x = _mm512_maskz_loadu_ps(msk,&part[j]);
+      v_y = _mm512_maskz_loadu_ps(msk,&part[j+npe]);
+      v_z = _mm512_maskz_loadu_ps(msk,&part[j+2*npe]);
+      v_nn = _mm512_cvttps_epi32(v_x);
+      v_mm = _mm512_cvttps_epi32(v_y);
+      v_ll = _mm512_cvttps_epi32(v_z);
+      v_dxp = _mm512_mul_ps(v_qm,_mm512_sub_ps(v_x,
+              _mm512_cvtepi32_ps(v_nn)));
+      v_dyp = _mm512_sub_ps(v_y,_mm512_cvtepi32_ps(v_mm));
+      v_dzp = _mm512_sub_ps(v_z,_mm512_cvtepi32_ps(v_ll));
+/* nn = 4*(nn + nxv*mm + nxyv*ll) */
+      v_mm = _mm512_mullo_epi32(v_nxv4,v_mm);
+      v_ll = _mm512_mullo_epi32(v_nxyv4,v_ll);
+      v_nn = _mm512_add_epi32(_mm512_slli_epi32(v_nn,2),
+             _mm512_add_epi32(v_mm,v_ll));
+      v_amx = _mm512_sub_ps(v_qm,v_dxp);
+      v_amy = _mm512_sub_ps(v_one,v_dyp);
+      v_dx1 = _mm512_mul_ps(v_dxp,v_dyp);
+      v_dyp = _mm512_mul_ps(v_amx,v_dyp);
+      v_amx = _mm512_mul_ps(v_amx,v_amy);
+      v_amz = _mm512_sub_ps(v_one,v_dzp);
+      v_amy = _mm512_mul_ps(v_dxp,v_amy);
+      _mm512_store_epi32(kk,v_nn);
+/* weights for the 8 grid points */
+      _mm512_store_ps(&sw[0],_mm512_mul_ps(v_amx,v_amz));
+      _mm512_store_ps(&sw[NV],_mm512_mul_ps(v_amy,v_amz));
+      _mm512_store_ps(&sw[2*NV],_mm512_mul_ps(v_dyp,v_amz));
+      _mm512_store_ps(&sw[3*NV],_mm512_mul_ps(v_dx1,v_amz));
+      _mm512_store_ps(&sw[4*NV],_mm512_mul_ps(v_amx,v_dzp));
+      _mm512_store_ps(&sw[5*NV],_mm512_mul_ps(v_amy,v_dzp));
+      _mm512_store_ps(&sw[6*NV],_mm512_mul_ps(v_dyp,v_dzp));
+      _mm512_store_ps(&sw[7*NV],_mm512_mul_ps(v_dx1,v_dzp));
+      v_ux = _mm512_maskz_loadu_ps(msk,&part[j+3*npe]);
+      v_uy = _mm512_maskz_loadu_ps(msk,&part[j+4*npe]);
+      v_uz = _mm512_maskz_loadu_ps(msk,&part[j+5*npe]);
+/* find inverse gamma */
+      if (lrel) {
+         v_at = _mm512_mul_ps(v_ux,v_ux);
+         v_at = _mm512_fmadd_ps(v_uy,v_uy,v_at);
+         v_at = _mm512_fmadd_ps(v_uz,v_uz,v_at);
+         v_at = _mm512_div_ps(v_one,_mm512_sqrt_ps(_mm512_fmadd_ps(
+                v_at,v_ci2,v_one)));
+         v_vx = _mm512_mul_ps(v_ux,v_at);
+         v_vy = _mm512_mul_ps(v_uy,v_at);
+         v_vz = _mm512_mul_ps(v_uz,v_at);
+      }
+      else {
+         v_vx = v_ux;
+         v_vy = v_uy;
+         v_vz = v_uz;
+      }
+      _mm512_store_ps(&sv[0],v_vx);
+      _mm512_store_ps(&sv[NV],v_vy);
+      _mm512_store_ps(&sv[2*NV],v_vz);
+/* deposit current */
+      for (i = 0; i < nps; i++) {
+         nn = kk[i];
+         v_v = _mm256_setr_ps(sv[i],sv[i+NV],sv[i+2*NV],0.0f,sv[i],
+                              sv[i+NV],sv[i+2*NV],0.0f);
+         mm = nn + 4*nxv;
+         a = _mm256_setr_ps(sw[i],sw[i],sw[i],sw[i],sw[i+NV],
+                            sw[i+NV],sw[i+NV],sw[i+NV]);
+         b = _mm256_loadu_ps(&cu[nn]);
+         _mm256_storeu_ps(&cu[nn],_mm256_fmadd_ps(v_v,a,b));
+         a = _mm256_setr_ps(sw[i+2*NV],sw[i+2*NV],sw[i+2*NV],
+                            sw[i+2*NV],sw[i+3*NV],sw[i+3*NV],
+                            sw[i+3*NV],sw[i+3*NV]);
+         b = _mm256_loadu_ps(&cu[mm]);
+         _mm256_storeu_ps(&cu[mm],_mm256_fmadd_ps(v_v,a,b));
+         nn += 4*nxyv;
+         mm += 4*nxyv;
+         a = _mm256_setr_ps(sw[i+4*NV],sw[i+4*NV],sw[i+4*NV],
+                            sw[i+4*NV],sw[i+5*NV],sw[i+5*NV],
+                            sw[i+5*NV],sw[i+5*NV]);
+         b = _mm256_loadu_ps(&cu[nn]);
+         _mm256_storeu_ps(&cu[nn],_mm256_fmadd_ps(v_v,a,b));
+         a = _mm256_setr_ps(sw[i+6*NV],sw[i+6*NV],sw[i+6*NV],
+                            sw[i+6*NV],sw[i+7*NV],sw[i+7*NV],
+                            sw[i+7*NV],sw[i+7*NV]);
+         b = _mm256_loadu_ps(&cu[mm]);
+         _mm256_storeu_ps(&cu[mm],_mm256_fmadd_ps(v_v,a,b));
+      }
+/* advance position half a time-step */
+      v_dx = _mm512_fmadd_ps(v_vx,v_dt,v_x);
+      v_dy = _mm512_fmadd_ps(v_vy,v_dt,v_y);
+      v_dz = _mm512_fmadd_ps(v_vz,v_dt,v_z);
+/* periodic boundary conditions */
+      if (ipbc==1) {
+         mskr = _mm512_cmp_ps_mask(v_dx,v_edgelx,_CMP_LT_OQ);
+         v_dx = _mm512_mask_add_ps(v_dx,mskr,v_dx,v_edgerx);
+         mskr = _mm512_cmp_ps_mask(v_dx,v_edgerx,_CMP_GE_OQ);
+         v_dx = _mm512_mask_sub_ps(v_dx,mskr,v_dx,v_edgerx);
+         mskr = _mm512_cmp_ps_mask(v_dy,v_edgely,_CMP_LT_OQ);
+         v_dy = _mm512_mask_add_ps(v_dy,mskr,v_dy,v_edgery);
+         mskr = _mm512_cmp_ps_mask(v_dy,v_edgery,_CMP_GE_OQ);
+         v_dy = _mm512_mask_sub_ps(v_dy,mskr,v_dy,v_edgery);
+         mskr = _mm512_cmp_ps_mask(v_dz,v_edgelz,_CMP_LT_OQ);
+         v_dz = _mm512_mask_add_ps(v_dz,mskr,v_dz,v_edgerz);
+         mskr = _mm512_cmp_ps_mask(v_dz,v_edgerz,_CMP_GE_OQ);
+         v_dz = _mm512_mask_sub_ps(v_dz,mskr,v_dz,v_edgerz);
+      }
+/* reflecting boundary conditions */
+      else if (ipbc==2) {
+         mskr = _mm512_cmp_ps_mask(v_dx,v_edgelx,_CMP_LT_OQ)
+              | _mm512_cmp_ps_mask(v_dx,v_edgerx,_CMP_GE_OQ);
+         v_dx = _mm512_mask_blend_ps(mskr,v_dx,v_x);
+         _mm512_mask_storeu_ps(&part[j+3*npe],msk & mskr,
+                               _mm512_sub_ps(v_zero,v_ux));
+         mskr = _mm512_cmp_ps_mask(v_dy,v_edgely,_CMP_LT_OQ)
+              | _mm512_cmp_ps_mask(v_dy,v_edgery,_CMP_GE_OQ);
+         v_dy = _mm512_mask_blend_ps(mskr,v_dy,v_y);
+         _mm512_mask_storeu_ps(&part[j+4*npe],msk & mskr,
+                               _mm512_sub_ps(v_zero,v_uy));
+         mskr = _mm512_cmp_ps_mask(v_dz,v_edgelz,_CMP_LT_OQ)
+              | _mm512_cmp_ps_mask(v_dz,v_edgerz,_CMP_GE_OQ);
+         v_dz = _mm512_mask_blend_ps(mskr,v_dz,v_z);
+         _mm512_mask_storeu_ps(&part[j+5*npe],msk & mskr,
+                               _mm512_sub_ps(v_zero,v_uz));
+      }
+/* mixed reflecting/periodic boundary conditions */
+      else if (ipbc==3) {
+         mskr = _mm512_cmp_ps_mask(v_dx,v_edgelx,_CMP_LT_OQ)
+              | _mm512_cmp_ps_mask(v_dx,v_edgerx,_CMP_GE_OQ);
+         v_dx = _mm512_mask_blend_ps(mskr,v_dx,v_x);
+         _mm512_mask_storeu_ps(&part[j+3*npe],msk & mskr,
+                               _mm512_sub_ps(v_zero,v_ux));
+         mskr = _mm512_cmp_ps_mask(v_dy,v_edgely,_CMP_LT_OQ)
+              | _mm512_cmp_ps_mask(v_dy,v_edgery,_CMP_GE_OQ);
+         v_dy = _mm512_mask_blend_ps(mskr,v_dy,v_y);
+         _mm512_mask_storeu_ps(&part[j+4*npe],msk & mskr,
+                               _mm512_sub_ps(v_zero,v_uy));
+         mskr = _mm512_cmp_ps_mask(v_dz,v_edgelz,_CMP_LT_OQ);
+         v_dz = _mm512_mask_add_ps(v_dz,mskr,v_dz,v_edgerz);
+         mskr = _mm512_cmp_ps_mask(v_dz,v_edgerz,_CMP_GE_OQ);
+         v_dz = _mm512_mask_sub_ps(v_dz,mskr,v_dz,v_edgerz);
+      }
+/* set new position */
+      _mm512_mask_storeu_ps(&part[j],msk,v_dx);
+      _mm512_mask_storeu_ps(&part[j+npe],msk,v_dy);
+      _mm512_mask_storeu_ps(&part[j+2*npe],msk,v_dz);
+   }
+   return;
+#undef NV
+}
+
+/*--------------------------------------------------------------------*/
+static AVX2 void cavx2jpost3lt(float part[], float cu[], float qm,
+                               float dt, float ci, int nop, int npe,
+                               int idimp, int nx, int ny, int nz,
+                               int nxv, int nyv, int nzv, int ipbc,
+                               int lrel) {
+/* AVX2 version of cgjpost3lt (lrel = 0) and cgrjpost3lt (lrel = 1)
+   weights, addresses and velocities are calculated for 8 particles
+   at a time, then the current of each particle is added to the global
+   array with 256 bit vectors, two grid points at a time
+local data                                                            */
+#define NV              8
+   int i, j, nps, nn, mm, nxyv;
+   float ci2, edgelx, edgely, edgelz, edgerx, edgery, edgerz;
+   __m256i v_nxv4, v_nxyv4, v_nn, v_mm, v_ll;
+   __m256 v_qm, v_ci2, v_dt, v_one, v_zero;
+   __m256 v_edgelx, v_edgely, v_edgelz, v_edgerx, v_edgery, v_edgerz;
+   __m256 v_x, v_y, v_z, v_vx, v_vy, v_vz, v_ux, v_uy, v_uz;
+   __m256 v_dxp, v_dyp, v_dzp, v_amx, v_amy, v_amz, v_dx1;
+   __m256 v_dx, v_dy, v_dz, v_at;
+   __m256 a, b, v_v;
+   __m256i v_it, v_msk;
+   __m256 v_ms;
+   __m256i v_mskr;
+   __attribute__((aligned(32))) int kk[NV];
+   __attribute__((aligned(32))) float sw[8*NV], sv[3*NV];
+   nxyv = nxv*nyv;
+   ci2 = ci*ci;
+/* set boundary values */
+   edgelx = 0.0f;
+   edgely = 0.0f;
+   edgelz = 0.0f;
+   edgerx = (float) nx;
+   edgery = (float) ny;
+   edgerz = (float) nz;
+   if (ipbc==2) {
+      edgelx = 1.0f;
+      edgely = 1.0f;
+      edgelz = 1.0f;
+      edgerx = (float) (nx-1);
+      edgery = (float) (ny-1);
+      edgerz = (float) (nz-1);
+   }
+   else if (ipbc==3) {
+      edgelx = 1.0f;
+      edgely = 1.0f;
+      edgerx = (float) (nx-1);
+      edgery = (float) (ny-1);
+   }
+   v_it = _mm256_setr_epi32(0,1,2,3,4,5,6,7);
+   v_nxv4 = _mm256_set1_epi32(4*nxv);
+   v_nxyv4 = _mm256_set1_epi32(4*nxyv);
+   v_one = _mm256_set1_ps(1.0f);
+   v_zero = _mm256_setzero_ps();
+   v_edgelx = _mm256_set1_ps(edgelx);
+   v_edgely = _mm256_set1_ps(edgely);
+   v_edgelz = _mm256_set1_ps(edgelz);
+   v_edgerx = _mm256_set1_ps(edgerx);
+   v_edgery = _mm256_set1_ps(edgery);
+   v_edgerz = _mm256_set1_ps(edgerz);
+   v_qm = _mm256_set1_ps(qm);
+   v_ci2 = _mm256_set1_ps(ci2);
+   v_dt = _mm256_set1_ps(dt);
+/* loop over particles in blocks of 8 */
+   for (j = 0; j < nop; j+=NV) {
+      nps = nop - j;
+      nps = nps < NV ? nps : NV;
+      v_msk = _mm256_cmpgt_epi32(_mm256_set1_epi32(nps),v_it);
+      v_ms = _mm256_castsi256_ps(v_msk);
+/* find interpolation weights */
+      v_x = _mm256_maskload_ps(&part[j],v_msk);
+      v_y = _mm256_maskload_ps(&part[j+npe],v_msk);
+      v_z = _mm256_maskload_ps(&part[j+2*npe],v_msk);
+      v_nn = _mm256_cvttps_epi32(v_x);
+      v_mm = _mm256_cvttps_epi32(v_y);
+      v_ll = _mm256_cvttps_epi32(v_z);
+      v_dxp = _mm256_mul_ps(v_qm,_mm256_sub_ps(v_x,
+              _mm256_cvtepi32_ps(v_nn)));
+      v_dyp = _mm256_sub_ps(v_y,_mm256_cvtepi32_ps(v_mm));
+      v_dzp = _mm256_sub_ps(v_z,_mm256_cvtepi32_ps(v_ll));
+/* nn = 4*(nn + nxv*mm + nxyv*ll) */
+      v_mm = _mm256_mullo_epi32(v_nxv4,v_mm);
+      v_ll = _mm256_mullo_epi32(v_nxyv4,v_ll);
+      v_nn = _mm256_add_epi32(_mm256_slli_epi32(v_nn,2),
+             _mm256_add_epi32(v_mm,v_ll));
+      v_amx = _mm256_sub_ps(v_qm,v_dxp);
+      v_amy = _mm256_sub_ps(v_one,v_dyp);
+      v_dx1 = _mm256_mul_ps(v_dxp,v_dyp);
+      v_dyp = _mm256_mul_ps(v_amx,v_dyp);
+      v_amx = _mm256_mul_ps(v_amx,v_amy);
+      v_amz = _mm256_sub_ps(v_one,v_dzp);
+      v_amy = _mm256_mul_ps(v_dxp,v_amy);
+      _mm256_store_si256((__m256i *)kk,v_nn);
+/* weights for the 8 grid points */
+      _mm256_store_ps(&sw[0],_mm256_mul_ps(v_amx,v_amz));
+      _mm256_store_ps(&sw[NV],_mm256_mul_ps(v_amy,v_amz));
+      _mm256_store_ps(&sw[2*NV],_mm256_mul_ps(v_dyp,v_amz));
+      _mm256_store_ps(&sw[3*NV],_mm256_mul_ps(v_dx1,v_amz));
+      _mm256_store_ps(&sw[4*NV],_mm256_mul_ps(v_amx,v_dzp));
+      _mm256_store_ps(&sw[5*NV],_mm256_mul_ps(v_amy,v_dzp));
+      _mm256_store_ps(&sw[6*NV],_mm256_mul_ps(v_dyp,v_dzp));
+      _mm256_store_ps(&sw[7*NV],_mm256_mul_ps(v_dx1,v_dzp));
+      v_ux = _mm256_maskload_ps(&part[j+3*npe],v_msk);
+      v_uy = _mm256_maskload_ps(&part[j+4*npe],v_msk);
+      v_uz = _mm256_maskload_ps(&part[j+5*npe],v_msk);
+/* find inverse gamma */
+      if (lrel) {
+         v_at = _mm256_mul_ps(v_ux,v_ux);
+         v_at = _mm256_fmadd_ps(v_uy,v_uy,v_at);
+         v_at = _mm256_fmadd_ps(v_uz,v_uz,v_at);
+         v_at = _mm256_div_ps(v_one,_mm256_sqrt_ps(_mm256_fmadd_ps(
+                v_at,v_ci2,v_one)));
+         v_vx = _mm256_mul_ps(v_ux,v_at);
+         v_vy = _mm256_mul_ps(v_uy,v_at);
+         v_vz = _mm256_mul_ps(v_uz,v_at);
+      }
+      else {
+         v_vx = v_ux;
+         v_vy = v_uy;
+         v_vz = v_uz;
+      }
+      _mm256_store_ps(&sv[0],v_vx);
+      _mm256_store_ps(&sv[NV],v_vy);
+      _mm256_store_ps(&sv[2*NV],v_vz);
+/* deposit current */
+      for (i = 0; i < nps; i++) {
+         nn = kk[i];
+         v_v = _mm256_setr_ps(sv[i],sv[i+NV],sv[i+2*NV],0.0f,sv[i],
+                              sv[i+NV],sv[i+2*NV],0.0f);
+         mm = nn + 4*nxv;
+         a = _mm256_setr_ps(sw[i],sw[i],sw[i],sw[i],sw[i+NV],
+                            sw[i+NV],sw[i+NV],sw[i+NV]);
+         b = _mm256_loadu_ps(&cu[nn]);
+         _mm256_storeu_ps(&cu[nn],_mm256_fmadd_ps(v_v,a,b));
+         a = _mm256_setr_ps(sw[i+2*NV],sw[i+2*NV],sw[i+2*NV],
+                            sw[i+2*NV],sw[i+3*NV],sw[i+3*NV],
+                            sw[i+3*NV],sw[i+3*NV]);
+         b = _mm256_loadu_ps(&cu[mm]);
+         _mm256_storeu_ps(&cu[mm],_mm256_fmadd_ps(v_v,a,b));
+         nn += 4*nxyv;
+         mm += 4*nxyv;
+         a = _mm256_setr_ps(sw[i+4*NV],sw[i+4*NV],sw[i+4*NV],
+                            sw[i+4*NV],sw[i+5*NV],sw[i+5*NV],
+                            sw[i+5*NV],sw[i+5*NV]);
+         b = _mm256_loadu_ps(&cu[nn]);
+         _mm256_storeu_ps(&cu[nn],_mm256_fmadd_ps(v_v,a,b));
+         a = _mm256_setr_ps(sw[i+6*NV],sw[i+6*NV],sw[i+6*NV],
+                            sw[i+6*NV],sw[i+7*NV],sw[i+7*NV],
+                            sw[i+7*NV],sw[i+7*NV]);
+         b = _mm256_loadu_ps(&cu[mm]);
+         _mm256_storeu_ps(&cu[mm],_mm256_fmadd_ps(v_v,a,b));
+      }
+/* advance position half a time-step */
+      v_dx = _mm256_fmadd_ps(v_vx,v_dt,v_x);
+      v_dy = _mm256_fmadd_ps(v_vy,v_dt,v_y);
+      v_dz = _mm256_fmadd_ps(v_vz,v_dt,v_z);
+/* periodic boundary conditions */
+      if (ipbc==1) {
+         v_dx = _mm256_blendv_ps(v_dx,_mm256_add_ps(v_dx,v_edgerx),
+                _mm256_cmp_ps(v_dx,v_edgelx,_CMP_LT_OQ));
+         v_dx = _mm256_blendv_ps(v_dx,_mm256_sub_ps(v_dx,v_edgerx),
+                _mm256_cmp_ps(v_dx,v_edgerx,_CMP_GE_OQ));
+         v_dy = _mm256_blendv_ps(v_dy,_mm256_add_ps(v_dy,v_edgery),
+                _mm256_cmp_ps(v_dy,v_edgely,_CMP_LT_OQ));
+         v_dy = _mm256_blendv_ps(v_dy,_mm256_sub_ps(v_dy,v_edgery),
+                _mm256_cmp_ps(v_dy,v_edgery,_CMP_GE_OQ));
+         v_dz = _mm256_blendv_ps(v_dz,_mm256_add_ps(v_dz,v_edgerz),
+                _mm256_cmp_ps(v_dz,v_edgelz,_CMP_LT_OQ));
+         v_dz = _mm256_blendv_ps(v_dz,_mm256_sub_ps(v_dz,v_edgerz),
+                _mm256_cmp_ps(v_dz,v_edgerz,_CMP_GE_OQ));
+      }
+/* reflecting boundary conditions */
+      else if (ipbc==2) {
+         v_at = _mm256_or_ps(_mm256_cmp_ps(v_dx,v_edgelx,_CMP_LT_OQ),
+                _mm256_cmp_ps(v_dx,v_edgerx,_CMP_GE_OQ));
+         v_dx = _mm256_blendv_ps(v_dx,v_x,v_at);
+         v_mskr = _mm256_castps_si256(_mm256_and_ps(v_at,v_ms));
+         _mm256_maskstore_ps(&part[j+3*npe],v_mskr,
+                             _mm256_sub_ps(v_zero,v_ux));
+         v_at = _mm256_or_ps(_mm256_cmp_ps(v_dy,v_edgely,_CMP_LT_OQ),
+                _mm256_cmp_ps(v_dy,v_edgery,_CMP_GE_OQ));
+         v_dy = _mm256_blendv_ps(v_dy,v_y,v_at);
+         v_mskr = _mm256_castps_si256(_mm256_and_ps(v_at,v_ms));
+         _mm256_maskstore_ps(&part[j+4*npe],v_mskr,
+                             _mm256_sub_ps(v_zero,v_uy));
+         v_at = _mm256_or_ps(_mm256_cmp_ps(v_dz,v_edgelz,_CMP_LT_OQ),
+                _mm256_cmp_ps(v_dz,v_edgerz,_CMP_GE_OQ));
+         v_dz = _mm256_blendv_ps(v_dz,v_z,v_at);
+         v_mskr = _mm256_castps_si256(_mm256_and_ps(v_at,v_ms));
+         _mm256_maskstore_ps(&part[j+5*npe],v_mskr,
+                             _mm256_sub_ps(v_zero,v_uz));
+      }
+/* mixed reflecting/periodic boundary conditions */
+      else if (ipbc==3) {
+         v_at = _mm256_or_ps(_mm256_cmp_ps(v_dx,v_edgelx,_CMP_LT_OQ),
+                _mm256_cmp_ps(v_dx,v_edgerx,_CMP_GE_OQ));
+         v_dx = _mm256_blendv_ps(v_dx,v_x,v_at);
+         v_mskr = _mm256_castps_si256(_mm256_and_ps(v_at,v_ms));
+         _mm256_maskstore_ps(&part[j+3*npe],v_mskr,
+                             _mm256_sub_ps(v_zero,v_ux));
+         v_at = _mm256_or_ps(_mm256_cmp_ps(v_dy,v_edgely,_CMP_LT_OQ),
+                _mm256_cmp_ps(v_dy,v_edgery,_CMP_GE_OQ));
+         v_dy = _mm256_blendv_ps(v_dy,v_y,v_at);
+         v_mskr = _mm256_castps_si256(_mm256_and_ps(v_at,v_ms));
+         _mm256_maskstore_ps(&part[j+4*npe],v_mskr,
+                             _mm256_sub_ps(v_zero,v_uy));
+         v_dz = _mm256_blendv_ps(v_dz,_mm256_add_ps(v_dz,v_edgerz),
+                _mm256_cmp_ps(v_dz,v_edgelz,_CMP_LT_OQ));
+         v_dz = _mm256_blendv_ps(v_dz,_mm256_sub_ps(v_dz,v_edgerz),
+                _mm256_cmp_ps(v_dz,v_edgerz,_CMP_GE_OQ));
+      }
+/* set new position */
+      _mm256_maskstore_ps(&part[j],v_msk,v_dx);
+      _mm256_maskstore_ps(&part[j+npe],v_msk,v_dy);
+      _mm256_maskstore_ps(&part[j+2*npe],v_msk,v_dz);
+   }
+   return;
+#undef NV
+}
+
+/*--------------------------------------------------------------------*/
+void cavxgbpush3lt(float part[], float fxyz[], float bxyz[], float qbm,
+                   float dt, float dtc, float *ek, int idimp, int nop,
+                   int npe, int nx, int ny, int nz, int nxv, int nyv,
+                   int nzv, int ipbc) {
+/* for 3d code, this subroutine updates particle co-ordinates and
+   velocities using leap-frog scheme in time and first-order linear
+   interpolation in space, with magnetic field.  Using the Boris Mover.
+   vector version using guard cells
+   190 flops/particle, 1 divide, 54 loads, 6 stores
+   input: all, output: part, ek
+   same algorithm and arguments as cgbpush3lt.  uses AVX-512F if
+   available, otherwise AVX2, as found by cavxcheck
+   requires AVX2, and fxyz, bxyz with 4 components per grid point
+local data                                                            */
+   if (cavxcheck()==2)
+      cavx512bpush3lt(part,fxyz,bxyz,qbm,dt,dtc,0.0f,ek,idimp,nop,npe,
+                      nx,ny,nz,nxv,nyv,nzv,ipbc,0);
+   else
+      cavx2bpush3lt(part,fxyz,bxyz,qbm,dt,dtc,0.0f,ek,idimp,nop,npe,nx,
+                    ny,nz,nxv,nyv,nzv,ipbc,0);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cavxgrbpush3lt(float part[], float fxyz[], float bxyz[], float qbm,
+                    float dt, float dtc, float ci, float *ek, int idimp,
+                    int nop, int npe, int nx, int ny, int nz, int nxv,
+                    int nyv, int nzv, int ipbc) {
+/* for 3d code, this subroutine updates particle co-ordinates and
+   velocities using leap-frog scheme in time and first-order linear
+   interpolation in space, for relativistic particles with magnetic field
+   Using the Boris Mover.
+   vector version using guard cells
+   202 flops/particle, 4 divides, 2 sqrts, 54 loads, 6 stores
+   input: all, output: part, ek
+   same algorithm and arguments as cgrbpush3lt.  uses AVX-512F if
+   available, otherwise AVX2, as found by cavxcheck
+   requires AVX2, and fxyz, bxyz with 4 components per grid point
+local data                                                            */
+   if (cavxcheck()==2)
+      cavx512bpush3lt(part,fxyz,bxyz,qbm,dt,dtc,ci,ek,idimp,nop,npe,nx,
+                      ny,nz,nxv,nyv,nzv,ipbc,1);
+   else
+      cavx2bpush3lt(part,fxyz,bxyz,qbm,dt,dtc,ci,ek,idimp,nop,npe,nx,ny,
+                    nz,nxv,nyv,nzv,ipbc,1);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cavxgjpost3lt(float part[], float cu[], float qm, float dt,
+                   int nop, int npe, int idimp, int nx, int ny, int nz,
+                   int nxv, int nyv, int nzv, int ipbc) {
+/* for 3d code, this subroutine calculates particle current density
+   using first-order linear interpolation
+   in addition, particle positions are advanced a half time-step
+   vector version using guard cells
+   69 flops/particle, 30 loads, 27 stores
+   input: all, output: part, cu
+   same algorithm and arguments as cgjpost3lt.  uses AVX-512F if
+   available, otherwise AVX2, as found by cavxcheck
+   requires AVX2, and cu with 4 components per grid point
+local data                                                            */
+   if (cavxcheck()==2)
+      cavx512jpost3lt(part,cu,qm,dt,0.0f,nop,npe,idimp,nx,ny,nz,nxv,nyv,
+                      nzv,ipbc,0);
+   else
+      cavx2jpost3lt(part,cu,qm,dt,0.0f,nop,npe,idimp,nx,ny,nz,nxv,nyv,
+                    nzv,ipbc,0);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cavxgrjpost3lt(float part[], float cu[], float qm, float dt,
+                    float ci, int nop, int npe, int idimp, int nx,
+                    int ny, int nz, int nxv, int nyv, int nzv,
+                    int ipbc) {
+/* for 3d code, this subroutine calculates particle current density
+   using first-order linear interpolation for relativistic particles
+   in addition, particle positions are advanced a half time-step
+   vector version using guard cells
+   79 flops/particle, 1 divide, 1 sqrt, 30 loads, 27 stores
+   input: all, output: part, cu
+   same algorithm and arguments as cgrjpost3lt.  uses AVX-512F if
+   available, otherwise AVX2, as found by cavxcheck
+   requires AVX2, and cu with 4 components per grid point
+local data                                                            */
+   if (cavxcheck()==2)
+      cavx512jpost3lt(part,cu,qm,dt,ci,nop,npe,idimp,nx,ny,nz,nxv,nyv,
+                      nzv,ipbc,1);
+   else
+      cavx2jpost3lt(part,cu,qm,dt,ci,nop,npe,idimp,nx,ny,nz,nxv,nyv,nzv,
+                    ipbc,1);
+   return;
+}
+
+/* Interfaces to Fortran */
+
+/*--------------------------------------------------------------------*/
+int cavxcheck_() {
+   return cavxcheck();
+}
+
+/*--------------------------------------------------------------------*/
+void cavxgbpush3lt_(float *part, float *fxyz, float *bxyz, float *qbm,
+                    float *dt, float *dtc, float *ek, int *idimp,
+                    int *nop, int *npe, int *nx, int *ny, int *nz,
+                    int *nxv, int *nyv, int *nzv, int *ipbc) {
+   cavxgbpush3lt(part,fxyz,bxyz,*qbm,*dt,*dtc,ek,*idimp,*nop,*npe,*nx,
+                 *ny,*nz,*nxv,*nyv,*nzv,*ipbc);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cavxgrbpush3lt_(float *part, float *fxyz, float *bxyz, float *qbm,
+                     float *dt, float *dtc, float *ci, float *ek,
+                     int *idimp, int *nop, int *npe, int *nx, int *ny,
+                     int *nz, int *nxv, int *nyv, int *nzv, int *ipbc) {
+   cavxgrbpush3lt(part,fxyz,bxyz,*qbm,*dt,*dtc,*ci,ek,*idimp,*nop,*npe,
+                  *nx,*ny,*nz,*nxv,*nyv,*nzv,*ipbc);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cavxgjpost3lt_(float *part, float *cu, float *qm, float *dt,
+                    int *nop, int *npe, int *idimp, int *nx, int *ny,
+                    int *nz, int *nxv, int *nyv, int *nzv, int *ipbc) {
+   cavxgjpost3lt(part,cu,*qm,*dt,*nop,*npe,*idimp,*nx,*ny,*nz,*nxv,*nyv,
+                 *nzv,*ipbc);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cavxgrjpost3lt_(float *part, float *cu, float *qm, float *dt,
+                     float *ci, int *nop, int *npe, int *idimp, int *nx,
+                     int *ny, int *nz, int *nxv, int *nyv, int *nzv,
+                     int *ipbc) {
+   cavxgrjpost3lt(part,cu,*qm,*dt,*ci,*nop,*npe,*idimp,*nx,*ny,*nz,*nxv,
+                  *nyv,*nzv,*ipbc);
+   return;
+}
+
@@ -0,0 +1,23 @@
+/* header file for avxbpush3.c */
+
+int cavxcheck();
+
+void cavxgbpush3lt(float part[], float fxyz[], float bxyz[], float qbm,
+                   float dt, float dtc, float *ek, int idimp, int nop,
+                   int npe, int nx, int ny, int nz, int nxv, int nyv,
+                   int nzv, int ipbc);
+
+void cavxgrbpush3lt(float part[], float fxyz[], float bxyz[], float qbm,
+                    float dt, float dtc, float ci, float *ek, int idimp,
+                    int nop, int npe, int nx, int ny, int nz, int nxv,
+                    int nyv, int nzv, int ipbc);
+
+void cavxgjpost3lt(float part[], float cu[], float qm, float dt,
+                   int nop, int npe, int idimp, int nx, int ny, int nz,
+                   int nxv, int nyv, int nzv, int ipbc);
+
+void cavxgrjpost3lt(float part[], float cu[], float qm, float dt,
+                    float ci, int nop, int npe, int idimp, int nx,
+                    int ny, int nz, int nxv, int nyv, int nzv,
+                    int ipbc);
+
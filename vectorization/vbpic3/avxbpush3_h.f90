@@ -0,0 +1,63 @@
+!-----------------------------------------------------------------------
+! Interface file for avxbpush3.c
+      module avxbpush3_h
+      implicit none
+!
+      interface
+         function cavxcheck()
+         implicit none
+         integer :: cavxcheck
+         end function
+      end interface
+!
+      interface
+         subroutine cavxgbpush3lt(part,fxyz,bxyz,qbm,dt,dtc,ek,idimp,nop&
+     &,npe,nx,ny,nz,nxv,nyv,nzv,ipbc)
+         implicit none
+         integer, intent(in) :: idimp, nop, npe, nx, ny, nz
+         integer, intent(in) :: nxv, nyv, nzv, ipbc
+         real, intent(in) :: qbm, dt, dtc
+         real, intent(inout) :: ek
+         real, dimension(npe,idimp), intent(inout) :: part
+         real, dimension(4,nxv*nyv*nzv), intent(in) :: fxyz, bxyz
+         end subroutine
+      end interface
+!
+      interface
+         subroutine cavxgrbpush3lt(part,fxyz,bxyz,qbm,dt,dtc,ci,ek,idimp&
+     &,nop,npe,nx,ny,nz,nxv,nyv,nzv,ipbc)
+         implicit none
+         integer, intent(in) :: idimp, nop, npe, nx, ny, nz
+         integer, intent(in) :: nxv, nyv, nzv, ipbc
+         real, intent(in) :: qbm, dt, dtc, ci
+         real, intent(inout) :: ek
+         real, dimension(npe,idimp), intent(inout) :: part
+         real, dimension(4,nxv*nyv*nzv), intent(in) :: fxyz, bxyz
+         end subroutine
+      end interface
+!
+      interface
+         subroutine cavxgjpost3lt(part,cu,qm,dt,nop,npe,idimp,nx,ny,nz, &
+     &nxv,nyv,nzv,ipbc)
+         implicit none
+         integer, intent(in) :: nop, npe, idimp, nx, ny, nz
+         integer, intent(in) :: nxv, nyv, nzv, ipbc
+         real, intent(in) :: qm, dt
+         real, dimension(npe,idimp), intent(inout) :: part
+         real, dimension(4,nxv*nyv*nzv), intent(inout) :: cu
+         end subroutine
+      end interface
+!
+      interface
+         subroutine cavxgrjpost3lt(part,cu,qm,dt,ci,nop,npe,idimp,nx,ny,&
+     &nz,nxv,nyv,nzv,ipbc)
+         implicit none
+         integer, intent(in) :: nop, npe, idimp, nx, ny, nz
+         integer, intent(in) :: nxv, nyv, nzv, ipbc
+         real, intent(in) :: qm, dt, ci
+         real, dimension(npe,idimp), intent(inout) :: part
+         real, dimension(4,nxv*nyv*nzv), intent(inout) :: cu
+         end subroutine
+      end interface
+!
+      end module
@@ -9,6 +9,8 @@
 #include <immintrin.h>
 #include "kncbpush3.h"
 
+#ifdef __MIC__
+
 /*--------------------------------------------------------------------*/
 void ckncxiscan2(int *isdata, int nths) {
 /* performs local prefix reduction of integer data shared by threads */
@@ -11569,6 +11571,199 @@ void ckncwfft3rv3(float complex f[], int isign, int mixup[],
    return;
 }
 
+#else
+
+/* KNC intrinsics are only available when compiling for the Xeon Phi */
+/* coprocessor (__MIC__).  Otherwise these procedures abort, and the  */
+/* autovector (kvec = 1) or AVX-512F/AVX2 (kvec = 3) versions must be */
+/* used.                                                              */
+
+static void cknc_none(const char *name) {
+   fprintf(stderr,"%s: KNC version not available in this build\n",name);
+   exit(1);
+}
+
+/*--------------------------------------------------------------------*/
+void ckncxiscan2(int *isdata, int nths) {
+   cknc_none("ckncxiscan2");
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void ckncgbpush3lt(float part[], float fxyz[], float bxyz[], float qbm,
+                   float dt, float dtc, float *ek, int idimp, int nop,
+                   int npe, int nx, int ny, int nz, int nxv, int nyv,
+                   int nzv, int ipbc) {
+   cknc_none("ckncgbpush3lt");
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void ckncgrbpush3lt(float part[], float fxyz[], float bxyz[], float qbm,
+                    float dt, float dtc, float ci, float *ek, int idimp,
+                    int nop, int npe, int nx, int ny, int nz, int nxv,
+                    int nyv, int nzv, int ipbc) {
+   cknc_none("ckncgrbpush3lt");
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void ckncgpost3lt(float part[], float q[], float qm, int nop, int npe,
+                  int idimp, int nxv, int nyv, int nzv) {
+   cknc_none("ckncgpost3lt");
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cknc2gpost3lt(float part[], float q[], float qm, int nop, int npe,
+                   int idimp, int nxv, int nyv, int nzv) {
+   cknc_none("cknc2gpost3lt");
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void ckncgjpost3lt(float part[], float cu[], float qm, float dt,
+                   int nop, int npe, int idimp, int nx, int ny, int nz,
+                   int nxv, int nyv, int nzv, int ipbc) {
+   cknc_none("ckncgjpost3lt");
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void ckncgrjpost3lt(float part[], float cu[], float qm, float dt,
+                    float ci, int nop, int npe, int idimp, int nx,
+                    int ny, int nz, int nxv, int nyv, int nzv,
+                    int ipbc) {
+   cknc_none("ckncgrjpost3lt");
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void ckncdsortp3yzlt(float parta[], float partb[], int npic[],
+                     int idimp, int nop, int npe, int ny1, int nyz1) {
+   cknc_none("ckncdsortp3yzlt");
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cknccguard3l(float fxyz[], int nx, int ny, int nz, int nxe,
+                  int nye, int nze) {
+   cknc_none("cknccguard3l");
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void ckncacguard3l(float cu[], int nx, int ny, int nz, int nxe, int nye,
+                   int nze) {
+   cknc_none("ckncacguard3l");
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void ckncaguard3l(float q[], int nx, int ny, int nz, int nxe, int nye,
+                  int nze) {
+   cknc_none("ckncaguard3l");
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void ckncpois33(float complex q[], float complex fxyz[], int isign,
+                float complex ffc[], float ax, float ay, float az,
+                float affp, float *we, int nx, int ny, int nz, int nxvh,
+                int nyv, int nzv, int nxhd, int nyhd, int nzhd) {
+   cknc_none("ckncpois33");
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void cknccuperp3(float complex cu[], int nx, int ny, int nz, int nxvh,
+                 int nyv, int nzv) {
+   cknc_none("cknccuperp3");
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void ckncibpois33(float complex cu[], float complex bxyz[],
+                  float complex ffc[], float ci, float *wm, int nx,
+                  int ny, int nz, int nxvh, int nyv, int nzv, int nxhd,
+                  int nyhd, int nzhd) {
+   cknc_none("ckncibpois33");
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void ckncmaxwel3(float complex exyz[], float complex bxyz[],
+                 float complex cu[], float complex ffc[], float ci,
+                 float dt, float *wf, float *wm, int nx, int ny, int nz,
+                 int nxvh, int nyv, int nzv, int nxhd, int nyhd,
+                 int nzhd) {
+   cknc_none("ckncmaxwel3");
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void ckncemfield3(float complex fxyz[], float complex exyz[],
+                  float complex ffc[], int isign, int nx, int ny,
+                  int nz, int nxvh, int nyv, int nzv, int nxhd,
+                  int nyhd, int nzhd) {
+   cknc_none("ckncemfield3");
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void ckncfft3rvxy(float complex f[], int isign, int mixup[],
+                  float complex sct[], int indx, int indy, int indz,
+                  int nzi, int nzp, int nxhd, int nyd, int nzd,
+                  int nxhyzd, int nxyzhd) {
+   cknc_none("ckncfft3rvxy");
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void ckncfft3rxz(float complex f[], int isign, int mixup[],
+                 float complex sct[], int indx, int indy, int indz,
+                 int nyi, int nyp, int nxhd, int nyd, int nzd,
+                 int nxhyzd, int nxyzhd) {
+   cknc_none("ckncfft3rxz");
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void ckncfft3rv3xy(float complex f[], int isign, int mixup[],
+                   float complex sct[], int indx, int indy, int indz,
+                   int nzi, int nzp, int nxhd, int nyd, int nzd,
+                   int nxhyzd, int nxyzhd) {
+   cknc_none("ckncfft3rv3xy");
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void ckncfft3rv3z(float complex f[], int isign, int mixup[],
+                  float complex sct[], int indx, int indy, int indz,
+                  int nyi, int nyp, int nxhd, int nyd, int nzd,
+                  int nxhyzd, int nxyzhd) {
+   cknc_none("ckncfft3rv3z");
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void ckncwfft3rvx(float complex f[], int isign, int mixup[],
+                  float complex sct[], int indx, int indy, int indz,
+                  int nxhd, int nyd, int nzd, int nxhyzd, int nxyzhd) {
+   cknc_none("ckncwfft3rvx");
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void ckncwfft3rv3(float complex f[], int isign, int mixup[],
+                  float complex sct[], int indx, int indy, int indz,
+                  int nxhd, int nyd, int nzd, int nxhyzd, int nxyzhd) {
+   cknc_none("ckncwfft3rv3");
+   return;
+}
+
+#endif
+
 /* Interfaces to Fortran */
 
 /*--------------------------------------------------------------------*/
@@ -8,6 +8,7 @@
 #include "vbpush3.h"
 #include "avx512lib3.h"
 #include "kncbpush3.h"
+#include "avxbpush3.h"
 
 void dtimer(double *time, struct timeval *itime, int icntrl);
 
@@ -38,7 +39,7 @@ int main(int argc, char *argv[]) {
 /* wke/we = particle kinetic/electrostatic field energy             */
 /* wf/wm/wt = magnetic field/transverse electric field/total energy */
    float wke = 0.0, we = 0.0, wf = 0.0, wm = 0.0, wt = 0.0;
-/* kvec = (1,2) = run (autovector,KNC) version */
+/* kvec = (1,2,3) = run (autovector,KNC,AVX-512F/AVX2) version */
    int kvec = 1;
 
 /* declare scalars for standard code */
@@ -86,6 +87,17 @@ int main(int argc, char *argv[]) {
    qbme = qme;
    affp = ((float) nx)*((float) ny)*((float) nz)/(float ) np;
    dth = 0.0;
+/* check if AVX-512F or AVX2 is available */
+   if (kvec==3) {
+      if (cavxcheck()==2)
+         printf("using AVX-512F version\n");
+      else if (cavxcheck()==1)
+         printf("using AVX2 version\n");
+      else {
+         printf("AVX2 not available, using autovector version\n");
+         kvec = 1;
+      }
+   }
 
 /* allocate data for standard code */
    mixup = (int *) malloc(nxhyz*sizeof(int));
@@ -151,6 +163,10 @@ L500: if (nloop <= ntime)
          else if (kvec==2)
              ckncgrjpost3lt(partt,cue,qme,dth,ci,np,npe,idimp,nx,ny,nz,
                             nxe,nye,nze,ipbc);
+/* AVX-512F/AVX2 function */
+         else if (kvec==3)
+            cavxgrjpost3lt(partt,cue,qme,dth,ci,np,npe,idimp,nx,ny,nz,
+                           nxe,nye,nze,ipbc);
       }
       else {
          if (kvec==1)
@@ -162,6 +178,10 @@ L500: if (nloop <= ntime)
          else if (kvec==2)
             ckncgjpost3lt(partt,cue,qme,dth,np,npe,idimp,nx,ny,nz,nxe,
                           nye,nze,ipbc);
+/* AVX-512F/AVX2 function */
+         else if (kvec==3)
+            cavxgjpost3lt(partt,cue,qme,dth,np,npe,idimp,nx,ny,nz,nxe,
+                          nye,nze,ipbc);
       }
       dtimer(&dtime,&itime,1);
       time = (float) dtime;
@@ -172,7 +192,7 @@ L500: if (nloop <= ntime)
       for (j = 0; j < nxe*nye; j++) {
          qe[j] = 0.0;
       }
-      if (kvec==1)
+      if ((kvec==1) || (kvec==3))
          cgpost3lt(partt,qe,qme,np,npe,idimp,nxe,nye,nze);
 /*       cvgpost3lt(partt,qe,qme,np,npe,idimp,nxe,nye,nze); */
 /* KNC function */
@@ -184,7 +204,7 @@ L500: if (nloop <= ntime)
 
 /* add guard cells with standard procedure: updates cue, qe */
       dtimer(&dtime,&itime,-1);
-      if (kvec==1) {
+      if ((kvec==1) || (kvec==3)) {
          cacguard3l(cue,nx,ny,nz,nxe,nye,nze);
          caguard3l(qe,nx,ny,nz,nxe,nye,nze);
       }
@@ -200,7 +220,7 @@ L500: if (nloop <= ntime)
 /* transform charge to fourier space with standard procedure: updates qe */
       dtimer(&dtime,&itime,-1);
       isign = -1;
-      if (kvec==1)
+      if ((kvec==1) || (kvec==3))
          cwfft3rvx((float complex *)qe,isign,mixup,sct,indx,indy,indz,
                    nxeh,nye,nze,nxhyz,nxyzh);
 /* KNC function */
@@ -214,7 +234,7 @@ L500: if (nloop <= ntime)
 /* transform current to fourier space with standard procedure: update cue */
       dtimer(&dtime,&itime,-1);
       isign = -1;
-      if (kvec==1)
+      if ((kvec==1) || (kvec==3))
          cwfft3rv3((float complex *)cue,isign,mixup,sct,indx,indy,indz,
                 nxeh,nye,nze,nxhyz,nxyzh);
 /* KNC function */
@@ -227,7 +247,7 @@ L500: if (nloop <= ntime)
 
 /* take transverse part of current with standard procedure: updates cue */
       dtimer(&dtime,&itime,-1);
-      if (kvec==1)
+      if ((kvec==1) || (kvec==3))
          ccuperp3((float complex *)cue,nx,ny,nz,nxeh,nye,nze);
 /* KNC function */
       else if (kvec==2)
@@ -240,7 +260,7 @@ L500: if (nloop <= ntime)
 /* procedure: updates exyz, bxyz                                   */
       dtimer(&dtime,&itime,-1);
       if (ntime==0) {
-         if (kvec==1)
+         if ((kvec==1) || (kvec==3))
             cvibpois33((float complex *)cue,bxyz,ffc,ci,&wm,nx,ny,nz,
                        nxeh,nye,nze,nxh,nyh,nzh);
 /* KNC function */
@@ -251,7 +271,7 @@ L500: if (nloop <= ntime)
          dth = 0.5*dt;
       }
       else {
-         if (kvec==1)
+         if ((kvec==1) || (kvec==3))
             cvmaxwel3(exyz,bxyz,(float complex *)cue,ffc,ci,dt,&wf,&wm,
                       nx,ny,nz,nxeh,nye,nze,nxh,nyh,nzh);
 /* KNC function */
@@ -267,7 +287,7 @@ L500: if (nloop <= ntime)
 /* updates fxyze                                                    */
       dtimer(&dtime,&itime,-1);
       isign = -1;
-      if (kvec==1)
+      if ((kvec==1) || (kvec==3))
          cvpois33((float complex *)qe,(float complex *)fxyze,isign,ffc,
                   ax,ay,az,affp,&we,nx,ny,nz,nxeh,nye,nze,nxh,nyh,nzh);
 /* KNC function */
@@ -283,7 +303,7 @@ L500: if (nloop <= ntime)
 /* procedure: updates fxyze */
       dtimer(&dtime,&itime,-1);
       isign = 1;
-      if (kvec==1)
+      if ((kvec==1) || (kvec==3))
          cvemfield3((float complex *)fxyze,exyz,ffc,isign,nx,ny,nz,nxeh,
                     nye,nze,nxh,nyh,nzh);
 /* KNC function */
@@ -292,7 +312,7 @@ L500: if (nloop <= ntime)
                       nxeh,nye,nze,nxh,nyh,nzh);
 /* copy magnetic field with standard procedure: updates bxyze */
       isign = -1;
-      if (kvec==1)
+      if ((kvec==1) || (kvec==3))
          cvemfield3((float complex *)bxyze,bxyz,ffc,isign,nx,ny,nz,nxeh,
                     nye,nze,nxh,nyh,nzh);
 /* KNC function */
@@ -307,7 +327,7 @@ L500: if (nloop <= ntime)
 /* updates fxyze                                                   */
       dtimer(&dtime,&itime,-1);
       isign = 1;
-      if (kvec==1)
+      if ((kvec==1) || (kvec==3))
          cwfft3rv3((float complex *)fxyze,isign,mixup,sct,indx,indy,
                    indz,nxeh,nye,nze,nxhyz,nxyzh);
 /* KNC function */
@@ -322,7 +342,7 @@ L500: if (nloop <= ntime)
 /* updates bxyze                                                   */
       dtimer(&dtime,&itime,-1);
       isign = 1;
-      if (kvec==1)
+      if ((kvec==1) || (kvec==3))
          cwfft3rv3((float complex *)bxyze,isign,mixup,sct,indx,indy,
                    indz,nxeh,nye,nze,nxhyz,nxyzh);
 /* KNC function */
@@ -335,7 +355,7 @@ L500: if (nloop <= ntime)
 
 /* copy guard cells with standard procedure: updates fxyze, bxyze */
       dtimer(&dtime,&itime,-1);
-      if (kvec==1) {
+      if ((kvec==1) || (kvec==3)) {
          ccguard3l(fxyze,nx,ny,nz,nxe,nye,nze);
          ccguard3l(bxyze,nx,ny,nz,nxe,nye,nze);
       }
@@ -361,6 +381,10 @@ L500: if (nloop <= ntime)
          else if (kvec==2)
             ckncgrbpush3lt(partt,fxyze,bxyze,qbme,dt,dth,ci,&wke,idimp,
                            np,npe,nx,ny,nz,nxe,nye,nze,ipbc);
+/* AVX-512F/AVX2 function */
+         else if (kvec==3)
+            cavxgrbpush3lt(partt,fxyze,bxyze,qbme,dt,dth,ci,&wke,idimp,
+                           np,npe,nx,ny,nz,nxe,nye,nze,ipbc);
       }
       else {
          if (kvec==1)
@@ -372,6 +396,10 @@ L500: if (nloop <= ntime)
          else if (kvec==2)
             ckncgbpush3lt(partt,fxyze,bxyze,qbme,dt,dth,&wke,idimp,np,
                           npe,nx,ny,nz,nxe,nye,nze,ipbc);
+/* AVX-512F/AVX2 function */
+         else if (kvec==3)
+            cavxgbpush3lt(partt,fxyze,bxyze,qbme,dt,dth,&wke,idimp,np,
+                          npe,nx,ny,nz,nxe,nye,nze,ipbc);
       }
       dtimer(&dtime,&itime,1);
       time = (float) dtime;
@@ -381,7 +409,7 @@ L500: if (nloop <= ntime)
       if (sortime > 0) {
          if (ntime%sortime==0) {
             dtimer(&dtime,&itime,-1);
-            if (kvec==1)
+            if ((kvec==1) || (kvec==3))
                cdsortp3yzlt(partt,partt2,npic,idimp,np,npe,ny1,nyz1);
 /* KNC function */
             else if (kvec==2)
@@ -4,6 +4,7 @@
       program vbpic3
       use avx512flib3_h
       use kncbpush3_h
+      use avxbpush3_h
       use vbpush3_h
       implicit none
 ! indx/indy/indz = exponent which determines grid points in x/y/z
@@ -32,7 +33,7 @@
 ! wke/we = particle kinetic/electrostatic field energy
 ! wf/wm/wt = magnetic field/transverse electric field/total energy
       real :: wke = 0.0, we = 0.0, wf = 0.0, wm = 0.0, wt = 0.0
-! kvec = (1,2) = run (autovector,KNC) version
+! kvec = (1,2,3) = run (autovector,KNC,AVX-512F/AVX2) version
       integer :: kvec = 1
 !
 ! declare scalars for standard code
@@ -67,6 +68,18 @@
       real :: tdjpost = 0.0, tpush = 0.0, tsort = 0.0
       double precision :: dtime
 !
+! check if AVX-512F or AVX2 is available
+      if (kvec==3) then
+         if (cavxcheck()==2) then
+            write (*,*) 'using AVX-512F version'
+         else if (cavxcheck()==1) then
+            write (*,*) 'using AVX2 version'
+         else
+            write (*,*) 'AVX2 not available, using autovector version'
+            kvec = 1
+         endif
+      endif
+!
 ! initialize scalars for standard code
 ! np = total number of particles in simulation
 ! nx/ny/nz = number of grid points in x/y direction
@@ -141,6 +154,10 @@
          else if (kvec==2) then
             call ckncgrjpost3lt(partt,cue,qme,dth,ci,np,npe,idimp,nx,ny,&
      &nz,nxe,nye,nze,ipbc)
+! AVX-512F/AVX2 function
+         else if (kvec==3) then
+            call cavxgrjpost3lt(partt,cue,qme,dth,ci,np,npe,idimp,nx,ny,&
+     &nz,nxe,nye,nze,ipbc)
          endif
       else
          if (kvec==1) then
@@ -152,6 +169,10 @@
          else if (kvec==2) then
             call ckncgjpost3lt(partt,cue,qme,dth,np,npe,idimp,nx,ny,nz, &
      &nxe,nye,nze,ipbc)
+! AVX-512F/AVX2 function
+         else if (kvec==3) then
+            call cavxgjpost3lt(partt,cue,qme,dth,np,npe,idimp,nx,ny,nz, &
+     &nxe,nye,nze,ipbc)
          endif
       endif
       call dtimer(dtime,itime,1)
@@ -161,7 +182,7 @@
 ! deposit charge with standard procedure: updates qe
       call dtimer(dtime,itime,-1)
       qe = 0.0
-      if (kvec==1) then
+      if ((kvec==1).or.(kvec==3)) then
          call GPOST3LT(partt,qe,qme,np,npe,idimp,nxe,nye,nze)
 !        call VGPOST3LT(partt,qe,qme,np,npe,idimp,nxe,nye,nze)
 ! KNC function
@@ -174,7 +195,7 @@
 !
 ! add guard cells with standard procedure: updates cue, qe
       call dtimer(dtime,itime,-1)
-      if (kvec==1) then
+      if ((kvec==1).or.(kvec==3)) then
          call ACGUARD3L(cue,nx,ny,nz,nxe,nye,nze)
          call AGUARD3L(qe,nx,ny,nz,nxe,nye,nze)
 ! KNC function
@@ -189,7 +210,7 @@
 ! transform charge to fourier space with standard procedure: updates qe
       call dtimer(dtime,itime,-1)
       isign = -1
-      if (kvec==1) then
+      if ((kvec==1).or.(kvec==3)) then
          call WFFT3RVX(qe,isign,mixup,sct,indx,indy,indz,nxeh,nye,nze,  &
      &nxhyz,nxyzh)
 ! KNC function
@@ -204,7 +225,7 @@
 ! transform current to fourier space with standard procedure: update cue
       call dtimer(dtime,itime,-1)
       isign = -1
-      if (kvec==1) then
+      if ((kvec==1).or.(kvec==3)) then
          call WFFT3RV3(cue,isign,mixup,sct,indx,indy,indz,nxeh,nye,nze, &
      &nxhyz,nxyzh)
 ! KNC function
@@ -218,7 +239,7 @@
 !
 ! take transverse part of current with standard procedure: updates cue
       call dtimer(dtime,itime,-1)
-      if (kvec==1) then
+      if ((kvec==1).or.(kvec==3)) then
          call CUPERP3(cue,nx,ny,nz,nxeh,nye,nze)
 ! KNC function
       else if (kvec==2) then
@@ -232,7 +253,7 @@
 ! procedure: updates exyz, bxyz, wf, wm
       call dtimer(dtime,itime,-1)
       if (ntime==0) then
-         if (kvec==1) then
+         if ((kvec==1).or.(kvec==3)) then
             call VIBPOIS33(cue,bxyz,ffc,ci,wm,nx,ny,nz,nxeh,nye,nze,nxh,&
      &nyh,nzh)
 ! KNC function
@@ -243,7 +264,7 @@
          wf = 0.0
          dth = 0.5*dt
       else
-         if (kvec==1) then
+         if ((kvec==1).or.(kvec==3)) then
             call VMAXWEL3(exyz,bxyz,cue,ffc,ci,dt,wf,wm,nx,ny,nz,nxeh,  &
      &nye,nze,nxh,nyh,nzh)
 ! KNC function
@@ -260,7 +281,7 @@
 ! updates fxyze, we
       call dtimer(dtime,itime,-1)
       isign = -1
-      if (kvec==1) then
+      if ((kvec==1).or.(kvec==3)) then
          call VPOIS33(qe,fxyze,isign,ffc,ax,ay,az,affp,we,nx,ny,nz,nxeh,&
      &nye,nze,nxh,nyh,nzh)
 ! KNC function
@@ -276,7 +297,7 @@
 ! procedure: updates fxyze
       call dtimer(dtime,itime,-1)
       isign = 1
-      if (kvec==1) then
+      if ((kvec==1).or.(kvec==3)) then
          call VEMFIELD3(fxyze,exyz,ffc,isign,nx,ny,nz,nxeh,nye,nze,nxh, &
      &nyh,nzh)
 ! KNC function
@@ -286,7 +307,7 @@
       endif
 ! copy magnetic field with standard procedure: updates bxyze
       isign = -1
-      if (kvec==1) then
+      if ((kvec==1).or.(kvec==3)) then
          call VEMFIELD3(bxyze,bxyz,ffc,isign,nx,ny,nz,nxeh,nye,nze,nxh, &
      &nyh,nzh)
 ! KNC function
@@ -302,7 +323,7 @@
 ! updates fxyze
       call dtimer(dtime,itime,-1)
       isign = 1
-      if (kvec==1) then
+      if ((kvec==1).or.(kvec==3)) then
          call WFFT3RV3(fxyze,isign,mixup,sct,indx,indy,indz,nxeh,nye,nze&
      &,nxhyz,nxyzh)
 ! KNC function
@@ -318,7 +339,7 @@
 ! updates bxyze
       call dtimer(dtime,itime,-1)
       isign = 1
-      if (kvec==1) then
+      if ((kvec==1).or.(kvec==3)) then
          call WFFT3RV3(bxyze,isign,mixup,sct,indx,indy,indz,nxeh,nye,nze&
      &,nxhyz,nxyzh)
 ! KNC function
@@ -332,7 +353,7 @@
 !
 ! copy guard cells with standard procedure: updates fxyze, bxyze
       call dtimer(dtime,itime,-1)
-      if (kvec==1) then
+      if ((kvec==1).or.(kvec==3)) then
          call CGUARD3L(fxyze,nx,ny,nz,nxe,nye,nze)
          call CGUARD3L(bxyze,nx,ny,nz,nxe,nye,nze)
 ! KNC function
@@ -357,6 +378,10 @@
          else if (kvec==2) then
             call ckncgrbpush3lt(partt,fxyze,bxyze,qbme,dt,dth,ci,wke,   &
      &idimp,np,npe,nx,ny,nz,nxe,nye,nze,ipbc)
+! AVX-512F/AVX2 function
+         else if (kvec==3) then
+            call cavxgrbpush3lt(partt,fxyze,bxyze,qbme,dt,dth,ci,wke,   &
+     &idimp,np,npe,nx,ny,nz,nxe,nye,nze,ipbc)
          endif
       else
          if (kvec==1) then
@@ -368,6 +393,10 @@
          else if (kvec==2) then
             call ckncgbpush3lt(partt,fxyze,bxyze,qbme,dt,dth,wke,idimp, &
      &np,npe,nx,ny,nz,nxe,nye,nze,ipbc)
+! AVX-512F/AVX2 function
+         else if (kvec==3) then
+            call cavxgbpush3lt(partt,fxyze,bxyze,qbme,dt,dth,wke,idimp, &
+     &np,npe,nx,ny,nz,nxe,nye,nze,ipbc)
          endif
       endif
       call dtimer(dtime,itime,1)
@@ -378,7 +407,7 @@
       if (sortime > 0) then
          if (mod(ntime,sortime)==0) then
             call dtimer(dtime,itime,-1)
-            if (kvec==1) then
+            if ((kvec==1).or.(kvec==3)) then
                call DSORTP3YZLT(partt,partt2,npic,idimp,np,npe,ny1,nyz1)
 ! KNC function
             else if (kvec==2) then
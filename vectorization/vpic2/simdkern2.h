@@ -0,0 +1,386 @@
+/* Width-generic kernels for Skeleton 2D Electrostatic Vector PIC Code */
+/* this file is included by simdpush2.c once for each instruction set */
+/* the includer defines the vector length VW, the target attribute    */
+/* VATTR, the name prefix VFUN and the vector operations below, which */
+/* are undefined again at the end of this file                        */
+/* vector types:                                                       */
+/* VF = VW floats, VI = VW ints, VM = comparison mask, VD = double sum */
+/* vector operations:                                                  */
+/* v_loadu, v_storeu, v_set1, v_add, v_sub, v_mul, v_cvtt, v_cvt,      */
+/* v_istore, v_iset1, v_iadd, v_imul, v_cmplt, v_cmpge, m_or, v_blend, */
+/* v_dzero, v_dacc, v_dsum                                             */
+/* v_gather4(p,v_i,a,b,c,d) loads p[i], p[i+1], p[i+2], p[i+3] for the */
+/* VW addresses i in v_i into the vectors a, b, c, d                   */
+
+/*--------------------------------------------------------------------*/
+static VATTR void VFUN(gpush2lt)(float part[], float fxy[], float qbm,
+                                 float dt, float *ek, int idimp,
+                                 int nop, int npe, int nx, int ny,
+                                 int nxv, int nyv, int ipbc) {
+/* width-generic version of csse2gpush2lt, particles are processed in
+   blocks of VW, with the same algorithm and arguments
+local data                                                            */
+   int j, nps, nn, mm;
+   float qtm, edgelx, edgely, edgerx, edgery, dxp, dyp, amx, amy;
+   float x, y, dx, dy, vx, vy;
+   double sum1;
+   VI v_nxv, v_nn, v_mm;
+   VF v_qtm, v_dt, v_one, v_edgelx, v_edgely, v_edgerx, v_edgery;
+   VF v_x, v_y, v_dxp, v_dyp, v_amx, v_amy, v_dx, v_dy, v_vx, v_vy;
+   VF v_at, a, b, c, d;
+   VM v_m;
+   VD v_sum1;
+   qtm = qbm*dt;
+   sum1 = 0.0;
+   nps = VW*(nop/VW);
+/* set boundary values */
+   edgelx = 0.0f;
+   edgely = 0.0f;
+   edgerx = (float) nx;
+   edgery = (float) ny;
+   if (ipbc==2) {
+      edgelx = 1.0f;
+      edgely = 1.0f;
+      edgerx = (float) (nx-1);
+      edgery = (float) (ny-1);
+   }
+   else if (ipbc==3) {
+      edgelx = 1.0f;
+      edgerx = (float) (nx-1);
+   }
+   v_nxv = v_iset1(nxv);
+   v_qtm = v_set1(qtm);
+   v_one = v_set1(1.0f);
+   v_dt = v_set1(dt);
+   v_edgelx = v_set1(edgelx);
+   v_edgely = v_set1(edgely);
+   v_edgerx = v_set1(edgerx);
+   v_edgery = v_set1(edgery);
+   v_sum1 = v_dzero();
+/* vector loop over particles in blocks of VW */
+   for (j = 0; j < nps; j+=VW) {
+/* find interpolation weights */
+      v_x = v_loadu(&part[j]);
+      v_y = v_loadu(&part[j+npe]);
+      v_nn = v_cvtt(v_x);
+      v_mm = v_cvtt(v_y);
+      v_dxp = v_sub(v_x,v_cvt(v_nn));
+      v_dyp = v_sub(v_y,v_cvt(v_mm));
+/* nn = 2*(nn + nxv*mm) */
+      v_nn = v_iadd(v_nn,v_imul(v_mm,v_nxv));
+      v_nn = v_iadd(v_nn,v_nn);
+      v_amx = v_sub(v_one,v_dxp);
+      v_amy = v_sub(v_one,v_dyp);
+/* find acceleration, for lower left/right */
+      v_gather4(fxy,v_nn,a,b,c,d);
+      v_dx = v_mul(v_amx,a);
+      v_dy = v_mul(v_amx,b);
+      v_dx = v_mul(v_amy,v_add(v_mul(v_dxp,c),v_dx));
+      v_dy = v_mul(v_amy,v_add(v_mul(v_dxp,d),v_dy));
+/* upper left/right */
+      v_nn = v_iadd(v_nn,v_iadd(v_nxv,v_nxv));
+      v_gather4(fxy,v_nn,a,b,c,d);
+      a = v_mul(v_amx,a);
+      b = v_mul(v_amx,b);
+      a = v_mul(v_dyp,v_add(v_mul(v_dxp,c),a));
+      b = v_mul(v_dyp,v_add(v_mul(v_dxp,d),b));
+      v_dx = v_add(v_dx,a);
+      v_dy = v_add(v_dy,b);
+/* new velocity */
+      v_dxp = v_loadu(&part[j+2*npe]);
+      v_dyp = v_loadu(&part[j+3*npe]);
+      v_vx = v_add(v_dxp,v_mul(v_qtm,v_dx));
+      v_vy = v_add(v_dyp,v_mul(v_qtm,v_dy));
+/* average kinetic energy */
+      v_dxp = v_add(v_dxp,v_vx);
+      v_dyp = v_add(v_dyp,v_vy);
+      v_at = v_mul(v_dxp,v_dxp);
+      v_at = v_add(v_at,v_mul(v_dyp,v_dyp));
+      v_sum1 = v_dacc(v_sum1,v_at);
+/* new position */
+      v_dx = v_add(v_x,v_mul(v_vx,v_dt));
+      v_dy = v_add(v_y,v_mul(v_vy,v_dt));
+/* periodic boundary conditions in x */
+      if (ipbc==1) {
+         v_dx = v_blend(v_dx,v_add(v_dx,v_edgerx),v_cmplt(v_dx,v_edgelx));
+         v_dx = v_blend(v_dx,v_sub(v_dx,v_edgerx),v_cmpge(v_dx,v_edgerx));
+      }
+/* reflecting boundary conditions in x */
+      else if ((ipbc==2) || (ipbc==3)) {
+         v_m = m_or(v_cmplt(v_dx,v_edgelx),v_cmpge(v_dx,v_edgerx));
+         v_dx = v_blend(v_dx,v_x,v_m);
+         v_vx = v_blend(v_vx,v_sub(v_set1(0.0f),v_vx),v_m);
+      }
+/* periodic boundary conditions in y */
+      if ((ipbc==1) || (ipbc==3)) {
+         v_dy = v_blend(v_dy,v_add(v_dy,v_edgery),v_cmplt(v_dy,v_edgely));
+         v_dy = v_blend(v_dy,v_sub(v_dy,v_edgery),v_cmpge(v_dy,v_edgery));
+      }
+/* reflecting boundary conditions in y */
+      else if (ipbc==2) {
+         v_m = m_or(v_cmplt(v_dy,v_edgely),v_cmpge(v_dy,v_edgery));
+         v_dy = v_blend(v_dy,v_y,v_m);
+         v_vy = v_blend(v_vy,v_sub(v_set1(0.0f),v_vy),v_m);
+      }
+/* set new position */
+      v_storeu(&part[j],v_dx);
+      v_storeu(&part[j+npe],v_dy);
+/* set new velocity */
+      v_storeu(&part[j+2*npe],v_vx);
+      v_storeu(&part[j+3*npe],v_vy);
+   }
+/* loop over remaining particles */
+   for (j = nps; j < nop; j++) {
+/* find interpolation weights */
+      x = part[j];
+      y = part[j+npe];
+      nn = x;
+      mm = y;
+      dxp = x - (float) nn;
+      dyp = y - (float) mm;
+      nn = 2*(nn + nxv*mm);
+      amx = 1.0f - dxp;
+      amy = 1.0f - dyp;
+/* find acceleration */
+      dx = amx*fxy[nn];
+      dy = amx*fxy[nn+1];
+      dx = amy*(dxp*fxy[nn+2] + dx);
+      dy = amy*(dxp*fxy[nn+3] + dy);
+      nn += 2*nxv;
+      vx = amx*fxy[nn];
+      vy = amx*fxy[nn+1];
+      dx += dyp*(dxp*fxy[nn+2] + vx);
+      dy += dyp*(dxp*fxy[nn+3] + vy);
+/* new velocity */
+      dxp = part[j+2*npe];
+      dyp = part[j+3*npe];
+      vx = dxp + qtm*dx;
+      vy = dyp + qtm*dy;
+/* average kinetic energy */
+      dxp += vx;
+      dyp += vy;
+      sum1 += dxp*dxp + dyp*dyp;
+/* new position */
+      dx = x + vx*dt;
+      dy = y + vy*dt;
+/* periodic boundary conditions */
+      if (ipbc==1) {
+         if (dx < edgelx) dx += edgerx;
+         if (dx >= edgerx) dx -= edgerx;
+         if (dy < edgely) dy += edgery;
+         if (dy >= edgery) dy -= edgery;
+      }
+/* reflecting boundary conditions */
+      else if (ipbc==2) {
+         if ((dx < edgelx) || (dx >= edgerx)) {
+            dx = x;
+            vx = -vx;
+         }
+         if ((dy < edgely) || (dy >= edgery)) {
+            dy = y;
+            vy = -vy;
+         }
+      }
+/* mixed reflecting/periodic boundary conditions */
+      else if (ipbc==3) {
+         if ((dx < edgelx) || (dx >= edgerx)) {
+            dx = x;
+            vx = -vx;
+         }
+         if (dy < edgely) dy += edgery;
+         if (dy >= edgery) dy -= edgery;
+      }
+/* set new position */
+      part[j] = dx;
+      part[j+npe] = dy;
+/* set new velocity */
+      part[j+2*npe] = vx;
+      part[j+3*npe] = vy;
+   }
+/* normalize kinetic energy */
+   *ek += 0.125f*(sum1 + v_dsum(v_sum1));
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+static VATTR void VFUN(gpost2lt)(float part[], float q[], float qm,
+                                 int nop, int npe, int idimp, int nxv,
+                                 int nyv) {
+/* width-generic version of csse2gpost2lt, weights and addresses are
+   calculated for VW particles at a time, then the charge of each group
+   of 4 particles is added with SSE2, as in csse2gpost2lt
+local data                                                            */
+   int j, k, nps, nn, mm;
+   float x, y, dxp, dyp, amx, amy;
+   VI v_nxv, v_nn, v_mm;
+   VF v_qm, v_one, v_x, v_y, v_dxp, v_dyp, v_amx, v_amy;
+   __m128 a, b, c, d, v_a;
+   __attribute__((aligned(64))) int ll[VW];
+   __attribute__((aligned(64))) float sw[4*VW];
+   nps = VW*(nop/VW);
+   v_nxv = v_iset1(nxv);
+   v_qm = v_set1(qm);
+   v_one = v_set1(1.0f);
+/* vector loop over particles in blocks of VW */
+   for (j = 0; j < nps; j+=VW) {
+/* find interpolation weights */
+      v_x = v_loadu(&part[j]);
+      v_y = v_loadu(&part[j+npe]);
+      v_nn = v_cvtt(v_x);
+      v_mm = v_cvtt(v_y);
+      v_dxp = v_mul(v_sub(v_x,v_cvt(v_nn)),v_qm);
+      v_dyp = v_sub(v_y,v_cvt(v_mm));
+/* nn = nn + nxv*mm */
+      v_nn = v_iadd(v_nn,v_imul(v_mm,v_nxv));
+      v_amx = v_sub(v_qm,v_dxp);
+      v_amy = v_sub(v_one,v_dyp);
+/* calculate weights, for lower left/right, upper left/right */
+      v_storeu(&sw[0],v_mul(v_amx,v_amy));
+      v_storeu(&sw[VW],v_mul(v_dxp,v_amy));
+      v_storeu(&sw[2*VW],v_mul(v_amx,v_dyp));
+      v_storeu(&sw[3*VW],v_mul(v_dxp,v_dyp));
+      v_istore(ll,v_nn);
+/* deposit charge for groups of 4 particles */
+      for (k = 0; k < VW; k+=4) {
+         a = _mm_load_ps(&sw[k]);
+         b = _mm_load_ps(&sw[k+VW]);
+         c = _mm_load_ps(&sw[k+2*VW]);
+         d = _mm_load_ps(&sw[k+3*VW]);
+/* transpose so a,b,c,d contain the 4 weights for each of 4 particles */
+         _MM_TRANSPOSE4_PS(a,b,c,d);
+         mm = ll[k];
+         v_a = _mm_loadl_pi(a,(__m64 *)&q[mm]);
+         v_a = _mm_loadh_pi(v_a,(__m64 *)&q[mm+nxv]);
+         v_a = _mm_add_ps(v_a,a);
+         _mm_storel_pi((__m64 *)&q[mm],v_a);
+         _mm_storeh_pi((__m64 *)&q[mm+nxv],v_a);
+         mm = ll[k+1];
+         v_a = _mm_loadl_pi(b,(__m64 *)&q[mm]);
+         v_a = _mm_loadh_pi(v_a,(__m64 *)&q[mm+nxv]);
+         v_a = _mm_add_ps(v_a,b);
+         _mm_storel_pi((__m64 *)&q[mm],v_a);
+         _mm_storeh_pi((__m64 *)&q[mm+nxv],v_a);
+         mm = ll[k+2];
+         v_a = _mm_loadl_pi(c,(__m64 *)&q[mm]);
+         v_a = _mm_loadh_pi(v_a,(__m64 *)&q[mm+nxv]);
+         v_a = _mm_add_ps(v_a,c);
+         _mm_storel_pi((__m64 *)&q[mm],v_a);
+         _mm_storeh_pi((__m64 *)&q[mm+nxv],v_a);
+         mm = ll[k+3];
+         v_a = _mm_loadl_pi(d,(__m64 *)&q[mm]);
+         v_a = _mm_loadh_pi(v_a,(__m64 *)&q[mm+nxv]);
+         v_a = _mm_add_ps(v_a,d);
+         _mm_storel_pi((__m64 *)&q[mm],v_a);
+         _mm_storeh_pi((__m64 *)&q[mm+nxv],v_a);
+      }
+   }
+/* loop over remaining particles */
+   for (j = nps; j < nop; j++) {
+/* find interpolation weights */
+      x = part[j];
+      y = part[j+npe];
+      nn = x;
+      mm = y;
+      dxp = qm*(x - (float) nn);
+      dyp = y - (float) mm;
+      nn = nn + nxv*mm;
+      amx = qm - dxp;
+      amy = 1.0f - dyp;
+/* deposit charge */
+      x = q[nn] + amx*amy;
+      y = q[nn+1] + dxp*amy;
+      q[nn] = x;
+      q[nn+1] = y;
+      nn += nxv;
+      x = q[nn] + amx*dyp;
+      y = q[nn+1] + dxp*dyp;
+      q[nn] = x;
+      q[nn+1] = y;
+   }
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+static VATTR void VFUN(dsortp2ylt)(float parta[], float partb[],
+                                   int npic[], int idimp, int nop,
+                                   int npe, int ny1) {
+/* width-generic version of csse2dsortp2ylt, the cell addresses are
+   calculated for VW particles at a time
+local data                                                            */
+   int i, j, k, m, nps, ip;
+   __attribute__((aligned(64))) int ll[VW], pp[VW];
+   __attribute__((aligned(64))) float sv[VW];
+   nps = VW*(nop/VW);
+/* clear counter array */
+   memset((void *)npic,0,ny1*sizeof(int));
+/* find how many particles in each grid */
+/* vector loop over particles in blocks of VW */
+   for (j = 0; j < nps; j+=VW) {
+      v_istore(ll,v_cvtt(v_loadu(&parta[j+npe])));
+      for (k = 0; k < VW; k++) {
+         npic[ll[k]] += 1;
+      }
+   }
+/* loop over remaining particles */
+   for (j = nps; j < nop; j++) {
+      m = parta[j+npe];
+      npic[m] += 1;
+   }
+/* find address offset */
+   csse2xiscan2(npic,ny1);
+/* find addresses of particles at each grid and reorder particles */
+/* vector loop over particles in blocks of VW */
+   for (j = 0; j < nps; j+=VW) {
+      v_istore(ll,v_cvtt(v_loadu(&parta[j+npe])));
+      for (k = 0; k < VW; k++) {
+         m = ll[k];
+         ip = npic[m];
+         npic[m] = ip + 1;
+         pp[k] = ip;
+      }
+      for (i = 0; i < idimp; i++) {
+         v_storeu(sv,v_loadu(&parta[j+npe*i]));
+         for (k = 0; k < VW; k++) {
+            partb[pp[k]+npe*i] = sv[k];
+         }
+      }
+   }
+/* loop over remaining particles */
+   for (j = nps; j < nop; j++) {
+      m = parta[j+npe];
+      ip = npic[m];
+      npic[m] = ip + 1;
+      for (i = 0; i < idimp; i++) {
+         partb[ip+npe*i] = parta[j+npe*i];
+      }
+   }
+   return;
+}
+
+#undef VW
+#undef VATTR
+#undef VFUN
+#undef VF
+#undef VI
+#undef VM
+#undef VD
+#undef v_loadu
+#undef v_storeu
+#undef v_set1
+#undef v_add
+#undef v_sub
+#undef v_mul
+#undef v_cvtt
+#undef v_cvt
+#undef v_istore
+#undef v_iset1
+#undef v_iadd
+#undef v_imul
+#undef v_cmplt
+#undef v_cmpge
+#undef m_or
+#undef v_blend
+#undef v_dzero
+#undef v_dacc
+#undef v_dsum
+#undef v_gather4
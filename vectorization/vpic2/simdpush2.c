@@ -0,0 +1,303 @@
+/* SSE2/AVX2/AVX-512F C Library for Skeleton 2D Electrostatic Vector */
+/* PIC Code                                                           */
+/* the particle push, charge deposit and particle sort are written    */
+/* once, in simdkern2.h, for a generic vector length, and compiled    */
+/* here for 4, 8 and 16 wide vectors.  the widest instruction set     */
+/* available on the host is selected at run time with cpuid           */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <complex.h>
+#include <math.h>
+#include <immintrin.h>
+#include "ssepush2.h"
+#include "simdpush2.h"
+
+/* isa = instruction set found by csimdcheck, -1 if not checked yet */
+static int isa = -1;
+
+/* SSE2 instantiation, 4 wide */
+
+/*--------------------------------------------------------------------*/
+static inline __attribute__((target("sse2"))) __m128i sse2imul(
+                                              __m128i a, __m128i b) {
+/* 32 bit integer multiply, low 32 bits of each product */
+   __m128i c;
+   c = _mm_mul_epu32(b,_mm_srli_si128(a,4));
+   a = _mm_mul_epu32(a,b);
+   return _mm_add_epi32(a,_mm_slli_si128(c,4));
+}
+
+/*--------------------------------------------------------------------*/
+static inline __attribute__((target("sse2"))) __m128d sse2dacc(
+                                              __m128d s, __m128 a) {
+/* add 4 floats to 2 double precision partial sums */
+   s = _mm_add_pd(s,_mm_cvtps_pd(a));
+   return _mm_add_pd(s,_mm_cvtps_pd(_mm_movehl_ps(a,a)));
+}
+
+/*--------------------------------------------------------------------*/
+static inline __attribute__((target("sse2"))) double sse2dsum(
+                                              __m128d s) {
+/* sum of double precision partial sums */
+   __attribute__((aligned(16))) double dd[2];
+   _mm_store_pd(dd,s);
+   return dd[0] + dd[1];
+}
+
+#define VW              4
+#define VATTR __attribute__((target("sse2")))
+#define VFUN(f) sse2##f
+#define VF __m128
+#define VI __m128i
+#define VM __m128
+#define VD __m128d
+#define v_loadu(p) _mm_loadu_ps(p)
+#define v_storeu(p,a) _mm_storeu_ps(p,a)
+#define v_set1(s) _mm_set1_ps(s)
+#define v_add(a,b) _mm_add_ps(a,b)
+#define v_sub(a,b) _mm_sub_ps(a,b)
+#define v_mul(a,b) _mm_mul_ps(a,b)
+#define v_cvtt(a) _mm_cvttps_epi32(a)
+#define v_cvt(a) _mm_cvtepi32_ps(a)
+#define v_istore(p,a) _mm_store_si128((__m128i *)(p),a)
+#define v_iset1(s) _mm_set1_epi32(s)
+#define v_iadd(a,b) _mm_add_epi32(a,b)
+#define v_imul(a,b) sse2imul(a,b)
+#define v_cmplt(a,b) _mm_cmplt_ps(a,b)
+#define v_cmpge(a,b) _mm_cmpge_ps(a,b)
+#define m_or(a,b) _mm_or_ps(a,b)
+#define v_blend(a,b,m) _mm_or_ps(_mm_andnot_ps(m,a),_mm_and_ps(m,b))
+#define v_dzero() _mm_setzero_pd()
+#define v_dacc(s,a) sse2dacc(s,a)
+#define v_dsum(s) sse2dsum(s)
+#define v_gather4(p,v_i,a,b,c,d) do { \
+   __attribute__((aligned(16))) int ll[4]; \
+   _mm_store_si128((__m128i *)ll,v_i); \
+   a = _mm_loadu_ps(&p[ll[0]]); \
+   b = _mm_loadu_ps(&p[ll[1]]); \
+   c = _mm_loadu_ps(&p[ll[2]]); \
+   d = _mm_loadu_ps(&p[ll[3]]); \
+   _MM_TRANSPOSE4_PS(a,b,c,d); } while (0)
+#include "simdkern2.h"
+
+/* AVX2 instantiation, 8 wide */
+
+/*--------------------------------------------------------------------*/
+static inline __attribute__((target("avx2"))) __m256d avx2dacc(
+                                              __m256d s, __m256 a) {
+/* add 8 floats to 4 double precision partial sums */
+   s = _mm256_add_pd(s,_mm256_cvtps_pd(_mm256_castps256_ps128(a)));
+   return _mm256_add_pd(s,_mm256_cvtps_pd(_mm256_extractf128_ps(a,1)));
+}
+
+/*--------------------------------------------------------------------*/
+static inline __attribute__((target("avx2"))) double avx2dsum(
+                                              __m256d s) {
+/* sum of double precision partial sums */
+   __attribute__((aligned(32))) double dd[4];
+   _mm256_store_pd(dd,s);
+   return (dd[0] + dd[1]) + (dd[2] + dd[3]);
+}
+
+#define VW              8
+#define VATTR __attribute__((target("avx2")))
+#define VFUN(f) avx2##f
+#define VF __m256
+#define VI __m256i
+#define VM __m256
+#define VD __m256d
+#define v_loadu(p) _mm256_loadu_ps(p)
+#define v_storeu(p,a) _mm256_storeu_ps(p,a)
+#define v_set1(s) _mm256_set1_ps(s)
+#define v_add(a,b) _mm256_add_ps(a,b)
+#define v_sub(a,b) _mm256_sub_ps(a,b)
+#define v_mul(a,b) _mm256_mul_ps(a,b)
+#define v_cvtt(a) _mm256_cvttps_epi32(a)
+#define v_cvt(a) _mm256_cvtepi32_ps(a)
+#define v_istore(p,a) _mm256_store_si256((__m256i *)(p),a)
+#define v_iset1(s) _mm256_set1_epi32(s)
+#define v_iadd(a,b) _mm256_add_epi32(a,b)
+#define v_imul(a,b) _mm256_mullo_epi32(a,b)
+#define v_cmplt(a,b) _mm256_cmp_ps(a,b,_CMP_LT_OQ)
+#define v_cmpge(a,b) _mm256_cmp_ps(a,b,_CMP_GE_OQ)
+#define m_or(a,b) _mm256_or_ps(a,b)
+#define v_blend(a,b,m) _mm256_blendv_ps(a,b,m)
+#define v_dzero() _mm256_setzero_pd()
+#define v_dacc(s,a) avx2dacc(s,a)
+#define v_dsum(s) avx2dsum(s)
+#define v_gather4(p,v_i,a,b,c,d) \
+   a = _mm256_i32gather_ps(p,v_i,4); \
+   b = _mm256_i32gather_ps(p+1,v_i,4); \
+   c = _mm256_i32gather_ps(p+2,v_i,4); \
+   d = _mm256_i32gather_ps(p+3,v_i,4)
+#include "simdkern2.h"
+
+/* AVX-512F instantiation, 16 wide */
+
+/*--------------------------------------------------------------------*/
+static inline __attribute__((target("avx512f"))) __m512d avx512dacc(
+                                                 __m512d s, __m512 a) {
+/* add 16 floats to 8 double precision partial sums */
+   s = _mm512_add_pd(s,_mm512_cvtps_pd(_mm512_castps512_ps256(a)));
+   return _mm512_add_pd(s,_mm512_cvtps_pd(_mm256_castpd_ps(
+                        _mm512_extractf64x4_pd(_mm512_castps_pd(a),1))));
+}
+
+#define VW              16
+#define VATTR __attribute__((target("avx512f")))
+#define VFUN(f) avx512##f
+#define VF __m512
+#define VI __m512i
+#define VM __mmask16
+#define VD __m512d
+#define v_loadu(p) _mm512_loadu_ps(p)
+#define v_storeu(p,a) _mm512_storeu_ps(p,a)
+#define v_set1(s) _mm512_set1_ps(s)
+#define v_add(a,b) _mm512_add_ps(a,b)
+#define v_sub(a,b) _mm512_sub_ps(a,b)
+#define v_mul(a,b) _mm512_mul_ps(a,b)
+#define v_cvtt(a) _mm512_cvttps_epi32(a)
+#define v_cvt(a) _mm512_cvtepi32_ps(a)
+#define v_istore(p,a) _mm512_store_epi32(p,a)
+#define v_iset1(s) _mm512_set1_epi32(s)
+#define v_iadd(a,b) _mm512_add_epi32(a,b)
+#define v_imul(a,b) _mm512_mullo_epi32(a,b)
+#define v_cmplt(a,b) _mm512_cmp_ps_mask(a,b,_CMP_LT_OQ)
+#define v_cmpge(a,b) _mm512_cmp_ps_mask(a,b,_CMP_GE_OQ)
+#define m_or(a,b) ((a) | (b))
+#define v_blend(a,b,m) _mm512_mask_blend_ps(m,a,b)
+#define v_dzero() _mm512_setzero_pd()
+#define v_dacc(s,a) avx512dacc(s,a)
+#define v_dsum(s) _mm512_reduce_add_pd(s)
+#define v_gather4(p,v_i,a,b,c,d) \
+   a = _mm512_i32gather_ps(v_i,p,4); \
+   b = _mm512_i32gather_ps(v_i,p+1,4); \
+   c = _mm512_i32gather_ps(v_i,p+2,4); \
+   d = _mm512_i32gather_ps(v_i,p+3,4)
+#include "simdkern2.h"
+
+/*--------------------------------------------------------------------*/
+int csimdcheck() {
+/* this function determines with cpuid which vector length is used by
+   the procedures in this library.  the result is saved for later calls
+   returns 2 if AVX-512F is available (16 wide), 1 if AVX2 is available
+   (8 wide), and 0 otherwise (SSE2, 4 wide)
+local data                                                            */
+   if (isa < 0) {
+      __builtin_cpu_init();
+      isa = 0;
+      if (__builtin_cpu_supports("avx2"))
+         isa = 1;
+      if (__builtin_cpu_supports("avx512f"))
+         isa = 2;
+   }
+   return isa;
+}
+
+/*--------------------------------------------------------------------*/
+void csimdgpush2lt(float part[], float fxy[], float qbm, float dt,
+                   float *ek, int idimp, int nop, int npe, int nx,
+                   int ny, int nxv, int nyv, int ipbc) {
+/* for 2d code, this subroutine updates particle co-ordinates and
+   velocities using leap-frog scheme in time and first-order linear
+   interpolation in space, with various boundary conditions.
+   vector version using guard cells
+   44 flops/particle, 12 loads, 4 stores
+   input: all, output: part, ek
+   same algorithm and arguments as csse2gpush2lt.  uses the widest
+   vector length found by csimdcheck
+   part does not need to be aligned
+local data                                                            */
+   switch (csimdcheck()) {
+   case 2:
+      avx512gpush2lt(part,fxy,qbm,dt,ek,idimp,nop,npe,nx,ny,nxv,nyv,
+                     ipbc);
+      break;
+   case 1:
+      avx2gpush2lt(part,fxy,qbm,dt,ek,idimp,nop,npe,nx,ny,nxv,nyv,ipbc);
+      break;
+   default:
+      sse2gpush2lt(part,fxy,qbm,dt,ek,idimp,nop,npe,nx,ny,nxv,nyv,ipbc);
+   }
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void csimdgpost2lt(float part[], float q[], float qm, int nop, int npe,
+                   int idimp, int nxv, int nyv) {
+/* for 2d code, this subroutine calculates particle charge density
+   using first-order linear interpolation, periodic boundaries
+   vector version using guard cells
+   17 flops/particle, 6 loads, 4 stores
+   input: all, output: q
+   same algorithm and arguments as csse2gpost2lt.  uses the widest
+   vector length found by csimdcheck
+   part does not need to be aligned
+local data                                                            */
+   switch (csimdcheck()) {
+   case 2:
+      avx512gpost2lt(part,q,qm,nop,npe,idimp,nxv,nyv);
+      break;
+   case 1:
+      avx2gpost2lt(part,q,qm,nop,npe,idimp,nxv,nyv);
+      break;
+   default:
+      sse2gpost2lt(part,q,qm,nop,npe,idimp,nxv,nyv);
+   }
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void csimddsortp2ylt(float parta[], float partb[], int npic[],
+                     int idimp, int nop, int npe, int ny1) {
+/* this subroutine sorts particles by y grid
+   linear interpolation
+   same algorithm and arguments as csse2dsortp2ylt.  uses the widest
+   vector length found by csimdcheck
+   parta does not need to be aligned, npic needs to be 16 byte aligned
+local data                                                            */
+   switch (csimdcheck()) {
+   case 2:
+      avx512dsortp2ylt(parta,partb,npic,idimp,nop,npe,ny1);
+      break;
+   case 1:
+      avx2dsortp2ylt(parta,partb,npic,idimp,nop,npe,ny1);
+      break;
+   default:
+      sse2dsortp2ylt(parta,partb,npic,idimp,nop,npe,ny1);
+   }
+   return;
+}
+
+/* Interfaces to Fortran */
+
+/*--------------------------------------------------------------------*/
+int csimdcheck_() {
+   return csimdcheck();
+}
+
+/*--------------------------------------------------------------------*/
+void csimdgpush2lt_(float *part, float *fxy, float *qbm, float *dt,
+                    float *ek, int *idimp, int *nop, int *npe, int *nx,
+                    int *ny, int *nxv, int *nyv, int *ipbc) {
+   csimdgpush2lt(part,fxy,*qbm,*dt,ek,*idimp,*nop,*npe,*nx,*ny,*nxv,
+                 *nyv,*ipbc);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void csimdgpost2lt_(float *part, float *q, float *qm, int *nop,
+                    int *npe, int *idimp, int *nxv, int *nyv) {
+   csimdgpost2lt(part,q,*qm,*nop,*npe,*idimp,*nxv,*nyv);
+   return;
+}
+
+/*--------------------------------------------------------------------*/
+void csimddsortp2ylt_(float *parta, float *partb, int *npic, int *idimp,
+                      int *nop, int *npe, int *ny1) {
+   csimddsortp2ylt(parta,partb,npic,*idimp,*nop,*npe,*ny1);
+   return;
+}
+
@@ -0,0 +1,14 @@
+/* header file for simdpush2.c */
+
+int csimdcheck();
+
+void csimdgpush2lt(float part[], float fxy[], float qbm, float dt,
+                   float *ek, int idimp, int nop, int npe, int nx,
+                   int ny, int nxv, int nyv, int ipbc);
+
+void csimdgpost2lt(float part[], float q[], float qm, int nop, int npe,
+                   int idimp, int nxv, int nyv);
+
+void csimddsortp2ylt(float parta[], float partb[], int npic[],
+                     int idimp, int nop, int npe, int ny1);
+
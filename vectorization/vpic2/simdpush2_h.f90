@@ -0,0 +1,43 @@
+!-----------------------------------------------------------------------
+! Interface file for simdpush2.c
+      module simdpush2_h
+      implicit none
+!
+      interface
+         function csimdcheck()
+         implicit none
+         integer :: csimdcheck
+         end function
+      end interface
+!
+      interface
+         subroutine csimdgpush2lt(part,fxy,qbm,dt,ek,idimp,nop,npe,nx,ny&
+     &,nxv,nyv,ipbc)
+         implicit none
+         integer :: idimp, nop, npe, nx, ny, nxv, nyv, ipbc
+         real :: qbm, dt, ek
+         real, dimension(npe,idimp) :: part
+         real, dimension(2,nxv,nyv) :: fxy
+         end subroutine
+      end interface
+!
+      interface
+         subroutine csimdgpost2lt(part,q,qm,nop,npe,idimp,nxv,nyv)
+         implicit none
+         integer :: nop, npe, idimp, nxv, nyv
+         real :: qm
+         real, dimension(npe,idimp) :: part
+         real, dimension(nxv,nyv) :: q
+         end subroutine
+      end interface
+!
+      interface
+         subroutine csimddsortp2ylt(parta,partb,npic,idimp,nop,npe,ny1)
+         implicit none
+         integer :: idimp, nop, npe, ny1
+         real, dimension(npe,idimp) :: parta, partb
+         integer, dimension(ny1) :: npic
+         end subroutine
+      end interface
+!
+      end module
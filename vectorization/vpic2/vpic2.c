@@ -8,6 +8,7 @@
 #include "vpush2.h"
 #include "sselib2.h"
 #include "ssepush2.h"
+#include "simdpush2.h"
 
 void dtimer(double *time, struct timeval *itime, int icntrl);
 
@@ -34,7 +35,7 @@ int main(int argc, char *argv[]) {
    int idimp = 4, ipbc = 1, sortime = 50;
 /* wke/we/wt = particle kinetic/electric field/total energy */
    float wke = 0.0, we = 0.0, wt = 0.0;
-/* kvec = (1,2) = run (autovector,SSE2) version */
+/* kvec = (1,2,3) = run (autovector,SSE2,SSE2/AVX2/AVX-512F) version */
    int kvec = 1;
 
 /* declare scalars for standard code */
@@ -79,6 +80,15 @@ int main(int argc, char *argv[]) {
    nloop = tend/dt + .0001; ntime = 0;
    qbme = qme;
    affp = (float) (nx*ny)/(float ) np;
+/* report vector length selected at run time */
+   if (kvec==3) {
+      if (csimdcheck()==2)
+         printf("using AVX-512F version\n");
+      else if (csimdcheck()==1)
+         printf("using AVX2 version\n");
+      else
+         printf("using SSE2 version\n");
+   }
 
 /* allocate data for standard code */
    mixup = (int *) malloc(nxhy*sizeof(int));
@@ -124,6 +134,9 @@ L500: if (nloop <= ntime)
 /* SSE2 function */
       else if (kvec==2)
          csse2gpost2lt(partt,qe,qme,np,npe,idimp,nxe,nye);
+/* SSE2/AVX2/AVX-512F function */
+      else if (kvec==3)
+         csimdgpost2lt(partt,qe,qme,np,npe,idimp,nxe,nye);
       dtimer(&dtime,&itime,1);
       time = (float) dtime;
       tdpost += time;
@@ -133,7 +146,7 @@ L500: if (nloop <= ntime)
       if (kvec==1)
          caguard2l(qe,nx,ny,nxe,nye);
 /* SSE2 function */
-      else if (kvec==2)
+      else if ((kvec==2) || (kvec==3))
          csse2aguard2l(qe,nx,ny,nxe,nye);
       dtimer(&dtime,&itime,1);
       time = (float) dtime;
@@ -146,7 +159,7 @@ L500: if (nloop <= ntime)
          cwfft2rvx((float complex *)qe,isign,mixup,sct,indx,indy,nxeh,
                    nye,nxhy,nxyh);
 /* SSE2 function */
-      else if (kvec==2)
+      else if ((kvec==2) || (kvec==3))
          csse2wfft2rx((float complex *)qe,isign,mixup,sct,indx,indy,
                       nxeh,nye,nxhy,nxyh);
       dtimer(&dtime,&itime,1);
@@ -161,7 +174,7 @@ L500: if (nloop <= ntime)
          cvpois22((float complex *)qe,(float complex *)fxye,isign,ffc,
                   ax,ay,affp,&we,nx,ny,nxeh,nye,nxh,nyh);
 /* SSE2 function */
-      else if (kvec==2)
+      else if ((kvec==2) || (kvec==3))
          csse2pois22((float complex *)qe,(float complex *)fxye,isign,
                      ffc,ax,ay,affp,&we,nx,ny,nxeh,nye,nxh,nyh);
       dtimer(&dtime,&itime,1);
@@ -175,7 +188,7 @@ L500: if (nloop <= ntime)
          cwfft2rv2((float complex *)fxye,isign,mixup,sct,indx,indy,nxeh,
                    nye,nxhy,nxyh);
 /* SSE2 function */
-      else if (kvec==2)
+      else if ((kvec==2) || (kvec==3))
          csse2wfft2r2((float complex *)fxye,isign,mixup,sct,indx,indy,
                       nxeh,nye,nxhy,nxyh);
       dtimer(&dtime,&itime,1);
@@ -187,7 +200,7 @@ L500: if (nloop <= ntime)
       if (kvec==1) 
          ccguard2l(fxye,nx,ny,nxe,nye);
 /* SSE2 function */
-      else if (kvec==2)
+      else if ((kvec==2) || (kvec==3))
          csse2cguard2l(fxye,nx,ny,nxe,nye);
       dtimer(&dtime,&itime,1);
       time = (float) dtime;
@@ -203,6 +216,10 @@ L500: if (nloop <= ntime)
       else if (kvec==2)
          csse2gpush2lt(partt,fxye,qbme,dt,&wke,idimp,np,npe,nx,ny,nxe,
                       nye,ipbc);
+/* SSE2/AVX2/AVX-512F function */
+      else if (kvec==3)
+         csimdgpush2lt(partt,fxye,qbme,dt,&wke,idimp,np,npe,nx,ny,nxe,
+                       nye,ipbc);
       dtimer(&dtime,&itime,1);
       time = (float) dtime;
       tpush += time;
@@ -216,6 +233,9 @@ L500: if (nloop <= ntime)
 /* SSE2 function */
             else if (kvec==2)
                csse2dsortp2ylt(partt,partt2,npicy,idimp,np,npe,ny1);
+/* SSE2/AVX2/AVX-512F function */
+            else if (kvec==3)
+               csimddsortp2ylt(partt,partt2,npicy,idimp,np,npe,ny1);
 /* exchange pointers */
             tpartt = partt;
             partt = partt2;
@@ -4,6 +4,7 @@
       program vpic2
       use sseflib2_h
       use ssepush2_h
+      use simdpush2_h
       use vpush2_h
       implicit none
 ! indx/indy = exponent which determines grid points in x/y direction:
@@ -28,7 +29,7 @@
       integer :: idimp = 4, ipbc = 1, sortime = 50
 ! wke/we/wt = particle kinetic/electric field/total energy
       real :: wke = 0.0, we = 0.0, wt = 0.0
-! kvec = (1,2) = run (autovector,SSE2) version
+! kvec = (1,2,3) = run (autovector,SSE2,SSE2/AVX2/AVX-512F) version
       integer :: kvec = 1
 !
 ! declare scalars for standard code
@@ -71,6 +72,16 @@
       nloop = tend/dt + .0001; ntime = 0
       qbme = qme
       affp = real(nx*ny)/real(np)
+! report vector length selected at run time
+      if (kvec==3) then
+         if (csimdcheck()==2) then
+            write (*,*) 'using AVX-512F version'
+         else if (csimdcheck()==1) then
+            write (*,*) 'using AVX2 version'
+         else
+            write (*,*) 'using SSE2 version'
+         endif
+      endif
 !
 ! allocate data for standard code
       allocate(mixup(nxhy),sct(nxyh))
@@ -113,6 +124,9 @@
 ! SSE2 function
       else if (kvec==2) then
          call csse2gpost2lt(partt,qe,qme,np,npe,idimp,nxe,nye)
+! SSE2/AVX2/AVX-512F function
+      else if (kvec==3) then
+         call csimdgpost2lt(partt,qe,qme,np,npe,idimp,nxe,nye)
       endif
       call dtimer(dtime,itime,1)
       time = real(dtime)
@@ -123,7 +137,7 @@
       if (kvec==1) then
          call AGUARD2L(qe,nx,ny,nxe,nye)
 ! SSE2 function
-      else if (kvec==2) then
+      else if ((kvec==2).or.(kvec==3)) then
          call csse2aguard2l(qe,nx,ny,nxe,nye)
       endif
       call dtimer(dtime,itime,1)
@@ -136,7 +150,7 @@
       if (kvec==1) then
          call WFFT2RVX(qe,isign,mixup,sct,indx,indy,nxeh,nye,nxhy,nxyh)
 ! SSE2 function
-      else if (kvec==2) then
+      else if ((kvec==2).or.(kvec==3)) then
          call csse2wfft2rx(qe,isign,mixup,sct,indx,indy,nxeh,nye,nxhy,  &
      &nxyh)
       endif
@@ -152,7 +166,7 @@
          call VPOIS22(qe,fxye,isign,ffc,ax,ay,affp,we,nx,ny,nxeh,nye,nxh&
      &,nyh)
 ! SSE2 function
-      else if (kvec==2) then
+      else if ((kvec==2).or.(kvec==3)) then
          call csse2pois22(qe,fxye,isign,ffc,ax,ay,affp,we,nx,ny,nxeh,nye&
      &,nxh,nyh)
       endif
@@ -167,7 +181,7 @@
          call WFFT2RV2(fxye,isign,mixup,sct,indx,indy,nxeh,nye,nxhy,nxyh&
      &)
 ! SSE2 function
-      else if (kvec==2) then
+      else if ((kvec==2).or.(kvec==3)) then
          call csse2wfft2r2(fxye,isign,mixup,sct,indx,indy,nxeh,nye,nxhy,&
      &nxyh)
       endif
@@ -180,7 +194,7 @@
       if (kvec==1) then
          call CGUARD2L(fxye,nx,ny,nxe,nye)
 ! SSE2 function
-      else if (kvec==2) then
+      else if ((kvec==2).or.(kvec==3)) then
          call csse2cguard2l(fxye,nx,ny,nxe,nye)
       endif
       call dtimer(dtime,itime,1)
@@ -197,6 +211,10 @@
       else if (kvec==2) then
          call csse2gpush2lt(partt,fxye,qbme,dt,wke,idimp,np,npe,nx,ny,  &
      &nxe,nye,ipbc)
+! SSE2/AVX2/AVX-512F function
+      else if (kvec==3) then
+         call csimdgpush2lt(partt,fxye,qbme,dt,wke,idimp,np,npe,nx,ny,  &
+     &nxe,nye,ipbc)
       endif
       call dtimer(dtime,itime,1)
       time = real(dtime)
@@ -211,6 +229,9 @@
 ! SSE2 function
             else if (kvec==2) then
                call csse2dsortp2ylt(partt,partt2,npicy,idimp,np,npe,ny1)
+! SSE2/AVX2/AVX-512F function
+            else if (kvec==3) then
+               call csimddsortp2ylt(partt,partt2,npicy,idimp,np,npe,ny1)
             endif
 ! exchange pointers
             tpartt => partt